@@ -33,6 +33,7 @@
 #include "absl/container/btree_map.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -2771,15 +2772,18 @@ class CloneNodesIntoBlockHandler {
       std::vector<PipelineRegister>& pipeline_registers_list) {
     // As a special case, check if the node is a tuple
     // containing types that are of zero-width.  If so, separate them out so
-    // that future optimization passes can remove them.
+    // that future optimization passes can remove them. Tuples are also split
+    // when split_pipeline_registers() is set so the value's shape is
+    // preserved with one leaf-sized register per element.
     //
-    // Note that for nested tuples, only the first level will be split,
-    // any nested tuple will remain as a tuple.
+    // Note that for nested tuples, only the first level will be split and
+    // any nested tuple will remain as a tuple, unless
+    // split_pipeline_registers() is set in which case the split recurses.
     Type* node_type = node->GetType();
     if (node_type->IsTuple()) {
       TupleType* tuple_type = node_type->AsTupleOrDie();
 
-      if (HasZeroWidthType(tuple_type)) {
+      if (HasZeroWidthType(tuple_type) || options_.split_pipeline_registers()) {
         std::vector<Node*> split_registers(tuple_type->size());
 
         // Create registers for each element.
@@ -2787,6 +2791,15 @@ class CloneNodesIntoBlockHandler {
           XLS_ASSIGN_OR_RETURN(Node * split_node, block()->MakeNode<TupleIndex>(
                                                       node->loc(), node, i));
 
+          if (options_.split_pipeline_registers()) {
+            XLS_ASSIGN_OR_RETURN(
+                split_registers.at(i),
+                CreatePipelineRegistersForNode(
+                    absl::StrFormat("%s_index%d", base_name, i), split_node,
+                    stage, pipeline_registers_list));
+            continue;
+          }
+
           XLS_ASSIGN_OR_RETURN(PipelineRegister pipe_reg,
                                CreatePipelineRegister(
                                    absl::StrFormat("%s_index%d", base_name, i),
@@ -3346,6 +3359,57 @@ absl::StatusOr<CodegenPassUnit> FunctionBaseToPipelinedBlock(
   return unit_or_status;
 }
 
+/* static */ uint64_t BlockConversionCache::ScheduleFingerprint(
+    const PipelineSchedule& schedule) {
+  // Fold in each node's stage, id, op and operands so the fingerprint
+  // captures both the stage assignment and the structure of the scheduled IR.
+  uint64_t fingerprint = absl::HashOf(schedule.length());
+  for (int64_t stage = 0; stage < schedule.length(); ++stage) {
+    for (Node* node : schedule.nodes_in_cycle(stage)) {
+      fingerprint = absl::HashOf(fingerprint, stage, node->id(),
+                                 static_cast<int64_t>(node->op()));
+      for (Node* operand : node->operands()) {
+        fingerprint = absl::HashOf(fingerprint, operand->id());
+      }
+    }
+  }
+  return fingerprint;
+}
+
+std::optional<CodegenPassUnit> BlockConversionCache::Lookup(
+    const PipelineSchedule& schedule) const {
+  auto it = results_.find(
+      Key{schedule.function_base(), ScheduleFingerprint(schedule)});
+  if (it == results_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void BlockConversionCache::Insert(const PipelineSchedule& schedule,
+                                  const CodegenPassUnit& unit) {
+  results_.insert_or_assign(
+      Key{schedule.function_base(), ScheduleFingerprint(schedule)}, unit);
+}
+
+absl::StatusOr<CodegenPassUnit> FunctionBaseToPipelinedBlock(
+    const PipelineSchedule& schedule, const CodegenOptions& options,
+    FunctionBase* f, BlockConversionCache* cache) {
+  if (cache != nullptr) {
+    if (std::optional<CodegenPassUnit> cached = cache->Lookup(schedule);
+        cached.has_value()) {
+      VLOG(3) << "Reusing cached pipelined block conversion for " << f->name();
+      return *std::move(cached);
+    }
+  }
+  XLS_ASSIGN_OR_RETURN(CodegenPassUnit unit,
+                       FunctionBaseToPipelinedBlock(schedule, options, f));
+  if (cache != nullptr) {
+    cache->Insert(schedule, unit);
+  }
+  return unit;
+}
+
 absl::StatusOr<CodegenPassUnit> FunctionToCombinationalBlock(
     Function* f, const CodegenOptions& options) {
   XLS_RET_CHECK(!options.valid_control().has_value())
@@ -19,8 +19,10 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_options.h"
 #include "xls/codegen/codegen_pass.h"
@@ -55,6 +57,46 @@ absl::StatusOr<CodegenPassUnit> FunctionBaseToPipelinedBlock(
     const PipelineSchedule& schedule, const CodegenOptions& options,
     FunctionBase* f);
 
+// Memoizes the results of pipelined block conversion. During schedule
+// exploration (for example, sweeping pipeline_stages or clock_period_ps) the
+// same FunctionBase is frequently re-converted under a schedule with identical
+// stage contents. The cache keys each conversion on a fingerprint of the
+// schedule's per-stage node assignment so repeated conversions reuse the
+// previously converted block and only schedules which actually changed are
+// converted again.
+//
+// All conversions sharing a cache instance must use the same CodegenOptions
+// and must not modify the scheduled IR between conversions; callers sweeping
+// codegen options should use a separate cache per configuration. The cache
+// holds pointers into the package and must not outlive it.
+class BlockConversionCache {
+ public:
+  // Returns the result of an earlier conversion of the schedule's
+  // FunctionBase under the same per-stage node assignment, or std::nullopt if
+  // no such conversion has been recorded.
+  std::optional<CodegenPassUnit> Lookup(const PipelineSchedule& schedule) const;
+
+  // Records `unit` as the conversion result for `schedule`.
+  void Insert(const PipelineSchedule& schedule, const CodegenPassUnit& unit);
+
+ private:
+  // Key identifying a conversion: the scheduled FunctionBase and a
+  // fingerprint of the stage contents of its schedule.
+  using Key = std::pair<FunctionBase*, uint64_t>;
+
+  static uint64_t ScheduleFingerprint(const PipelineSchedule& schedule);
+
+  absl::flat_hash_map<Key, CodegenPassUnit> results_;
+};
+
+// As FunctionBaseToPipelinedBlock above, but consults and populates `cache`
+// (which may be null, in which case no caching is performed). On a cache hit
+// the block produced by the earlier conversion is returned and no new block is
+// added to the package.
+absl::StatusOr<CodegenPassUnit> FunctionBaseToPipelinedBlock(
+    const PipelineSchedule& schedule, const CodegenOptions& options,
+    FunctionBase* f, BlockConversionCache* cache);
+
 // Converts every scheduled function/proc in `package` to pipelined blocks.
 absl::StatusOr<CodegenPassUnit> PackageToPipelinedBlocks(
     const PackagePipelineSchedules& schedule, const CodegenOptions& options,
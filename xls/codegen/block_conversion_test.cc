@@ -518,6 +518,49 @@ TEST_F(BlockConversionTest, SimplePipelinedFunction) {
                   m::Add(m::InputPort("x"), m::InputPort("y"))))))));
 }
 
+TEST_F(BlockConversionTest, PipelinedFunctionConversionCache) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Function * f, fb.BuildWithReturnValue(fb.Negate(fb.Not(fb.Add(x, y)))));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule schedule,
+      RunPipelineSchedule(f, TestDelayEstimator(),
+                          SchedulingOptions().pipeline_stages(3)));
+
+  CodegenOptions options =
+      CodegenOptions().flop_inputs(false).flop_outputs(false).clock_name("clk");
+  BlockConversionCache cache;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      CodegenPassUnit unit,
+      FunctionBaseToPipelinedBlock(schedule, options, f, &cache));
+  int64_t block_count = p->blocks().size();
+
+  // Converting again under an identical schedule hits the cache: the same
+  // block is returned and no new block is added to the package.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      CodegenPassUnit cached_unit,
+      FunctionBaseToPipelinedBlock(schedule, options, f, &cache));
+  EXPECT_EQ(cached_unit.top_block, unit.top_block);
+  EXPECT_EQ(p->blocks().size(), block_count);
+  EXPECT_EQ(cached_unit.metadata.size(), unit.metadata.size());
+
+  // A schedule with different stage contents misses the cache and is
+  // converted anew.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule two_stage_schedule,
+      RunPipelineSchedule(f, TestDelayEstimator(),
+                          SchedulingOptions().pipeline_stages(2)));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      CodegenPassUnit other_unit,
+      FunctionBaseToPipelinedBlock(two_stage_schedule, options, f, &cache));
+  EXPECT_NE(other_unit.top_block, unit.top_block);
+  EXPECT_GT(p->blocks().size(), block_count);
+}
+
 TEST_F(BlockConversionTest, TrivialPipelinedFunction) {
   auto p = CreatePackage();
   FunctionBuilder fb(TestName(), p.get());
@@ -616,6 +659,36 @@ TEST_F(BlockConversionTest, ZeroWidthPipeline) {
   EXPECT_EQ(unit.top_block->GetRegisters().size(), 4);
 }
 
+TEST_F(BlockConversionTest, SplitPipelineRegistersPreservesTupleShape) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue y = fb.Param("y", p->GetBitsType(16));
+  BValue z = fb.Param("z", p->GetBitsType(32));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Function * f, fb.BuildWithReturnValue(fb.Tuple({x, fb.Tuple({y, z})})));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule schedule,
+      RunPipelineSchedule(f, TestDelayEstimator(),
+                          SchedulingOptions().pipeline_stages(3)));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      CodegenPassUnit unit,
+      FunctionBaseToPipelinedBlock(schedule,
+                                   CodegenOptions()
+                                       .flop_inputs(false)
+                                       .flop_outputs(false)
+                                       .clock_name("clk")
+                                       .split_pipeline_registers(true),
+                                   f));
+
+  // The nested tuple is split recursively, so each of the three leaf elements
+  // gets its own bits-typed register at each of the two stage boundaries.
+  EXPECT_EQ(unit.top_block->GetRegisters().size(), 6);
+  for (Register* reg : unit.top_block->GetRegisters()) {
+    EXPECT_TRUE(reg->type()->IsBits()) << reg->name();
+  }
+}
+
 // Verifies that an implicit token, as generated by the DSLX IR converter, is
 // appropriately plumbed into the wrapping block during conversion.
 TEST_F(BlockConversionTest, ImplicitToken) {
@@ -15,10 +15,13 @@
 #include "xls/codegen/block_generator.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -47,6 +50,7 @@
 #include "xls/codegen/verilog_line_map.pb.h"
 #include "xls/common/casts.h"
 #include "xls/common/logging/log_lines.h"
+#include "xls/common/thread.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/ir/bits.h"
@@ -925,41 +929,117 @@ absl::StatusOr<std::string> GenerateVerilog(Block* top,
 
   XLS_ASSIGN_OR_RETURN(std::vector<Block*> blocks,
                        GatherInstantiatedBlocks(top));
-  VerilogFile file(options.use_system_verilog() ? FileType::kSystemVerilog
-                                                : FileType::kVerilog);
-  for (Block* block : blocks) {
-    XLS_RETURN_IF_ERROR(BlockGenerator::Generate(block, &file, options));
-    if (block != blocks.back()) {
-      file.Add(file.Make<BlankLine>(SourceInfo()));
-      file.Add(file.Make<BlankLine>(SourceInfo()));
+
+  // Emission of a single block's module into its own VerilogFile. Emission
+  // only reads the IR so the blocks are independent of each other and are
+  // emitted concurrently below.
+  struct BlockEmission {
+    std::unique_ptr<VerilogFile> file;
+    LineInfo line_info;
+    // Line-map records for this block, streamed out of `line_info` as spans
+    // close. Verilog line numbers are local to the block's text until rebased
+    // during concatenation.
+    VerilogLineMap line_map;
+    std::string text;
+  };
+  std::vector<BlockEmission> emissions(blocks.size());
+  std::vector<absl::Status> statuses(blocks.size(), absl::OkStatus());
+  auto emit_block = [&](size_t i) {
+    emissions[i].file = std::make_unique<VerilogFile>(
+        options.use_system_verilog() ? FileType::kSystemVerilog
+                                     : FileType::kVerilog);
+    absl::Status status =
+        BlockGenerator::Generate(blocks[i], emissions[i].file.get(), options);
+    if (!status.ok()) {
+      statuses[i] = std::move(status);
+      return;
+    }
+    if (verilog_line_map != nullptr) {
+      // Stream line-map records directly into the per-block proto as spans
+      // close so the full node-to-spans relation is never retained.
+      emissions[i].line_info.set_span_sink(
+          [&emission = emissions[i], package = top->package()](
+              const VastNode* vast_node, LineSpan span) {
+            for (const SourceLocation& loc : vast_node->loc().locations) {
+              int64_t line = static_cast<int32_t>(loc.lineno());
+              VerilogLineMapping* mapping = emission.line_map.add_mapping();
+              mapping->set_source_file(
+                  package->GetFilename(loc.fileno()).value_or(""));
+              mapping->mutable_source_span()->set_line_start(line);
+              mapping->mutable_source_span()->set_line_end(line);
+              mapping->set_verilog_file("");  // to be updated later on
+              mapping->mutable_verilog_span()->set_line_start(
+                  span.StartLine());
+              mapping->mutable_verilog_span()->set_line_end(span.EndLine());
+            }
+          });
+    }
+    emissions[i].text = emissions[i].file->Emit(&emissions[i].line_info);
+  };
+  if (blocks.size() <= 1) {
+    for (size_t i = 0; i < blocks.size(); ++i) {
+      emit_block(i);
+    }
+  } else {
+    // Emit the blocks on a pool of threads. Results are indexed by block so
+    // the concatenation below is in block order regardless of completion
+    // order.
+    std::atomic<size_t> next_block(0);
+    size_t worker_count =
+        std::min(blocks.size(), static_cast<size_t>(AvailableCPUs()));
+    std::vector<std::unique_ptr<Thread>> threads;
+    threads.reserve(worker_count);
+    for (size_t w = 0; w < worker_count; ++w) {
+      threads.push_back(std::make_unique<Thread>([&] {
+        while (true) {
+          size_t i = next_block.fetch_add(1);
+          if (i >= blocks.size()) {
+            return;
+          }
+          emit_block(i);
+        }
+      }));
+    }
+    for (std::unique_ptr<Thread>& thread : threads) {
+      thread->Join();
     }
   }
+  for (const absl::Status& status : statuses) {
+    XLS_RETURN_IF_ERROR(status);
+  }
 
-  LineInfo line_info;
-  std::string text = file.Emit(&line_info);
-  if (verilog_line_map != nullptr) {
-    for (const auto& [vast_node, partial_spans] : line_info.Spans()) {
-      std::optional<std::vector<LineSpan>> spans =
-          line_info.LookupNode(vast_node);
-      if (!spans.has_value()) {
+  // Concatenate the per-block emissions in block order with two blank lines
+  // between modules, exactly as emitting all blocks into one VerilogFile
+  // would produce. `line_offset` tracks where each emission starts in the
+  // concatenated text so its line map spans can be rebased.
+  std::string text;
+  int64_t line_offset = 0;
+  for (size_t i = 0; i < emissions.size(); ++i) {
+    if (i > 0) {
+      absl::StrAppend(&text, "\n\n");
+      line_offset += 2;
+    }
+    if (verilog_line_map != nullptr) {
+      // With a span sink attached, only spans with an unmatched Start remain
+      // in the relation after emission.
+      if (!emissions[i].line_info.Spans().empty()) {
         return absl::InternalError(
             "Unbalanced calls to LineInfo::{Start, End}");
       }
-      for (const LineSpan& span : spans.value()) {
-        SourceInfo info = vast_node->loc();
-        for (const SourceLocation& loc : info.locations) {
-          int64_t line = static_cast<int32_t>(loc.lineno());
-          VerilogLineMapping* mapping = verilog_line_map->add_mapping();
-          mapping->set_source_file(
-              top->package()->GetFilename(loc.fileno()).value_or(""));
-          mapping->mutable_source_span()->set_line_start(line);
-          mapping->mutable_source_span()->set_line_end(line);
-          mapping->set_verilog_file("");  // to be updated later on
-          mapping->mutable_verilog_span()->set_line_start(span.StartLine());
-          mapping->mutable_verilog_span()->set_line_end(span.EndLine());
-        }
+      // Rebase the streamed records into the concatenated file and splice
+      // them into the output map.
+      for (VerilogLineMapping& mapping :
+           *emissions[i].line_map.mutable_mapping()) {
+        mapping.mutable_verilog_span()->set_line_start(
+            line_offset + mapping.verilog_span().line_start());
+        mapping.mutable_verilog_span()->set_line_end(
+            line_offset + mapping.verilog_span().line_end());
+        *verilog_line_map->add_mapping() = std::move(mapping);
       }
     }
+    line_offset += std::count(emissions[i].text.begin(),
+                              emissions[i].text.end(), '\n');
+    absl::StrAppend(&text, emissions[i].text);
   }
 
   VLOG(2) << "Verilog output:";
@@ -20,8 +20,6 @@
 #include <string>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
-#include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -46,24 +44,35 @@ int64_t GenerateFlopCount(Block* block) {
   return count;
 }
 
+// Returns the largest node id in `block`. Node ids are dense enough within a
+// block that tables indexed by id are cheaper than hash maps keyed by Node*.
+int64_t MaxNodeId(Block* block) {
+  int64_t max_id = 0;
+  for (Node* node : block->nodes()) {
+    max_id = std::max(max_id, node->id());
+  }
+  return max_id;
+}
+
 // Returns true if there is a combinational feedthrough path from an input port
 // to an output port.
 bool HasFeedthroughPass(Block* block) {
-  // Nodes which have a combinational path from an input port.
-  absl::flat_hash_set<Node*> input_path_nodes;
+  // Whether each node (indexed by id) has a combinational path from an input
+  // port.
+  std::vector<bool> input_path_nodes(MaxNodeId(block) + 1, false);
   for (Node* node : TopoSort(block)) {
     if (node->Is<InputPort>()) {
-      input_path_nodes.insert(node);
+      input_path_nodes[node->id()] = true;
       continue;
     }
     for (Node* operand : node->operands()) {
       if (operand->GetType()->GetFlatBitCount() > 0 &&
-          input_path_nodes.contains(operand)) {
-        input_path_nodes.insert(node);
+          input_path_nodes[operand->id()]) {
+        input_path_nodes[node->id()] = true;
         break;
       }
     }
-    if (node->Is<OutputPort>() && input_path_nodes.contains(node)) {
+    if (node->Is<OutputPort>() && input_path_nodes[node->id()]) {
       return true;
     }
   }
@@ -73,10 +82,13 @@ bool HasFeedthroughPass(Block* block) {
 // Sets the delay fields of `proto` based on analysis of `block`.
 absl::Status SetDelayFields(Block* block, const DelayEstimator& delay_estimator,
                             BlockMetricsProto* proto) {
-  // Maximum delay from input to each node.
-  absl::flat_hash_map<Node*, int64_t> input_delay_map;
-  // Maximum delay from a register read to each node.
-  absl::flat_hash_map<Node*, int64_t> reg_delay_map;
+  // Maximum delay from an input port (respectively, a register read) to each
+  // node, indexed by node id. `kNoPath` marks nodes with no such path. Dense
+  // tables make the analysis a single pass over the topological sort with
+  // constant-time lookups.
+  constexpr int64_t kNoPath = -1;
+  std::vector<int64_t> input_delay_map(MaxNodeId(block) + 1, kNoPath);
+  std::vector<int64_t> reg_delay_map(input_delay_map.size(), kNoPath);
 
   // Delay metrics to set on the proto.
   std::optional<int64_t> max_reg_to_reg_delay;
@@ -86,7 +98,7 @@ absl::Status SetDelayFields(Block* block, const DelayEstimator& delay_estimator,
 
   for (Node* node : TopoSort(block)) {
     if (node->Is<InputPort>()) {
-      input_delay_map[node] = 0;
+      input_delay_map[node->id()] = 0;
       continue;
     }
 
@@ -104,38 +116,38 @@ absl::Status SetDelayFields(Block* block, const DelayEstimator& delay_estimator,
     std::optional<int64_t> reg_delay;
     for (Node* operand : node->operands()) {
       if (operand->GetType()->GetFlatBitCount() > 0) {
-        if (input_delay_map.contains(operand)) {
-          input_delay = optional_max(input_delay_map.at(operand) + node_delay,
-                                     input_delay);
+        if (input_delay_map[operand->id()] != kNoPath) {
+          input_delay = optional_max(
+              input_delay_map[operand->id()] + node_delay, input_delay);
         }
-        if (reg_delay_map.contains(operand)) {
-          reg_delay =
-              optional_max(reg_delay_map.at(operand) + node_delay, reg_delay);
+        if (reg_delay_map[operand->id()] != kNoPath) {
+          reg_delay = optional_max(reg_delay_map[operand->id()] + node_delay,
+                                   reg_delay);
         }
       }
     }
     if (input_delay.has_value()) {
-      input_delay_map[node] = input_delay.value();
+      input_delay_map[node->id()] = input_delay.value();
     }
     if (reg_delay.has_value()) {
-      reg_delay_map[node] = reg_delay.value();
+      reg_delay_map[node->id()] = reg_delay.value();
     }
 
     if (node->Is<OutputPort>()) {
       Node* data = node->operand(0);
-      if (input_delay_map.contains(data)) {
-        max_feedthrough_path_delay =
-            optional_max(input_delay_map.at(data), max_feedthrough_path_delay);
+      if (input_delay_map[data->id()] != kNoPath) {
+        max_feedthrough_path_delay = optional_max(input_delay_map[data->id()],
+                                                  max_feedthrough_path_delay);
       }
-      if (reg_delay_map.contains(data)) {
+      if (reg_delay_map[data->id()] != kNoPath) {
         max_reg_to_output_delay =
-            optional_max(reg_delay_map.at(data), max_reg_to_output_delay);
+            optional_max(reg_delay_map[data->id()], max_reg_to_output_delay);
       }
       continue;
     }
     if (node->Is<RegisterRead>()) {
       // The delay of a RegisterRead is the clk-to-q delay.
-      reg_delay_map[node] = node_delay;
+      reg_delay_map[node->id()] = node_delay;
       continue;
     }
     if (node->Is<RegisterWrite>()) {
@@ -147,13 +159,13 @@ absl::Status SetDelayFields(Block* block, const DelayEstimator& delay_estimator,
         operands.push_back(node->As<RegisterWrite>()->load_enable().value());
       }
       for (Node* operand : operands) {
-        if (input_delay_map.contains(operand)) {
-          max_input_to_reg_delay =
-              optional_max(input_delay_map.at(operand), max_input_to_reg_delay);
+        if (input_delay_map[operand->id()] != kNoPath) {
+          max_input_to_reg_delay = optional_max(input_delay_map[operand->id()],
+                                                max_input_to_reg_delay);
         }
-        if (reg_delay_map.contains(operand)) {
+        if (reg_delay_map[operand->id()] != kNoPath) {
           max_reg_to_reg_delay =
-              optional_max(reg_delay_map.at(operand), max_reg_to_reg_delay);
+              optional_max(reg_delay_map[operand->id()], max_reg_to_reg_delay);
         }
       }
       continue;
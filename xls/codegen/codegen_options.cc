@@ -53,6 +53,7 @@ CodegenOptions::CodegenOptions(const CodegenOptions& options)
       flop_inputs_kind_(options.flop_inputs_kind_),
       flop_outputs_kind_(options.flop_outputs_kind_),
       split_outputs_(options.split_outputs_),
+      split_pipeline_registers_(options.split_pipeline_registers_),
       add_idle_output_(options.add_idle_output_),
       flop_single_value_channels_(options.flop_single_value_channels_),
       emit_as_pipeline_(options.emit_as_pipeline_),
@@ -84,6 +85,7 @@ CodegenOptions& CodegenOptions::operator=(const CodegenOptions& options) {
   flop_inputs_kind_ = options.flop_inputs_kind_;
   flop_outputs_kind_ = options.flop_outputs_kind_;
   split_outputs_ = options.split_outputs_;
+  split_pipeline_registers_ = options.split_pipeline_registers_;
   add_idle_output_ = options.add_idle_output_;
   flop_single_value_channels_ = options.flop_single_value_channels_;
   emit_as_pipeline_ = options.emit_as_pipeline_;
@@ -215,6 +217,11 @@ CodegenOptions& CodegenOptions::split_outputs(bool value) {
   return *this;
 }
 
+CodegenOptions& CodegenOptions::split_pipeline_registers(bool value) {
+  split_pipeline_registers_ = value;
+  return *this;
+}
+
 CodegenOptions& CodegenOptions::add_idle_output(bool value) {
   add_idle_output_ = value;
   return *this;
@@ -164,6 +164,14 @@ class CodegenOptions {
   CodegenOptions& split_outputs(bool value);
   bool split_outputs() const { return split_outputs_; }
 
+  // Split tuple-typed pipeline register values into one register per element
+  // (recursively for nested tuples), preserving the value's shape through
+  // block conversion instead of flattening it into a single wide register.
+  // Leaf-sized registers keep register optimization passes and the emitted
+  // Verilog free of large concat/bit-slice chains.
+  CodegenOptions& split_pipeline_registers(bool value);
+  bool split_pipeline_registers() const { return split_pipeline_registers_; }
+
   // Add a single idle signal output, tied to the nor of all valid signals.
   CodegenOptions& add_idle_output(bool value);
   bool add_idle_output() const { return add_idle_output_; }
@@ -268,6 +276,7 @@ class CodegenOptions {
   IOKind flop_inputs_kind_ = IOKind::kFlop;
   IOKind flop_outputs_kind_ = IOKind::kFlop;
   bool split_outputs_ = false;
+  bool split_pipeline_registers_ = false;
   bool add_idle_output_ = false;
   bool flop_single_value_channels_ = false;
   absl::flat_hash_map<Op, std::unique_ptr<OpOverride>> op_overrides_;
@@ -17,10 +17,12 @@
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_pass.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/ir/block.h"
 #include "xls/ir/node_util.h"
 #include "xls/ir/nodes.h"
@@ -86,24 +88,40 @@ std::optional<PartialProductOp*> MatchMulpAdd(Node* node) {
   return mulp;
 }
 
+absl::StatusOr<bool> CombineMulps(Block* block) {
+  bool changed = false;
+  for (Node* node : block->nodes()) {
+    if (std::optional<PartialProductOp*> mulp = MatchMulpAdd(node)) {
+      XLS_RETURN_IF_ERROR(
+          node->ReplaceUsesWithNew<ArithOp>(
+                  mulp.value()->operand(0), mulp.value()->operand(1),
+                  node->BitCountOrDie(),
+                  mulp.value()->op() == Op::kSMulp ? Op::kSMul : Op::kUMul)
+              .status());
+      changed = true;
+    }
+  }
+  return changed;
+}
+
 }  // namespace
 
 absl::StatusOr<bool> MulpCombiningPass::RunInternal(
     CodegenPassUnit* unit, const CodegenPassOptions& options,
     PassResults* results) const {
-  bool changed = false;
+  // The rewrite is local to a block, so blocks are processed concurrently.
+  std::vector<Block*> blocks;
   for (const std::unique_ptr<Block>& block : unit->package->blocks()) {
-    for (Node* node : block->nodes()) {
-      if (std::optional<PartialProductOp*> mulp = MatchMulpAdd(node)) {
-        XLS_RETURN_IF_ERROR(
-            node->ReplaceUsesWithNew<ArithOp>(
-                    mulp.value()->operand(0), mulp.value()->operand(1),
-                    node->BitCountOrDie(),
-                    mulp.value()->op() == Op::kSMulp ? Op::kSMul : Op::kUMul)
-                .status());
-        changed = true;
-      }
-    }
+    blocks.push_back(block.get());
+  }
+  std::vector<absl::StatusOr<bool>> block_changed =
+      GetDefaultThreadPool().ParallelMap<absl::StatusOr<bool>>(
+          static_cast<int64_t>(blocks.size()),
+          [&](int64_t i) { return CombineMulps(blocks[i]); });
+  bool changed = false;
+  for (absl::StatusOr<bool>& result : block_changed) {
+    XLS_ASSIGN_OR_RETURN(bool result_changed, result);
+    changed = changed || result_changed;
   }
   if (changed) {
     unit->GcMetadata();
@@ -14,6 +14,7 @@
 
 #include "xls/codegen/port_legalization_pass.h"
 
+#include <cstdint>
 #include <memory>
 #include <variant>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_pass.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/ir/block.h"
 #include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
@@ -42,54 +44,71 @@ bool IsZeroWidthInstantiationPort(Node* node) {
   }
   return false;
 }
-}  // namespace
 
-absl::StatusOr<bool> PortLegalizationPass::RunInternal(
-    CodegenPassUnit* unit, const CodegenPassOptions& options,
-    PassResults* results) const {
+absl::StatusOr<bool> LegalizePorts(Block* block) {
   bool changed = false;
   std::vector<Node*> to_remove;
-  for (std::unique_ptr<Block>& block : unit->package->blocks()) {
-    // Remove instantiation inputs/outputs with zero width.
-    for (Node* node : block->nodes()) {
-      if (IsZeroWidthInstantiationPort(node)) {
-        XLS_RETURN_IF_ERROR(
-            node->ReplaceUsesWithNew<xls::Literal>(ZeroOfType(node->GetType()))
-                .status());
-        to_remove.push_back(node);
-        changed = true;
-      }
+  // Remove instantiation inputs/outputs with zero width.
+  for (Node* node : block->nodes()) {
+    if (IsZeroWidthInstantiationPort(node)) {
+      XLS_RETURN_IF_ERROR(
+          node->ReplaceUsesWithNew<xls::Literal>(ZeroOfType(node->GetType()))
+              .status());
+      to_remove.push_back(node);
+      changed = true;
     }
-    for (Node* node : to_remove) {
-      XLS_RETURN_IF_ERROR(block->RemoveNode(node));
-    }
-    to_remove.clear();
+  }
+  for (Node* node : to_remove) {
+    XLS_RETURN_IF_ERROR(block->RemoveNode(node));
+  }
 
-    std::vector<Block::Port> ports(block->GetPorts().begin(),
-                                   block->GetPorts().end());
-    // Remove zero-width input ports and output ports.
-    for (const Block::Port& port : ports) {
-      if (std::holds_alternative<InputPort*>(port)) {
-        InputPort* input_port = std::get<InputPort*>(port);
-        if (input_port->GetType()->GetFlatBitCount() == 0) {
-          VLOG(4) << "Removing zero-width input port " << input_port->name();
-          XLS_RETURN_IF_ERROR(input_port
-                                  ->ReplaceUsesWithNew<xls::Literal>(
-                                      ZeroOfType(input_port->GetType()))
-                                  .status());
-          XLS_RETURN_IF_ERROR(block->RemoveNode(input_port));
-          changed = true;
-        }
-      } else if (std::holds_alternative<OutputPort*>(port)) {
-        OutputPort* output_port = std::get<OutputPort*>(port);
-        if (output_port->operand(0)->GetType()->GetFlatBitCount() == 0) {
-          VLOG(4) << "Removing zero-width output port " << output_port->name();
-          XLS_RETURN_IF_ERROR(block->RemoveNode(output_port));
-          changed = true;
-        }
+  std::vector<Block::Port> ports(block->GetPorts().begin(),
+                                 block->GetPorts().end());
+  // Remove zero-width input ports and output ports.
+  for (const Block::Port& port : ports) {
+    if (std::holds_alternative<InputPort*>(port)) {
+      InputPort* input_port = std::get<InputPort*>(port);
+      if (input_port->GetType()->GetFlatBitCount() == 0) {
+        VLOG(4) << "Removing zero-width input port " << input_port->name();
+        XLS_RETURN_IF_ERROR(input_port
+                                ->ReplaceUsesWithNew<xls::Literal>(
+                                    ZeroOfType(input_port->GetType()))
+                                .status());
+        XLS_RETURN_IF_ERROR(block->RemoveNode(input_port));
+        changed = true;
+      }
+    } else if (std::holds_alternative<OutputPort*>(port)) {
+      OutputPort* output_port = std::get<OutputPort*>(port);
+      if (output_port->operand(0)->GetType()->GetFlatBitCount() == 0) {
+        VLOG(4) << "Removing zero-width output port " << output_port->name();
+        XLS_RETURN_IF_ERROR(block->RemoveNode(output_port));
+        changed = true;
       }
     }
   }
+  return changed;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> PortLegalizationPass::RunInternal(
+    CodegenPassUnit* unit, const CodegenPassOptions& options,
+    PassResults* results) const {
+  // Each block is legalized independently; Package-level tables (node ids,
+  // type interning, names) are safe for concurrent node creation and removal.
+  std::vector<Block*> blocks;
+  for (const std::unique_ptr<Block>& block : unit->package->blocks()) {
+    blocks.push_back(block.get());
+  }
+  std::vector<absl::StatusOr<bool>> block_changed =
+      GetDefaultThreadPool().ParallelMap<absl::StatusOr<bool>>(
+          static_cast<int64_t>(blocks.size()),
+          [&](int64_t i) { return LegalizePorts(blocks[i]); });
+  bool changed = false;
+  for (absl::StatusOr<bool>& result : block_changed) {
+    XLS_ASSIGN_OR_RETURN(bool result_changed, result);
+    changed = changed || result_changed;
+  }
 
   if (changed) {
     unit->GcMetadata();
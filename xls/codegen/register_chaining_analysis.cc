@@ -14,16 +14,21 @@
 
 #include "xls/codegen/register_chaining_analysis.h"
 
+#include <cstdint>
 #include <deque>
 #include <iterator>
 #include <list>
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "xls/codegen/codegen_pass.h"
 #include "xls/codegen/concurrent_stage_groups.h"
+#include "xls/data_structures/union_find.h"
+#include "xls/ir/node.h"
 
 namespace xls::verilog {
 
@@ -195,4 +200,39 @@ RegisterChains::SplitBetweenMutexRegions(
   // mutex region so there's no point in trying to do this.
   return results;
 }
+
+std::vector<std::vector<RegisterData>> ClusterRegisters(
+    absl::Span<const RegisterData> candidates) {
+  // Index each candidate by its read node so the register feeding another's
+  // write can be found directly rather than by scanning the block's nodes.
+  absl::flat_hash_map<Node*, int64_t> read_index;
+  read_index.reserve(candidates.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(candidates.size()); ++i) {
+    read_index[candidates[i].read] = i;
+  }
+
+  UnionFind<int64_t> components;
+  for (int64_t i = 0; i < static_cast<int64_t>(candidates.size()); ++i) {
+    components.Insert(i);
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(candidates.size()); ++i) {
+    auto it = read_index.find(candidates[i].write->data());
+    if (it != read_index.end() && it->second != i) {
+      components.Union(i, it->second);
+    }
+  }
+
+  std::vector<std::vector<RegisterData>> clusters;
+  absl::flat_hash_map<int64_t, int64_t> representative_to_cluster;
+  for (int64_t i = 0; i < static_cast<int64_t>(candidates.size()); ++i) {
+    auto [it, inserted] = representative_to_cluster.try_emplace(
+        components.Find(i), static_cast<int64_t>(clusters.size()));
+    if (inserted) {
+      clusters.emplace_back();
+    }
+    clusters[it->second].push_back(candidates[i]);
+  }
+  return clusters;
+}
+
 }  // namespace xls::verilog
@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "xls/codegen/codegen_pass.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/register.h"
@@ -125,6 +126,17 @@ class RegisterChains {
  private:
   std::list<std::deque<RegisterData>> chains_;
 };
+
+// Partitions `candidates` into independent clusters: two registers land in
+// the same cluster only if a chain could link them, i.e. one's write takes
+// its data directly from the other's read. The registers are indexed by read
+// node, so clustering never scans the block's nodes. Chains cannot span
+// clusters, so each cluster may be analyzed independently (and
+// concurrently). Clusters are returned in order of their first appearance in
+// `candidates`, with each cluster's registers in `candidates` order.
+std::vector<std::vector<RegisterData>> ClusterRegisters(
+    absl::Span<const RegisterData> candidates);
+
 }  // namespace xls::verilog
 
 #endif  // XLS_CODEGEN_REGISTER_CHAINING_ANALYSIS_H_
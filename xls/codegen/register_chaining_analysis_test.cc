@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <optional>
 #include <string_view>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -265,6 +266,26 @@ TEST_F(RegisterChainingAnalysisTest, LongChain) {
                           check_order);
 }
 
+TEST_F(RegisterChainingAnalysisTest, ClusterRegistersSeparatesPipelines) {
+  auto p = CreatePackage();
+  BlockBuilder bb(TestName(), p.get());
+  XLS_ASSERT_OK(bb.AddClockPort("clk"));
+  XLS_ASSERT_OK_AND_ASSIGN(auto first, CreateStraightShot<3>(bb, 0, "first_"));
+  XLS_ASSERT_OK_AND_ASSIGN(auto second,
+                           CreateStraightShot<3>(bb, 0, "second_"));
+  XLS_ASSERT_OK(bb.Build().status());
+
+  // Interleave the two pipelines' registers; clustering separates them again
+  // with each cluster in submission order.
+  std::vector<RegisterData> candidates{first[0], second[0], first[1],
+                                       second[1], first[2], second[2]};
+  EXPECT_THAT(ClusterRegisters(candidates),
+              ElementsAre(ElementsAre(Reg("first_reg_A"), Reg("first_reg_B"),
+                                      Reg("first_reg_C")),
+                          ElementsAre(Reg("second_reg_A"), Reg("second_reg_B"),
+                                      Reg("second_reg_C"))));
+}
+
 TEST_F(RegisterChainingAnalysisTest, BrokenChain) {
   auto p = CreatePackage();
   BlockBuilder bb(TestName(), p.get());
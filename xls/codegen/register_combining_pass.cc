@@ -14,6 +14,9 @@
 
 #include "xls/codegen/register_combining_pass.h"
 
+#include <cstdint>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
@@ -28,6 +31,7 @@
 #include "xls/codegen/register_chaining_analysis.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/register.h"
@@ -142,15 +146,30 @@ absl::StatusOr<bool> RunOnBlock(Block* block, CodegenMetadata& metadata,
       });
     }
   }
-  // chains of registers which are possibly combinable.
-  RegisterChains reg_groups;
-
-  for (const RegisterData& rd : candidate_registers) {
-    reg_groups.InsertAndReduce(rd);
+  // Chains never span clusters, so chain construction runs per cluster;
+  // large blocks with many independent clusters are analyzed concurrently.
+  // ParallelMap returns results in cluster order, keeping the combining
+  // order (and thus the output) deterministic.
+  std::vector<std::vector<RegisterData>> clusters =
+      ClusterRegisters(candidate_registers);
+  using ClusterChains = absl::StatusOr<std::vector<std::vector<RegisterData>>>;
+  std::vector<ClusterChains> cluster_chains =
+      GetDefaultThreadPool().ParallelMap<ClusterChains>(
+          static_cast<int64_t>(clusters.size()), [&](int64_t i) {
+            // chains of registers which are possibly combinable.
+            RegisterChains reg_groups;
+            for (const RegisterData& rd : clusters[i]) {
+              reg_groups.InsertAndReduce(rd);
+            }
+            return reg_groups.SplitBetweenMutexRegions(
+                *metadata.concurrent_stages, options);
+          });
+  std::vector<std::vector<RegisterData>> mutex_chains;
+  for (ClusterChains& chains : cluster_chains) {
+    XLS_ASSIGN_OR_RETURN(std::vector<std::vector<RegisterData>> result,
+                         std::move(chains));
+    absl::c_move(result, std::back_inserter(mutex_chains));
   }
-  XLS_ASSIGN_OR_RETURN(std::vector<std::vector<RegisterData>> mutex_chains,
-                       reg_groups.SplitBetweenMutexRegions(
-                           *metadata.concurrent_stages, options));
   bool changed = !mutex_chains.empty();
 
   for (const std::vector<RegisterData>& group : mutex_chains) {
@@ -15,6 +15,7 @@
 #include "xls/codegen/register_legalization_pass.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -25,6 +26,7 @@
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_pass.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/ir/block.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/register.h"
@@ -33,28 +35,21 @@
 
 namespace xls::verilog {
 
-absl::StatusOr<bool> RegisterLegalizationPass::RunInternal(
-    CodegenPassUnit* unit, const CodegenPassOptions& options,
-    PassResults* results) const {
-  bool changed = false;
+namespace {
 
-  // Build vector of (Block, Register) because removing registers invalidates
-  // block->GetRegisters(). Removing the registers later requires a pointer to
-  // the block that contains the register.
-  std::vector<std::pair<Block*, Register*>> to_remove;
-  for (const std::unique_ptr<Block>& block : unit->package->blocks()) {
-    for (Register* reg : block->GetRegisters()) {
-      if (reg->type()->GetFlatBitCount() == 0) {
-        to_remove.push_back(std::make_pair(block.get(), reg));
-      }
+// Removes zero-width registers from `block` and returns the removed
+// registers.
+absl::StatusOr<std::vector<Register*>> RemoveZeroWidthRegisters(Block* block) {
+  // Build vector of registers to remove because removing registers
+  // invalidates block->GetRegisters().
+  std::vector<Register*> to_remove;
+  for (Register* reg : block->GetRegisters()) {
+    if (reg->type()->GetFlatBitCount() == 0) {
+      to_remove.push_back(reg);
     }
   }
 
-  // Now, remove the list of registers we've built. Make a set because later we
-  // clean up dangling pointers.
-  absl::flat_hash_set<Register*> removed_regs;
-  removed_regs.reserve(to_remove.size());
-  for (auto [block, reg] : to_remove) {
+  for (Register* reg : to_remove) {
     // Replace the uses of RegisterRead of a zero-width register with a
     // zero-valued literal and delete the register, RegisterRead, and
     // RegisterWrite.
@@ -64,13 +59,38 @@ absl::StatusOr<bool> RegisterLegalizationPass::RunInternal(
     XLS_RETURN_IF_ERROR(
         reg_read->ReplaceUsesWithNew<xls::Literal>(ZeroOfType(reg->type()))
             .status());
-    removed_regs.insert(reg);
     VLOG(3) << "Removing zero-width register " << reg->name();
     XLS_RETURN_IF_ERROR(block->RemoveNode(reg_read));
     XLS_RETURN_IF_ERROR(block->RemoveNode(reg_write));
     XLS_RETURN_IF_ERROR(block->RemoveRegister(reg));
-    changed = true;
   }
+  return to_remove;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> RegisterLegalizationPass::RunInternal(
+    CodegenPassUnit* unit, const CodegenPassOptions& options,
+    PassResults* results) const {
+  // Registers are local to their block, so blocks are legalized concurrently;
+  // the shared metadata cleanup below stays on this thread.
+  std::vector<Block*> blocks;
+  for (const std::unique_ptr<Block>& block : unit->package->blocks()) {
+    blocks.push_back(block.get());
+  }
+  using RemovedRegisters = absl::StatusOr<std::vector<Register*>>;
+  std::vector<RemovedRegisters> removed_per_block =
+      GetDefaultThreadPool().ParallelMap<RemovedRegisters>(
+          static_cast<int64_t>(blocks.size()),
+          [&](int64_t i) { return RemoveZeroWidthRegisters(blocks[i]); });
+
+  // Make a set because later we clean up dangling pointers.
+  absl::flat_hash_set<Register*> removed_regs;
+  for (RemovedRegisters& removed : removed_per_block) {
+    XLS_ASSIGN_OR_RETURN(std::vector<Register*> regs, std::move(removed));
+    removed_regs.insert(regs.begin(), regs.end());
+  }
+  bool changed = !removed_regs.empty();
 
   if (changed) {
     unit->GcMetadata();
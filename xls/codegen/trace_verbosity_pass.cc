@@ -21,6 +21,7 @@
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_pass.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/ir/block.h"
 #include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
@@ -54,13 +55,22 @@ absl::StatusOr<bool> FilterVerboseTraces(Block* block, int64_t verbosity) {
 absl::StatusOr<bool> TraceVerbosityPass::RunInternal(
     CodegenPassUnit* unit, const CodegenPassOptions& options,
     PassResults* results) const {
-  bool changed = false;
+  // Blocks are filtered independently, so fan the per-block work out across
+  // the pool.
+  std::vector<Block*> blocks;
   for (const std::unique_ptr<Block>& block : unit->package->blocks()) {
-    XLS_ASSIGN_OR_RETURN(
-        bool block_changed,
-        FilterVerboseTraces(block.get(),
-                            options.codegen_options.max_trace_verbosity()));
-    changed = changed || block_changed;
+    blocks.push_back(block.get());
+  }
+  std::vector<absl::StatusOr<bool>> block_changed =
+      GetDefaultThreadPool().ParallelMap<absl::StatusOr<bool>>(
+          static_cast<int64_t>(blocks.size()), [&](int64_t i) {
+            return FilterVerboseTraces(
+                blocks[i], options.codegen_options.max_trace_verbosity());
+          });
+  bool changed = false;
+  for (absl::StatusOr<bool>& result : block_changed) {
+    XLS_ASSIGN_OR_RETURN(bool result_changed, result);
+    changed = changed || result_changed;
   }
 
   if (changed) {
@@ -15,6 +15,7 @@
 #include "xls/codegen/vast.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -102,6 +103,63 @@ std::string EmitNothing(const VastNode* node, LineInfo* line_info) {
 
 }  // namespace
 
+void LineEmitter::Append(std::string_view text) {
+  while (!text.empty()) {
+    size_t newline = text.find('\n');
+    std::string_view line = text.substr(0, newline);
+    if (!line.empty()) {
+      if (at_line_start_) {
+        AppendRaw(indent_);
+      }
+      AppendRaw(line);
+      at_line_start_ = false;
+    }
+    if (newline == std::string_view::npos) {
+      break;
+    }
+    AppendRaw("\n");
+    at_line_start_ = true;
+    text.remove_prefix(line.size() + 1);
+  }
+}
+
+void LineEmitter::IncreaseIndent() {
+  indent_.append(kIndentSpaces, ' ');
+}
+
+void LineEmitter::DecreaseIndent() {
+  indent_.resize(indent_.size() - kIndentSpaces);
+}
+
+std::string LineEmitter::ToString() const {
+  int64_t total_size = 0;
+  for (const std::string& chunk : chunks_) {
+    total_size += chunk.size();
+  }
+  std::string result;
+  result.reserve(total_size);
+  for (const std::string& chunk : chunks_) {
+    result.append(chunk);
+  }
+  return result;
+}
+
+void LineEmitter::AppendRaw(std::string_view text) {
+  if (text.empty()) {
+    return;
+  }
+  if (chunks_.empty() ||
+      chunks_.back().size() + text.size() > static_cast<size_t>(kChunkSize)) {
+    chunks_.emplace_back();
+    chunks_.back().reserve(kChunkSize);
+  }
+  chunks_.back().append(text.data(), text.size());
+}
+
+void VastNode::EmitTo(LineEmitter* emitter, LineInfo* line_info) const {
+  emitter->Append(Emit(line_info));
+}
+
 std::string PartialLineSpans::ToString() const {
   return absl::StrCat(
       "[",
@@ -131,8 +189,17 @@ void LineInfo::End(const VastNode* node) {
       << "LineInfoEnd can't be called twice in a row on the same node!";
   int64_t start_line = spans_.at(node).hanging_start_line.value();
   int64_t end_line = current_line_number_;
-  spans_.at(node).completed_spans.push_back(LineSpan(start_line, end_line));
   spans_.at(node).hanging_start_line = std::nullopt;
+  if (span_sink_ != nullptr) {
+    // Stream the span out rather than accumulating it. Drop the node's entry
+    // if nothing remains so the relation only holds open spans.
+    if (spans_.at(node).completed_spans.empty()) {
+      spans_.erase(node);
+    }
+    span_sink_(node, LineSpan(start_line, end_line));
+    return;
+  }
+  spans_.at(node).completed_spans.push_back(LineSpan(start_line, end_line));
 }
 
 void LineInfo::Increase(int64_t delta) { current_line_number_ += delta; }
@@ -247,21 +314,17 @@ UnpackedArrayType* VerilogFile::UnpackedArrayType(
 }
 
 std::string VerilogFile::Emit(LineInfo* line_info) const {
-  auto file_member_str = [=](const FileMember& member) -> std::string {
-    return absl::visit(
-        Visitor{[=](Include* m) -> std::string { return m->Emit(line_info); },
-                [=](Module* m) -> std::string { return m->Emit(line_info); },
-                [=](BlankLine* m) -> std::string { return m->Emit(line_info); },
-                [=](Comment* m) -> std::string { return m->Emit(line_info); }},
-        member);
-  };
+  LineEmitter emitter;
+  EmitTo(&emitter, line_info);
+  return emitter.ToString();
+}
 
-  std::string out;
+void VerilogFile::EmitTo(LineEmitter* emitter, LineInfo* line_info) const {
   for (const FileMember& member : members_) {
-    absl::StrAppend(&out, file_member_str(member), "\n");
+    absl::visit([&](auto* m) { m->EmitTo(emitter, line_info); }, member);
+    emitter->Append("\n");
     LineInfoIncrease(line_info, 1);
   }
-  return out;
 }
 
 LocalParamItemRef* LocalParam::AddItem(std::string_view name, Expression* value,
@@ -286,23 +349,35 @@ std::string CaseArm::Emit(LineInfo* line_info) const {
 }
 
 std::string StatementBlock::Emit(LineInfo* line_info) const {
+  LineEmitter emitter;
+  EmitTo(&emitter, line_info);
+  return emitter.ToString();
+}
+
+void StatementBlock::EmitTo(LineEmitter* emitter, LineInfo* line_info) const {
   LineInfoStart(line_info, this);
   // TODO(meheff): We can probably be smarter about optionally emitting the
   // begin/end.
   if (statements_.empty()) {
+    emitter->Append("begin end");
     LineInfoEnd(line_info, this);
-    return "begin end";
+    return;
   }
-  std::string result = "begin\n";
+  emitter->Append("begin\n");
   LineInfoIncrease(line_info, 1);
-  std::vector<std::string> lines;
+  emitter->IncreaseIndent();
+  bool first = true;
   for (const auto& statement : statements_) {
-    lines.push_back(statement->Emit(line_info));
+    if (!first) {
+      emitter->Append("\n");
+    }
+    first = false;
+    statement->EmitTo(emitter, line_info);
     LineInfoIncrease(line_info, 1);
   }
-  absl::StrAppend(&result, Indent(absl::StrJoin(lines, "\n")), "\nend");
+  emitter->DecreaseIndent();
+  emitter->Append("\nend");
   LineInfoEnd(line_info, this);
-  return result;
 }
 
 Port Port::FromProto(const PortProto& proto, VerilogFile* f) {
@@ -746,22 +821,37 @@ std::string EmitModuleMember(LineInfo* line_info, const ModuleMember& member) {
 }  // namespace
 
 std::string ModuleSection::Emit(LineInfo* line_info) const {
+  LineEmitter emitter;
+  EmitTo(&emitter, line_info);
+  return emitter.ToString();
+}
+
+void ModuleSection::EmitTo(LineEmitter* emitter, LineInfo* line_info) const {
   LineInfoStart(line_info, this);
-  std::vector<std::string> elements;
+  int64_t element_count = 0;
   for (const ModuleMember& member : members_) {
     if (std::holds_alternative<ModuleSection*>(member)) {
       if (std::get<ModuleSection*>(member)->members_.empty()) {
         continue;
       }
     }
-    elements.push_back(EmitModuleMember(line_info, member));
+    if (element_count > 0) {
+      emitter->Append("\n");
+    }
+    if (std::holds_alternative<ModuleSection*>(member)) {
+      // Nested sections stream recursively rather than being emitted into an
+      // intermediate string.
+      std::get<ModuleSection*>(member)->EmitTo(emitter, line_info);
+    } else {
+      emitter->Append(EmitModuleMember(line_info, member));
+    }
     LineInfoIncrease(line_info, 1);
+    element_count++;
   }
-  if (!elements.empty()) {
+  if (element_count > 0) {
     LineInfoIncrease(line_info, -1);
   }
   LineInfoEnd(line_info, this);
-  return absl::StrJoin(elements, "\n");
 }
 
 std::string ContinuousAssignment::Emit(LineInfo* line_info) const {
@@ -866,29 +956,36 @@ std::string SystemFunctionCall::Emit(LineInfo* line_info) const {
 }
 
 std::string Module::Emit(LineInfo* line_info) const {
+  LineEmitter emitter;
+  EmitTo(&emitter, line_info);
+  return emitter.ToString();
+}
+
+void Module::EmitTo(LineEmitter* emitter, LineInfo* line_info) const {
   LineInfoStart(line_info, this);
-  std::string result = absl::StrCat("module ", name_);
+  emitter->Append(absl::StrCat("module ", name_));
   if (ports_.empty()) {
-    absl::StrAppend(&result, ";\n");
+    emitter->Append(";\n");
     LineInfoIncrease(line_info, 1);
   } else {
-    absl::StrAppend(&result, "(\n  ");
+    emitter->Append("(\n  ");
     LineInfoIncrease(line_info, 1);
-    absl::StrAppend(
-        &result,
+    emitter->Append(
         absl::StrJoin(ports_, ",\n  ", [=](std::string* out, const Port& port) {
           absl::StrAppendFormat(out, "%s %s", ToString(port.direction),
                                 port.wire->EmitNoSemi(line_info));
           LineInfoIncrease(line_info, 1);
         }));
-    absl::StrAppend(&result, "\n);\n");
+    emitter->Append("\n);\n");
     LineInfoIncrease(line_info, 1);
   }
-  absl::StrAppend(&result, Indent(top_.Emit(line_info)), "\n");
+  emitter->IncreaseIndent();
+  top_.EmitTo(emitter, line_info);
+  emitter->DecreaseIndent();
+  emitter->Append("\n");
   LineInfoIncrease(line_info, 1);
-  absl::StrAppend(&result, "endmodule");
+  emitter->Append("endmodule");
   LineInfoEnd(line_info, this);
-  return result;
 }
 
 std::string Literal::Emit(LineInfo* line_info) const {
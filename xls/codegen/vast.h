@@ -20,6 +20,7 @@
 
 #include <cstdint>
 #include <filesystem>  // NOLINT
+#include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -110,6 +111,16 @@ class LineInfo {
  public:
   LineInfo() = default;
 
+  // Callback invoked with each span as it completes (i.e. on `End`).
+  using SpanSink = std::function<void(const VastNode*, LineSpan)>;
+
+  // Streams completed spans to `sink` as they close instead of accumulating
+  // them in the node-to-spans relation. This bounds the memory held while
+  // emitting very large files: consumers that only need a flat record stream
+  // (e.g. line-map generation) never retain the per-node map. When a sink is
+  // set, `Spans()` and `LookupNode()` reflect only spans that are still open.
+  void set_span_sink(SpanSink sink) { span_sink_ = std::move(sink); }
+
   // Start recording a region in which the given node is active.
   // CHECK fails if called multiple times with no intervening `End` calls.
   void Start(const VastNode* node);
@@ -148,12 +159,47 @@ class LineInfo {
  private:
   int64_t current_line_number_ = 0;
   absl::flat_hash_map<const VastNode*, PartialLineSpans> spans_;
+  SpanSink span_sink_;
 };
 
 // Returns a sanitized identifier string based on the given name. Invalid
 // characters are replaced with '_'.
 std::string SanitizeIdentifier(std::string_view name);
 
+// Chunked append-only sink for emitted Verilog text. Text is appended once
+// into fixed-size chunks (a simple rope) rather than repeatedly joined,
+// indented and copied at each level of the VAST tree, which keeps emission of
+// very large modules linear in the size of the output. Indentation is applied
+// line by line as text is appended; empty lines are not indented (matching
+// Indent()).
+class LineEmitter {
+ public:
+  LineEmitter() = default;
+
+  // Appends `text`, splitting it on newlines and prefixing each non-empty
+  // line with the current indentation.
+  void Append(std::string_view text);
+
+  // Adjusts the indentation applied at the start of subsequent lines.
+  void IncreaseIndent();
+  void DecreaseIndent();
+
+  // Returns the concatenation of all appended text.
+  std::string ToString() const;
+
+ private:
+  static constexpr int64_t kIndentSpaces = 2;
+  static constexpr int64_t kChunkSize = 64 * 1024;
+
+  // Appends `text` verbatim, starting a new chunk when the current one is
+  // full.
+  void AppendRaw(std::string_view text);
+
+  std::string indent_;
+  bool at_line_start_ = true;
+  std::vector<std::string> chunks_;
+};
+
 // Base type for a VAST node. All nodes are owned by a VerilogFile.
 class VastNode {
  public:
@@ -168,6 +214,13 @@ class VastNode {
 
   virtual std::string Emit(LineInfo* line_info) const = 0;
 
+  // Streams the emission of this node into `emitter`. The default
+  // implementation appends the result of Emit() in one piece; nodes which
+  // aggregate large amounts of text (statement blocks, module sections,
+  // modules) override this to stream their children into the sink directly
+  // instead of joining and indenting intermediate strings.
+  virtual void EmitTo(LineEmitter* emitter, LineInfo* line_info) const;
+
  private:
   VerilogFile* file_;
   SourceInfo loc_;
@@ -631,6 +684,7 @@ class StatementBlock : public VastNode {
   inline T* Add(const SourceInfo& loc, Args&&... args);
 
   std::string Emit(LineInfo* line_info) const override;
+  void EmitTo(LineEmitter* emitter, LineInfo* line_info) const override;
 
  private:
   std::vector<Statement*> statements_;
@@ -1863,6 +1917,7 @@ class ModuleSection : public VastNode {
   std::vector<ModuleMember> GatherMembers() const;
 
   std::string Emit(LineInfo* line_info) const override;
+  void EmitTo(LineEmitter* emitter, LineInfo* line_info) const override;
 
  private:
   std::vector<ModuleMember> members_;
@@ -1933,6 +1988,7 @@ class Module : public VastNode {
   const std::string& name() const { return name_; }
 
   std::string Emit(LineInfo* line_info) const override;
+  void EmitTo(LineEmitter* emitter, LineInfo* line_info) const override;
 
  private:
   // Add the given Def as a port on the module.
@@ -1989,6 +2045,9 @@ class VerilogFile {
 
   std::string Emit(LineInfo* line_info = nullptr) const;
 
+  // Streams the emission of the whole file into `emitter`.
+  void EmitTo(LineEmitter* emitter, LineInfo* line_info) const;
+
   verilog::Slice* Slice(IndexableExpression* subject, Expression* hi,
                         Expression* lo, const SourceInfo& loc) {
     return Make<verilog::Slice>(loc, subject, hi, lo);
@@ -0,0 +1,96 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/file/file_mapping.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>  // NOLINT
+#include <string>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "xls/common/file/file_descriptor.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/status/error_code_to_status.h"
+#include "xls/common/status/status_macros.h"
+
+namespace xls {
+
+/* static */ absl::StatusOr<FileMapping> FileMapping::Open(
+    const std::filesystem::path& path) {
+  FileMapping mapping;
+  FileDescriptor fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (fd.get() == -1) {
+    return ErrnoToStatus(errno) << "Failed to open: " << path.string();
+  }
+  struct stat stat_buf;
+  if (fstat(fd.get(), &stat_buf) == -1) {
+    return ErrnoToStatus(errno) << "Failed to stat: " << path.string();
+  }
+  if (!S_ISREG(stat_buf.st_mode)) {
+    // Pipes and special files (e.g. /dev/stdin) cannot be mapped; fall back
+    // to an owned copy of the contents.
+    XLS_ASSIGN_OR_RETURN(mapping.fallback_, GetFileContents(path));
+    return mapping;
+  }
+  if (stat_buf.st_size == 0) {
+    return mapping;
+  }
+  void* mapped = mmap(nullptr, stat_buf.st_size, PROT_READ, MAP_PRIVATE,
+                      fd.get(), /*offset=*/0);
+  if (mapped == MAP_FAILED) {
+    return ErrnoToStatus(errno) << "Failed to mmap: " << path.string();
+  }
+  mapping.mapped_ = mapped;
+  mapping.size_ = static_cast<size_t>(stat_buf.st_size);
+  return mapping;
+}
+
+FileMapping::~FileMapping() { Unmap(); }
+
+FileMapping::FileMapping(FileMapping&& other)
+    : mapped_(other.mapped_),
+      size_(other.size_),
+      fallback_(std::move(other.fallback_)) {
+  other.mapped_ = nullptr;
+  other.size_ = 0;
+}
+
+FileMapping& FileMapping::operator=(FileMapping&& other) {
+  if (this != &other) {
+    Unmap();
+    mapped_ = other.mapped_;
+    size_ = other.size_;
+    fallback_ = std::move(other.fallback_);
+    other.mapped_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+void FileMapping::Unmap() {
+  if (mapped_ != nullptr) {
+    munmap(mapped_, size_);
+    mapped_ = nullptr;
+    size_ = 0;
+  }
+}
+
+}  // namespace xls
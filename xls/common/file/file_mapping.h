@@ -0,0 +1,72 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_COMMON_FILE_FILE_MAPPING_H_
+#define XLS_COMMON_FILE_FILE_MAPPING_H_
+
+#include <cstddef>
+#include <filesystem>  // NOLINT
+#include <string>
+#include <string_view>
+
+#include "absl/status/statusor.h"
+
+namespace xls {
+
+// A read-only view of a file's contents backed by mmap. Unlike
+// GetFileContents this does not copy the file into a heap-allocated string;
+// parsers and scanners taking string_view input (IR, netlist, Liberty) can
+// operate directly on the mapped pages and hand out string_view tokens into
+// them. The mapping is released when the object is destroyed; views obtained
+// from data() must not outlive it.
+//
+// Inputs that cannot be mapped (pipes such as /dev/stdin, special files)
+// transparently fall back to reading the contents into an owned buffer, so
+// callers need no special casing.
+class FileMapping {
+ public:
+  // Maps the file at `path` read-only.
+  static absl::StatusOr<FileMapping> Open(const std::filesystem::path& path);
+
+  ~FileMapping();
+
+  FileMapping(const FileMapping&) = delete;
+  FileMapping& operator=(const FileMapping&) = delete;
+  FileMapping(FileMapping&& other);
+  FileMapping& operator=(FileMapping&& other);
+
+  // The file's contents. Valid until this object is destroyed.
+  std::string_view data() const {
+    if (mapped_ != nullptr) {
+      return std::string_view(static_cast<const char*>(mapped_), size_);
+    }
+    return fallback_;
+  }
+
+ private:
+  FileMapping() = default;
+
+  void Unmap();
+
+  // Set when the file is mmapped; null for empty files and unmappable inputs.
+  void* mapped_ = nullptr;
+  size_t size_ = 0;
+
+  // Owned contents for inputs that cannot be mapped.
+  std::string fallback_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_COMMON_FILE_FILE_MAPPING_H_
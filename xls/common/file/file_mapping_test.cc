@@ -0,0 +1,60 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/file/file_mapping.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "xls/common/file/temp_file.h"
+#include "xls/common/status/matchers.h"
+
+namespace xls {
+namespace {
+
+TEST(FileMappingTest, MapsRegularFile) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempFile file,
+                           TempFile::CreateWithContent("hello, mmap"));
+  XLS_ASSERT_OK_AND_ASSIGN(FileMapping mapping, FileMapping::Open(file.path()));
+  EXPECT_EQ(mapping.data(), "hello, mmap");
+}
+
+TEST(FileMappingTest, EmptyFile) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempFile file, TempFile::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(FileMapping mapping, FileMapping::Open(file.path()));
+  EXPECT_TRUE(mapping.data().empty());
+}
+
+TEST(FileMappingTest, MoveTransfersContents) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempFile file, TempFile::CreateWithContent("abc"));
+  XLS_ASSERT_OK_AND_ASSIGN(FileMapping mapping, FileMapping::Open(file.path()));
+  FileMapping moved = std::move(mapping);
+  EXPECT_EQ(moved.data(), "abc");
+}
+
+TEST(FileMappingTest, UnmappableFileFallsBackToCopy) {
+  // Character devices cannot be mmapped the way regular files can; the
+  // mapping falls back to reading the contents.
+  XLS_ASSERT_OK_AND_ASSIGN(FileMapping mapping, FileMapping::Open("/dev/null"));
+  EXPECT_TRUE(mapping.data().empty());
+}
+
+TEST(FileMappingTest, MissingFileIsAnError) {
+  EXPECT_EQ(FileMapping::Open("/does/not/exist").status().code(),
+            absl::StatusCode::kNotFound);
+}
+
+}  // namespace
+}  // namespace xls
@@ -23,6 +23,8 @@
 #include <cerrno>
 #include <cstring>
 #include <filesystem>  // NOLINT
+#include <fstream>
+#include <ostream>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -219,6 +221,24 @@ absl::Status SetFileContents(const std::filesystem::path& file_name,
   return SetFileContentsOrAppend(file_name, content, SetOrAppend::kSet);
 }
 
+absl::Status SetFileContents(const std::filesystem::path& file_name,
+                             absl::FunctionRef<void(std::ostream&)> writer) {
+  // An ofstream without exceptions enabled records failures in the stream
+  // state rather than throwing, so errors are surfaced as Status below.
+  std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return absl::UnknownError(
+        absl::StrCat("Unable to open file for writing: ", file_name.string()));
+  }
+  writer(file);
+  file.close();
+  if (file.fail()) {
+    return absl::UnknownError(
+        absl::StrCat("Error writing file: ", file_name.string()));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status AppendStringToFile(const std::filesystem::path& file_name,
                                 std::string_view content) {
   return SetFileContentsOrAppend(file_name, content, SetOrAppend::kAppend);
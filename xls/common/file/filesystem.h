@@ -19,10 +19,12 @@
 #define XLS_COMMON_FILE_FILESYSTEM_H_
 
 #include <filesystem>  // NOLINT
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -98,6 +100,20 @@ absl::StatusOr<std::string> GetFileContents(
 absl::Status SetFileContents(const std::filesystem::path& file_name,
                              std::string_view content);
 
+// Overwrites the contents of the file file_name with whatever `writer` emits
+// on the provided stream. The stream is backed directly by the file, so large
+// outputs (e.g. textual IR for big packages) can be streamed out without first
+// being materialized as a single string in memory.
+//
+// WARNING: The file update is NOT guaranteed to be atomic.
+//
+// Typical return codes (not guaranteed exhaustive):
+//  * StatusCode::kOk
+//  * StatusCode::kPermissionDenied (file not writable)
+//  * StatusCode::kUnknown (a Write or Open error occurred)
+absl::Status SetFileContents(const std::filesystem::path& file_name,
+                             absl::FunctionRef<void(std::ostream&)> writer);
+
 // Writes the contents of data into the file file_name, appending to any
 // existing content.
 //
@@ -19,6 +19,7 @@
 #include <filesystem>  // NOLINT
 #include <fstream>
 #include <ios>
+#include <ostream>
 #include <string>
 #include <system_error>  // NOLINT(build/c++11)
 
@@ -195,6 +196,21 @@ TEST(FilesystemTest, SetFileContentsCreatesFileWhenMissing) {
   EXPECT_EQ(*read_contents, "hello");
 }
 
+TEST(FilesystemTest, SetFileContentsFromWriterOverwritesFile) {
+  absl::StatusOr<TempFile> temp_file = TempFile::CreateWithContent("abc");
+  XLS_ASSERT_OK(temp_file);
+
+  XLS_EXPECT_OK(SetFileContents(temp_file->path(), [](std::ostream& os) {
+    os << "hello ";
+    os << "streamed world";
+  }));
+
+  absl::StatusOr<std::string> read_contents =
+      GetFileContents(temp_file->path());
+  XLS_ASSERT_OK(read_contents);
+  EXPECT_EQ(*read_contents, "hello streamed world");
+}
+
 TEST(FilesystemTest, SetFileContentsOverwritesFile) {
   static constexpr char kContents[] = "h\ne\0y!";
   // Make sure to include the \0 in the string, to verify that binary data can
@@ -0,0 +1,190 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/no_destructor.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/metrics.pb.h"
+
+namespace xls::metrics {
+
+namespace internal {
+
+int64_t ThisThreadShardIndex() {
+  static std::atomic<int64_t> next_index{0};
+  static thread_local const int64_t index =
+      next_index.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+  return index;
+}
+
+}  // namespace internal
+
+int64_t Counter::Read() const {
+  int64_t total = 0;
+  for (const Shard& shard : shards_) {
+    total += shard.value.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+CounterProto Counter::ToProto() const {
+  CounterProto proto;
+  proto.set_name(name_);
+  proto.set_value(Read());
+  return proto;
+}
+
+void DurationHistogram::Record(absl::Duration duration) {
+  int64_t nanos = std::max<int64_t>(absl::ToInt64Nanoseconds(duration), 0);
+  Shard& shard = shards_[internal::ThisThreadShardIndex()];
+  shard.count.fetch_add(1, std::memory_order_relaxed);
+  shard.total_nanos.fetch_add(nanos, std::memory_order_relaxed);
+  int64_t bucket = std::bit_width(static_cast<uint64_t>(nanos));
+  shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+DurationHistogramProto DurationHistogram::ToProto() const {
+  DurationHistogramProto proto;
+  proto.set_name(name_);
+  int64_t count = 0;
+  int64_t total_nanos = 0;
+  std::vector<int64_t> buckets(kNumBuckets, 0);
+  for (const Shard& shard : shards_) {
+    count += shard.count.load(std::memory_order_relaxed);
+    total_nanos += shard.total_nanos.load(std::memory_order_relaxed);
+    for (int64_t i = 0; i < kNumBuckets; ++i) {
+      buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+    }
+  }
+  proto.set_count(count);
+  proto.set_total_nanos(total_nanos);
+  // Trailing empty buckets are elided to keep dumps compact.
+  int64_t last_nonzero = -1;
+  for (int64_t i = 0; i < kNumBuckets; ++i) {
+    if (buckets[i] != 0) {
+      last_nonzero = i;
+    }
+  }
+  for (int64_t i = 0; i <= last_nonzero; ++i) {
+    proto.add_bucket_counts(buckets[i]);
+  }
+  return proto;
+}
+
+/* static */ MetricsRegistry& MetricsRegistry::GetGlobal() {
+  static absl::NoDestructor<MetricsRegistry> registry;
+  return *registry;
+}
+
+Counter* MetricsRegistry::GetCounter(std::string_view name) {
+  absl::MutexLock lock(&mutex_);
+  std::unique_ptr<Counter>& counter = counters_[std::string(name)];
+  if (counter == nullptr) {
+    counter = std::make_unique<Counter>(name);
+  }
+  return counter.get();
+}
+
+DurationHistogram* MetricsRegistry::GetDurationHistogram(
+    std::string_view name) {
+  absl::MutexLock lock(&mutex_);
+  std::unique_ptr<DurationHistogram>& histogram =
+      histograms_[std::string(name)];
+  if (histogram == nullptr) {
+    histogram = std::make_unique<DurationHistogram>(name);
+  }
+  return histogram.get();
+}
+
+MetricsProto MetricsRegistry::ToProto() const {
+  absl::MutexLock lock(&mutex_);
+  std::vector<const Counter*> counters;
+  counters.reserve(counters_.size());
+  for (const auto& [_, counter] : counters_) {
+    counters.push_back(counter.get());
+  }
+  std::sort(counters.begin(), counters.end(),
+            [](const Counter* a, const Counter* b) {
+              return a->name() < b->name();
+            });
+  std::vector<const DurationHistogram*> histograms;
+  histograms.reserve(histograms_.size());
+  for (const auto& [_, histogram] : histograms_) {
+    histograms.push_back(histogram.get());
+  }
+  std::sort(histograms.begin(), histograms.end(),
+            [](const DurationHistogram* a, const DurationHistogram* b) {
+              return a->name() < b->name();
+            });
+  MetricsProto proto;
+  for (const Counter* counter : counters) {
+    *proto.add_counters() = counter->ToProto();
+  }
+  for (const DurationHistogram* histogram : histograms) {
+    *proto.add_duration_histograms() = histogram->ToProto();
+  }
+  return proto;
+}
+
+namespace {
+
+std::string& DumpPath() {
+  static absl::NoDestructor<std::string> path;
+  return *path;
+}
+
+absl::Mutex& DumpMutex() {
+  static absl::NoDestructor<absl::Mutex> mutex;
+  return *mutex;
+}
+
+void DumpMetricsAtExitHandler() {
+  std::string path;
+  {
+    absl::MutexLock lock(&DumpMutex());
+    path = DumpPath();
+  }
+  absl::Status status =
+      SetTextProtoFile(path, MetricsRegistry::GetGlobal().ToProto());
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to dump metrics to " << path << ": " << status;
+  }
+}
+
+}  // namespace
+
+void DumpMetricsAtExit(std::string_view path) {
+  absl::MutexLock lock(&DumpMutex());
+  if (DumpPath().empty()) {
+    std::atexit(DumpMetricsAtExitHandler);
+  }
+  DumpPath() = std::string(path);
+}
+
+}  // namespace xls::metrics
@@ -0,0 +1,201 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_COMMON_METRICS_H_
+#define XLS_COMMON_METRICS_H_
+
+// Lightweight always-on metrics for XLS hot paths. Counters and duration
+// histograms are sharded across cache lines so concurrent updates from many
+// threads do not contend; an update is one relaxed atomic add. Probes are
+// placed with the XLS_METRICS_* macros below, which resolve the metric once
+// per site via a function-local static. Building with -DXLS_NO_METRICS
+// compiles every probe out entirely.
+//
+// Metrics live in the process-wide MetricsRegistry and can be written out as
+// a metrics.proto MetricsProto textproto at process exit with
+// DumpMetricsAtExit().
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xls/common/metrics.pb.h"
+#include "xls/common/stopwatch.h"
+
+#if !defined(XLS_NO_METRICS)
+#define XLS_METRICS_ENABLED 1
+#else
+#define XLS_METRICS_ENABLED 0
+#endif
+
+namespace xls::metrics {
+
+namespace internal {
+
+// Number of cache-line-sized shards per metric. Threads are assigned shards
+// round-robin on first use; the count trades memory for reduced contention.
+inline constexpr int64_t kNumShards = 16;
+
+// Returns this thread's shard index.
+int64_t ThisThreadShardIndex();
+
+}  // namespace internal
+
+// A monotonically increasing integer counter. Add() is wait-free; Read()
+// sums the shards and is approximate while writers are active.
+class Counter {
+ public:
+  explicit Counter(std::string_view name) : name_(name) {}
+
+  Counter(const Counter&) = delete;
+  Counter& operator=(const Counter&) = delete;
+
+  void Add(int64_t amount) {
+    shards_[internal::ThisThreadShardIndex()].value.fetch_add(
+        amount, std::memory_order_relaxed);
+  }
+
+  int64_t Read() const;
+
+  const std::string& name() const { return name_; }
+
+  CounterProto ToProto() const;
+
+ private:
+  struct alignas(ABSL_CACHELINE_SIZE) Shard {
+    std::atomic<int64_t> value{0};
+  };
+
+  std::string name_;
+  std::array<Shard, internal::kNumShards> shards_;
+};
+
+// A histogram of durations with exponential (power-of-two nanosecond)
+// buckets; see DurationHistogramProto for the bucket boundaries. Record() is
+// wait-free.
+class DurationHistogram {
+ public:
+  explicit DurationHistogram(std::string_view name) : name_(name) {}
+
+  DurationHistogram(const DurationHistogram&) = delete;
+  DurationHistogram& operator=(const DurationHistogram&) = delete;
+
+  void Record(absl::Duration duration);
+
+  const std::string& name() const { return name_; }
+
+  DurationHistogramProto ToProto() const;
+
+ private:
+  static constexpr int64_t kNumBuckets = 64;
+
+  struct alignas(ABSL_CACHELINE_SIZE) Shard {
+    std::atomic<int64_t> count{0};
+    std::atomic<int64_t> total_nanos{0};
+    std::array<std::atomic<int64_t>, kNumBuckets> buckets{};
+  };
+
+  std::string name_;
+  std::array<Shard, internal::kNumShards> shards_;
+};
+
+// Records the time from construction to destruction into a histogram.
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(DurationHistogram* histogram) : histogram_(histogram) {}
+  ~ScopedTimer() { histogram_->Record(stopwatch_.GetElapsedTime()); }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  DurationHistogram* histogram_;
+  Stopwatch stopwatch_;
+};
+
+// The process-wide collection of metrics. Metrics are created on first
+// lookup and live for the life of the process; the returned pointers are
+// stable and safe to cache.
+class MetricsRegistry {
+ public:
+  static MetricsRegistry& GetGlobal();
+
+  Counter* GetCounter(std::string_view name);
+  DurationHistogram* GetDurationHistogram(std::string_view name);
+
+  // Snapshots every registered metric, ordered by name.
+  MetricsProto ToProto() const;
+
+ private:
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::unique_ptr<Counter>> counters_
+      ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, std::unique_ptr<DurationHistogram>>
+      histograms_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Arranges for the global registry to be written to `path` as a MetricsProto
+// textproto at normal process exit. The last path registered wins; write
+// failures are logged.
+void DumpMetricsAtExit(std::string_view path);
+
+}  // namespace xls::metrics
+
+#define XLS_METRICS_CONCAT_IMPL_(a, b) a##b
+#define XLS_METRICS_CONCAT_(a, b) XLS_METRICS_CONCAT_IMPL_(a, b)
+
+#if XLS_METRICS_ENABLED
+
+// Adds `amount` to the counter named `name` (a string literal).
+#define XLS_METRICS_COUNTER_ADD(name, amount)                          \
+  do {                                                                 \
+    static ::xls::metrics::Counter* const xls_metrics_counter =        \
+        ::xls::metrics::MetricsRegistry::GetGlobal().GetCounter(name); \
+    xls_metrics_counter->Add(amount);                                  \
+  } while (false)
+
+#define XLS_METRICS_COUNTER_INC(name) XLS_METRICS_COUNTER_ADD(name, 1)
+
+// Records the time from this statement to the end of the enclosing scope
+// into the duration histogram named `name` (a string literal).
+#define XLS_METRICS_SCOPED_TIMER(name)                                      \
+  static ::xls::metrics::DurationHistogram* const XLS_METRICS_CONCAT_(      \
+      xls_metrics_histogram_, __LINE__) =                                   \
+      ::xls::metrics::MetricsRegistry::GetGlobal().GetDurationHistogram(    \
+          name);                                                            \
+  ::xls::metrics::ScopedTimer XLS_METRICS_CONCAT_(xls_metrics_timer_,       \
+                                                  __LINE__)(                \
+      XLS_METRICS_CONCAT_(xls_metrics_histogram_, __LINE__))
+
+#else
+
+#define XLS_METRICS_COUNTER_ADD(name, amount) \
+  do {                                        \
+  } while (false)
+#define XLS_METRICS_COUNTER_INC(name) \
+  do {                                \
+  } while (false)
+#define XLS_METRICS_SCOPED_TIMER(name) static_assert(true)
+
+#endif  // XLS_METRICS_ENABLED
+
+#endif  // XLS_COMMON_METRICS_H_
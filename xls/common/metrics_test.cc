@@ -0,0 +1,103 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/metrics.h"
+
+#include <cstdint>
+
+#include "gtest/gtest.h"
+#include "absl/time/time.h"
+#include "xls/common/metrics.pb.h"
+#include "xls/common/thread_pool.h"
+
+namespace xls::metrics {
+namespace {
+
+TEST(MetricsTest, CounterSumsAcrossThreads) {
+  Counter counter("test_counter");
+  ThreadPool pool(8);
+  pool.ParallelFor(1000, [&counter](int64_t) { counter.Add(1); });
+  EXPECT_EQ(counter.Read(), 1000);
+  CounterProto proto = counter.ToProto();
+  EXPECT_EQ(proto.name(), "test_counter");
+  EXPECT_EQ(proto.value(), 1000);
+}
+
+TEST(MetricsTest, HistogramBucketsByBitWidth) {
+  DurationHistogram histogram("test_histogram");
+  histogram.Record(absl::Nanoseconds(0));   // bucket 0
+  histogram.Record(absl::Nanoseconds(1));   // bucket 1
+  histogram.Record(absl::Nanoseconds(5));   // bucket 3: [4, 8)
+  histogram.Record(absl::Nanoseconds(7));   // bucket 3
+  DurationHistogramProto proto = histogram.ToProto();
+  EXPECT_EQ(proto.count(), 4);
+  EXPECT_EQ(proto.total_nanos(), 13);
+  ASSERT_EQ(proto.bucket_counts_size(), 4);
+  EXPECT_EQ(proto.bucket_counts(0), 1);
+  EXPECT_EQ(proto.bucket_counts(1), 1);
+  EXPECT_EQ(proto.bucket_counts(2), 0);
+  EXPECT_EQ(proto.bucket_counts(3), 2);
+}
+
+TEST(MetricsTest, RegistryReturnsStablePointers) {
+  MetricsRegistry& registry = MetricsRegistry::GetGlobal();
+  Counter* counter = registry.GetCounter("metrics_test.stable");
+  EXPECT_EQ(counter, registry.GetCounter("metrics_test.stable"));
+  EXPECT_NE(counter, registry.GetCounter("metrics_test.other"));
+  EXPECT_EQ(registry.GetDurationHistogram("metrics_test.hist"),
+            registry.GetDurationHistogram("metrics_test.hist"));
+}
+
+TEST(MetricsTest, RegistryProtoIsSortedByName) {
+  MetricsRegistry& registry = MetricsRegistry::GetGlobal();
+  registry.GetCounter("metrics_test.sorted_b")->Add(2);
+  registry.GetCounter("metrics_test.sorted_a")->Add(1);
+  MetricsProto proto = registry.ToProto();
+  int64_t a_index = -1;
+  int64_t b_index = -1;
+  for (int64_t i = 0; i < proto.counters_size(); ++i) {
+    if (proto.counters(i).name() == "metrics_test.sorted_a") {
+      a_index = i;
+      EXPECT_EQ(proto.counters(i).value(), 1);
+    } else if (proto.counters(i).name() == "metrics_test.sorted_b") {
+      b_index = i;
+      EXPECT_EQ(proto.counters(i).value(), 2);
+    }
+  }
+  ASSERT_NE(a_index, -1);
+  ASSERT_NE(b_index, -1);
+  EXPECT_LT(a_index, b_index);
+}
+
+TEST(MetricsTest, ProbeMacrosCompile) {
+  XLS_METRICS_COUNTER_INC("metrics_test.macro_counter");
+  XLS_METRICS_COUNTER_ADD("metrics_test.macro_counter", 2);
+  {
+    XLS_METRICS_SCOPED_TIMER("metrics_test.macro_timer");
+  }
+#if XLS_METRICS_ENABLED
+  EXPECT_EQ(MetricsRegistry::GetGlobal()
+                .GetCounter("metrics_test.macro_counter")
+                ->Read(),
+            3);
+  EXPECT_EQ(MetricsRegistry::GetGlobal()
+                .GetDurationHistogram("metrics_test.macro_timer")
+                ->ToProto()
+                .count(),
+            1);
+#endif
+}
+
+}  // namespace
+}  // namespace xls::metrics
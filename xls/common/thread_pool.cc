@@ -0,0 +1,122 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "absl/base/no_destructor.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/thread.h"
+
+namespace xls {
+
+ThreadPool::ThreadPool(int64_t worker_count) {
+  if (worker_count <= 0) {
+    worker_count = AvailableCPUs();
+  }
+  threads_.reserve(worker_count);
+  for (int64_t i = 0; i < worker_count; ++i) {
+    threads_.push_back(std::make_unique<Thread>([this] { WorkerLoop(); }));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutting_down_ = true;
+  }
+  // Thread joins in its destructor.
+  threads_.clear();
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  absl::MutexLock lock(&mutex_);
+  queue_.push_back(std::move(task));
+}
+
+void ThreadPool::WorkerLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      absl::MutexLock lock(&mutex_);
+      auto has_work = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+        return !queue_.empty() || shutting_down_;
+      };
+      mutex_.Await(absl::Condition(&has_work));
+      // Drain the queue before shutting down so the destructor waits for
+      // already-scheduled work.
+      if (queue_.empty()) {
+        return;
+      }
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task();
+  }
+}
+
+void ThreadPool::TaskGroup::Run(std::function<void()> task) {
+  {
+    absl::MutexLock lock(&mutex_);
+    ++pending_;
+  }
+  pool_->Schedule([this, task = std::move(task)] {
+    task();
+    absl::MutexLock lock(&mutex_);
+    --pending_;
+  });
+}
+
+void ThreadPool::TaskGroup::Wait() {
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(
+      +[](int64_t* pending) { return *pending == 0; }, &pending_));
+}
+
+void ThreadPool::ParallelFor(int64_t count,
+                             absl::FunctionRef<void(int64_t)> fn) {
+  if (count <= 0) {
+    return;
+  }
+  std::atomic<int64_t> next_index = 0;
+  auto run_iterations = [&]() {
+    for (int64_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+         i < count; i = next_index.fetch_add(1, std::memory_order_relaxed)) {
+      fn(i);
+    }
+  };
+  TaskGroup group(this);
+  // The calling thread participates; extra helpers that arrive after the
+  // iterations run out simply find nothing to claim.
+  int64_t helper_count = std::min(worker_count(), count - 1);
+  for (int64_t i = 0; i < helper_count; ++i) {
+    group.Run(run_iterations);
+  }
+  run_iterations();
+  group.Wait();
+}
+
+ThreadPool& GetDefaultThreadPool() {
+  static absl::NoDestructor<ThreadPool> pool;
+  return *pool;
+}
+
+}  // namespace xls
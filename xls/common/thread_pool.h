@@ -0,0 +1,115 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_COMMON_THREAD_POOL_H_
+#define XLS_COMMON_THREAD_POOL_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/thread.h"
+
+namespace xls {
+
+// A fixed-size pool of worker threads sharing one work queue. This is the
+// one executor for XLS-internal parallelism (passes, analyses, drivers);
+// subsystems should size it from their existing worker-count options rather
+// than spawning ad-hoc std::thread batches.
+//
+// Thread safety: all public methods may be called concurrently from any
+// thread. The blocking operations (TaskGroup::Wait, ParallelFor, and the
+// destructor) must not be called from inside a pool task, as the pool does
+// not grow and the wait could starve the queue.
+class ThreadPool {
+ public:
+  // Creates a pool with `worker_count` threads; a non-positive count uses one
+  // thread per available CPU.
+  explicit ThreadPool(int64_t worker_count = 0);
+
+  // Blocks until all queued tasks have run, then joins the workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  int64_t worker_count() const { return static_cast<int64_t>(threads_.size()); }
+
+  // Enqueues `task` to run on some pool thread.
+  void Schedule(std::function<void()> task);
+
+  // A set of tasks which can be awaited together. The group itself is not
+  // thread-safe; schedule from one thread and Wait there.
+  class TaskGroup {
+   public:
+    explicit TaskGroup(ThreadPool* pool) : pool_(pool) {}
+
+    // Waits for any tasks still outstanding.
+    ~TaskGroup() { Wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // Enqueues `task` on the pool as part of this group.
+    void Run(std::function<void()> task);
+
+    // Blocks until every task Run() on this group has finished.
+    void Wait();
+
+   private:
+    ThreadPool* pool_;
+    absl::Mutex mutex_;
+    int64_t pending_ ABSL_GUARDED_BY(mutex_) = 0;
+  };
+
+  // Invokes `fn(i)` for every i in [0, count) and blocks until all calls
+  // have returned. Iterations are claimed dynamically, one at a time, by the
+  // calling thread and up to worker_count() pool threads; `fn` must be safe
+  // to call concurrently with itself.
+  void ParallelFor(int64_t count, absl::FunctionRef<void(int64_t)> fn);
+
+  // As ParallelFor, but collects `fn`'s results indexed by iteration. The
+  // output order is the index order, independent of how iterations were
+  // scheduled, so reductions over the returned vector are deterministic.
+  // `T` must be default-constructible and must not be bool (std::vector<bool>
+  // packs bits, so concurrent element writes would race).
+  template <typename T>
+  std::vector<T> ParallelMap(int64_t count,
+                             absl::FunctionRef<T(int64_t)> fn) {
+    std::vector<T> results(count);
+    ParallelFor(count, [&](int64_t i) { results[i] = fn(i); });
+    return results;
+  }
+
+ private:
+  void WorkerLoop();
+
+  absl::Mutex mutex_;
+  std::deque<std::function<void()>> queue_ ABSL_GUARDED_BY(mutex_);
+  bool shutting_down_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<std::unique_ptr<Thread>> threads_;
+};
+
+// Returns a lazily-created process-wide pool with one thread per available
+// CPU, for callers without a natural place to own a pool.
+ThreadPool& GetDefaultThreadPool();
+
+}  // namespace xls
+
+#endif  // XLS_COMMON_THREAD_POOL_H_
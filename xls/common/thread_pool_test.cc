@@ -0,0 +1,88 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/thread_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace xls {
+namespace {
+
+TEST(ThreadPoolTest, DestructorDrainsScheduledTasks) {
+  std::atomic<int64_t> counter = 0;
+  {
+    ThreadPool pool(2);
+    for (int64_t i = 0; i < 100; ++i) {
+      pool.Schedule([&counter] { counter.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(ThreadPoolTest, TaskGroupWaitsForItsTasksOnly) {
+  ThreadPool pool(2);
+  std::atomic<int64_t> counter = 0;
+  ThreadPool::TaskGroup group(&pool);
+  for (int64_t i = 0; i < 10; ++i) {
+    group.Run([&counter] { counter.fetch_add(1); });
+  }
+  group.Wait();
+  EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(ThreadPoolTest, ParallelForCoversEveryIndexOnce) {
+  ThreadPool pool(4);
+  constexpr int64_t kCount = 10000;
+  std::vector<int64_t> hits(kCount, 0);
+  pool.ParallelFor(kCount, [&hits](int64_t i) { ++hits[i]; });
+  for (int64_t i = 0; i < kCount; ++i) {
+    ASSERT_EQ(hits[i], 1) << "index " << i;
+  }
+}
+
+TEST(ThreadPoolTest, ParallelForEmptyRange) {
+  ThreadPool pool(2);
+  pool.ParallelFor(0, [](int64_t) { FAIL(); });
+}
+
+TEST(ThreadPoolTest, ParallelMapResultsAreInIndexOrder) {
+  ThreadPool pool(4);
+  std::vector<int64_t> squares =
+      pool.ParallelMap<int64_t>(1000, [](int64_t i) { return i * i; });
+  ASSERT_EQ(squares.size(), 1000);
+  for (int64_t i = 0; i < 1000; ++i) {
+    ASSERT_EQ(squares[i], i * i);
+  }
+}
+
+TEST(ThreadPoolTest, PoolIsReusableAcrossParallelFors) {
+  ThreadPool pool(3);
+  std::atomic<int64_t> total = 0;
+  for (int64_t round = 0; round < 10; ++round) {
+    pool.ParallelFor(100, [&total](int64_t) { total.fetch_add(1); });
+  }
+  EXPECT_EQ(total.load(), 1000);
+}
+
+TEST(ThreadPoolTest, DefaultThreadPoolIsShared) {
+  EXPECT_EQ(&GetDefaultThreadPool(), &GetDefaultThreadPool());
+  EXPECT_GE(GetDefaultThreadPool().worker_count(), 1);
+}
+
+}  // namespace
+}  // namespace xls
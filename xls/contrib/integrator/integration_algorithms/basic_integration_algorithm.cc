@@ -18,10 +18,13 @@
 #include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/contrib/integrator/ir_integrator.h"
 #include "xls/ir/node.h"
 #include "xls/ir/op.h"
 
@@ -53,6 +56,20 @@ absl::Status BasicIntegrationAlgorithm::Initialize() {
 absl::StatusOr<std::unique_ptr<IntegrationFunction>>
 BasicIntegrationAlgorithm::Run() {
   while (!ready_nodes_.empty()) {
+    // Bucket merge candidates by structural fingerprint so that each ready
+    // node is only scored against internal nodes it could possibly merge
+    // with, rather than every node in the integration function.
+    absl::flat_hash_map<int64_t, std::vector<Node*>> merge_candidates;
+    for (Node* internal_node : integration_function_->function()->nodes()) {
+      // TODO(jbaileyhandle): Relax this requirement so that
+      // it only applies to integration-generated muxes.
+      if (!integration_function_->IsMappingTarget(internal_node)) {
+        continue;
+      }
+      merge_candidates[IntegrationFunction::MergeFingerprint(internal_node)]
+          .push_back(internal_node);
+    }
+
     std::optional<BasicIntegrationMove> move;
     for (auto node_itr = ready_nodes_.begin(); node_itr != ready_nodes_.end();
          ++node_itr) {
@@ -63,14 +80,13 @@ BasicIntegrationAlgorithm::Run() {
         move = MakeInsertMove(node_itr, insert_cost);
       }
 
-      // Check merge cost.
-      for (Node* internal_node : integration_function_->function()->nodes()) {
-        // TODO(jbaileyhandle): Relax this requirement so that
-        // it only applies to integration-generated muxes.
-        if (!integration_function_->IsMappingTarget(internal_node)) {
-          continue;
-        }
-
+      // Check merge cost against nodes sharing this node's fingerprint.
+      auto bucket = merge_candidates.find(
+          IntegrationFunction::MergeFingerprint(*node_itr));
+      if (bucket == merge_candidates.end()) {
+        continue;
+      }
+      for (Node* internal_node : bucket->second) {
         // Check if mergeable
         XLS_ASSIGN_OR_RETURN(
             std::optional<int64_t> merge_cost,
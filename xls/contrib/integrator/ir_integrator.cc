@@ -24,6 +24,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -732,6 +733,20 @@ int64_t IntegrationFunction::GetNodeCost(const Node* node) const {
   }
 }
 
+int64_t IntegrationFunction::MergeFingerprint(const Node* node) {
+  // Merging requires matching ops, result types, operand counts and operand
+  // types (see Node::IsDefinitelyEqualTo), so hashing exactly those features
+  // guarantees that mergeable nodes land in the same bucket. Types are
+  // interned per package, so hashing the Type pointers suffices.
+  std::vector<const Type*> operand_types;
+  operand_types.reserve(node->operand_count());
+  for (const Node* operand : node->operands()) {
+    operand_types.push_back(operand->GetType());
+  }
+  return static_cast<int64_t>(
+      absl::HashOf(node->op(), node->GetType(), operand_types));
+}
+
 absl::StatusOr<std::vector<Node*>> IntegrationFunction::MergeNodes(
     Node* node_a, Node* node_b) {
   XLS_ASSIGN_OR_RETURN(MergeNodesBackendResult merge_result,
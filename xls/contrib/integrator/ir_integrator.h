@@ -186,6 +186,13 @@ class IntegrationFunction {
   // Returns an estimate of the (gate count? area?) cost of a node.
   int64_t GetNodeCost(const Node* node) const;
 
+  // Returns a structural fingerprint of 'node' - a hash of its op, result
+  // type and operand types. Any two nodes that can potentially be merged
+  // (see GetMergeNodesCost) have the same fingerprint, so nodes with
+  // different fingerprints never merge. Callers can bucket merge candidates
+  // by fingerprint and skip scoring pairs from different buckets.
+  static int64_t MergeFingerprint(const Node* node);
+
  private:
   IntegrationFunction(Package* package, const IntegrationOptions& options)
       : package_(package), integration_options_(options) {}
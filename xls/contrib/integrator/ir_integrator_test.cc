@@ -2862,5 +2862,31 @@ TEST_F(IntegratorTest, NodeSourceFunctionsCollideTest) {
       IsOkAndHolds(true));
 }
 
+TEST_F(IntegratorTest, MergeFingerprintBucketsMergeableNodes) {
+  auto p = CreatePackage();
+  FunctionBuilder fb("func", p.get());
+  auto a = fb.Param("a", p->GetBitsType(8));
+  auto b = fb.Param("b", p->GetBitsType(8));
+  auto wide = fb.Param("wide", p->GetBitsType(16));
+  auto add1 = fb.Add(a, b, SourceInfo(), "add1");
+  auto add2 = fb.Add(b, a, SourceInfo(), "add2");
+  auto sub = fb.Subtract(a, b, SourceInfo(), "sub");
+  auto add_wide = fb.Add(wide, wide, SourceInfo(), "add_wide");
+  XLS_ASSERT_OK(fb.Build().status());
+
+  // Same op, operand types and result type - potentially mergeable, so the
+  // fingerprints must match.
+  EXPECT_EQ(IntegrationFunction::MergeFingerprint(add1.node()),
+            IntegrationFunction::MergeFingerprint(add2.node()));
+
+  // Different op.
+  EXPECT_NE(IntegrationFunction::MergeFingerprint(add1.node()),
+            IntegrationFunction::MergeFingerprint(sub.node()));
+
+  // Different operand and result types.
+  EXPECT_NE(IntegrationFunction::MergeFingerprint(add1.node()),
+            IntegrationFunction::MergeFingerprint(add_wide.node()));
+}
+
 }  // namespace
 }  // namespace xls
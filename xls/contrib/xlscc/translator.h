@@ -1432,6 +1432,11 @@ class Translator {
   absl::flat_hash_map<std::shared_ptr<CInstantiableTypeAlias>,
                       std::shared_ptr<CType>, InstTypeHash, InstTypeEq>
       inst_types_;
+  // Memoizes translated functions by their canonical definition decl
+  // (GetFunctionBody() resolves redeclarations to the definition before
+  // lookup). Clang uniques template instantiations within an ASTContext, so
+  // identical instantiations of the same template share a single entry here
+  // and are only translated once per Translator.
   absl::flat_hash_map<const clang::NamedDecl*,
                       std::unique_ptr<GeneratedFunction>>
       inst_functions_;
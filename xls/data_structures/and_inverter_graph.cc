@@ -0,0 +1,140 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/data_structures/and_inverter_graph.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+
+namespace xls {
+namespace {
+
+// Deterministic 64-bit mixer (splitmix64) used to assign each variable a
+// fixed pseudorandom simulation pattern.
+uint64_t SplitMix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+}  // namespace
+
+AndInverterGraph::AndInverterGraph() {
+  // Node 0 is the constant false function; its uninverted literal is zero()
+  // and its inverted literal is one().
+  nodes_.push_back(AigNode{.signature = 0});
+}
+
+AigLiteral AndInverterGraph::NewVariable() {
+  AigNode node;
+  node.is_variable = true;
+  node.signature = SplitMix64(static_cast<uint64_t>(variable_count_) + 1);
+  ++variable_count_;
+  nodes_.push_back(node);
+  return AigLiteral(static_cast<int32_t>(nodes_.size() - 1) << 1);
+}
+
+AigLiteral AndInverterGraph::And(AigLiteral a, AigLiteral b) {
+  // Canonicalize the fanin order so structurally identical gates hash
+  // identically.
+  if (b < a) {
+    std::swap(a, b);
+  }
+  // Local simplification rules; these keep trivially constant or redundant
+  // expressions out of the graph.
+  if (a == zero() || b == zero()) {
+    return zero();
+  }
+  if (a == one()) {
+    return b;
+  }
+  if (b == one()) {
+    return a;
+  }
+  if (a == b) {
+    return a;
+  }
+  if (a == Not(b)) {
+    return zero();
+  }
+  auto [it, inserted] =
+      unique_table_.insert({{a.value(), b.value()}, AigLiteral(0)});
+  if (!inserted) {
+    return it->second;
+  }
+  AigNode node;
+  node.fanin0 = a;
+  node.fanin1 = b;
+  node.signature = GetSignature(a) & GetSignature(b);
+  nodes_.push_back(node);
+  AigLiteral literal(static_cast<int32_t>(nodes_.size() - 1) << 1);
+  it->second = literal;
+  return literal;
+}
+
+uint64_t AndInverterGraph::GetSignature(AigLiteral expr) const {
+  uint64_t signature = NodeOf(expr).signature;
+  return (expr.value() & 1) != 0 ? ~signature : signature;
+}
+
+absl::StatusOr<bool> AndInverterGraph::Evaluate(
+    AigLiteral expr,
+    const absl::flat_hash_map<AigLiteral, bool>& variable_values) const {
+  absl::flat_hash_map<int32_t, bool> node_values;
+  node_values[0] = false;
+  // Iterative post-order evaluation of the expression DAG.
+  std::vector<std::pair<int32_t, bool>> stack;
+  stack.push_back({expr.value() >> 1, false});
+  while (!stack.empty()) {
+    auto [index, fanins_done] = stack.back();
+    stack.pop_back();
+    if (node_values.contains(index)) {
+      continue;
+    }
+    const AigNode& node = nodes_[index];
+    if (node.is_variable) {
+      AigLiteral variable_literal(index << 1);
+      auto it = variable_values.find(variable_literal);
+      if (it == variable_values.end()) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Missing value for variable with literal %d", index << 1));
+      }
+      node_values[index] = it->second;
+      continue;
+    }
+    int32_t fanin0_index = node.fanin0.value() >> 1;
+    int32_t fanin1_index = node.fanin1.value() >> 1;
+    if (!fanins_done) {
+      stack.push_back({index, true});
+      stack.push_back({fanin0_index, false});
+      stack.push_back({fanin1_index, false});
+      continue;
+    }
+    bool fanin0_value =
+        node_values.at(fanin0_index) ^ ((node.fanin0.value() & 1) != 0);
+    bool fanin1_value =
+        node_values.at(fanin1_index) ^ ((node.fanin1.value() & 1) != 0);
+    node_values[index] = fanin0_value && fanin1_value;
+  }
+  return node_values.at(expr.value() >> 1) ^ ((expr.value() & 1) != 0);
+}
+
+}  // namespace xls
@@ -0,0 +1,150 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DATA_STRUCTURES_AND_INVERTER_GRAPH_H_
+#define XLS_DATA_STRUCTURES_AND_INVERTER_GRAPH_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/status/statusor.h"
+#include "xls/common/strong_int.h"
+
+namespace xls {
+
+// A literal in an and-inverter graph (AIG): a reference to an AIG node with an
+// optional inversion. The node index is encoded in the upper bits and the
+// inversion (complement) flag in the least-significant bit.
+XLS_DEFINE_STRONG_INT_TYPE(AigLiteral, int32_t);
+
+// A node in the AIG. Every node is either the constant-false node, a variable,
+// or the AND of two literals.
+struct AigNode {
+  // Fanin literals of an AND node. Canonicalized so fanin0 <= fanin1.
+  // Meaningless for the constant and variable nodes.
+  AigLiteral fanin0 = AigLiteral(0);
+  AigLiteral fanin1 = AigLiteral(0);
+
+  // The value of this node on 64 fixed pseudorandom input assignments.
+  // Variables are assigned deterministic pseudorandom patterns and AND nodes
+  // combine the patterns of their fanins. Two literals whose signatures differ
+  // cannot be functionally equivalent (on at least one of the sampled
+  // assignments they evaluate differently).
+  uint64_t signature = 0;
+
+  bool is_variable = false;
+};
+
+// An and-inverter graph: a DAG of two-input AND nodes with optionally inverted
+// edges. Unlike a BDD, the graph grows linearly with the number of gates in
+// the evaluated expressions, so wide arithmetic operations which cause
+// exponential blowup in a BDD are cheap to represent. The tradeoff is that an
+// AIG is not canonical: structural hashing and local simplification rules
+// identify many (but not all) equivalent expressions.
+//
+// Equivalence detection is "fraig-style": structurally hashed nodes share a
+// literal (a sound proof of equivalence), and per-node simulation signatures
+// cheaply refute equivalence of most inequivalent literals. No SAT-based
+// proving is performed, so literals with equal signatures which are not
+// structurally identical remain unresolved.
+//
+// Not thread-safe.
+class AndInverterGraph {
+ public:
+  AndInverterGraph();
+
+  AndInverterGraph(const AndInverterGraph&) = delete;
+  AndInverterGraph& operator=(const AndInverterGraph&) = delete;
+
+  // Literals of the constant false/true functions.
+  AigLiteral zero() const { return AigLiteral(0); }
+  AigLiteral one() const { return AigLiteral(1); }
+
+  // Adds a new variable to the graph and returns the literal corresponding to
+  // the variable's value.
+  AigLiteral NewVariable();
+
+  // Returns the inverse of the given expression. Inversion is a property of
+  // the edge so this never creates a node.
+  AigLiteral Not(AigLiteral expr) const {
+    return AigLiteral(expr.value() ^ 1);
+  }
+
+  // Returns the AND/OR of the given expressions. Structurally identical
+  // expressions return the same literal.
+  AigLiteral And(AigLiteral a, AigLiteral b);
+  AigLiteral Or(AigLiteral a, AigLiteral b) {
+    return Not(And(Not(a), Not(b)));
+  }
+
+  // Returns true if `a` is known to imply `b`; that is, if a AND NOT b
+  // simplifies to the constant false. A false return value does not mean the
+  // implication does not hold, only that it could not be shown structurally.
+  bool Implies(AigLiteral a, AigLiteral b) { return And(a, Not(b)) == zero(); }
+
+  // Returns the simulation signature of the given literal: its value on 64
+  // fixed pseudorandom input assignments. Literals with different signatures
+  // are definitely not equivalent.
+  uint64_t GetSignature(AigLiteral expr) const;
+
+  // Returns false if the two literals are definitely not equivalent (their
+  // simulation signatures differ). A true return value means equivalence is
+  // possible, not proven; literal equality is the only structural proof.
+  bool MayBeEquivalent(AigLiteral a, AigLiteral b) const {
+    return GetSignature(a) == GetSignature(b);
+  }
+
+  // Evaluates the given expression with the given variable values. The keys in
+  // the map are the literals returned by NewVariable. An error is returned if
+  // the map is missing a variable required to evaluate the expression.
+  absl::StatusOr<bool> Evaluate(
+      AigLiteral expr,
+      const absl::flat_hash_map<AigLiteral, bool>& variable_values) const;
+
+  // Returns true if the given literal refers (possibly inverted) to a
+  // variable node.
+  bool IsVariable(AigLiteral expr) const {
+    return NodeOf(expr).is_variable;
+  }
+
+  // Returns the number of nodes (constant, variables, and AND gates) in the
+  // graph.
+  int64_t node_count() const { return nodes_.size(); }
+
+  // Returns the number of variables in the graph.
+  int64_t variable_count() const { return variable_count_; }
+
+ private:
+  const AigNode& NodeOf(AigLiteral expr) const {
+    int64_t index = expr.value() >> 1;
+    DCHECK_GE(index, 0);
+    DCHECK_LT(index, static_cast<int64_t>(nodes_.size()));
+    return nodes_[index];
+  }
+
+  std::vector<AigNode> nodes_;
+
+  // Structural hashing (unique) table mapping canonicalized AND fanin pairs to
+  // the literal of the existing node.
+  absl::flat_hash_map<std::pair<int32_t, int32_t>, AigLiteral> unique_table_;
+
+  int64_t variable_count_ = 0;
+};
+
+}  // namespace xls
+
+#endif  // XLS_DATA_STRUCTURES_AND_INVERTER_GRAPH_H_
@@ -15,6 +15,7 @@
 #include "xls/data_structures/binary_decision_diagram.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <limits>
 #include <string>
@@ -29,16 +30,40 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
 
 namespace xls {
 
 BinaryDecisionDiagram::BinaryDecisionDiagram() {
+  absl::MutexLock lock(&mutex_);
   // Leaf node 0.
-  nodes_.push_back(BddNode(BddVariable(-1), BddNodeIndex(-1), BddNodeIndex(-1),
-                           /*p=*/1));
+  AppendNode(BddNode(BddVariable(-1), BddNodeIndex(-1), BddNodeIndex(-1),
+                     /*p=*/1));
   // Leaf node 1.
-  nodes_.push_back(BddNode(BddVariable(-1), BddNodeIndex(-1), BddNodeIndex(-1),
-                           /*p=*/1));
+  AppendNode(BddNode(BddVariable(-1), BddNodeIndex(-1), BddNodeIndex(-1),
+                     /*p=*/1));
+}
+
+BinaryDecisionDiagram::~BinaryDecisionDiagram() {
+  for (std::atomic<BddNode*>& chunk : node_chunks_) {
+    delete[] chunk.load(std::memory_order_relaxed);
+  }
+}
+
+BddNodeIndex BinaryDecisionDiagram::AppendNode(const BddNode& node) {
+  int64_t index = node_count_.load(std::memory_order_relaxed);
+  int64_t chunk = ChunkForIndex(index);
+  CHECK_LT(chunk, kMaxNodeChunks);
+  BddNode* chunk_data = node_chunks_[chunk].load(std::memory_order_relaxed);
+  if (chunk_data == nullptr) {
+    chunk_data = new BddNode[ChunkSize(chunk)];
+    node_chunks_[chunk].store(chunk_data, std::memory_order_release);
+  }
+  chunk_data[index - ChunkBaseIndex(chunk)] = node;
+  // Publish the new node only after its contents are written so concurrent
+  // lock-free readers never see a partially constructed node.
+  node_count_.store(index + 1, std::memory_order_release);
+  return BddNodeIndex(index);
 }
 
 BddNodeIndex BinaryDecisionDiagram::GetOrCreateNode(BddVariable var,
@@ -57,8 +82,7 @@ BddNodeIndex BinaryDecisionDiagram::GetOrCreateNode(BddVariable var,
   int32_t paths = std::min(
       static_cast<int64_t>(GetNode(low).path_count) + GetNode(high).path_count,
       static_cast<int64_t>(std::numeric_limits<int32_t>::max()));
-  nodes_.emplace_back(var, high, low, paths);
-  BddNodeIndex node_index = BddNodeIndex(nodes_.size() - 1);
+  BddNodeIndex node_index = AppendNode(BddNode(var, high, low, paths));
   node_map_[key] = node_index;
   return node_index;
 }
@@ -135,26 +159,32 @@ BddNodeIndex BinaryDecisionDiagram::IfThenElse(BddNodeIndex cond,
 }
 
 BddNodeIndex BinaryDecisionDiagram::NewVariable() {
+  absl::MutexLock lock(&mutex_);
   BddVariable var = next_var_;
   ++next_var_;
   return GetOrCreateNode(var, one(), zero());
 }
 
 BddNodeIndex BinaryDecisionDiagram::Not(BddNodeIndex expr) {
+  absl::MutexLock lock(&mutex_);
   return IfThenElse(expr, zero(), one());
 }
 
 BddNodeIndex BinaryDecisionDiagram::Or(BddNodeIndex a, BddNodeIndex b) {
+  absl::MutexLock lock(&mutex_);
   return IfThenElse(a, one(), b);
 }
 
 BddNodeIndex BinaryDecisionDiagram::And(BddNodeIndex a, BddNodeIndex b) {
+  absl::MutexLock lock(&mutex_);
   return IfThenElse(a, b, zero());
 }
 
 absl::StatusOr<bool> BinaryDecisionDiagram::Evaluate(
     BddNodeIndex expr,
     const absl::flat_hash_map<BddNodeIndex, bool>& variable_values) const {
+  // Locked for the node_map_ lookup in GetVariableBaseNode.
+  absl::MutexLock lock(&mutex_);
   BddNodeIndex result = expr;
   VLOG(2) << "Evaluating node: " << static_cast<int64_t>(expr);
   VLOG(2) << "  expression = " << ToStringDnf(expr, /*minterm_limit=*/5);
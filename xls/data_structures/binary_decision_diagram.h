@@ -15,13 +15,19 @@
 #ifndef XLS_DATA_STRUCTURES_BINARY_DECISION_DIAGRAM_H_
 #define XLS_DATA_STRUCTURES_BINARY_DECISION_DIAGRAM_H_
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <string>
 #include <tuple>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/numeric/bits.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "xls/common/strong_int.h"
 
 namespace xls {
@@ -34,6 +40,12 @@ namespace xls {
 //   K.S. Brace, R.L. Rudell, and R.E. Bryant,
 //   "Efficient Implementation of a BDD package"
 //   https://ieeexplore.ieee.org/document/114826
+//
+// The BDD may be shared between threads: expression-building operations
+// (NewVariable, Not, And, Or, Evaluate) are internally serialized, and nodes
+// are stored in a chunked arena so references returned by GetNode remain valid
+// while other threads create nodes. Read-only accessors (GetNode, size,
+// path_count) are lock-free.
 
 // For efficiency variables and nodes are referred to by indices into vector
 // data members in the BDD.
@@ -63,6 +75,10 @@ class BinaryDecisionDiagram {
   // Creates an empty BDD. Initialize the BDD contains only the nodes
   // corresponding to zero and one.
   BinaryDecisionDiagram();
+  ~BinaryDecisionDiagram();
+
+  BinaryDecisionDiagram(const BinaryDecisionDiagram&) = delete;
+  BinaryDecisionDiagram& operator=(const BinaryDecisionDiagram&) = delete;
 
   // Adds a new variable to the BDD and returns the node corresponding the
   // variable's value.
@@ -87,16 +103,25 @@ class BinaryDecisionDiagram {
       BddNodeIndex expr,
       const absl::flat_hash_map<BddNodeIndex, bool>& variable_values) const;
 
-  // Returns the BDD node with the given index.
+  // Returns the BDD node with the given index. The returned reference is
+  // stable; it is not invalidated by the creation of other nodes.
   const BddNode& GetNode(BddNodeIndex node_index) const {
-    return nodes_.at(node_index.value());
+    int64_t index = node_index.value();
+    DCHECK_GE(index, 0);
+    DCHECK_LT(index, node_count_.load(std::memory_order_acquire));
+    int64_t chunk = ChunkForIndex(index);
+    return node_chunks_[chunk].load(std::memory_order_acquire)
+        [index - ChunkBaseIndex(chunk)];
   }
 
   // Returns the number of nodes in the graph.
-  int64_t size() const { return nodes_.size(); }
+  int64_t size() const { return node_count_.load(std::memory_order_acquire); }
 
   // Returns the number of variables in the graph.
-  int64_t variable_count() const { return next_var_.value(); }
+  int64_t variable_count() const {
+    absl::MutexLock lock(&mutex_);
+    return next_var_.value();
+  }
 
   // Returns the number of paths in the given expression.
   int64_t path_count(BddNodeIndex expr) const {
@@ -124,7 +149,8 @@ class BinaryDecisionDiagram {
   // Get the node corresponding to the given variable with the given low/high
   // children. Creates it if it does not exist.
   BddNodeIndex GetOrCreateNode(BddVariable var, BddNodeIndex high,
-                               BddNodeIndex low);
+                               BddNodeIndex low)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // Returns the node equal to given expression with the given variable
   // set to the given value.
@@ -132,31 +158,71 @@ class BinaryDecisionDiagram {
 
   // Returns the node corresponding to the given if-then-else expression.
   BddNodeIndex IfThenElse(BddNodeIndex cond, BddNodeIndex if_true,
-                          BddNodeIndex if_false);
+                          BddNodeIndex if_false)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   // Returns the node corresponding to the value of the given variable.
-  BddNodeIndex GetVariableBaseNode(BddVariable variable) const {
+  BddNodeIndex GetVariableBaseNode(BddVariable variable) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
     return node_map_.at({variable, one(), zero()});
   }
 
+  // Appends a node to the arena and returns its index. Allocates a new chunk
+  // if the current one is full. The node is published (via node_count_) only
+  // after its contents are written so lock-free readers never observe a
+  // partially constructed node.
+  BddNodeIndex AppendNode(const BddNode& node)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Nodes are stored in a sequence of chunks of geometrically increasing size;
+  // chunk i holds ChunkSize(i) == 2^(kFirstChunkSizeLog2 + i) nodes starting
+  // at index ChunkBaseIndex(i) == 2^kFirstChunkSizeLog2 * (2^i - 1). The
+  // fixed-size top-level array means no existing storage is ever moved when
+  // the BDD grows, so node references are stable and GetNode needs no lock.
+  // kMaxNodeChunks chunks are sufficient to cover every index representable by
+  // BddNodeIndex (int32_t).
+  static constexpr int64_t kFirstChunkSizeLog2 = 12;  // 4096 nodes.
+  static constexpr int64_t kMaxNodeChunks = 20;
+
+  static int64_t ChunkForIndex(int64_t index) {
+    return absl::bit_width(
+               static_cast<uint64_t>((index >> kFirstChunkSizeLog2) + 1)) -
+           1;
+  }
+  static int64_t ChunkBaseIndex(int64_t chunk) {
+    return ((int64_t{1} << chunk) - 1) << kFirstChunkSizeLog2;
+  }
+  static int64_t ChunkSize(int64_t chunk) {
+    return int64_t{1} << (kFirstChunkSizeLog2 + chunk);
+  }
+
+  // Serializes node creation (expression building). Lock-free accessors
+  // synchronize with node creation via node_count_ and node_chunks_.
+  mutable absl::Mutex mutex_;
+
   // The numeric id to use for the next created variable. Increments with each
   // call to NewVariable which
-  BddVariable next_var_ = BddVariable(0);
+  BddVariable next_var_ ABSL_GUARDED_BY(mutex_) = BddVariable(0);
+
+  // The arena holding all nodes in the BDD. Chunk pointers are written once
+  // (under mutex_) and read lock-free.
+  std::array<std::atomic<BddNode*>, kMaxNodeChunks> node_chunks_ = {};
 
-  // The vector of all the nodes in the BDD.
-  std::vector<BddNode> nodes_;
+  // The number of nodes in the arena. Written with release ordering after a
+  // node's contents are in place; read with acquire ordering.
+  std::atomic<int64_t> node_count_ = 0;
 
   // A map from BDD node content (variable id, high child, low child) to the
   // index of the respective node. This map is used to ensure that no duplicate
   // nodes are created.
   using NodeKey = std::tuple<BddVariable, BddNodeIndex, BddNodeIndex>;
-  absl::flat_hash_map<NodeKey, BddNodeIndex> node_map_;
+  absl::flat_hash_map<NodeKey, BddNodeIndex> node_map_ ABSL_GUARDED_BY(mutex_);
 
   // A map from if-then-else expression to the node corresponding to that
   // expression. The key elements are (condition, if-true, if-false). This map
   // enables fast lookup for expressions.
   using IteKey = std::tuple<BddNodeIndex, BddNodeIndex, BddNodeIndex>;
-  absl::flat_hash_map<IteKey, BddNodeIndex> ite_map_;
+  absl::flat_hash_map<IteKey, BddNodeIndex> ite_map_ ABSL_GUARDED_BY(mutex_);
 };
 
 }  // namespace xls
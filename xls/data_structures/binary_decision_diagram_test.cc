@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <limits>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -312,5 +313,68 @@ TEST(BinaryDecisionDiagramTest, ThreeVariableExhaustive) {
   }
 }
 
+TEST(BinaryDecisionDiagramTest, StableNodeReferences) {
+  // References returned by GetNode must remain valid as the BDD grows (the
+  // node store is chunked; it is never reallocated).
+  BinaryDecisionDiagram bdd;
+  BddNodeIndex var0 = bdd.NewVariable();
+  const BddNode* var0_node = &bdd.GetNode(var0);
+
+  // Create enough nodes to span several storage chunks.
+  std::vector<BddNodeIndex> vars;
+  for (int64_t i = 0; i < 20000; ++i) {
+    vars.push_back(bdd.NewVariable());
+  }
+  BddNodeIndex expr = var0;
+  for (BddNodeIndex var : vars) {
+    expr = bdd.Or(expr, var);
+  }
+  EXPECT_GT(bdd.size(), 20000);
+
+  EXPECT_EQ(var0_node, &bdd.GetNode(var0));
+  EXPECT_EQ(var0_node->variable, BddVariable(0));
+}
+
+TEST(BinaryDecisionDiagramTest, ConcurrentExpressionBuilding) {
+  // Multiple threads building expressions over a shared set of variables must
+  // produce the same canonical nodes as serial construction.
+  BinaryDecisionDiagram bdd;
+  constexpr int64_t kNumVariables = 64;
+  std::vector<BddNodeIndex> vars;
+  for (int64_t i = 0; i < kNumVariables; ++i) {
+    vars.push_back(bdd.NewVariable());
+  }
+
+  constexpr int64_t kNumThreads = 8;
+  std::vector<std::vector<BddNodeIndex>> results(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int64_t t = 0; t < kNumThreads; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      // Each thread computes the same AND- and OR-reductions.
+      BddNodeIndex and_reduce = bdd.one();
+      BddNodeIndex or_reduce = bdd.zero();
+      for (int64_t i = 0; i < kNumVariables; ++i) {
+        and_reduce = bdd.And(and_reduce, vars[i]);
+        or_reduce = bdd.Or(or_reduce, vars[i]);
+      }
+      results[t] = {and_reduce, or_reduce};
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // Nodes are hash-consed so every thread must have gotten identical indices.
+  for (int64_t t = 1; t < kNumThreads; ++t) {
+    EXPECT_EQ(results[t], results[0]);
+  }
+  absl::flat_hash_map<BddNodeIndex, bool> all_true;
+  for (BddNodeIndex var : vars) {
+    all_true[var] = true;
+  }
+  EXPECT_THAT(bdd.Evaluate(results[0][0], all_true), IsOkAndHolds(true));
+  EXPECT_THAT(bdd.Evaluate(results[0][1], all_true), IsOkAndHolds(true));
+}
+
 }  // namespace
 }  // namespace xls
@@ -16,8 +16,10 @@
 #define XLS_DATA_STRUCTURES_INLINE_BITMAP_H_
 
 #include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <utility>
 
 #include "absl/base/casts.h"
@@ -142,12 +144,14 @@ class InlineBitmap {
     if (bit_count_ != other.bit_count_) {
       return false;
     }
-    for (int64_t wordno = 0; wordno < word_count(); ++wordno) {
-      if (data_[wordno] != other.data_[wordno]) {
-        return false;
-      }
+    if (word_count() == 0) {
+      return true;
     }
-    return true;
+    // Bits beyond bit_count() are invariantly masked to zero, so whole-word
+    // comparison is exact. memcmp over the contiguous word storage vectorizes
+    // well.
+    return std::memcmp(data_.data(), other.data_.data(),
+                       word_count() * kWordBytes) == 0;
   }
   bool operator!=(const InlineBitmap& other) const { return !(*this == other); }
 
@@ -305,6 +309,43 @@ class InlineBitmap {
     }
   }
 
+  // Sets this bitmap to the bitwise 'xor' of this bitmap and `other`.
+  void Xor(const InlineBitmap& other) {
+    CHECK_EQ(bit_count(), other.bit_count());
+    for (int64_t i = 0; i < data_.size(); ++i) {
+      data_[i] ^= other.data_[i];
+    }
+  }
+
+  // Returns the number of set bits in the bitmap.
+  int64_t CountOnes() const {
+    int64_t count = 0;
+    for (uint64_t word : data_) {
+      count += std::popcount(word);
+    }
+    return count;
+  }
+
+  // Returns the index of the first set bit at an index >= `start`, or
+  // std::nullopt if no such bit is set. Scans a word at a time, so iterating
+  // over the set bits of a sparse bitmap is far cheaper than calling Get() on
+  // every index.
+  std::optional<int64_t> FindNextSetBit(int64_t start) const {
+    DCHECK_GE(start, 0);
+    if (start >= bit_count_) {
+      return std::nullopt;
+    }
+    int64_t wordno = start / kWordBits;
+    uint64_t word = data_[wordno] & (~uint64_t{0} << (start % kWordBits));
+    while (word == 0) {
+      if (++wordno == word_count()) {
+        return std::nullopt;
+      }
+      word = data_[wordno];
+    }
+    return wordno * kWordBits + std::countr_zero(word);
+  }
+
   int64_t byte_count() const { return CeilOfRatio(bit_count_, int64_t{8}); }
   int64_t word_count() const { return data_.size(); }
 
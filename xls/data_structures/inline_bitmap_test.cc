@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <ios>
 #include <limits>
+#include <optional>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -552,6 +553,44 @@ TEST(InlineBitmapTest, WithSize) {
   }
 }
 
+TEST(InlineBitmapTest, CountOnes) {
+  EXPECT_EQ(InlineBitmap(0).CountOnes(), 0);
+  EXPECT_EQ(InlineBitmap(129).CountOnes(), 0);
+  EXPECT_EQ(InlineBitmap(129, /*fill=*/true).CountOnes(), 129);
+
+  InlineBitmap b(200);
+  b.Set(0);
+  b.Set(63);
+  b.Set(64);
+  b.Set(199);
+  EXPECT_EQ(b.CountOnes(), 4);
+}
+
+TEST(InlineBitmapTest, FindNextSetBit) {
+  EXPECT_EQ(InlineBitmap(0).FindNextSetBit(0), std::nullopt);
+  EXPECT_EQ(InlineBitmap(129).FindNextSetBit(0), std::nullopt);
+
+  InlineBitmap b(200);
+  b.Set(5);
+  b.Set(64);
+  b.Set(199);
+  EXPECT_EQ(b.FindNextSetBit(0), 5);
+  EXPECT_EQ(b.FindNextSetBit(5), 5);
+  EXPECT_EQ(b.FindNextSetBit(6), 64);
+  EXPECT_EQ(b.FindNextSetBit(65), 199);
+  EXPECT_EQ(b.FindNextSetBit(199), 199);
+  // A start index at or past the end of the bitmap finds nothing.
+  EXPECT_EQ(b.FindNextSetBit(200), std::nullopt);
+
+  // Iterating over the set bits visits each exactly once.
+  std::vector<int64_t> set_bits;
+  for (std::optional<int64_t> i = b.FindNextSetBit(0); i.has_value();
+       i = b.FindNextSetBit(*i + 1)) {
+    set_bits.push_back(*i);
+  }
+  EXPECT_THAT(set_bits, ElementsAre(5, 64, 199));
+}
+
 }  // namespace
 
 // Note: tests below this point are friended, so cannot live in the anonymous
@@ -91,23 +91,6 @@ std::pair<Type*, int64_t> GetSubtypeAndOffsetHelper(
                                    index.subspan(1), offset + element_offset);
 }
 
-void GetLeafTypesHelper(Type* t, absl::InlinedVector<Type*, 1>* leaf_types) {
-  if (IsLeafType(t)) {
-    leaf_types->push_back(t);
-    return;
-  }
-  if (t->IsArray()) {
-    for (int64_t i = 0; i < t->AsArrayOrDie()->size(); ++i) {
-      GetLeafTypesHelper(t->AsArrayOrDie()->element_type(), leaf_types);
-    }
-    return;
-  }
-  CHECK(t->IsTuple());
-  for (int64_t i = 0; i < t->AsTupleOrDie()->size(); ++i) {
-    GetLeafTypesHelper(t->AsTupleOrDie()->element_type(i), leaf_types);
-  }
-}
-
 std::string ToStringHelper(Type* subtype,
                            absl::Span<const std::string> elements,
                            bool multiline, int64_t indent,
@@ -232,12 +215,6 @@ std::pair<Type*, int64_t> GetSubtypeAndOffset(Type* t,
   return GetSubtypeAndOffsetHelper(t, index, /*offset=*/0);
 }
 
-absl::InlinedVector<Type*, 1> GetLeafTypes(Type* t) {
-  absl::InlinedVector<Type*, 1> leaf_types;
-  GetLeafTypesHelper(t, &leaf_types);
-  return leaf_types;
-}
-
 int64_t GetLeafTypeOffset(Type* t, absl::Span<int64_t const> index) {
   auto [subtype, offset] = GetSubtypeAndOffset(t, index);
   CHECK(IsLeafType(subtype));
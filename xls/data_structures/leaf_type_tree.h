@@ -50,10 +50,6 @@ namespace leaf_type_tree_internal {
 std::pair<Type*, int64_t> GetSubtypeAndOffset(Type* t,
                                               absl::Span<int64_t const> index);
 
-// Returns the leaf types for the type `t`. Returned as an inlined vector to
-// match internal storage of LeafTypeTree.
-absl::InlinedVector<Type*, 1> GetLeafTypes(Type* t);
-
 // Returns the leaf element linear offset in the flattened representation of
 // type `t` for the given type-index `index`. CHECK fails if the index is not
 // the index of a leaf element.
@@ -348,7 +344,6 @@ template <typename T>
 class LeafTypeTree {
  public:
   using DataContainerT = absl::InlinedVector<T, 1>;
-  using TypeContainerT = absl::InlinedVector<Type*, 1>;
 
   LeafTypeTree() : type_(nullptr) {}
   LeafTypeTree(const LeafTypeTree<T>& other) = default;
@@ -360,22 +355,16 @@ class LeafTypeTree {
 
   // Creates a leaf type tree in which each data member is default constructed.
   explicit LeafTypeTree(Type* type)
-      : type_(type),
-        elements_(type->leaf_count()),
-        leaf_types_(leaf_type_tree_internal::GetLeafTypes(type)) {}
+      : type_(type), elements_(type->leaf_count()) {}
 
   // Creates a leaf type tree in which each data member set to `init_value`.
   LeafTypeTree(Type* type, const T& init_value)
-      : type_(type),
-        elements_(type->leaf_count(), init_value),
-        leaf_types_(leaf_type_tree_internal::GetLeafTypes(type)) {}
+      : type_(type), elements_(type->leaf_count(), init_value) {}
 
   // Constructor which takes a flattened representation of the leaf elements.
   LeafTypeTree(Type* type, absl::Span<const T> elements)
-      : type_(type),
-        elements_(elements.begin(), elements.end()),
-        leaf_types_(leaf_type_tree_internal::GetLeafTypes(type)) {
-    CHECK_EQ(elements_.size(), leaf_types_.size());
+      : type_(type), elements_(elements.begin(), elements.end()) {
+    CHECK_EQ(elements_.size(), type->leaf_count());
   }
 
   // Factory for efficiently constructing a LeafTypeTree by moving in the vector
@@ -385,8 +374,7 @@ class LeafTypeTree {
     CHECK_EQ(elements.size(), type->leaf_count());
     LeafTypeTree<T> ltt;
     ltt.type_ = type;
-    ltt.elements_ = elements;
-    ltt.leaf_types_ = leaf_type_tree_internal::GetLeafTypes(type);
+    ltt.elements_ = std::move(elements);
     return ltt;
   }
 
@@ -396,7 +384,6 @@ class LeafTypeTree {
     LeafTypeTree<T> ltt;
     ltt.type_ = type;
     ltt.elements_ = {element};
-    ltt.leaf_types_ = leaf_type_tree_internal::GetLeafTypes(type);
     return ltt;
   }
 
@@ -447,9 +434,20 @@ class LeafTypeTree {
     return absl::Span<T const>(elements_);
   }
 
+  // Consumes this tree and returns its flat element storage, leaving the tree
+  // in the default-constructed (empty) state. Used by LeafTypeTreePool to
+  // recycle allocations.
+  DataContainerT ReleaseElements() && {
+    type_ = nullptr;
+    return std::move(elements_);
+  }
+
   // Returns the types of each leaf in the XLS type of this object. The order
-  // of these types corresponds to the order of elements().
-  absl::Span<Type* const> leaf_types() const { return leaf_types_; }
+  // of these types corresponds to the order of elements(). The leaf types are
+  // cached on the Type itself so no per-instance storage is required.
+  absl::Span<Type* const> leaf_types() const {
+    return type_ == nullptr ? absl::Span<Type* const>() : type_->leaf_types();
+  }
 
   // Returns an immutable view of the LeafTypeTree.
   LeafTypeTreeView<T> AsView(absl::Span<const int64_t> index = {}) const
@@ -512,7 +510,6 @@ class LeafTypeTree {
  protected:
   Type* type_;
   DataContainerT elements_;
-  TypeContainerT leaf_types_;
 };
 
 namespace leaf_type_tree_internal {
@@ -742,6 +739,22 @@ LeafTypeTree<T> Zip(LeafTypeTreeView<A> a, LeafTypeTreeView<A> b,
   return result.value();
 }
 
+// In-place form of Zip: combines each corresponding leaf element of `a` and
+// `b` into `dest` without allocating a new LeafTypeTree. `dest` may alias one
+// of the inputs. Returns an error if the views are not generated from the
+// same type.
+template <typename T, typename A>
+absl::Status ZipInto(MutableLeafTypeTreeView<T> dest, LeafTypeTreeView<A> a,
+                     LeafTypeTreeView<A> b,
+                     const std::function<T(const A&, const A&)>& f) {
+  XLS_RET_CHECK_EQ(dest.type(), a.type());
+  XLS_RET_CHECK_EQ(dest.type(), b.type());
+  for (int64_t i = 0; i < dest.size(); ++i) {
+    dest.elements()[i] = f(a.elements()[i], b.elements()[i]);
+  }
+  return absl::OkStatus();
+}
+
 // Produce a new `LeafTypeTree` from this one `LeafTypeTreeView` with a
 // different leaf type by way of a function.
 template <typename T, typename R>
@@ -0,0 +1,70 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DATA_STRUCTURES_LEAF_TYPE_TREE_POOL_H_
+#define XLS_DATA_STRUCTURES_LEAF_TYPE_TREE_POOL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "xls/data_structures/leaf_type_tree.h"
+#include "xls/ir/type.h"
+
+namespace xls {
+
+// A free-list pool which recycles the flat element storage of LeafTypeTree
+// instances. Code which creates and destroys many trees of the same type
+// shapes (e.g., per-node dataflow state in optimization passes) can acquire
+// trees from a pool and release them when done instead of allocating fresh
+// storage each time. Not thread-safe.
+template <typename T>
+class LeafTypeTreePool {
+ public:
+  // Returns a tree of `type` with every leaf set to `init_value`
+  // (default-constructed if omitted), reusing the storage of a previously
+  // released tree with the same leaf count when available.
+  LeafTypeTree<T> Acquire(Type* type, const T& init_value = T()) {
+    auto it = free_lists_.find(type->leaf_count());
+    if (it == free_lists_.end() || it->second.empty()) {
+      return LeafTypeTree<T>(type, init_value);
+    }
+    typename LeafTypeTree<T>::DataContainerT elements =
+        std::move(it->second.back());
+    it->second.pop_back();
+    std::fill(elements.begin(), elements.end(), init_value);
+    return LeafTypeTree<T>::CreateFromVector(type, std::move(elements));
+  }
+
+  // Returns the element storage of `ltt` to the pool for reuse by later
+  // Acquire calls.
+  void Release(LeafTypeTree<T>&& ltt) {
+    if (ltt.type() == nullptr || ltt.size() == 0) {
+      return;
+    }
+    free_lists_[ltt.size()].push_back(std::move(ltt).ReleaseElements());
+  }
+
+ private:
+  // Free lists of element storage keyed by leaf count.
+  absl::flat_hash_map<int64_t,
+                      std::vector<typename LeafTypeTree<T>::DataContainerT>>
+      free_lists_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_DATA_STRUCTURES_LEAF_TYPE_TREE_POOL_H_
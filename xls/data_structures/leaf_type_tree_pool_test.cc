@@ -0,0 +1,87 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/data_structures/leaf_type_tree_pool.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "xls/data_structures/leaf_type_tree.h"
+#include "xls/ir/package.h"
+#include "xls/ir/type.h"
+
+namespace xls {
+namespace {
+
+using ::testing::ElementsAre;
+
+class LeafTypeTreePoolTest : public ::testing::Test {
+ protected:
+  LeafTypeTreePoolTest() : package_("LeafTypeTreePoolTest") {}
+
+  Package package_;
+};
+
+TEST_F(LeafTypeTreePoolTest, AcquireReleaseReusesStorage) {
+  Type* type = package_.GetTupleType(
+      {package_.GetBitsType(32), package_.GetBitsType(8)});
+  LeafTypeTreePool<int64_t> pool;
+
+  LeafTypeTree<int64_t> tree = pool.Acquire(type, /*init_value=*/7);
+  EXPECT_EQ(tree.type(), type);
+  EXPECT_THAT(tree.elements(), ElementsAre(7, 7));
+
+  tree.Set({0}, 42);
+  const int64_t* storage = tree.elements().data();
+  pool.Release(std::move(tree));
+
+  // Reacquiring a tree with the same leaf count reuses the released storage
+  // and reinitializes the elements.
+  LeafTypeTree<int64_t> reused = pool.Acquire(type);
+  EXPECT_EQ(reused.elements().data(), storage);
+  EXPECT_THAT(reused.elements(), ElementsAre(0, 0));
+}
+
+TEST_F(LeafTypeTreePoolTest, StorageSharedAcrossSameLeafCountTypes) {
+  Type* tuple_type = package_.GetTupleType(
+      {package_.GetBitsType(32), package_.GetBitsType(8)});
+  Type* array_type = package_.GetArrayType(2, package_.GetBitsType(16));
+  LeafTypeTreePool<int64_t> pool;
+
+  LeafTypeTree<int64_t> tree = pool.Acquire(tuple_type);
+  const int64_t* storage = tree.elements().data();
+  pool.Release(std::move(tree));
+
+  // The free list is keyed by leaf count, not by type, so a differently
+  // shaped type with the same number of leaves can reuse the storage.
+  LeafTypeTree<int64_t> reused = pool.Acquire(array_type, /*init_value=*/3);
+  EXPECT_EQ(reused.type(), array_type);
+  EXPECT_EQ(reused.elements().data(), storage);
+  EXPECT_THAT(reused.elements(), ElementsAre(3, 3));
+}
+
+TEST_F(LeafTypeTreePoolTest, EmptyPoolAllocatesFresh) {
+  Type* type = package_.GetBitsType(1);
+  LeafTypeTreePool<int64_t> pool;
+  LeafTypeTree<int64_t> a = pool.Acquire(type, /*init_value=*/1);
+  LeafTypeTree<int64_t> b = pool.Acquire(type, /*init_value=*/2);
+  EXPECT_NE(a.elements().data(), b.elements().data());
+  EXPECT_THAT(a.elements(), ElementsAre(1));
+  EXPECT_THAT(b.elements(), ElementsAre(2));
+}
+
+}  // namespace
+}  // namespace xls
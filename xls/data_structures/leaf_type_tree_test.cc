@@ -909,6 +909,28 @@ TEST_F(LeafTypeTreeTest, ZipMultiple) {
 ))");
 }
 
+TEST_F(LeafTypeTreeTest, ZipInto) {
+  Type* type = AsType("(bits[32][2], bits[2])");
+  LeafTypeTree<int64_t> input0(type, {10, 20, 30});
+  LeafTypeTree<int64_t> input1(type, {1, 2, 3});
+  LeafTypeTree<int64_t> dest(type);
+  XLS_ASSERT_OK(leaf_type_tree::ZipInto<int64_t, int64_t>(
+      dest.AsMutableView(), input0.AsView(), input1.AsView(),
+      [](const int64_t& a, const int64_t& b) { return a + b; }));
+  EXPECT_THAT(dest.elements(), ElementsAre(11, 22, 33));
+}
+
+TEST_F(LeafTypeTreeTest, ZipIntoTypeMismatch) {
+  LeafTypeTree<int64_t> input0(AsType("(bits[32], bits[2])"));
+  LeafTypeTree<int64_t> input1(AsType("(bits[32], bits[2])"));
+  LeafTypeTree<int64_t> dest(AsType("(bits[32], bits[7])"));
+  EXPECT_THAT(
+      leaf_type_tree::ZipInto<int64_t, int64_t>(
+          dest.AsMutableView(), input0.AsView(), input1.AsView(),
+          [](const int64_t& a, const int64_t& b) { return a + b; }),
+      StatusIs(absl::StatusCode::kInternal, HasSubstr("dest.type()")));
+}
+
 TEST_F(LeafTypeTreeTest, CreateFromFunction) {
   Type* type = AsType("(bits[32][2], bits[2])");
   LeafTypeTree<std::string> result =
@@ -274,16 +274,169 @@ int64_t AugmentFlow(const Graph& graph, NodeId source, NodeId sink,
   return 0;
 }
 
+// Node count at which MinCutBetweenNodes switches from the augmenting-path
+// method to push-relabel. On small graphs the augmenting-path method typically
+// terminates after a handful of BFS passes; push-relabel's advantage appears
+// on the large graphs produced by min-cut scheduling of wide functions.
+constexpr int64_t kPushRelabelNodeThreshold = 256;
+
+// Clamps effectively-infinite edge capacities in the residual graph in
+// preparation for running push-relabel. Capacities exceeding the sum of all
+// finite edge weights can never constrain the min cut, so clamping them to
+// that sum plus one does not change the result. The clamp bounds the excess
+// which can accumulate at a node during push-relabel, which would otherwise
+// overflow when multiple maximum-weight edges push into the same node.
+// Returns false (leaving capacities untouched) if the finite weights
+// themselves overflow; in that case the caller must use the augmenting-path
+// method which never accumulates flow at intermediate nodes.
+bool ClampEffectivelyInfiniteCapacities(const Graph& graph,
+                                        ResidualGraph* residual_graph) {
+  int64_t finite_weight_total = 0;
+  for (EdgeId edge_id = EdgeId{0}; edge_id <= graph.max_edge_id();
+       edge_id += EdgeId{1}) {
+    int64_t weight = graph.edge(edge_id).weight;
+    if (weight == std::numeric_limits<int64_t>::max()) {
+      continue;
+    }
+    if (finite_weight_total > std::numeric_limits<int64_t>::max() - weight) {
+      return false;
+    }
+    finite_weight_total += weight;
+  }
+  if (finite_weight_total == std::numeric_limits<int64_t>::max()) {
+    return false;
+  }
+  int64_t capacity_clamp = finite_weight_total + 1;
+  // Only forward edges need clamping; backward edges start at zero capacity
+  // and never exceed the (clamped) weight of their dual.
+  for (EdgeId edge_id = EdgeId{0}; edge_id <= graph.max_edge_id();
+       edge_id += EdgeId{1}) {
+    ResidualEdge& edge = residual_graph->edge(edge_id);
+    edge.capacity = std::min(edge.capacity, capacity_clamp);
+  }
+  return true;
+}
+
+// Computes a maximum flow from source to sink using the push-relabel method
+// with FIFO selection of active nodes and the gap relabeling heuristic. Rather
+// than augmenting flow along complete source-to-sink paths, the method pushes
+// excess flow downhill along a height function which is lazily raised
+// (relabeled) as nodes run out of admissible edges. Worst case run time is
+// O(V^3) which is superior to the augmenting path method on large dense
+// graphs. On return 'residual_graph' holds the residual capacities of a
+// maximum flow.
+void PushRelabelMaxFlow(const Graph& graph, NodeId source, NodeId sink,
+                        ResidualGraph* residual_graph) {
+  const int64_t node_count = graph.node_count();
+  std::vector<int64_t> height(node_count, 0);
+  std::vector<int64_t> excess(node_count, 0);
+  // Number of nodes at each height. Used to detect gaps in the height
+  // function. Heights are bounded by 2 * node_count.
+  std::vector<int64_t> height_count(2 * node_count + 1, 0);
+  // Index into the successor list of each node of the next edge to consider
+  // for a push (the "current arc" optimization).
+  std::vector<int64_t> current_arc(node_count, 0);
+  std::vector<bool> active(node_count, false);
+  std::deque<NodeId> fifo;
+
+  auto activate = [&](NodeId node) {
+    if (!active[int64_t{node}] && node != source && node != sink) {
+      active[int64_t{node}] = true;
+      fifo.push_back(node);
+    }
+  };
+
+  height[int64_t{source}] = node_count;
+  height_count[0] = node_count - 1;
+  height_count[node_count] = 1;
+
+  // Saturate all edges out of the source to create the initial excess.
+  for (EdgeId edge_id : residual_graph->successors(source)) {
+    ResidualEdge& edge = residual_graph->edge(edge_id);
+    if (edge.capacity > 0 && edge.to != source) {
+      excess[int64_t{edge.to}] += edge.capacity;
+      residual_graph->PushFlow(edge.capacity, &edge);
+      activate(edge.to);
+    }
+  }
+
+  while (!fifo.empty()) {
+    NodeId node = fifo.front();
+    fifo.pop_front();
+    active[int64_t{node}] = false;
+
+    // Discharge the node: push its excess along admissible edges (edges with
+    // residual capacity leading exactly one height level down), relabeling the
+    // node whenever its admissible edges are exhausted.
+    int64_t& node_excess = excess[int64_t{node}];
+    while (node_excess > 0) {
+      absl::Span<const EdgeId> successors = residual_graph->successors(node);
+      if (current_arc[int64_t{node}] ==
+          static_cast<int64_t>(successors.size())) {
+        // No admissible edge remains. Relabel the node to one more than its
+        // lowest neighbor reachable through an edge with residual capacity. A
+        // node with excess always has such a neighbor: the backward edge of
+        // whichever edge delivered the excess.
+        const int64_t old_height = height[int64_t{node}];
+        int64_t new_height = 2 * node_count;
+        for (EdgeId edge_id : successors) {
+          const ResidualEdge& edge = residual_graph->edge(edge_id);
+          if (edge.capacity > 0) {
+            new_height = std::min(new_height, height[int64_t{edge.to}] + 1);
+          }
+        }
+        CHECK_LT(new_height, 2 * node_count);
+        current_arc[int64_t{node}] = 0;
+        height_count[old_height]--;
+        height[int64_t{node}] = new_height;
+        height_count[new_height]++;
+
+        // Gap heuristic: if no node remains at old_height then no node with a
+        // height in (old_height, node_count) can ever push its excess to the
+        // sink. Lift them above the source so their excess drains straight
+        // back to it.
+        if (height_count[old_height] == 0 && old_height < node_count) {
+          for (int64_t i = 0; i < node_count; ++i) {
+            if (height[i] > old_height && height[i] < node_count) {
+              height_count[height[i]]--;
+              height[i] = node_count + 1;
+              height_count[node_count + 1]++;
+            }
+          }
+        }
+        continue;
+      }
+
+      ResidualEdge& edge =
+          residual_graph->edge(successors[current_arc[int64_t{node}]]);
+      if (edge.capacity > 0 &&
+          height[int64_t{node}] == height[int64_t{edge.to}] + 1) {
+        int64_t amount = std::min(node_excess, edge.capacity);
+        residual_graph->PushFlow(amount, &edge);
+        node_excess -= amount;
+        excess[int64_t{edge.to}] += amount;
+        activate(edge.to);
+      } else {
+        current_arc[int64_t{node}]++;
+      }
+    }
+  }
+}
+
 }  // namespace
 
 GraphCut MinCutBetweenNodes(const Graph& graph, NodeId source, NodeId sink) {
-  // This loop is the core of the Ford-Fulkerson method. Starting with zero flow
-  // on all edges, flow is increased along a path from source to sink with
-  // residual capacity (called an augmenting path). When no further augmenting
-  // paths exist, flow has been maximized. 'flow' is the flow of each edge in
-  // the graph indexed by EdgeId.
   ResidualGraph residual_graph(graph);
-  while (AugmentFlow(graph, source, sink, &residual_graph) > 0) {
+  if (graph.node_count() >= kPushRelabelNodeThreshold &&
+      ClampEffectivelyInfiniteCapacities(graph, &residual_graph)) {
+    PushRelabelMaxFlow(graph, source, sink, &residual_graph);
+  } else {
+    // This loop is the core of the Ford-Fulkerson method. Starting with zero
+    // flow on all edges, flow is increased along a path from source to sink
+    // with residual capacity (called an augmenting path). When no further
+    // augmenting paths exist, flow has been maximized.
+    while (AugmentFlow(graph, source, sink, &residual_graph) > 0) {
+    }
   }
 
   // Once a maximum flow is found, walk the residual graph from the source. All
@@ -283,6 +283,48 @@ TEST(MinCutTest, LargeDirectedGraphs) {
   }
 }
 
+TEST(MinCutTest, WideBipartiteGraph) {
+  // A graph wide enough to exercise the push-relabel path: the source feeds
+  // many middle nodes with weight-2 edges and each middle node feeds the sink
+  // with a weight-1 edge. The unique min cut saturates the middle-to-sink
+  // edges.
+  constexpr int64_t kMiddleNodeCount = 300;
+  Graph graph;
+  NodeId source = graph.AddNode("source");
+  NodeId sink = graph.AddNode("sink");
+  for (int64_t i = 0; i < kMiddleNodeCount; ++i) {
+    NodeId middle = graph.AddNode(absl::StrFormat("middle_%d", i));
+    graph.AddEdge(source, middle, 2);
+    graph.AddEdge(middle, sink, 1);
+  }
+  GraphCut min_cut = MinCutBetweenNodes(graph, source, sink);
+  EXPECT_EQ(min_cut.weight, kMiddleNodeCount);
+  EXPECT_EQ(min_cut.source_partition.size(), kMiddleNodeCount + 1);
+  EXPECT_THAT(min_cut.sink_partition, UnorderedElementsAre(sink));
+}
+
+TEST(MinCutTest, LargeGraphWithInfiniteWeightEdges) {
+  // Like WideBipartiteGraph but with effectively-infinite source and sink
+  // edges around a finite-weight middle layer, mirroring how the min-cut
+  // scheduler pins nodes to a stage. Exercises the capacity clamping performed
+  // before push-relabel.
+  constexpr int64_t kChainCount = 150;
+  Graph graph;
+  NodeId source = graph.AddNode("source");
+  NodeId sink = graph.AddNode("sink");
+  for (int64_t i = 0; i < kChainCount; ++i) {
+    NodeId a = graph.AddNode(absl::StrFormat("a_%d", i));
+    NodeId b = graph.AddNode(absl::StrFormat("b_%d", i));
+    graph.AddEdge(source, a, std::numeric_limits<int64_t>::max());
+    graph.AddEdge(a, b, 3);
+    graph.AddEdge(b, sink, std::numeric_limits<int64_t>::max());
+  }
+  GraphCut min_cut = MinCutBetweenNodes(graph, source, sink);
+  EXPECT_EQ(min_cut.weight, 3 * kChainCount);
+  EXPECT_EQ(min_cut.source_partition.size(), kChainCount + 1);
+  EXPECT_EQ(min_cut.sink_partition.size(), kChainCount + 1);
+}
+
 TEST(MinCutTest, MaxFlowToMinCutTraversalTest) {
   // Test a fix for b/155115565 where the residual graph was not properly
   // traversed to identify the partitions after max flow was computed.
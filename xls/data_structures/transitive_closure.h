@@ -15,19 +15,42 @@
 #ifndef XLS_DATA_STRUCTURES_TRANSITIVE_CLOSURE_H_
 #define XLS_DATA_STRUCTURES_TRANSITIVE_CLOSURE_H_
 
+#include <algorithm>
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
-#include "absl/strings/str_format.h"
+#include "xls/data_structures/inline_bitmap.h"
 
 namespace xls {
 
 template <typename V>
 using HashRelation = absl::flat_hash_map<V, absl::flat_hash_set<V>>;
 
-// Compute the transitive closure of a relation.
+// Computes the transitive closure of a dense relation in place: bit j of row
+// i is set iff i relates to j. Rows are updated with word-parallel unions
+// (Warshall's algorithm; https://cs.winona.edu/lin/cs440/ch08-2.pdf), so the
+// cost is O(V^3 / 64) over contiguous bitmap words rather than per-element
+// hash operations.
+inline void TransitiveClosure(std::vector<InlineBitmap>& rows) {
+  const int64_t n = rows.size();
+  for (int64_t k = 0; k < n; ++k) {
+    const InlineBitmap& row_k = rows[k];
+    for (int64_t i = 0; i < n; ++i) {
+      // Skip i == k; unioning a row into itself is a no-op and would alias.
+      if (i != k && rows[i].Get(k)) {
+        rows[i].Union(row_k);
+      }
+    }
+  }
+}
+
+// Computes the transitive closure of a relation. Adapter over the dense
+// bitmap form above: the nodes are put in a stable order, the relation is
+// packed into one bitmap row per node, and the closure is unpacked back into
+// hash sets.
 template <typename V>
 HashRelation<V> TransitiveClosure(const HashRelation<V>& relation) {
   using Rel = HashRelation<V>;
@@ -54,42 +77,21 @@ HashRelation<V> TransitiveClosure(const HashRelation<V>& relation) {
     node_to_index[ordered_nodes[i]] = i;
   }
 
-  // Warshall's algorithm; https://cs.winona.edu/lin/cs440/ch08-2.pdf
-
-  auto get = [&](const HashRelation<int64_t>& rel, int64_t i,
-                 int64_t j) -> bool {
-    return rel.contains(i) && rel.at(i).contains(j);
-  };
-
-  auto set = [&](HashRelation<int64_t>* rel, int64_t i, int64_t j, bool value) {
-    if (value) {
-      (*rel)[i].insert(j);
-    } else {
-      (*rel)[i].erase(j);
-    }
-  };
-
-  HashRelation<int64_t> lag;
+  std::vector<InlineBitmap> rows(n, InlineBitmap(n));
   for (const auto& [node, children] : relation) {
+    InlineBitmap& row = rows[node_to_index.at(node)];
     for (const auto& child : children) {
-      set(&lag, node_to_index.at(node), node_to_index.at(child), true);
+      row.Set(node_to_index.at(child));
     }
   }
-  HashRelation<int64_t> closure = lag;
-  for (int64_t k = 0; k < n; ++k) {
-    for (int64_t i = 0; i < n; ++i) {
-      for (int64_t j = 0; j < n; ++j) {
-        set(&closure, i, j,
-            get(lag, i, j) || (get(lag, i, k) && get(lag, k, j)));
-      }
-    }
-    lag = closure;
-  }
+
+  TransitiveClosure(rows);
 
   Rel result;
-  for (const auto& [node_index, children_indices] : closure) {
-    for (const auto& child_index : children_indices) {
-      result[ordered_nodes[node_index]].insert(ordered_nodes[child_index]);
+  for (int64_t i = 0; i < n; ++i) {
+    for (std::optional<int64_t> j = rows[i].FindNextSetBit(0); j.has_value();
+         j = rows[i].FindNextSetBit(*j + 1)) {
+      result[ordered_nodes[i]].insert(ordered_nodes[*j]);
     }
   }
 
@@ -15,11 +15,13 @@
 #include "xls/data_structures/transitive_closure.h"
 
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "xls/data_structures/inline_bitmap.h"
 
 namespace xls {
 namespace {
@@ -43,5 +45,31 @@ TEST(TransitiveClosureTest, Simple) {
   EXPECT_FALSE(tc.contains("qux"));
 }
 
+TEST(TransitiveClosureTest, Cycle) {
+  HashRelation<V> rel;
+  rel["foo"].insert("bar");
+  rel["bar"].insert("foo");
+  rel["bar"].insert("baz");
+  HashRelation<V> tc = TransitiveClosure<V>(rel);
+  EXPECT_THAT(tc.at("foo"), UnorderedElementsAre("foo", "bar", "baz"));
+  EXPECT_THAT(tc.at("bar"), UnorderedElementsAre("foo", "bar", "baz"));
+  EXPECT_FALSE(tc.contains("baz"));
+}
+
+TEST(TransitiveClosureTest, DenseForm) {
+  // 0 -> 1 -> 2, 3 isolated.
+  std::vector<InlineBitmap> rows(4, InlineBitmap(4));
+  rows[0].Set(1);
+  rows[1].Set(2);
+  TransitiveClosure(rows);
+  EXPECT_TRUE(rows[0].Get(1));
+  EXPECT_TRUE(rows[0].Get(2));
+  EXPECT_FALSE(rows[0].Get(0));
+  EXPECT_FALSE(rows[0].Get(3));
+  EXPECT_TRUE(rows[1].Get(2));
+  EXPECT_EQ(rows[2].CountOnes(), 0);
+  EXPECT_EQ(rows[3].CountOnes(), 0);
+}
+
 }  // namespace
 }  // namespace xls
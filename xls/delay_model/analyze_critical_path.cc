@@ -14,15 +14,18 @@
 
 #include "xls/delay_model/analyze_critical_path.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xls/common/math_util.h"
@@ -39,14 +42,21 @@ namespace xls {
 absl::StatusOr<std::vector<CriticalPathEntry>> AnalyzeCriticalPath(
     FunctionBase* f, std::optional<int64_t> clock_period_ps,
     const DelayEstimator& delay_estimator) {
-  struct NodeEntry {
-    Node* node;
-
-    // Delay of the node.
-    int64_t node_delay;
+  const std::optional<int64_t> clock_periods_ps[] = {clock_period_ps};
+  XLS_ASSIGN_OR_RETURN(
+      std::vector<std::vector<CriticalPathEntry>> critical_paths,
+      AnalyzeCriticalPaths(f, clock_periods_ps, delay_estimator));
+  return std::move(critical_paths.front());
+}
 
-    // The delay of the critical path in the graph up to and including this node
-    // (includes this node's delay).
+absl::StatusOr<std::vector<std::vector<CriticalPathEntry>>>
+AnalyzeCriticalPaths(FunctionBase* f,
+                     absl::Span<const std::optional<int64_t>> clock_periods_ps,
+                     const DelayEstimator& delay_estimator) {
+  // Per-node, per-configuration arrival information.
+  struct NodeEntry {
+    // The delay of the critical path in the graph up to and including this
+    // node (includes this node's delay).
     int64_t critical_path_delay;
 
     // The predecessor on the critical path through this node.
@@ -56,68 +66,271 @@ absl::StatusOr<std::vector<CriticalPathEntry>> AnalyzeCriticalPath(
     bool delayed_by_cycle_boundary;
   };
 
-  // Map from each node to it's corresponding entry.
-  absl::flat_hash_map<Node*, NodeEntry> node_entries;
+  const int64_t num_configs = clock_periods_ps.size();
 
-  // The node with the greatest critical path delay.
-  std::optional<NodeEntry> latest_entry;
+  // Delay of each node, queried from the delay estimator exactly once.
+  absl::flat_hash_map<Node*, int64_t> node_delays;
+
+  // Map from each node to its per-configuration entries.
+  absl::flat_hash_map<Node*, std::vector<NodeEntry>> node_entries;
+
+  // The node with the greatest critical path delay for each configuration.
+  std::vector<std::optional<Node*>> latest_nodes(num_configs);
 
   for (Node* node : TopoSort(f)) {
-    NodeEntry& entry = node_entries[node];
-    entry.node = node;
-
-    // The maximum delay from any path up to but not including `node`.
-    int64_t max_path_delay = 0;
-    for (Node* operand : node->operands()) {
-      int64_t operand_path_delay = node_entries.at(operand).critical_path_delay;
-      if (operand_path_delay >= max_path_delay) {
-        max_path_delay = node_entries.at(operand).critical_path_delay;
-        entry.critical_path_predecessor = operand;
+    XLS_ASSIGN_OR_RETURN(int64_t node_delay,
+                         delay_estimator.GetOperationDelayInPsFast(node));
+    node_delays[node] = node_delay;
+    std::vector<NodeEntry>& entries = node_entries[node];
+    entries.resize(num_configs);
+    for (int64_t config = 0; config < num_configs; ++config) {
+      NodeEntry& entry = entries[config];
+      const std::optional<int64_t>& clock_period_ps = clock_periods_ps[config];
+
+      // The maximum delay from any path up to but not including `node`.
+      int64_t max_path_delay = 0;
+      for (Node* operand : node->operands()) {
+        int64_t operand_path_delay =
+            node_entries.at(operand)[config].critical_path_delay;
+        if (operand_path_delay >= max_path_delay) {
+          max_path_delay = operand_path_delay;
+          entry.critical_path_predecessor = operand;
+        }
+      }
+
+      // If the dependency straddles a clock boundary we have to make our delay
+      // start from the clock time.
+      entry.delayed_by_cycle_boundary = false;
+      if (clock_period_ps.has_value() &&
+          (((max_path_delay + node_delay) / clock_period_ps.value()) >
+           (max_path_delay / clock_period_ps.value()))) {
+        int64_t new_max_path_delay = RoundDownToNearest(
+            max_path_delay + node_delay, clock_period_ps.value());
+        CHECK_GT(new_max_path_delay, max_path_delay);
+        max_path_delay = new_max_path_delay;
+        entry.delayed_by_cycle_boundary = true;
+      }
+      entry.critical_path_delay = max_path_delay + node_delay;
+
+      std::optional<Node*>& latest_node = latest_nodes[config];
+      if (!latest_node.has_value() ||
+          node_entries.at(latest_node.value())[config].critical_path_delay <=
+              entry.critical_path_delay) {
+        latest_node = node;
       }
     }
-    XLS_ASSIGN_OR_RETURN(entry.node_delay,
-                         delay_estimator.GetOperationDelayInPs(node));
-
-    // If the dependency straddles a clock boundary we have to make our delay
-    // start from the clock time.
-    entry.delayed_by_cycle_boundary = false;
-    if (clock_period_ps.has_value() &&
-        (((max_path_delay + entry.node_delay) / clock_period_ps.value()) >
-         (max_path_delay / clock_period_ps.value()))) {
-      int64_t new_max_path_delay = RoundDownToNearest(
-          max_path_delay + entry.node_delay, clock_period_ps.value());
-      CHECK_GT(new_max_path_delay, max_path_delay);
-      max_path_delay = new_max_path_delay;
-      entry.delayed_by_cycle_boundary = true;
+  }
+
+  // Starting with the operation with the longest path delay, walk back up the
+  // critical path of each configuration constructing CriticalPathEntry's as
+  // we go.
+  std::vector<std::vector<CriticalPathEntry>> critical_paths(num_configs);
+  for (int64_t config = 0; config < num_configs; ++config) {
+    XLS_RET_CHECK(latest_nodes[config].has_value());
+    Node* node = latest_nodes[config].value();
+    while (true) {
+      const NodeEntry& entry = node_entries.at(node)[config];
+      critical_paths[config].push_back(CriticalPathEntry{
+          .node = node,
+          .node_delay_ps = node_delays.at(node),
+          .path_delay_ps = entry.critical_path_delay,
+          .delayed_by_cycle_boundary = entry.delayed_by_cycle_boundary});
+      if (!entry.critical_path_predecessor.has_value()) {
+        break;
+      }
+      node = entry.critical_path_predecessor.value();
     }
-    entry.critical_path_delay = max_path_delay + entry.node_delay;
+  }
 
-    if (!latest_entry.has_value() ||
-        latest_entry->critical_path_delay <= entry.critical_path_delay) {
-      latest_entry = entry;
+  return std::move(critical_paths);
+}
+
+absl::StatusOr<std::vector<CriticalPathEntry>>
+CriticalPathAnalyzer::GetCriticalPath() {
+  XLS_RETURN_IF_ERROR(Refresh());
+
+  // Find the node with the greatest arrival time. Walk in topological order so
+  // ties resolve identically to AnalyzeCriticalPath.
+  Node* latest_node = nullptr;
+  for (Node* node : f_->GetCachedTopoSort()) {
+    if (latest_node == nullptr || entries_.at(latest_node->id()).arrival_ps <=
+                                      entries_.at(node->id()).arrival_ps) {
+      latest_node = node;
     }
   }
+  XLS_RET_CHECK(latest_node != nullptr);
 
-  // Starting with the operation with the longest pat hdelay, walk back up its
-  // critical path constructing CriticalPathEntry's as we go.
   std::vector<CriticalPathEntry> critical_path;
-  XLS_RET_CHECK(latest_entry.has_value());
-  NodeEntry* entry = &(latest_entry.value());
-  while (true) {
+  Node* node = latest_node;
+  while (node != nullptr) {
+    const ArrivalEntry& entry = entries_.at(node->id());
     critical_path.push_back(CriticalPathEntry{
-        .node = entry->node,
-        .node_delay_ps = entry->node_delay,
-        .path_delay_ps = entry->critical_path_delay,
-        .delayed_by_cycle_boundary = entry->delayed_by_cycle_boundary});
-    if (!entry->critical_path_predecessor.has_value()) {
+        .node = node,
+        .node_delay_ps = entry.node_delay_ps,
+        .path_delay_ps = entry.arrival_ps,
+        .delayed_by_cycle_boundary = entry.delayed_by_cycle_boundary});
+    if (entry.predecessor_id == -1) {
       break;
     }
-    entry = &node_entries.at(entry->critical_path_predecessor.value());
+    node = f_->GetNodeById(entry.predecessor_id);
+    XLS_RET_CHECK(node != nullptr);
   }
-
   return std::move(critical_path);
 }
 
+absl::StatusOr<int64_t> CriticalPathAnalyzer::GetArrivalTime(Node* node) {
+  XLS_RET_CHECK_EQ(node->function_base(), f_);
+  XLS_RETURN_IF_ERROR(Refresh());
+  return entries_.at(node->id()).arrival_ps;
+}
+
+absl::StatusOr<int64_t> CriticalPathAnalyzer::GetSlack(Node* node) {
+  XLS_RET_CHECK_EQ(node->function_base(), f_);
+  XLS_RETURN_IF_ERROR(Refresh());
+  if (!slacks_valid_) {
+    XLS_RETURN_IF_ERROR(ComputeSlacks());
+  }
+  return slacks_.at(node->id());
+}
+
+absl::Status CriticalPathAnalyzer::Refresh() {
+  int64_t current_version = f_->transform_version();
+  if (analyzed_version_ == current_version) {
+    return absl::OkStatus();
+  }
+  std::optional<std::vector<int64_t>> changed_ids;
+  if (analyzed_version_ >= 0) {
+    changed_ids = f_->ChangedNodeIdsSince(analyzed_version_);
+  }
+  if (changed_ids.has_value()) {
+    XLS_RETURN_IF_ERROR(UpdateChanged(*changed_ids));
+  } else {
+    // First refresh, or the change journal has been truncated past our
+    // version; recompute everything.
+    XLS_RETURN_IF_ERROR(PopulateAll());
+  }
+  analyzed_version_ = current_version;
+  slacks_valid_ = false;
+  return absl::OkStatus();
+}
+
+absl::Status CriticalPathAnalyzer::PopulateAll() {
+  entries_.clear();
+  for (Node* node : f_->GetCachedTopoSort()) {
+    XLS_ASSIGN_OR_RETURN(entries_[node->id()], ComputeEntry(node));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status CriticalPathAnalyzer::UpdateChanged(
+    absl::Span<const int64_t> changed_ids) {
+  // Drop entries of nodes which no longer exist.
+  for (int64_t id : changed_ids) {
+    if (f_->GetNodeById(id) == nullptr) {
+      entries_.erase(id);
+    }
+  }
+
+  absl::Span<Node* const> topo_sort = f_->GetCachedTopoSort();
+  absl::flat_hash_map<Node*, int64_t> topo_index;
+  topo_index.reserve(topo_sort.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(topo_sort.size()); ++i) {
+    topo_index[topo_sort[i]] = i;
+  }
+
+  // Worklist of dirty nodes ordered topologically so each node is recomputed
+  // after its operands. Recomputation stops propagating wherever the cached
+  // entry is unchanged, bounding the work to the affected cones.
+  std::set<std::pair<int64_t, Node*>> worklist;
+  for (int64_t id : changed_ids) {
+    Node* node = f_->GetNodeById(id);
+    if (node != nullptr) {
+      worklist.insert({topo_index.at(node), node});
+    }
+  }
+  while (!worklist.empty()) {
+    Node* node = worklist.begin()->second;
+    worklist.erase(worklist.begin());
+    XLS_ASSIGN_OR_RETURN(ArrivalEntry entry, ComputeEntry(node));
+    auto it = entries_.find(node->id());
+    if (it != entries_.end() && it->second == entry) {
+      continue;
+    }
+    entries_.insert_or_assign(node->id(), entry);
+    for (Node* user : node->users()) {
+      worklist.insert({topo_index.at(user), user});
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<CriticalPathAnalyzer::ArrivalEntry>
+CriticalPathAnalyzer::ComputeEntry(Node* node) const {
+  ArrivalEntry entry;
+
+  // The maximum delay from any path up to but not including `node`.
+  int64_t max_operand_arrival = 0;
+  for (Node* operand : node->operands()) {
+    auto it = entries_.find(operand->id());
+    XLS_RET_CHECK(it != entries_.end())
+        << "No arrival entry for operand: " << operand->GetName();
+    if (it->second.arrival_ps >= max_operand_arrival) {
+      max_operand_arrival = it->second.arrival_ps;
+      entry.predecessor_id = operand->id();
+    }
+  }
+  XLS_ASSIGN_OR_RETURN(entry.node_delay_ps,
+                       delay_estimator_.GetOperationDelayInPsFast(node));
+
+  // If the dependency straddles a clock boundary we have to make our delay
+  // start from the clock time.
+  int64_t start_ps = max_operand_arrival;
+  if (clock_period_ps_.has_value() &&
+      (((start_ps + entry.node_delay_ps) / clock_period_ps_.value()) >
+       (start_ps / clock_period_ps_.value()))) {
+    start_ps = RoundDownToNearest(start_ps + entry.node_delay_ps,
+                                  clock_period_ps_.value());
+    CHECK_GT(start_ps, max_operand_arrival);
+    entry.delayed_by_cycle_boundary = true;
+  }
+  entry.boundary_push_ps = start_ps - max_operand_arrival;
+  entry.arrival_ps = start_ps + entry.node_delay_ps;
+  return entry;
+}
+
+absl::Status CriticalPathAnalyzer::ComputeSlacks() {
+  absl::Span<Node* const> topo_sort = f_->GetCachedTopoSort();
+
+  int64_t max_arrival = 0;
+  for (Node* node : topo_sort) {
+    max_arrival = std::max(max_arrival, entries_.at(node->id()).arrival_ps);
+  }
+
+  // Standard backward pass: the required time of a node is the latest time its
+  // value may arrive without lengthening any downstream path beyond the
+  // critical path delay. Cycle boundary pushes are taken from the forward
+  // solution. No delay estimator queries are required.
+  absl::flat_hash_map<int64_t, int64_t> required_times;
+  required_times.reserve(entries_.size());
+  slacks_.clear();
+  slacks_.reserve(entries_.size());
+  for (auto it = topo_sort.rbegin(); it != topo_sort.rend(); ++it) {
+    Node* node = *it;
+    int64_t required = max_arrival;
+    for (Node* user : node->users()) {
+      const ArrivalEntry& user_entry = entries_.at(user->id());
+      required = std::min(required,
+                          required_times.at(user->id()) -
+                              user_entry.node_delay_ps -
+                              user_entry.boundary_push_ps);
+    }
+    required_times[node->id()] = required;
+    slacks_[node->id()] = required - entries_.at(node->id()).arrival_ps;
+  }
+  slacks_valid_ = true;
+  return absl::OkStatus();
+}
+
 std::string CriticalPathToString(
     absl::Span<const CriticalPathEntry> critical_path,
     std::optional<std::function<std::string(Node*)>> extra_info) {
@@ -21,6 +21,8 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xls/delay_model/delay_estimator.h"
@@ -61,6 +63,103 @@ absl::StatusOr<std::vector<CriticalPathEntry>> AnalyzeCriticalPath(
     FunctionBase* f, std::optional<int64_t> clock_period_ps,
     const DelayEstimator& delay_estimator);
 
+// As AnalyzeCriticalPath, but computes the critical path for each of the given
+// clock configurations (std::nullopt meaning no clock period) in a single
+// traversal of the function. The delay of each node is queried from the delay
+// estimator only once regardless of the number of configurations, which is the
+// dominant cost of the analysis. Returns one critical path per configuration,
+// in the same order as `clock_periods_ps`.
+absl::StatusOr<std::vector<std::vector<CriticalPathEntry>>>
+AnalyzeCriticalPaths(FunctionBase* f,
+                     absl::Span<const std::optional<int64_t>> clock_periods_ps,
+                     const DelayEstimator& delay_estimator);
+
+// Incrementally recomputes the critical path of a function across IR
+// mutations. Per-node arrival times are cached between queries and only the
+// cones affected by nodes changed since the previous query (as reported by
+// FunctionBase::ChangedNodeIdsSince) are recomputed; when the change journal
+// has been truncated the whole function is reanalyzed. Useful for callers
+// which rerun critical path analysis after every pass or pass group. Not safe
+// for concurrent access.
+class CriticalPathAnalyzer {
+ public:
+  // Does not take ownership of `f` or `delay_estimator`; both must outlive
+  // this object.
+  CriticalPathAnalyzer(FunctionBase* f, std::optional<int64_t> clock_period_ps,
+                       const DelayEstimator& delay_estimator)
+      : f_(f),
+        clock_period_ps_(clock_period_ps),
+        delay_estimator_(delay_estimator) {}
+
+  // Returns the critical path of the function, refreshing stale arrival times
+  // first. Produces the same path as AnalyzeCriticalPath on the same function.
+  absl::StatusOr<std::vector<CriticalPathEntry>> GetCriticalPath();
+
+  // Returns the arrival time of the given node in picoseconds: the delay of
+  // the longest path up to and including the node.
+  absl::StatusOr<int64_t> GetArrivalTime(Node* node);
+
+  // Returns the slack of the given node in picoseconds: the amount by which
+  // the longest path through the node falls short of the overall critical
+  // path delay. Nodes on the critical path have zero slack. Cycle boundary
+  // adjustments are taken from the forward (arrival) solution.
+  absl::StatusOr<int64_t> GetSlack(Node* node);
+
+ private:
+  // Cached arrival information for a single node.
+  struct ArrivalEntry {
+    // Delay of the node itself.
+    int64_t node_delay_ps = 0;
+
+    // Delay of the longest path up to and including the node.
+    int64_t arrival_ps = 0;
+
+    // Amount the node's start time was pushed forward by a cycle boundary.
+    int64_t boundary_push_ps = 0;
+
+    // Id of the operand on the longest path to this node, or -1 if none.
+    int64_t predecessor_id = -1;
+
+    bool delayed_by_cycle_boundary = false;
+
+    friend bool operator==(const ArrivalEntry&, const ArrivalEntry&) = default;
+  };
+
+  // Brings the cached arrival entries up to date with the function.
+  absl::Status Refresh();
+
+  // Recomputes the arrival entries of every node in one pass.
+  absl::Status PopulateAll();
+
+  // Recomputes the arrival entries of the cones rooted at the given changed
+  // node ids.
+  absl::Status UpdateChanged(absl::Span<const int64_t> changed_ids);
+
+  // Computes the arrival entry of the given node from the cached entries of
+  // its operands.
+  absl::StatusOr<ArrivalEntry> ComputeEntry(Node* node) const;
+
+  // Recomputes the per-node slacks from the cached arrival entries.
+  absl::Status ComputeSlacks();
+
+  FunctionBase* f_;
+  std::optional<int64_t> clock_period_ps_;
+  const DelayEstimator& delay_estimator_;
+
+  // Arrival entries indexed by node id. Node ids are never reused within a
+  // package so entries of deleted nodes are simply dropped.
+  absl::flat_hash_map<int64_t, ArrivalEntry> entries_;
+
+  // Slack of each node indexed by node id. Recomputed from the arrival
+  // entries on demand; no delay estimator queries are required.
+  absl::flat_hash_map<int64_t, int64_t> slacks_;
+  bool slacks_valid_ = false;
+
+  // The transform version of `f_` at the time `entries_` was last refreshed,
+  // or -1 if never refreshed.
+  int64_t analyzed_version_ = -1;
+};
+
 // Returns a string representation of the critical-path. Includes delay
 // information for each node as well as cumulative delay.
 //
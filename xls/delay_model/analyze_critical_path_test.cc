@@ -14,6 +14,7 @@
 
 #include "xls/delay_model/analyze_critical_path.h"
 
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -28,8 +29,11 @@
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_matcher.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
 #include "xls/ir/package.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/type.h"
 #include "xls/ir/value.h"
 
@@ -38,6 +42,7 @@ namespace m = ::xls::op_matchers;
 namespace xls {
 namespace {
 
+using status_testing::IsOkAndHolds;
 using ::testing::_;
 using ::testing::ElementsAre;
 using ::testing::FieldsAre;
@@ -161,5 +166,88 @@ TEST_F(AnalyzeCriticalPathTest, ProcWithSendReceive) {
                               FieldsAre(m::Literal(Value::Token()), _, _, _)));
 }
 
+TEST_F(AnalyzeCriticalPathTest, MultipleClockConfigurations) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(32));
+  auto neg = fb.Negate(x);
+  auto rev = fb.Reverse(neg);
+  auto not_op = fb.Not(rev);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  (void)not_op;
+
+  // A single traversal with several clock configurations must produce the
+  // same paths as separate AnalyzeCriticalPath calls.
+  const std::optional<int64_t> configs[] = {std::nullopt, 2, 1};
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::vector<CriticalPathEntry>> cps,
+      AnalyzeCriticalPaths(f, configs, *delay_estimator_));
+  ASSERT_EQ(cps.size(), 3);
+  for (int64_t i = 0; i < 3; ++i) {
+    XLS_ASSERT_OK_AND_ASSIGN(std::vector<CriticalPathEntry> expected,
+                             AnalyzeCriticalPath(f, configs[i],
+                                                 *delay_estimator_));
+    ASSERT_EQ(cps[i].size(), expected.size());
+    for (int64_t j = 0; j < static_cast<int64_t>(expected.size()); ++j) {
+      EXPECT_EQ(cps[i][j].node, expected[j].node);
+      EXPECT_EQ(cps[i][j].node_delay_ps, expected[j].node_delay_ps);
+      EXPECT_EQ(cps[i][j].path_delay_ps, expected[j].path_delay_ps);
+      EXPECT_EQ(cps[i][j].delayed_by_cycle_boundary,
+                expected[j].delayed_by_cycle_boundary);
+    }
+  }
+}
+
+TEST_F(AnalyzeCriticalPathTest, IncrementalAnalyzerMatchesBatch) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(32));
+  auto y = fb.Param("y", p->GetBitsType(32));
+  auto neg = fb.Negate(x);
+  auto add = fb.Add(neg, y);
+  auto rev = fb.Reverse(add);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  CriticalPathAnalyzer analyzer(f, /*clock_period_ps=*/std::nullopt,
+                                *delay_estimator_);
+
+  auto expect_matches_fresh_analysis = [&]() {
+    XLS_ASSERT_OK_AND_ASSIGN(std::vector<CriticalPathEntry> incremental,
+                             analyzer.GetCriticalPath());
+    XLS_ASSERT_OK_AND_ASSIGN(
+        std::vector<CriticalPathEntry> fresh,
+        AnalyzeCriticalPath(f, /*clock_period_ps=*/std::nullopt,
+                            *delay_estimator_));
+    ASSERT_EQ(incremental.size(), fresh.size());
+    for (int64_t i = 0; i < static_cast<int64_t>(fresh.size()); ++i) {
+      EXPECT_EQ(incremental[i].node, fresh[i].node);
+      EXPECT_EQ(incremental[i].node_delay_ps, fresh[i].node_delay_ps);
+      EXPECT_EQ(incremental[i].path_delay_ps, fresh[i].path_delay_ps);
+    }
+  };
+  expect_matches_fresh_analysis();
+
+  EXPECT_THAT(analyzer.GetArrivalTime(rev.node()), IsOkAndHolds(3));
+  EXPECT_THAT(analyzer.GetSlack(rev.node()), IsOkAndHolds(0));
+  EXPECT_THAT(analyzer.GetSlack(add.node()), IsOkAndHolds(0));
+  // `y` feeds the add directly while the longest path goes through `neg`, so
+  // it has one node delay of slack.
+  EXPECT_THAT(analyzer.GetSlack(y.node()), IsOkAndHolds(1));
+
+  // Lengthen the cone feeding the add and verify the refreshed result.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * not_neg,
+      f->MakeNode<UnOp>(SourceInfo(), neg.node(), Op::kNot));
+  XLS_ASSERT_OK(add.node()->ReplaceOperandNumber(0, not_neg));
+  expect_matches_fresh_analysis();
+  EXPECT_THAT(analyzer.GetArrivalTime(rev.node()), IsOkAndHolds(4));
+  EXPECT_THAT(analyzer.GetSlack(y.node()), IsOkAndHolds(2));
+
+  // Removing a node refreshes cleanly as well.
+  XLS_ASSERT_OK(rev.node()->ReplaceUsesWith(add.node()));
+  XLS_ASSERT_OK(f->RemoveNode(rev.node()));
+  expect_matches_fresh_analysis();
+}
+
 }  // namespace
 }  // namespace xls
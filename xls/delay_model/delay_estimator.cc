@@ -31,6 +31,7 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
@@ -264,6 +265,37 @@ absl::StatusOr<int64_t> CachingDelayEstimator::GetOperationDelayInPs(
   return delay;
 }
 
+FunctionBaseCachingDelayEstimator::FunctionBaseCachingDelayEstimator(
+    std::string_view name, FunctionBase* function_base,
+    const DelayEstimator& cached)
+    : DelayEstimator(name), function_base_(function_base), cached_(cached) {}
+
+absl::Status FunctionBaseCachingDelayEstimator::Populate() const {
+  int64_t max_id = 0;
+  for (Node* node : function_base_->nodes()) {
+    max_id = std::max(max_id, node->id());
+  }
+  delays_.emplace(max_id + 1, 0);
+  for (Node* node : function_base_->nodes()) {
+    XLS_ASSIGN_OR_RETURN((*delays_)[node->id()],
+                         cached_.GetOperationDelayInPs(node));
+  }
+  transform_version_ = function_base_->transform_version();
+  return absl::OkStatus();
+}
+
+absl::StatusOr<int64_t>
+FunctionBaseCachingDelayEstimator::GetOperationDelayInPs(Node* node) const {
+  if (node->function_base() != function_base_) {
+    return cached_.GetOperationDelayInPs(node);
+  }
+  if (!delays_.has_value() ||
+      transform_version_ != function_base_->transform_version()) {
+    XLS_RETURN_IF_ERROR(Populate());
+  }
+  return (*delays_)[node->id()];
+}
+
 /* static */ absl::StatusOr<int64_t> DelayEstimator::GetLogicalEffortDelayInPs(
     Node* node, int64_t tau_in_ps) {
   XLS_ASSIGN_OR_RETURN(int64_t delay_in_tau, GetLogicalEffortDelayInTau(node));
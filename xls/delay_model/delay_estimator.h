@@ -15,15 +15,18 @@
 #ifndef XLS_DELAY_MODEL_DELAY_ESTIMATOR_H_
 #define XLS_DELAY_MODEL_DELAY_ESTIMATOR_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/fixed_array.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -37,7 +40,21 @@ namespace xls {
 // Abstraction describing a timing model for XLS operations.
 class DelayEstimator {
  public:
+  // Signature of a per-op delay function in an opcode-indexed dispatch table.
+  // Generated delay models provide such tables so hot callers (scheduling,
+  // critical path analysis) can look up delays without virtual dispatch.
+  using OpDelayFunction = absl::StatusOr<int64_t> (*)(Node*);
+
   explicit DelayEstimator(std::string_view name) : name_(name) {}
+
+  // Constructor for models which provide a direct dispatch table. The table
+  // must be indexed by opcode (size kOpLimit), have static storage duration,
+  // and contain null entries for ops the model does not handle. Table entries
+  // must agree with GetOperationDelayInPs() modulo clamping at zero.
+  DelayEstimator(std::string_view name,
+                 absl::Span<const OpDelayFunction> op_delay_functions)
+      : name_(name), op_delay_functions_(op_delay_functions) {}
+
   virtual ~DelayEstimator() = default;
 
   const std::string& name() const { return name_; }
@@ -45,6 +62,24 @@ class DelayEstimator {
   // Returns the estimated delay of the given node in picoseconds.
   virtual absl::StatusOr<int64_t> GetOperationDelayInPs(Node* node) const = 0;
 
+  // As GetOperationDelayInPs(), but dispatches directly through the per-op
+  // table (avoiding the virtual call) when the model provides one. Ops without
+  // a table entry, and models without tables, fall back to the virtual path.
+  absl::StatusOr<int64_t> GetOperationDelayInPsFast(Node* node) const {
+    if (!op_delay_functions_.empty()) {
+      OpDelayFunction delay_function =
+          op_delay_functions_[static_cast<int64_t>(node->op())];
+      if (delay_function != nullptr) {
+        absl::StatusOr<int64_t> delay = delay_function(node);
+        if (delay.ok()) {
+          return std::max<int64_t>(0, delay.value());
+        }
+        return delay;
+      }
+    }
+    return GetOperationDelayInPs(node);
+  }
+
   // Compute the delay of the given node using logical effort estimation. Only
   // relatively simple operations (kAnd, kOr, etc) are supported using this
   // method.
@@ -53,6 +88,7 @@ class DelayEstimator {
 
  private:
   std::string name_;
+  absl::Span<const OpDelayFunction> op_delay_functions_;
 };
 
 // Decorates an underlying delay estimator with an overriding modifier function.
@@ -122,6 +158,41 @@ class CachingDelayEstimator : public DelayEstimator {
       ABSL_GUARDED_BY(cache_mutex_);
 };
 
+// Caches the delays of all nodes of a single FunctionBase in a flat array
+// indexed by node id. The array is populated in a single bulk pass over the
+// function so repeated queries (e.g. from scheduling) cost an array load
+// rather than a hash lookup or a virtual dispatch into the underlying model.
+// The cache is repopulated automatically when the function's transform version
+// changes, i.e. after any node mutation. Queries for nodes of other
+// FunctionBases fall through to the underlying estimator. Unlike
+// CachingDelayEstimator, this class is not safe for concurrent access.
+class FunctionBaseCachingDelayEstimator : public DelayEstimator {
+ public:
+  FunctionBaseCachingDelayEstimator(std::string_view name,
+                                    FunctionBase* function_base,
+                                    const DelayEstimator& cached);
+
+  ~FunctionBaseCachingDelayEstimator() override = default;
+
+  absl::StatusOr<int64_t> GetOperationDelayInPs(Node* node) const override;
+
+ private:
+  // Recomputes the delay of every node of the function in one pass.
+  absl::Status Populate() const;
+
+  FunctionBase* function_base_;
+  const DelayEstimator& cached_;
+
+  // Delay of each node of `function_base_` indexed by node id. Node ids are
+  // never reused within a package, so an entry remains valid until the
+  // function's transform version changes and the array is rebuilt.
+  mutable std::optional<absl::FixedArray<int64_t>> delays_;
+
+  // The transform version of `function_base_` at the time `delays_` was
+  // populated.
+  mutable int64_t transform_version_ = -1;
+};
+
 enum class DelayEstimatorPrecedence {
   kLow = 1,
   kMedium = 2,
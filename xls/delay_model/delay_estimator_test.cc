@@ -14,6 +14,7 @@
 
 #include "xls/delay_model/delay_estimator.h"
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string_view>
@@ -23,11 +24,14 @@
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "xls/common/status/matchers.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
+#include "xls/ir/source_location.h"
 
 namespace xls {
 
@@ -49,6 +53,19 @@ class FakeDelayEstimator : public DelayEstimator {
   int64_t delay_;
 };
 
+// A test delay estimator which additionally provides a direct per-op dispatch
+// table as the generated delay models do.
+class TableDelayEstimator : public DelayEstimator {
+ public:
+  explicit TableDelayEstimator(
+      absl::Span<const OpDelayFunction> op_delay_functions)
+      : DelayEstimator("table", op_delay_functions) {}
+
+  absl::StatusOr<int64_t> GetOperationDelayInPs(Node* node) const override {
+    return 1;
+  }
+};
+
 class DelayEstimatorTest : public IrTestBase {};
 
 TEST_F(DelayEstimatorTest, DelayEstimatorManager) {
@@ -82,6 +99,34 @@ TEST_F(DelayEstimatorTest, DelayEstimatorManager) {
               StatusIs(absl::StatusCode::kNotFound));
 }
 
+TEST_F(DelayEstimatorTest, DirectDispatchTable) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue lit = fb.Literal(UBits(1, 8));
+  BValue neg = fb.Negate(lit);
+  BValue not_op = fb.Not(neg);
+  XLS_ASSERT_OK(fb.Build().status());
+
+  static std::array<DelayEstimator::OpDelayFunction, kOpLimit> table{};
+  table[static_cast<int64_t>(Op::kLiteral)] =
+      +[](Node* node) -> absl::StatusOr<int64_t> { return 42; };
+  table[static_cast<int64_t>(Op::kNeg)] =
+      +[](Node* node) -> absl::StatusOr<int64_t> { return -5; };
+  TableDelayEstimator estimator(table);
+
+  // Ops with table entries dispatch directly through the table (with results
+  // clamped at zero); ops without entries fall back to the virtual method.
+  EXPECT_THAT(estimator.GetOperationDelayInPsFast(lit.node()),
+              IsOkAndHolds(42));
+  EXPECT_THAT(estimator.GetOperationDelayInPsFast(neg.node()), IsOkAndHolds(0));
+  EXPECT_THAT(estimator.GetOperationDelayInPsFast(not_op.node()),
+              IsOkAndHolds(1));
+
+  // An estimator without a table always uses the virtual method.
+  FakeDelayEstimator fake(7, "seven");
+  EXPECT_THAT(fake.GetOperationDelayInPsFast(lit.node()), IsOkAndHolds(7));
+}
+
 TEST_F(DelayEstimatorTest, LogicalEffortForAndReduces) {
   {
     // 10bit AndReduce.
@@ -303,6 +348,45 @@ TEST_F(DelayEstimatorTest, CachingDelayEstimator) {
   EXPECT_THAT(caching.GetNodeDelay(f->return_value()), 1);
 }
 
+TEST_F(DelayEstimatorTest, FunctionBaseCachingDelayEstimator) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(1));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f,
+                           fb.BuildWithReturnValue(fb.Xor({x, x})));
+  FunctionBuilder other_fb("other", p.get());
+  BValue y = other_fb.Param("y", p->GetBitsType(1));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * g,
+                           other_fb.BuildWithReturnValue(other_fb.Xor({y, y})));
+
+  // An estimator whose answer can be changed from the test to observe whether
+  // queries hit the cache or the underlying estimator.
+  FakeDelayEstimator fake(0, "zero");
+  int64_t delay = 7;
+  DecoratingDelayEstimator varying(
+      "varying", fake, [&delay](Node*, int64_t) { return delay; });
+
+  FunctionBaseCachingDelayEstimator caching("flat_caching", f, varying);
+  EXPECT_THAT(caching.GetOperationDelayInPs(f->return_value()),
+              IsOkAndHolds(7));
+
+  // Cached values are served without consulting the underlying estimator.
+  delay = 100;
+  EXPECT_THAT(caching.GetOperationDelayInPs(f->return_value()),
+              IsOkAndHolds(7));
+
+  // Nodes of other FunctionBases fall through to the underlying estimator.
+  EXPECT_THAT(caching.GetOperationDelayInPs(g->return_value()),
+              IsOkAndHolds(100));
+
+  // Mutating the function bumps its transform version which invalidates the
+  // cache and triggers a bulk repopulation.
+  XLS_ASSERT_OK(
+      f->MakeNode<UnOp>(SourceInfo(), f->return_value(), Op::kNot).status());
+  EXPECT_THAT(caching.GetOperationDelayInPs(f->return_value()),
+              IsOkAndHolds(100));
+}
+
 // A Delay Estimator that can only handle one kind of operation.
 class TestNodeMatchEstimator : public DelayEstimator {
  public:
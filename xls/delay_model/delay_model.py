@@ -566,23 +566,36 @@ class BoundingBoxEstimator(Estimator):
       )
 
   def cpp_delay_code(self, node_identifier: str) -> str:
+    num_factors = len(self.delay_factors)
     lines = []
+    # Emit the bounding boxes as a flat constexpr table (factor upper bounds
+    # followed by the delay of the box) and scan it with conditional selects
+    # rather than a chain of early-return conditionals. The first matching row
+    # wins, matching raw_delay().
+    lines.append(
+        'constexpr std::array<std::array<int64_t, %d>, %d> kBoxes = {{'
+        % (num_factors + 1, len(self.raw_data_points))
+    )
     for raw_data_point in self.raw_data_points:
-      test_expr_terms = []
-      for i, x_value in enumerate(raw_data_point.delay_factors):
-        test_expr_terms.append(
-            '%s <= %d'
-            % (
-                _delay_factor_cpp_expression(
-                    self.delay_factors[i], node_identifier
-                ),
-                x_value,
-            )
-        )
+      row = list(raw_data_point.delay_factors) + [raw_data_point.delay_ps]
+      lines.append('    {{%s}},' % ', '.join(str(int(v)) for v in row))
+    lines.append('}};')
+    for i, factor in enumerate(self.delay_factors):
       lines.append(
-          'if (%s) { return %d; }'
-          % (' && '.join(test_expr_terms), raw_data_point.delay_ps)
+          'const int64_t x%d = %s;'
+          % (i, _delay_factor_cpp_expression(factor, node_identifier))
       )
+    lines.append('int64_t delay = -1;')
+    lines.append('for (const auto& box : kBoxes) {')
+    lines.append(
+        '  const bool in_box = %s;'
+        % ' && '.join('x%d <= box[%d]' % (i, i) for i in range(num_factors))
+    )
+    lines.append(
+        '  delay = (delay >= 0 || !in_box) ? delay : box[%d];' % num_factors
+    )
+    lines.append('}')
+    lines.append('if (delay >= 0) { return delay; }')
     lines.append(
         'return absl::UnimplementedError('
         '"Unhandled node for delay estimation: " '
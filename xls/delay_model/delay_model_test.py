@@ -112,22 +112,20 @@ class DelayModelTest(absltest.TestCase):
                 'op: "kBar" bit_count: 64 operands { bit_count: 64 }')), 1234)
     self.assertEqualIgnoringWhitespace(
         bar.cpp_delay_code('node'), """
-          if (node->GetType()->GetFlatBitCount() <= 3 &&
-              node->operand(0)->GetType()->GetFlatBitCount() <= 7) {
-            return 23;
-          }
-          if (node->GetType()->GetFlatBitCount() <= 12 &&
-              node->operand(0)->GetType()->GetFlatBitCount() <= 42) {
-            return 100;
-          }
-          if (node->GetType()->GetFlatBitCount() <= 32 &&
-              node->operand(0)->GetType()->GetFlatBitCount() <= 10) {
-            return 122;
-          }
-          if (node->GetType()->GetFlatBitCount() <= 64 &&
-              node->operand(0)->GetType()->GetFlatBitCount() <= 64) {
-            return 1234;
+          constexpr std::array<std::array<int64_t, 3>, 4> kBoxes = {{
+              {{3, 7, 23}},
+              {{12, 42, 100}},
+              {{32, 10, 122}},
+              {{64, 64, 1234}},
+          }};
+          const int64_t x0 = node->GetType()->GetFlatBitCount();
+          const int64_t x1 = node->operand(0)->GetType()->GetFlatBitCount();
+          int64_t delay = -1;
+          for (const auto& box : kBoxes) {
+            const bool in_box = x0 <= box[0] && x1 <= box[1];
+            delay = (delay >= 0 || !in_box) ? delay : box[2];
           }
+          if (delay >= 0) { return delay; }
           return absl::UnimplementedError(
               "Unhandled node for delay estimation: " +
               node->ToStringWithOperandTypes());
@@ -39,14 +39,15 @@ absl::StatusOr<BytecodeFunction*> BytecodeCache::GetOrCreateBytecodeFunction(
     const std::optional<ParametricEnv>& caller_bindings) {
   XLS_RET_CHECK(type_info != nullptr);
   Key key = std::make_tuple(&f, type_info, caller_bindings);
-  if (!cache_.contains(key)) {
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
     XLS_ASSIGN_OR_RETURN(
         std::unique_ptr<BytecodeFunction> bf,
         BytecodeEmitter::Emit(import_data_, type_info, f, caller_bindings));
-    cache_.emplace(key, std::move(bf));
+    it = cache_.emplace(std::move(key), std::move(bf)).first;
   }
 
-  return cache_.at(key).get();
+  return it->second.get();
 }
 
 }  // namespace xls::dslx
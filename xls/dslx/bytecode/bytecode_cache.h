@@ -29,6 +29,14 @@
 
 namespace xls::dslx {
 
+// Process-local memoization of emitted bytecode, keyed by (function,
+// type-info, caller bindings) identity.
+//
+// Note: the cache is intentionally not persisted across processes. Emitted
+// `Bytecode` holds raw pointers into the owning module's AST and `TypeInfo`
+// (and `InterpValue`s may refer to functions and channels), so a
+// `BytecodeFunction` has no meaning outside the process that emitted it; a
+// disk cache would first require a stable serialized form for all of those.
 class BytecodeCache : public BytecodeCacheInterface {
  public:
   explicit BytecodeCache(ImportData* import_data);
@@ -17,7 +17,6 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <ios>
 #include <memory>
 #include <optional>
@@ -26,6 +25,7 @@
 #include <variant>
 #include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/memory/memory.h"
@@ -413,8 +413,9 @@ absl::Status BytecodeInterpreter::EvalNextInstruction() {
 }
 
 absl::Status BytecodeInterpreter::EvalBinop(
-    const std::function<absl::StatusOr<InterpValue>(
-        const InterpValue& lhs, const InterpValue& rhs)>& op) {
+    absl::FunctionRef<absl::StatusOr<InterpValue>(const InterpValue& lhs,
+                                                  const InterpValue& rhs)>
+        op) {
   XLS_RET_CHECK_GE(stack_.size(), 2);
   XLS_ASSIGN_OR_RETURN(InterpValue rhs, Pop());
   XLS_ASSIGN_OR_RETURN(InterpValue lhs, Pop());
@@ -670,12 +671,13 @@ absl::Status BytecodeInterpreter::EvalCreateArray(const Bytecode& bytecode) {
   elements.reserve(array_size.value());
   for (int64_t i = 0; i < array_size.value(); i++) {
     XLS_ASSIGN_OR_RETURN(InterpValue value, Pop());
-    elements.push_back(value);
+    elements.push_back(std::move(value));
   }
 
   std::reverse(elements.begin(), elements.end());
-  XLS_ASSIGN_OR_RETURN(InterpValue array, InterpValue::MakeArray(elements));
-  stack_.Push(array);
+  XLS_ASSIGN_OR_RETURN(InterpValue array,
+                       InterpValue::MakeArray(std::move(elements)));
+  stack_.Push(std::move(array));
   return absl::OkStatus();
 }
 
@@ -688,12 +690,12 @@ absl::Status BytecodeInterpreter::EvalCreateTuple(const Bytecode& bytecode) {
   elements.reserve(tuple_size.value());
   for (int64_t i = 0; i < tuple_size.value(); i++) {
     XLS_ASSIGN_OR_RETURN(InterpValue value, Pop());
-    elements.push_back(value);
+    elements.push_back(std::move(value));
   }
 
   std::reverse(elements.begin(), elements.end());
 
-  stack_.Push(InterpValue::MakeTuple(elements));
+  stack_.Push(InterpValue::MakeTuple(std::move(elements)));
   return absl::OkStatus();
 }
 
@@ -759,9 +761,8 @@ absl::Status BytecodeInterpreter::EvalExpandTuple(const Bytecode& bytecode) {
   // element on top of the stack.
   XLS_ASSIGN_OR_RETURN(int64_t tuple_size, tuple.GetLength());
   for (int64_t i = tuple_size - 1; i >= 0; i--) {
-    XLS_ASSIGN_OR_RETURN(InterpValue element,
-                         tuple.Index(InterpValue::MakeUBits(64, i)));
-    stack_.Push(element);
+    XLS_ASSIGN_OR_RETURN(InterpValue element, tuple.Index(i));
+    stack_.Push(std::move(element));
   }
 
   return absl::OkStatus();
@@ -800,7 +801,7 @@ absl::Status BytecodeInterpreter::EvalTupleIndex(const Bytecode& bytecode) {
 
   XLS_ASSIGN_OR_RETURN(InterpValue result, basis.Index(index),
                        _ << " while processing " << bytecode.ToString());
-  stack_.Push(result);
+  stack_.Push(std::move(result));
   return absl::OkStatus();
 }
 
@@ -817,14 +818,14 @@ absl::Status BytecodeInterpreter::EvalIndex(const Bytecode& bytecode) {
 
   XLS_ASSIGN_OR_RETURN(InterpValue result, basis.Index(index),
                        _ << " while processing " << bytecode.ToString());
-  stack_.Push(result);
+  stack_.Push(std::move(result));
   return absl::OkStatus();
 }
 
 absl::Status BytecodeInterpreter::EvalInvert(const Bytecode& bytecode) {
   XLS_ASSIGN_OR_RETURN(InterpValue operand, Pop());
   XLS_ASSIGN_OR_RETURN(InterpValue result, operand.BitwiseNegate());
-  stack_.Push(result);
+  stack_.Push(std::move(result));
   return absl::OkStatus();
 }
 
@@ -836,7 +837,7 @@ absl::Status BytecodeInterpreter::EvalLe(const Bytecode& bytecode) {
 
 absl::Status BytecodeInterpreter::EvalLiteral(const Bytecode& bytecode) {
   XLS_ASSIGN_OR_RETURN(InterpValue value, bytecode.value_data());
-  stack_.Push(value);
+  stack_.Push(std::move(value));
   return absl::OkStatus();
 }
 
@@ -1201,7 +1202,7 @@ absl::Status BytecodeInterpreter::EvalStore(const Bytecode& bytecode) {
   }
 
   XLS_ASSIGN_OR_RETURN(InterpValue value, Pop());
-  frames_.back().StoreSlot(slot, value);
+  frames_.back().StoreSlot(slot, std::move(value));
   return absl::OkStatus();
 }
 
@@ -1244,8 +1245,8 @@ absl::Status BytecodeInterpreter::EvalSwap(const Bytecode& bytecode) {
   XLS_RET_CHECK_GE(stack_.size(), 2);
   XLS_ASSIGN_OR_RETURN(InterpValue tos0, Pop());
   XLS_ASSIGN_OR_RETURN(InterpValue tos1, Pop());
-  stack_.Push(tos0);
-  stack_.Push(tos1);
+  stack_.Push(std::move(tos0));
+  stack_.Push(std::move(tos1));
   return absl::OkStatus();
 }
 
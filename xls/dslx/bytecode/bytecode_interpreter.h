@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
@@ -160,9 +161,13 @@ class BytecodeInterpreter {
   absl::Status EvalWidthSlice(const Bytecode& bytecode);
   absl::Status EvalXor(const Bytecode& bytecode);
 
+  // Note: takes a FunctionRef (rather than a std::function) so the lambdas
+  // passed by the arithmetic handlers do not pay a std::function construction
+  // on every executed opcode.
   absl::Status EvalBinop(
-      const std::function<absl::StatusOr<InterpValue>(
-          const InterpValue& lhs, const InterpValue& rhs)>& op);
+      absl::FunctionRef<absl::StatusOr<InterpValue>(const InterpValue& lhs,
+                                                    const InterpValue& rhs)>
+          op);
 
   absl::StatusOr<BytecodeFunction*> GetBytecodeFn(
       Function& function, const Invocation* invocation,
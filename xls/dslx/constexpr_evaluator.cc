@@ -668,6 +668,16 @@ absl::Status ConstexprEvaluator::HandleXlsTuple(const XlsTuple* expr) {
 }
 
 absl::Status ConstexprEvaluator::InterpretExpr(const Expr* expr) {
+  // Identical (expression, parametric env) pairs come up over and over when a
+  // parametric function is instantiated from many contexts; reuse the value
+  // computed the first time instead of re-emitting and re-interpreting
+  // bytecode.
+  if (std::optional<InterpValue> memoized =
+          type_info_->GetMemoizedConstexpr(expr, bindings_)) {
+    type_info_->NoteConstExpr(expr, *std::move(memoized));
+    return absl::OkStatus();
+  }
+
   absl::flat_hash_map<std::string, InterpValue> env;
   XLS_ASSIGN_OR_RETURN(
       env, MakeConstexprEnv(import_data_, type_info_, warning_collector_, expr,
@@ -690,7 +700,12 @@ absl::Status ConstexprEvaluator::InterpretExpr(const Expr* expr) {
           "constexpr evaluation detected rollover in operation");
     }
   }
-  type_info_->NoteConstExpr(expr, constexpr_value);
+  // Only memoize evaluations that produced no rollover warnings so that the
+  // warnings are not silently dropped for later evaluation contexts.
+  if (rollovers.empty()) {
+    type_info_->NoteMemoizedConstexpr(expr, bindings_, constexpr_value);
+  }
+  type_info_->NoteConstExpr(expr, std::move(constexpr_value));
 
   return absl::OkStatus();
 }
@@ -27,6 +27,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -119,6 +120,69 @@ absl::StatusOr<int64_t> ArraySize(const ArrayTypeAnnotation* type_annotation,
   return InterpretInt(type_annotation->dim(), type_info, import_data);
 }
 
+// Returns the number of bytes a bit-vector leaf of `bit_count` bits occupies
+// in the flat byte-buffer layout: the width of the C++ integer type used to
+// represent the value. Returns std::nullopt for bit counts wider than 64 bits
+// which are not supported.
+std::optional<int64_t> FlatLeafByteSize(int64_t bit_count) {
+  if (bit_count > 64) {
+    return std::nullopt;
+  }
+  if (bit_count <= 8) {
+    return 1;
+  }
+  if (bit_count <= 16) {
+    return 2;
+  }
+  if (bit_count <= 32) {
+    return 4;
+  }
+  return 8;
+}
+
+// Emits C++ code which writes the bit-vector `rhs` of `bit_count` bits into
+// the flat-layout buffer pointed to by the expression `buffer`. The value is
+// stored little-endian, masked to `bit_count` bits.
+std::string EmitLeafToFlatBuffer(std::string_view buffer, std::string_view rhs,
+                                 int64_t bit_count, int64_t nesting) {
+  int64_t byte_size = FlatLeafByteSize(bit_count).value();
+  std::string flat_var = absl::StrCat("flat", nesting);
+  std::vector<std::string> pieces;
+  pieces.push_back(absl::StrFormat("uint64_t %s = static_cast<uint64_t>(%s);",
+                                   flat_var, rhs));
+  if (bit_count < 64) {
+    pieces.push_back(absl::StrFormat("%s &= (uint64_t{1} << %d) - 1;",
+                                     flat_var, bit_count));
+  }
+  pieces.push_back(absl::StrFormat("std::memcpy(%s, &%s, %d);", buffer,
+                                   flat_var, byte_size));
+  return absl::StrFormat("{\n%s\n}", Indent(absl::StrJoin(pieces, "\n"), 2));
+}
+
+// Emits C++ code which reads `lhs` of C++ type `cpp_type` from the
+// flat-layout buffer pointed to by the expression `buffer`. Signed values are
+// sign-extended from `bit_count` bits.
+std::string EmitLeafFromFlatBuffer(std::string_view lhs,
+                                   std::string_view buffer,
+                                   std::string_view cpp_type, int64_t bit_count,
+                                   bool is_signed, int64_t nesting) {
+  int64_t byte_size = FlatLeafByteSize(bit_count).value();
+  std::string flat_var = absl::StrCat("flat", nesting);
+  std::vector<std::string> pieces;
+  pieces.push_back(absl::StrFormat("uint64_t %s = 0;", flat_var));
+  pieces.push_back(absl::StrFormat("std::memcpy(&%s, %s, %d);", flat_var,
+                                   buffer, byte_size));
+  if (is_signed && bit_count < 64) {
+    pieces.push_back(absl::StrFormat(
+        "%s = static_cast<%s>(static_cast<int64_t>(%s << %d) >> %d);", lhs,
+        cpp_type, flat_var, 64 - bit_count, 64 - bit_count));
+  } else {
+    pieces.push_back(
+        absl::StrFormat("%s = static_cast<%s>(%s);", lhs, cpp_type, flat_var));
+  }
+  return absl::StrFormat("{\n%s\n}", Indent(absl::StrJoin(pieces, "\n"), 2));
+}
+
 // An emitter for bit-vector types which are represented using C++ primitive
 // types (bool, int8_t, uint16_t, etc).
 class BitVectorCppEmitter : public CppEmitter {
@@ -226,6 +290,31 @@ class BitVectorCppEmitter : public CppEmitter {
   std::optional<int64_t> GetBitCountIfBitVector() const override {
     return dslx_bit_count_;
   }
+
+  std::optional<std::string> GetFlatByteSizeExpr() const override {
+    std::optional<int64_t> byte_size = FlatLeafByteSize(dslx_bit_count());
+    if (!byte_size.has_value()) {
+      return std::nullopt;
+    }
+    return absl::StrCat(*byte_size);
+  }
+
+  std::optional<std::string> GetFlatAlignmentExpr() const override {
+    return GetFlatByteSizeExpr();
+  }
+
+  std::string AssignToFlatBuffer(std::string_view buffer, std::string_view rhs,
+                                 int64_t nesting) const override {
+    return EmitLeafToFlatBuffer(buffer, rhs, dslx_bit_count(), nesting);
+  }
+
+  std::string AssignFromFlatBuffer(std::string_view lhs,
+                                   std::string_view buffer,
+                                   int64_t nesting) const override {
+    return EmitLeafFromFlatBuffer(lhs, buffer, cpp_type(), dslx_bit_count(),
+                                  is_signed(), nesting);
+  }
+
   int64_t dslx_bit_count() const { return dslx_bit_count_; }
   bool is_signed() const { return is_signed_; }
 
@@ -250,6 +339,21 @@ class BitVectorCppEmitter : public CppEmitter {
   bool is_signed_;
 };
 
+// Returns true if every member of `struct_def` supports the flat byte-buffer
+// layout (and hence the generated struct defines flat-layout constants and
+// converters).
+bool StructSupportsFlatLayout(const StructDef* struct_def, TypeInfo* type_info,
+                              ImportData* import_data) {
+  for (const auto& member : struct_def->members()) {
+    absl::StatusOr<std::unique_ptr<CppEmitter>> emitter = CppEmitter::Create(
+        member.type, member.type->ToString(), type_info, import_data);
+    if (!emitter.ok() || !(*emitter)->SupportsFlatLayout()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // An emitter for DSLX type refs. The emitted C++ code delegates all
 // functionality (ToString, etc) to code generated by other emitters.
 class TypeRefCppEmitter : public CppEmitter {
@@ -259,10 +363,14 @@ class TypeRefCppEmitter : public CppEmitter {
   explicit TypeRefCppEmitter(const TypeRefTypeAnnotation* type_annotation,
                              std::string_view cpp_type,
                              std::string_view dslx_type,
-                             std::optional<int64_t> dslx_bit_count)
+                             std::optional<int64_t> dslx_bit_count,
+                             std::optional<bool> dslx_is_signed,
+                             bool struct_supports_flat_layout)
       : CppEmitter(cpp_type, dslx_type),
         typeref_type_annotation_(type_annotation),
-        dslx_bit_count_(dslx_bit_count) {}
+        dslx_bit_count_(dslx_bit_count),
+        dslx_is_signed_(dslx_is_signed),
+        struct_supports_flat_layout_(struct_supports_flat_layout) {}
   ~TypeRefCppEmitter() override = default;
 
   static absl::StatusOr<std::unique_ptr<TypeRefCppEmitter>> Create(
@@ -273,13 +381,23 @@ class TypeRefCppEmitter : public CppEmitter {
     std::optional<BitVectorMetadata> bit_vector_metadata =
         ExtractBitVectorMetadata(type_annotation);
     std::optional<int64_t> dslx_bit_count;
+    std::optional<bool> dslx_is_signed;
     if (bit_vector_metadata.has_value()) {
       XLS_ASSIGN_OR_RETURN(dslx_bit_count,
                            GetBitCountFromBitVectorMetadata(
                                *bit_vector_metadata, type_info, import_data));
+      dslx_is_signed = bit_vector_metadata->is_signed;
+    }
+    bool struct_supports_flat_layout = false;
+    if (std::holds_alternative<StructDef*>(
+            type_annotation->type_ref()->type_definition())) {
+      struct_supports_flat_layout = StructSupportsFlatLayout(
+          std::get<StructDef*>(type_annotation->type_ref()->type_definition()),
+          type_info, import_data);
     }
-    return std::make_unique<TypeRefCppEmitter>(type_annotation, cpp_type,
-                                               dslx_type, dslx_bit_count);
+    return std::make_unique<TypeRefCppEmitter>(
+        type_annotation, cpp_type, dslx_type, dslx_bit_count, dslx_is_signed,
+        struct_supports_flat_layout);
   }
 
   std::string AssignToValue(std::string_view lhs, std::string_view rhs,
@@ -340,10 +458,66 @@ class TypeRefCppEmitter : public CppEmitter {
     return dslx_bit_count_;
   }
 
+  std::optional<std::string> GetFlatByteSizeExpr() const override {
+    if (TypeHasMethods()) {
+      if (!struct_supports_flat_layout_) {
+        return std::nullopt;
+      }
+      return absl::StrFormat("%s::kFlatByteSize", cpp_type());
+    }
+    if (!dslx_bit_count_.has_value()) {
+      return std::nullopt;
+    }
+    std::optional<int64_t> byte_size = FlatLeafByteSize(*dslx_bit_count_);
+    if (!byte_size.has_value()) {
+      return std::nullopt;
+    }
+    return absl::StrCat(*byte_size);
+  }
+
+  std::optional<std::string> GetFlatAlignmentExpr() const override {
+    if (TypeHasMethods()) {
+      if (!struct_supports_flat_layout_) {
+        return std::nullopt;
+      }
+      return absl::StrFormat("%s::kFlatAlignment", cpp_type());
+    }
+    return GetFlatByteSizeExpr();
+  }
+
+  std::string AssignToFlatBuffer(std::string_view buffer, std::string_view rhs,
+                                 int64_t nesting) const override {
+    if (TypeHasMethods()) {
+      return absl::StrFormat(
+          "XLS_RETURN_IF_ERROR(%s.ToFlatBytes(absl::MakeSpan(%s, "
+          "%s::kFlatByteSize)));",
+          rhs, buffer, cpp_type());
+    }
+    return EmitLeafToFlatBuffer(buffer, rhs, *dslx_bit_count_, nesting);
+  }
+
+  std::string AssignFromFlatBuffer(std::string_view lhs,
+                                   std::string_view buffer,
+                                   int64_t nesting) const override {
+    if (TypeHasMethods()) {
+      return absl::StrFormat(
+          "XLS_ASSIGN_OR_RETURN(%s, %s::FromFlatBytes(absl::MakeConstSpan(%s, "
+          "%s::kFlatByteSize)));",
+          lhs, cpp_type(), buffer, cpp_type());
+    }
+    return EmitLeafFromFlatBuffer(lhs, buffer, cpp_type(), *dslx_bit_count_,
+                                  dslx_is_signed_.value_or(false), nesting);
+  }
+
  protected:
   const TypeRefTypeAnnotation* typeref_type_annotation_;
   // Bit-count of the underlying DSLX type if it is a bitvector.
   std::optional<int64_t> dslx_bit_count_;
+  // Signedness of the underlying DSLX type if it is a bitvector.
+  std::optional<bool> dslx_is_signed_;
+  // True if the referenced type is a struct whose generated C++ type defines
+  // flat-layout constants and converters.
+  bool struct_supports_flat_layout_;
 };
 
 // An emitter for DSLX array types which are represented in C++ using
@@ -465,6 +639,55 @@ class ArrayCppEmitter : public CppEmitter {
                         });
   }
 
+  std::optional<std::string> GetFlatByteSizeExpr() const override {
+    std::optional<std::string> element_size =
+        element_emitter_->GetFlatByteSizeExpr();
+    if (!element_size.has_value()) {
+      return std::nullopt;
+    }
+    int64_t element_bytes;
+    if (absl::SimpleAtoi(*element_size, &element_bytes)) {
+      return absl::StrCat(array_size() * element_bytes);
+    }
+    return absl::StrFormat("(%d * %s)", array_size(), *element_size);
+  }
+
+  std::optional<std::string> GetFlatAlignmentExpr() const override {
+    return element_emitter_->GetFlatAlignmentExpr();
+  }
+
+  std::string AssignToFlatBuffer(std::string_view buffer, std::string_view rhs,
+                                 int64_t nesting) const override {
+    std::string ind_var = absl::StrCat("i", nesting);
+    std::string element_assignment = element_emitter_->AssignToFlatBuffer(
+        absl::StrFormat("(%s) + %s * %s", buffer, ind_var,
+                        *element_emitter_->GetFlatByteSizeExpr()),
+        absl::StrFormat("%s[%s]", rhs, ind_var), nesting + 1);
+    std::vector<std::string> pieces;
+    pieces.push_back(absl::StrFormat("for (int64_t %s = 0; %s < %d; ++%s) {",
+                                     ind_var, ind_var, array_size(), ind_var));
+    pieces.push_back(Indent(element_assignment, 2));
+    pieces.push_back("}");
+    return absl::StrJoin(pieces, "\n");
+  }
+
+  std::string AssignFromFlatBuffer(std::string_view lhs,
+                                   std::string_view buffer,
+                                   int64_t nesting) const override {
+    std::string ind_var = absl::StrCat("i", nesting);
+    std::string element_assignment = element_emitter_->AssignFromFlatBuffer(
+        absl::StrFormat("%s[%s]", lhs, ind_var),
+        absl::StrFormat("(%s) + %s * %s", buffer, ind_var,
+                        *element_emitter_->GetFlatByteSizeExpr()),
+        nesting + 1);
+    std::vector<std::string> pieces;
+    pieces.push_back(absl::StrFormat("for (int64_t %s = 0; %s < %d; ++%s) {",
+                                     ind_var, ind_var, array_size(), ind_var));
+    pieces.push_back(Indent(element_assignment, 2));
+    pieces.push_back("}");
+    return absl::StrJoin(pieces, "\n");
+  }
+
   int64_t array_size() const { return array_size_; }
 
  protected:
@@ -110,6 +110,44 @@ class CppEmitter {
     return std::nullopt;
   }
 
+  // Returns a C++ constexpr expression giving the number of bytes an instance
+  // of this type occupies in the flat byte-buffer layout, or std::nullopt if
+  // the type cannot be flattened (e.g., tuples and >64-bit bit-vectors). The
+  // expression may reference constants defined by other generated types (e.g.,
+  // `MyStruct::kFlatByteSize`).
+  virtual std::optional<std::string> GetFlatByteSizeExpr() const {
+    return std::nullopt;
+  }
+
+  // Returns a C++ constexpr expression giving the byte alignment of this type
+  // in the flat byte-buffer layout, or std::nullopt if the type cannot be
+  // flattened.
+  virtual std::optional<std::string> GetFlatAlignmentExpr() const {
+    return std::nullopt;
+  }
+
+  // Returns true if this type can be converted to/from the flat byte-buffer
+  // layout.
+  bool SupportsFlatLayout() const { return GetFlatByteSizeExpr().has_value(); }
+
+  // Emits C++ code which writes `rhs` of `cpp_type()` into the flat-layout
+  // buffer pointed to by the `uint8_t*`-typed expression `buffer`. Must only
+  // be called if SupportsFlatLayout() returns true.
+  virtual std::string AssignToFlatBuffer(std::string_view buffer,
+                                         std::string_view rhs,
+                                         int64_t nesting) const {
+    return "";
+  }
+
+  // Emits C++ code which reads `lhs` of `cpp_type()` from the flat-layout
+  // buffer pointed to by the `const uint8_t*`-typed expression `buffer`. Must
+  // only be called if SupportsFlatLayout() returns true.
+  virtual std::string AssignFromFlatBuffer(std::string_view lhs,
+                                           std::string_view buffer,
+                                           int64_t nesting) const {
+    return "";
+  }
+
   // If the underlying DSLX type is a bit vector then return its signedness.
   // Otherwise return std::nullopt.
   virtual std::optional<bool> GetSignednessIfBitVector() const {
@@ -37,7 +37,8 @@ namespace xls::dslx {
 absl::StatusOr<CppSource> TranspileToCpp(Module* module,
                                          ImportData* import_data,
                                          std::string_view output_header_path,
-                                         std::string_view namespaces) {
+                                         std::string_view namespaces,
+                                         bool emit_flat_layout) {
   constexpr std::string_view kHeaderTemplate =
       R"(// AUTOMATICALLY GENERATED FILE FROM `xls/dslx/cpp_transpiler`. DO NOT EDIT!
 #ifndef $0
@@ -49,7 +50,7 @@ absl::StatusOr<CppSource> TranspileToCpp(Module* module,
 #include <vector>
 
 #include "absl/status/statusor.h"
-#include "xls/public/value.h"
+$4#include "xls/public/value.h"
 
 $2$1$3
 
@@ -59,7 +60,7 @@ $2$1$3
   constexpr std::string_view kSourceTemplate =
       R"(// AUTOMATICALLY GENERATED FILE FROM `xls/dslx/cpp_transpiler`. DO NOT EDIT!
 #include <array>
-#include <string>
+%s#include <string>
 #include <vector>
 
 #include "%s"
@@ -101,8 +102,10 @@ static std::string __indent(int64_t amount) {
   std::vector<std::string> header;
   std::vector<std::string> source;
   for (const TypeDefinition& def : module->GetTypeDefinitions()) {
-    XLS_ASSIGN_OR_RETURN(std::unique_ptr<CppTypeGenerator> generator,
-                         CppTypeGenerator::Create(def, type_info, import_data));
+    XLS_ASSIGN_OR_RETURN(
+        std::unique_ptr<CppTypeGenerator> generator,
+        CppTypeGenerator::Create(def, type_info, import_data,
+                                 emit_flat_layout));
     XLS_ASSIGN_OR_RETURN(CppSource result, generator->GetCppSource());
     header.push_back(result.header);
     source.push_back(result.source);
@@ -125,11 +128,19 @@ static std::string __indent(int64_t amount) {
     namespace_end = absl::StrCat("\n\n}  // namespace ", namespaces);
   }
 
+  // The flat-layout converters use absl::Span in their signatures and
+  // memset/memcpy in their implementations.
+  std::string_view header_extra_includes =
+      emit_flat_layout ? "#include \"absl/types/span.h\"\n" : "";
+  std::string_view source_extra_includes =
+      emit_flat_layout ? "#include <cstring>\n" : "";
+
   return CppSource{
       absl::Substitute(kHeaderTemplate, header_guard,
                        absl::StrJoin(header, "\n\n"), namespace_begin,
-                       namespace_end),
-      absl::StrFormat(kSourceTemplate, output_header_path, namespace_begin,
+                       namespace_end, header_extra_includes),
+      absl::StrFormat(kSourceTemplate, source_extra_includes,
+                      output_header_path, namespace_begin,
                       absl::StrJoin(source, "\n\n"), namespace_end)};
 }
 
@@ -38,10 +38,19 @@ namespace xls::dslx {
 // should be infrequent, so users should feel comfortable using these
 // interfaces, but should also be aware of the potential for change in the
 // future.
+//
+// If `emit_flat_layout` is true then generated structs additionally define
+// constexpr byte offset constants for each member (plus kFlatAlignment and
+// kFlatByteSize) and ToFlatBytes/FromFlatBytes converters which write/read a
+// flat byte buffer directly, without materializing a Value tree per
+// field. This is useful for callers which convert in hot loops. Structs
+// containing tuples or >64-bit bit-vectors are emitted without the flat
+// converters.
 absl::StatusOr<CppSource> TranspileToCpp(Module* module,
                                          ImportData* import_data,
                                          std::string_view output_header_path,
-                                         std::string_view namespaces = "");
+                                         std::string_view namespaces = "",
+                                         bool emit_flat_layout = false);
 
 }  // namespace xls::dslx
 
@@ -220,6 +220,31 @@ struct OuterStruct {
   ExpectEqualToGoldenFiles(result);
 }
 
+TEST(CppTranspilerTest, StructFlatLayout) {
+  constexpr std::string_view kModule = R"(
+struct InnerStruct {
+  x: u32,
+  y: u16
+}
+
+struct OuterStruct {
+  a: u3,
+  b: s16,
+  c: InnerStruct,
+  d: u8[4]
+})";
+
+  auto import_data = CreateImportDataForTest();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TypecheckedModule module,
+      ParseAndTypecheck(kModule, "fake_path", "MyModule", &import_data));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      TranspileToCpp(module.module, &import_data, "fake_path.h",
+                     /*namespaces=*/"", /*emit_flat_layout=*/true));
+  ExpectEqualToGoldenFiles(result);
+}
+
 TEST(CppTranspilerTest, StructWithStructWithStruct) {
   constexpr std::string_view kModule = R"(
 struct InnerStruct {
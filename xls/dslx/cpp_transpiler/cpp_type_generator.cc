@@ -14,6 +14,7 @@
 
 #include "xls/dslx/cpp_transpiler/cpp_type_generator.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -25,6 +26,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -409,21 +411,57 @@ class TypeAliasCppTypeGenerator : public CppTypeGenerator {
   std::unique_ptr<CppEmitter> emitter_;
 };
 
+// Returns a constexpr expression rounding `value` up to the nearest multiple
+// of `alignment`, folding to a literal when both operands are literals.
+std::string AlignUpExpr(std::string_view value, std::string_view alignment) {
+  int64_t value_int;
+  int64_t alignment_int;
+  if (absl::SimpleAtoi(value, &value_int) &&
+      absl::SimpleAtoi(alignment, &alignment_int)) {
+    return absl::StrCat((value_int + alignment_int - 1) / alignment_int *
+                        alignment_int);
+  }
+  if (alignment == "1") {
+    return std::string(value);
+  }
+  return absl::StrFormat("(%s + %s - 1) / %s * %s", value, alignment,
+                         alignment, alignment);
+}
+
+// Returns a constexpr expression for the maximum of the two expressions,
+// folding to a literal when both operands are literals.
+std::string MaxExpr(std::string_view a, std::string_view b) {
+  int64_t a_int;
+  int64_t b_int;
+  if (absl::SimpleAtoi(a, &a_int) && absl::SimpleAtoi(b, &b_int)) {
+    return absl::StrCat(std::max(a_int, b_int));
+  }
+  if (a == b || b == "1") {
+    return std::string(a);
+  }
+  if (a == "1") {
+    return std::string(b);
+  }
+  return absl::StrFormat("(%s > %s ? %s : %s)", a, b, a, b);
+}
+
 // A type generator for emitting a C++ struct for representing a DSLX struct.
 class StructCppTypeGenerator : public CppTypeGenerator {
  public:
   explicit StructCppTypeGenerator(
       std::string_view cpp_type, std::string_view dslx_type,
       const StructDef* struct_def,
-      std::vector<std::unique_ptr<CppEmitter>> member_emitters)
+      std::vector<std::unique_ptr<CppEmitter>> member_emitters,
+      bool emit_flat_layout)
       : CppTypeGenerator(cpp_type, dslx_type),
         struct_def_(struct_def),
-        member_emitters_(std::move(member_emitters)) {}
+        member_emitters_(std::move(member_emitters)),
+        emit_flat_layout_(emit_flat_layout) {}
   ~StructCppTypeGenerator() override = default;
 
   static absl::StatusOr<std::unique_ptr<StructCppTypeGenerator>> Create(
-      const StructDef* struct_def, TypeInfo* type_info,
-      ImportData* import_data) {
+      const StructDef* struct_def, TypeInfo* type_info, ImportData* import_data,
+      bool emit_flat_layout) {
     std::vector<std::unique_ptr<CppEmitter>> member_emitters;
     for (const auto& i : struct_def->members()) {
       XLS_ASSIGN_OR_RETURN(std::unique_ptr<CppEmitter> emitter,
@@ -433,7 +471,7 @@ class StructCppTypeGenerator : public CppTypeGenerator {
     }
     return std::make_unique<StructCppTypeGenerator>(
         DslxTypeNameToCpp(struct_def->identifier()), struct_def->identifier(),
-        struct_def, std::move(member_emitters));
+        struct_def, std::move(member_emitters), emit_flat_layout);
   }
 
   absl::StatusOr<CppSource> GetCppSource() const override {
@@ -480,19 +518,45 @@ class StructCppTypeGenerator : public CppTypeGenerator {
         cpp_type()));
     hdr_pieces.push_back(operator_stream_method.header);
 
+    std::vector<std::string> src_pieces = {
+        from_value_method.source,  to_value_method.source,
+        to_string_method.source,   to_dslx_string_method.source,
+        verify_method.source,      operator_eq_method.source,
+        operator_stream_method.source};
+
+    if (emit_flat_layout_ && SupportsFlatLayout()) {
+      CppSource to_flat_bytes_method = ToFlatBytesMethod();
+      CppSource from_flat_bytes_method = FromFlatBytesMethod();
+      hdr_pieces.push_back("");
+      hdr_pieces.push_back(
+          "// Byte offset of each member in the flat byte-buffer layout\n"
+          "// produced by ToFlatBytes().");
+      hdr_pieces.push_back(FlatLayoutDecls());
+      hdr_pieces.push_back(to_flat_bytes_method.header);
+      hdr_pieces.push_back(from_flat_bytes_method.header);
+      src_pieces.push_back(to_flat_bytes_method.source);
+      src_pieces.push_back(from_flat_bytes_method.source);
+    }
+
     std::string members = absl::StrJoin(hdr_pieces, "\n");
 
     std::string header =
         absl::StrFormat("struct %s {\n%s\n};", cpp_type(), Indent(members, 2));
-    std::string source =
-        absl::StrJoin({from_value_method.source, to_value_method.source,
-                       to_string_method.source, to_dslx_string_method.source,
-                       verify_method.source, operator_eq_method.source,
-                       operator_stream_method.source},
-                      "\n\n");
+    std::string source = absl::StrJoin(src_pieces, "\n\n");
     return CppSource{.header = header, .source = source};
   }
 
+  // Returns true if every member of the struct supports the flat byte-buffer
+  // layout.
+  bool SupportsFlatLayout() const {
+    for (const std::unique_ptr<CppEmitter>& emitter : member_emitters_) {
+      if (!emitter->SupportsFlatLayout()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
  protected:
   CppSource FromValueMethod() const {
     std::vector<std::string> pieces;
@@ -648,15 +712,123 @@ class StructCppTypeGenerator : public CppTypeGenerator {
     };
   }
 
+  // Emits the constexpr constants describing the flat byte-buffer layout of
+  // the struct: the byte offset of each member plus the alignment and total
+  // size of the struct. Offsets involving members whose size is only known to
+  // the C++ compiler (e.g., nested structs) are emitted as constexpr
+  // expressions; all-literal cases are folded to numbers.
+  std::string FlatLayoutDecls() const {
+    std::vector<std::string> decls;
+    // Expression for the first byte past the members laid out so far.
+    std::string end = "0";
+    std::string alignment = "1";
+    for (int64_t i = 0; i < struct_def_->size(); ++i) {
+      std::string member_name =
+          DslxTypeNameToCpp(struct_def_->GetMemberName(i));
+      std::string size = *member_emitters_[i]->GetFlatByteSizeExpr();
+      std::string member_alignment =
+          *member_emitters_[i]->GetFlatAlignmentExpr();
+      std::string offset_name = absl::StrFormat("k%sFlatOffset", member_name);
+      std::string offset = AlignUpExpr(end, member_alignment);
+      decls.push_back(absl::StrFormat("static constexpr int64_t %s = %s;",
+                                      offset_name, offset));
+      int64_t offset_int;
+      int64_t size_int;
+      if (absl::SimpleAtoi(offset, &offset_int) &&
+          absl::SimpleAtoi(size, &size_int)) {
+        end = absl::StrCat(offset_int + size_int);
+      } else {
+        end = absl::StrFormat("%s + %s", offset_name, size);
+      }
+      alignment = MaxExpr(alignment, member_alignment);
+    }
+    decls.push_back(absl::StrFormat(
+        "static constexpr int64_t kFlatAlignment = %s;", alignment));
+    int64_t end_int;
+    int64_t alignment_int;
+    std::string byte_size;
+    if (absl::SimpleAtoi(end, &end_int) &&
+        absl::SimpleAtoi(alignment, &alignment_int)) {
+      byte_size =
+          absl::StrCat((end_int + alignment_int - 1) / alignment_int *
+                       alignment_int);
+    } else {
+      byte_size = AlignUpExpr(end, "kFlatAlignment");
+    }
+    decls.push_back(absl::StrFormat(
+        "static constexpr int64_t kFlatByteSize = %s;", byte_size));
+    return absl::StrJoin(decls, "\n");
+  }
+
+  CppSource ToFlatBytesMethod() const {
+    std::vector<std::string> pieces;
+    pieces.push_back("if (buffer.size() < kFlatByteSize) {");
+    pieces.push_back("  return absl::InvalidArgumentError(absl::StrFormat(");
+    pieces.push_back(
+        "      \"Buffer must hold at least %d bytes; got %d.\",");
+    pieces.push_back("      kFlatByteSize, buffer.size()));");
+    pieces.push_back("}");
+    pieces.push_back("XLS_RETURN_IF_ERROR(Verify());");
+    pieces.push_back("std::memset(buffer.data(), 0, kFlatByteSize);");
+    for (int64_t i = 0; i < struct_def_->size(); ++i) {
+      pieces.push_back(member_emitters_[i]->AssignToFlatBuffer(
+          absl::StrFormat("buffer.data() + k%sFlatOffset",
+                          DslxTypeNameToCpp(struct_def_->GetMemberName(i))),
+          struct_def_->GetMemberName(i), /*nesting=*/0));
+    }
+    pieces.push_back("return absl::OkStatus();");
+    std::string body = absl::StrJoin(pieces, "\n");
+
+    return CppSource{
+        .header = "absl::Status ToFlatBytes(absl::Span<uint8_t> buffer) const;",
+        .source = absl::StrFormat(
+            "absl::Status %s::ToFlatBytes(absl::Span<uint8_t> buffer) const "
+            "{\n%s\n}",
+            cpp_type(), Indent(body, 2))};
+  }
+
+  CppSource FromFlatBytesMethod() const {
+    std::vector<std::string> pieces;
+    pieces.push_back("if (buffer.size() < kFlatByteSize) {");
+    pieces.push_back("  return absl::InvalidArgumentError(absl::StrFormat(");
+    pieces.push_back(
+        "      \"Buffer must hold at least %d bytes; got %d.\",");
+    pieces.push_back("      kFlatByteSize, buffer.size()));");
+    pieces.push_back("}");
+    pieces.push_back(absl::StrFormat("%s result;", cpp_type()));
+    for (int64_t i = 0; i < struct_def_->size(); ++i) {
+      pieces.push_back(member_emitters_[i]->AssignFromFlatBuffer(
+          absl::StrFormat("result.%s", struct_def_->GetMemberName(i)),
+          absl::StrFormat("buffer.data() + k%sFlatOffset",
+                          DslxTypeNameToCpp(struct_def_->GetMemberName(i))),
+          /*nesting=*/0));
+    }
+    pieces.push_back("XLS_RETURN_IF_ERROR(result.Verify());");
+    pieces.push_back("return result;");
+    std::string body = absl::StrJoin(pieces, "\n");
+
+    return CppSource{
+        .header = absl::StrFormat(
+            "static absl::StatusOr<%s> FromFlatBytes(absl::Span<const "
+            "uint8_t> buffer);",
+            cpp_type()),
+        .source = absl::StrFormat(
+            "absl::StatusOr<%s> %s::FromFlatBytes(absl::Span<const uint8_t> "
+            "buffer) {\n%s\n}",
+            cpp_type(), cpp_type(), Indent(body, 2))};
+  }
+
   const StructDef* struct_def_;
   std::vector<std::unique_ptr<CppEmitter>> member_emitters_;
+  bool emit_flat_layout_;
 };
 
 }  // namespace
 
 /* static */ absl::StatusOr<std::unique_ptr<CppTypeGenerator>>
 CppTypeGenerator::Create(const TypeDefinition& type_definition,
-                         TypeInfo* type_info, ImportData* import_data) {
+                         TypeInfo* type_info, ImportData* import_data,
+                         bool emit_flat_layout) {
   return absl::visit(
       Visitor{[&](const TypeAlias* type_alias)
                   -> absl::StatusOr<std::unique_ptr<CppTypeGenerator>> {
@@ -665,8 +837,8 @@ CppTypeGenerator::Create(const TypeDefinition& type_definition,
               },
               [&](const StructDef* struct_def)
                   -> absl::StatusOr<std::unique_ptr<CppTypeGenerator>> {
-                return StructCppTypeGenerator::Create(struct_def, type_info,
-                                                      import_data);
+                return StructCppTypeGenerator::Create(
+                    struct_def, type_info, import_data, emit_flat_layout);
               },
               [&](const EnumDef* enum_def)
                   -> absl::StatusOr<std::unique_ptr<CppTypeGenerator>> {
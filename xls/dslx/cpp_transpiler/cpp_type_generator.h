@@ -52,10 +52,13 @@ class CppTypeGenerator {
   // not a tuple or array).
   std::string dslx_type() const { return dslx_type_; }
 
-  // Returns a type generator for the given TypeDefinition.
+  // Returns a type generator for the given TypeDefinition. If
+  // `emit_flat_layout` is true then generated structs additionally define
+  // constexpr field offset constants and converters to/from a flat byte-buffer
+  // layout (see TranspileToCpp).
   static absl::StatusOr<std::unique_ptr<CppTypeGenerator>> Create(
       const TypeDefinition& type_definition, TypeInfo* type_info,
-      ImportData* import_data);
+      ImportData* import_data, bool emit_flat_layout = false);
 
  protected:
   std::string cpp_type_;
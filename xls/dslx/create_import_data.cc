@@ -14,17 +14,47 @@
 
 #include "xls/dslx/create_import_data.h"
 
+#include <cstdlib>
 #include <filesystem>  // NOLINT
 #include <memory>
+#include <utility>
 
+#include "absl/base/no_destructor.h"
+#include "absl/log/log.h"
 #include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xls/dslx/bytecode/bytecode_cache.h"
 #include "xls/dslx/default_dslx_stdlib_path.h"
 #include "xls/dslx/import_data.h"
+#include "xls/dslx/stdlib_snapshot.h"
 #include "xls/dslx/warning_kind.h"
 
 namespace xls::dslx {
+namespace {
+
+// Returns the stdlib snapshot named by the XLS_DSLX_STDLIB_SNAPSHOT
+// environment variable, loaded once per process, or nullptr if the variable
+// is unset or the snapshot cannot be loaded.
+std::shared_ptr<const StdlibSnapshot> GetStdlibSnapshotFromEnv() {
+  static const absl::NoDestructor<std::shared_ptr<const StdlibSnapshot>>
+      snapshot([]() -> std::shared_ptr<const StdlibSnapshot> {
+        const char* path = getenv("XLS_DSLX_STDLIB_SNAPSHOT");
+        if (path == nullptr) {
+          return nullptr;
+        }
+        absl::StatusOr<StdlibSnapshot> loaded = StdlibSnapshot::Load(path);
+        if (!loaded.ok()) {
+          LOG(WARNING) << "Failed to load DSLX stdlib snapshot from " << path
+                       << ": " << loaded.status();
+          return nullptr;
+        }
+        return std::make_shared<const StdlibSnapshot>(*std::move(loaded));
+      }());
+  return *snapshot;
+}
+
+}  // namespace
 
 ImportData CreateImportData(
     const std::filesystem::path& stdlib_path,
@@ -32,6 +62,7 @@ ImportData CreateImportData(
     WarningKindSet warnings) {
   ImportData import_data(stdlib_path, additional_search_paths, warnings);
   import_data.SetBytecodeCache(std::make_unique<BytecodeCache>(&import_data));
+  import_data.SetStdlibSnapshot(GetStdlibSnapshotFromEnv());
   return import_data;
 }
 
@@ -0,0 +1,253 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/dslx_daemon.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "absl/cleanup/cleanup.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/status/error_code_to_status.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/dslx/create_import_data.h"
+#include "xls/dslx/extract_module_name.h"
+#include "xls/dslx/import_data.h"
+#include "xls/dslx/ir_convert/convert_options.h"
+#include "xls/dslx/ir_convert/ir_converter.h"
+#include "xls/dslx/parse_and_typecheck.h"
+#include "xls/dslx/run_routines/run_comparator.h"
+#include "xls/dslx/run_routines/run_routines.h"
+
+namespace xls::dslx {
+
+DslxDaemon::DslxDaemon(Options options) : options_(std::move(options)) {}
+
+absl::Status DslxDaemon::EnsureCachesFresh() {
+  bool stale = !import_data_.has_value();
+  for (const auto& [path, load_time] : load_times_) {
+    if (stale) {
+      break;
+    }
+    std::error_code ec;
+    std::filesystem::file_time_type mtime =
+        std::filesystem::last_write_time(path, ec);
+    if (ec || mtime != load_time) {
+      VLOG(1) << "DSLX daemon: `" << path
+              << "` changed on disk; discarding cached state";
+      stale = true;
+    }
+  }
+  if (stale) {
+    import_data_.emplace(CreateImportData(
+        options_.stdlib_path, options_.dslx_paths, options_.warnings));
+    run_comparator_ = std::make_unique<RunComparator>(CompareMode::kJit);
+    load_times_.clear();
+  }
+  return absl::OkStatus();
+}
+
+void DslxDaemon::RecordLoadedFileTimes() {
+  for (const std::filesystem::path& path :
+       import_data_->GetLoadedModulePaths()) {
+    std::string key = path.string();
+    if (load_times_.contains(key)) {
+      continue;
+    }
+    std::error_code ec;
+    std::filesystem::file_time_type mtime =
+        std::filesystem::last_write_time(path, ec);
+    if (ec) {
+      // Nothing to watch for modules without a readable backing file.
+      continue;
+    }
+    load_times_.emplace(std::move(key), mtime);
+  }
+}
+
+absl::StatusOr<TypecheckedModule> DslxDaemon::Typecheck(
+    std::string_view path) {
+  XLS_ASSIGN_OR_RETURN(std::string program,
+                       GetFileContents(std::filesystem::path(path)));
+  XLS_ASSIGN_OR_RETURN(std::string module_name,
+                       ExtractModuleName(std::filesystem::path(path)));
+  absl::StatusOr<TypecheckedModule> tm =
+      ParseAndTypecheck(program, path, module_name, &*import_data_);
+  // Imports that loaded successfully before a failure stay cached, so record
+  // load times whether or not the typecheck succeeded.
+  RecordLoadedFileTimes();
+  return tm;
+}
+
+absl::StatusOr<std::string> DslxDaemon::Dispatch(std::string_view line) {
+  std::vector<std::string_view> tokens =
+      absl::StrSplit(line, ' ', absl::SkipWhitespace());
+  if (tokens.empty()) {
+    return absl::InvalidArgumentError("empty request");
+  }
+  std::string_view command = tokens[0];
+
+  if (command == "quit") {
+    quit_requested_ = true;
+    return "";
+  }
+  if (command == "reset") {
+    import_data_.reset();
+    run_comparator_.reset();
+    load_times_.clear();
+    return "";
+  }
+  if (tokens.size() != 2) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "expected a request of the form `<command> <path>`; got: `%s`", line));
+  }
+  std::string_view path = tokens[1];
+  XLS_RETURN_IF_ERROR(EnsureCachesFresh());
+
+  if (command == "typecheck") {
+    XLS_RETURN_IF_ERROR(Typecheck(path).status());
+    return "";
+  }
+  if (command == "convert-ir") {
+    XLS_ASSIGN_OR_RETURN(TypecheckedModule tm, Typecheck(path));
+    return ConvertModule(tm.module, &*import_data_, ConvertOptions{});
+  }
+  if (command == "test") {
+    XLS_ASSIGN_OR_RETURN(std::string program,
+                         GetFileContents(std::filesystem::path(path)));
+    XLS_ASSIGN_OR_RETURN(std::string module_name,
+                         ExtractModuleName(std::filesystem::path(path)));
+    ParseAndTestOptions test_options = {
+        .run_comparator = run_comparator_.get(),
+        .import_data = &*import_data_,
+    };
+    absl::StatusOr<TestResultData> result =
+        ParseAndTest(program, module_name, path, test_options);
+    RecordLoadedFileTimes();
+    XLS_RETURN_IF_ERROR(result.status());
+    std::string summary = absl::StrFormat(
+        "%s: %d ran, %d failed, %d skipped",
+        TestResultToString(result->result()), result->GetRanCount(),
+        result->GetFailedCount(), result->GetSkippedCount());
+    if (result->result() != TestResult::kAllPassed) {
+      return absl::FailedPreconditionError(summary);
+    }
+    return absl::StrCat(summary, "\n");
+  }
+  return absl::InvalidArgumentError(
+      absl::StrFormat("unknown command: `%s`", command));
+}
+
+std::string DslxDaemon::HandleRequest(std::string_view line) {
+  absl::StatusOr<std::string> payload = Dispatch(line);
+  if (!payload.ok()) {
+    return absl::StrCat("ERROR ", payload.status().message(), "\n");
+  }
+  if (payload->empty()) {
+    return "OK\n";
+  }
+  return absl::StrCat("OK\n", *payload);
+}
+
+absl::Status DslxDaemon::Serve(const std::filesystem::path& socket_path) {
+  const std::string path_str = socket_path.string();
+  sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  if (path_str.size() >= sizeof(addr.sun_path)) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("socket path is too long (%d bytes; limit is %d): %s",
+                        path_str.size(), sizeof(addr.sun_path) - 1, path_str));
+  }
+  memcpy(addr.sun_path, path_str.c_str(), path_str.size() + 1);
+
+  int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    return ErrnoToStatus(errno) << "Failed to create socket";
+  }
+  // A stale socket file left behind by a previous daemon would make bind()
+  // fail.
+  unlink(path_str.c_str());
+  absl::Cleanup cleanup = [&] {
+    close(listen_fd);
+    unlink(path_str.c_str());
+  };
+  if (bind(listen_fd, reinterpret_cast<const sockaddr*>(&addr),
+           sizeof(addr)) != 0) {
+    return ErrnoToStatus(errno) << "Failed to bind socket: " << path_str;
+  }
+  if (listen(listen_fd, SOMAXCONN) != 0) {
+    return ErrnoToStatus(errno) << "Failed to listen on socket: " << path_str;
+  }
+  LOG(INFO) << "DSLX daemon serving on " << path_str;
+
+  while (!quit_requested_) {
+    int client_fd = accept(listen_fd, nullptr, nullptr);
+    if (client_fd < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return ErrnoToStatus(errno) << "Failed to accept connection";
+    }
+    absl::Cleanup close_client = [&] { close(client_fd); };
+
+    std::string request;
+    char buf[4096];
+    while (request.find('\n') == std::string::npos) {
+      ssize_t n = read(client_fd, buf, sizeof(buf));
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        break;
+      }
+      request.append(buf, n);
+    }
+
+    std::string response = HandleRequest(request.substr(0, request.find('\n')));
+    std::string_view remaining = response;
+    while (!remaining.empty()) {
+      // MSG_NOSIGNAL: a client that hangs up early should not kill the
+      // daemon with SIGPIPE.
+      ssize_t n =
+          send(client_fd, remaining.data(), remaining.size(), MSG_NOSIGNAL);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        break;
+      }
+      remaining.remove_prefix(n);
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace xls::dslx
@@ -0,0 +1,108 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DSLX_DSLX_DAEMON_H_
+#define XLS_DSLX_DSLX_DAEMON_H_
+
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xls/dslx/default_dslx_stdlib_path.h"
+#include "xls/dslx/import_data.h"
+#include "xls/dslx/parse_and_typecheck.h"
+#include "xls/dslx/run_routines/run_comparator.h"
+#include "xls/dslx/warning_kind.h"
+
+namespace xls::dslx {
+
+// Serves typechecking, IR-conversion and test-running requests over a
+// Unix-domain socket so that incremental builds which invoke the DSLX tools
+// thousands of times pay process startup, stdlib typechecking and JIT warmup
+// once per daemon instead of once per file.
+//
+// Protocol: one request per connection. A request is a single line:
+//
+//   typecheck <path>    parse and typecheck the DSLX file at <path>
+//   convert-ir <path>   convert the DSLX file to IR; IR text is the payload
+//   test <path>         run the tests in the DSLX file at <path>
+//   reset               discard all cached state
+//   quit                shut the daemon down
+//
+// The response is a line reading "OK" or "ERROR <message>", followed by the
+// payload (if any), after which the daemon closes the connection.
+//
+// One ImportData is kept alive across requests so the stdlib and previously
+// imported modules stay typechecked, and one RunComparator so jitted
+// functions stay compiled. Before each request the modification times of all
+// source files loaded into the import data are compared against the times at
+// which they were loaded; if any file changed, the cached state is discarded
+// and rebuilt. The daemon is single-threaded and services requests in
+// arrival order.
+class DslxDaemon {
+ public:
+  struct Options {
+    std::string stdlib_path = std::string(kDefaultDslxStdlibPath);
+    std::vector<std::filesystem::path> dslx_paths;
+    WarningKindSet warnings = kDefaultWarningsSet;
+  };
+
+  explicit DslxDaemon(Options options);
+
+  // Binds a listening socket at `socket_path` and serves requests until a
+  // client sends "quit". Any stale socket file at `socket_path` is replaced;
+  // the socket file is removed again on return.
+  absl::Status Serve(const std::filesystem::path& socket_path);
+
+  // Handles a single request line and returns the response text. Exposed
+  // separately from the socket accept loop for testing.
+  std::string HandleRequest(std::string_view line);
+
+  // Whether a client has requested daemon shutdown.
+  bool quit_requested() const { return quit_requested_; }
+
+ private:
+  // Returns the response payload for a request line, or an error whose
+  // message becomes the "ERROR" line of the response.
+  absl::StatusOr<std::string> Dispatch(std::string_view line);
+
+  // Discards the cached import data and JIT state if any source file loaded
+  // into the import data has changed on disk since it was loaded.
+  absl::Status EnsureCachesFresh();
+
+  // Records the modification times of files a request newly loaded into the
+  // import data, so later requests can detect edits to them.
+  void RecordLoadedFileTimes();
+
+  // Parses and typechecks the DSLX file at `path` into the warm import data.
+  absl::StatusOr<TypecheckedModule> Typecheck(std::string_view path);
+
+  Options options_;
+  std::optional<ImportData> import_data_;
+  std::unique_ptr<RunComparator> run_comparator_;
+  // Modification time of each loaded source file at the time it was loaded.
+  absl::flat_hash_map<std::string, std::filesystem::file_time_type>
+      load_times_;
+  bool quit_requested_ = false;
+};
+
+}  // namespace xls::dslx
+
+#endif  // XLS_DSLX_DSLX_DAEMON_H_
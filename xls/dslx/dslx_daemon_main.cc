@@ -0,0 +1,95 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>  // NOLINT
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_split.h"
+#include "xls/common/exit_status.h"
+#include "xls/common/init_xls.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/dslx/default_dslx_stdlib_path.h"
+#include "xls/dslx/dslx_daemon.h"
+#include "xls/dslx/warning_kind.h"
+
+ABSL_FLAG(std::string, socket_path, "",
+          "Path of the Unix-domain socket to serve requests on (required).");
+ABSL_FLAG(std::string, dslx_stdlib_path,
+          std::string(xls::kDefaultDslxStdlibPath),
+          "Path to DSLX standard library files.");
+ABSL_FLAG(std::string, dslx_path, "",
+          "Additional paths to search for modules (colon delimited).");
+ABSL_FLAG(std::string, disable_warnings, "",
+          "Comma-delimited list of warnings to disable -- not generally "
+          "recommended, but can be used in exceptional circumstances");
+ABSL_FLAG(std::string, enable_warnings, "",
+          "Comma-delimited list of warnings to enable -- this is only useful "
+          "if/when some warnings are disabled in the default warning set");
+
+namespace xls::dslx {
+namespace {
+
+static constexpr std::string_view kUsage = R"(
+Serves DSLX typechecking, IR conversion, and test execution over a
+Unix-domain socket, keeping the stdlib, imported modules, and jitted
+functions warm across requests. See dslx_daemon.h for the request protocol.
+)";
+
+absl::Status RealMain(const std::filesystem::path& socket_path,
+                      std::vector<std::filesystem::path> dslx_paths) {
+  XLS_ASSIGN_OR_RETURN(
+      WarningKindSet warnings,
+      WarningKindSetFromDisabledString(absl::GetFlag(FLAGS_disable_warnings)));
+  XLS_ASSIGN_OR_RETURN(
+      const WarningKindSet warnings_to_enable,
+      WarningKindSetFromString(absl::GetFlag(FLAGS_enable_warnings)));
+  warnings |= warnings_to_enable;
+
+  DslxDaemon daemon(DslxDaemon::Options{
+      .stdlib_path = absl::GetFlag(FLAGS_dslx_stdlib_path),
+      .dslx_paths = std::move(dslx_paths),
+      .warnings = warnings,
+  });
+  return daemon.Serve(socket_path);
+}
+
+}  // namespace
+}  // namespace xls::dslx
+
+int main(int argc, char* argv[]) {
+  xls::InitXls(xls::dslx::kUsage, argc, argv);
+
+  std::string socket_path = absl::GetFlag(FLAGS_socket_path);
+  if (socket_path.empty()) {
+    LOG(QFATAL) << "--socket_path is required.";
+  }
+
+  std::string dslx_path = absl::GetFlag(FLAGS_dslx_path);
+  std::vector<std::string> dslx_path_strs = absl::StrSplit(dslx_path, ':');
+  std::vector<std::filesystem::path> dslx_paths;
+  dslx_paths.reserve(dslx_path_strs.size());
+  for (const auto& path : dslx_path_strs) {
+    dslx_paths.push_back(std::filesystem::path(path));
+  }
+
+  return xls::ExitStatus(
+      xls::dslx::RealMain(socket_path, std::move(dslx_paths)));
+}
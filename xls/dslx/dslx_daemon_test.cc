@@ -0,0 +1,126 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/dslx_daemon.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+
+namespace xls::dslx {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::StartsWith;
+
+TEST(DslxDaemonTest, TypecheckOk) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(dir.path() / "foo.x",
+                                "fn main(x: u32) -> u32 { x + u32:1 }\n"));
+  DslxDaemon daemon(DslxDaemon::Options{});
+  EXPECT_EQ(daemon.HandleRequest(absl::StrCat(
+                "typecheck ", (dir.path() / "foo.x").string())),
+            "OK\n");
+}
+
+TEST(DslxDaemonTest, TypecheckError) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(dir.path() / "foo.x",
+                                "fn main(x: u32) -> u8 { x }\n"));
+  DslxDaemon daemon(DslxDaemon::Options{});
+  EXPECT_THAT(daemon.HandleRequest(absl::StrCat(
+                  "typecheck ", (dir.path() / "foo.x").string())),
+              StartsWith("ERROR "));
+}
+
+TEST(DslxDaemonTest, ConvertIr) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(dir.path() / "foo.x",
+                                "fn main(x: u32) -> u32 { x + u32:1 }\n"));
+  DslxDaemon daemon(DslxDaemon::Options{});
+  std::string response = daemon.HandleRequest(
+      absl::StrCat("convert-ir ", (dir.path() / "foo.x").string()));
+  EXPECT_THAT(response, StartsWith("OK\n"));
+  EXPECT_THAT(response, HasSubstr("package foo"));
+}
+
+TEST(DslxDaemonTest, RunTests) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(dir.path() / "foo.x", R"(
+fn double(x: u32) -> u32 { x * u32:2 }
+
+#[test]
+fn test_double() { assert_eq(double(u32:2), u32:4) }
+)"));
+  DslxDaemon daemon(DslxDaemon::Options{});
+  const std::string request =
+      absl::StrCat("test ", (dir.path() / "foo.x").string());
+  std::string response = daemon.HandleRequest(request);
+  EXPECT_THAT(response, StartsWith("OK\n"));
+  EXPECT_THAT(response, HasSubstr("1 ran, 0 failed"));
+
+  // A second request is served from the warm caches.
+  EXPECT_THAT(daemon.HandleRequest(request), StartsWith("OK\n"));
+}
+
+TEST(DslxDaemonTest, FailingTestReportsError) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(dir.path() / "foo.x", R"(
+#[test]
+fn test_fails() { assert_eq(u32:1, u32:2) }
+)"));
+  DslxDaemon daemon(DslxDaemon::Options{});
+  EXPECT_THAT(daemon.HandleRequest(
+                  absl::StrCat("test ", (dir.path() / "foo.x").string())),
+              StartsWith("ERROR "));
+}
+
+TEST(DslxDaemonTest, EditedFileInvalidatesCache) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory dir, TempDirectory::Create());
+  const std::string path = (dir.path() / "foo.x").string();
+  XLS_ASSERT_OK(SetFileContents(path, "fn main(x: u32) -> u32 { x }\n"));
+  DslxDaemon daemon(DslxDaemon::Options{});
+  const std::string request = absl::StrCat("typecheck ", path);
+  EXPECT_EQ(daemon.HandleRequest(request), "OK\n");
+
+  // Rewriting the file with a type error must be noticed even though a module
+  // of the same name is already cached.
+  XLS_ASSERT_OK(SetFileContents(path, "fn main(x: u32) -> u8 { x }\n"));
+  EXPECT_THAT(daemon.HandleRequest(request), StartsWith("ERROR "));
+
+  // ... and a fix is picked up again.
+  XLS_ASSERT_OK(SetFileContents(path, "fn main(x: u32) -> u32 { x + x }\n"));
+  EXPECT_EQ(daemon.HandleRequest(request), "OK\n");
+}
+
+TEST(DslxDaemonTest, ResetAndBadRequests) {
+  DslxDaemon daemon(DslxDaemon::Options{});
+  EXPECT_EQ(daemon.HandleRequest("reset"), "OK\n");
+  EXPECT_THAT(daemon.HandleRequest(""), StartsWith("ERROR "));
+  EXPECT_THAT(daemon.HandleRequest("frobnicate /tmp/foo.x"),
+              StartsWith("ERROR "));
+  EXPECT_THAT(daemon.HandleRequest("typecheck"), StartsWith("ERROR "));
+
+  EXPECT_FALSE(daemon.quit_requested());
+  EXPECT_EQ(daemon.HandleRequest("quit"), "OK\n");
+  EXPECT_TRUE(daemon.quit_requested());
+}
+
+}  // namespace
+}  // namespace xls::dslx
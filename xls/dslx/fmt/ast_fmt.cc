@@ -30,12 +30,15 @@
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_replace.h"
 #include "absl/types/span.h"
 #include "absl/types/variant.h"
+#include "xls/common/status/ret_check.h"
 #include "xls/common/visitor.h"
 #include "xls/dslx/channel_direction.h"
 #include "xls/dslx/fmt/pretty_print.h"
@@ -2260,6 +2263,106 @@ std::string AutoFmt(const Module& m, const Comments& comments,
   return PrettyPrint(arena, ref, text_width);
 }
 
+absl::StatusOr<std::string> AutoFmtRange(const Module& m,
+                                         const Comments& comments,
+                                         std::string_view original_text,
+                                         const Span& range,
+                                         int64_t text_width) {
+  // Note: positions coming from e.g. the language server may carry a different
+  // filename than the module's spans, so we compare by line/column only.
+  auto pos_le = [](const Pos& a, const Pos& b) {
+    return std::make_pair(a.lineno(), a.colno()) <=
+           std::make_pair(b.lineno(), b.colno());
+  };
+
+  const std::vector<std::string_view> lines =
+      absl::StrSplit(original_text, '\n');
+
+  // A whole-line splice: lines [first_lineno, last_lineno] of the original
+  // text are replaced by "text".
+  struct Replacement {
+    int64_t first_lineno;
+    int64_t last_lineno;
+    std::string text;
+  };
+  std::vector<Replacement> replacements;
+
+  for (const ModuleMember& member : m.top()) {
+    const AstNode* node = ToAstNode(member);
+
+    // Desugared proc functions are formatted as part of their proc.
+    if (const Function* f = dynamic_cast<const Function*>(node);
+        f != nullptr && f->tag() != FunctionTag::kNormal) {
+      continue;
+    }
+
+    std::optional<Span> member_span = node->GetSpan();
+    CHECK(member_span.has_value()) << node->GetNodeTypeName();
+    const Pos& member_start = member_span->start();
+    const Pos& member_limit = member_span->limit();
+
+    // Skip members that do not overlap the requested range.
+    if (pos_le(member_limit, range.start()) ||
+        pos_le(range.limit(), member_start)) {
+      continue;
+    }
+
+    // We splice on whole-line boundaries, so conservatively leave the member
+    // alone if it does not start at column zero.
+    if (member_start.colno() != 0) {
+      continue;
+    }
+
+    // If the limit column is zero the limit is exclusive, so the last
+    // character is really on the prior line.
+    int64_t last_lineno = member_limit.colno() == 0
+                              ? member_limit.lineno() - 1
+                              : member_limit.lineno();
+    XLS_RET_CHECK_GE(last_lineno, member_start.lineno());
+    XLS_RET_CHECK_LT(last_lineno, static_cast<int64_t>(lines.size()));
+
+    // If there is trailing text after the member on its final line (e.g. an
+    // inline comment) we cannot replace the whole line, so leave it as-is.
+    if (member_limit.colno() != 0) {
+      std::string_view last_line = lines[last_lineno];
+      size_t tail_start =
+          std::min(static_cast<size_t>(member_limit.colno()), last_line.size());
+      if (!absl::StripAsciiWhitespace(last_line.substr(tail_start)).empty()) {
+        continue;
+      }
+    }
+
+    DocArena arena;
+    DocRef ref = Fmt(member, comments, arena);
+    replacements.push_back(Replacement{
+        .first_lineno = member_start.lineno(),
+        .last_lineno = last_lineno,
+        .text = PrettyPrint(arena, ref, text_width),
+    });
+  }
+
+  std::string result;
+  int64_t next_lineno = 0;
+  for (const Replacement& replacement : replacements) {
+    XLS_RET_CHECK_GE(replacement.first_lineno, next_lineno);
+    for (int64_t i = next_lineno; i < replacement.first_lineno; ++i) {
+      absl::StrAppend(&result, lines[i], "\n");
+    }
+    absl::StrAppend(&result, replacement.text);
+    if (!replacement.text.empty() && replacement.text.back() != '\n') {
+      absl::StrAppend(&result, "\n");
+    }
+    next_lineno = replacement.last_lineno + 1;
+  }
+  for (int64_t i = next_lineno; i < static_cast<int64_t>(lines.size()); ++i) {
+    absl::StrAppend(&result, lines[i]);
+    if (i + 1 != static_cast<int64_t>(lines.size())) {
+      absl::StrAppend(&result, "\n");
+    }
+  }
+  return result;
+}
+
 // AutoFmt output should be the same as input after whitespace is eliminated
 // excepting that:
 //
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xls/dslx/fmt/pretty_print.h"
 #include "xls/dslx/frontend/ast.h"
@@ -83,6 +84,20 @@ inline constexpr int64_t kDslxDefaultTextWidth = 100;
 std::string AutoFmt(const Module& m, const Comments& comments,
                     int64_t text_width = kDslxDefaultTextWidth);
 
+// Range-restricted auto-formatting entry point.
+//
+// Reformats only the top-level members of "m" whose spans overlap "range",
+// splicing the formatted text for each such member into "original_text" (the
+// exact text "m" was parsed from) and leaving all other bytes untouched.
+//
+// Members that cannot be safely spliced on whole-line boundaries -- e.g. ones
+// that share a line with other text such as a trailing comment -- are left
+// as-is. This lets interactive consumers (like the language server) format
+// just the definitions being edited instead of re-rendering the whole module.
+absl::StatusOr<std::string> AutoFmtRange(
+    const Module& m, const Comments& comments, std::string_view original_text,
+    const Span& range, int64_t text_width = kDslxDefaultTextWidth);
+
 // If we fail the postcondition we return back the data we used to detect that
 // the postcondition was violated.
 struct AutoFmtPostconditionViolation {
@@ -36,6 +36,7 @@
 #include "xls/dslx/frontend/bindings.h"
 #include "xls/dslx/frontend/comment_data.h"
 #include "xls/dslx/frontend/parser.h"
+#include "xls/dslx/frontend/pos.h"
 #include "xls/dslx/frontend/scanner.h"
 #include "xls/dslx/parse_and_typecheck.h"
 
@@ -1922,5 +1923,58 @@ pub fn f(a: A) -> A { if a.B[0].value == u32:0 { zero!<A>() } else { a } }
 )");
 }
 
+// -- AutoFmtRangeTest cases, formatting only a sub-span of the module
+
+class AutoFmtRangeTest : public testing::Test {
+ public:
+  absl::StatusOr<std::string> DoFmtRange(std::string_view input,
+                                         const Span& range) {
+    std::vector<CommentData> comments;
+    XLS_ASSIGN_OR_RETURN(std::unique_ptr<Module> m,
+                         ParseModule(input, "fake.x", "fake", &comments));
+    return AutoFmtRange(*m, Comments::Create(comments), input, range);
+  }
+};
+
+TEST_F(AutoFmtRangeTest, OnlyOverlappingFunctionIsReformatted) {
+  constexpr std::string_view kInput = "fn double(x:u32)->u32{u32:2*x}\n"
+                                      "\n"
+                                      "fn messy(x:u32)->u32{u32:3*x}\n";
+  // The range only covers (part of) the first function, so the second one is
+  // left byte-identical even though it would also reflow.
+  const Span range(Pos("fake.x", 0, 0), Pos("fake.x", 0, 5));
+  XLS_ASSERT_OK_AND_ASSIGN(std::string got, DoFmtRange(kInput, range));
+  EXPECT_EQ(got,
+            "fn double(x: u32) -> u32 { u32:2 * x }\n"
+            "\n"
+            "fn messy(x:u32)->u32{u32:3*x}\n");
+}
+
+TEST_F(AutoFmtRangeTest, MultiLineMemberIsSplicedWholeLeavingNeighbors) {
+  constexpr std::string_view kInput = "// leading comment stays put\n"
+                                      "const N=u32:4;\n"
+                                      "\n"
+                                      "fn messy(x:u32)\n"
+                                      "->u32{\n"
+                                      "u32:3*x}\n";
+  // Range covering only the multi-line function.
+  const Span range(Pos("fake.x", 3, 0), Pos("fake.x", 5, 0));
+  XLS_ASSERT_OK_AND_ASSIGN(std::string got, DoFmtRange(kInput, range));
+  EXPECT_EQ(got,
+            "// leading comment stays put\n"
+            "const N=u32:4;\n"
+            "\n"
+            "fn messy(x: u32) -> u32 { u32:3 * x }\n");
+}
+
+TEST_F(AutoFmtRangeTest, MemberWithTrailingCommentIsLeftAsIs) {
+  constexpr std::string_view kInput = "const A=u32:1;  // inline note\n";
+  // The trailing comment shares the member's final line, so we conservatively
+  // keep the original text rather than dropping the comment.
+  const Span range(Pos("fake.x", 0, 0), Pos("fake.x", 1, 0));
+  XLS_ASSERT_OK_AND_ASSIGN(std::string got, DoFmtRange(kInput, range));
+  EXPECT_EQ(got, kInput);
+}
+
 }  // namespace
 }  // namespace xls::dslx
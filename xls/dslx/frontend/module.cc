@@ -48,6 +48,12 @@ Module::Module(std::string name, std::optional<std::filesystem::path> fs_path)
 
 Module::~Module() {
   VLOG(3) << "Destroying module \"" << name_ << "\" @ " << this;
+  // Nodes are allocated from the module arena, so we run destructors here (in
+  // reverse allocation order) and let the arena release all of the node
+  // storage in bulk.
+  for (auto it = nodes_.rbegin(); it != nodes_.rend(); ++it) {
+    (*it)->~AstNode();
+  }
 }
 
 std::string Module::ToString() const {
@@ -88,10 +94,10 @@ std::string Module::ToString() const {
 }
 
 const AstNode* Module::FindNode(AstNodeKind kind, const Span& target) const {
-  for (const auto& node : nodes_) {
+  for (const AstNode* node : nodes_) {
     if (node->kind() == kind && node->GetSpan().has_value() &&
         node->GetSpan().value() == target) {
-      return node.get();
+      return node;
     }
   }
   return nullptr;
@@ -99,9 +105,9 @@ const AstNode* Module::FindNode(AstNodeKind kind, const Span& target) const {
 
 std::vector<const AstNode*> Module::FindIntercepting(const Pos& target) const {
   std::vector<const AstNode*> found;
-  for (const auto& node : nodes_) {
+  for (const AstNode* node : nodes_) {
     if (node->GetSpan().has_value() && node->GetSpan()->Contains(target)) {
-      found.push_back(node.get());
+      found.push_back(node);
     }
   }
   return found;
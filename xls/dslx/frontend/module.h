@@ -19,6 +19,8 @@
 #include <filesystem>  // NOLINT
 #include <functional>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -81,8 +83,10 @@ class Module : public AstNode {
 
   ~Module() override;
 
-  Module(Module&& other) = default;
-  Module& operator=(Module&& other) = default;
+  // Not movable: AST nodes are allocated from the module-owned arena and hold
+  // back-pointers to this module as their owner.
+  Module(Module&& other) = delete;
+  Module& operator=(Module&& other) = delete;
 
   AstNodeKind kind() const override { return AstNodeKind::kModule; }
 
@@ -244,11 +248,13 @@ class Module : public AstNode {
  private:
   template <typename T, typename... Args>
   T* MakeInternal(Args&&... args) {
-    std::unique_ptr<T> node =
-        std::make_unique<T>(this, std::forward<Args>(args)...);
-    T* ptr = node.get();
+    // Nodes are bump-allocated from the module-owned arena; ~Module runs the
+    // destructors and the arena releases all node storage in bulk. Node
+    // pointers are stable for the lifetime of the module.
+    void* storage = arena_.allocate(sizeof(T), alignof(T));
+    T* ptr = new (storage) T(this, std::forward<Args>(args)...);
     ptr->SetParentage();
-    nodes_.push_back(std::move(node));
+    nodes_.push_back(ptr);
     return ptr;
   }
 
@@ -285,7 +291,11 @@ class Module : public AstNode {
   std::optional<std::filesystem::path> fs_path_;
 
   std::vector<ModuleMember> top_;  // Top-level members of this module.
-  std::vector<std::unique_ptr<AstNode>> nodes_;  // Lifetime-owned AST nodes.
+
+  // Arena backing all AST node storage, and the nodes allocated from it (in
+  // allocation order) so ~Module can run their destructors.
+  std::pmr::monotonic_buffer_resource arena_;
+  std::vector<AstNode*> nodes_;  // Lifetime-owned AST nodes.
 
   // Map of top-level module member name to the member itself.
   absl::flat_hash_map<std::string, ModuleMember> top_by_name_;
@@ -65,6 +65,34 @@ absl::StatusOr<ModuleInfo*> ImportData::Put(
   return pmodule_info;
 }
 
+std::vector<std::filesystem::path> ImportData::GetLoadedModulePaths() const {
+  std::vector<std::filesystem::path> paths;
+  paths.reserve(path_to_module_info_.size());
+  for (const auto& [path, module_info] : path_to_module_info_) {
+    paths.push_back(std::filesystem::path(path));
+  }
+  return paths;
+}
+
+const ImportData::TypecheckCacheEntry* ImportData::GetTypecheckCacheEntry(
+    std::string_view module_name, std::string_view ast_text) const {
+  auto it = typecheck_cache_.find(module_name);
+  if (it == typecheck_cache_.end() || it->second.ast_text != ast_text) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void ImportData::AddTypecheckCacheEntry(
+    std::string_view module_name, std::string ast_text,
+    ModuleInfo* module_info, std::vector<WarningCollector::Entry> warnings) {
+  typecheck_cache_.insert_or_assign(
+      std::string(module_name),
+      TypecheckCacheEntry{.ast_text = std::move(ast_text),
+                          .module_info = module_info,
+                          .warnings = std::move(warnings)});
+}
+
 absl::StatusOr<TypeInfo*> ImportData::GetRootTypeInfoForNode(
     const AstNode* node) {
   XLS_RET_CHECK(node != nullptr);
@@ -35,7 +35,9 @@
 #include "xls/dslx/frontend/pos.h"
 #include "xls/dslx/import_record.h"
 #include "xls/dslx/interp_bindings.h"
+#include "xls/dslx/stdlib_snapshot.h"
 #include "xls/dslx/type_system/type_info.h"
+#include "xls/dslx/warning_collector.h"
 #include "xls/dslx/warning_kind.h"
 
 namespace xls::dslx {
@@ -179,6 +181,11 @@ class ImportData {
     top_level_bindings_done_.insert(module);
   }
 
+  // Returns the filesystem paths of all modules currently loaded into this
+  // object. Long-lived tools use this to detect when a loaded source file has
+  // changed on disk and the cached modules must be discarded.
+  std::vector<std::filesystem::path> GetLoadedModulePaths() const;
+
   const std::filesystem::path& stdlib_path() const { return stdlib_path_; }
   absl::Span<const std::filesystem::path> additional_search_paths() {
     return additional_search_paths_;
@@ -187,6 +194,16 @@ class ImportData {
   void SetBytecodeCache(std::unique_ptr<BytecodeCacheInterface> bytecode_cache);
   BytecodeCacheInterface* bytecode_cache();
 
+  // Installs a preloaded image of the stdlib sources. Stdlib imports are then
+  // satisfied from the snapshot instead of probing the filesystem; see
+  // stdlib_snapshot.h.
+  void SetStdlibSnapshot(std::shared_ptr<const StdlibSnapshot> snapshot) {
+    stdlib_snapshot_ = std::move(snapshot);
+  }
+  const StdlibSnapshot* stdlib_snapshot() const {
+    return stdlib_snapshot_.get();
+  }
+
   // Helpers for finding nodes in the cluster of modules managed by this object.
   //
   // These return a NotFound error if _either_ the module (implicitly
@@ -202,6 +219,28 @@ class ImportData {
   // into this ImportData set.
   WarningKindSet enabled_warnings() const { return enabled_warnings_; }
 
+  // An entry in the typecheck cache; see GetTypecheckCacheEntry(). `ast_text`
+  // is the printed AST of the module at the time it was typechecked and
+  // `warnings` are the warnings deduction produced, replayed on a cache hit.
+  struct TypecheckCacheEntry {
+    std::string ast_text;
+    ModuleInfo* module_info;
+    std::vector<WarningCollector::Entry> warnings;
+  };
+
+  // Returns the cached typecheck result registered under `module_name` if the
+  // module's printed AST matches `ast_text`, or nullptr if there is none.
+  // Used by TypecheckModule() to skip re-deduction of unchanged modules
+  // within a process.
+  const TypecheckCacheEntry* GetTypecheckCacheEntry(
+      std::string_view module_name, std::string_view ast_text) const;
+
+  // Notes the typecheck result for `module_name` so later typechecks of an
+  // identical module can be served from the cache.
+  void AddTypecheckCacheEntry(std::string_view module_name,
+                              std::string ast_text, ModuleInfo* module_info,
+                              std::vector<WarningCollector::Entry> warnings);
+
  private:
   friend ImportData CreateImportData(const std::filesystem::path&,
                                      absl::Span<const std::filesystem::path>,
@@ -230,11 +269,13 @@ class ImportData {
       top_level_bindings_;
   absl::flat_hash_set<Module*> top_level_bindings_done_;
   absl::flat_hash_map<Module*, AstNode*> typecheck_wip_;
+  absl::flat_hash_map<std::string, TypecheckCacheEntry> typecheck_cache_;
   TypeInfoOwner type_info_owner_;
   const std::filesystem::path stdlib_path_;
   absl::Span<const std::filesystem::path> additional_search_paths_;
   WarningKindSet enabled_warnings_;
   std::unique_ptr<BytecodeCacheInterface> bytecode_cache_;
+  std::shared_ptr<const StdlibSnapshot> stdlib_snapshot_;
 
   // See comment on AddToImporterStack() above.
   std::vector<ImportRecord> importer_stack_;
@@ -21,6 +21,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/no_destructor.h"
 #include "absl/cleanup/cleanup.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
@@ -41,6 +42,7 @@
 #include "xls/dslx/frontend/pos.h"
 #include "xls/dslx/frontend/scanner.h"
 #include "xls/dslx/import_data.h"
+#include "xls/dslx/stdlib_snapshot.h"
 #include "xls/dslx/type_system/type_info.h"
 
 namespace xls::dslx {
@@ -51,12 +53,12 @@ static absl::StatusOr<std::filesystem::path> FindExistingPath(
     const Span& import_span) {
   absl::Span<std::string const> pieces = subject.pieces();
   std::optional<std::string> subject_parent_path;
-  const absl::flat_hash_set<std::string> builtins = {
-      "std", "apfloat", "float32", "float64", "bfloat16"};
+  static const absl::NoDestructor<absl::flat_hash_set<std::string>> builtins(
+      {"std", "apfloat", "float32", "float64", "bfloat16"});
 
   // Initialize subject and parent subject path.
   std::filesystem::path subject_path;
-  if (pieces.size() == 1 && builtins.contains(pieces[0])) {
+  if (pieces.size() == 1 && builtins->contains(pieces[0])) {
     subject_path = stdlib_path / absl::StrCat(pieces[0], ".x");
   } else {
     subject_path = absl::StrJoin(pieces, "/") + ".x";
@@ -153,16 +155,35 @@ absl::StatusOr<ModuleInfo*> DoImport(const TypecheckModuleFn& ftypecheck,
 
   VLOG(3) << "DoImport (uncached) subject: " << subject.ToString();
 
-  XLS_ASSIGN_OR_RETURN(
-      std::filesystem::path found_path,
-      FindExistingPath(subject, import_data->stdlib_path(),
-                       import_data->additional_search_paths(), import_span));
+  // Single-piece imports may be satisfied from a preloaded stdlib snapshot,
+  // skipping the path probing and file read below.
+  const StdlibSnapshot::ModuleSource* snapshot_source = nullptr;
+  if (import_data->stdlib_snapshot() != nullptr &&
+      subject.pieces().size() == 1) {
+    snapshot_source =
+        import_data->stdlib_snapshot()->GetModule(subject.pieces().front());
+  }
+
+  std::filesystem::path found_path;
+  if (snapshot_source != nullptr) {
+    found_path = snapshot_source->path;
+  } else {
+    XLS_ASSIGN_OR_RETURN(
+        found_path,
+        FindExistingPath(subject, import_data->stdlib_path(),
+                         import_data->additional_search_paths(), import_span));
+  }
 
   XLS_RETURN_IF_ERROR(import_data->AddToImporterStack(import_span, found_path));
   absl::Cleanup cleanup = absl::MakeCleanup(
       [&] { CHECK_OK(import_data->PopFromImporterStack(import_span)); });
 
-  XLS_ASSIGN_OR_RETURN(std::string contents, GetFileContents(found_path));
+  std::string contents;
+  if (snapshot_source != nullptr) {
+    contents = snapshot_source->contents;
+  } else {
+    XLS_ASSIGN_OR_RETURN(contents, GetFileContents(found_path));
+  }
 
   absl::Span<std::string const> pieces = subject.pieces();
   std::string fully_qualified_name = absl::StrJoin(pieces, ".");
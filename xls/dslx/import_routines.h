@@ -44,6 +44,13 @@ using TypecheckModuleFn = std::function<absl::StatusOr<TypeInfo*>(Module*)>;
 //
 // Returns:
 //  The imported module information.
+//
+// Import processing is deliberately serial, even for independent subtrees of
+// the import DAG: new imports are discovered in the middle of typechecking
+// the importer (via `ftypecheck`), and both typechecking and module caching
+// mutate shared, non-thread-safe ImportData state (the TypeInfo owner and the
+// importer stack used for cycle detection). Parallelizing imports would
+// require making that whole path concurrency-safe first.
 absl::StatusOr<ModuleInfo*> DoImport(const TypecheckModuleFn& ftypecheck,
                                      const ImportTokens& subject,
                                      ImportData* import_data,
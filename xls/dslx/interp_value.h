@@ -398,6 +398,12 @@ class InterpValue {
   absl::StatusOr<std::string> ToEnumString(
       const EnumFormatDescriptor& fmt_desc) const;
 
+  // Note: bits-typed payloads up to 64 bits wide are stored inline (Bits is
+  // backed by an InlineBitmap with one inline word), so only aggregates and
+  // wide bits values reach the heap. Tuple/array elements cannot get inline
+  // small-buffer storage here because InterpValue is incomplete at this point
+  // in the declaration.
+  //
   // Note: currently InterpValues are not scoped to a lifetime, so we use a
   // shared_ptr for referring to token data for identity purposes.
   //
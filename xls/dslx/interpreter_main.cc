@@ -79,6 +79,10 @@ ABSL_FLAG(bool, trace_channels, false,
 ABSL_FLAG(int64_t, max_ticks, 100000,
           "If non-zero, the maximum number of ticks to execute on any proc. If "
           "exceeded an error is returned.");
+ABSL_FLAG(int64_t, test_parallelism, 1,
+          "Number of worker threads used to execute tests within the entry "
+          "module. Values greater than one run tests concurrently; ignored "
+          "when --compare is not `none`.");
 // LINT.ThenChange(//xls/build_rules/xls_dslx_rules.bzl)
 
 namespace xls::dslx {
@@ -100,7 +104,7 @@ absl::StatusOr<TestResult> RealMain(
     const std::optional<std::string>& test_filter,
     FormatPreference format_preference, CompareFlag compare_flag, bool execute,
     bool warnings_as_errors, std::optional<int64_t> seed, bool trace_channels,
-    std::optional<int64_t> max_ticks,
+    std::optional<int64_t> max_ticks, int64_t test_parallelism,
     std::optional<std::string_view> xml_output_file) {
   XLS_ASSIGN_OR_RETURN(
       WarningKindSet warnings,
@@ -150,7 +154,8 @@ absl::StatusOr<TestResult> RealMain(
                                  .warnings_as_errors = warnings_as_errors,
                                  .warnings = warnings,
                                  .trace_channels = trace_channels,
-                                 .max_ticks = max_ticks};
+                                 .max_ticks = max_ticks,
+                                 .parallelism = test_parallelism};
 
   XLS_ASSIGN_OR_RETURN(
       TestResultData test_result,
@@ -257,7 +262,8 @@ int main(int argc, char* argv[]) {
 
   absl::StatusOr<xls::dslx::TestResult> test_result = xls::dslx::RealMain(
       args[0], dslx_paths, test_filter, preference, compare_flag, execute,
-      warnings_as_errors, seed, trace_channels, max_ticks, xml_output_file);
+      warnings_as_errors, seed, trace_channels, max_ticks,
+      absl::GetFlag(FLAGS_test_parallelism), xml_output_file);
   if (!test_result.ok()) {
     return xls::ExitStatus(test_result.status());
   }
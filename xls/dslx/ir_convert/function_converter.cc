@@ -399,6 +399,10 @@ bool FunctionConverter::GetRequiresImplicitToken(dslx::Function* f) const {
 void FunctionConverter::SetFunctionBuilder(
     std::unique_ptr<BuilderBase> builder) {
   CHECK(function_builder_ == nullptr);
+  // The converter emits already-typechecked IR, so defer per-node
+  // verification and name uniquification to the single finalize step at build
+  // time.
+  builder->EnableBulkConstruction();
   function_builder_ = std::move(builder);
 }
 
@@ -233,6 +233,15 @@ absl::Status CreateBoundaryChannels(absl::Span<Param* const> params,
 
 // Converts the functions in the call graph in a specified order.
 //
+// Although the conversion order forms a DAG and independent callees look
+// parallelizable in principle, conversion is intentionally serial: a caller's
+// converter resolves already-converted callees by mangled name directly in
+// the shared output Package, channels are global Package entities created as
+// proc configs convert, and conversion constexpr-evaluates via non-
+// thread-safe ImportData/TypeInfo state. There is also no facility for
+// linking IR entities across packages, which per-thread staging packages
+// would require.
+//
 // Args:
 //   order: order for conversion
 //   import_data: Contains type information used in conversion.
@@ -24,6 +24,7 @@
 
 #include <filesystem>  // NOLINT
 #include <iostream>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <string_view>
@@ -39,8 +40,11 @@
 #include "external/verible/common/lsp/message-stream-splitter.h"
 #include "xls/common/exit_status.h"
 #include "xls/common/init_xls.h"
+#include "xls/common/thread.h"
+#include "xls/common/thread_pool.h"
 #include "xls/dslx/default_dslx_stdlib_path.h"
 #include "xls/dslx/lsp/language_server_adapter.h"
+#include "xls/dslx/lsp/workspace_index.h"
 
 ABSL_FLAG(std::string, stdlib_path, xls::kDefaultDslxStdlibPath,
           "Path to DSLX standard library files.");
@@ -50,6 +54,11 @@ ABSL_FLAG(std::string, dslx_path,
           getenv(kDslxPath) != nullptr ? getenv(kDslxPath) : "",
           "Additional paths to search for modules (colon delimited).");
 
+ABSL_FLAG(std::string, workspace_root, "",
+          "If given, DSLX modules under this directory are indexed in the "
+          "background at startup so references into modules that were never "
+          "opened in the editor resolve without waiting for a typecheck.");
+
 namespace xls::dslx {
 namespace {
 
@@ -78,6 +87,7 @@ InitializeResult InitializeServer(const nlohmann::json& params) {
       {"tooltipSupport", false},
   };
   capabilities["documentFormattingProvider"] = true;
+  capabilities["documentRangeFormattingProvider"] = true;
   return InitializeResult{
       .capabilities = std::move(capabilities),
       .serverInfo =
@@ -115,8 +125,30 @@ absl::Status RealMain() {
            << "\tdslx_path=" << dslx_path << "\n"
            << "\tcwd=" << fs::current_path().string() << "\n";
 
+  // If a workspace root is given, crawl and typecheck its modules in the
+  // background while the server starts answering requests; lookups against a
+  // partially built index simply see the modules indexed so far.
+  std::unique_ptr<WorkspaceIndex> workspace_index;
+  std::unique_ptr<Thread> index_build_thread;
+  const std::string workspace_root = absl::GetFlag(FLAGS_workspace_root);
+  if (!workspace_root.empty()) {
+    workspace_index = std::make_unique<WorkspaceIndex>(stdlib_path, dslx_paths);
+    index_build_thread = std::make_unique<Thread>([&workspace_index,
+                                                   workspace_root] {
+      absl::Status build_status =
+          workspace_index->Build(workspace_root, &GetDefaultThreadPool());
+      if (build_status.ok()) {
+        LspLog() << "Workspace index ready: " << workspace_index->module_count()
+                 << " modules\n";
+      } else {
+        LspLog() << "Workspace indexing failed: " << build_status << "\n";
+      }
+    });
+  }
+
   // Adapter that interfaces between dslx parsing and LSP
-  LanguageServerAdapter language_server_adapter(stdlib_path, dslx_paths);
+  LanguageServerAdapter language_server_adapter(stdlib_path, dslx_paths,
+                                                workspace_index.get());
 
   // The dispatcher receives json rpc requests
   // (https://www.jsonrpc.org/specification) which are passed in
@@ -196,6 +228,19 @@ absl::Status RealMain() {
         return std::vector<verible::lsp::TextEdit>{};
       });
 
+  dispatcher.AddRequestHandler(
+      "textDocument/rangeFormatting", [&](const nlohmann::json& params) {
+        const std::string uri = params["textDocument"]["uri"];
+        const verible::lsp::Range range = params["range"];
+        auto text_edits_or = language_server_adapter.FormatRange(uri, range);
+        if (text_edits_or.ok()) {
+          return text_edits_or.value();
+        }
+        LspLog() << "could not format range; status: " << text_edits_or.status()
+                 << "\n";
+        return std::vector<verible::lsp::TextEdit>{};
+      });
+
   dispatcher.AddRequestHandler(
       "textDocument/documentLink",
       [&](const verible::lsp::DocumentLinkParams& params) {
@@ -211,6 +256,10 @@ absl::Status RealMain() {
     });
   }
 
+  if (index_build_thread != nullptr) {
+    index_build_thread->Join();
+  }
+
   LspLog() << status << "\n";
   return status;
 }
@@ -62,4 +62,26 @@ std::optional<Span> FindDefinition(const Module& m, const Pos& selected) {
   return std::nullopt;
 }
 
+std::optional<ImportedMemberReference> FindImportedMemberReference(
+    const Module& m, const Pos& selected) {
+  for (const AstNode* node : m.FindIntercepting(selected)) {
+    auto* colon_ref = dynamic_cast<const ColonRef*>(node);
+    if (colon_ref == nullptr) {
+      continue;
+    }
+    std::optional<Import*> import = colon_ref->ResolveImportSubject();
+    if (!import.has_value()) {
+      continue;
+    }
+    VLOG(3) << "Intercepting colon ref: `" << colon_ref->ToString() << "`";
+    // The trailing component of the import subject is the module name, which
+    // is how workspace indices key modules (the import-site alias is local to
+    // this module).
+    return ImportedMemberReference{
+        .module_name = (*import)->subject().back(),
+        .member_name = colon_ref->attr()};
+  }
+  return std::nullopt;
+}
+
 }  // namespace xls::dslx
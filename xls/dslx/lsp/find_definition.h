@@ -16,6 +16,7 @@
 #define XLS_DSLX_LSP_FIND_DEFINITION_H_
 
 #include <optional>
+#include <string>
 
 #include "xls/dslx/frontend/ast.h"
 #include "xls/dslx/frontend/module.h"
@@ -39,6 +40,20 @@ namespace xls::dslx {
 // colon-reference to a construct in another module will return nullopt.
 std::optional<Span> FindDefinition(const Module& m, const Pos& selected);
 
+// A colon-reference to a member of an imported module; e.g. selecting
+// `foo::BAR` yields {module_name: "foo", member_name: "BAR"}.
+struct ImportedMemberReference {
+  std::string module_name;
+  std::string member_name;
+};
+
+// Looks up a colon-reference to a member of an imported module at position
+// "selected". FindDefinition() above cannot resolve such references within a
+// single module; callers instead consult a workspace-wide index with the
+// returned module/member names.
+std::optional<ImportedMemberReference> FindImportedMemberReference(
+    const Module& m, const Pos& selected);
+
 }  // namespace xls::dslx
 
 #endif  // XLS_DSLX_LSP_FIND_DEFINITION_H_
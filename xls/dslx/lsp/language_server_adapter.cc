@@ -30,6 +30,7 @@
 #include "external/verible/common/lsp/lsp-file-utils.h"
 #include "external/verible/common/lsp/lsp-protocol-enums.h"
 #include "external/verible/common/lsp/lsp-protocol.h"
+#include "xls/common/status/status_macros.h"
 #include "xls/dslx/create_import_data.h"
 #include "xls/dslx/extract_module_name.h"
 #include "xls/dslx/fmt/ast_fmt.h"
@@ -86,8 +87,11 @@ void AppendDiagnosticFromTypecheck(
 
 LanguageServerAdapter::LanguageServerAdapter(
     std::string_view stdlib,
-    const std::vector<std::filesystem::path>& dslx_paths)
-    : stdlib_(stdlib), dslx_paths_(dslx_paths) {}
+    const std::vector<std::filesystem::path>& dslx_paths,
+    const WorkspaceIndex* workspace_index)
+    : stdlib_(stdlib),
+      dslx_paths_(dslx_paths),
+      workspace_index_(workspace_index) {}
 
 const LanguageServerAdapter::ParseData* LanguageServerAdapter::FindParsedForUri(
     std::string_view uri) const {
@@ -110,6 +114,13 @@ absl::Status LanguageServerAdapter::Update(std::string_view file_uri,
   auto inserted = uri_parse_data_.emplace(file_uri, nullptr);
   std::unique_ptr<ParseData>& insert_value = inserted.first->second;
 
+  // Editors routinely send update notifications whose text is identical to
+  // what we last processed (e.g. on save); answer those from the cache
+  // instead of re-running the full parse and typecheck.
+  if (insert_value != nullptr && insert_value->contents == dslx_code) {
+    return insert_value->status();
+  }
+
   ImportData import_data =
       CreateImportData(stdlib_, dslx_paths_, kAllWarningsSet);
   const std::string& module_name = module_name_or.value();
@@ -121,13 +132,16 @@ absl::Status LanguageServerAdapter::Update(std::string_view file_uri,
 
   if (typechecked_module.ok()) {
     insert_value.reset(new ParseData{
-        std::move(import_data), TypecheckedModuleWithComments{
-                                    .tm = std::move(typechecked_module).value(),
-                                    .comments = Comments::Create(comments),
-                                }});
+        std::move(import_data),
+        TypecheckedModuleWithComments{
+            .tm = std::move(typechecked_module).value(),
+            .comments = Comments::Create(comments),
+        },
+        /*contents=*/std::string(dslx_code)});
   } else {
-    insert_value.reset(
-        new ParseData{std::move(import_data), typechecked_module.status()});
+    insert_value.reset(new ParseData{std::move(import_data),
+                                     typechecked_module.status(),
+                                     /*contents=*/std::string(dslx_code)});
   }
 
   const absl::Duration duration = absl::Now() - start;
@@ -174,6 +188,22 @@ std::vector<verible::lsp::Location> LanguageServerAdapter::FindDefinitions(
       location.uri = uri;
       return {location};
     }
+    // In-module resolution failed; colon-references into other modules can
+    // still be answered from the background workspace index.
+    if (workspace_index_ != nullptr) {
+      std::optional<ImportedMemberReference> reference =
+          FindImportedMemberReference(parsed->module(), pos);
+      if (reference.has_value()) {
+        std::optional<WorkspaceIndex::Entry> entry = workspace_index_->Lookup(
+            reference->module_name, reference->member_name);
+        if (entry.has_value()) {
+          verible::lsp::Location location =
+              ConvertSpanToLspLocation(entry->definition_span);
+          location.uri = verible::lsp::PathToLSPUri(entry->path.string());
+          return {location};
+        }
+      }
+    }
   }
   return {};
 }
@@ -191,6 +221,23 @@ LanguageServerAdapter::FormatDocument(std::string_view uri) const {
   return ResultT{};
 }
 
+absl::StatusOr<std::vector<verible::lsp::TextEdit>>
+LanguageServerAdapter::FormatRange(std::string_view uri,
+                                   const verible::lsp::Range& range) const {
+  using ResultT = std::vector<verible::lsp::TextEdit>;
+  if (const ParseData* parsed = FindParsedForUri(uri); parsed && parsed->ok()) {
+    const Module& module = parsed->module();
+    const Span target = ConvertLspRangeToSpan(uri, range);
+    XLS_ASSIGN_OR_RETURN(
+        std::string new_contents,
+        AutoFmtRange(module, parsed->comments(), parsed->contents, target));
+    return ResultT{
+        verible::lsp::TextEdit{.range = ConvertSpanToLspRange(module.span()),
+                               .newText = new_contents}};
+  }
+  return ResultT{};
+}
+
 std::vector<verible::lsp::DocumentLink>
 LanguageServerAdapter::ProvideImportLinks(std::string_view uri) const {
   std::vector<verible::lsp::DocumentLink> result;
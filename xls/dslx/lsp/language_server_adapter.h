@@ -31,6 +31,7 @@
 #include "xls/dslx/fmt/ast_fmt.h"
 #include "xls/dslx/frontend/module.h"
 #include "xls/dslx/import_data.h"
+#include "xls/dslx/lsp/workspace_index.h"
 #include "xls/dslx/parse_and_typecheck.h"
 
 namespace xls::dslx {
@@ -45,8 +46,12 @@ inline std::ostream& LspLog() { return std::cerr; }
 // serializing entity).
 class LanguageServerAdapter {
  public:
+  // If `workspace_index` is non-null it is consulted to resolve references
+  // into modules this adapter has not opened; it may still be building in the
+  // background (its lookups are thread-safe) and must outlive the adapter.
   LanguageServerAdapter(std::string_view stdlib,
-                        const std::vector<std::filesystem::path>& dslx_paths);
+                        const std::vector<std::filesystem::path>& dslx_paths,
+                        const WorkspaceIndex* workspace_index = nullptr);
 
   // Note: this is parsing is triggered for every keystroke. Fine for now.
   // Successful and unsuccessful parses are memoized so that their status
@@ -76,6 +81,15 @@ class LanguageServerAdapter {
   absl::StatusOr<std::vector<verible::lsp::TextEdit>> FormatDocument(
       std::string_view uri) const;
 
+  // Implements the functionality for range formatting:
+  // https://microsoft.github.io/language-server-protocol/specifications/lsp/3.17/specification/#textDocument_rangeFormatting
+  //
+  // Only the top-level definitions overlapping "range" are reformatted; the
+  // rest of the buffer is left byte-identical. This keeps formatting
+  // interactive on large files.
+  absl::StatusOr<std::vector<verible::lsp::TextEdit>> FormatRange(
+      std::string_view uri, const verible::lsp::Range& range) const;
+
   // Present links to imports to directly open the relevant file.
   std::vector<verible::lsp::DocumentLink> ProvideImportLinks(
       std::string_view uri) const;
@@ -98,6 +112,10 @@ class LanguageServerAdapter {
     ImportData import_data;
     absl::StatusOr<TypecheckedModuleWithComments> tmc;
 
+    // The exact buffer contents this parse result was produced from, so
+    // updates carrying unchanged text can be answered from the cache.
+    std::string contents;
+
     bool ok() const { return tmc.ok(); }
     absl::Status status() const { return tmc.status(); }
 
@@ -117,6 +135,7 @@ class LanguageServerAdapter {
 
   const std::string stdlib_;
   const std::vector<std::filesystem::path> dslx_paths_;
+  const WorkspaceIndex* workspace_index_;
   absl::flat_hash_map<std::string, std::unique_ptr<ParseData>> uri_parse_data_;
 };
 
@@ -24,8 +24,12 @@
 #include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "external/verible/common/lsp/lsp-protocol.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
 #include "xls/common/status/matchers.h"
+#include "xls/common/thread_pool.h"
 #include "xls/dslx/default_dslx_stdlib_path.h"
+#include "xls/dslx/lsp/workspace_index.h"
 
 namespace xls::dslx {
 namespace {
@@ -87,6 +91,23 @@ TEST(LanguageServerAdapterTest, LanguageServerRetainsParseResultForAllBuffers) {
   EXPECT_EQ(adapter.GenerateDocumentSymbols("non-existent.x").size(), 0);
 }
 
+TEST(LanguageServerAdapterTest, UnchangedUpdateIsServedFromCache) {
+  LanguageServerAdapter adapter(kDefaultDslxStdlibPath, /*dslx_paths=*/{"."});
+  constexpr std::string_view kUri = "memfile://test.x";
+
+  // Both the success and error status of a buffer must be stable across
+  // repeated updates with identical text (which hit the cache).
+  XLS_ASSERT_OK(adapter.Update(kUri, "fn f() { () }"));
+  XLS_ASSERT_OK(adapter.Update(kUri, "fn f() { () }"));
+  EXPECT_EQ(adapter.GenerateDocumentSymbols(kUri).size(), 1);
+
+  EXPECT_THAT(adapter.Update(kUri, "blahblahblah"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(adapter.Update(kUri, "blahblahblah"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_EQ(adapter.GenerateParseDiagnostics(kUri).size(), 1);
+}
+
 TEST(LanguageServerAdapterTest, TestFindDefinitionsFunctionRef) {
   LanguageServerAdapter adapter(kDefaultDslxStdlibPath, /*dslx_paths=*/{"."});
   constexpr std::string_view kUri = "memfile://test.x";
@@ -105,6 +126,33 @@ fn main() { f() })"));
   EXPECT_TRUE(definition_location.range.end == want_end);
 }
 
+TEST(LanguageServerAdapterTest, TestFindDefinitionsAcrossModulesViaIndex) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory workspace, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(workspace.path() / "lib.x",
+                                "pub const FOO = u32:42;\n"));
+
+  WorkspaceIndex index(kDefaultDslxStdlibPath,
+                       /*dslx_paths=*/{workspace.path()});
+  ThreadPool pool(1);
+  XLS_ASSERT_OK(index.Build(workspace.path(), &pool));
+
+  LanguageServerAdapter adapter(kDefaultDslxStdlibPath,
+                                /*dslx_paths=*/{workspace.path()}, &index);
+  constexpr std::string_view kUri = "memfile://test.x";
+  XLS_ASSERT_OK(adapter.Update(kUri, R"(import lib;
+fn main() -> u32 { lib::FOO })"));
+  // Position inside the `FOO` of `lib::FOO`.
+  verible::lsp::Position position{1, 25};
+  std::vector<verible::lsp::Location> definition_locations =
+      adapter.FindDefinitions(kUri, position);
+  ASSERT_EQ(definition_locations.size(), 1);
+
+  verible::lsp::Location definition_location = definition_locations.at(0);
+  EXPECT_TRUE(absl::StrContains(definition_location.uri, "lib.x"));
+  const auto want_start = verible::lsp::Position{0, 10};
+  EXPECT_TRUE(definition_location.range.start == want_start);
+}
+
 TEST(LanguageServerAdapterTest, TestFindDefinitionsTypeRef) {
   LanguageServerAdapter adapter(kDefaultDslxStdlibPath, /*dslx_paths=*/{"."});
   constexpr std::string_view kUri = "memfile://test.x";
@@ -193,5 +241,27 @@ fn messy() {
 )");
 }
 
+TEST(LanguageServerAdapterTest, RangeFormattingOnlyTouchesOverlappingMember) {
+  LanguageServerAdapter adapter(kDefaultDslxStdlibPath, /*dslx_paths=*/{"."});
+  constexpr std::string_view kUri = "memfile://test.x";
+  XLS_ASSERT_OK(adapter.Update(kUri, R"(fn messy(x:u32)->u32{u32:2*x}
+
+fn also_messy(x:u32)->u32{u32:3*x}
+)"));
+  // Range covering only the first function -- the second one should come back
+  // byte-identical even though it would also reflow.
+  const auto kRange =
+      verible::lsp::Range{.start = verible::lsp::Position{0, 0},
+                          .end = verible::lsp::Position{0, 5}};
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<verible::lsp::TextEdit> edits,
+                           adapter.FormatRange(kUri, kRange));
+
+  ASSERT_EQ(edits.size(), 1);
+  EXPECT_EQ(edits.at(0).newText, R"(fn messy(x: u32) -> u32 { u32:2 * x }
+
+fn also_messy(x:u32)->u32{u32:3*x}
+)");
+}
+
 }  // namespace
 }  // namespace xls::dslx
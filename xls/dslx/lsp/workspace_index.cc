@@ -0,0 +1,158 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/lsp/workspace_index.h"
+
+#include <cstdint>
+#include <filesystem>  // NOLINT
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>  // NOLINT
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/variant.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/visitor.h"
+#include "xls/dslx/create_import_data.h"
+#include "xls/dslx/extract_module_name.h"
+#include "xls/dslx/frontend/ast.h"
+#include "xls/dslx/frontend/module.h"
+#include "xls/dslx/frontend/pos.h"
+#include "xls/dslx/import_data.h"
+#include "xls/dslx/parse_and_typecheck.h"
+#include "xls/dslx/warning_kind.h"
+
+namespace xls::dslx {
+namespace {
+
+// Returns the name definition of a module member that binds a name usable in
+// a colon-reference from another module, or nullptr for members that bind
+// nothing navigable (tests, quickchecks, imports, const asserts).
+const NameDef* GetNavigableNameDef(const ModuleMember& member) {
+  return absl::visit(
+      Visitor{
+          [](Function* f) -> const NameDef* { return f->name_def(); },
+          [](Proc* p) -> const NameDef* { return p->name_def(); },
+          [](TestFunction*) -> const NameDef* { return nullptr; },
+          [](TestProc*) -> const NameDef* { return nullptr; },
+          [](QuickCheck*) -> const NameDef* { return nullptr; },
+          [](TypeAlias* t) -> const NameDef* { return &t->name_def(); },
+          [](StructDef* s) -> const NameDef* { return s->name_def(); },
+          [](ConstantDef* c) -> const NameDef* { return c->name_def(); },
+          [](EnumDef* e) -> const NameDef* { return e->name_def(); },
+          [](Import*) -> const NameDef* { return nullptr; },
+          [](ConstAssert*) -> const NameDef* { return nullptr; },
+      },
+      member);
+}
+
+}  // namespace
+
+absl::Status WorkspaceIndex::Build(const std::filesystem::path& root,
+                                   ThreadPool* pool) {
+  std::vector<std::filesystem::path> files;
+  std::error_code ec;
+  for (std::filesystem::recursive_directory_iterator it(root, ec), end;
+       it != end; it.increment(ec)) {
+    if (ec) {
+      return absl::NotFoundError(absl::StrFormat(
+          "Cannot crawl workspace root `%s`: %s", root.string(), ec.message()));
+    }
+    if (it->is_regular_file() && it->path().extension() == ".x") {
+      files.push_back(it->path());
+    }
+  }
+  if (ec) {
+    return absl::NotFoundError(absl::StrFormat(
+        "Cannot crawl workspace root `%s`: %s", root.string(), ec.message()));
+  }
+
+  pool->ParallelFor(static_cast<int64_t>(files.size()),
+                    [&](int64_t i) { IndexOneFile(files[i]); });
+  return absl::OkStatus();
+}
+
+void WorkspaceIndex::IndexOneFile(const std::filesystem::path& path) {
+  absl::StatusOr<std::string> contents = GetFileContents(path);
+  if (!contents.ok()) {
+    VLOG(1) << "Workspace index: cannot read `" << path
+            << "`: " << contents.status();
+    return;
+  }
+  absl::StatusOr<std::string> module_name = ExtractModuleName(path);
+  if (!module_name.ok()) {
+    VLOG(1) << "Workspace index: no module name for `" << path
+            << "`: " << module_name.status();
+    return;
+  }
+
+  // Each file gets its own ImportData: frontend state is not thread-safe to
+  // share across pool workers.
+  ImportData import_data =
+      CreateImportData(stdlib_path_, dslx_paths_, kDefaultWarningsSet);
+  absl::StatusOr<TypecheckedModule> tm =
+      ParseAndTypecheck(*contents, path.string(), *module_name, &import_data);
+  if (!tm.ok()) {
+    // Work-in-progress files are expected in a live workspace; they are
+    // simply absent from the index.
+    VLOG(1) << "Workspace index: skipping `" << path << "`: " << tm.status();
+    return;
+  }
+
+  absl::flat_hash_map<std::string, Entry> members;
+  for (const ModuleMember& member : tm->module->top()) {
+    const NameDef* name_def = GetNavigableNameDef(member);
+    if (name_def == nullptr) {
+      continue;
+    }
+    members.insert(
+        {name_def->identifier(),
+         Entry{.module_name = *module_name,
+               .member_name = name_def->identifier(),
+               .path = path,
+               .definition_span = name_def->span()}});
+  }
+
+  absl::MutexLock lock(&mutex_);
+  modules_.insert_or_assign(*module_name, std::move(members));
+}
+
+std::optional<WorkspaceIndex::Entry> WorkspaceIndex::Lookup(
+    std::string_view module_name, std::string_view member_name) const {
+  absl::MutexLock lock(&mutex_);
+  auto module_it = modules_.find(module_name);
+  if (module_it == modules_.end()) {
+    return std::nullopt;
+  }
+  auto member_it = module_it->second.find(member_name);
+  if (member_it == module_it->second.end()) {
+    return std::nullopt;
+  }
+  return member_it->second;
+}
+
+int64_t WorkspaceIndex::module_count() const {
+  absl::MutexLock lock(&mutex_);
+  return static_cast<int64_t>(modules_.size());
+}
+
+}  // namespace xls::dslx
@@ -0,0 +1,91 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DSLX_LSP_WORKSPACE_INDEX_H_
+#define XLS_DSLX_LSP_WORKSPACE_INDEX_H_
+
+#include <cstdint>
+#include <filesystem>  // NOLINT
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/thread_pool.h"
+#include "xls/dslx/frontend/pos.h"
+
+namespace xls::dslx {
+
+// Index of top-level definitions across all DSLX modules in a workspace, so
+// that colon-references to modules the editor has never opened can be
+// resolved without typechecking on the navigation path.
+//
+// Build() crawls the workspace for `.x` files and typechecks them on the
+// shared thread pool; each file is processed into its own ImportData since
+// frontend state is not thread-safe to share. Modules are published into the
+// index as they complete, so lookups issued while the build is still running
+// see the modules indexed so far.
+//
+// Thread safety: Lookup()/module_count() may be called concurrently with
+// Build() and with each other.
+class WorkspaceIndex {
+ public:
+  // Where a top-level definition lives.
+  struct Entry {
+    std::string module_name;
+    std::string member_name;
+    std::filesystem::path path;
+    Span definition_span;
+  };
+
+  WorkspaceIndex(std::string_view stdlib_path,
+                 std::vector<std::filesystem::path> dslx_paths)
+      : stdlib_path_(stdlib_path), dslx_paths_(std::move(dslx_paths)) {}
+
+  // Crawls `root` recursively for `.x` files and indexes them using up to
+  // `pool`'s worker count of concurrent typechecks. Files that fail to parse
+  // or typecheck are skipped (the workspace routinely contains
+  // work-in-progress files). Returns an error only if `root` cannot be
+  // crawled.
+  absl::Status Build(const std::filesystem::path& root, ThreadPool* pool);
+
+  // Returns the location of top-level definition `member_name` in the module
+  // named `module_name`, if indexed.
+  std::optional<Entry> Lookup(std::string_view module_name,
+                              std::string_view member_name) const;
+
+  // Number of modules indexed so far.
+  int64_t module_count() const;
+
+ private:
+  // Typechecks the file at `path` and publishes its top-level definitions.
+  void IndexOneFile(const std::filesystem::path& path);
+
+  const std::string stdlib_path_;
+  const std::vector<std::filesystem::path> dslx_paths_;
+
+  mutable absl::Mutex mutex_;
+  // Module name -> member name -> entry.
+  absl::flat_hash_map<std::string, absl::flat_hash_map<std::string, Entry>>
+      modules_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace xls::dslx
+
+#endif  // XLS_DSLX_LSP_WORKSPACE_INDEX_H_
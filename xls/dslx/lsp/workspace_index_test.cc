@@ -0,0 +1,81 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/lsp/workspace_index.h"
+
+#include <optional>
+
+#include "gtest/gtest.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+#include "xls/common/thread_pool.h"
+
+namespace xls::dslx {
+namespace {
+
+TEST(WorkspaceIndexTest, IndexesWorkspace) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory workspace, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(workspace.path() / "lib.x", R"(
+pub const FOO = u32:42;
+pub fn add1(x: u32) -> u32 { x + u32:1 }
+pub struct Point { x: u32, y: u32 }
+)"));
+  XLS_ASSERT_OK(SetFileContents(workspace.path() / "user.x", R"(
+import lib;
+fn main() -> u32 { lib::add1(lib::FOO) }
+)"));
+
+  WorkspaceIndex index(/*stdlib_path=*/"",
+                       /*dslx_paths=*/{workspace.path()});
+  ThreadPool pool(2);
+  XLS_ASSERT_OK(index.Build(workspace.path(), &pool));
+  EXPECT_EQ(index.module_count(), 2);
+
+  std::optional<WorkspaceIndex::Entry> entry = index.Lookup("lib", "add1");
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->module_name, "lib");
+  EXPECT_EQ(entry->path, workspace.path() / "lib.x");
+  EXPECT_EQ(entry->definition_span.start().lineno(), 2);
+
+  EXPECT_TRUE(index.Lookup("lib", "Point").has_value());
+  EXPECT_TRUE(index.Lookup("lib", "FOO").has_value());
+  EXPECT_FALSE(index.Lookup("lib", "nonexistent").has_value());
+  EXPECT_FALSE(index.Lookup("nonexistent", "add1").has_value());
+}
+
+TEST(WorkspaceIndexTest, BrokenFilesAreSkipped) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory workspace, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(workspace.path() / "good.x",
+                                "pub fn id(x: u32) -> u32 { x }\n"));
+  XLS_ASSERT_OK(SetFileContents(workspace.path() / "broken.x",
+                                "this is not a valid module\n"));
+  XLS_ASSERT_OK(
+      SetFileContents(workspace.path() / "notes.txt", "not DSLX at all\n"));
+
+  WorkspaceIndex index(/*stdlib_path=*/"", /*dslx_paths=*/{});
+  ThreadPool pool(2);
+  XLS_ASSERT_OK(index.Build(workspace.path(), &pool));
+  EXPECT_EQ(index.module_count(), 1);
+  EXPECT_TRUE(index.Lookup("good", "id").has_value());
+}
+
+TEST(WorkspaceIndexTest, MissingRootIsAnError) {
+  WorkspaceIndex index(/*stdlib_path=*/"", /*dslx_paths=*/{});
+  ThreadPool pool(1);
+  EXPECT_FALSE(index.Build("/this/path/does/not/exist", &pool).ok());
+}
+
+}  // namespace
+}  // namespace xls::dslx
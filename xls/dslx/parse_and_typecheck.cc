@@ -87,17 +87,37 @@ absl::StatusOr<TypecheckedModule> TypecheckModule(
 
   std::string_view module_name = module->name();
 
+  // If an identical module has already been typechecked into this ImportData
+  // serve the previous result instead of re-deducing every definition. The
+  // returned module and type information are those of the earlier typecheck
+  // (both are owned by the import data either way); the recorded warnings are
+  // replayed into a fresh collector.
+  std::string ast_text = module->ToString();
+  if (const ImportData::TypecheckCacheEntry* entry =
+          import_data->GetTypecheckCacheEntry(module_name, ast_text);
+      entry != nullptr) {
+    WarningCollector warnings(import_data->enabled_warnings());
+    for (const WarningCollector::Entry& warning : entry->warnings) {
+      warnings.Add(warning.span, warning.kind, warning.message);
+    }
+    return TypecheckedModule{&entry->module_info->module(),
+                             entry->module_info->type_info(),
+                             std::move(warnings)};
+  }
+
   WarningCollector warnings(import_data->enabled_warnings());
   XLS_ASSIGN_OR_RETURN(TypeInfo * type_info,
                        TypecheckModule(module.get(), import_data, &warnings));
   TypecheckedModule result{module.get(), type_info, std::move(warnings)};
   XLS_ASSIGN_OR_RETURN(ImportTokens subject,
                        ImportTokens::FromString(module_name));
-  XLS_RETURN_IF_ERROR(import_data
-                          ->Put(subject, std::make_unique<ModuleInfo>(
-                                             std::move(module), type_info,
-                                             std::filesystem::path(path)))
-                          .status());
+  XLS_ASSIGN_OR_RETURN(
+      ModuleInfo * module_info,
+      import_data->Put(subject, std::make_unique<ModuleInfo>(
+                                    std::move(module), type_info,
+                                    std::filesystem::path(path))));
+  import_data->AddTypecheckCacheEntry(module_name, std::move(ast_text),
+                                      module_info, result.warnings.warnings());
   return result;
 }
 
@@ -0,0 +1,78 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/parse_and_typecheck.h"
+
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "xls/common/status/matchers.h"
+#include "xls/dslx/create_import_data.h"
+#include "xls/dslx/frontend/ast.h"
+#include "xls/dslx/import_data.h"
+
+namespace xls::dslx {
+namespace {
+
+TEST(ParseAndTypecheckTest, UnchangedModuleIsServedFromTypecheckCache) {
+  constexpr std::string_view kProgram = R"(
+fn id(x: u32) -> u32 { x }
+
+fn main(x: u32) -> u32 { id(x) + u32:1 }
+)";
+  ImportData import_data = CreateImportDataForTest();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TypecheckedModule first,
+      ParseAndTypecheck(kProgram, "test.x", "test", &import_data));
+
+  // Typechecking an identical module again returns the module and type
+  // information of the first typecheck rather than failing or re-deducing.
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<Module> reparsed,
+                           ParseModule(kProgram, "test.x", "test"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TypecheckedModule second,
+      TypecheckModule(std::move(reparsed), "test.x", &import_data));
+  EXPECT_EQ(first.module, second.module);
+  EXPECT_EQ(first.type_info, second.type_info);
+}
+
+TEST(ParseAndTypecheckTest, CachedTypecheckReplaysWarnings) {
+  // `let _ = ...` provokes a "useless anonymous binding"-style warning which
+  // must also be reported when the result comes from the cache.
+  constexpr std::string_view kProgram = R"(
+fn main() -> u32 {
+    let x = u32:42;
+    x
+}
+
+fn unused_helper() -> u32 { u32:0 }
+)";
+  ImportData import_data = CreateImportDataForTest();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TypecheckedModule first,
+      ParseAndTypecheck(kProgram, "test.x", "test", &import_data));
+
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<Module> reparsed,
+                           ParseModule(kProgram, "test.x", "test"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TypecheckedModule second,
+      TypecheckModule(std::move(reparsed), "test.x", &import_data));
+  EXPECT_EQ(first.warnings.warnings().size(),
+            second.warnings.warnings().size());
+}
+
+}  // namespace
+}  // namespace xls::dslx
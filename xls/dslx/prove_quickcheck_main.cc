@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>  // NOLINT
 #include <memory>
@@ -48,6 +49,10 @@ ABSL_FLAG(std::string, disable_warnings, "",
           "recommended, but can be used in exceptional circumstances");
 ABSL_FLAG(bool, warnings_as_errors, true,
           "Whether to fail early, as an error, if warnings are detected");
+ABSL_FLAG(int64_t, parallelism, 1,
+          "Number of worker threads used to prove quickcheck properties; "
+          "with the default of 1 properties are proven serially on the "
+          "calling thread.");
 
 static constexpr std::string_view kUsage = R"(
 Attempts to proves a single quickcheck property in a given module to be
@@ -60,7 +65,7 @@ namespace {
 absl::StatusOr<TestResultData> RealMain(
     std::string_view entry_module_path, std::string_view test_filter,
     absl::Span<const std::filesystem::path> dslx_paths, bool warnings_as_errors,
-    std::optional<std::string_view> xml_output_file) {
+    int64_t parallelism, std::optional<std::string_view> xml_output_file) {
   XLS_ASSIGN_OR_RETURN(
       WarningKindSet warnings,
       WarningKindSetFromDisabledString(absl::GetFlag(FLAGS_disable_warnings)));
@@ -85,6 +90,7 @@ absl::StatusOr<TestResultData> RealMain(
       .test_filter = test_filter_re_ptr,
       .warnings_as_errors = warnings_as_errors,
       .warnings = warnings,
+      .parallelism = parallelism,
   };
 
   XLS_ASSIGN_OR_RETURN(
@@ -138,7 +144,8 @@ int main(int argc, char** argv) {
 
   absl::StatusOr<xls::dslx::TestResultData> test_result =
       xls::dslx::RealMain(positional_arguments[0], test_filter, dslx_paths,
-                          warnings_as_errors, xml_output_file);
+                          warnings_as_errors, absl::GetFlag(FLAGS_parallelism),
+                          xml_output_file);
   if (!test_result.ok()) {
     return xls::ExitStatus(test_result.status());
   }
@@ -15,6 +15,7 @@
 #include "xls/dslx/run_routines/run_comparator.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -94,6 +95,12 @@ absl::Status RunComparator::RunComparison(Package* ir_package,
     ir_args.insert(ir_args.begin(), Value::Token());
   }
 
+  // Convert the interpreter value to an IR value so we can compare it.
+  //
+  // Note this conversion is lossy, but that's ok because we're just looking for
+  // mismatches.
+  XLS_ASSIGN_OR_RETURN(Value interp_ir_value, got.ConvertToIr());
+
   const char* mode_str = nullptr;
   Value ir_result;
   switch (mode_) {
@@ -102,7 +109,18 @@ absl::Status RunComparator::RunComparison(Package* ir_package,
       // once the DSLX interpreter supports them (and the JIT supports traces).
       XLS_ASSIGN_OR_RETURN(FunctionJit * jit,
                            GetOrCompileJitFunction(ir_name, ir_function));
-      XLS_ASSIGN_OR_RETURN(ir_result, DropInterpreterEvents(jit->Run(ir_args)));
+      // Compare on the JIT's raw result buffer; a full result Value is only
+      // materialized for mismatching runs, which are vanishingly rare.
+      Value expected_ir_value = interp_ir_value;
+      if (requires_implicit_token) {
+        expected_ir_value = Value::Tuple({Value::Token(), interp_ir_value});
+      }
+      XLS_ASSIGN_OR_RETURN(std::optional<Value> mismatch,
+                           jit->RunAndCompare(ir_args, expected_ir_value));
+      if (!mismatch.has_value()) {
+        return absl::OkStatus();
+      }
+      ir_result = std::move(*mismatch);
       mode_str = "JIT";
       break;
     }
@@ -122,12 +140,6 @@ absl::Status RunComparator::RunComparison(Package* ir_package,
     ir_result = std::move(real_ir_result);
   }
 
-  // Convert the interpreter value to an IR value so we can compare it.
-  //
-  // Note this conversion is lossy, but that's ok because we're just looking for
-  // mismatches.
-  XLS_ASSIGN_OR_RETURN(Value interp_ir_value, got.ConvertToIr());
-
   if (interp_ir_value != ir_result) {
     return absl::InternalError(
         absl::StrFormat("IR %s produced a different value from the DSL "
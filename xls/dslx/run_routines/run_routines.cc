@@ -17,6 +17,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <ctime>
 #include <functional>
@@ -43,6 +44,7 @@
 #include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/dslx/bytecode/bytecode.h"
 #include "xls/dslx/bytecode/bytecode_cache.h"
 #include "xls/dslx/bytecode/bytecode_emitter.h"
@@ -420,6 +422,73 @@ static absl::Status RunQuickChecksIfJitEnabled(
   return absl::OkStatus();
 }
 
+// Outcome of proving one quickcheck property, captured so parallel runs can
+// replay per-property output and records in declaration order after the
+// workers have joined.
+struct QuickcheckOutcome {
+  absl::Status status;
+  std::vector<Value> counterexample;
+  absl::Time start;
+  absl::Duration duration;
+};
+
+// Converts the quickcheck property `quickcheck` into its own IR package and
+// attempts to prove it infallible through the Z3 translator. Every call
+// translates into an independent solver context, so distinct properties may
+// be proven concurrently. On disproof returns the proof error and populates
+// `counterexample`.
+static absl::Status ProveSingleQuickcheck(ImportData* import_data,
+                                          Module* entry_module,
+                                          QuickCheck* quickcheck,
+                                          std::vector<Value>* counterexample) {
+  Function* f = quickcheck->f();
+  VLOG(1) << "Found quickcheck function: " << f->identifier();
+
+  Package package(entry_module->name());
+  XLS_RETURN_IF_ERROR(ConvertOneFunctionIntoPackage(
+      entry_module, f, import_data,
+      /*parametric_env=*/nullptr, ConvertOptions{}, &package));
+
+  // Note: we need this to eliminate unoptimized IR constructs that are not
+  // currently handled for translation; e.g. bounded-for-loops and non-inlined
+  // function calls.
+  XLS_RETURN_IF_ERROR(RunOptimizationPassPipeline(&package).status());
+
+  XLS_ASSIGN_OR_RETURN(std::string ir_function_name,
+                       MangleDslxName(entry_module->name(), f->identifier(),
+                                      CallingConvention::kTypical));
+  XLS_ASSIGN_OR_RETURN(xls::Function * ir_function,
+                       package.GetFunction(ir_function_name));
+  VLOG(1) << "Found IR function: " << ir_function->name();
+
+  XLS_ASSIGN_OR_RETURN(
+      solvers::z3::ProverResult proven,
+      solvers::z3::TryProve(ir_function, ir_function->return_value(),
+                            solvers::z3::Predicate::NotEqualToZero(),
+                            absl::InfiniteDuration()));
+  VLOG(1) << "Proven? "
+          << (std::holds_alternative<solvers::z3::ProvenTrue>(proven)
+                  ? "true"
+                  : "false");
+
+  if (std::holds_alternative<solvers::z3::ProvenTrue>(proven)) {
+    return absl::OkStatus();
+  }
+
+  const auto& proven_false = std::get<solvers::z3::ProvenFalse>(proven);
+
+  // Extract the counterexample, and collapse it back into sequential order.
+  using ParamValues = absl::flat_hash_map<const xls::Param*, Value>;
+  XLS_ASSIGN_OR_RETURN(ParamValues counterexample_map,
+                       proven_false.counterexample);
+  for (const xls::Param* param : ir_function->params()) {
+    counterexample->push_back(counterexample_map[param]);
+  }
+  std::string one_liner =
+      absl::StrCat("counterexample: ", absl::StrJoin(*counterexample, ", "));
+  return ProofErrorStatus(quickcheck->span(), one_liner);
+}
+
 absl::StatusOr<ParseAndProveResult> ParseAndProve(
     std::string_view program, std::string_view module_name,
     std::string_view filename, const ParseAndProveOptions& options) {
@@ -461,16 +530,67 @@ absl::StatusOr<ParseAndProveResult> ParseAndProve(
   // Counter-examples map from failing test name -> counterexample values.
   absl::flat_hash_map<std::string, std::vector<Value>> counterexamples;
 
-  for (const std::string& quickcheck_name :
-       entry_module->GetQuickCheckNames()) {
+  const std::vector<std::string> quickcheck_names =
+      entry_module->GetQuickCheckNames();
+  int64_t parallelism = std::max<int64_t>(options.parallelism, int64_t{1});
+  parallelism = std::min<int64_t>(
+      parallelism, static_cast<int64_t>(quickcheck_names.size()));
+
+  // When proving in parallel, workers claim property indices and record
+  // outcomes here; per-property output and result records are replayed in
+  // declaration order below. Each worker re-parses and re-typechecks the
+  // program into its own ImportData (frontend state is not thread-safe to
+  // share), and every proof attempt translates into an independent Z3 solver
+  // context.
+  std::vector<QuickcheckOutcome> outcomes(quickcheck_names.size());
+  if (parallelism > 1) {
+    std::atomic<int64_t> next_index = 0;
+    std::vector<std::unique_ptr<Thread>> threads;
+    threads.reserve(parallelism);
+    for (int64_t i = 0; i < parallelism; ++i) {
+      threads.push_back(std::make_unique<Thread>([&]() {
+        auto worker_import_data = CreateImportData(
+            options.stdlib_path, options.dslx_paths, options.warnings);
+        absl::StatusOr<TypecheckedModule> worker_tm = ParseAndTypecheck(
+            program, filename, module_name, &worker_import_data);
+        const int64_t num_properties =
+            static_cast<int64_t>(quickcheck_names.size());
+        for (int64_t index = next_index.fetch_add(1); index < num_properties;
+             index = next_index.fetch_add(1)) {
+          const std::string& quickcheck_name = quickcheck_names[index];
+          if (!TestMatchesFilter(quickcheck_name, options.test_filter)) {
+            continue;
+          }
+          QuickcheckOutcome& outcome = outcomes[index];
+          outcome.start = absl::Now();
+          if (!worker_tm.ok()) {
+            // The main-thread typecheck above succeeded, so this is not
+            // expected in practice; report it per-property rather than crash.
+            outcome.status = worker_tm.status();
+            outcome.duration = absl::Now() - outcome.start;
+            continue;
+          }
+          QuickCheck* quickcheck =
+              worker_tm->module->GetQuickCheckByName().at(quickcheck_name);
+          outcome.status =
+              ProveSingleQuickcheck(&worker_import_data, worker_tm->module,
+                                    quickcheck, &outcome.counterexample);
+          outcome.duration = absl::Now() - outcome.start;
+        }
+      }));
+    }
+    for (std::unique_ptr<Thread>& thread : threads) {
+      thread->Join();
+    }
+  }
+
+  for (int64_t i = 0; i < static_cast<int64_t>(quickcheck_names.size()); ++i) {
+    const std::string& quickcheck_name = quickcheck_names[i];
     QuickCheck* quickcheck = qcs.at(quickcheck_name);
     const Pos& start_pos = quickcheck->span().start();
-    Function* f = quickcheck->f();
-    VLOG(1) << "Found quickcheck function: " << f->identifier();
     std::cerr << "[ RUN QUICKCHECK        ] " << quickcheck_name << '\n';
-    absl::Status status;
 
-    auto test_case_start = absl::Now();
+    absl::Time test_case_start = absl::Now();
 
     if (!TestMatchesFilter(quickcheck_name, options.test_filter)) {
       auto test_case_end = absl::Now();
@@ -484,64 +604,22 @@ absl::StatusOr<ParseAndProveResult> ParseAndProve(
                              .timestamp = test_case_start});
       continue;
     }
-    Package package(entry_module->name());
-
-    status = ConvertOneFunctionIntoPackage(entry_module, f, &import_data,
-                                           /*parametric_env=*/nullptr,
-                                           ConvertOptions{}, &package);
-    if (!status.ok()) {
-      HandleError(result, status, quickcheck_name, start_pos, test_case_start,
-                  absl::Now() - start, /*is_quickcheck=*/true);
-      continue;
-    }
-
-    // Note: we need this to eliminate unoptimized IR constructs that are not
-    // currently handled for translation; e.g. bounded-for-loops and non-inlined
-    // function calls.
-    status = RunOptimizationPassPipeline(&package).status();
-    if (!status.ok()) {
-      HandleError(result, status, quickcheck_name, start_pos, test_case_start,
-                  absl::Now() - start, /*is_quickcheck=*/true);
-      continue;
-    }
 
-    absl::StatusOr<std::string> ir_function_name_or = MangleDslxName(
-        entry_module->name(), f->identifier(), CallingConvention::kTypical);
-    if (!ir_function_name_or.ok()) {
-      HandleError(result, status, quickcheck_name, start_pos, test_case_start,
-                  absl::Now() - start, /*is_quickcheck=*/true);
-      continue;
-    }
-
-    absl::StatusOr<xls::Function*> ir_function_or =
-        package.GetFunction(ir_function_name_or.value());
-    if (!ir_function_or.ok()) {
-      HandleError(result, status, quickcheck_name, start_pos, test_case_start,
-                  absl::Now() - start, /*is_quickcheck=*/true);
-      continue;
-    }
-
-    VLOG(1) << "Found IR function: " << ir_function_or.value()->name();
-
-    absl::StatusOr<solvers::z3::ProverResult> proven_or = solvers::z3::TryProve(
-        ir_function_or.value(), ir_function_or.value()->return_value(),
-        solvers::z3::Predicate::NotEqualToZero(), absl::InfiniteDuration());
-
-    if (!proven_or.ok()) {
-      HandleError(result, status, quickcheck_name, start_pos, test_case_start,
-                  absl::Now() - start, /*is_quickcheck=*/true);
-      continue;
+    absl::Status status;
+    absl::Duration duration;
+    std::vector<Value> counterexample;
+    if (parallelism > 1) {
+      status = outcomes[i].status;
+      test_case_start = outcomes[i].start;
+      duration = outcomes[i].duration;
+      counterexample = std::move(outcomes[i].counterexample);
+    } else {
+      status = ProveSingleQuickcheck(&import_data, entry_module, quickcheck,
+                                     &counterexample);
+      duration = absl::Now() - test_case_start;
     }
 
-    VLOG(1) << "Proven? "
-            << (std::holds_alternative<solvers::z3::ProvenTrue>(
-                    proven_or.value())
-                    ? "true"
-                    : "false");
-
-    if (std::holds_alternative<solvers::z3::ProvenTrue>(proven_or.value())) {
-      absl::Time test_case_end = absl::Now();
-      absl::Duration duration = test_case_end - test_case_start;
+    if (status.ok()) {
       result.AddTestCase(test_xml::TestCase{
           .name = std::string(quickcheck_name),
           .file = start_pos.filename(),
@@ -551,27 +629,15 @@ absl::StatusOr<ParseAndProveResult> ParseAndProve(
           .time = duration,
           .timestamp = test_case_start,
       });
-      std::cerr << "[                    OK ] " << quickcheck_name << "\n";
+      std::cerr << absl::StreamFormat("[                    OK ] %s (%s)\n",
+                                      quickcheck_name,
+                                      absl::FormatDuration(duration));
       continue;
     }
 
-    const auto& proven_false =
-        std::get<solvers::z3::ProvenFalse>(proven_or.value());
-
-    // Extract the counterexample, and collapse it back into sequential order.
-    std::vector<Value> counterexample;
-    using ParamValues = absl::flat_hash_map<const xls::Param*, Value>;
-    XLS_ASSIGN_OR_RETURN(ParamValues counterexample_map,
-                         proven_false.counterexample);
-    for (const xls::Param* param : ir_function_or.value()->params()) {
-      counterexample.push_back(counterexample_map[param]);
+    if (!counterexample.empty()) {
+      counterexamples[quickcheck_name] = std::move(counterexample);
     }
-    std::string one_liner =
-        absl::StrCat("counterexample: ", absl::StrJoin(counterexample, ", "));
-    status = ProofErrorStatus(quickcheck->span(), one_liner);
-    counterexamples[quickcheck_name] = std::move(counterexample);
-    absl::Time test_case_end = absl::Now();
-    absl::Duration duration = test_case_end - test_case_start;
     HandleError(result, status, quickcheck_name, start_pos, test_case_start,
                 duration, /*is_quickcheck=*/true);
   }
@@ -591,14 +657,46 @@ absl::StatusOr<ParseAndProveResult> ParseAndProve(
                              .counterexamples = std::move(counterexamples)};
 }
 
+// Outcome of running one unit test, captured so parallel runs can replay
+// per-test output and records in deterministic (declaration) order after the
+// workers have joined.
+struct UnitTestOutcome {
+  absl::Status status;
+  absl::Time start;
+  absl::Duration duration;
+};
+
+// Runs the single unit test (function or proc) named `test_name` from
+// `entry_module`.
+static absl::Status RunSingleTest(
+    ImportData* import_data, TypeInfo* type_info, Module* entry_module,
+    const std::string& test_name,
+    const BytecodeInterpreterOptions& interpreter_options) {
+  ModuleMember* member = entry_module->FindMemberWithName(test_name).value();
+  if (std::holds_alternative<TestFunction*>(*member)) {
+    XLS_ASSIGN_OR_RETURN(TestFunction * tf, entry_module->GetTest(test_name));
+    return RunTestFunction(import_data, type_info, entry_module, tf,
+                           interpreter_options);
+  }
+  XLS_ASSIGN_OR_RETURN(TestProc * tp, entry_module->GetTestProc(test_name));
+  return RunTestProc(import_data, type_info, entry_module, tp,
+                     interpreter_options);
+}
+
 absl::StatusOr<TestResultData> ParseAndTest(
     std::string_view program, std::string_view module_name,
     std::string_view filename, const ParseAndTestOptions& options) {
   const absl::Time start = absl::Now();
   TestResultData result(start, /*test_cases=*/{});
 
-  auto import_data = CreateImportData(options.stdlib_path, options.dslx_paths,
-                                      options.warnings);
+  std::optional<ImportData> local_import_data;
+  if (options.import_data == nullptr) {
+    local_import_data.emplace(CreateImportData(
+        options.stdlib_path, options.dslx_paths, options.warnings));
+  }
+  ImportData& import_data = options.import_data == nullptr
+                                ? *local_import_data
+                                : *options.import_data;
 
   absl::StatusOr<TypecheckedModule> tm_or =
       ParseAndTypecheck(program, filename, module_name, &import_data);
@@ -665,50 +763,110 @@ absl::StatusOr<TestResultData> ParseAndTest(
   }
 
   // Run unit tests.
-  for (const std::string& test_name : entry_module->GetTestNames()) {
-    auto test_case_start = absl::Now();
+  const std::vector<std::string> test_names = entry_module->GetTestNames();
+  int64_t parallelism = std::max<int64_t>(options.parallelism, int64_t{1});
+  if (options.run_comparator != nullptr) {
+    // The comparator and its JIT caches are shared mutable state, so
+    // comparison runs are always serial.
+    parallelism = 1;
+  }
+  parallelism =
+      std::min<int64_t>(parallelism, static_cast<int64_t>(test_names.size()));
+
+  // When running in parallel, workers claim test indices and record outcomes
+  // here; per-test output and result records are then replayed in declaration
+  // order below. Each worker re-parses and re-typechecks the program into its
+  // own ImportData since frontend state is not thread-safe to share.
+  std::vector<UnitTestOutcome> outcomes(test_names.size());
+  if (parallelism > 1) {
+    std::atomic<int64_t> next_index = 0;
+    std::vector<std::unique_ptr<Thread>> threads;
+    threads.reserve(parallelism);
+    for (int64_t i = 0; i < parallelism; ++i) {
+      threads.push_back(std::make_unique<Thread>([&]() {
+        auto worker_import_data = CreateImportData(
+            options.stdlib_path, options.dslx_paths, options.warnings);
+        absl::StatusOr<TypecheckedModule> worker_tm = ParseAndTypecheck(
+            program, filename, module_name, &worker_import_data);
+        const int64_t num_tests = static_cast<int64_t>(test_names.size());
+        for (int64_t index = next_index.fetch_add(1); index < num_tests;
+             index = next_index.fetch_add(1)) {
+          const std::string& test_name = test_names[index];
+          if (!TestMatchesFilter(test_name, options.test_filter)) {
+            continue;
+          }
+          UnitTestOutcome& outcome = outcomes[index];
+          outcome.start = absl::Now();
+          if (!worker_tm.ok()) {
+            // The main-thread typecheck above succeeded, so this is not
+            // expected in practice; report it per-test rather than crash.
+            outcome.status = worker_tm.status();
+            outcome.duration = absl::Now() - outcome.start;
+            continue;
+          }
+          BytecodeInterpreterOptions interpreter_options;
+          interpreter_options.trace_hook(InfoLoggingTraceHook)
+              .trace_channels(options.trace_channels)
+              .max_ticks(options.max_ticks)
+              .format_preference(options.format_preference);
+          outcome.status =
+              RunSingleTest(&worker_import_data, worker_tm->type_info,
+                            worker_tm->module, test_name, interpreter_options);
+          outcome.duration = absl::Now() - outcome.start;
+        }
+      }));
+    }
+    for (std::unique_ptr<Thread>& thread : threads) {
+      thread->Join();
+    }
+  }
+
+  for (int64_t i = 0; i < static_cast<int64_t>(test_names.size()); ++i) {
+    const std::string& test_name = test_names[i];
     ModuleMember* member = entry_module->FindMemberWithName(test_name).value();
     const Pos start_pos = GetPos(*member);
 
     if (!TestMatchesFilter(test_name, options.test_filter)) {
-      auto test_case_end = absl::Now();
+      const absl::Time now = absl::Now();
       result.AddTestCase(test_xml::TestCase{
           test_name, start_pos.filename(), start_pos.GetHumanLineno(),
           test_xml::RunStatus::kRun, test_xml::RunResult::kFiltered,
-          test_case_end - test_case_start, test_case_start});
+          absl::ZeroDuration(), now});
       continue;
     }
 
     std::cerr << "[ RUN UNITTEST  ] " << test_name << '\n';
     absl::Status status;
-    BytecodeInterpreterOptions interpreter_options;
-    interpreter_options.post_fn_eval_hook(post_fn_eval_hook)
-        .trace_hook(InfoLoggingTraceHook)
-        .trace_channels(options.trace_channels)
-        .max_ticks(options.max_ticks)
-        .format_preference(options.format_preference);
-    if (std::holds_alternative<TestFunction*>(*member)) {
-      XLS_ASSIGN_OR_RETURN(TestFunction * tf, entry_module->GetTest(test_name));
-      status = RunTestFunction(&import_data, tm_or.value().type_info,
-                               entry_module, tf, interpreter_options);
+    absl::Time test_case_start;
+    absl::Duration test_case_duration;
+    if (parallelism > 1) {
+      status = outcomes[i].status;
+      test_case_start = outcomes[i].start;
+      test_case_duration = outcomes[i].duration;
     } else {
-      XLS_ASSIGN_OR_RETURN(TestProc * tp, entry_module->GetTestProc(test_name));
-      status = RunTestProc(&import_data, tm_or.value().type_info, entry_module,
-                           tp, interpreter_options);
+      test_case_start = absl::Now();
+      BytecodeInterpreterOptions interpreter_options;
+      interpreter_options.post_fn_eval_hook(post_fn_eval_hook)
+          .trace_hook(InfoLoggingTraceHook)
+          .trace_channels(options.trace_channels)
+          .max_ticks(options.max_ticks)
+          .format_preference(options.format_preference);
+      status = RunSingleTest(&import_data, tm_or.value().type_info,
+                             entry_module, test_name, interpreter_options);
+      test_case_duration = absl::Now() - test_case_start;
     }
-    auto test_case_end = absl::Now();
 
     if (status.ok()) {
       // Add to the tracking data.
       result.AddTestCase(test_xml::TestCase{
           test_name, start_pos.filename(), start_pos.GetHumanLineno(),
           test_xml::RunStatus::kRun, test_xml::RunResult::kCompleted,
-          test_case_end - test_case_start, test_case_start});
+          test_case_duration, test_case_start});
 
       std::cerr << "[            OK ]" << '\n';
     } else {
       HandleError(result, status, test_name, start_pos, test_case_start,
-                  test_case_end - test_case_start,
+                  test_case_duration,
                   /*is_quickcheck=*/false);
     }
   }
@@ -34,6 +34,7 @@
 #include "absl/types/span.h"
 #include "xls/dslx/default_dslx_stdlib_path.h"
 #include "xls/dslx/frontend/ast.h"
+#include "xls/dslx/import_data.h"
 #include "xls/dslx/interp_value.h"
 #include "xls/dslx/ir_convert/convert_options.h"
 #include "xls/dslx/run_routines/test_xml.h"
@@ -104,6 +105,23 @@ struct ParseAndTestOptions {
   WarningKindSet warnings = kDefaultWarningsSet;
   bool trace_channels = false;
   std::optional<int64_t> max_ticks;
+
+  // Number of worker threads used to execute `#[test]` cases. With the
+  // default of 1 all tests run serially on the calling thread. With a larger
+  // value each worker re-parses and re-typechecks the program into its own
+  // ImportData (frontend state is not thread-safe to share) and test output
+  // is replayed in deterministic order after all workers join. Ignored (runs
+  // serially) when `run_comparator` is set, since the comparator and its JIT
+  // caches are shared mutable state.
+  int64_t parallelism = 1;
+
+  // If non-null, typechecking and IR conversion use this ImportData instead
+  // of constructing a fresh one, so long-lived callers (e.g. daemon mode)
+  // keep the stdlib and previously imported modules warm across invocations.
+  // `stdlib_path` and `dslx_paths` are unused in that case; the import data
+  // carries its own. Workers spawned when `parallelism` > 1 still construct
+  // their own import data.
+  ImportData* import_data = nullptr;
 };
 
 // As above, but a subset of the options required for the ParseAndProve()
@@ -114,6 +132,12 @@ struct ParseAndProveOptions {
   const RE2* test_filter = nullptr;
   bool warnings_as_errors = true;
   WarningKindSet warnings = kDefaultWarningsSet;
+
+  // Number of worker threads used to prove quickcheck properties; semantics
+  // match `ParseAndTestOptions::parallelism`. Every proof attempt translates
+  // the property into an independent Z3 solver context, so distinct
+  // properties are safe to prove concurrently.
+  int64_t parallelism = 1;
 };
 
 enum class TestResult : uint8_t {
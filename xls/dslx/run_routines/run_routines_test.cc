@@ -441,6 +441,30 @@ TEST(ParseAndTestTest, TestFilterSelectOne) {
   EXPECT_THAT(result, IsTestResult(TestResult::kAllPassed, 2, 1, 0));
 }
 
+TEST(ParseAndTestTest, ParallelExecutionMatchesSerialResults) {
+  constexpr std::string_view kProgram = R"(
+#[test] fn test_one() {}
+#[test] fn test_two() {}
+#[test] fn test_three() {}
+#[test] fn test_fails() { assert_eq(u32:1, u32:2) }
+)";
+  ParseAndTestOptions options;
+  options.parallelism = 4;
+  XLS_ASSERT_OK_AND_ASSIGN(TestResultData result,
+                           ParseAndTest(kProgram, "test", "test.x", options));
+  EXPECT_THAT(result, IsTestResult(TestResult::kSomeFailed, 4, 0, 1));
+}
+
+TEST(ParseAndTestTest, ParallelExecutionRespectsTestFilter) {
+  const RE2 test_filter(".*_one");
+  ParseAndTestOptions options;
+  options.test_filter = &test_filter;
+  options.parallelism = 2;
+  XLS_ASSERT_OK_AND_ASSIGN(TestResultData result,
+                           ParseAndTest(kTwoTests, "test", "test.x", options));
+  EXPECT_THAT(result, IsTestResult(TestResult::kAllPassed, 2, 1, 0));
+}
+
 TEST(ParseAndTestTest, TestFilterSelectBoth) {
   const RE2 test_filter("test_.*");
   ParseAndTestOptions options;
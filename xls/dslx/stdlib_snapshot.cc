@@ -0,0 +1,82 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/stdlib_snapshot.h"
+
+#include <filesystem>  // NOLINT
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/dslx/stdlib_snapshot.pb.h"
+
+namespace xls::dslx {
+
+/* static */ absl::StatusOr<StdlibSnapshot> StdlibSnapshot::CreateFromDirectory(
+    const std::filesystem::path& stdlib_path) {
+  XLS_ASSIGN_OR_RETURN(std::vector<std::filesystem::path> entries,
+                       GetDirectoryEntries(stdlib_path));
+  StdlibSnapshot snapshot;
+  for (const std::filesystem::path& entry : entries) {
+    if (entry.extension() != ".x") {
+      continue;
+    }
+    XLS_ASSIGN_OR_RETURN(std::string contents, GetFileContents(entry));
+    snapshot.modules_[entry.stem().string()] =
+        ModuleSource{.path = entry, .contents = std::move(contents)};
+  }
+  if (snapshot.modules_.empty()) {
+    return absl::NotFoundError(absl::StrFormat(
+        "No `.x` modules found in stdlib directory: %s", stdlib_path));
+  }
+  return snapshot;
+}
+
+/* static */ absl::StatusOr<StdlibSnapshot> StdlibSnapshot::Load(
+    const std::filesystem::path& file) {
+  StdlibSnapshotProto proto;
+  XLS_RETURN_IF_ERROR(ParseProtobinFile(file, &proto));
+  StdlibSnapshot snapshot;
+  for (const StdlibModuleSourceProto& module : proto.modules()) {
+    snapshot.modules_[module.name()] = ModuleSource{
+        .path = std::filesystem::path(module.path()),
+        .contents = module.contents()};
+  }
+  return snapshot;
+}
+
+absl::Status StdlibSnapshot::Save(const std::filesystem::path& file) const {
+  StdlibSnapshotProto proto;
+  for (const auto& [name, source] : modules_) {
+    StdlibModuleSourceProto* module = proto.add_modules();
+    module->set_name(name);
+    module->set_path(source.path.string());
+    module->set_contents(source.contents);
+  }
+  return SetProtobinFile(file, proto);
+}
+
+const StdlibSnapshot::ModuleSource* StdlibSnapshot::GetModule(
+    std::string_view name) const {
+  auto it = modules_.find(name);
+  return it == modules_.end() ? nullptr : &it->second;
+}
+
+}  // namespace xls::dslx
@@ -0,0 +1,71 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DSLX_STDLIB_SNAPSHOT_H_
+#define XLS_DSLX_STDLIB_SNAPSHOT_H_
+
+#include <cstdint>
+#include <filesystem>  // NOLINT
+#include <string>
+#include <string_view>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+namespace xls::dslx {
+
+// A snapshot of the DSLX standard library sources which can be produced at
+// build time and loaded in a single read at tool startup. Importing a stdlib
+// module through a snapshot skips the per-import path probing and file reads
+// in import_routines; parsing and typechecking still run against the
+// memory-resident text.
+//
+// Serializing fully-typechecked modules (AST + TypeInfo) is not yet possible:
+// TypeInfo only has one-way proto conversion (type_info_to_proto.h) and its
+// invocation and constexpr side tables have no serialized form. The snapshot
+// covers the portion which round-trips today.
+class StdlibSnapshot {
+ public:
+  struct ModuleSource {
+    std::filesystem::path path;
+    std::string contents;
+  };
+
+  // Creates a snapshot containing every `.x` module in `stdlib_path`, keyed
+  // by file stem (e.g. "std" for std.x).
+  static absl::StatusOr<StdlibSnapshot> CreateFromDirectory(
+      const std::filesystem::path& stdlib_path);
+
+  // Loads a snapshot from a binary-proto file written by Save.
+  static absl::StatusOr<StdlibSnapshot> Load(
+      const std::filesystem::path& file);
+
+  // Writes the snapshot to `file` as a binary proto.
+  absl::Status Save(const std::filesystem::path& file) const;
+
+  // Returns the source of stdlib module `name` (e.g. "std"), or nullptr if
+  // the snapshot does not contain it. The returned pointer is valid for the
+  // lifetime of the snapshot.
+  const ModuleSource* GetModule(std::string_view name) const;
+
+  int64_t module_count() const { return modules_.size(); }
+
+ private:
+  absl::flat_hash_map<std::string, ModuleSource> modules_;
+};
+
+}  // namespace xls::dslx
+
+#endif  // XLS_DSLX_STDLIB_SNAPSHOT_H_
@@ -0,0 +1,66 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>  // NOLINT
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xls/common/exit_status.h"
+#include "xls/common/init_xls.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/dslx/default_dslx_stdlib_path.h"
+#include "xls/dslx/stdlib_snapshot.h"
+
+ABSL_FLAG(std::string, stdlib_path, xls::kDefaultDslxStdlibPath,
+          "Path to DSLX standard library directory to snapshot.");
+ABSL_FLAG(std::string, output_path, "",
+          "Path to write the snapshot to as a protobin.");
+
+namespace xls::dslx {
+namespace {
+
+static constexpr std::string_view kUsage = R"(
+Snapshots the DSLX standard library sources into a single binary-proto file.
+Tools load the snapshot at startup (via the XLS_DSLX_STDLIB_SNAPSHOT
+environment variable) to satisfy stdlib imports without per-import filesystem
+probing.
+)";
+
+absl::Status RealMain(const std::filesystem::path& stdlib_path,
+                      const std::filesystem::path& output_path) {
+  XLS_ASSIGN_OR_RETURN(StdlibSnapshot snapshot,
+                       StdlibSnapshot::CreateFromDirectory(stdlib_path));
+  XLS_RETURN_IF_ERROR(snapshot.Save(output_path));
+  LOG(INFO) << "Wrote snapshot of " << snapshot.module_count()
+            << " stdlib modules to " << output_path;
+  return absl::OkStatus();
+}
+
+}  // namespace
+}  // namespace xls::dslx
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string_view> args =
+      xls::InitXls(xls::dslx::kUsage, argc, argv);
+  if (absl::GetFlag(FLAGS_output_path).empty()) {
+    LOG(QFATAL) << "--output_path is required.";
+  }
+  return xls::ExitStatus(xls::dslx::RealMain(
+      absl::GetFlag(FLAGS_stdlib_path), absl::GetFlag(FLAGS_output_path)));
+}
@@ -0,0 +1,84 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/stdlib_snapshot.h"
+
+#include <memory>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+#include "xls/dslx/create_import_data.h"
+#include "xls/dslx/import_data.h"
+#include "xls/dslx/parse_and_typecheck.h"
+#include "xls/dslx/warning_kind.h"
+
+namespace xls::dslx {
+namespace {
+
+TEST(StdlibSnapshotTest, CreateSaveLoadRoundTrip) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory stdlib_dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(stdlib_dir.path() / "std.x",
+                                "pub const ANSWER = u32:42;\n"));
+  XLS_ASSERT_OK(SetFileContents(stdlib_dir.path() / "apfloat.x",
+                                "pub const ZERO = u32:0;\n"));
+  XLS_ASSERT_OK(
+      SetFileContents(stdlib_dir.path() / "README.md", "not a module\n"));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      StdlibSnapshot snapshot,
+      StdlibSnapshot::CreateFromDirectory(stdlib_dir.path()));
+  EXPECT_EQ(snapshot.module_count(), 2);
+
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory out_dir, TempDirectory::Create());
+  XLS_ASSERT_OK(snapshot.Save(out_dir.path() / "stdlib.snapshot"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      StdlibSnapshot loaded,
+      StdlibSnapshot::Load(out_dir.path() / "stdlib.snapshot"));
+  EXPECT_EQ(loaded.module_count(), 2);
+  ASSERT_NE(loaded.GetModule("std"), nullptr);
+  EXPECT_EQ(loaded.GetModule("std")->contents, "pub const ANSWER = u32:42;\n");
+  EXPECT_EQ(loaded.GetModule("missing"), nullptr);
+}
+
+TEST(StdlibSnapshotTest, ImportIsSatisfiedFromSnapshot) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory stdlib_dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(stdlib_dir.path() / "std.x",
+                                "pub const SNAPSHOT_ONLY = u32:7;\n"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      StdlibSnapshot snapshot,
+      StdlibSnapshot::CreateFromDirectory(stdlib_dir.path()));
+
+  // Point the import data at a nonexistent stdlib directory so the import can
+  // only succeed through the snapshot.
+  ImportData import_data = CreateImportData(
+      stdlib_dir.path() / "nonexistent",
+      /*additional_search_paths=*/{}, kDefaultWarningsSet);
+  import_data.SetStdlibSnapshot(
+      std::make_shared<const StdlibSnapshot>(std::move(snapshot)));
+
+  constexpr const char* kProgram = R"(
+import std;
+
+const USE = std::SNAPSHOT_ONLY;
+)";
+  XLS_ASSERT_OK(
+      ParseAndTypecheck(kProgram, "test.x", "test", &import_data).status());
+}
+
+}  // namespace
+}  // namespace xls::dslx
@@ -156,6 +156,23 @@ void TypeInfo::NoteConstExpr(const AstNode* const_expr, InterpValue value) {
   const_exprs_.insert({const_expr, value});
 }
 
+std::optional<InterpValue> TypeInfo::GetMemoizedConstexpr(
+    const Expr* expr, const ParametricEnv& bindings) const {
+  const TypeInfo* root = GetRoot();
+  auto it = root->constexpr_memo_.find(std::make_pair(expr, bindings));
+  if (it == root->constexpr_memo_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void TypeInfo::NoteMemoizedConstexpr(const Expr* expr,
+                                     const ParametricEnv& bindings,
+                                     InterpValue value) {
+  GetRoot()->constexpr_memo_.insert(
+      {std::make_pair(expr, bindings), std::move(value)});
+}
+
 absl::StatusOr<InterpValue> TypeInfo::GetConstExpr(
     const AstNode* const_expr) const {
   CHECK_EQ(const_expr->owner(), module_)
@@ -21,6 +21,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -274,6 +275,18 @@ class TypeInfo {
   // Note that these index over AstNodes instead of Exprs so that NameDefs can
   // be used as constexpr keys.
   void NoteConstExpr(const AstNode* const_expr, InterpValue value);
+
+  // Cross-instantiation memoization of constexpr evaluation results, keyed by
+  // (expression, parametric env). Unlike the per-TypeInfo constexpr notes
+  // above, this table lives on the root of the type info tree: the same
+  // expression evaluated under identical parametric bindings yields the same
+  // value regardless of which derived TypeInfo the evaluation ran in, so
+  // repeated instantiations can reuse it. Returns nullopt on a miss.
+  std::optional<InterpValue> GetMemoizedConstexpr(
+      const Expr* expr, const ParametricEnv& bindings) const;
+  void NoteMemoizedConstexpr(const Expr* expr, const ParametricEnv& bindings,
+                             InterpValue value);
+
   bool IsKnownConstExpr(const AstNode* node) const;
   bool IsKnownNonConstExpr(const AstNode* node) const;
   absl::StatusOr<InterpValue> GetConstExpr(const AstNode* const_expr) const;
@@ -355,6 +368,8 @@ class TypeInfo {
   absl::flat_hash_map<const AstNode*, std::optional<InterpValue>> const_exprs_;
 
   // The following are only present on the root type info.
+  absl::flat_hash_map<std::pair<const Expr*, ParametricEnv>, InterpValue>
+      constexpr_memo_;
   absl::flat_hash_map<Import*, ImportedInfo> imports_;
   absl::flat_hash_map<const Invocation*, InvocationData> invocations_;
   absl::flat_hash_map<Slice*, SliceData> slices_;
@@ -86,5 +86,34 @@ fn main() -> u32 {
                                  "present in parametric keys: {}")));
 }
 
+TEST(TypeInfoTest, ConstexprMemoizationRoundTrip) {
+  ImportData import_data = CreateImportDataForTest();
+  XLS_ASSERT_OK_AND_ASSIGN(TypecheckedModule tm,
+                           ParseAndTypecheck(R"(
+fn main() -> u32 {
+  u32:42
+})",
+                                             "test.x", "test", &import_data));
+
+  Function* main = tm.module->GetFunctionByName().at("main");
+  const Expr* body = down_cast<const Expr*>(
+      ToAstNode(main->body()->statements().at(0)->wrapped()));
+  ASSERT_NE(body, nullptr);
+
+  const ParametricEnv env(absl::flat_hash_map<std::string, InterpValue>{
+      {"X", InterpValue::MakeU32(7)},
+  });
+
+  // Miss before noting, hit after; a different env still misses.
+  EXPECT_EQ(tm.type_info->GetMemoizedConstexpr(body, env), std::nullopt);
+  tm.type_info->NoteMemoizedConstexpr(body, env, InterpValue::MakeU32(42));
+  std::optional<InterpValue> memoized =
+      tm.type_info->GetMemoizedConstexpr(body, env);
+  ASSERT_TRUE(memoized.has_value());
+  EXPECT_EQ(*memoized, InterpValue::MakeU32(42));
+  EXPECT_EQ(tm.type_info->GetMemoizedConstexpr(body, ParametricEnv()),
+            std::nullopt);
+}
+
 }  // namespace
 }  // namespace xls::dslx
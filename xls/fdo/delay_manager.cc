@@ -56,7 +56,7 @@ DelayManager::DelayManager(FunctionBase *function,
     node_to_index_[node] = index;
     index_to_node_[index] = node;
     absl::StatusOr<int64_t> maybe_delay =
-        delay_estimator.GetOperationDelayInPs(node);
+        delay_estimator.GetOperationDelayInPsFast(node);
     CHECK_OK(maybe_delay.status());
     indices_to_delay_[index][index] = maybe_delay.value();
     index++;
@@ -93,7 +93,13 @@ absl::Status DelayManager::SetCriticalPathDelay(Node *from, Node *to,
   int64_t &current_delay = indices_to_delay_[from_index][to_index];
   if (!if_shorter || current_delay > delay) {
     if (!if_exist || current_delay != -1) {
-      current_delay = delay;
+      if (current_delay != delay) {
+        current_delay = delay;
+        // Remember the changed pair so the next propagation only recomputes
+        // paths through the affected nodes.
+        changed_sources_.insert(from_index);
+        changed_targets_.insert(to_index);
+      }
     }
   }
   return absl::OkStatus();
@@ -120,9 +126,35 @@ absl::StatusOr<std::vector<Node *>> DelayManager::GetFullCriticalPath(
 }
 
 void DelayManager::PropagateDelays() {
-  // Traverse the function in a reversed topological order.
+  // The first propagation must visit every node; later propagations only need
+  // to revisit paths through nodes whose delays have changed since the
+  // previous propagation.
+  const bool full = !full_propagation_done_;
+  if (!full && changed_sources_.empty() && changed_targets_.empty()) {
+    return;
+  }
+
+  // Traverse the function in a reversed topological order. A row (the delays
+  // from one source node to all targets) is recomputed if it changed directly
+  // through SetCriticalPathDelay or if the row of one of the node's users was
+  // changed.
+  std::vector<bool> row_changed(function_->node_count(), false);
+  absl::flat_hash_set<int64_t> changed_columns;
   for (Node *node : ReverseTopoSort(function_)) {
     int64_t node_index = node_to_index_[node];
+    const bool is_seed = full || changed_sources_.contains(node_index);
+    bool needs_recompute = is_seed;
+    if (!needs_recompute) {
+      for (Node *user : node->users()) {
+        if (row_changed[node_to_index_[user]]) {
+          needs_recompute = true;
+          break;
+        }
+      }
+    }
+    if (!needs_recompute) {
+      continue;
+    }
     int64_t node_delay = indices_to_delay_[node_index][node_index];
     std::vector<int64_t> new_delays(function_->node_count(), -1);
 
@@ -142,19 +174,46 @@ void DelayManager::PropagateDelays() {
     }
 
     // Update the original delay if the newly calculated delay is smaller.
+    bool modified = false;
     for (int64_t i = 0; i < function_->node_count(); ++i) {
       if (new_delays[i] != -1) {
         int64_t &current_delay = indices_to_delay_[node_index][i];
         if (current_delay >= new_delays[i] || current_delay == -1) {
+          if (current_delay != new_delays[i]) {
+            modified = true;
+            changed_columns.insert(i);
+          }
           current_delay = new_delays[i];
         }
       }
     }
+    // A seed row counts as changed even if the recomputation was a no-op as
+    // its entries were already modified before this propagation.
+    row_changed[node_index] = modified || is_seed;
   }
 
-  // Traverse the function in a topological order.
+  // Traverse the function in a topological order. A column (the delays from
+  // all sources to one target node) is recomputed if it changed directly
+  // through SetCriticalPathDelay, if one of its entries was changed by the
+  // first pass, or if the column of one of the node's operands was changed.
+  std::vector<bool> column_changed(function_->node_count(), false);
+  absl::flat_hash_set<int64_t> next_changed_sources;
   for (Node *node : TopoSort(function_)) {
     int64_t node_index = node_to_index_[node];
+    const bool is_seed = full || changed_targets_.contains(node_index) ||
+                         changed_columns.contains(node_index);
+    bool needs_recompute = is_seed;
+    if (!needs_recompute) {
+      for (Node *operand : node->operands()) {
+        if (column_changed[node_to_index_[operand]]) {
+          needs_recompute = true;
+          break;
+        }
+      }
+    }
+    if (!needs_recompute) {
+      continue;
+    }
     int64_t node_delay = indices_to_delay_[node_index][node_index];
     std::vector<int64_t> new_delays(function_->node_count(), -1);
     std::vector<Node *> new_critical_operands(function_->node_count(), nullptr);
@@ -176,17 +235,29 @@ void DelayManager::PropagateDelays() {
     }
 
     // Update the original delay if the newly calculated delay is smaller.
+    bool modified = false;
     for (int64_t i = 0; i < function_->node_count(); ++i) {
       if (new_delays[i] != -1) {
         int64_t &current_delay = indices_to_delay_[i][node_index];
         if (current_delay >= new_delays[i] || current_delay == -1) {
+          if (current_delay != new_delays[i]) {
+            modified = true;
+            // The second pass lowers rows which the first pass of the next
+            // propagation reads; carry the change over to the next call.
+            next_changed_sources.insert(i);
+          }
           current_delay = new_delays[i];
           indices_to_critical_operand_[i][node_index] =
               new_critical_operands[i];
         }
       }
     }
+    column_changed[node_index] = modified || is_seed;
   }
+
+  changed_sources_ = std::move(next_changed_sources);
+  changed_targets_.clear();
+  full_propagation_done_ = true;
 }
 
 absl::flat_hash_map<Node *, std::vector<Node *>>
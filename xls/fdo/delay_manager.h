@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/functional/function_ref.h"
 #include "absl/random/bit_gen_ref.h"
 #include "absl/status/status.h"
@@ -101,6 +102,10 @@ class DelayManager {
   // topological order once. Note that this method is not optimal - it cannot
   // find the best combination of partial paths as Floyd–Warshall but it's
   // complexity is in O(n^2).
+  //
+  // The first call propagates through the whole function; later calls only
+  // recompute the paths through nodes whose delays have changed (through
+  // SetCriticalPathDelay) since the previous propagation.
   void PropagateDelays();
 
   // Get all the paths whose delay is longer than the given delay threshold.
@@ -150,6 +155,15 @@ class DelayManager {
   // critical operand of the target node.
   std::vector<std::vector<Node *>> indices_to_critical_operand_;
 
+  // Node indices whose outgoing (source) or incoming (target) critical path
+  // delays have changed since the last propagation. Only the paths through
+  // these nodes need to be revisited by the next propagation.
+  absl::flat_hash_set<int64_t> changed_sources_;
+  absl::flat_hash_set<int64_t> changed_targets_;
+
+  // Whether an initial whole-function propagation has been performed.
+  bool full_propagation_done_ = false;
+
   // Name of the delay estimator.
   const std::string name_;
 };
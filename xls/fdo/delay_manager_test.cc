@@ -176,5 +176,53 @@ fn main(i0: bits[3], i1: bits[3]) -> bits[3] {
   EXPECT_EQ(new_udiv3_i0_delay, -1);
 }
 
+// Propagation after targeted delay updates only revisits the paths through the
+// changed nodes. The result must match a freshly-constructed DelayManager
+// which receives the same updates in one batch.
+TEST_F(DelayManagerTest, IncrementalPropagationMatchesFreshManager) {
+  std::string ir_text = R"(
+package p
+
+fn main(i0: bits[3], i1: bits[3]) -> bits[3] {
+  add.1: bits[3] = add(i0, i1)
+  sub.2: bits[3] = sub(add.1, i1)
+  ret udiv.3: bits[3] = udiv(sub.2, add.1)
+}
+)";
+
+  XLS_ASSERT_OK_AND_ASSIGN(auto package, Parser::ParsePackage(ir_text));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * function, package->GetFunction("main"));
+  Node *add1 = FindNode("add.1", function);
+  Node *sub2 = FindNode("sub.2", function);
+  Node *udiv3 = FindNode("udiv.3", function);
+
+  // Land the updates one by one with a propagation after each.
+  DelayManager incremental(function, TestDelayEstimator());
+  XLS_EXPECT_OK(incremental.SetCriticalPathDelay(add1, sub2, 1));
+  incremental.PropagateDelays();
+  XLS_EXPECT_OK(incremental.SetCriticalPathDelay(sub2, udiv3, 2));
+  incremental.PropagateDelays();
+
+  // Land both updates in one batch on a fresh manager.
+  DelayManager batch(function, TestDelayEstimator());
+  XLS_EXPECT_OK(batch.SetCriticalPathDelay(add1, sub2, 1));
+  XLS_EXPECT_OK(batch.SetCriticalPathDelay(sub2, udiv3, 2));
+  batch.PropagateDelays();
+
+  for (Node *from : function->nodes()) {
+    for (Node *to : function->nodes()) {
+      XLS_ASSERT_OK_AND_ASSIGN(int64_t incremental_delay,
+                               incremental.GetCriticalPathDelay(from, to));
+      XLS_ASSERT_OK_AND_ASSIGN(int64_t batch_delay,
+                               batch.GetCriticalPathDelay(from, to));
+      EXPECT_EQ(incremental_delay, batch_delay)
+          << "from " << from->GetName() << " to " << to->GetName();
+    }
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(int64_t add1_udiv3_delay,
+                           incremental.GetCriticalPathDelay(add1, udiv3));
+  EXPECT_EQ(add1_udiv3_delay, 3);
+}
+
 }  // namespace
 }  // namespace xls
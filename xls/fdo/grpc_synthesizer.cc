@@ -46,8 +46,11 @@ class GrpcSynthesizer : public Synthesizer {
     request.set_target_frequency_hz(params_.frequency_hz());
     request.set_module_text(verilog_text);
 
+    // FDO issues many small compile requests, often concurrently; the shared
+    // client keeps a warm connection per server and pipelines outstanding
+    // requests over it.
     XLS_ASSIGN_OR_RETURN(CompileResponse response,
-                         xls::synthesis::SynthesizeViaClient(
+                         xls::synthesis::SynthesizeViaSharedClient(
                              params_.server_and_port(), request));
     const int64_t clock_period_ps =
         static_cast<int64_t>(1e12) / params_.frequency_hz();
@@ -17,10 +17,12 @@
 #include <algorithm>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <optional>
 #include <random>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -242,7 +244,8 @@ absl::Status RefineDelayEstimations(
 
   XLS_ASSIGN_OR_RETURN(
       std::vector<int64_t> delay_list,
-      options.synthesizer->SynthesizeNodesConcurrentlyAndGetDelays(nodes_list));
+      options.synthesizer->SynthesizeNodesConcurrentlyAndGetDelays(
+          nodes_list, options.synthesis_concurrency));
 
   VLOG(1) << "Number of modules generated is " << nodes_list.size();
   for (int64_t j = 0; j < delay_list.size(); ++j) {
@@ -268,6 +271,7 @@ absl::Status RefineDelayEstimations(
 }
 
 absl::Status BuildError(IterativeSDCSchedulingModel &model,
+                        math_opt::IncrementalSolver *solver,
                         const math_opt::SolveResult &result,
                         SchedulingFailureBehavior failure_behavior) {
   CHECK_NE(result.termination.reason, math_opt::TerminationReason::kOptimal);
@@ -278,9 +282,8 @@ absl::Status BuildError(IterativeSDCSchedulingModel &model,
            math_opt::TerminationReason::kInfeasibleOrUnbounded)) {
     XLS_RETURN_IF_ERROR(model.AddSlackVariables(
         failure_behavior.infeasible_per_state_backedge_slack_pool));
-    XLS_ASSIGN_OR_RETURN(
-        math_opt::SolveResult result_with_slack,
-        math_opt::Solve(model.UnderlyingModel(), math_opt::SolverType::kGlop));
+    XLS_ASSIGN_OR_RETURN(math_opt::SolveResult result_with_slack,
+                         solver->Solve());
     if (result_with_slack.termination.reason ==
             math_opt::TerminationReason::kOptimal ||
         result_with_slack.termination.reason ==
@@ -307,18 +310,46 @@ absl::Status IterativeSDCSchedulingModel::AddTimingConstraints(
   absl::flat_hash_map<Node *, std::vector<Node *>> delay_constraints =
       delay_manager_.GetPathsOverDelayThreshold(clock_period_ps);
 
-  int64_t number_constraints = 0;
+  absl::flat_hash_set<std::pair<Node *, Node *>> over_threshold_pairs;
   for (const auto &p : delay_constraints) {
     Node *source = p.first;
     for (Node *target : p.second) {
-      number_constraints++;
-      DiffAtLeastConstraint(target, source, 1, "timing");
-      VLOG(2) << "Setting timing constraint: "
-              << absl::StrFormat("1 ≤ %s - %s", target->GetName(),
-                                 source->GetName());
+      over_threshold_pairs.insert(std::make_pair(source, target));
     }
   }
-  VLOG(2) << "Number of timing constraints added: " << number_constraints;
+
+  // Delay refinement can shorten paths as well as lengthen them, so drop
+  // constraints for pairs which are no longer over the clock period before
+  // adding constraints for newly-violating pairs. Pairs whose status is
+  // unchanged keep their existing constraint untouched.
+  int64_t number_removed = 0;
+  for (auto it = timing_constraints_.begin();
+       it != timing_constraints_.end();) {
+    if (over_threshold_pairs.contains(it->first)) {
+      ++it;
+      continue;
+    }
+    UnderlyingModel().DeleteLinearConstraint(it->second);
+    timing_constraints_.erase(it++);
+    number_removed++;
+  }
+
+  int64_t number_added = 0;
+  for (const auto &[source, target] : over_threshold_pairs) {
+    if (timing_constraints_.contains(std::make_pair(source, target))) {
+      continue;
+    }
+    number_added++;
+    timing_constraints_.emplace(
+        std::make_pair(source, target),
+        DiffAtLeastConstraint(target, source, 1, "timing"));
+    VLOG(2) << "Setting timing constraint: "
+            << absl::StrFormat("1 ≤ %s - %s", target->GetName(),
+                               source->GetName());
+  }
+  VLOG(2) << "Number of timing constraints added: " << number_added
+          << ", removed: " << number_removed
+          << ", total: " << timing_constraints_.size();
   return absl::OkStatus();
 }
 
@@ -399,39 +430,48 @@ absl::StatusOr<ScheduleCycleMap> ScheduleByIterativeSDC(
     return absl::InvalidArgumentError("synthesizer is not ready");
   }
 
-  ScheduleCycleMap cycle_map;
-  absl::flat_hash_set<NodeCut> evaluated_cuts;
-  std::mt19937_64 bit_gen;
-  for (int64_t i = 0; i < options.iteration_number; ++i) {
-    IterativeSDCSchedulingModel model(f, delay_manager);
+  // The model (and the solver's internal state) is kept alive across
+  // refinement iterations; only the timing constraints derived from the delay
+  // manager change between iterations, and those are updated in place by
+  // AddTimingConstraints. The structural constraints below are added once.
+  IterativeSDCSchedulingModel model(f, delay_manager);
 
-    for (const SchedulingConstraint &constraint : constraints) {
-      XLS_RETURN_IF_ERROR(model.AddSchedulingConstraint(constraint));
-    }
+  for (const SchedulingConstraint &constraint : constraints) {
+    XLS_RETURN_IF_ERROR(model.AddSchedulingConstraint(constraint));
+  }
 
-    for (Node *node : f->nodes()) {
-      for (Node *user : node->users()) {
-        XLS_RETURN_IF_ERROR(model.AddDefUseConstraints(node, user));
-      }
-      if (f->IsFunction() && f->HasImplicitUse(node)) {
-        XLS_RETURN_IF_ERROR(model.AddDefUseConstraints(node, std::nullopt));
-      }
+  for (Node *node : f->nodes()) {
+    for (Node *user : node->users()) {
+      XLS_RETURN_IF_ERROR(model.AddDefUseConstraints(node, user));
+    }
+    if (f->IsFunction() && f->HasImplicitUse(node)) {
+      XLS_RETURN_IF_ERROR(model.AddDefUseConstraints(node, std::nullopt));
     }
+  }
 
-    if (f->IsProc()) {
-      Proc *proc = f->AsProcOrDie();
-      for (int64_t index = 0; index < proc->GetStateElementCount(); ++index) {
-        Param *const state_access = proc->GetStateParam(index);
-        Node *const next_state_element = proc->GetNextStateElement(index);
-
-        // The next-state element always has lifetime extended to the state
-        // param node, since we can't store the new value in the state register
-        // until the old value's been used.
-        XLS_RETURN_IF_ERROR(
-            model.AddLifetimeConstraint(next_state_element, state_access));
-      }
+  if (f->IsProc()) {
+    Proc *proc = f->AsProcOrDie();
+    for (int64_t index = 0; index < proc->GetStateElementCount(); ++index) {
+      Param *const state_access = proc->GetStateParam(index);
+      Node *const next_state_element = proc->GetNextStateElement(index);
+
+      // The next-state element always has lifetime extended to the state
+      // param node, since we can't store the new value in the state register
+      // until the old value's been used.
+      XLS_RETURN_IF_ERROR(
+          model.AddLifetimeConstraint(next_state_element, state_access));
     }
+  }
 
+  XLS_ASSIGN_OR_RETURN(
+      std::unique_ptr<math_opt::IncrementalSolver> solver,
+      math_opt::IncrementalSolver::New(&model.UnderlyingModel(),
+                                       math_opt::SolverType::kGlop));
+
+  ScheduleCycleMap cycle_map;
+  absl::flat_hash_set<NodeCut> evaluated_cuts;
+  std::mt19937_64 bit_gen;
+  for (int64_t i = 0; i < options.iteration_number; ++i) {
     XLS_RETURN_IF_ERROR(model.AddTimingConstraints(clock_period_ps));
 
     int64_t min_pipeline_length = 1;
@@ -443,11 +483,11 @@ absl::StatusOr<ScheduleCycleMap> ScheduleByIterativeSDC(
       model.MinimizePipelineLength();
       XLS_ASSIGN_OR_RETURN(
           const math_opt::SolveResult result_with_minimized_pipeline_length,
-          math_opt::Solve(model.UnderlyingModel(),
-                          math_opt::SolverType::kGlop));
+          solver->Solve());
       if (result_with_minimized_pipeline_length.termination.reason !=
           math_opt::TerminationReason::kOptimal) {
-        return BuildError(model, result_with_minimized_pipeline_length,
+        return BuildError(model, solver.get(),
+                          result_with_minimized_pipeline_length,
                           failure_behavior);
       }
       XLS_ASSIGN_OR_RETURN(
@@ -459,12 +499,10 @@ absl::StatusOr<ScheduleCycleMap> ScheduleByIterativeSDC(
 
     model.SetObjective();
 
-    XLS_ASSIGN_OR_RETURN(
-        math_opt::SolveResult result,
-        math_opt::Solve(model.UnderlyingModel(), math_opt::SolverType::kGlop));
+    XLS_ASSIGN_OR_RETURN(math_opt::SolveResult result, solver->Solve());
 
     if (result.termination.reason != math_opt::TerminationReason::kOptimal) {
-      return BuildError(model, result, failure_behavior);
+      return BuildError(model, solver.get(), result, failure_behavior);
     }
 
     // Extract scheduling results to the cycle map.
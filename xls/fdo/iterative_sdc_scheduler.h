@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <optional>
+#include <utility>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
@@ -27,6 +28,7 @@
 #include "xls/ir/node.h"
 #include "xls/scheduling/scheduling_options.h"
 #include "xls/scheduling/sdc_scheduler.h"
+#include "ortools/math_opt/cpp/math_opt.h"
 
 namespace xls {
 
@@ -42,11 +44,21 @@ class IterativeSDCSchedulingModel : public SDCSchedulingModel {
 
   // Overrides the original timing constraints builder. This method directly
   // call delay manager to extract the paths longer than the given clock period
-  // instead of recalculating them.
+  // instead of recalculating them. The model is kept alive across FDO
+  // refinement iterations, so this method updates the underlying LP in place:
+  // constraints for node pairs no longer over the clock period are deleted and
+  // only newly-violating pairs get fresh constraints.
   absl::Status AddTimingConstraints(int64_t clock_period_ps);
 
  private:
   const DelayManager& delay_manager_;
+
+  // The timing constraints currently in the model, keyed by (source, target).
+  // Used to diff against the delay manager's current over-threshold paths so
+  // each iteration only touches constraints whose delay estimate changed.
+  absl::flat_hash_map<std::pair<Node*, Node*>,
+                      operations_research::math_opt::LinearConstraint>
+      timing_constraints_;
 };
 
 struct IterativeSDCSchedulingOptions {
@@ -55,6 +67,9 @@ struct IterativeSDCSchedulingOptions {
   int64_t delay_driven_path_number = 0;
   int64_t fanout_driven_path_number = 0;
   float stochastic_ratio = 1.0;
+  // Bound on concurrent synthesis requests during delay refinement; 0 means
+  // one request per extracted path/cone/window.
+  int64_t synthesis_concurrency = 0;
   PathEvaluateStrategy path_evaluate_strategy = PathEvaluateStrategy::WINDOW;
 };
 
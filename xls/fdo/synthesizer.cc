@@ -14,6 +14,8 @@
 
 #include "xls/fdo/synthesizer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -49,19 +51,27 @@ namespace synthesis {
 
 absl::StatusOr<std::vector<int64_t>>
 Synthesizer::SynthesizeNodesConcurrentlyAndGetDelays(
-    absl::Span<const absl::flat_hash_set<Node *>> nodes_list) const {
-  // Launches multi-threading delay estimation.
-  std::vector<absl::StatusOr<int64_t>> results;
+    absl::Span<const absl::flat_hash_set<Node *>> nodes_list,
+    int64_t max_concurrency) const {
+  // Launches multi-threading delay estimation. The node sets are independent,
+  // so they are dispatched to a bounded pool of workers each of which grabs
+  // the next unclaimed set until all sets are synthesized.
+  int64_t num_entries = static_cast<int64_t>(nodes_list.size());
+  int64_t num_workers = max_concurrency <= 0
+                            ? num_entries
+                            : std::min(max_concurrency, num_entries);
+  std::vector<absl::StatusOr<int64_t>> results(num_entries,
+                                               absl::StatusOr<int64_t>(0));
+  std::atomic<int64_t> next_index = 0;
   std::vector<std::unique_ptr<Thread>> threads;
-  results.reserve(nodes_list.size());
-  absl::StatusOr<int64_t> init_val = 0;
-  for (const absl::flat_hash_set<Node *> &nodes : nodes_list) {
-    results.push_back(init_val);
-    absl::StatusOr<int64_t> &dest = results.back();
-    // TODO(hanchenye): 2023-08-14 Use a thread pool structure that we can
-    // schedule on.
-    threads.push_back(std::make_unique<Thread>(
-        [&]() { dest = SynthesizeNodesAndGetDelay(nodes); }));
+  threads.reserve(num_workers);
+  for (int64_t i = 0; i < num_workers; ++i) {
+    threads.push_back(std::make_unique<Thread>([&]() {
+      for (int64_t index = next_index.fetch_add(1); index < num_entries;
+           index = next_index.fetch_add(1)) {
+        results[index] = SynthesizeNodesAndGetDelay(nodes_list[index]);
+      }
+    }));
   }
 
   // Records the estimated delays.
@@ -71,9 +71,13 @@ class Synthesizer {
       FunctionBase *f, bool flop_inputs_outputs) const;
 
   // Launches `SynthesizeNodesAndGetDelay` concurrently for each set of nodes
-  // listed in `nodes_list` and get their delays.
+  // listed in `nodes_list` and get their delays. `max_concurrency` bounds the
+  // number of in-flight synthesis requests (and hence concurrent synthesis
+  // tool sessions); if it is zero or negative one worker is launched per
+  // entry of `nodes_list`.
   absl::StatusOr<std::vector<int64_t>> SynthesizeNodesConcurrentlyAndGetDelays(
-      absl::Span<const absl::flat_hash_set<Node *>> nodes_list) const;
+      absl::Span<const absl::flat_hash_set<Node *>> nodes_list,
+      int64_t max_concurrency = 0) const;
 
  private:
   // Records the name of the concreate synthesizer, e.g., yosys, for management
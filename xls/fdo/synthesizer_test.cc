@@ -17,8 +17,11 @@
 #include <cstdint>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "xls/common/status/matchers.h"
 #include "xls/ir/function.h"
@@ -29,6 +32,8 @@
 namespace xls {
 namespace {
 
+using ::testing::ElementsAre;
+
 class FakeSynthesizer : public synthesis::Synthesizer {
  public:
   FakeSynthesizer() : synthesis::Synthesizer("FakeSynthesizer") {}
@@ -161,5 +166,56 @@ endmodule
   EXPECT_EQ(actual_verilog_text, expected_verilog_text);
 }
 
+// Synthesizer which reports the number of nodes in the synthesized set as its
+// delay, for checking result aggregation of the concurrent dispatch.
+class NodeCountSynthesizer : public synthesis::Synthesizer {
+ public:
+  NodeCountSynthesizer() : synthesis::Synthesizer("NodeCountSynthesizer") {}
+
+  absl::StatusOr<int64_t> SynthesizeVerilogAndGetDelay(
+      std::string_view verilog_text,
+      std::string_view top_module_name) const override {
+    return 0;
+  }
+
+  absl::StatusOr<int64_t> SynthesizeNodesAndGetDelay(
+      const absl::flat_hash_set<Node *> &nodes) const override {
+    return nodes.size();
+  }
+};
+
+TEST_F(SynthesizerTest, BoundedConcurrencyPreservesResultOrder) {
+  const std::string ir_text = R"(
+package p
+
+fn test(i0: bits[3], i1: bits[3]) -> bits[3] {
+  add.3: bits[3] = add(i0, i1, id=3)
+  ret sub.4: bits[3] = sub(add.3, i1, id=4)
+}
+)";
+
+  XLS_ASSERT_OK_AND_ASSIGN(auto package, Parser::ParsePackage(ir_text));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * function, package->GetFunction("test"));
+
+  std::vector<Node *> nodes(function->nodes().begin(),
+                            function->nodes().end());
+  std::vector<absl::flat_hash_set<Node *>> nodes_list;
+  for (int64_t i = 0; i < static_cast<int64_t>(nodes.size()); ++i) {
+    nodes_list.push_back(
+        absl::flat_hash_set<Node *>(nodes.begin(), nodes.begin() + i + 1));
+  }
+
+  NodeCountSynthesizer synthesizer;
+  // All concurrency bounds (including the unbounded default) must produce
+  // the same delays in input order.
+  for (int64_t max_concurrency : {0, 1, 2, 16}) {
+    XLS_ASSERT_OK_AND_ASSIGN(
+        std::vector<int64_t> delays,
+        synthesizer.SynthesizeNodesConcurrentlyAndGetDelays(nodes_list,
+                                                            max_concurrency));
+    EXPECT_THAT(delays, ElementsAre(1, 2, 3, 4));
+  }
+}
+
 }  // namespace
 }  // namespace xls
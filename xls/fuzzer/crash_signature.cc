@@ -0,0 +1,75 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/crash_signature.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "openssl/sha.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/status/status_macros.h"
+#include "re2/re2.h"
+
+namespace xls {
+
+std::string NormalizeErrorMessage(std::string_view message) {
+  std::string normalized(message);
+  // Paths first (they contain digits), then hex values (so "0x12" does not
+  // decay to "0x#" via the decimal rule first), then decimal runs.
+  static const LazyRE2 kPathRe{R"((?:/[\w.\-]+)+/?)"};
+  static const LazyRE2 kHexRe{"0x[0-9a-fA-F]+"};
+  static const LazyRE2 kNumberRe{R"(\d+)"};
+  RE2::GlobalReplace(&normalized, *kPathRe, "<path>");
+  RE2::GlobalReplace(&normalized, *kHexRe, "0x#");
+  RE2::GlobalReplace(&normalized, *kNumberRe, "#");
+  return normalized;
+}
+
+std::string ComputeCrashSignature(const absl::Status& error) {
+  std::string shape = absl::StrCat(absl::StatusCodeToString(error.code()), ":",
+                                   NormalizeErrorMessage(error.message()));
+  std::array<uint8_t, SHA256_DIGEST_LENGTH> digest;
+  SHA256(reinterpret_cast<const uint8_t*>(shape.data()), shape.size(),
+         digest.data());
+  return absl::BytesToHexString(
+      {reinterpret_cast<const char*>(digest.data()), digest.size()});
+}
+
+absl::StatusOr<bool> CrashSignatureIndex::InsertSignature(
+    const std::string& signature) {
+  std::error_code ec;
+  std::filesystem::create_directories(directory_, ec);
+  if (ec) {
+    return absl::InternalError(
+        absl::StrCat("Unable to create crash signature index directory ",
+                     directory_.string(), ": ", ec.message()));
+  }
+  std::filesystem::path entry = directory_ / signature;
+  if (FileExists(entry).ok()) {
+    return false;
+  }
+  XLS_RETURN_IF_ERROR(SetFileContents(entry, ""));
+  return true;
+}
+
+}  // namespace xls
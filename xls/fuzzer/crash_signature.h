@@ -0,0 +1,64 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_FUZZER_CRASH_SIGNATURE_H_
+#define XLS_FUZZER_CRASH_SIGNATURE_H_
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+namespace xls {
+
+// Utilities for deduplicating fuzzer crashers by failure signature.
+//
+// A crash signature hashes the *shape* of a sample's failure: the status code
+// plus the error message with run-specific detail (numbers, hex values and
+// file paths) normalized away. Failures with the same signature almost always
+// share a root cause, so minimizing more than one of them wastes node-hours.
+
+// Returns `message` with run-specific detail replaced by placeholders:
+// absolute paths become "<path>", hex values become "0x#" and decimal number
+// runs become "#". Exposed for testing.
+std::string NormalizeErrorMessage(std::string_view message);
+
+// Returns the signature of `error` as a hex string: a SHA-256 digest over the
+// status code and the normalized message.
+std::string ComputeCrashSignature(const absl::Status& error);
+
+// A persistent index of crash signatures backed by a directory: each known
+// signature is an empty file named after its hash. The layout makes the index
+// shareable between concurrently running workers and across fuzzer
+// invocations pointed at the same crasher directory. Concurrent inserts of
+// the same signature may both report it as new; that only costs one redundant
+// minimization, not hundreds.
+class CrashSignatureIndex {
+ public:
+  explicit CrashSignatureIndex(std::filesystem::path directory)
+      : directory_(std::move(directory)) {}
+
+  // Records `signature`, creating the index directory if needed. Returns true
+  // if the signature was not previously present (i.e. this failure is new).
+  absl::StatusOr<bool> InsertSignature(const std::string& signature);
+
+ private:
+  std::filesystem::path directory_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_FUZZER_CRASH_SIGNATURE_H_
@@ -0,0 +1,65 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/crash_signature.h"
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+
+namespace xls {
+namespace {
+
+TEST(CrashSignatureTest, NormalizationStripsRunSpecificDetail) {
+  EXPECT_EQ(NormalizeErrorMessage(
+                "Subprocess /tmp/run_dir_1234/eval_ir_main returned 139 at "
+                "0xdeadbeef after 42 nodes"),
+            "Subprocess <path> returned # at 0x# after # nodes");
+}
+
+TEST(CrashSignatureTest, SignatureIgnoresRunSpecificDetail) {
+  absl::Status first = absl::InternalError(
+      "Result miscompare for sample 17 in /tmp/worker0/run_3");
+  absl::Status second = absl::InternalError(
+      "Result miscompare for sample 23 in /tmp/worker5/run_99");
+  EXPECT_EQ(ComputeCrashSignature(first), ComputeCrashSignature(second));
+}
+
+TEST(CrashSignatureTest, SignatureDistinguishesDifferentFailures) {
+  EXPECT_NE(ComputeCrashSignature(absl::InternalError("Result miscompare")),
+            ComputeCrashSignature(absl::InternalError("Verifier failure")));
+  EXPECT_NE(
+      ComputeCrashSignature(absl::InternalError("boom")),
+      ComputeCrashSignature(absl::DeadlineExceededError("boom")));
+}
+
+TEST(CrashSignatureTest, IndexPersistsAcrossInstances) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+  CrashSignatureIndex index(temp_dir.path() / "signature_index");
+  XLS_ASSERT_OK_AND_ASSIGN(bool inserted, index.InsertSignature("abc123"));
+  EXPECT_TRUE(inserted);
+  XLS_ASSERT_OK_AND_ASSIGN(inserted, index.InsertSignature("abc123"));
+  EXPECT_FALSE(inserted);
+  XLS_ASSERT_OK_AND_ASSIGN(inserted, index.InsertSignature("def456"));
+  EXPECT_TRUE(inserted);
+
+  // A fresh index over the same directory sees the recorded signatures.
+  CrashSignatureIndex other_index(temp_dir.path() / "signature_index");
+  XLS_ASSERT_OK_AND_ASSIGN(inserted, other_index.InsertSignature("abc123"));
+  EXPECT_FALSE(inserted);
+}
+
+}  // namespace
+}  // namespace xls
@@ -0,0 +1,276 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/in_process_commands.h"
+
+#include <cstdlib>
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+#include "absl/time/time.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/get_runfile_path.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/common/subprocess.h"
+#include "xls/fuzzer/sample.h"
+#include "xls/fuzzer/sample_runner.h"
+#include "xls/interpreter/function_interpreter.h"
+#include "xls/ir/events.h"
+#include "xls/ir/format_preference.h"
+#include "xls/ir/function.h"
+#include "xls/ir/ir_parser.h"
+#include "xls/ir/package.h"
+#include "xls/ir/value.h"
+#include "xls/jit/function_jit.h"
+#include "xls/public/runtime_build_actions.h"
+#include "re2/re2.h"
+
+namespace xls {
+namespace {
+
+constexpr std::string_view kEvalIrMainPath = "xls/tools/eval_ir_main";
+constexpr std::string_view kIrConverterMainPath =
+    "xls/dslx/ir_convert/ir_converter_main";
+constexpr std::string_view kIrOptMainPath = "xls/tools/opt_main";
+
+// Resolves a path from a tool command line. The subprocess tools run with
+// `run_dir` as their CWD so SampleRunner may pass paths relative to it.
+std::filesystem::path ResolvePath(std::string_view path,
+                                  const std::filesystem::path& run_dir) {
+  std::filesystem::path p(path);
+  return p.is_absolute() ? p : run_dir / p;
+}
+
+// Runs the given stage under the standard subprocess tool, mirroring the
+// behavior of SampleRunner's own subprocess invocation: the tool's stderr is
+// written to `<basename>.stderr` in `run_dir`, the sample timeout is honored,
+// and non-zero exits matching a known-failure filter are reported as
+// FailedPrecondition rather than errors.
+absl::StatusOr<std::string> RunToolSubprocess(
+    std::string_view tool_path, const std::vector<std::string>& args,
+    const std::filesystem::path& run_dir, const SampleOptions& options) {
+  XLS_ASSIGN_OR_RETURN(std::filesystem::path executable,
+                       GetXlsRunfilePath(tool_path));
+  std::string basename = executable.filename();
+
+  std::vector<std::string> argv = {executable.string()};
+  argv.insert(argv.end(), args.begin(), args.end());
+  argv.push_back("--logtostderr");
+
+  std::optional<absl::Duration> timeout =
+      options.timeout_seconds().has_value()
+          ? std::make_optional(absl::Seconds(*options.timeout_seconds()))
+          : std::nullopt;
+  XLS_ASSIGN_OR_RETURN(SubprocessResult result,
+                       InvokeSubprocess(argv, run_dir, timeout));
+  std::string command_string = absl::StrJoin(argv, " ");
+  if (result.timeout_expired) {
+    return absl::DeadlineExceededError(
+        absl::StrCat("Subprocess call timed out: ", command_string));
+  }
+  XLS_RETURN_IF_ERROR(SetFileContents(
+      run_dir / absl::StrCat(basename, ".stderr"), result.stderr));
+  if (!result.normal_termination) {
+    return absl::InternalError(
+        absl::StrCat("Subprocess call failed: ", command_string));
+  }
+  if (result.exit_status != EXIT_SUCCESS) {
+    for (const KnownFailure& filter : options.known_failures()) {
+      if ((filter.tool == nullptr || RE2::FullMatch(basename, *filter.tool)) &&
+          filter.stderr_regex != nullptr &&
+          RE2::PartialMatch(result.stderr, *filter.stderr_regex)) {
+        return absl::FailedPreconditionError(absl::StrFormat(
+            "%s returned a non-zero exit status (%d) but failure "
+            "was suppressed due to stderr regexp",
+            executable.string(), result.exit_status));
+      }
+    }
+    return absl::InternalError(
+        absl::StrCat(executable.string(), " returned non-zero exit status (",
+                     result.exit_status, "): ", command_string));
+  }
+  return result.stdout;
+}
+
+// In-process equivalent of the ir_converter_main invocation SampleRunner
+// builds: optional `--top=NAME`, `--warnings_as_errors=false` and the DSLX
+// input path. Any other flag means the invocation cannot be faithfully
+// reproduced here and is reported as unimplemented (triggering the subprocess
+// fallback when enabled).
+absl::StatusOr<std::string> ConvertDslxToIrInProcess(
+    const std::vector<std::string>& args, const std::filesystem::path& run_dir,
+    const SampleOptions& options) {
+  std::string top;
+  std::optional<std::filesystem::path> input_path;
+  for (const std::string& arg : args) {
+    if (absl::StartsWith(arg, "--top=")) {
+      top = std::string(absl::StripPrefix(arg, "--top="));
+    } else if (arg == "--warnings_as_errors=false") {
+      // In-process typechecking does not promote warnings to errors.
+    } else if (absl::StartsWith(arg, "--")) {
+      return absl::UnimplementedError(absl::StrCat(
+          "Cannot convert DSLX in process with converter flag: ", arg));
+    } else {
+      input_path = ResolvePath(arg, run_dir);
+    }
+  }
+  XLS_RET_CHECK(input_path.has_value()) << "No DSLX input path given.";
+  XLS_ASSIGN_OR_RETURN(std::string dslx, GetFileContents(*input_path));
+  std::string module_name = input_path->stem();
+  XLS_ASSIGN_OR_RETURN(
+      std::string ir_text,
+      ConvertDslxToIr(dslx, input_path->string(), module_name,
+                      GetDefaultDslxStdlibPath(),
+                      /*additional_search_paths=*/{}));
+  if (top.empty()) {
+    return ir_text;
+  }
+  // Mark the requested function as the package top, as ir_converter_main does
+  // for --top.
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       Parser::ParsePackage(ir_text));
+  XLS_ASSIGN_OR_RETURN(std::string mangled_top,
+                       MangleDslxName(module_name, top));
+  XLS_RETURN_IF_ERROR(package->SetTopByName(mangled_top));
+  return package->DumpIr();
+}
+
+// In-process equivalent of the opt_main invocation SampleRunner builds: a
+// bare IR path optimized with the package's top entity.
+absl::StatusOr<std::string> OptimizeIrInProcess(
+    const std::vector<std::string>& args, const std::filesystem::path& run_dir,
+    const SampleOptions& options) {
+  XLS_RET_CHECK_EQ(args.size(), 1) << "Expected a single IR path argument.";
+  XLS_ASSIGN_OR_RETURN(std::string ir_text,
+                       GetFileContents(ResolvePath(args[0], run_dir)));
+  return OptimizeIr(ir_text, /*top=*/"");
+}
+
+// In-process equivalent of the eval_ir_main invocation SampleRunner builds:
+// `--input_file=ARGS_PATH`, `--use_llvm_jit`/`--nouse_llvm_jit` and the IR
+// path. The JIT-compiled function (or the interpreter) is reused across the
+// whole argument batch, so LLVM compilation happens at most once per sample
+// rather than once per subprocess.
+absl::StatusOr<std::string> EvaluateIrInProcess(
+    const std::vector<std::string>& args, const std::filesystem::path& run_dir,
+    const SampleOptions& options) {
+  bool use_jit = true;
+  std::optional<std::filesystem::path> args_path;
+  std::optional<std::filesystem::path> ir_path;
+  for (const std::string& arg : args) {
+    if (absl::StartsWith(arg, "--input_file=")) {
+      args_path = ResolvePath(absl::StripPrefix(arg, "--input_file="), run_dir);
+    } else if (arg == "--use_llvm_jit") {
+      use_jit = true;
+    } else if (arg == "--nouse_llvm_jit") {
+      use_jit = false;
+    } else if (absl::StartsWith(arg, "--")) {
+      return absl::UnimplementedError(
+          absl::StrCat("Cannot evaluate IR in process with flag: ", arg));
+    } else {
+      ir_path = ResolvePath(arg, run_dir);
+    }
+  }
+  XLS_RET_CHECK(ir_path.has_value()) << "No IR path given.";
+  XLS_RET_CHECK(args_path.has_value()) << "No --input_file given.";
+
+  XLS_ASSIGN_OR_RETURN(std::string ir_text, GetFileContents(*ir_path));
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       Parser::ParsePackage(ir_text));
+  XLS_ASSIGN_OR_RETURN(Function * top, package->GetTopAsFunction());
+
+  // Parse the argument batch: one semicolon-separated set of typed values per
+  // line, as written by SampleRunner and consumed by eval_ir_main.
+  XLS_ASSIGN_OR_RETURN(std::string args_text, GetFileContents(*args_path));
+  std::vector<std::vector<Value>> arg_sets;
+  for (std::string_view line : absl::StrSplit(args_text, '\n')) {
+    line = absl::StripAsciiWhitespace(line);
+    if (line.empty()) {
+      continue;
+    }
+    std::vector<Value> arg_set;
+    for (std::string_view value_text : absl::StrSplit(line, ';')) {
+      XLS_ASSIGN_OR_RETURN(Value value, Parser::ParseTypedValue(value_text));
+      arg_set.push_back(std::move(value));
+    }
+    arg_sets.push_back(std::move(arg_set));
+  }
+
+  std::unique_ptr<FunctionJit> jit;
+  if (use_jit) {
+    XLS_ASSIGN_OR_RETURN(jit, FunctionJit::Create(top));
+  }
+  std::string results_text;
+  for (const std::vector<Value>& arg_set : arg_sets) {
+    XLS_ASSIGN_OR_RETURN(
+        Value result,
+        use_jit ? DropInterpreterEvents(jit->Run(arg_set))
+                : DropInterpreterEvents(InterpretFunction(top, arg_set)));
+    absl::StrAppend(&results_text, result.ToString(FormatPreference::kHex),
+                    "\n");
+  }
+  return results_text;
+}
+
+// Wraps `in_process` so that on failure the stage is re-run under the
+// subprocess tool at `tool_path`, reproducing the failure with standard
+// isolation and error reporting.
+SampleRunner::Commands::Callable WithSubprocessFallback(
+    SampleRunner::Commands::Callable in_process, std::string_view tool_path,
+    bool fallback_to_subprocess) {
+  return [in_process = std::move(in_process), tool_path,
+          fallback_to_subprocess](
+             const std::vector<std::string>& args,
+             const std::filesystem::path& run_dir,
+             const SampleOptions& options) -> absl::StatusOr<std::string> {
+    absl::StatusOr<std::string> result = in_process(args, run_dir, options);
+    if (result.ok() || !fallback_to_subprocess) {
+      return result;
+    }
+    LOG(WARNING) << "In-process execution of " << tool_path
+                 << " failed, re-running as a subprocess: " << result.status();
+    return RunToolSubprocess(tool_path, args, run_dir, options);
+  };
+}
+
+}  // namespace
+
+SampleRunner::Commands CreateInProcessCommands(bool fallback_to_subprocess) {
+  SampleRunner::Commands commands;
+  commands.ir_converter_main = WithSubprocessFallback(
+      ConvertDslxToIrInProcess, kIrConverterMainPath, fallback_to_subprocess);
+  commands.ir_opt_main = WithSubprocessFallback(
+      OptimizeIrInProcess, kIrOptMainPath, fallback_to_subprocess);
+  commands.eval_ir_main = WithSubprocessFallback(
+      EvaluateIrInProcess, kEvalIrMainPath, fallback_to_subprocess);
+  return commands;
+}
+
+}  // namespace xls
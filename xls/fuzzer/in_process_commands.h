@@ -0,0 +1,40 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_FUZZER_IN_PROCESS_COMMANDS_H_
+#define XLS_FUZZER_IN_PROCESS_COMMANDS_H_
+
+#include "xls/fuzzer/sample_runner.h"
+
+namespace xls {
+
+// Returns a SampleRunner command set which runs the DSLX-to-IR conversion, IR
+// optimization and IR function evaluation stages of a sample in this process
+// instead of spawning the corresponding tool subprocess for each stage. This
+// eliminates the per-stage process launch and LLVM initialization cost, which
+// dominates the runtime of small fuzz samples; the files each stage would
+// have produced are still written by SampleRunner so runs remain replayable
+// with run.sh. Codegen, Verilog simulation and proc evaluation are left as
+// subprocess invocations.
+//
+// When `fallback_to_subprocess` is true (the default) any in-process stage
+// failure is retried under the standard subprocess tool so that crashes and
+// errors are reproduced with the usual process isolation (and the usual
+// .stderr artifacts and known-failure filtering) before being reported.
+SampleRunner::Commands CreateInProcessCommands(
+    bool fallback_to_subprocess = true);
+
+}  // namespace xls
+
+#endif  // XLS_FUZZER_IN_PROCESS_COMMANDS_H_
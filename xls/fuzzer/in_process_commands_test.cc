@@ -0,0 +1,117 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/in_process_commands.h"
+
+#include <filesystem>  // NOLINT
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+#include "xls/fuzzer/sample.h"
+#include "xls/fuzzer/sample_runner.h"
+
+namespace xls {
+namespace {
+
+using status_testing::IsOkAndHolds;
+using status_testing::StatusIs;
+using ::testing::HasSubstr;
+
+constexpr std::string_view kAdderDslx = R"(
+fn main(x: u8, y: u8) -> u8 {
+  x + y
+}
+)";
+
+class InProcessCommandsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    XLS_ASSERT_OK_AND_ASSIGN(temp_dir_, TempDirectory::Create());
+  }
+
+  void TearDown() override {
+    // Take ownership of the temp dir so it is removed on destruction.
+    TempDirectory temp_dir = *std::move(temp_dir_);
+  }
+
+  std::filesystem::path GetTempPath() { return temp_dir_->path(); }
+
+  // Returns the Callable backing the given optional command.
+  static SampleRunner::Commands::Callable GetCallable(
+      const std::optional<SampleRunner::Commands::Command>& command) {
+    return std::get<SampleRunner::Commands::Callable>(*command);
+  }
+
+  std::optional<TempDirectory> temp_dir_;
+};
+
+TEST_F(InProcessCommandsTest, ConvertOptimizeAndEvaluate) {
+  SampleRunner::Commands commands =
+      CreateInProcessCommands(/*fallback_to_subprocess=*/false);
+  const std::filesystem::path run_dir = GetTempPath();
+  const SampleOptions options;
+
+  XLS_ASSERT_OK(SetFileContents(run_dir / "sample.x", kAdderDslx));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::string ir_text,
+      GetCallable(commands.ir_converter_main)(
+          {"--top=main", "--warnings_as_errors=false", "sample.x"}, run_dir,
+          options));
+  EXPECT_THAT(ir_text, HasSubstr("top fn __sample__main"));
+
+  XLS_ASSERT_OK(SetFileContents(run_dir / "sample.ir", ir_text));
+  XLS_ASSERT_OK_AND_ASSIGN(std::string opt_ir_text,
+                           GetCallable(commands.ir_opt_main)(
+                               {"sample.ir"}, run_dir, options));
+  EXPECT_THAT(opt_ir_text, HasSubstr("top fn __sample__main"));
+
+  XLS_ASSERT_OK(SetFileContents(run_dir / "args.txt",
+                                "bits[8]:0x2; bits[8]:0x3\n"
+                                "bits[8]:0x10; bits[8]:0x20\n"));
+  EXPECT_THAT(
+      GetCallable(commands.eval_ir_main)(
+          {"--input_file=args.txt", "--nouse_llvm_jit", "sample.ir"}, run_dir,
+          options),
+      IsOkAndHolds("bits[8]:0x5\nbits[8]:0x30\n"));
+  EXPECT_THAT(
+      GetCallable(commands.eval_ir_main)(
+          {"--input_file=args.txt", "--use_llvm_jit", "sample.ir"}, run_dir,
+          options),
+      IsOkAndHolds("bits[8]:0x5\nbits[8]:0x30\n"));
+}
+
+TEST_F(InProcessCommandsTest, UnknownFlagIsNotSilentlyIgnored) {
+  SampleRunner::Commands commands =
+      CreateInProcessCommands(/*fallback_to_subprocess=*/false);
+  const std::filesystem::path run_dir = GetTempPath();
+  const SampleOptions options;
+
+  XLS_ASSERT_OK(SetFileContents(run_dir / "sample.x", kAdderDslx));
+  EXPECT_THAT(GetCallable(commands.ir_converter_main)(
+                  {"--emit_fail_as_assert", "sample.x"}, run_dir, options),
+              StatusIs(absl::StatusCode::kUnimplemented,
+                       HasSubstr("--emit_fail_as_assert")));
+}
+
+}  // namespace
+}  // namespace xls
@@ -24,6 +24,7 @@
 #include <string_view>
 #include <vector>
 
+#include "absl/flags/flag.h"
 #include "absl/log/log.h"
 #include "absl/random/bit_gen_ref.h"
 #include "absl/status/status.h"
@@ -44,11 +45,19 @@
 #include "xls/common/subprocess.h"
 #include "xls/fuzzer/ast_generator.h"
 #include "xls/fuzzer/cpp_run_fuzz.h"
+#include "xls/fuzzer/crash_signature.h"
+#include "xls/fuzzer/in_process_commands.h"
 #include "xls/fuzzer/sample.h"
 #include "xls/fuzzer/sample_generator.h"
 #include "xls/fuzzer/sample_runner.h"
 #include "xls/fuzzer/sample_summary.pb.h"
 
+ABSL_FLAG(bool, use_in_process_sample_runner, false,
+          "Run the DSLX-to-IR, optimization and IR evaluation stages of each "
+          "sample in process instead of spawning a tool subprocess per stage. "
+          "Substantially faster for small samples; failing stages are re-run "
+          "as subprocesses so crashers still reproduce in isolation.");
+
 namespace xls {
 
 namespace {
@@ -222,7 +231,10 @@ absl::Status RunSample(const Sample& smp, const std::filesystem::path& run_dir,
 
   VLOG(1) << "Starting to run sample";
   VLOG(2) << smp.input_text();
-  SampleRunner runner(run_dir);
+  SampleRunner runner =
+      absl::GetFlag(FLAGS_use_in_process_sample_runner)
+          ? SampleRunner(run_dir, CreateInProcessCommands())
+          : SampleRunner(run_dir);
   XLS_RETURN_IF_ERROR(runner.RunFromFiles(sample_file_name, options_file_name,
                                           args_file_name,
                                           ir_channel_names_file_name));
@@ -273,7 +285,16 @@ absl::StatusOr<Sample> GenerateSampleAndRun(
   if (crasher_dir.has_value()) {
     XLS_ASSIGN_OR_RETURN(std::filesystem::path sample_crasher_dir,
                          SaveCrasher(run_dir, smp, status, *crasher_dir));
-    if (!absl::IsDeadlineExceeded(status)) {
+    // Minimization is by far the most expensive part of handling a crasher,
+    // and identical failure signatures share a root cause; only minimize the
+    // first crasher with a given signature.
+    CrashSignatureIndex signature_index(*crasher_dir / "signature_index");
+    XLS_ASSIGN_OR_RETURN(
+        bool new_signature,
+        signature_index.InsertSignature(ComputeCrashSignature(status)));
+    if (!new_signature) {
+      LOG(INFO) << "Crash signature seen before; skipping minimization.";
+    } else if (!absl::IsDeadlineExceeded(status)) {
       LOG(INFO) << "Attempting to minimize IR...";
       std::optional<absl::Duration> timeout =
           sample_options.timeout_seconds().has_value()
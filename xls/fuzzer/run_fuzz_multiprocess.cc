@@ -40,6 +40,7 @@
 #include "xls/fuzzer/ast_generator.h"
 #include "xls/fuzzer/run_fuzz.h"
 #include "xls/fuzzer/sample.h"
+#include "xls/fuzzer/sample_corpus.h"
 
 namespace xls {
 namespace {
@@ -55,7 +56,7 @@ absl::Status GenerateAndRunSamples(
     const std::optional<std::filesystem::path>& top_run_dir,
     const std::optional<std::filesystem::path>& crasher_dir,
     const std::optional<std::filesystem::path>& summary_dir,
-    std::optional<int64_t> sample_count,
+    SampleCorpusWriter* corpus_writer, std::optional<int64_t> sample_count,
     const std::optional<absl::Duration>& duration, bool force_failure) {
   int64_t crashers = 0;
   LOG(INFO) << "--- Started worker " << worker_number;
@@ -94,11 +95,13 @@ absl::Status GenerateAndRunSamples(
       run_dir = temp_run_dir->path();
     }
 
-    absl::Status sample_status =
+    absl::StatusOr<Sample> run_result =
         GenerateSampleAndRun(rng, ast_generator_options, sample_options,
-                             run_dir, crasher_dir, summary_file, force_failure)
-            .status();
-    if (!sample_status.ok()) {
+                             run_dir, crasher_dir, summary_file, force_failure);
+    if (run_result.ok() && corpus_writer != nullptr) {
+      XLS_RETURN_IF_ERROR(corpus_writer->Append(*run_result));
+    }
+    if (!run_result.ok()) {
       LOG(INFO) << kRedText
                 << absl::StreamFormat(
                        "--- Worker #%d noted crasher #%d for sample number %d",
@@ -165,8 +168,14 @@ absl::Status ParallelGenerateAndRunSamples(
     const std::optional<std::filesystem::path>& top_run_dir,
     const std::optional<std::filesystem::path>& crasher_dir,
     const std::optional<std::filesystem::path>& summary_dir,
+    const std::optional<std::filesystem::path>& corpus_file,
     std::optional<int64_t> sample_count, std::optional<absl::Duration> duration,
     bool force_failure) {
+  // All workers share one corpus writer; Append() is thread-safe.
+  std::unique_ptr<SampleCorpusWriter> corpus_writer;
+  if (corpus_file.has_value()) {
+    XLS_ASSIGN_OR_RETURN(corpus_writer, SampleCorpusWriter::Open(*corpus_file));
+  }
   std::vector<std::unique_ptr<Thread>> workers;
   workers.resize(worker_count);
   std::vector<absl::Status> worker_status;
@@ -179,10 +188,10 @@ absl::Status ParallelGenerateAndRunSamples(
             : std::nullopt;
     workers[i] = std::make_unique<Thread>([&, i, worker_sample_count,
                                            status = &worker_status[i]] {
-      *status =
-          GenerateAndRunSamples(i, ast_generator_options, sample_options, seed,
-                                top_run_dir, crasher_dir, summary_dir,
-                                worker_sample_count, duration, force_failure);
+      *status = GenerateAndRunSamples(
+          i, ast_generator_options, sample_options, seed, top_run_dir,
+          crasher_dir, summary_dir, corpus_writer.get(), worker_sample_count,
+          duration, force_failure);
     });
   }
   for (int64_t i = 0; i < workers.size(); ++i) {
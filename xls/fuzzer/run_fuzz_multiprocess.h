@@ -33,7 +33,10 @@ namespace xls {
 // according to `sample_options`. Uses a nondeterministic seed if `seed` is not
 // specified. Creates run directories in `top_run_dir` if specified; otherwise
 // creates ephemeral temporary directories for each sample. Failing samples are
-// written to `crasher_dir`, and summaries to `summary_dir`.
+// written to `crasher_dir`, and summaries to `summary_dir`. If `corpus_file`
+// is specified, every successfully run sample is appended to the packed
+// corpus at that path (see sample_corpus.h); the file is created if needed
+// and appended to if it already exists.
 //
 // If `force_failure` is true, every sample run will be considered a failure.
 // This is useful for testing failure paths.
@@ -45,6 +48,7 @@ absl::Status ParallelGenerateAndRunSamples(
     const std::optional<std::filesystem::path>& top_run_dir = std::nullopt,
     const std::optional<std::filesystem::path>& crasher_dir = std::nullopt,
     const std::optional<std::filesystem::path>& summary_dir = std::nullopt,
+    const std::optional<std::filesystem::path>& corpus_file = std::nullopt,
     std::optional<int64_t> sample_count = std::nullopt,
     std::optional<absl::Duration> duration = std::nullopt,
     bool force_failure = false);
@@ -41,6 +41,10 @@ ABSL_FLAG(int64_t, calls_per_sample, 128, "Arguments to generate per sample.");
 ABSL_FLAG(std::optional<std::string>, crash_path, std::nullopt,
           "Path at which to place crash data.");
 ABSL_FLAG(bool, codegen, false, "Run code generation.");
+ABSL_FLAG(std::optional<std::string>, corpus_file, std::nullopt,
+          "Path of a packed sample corpus file to which every successfully "
+          "run sample is appended. The file is created if it does not exist "
+          "and appended to otherwise.");
 ABSL_FLAG(bool, emit_loops, true, "Emit loops in generator.");
 ABSL_FLAG(
     bool, force_failure, false,
@@ -91,6 +95,7 @@ struct Options {
   int64_t calls_per_sample;
   std::optional<std::filesystem::path> crash_path;
   bool codegen;
+  std::optional<std::filesystem::path> corpus_file;
   bool emit_loops;
   bool force_failure;
   bool generate_proc;
@@ -172,7 +177,8 @@ absl::Status RealMain(const Options& options) {
       worker_count, ast_generator_options, sample_options, options.seed,
       /*top_run_dir=*/options.save_temps_path,
       /*crasher_dir=*/options.crash_path, /*summary_dir=*/options.summary_path,
-      options.sample_count, options.duration, options.force_failure);
+      /*corpus_file=*/options.corpus_file, options.sample_count,
+      options.duration, options.force_failure);
 }
 
 }  // namespace
@@ -198,6 +204,7 @@ int main(int argc, char** argv) {
       .calls_per_sample = absl::GetFlag(FLAGS_calls_per_sample),
       .crash_path = absl::GetFlag(FLAGS_crash_path),
       .codegen = absl::GetFlag(FLAGS_codegen),
+      .corpus_file = absl::GetFlag(FLAGS_corpus_file),
       .emit_loops = absl::GetFlag(FLAGS_emit_loops),
       .force_failure = absl::GetFlag(FLAGS_force_failure),
       .generate_proc = absl::GetFlag(FLAGS_generate_proc),
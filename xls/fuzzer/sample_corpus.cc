@@ -0,0 +1,255 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/sample_corpus.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>  // NOLINT
+#include <fstream>
+#include <ios>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/fuzzer/sample.h"
+#include "zstd.h"
+
+namespace xls {
+namespace {
+
+// zstd compression level used when appending. Level 3 is the zstd default; it
+// compresses the highly repetitive DSLX/argument text roughly 10x while
+// remaining far cheaper than running a sample.
+constexpr int kCompressionLevel = 3;
+
+// Size of the per-frame header: uncompressed size plus compressed size.
+constexpr int64_t kFrameHeaderSize = 2 * sizeof(uint64_t);
+
+std::filesystem::path IndexPath(const std::filesystem::path& path) {
+  return std::filesystem::path(absl::StrCat(path.string(), ".index"));
+}
+
+void AppendU64LE(uint64_t value, std::string* out) {
+  for (int i = 0; i < 8; ++i) {
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+uint64_t DecodeU64LE(const char* data) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+  }
+  return value;
+}
+
+// Decompresses one frame body and deserializes the contained sample.
+absl::StatusOr<Sample> DecodeFrame(std::string_view compressed,
+                                   uint64_t uncompressed_size) {
+  std::string serialized(uncompressed_size, '\0');
+  size_t result = ZSTD_decompress(serialized.data(), serialized.size(),
+                                  compressed.data(), compressed.size());
+  if (ZSTD_isError(result)) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Corrupt corpus frame: ", ZSTD_getErrorName(result)));
+  }
+  if (result != uncompressed_size) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Corrupt corpus frame: expected ", uncompressed_size,
+                     " bytes, decompressed ", result));
+  }
+  return Sample::Deserialize(serialized);
+}
+
+}  // namespace
+
+/* static */ absl::StatusOr<std::unique_ptr<SampleCorpusWriter>>
+SampleCorpusWriter::Open(const std::filesystem::path& path) {
+  std::error_code ec;
+  int64_t existing_size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    existing_size = 0;
+  }
+  if (existing_size > 0) {
+    // Appending to an existing corpus; make sure it is one.
+    std::ifstream existing(path, std::ios::binary);
+    char magic[kSampleCorpusMagic.size()];
+    if (!existing.read(magic, kSampleCorpusMagic.size()) ||
+        std::string_view(magic, kSampleCorpusMagic.size()) !=
+            kSampleCorpusMagic) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          path.string(), " exists but is not a packed sample corpus"));
+    }
+  }
+
+  std::ofstream corpus_out(path, std::ios::binary | std::ios::app);
+  std::ofstream index_out(IndexPath(path), std::ios::binary | std::ios::app);
+  if (!corpus_out.is_open() || !index_out.is_open()) {
+    return absl::InternalError(
+        absl::StrCat("Unable to open corpus file for appending: ",
+                     path.string()));
+  }
+  if (existing_size == 0) {
+    corpus_out.write(kSampleCorpusMagic.data(), kSampleCorpusMagic.size());
+    corpus_out.flush();
+    existing_size = kSampleCorpusMagic.size();
+  }
+  return absl::WrapUnique(
+      new SampleCorpusWriter(path, std::move(corpus_out), std::move(index_out),
+                             existing_size));
+}
+
+absl::Status SampleCorpusWriter::Append(const Sample& sample) {
+  std::string serialized = sample.Serialize();
+  std::string frame;
+  AppendU64LE(serialized.size(), &frame);
+  frame.resize(kFrameHeaderSize + ZSTD_compressBound(serialized.size()));
+  size_t compressed_size = ZSTD_compress(
+      frame.data() + kFrameHeaderSize, frame.size() - kFrameHeaderSize,
+      serialized.data(), serialized.size(), kCompressionLevel);
+  if (ZSTD_isError(compressed_size)) {
+    return absl::InternalError(absl::StrCat(
+        "Unable to compress sample: ", ZSTD_getErrorName(compressed_size)));
+  }
+  frame.resize(kFrameHeaderSize + compressed_size);
+  // Patch the compressed size into the second header word.
+  std::string compressed_size_le;
+  AppendU64LE(compressed_size, &compressed_size_le);
+  std::memcpy(frame.data() + sizeof(uint64_t), compressed_size_le.data(),
+              sizeof(uint64_t));
+
+  std::string index_entry;
+  absl::MutexLock lock(&mutex_);
+  AppendU64LE(offset_, &index_entry);
+  corpus_out_.write(frame.data(), frame.size());
+  corpus_out_.flush();
+  index_out_.write(index_entry.data(), index_entry.size());
+  index_out_.flush();
+  if (!corpus_out_.good() || !index_out_.good()) {
+    return absl::InternalError(
+        absl::StrCat("Error writing to corpus file: ", path_.string()));
+  }
+  offset_ += frame.size();
+  return absl::OkStatus();
+}
+
+absl::StatusOr<int64_t> GetSampleCorpusSize(
+    const std::filesystem::path& path) {
+  std::error_code ec;
+  int64_t index_size = std::filesystem::file_size(IndexPath(path), ec);
+  if (ec) {
+    return absl::NotFoundError(absl::StrCat(
+        "Unable to read corpus index for ", path.string(), ": ",
+        ec.message()));
+  }
+  XLS_RET_CHECK_EQ(index_size % sizeof(uint64_t), 0)
+      << "Corrupt corpus index: " << IndexPath(path);
+  return index_size / static_cast<int64_t>(sizeof(uint64_t));
+}
+
+absl::StatusOr<std::vector<Sample>> ReadSampleCorpus(
+    const std::filesystem::path& path) {
+  XLS_ASSIGN_OR_RETURN(std::string contents, GetFileContents(path));
+  if (contents.size() < kSampleCorpusMagic.size() ||
+      std::string_view(contents).substr(0, kSampleCorpusMagic.size()) !=
+          kSampleCorpusMagic) {
+    return absl::InvalidArgumentError(
+        absl::StrCat(path.string(), " is not a packed sample corpus"));
+  }
+  std::vector<Sample> samples;
+  const int64_t contents_size = static_cast<int64_t>(contents.size());
+  int64_t pos = kSampleCorpusMagic.size();
+  while (pos < contents_size) {
+    if (contents_size - pos < kFrameHeaderSize) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Truncated corpus frame header at offset ", pos,
+                       " in ", path.string()));
+    }
+    uint64_t uncompressed_size = DecodeU64LE(contents.data() + pos);
+    uint64_t compressed_size =
+        DecodeU64LE(contents.data() + pos + sizeof(uint64_t));
+    pos += kFrameHeaderSize;
+    if (static_cast<uint64_t>(contents_size - pos) < compressed_size) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Truncated corpus frame at offset ", pos, " in ", path.string()));
+    }
+    XLS_ASSIGN_OR_RETURN(
+        Sample sample,
+        DecodeFrame(std::string_view(contents).substr(pos, compressed_size),
+                    uncompressed_size));
+    samples.push_back(std::move(sample));
+    pos += compressed_size;
+  }
+  return samples;
+}
+
+absl::StatusOr<std::vector<Sample>> ReadSampleCorpusRange(
+    const std::filesystem::path& path, int64_t start, int64_t count) {
+  XLS_ASSIGN_OR_RETURN(int64_t corpus_size, GetSampleCorpusSize(path));
+  XLS_RET_CHECK_GE(start, 0);
+  XLS_RET_CHECK_GE(count, 0);
+  if (start + count > corpus_size) {
+    return absl::OutOfRangeError(absl::StrCat(
+        "Requested samples [", start, ", ", start + count, ") but corpus ",
+        path.string(), " holds ", corpus_size, " samples"));
+  }
+
+  XLS_ASSIGN_OR_RETURN(std::string index_contents,
+                       GetFileContents(IndexPath(path)));
+  uint64_t offset =
+      DecodeU64LE(index_contents.data() + start * sizeof(uint64_t));
+
+  std::ifstream corpus(path, std::ios::binary);
+  if (!corpus.is_open()) {
+    return absl::NotFoundError(
+        absl::StrCat("Unable to open corpus file: ", path.string()));
+  }
+  corpus.seekg(offset);
+  std::vector<Sample> samples;
+  samples.reserve(count);
+  for (int64_t i = 0; i < count; ++i) {
+    char header[kFrameHeaderSize];
+    if (!corpus.read(header, kFrameHeaderSize)) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Truncated corpus frame header for sample ", start + i, " in ",
+          path.string()));
+    }
+    uint64_t uncompressed_size = DecodeU64LE(header);
+    uint64_t compressed_size = DecodeU64LE(header + sizeof(uint64_t));
+    std::string compressed(compressed_size, '\0');
+    if (!corpus.read(compressed.data(), compressed.size())) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Truncated corpus frame for sample ", start + i,
+                       " in ", path.string()));
+    }
+    XLS_ASSIGN_OR_RETURN(Sample sample,
+                         DecodeFrame(compressed, uncompressed_size));
+    samples.push_back(std::move(sample));
+  }
+  return samples;
+}
+
+}  // namespace xls
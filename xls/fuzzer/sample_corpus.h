@@ -0,0 +1,100 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_FUZZER_SAMPLE_CORPUS_H_
+#define XLS_FUZZER_SAMPLE_CORPUS_H_
+
+#include <cstdint>
+#include <filesystem>  // NOLINT
+#include <fstream>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/fuzzer/sample.h"
+
+namespace xls {
+
+// A packed, appendable on-disk format for fuzzer sample corpora.
+//
+// Historically each sample was stored as a directory of small text files
+// (DSLX, arguments, options). At corpus scale that layout burns millions of
+// inodes and makes triage passes IO-bound on directory walks. The packed
+// format stores an entire corpus in a single file: an 8-byte magic string
+// followed by a sequence of frames, each holding one serialized Sample
+// compressed with zstd. A sidecar index file (the corpus path with ".index"
+// appended) records the byte offset of every frame so readers can seek to an
+// arbitrary sample without scanning the whole file.
+//
+// Frame layout (all integers little-endian):
+//   uint64 uncompressed_size
+//   uint64 compressed_size
+//   byte[compressed_size] zstd frame of Sample::Serialize() text
+
+// The magic string at the start of every packed corpus file.
+inline constexpr std::string_view kSampleCorpusMagic = "XLSCORP1";
+
+// Appends samples to a packed corpus file, creating it (and its index) if it
+// does not exist. Append() is thread-safe so a single writer can be shared by
+// all fuzz worker threads. Frames are flushed as they are written; a crashed
+// fuzzer run leaves a readable corpus behind.
+class SampleCorpusWriter {
+ public:
+  // Opens the corpus at `path` for appending. Fails if an existing file does
+  // not start with the corpus magic.
+  static absl::StatusOr<std::unique_ptr<SampleCorpusWriter>> Open(
+      const std::filesystem::path& path);
+
+  // Compresses and appends `sample`, and records its offset in the index.
+  absl::Status Append(const Sample& sample);
+
+  const std::filesystem::path& path() const { return path_; }
+
+ private:
+  SampleCorpusWriter(std::filesystem::path path, std::ofstream corpus_out,
+                     std::ofstream index_out, int64_t offset)
+      : path_(std::move(path)),
+        corpus_out_(std::move(corpus_out)),
+        index_out_(std::move(index_out)),
+        offset_(offset) {}
+
+  std::filesystem::path path_;
+  absl::Mutex mutex_;
+  std::ofstream corpus_out_ ABSL_GUARDED_BY(mutex_);
+  std::ofstream index_out_ ABSL_GUARDED_BY(mutex_);
+  // Byte offset in the corpus file at which the next frame will be written.
+  int64_t offset_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Returns the number of samples in the packed corpus at `path`, from the
+// index alone without touching the corpus file.
+absl::StatusOr<int64_t> GetSampleCorpusSize(const std::filesystem::path& path);
+
+// Reads every sample from the packed corpus at `path`.
+absl::StatusOr<std::vector<Sample>> ReadSampleCorpus(
+    const std::filesystem::path& path);
+
+// Reads `count` samples starting at sample number `start` (zero-based), using
+// the index to seek directly to the first frame. This is the API triage tools
+// should use to shard a large corpus across processes.
+absl::StatusOr<std::vector<Sample>> ReadSampleCorpusRange(
+    const std::filesystem::path& path, int64_t start, int64_t count);
+
+}  // namespace xls
+
+#endif  // XLS_FUZZER_SAMPLE_CORPUS_H_
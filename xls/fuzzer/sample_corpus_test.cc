@@ -0,0 +1,127 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/sample_corpus.h"
+
+#include <cstdint>
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+#include "xls/dslx/interp_value.h"
+#include "xls/fuzzer/sample.h"
+
+namespace xls {
+namespace {
+
+using status_testing::StatusIs;
+
+// Returns a distinguishable sample for `number`.
+Sample MakeSample(int64_t number) {
+  std::string dslx_text = absl::StrFormat(
+      "fn main(x: u32) -> u32 {\n  x + u32:%d\n}", number);
+  SampleOptions options;
+  return Sample(dslx_text, options,
+                {{dslx::InterpValue::MakeU32(number)},
+                 {dslx::InterpValue::MakeU32(2 * number)}});
+}
+
+TEST(SampleCorpusTest, WriteAndReadBack) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+  std::filesystem::path corpus_path = temp_dir.path() / "corpus.xlscorp";
+
+  constexpr int64_t kSampleCount = 10;
+  {
+    XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SampleCorpusWriter> writer,
+                             SampleCorpusWriter::Open(corpus_path));
+    for (int64_t i = 0; i < kSampleCount; ++i) {
+      XLS_ASSERT_OK(writer->Append(MakeSample(i)));
+    }
+  }
+
+  XLS_ASSERT_OK_AND_ASSIGN(int64_t size, GetSampleCorpusSize(corpus_path));
+  EXPECT_EQ(size, kSampleCount);
+
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Sample> samples,
+                           ReadSampleCorpus(corpus_path));
+  ASSERT_EQ(samples.size(), kSampleCount);
+  for (int64_t i = 0; i < kSampleCount; ++i) {
+    EXPECT_EQ(samples[i], MakeSample(i));
+  }
+}
+
+TEST(SampleCorpusTest, AppendToExistingCorpus) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+  std::filesystem::path corpus_path = temp_dir.path() / "corpus.xlscorp";
+
+  {
+    XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SampleCorpusWriter> writer,
+                             SampleCorpusWriter::Open(corpus_path));
+    XLS_ASSERT_OK(writer->Append(MakeSample(0)));
+  }
+  {
+    // Reopening appends rather than truncating.
+    XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SampleCorpusWriter> writer,
+                             SampleCorpusWriter::Open(corpus_path));
+    XLS_ASSERT_OK(writer->Append(MakeSample(1)));
+  }
+
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Sample> samples,
+                           ReadSampleCorpus(corpus_path));
+  ASSERT_EQ(samples.size(), 2);
+  EXPECT_EQ(samples[0], MakeSample(0));
+  EXPECT_EQ(samples[1], MakeSample(1));
+}
+
+TEST(SampleCorpusTest, RangeReadSeeksViaIndex) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+  std::filesystem::path corpus_path = temp_dir.path() / "corpus.xlscorp";
+
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SampleCorpusWriter> writer,
+                           SampleCorpusWriter::Open(corpus_path));
+  for (int64_t i = 0; i < 8; ++i) {
+    XLS_ASSERT_OK(writer->Append(MakeSample(i)));
+  }
+
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Sample> samples,
+                           ReadSampleCorpusRange(corpus_path, 3, 2));
+  ASSERT_EQ(samples.size(), 2);
+  EXPECT_EQ(samples[0], MakeSample(3));
+  EXPECT_EQ(samples[1], MakeSample(4));
+
+  EXPECT_THAT(ReadSampleCorpusRange(corpus_path, 7, 2),
+              StatusIs(absl::StatusCode::kOutOfRange));
+}
+
+TEST(SampleCorpusTest, RejectsNonCorpusFile) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+  std::filesystem::path not_a_corpus = temp_dir.path() / "sample.x";
+  XLS_ASSERT_OK(SetFileContents(not_a_corpus, "fn main() -> u32 { u32:0 }"));
+
+  EXPECT_THAT(SampleCorpusWriter::Open(not_a_corpus).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ReadSampleCorpus(not_a_corpus).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace xls
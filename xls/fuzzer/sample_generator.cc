@@ -20,7 +20,6 @@
 #include <optional>
 #include <string>
 #include <string_view>
-#include <tuple>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -67,9 +66,9 @@ using dslx::ImportData;
 using dslx::InterpValue;
 using dslx::Module;
 using dslx::ModuleMember;
-using dslx::ParseModule;
 using dslx::Type;
 using dslx::TypecheckedModule;
+using dslx::TypecheckModule;
 
 class HasNonBlockingRecvVisitor : public AstNodeVisitorWithDefault {
  public:
@@ -115,15 +114,13 @@ class IsPotentiallyDelayingNodeVisitor : public AstNodeVisitorWithDefault {
 
 }  // namespace
 
-static absl::StatusOr<bool> HasNonBlockingRecv(const std::string& dslx_text) {
-  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Module> module,
-                       ParseModule(dslx_text, "sample.x", "sample"));
+static absl::StatusOr<bool> HasNonBlockingRecv(Module* module) {
   XLS_RET_CHECK(module != nullptr);
 
   HasNonBlockingRecvVisitor visitor;
   // Using std::deque to leverage the `insert` operator.
   std::deque<AstNode*> bfs_queue;
-  bfs_queue.push_back(module.get());
+  bfs_queue.push_back(module);
   while (!bfs_queue.empty()) {
     AstNode* node = bfs_queue.front();
     bfs_queue.pop_front();
@@ -215,15 +212,15 @@ static std::vector<std::string> GenerateCodegenArgs(
   return args;
 }
 
-// This function generates a module satisfying `ast_options`, and returns the
-// DSLX for that module and the minimum number of stages it can be safely
-// scheduled in.
-static absl::StatusOr<std::pair<std::string, int64_t>> Generate(
+// This function generates a module satisfying `ast_options` and returns the
+// annotated module along with the minimum number of stages it can be safely
+// scheduled in. The module is named "sample" to match the name the sample
+// runner gives it when re-parsing sample.x, so IR symbols derived from the
+// module name (e.g. mangled channel names) line up.
+static absl::StatusOr<dslx::AnnotatedModule> Generate(
     const AstGeneratorOptions& ast_options, absl::BitGenRef bit_gen) {
   AstGenerator g(ast_options, bit_gen);
-  XLS_ASSIGN_OR_RETURN(dslx::AnnotatedModule module,
-                       g.Generate("main", "test"));
-  return std::make_pair(module.module->ToString(), module.min_stages);
+  return g.Generate("main", "sample");
 }
 
 // The function translates a list of Type unique_ptrs to a list of
@@ -359,17 +356,20 @@ absl::StatusOr<Sample> GenerateSample(
            "function sample.";
   }
 
-  std::string dslx_text;
+  std::unique_ptr<Module> module;
   bool has_nb_recv = false;
   int64_t min_stages = 1;
   do {
-    XLS_ASSIGN_OR_RETURN(std::tie(dslx_text, min_stages),
+    XLS_ASSIGN_OR_RETURN(dslx::AnnotatedModule annotated,
                          Generate(generator_options, bit_gen));
-    XLS_ASSIGN_OR_RETURN(has_nb_recv, HasNonBlockingRecv(dslx_text));
+    module = std::move(annotated.module);
+    min_stages = annotated.min_stages;
+    XLS_ASSIGN_OR_RETURN(has_nb_recv, HasNonBlockingRecv(module.get()));
     // If this sample is going through codegen, regenerate the sample until it's
     // legal; we currently can't verify latency-sensitive samples, which means
     // we can't have a non-blocking recv except with 1 pipeline stage.
   } while (sample_options.codegen() && has_nb_recv && min_stages > 1);
+  std::string dslx_text = module->ToString();
 
   // Generate the sample options which is how to *run* the generated
   // sample. AstGeneratorOptions 'options' is how to *generate* the sample.
@@ -390,16 +390,17 @@ absl::StatusOr<Sample> GenerateSample(
                             min_stages, has_nb_recv, bit_gen));
   }
 
-  // Parse and type check the DSLX input to retrieve the top entity. The top
-  // member must be a proc or a function.
+  // Type check the generated module directly to retrieve the top entity;
+  // re-parsing the printed text would only reconstruct the AST we already
+  // hold. The top member must be a proc or a function.
   ImportData import_data(
       dslx::CreateImportData(/*stdlib_path=*/"",
                              /*additional_search_paths=*/{},
                              /*enabled_warnings=*/dslx::kAllWarningsSet));
   absl::StatusOr<TypecheckedModule> tm =
-      ParseAndTypecheck(dslx_text, "sample.x", "sample", &import_data);
+      TypecheckModule(std::move(module), "sample.x", &import_data);
   if (!tm.ok()) {
-    LOG(ERROR) << "Generated sample failed to parse.";
+    LOG(ERROR) << "Generated sample failed to typecheck.";
     XLS_LOG_LINES(ERROR, dslx_text);
     return tm.status();
   }
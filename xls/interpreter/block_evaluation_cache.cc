@@ -0,0 +1,108 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/block_evaluation_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/interpreter/block_evaluator.h"
+#include "xls/ir/block.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+// Serializes the stimulus into a stable text form: one line per cycle with
+// ports in name order.
+std::string StimulusToString(
+    absl::Span<const absl::flat_hash_map<std::string, Value>> inputs) {
+  std::string result;
+  for (const absl::flat_hash_map<std::string, Value>& cycle : inputs) {
+    std::vector<std::string> port_names;
+    port_names.reserve(cycle.size());
+    for (const auto& [name, _] : cycle) {
+      port_names.push_back(name);
+    }
+    std::sort(port_names.begin(), port_names.end());
+    for (const std::string& name : port_names) {
+      absl::StrAppend(&result, name, "=", cycle.at(name).ToString(), ";");
+    }
+    absl::StrAppend(&result, "\n");
+  }
+  return result;
+}
+
+}  // namespace
+
+absl::StatusOr<std::vector<absl::flat_hash_map<std::string, Value>>>
+BlockEvaluationCache::EvaluateSequentialBlock(
+    const BlockEvaluator& evaluator, Block* block,
+    absl::Span<const absl::flat_hash_map<std::string, Value>> inputs) {
+  Key key{.block_ir = block->DumpIr(),
+          .stimulus = StimulusToString(inputs),
+          .evaluator = std::string(evaluator.name())};
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      ++stats_.hits;
+      lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+      return it->second.trace;
+    }
+    ++stats_.misses;
+  }
+
+  // Evaluate outside the lock; evaluation can be long-running and concurrent
+  // misses on distinct keys should not serialize.
+  XLS_ASSIGN_OR_RETURN(
+      std::vector<absl::flat_hash_map<std::string, Value>> trace,
+      evaluator.EvaluateSequentialBlock(block, inputs));
+
+  absl::MutexLock lock(&mutex_);
+  auto [it, inserted] = entries_.try_emplace(key);
+  if (!inserted) {
+    // Another thread raced us to this key; keep its entry.
+    return trace;
+  }
+  lru_.push_front(key);
+  it->second = Entry{.trace = trace, .lru_position = lru_.begin()};
+  while (static_cast<int64_t>(entries_.size()) > max_entries_) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+    ++stats_.evictions;
+  }
+  return trace;
+}
+
+BlockEvaluationCache::Stats BlockEvaluationCache::stats() const {
+  absl::MutexLock lock(&mutex_);
+  return stats_;
+}
+
+int64_t BlockEvaluationCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return static_cast<int64_t>(entries_.size());
+}
+
+}  // namespace xls
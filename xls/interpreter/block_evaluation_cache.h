@@ -0,0 +1,103 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_INTERPRETER_BLOCK_EVALUATION_CACHE_H_
+#define XLS_INTERPRETER_BLOCK_EVALUATION_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xls/interpreter/block_evaluator.h"
+#include "xls/ir/block.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+
+// A content-addressed cache of sequential block evaluation traces, for
+// harnesses (fuzzers, nightly codegen verification) which re-evaluate
+// identical (block, stimulus) pairs across revisions. Entries are keyed by
+// the block's IR text, the full stimulus, and the evaluator's name, so any
+// change to the block, the inputs, or the evaluator kind misses and
+// re-evaluates; unchanged pairs replay the recorded output trace. Eviction is
+// least-recently-used with a fixed entry budget.
+//
+// Thread-safe; concurrent lookups of the same missing key may both evaluate,
+// with one result retained.
+class BlockEvaluationCache {
+ public:
+  static constexpr int64_t kDefaultMaxEntries = 1024;
+
+  explicit BlockEvaluationCache(int64_t max_entries = kDefaultMaxEntries)
+      : max_entries_(max_entries) {}
+
+  // As BlockEvaluator::EvaluateSequentialBlock, but returns the cached output
+  // trace when this (block, stimulus, evaluator) triple has been evaluated
+  // before. Evaluation errors are returned without populating the cache.
+  absl::StatusOr<std::vector<absl::flat_hash_map<std::string, Value>>>
+  EvaluateSequentialBlock(
+      const BlockEvaluator& evaluator, Block* block,
+      absl::Span<const absl::flat_hash_map<std::string, Value>> inputs);
+
+  // Hit-rate statistics since construction.
+  struct Stats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+  };
+  Stats stats() const;
+
+  // Number of traces currently held.
+  int64_t size() const;
+
+ private:
+  struct Key {
+    std::string block_ir;
+    std::string stimulus;
+    std::string evaluator;
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.block_ir, key.stimulus,
+                        key.evaluator);
+    }
+    friend bool operator==(const Key& a, const Key& b) {
+      return a.block_ir == b.block_ir && a.stimulus == b.stimulus &&
+             a.evaluator == b.evaluator;
+    }
+  };
+
+  struct Entry {
+    std::vector<absl::flat_hash_map<std::string, Value>> trace;
+    // Position in lru_; the front is the most recently used.
+    std::list<Key>::iterator lru_position;
+  };
+
+  const int64_t max_entries_;
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<Key, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  std::list<Key> lru_ ABSL_GUARDED_BY(mutex_);
+  Stats stats_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace xls
+
+#endif  // XLS_INTERPRETER_BLOCK_EVALUATION_CACHE_H_
@@ -0,0 +1,148 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/block_evaluation_cache.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/matchers.h"
+#include "xls/interpreter/block_interpreter.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/block.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/package.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+class BlockEvaluationCacheTest : public IrTestBase {
+ public:
+  absl::StatusOr<Block*> AdderBlock(Package* p) {
+    BlockBuilder bb(TestName(), p);
+    BValue a = bb.InputPort("a", p->GetBitsType(32));
+    BValue b = bb.InputPort("b", p->GetBitsType(32));
+    bb.OutputPort("sum", bb.Add(a, b));
+    return bb.Build();
+  }
+
+  std::vector<absl::flat_hash_map<std::string, Value>> Stimulus(
+      uint64_t offset) {
+    std::vector<absl::flat_hash_map<std::string, Value>> inputs;
+    for (uint64_t i = 0; i < 4; ++i) {
+      inputs.push_back({{"a", Value(UBits(i + offset, 32))},
+                        {"b", Value(UBits(2 * i, 32))}});
+    }
+    return inputs;
+  }
+};
+
+TEST_F(BlockEvaluationCacheTest, RepeatedEvaluationHitsCache) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Block * block, AdderBlock(p.get()));
+
+  BlockEvaluationCache cache;
+  XLS_ASSERT_OK_AND_ASSIGN(auto trace,
+                           cache.EvaluateSequentialBlock(
+                               kInterpreterBlockEvaluator, block, Stimulus(1)));
+  ASSERT_EQ(trace.size(), 4);
+  EXPECT_EQ(trace[1].at("sum"), Value(UBits(4, 32)));
+  EXPECT_EQ(cache.stats().hits, 0);
+  EXPECT_EQ(cache.stats().misses, 1);
+
+  XLS_ASSERT_OK_AND_ASSIGN(auto replay,
+                           cache.EvaluateSequentialBlock(
+                               kInterpreterBlockEvaluator, block, Stimulus(1)));
+  EXPECT_EQ(replay, trace);
+  EXPECT_EQ(cache.stats().hits, 1);
+  EXPECT_EQ(cache.stats().misses, 1);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(BlockEvaluationCacheTest, DifferentStimulusOrBlockMisses) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Block * block, AdderBlock(p.get()));
+
+  BlockEvaluationCache cache;
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(1))
+                    .status());
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(2))
+                    .status());
+  EXPECT_EQ(cache.stats().misses, 2);
+
+  // A block with different contents misses even under identical stimulus.
+  BlockBuilder bb("subtractor", p.get());
+  BValue a = bb.InputPort("a", p->GetBitsType(32));
+  BValue b = bb.InputPort("b", p->GetBitsType(32));
+  bb.OutputPort("sum", bb.Subtract(a, b));
+  XLS_ASSERT_OK_AND_ASSIGN(Block * other, bb.Build());
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, other,
+                                             Stimulus(1))
+                    .status());
+  EXPECT_EQ(cache.stats().misses, 3);
+  EXPECT_EQ(cache.stats().hits, 0);
+}
+
+TEST_F(BlockEvaluationCacheTest, LeastRecentlyUsedEntryIsEvicted) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Block * block, AdderBlock(p.get()));
+
+  BlockEvaluationCache cache(/*max_entries=*/2);
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(1))
+                    .status());
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(2))
+                    .status());
+  // Touch stimulus 1 so stimulus 2 is the eviction candidate.
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(1))
+                    .status());
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(3))
+                    .status());
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_EQ(cache.stats().evictions, 1);
+
+  // Stimulus 1 is still cached; stimulus 2 was evicted.
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(1))
+                    .status());
+  EXPECT_EQ(cache.stats().hits, 2);
+  XLS_ASSERT_OK(cache
+                    .EvaluateSequentialBlock(kInterpreterBlockEvaluator, block,
+                                             Stimulus(2))
+                    .status());
+  EXPECT_EQ(cache.stats().hits, 2);
+  EXPECT_EQ(cache.stats().evictions, 2);
+}
+
+}  // namespace
+}  // namespace xls
@@ -182,28 +182,11 @@ absl::StatusOr<std::vector<absl::flat_hash_map<std::string, Value>>>
 BlockEvaluator::EvaluateSequentialBlock(
     Block* block,
     absl::Span<const absl::flat_hash_map<std::string, Value>> inputs) const {
-  XLS_ASSIGN_OR_RETURN(BlockElaboration elaboration,
-                       BlockElaboration::Elaborate(block));
-  // Initial register state is zero for all registers.
-  absl::flat_hash_map<std::string, Value> reg_state;
-  for (BlockInstance* inst : elaboration.instances()) {
-    if (!inst->block().has_value()) {
-      continue;
-    }
-    for (Register* reg : inst->block().value()->GetRegisters()) {
-      reg_state[absl::StrCat(inst->RegisterPrefix(), reg->name())] =
-          ZeroOfType(reg->type());
-    }
-  }
-
-  std::vector<absl::flat_hash_map<std::string, Value>> outputs;
-  for (const absl::flat_hash_map<std::string, Value>& input_set : inputs) {
-    XLS_ASSIGN_OR_RETURN(BlockRunResult result,
-                         EvaluateBlock(input_set, reg_state, elaboration));
-    outputs.push_back(std::move(result.outputs));
-    reg_state = std::move(result.reg_state);
-  }
-  return std::move(outputs);
+  // The continuation starts with zero values for all registers and carries
+  // the register state from cycle to cycle.
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<BlockContinuation> continuation,
+                       NewContinuation(block));
+  return continuation->RunCycles(inputs);
 }
 
 absl::StatusOr<std::vector<absl::flat_hash_map<std::string, uint64_t>>>
@@ -605,4 +588,16 @@ BlockEvaluator::NewContinuation(
       *this);
 }
 
+absl::StatusOr<std::vector<absl::flat_hash_map<std::string, Value>>>
+BlockContinuation::RunCycles(
+    absl::Span<const absl::flat_hash_map<std::string, Value>> inputs) {
+  std::vector<absl::flat_hash_map<std::string, Value>> outputs;
+  outputs.reserve(inputs.size());
+  for (const absl::flat_hash_map<std::string, Value>& input_set : inputs) {
+    XLS_RETURN_IF_ERROR(RunOneCycle(input_set));
+    outputs.push_back(output_ports());
+  }
+  return outputs;
+}
+
 }  // namespace xls
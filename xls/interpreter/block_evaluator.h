@@ -387,6 +387,12 @@ class BlockContinuation {
   // register state.
   virtual absl::Status RunOneCycle(
       const absl::flat_hash_map<std::string, Value>& inputs) = 0;
+  // Runs one cycle per element of `inputs`, carrying the register state from
+  // cycle to cycle, and returns the output-port values of each cycle.
+  // Evaluators may override this to amortize per-cycle setup across the whole
+  // batch. Afterwards the continuation reflects the final cycle.
+  virtual absl::StatusOr<std::vector<absl::flat_hash_map<std::string, Value>>>
+  RunCycles(absl::Span<const absl::flat_hash_map<std::string, Value>> inputs);
   // Update the registers to the give values.
   virtual absl::Status SetRegisters(
       const absl::flat_hash_map<std::string, Value>& regs) = 0;
@@ -1135,5 +1135,44 @@ TEST_P(BlockEvaluatorTest, DelaysContinuation) {
   }
 }
 
+TEST_P(BlockEvaluatorTest, RunCyclesWithRepeatedInputs) {
+  auto package = CreatePackage();
+  BlockBuilder b(TestName(), package.get());
+  XLS_ASSERT_OK(b.block()->AddClockPort("clk"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Register * reg,
+      b.block()->AddRegister("accum", package->GetBitsType(32)));
+
+  BValue x = b.InputPort("x", package->GetBitsType(32));
+  BValue en = b.InputPort("en", package->GetBitsType(1));
+  BValue accum = b.RegisterRead(reg);
+  b.RegisterWrite(reg, b.Add(x, accum), /*load_enable=*/en);
+  b.OutputPort("out", accum);
+  XLS_ASSERT_OK_AND_ASSIGN(Block * block, b.Build());
+
+  auto v32 = [](uint64_t v) { return Value(UBits(v, 32)); };
+  Value on = Value(UBits(1, 1));
+  Value off = Value(UBits(0, 1));
+  // The block is idle in the middle cycles: neither the inputs nor the
+  // register change, so evaluators which cache values between cycles must
+  // still produce each cycle's outputs.
+  std::vector<absl::flat_hash_map<std::string, Value>> inputs = {
+      {{"x", v32(5)}, {"en", on}},  {{"x", v32(5)}, {"en", off}},
+      {{"x", v32(5)}, {"en", off}}, {{"x", v32(5)}, {"en", off}},
+      {{"x", v32(7)}, {"en", on}},  {{"x", v32(7)}, {"en", on}},
+  };
+  XLS_ASSERT_OK_AND_ASSIGN(auto cont, evaluator().NewContinuation(block));
+  XLS_ASSERT_OK_AND_ASSIGN(auto outputs, cont->RunCycles(inputs));
+
+  ASSERT_EQ(outputs.size(), 6);
+  EXPECT_THAT(outputs.at(0), UnorderedElementsAre(Pair("out", v32(0))));
+  EXPECT_THAT(outputs.at(1), UnorderedElementsAre(Pair("out", v32(5))));
+  EXPECT_THAT(outputs.at(2), UnorderedElementsAre(Pair("out", v32(5))));
+  EXPECT_THAT(outputs.at(3), UnorderedElementsAre(Pair("out", v32(5))));
+  EXPECT_THAT(outputs.at(4), UnorderedElementsAre(Pair("out", v32(5))));
+  EXPECT_THAT(outputs.at(5), UnorderedElementsAre(Pair("out", v32(12))));
+  EXPECT_THAT(cont->registers(), UnorderedElementsAre(Pair("accum", v32(19))));
+}
+
 }  // namespace
 }  // namespace xls
@@ -14,6 +14,7 @@
 
 #include "xls/interpreter/block_interpreter.h"
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -39,8 +40,11 @@
 #include "xls/ir/events.h"
 #include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
 #include "xls/ir/register.h"
+#include "xls/ir/topo_sort.h"
 #include "xls/ir/value.h"
+#include "xls/passes/node_dependency_analysis.h"
 
 namespace xls {
 namespace {
@@ -59,6 +63,17 @@ class BlockInterpreter final : public IrInterpreter {
     NodeValuesMap().reserve(block->node_count());
   }
 
+  // Constructor which stores node values in an external map so they can be
+  // reused across cycles.
+  BlockInterpreter(absl::flat_hash_map<Node*, Value>* node_values,
+                   InterpreterEvents* events, std::string_view register_prefix,
+                   const absl::flat_hash_map<std::string, Value>& reg_state,
+                   absl::flat_hash_map<std::string, Value>& next_reg_state)
+      : IrInterpreter(node_values, events),
+        register_prefix_(register_prefix),
+        reg_state_(reg_state),
+        next_reg_state_(next_reg_state) {}
+
   // Ports and InstantiationInputs/Outputs are handled by the
   // ElaboratedBlockInterpreter.
 
@@ -565,6 +580,189 @@ class ElaboratedBlockInterpreter final : public ElaboratedBlockDfsVisitor {
   BlockInterpreter* current_interpreter_ = nullptr;
 };
 
+// Continuation for a block without instantiations which caches node values
+// from cycle to cycle. Each cycle re-evaluates only the side-effecting nodes
+// (which include all ports and register reads/writes) and the fanout cone of
+// the input ports and registers whose value changed since the previous cycle;
+// every other node reuses its cached value.
+class IncrementalBlockContinuation final : public BlockContinuation {
+ public:
+  IncrementalBlockContinuation(
+      BlockElaboration&& elaboration,
+      const absl::flat_hash_map<std::string, Value>& initial_registers)
+      : elaboration_(std::move(elaboration)),
+        block_(*elaboration_.top()->block()),
+        register_prefix_(elaboration_.top()->RegisterPrefix()),
+        topo_sort_(TopoSort(block_)),
+        dependency_analysis_(MakeDependencyAnalysis(block_)),
+        reg_state_(initial_registers) {
+    for (InputPort* port : block_->GetInputPorts()) {
+      input_port_names_.insert(port->GetName());
+    }
+  }
+
+  const absl::flat_hash_map<std::string, Value>& output_ports() final {
+    return outputs_;
+  }
+
+  const absl::flat_hash_map<std::string, Value>& registers() final {
+    return reg_state_;
+  }
+
+  const InterpreterEvents& events() final { return events_; }
+
+  absl::Status RunOneCycle(
+      const absl::flat_hash_map<std::string, Value>& inputs) final {
+    for (const auto& [name, value] : inputs) {
+      // Empty tuples don't have data
+      if (value.GetFlatBitCount() == 0) {
+        continue;
+      }
+      if (!input_port_names_.contains(name)) {
+        return absl::InvalidArgumentError(
+            absl::StrFormat("Block has no input port '%s'", name));
+      }
+    }
+
+    // On the first cycle every node is dirty; afterwards only the cones fed
+    // by the input ports and registers whose value changed are.
+    const bool first_cycle = node_values_.empty();
+    std::vector<DependencyBitmap> changed_cones;
+    if (!first_cycle) {
+      for (Node* node : topo_sort_) {
+        bool changed = false;
+        if (node->Is<InputPort>()) {
+          auto prev_iter = prev_inputs_.find(node->GetName());
+          auto input_iter = inputs.find(node->GetName());
+          changed = prev_iter == prev_inputs_.end() ||
+                    input_iter == inputs.end() ||
+                    prev_iter->second != input_iter->second;
+        } else if (node->Is<RegisterRead>()) {
+          changed = changed_registers_.contains(
+              absl::StrCat(register_prefix_,
+                           node->As<RegisterRead>()->GetRegister()->name()));
+        } else {
+          continue;
+        }
+        if (changed) {
+          XLS_ASSIGN_OR_RETURN(DependencyBitmap cone,
+                               dependency_analysis_.GetDependents(node));
+          changed_cones.push_back(cone);
+        }
+      }
+    }
+
+    events_ = InterpreterEvents();
+    next_reg_state_.clear();
+    BlockInterpreter visitor(&node_values_, &events_, register_prefix_,
+                             reg_state_, next_reg_state_);
+    for (Node* node : topo_sort_) {
+      bool dirty = first_cycle || OpIsSideEffecting(node->op());
+      for (const DependencyBitmap& cone : changed_cones) {
+        if (dirty) {
+          break;
+        }
+        XLS_ASSIGN_OR_RETURN(dirty, cone.IsDependent(node));
+      }
+      if (!dirty) {
+        continue;
+      }
+      node_values_.erase(node);
+      if (node->Is<InputPort>()) {
+        auto port_iter = inputs.find(node->GetName());
+        if (port_iter == inputs.end()) {
+          return absl::InvalidArgumentError(
+              absl::StrFormat("Missing input for port '%s'", node->GetName()));
+        }
+        XLS_RETURN_IF_ERROR(visitor.SetValueResult(node, port_iter->second));
+        continue;
+      }
+      if (node->Is<OutputPort>()) {
+        // Output ports have empty tuple types.
+        XLS_RETURN_IF_ERROR(visitor.SetValueResult(node, Value::Tuple({})));
+        continue;
+      }
+      XLS_RETURN_IF_ERROR(node->VisitSingleNode(&visitor));
+    }
+
+    outputs_.clear();
+    for (Node* port : block_->GetOutputPorts()) {
+      outputs_[port->GetName()] = visitor.ResolveAsValue(port->operand(0));
+    }
+
+    // Clock edge: latch the next register state and remember which registers
+    // changed so their readers are re-evaluated next cycle.
+    changed_registers_.clear();
+    for (auto& [name, value] : next_reg_state_) {
+      auto reg_iter = reg_state_.find(name);
+      if (reg_iter == reg_state_.end()) {
+        return absl::InvalidArgumentError(
+            absl::StrFormat("Missing value for register '%s'", name));
+      }
+      if (reg_iter->second != value) {
+        changed_registers_.insert(name);
+        reg_iter->second = std::move(value);
+      }
+    }
+
+    prev_inputs_ = inputs;
+    return absl::OkStatus();
+  }
+
+  absl::Status SetRegisters(
+      const absl::flat_hash_map<std::string, Value>& regs) final {
+    XLS_RET_CHECK_EQ(regs.size(), reg_state_.size());
+    for (const auto& [name, value] : regs) {
+      XLS_RET_CHECK(reg_state_.contains(name)) << name;
+      if (reg_state_.at(name) != value) {
+        changed_registers_.insert(name);
+      }
+    }
+    reg_state_ = regs;
+    return absl::OkStatus();
+  }
+
+ private:
+  static NodeDependencyAnalysis MakeDependencyAnalysis(Block* block) {
+    std::vector<Node*> sources;
+    for (Node* node : block->nodes()) {
+      if (node->Is<InputPort>() || node->Is<RegisterRead>()) {
+        sources.push_back(node);
+      }
+    }
+    return NodeDependencyAnalysis::ForwardDependents(block, sources);
+  }
+
+  BlockElaboration elaboration_;
+  Block* block_;
+  std::string register_prefix_;
+
+  // Nodes of the block in evaluation order.
+  std::vector<Node*> topo_sort_;
+
+  // Forward dependents of each input port and register read, used to find the
+  // cone of nodes whose value may change between cycles.
+  NodeDependencyAnalysis dependency_analysis_;
+
+  // Names of the block's input ports, for rejecting stray inputs.
+  absl::flat_hash_set<std::string> input_port_names_;
+
+  absl::flat_hash_map<std::string, Value> reg_state_;
+  absl::flat_hash_map<std::string, Value> next_reg_state_;
+  absl::flat_hash_map<std::string, Value> outputs_;
+
+  // Inputs of the previous cycle; empty before the first cycle.
+  absl::flat_hash_map<std::string, Value> prev_inputs_;
+
+  // Registers whose value changed on the last clock edge.
+  absl::flat_hash_set<std::string> changed_registers_;
+
+  // Cached values of all nodes from the previous cycle.
+  absl::flat_hash_map<Node*, Value> node_values_;
+
+  InterpreterEvents events_;
+};
+
 }  // namespace
 
 absl::StatusOr<BlockRunResult> BlockRun(
@@ -628,4 +826,18 @@ absl::StatusOr<BlockRunResult> BlockRun(
   return result;
 }
 
+absl::StatusOr<std::unique_ptr<BlockContinuation>>
+InterpreterBlockEvaluator::NewContinuation(
+    BlockElaboration&& elaboration,
+    const absl::flat_hash_map<std::string, Value>& initial_registers) const {
+  Block* top_block = *elaboration.top()->block();
+  if (top_block->GetInstantiations().empty()) {
+    return std::make_unique<IncrementalBlockContinuation>(
+        std::move(elaboration), initial_registers);
+  }
+  // Hierarchical blocks evaluate through the generic elaborated interpreter.
+  return BlockEvaluator::NewContinuation(std::move(elaboration),
+                                         initial_registers);
+}
+
 }  // namespace xls
@@ -16,6 +16,7 @@
 #define XLS_INTERPRETER_BLOCK_INTERPRETER_H_
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -48,6 +49,18 @@ class InterpreterBlockEvaluator final : public BlockEvaluator {
       const BlockElaboration& elaboration) const final {
     return BlockRun(inputs, registers, elaboration);
   }
+
+  using BlockEvaluator::NewContinuation;
+
+ protected:
+  // Returns a continuation which caches node values across cycles and only
+  // re-evaluates the fanout cone of the input ports and registers whose value
+  // changed since the previous cycle. Blocks with instantiations fall back to
+  // the generic continuation.
+  absl::StatusOr<std::unique_ptr<BlockContinuation>> NewContinuation(
+      BlockElaboration&& elaboration,
+      const absl::flat_hash_map<std::string, Value>& initial_registers)
+      const override;
 };
 
 // Runs the interpreter on a combinational block. `inputs` must contain a
@@ -22,15 +22,21 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/memory/memory.h"
+#include "absl/numeric/bits.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xls/common/metrics.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/interpreter/channel_queue_stats.pb.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/package.h"
 #include "xls/ir/proc_elaboration.h"
@@ -54,7 +60,7 @@ absl::Status ChannelQueue::AttachGenerator(GeneratorFn generator) {
   return absl::OkStatus();
 }
 
-absl::Status ChannelQueue::Write(const Value& value) {
+absl::Status ChannelQueue::Write(Value value) {
   VLOG(4) << absl::StreamFormat(
       "Writing value to channel instance `%s`: { %s }",
       channel_instance()->ToString(), value.ToString());
@@ -69,23 +75,26 @@ absl::Status ChannelQueue::Write(const Value& value) {
         channel()->name(), channel()->type()->ToString(), value.ToString()));
   }
 
-  WriteInternal(value);
+  bool was_empty = stats_enabled_ && GetSizeInternal() == 0;
+  WriteInternal(std::move(value));
+  RecordWrite(was_empty);
   VLOG(4) << absl::StreamFormat("Channel now has %d elements", queue_.size());
   return absl::OkStatus();
 }
 
-void ChannelQueue::WriteInternal(const Value& value) {
+void ChannelQueue::WriteInternal(Value value) {
+  XLS_METRICS_COUNTER_INC("channel_queue.writes");
   if (channel()->kind() == ChannelKind::kSingleValue) {
     if (queue_.empty()) {
-      queue_.push_back(value);
+      queue_.push_back(std::move(value));
     } else {
-      queue_.front() = value;
+      queue_.front() = std::move(value);
     }
     return;
   }
 
   CHECK_EQ(channel()->kind(), ChannelKind::kStreaming);
-  queue_.push_back(value);
+  queue_.push_back(std::move(value));
 }
 
 std::optional<Value> ChannelQueue::Read() {
@@ -95,10 +104,11 @@ std::optional<Value> ChannelQueue::Read() {
     // than directly returning the generated value, write then read it.
     std::optional<Value> generated_value = (*generator_)();
     if (generated_value.has_value()) {
-      WriteInternal(generated_value.value());
+      WriteInternal(*std::move(generated_value));
     }
   }
   std::optional<Value> value = ReadInternal();
+  RecordRead(/*read_value=*/value.has_value());
   VLOG(4) << absl::StreamFormat(
       "Reading data from channel instance %s: %s",
       channel_instance()->ToString(),
@@ -107,19 +117,163 @@ std::optional<Value> ChannelQueue::Read() {
   return value;
 }
 
+bool ChannelQueue::ReadInPlace(
+    absl::FunctionRef<bool(const Value&)> inspector) {
+  absl::MutexLock lock(&mutex_);
+  if (generator_.has_value()) {
+    // Materialize the front element so it can be inspected. Write/ReadInternal
+    // are virtual and may have other side-effects so write the generated value
+    // rather than inspecting it directly.
+    std::optional<Value> generated_value = (*generator_)();
+    if (generated_value.has_value()) {
+      WriteInternal(*std::move(generated_value));
+    }
+  }
+  const Value* front = PeekInternal();
+  if (front == nullptr) {
+    return false;
+  }
+  VLOG(4) << absl::StreamFormat("Inspecting front of channel instance %s: %s",
+                                channel_instance()->ToString(),
+                                front->ToString());
+  if (inspector(*front)) {
+    // Commit the dequeue; the moved-out value is discarded.
+    ReadInternal();
+    RecordRead(/*read_value=*/true);
+    VLOG(4) << absl::StreamFormat("Channel now has %d elements", queue_.size());
+  }
+  return true;
+}
+
+absl::Status ChannelQueue::WriteBatch(absl::Span<const Value> values) {
+  absl::MutexLock lock(&mutex_);
+  if (generator_.has_value()) {
+    return absl::InternalError(
+        "Cannot write to ChannelQueue because it has a generator function.");
+  }
+  for (const Value& value : values) {
+    if (!ValueConformsToType(value, channel()->type())) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Channel `%s` expects values to have type %s, got: %s",
+          channel()->name(), channel()->type()->ToString(), value.ToString()));
+    }
+  }
+  for (const Value& value : values) {
+    VLOG(4) << absl::StreamFormat(
+        "Writing value to channel instance `%s`: { %s }",
+        channel_instance()->ToString(), value.ToString());
+    bool was_empty = stats_enabled_ && GetSizeInternal() == 0;
+    WriteInternal(value);
+    RecordWrite(was_empty);
+  }
+  VLOG(4) << absl::StreamFormat("Channel now has %d elements", queue_.size());
+  return absl::OkStatus();
+}
+
+std::vector<Value> ChannelQueue::ReadBatch(int64_t max_count) {
+  absl::MutexLock lock(&mutex_);
+  std::vector<Value> values;
+  for (int64_t i = 0; i < max_count; ++i) {
+    if (generator_.has_value()) {
+      // Write/ReadInternal are virtual and may have other side-effects so
+      // rather than directly returning the generated value, write then read
+      // it.
+      std::optional<Value> generated_value = (*generator_)();
+      if (generated_value.has_value()) {
+        WriteInternal(*std::move(generated_value));
+      }
+    }
+    std::optional<Value> value = ReadInternal();
+    if (!value.has_value()) {
+      // Running out of elements while draining a batch is not counted as a
+      // blocked read.
+      break;
+    }
+    RecordRead(/*read_value=*/true);
+    values.push_back(*std::move(value));
+  }
+  VLOG(4) << absl::StreamFormat(
+      "Read %d values from channel instance %s; channel now has %d elements",
+      values.size(), channel_instance()->ToString(), queue_.size());
+  return values;
+}
+
+bool ChannelQueue::WaitForData(int64_t min_count, absl::Duration timeout) {
+  absl::MutexLock lock(&mutex_);
+  const auto has_data = [this, min_count]() ABSL_SHARED_LOCKS_REQUIRED(
+                            mutex_) { return GetSizeInternal() >= min_count; };
+  return mutex_.AwaitWithTimeout(absl::Condition(&has_data), timeout);
+}
+
+bool ChannelQueue::WaitForSpace(int64_t max_count, absl::Duration timeout) {
+  absl::MutexLock lock(&mutex_);
+  const auto has_space = [this, max_count]() ABSL_SHARED_LOCKS_REQUIRED(
+                             mutex_) { return GetSizeInternal() <= max_count; };
+  return mutex_.AwaitWithTimeout(absl::Condition(&has_space), timeout);
+}
+
 int64_t ChannelQueue::GetSizeInternal() const { return queue_.size(); }
 
 std::optional<Value> ChannelQueue::ReadInternal() {
   if (queue_.empty()) {
     return std::nullopt;
   }
-  Value value = queue_.front();
-  if (channel()->kind() != ChannelKind::kSingleValue) {
-    queue_.pop_front();
+  XLS_METRICS_COUNTER_INC("channel_queue.reads");
+  if (channel()->kind() == ChannelKind::kSingleValue) {
+    // The value persists on single-value channels so it must be copied out.
+    return queue_.front();
   }
+  Value value = std::move(queue_.front());
+  queue_.pop_front();
   return std::move(value);
 }
 
+const Value* ChannelQueue::PeekInternal() {
+  return queue_.empty() ? nullptr : &queue_.front();
+}
+
+void ChannelQueue::RecordWrite(bool was_empty) {
+  if (!stats_enabled_) {
+    return;
+  }
+  stats_.set_total_writes(stats_.total_writes() + 1);
+  if (was_empty) {
+    stats_.set_unblock_write_count(stats_.unblock_write_count() + 1);
+  }
+  RecordOccupancySample();
+}
+
+void ChannelQueue::RecordRead(bool read_value) {
+  if (!stats_enabled_) {
+    return;
+  }
+  if (!read_value) {
+    stats_.set_blocked_read_count(stats_.blocked_read_count() + 1);
+    return;
+  }
+  stats_.set_total_reads(stats_.total_reads() + 1);
+  RecordOccupancySample();
+}
+
+void ChannelQueue::RecordOccupancySample() {
+  int64_t size = GetSizeInternal();
+  stats_.set_high_water_mark(std::max(stats_.high_water_mark(), size));
+  // Bucket 0 holds occupancy zero; bucket i > 0 holds [2^(i-1), 2^i).
+  int64_t bucket =
+      size == 0 ? 0 : absl::bit_width(static_cast<uint64_t>(size));
+  while (stats_.occupancy_buckets_size() <= bucket) {
+    stats_.add_occupancy_buckets(0);
+  }
+  stats_.set_occupancy_buckets(bucket, stats_.occupancy_buckets(bucket) + 1);
+}
+
+ChannelQueueStatsProto ChannelQueue::GetStats() const {
+  absl::MutexLock lock(&mutex_);
+  ChannelQueueStatsProto stats = stats_;
+  stats.set_channel_name(channel_instance_->ToString());
+  return stats;
+}
+
 /* static */ absl::StatusOr<std::unique_ptr<ChannelQueueManager>>
 ChannelQueueManager::Create(Package* package) {
   XLS_ASSIGN_OR_RETURN(ProcElaboration elaboration,
@@ -212,4 +366,18 @@ absl::StatusOr<ChannelQueue*> ChannelQueueManager::GetQueueByName(
   return queues_.at(instance).get();
 }
 
+void ChannelQueueManager::EnableStatsCollection() {
+  for (ChannelQueue* queue : queue_vec_) {
+    queue->EnableStatsCollection();
+  }
+}
+
+ChannelQueueManagerStatsProto ChannelQueueManager::GetStats() const {
+  ChannelQueueManagerStatsProto stats;
+  for (ChannelQueue* queue : queue_vec_) {
+    *stats.add_queue_stats() = queue->GetStats();
+  }
+  return stats;
+}
+
 }  // namespace xls
@@ -26,10 +26,13 @@
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
+#include "xls/interpreter/channel_queue_stats.pb.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/package.h"
 #include "xls/ir/proc_elaboration.h"
@@ -69,27 +72,100 @@ class ChannelQueue {
   // Returns whether the channel queue is empty.
   bool IsEmpty() const { return GetSize() == 0; }
 
-  // Writes the given value on to the channel.
-  absl::Status Write(const Value& value);
+  // Writes the given value on to the channel. The value is taken by value so
+  // callers holding an expiring Value move it into the queue rather than
+  // deep-copying large payloads.
+  absl::Status Write(Value value);
 
   // Reads and returns a value from the channel. Returns an std::nullopt if
-  // the channel is empty.
+  // the channel is empty. The value is moved out of the queue.
   std::optional<Value> Read();
 
+  // Invokes `inspector` on the element at the front of the queue in place --
+  // without copying it out -- while holding the queue lock, then dequeues the
+  // element if `inspector` returns true. A generator, if attached, is
+  // consulted to materialize the front element. Returns false (without
+  // invoking `inspector`) if the queue is empty or the queue implementation
+  // does not store Value elements (e.g. the JIT byte queues); callers must
+  // then fall back to Read().
+  bool ReadInPlace(absl::FunctionRef<bool(const Value&)> inspector);
+
+  // Writes each value in `values` on to the channel in order. The queue lock
+  // is acquired once for the entire batch. All values are validated before
+  // any is written, so on error nothing is enqueued.
+  absl::Status WriteBatch(absl::Span<const Value> values);
+
+  // Reads and returns up to `max_count` values from the channel in order. The
+  // queue lock is acquired once for the entire batch. Fewer values (possibly
+  // none) are returned if the channel empties first. As with repeated calls
+  // to `Read`, single-value channels return the current value `max_count`
+  // times.
+  std::vector<Value> ReadBatch(int64_t max_count);
+
+  // Blocks until the queue holds at least `min_count` elements, or until
+  // `timeout` expires. Returns true if the watermark was reached. Queues with
+  // an attached generator materialize values only when read, so the watermark
+  // cannot be reached through a generator.
+  bool WaitForData(int64_t min_count,
+                   absl::Duration timeout = absl::InfiniteDuration());
+
+  // Blocks until the queue has drained to at most `max_count` elements, or
+  // until `timeout` expires. Returns true if the watermark was reached. The
+  // queue itself is unbounded; this is the producer-side watermark for pacing
+  // writers against a slow consumer.
+  bool WaitForSpace(int64_t max_count,
+                    absl::Duration timeout = absl::InfiniteDuration());
+
   // Attaches a function which generates values for the channel. The generator
   // is called when a value is needed for reading. If a generator is attached
   // then calling `Write` returns an error.
   using GeneratorFn = std::function<std::optional<Value>()>;
   absl::Status AttachGenerator(GeneratorFn generator);
 
+  // Returns whether a generator is attached to this queue. A queue with a
+  // generator may report empty and still produce a value on a later read, so
+  // callers must not treat an empty generator-backed queue as permanently
+  // blocked.
+  bool has_generator() const {
+    absl::MutexLock lock(&mutex_);
+    return generator_.has_value();
+  }
+
+  // Enables collection of occupancy and blocking statistics on this queue.
+  // Collection is off by default because it adds work to every read and
+  // write.
+  void EnableStatsCollection() {
+    absl::MutexLock lock(&mutex_);
+    stats_enabled_ = true;
+  }
+
+  // Returns the statistics collected since stats collection was enabled. All
+  // fields other than the channel name are zero if collection was never
+  // enabled.
+  ChannelQueueStatsProto GetStats() const;
+
  protected:
   mutable absl::Mutex mutex_;
 
   virtual int64_t GetSizeInternal() const ABSL_SHARED_LOCKS_REQUIRED(mutex_);
-  virtual void WriteInternal(const Value& value)
-      ABSL_SHARED_LOCKS_REQUIRED(mutex_);
+  virtual void WriteInternal(Value value) ABSL_SHARED_LOCKS_REQUIRED(mutex_);
   virtual std::optional<Value> ReadInternal()
       ABSL_SHARED_LOCKS_REQUIRED(mutex_);
+  // Returns a pointer to the element at the front of the queue, or nullptr if
+  // the queue is empty. Implementations which do not store Value elements
+  // return nullptr unconditionally, which makes ReadInPlace report
+  // no-value-available. The pointer is only valid while mutex_ is held.
+  virtual const Value* PeekInternal() ABSL_SHARED_LOCKS_REQUIRED(mutex_);
+
+  // Statistics hooks called after the respective operation completes while
+  // holding mutex_. No-ops unless stats collection is enabled. `was_empty` is
+  // whether the queue was empty before the write; `read_value` is whether the
+  // read produced a value.
+  void RecordWrite(bool was_empty) ABSL_SHARED_LOCKS_REQUIRED(mutex_);
+  void RecordRead(bool read_value) ABSL_SHARED_LOCKS_REQUIRED(mutex_);
+  // Records the current occupancy in the histogram and high-water mark.
+  void RecordOccupancySample() ABSL_SHARED_LOCKS_REQUIRED(mutex_);
+
   ChannelInstance* channel_instance_;
 
   std::deque<Value> queue_ ABSL_GUARDED_BY(mutex_);
@@ -97,6 +173,11 @@ class ChannelQueue {
   // TODO(meheff): 2022/09/27 Fix this, potentially by obviating the need for
   // the thread-unsafe version of the queue.
   std::optional<GeneratorFn> generator_ ABSL_GUARDED_BY_FIXME(mutex_);
+
+  // Occupancy and blocking statistics, accumulated only while enabled. The
+  // channel name field is filled in lazily by GetStats.
+  bool stats_enabled_ ABSL_GUARDED_BY(mutex_) = false;
+  ChannelQueueStatsProto stats_ ABSL_GUARDED_BY(mutex_);
 };
 
 // A functor which returns a sequence of Values when called. Maybe be attached
@@ -157,6 +238,13 @@ class ChannelQueueManager {
   absl::StatusOr<ChannelQueue*> GetQueueById(int64_t channel_id);
   absl::StatusOr<ChannelQueue*> GetQueueByName(std::string_view name);
 
+  // Enables statistics collection on every queue. See
+  // ChannelQueue::EnableStatsCollection.
+  void EnableStatsCollection();
+
+  // Returns the statistics collected by every queue, sorted by channel ID.
+  ChannelQueueManagerStatsProto GetStats() const;
+
   const ProcElaboration& elaboration() const { return elaboration_; }
   Package* package() const { return elaboration_.package(); }
 
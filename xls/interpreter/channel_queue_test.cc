@@ -15,6 +15,7 @@
 #include "xls/interpreter/channel_queue.h"
 
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -25,11 +26,14 @@
 #include "absl/types/span.h"
 #include "xls/common/status/matchers.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/interpreter/channel_queue_stats.pb.h"
 #include "xls/interpreter/channel_queue_test_base.h"
+#include "xls/ir/bits.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/channel_ops.h"
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/package.h"
+#include "xls/ir/value.h"
 
 namespace xls {
 namespace {
@@ -129,6 +133,49 @@ TEST_F(ChannelQueueManagerTest, ChannelQueueManagerCustomQueues) {
             channel_c);
 }
 
+TEST_F(ChannelQueueManagerTest, QueueStatsCollection) {
+  Package package(TestName());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * channel,
+      package.CreateStreamingChannel("a", ChannelOps::kReceiveOnly,
+                                     package.GetBitsType(32)));
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<ChannelQueueManager> manager,
+                           ChannelQueueManager::Create(&package));
+  ChannelQueue& queue = manager->GetQueue(channel);
+
+  // Operations before collection is enabled are not counted.
+  XLS_ASSERT_OK(queue.Write(Value(UBits(0, 32))));
+  EXPECT_EQ(queue.Read(), Value(UBits(0, 32)));
+
+  manager->EnableStatsCollection();
+
+  // A read on an empty queue counts as a blocked read.
+  EXPECT_EQ(queue.Read(), std::nullopt);
+  XLS_ASSERT_OK(queue.Write(Value(UBits(1, 32))));
+  XLS_ASSERT_OK(queue.Write(Value(UBits(2, 32))));
+  XLS_ASSERT_OK(queue.Write(Value(UBits(3, 32))));
+  EXPECT_EQ(queue.Read(), Value(UBits(1, 32)));
+
+  ChannelQueueStatsProto stats = queue.GetStats();
+  EXPECT_EQ(stats.channel_name(), "a");
+  EXPECT_EQ(stats.total_writes(), 3);
+  EXPECT_EQ(stats.total_reads(), 1);
+  EXPECT_EQ(stats.high_water_mark(), 3);
+  EXPECT_EQ(stats.blocked_read_count(), 1);
+  EXPECT_EQ(stats.unblock_write_count(), 1);
+  // Occupancy samples are 1, 2, 3 (after each write) and 2 (after the read).
+  // Bucket 1 holds occupancy 1; bucket 2 holds occupancies in [2, 4).
+  ASSERT_EQ(stats.occupancy_buckets_size(), 3);
+  EXPECT_EQ(stats.occupancy_buckets(0), 0);
+  EXPECT_EQ(stats.occupancy_buckets(1), 1);
+  EXPECT_EQ(stats.occupancy_buckets(2), 3);
+
+  ChannelQueueManagerStatsProto manager_stats = manager->GetStats();
+  ASSERT_EQ(manager_stats.queue_stats_size(), 1);
+  EXPECT_EQ(manager_stats.queue_stats(0).channel_name(), "a");
+  EXPECT_EQ(manager_stats.queue_stats(0).total_writes(), 3);
+}
+
 TEST_F(ChannelQueueManagerTest, ChannelQueueManagerErrorConditions) {
   Package package(TestName());
   XLS_ASSERT_OK_AND_ASSIGN(
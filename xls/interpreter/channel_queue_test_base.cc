@@ -21,7 +21,9 @@
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/time/time.h"
 #include "xls/common/status/matchers.h"
+#include "xls/common/thread.h"
 #include "xls/interpreter/channel_queue.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/channel.h"
@@ -33,6 +35,7 @@ namespace xls {
 namespace {
 
 using status_testing::StatusIs;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
 using ::testing::Optional;
 
@@ -70,6 +73,46 @@ TEST_P(ChannelQueueTestBase, FifoChannelQueueTest) {
   EXPECT_EQ(queue->Read(), std::nullopt);
 }
 
+TEST_P(ChannelQueueTestBase, ReadInPlace) {
+  Package package(TestName());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * channel,
+      package.CreateStreamingChannel("my_channel", ChannelOps::kSendReceive,
+                                     package.GetBitsType(32)));
+  XLS_ASSERT_OK_AND_ASSIGN(ProcElaboration elaboration,
+                           ProcElaboration::ElaborateOldStylePackage(&package));
+  auto queue =
+      GetParam().CreateQueue(elaboration.GetUniqueInstance(channel).value());
+
+  // An empty queue has nothing to inspect.
+  EXPECT_FALSE(queue->ReadInPlace([](const Value&) { return true; }));
+
+  XLS_ASSERT_OK(queue->Write(Value(UBits(42, 32))));
+  XLS_ASSERT_OK(queue->Write(Value(UBits(123, 32))));
+
+  bool inspected = queue->ReadInPlace([](const Value& value) {
+    EXPECT_EQ(value, Value(UBits(42, 32)));
+    // Decline the dequeue; the element stays at the front.
+    return false;
+  });
+  if (inspected) {
+    EXPECT_EQ(queue->GetSize(), 2);
+    // Inspect again and commit the dequeue this time.
+    EXPECT_TRUE(queue->ReadInPlace([](const Value& value) {
+      EXPECT_EQ(value, Value(UBits(42, 32)));
+      return true;
+    }));
+    EXPECT_EQ(queue->GetSize(), 1);
+  } else {
+    // Queue implementations which do not store Value elements report no value
+    // available; callers fall back to Read.
+    EXPECT_THAT(queue->Read(), Optional(Value(UBits(42, 32))));
+  }
+
+  EXPECT_THAT(queue->Read(), Optional(Value(UBits(123, 32))));
+  EXPECT_TRUE(queue->IsEmpty());
+}
+
 TEST_P(ChannelQueueTestBase, SingleValueChannelQueueTest) {
   Package package(TestName());
   XLS_ASSERT_OK_AND_ASSIGN(
@@ -125,6 +168,67 @@ TEST_P(ChannelQueueTestBase, ErrorConditions) {
                                  "type bits[1], got: bits[123]:0x2c")));
 }
 
+TEST_P(ChannelQueueTestBase, BatchReadWrite) {
+  Package package(TestName());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * channel,
+      package.CreateStreamingChannel("my_channel", ChannelOps::kSendReceive,
+                                     package.GetBitsType(32)));
+  XLS_ASSERT_OK_AND_ASSIGN(ProcElaboration elaboration,
+                           ProcElaboration::ElaborateOldStylePackage(&package));
+  auto queue =
+      GetParam().CreateQueue(elaboration.GetUniqueInstance(channel).value());
+
+  EXPECT_TRUE(queue->ReadBatch(10).empty());
+
+  XLS_ASSERT_OK(queue->WriteBatch(
+      {Value(UBits(1, 32)), Value(UBits(2, 32)), Value(UBits(3, 32))}));
+  EXPECT_EQ(queue->GetSize(), 3);
+
+  EXPECT_THAT(queue->ReadBatch(2),
+              ElementsAre(Value(UBits(1, 32)), Value(UBits(2, 32))));
+  EXPECT_EQ(queue->GetSize(), 1);
+
+  // Reading more values than the queue holds drains the queue.
+  EXPECT_THAT(queue->ReadBatch(10), ElementsAre(Value(UBits(3, 32))));
+  EXPECT_TRUE(queue->IsEmpty());
+
+  // A batch write with an ill-typed value writes nothing.
+  EXPECT_THAT(queue->WriteBatch({Value(UBits(1, 32)), Value(UBits(44, 123))}),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("expects values to have type bits[32]")));
+  EXPECT_TRUE(queue->IsEmpty());
+}
+
+TEST_P(ChannelQueueTestBase, Watermarks) {
+  Package package(TestName());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * channel,
+      package.CreateStreamingChannel("my_channel", ChannelOps::kSendReceive,
+                                     package.GetBitsType(32)));
+  XLS_ASSERT_OK_AND_ASSIGN(ProcElaboration elaboration,
+                           ProcElaboration::ElaborateOldStylePackage(&package));
+  auto queue =
+      GetParam().CreateQueue(elaboration.GetUniqueInstance(channel).value());
+
+  // An empty queue has space but no data.
+  EXPECT_TRUE(queue->WaitForSpace(0, absl::Milliseconds(5)));
+  EXPECT_FALSE(queue->WaitForData(1, absl::Milliseconds(5)));
+
+  XLS_ASSERT_OK(queue->WriteBatch({Value(UBits(1, 32)), Value(UBits(2, 32))}));
+  EXPECT_TRUE(queue->WaitForData(2, absl::Milliseconds(5)));
+  EXPECT_FALSE(queue->WaitForSpace(1, absl::Milliseconds(5)));
+
+  // A consumer thread draining the queue unblocks the producer-side wait.
+  Thread consumer([&queue]() {
+    queue->WaitForData(2);
+    queue->ReadBatch(2);
+  });
+  EXPECT_TRUE(queue->WaitForSpace(0));
+  consumer.Join();
+  EXPECT_TRUE(queue->IsEmpty());
+}
+
 TEST_P(ChannelQueueTestBase, IotaGenerator) {
   Package package(TestName());
   XLS_ASSERT_OK_AND_ASSIGN(
@@ -0,0 +1,42 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/evaluation_plan.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/topo_sort.h"
+
+namespace xls {
+
+/* static */ std::unique_ptr<EvaluationPlan> EvaluationPlan::Create(
+    FunctionBase* function_base) {
+  std::unique_ptr<EvaluationPlan> plan(new EvaluationPlan(function_base));
+  plan->nodes_ = TopoSort(function_base);
+  int64_t max_id = 0;
+  for (Node* node : plan->nodes_) {
+    max_id = std::max(max_id, node->id());
+  }
+  plan->slot_of_id_.assign(max_id + 1, -1);
+  for (int64_t i = 0; i < static_cast<int64_t>(plan->nodes_.size()); ++i) {
+    plan->slot_of_id_[plan->nodes_[i]->id()] = static_cast<int32_t>(i);
+  }
+  return plan;
+}
+
+}  // namespace xls
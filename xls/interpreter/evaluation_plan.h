@@ -0,0 +1,65 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_INTERPRETER_EVALUATION_PLAN_H_
+#define XLS_INTERPRETER_EVALUATION_PLAN_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+
+namespace xls {
+
+// A pre-compiled evaluation order for a FunctionBase.
+//
+// The plan records the topological order of the nodes once and assigns each
+// node a dense slot number (its position in that order). Interpreter runs
+// driven by a plan store node values in a flat array indexed by slot instead
+// of a hash map keyed by Node*, so each run is a single pass over the node
+// array with constant-time operand lookups. A plan only reads the IR and can
+// be reused across any number of runs (including concurrent ones), but must
+// be recreated if the FunctionBase is modified.
+class EvaluationPlan {
+ public:
+  static std::unique_ptr<EvaluationPlan> Create(FunctionBase* function_base);
+
+  FunctionBase* function_base() const { return function_base_; }
+
+  // The nodes of the FunctionBase in evaluation (topological) order.
+  absl::Span<Node* const> nodes() const { return nodes_; }
+
+  // The number of value slots an evaluation over this plan requires.
+  int64_t size() const { return static_cast<int64_t>(nodes_.size()); }
+
+  // Returns the flat value-array slot of `node`, which is its position in
+  // `nodes()`. `node` must belong to the plan's FunctionBase.
+  int64_t slot(Node* node) const { return slot_of_id_[node->id()]; }
+
+ private:
+  explicit EvaluationPlan(FunctionBase* function_base)
+      : function_base_(function_base) {}
+
+  FunctionBase* function_base_;
+  std::vector<Node*> nodes_;
+  // Slot of each node, indexed by node id.
+  std::vector<int32_t> slot_of_id_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_INTERPRETER_EVALUATION_PLAN_H_
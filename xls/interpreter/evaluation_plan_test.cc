@@ -0,0 +1,79 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/evaluation_plan.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "xls/common/status/matchers.h"
+#include "xls/interpreter/function_interpreter.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/events.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+class EvaluationPlanTest : public IrTestBase {};
+
+TEST_F(EvaluationPlanTest, SlotsFollowTopologicalOrder) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  fb.Add(fb.Add(x, y), fb.Not(x));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  std::unique_ptr<EvaluationPlan> plan = EvaluationPlan::Create(f);
+  EXPECT_EQ(plan->function_base(), f);
+  ASSERT_EQ(plan->size(), f->node_count());
+  for (int64_t i = 0; i < plan->size(); ++i) {
+    Node* node = plan->nodes()[i];
+    EXPECT_EQ(plan->slot(node), i);
+    // Operands are evaluated before their users.
+    for (Node* operand : node->operands()) {
+      EXPECT_LT(plan->slot(operand), i);
+    }
+  }
+}
+
+TEST_F(EvaluationPlanTest, PlanIsReusableAcrossRuns) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  fb.Add(x, y);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  std::unique_ptr<EvaluationPlan> plan = EvaluationPlan::Create(f);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      InterpreterResult<Value> first,
+      InterpretFunctionWithPlan(
+          *plan, {Value(UBits(1, 32)), Value(UBits(2, 32))}));
+  EXPECT_EQ(first.value, Value(UBits(3, 32)));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      InterpreterResult<Value> second,
+      InterpretFunctionWithPlan(
+          *plan, {Value(UBits(40, 32)), Value(UBits(2, 32))}));
+  EXPECT_EQ(second.value, Value(UBits(42, 32)));
+}
+
+}  // namespace
+}  // namespace xls
@@ -15,6 +15,7 @@
 #include "xls/interpreter/function_interpreter.h"
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -26,9 +27,11 @@
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/interpreter/evaluation_plan.h"
 #include "xls/interpreter/ir_interpreter.h"
 #include "xls/ir/events.h"
 #include "xls/ir/keyword_args.h"
+#include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/value.h"
 
@@ -38,8 +41,9 @@ namespace {
 // An interpreter for XLS functions.
 class FunctionInterpreter final : public IrInterpreter {
  public:
-  explicit FunctionInterpreter(absl::Span<const Value> args)
-      : args_(args.begin(), args.end()) {}
+  FunctionInterpreter(const EvaluationPlan* plan, absl::Span<Value> slots,
+                      absl::Span<const Value> args)
+      : IrInterpreter(plan, slots), args_(args.begin(), args.end()) {}
 
   absl::Status HandleParam(Param* param) override {
     XLS_ASSIGN_OR_RETURN(int64_t index,
@@ -61,6 +65,13 @@ class FunctionInterpreter final : public IrInterpreter {
 
 absl::StatusOr<InterpreterResult<Value>> InterpretFunction(
     Function* function, absl::Span<const Value> args) {
+  std::unique_ptr<EvaluationPlan> plan = EvaluationPlan::Create(function);
+  return InterpretFunctionWithPlan(*plan, args);
+}
+
+absl::StatusOr<InterpreterResult<Value>> InterpretFunctionWithPlan(
+    const EvaluationPlan& plan, absl::Span<const Value> args) {
+  Function* function = plan.function_base()->AsFunctionOrDie();
   VLOG(3) << "Interpreting function " << function->name();
   if (args.size() != function->params().size()) {
     return absl::InvalidArgumentError(absl::StrFormat(
@@ -78,8 +89,15 @@ absl::StatusOr<InterpreterResult<Value>> InterpretFunction(
           value.ToString(), argno, param_type->ToString()));
     }
   }
-  FunctionInterpreter visitor(args);
-  XLS_RETURN_IF_ERROR(function->Accept(&visitor));
+  // The value slots are allocated per call rather than kept in thread-local
+  // scratch storage: interpretation can re-enter (invoke, map and counted_for
+  // bodies are themselves interpreted), so a single per-thread array could be
+  // clobbered while an outer run is still using it.
+  std::vector<Value> slots(plan.size());
+  FunctionInterpreter visitor(&plan, absl::MakeSpan(slots), args);
+  for (Node* node : plan.nodes()) {
+    XLS_RETURN_IF_ERROR(node->VisitSingleNode(&visitor));
+  }
   Value result = visitor.ResolveAsValue(function->return_value());
   VLOG(2) << "Result = " << result;
   InterpreterEvents events = visitor.GetInterpreterEvents();
@@ -21,6 +21,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "xls/interpreter/evaluation_plan.h"
 #include "xls/interpreter/ir_interpreter.h"
 #include "xls/ir/function.h"
 #include "xls/ir/value.h"
@@ -33,6 +34,14 @@ namespace xls {
 absl::StatusOr<InterpreterResult<Value>> InterpretFunction(
     Function* function, absl::Span<const Value> args);
 
+// As InterpretFunction, but driven by a pre-compiled evaluation plan (which
+// must have been created for a Function). Callers which interpret the same
+// function many times should create the plan once and use this entry point;
+// it avoids the per-run topological sort and stores node values in a flat
+// array instead of a hash map.
+absl::StatusOr<InterpreterResult<Value>> InterpretFunctionWithPlan(
+    const EvaluationPlan& plan, absl::Span<const Value> args);
+
 // Runs the interpreter on the function where the arguments are given by name.
 // Returns both the result alue and any events that happened while running.
 absl::StatusOr<InterpreterResult<Value>> InterpretFunctionKwargs(
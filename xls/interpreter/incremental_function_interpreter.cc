@@ -0,0 +1,134 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/incremental_function_interpreter.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/interpreter/ir_interpreter.h"
+#include "xls/ir/events.h"
+#include "xls/ir/function.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
+#include "xls/ir/package.h"
+#include "xls/ir/topo_sort.h"
+#include "xls/ir/type.h"
+#include "xls/ir/value.h"
+#include "xls/passes/node_dependency_analysis.h"
+
+namespace xls {
+namespace {
+
+// Returns true if the given node must be re-evaluated on every call even when
+// its operands are unchanged: side-effecting nodes contribute to the
+// interpreter events of each run, and nodes which invoke other functions may
+// transitively contain side-effecting nodes.
+bool MustReevaluate(Node* node) {
+  if (OpIsSideEffecting(node->op())) {
+    return true;
+  }
+  switch (node->op()) {
+    case Op::kInvoke:
+    case Op::kMap:
+    case Op::kCountedFor:
+    case Op::kDynamicCountedFor:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+IncrementalFunctionInterpreter::IncrementalFunctionInterpreter(
+    Function* function)
+    : function_(function),
+      dependency_analysis_(NodeDependencyAnalysis::ForwardDependents(
+          function, std::vector<Node*>(function->params().begin(),
+                                       function->params().end()))),
+      topo_sort_(TopoSort(function)) {}
+
+absl::StatusOr<InterpreterResult<Value>> IncrementalFunctionInterpreter::Run(
+    absl::Span<const Value> args) {
+  if (args.size() != function_->params().size()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Function %s wants %d arguments, got %d.", function_->name(),
+        function_->params().size(), args.size()));
+  }
+  for (int64_t argno = 0; argno < static_cast<int64_t>(args.size()); ++argno) {
+    Param* param = function_->param(argno);
+    const Value& value = args[argno];
+    Type* param_type = param->GetType();
+    Type* value_type = function_->package()->GetTypeForValue(value);
+    if (value_type != param_type) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Got argument %s for parameter %d which is not of type %s",
+          value.ToString(), argno, param_type->ToString()));
+    }
+  }
+
+  // On the first call every node is dirty; afterwards only the cones fed by
+  // parameters whose argument changed since the previous call are.
+  const bool first_run = node_values_.empty();
+  std::vector<DependencyBitmap> changed_cones;
+  if (!first_run) {
+    for (int64_t argno = 0; argno < static_cast<int64_t>(args.size());
+         ++argno) {
+      if (args[argno] == prev_args_[argno]) {
+        continue;
+      }
+      XLS_ASSIGN_OR_RETURN(
+          DependencyBitmap cone,
+          dependency_analysis_.GetDependents(function_->param(argno)));
+      changed_cones.push_back(cone);
+    }
+  }
+
+  InterpreterEvents events;
+  IrInterpreter visitor(&node_values_, &events);
+  for (Node* node : topo_sort_) {
+    bool dirty = first_run || MustReevaluate(node);
+    for (const DependencyBitmap& cone : changed_cones) {
+      if (dirty) {
+        break;
+      }
+      XLS_ASSIGN_OR_RETURN(dirty, cone.IsDependent(node));
+    }
+    if (!dirty) {
+      continue;
+    }
+    node_values_.erase(node);
+    if (node->Is<Param>()) {
+      XLS_ASSIGN_OR_RETURN(int64_t index,
+                           function_->GetParamIndex(node->As<Param>()));
+      XLS_RETURN_IF_ERROR(visitor.SetValueResult(node, args[index]));
+      continue;
+    }
+    XLS_RETURN_IF_ERROR(node->VisitSingleNode(&visitor));
+  }
+
+  prev_args_.assign(args.begin(), args.end());
+  return InterpreterResult<Value>{node_values_.at(function_->return_value()),
+                                  std::move(events)};
+}
+
+}  // namespace xls
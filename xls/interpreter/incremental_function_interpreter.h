@@ -0,0 +1,70 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_INTERPRETER_INCREMENTAL_FUNCTION_INTERPRETER_H_
+#define XLS_INTERPRETER_INCREMENTAL_FUNCTION_INTERPRETER_H_
+
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/ir/events.h"
+#include "xls/ir/function.h"
+#include "xls/ir/node.h"
+#include "xls/ir/value.h"
+#include "xls/passes/node_dependency_analysis.h"
+
+namespace xls {
+
+// Interpreter for evaluating a single function over many argument samples
+// where successive samples differ in only a few parameters (e.g. fuzzing or
+// parameter sweeps). Node values from the previous evaluation are cached, and
+// each call only re-evaluates the cone of nodes fed by the parameters whose
+// argument actually changed; every other node reuses its cached `Value`.
+//
+// Side-effecting nodes (asserts, traces, covers) and nodes which invoke other
+// functions are always re-evaluated so the returned `InterpreterEvents`
+// reflect a complete run.
+//
+// The function must not be modified between calls to `Run`.
+class IncrementalFunctionInterpreter {
+ public:
+  explicit IncrementalFunctionInterpreter(Function* function);
+
+  // Evaluates the function with the given arguments, reusing cached values
+  // for nodes outside the dirty cone of the changed arguments. The first call
+  // evaluates every node.
+  absl::StatusOr<InterpreterResult<Value>> Run(absl::Span<const Value> args);
+
+ private:
+  Function* function_;
+
+  // Forward dependents of each parameter, used to find the cone of nodes
+  // whose value may change when an argument changes.
+  NodeDependencyAnalysis dependency_analysis_;
+
+  // Nodes of the function in evaluation order.
+  std::vector<Node*> topo_sort_;
+
+  // Arguments of the previous `Run` call; empty before the first call.
+  std::vector<Value> prev_args_;
+
+  // Cached values of all nodes from the previous `Run` call.
+  absl::flat_hash_map<Node*, Value> node_values_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_INTERPRETER_INCREMENTAL_FUNCTION_INTERPRETER_H_
@@ -57,6 +57,43 @@ uint64_t BitsToBoundedUint64(const Bits& bits, uint64_t upper_limit) {
   return bits.ToUint64().value();
 }
 
+// The handlers for the common arithmetic and logic ops below have an unboxed
+// fast path: when the node and all of its operands fit in a single 64-bit
+// word, the op is evaluated directly on uint64_t values and only the final
+// result is boxed into a Value. The generic Bits paths remain as the fallback
+// for wide values.
+
+// Returns true if `node` and all of its operands are bits-typed values of at
+// most 64 bits, i.e. candidates for the unboxed fast path.
+bool NodeFitsInUint64(Node* node) {
+  auto is_narrow = [](Node* n) {
+    return n->GetType()->IsBits() && n->BitCountOrDie() <= 64;
+  };
+  if (!is_narrow(node)) {
+    return false;
+  }
+  for (Node* operand : node->operands()) {
+    if (!is_narrow(operand)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Masks `value` to its low `width` bits. `width` must be in [0, 64].
+uint64_t MaskToWidth(uint64_t value, int64_t width) {
+  return width == 64 ? value : value & ((uint64_t{1} << width) - 1);
+}
+
+// Interprets `value`, a `width`-bit value, as a sign-extended int64_t.
+int64_t AsSigned(uint64_t value, int64_t width) {
+  if (width == 0) {
+    return 0;
+  }
+  uint64_t sign_bit = uint64_t{1} << (width - 1);
+  return static_cast<int64_t>((value ^ sign_bit) - sign_bit);
+}
+
 }  // namespace
 
 absl::StatusOr<Value> InterpretNode(Node* node,
@@ -97,6 +134,12 @@ absl::Status IrInterpreter::AddInterpreterEvents(
 }
 
 absl::Status IrInterpreter::HandleAdd(BinOp* add) {
+  if (NodeFitsInUint64(add)) {
+    return SetUint64Result(
+        add, MaskToWidth(ResolveAsUint64(add->operand(0)) +
+                             ResolveAsUint64(add->operand(1)),
+                         add->BitCountOrDie()));
+  }
   return SetBitsResult(add, bits_ops::Add(ResolveAsBits(add->operand(0)),
                                           ResolveAsBits(add->operand(1))));
 }
@@ -117,30 +160,70 @@ absl::Status IrInterpreter::HandleXorReduce(BitwiseReductionOp* xor_reduce) {
 }
 
 absl::Status IrInterpreter::HandleNaryAnd(NaryOp* and_op) {
+  if (NodeFitsInUint64(and_op)) {
+    uint64_t accum = ~uint64_t{0};
+    for (Node* operand : and_op->operands()) {
+      accum &= ResolveAsUint64(operand);
+    }
+    return SetUint64Result(
+        and_op, MaskToWidth(accum, and_op->BitCountOrDie()));
+  }
   std::vector<Bits> operands = ResolveAsBitsVector(and_op->operands());
   Bits accum = bits_ops::NaryAnd(operands);
   return SetBitsResult(and_op, accum);
 }
 
 absl::Status IrInterpreter::HandleNaryNand(NaryOp* nand_op) {
+  if (NodeFitsInUint64(nand_op)) {
+    uint64_t accum = ~uint64_t{0};
+    for (Node* operand : nand_op->operands()) {
+      accum &= ResolveAsUint64(operand);
+    }
+    return SetUint64Result(
+        nand_op, MaskToWidth(~accum, nand_op->BitCountOrDie()));
+  }
   std::vector<Bits> operands = ResolveAsBitsVector(nand_op->operands());
   Bits accum = bits_ops::NaryNand(operands);
   return SetBitsResult(nand_op, accum);
 }
 
 absl::Status IrInterpreter::HandleNaryNor(NaryOp* nor_op) {
+  if (NodeFitsInUint64(nor_op)) {
+    uint64_t accum = uint64_t{0};
+    for (Node* operand : nor_op->operands()) {
+      accum |= ResolveAsUint64(operand);
+    }
+    return SetUint64Result(
+        nor_op, MaskToWidth(~accum, nor_op->BitCountOrDie()));
+  }
   std::vector<Bits> operands = ResolveAsBitsVector(nor_op->operands());
   Bits accum = bits_ops::NaryNor(operands);
   return SetBitsResult(nor_op, accum);
 }
 
 absl::Status IrInterpreter::HandleNaryOr(NaryOp* or_op) {
+  if (NodeFitsInUint64(or_op)) {
+    uint64_t accum = uint64_t{0};
+    for (Node* operand : or_op->operands()) {
+      accum |= ResolveAsUint64(operand);
+    }
+    return SetUint64Result(
+        or_op, MaskToWidth(accum, or_op->BitCountOrDie()));
+  }
   std::vector<Bits> operands = ResolveAsBitsVector(or_op->operands());
   Bits accum = bits_ops::NaryOr(operands);
   return SetBitsResult(or_op, accum);
 }
 
 absl::Status IrInterpreter::HandleNaryXor(NaryOp* xor_op) {
+  if (NodeFitsInUint64(xor_op)) {
+    uint64_t accum = uint64_t{0};
+    for (Node* operand : xor_op->operands()) {
+      accum ^= ResolveAsUint64(operand);
+    }
+    return SetUint64Result(
+        xor_op, MaskToWidth(accum, xor_op->BitCountOrDie()));
+  }
   std::vector<Bits> operands = ResolveAsBitsVector(xor_op->operands());
   Bits accum = bits_ops::NaryXor(operands);
   return SetBitsResult(xor_op, accum);
@@ -367,30 +450,61 @@ absl::Status IrInterpreter::HandleSMod(BinOp* mod) {
 }
 
 absl::Status IrInterpreter::HandleEq(CompareOp* eq) {
+  if (NodeFitsInUint64(eq)) {
+    return SetUint64Result(
+        eq, static_cast<uint64_t>(ResolveAsUint64(eq->operand(0)) ==
+                                  ResolveAsUint64(eq->operand(1))));
+  }
   return SetUint64Result(eq,
                          static_cast<int64_t>(ResolveAsValue(eq->operand(0)) ==
                                               ResolveAsValue(eq->operand(1))));
 }
 
 absl::Status IrInterpreter::HandleSGe(CompareOp* ge) {
+  if (NodeFitsInUint64(ge)) {
+    int64_t width = ge->operand(0)->BitCountOrDie();
+    return SetUint64Result(
+        ge,
+        static_cast<uint64_t>(
+            AsSigned(ResolveAsUint64(ge->operand(0)), width) >=
+            AsSigned(ResolveAsUint64(ge->operand(1)), width)));
+  }
   return SetUint64Result(
       ge, static_cast<uint64_t>(bits_ops::SGreaterThanOrEqual(
               ResolveAsBits(ge->operand(0)), ResolveAsBits(ge->operand(1)))));
 }
 
 absl::Status IrInterpreter::HandleSGt(CompareOp* gt) {
+  if (NodeFitsInUint64(gt)) {
+    int64_t width = gt->operand(0)->BitCountOrDie();
+    return SetUint64Result(
+        gt,
+        static_cast<uint64_t>(
+            AsSigned(ResolveAsUint64(gt->operand(0)), width) >
+            AsSigned(ResolveAsUint64(gt->operand(1)), width)));
+  }
   return SetUint64Result(
       gt, static_cast<uint64_t>(bits_ops::SGreaterThan(
               ResolveAsBits(gt->operand(0)), ResolveAsBits(gt->operand(1)))));
 }
 
 absl::Status IrInterpreter::HandleUGe(CompareOp* ge) {
+  if (NodeFitsInUint64(ge)) {
+    return SetUint64Result(
+        ge, static_cast<uint64_t>(ResolveAsUint64(ge->operand(0)) >=
+                                  ResolveAsUint64(ge->operand(1))));
+  }
   return SetUint64Result(
       ge, static_cast<uint64_t>(bits_ops::UGreaterThanOrEqual(
               ResolveAsBits(ge->operand(0)), ResolveAsBits(ge->operand(1)))));
 }
 
 absl::Status IrInterpreter::HandleUGt(CompareOp* gt) {
+  if (NodeFitsInUint64(gt)) {
+    return SetUint64Result(
+        gt, static_cast<uint64_t>(ResolveAsUint64(gt->operand(0)) >
+                                  ResolveAsUint64(gt->operand(1))));
+  }
   return SetUint64Result(
       gt, static_cast<uint64_t>(bits_ops::UGreaterThan(
               ResolveAsBits(gt->operand(0)), ResolveAsBits(gt->operand(1)))));
@@ -583,24 +697,50 @@ absl::Status IrInterpreter::HandleLiteral(Literal* literal) {
 }
 
 absl::Status IrInterpreter::HandleULe(CompareOp* le) {
+  if (NodeFitsInUint64(le)) {
+    return SetUint64Result(
+        le, static_cast<uint64_t>(ResolveAsUint64(le->operand(0)) <=
+                                  ResolveAsUint64(le->operand(1))));
+  }
   return SetUint64Result(
       le, static_cast<uint64_t>(bits_ops::ULessThanOrEqual(
               ResolveAsBits(le->operand(0)), ResolveAsBits(le->operand(1)))));
 }
 
 absl::Status IrInterpreter::HandleSLt(CompareOp* lt) {
+  if (NodeFitsInUint64(lt)) {
+    int64_t width = lt->operand(0)->BitCountOrDie();
+    return SetUint64Result(
+        lt,
+        static_cast<uint64_t>(
+            AsSigned(ResolveAsUint64(lt->operand(0)), width) <
+            AsSigned(ResolveAsUint64(lt->operand(1)), width)));
+  }
   return SetUint64Result(
       lt, static_cast<uint64_t>(bits_ops::SLessThan(
               ResolveAsBits(lt->operand(0)), ResolveAsBits(lt->operand(1)))));
 }
 
 absl::Status IrInterpreter::HandleSLe(CompareOp* le) {
+  if (NodeFitsInUint64(le)) {
+    int64_t width = le->operand(0)->BitCountOrDie();
+    return SetUint64Result(
+        le,
+        static_cast<uint64_t>(
+            AsSigned(ResolveAsUint64(le->operand(0)), width) <=
+            AsSigned(ResolveAsUint64(le->operand(1)), width)));
+  }
   return SetUint64Result(
       le, static_cast<uint64_t>(bits_ops::SLessThanOrEqual(
               ResolveAsBits(le->operand(0)), ResolveAsBits(le->operand(1)))));
 }
 
 absl::Status IrInterpreter::HandleULt(CompareOp* lt) {
+  if (NodeFitsInUint64(lt)) {
+    return SetUint64Result(
+        lt, static_cast<uint64_t>(ResolveAsUint64(lt->operand(0)) <
+                                  ResolveAsUint64(lt->operand(1))));
+  }
   return SetUint64Result(
       lt, static_cast<uint64_t>(bits_ops::ULessThan(
               ResolveAsBits(lt->operand(0)), ResolveAsBits(lt->operand(1)))));
@@ -635,6 +775,14 @@ absl::Status IrInterpreter::HandleSMul(ArithOp* mul) {
 
 absl::Status IrInterpreter::HandleUMul(ArithOp* mul) {
   const int64_t mul_width = mul->BitCountOrDie();
+  if (NodeFitsInUint64(mul)) {
+    // uint64_t multiplication is modulo 2**64 so the low bits are correct
+    // even if the full product would overflow.
+    return SetUint64Result(
+        mul, MaskToWidth(ResolveAsUint64(mul->operand(0)) *
+                             ResolveAsUint64(mul->operand(1)),
+                         mul_width));
+  }
   Bits result = bits_ops::UMul(ResolveAsBits(mul->operand(0)),
                                ResolveAsBits(mul->operand(1)));
   if (result.bit_count() > mul_width) {
@@ -679,16 +827,31 @@ absl::Status IrInterpreter::HandleUMulp(PartialProductOp* mul) {
 }
 
 absl::Status IrInterpreter::HandleNe(CompareOp* ne) {
+  if (NodeFitsInUint64(ne)) {
+    return SetUint64Result(
+        ne, static_cast<uint64_t>(ResolveAsUint64(ne->operand(0)) !=
+                                  ResolveAsUint64(ne->operand(1))));
+  }
   return SetUint64Result(ne,
                          static_cast<int64_t>(ResolveAsValue(ne->operand(0)) !=
                                               ResolveAsValue(ne->operand(1))));
 }
 
 absl::Status IrInterpreter::HandleNeg(UnOp* neg) {
+  if (NodeFitsInUint64(neg)) {
+    return SetUint64Result(
+        neg, MaskToWidth(-ResolveAsUint64(neg->operand(0)),
+                         neg->BitCountOrDie()));
+  }
   return SetBitsResult(neg, bits_ops::Negate(ResolveAsBits(neg->operand(0))));
 }
 
 absl::Status IrInterpreter::HandleNot(UnOp* not_op) {
+  if (NodeFitsInUint64(not_op)) {
+    return SetUint64Result(
+        not_op, MaskToWidth(~ResolveAsUint64(not_op->operand(0)),
+                            not_op->BitCountOrDie()));
+  }
   return SetBitsResult(not_op,
                        bits_ops::Not(ResolveAsBits(not_op->operand(0))));
 }
@@ -759,6 +922,15 @@ absl::Status IrInterpreter::HandleSel(Select* sel) {
 }
 
 absl::Status IrInterpreter::HandleShll(BinOp* shll) {
+  if (NodeFitsInUint64(shll)) {
+    uint64_t value = ResolveAsUint64(shll->operand(0));
+    uint64_t shift_amt = ResolveAsUint64(shll->operand(1));
+    uint64_t result =
+        shift_amt >= static_cast<uint64_t>(shll->BitCountOrDie())
+            ? 0
+            : MaskToWidth(value << shift_amt, shll->BitCountOrDie());
+    return SetUint64Result(shll, result);
+  }
   const Bits& input = ResolveAsBits(shll->operand(0));
   const int64_t shift_amt =
       ResolveAsBoundedUint64(shll->operand(1), input.bit_count());
@@ -773,6 +945,15 @@ absl::Status IrInterpreter::HandleShra(BinOp* shra) {
 }
 
 absl::Status IrInterpreter::HandleShrl(BinOp* shrl) {
+  if (NodeFitsInUint64(shrl)) {
+    uint64_t value = ResolveAsUint64(shrl->operand(0));
+    uint64_t shift_amt = ResolveAsUint64(shrl->operand(1));
+    uint64_t result =
+        shift_amt >= static_cast<uint64_t>(shrl->BitCountOrDie())
+            ? 0
+            : value >> shift_amt;
+    return SetUint64Result(shrl, result);
+  }
   const Bits& input = ResolveAsBits(shrl->operand(0));
   const int64_t shift_amt =
       ResolveAsBoundedUint64(shrl->operand(1), input.bit_count());
@@ -786,6 +967,12 @@ absl::Status IrInterpreter::HandleSignExtend(ExtendOp* sign_ext) {
 }
 
 absl::Status IrInterpreter::HandleSub(BinOp* sub) {
+  if (NodeFitsInUint64(sub)) {
+    return SetUint64Result(
+        sub, MaskToWidth(ResolveAsUint64(sub->operand(0)) -
+                             ResolveAsUint64(sub->operand(1)),
+                         sub->BitCountOrDie()));
+  }
   return SetBitsResult(sub, bits_ops::Sub(ResolveAsBits(sub->operand(0)),
                                           ResolveAsBits(sub->operand(1))));
 }
@@ -829,11 +1016,11 @@ absl::Status IrInterpreter::VerifyAllBitsTypes(Node* node) {
 }
 
 const Bits& IrInterpreter::ResolveAsBits(Node* node) {
-  return NodeValuesMap().at(node).bits();
+  return ResolveAsValue(node).bits();
 }
 
 bool IrInterpreter::ResolveAsBool(Node* node) {
-  const Bits& bits = NodeValuesMap().at(node).bits();
+  const Bits& bits = ResolveAsValue(node).bits();
   CHECK_EQ(bits.bit_count(), 1);
   return bits.IsAllOnes();
 }
@@ -852,6 +1039,12 @@ uint64_t IrInterpreter::ResolveAsBoundedUint64(Node* node,
   return BitsToBoundedUint64(ResolveAsBits(node), upper_limit);
 }
 
+uint64_t IrInterpreter::ResolveAsUint64(Node* node) {
+  const Bits& bits = ResolveAsBits(node);
+  CHECK_LE(bits.bit_count(), 64);
+  return bits.ToUint64().value();
+}
+
 absl::Status IrInterpreter::SetUint64Result(Node* node, uint64_t result) {
   XLS_RET_CHECK(node->GetType()->IsBits());
   XLS_RET_CHECK_GE(node->BitCountOrDie(), Bits::MinBitCountUnsigned(result));
@@ -867,7 +1060,7 @@ absl::Status IrInterpreter::SetBitsResult(Node* node, const Bits& result) {
 absl::Status IrInterpreter::SetValueResult(Node* node, Value result) {
   if (VLOG_IS_ON(4) &&
       std::all_of(node->operands().begin(), node->operands().end(),
-                  [this](Node* o) { return NodeValuesMap().contains(o); })) {
+                  [this](Node* o) { return HasResult(o); })) {
     VLOG(4) << absl::StreamFormat("%s operands:", node->GetName());
     for (int64_t i = 0; i < node->operand_count(); ++i) {
       VLOG(4) << absl::StreamFormat(
@@ -878,13 +1071,17 @@ absl::Status IrInterpreter::SetValueResult(Node* node, Value result) {
   VLOG(3) << absl::StreamFormat("Result of %s: %s", node->ToString(),
                                 result.ToString());
 
-  XLS_RET_CHECK(!NodeValuesMap().contains(node));
+  XLS_RET_CHECK(!HasResult(node));
   if (!ValueConformsToType(result, node->GetType())) {
     return absl::InternalError(absl::StrFormat(
         "Expected value %s to match type %s of node %s", result.ToString(),
         node->GetType()->ToString(), node->GetName()));
   }
-  NodeValuesMap()[node] = std::move(result);
+  if (plan_ != nullptr) {
+    slots_[plan_->slot(node)] = std::move(result);
+  } else {
+    NodeValuesMap()[node] = std::move(result);
+  }
   return absl::OkStatus();
 }
 
@@ -22,6 +22,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "xls/interpreter/evaluation_plan.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/dfs_visitor.h"
 #include "xls/ir/events.h"
@@ -48,6 +49,17 @@ class IrInterpreter : public DfsVisitor {
                 InterpreterEvents* events)
       : node_values_ptr_(node_values), events_ptr_(events) {}
 
+  // Constructor for plan-driven evaluation. Node values are stored in
+  // `slots`, a flat array indexed by `plan`'s slot numbers, rather than in a
+  // hash map keyed by Node*. `slots` must hold `plan->size()`
+  // default-constructed (invalid) Values and both `plan` and `slots` must
+  // outlive the interpreter.
+  IrInterpreter(const EvaluationPlan* plan, absl::Span<Value> slots)
+      : node_values_ptr_(nullptr),
+        events_ptr_(nullptr),
+        plan_(plan),
+        slots_(slots) {}
+
   // Sets the evaluated value for 'node' to the given Value. 'value' must be
   // passed in by value (ha!) because a use case is passing in a previously
   // evaluated value and inserting a into flat_hash_map (done below) invalidates
@@ -56,6 +68,9 @@ class IrInterpreter : public DfsVisitor {
 
   // Returns the previously evaluated value of 'node' as a Value.
   const Value& ResolveAsValue(Node* node) const {
+    if (plan_ != nullptr) {
+      return slots_[plan_->slot(node)];
+    }
     return NodeValuesMap().at(node);
   }
 
@@ -69,7 +84,12 @@ class IrInterpreter : public DfsVisitor {
   absl::Status AddInterpreterEvents(const InterpreterEvents& events);
 
   // Returns true if a value has been set for the result of the given node.
-  bool HasResult(Node* node) const { return NodeValuesMap().contains(node); }
+  bool HasResult(Node* node) const {
+    if (plan_ != nullptr) {
+      return slots_[plan_->slot(node)].kind() != ValueKind::kInvalid;
+    }
+    return NodeValuesMap().contains(node);
+  }
 
   absl::Status HandleAdd(BinOp* add) override;
   absl::Status HandleAfterAll(AfterAll* after_all) override;
@@ -172,6 +192,10 @@ class IrInterpreter : public DfsVisitor {
   // value is greater than 'upper_limit' then 'upper_limit' is returned.
   uint64_t ResolveAsBoundedUint64(Node* node, uint64_t upper_limit);
 
+  // Returns the previously evaluated value of 'node' as an unboxed uint64_t.
+  // CHECK fails if the value is not a bits value of at most 64 bits.
+  uint64_t ResolveAsUint64(Node* node);
+
   // Sets the evaluated value for 'node' to the given uint64_t value. Returns an
   // error if 'node' is not a bits type or the result does not fit in the type.
   absl::Status SetUint64Result(Node* node, uint64_t result);
@@ -201,6 +225,11 @@ class IrInterpreter : public DfsVisitor {
   absl::flat_hash_map<Node*, Value>* node_values_ptr_;
   absl::flat_hash_map<Node*, Value> node_values_;
 
+  // When non-null, node values are stored in `slots_` at the plan's slot
+  // numbers instead of in the map above.
+  const EvaluationPlan* plan_ = nullptr;
+  absl::Span<Value> slots_;
+
   // Events observed while interpreting (currently only trace messages). To
   // support continuations, an existing events object can either be passed in at
   // construction time (`events_ptr_` is not null), or a fresh events object is
@@ -0,0 +1,209 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/parallel_proc_runtime.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/interpreter/channel_queue.h"
+#include "xls/interpreter/proc_evaluator.h"
+#include "xls/ir/events.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+
+/* static */ absl::StatusOr<std::unique_ptr<ParallelProcRuntime>>
+ParallelProcRuntime::Create(
+    std::vector<std::unique_ptr<ProcEvaluator>>&& evaluators,
+    std::unique_ptr<ChannelQueueManager>&& queue_manager,
+    int64_t worker_count) {
+  // Verify there exists exactly one evaluator per proc in the package.
+  absl::flat_hash_map<Proc*, std::unique_ptr<ProcEvaluator>> evaluator_map;
+  for (std::unique_ptr<ProcEvaluator>& evaluator : evaluators) {
+    Proc* proc = evaluator->proc();
+    auto [it, inserted] = evaluator_map.insert({proc, std::move(evaluator)});
+    XLS_RET_CHECK(inserted) << absl::StreamFormat(
+        "More than one evaluator given for proc `%s`", proc->name());
+  }
+  for (Proc* proc : queue_manager->elaboration().procs()) {
+    XLS_RET_CHECK(evaluator_map.contains(proc))
+        << absl::StreamFormat("No evaluator given for proc `%s`", proc->name());
+  }
+  XLS_RET_CHECK_EQ(evaluator_map.size(),
+                   queue_manager->elaboration().procs().size())
+      << "More evaluators than procs given.";
+  if (worker_count == 0) {
+    worker_count = std::max<int64_t>(1, std::thread::hardware_concurrency());
+  }
+  XLS_RET_CHECK_GT(worker_count, 0);
+  return absl::WrapUnique(new ParallelProcRuntime(
+      std::move(evaluator_map), std::move(queue_manager), worker_count));
+}
+
+absl::StatusOr<ParallelProcRuntime::NetworkTickResult>
+ParallelProcRuntime::TickInternal() {
+  VLOG(3) << absl::StreamFormat("Parallel TickInternal on package %s",
+                                package()->name());
+  struct QueueElement {
+    ProcInstance* instance;
+    ProcEvaluator* evaluator;
+    ProcContinuation* continuation;
+  };
+
+  // State shared between workers. Proc instances are dispatched from `ready`;
+  // an instance blocked on a receive is parked in `blocked` and re-enqueued
+  // when a send on that channel is observed, so no worker ever polls
+  // non-ready procs.
+  struct TickState {
+    std::deque<QueueElement> ready;
+    absl::flat_hash_map<ChannelInstance*, ProcInstance*> blocked;
+    // Number of instances currently being ticked by a worker.
+    int64_t active = 0;
+    bool progress_made = false;
+    bool progress_made_on_io_procs = false;
+    absl::Status status = absl::OkStatus();
+  };
+  absl::Mutex mutex;
+  TickState state;
+
+  for (ProcInstance* instance : elaboration().proc_instances()) {
+    state.ready.push_back(
+        QueueElement{.instance = instance,
+                     .evaluator = evaluators_.at(instance->proc()).get(),
+                     .continuation = continuations_.at(instance).get()});
+  }
+
+  // Must be called with `mutex` held.
+  auto enqueue = [&](ProcInstance* instance) {
+    state.ready.push_back(
+        QueueElement{.instance = instance,
+                     .evaluator = evaluators_.at(instance->proc()).get(),
+                     .continuation = continuations_.at(instance).get()});
+  };
+
+  auto worker_loop = [&]() {
+    while (true) {
+      QueueElement element;
+      {
+        absl::MutexLock lock(&mutex);
+        // Wake when work is available, when the network may have quiesced, or
+        // on error.
+        mutex.Await(absl::Condition(
+            +[](TickState* s) {
+              return !s->ready.empty() || s->active == 0 || !s->status.ok();
+            },
+            &state));
+        if (!state.status.ok() ||
+            (state.ready.empty() && state.active == 0)) {
+          return;
+        }
+        if (state.ready.empty()) {
+          continue;
+        }
+        element = state.ready.front();
+        state.ready.pop_front();
+        ++state.active;
+      }
+
+      absl::StatusOr<TickResult> tick_result =
+          element.evaluator->Tick(*element.continuation);
+      absl::Status events_status =
+          tick_result.ok()
+              ? InterpreterEventsToStatus(element.continuation->GetEvents())
+              : absl::OkStatus();
+
+      absl::MutexLock lock(&mutex);
+      --state.active;
+      if (!tick_result.ok() || !events_status.ok()) {
+        if (state.status.ok()) {
+          state.status =
+              tick_result.ok() ? events_status : tick_result.status();
+        }
+        continue;
+      }
+      state.progress_made |= tick_result->progress_made;
+      state.progress_made_on_io_procs |=
+          (tick_result->progress_made &&
+           element.evaluator->ProcHasIoOperations());
+      if (tick_result->execution_state ==
+          TickExecutionState::kSentOnChannel) {
+        ChannelInstance* channel_instance =
+            tick_result->channel_instance.value();
+        auto it = state.blocked.find(channel_instance);
+        if (it != state.blocked.end()) {
+          enqueue(it->second);
+          state.blocked.erase(it);
+        }
+        // This proc instance can go back on the ready queue.
+        state.ready.push_back(element);
+      } else if (tick_result->execution_state ==
+                 TickExecutionState::kBlockedOnReceive) {
+        ChannelInstance* channel_instance =
+            tick_result->channel_instance.value();
+        // A send on this channel may have raced with the receive observing an
+        // empty queue. Re-enqueue instead of parking in that case so the
+        // wakeup is not lost.
+        if (!queue_manager().GetQueue(channel_instance).IsEmpty()) {
+          state.ready.push_back(element);
+        } else {
+          state.blocked[channel_instance] = element.instance;
+        }
+      }
+    }
+  };
+
+  int64_t num_workers = std::min(
+      worker_count_, static_cast<int64_t>(state.ready.size()));
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (int64_t i = 0; i < num_workers; ++i) {
+    workers.push_back(std::thread(worker_loop));
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  XLS_RETURN_IF_ERROR(state.status);
+
+  auto get_blocked_channel_instances = [&]() {
+    std::vector<ChannelInstance*> instances;
+    for (ChannelInstance* instance : elaboration().channel_instances()) {
+      if (state.blocked.contains(instance)) {
+        instances.push_back(instance);
+      }
+    }
+    return instances;
+  };
+  return NetworkTickResult{
+      .progress_made = state.progress_made,
+      .progress_made_on_io_procs = state.progress_made_on_io_procs,
+      .blocked_channel_instances = get_blocked_channel_instances(),
+  };
+}
+
+}  // namespace xls
@@ -0,0 +1,70 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_INTERPRETER_PARALLEL_PROC_RUNTIME_H_
+#define XLS_INTERPRETER_PARALLEL_PROC_RUNTIME_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "xls/interpreter/channel_queue.h"
+#include "xls/interpreter/proc_evaluator.h"
+#include "xls/interpreter/proc_runtime.h"
+#include "xls/ir/elaboration.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+
+// A proc runtime which executes ready proc instances of the network on
+// multiple worker threads. Within a tick, proc instances which are not blocked
+// on a receive are dispatched to workers from a shared ready queue; an
+// instance blocked on a receive is woken by notification when a value is sent
+// on that channel rather than by polling all procs. Has the same semantics as
+// SerialProcRuntime (same ProcRuntime interface) and requires proc evaluators
+// which are thread-safe when invoked with different continuations (both
+// ProcInterpreter and ProcJit are). Channel queues are already internally
+// synchronized.
+//
+// Like SerialProcRuntime, the runtime itself is thread-compatible but not
+// thread-safe; only one thread may call Tick() and friends at a time.
+class ParallelProcRuntime : public ProcRuntime {
+ public:
+  // Creates and returns a parallel proc runtime for the given evaluators.
+  // `worker_count` is the number of worker threads to dispatch proc instances
+  // onto; zero means one worker per hardware thread.
+  static absl::StatusOr<std::unique_ptr<ParallelProcRuntime>> Create(
+      std::vector<std::unique_ptr<ProcEvaluator>>&& evaluators,
+      std::unique_ptr<ChannelQueueManager>&& queue_manager,
+      int64_t worker_count = 0);
+
+ private:
+  ParallelProcRuntime(
+      absl::flat_hash_map<Proc*, std::unique_ptr<ProcEvaluator>>&& evaluators,
+      std::unique_ptr<ChannelQueueManager>&& queue_manager,
+      int64_t worker_count)
+      : ProcRuntime(std::move(evaluators), std::move(queue_manager)),
+        worker_count_(worker_count) {}
+
+  absl::StatusOr<NetworkTickResult> TickInternal() override;
+
+  int64_t worker_count_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_INTERPRETER_PARALLEL_PROC_RUNTIME_H_
@@ -0,0 +1,99 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/parallel_proc_runtime.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/interpreter/channel_queue.h"
+#include "xls/interpreter/proc_evaluator.h"
+#include "xls/interpreter/proc_interpreter.h"
+#include "xls/interpreter/proc_runtime.h"
+#include "xls/interpreter/proc_runtime_test_base.h"
+#include "xls/ir/package.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+absl::StatusOr<std::unique_ptr<ParallelProcRuntime>> CreateRuntime(
+    ProcElaboration elaboration) {
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<ChannelQueueManager> queue_manager,
+                       ChannelQueueManager::Create(std::move(elaboration)));
+
+  // Create a ProcInterpreter for each Proc. ProcInterpreters are thread-safe
+  // when invoked with different continuations.
+  std::vector<std::unique_ptr<ProcEvaluator>> proc_interpreters;
+  for (Proc* proc : queue_manager->elaboration().procs()) {
+    proc_interpreters.push_back(
+        std::make_unique<ProcInterpreter>(proc, queue_manager.get()));
+  }
+
+  XLS_ASSIGN_OR_RETURN(
+      std::unique_ptr<ParallelProcRuntime> proc_runtime,
+      ParallelProcRuntime::Create(std::move(proc_interpreters),
+                                  std::move(queue_manager),
+                                  /*worker_count=*/4));
+
+  // Inject initial values into channel queues.
+  for (ChannelInstance* channel_instance :
+       proc_runtime->elaboration().channel_instances()) {
+    Channel* channel = channel_instance->channel;
+    ChannelQueue& queue =
+        proc_runtime->queue_manager().GetQueue(channel_instance);
+    for (const Value& value : channel->initial_values()) {
+      XLS_RETURN_IF_ERROR(queue.Write(value));
+    }
+  }
+
+  return std::move(proc_runtime);
+}
+
+absl::StatusOr<std::unique_ptr<ParallelProcRuntime>>
+CreateInterpreterParallelProcRuntime(Package* package) {
+  XLS_ASSIGN_OR_RETURN(ProcElaboration elaboration,
+                       ProcElaboration::ElaborateOldStylePackage(package));
+  return CreateRuntime(std::move(elaboration));
+}
+
+absl::StatusOr<std::unique_ptr<ParallelProcRuntime>>
+CreateInterpreterParallelProcRuntime(Proc* top) {
+  XLS_ASSIGN_OR_RETURN(ProcElaboration elaboration,
+                       ProcElaboration::Elaborate(top));
+  return CreateRuntime(std::move(elaboration));
+}
+
+// Run the full ProcRuntime test suite against the parallel runtime to verify
+// it has the same semantics as SerialProcRuntime.
+INSTANTIATE_TEST_SUITE_P(
+    ParallelProcRuntimeTest, ProcRuntimeTestBase,
+    testing::Values(ProcRuntimeTestParam(
+        "parallel_interpreter",
+        [](Package* package) -> std::unique_ptr<ProcRuntime> {
+          return CreateInterpreterParallelProcRuntime(package).value();
+        },
+        [](Proc* top) -> std::unique_ptr<ProcRuntime> {
+          return CreateInterpreterParallelProcRuntime(top).value();
+        })),
+    [](const testing::TestParamInfo<ProcRuntimeTestBase::ParamType>& info) {
+      return info.param.name();
+    });
+
+}  // namespace
+}  // namespace xls
@@ -0,0 +1,128 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_INTERPRETER_PROC_BLOCK_COSIMULATOR_H_
+#define XLS_INTERPRETER_PROC_BLOCK_COSIMULATOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/interpreter/block_evaluator.h"
+#include "xls/interpreter/channel_queue.h"
+#include "xls/interpreter/proc_runtime.h"
+#include "xls/ir/block.h"
+#include "xls/ir/events.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+
+// Binds a streaming channel in a proc network to the ready/valid/data port
+// triple a block exposes for that channel.
+struct CosimulatedChannel {
+  std::string channel_name;
+  std::string data_port;
+  std::string valid_port;
+  std::string ready_port;
+};
+
+// Drives a proc network (executed by a ProcRuntime, e.g. the proc JIT) and a
+// block (executed by any BlockEvaluator, e.g. the block JIT or the block
+// interpreter) under a single cycle scheduler. Values cross between the two
+// sides through the runtime's in-memory channel queues as typed xls::Values;
+// no serialization or process boundary is involved.
+//
+// Each cycle:
+//   1. The proc network is ticked until all procs are blocked on receives, so
+//      values destined for the block are deposited in their channel queues.
+//   2. The block is run for one clock cycle. Channels bound by
+//      `proc_to_block` pop from their queue and drive the block's data/valid
+//      ports, completing a transfer when the block asserts ready. Channels
+//      bound by `block_to_proc` always assert ready and push the data value
+//      into their queue when the block asserts valid.
+class ProcBlockCosimulator {
+ public:
+  // Creates a cosimulator running `block` with `evaluator` against the proc
+  // network executed by `runtime`. `runtime` and `block` must outlive the
+  // returned object; `evaluator` is only used during this call.
+  //
+  // `proc_to_block` binds channels whose values flow from the proc network
+  // into the block; `block_to_proc` binds channels flowing the other way.
+  // `fixed_inputs` is driven on the block every cycle (e.g. a deasserted
+  // reset port) and must cover any input port not bound to a channel.
+  static absl::StatusOr<std::unique_ptr<ProcBlockCosimulator>> Create(
+      ProcRuntime* runtime, const BlockEvaluator& evaluator, Block* block,
+      absl::Span<const CosimulatedChannel> proc_to_block,
+      absl::Span<const CosimulatedChannel> block_to_proc,
+      absl::flat_hash_map<std::string, Value> fixed_inputs = {});
+
+  // Runs a single clock cycle of the block along with as many proc ticks as
+  // the proc network can make progress on. Returns an error if the proc
+  // network deadlocks or the block evaluation fails.
+  absl::Status RunCycle();
+
+  // Runs `num_cycles` clock cycles.
+  absl::Status Run(int64_t num_cycles);
+
+  // Events recorded by the block evaluator in the most recent cycle.
+  const InterpreterEvents& block_events() { return continuation_->events(); }
+
+  // Number of clock cycles run so far.
+  int64_t current_cycle() const { return cycle_; }
+
+ private:
+  // A channel driving the block's input side. `pending` holds the value
+  // currently presented on the data port; it is popped from the queue and
+  // held until the block asserts ready.
+  struct InputBinding {
+    CosimulatedChannel ports;
+    ChannelQueue* queue;
+    std::optional<Value> pending;
+  };
+
+  // A channel receiving values from the block's output side.
+  struct OutputBinding {
+    CosimulatedChannel ports;
+    ChannelQueue* queue;
+  };
+
+  ProcBlockCosimulator(ProcRuntime* runtime,
+                       std::unique_ptr<BlockContinuation> continuation,
+                       std::vector<InputBinding> inputs,
+                       std::vector<OutputBinding> outputs,
+                       absl::flat_hash_map<std::string, Value> fixed_inputs)
+      : runtime_(runtime),
+        continuation_(std::move(continuation)),
+        inputs_(std::move(inputs)),
+        outputs_(std::move(outputs)),
+        fixed_inputs_(std::move(fixed_inputs)) {}
+
+  ProcRuntime* runtime_;
+  std::unique_ptr<BlockContinuation> continuation_;
+  std::vector<InputBinding> inputs_;
+  std::vector<OutputBinding> outputs_;
+  absl::flat_hash_map<std::string, Value> fixed_inputs_;
+  int64_t cycle_ = 0;
+};
+
+}  // namespace xls
+
+#endif  // XLS_INTERPRETER_PROC_BLOCK_COSIMULATOR_H_
@@ -0,0 +1,141 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/interpreter/proc_block_cosimulator.h"
+
+#include <memory>
+#include <optional>
+
+#include "gtest/gtest.h"
+#include "xls/common/status/matchers.h"
+#include "xls/interpreter/block_interpreter.h"
+#include "xls/interpreter/channel_queue.h"
+#include "xls/interpreter/interpreter_proc_runtime.h"
+#include "xls/interpreter/serial_proc_runtime.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/block.h"
+#include "xls/ir/channel.h"
+#include "xls/ir/channel_ops.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/type.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+class ProcBlockCosimulatorTest : public IrTestBase {};
+
+TEST_F(ProcBlockCosimulatorTest, PassThroughBlockFeedingPlusOneProc) {
+  auto package = CreatePackage();
+  Type* u32 = package->GetBitsType(32);
+  Type* u1 = package->GetBitsType(1);
+
+  // Values flow: to_block queue -> block -> from_block queue -> proc ->
+  // result queue.
+  XLS_ASSERT_OK(package
+                    ->CreateStreamingChannel("to_block",
+                                             ChannelOps::kReceiveOnly, u32)
+                    .status());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * from_block,
+      package->CreateStreamingChannel("from_block", ChannelOps::kReceiveOnly,
+                                      u32));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * result,
+      package->CreateStreamingChannel("result", ChannelOps::kSendOnly, u32));
+
+  // Proc which adds one to each value received from the block.
+  TokenlessProcBuilder pb("plus_one", "tkn", package.get());
+  BValue x = pb.Receive(from_block);
+  pb.Send(result, pb.Add(x, pb.Literal(UBits(1, 32))));
+  XLS_ASSERT_OK(pb.Build({}).status());
+
+  // Combinational block which passes through its ready/valid/data channel.
+  BlockBuilder bb("passthrough", package.get());
+  BValue in_data = bb.InputPort("in_data", u32);
+  BValue in_valid = bb.InputPort("in_valid", u1);
+  BValue out_ready = bb.InputPort("out_ready", u1);
+  bb.OutputPort("out_data", in_data);
+  bb.OutputPort("out_valid", in_valid);
+  bb.OutputPort("in_ready", out_ready);
+  XLS_ASSERT_OK_AND_ASSIGN(Block * block, bb.Build());
+
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SerialProcRuntime> runtime,
+                           CreateInterpreterSerialProcRuntime(package.get()));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      ChannelQueue * to_block_queue,
+      runtime->queue_manager().GetQueueByName("to_block"));
+  XLS_ASSERT_OK(to_block_queue->Write(Value(UBits(5, 32))));
+  XLS_ASSERT_OK(to_block_queue->Write(Value(UBits(7, 32))));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<ProcBlockCosimulator> cosim,
+      ProcBlockCosimulator::Create(
+          runtime.get(), kInterpreterBlockEvaluator, block,
+          /*proc_to_block=*/
+          {{.channel_name = "to_block",
+            .data_port = "in_data",
+            .valid_port = "in_valid",
+            .ready_port = "in_ready"}},
+          /*block_to_proc=*/
+          {{.channel_name = "from_block",
+            .data_port = "out_data",
+            .valid_port = "out_valid",
+            .ready_port = "out_ready"}}));
+
+  XLS_ASSERT_OK(cosim->Run(4));
+  EXPECT_EQ(cosim->current_cycle(), 4);
+
+  XLS_ASSERT_OK_AND_ASSIGN(ChannelQueue * result_queue,
+                           runtime->queue_manager().GetQueueByName("result"));
+  EXPECT_EQ(result_queue->Read(), Value(UBits(6, 32)));
+  EXPECT_EQ(result_queue->Read(), Value(UBits(8, 32)));
+  EXPECT_TRUE(result_queue->IsEmpty());
+}
+
+TEST_F(ProcBlockCosimulatorTest, CreateRejectsUnknownPort) {
+  auto package = CreatePackage();
+  Type* u32 = package->GetBitsType(32);
+  Type* u1 = package->GetBitsType(1);
+
+  XLS_ASSERT_OK(package
+                    ->CreateStreamingChannel("to_block",
+                                             ChannelOps::kReceiveOnly, u32)
+                    .status());
+
+  BlockBuilder bb("passthrough", package.get());
+  BValue in_data = bb.InputPort("in_data", u32);
+  BValue in_valid = bb.InputPort("in_valid", u1);
+  bb.OutputPort("out_data", in_data);
+  bb.OutputPort("out_valid", in_valid);
+  XLS_ASSERT_OK_AND_ASSIGN(Block * block, bb.Build());
+
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<SerialProcRuntime> runtime,
+                           CreateInterpreterSerialProcRuntime(package.get()));
+
+  EXPECT_FALSE(ProcBlockCosimulator::Create(
+                   runtime.get(), kInterpreterBlockEvaluator, block,
+                   /*proc_to_block=*/
+                   {{.channel_name = "to_block",
+                     .data_port = "in_data",
+                     .valid_port = "in_valid",
+                     .ready_port = "missing_ready"}},
+                   /*block_to_proc=*/{})
+                   .ok());
+}
+
+}  // namespace
+}  // namespace xls
@@ -150,12 +150,16 @@ class ProcIrInterpreter : public IrInterpreter {
       return SetValueResult(receive, ZeroOfType(receive->GetType()));
     }
 
-    if (receive->is_blocking()) {
-      return SetValueResult(receive, Value::Tuple({Value::Token(), *value}));
+    // Move the received value into the result tuple rather than copying;
+    // payloads on these channels can be large.
+    std::vector<Value> elements;
+    elements.reserve(receive->is_blocking() ? 2 : 3);
+    elements.push_back(Value::Token());
+    elements.push_back(*std::move(value));
+    if (!receive->is_blocking()) {
+      elements.push_back(Value(UBits(1, 1)));
     }
-
-    return SetValueResult(
-        receive, Value::Tuple({Value::Token(), *value, Value(UBits(1, 1))}));
+    return SetValueResult(receive, Value::TupleOwned(std::move(elements)));
   }
 
   absl::Status HandleSend(Send* send) override {
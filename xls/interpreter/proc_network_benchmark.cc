@@ -0,0 +1,291 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks of end-to-end proc network throughput for the interpreter and
+// JIT proc runtimes. Topologies covered: linear producer/consumer chains,
+// fan-out and fan-in, each with varying value sizes. Reported metrics:
+// items_per_second is value-hops per second (a value crossing one proc is one
+// hop, so ns/value-hop is its inverse) and the `ticks` counter is proc
+// network ticks per second.
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "include/benchmark/benchmark.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/interpreter/channel_queue.h"
+#include "xls/interpreter/interpreter_proc_runtime.h"
+#include "xls/interpreter/serial_proc_runtime.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/channel.h"
+#include "xls/ir/channel_ops.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/package.h"
+#include "xls/ir/type.h"
+#include "xls/ir/value.h"
+#include "xls/jit/jit_proc_runtime.h"
+
+namespace xls {
+namespace {
+
+// Number of values pushed through the network per benchmark iteration.
+constexpr int64_t kValuesPerBatch = 16;
+
+enum class RuntimeKind : uint8_t { kInterpreter, kJit };
+
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateRuntime(
+    RuntimeKind kind, Package* package) {
+  if (kind == RuntimeKind::kJit) {
+    return CreateJitSerialProcRuntime(package);
+  }
+  return CreateInterpreterSerialProcRuntime(package);
+}
+
+// Builds a chain of `hops` pass-through procs:
+//   in => proc_0 => proc_1 => ... => proc_{hops-1} => out
+// Returns the external input and output channels.
+absl::StatusOr<std::pair<Channel*, Channel*>> BuildLinearChain(
+    Package* package, int64_t hops, int64_t bit_count) {
+  Type* type = package->GetBitsType(bit_count);
+  XLS_ASSIGN_OR_RETURN(
+      Channel * in,
+      package->CreateStreamingChannel("in", ChannelOps::kReceiveOnly, type));
+  Channel* prev = in;
+  for (int64_t i = 0; i < hops; ++i) {
+    Channel* next;
+    if (i == hops - 1) {
+      XLS_ASSIGN_OR_RETURN(next,
+                           package->CreateStreamingChannel(
+                               "out", ChannelOps::kSendOnly, type));
+    } else {
+      XLS_ASSIGN_OR_RETURN(next, package->CreateStreamingChannel(
+                                     absl::StrFormat("link_%d", i),
+                                     ChannelOps::kSendReceive, type));
+    }
+    TokenlessProcBuilder pb(absl::StrFormat("proc_%d", i), "tkn", package);
+    pb.Send(next, pb.Receive(prev));
+    XLS_RETURN_IF_ERROR(pb.Build({}).status());
+    prev = next;
+  }
+  return std::make_pair(in, prev);
+}
+
+void RunLinearChain(benchmark::State& state, RuntimeKind kind) {
+  const int64_t hops = state.range(0);
+  const int64_t bit_count = state.range(1);
+  Package package("benchmark");
+  auto [in, out] = BuildLinearChain(&package, hops, bit_count).value();
+  std::unique_ptr<SerialProcRuntime> runtime =
+      CreateRuntime(kind, &package).value();
+  ChannelQueue& in_queue = runtime->queue_manager().GetQueue(in);
+  ChannelQueue& out_queue = runtime->queue_manager().GetQueue(out);
+  const Value value(UBits(42, bit_count));
+  int64_t total_ticks = 0;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kValuesPerBatch; ++i) {
+      CHECK_OK(in_queue.Write(value));
+    }
+    absl::StatusOr<int64_t> ticks = runtime->TickUntilOutput(
+        absl::flat_hash_map<Channel*, int64_t>{{out, kValuesPerBatch}});
+    CHECK_OK(ticks.status());
+    total_ticks += *ticks;
+    for (int64_t i = 0; i < kValuesPerBatch; ++i) {
+      CHECK(out_queue.Read().has_value());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kValuesPerBatch * hops);
+  state.counters["ticks"] =
+      benchmark::Counter(total_ticks, benchmark::Counter::kIsRate);
+}
+
+void BM_LinearChainInterpreter(benchmark::State& state) {
+  RunLinearChain(state, RuntimeKind::kInterpreter);
+}
+
+void BM_LinearChainJit(benchmark::State& state) {
+  RunLinearChain(state, RuntimeKind::kJit);
+}
+
+// Builds a fan-out topology: a distributor proc broadcasts each input value
+// to `width` forwarder procs, each of which writes to its own output channel.
+//   in => distributor => link_i => forwarder_i => out_i    (i in [0, width))
+absl::StatusOr<std::pair<Channel*, std::vector<Channel*>>> BuildFanOut(
+    Package* package, int64_t width, int64_t bit_count) {
+  Type* type = package->GetBitsType(bit_count);
+  XLS_ASSIGN_OR_RETURN(
+      Channel * in,
+      package->CreateStreamingChannel("in", ChannelOps::kReceiveOnly, type));
+  std::vector<Channel*> links;
+  for (int64_t i = 0; i < width; ++i) {
+    XLS_ASSIGN_OR_RETURN(Channel * link, package->CreateStreamingChannel(
+                                             absl::StrFormat("link_%d", i),
+                                             ChannelOps::kSendReceive, type));
+    links.push_back(link);
+  }
+  TokenlessProcBuilder distributor("distributor", "tkn", package);
+  BValue input = distributor.Receive(in);
+  for (Channel* link : links) {
+    distributor.Send(link, input);
+  }
+  XLS_RETURN_IF_ERROR(distributor.Build({}).status());
+
+  std::vector<Channel*> outs;
+  for (int64_t i = 0; i < width; ++i) {
+    XLS_ASSIGN_OR_RETURN(Channel * out, package->CreateStreamingChannel(
+                                            absl::StrFormat("out_%d", i),
+                                            ChannelOps::kSendOnly, type));
+    outs.push_back(out);
+    TokenlessProcBuilder pb(absl::StrFormat("forwarder_%d", i), "tkn",
+                            package);
+    pb.Send(out, pb.Receive(links[i]));
+    XLS_RETURN_IF_ERROR(pb.Build({}).status());
+  }
+  return std::make_pair(in, outs);
+}
+
+void RunFanOut(benchmark::State& state, RuntimeKind kind) {
+  const int64_t width = state.range(0);
+  const int64_t bit_count = state.range(1);
+  Package package("benchmark");
+  auto [in, outs] = BuildFanOut(&package, width, bit_count).value();
+  std::unique_ptr<SerialProcRuntime> runtime =
+      CreateRuntime(kind, &package).value();
+  ChannelQueue& in_queue = runtime->queue_manager().GetQueue(in);
+  const Value value(UBits(42, bit_count));
+  absl::flat_hash_map<Channel*, int64_t> output_counts;
+  for (Channel* out : outs) {
+    output_counts[out] = kValuesPerBatch;
+  }
+  int64_t total_ticks = 0;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < kValuesPerBatch; ++i) {
+      CHECK_OK(in_queue.Write(value));
+    }
+    absl::StatusOr<int64_t> ticks = runtime->TickUntilOutput(output_counts);
+    CHECK_OK(ticks.status());
+    total_ticks += *ticks;
+    for (Channel* out : outs) {
+      ChannelQueue& out_queue = runtime->queue_manager().GetQueue(out);
+      for (int64_t i = 0; i < kValuesPerBatch; ++i) {
+        CHECK(out_queue.Read().has_value());
+      }
+    }
+  }
+  // Each input value crosses the distributor once and one forwarder per
+  // output.
+  state.SetItemsProcessed(state.iterations() * kValuesPerBatch * (width + 1));
+  state.counters["ticks"] =
+      benchmark::Counter(total_ticks, benchmark::Counter::kIsRate);
+}
+
+void BM_FanOutInterpreter(benchmark::State& state) {
+  RunFanOut(state, RuntimeKind::kInterpreter);
+}
+
+void BM_FanOutJit(benchmark::State& state) {
+  RunFanOut(state, RuntimeKind::kJit);
+}
+
+// Builds a fan-in topology: a collector proc receives one value from each of
+// `width` input channels, sums them, and sends the result to a single output
+// channel.
+absl::StatusOr<std::pair<std::vector<Channel*>, Channel*>> BuildFanIn(
+    Package* package, int64_t width, int64_t bit_count) {
+  Type* type = package->GetBitsType(bit_count);
+  std::vector<Channel*> ins;
+  for (int64_t i = 0; i < width; ++i) {
+    XLS_ASSIGN_OR_RETURN(Channel * in, package->CreateStreamingChannel(
+                                           absl::StrFormat("in_%d", i),
+                                           ChannelOps::kReceiveOnly, type));
+    ins.push_back(in);
+  }
+  XLS_ASSIGN_OR_RETURN(
+      Channel * out,
+      package->CreateStreamingChannel("out", ChannelOps::kSendOnly, type));
+  TokenlessProcBuilder pb("collector", "tkn", package);
+  BValue sum = pb.Receive(ins[0]);
+  for (int64_t i = 1; i < width; ++i) {
+    sum = pb.Add(sum, pb.Receive(ins[i]));
+  }
+  pb.Send(out, sum);
+  XLS_RETURN_IF_ERROR(pb.Build({}).status());
+  return std::make_pair(ins, out);
+}
+
+void RunFanIn(benchmark::State& state, RuntimeKind kind) {
+  const int64_t width = state.range(0);
+  const int64_t bit_count = state.range(1);
+  Package package("benchmark");
+  auto [ins, out] = BuildFanIn(&package, width, bit_count).value();
+  std::unique_ptr<SerialProcRuntime> runtime =
+      CreateRuntime(kind, &package).value();
+  ChannelQueue& out_queue = runtime->queue_manager().GetQueue(out);
+  const Value value(UBits(42, bit_count));
+  int64_t total_ticks = 0;
+  for (auto _ : state) {
+    for (Channel* in : ins) {
+      ChannelQueue& in_queue = runtime->queue_manager().GetQueue(in);
+      for (int64_t i = 0; i < kValuesPerBatch; ++i) {
+        CHECK_OK(in_queue.Write(value));
+      }
+    }
+    absl::StatusOr<int64_t> ticks = runtime->TickUntilOutput(
+        absl::flat_hash_map<Channel*, int64_t>{{out, kValuesPerBatch}});
+    CHECK_OK(ticks.status());
+    total_ticks += *ticks;
+    for (int64_t i = 0; i < kValuesPerBatch; ++i) {
+      CHECK(out_queue.Read().has_value());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kValuesPerBatch * width);
+  state.counters["ticks"] =
+      benchmark::Counter(total_ticks, benchmark::Counter::kIsRate);
+}
+
+void BM_FanInInterpreter(benchmark::State& state) {
+  RunFanIn(state, RuntimeKind::kInterpreter);
+}
+
+void BM_FanInJit(benchmark::State& state) {
+  RunFanIn(state, RuntimeKind::kJit);
+}
+
+// Arguments are (topology size, value bit count). The bit-count axis covers
+// small scalar values through wide multi-word values.
+#define PROC_NETWORK_BENCHMARK_ARGS(name) \
+  BENCHMARK(name)                         \
+      ->ArgPair(1, 32)                    \
+      ->ArgPair(4, 32)                    \
+      ->ArgPair(16, 32)                   \
+      ->ArgPair(4, 1)                     \
+      ->ArgPair(4, 256)                   \
+      ->ArgPair(4, 2048)
+
+PROC_NETWORK_BENCHMARK_ARGS(BM_LinearChainInterpreter);
+PROC_NETWORK_BENCHMARK_ARGS(BM_LinearChainJit);
+PROC_NETWORK_BENCHMARK_ARGS(BM_FanOutInterpreter);
+PROC_NETWORK_BENCHMARK_ARGS(BM_FanOutJit);
+PROC_NETWORK_BENCHMARK_ARGS(BM_FanInInterpreter);
+PROC_NETWORK_BENCHMARK_ARGS(BM_FanInJit);
+
+#undef PROC_NETWORK_BENCHMARK_ARGS
+
+}  // namespace
+}  // namespace xls
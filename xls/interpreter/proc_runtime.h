@@ -24,6 +24,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "xls/interpreter/channel_queue.h"
+#include "xls/interpreter/channel_queue_stats.pb.h"
 #include "xls/interpreter/proc_evaluator.h"
 #include "xls/ir/elaboration.h"
 #include "xls/ir/events.h"
@@ -75,6 +76,19 @@ class ProcRuntime {
 
   ChannelQueueManager& queue_manager() { return *queue_manager_; }
 
+  // Enables collection of per-queue occupancy and blocking statistics. See
+  // ChannelQueue::EnableStatsCollection. Collection is off by default.
+  void EnableChannelStatsCollection() {
+    queue_manager_->EnableStatsCollection();
+  }
+
+  // Returns the per-queue statistics collected since collection was enabled.
+  // Typically inspected after a Tick/TickUntilOutput/TickUntilBlocked loop to
+  // find the queue which throttles a large proc network.
+  ChannelQueueManagerStatsProto GetChannelStats() const {
+    return queue_manager_->GetStats();
+  }
+
   // If the contained Channel queue manager is a JitChannelQueueManager then
   // return it. Otherwise raise an error.
   // TODO(meheff): 2022/10/26 Determine if there is a way of eliminating this
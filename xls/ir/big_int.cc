@@ -34,6 +34,24 @@
 #include "xls/ir/bits.h"
 
 namespace xls {
+namespace {
+
+// Returns a lazily-created, thread-local BN_CTX used as scratch space by the
+// BIGNUM operations which require one. Creating (and tearing down) a fresh
+// BN_CTX per operation showed up in fold-dominated passes; reusing one per
+// thread keeps the scratch BIGNUMs pooled across calls. Thread-local storage
+// avoids any locking; BigInt operations may run concurrently.
+BN_CTX* GetScratchCtx() {
+  struct CtxHolder {
+    CtxHolder() : ctx(BN_CTX_new()) { CHECK(ctx != nullptr); }
+    ~CtxHolder() { BN_CTX_free(ctx); }
+    BN_CTX* ctx;
+  };
+  thread_local CtxHolder holder;
+  return holder.ctx;
+}
+
+}  // namespace
 
 BigInt::BigInt() { BN_init(&bn_); }
 
@@ -252,10 +270,7 @@ int64_t BigInt::UnsignedBitCount() const {
   BigInt value;
   // Note: The documentation about BN_CTX in bn.h indicates that it's possible
   // to pass null to public methods that take a BN_CTX*, but that's not true.
-  BN_CTX* ctx = BN_CTX_new();
-  CHECK(ctx);
-  CHECK(BN_mul(&value.bn_, &lhs.bn_, &rhs.bn_, ctx));
-  BN_CTX_free(ctx);
+  CHECK(BN_mul(&value.bn_, &lhs.bn_, &rhs.bn_, GetScratchCtx()));
   return value;
 }
 
@@ -263,10 +278,8 @@ int64_t BigInt::UnsignedBitCount() const {
   BigInt value;
   // Note: The documentation about BN_CTX in bn.h indicates that it's possible
   // to pass null to public methods that take a BN_CTX*, but that's not true.
-  BN_CTX* ctx = BN_CTX_new();
-  CHECK(ctx);
-  CHECK(BN_div(&value.bn_, /*rem=*/nullptr, &lhs.bn_, &rhs.bn_, ctx));
-  BN_CTX_free(ctx);
+  CHECK(BN_div(&value.bn_, /*rem=*/nullptr, &lhs.bn_, &rhs.bn_,
+               GetScratchCtx()));
   return value;
 }
 
@@ -274,11 +287,8 @@ int64_t BigInt::UnsignedBitCount() const {
   BigInt value;
   // Note: The documentation about BN_CTX in bn.h indicates that it's possible
   // to pass null to public methods that take a BN_CTX*, but that's not true.
-  BN_CTX* ctx = BN_CTX_new();
-  CHECK(ctx);
   CHECK(BN_div(/*quotient=*/nullptr, /*rem=*/&value.bn_, &lhs.bn_, &rhs.bn_,
-               ctx));
-  BN_CTX_free(ctx);
+               GetScratchCtx()));
   return value;
 }
 
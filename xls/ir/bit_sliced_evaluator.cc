@@ -0,0 +1,60 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/bit_sliced_evaluator.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "xls/ir/bits.h"
+
+namespace xls {
+
+BitSlicedEvaluator::Vector PackLanes(absl::Span<const Bits> lane_values) {
+  CHECK(!lane_values.empty());
+  CHECK_LE(lane_values.size(), BitSlicedEvaluator::kNumLanes);
+  int64_t bit_count = lane_values.front().bit_count();
+  BitSlicedEvaluator::Vector result(bit_count, 0);
+  for (int64_t lane = 0; lane < lane_values.size(); ++lane) {
+    const Bits& value = lane_values[lane];
+    CHECK_EQ(value.bit_count(), bit_count);
+    for (int64_t b = 0; b < bit_count; ++b) {
+      if (value.Get(b)) {
+        result[b] |= uint64_t{1} << lane;
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<Bits> UnpackLanes(absl::Span<const uint64_t> elements,
+                              int64_t lane_count) {
+  CHECK_GT(lane_count, 0);
+  CHECK_LE(lane_count, BitSlicedEvaluator::kNumLanes);
+  std::vector<Bits> result;
+  result.reserve(lane_count);
+  for (int64_t lane = 0; lane < lane_count; ++lane) {
+    absl::InlinedVector<bool, 64> bits(elements.size());
+    for (int64_t b = 0; b < elements.size(); ++b) {
+      bits[b] = (elements[b] >> lane) & 1;
+    }
+    result.push_back(Bits(bits));
+  }
+  return result;
+}
+
+}  // namespace xls
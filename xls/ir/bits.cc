@@ -112,15 +112,7 @@ absl::InlinedVector<bool, 1> Bits::ToBitVector() const {
 
 bool Bits::IsOne() const { return PopCount() == 1 && Get(0); }
 
-int64_t Bits::PopCount() const {
-  int64_t count = 0;
-  for (int64_t i = 0; i < bit_count(); ++i) {
-    if (Get(i)) {
-      ++count;
-    }
-  }
-  return count;
-}
+int64_t Bits::PopCount() const { return bitmap_.CountOnes(); }
 
 int64_t Bits::CountLeadingZeros() const {
   for (int64_t i = 0; i < bit_count(); ++i) {
@@ -141,12 +133,7 @@ int64_t Bits::CountLeadingOnes() const {
 }
 
 int64_t Bits::CountTrailingZeros() const {
-  for (int64_t i = 0; i < bit_count(); ++i) {
-    if (Get(i)) {
-      return i;
-    }
-  }
-  return bit_count();
+  return bitmap_.FindNextSetBit(0).value_or(bit_count());
 }
 
 int64_t Bits::CountTrailingOnes() const {
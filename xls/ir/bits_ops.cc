@@ -50,6 +50,41 @@ Bits TruncateOrSignExtend(Bits bits, int64_t bit_count) {
   return Truncate(std::move(bits), bit_count);
 }
 
+using int128 = __int128;
+using uint128 = unsigned __int128;
+
+// Reads a value of up to 128 bits as an unsigned 128-bit integer.
+uint128 ToUint128(const Bits& bits) {
+  DCHECK_LE(bits.bit_count(), 128);
+  uint128 value = bits.bitmap().GetWord(0);
+  if (bits.bit_count() > 64) {
+    value |= static_cast<uint128>(bits.bitmap().GetWord(1)) << 64;
+  }
+  return value;
+}
+
+// As above, but sign-extends the (twos-complement) value to 128 bits.
+int128 ToInt128(const Bits& bits) {
+  uint128 value = ToUint128(bits);
+  if (bits.bit_count() > 0 && bits.bit_count() < 128 && bits.msb()) {
+    value |= ~uint128{0} << bits.bit_count();
+  }
+  return static_cast<int128>(value);
+}
+
+// Builds a Bits of `bit_count` (at most 128) from the low bits of `value`.
+Bits FromUint128(uint128 value, int64_t bit_count) {
+  DCHECK_LE(bit_count, 128);
+  InlineBitmap bitmap(bit_count);
+  if (bit_count > 0) {
+    bitmap.SetWord(0, static_cast<uint64_t>(value));
+  }
+  if (bit_count > 64) {
+    bitmap.SetWord(1, static_cast<uint64_t>(value >> 64));
+  }
+  return Bits::FromBitmap(std::move(bitmap));
+}
+
 }  // namespace
 
 Bits And(const Bits& lhs, const Bits& rhs) {
@@ -58,12 +93,9 @@ Bits And(const Bits& lhs, const Bits& rhs) {
     return UBits(lhs.ToUint64().value() & rhs.ToUint64().value(),
                  lhs.bit_count());
   }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = bytes[i] & rhs_bytes[i];
-  }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.Intersect(rhs.bitmap());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryAnd(absl::Span<const Bits> operands) {
@@ -82,12 +114,9 @@ Bits Or(const Bits& lhs, const Bits& rhs) {
     uint64_t result = (lhs_int | rhs_int);
     return UBits(result, lhs.bit_count());
   }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = bytes[i] | rhs_bytes[i];
-  }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.Union(rhs.bitmap());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryOr(absl::Span<const Bits> operands) {
@@ -106,12 +135,9 @@ Bits Xor(const Bits& lhs, const Bits& rhs) {
     uint64_t result = (lhs_int ^ rhs_int);
     return UBits(result, lhs.bit_count());
   }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = bytes[i] ^ rhs_bytes[i];
-  }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.Xor(rhs.bitmap());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryXor(absl::Span<const Bits> operands) {
@@ -129,12 +155,12 @@ Bits Nand(const Bits& lhs, const Bits& rhs) {
                      Mask(lhs.bit_count()),
                  lhs.bit_count());
   }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = ~(bytes[i] & rhs_bytes[i]);
+  InlineBitmap result = lhs.bitmap();
+  for (int64_t i = 0; i < result.word_count(); ++i) {
+    // SetWord masks off the bits beyond the width of the bitmap.
+    result.SetWord(i, ~(result.GetWord(i) & rhs.bitmap().GetWord(i)));
   }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryNand(absl::Span<const Bits> operands) {
@@ -152,12 +178,11 @@ Bits Nor(const Bits& lhs, const Bits& rhs) {
                      Mask(lhs.bit_count()),
                  lhs.bit_count());
   }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = ~(bytes[i] | rhs_bytes[i]);
+  InlineBitmap result = lhs.bitmap();
+  for (int64_t i = 0; i < result.word_count(); ++i) {
+    result.SetWord(i, ~(result.GetWord(i) | rhs.bitmap().GetWord(i)));
   }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryNor(absl::Span<const Bits> operands) {
@@ -173,11 +198,11 @@ Bits Not(const Bits& bits) {
     return UBits((~bits.ToUint64().value()) & Mask(bits.bit_count()),
                  bits.bit_count());
   }
-  std::vector<uint8_t> bytes = bits.ToBytes();
-  for (uint8_t& byte : bytes) {
-    byte = ~byte;
+  InlineBitmap result = bits.bitmap();
+  for (int64_t i = 0; i < result.word_count(); ++i) {
+    result.SetWord(i, ~result.GetWord(i));
   }
-  return Bits::FromBytes(bytes, bits.bit_count());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits AndReduce(const Bits& operand) {
@@ -204,9 +229,20 @@ Bits Add(const Bits& lhs, const Bits& rhs) {
     return UBits(result, lhs.bit_count());
   }
 
-  Bits sum = BigInt::Add(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs))
-                 .ToSignedBits();
-  return TruncateOrSignExtend(std::move(sum), lhs.bit_count());
+  // Word-wise ripple-carry addition over the backing bitmaps. The final
+  // SetWord masks the excess bits of the last word which performs the
+  // truncation to the result width.
+  InlineBitmap result = lhs.bitmap();
+  uint64_t carry = 0;
+  for (int64_t i = 0; i < result.word_count(); ++i) {
+    uint64_t lhs_word = result.GetWord(i);
+    uint64_t partial = lhs_word + rhs.bitmap().GetWord(i);
+    uint64_t sum = partial + carry;
+    carry = static_cast<uint64_t>(partial < lhs_word) |
+            static_cast<uint64_t>(sum < partial);
+    result.SetWord(i, sum);
+  }
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits Sub(const Bits& lhs, const Bits& rhs) {
@@ -217,9 +253,18 @@ Bits Sub(const Bits& lhs, const Bits& rhs) {
     uint64_t result = (lhs_int - rhs_int) & Mask(lhs.bit_count());
     return UBits(result, lhs.bit_count());
   }
-  Bits diff = BigInt::Sub(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs))
-                  .ToSignedBits();
-  return TruncateOrSignExtend(std::move(diff), lhs.bit_count());
+  // Word-wise subtraction with borrow, mirroring Add above.
+  InlineBitmap result = lhs.bitmap();
+  uint64_t borrow = 0;
+  for (int64_t i = 0; i < result.word_count(); ++i) {
+    uint64_t lhs_word = result.GetWord(i);
+    uint64_t partial = lhs_word - rhs.bitmap().GetWord(i);
+    uint64_t diff = partial - borrow;
+    borrow = static_cast<uint64_t>(partial > lhs_word) |
+             static_cast<uint64_t>(diff > partial);
+    result.SetWord(i, diff);
+  }
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits Increment(const Bits& x) {
@@ -256,6 +301,13 @@ Bits SMul(const Bits& lhs, const Bits& rhs) {
     int64_t result = lhs_int * rhs_int;
     return SBits(result, result_width);
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    // A 64x64-bit signed product fits in 128 bits; its twos-complement
+    // representation truncated to result_width bits is exact.
+    int128 product = static_cast<int128>(lhs.ToInt64().value()) *
+                     static_cast<int128>(rhs.ToInt64().value());
+    return FromUint128(static_cast<uint128>(product), result_width);
+  }
 
   BigInt product =
       BigInt::Mul(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs));
@@ -270,6 +322,11 @@ Bits UMul(const Bits& lhs, const Bits& rhs) {
     uint64_t result = lhs_int * rhs_int;
     return UBits(result, result_width);
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    uint128 product = static_cast<uint128>(lhs.ToUint64().value()) *
+                      static_cast<uint128>(rhs.ToUint64().value());
+    return FromUint128(product, result_width);
+  }
 
   BigInt product =
       BigInt::Mul(BigInt::MakeUnsigned(lhs), BigInt::MakeUnsigned(rhs));
@@ -280,6 +337,13 @@ Bits UDiv(const Bits& lhs, const Bits& rhs) {
   if (rhs.IsZero()) {
     return Bits::AllOnes(lhs.bit_count());
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    uint64_t result = lhs.ToUint64().value() / rhs.ToUint64().value();
+    return UBits(result, lhs.bit_count());
+  }
+  if (lhs.bit_count() <= 128 && rhs.bit_count() <= 128) {
+    return FromUint128(ToUint128(lhs) / ToUint128(rhs), lhs.bit_count());
+  }
   BigInt quotient =
       BigInt::Div(BigInt::MakeUnsigned(lhs), BigInt::MakeUnsigned(rhs));
   return ZeroExtend(quotient.ToUnsignedBits(), lhs.bit_count());
@@ -289,6 +353,13 @@ Bits UMod(const Bits& lhs, const Bits& rhs) {
   if (rhs.IsZero()) {
     return Bits(rhs.bit_count());
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    uint64_t result = lhs.ToUint64().value() % rhs.ToUint64().value();
+    return UBits(result, rhs.bit_count());
+  }
+  if (lhs.bit_count() <= 128 && rhs.bit_count() <= 128) {
+    return FromUint128(ToUint128(lhs) % ToUint128(rhs), rhs.bit_count());
+  }
   BigInt modulo =
       BigInt::Mod(BigInt::MakeUnsigned(lhs), BigInt::MakeUnsigned(rhs));
   return ZeroExtend(modulo.ToUnsignedBits(), rhs.bit_count());
@@ -308,6 +379,30 @@ Bits SDiv(const Bits& lhs, const Bits& rhs) {
     // 0b0111...111.
     return ZeroExtend(Bits::AllOnes(lhs.bit_count() - 1), lhs.bit_count());
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    // Compute on magnitudes to sidestep signed-overflow of INT64_MIN / -1; the
+    // result is truncated to lhs.bit_count() via unsigned wraparound.
+    int64_t lhs_int = lhs.ToInt64().value();
+    int64_t rhs_int = rhs.ToInt64().value();
+    uint64_t lhs_mag = lhs_int < 0 ? -static_cast<uint64_t>(lhs_int) : lhs_int;
+    uint64_t rhs_mag = rhs_int < 0 ? -static_cast<uint64_t>(rhs_int) : rhs_int;
+    uint64_t quotient_mag = lhs_mag / rhs_mag;
+    uint64_t result =
+        (lhs_int < 0) != (rhs_int < 0) ? -quotient_mag : quotient_mag;
+    return UBits(result & Mask(lhs.bit_count()), lhs.bit_count());
+  }
+  if (lhs.bit_count() <= 128 && rhs.bit_count() <= 128) {
+    int128 lhs_int = ToInt128(lhs);
+    int128 rhs_int = ToInt128(rhs);
+    uint128 lhs_mag = lhs_int < 0 ? -static_cast<uint128>(lhs_int)
+                                  : static_cast<uint128>(lhs_int);
+    uint128 rhs_mag = rhs_int < 0 ? -static_cast<uint128>(rhs_int)
+                                  : static_cast<uint128>(rhs_int);
+    uint128 quotient_mag = lhs_mag / rhs_mag;
+    uint128 result =
+        (lhs_int < 0) != (rhs_int < 0) ? -quotient_mag : quotient_mag;
+    return FromUint128(result, lhs.bit_count());
+  }
   BigInt quotient =
       BigInt::Div(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs));
   return TruncateOrSignExtend(quotient.ToSignedBits(), lhs.bit_count());
@@ -317,6 +412,28 @@ Bits SMod(const Bits& lhs, const Bits& rhs) {
   if (rhs.IsZero()) {
     return Bits(rhs.bit_count());
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    // As in SDiv, compute on magnitudes; the remainder takes the sign of the
+    // dividend.
+    int64_t lhs_int = lhs.ToInt64().value();
+    int64_t rhs_int = rhs.ToInt64().value();
+    uint64_t lhs_mag = lhs_int < 0 ? -static_cast<uint64_t>(lhs_int) : lhs_int;
+    uint64_t rhs_mag = rhs_int < 0 ? -static_cast<uint64_t>(rhs_int) : rhs_int;
+    uint64_t modulo_mag = lhs_mag % rhs_mag;
+    uint64_t result = lhs_int < 0 ? -modulo_mag : modulo_mag;
+    return UBits(result & Mask(rhs.bit_count()), rhs.bit_count());
+  }
+  if (lhs.bit_count() <= 128 && rhs.bit_count() <= 128) {
+    int128 lhs_int = ToInt128(lhs);
+    int128 rhs_int = ToInt128(rhs);
+    uint128 lhs_mag = lhs_int < 0 ? -static_cast<uint128>(lhs_int)
+                                  : static_cast<uint128>(lhs_int);
+    uint128 rhs_mag = rhs_int < 0 ? -static_cast<uint128>(rhs_int)
+                                  : static_cast<uint128>(rhs_int);
+    uint128 modulo_mag = lhs_mag % rhs_mag;
+    uint128 result = lhs_int < 0 ? -modulo_mag : modulo_mag;
+    return FromUint128(result, rhs.bit_count());
+  }
   BigInt modulo = BigInt::Mod(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs));
   return TruncateOrSignExtend(modulo.ToSignedBits(), rhs.bit_count());
 }
@@ -375,6 +492,9 @@ bool ULessThan(const Bits& lhs, int64_t rhs) {
 }
 
 bool SEqual(const Bits& lhs, const Bits& rhs) {
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    return lhs.ToInt64().value() == rhs.ToInt64().value();
+  }
   return BigInt::MakeSigned(lhs) == BigInt::MakeSigned(rhs);
 }
 
@@ -655,25 +775,85 @@ Bits MulpOffsetForSimulation(int64_t result_size, int64_t shift_size) {
   return offset_bits;
 }
 
-std::string BitsToRawDigits(const Bits& bits, FormatPreference preference,
-                            bool emit_leading_zeros) {
-  CHECK_NE(preference, FormatPreference::kDefault);
-  if (preference == FormatPreference::kSignedDecimal) {
-    // Leading zeros don't make a lot of sense in decimal format as there is no
-    // clean correspondence between decimal digits and binary digits.
-    CHECK(!emit_leading_zeros)
-        << "emit_leading_zeros not supported for decimal format.";
+namespace {
 
-    return BigInt::MakeSigned(bits).ToDecimalString();
+// Converts a magnitude held as little-endian 64-bit words to a decimal
+// string. Each round divides the whole word vector by 10^19 -- the largest
+// power of ten fitting in a 64-bit word -- peeling off 19 decimal digits at
+// once rather than converting bit by bit.
+std::string WordMagnitudeToDecimalString(std::vector<uint64_t> words) {
+  constexpr uint64_t kChunkDivisor = 10'000'000'000'000'000'000u;  // 10^19
+  while (!words.empty() && words.back() == 0) {
+    words.pop_back();
   }
+  if (words.empty()) {
+    return "0";
+  }
+  // Chunks of 19 decimal digits, least-significant chunk first.
+  std::vector<uint64_t> chunks;
+  while (!words.empty()) {
+    uint64_t remainder = 0;
+    for (int64_t i = words.size() - 1; i >= 0; --i) {
+      unsigned __int128 acc =
+          (static_cast<unsigned __int128>(remainder) << 64) | words[i];
+      words[i] = static_cast<uint64_t>(acc / kChunkDivisor);
+      remainder = static_cast<uint64_t>(acc % kChunkDivisor);
+    }
+    chunks.push_back(remainder);
+    while (!words.empty() && words.back() == 0) {
+      words.pop_back();
+    }
+  }
+  // The most significant chunk is emitted without padding; all lower chunks
+  // are exactly 19 digits wide.
+  std::string result = absl::StrCat(chunks.back());
+  for (int64_t i = chunks.size() - 2; i >= 0; --i) {
+    absl::StrAppendFormat(&result, "%019d", chunks[i]);
+  }
+  return result;
+}
 
-  if (preference == FormatPreference::kUnsignedDecimal) {
+// Returns the magnitude of `bits` as little-endian 64-bit words along with
+// whether the (twos-complement) value was negative.
+std::pair<std::vector<uint64_t>, bool> ToMagnitudeWords(const Bits& bits,
+                                                        bool is_signed) {
+  std::vector<uint64_t> words(bits.bitmap().word_count());
+  for (int64_t i = 0; i < static_cast<int64_t>(words.size()); ++i) {
+    words[i] = bits.bitmap().GetWord(i);
+  }
+  if (!is_signed || bits.bit_count() == 0 || !bits.msb()) {
+    return {std::move(words), false};
+  }
+  // Negative value: negate the twos-complement words to get the magnitude.
+  for (uint64_t& word : words) {
+    word = ~word;
+  }
+  if (int64_t top_bits = bits.bit_count() % 64; top_bits != 0) {
+    words.back() &= Mask(top_bits);
+  }
+  for (uint64_t& word : words) {
+    if (++word != 0) {
+      break;
+    }
+  }
+  return {std::move(words), true};
+}
+
+}  // namespace
+
+std::string BitsToRawDigits(const Bits& bits, FormatPreference preference,
+                            bool emit_leading_zeros) {
+  CHECK_NE(preference, FormatPreference::kDefault);
+  if (preference == FormatPreference::kSignedDecimal ||
+      preference == FormatPreference::kUnsignedDecimal) {
     // Leading zeros don't make a lot of sense in decimal format as there is no
     // clean correspondence between decimal digits and binary digits.
     CHECK(!emit_leading_zeros)
         << "emit_leading_zeros not supported for decimal format.";
-
-    return BigInt::MakeUnsigned(bits).ToDecimalString();
+    auto [words, negative] = ToMagnitudeWords(
+        bits, preference == FormatPreference::kSignedDecimal);
+    std::string magnitude = WordMagnitudeToDecimalString(std::move(words));
+    return negative ? absl::StrCat("-", magnitude) : magnitude;
   }
   if (bits.bit_count() == 0) {
     return "0";
@@ -696,23 +876,29 @@ std::string BitsToRawDigits(const Bits& bits, FormatPreference preference,
   const int64_t kSeparatorPeriod = 4;
 
   std::string result;
+  result.reserve(digit_count + digit_count / kSeparatorPeriod);
+  // Both digit widths (1 and 4) divide the 64-bit word size, so a digit never
+  // straddles a word boundary and can be read straight out of the bitmap with
+  // a shift and mask. Bits beyond bit_count() are invariantly zero in the
+  // bitmap, so a partial most-significant digit needs no special handling.
+  constexpr char kHexDigits[] = "0123456789abcdef";
+  const uint64_t digit_mask = Mask(digit_width);
+  const InlineBitmap& bitmap = bits.bitmap();
   bool eliding_leading_zeros = !emit_leading_zeros;
   for (int64_t digit_no = digit_count - 1; digit_no >= 0; --digit_no) {
+    const int64_t start = digit_no * digit_width;
+    const uint64_t digit_value =
+        (bitmap.GetWord(start / 64) >> (start % 64)) & digit_mask;
+    if (digit_value == 0 && eliding_leading_zeros && digit_no != 0) {
+      continue;
+    }
     // If including separators, add one every kSeparatorPeriod digits.
     if (include_separators && ((digit_no + 1) % kSeparatorPeriod == 0) &&
         !result.empty()) {
-      absl::StrAppend(&result, "_");
-    }
-    // Slice out a Bits which contains 1 digit.
-    int64_t start = digit_no * digit_width;
-    int64_t width = std::min(digit_width, bits.bit_count() - start);
-    // As single digit necessarily fits in a uint64_t, so the value() is safe.
-    uint64_t digit_value = bits.Slice(start, width).ToUint64().value();
-    if (digit_value == 0 && eliding_leading_zeros && digit_no != 0) {
-      continue;
+      result.push_back('_');
     }
     eliding_leading_zeros = false;
-    absl::StrAppend(&result, absl::StrFormat("%x", digit_value));
+    result.push_back(kHexDigits[digit_value]);
   }
   return result;
 }
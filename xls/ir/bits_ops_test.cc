@@ -269,6 +269,12 @@ TEST(BitsOpsTest, UDiv) {
   EXPECT_EQ(bits_ops::UDiv(UBits(10, 4), UBits(0, 4)), UBits(15, 4));
   EXPECT_EQ(bits_ops::UDiv(UBits(123456, 64), UBits(0, 20)), Bits::AllOnes(64));
 
+  // Operands of 65-128 bits take the 128-bit fast path.
+  XLS_ASSERT_OK_AND_ASSIGN(Bits lhs_66, ParseNumber("0x2_0000_0000_0000_0006"));
+  EXPECT_EQ(BitsToString(bits_ops::UDiv(lhs_66, UBits(2, 3)),
+                         FormatPreference::kHex),
+            "0x1_0000_0000_0000_0003");
+
   // Test wide values.
   XLS_ASSERT_OK_AND_ASSIGN(
       Bits wide_lhs,
@@ -292,6 +298,10 @@ TEST(BitsOpsTest, UMod) {
   EXPECT_EQ(bits_ops::UMod(UBits(10, 4), UBits(0, 4)), Bits(4));
   EXPECT_EQ(bits_ops::UMod(UBits(123456, 64), UBits(0, 20)), Bits(20));
 
+  // Operands of 65-128 bits take the 128-bit fast path.
+  XLS_ASSERT_OK_AND_ASSIGN(Bits lhs_66, ParseNumber("0x2_0000_0000_0000_0007"));
+  EXPECT_EQ(bits_ops::UMod(lhs_66, UBits(4, 3)), UBits(3, 3));
+
   // Test wide values.
   XLS_ASSERT_OK_AND_ASSIGN(
       Bits wide_lhs,
@@ -306,6 +316,8 @@ TEST(BitsOpsTest, UMod) {
 
 TEST(BitsOpsTest, SDiv) {
   EXPECT_EQ(bits_ops::SDiv(SBits(100, 64), SBits(5, 64)), SBits(20, 64));
+  // Operands of 65-128 bits take the 128-bit fast path.
+  EXPECT_EQ(bits_ops::SDiv(SBits(-100, 70), SBits(5, 70)), SBits(-20, 70));
   EXPECT_EQ(bits_ops::SDiv(SBits(100, 64), SBits(-5, 64)), SBits(-20, 64));
   EXPECT_EQ(bits_ops::SDiv(SBits(-100, 64), SBits(-5, 64)), SBits(20, 64));
   EXPECT_EQ(bits_ops::SDiv(SBits(-100, 64), SBits(5, 64)), SBits(-20, 64));
@@ -323,6 +335,12 @@ TEST(BitsOpsTest, SDiv) {
   EXPECT_EQ(bits_ops::SDiv(SBits(0, 64), SBits(7, 32)), SBits(0, 64));
   EXPECT_EQ(bits_ops::SDiv(SBits(0, 64), SBits(-7, 32)), SBits(0, 64));
 
+  // Most negative value divided by -1 wraps back to itself after truncation.
+  EXPECT_EQ(bits_ops::SDiv(SBits(std::numeric_limits<int64_t>::min(), 64),
+                           SBits(-1, 64)),
+            SBits(std::numeric_limits<int64_t>::min(), 64));
+  EXPECT_EQ(bits_ops::SDiv(SBits(-8, 4), SBits(-1, 4)), SBits(-8, 4));
+
   // Divide by zero.
   EXPECT_EQ(bits_ops::SDiv(Bits(), Bits()), Bits());
   EXPECT_EQ(bits_ops::SDiv(SBits(5, 4), SBits(0, 4)), SBits(7, 4));
@@ -345,6 +363,8 @@ TEST(BitsOpsTest, SDiv) {
 }
 
 TEST(BitsOpsTest, SMod) {
+  // Operands of 65-128 bits take the 128-bit fast path.
+  EXPECT_EQ(bits_ops::SMod(SBits(-100, 70), SBits(7, 70)), SBits(-2, 70));
   EXPECT_EQ(bits_ops::SMod(SBits(100, 64), SBits(5, 64)), SBits(0, 64));
   EXPECT_EQ(bits_ops::SMod(SBits(100, 64), SBits(-5, 64)), SBits(0, 64));
   EXPECT_EQ(bits_ops::SMod(SBits(-100, 64), SBits(-5, 64)), SBits(0, 64));
@@ -363,6 +383,11 @@ TEST(BitsOpsTest, SMod) {
   EXPECT_EQ(bits_ops::SMod(SBits(0, 64), SBits(7, 32)), SBits(0, 32));
   EXPECT_EQ(bits_ops::SMod(SBits(0, 64), SBits(-7, 32)), SBits(0, 32));
 
+  // Most negative value modulo -1 is zero.
+  EXPECT_EQ(bits_ops::SMod(SBits(std::numeric_limits<int64_t>::min(), 64),
+                           SBits(-1, 64)),
+            SBits(0, 64));
+
   // Zero right hand side.
   EXPECT_EQ(bits_ops::SMod(Bits(), Bits()), Bits());
   EXPECT_EQ(bits_ops::SMod(SBits(5, 4), SBits(0, 4)), Bits(4));
@@ -965,6 +990,22 @@ TEST(BitsOpsTest, U128HighBit) {
               "-170141183460469231731687303715884105728");
 }
 
+TEST(BitsOpsTest, ToStringDecimalChunkBoundaries) {
+  // Decimal conversion peels off 19 digits (10^19) at a time; exercise values
+  // just around and exactly at chunk boundaries.
+  const uint64_t kTenTo19 = 10'000'000'000'000'000'000u;
+  TestDecimal(UBits(kTenTo19, 64), "10000000000000000000",
+              "-8446744073709551616");
+  TestDecimal(UBits(kTenTo19 - 1, 64), "9999999999999999999",
+              "-8446744073709551617");
+  // 10^38 spans three chunks with all-zero low chunks which must be emitted
+  // fully zero-padded.
+  const Bits ten_to_38 =
+      bits_ops::UMul(UBits(kTenTo19, 64), UBits(kTenTo19, 64));
+  const std::string expected = "1" + std::string(38, '0');
+  TestDecimal(ten_to_38, expected, expected);
+}
+
 TEST(BitsOpsTest, ToStringValue1U1) {
   Bits b1 = UBits(1, 1);
   EXPECT_EQ(BitsToString(b1, FormatPreference::kUnsignedDecimal), "1");
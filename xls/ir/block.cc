@@ -272,15 +272,15 @@ absl::Status Block::SetPortNameExactly(std::string_view name, Node* node) {
                             name));
       }
       // Pick a new name for n.
-      n->name_ = UniquifyNodeName(name);
+      n->SetNameDirectly(UniquifyNodeName(name));
       XLS_RET_CHECK_NE(n->GetName(), name);
-      node->name_ = name;
+      node->SetNameDirectly(name);
       return absl::OkStatus();
     }
   }
   // Ensure the name is known by the uniquer.
   UniquifyNodeName(name);
-  node->name_ = name;
+  node->SetNameDirectly(name);
   return absl::OkStatus();
 }
 
@@ -625,6 +625,7 @@ absl::StatusOr<Instantiation*> Block::AddInstantiation(
   instantiation_vec_.push_back(instantiation_ptr);
   instantiation_inputs_[instantiation_ptr] = {};
   instantiation_outputs_[instantiation_ptr] = {};
+  BumpInstantiationVersion();
 
   return instantiation_ptr;
 }
@@ -648,6 +649,7 @@ absl::Status Block::RemoveInstantiation(Instantiation* instantiation) {
   XLS_RET_CHECK(it != instantiation_vec_.end());
   instantiation_vec_.erase(it);
   instantiations_.erase(instantiation->name());
+  BumpInstantiationVersion();
   return absl::OkStatus();
 }
 
@@ -14,6 +14,8 @@
 
 #include "xls/ir/call_graph.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <optional>
 #include <string_view>
@@ -125,6 +127,26 @@ std::vector<FunctionBase*> FunctionsInPostOrder(Package* p) {
   return post_order;
 }
 
+std::vector<std::vector<FunctionBase*>> CallGraphLevels(Package* p) {
+  // The level of a FunctionBase is one greater than the maximum level of its
+  // callees (zero if it calls no functions). Walking the post order guarantees
+  // callee levels are computed before their callers'.
+  absl::flat_hash_map<FunctionBase*, int64_t> level_map;
+  std::vector<std::vector<FunctionBase*>> levels;
+  for (FunctionBase* f : FunctionsInPostOrder(p)) {
+    int64_t level = 0;
+    for (Function* callee : CalledFunctions(f)) {
+      level = std::max(level, level_map.at(callee) + 1);
+    }
+    level_map[f] = level;
+    if (level >= static_cast<int64_t>(levels.size())) {
+      levels.resize(level + 1);
+    }
+    levels[level].push_back(f);
+  }
+  return levels;
+}
+
 absl::StatusOr<Function*> CloneFunctionAndItsDependencies(
     Function* to_clone, std::string_view new_name, Package* target_package,
     absl::flat_hash_map<const Function*, Function*> call_remapping) {
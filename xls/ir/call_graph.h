@@ -42,6 +42,13 @@ absl::StatusOr<Function*> CloneFunctionAndItsDependencies(
 // returned before callee FunctionBases in the returned order.
 std::vector<FunctionBase*> FunctionsInPostOrder(Package* p);
 
+// Partitions the FunctionBases of package 'p' into levels such that every
+// FunctionBase only calls FunctionBases in strictly earlier levels. Levels are
+// returned callee-first, so processing levels in order and the members of each
+// level in parallel respects call-graph dependencies. FunctionBases within a
+// level are mutually independent.
+std::vector<std::vector<FunctionBase*>> CallGraphLevels(Package* p);
+
 // Returns a list of all the nodes which reference the given function as a
 // target.
 std::vector<Node*> GetNodesWhichCall(Function* f);
@@ -14,6 +14,8 @@
 
 #include "xls/ir/call_graph.h"
 
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "xls/common/status/matchers.h"
@@ -146,6 +148,44 @@ TEST_F(CallGraphTest, SeveralFunctions) {
   EXPECT_THAT(FunctionsInPostOrder(p.get()), UnorderedElementsAre(a, b, c, d));
 }
 
+TEST_F(CallGraphTest, CallGraphLevels) {
+  auto p = CreatePackage();
+  Type* u32 = p->GetBitsType(32);
+
+  Function* a;
+  {
+    FunctionBuilder fb("a", p.get());
+    fb.Param("x", u32);
+    XLS_ASSERT_OK_AND_ASSIGN(a, fb.Build());
+  }
+  Function* b;
+  {
+    FunctionBuilder fb("b", p.get());
+    BValue x = fb.Param("x", u32);
+    fb.Invoke({x}, a);
+    XLS_ASSERT_OK_AND_ASSIGN(b, fb.Build());
+  }
+  Function* c;
+  {
+    FunctionBuilder fb("c", p.get());
+    BValue x = fb.Param("x", u32);
+    fb.Invoke({x}, a);
+    XLS_ASSERT_OK_AND_ASSIGN(c, fb.Build());
+  }
+  Function* d;
+  {
+    FunctionBuilder fb("d", p.get());
+    BValue array = fb.Param("array", p->GetArrayType(42, u32));
+    fb.Map(array, b);
+    XLS_ASSERT_OK_AND_ASSIGN(d, fb.Build());
+  }
+  std::vector<std::vector<FunctionBase*>> levels = CallGraphLevels(p.get());
+  ASSERT_EQ(levels.size(), 3);
+  EXPECT_THAT(levels[0], ElementsAre(a));
+  EXPECT_THAT(levels[1], UnorderedElementsAre(b, c));
+  EXPECT_THAT(levels[2], ElementsAre(d));
+}
+
 TEST_F(CallGraphTest, CloneFunctionAndItsDependencies) {
   auto p = CreatePackage();
   Type* u32 = p->GetBitsType(32);
@@ -0,0 +1,335 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/deferred_trace.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "xls/common/math_util.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/events.h"
+#include "xls/ir/format_preference.h"
+#include "xls/ir/format_strings.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+// Magic number and version at the head of the binary trace file format.
+constexpr std::string_view kTraceFileMagic = "XLSTRACE";
+constexpr int64_t kTraceFileVersion = 1;
+
+// Tags identifying the kind of an encoded Value.
+constexpr uint8_t kBitsTag = 0;
+constexpr uint8_t kTupleTag = 1;
+constexpr uint8_t kArrayTag = 2;
+constexpr uint8_t kTokenTag = 3;
+
+// Appends `value` to `out` as eight little-endian bytes. `ContainerT` is a
+// byte container (std::string or std::vector<uint8_t>).
+template <typename ContainerT>
+void AppendLittleEndian64(ContainerT* out, int64_t value) {
+  uint64_t bits = static_cast<uint64_t>(value);
+  for (int64_t i = 0; i < 8; ++i) {
+    out->push_back(static_cast<typename ContainerT::value_type>(
+        (bits >> (8 * i)) & 0xff));
+  }
+}
+
+// Bounds-checked sequential reader over an encoded byte buffer.
+class ByteReader {
+ public:
+  explicit ByteReader(absl::Span<const uint8_t> data) : data_(data) {}
+
+  absl::StatusOr<uint8_t> ReadByte() {
+    XLS_ASSIGN_OR_RETURN(absl::Span<const uint8_t> bytes, ReadBytes(1));
+    return bytes[0];
+  }
+
+  absl::StatusOr<int64_t> ReadInt64() {
+    XLS_ASSIGN_OR_RETURN(absl::Span<const uint8_t> bytes, ReadBytes(8));
+    uint64_t bits = 0;
+    for (int64_t i = 0; i < 8; ++i) {
+      bits |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return static_cast<int64_t>(bits);
+  }
+
+  absl::StatusOr<absl::Span<const uint8_t>> ReadBytes(int64_t count) {
+    if (count < 0 || pos_ + count > static_cast<int64_t>(data_.size())) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Malformed trace data: cannot read %d bytes at offset %d of %d",
+          count, pos_, data_.size()));
+    }
+    absl::Span<const uint8_t> result = data_.subspan(pos_, count);
+    pos_ += count;
+    return result;
+  }
+
+  bool AtEnd() const { return pos_ == static_cast<int64_t>(data_.size()); }
+
+ private:
+  absl::Span<const uint8_t> data_;
+  int64_t pos_ = 0;
+};
+
+// Recursively encodes `value` onto the end of `out`.
+void EncodeValue(const Value& value, std::vector<uint8_t>* out) {
+  if (value.IsBits()) {
+    out->push_back(kBitsTag);
+    AppendLittleEndian64(out, value.bits().bit_count());
+    for (uint8_t byte : value.bits().ToBytes()) {
+      out->push_back(byte);
+    }
+    return;
+  }
+  if (value.IsToken()) {
+    out->push_back(kTokenTag);
+    return;
+  }
+  out->push_back(value.IsTuple() ? kTupleTag : kArrayTag);
+  AppendLittleEndian64(out, value.size());
+  for (const Value& element : value.elements()) {
+    EncodeValue(element, out);
+  }
+}
+
+// Recursively decodes a single Value from `reader`.
+absl::StatusOr<Value> DecodeValue(ByteReader& reader) {
+  XLS_ASSIGN_OR_RETURN(uint8_t tag, reader.ReadByte());
+  switch (tag) {
+    case kBitsTag: {
+      XLS_ASSIGN_OR_RETURN(int64_t bit_count, reader.ReadInt64());
+      if (bit_count < 0) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Malformed trace data: negative bit count %d", bit_count));
+      }
+      XLS_ASSIGN_OR_RETURN(absl::Span<const uint8_t> bytes,
+                           reader.ReadBytes(CeilOfRatio<int64_t>(bit_count, 8)));
+      return Value(Bits::FromBytes(bytes, bit_count));
+    }
+    case kTokenTag:
+      return Value::Token();
+    case kTupleTag:
+    case kArrayTag: {
+      XLS_ASSIGN_OR_RETURN(int64_t size, reader.ReadInt64());
+      if (size < 0) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Malformed trace data: negative element count %d", size));
+      }
+      std::vector<Value> elements;
+      elements.reserve(size);
+      for (int64_t i = 0; i < size; ++i) {
+        XLS_ASSIGN_OR_RETURN(Value element, DecodeValue(reader));
+        elements.push_back(std::move(element));
+      }
+      if (tag == kTupleTag) {
+        return Value::TupleOwned(std::move(elements));
+      }
+      return Value::Array(elements);
+    }
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Malformed trace data: unknown value tag %d", tag));
+  }
+}
+
+}  // namespace
+
+int64_t DeferredTraceBuffer::RegisterDescriptor(
+    absl::Span<const FormatStep> steps, int64_t verbosity) {
+  std::pair<std::string, int64_t> key(StepsToXlsFormatString(steps),
+                                      verbosity);
+  auto it = descriptor_ids_.find(key);
+  if (it != descriptor_ids_.end()) {
+    return it->second;
+  }
+  int64_t id = descriptors_.size();
+  descriptors_.push_back(
+      TraceDescriptor{.steps = std::vector<FormatStep>(steps.begin(),
+                                                       steps.end()),
+                      .verbosity = verbosity});
+  descriptor_ids_.insert({std::move(key), id});
+  return id;
+}
+
+absl::Status DeferredTraceBuffer::Record(int64_t descriptor_id,
+                                         absl::Span<const Value> args) {
+  XLS_RET_CHECK_GE(descriptor_id, 0);
+  XLS_RET_CHECK_LT(descriptor_id, descriptor_count());
+  const TraceDescriptor& descriptor = descriptors_[descriptor_id];
+  int64_t expected = OperandsExpectedByFormat(descriptor.steps);
+  if (static_cast<int64_t>(args.size()) != expected) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Trace format %s expects %d data operands, got %d",
+        StepsToXlsFormatString(descriptor.steps), expected, args.size()));
+  }
+  record_descriptor_ids_.push_back(descriptor_id);
+  record_arg_offsets_.push_back(arg_data_.size());
+  for (const Value& arg : args) {
+    EncodeValue(arg, &arg_data_);
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<Value>> DeferredTraceBuffer::DecodeRecordArgs(
+    int64_t index) const {
+  const TraceDescriptor& descriptor =
+      descriptors_[record_descriptor_ids_[index]];
+  int64_t arg_count = OperandsExpectedByFormat(descriptor.steps);
+  ByteReader reader(
+      absl::MakeConstSpan(arg_data_).subspan(record_arg_offsets_[index]));
+  std::vector<Value> args;
+  args.reserve(arg_count);
+  for (int64_t i = 0; i < arg_count; ++i) {
+    XLS_ASSIGN_OR_RETURN(Value arg, DecodeValue(reader));
+    args.push_back(std::move(arg));
+  }
+  return args;
+}
+
+absl::StatusOr<TraceMessage> DeferredTraceBuffer::FormatRecord(
+    int64_t index) const {
+  XLS_RET_CHECK_GE(index, 0);
+  XLS_RET_CHECK_LT(index, record_count());
+  const TraceDescriptor& descriptor =
+      descriptors_[record_descriptor_ids_[index]];
+  XLS_ASSIGN_OR_RETURN(std::vector<Value> args, DecodeRecordArgs(index));
+  std::string message;
+  auto arg_it = args.begin();
+  for (const FormatStep& step : descriptor.steps) {
+    if (std::holds_alternative<std::string>(step)) {
+      absl::StrAppend(&message, std::get<std::string>(step));
+    } else {
+      absl::StrAppend(
+          &message, arg_it->ToHumanString(std::get<FormatPreference>(step)));
+      ++arg_it;
+    }
+  }
+  return TraceMessage{.message = std::move(message),
+                      .verbosity = descriptor.verbosity};
+}
+
+absl::Status DeferredTraceBuffer::AppendMessagesTo(
+    InterpreterEvents* events) const {
+  for (int64_t i = 0; i < record_count(); ++i) {
+    XLS_ASSIGN_OR_RETURN(TraceMessage message, FormatRecord(i));
+    events->trace_msgs.push_back(std::move(message));
+  }
+  return absl::OkStatus();
+}
+
+std::string DeferredTraceBuffer::SerializeToString() const {
+  std::string out;
+  absl::StrAppend(&out, kTraceFileMagic);
+  AppendLittleEndian64(&out, kTraceFileVersion);
+
+  AppendLittleEndian64(&out, descriptor_count());
+  for (const TraceDescriptor& descriptor : descriptors_) {
+    AppendLittleEndian64(&out, descriptor.verbosity);
+    std::string format_string = StepsToXlsFormatString(descriptor.steps);
+    AppendLittleEndian64(&out, format_string.size());
+    absl::StrAppend(&out, format_string);
+  }
+
+  AppendLittleEndian64(&out, record_count());
+  for (int64_t descriptor_id : record_descriptor_ids_) {
+    AppendLittleEndian64(&out, descriptor_id);
+  }
+  for (int64_t offset : record_arg_offsets_) {
+    AppendLittleEndian64(&out, offset);
+  }
+
+  AppendLittleEndian64(&out, arg_data_.size());
+  out.append(reinterpret_cast<const char*>(arg_data_.data()),
+             arg_data_.size());
+  return out;
+}
+
+/* static */ absl::StatusOr<DeferredTraceBuffer>
+DeferredTraceBuffer::ParseFromString(std::string_view serialized) {
+  ByteReader reader(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+  XLS_ASSIGN_OR_RETURN(absl::Span<const uint8_t> magic,
+                       reader.ReadBytes(kTraceFileMagic.size()));
+  if (std::string_view(reinterpret_cast<const char*>(magic.data()),
+                       magic.size()) != kTraceFileMagic) {
+    return absl::InvalidArgumentError("Not a binary trace file");
+  }
+  XLS_ASSIGN_OR_RETURN(int64_t version, reader.ReadInt64());
+  if (version != kTraceFileVersion) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Unsupported trace file version %d (expected %d)", version,
+        kTraceFileVersion));
+  }
+
+  DeferredTraceBuffer buffer;
+  XLS_ASSIGN_OR_RETURN(int64_t descriptor_count, reader.ReadInt64());
+  XLS_RET_CHECK_GE(descriptor_count, 0);
+  for (int64_t i = 0; i < descriptor_count; ++i) {
+    XLS_ASSIGN_OR_RETURN(int64_t verbosity, reader.ReadInt64());
+    XLS_ASSIGN_OR_RETURN(int64_t length, reader.ReadInt64());
+    XLS_ASSIGN_OR_RETURN(absl::Span<const uint8_t> bytes,
+                         reader.ReadBytes(length));
+    std::string_view format_string(
+        reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    XLS_ASSIGN_OR_RETURN(std::vector<FormatStep> steps,
+                         ParseFormatString(format_string));
+    XLS_RET_CHECK_EQ(buffer.RegisterDescriptor(steps, verbosity), i)
+        << "Duplicate descriptor in trace file";
+  }
+
+  XLS_ASSIGN_OR_RETURN(int64_t record_count, reader.ReadInt64());
+  XLS_RET_CHECK_GE(record_count, 0);
+  buffer.record_descriptor_ids_.reserve(record_count);
+  for (int64_t i = 0; i < record_count; ++i) {
+    XLS_ASSIGN_OR_RETURN(int64_t descriptor_id, reader.ReadInt64());
+    XLS_RET_CHECK_GE(descriptor_id, 0);
+    XLS_RET_CHECK_LT(descriptor_id, descriptor_count);
+    buffer.record_descriptor_ids_.push_back(descriptor_id);
+  }
+  buffer.record_arg_offsets_.reserve(record_count);
+  for (int64_t i = 0; i < record_count; ++i) {
+    XLS_ASSIGN_OR_RETURN(int64_t offset, reader.ReadInt64());
+    XLS_RET_CHECK_GE(offset, 0);
+    buffer.record_arg_offsets_.push_back(offset);
+  }
+
+  XLS_ASSIGN_OR_RETURN(int64_t arg_data_size, reader.ReadInt64());
+  XLS_ASSIGN_OR_RETURN(absl::Span<const uint8_t> arg_data,
+                       reader.ReadBytes(arg_data_size));
+  buffer.arg_data_.assign(arg_data.begin(), arg_data.end());
+  for (int64_t offset : buffer.record_arg_offsets_) {
+    XLS_RET_CHECK_LE(offset, arg_data_size);
+  }
+  if (!reader.AtEnd()) {
+    return absl::InvalidArgumentError(
+        "Malformed trace file: trailing bytes after argument data");
+  }
+  return buffer;
+}
+
+}  // namespace xls
@@ -0,0 +1,102 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_IR_DEFERRED_TRACE_H_
+#define XLS_IR_DEFERRED_TRACE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/ir/events.h"
+#include "xls/ir/format_strings.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+
+// The format string and verbosity shared by all trace records produced by a
+// single trace statement. Registered once per statement in a
+// DeferredTraceBuffer and referenced by id from each record.
+struct TraceDescriptor {
+  std::vector<FormatStep> steps;
+  int64_t verbosity;
+};
+
+// A buffer of unformatted trace records. Instead of eagerly interpolating
+// every trace message into a string (the dominant cost of tracing in long
+// simulations), each record stores only a descriptor id and the raw argument
+// values in a compact columnar encoding. Records are formatted lazily when
+// displayed, and the buffer can be serialized to a binary trace file for
+// offline decoding (see xls/tools/trace_decoder_main.cc).
+class DeferredTraceBuffer {
+ public:
+  // Registers a format descriptor and returns its id. Descriptors with the
+  // same format string and verbosity are deduplicated.
+  int64_t RegisterDescriptor(absl::Span<const FormatStep> steps,
+                             int64_t verbosity);
+
+  // Appends a record of the given descriptor. Returns an error if `args` does
+  // not match the number of data operands expected by the descriptor's format
+  // string.
+  absl::Status Record(int64_t descriptor_id, absl::Span<const Value> args);
+
+  // Lazily formats the record at `index` into a trace message.
+  absl::StatusOr<TraceMessage> FormatRecord(int64_t index) const;
+
+  // Formats all records in the buffer and appends them to
+  // `events->trace_msgs` in record order.
+  absl::Status AppendMessagesTo(InterpreterEvents* events) const;
+
+  int64_t record_count() const { return record_descriptor_ids_.size(); }
+  int64_t descriptor_count() const { return descriptors_.size(); }
+  const TraceDescriptor& descriptor(int64_t id) const {
+    return descriptors_.at(id);
+  }
+
+  // Serializes the buffer to the binary trace file format. The format is
+  // versioned and self-contained: it carries the descriptor table (format
+  // strings and verbosities) followed by the descriptor-id column and the
+  // encoded argument values.
+  std::string SerializeToString() const;
+
+  // Deserializes a buffer produced by SerializeToString.
+  static absl::StatusOr<DeferredTraceBuffer> ParseFromString(
+      std::string_view serialized);
+
+ private:
+  // Decodes the arguments of the record at `index`.
+  absl::StatusOr<std::vector<Value>> DecodeRecordArgs(int64_t index) const;
+
+  std::vector<TraceDescriptor> descriptors_;
+  // Maps (XLS format string, verbosity) to descriptor id for deduplication.
+  absl::flat_hash_map<std::pair<std::string, int64_t>, int64_t>
+      descriptor_ids_;
+
+  // Columnar record storage. Record i consists of descriptor
+  // `record_descriptor_ids_[i]` and the arguments encoded in `arg_data_`
+  // starting at byte offset `record_arg_offsets_[i]`.
+  std::vector<int64_t> record_descriptor_ids_;
+  std::vector<int64_t> record_arg_offsets_;
+  std::vector<uint8_t> arg_data_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_IR_DEFERRED_TRACE_H_
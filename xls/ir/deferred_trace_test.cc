@@ -0,0 +1,109 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/deferred_trace.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/events.h"
+#include "xls/ir/format_strings.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+using status_testing::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+TEST(DeferredTraceTest, RecordAndFormatLazily) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<FormatStep> steps,
+                           ParseFormatString("x is {} and y is {:x}"));
+  DeferredTraceBuffer buffer;
+  int64_t id = buffer.RegisterDescriptor(steps, /*verbosity=*/1);
+  XLS_ASSERT_OK(
+      buffer.Record(id, {Value(UBits(42, 8)), Value(UBits(0xab, 8))}));
+  XLS_ASSERT_OK(buffer.Record(id, {Value(UBits(7, 8)), Value(UBits(1, 8))}));
+
+  EXPECT_EQ(buffer.record_count(), 2);
+  XLS_ASSERT_OK_AND_ASSIGN(TraceMessage first, buffer.FormatRecord(0));
+  EXPECT_EQ(first.message, "x is 42 and y is ab");
+  EXPECT_EQ(first.verbosity, 1);
+  XLS_ASSERT_OK_AND_ASSIGN(TraceMessage second, buffer.FormatRecord(1));
+  EXPECT_EQ(second.message, "x is 7 and y is 1");
+}
+
+TEST(DeferredTraceTest, DescriptorsAreDeduplicated) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<FormatStep> steps,
+                           ParseFormatString("value: {}"));
+  DeferredTraceBuffer buffer;
+  int64_t id = buffer.RegisterDescriptor(steps, /*verbosity=*/0);
+  EXPECT_EQ(buffer.RegisterDescriptor(steps, /*verbosity=*/0), id);
+  EXPECT_NE(buffer.RegisterDescriptor(steps, /*verbosity=*/3), id);
+  EXPECT_EQ(buffer.descriptor_count(), 2);
+}
+
+TEST(DeferredTraceTest, RecordRejectsWrongOperandCount) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<FormatStep> steps,
+                           ParseFormatString("{} and {}"));
+  DeferredTraceBuffer buffer;
+  int64_t id = buffer.RegisterDescriptor(steps, /*verbosity=*/0);
+  EXPECT_THAT(buffer.Record(id, {Value(UBits(1, 8))}),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("expects 2 data operands, got 1")));
+}
+
+TEST(DeferredTraceTest, SerializationRoundTrip) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<FormatStep> steps,
+                           ParseFormatString("compound: {}"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Value array, Value::Array({Value(UBits(1, 4)), Value(UBits(2, 4))}));
+  DeferredTraceBuffer buffer;
+  int64_t id = buffer.RegisterDescriptor(steps, /*verbosity=*/2);
+  XLS_ASSERT_OK(buffer.Record(id, {Value::Tuple({Value(UBits(3, 16)), array})}));
+  XLS_ASSERT_OK(buffer.Record(id, {Value::Token()}));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      DeferredTraceBuffer parsed,
+      DeferredTraceBuffer::ParseFromString(buffer.SerializeToString()));
+  EXPECT_EQ(parsed.descriptor_count(), 1);
+  EXPECT_EQ(parsed.record_count(), 2);
+
+  InterpreterEvents original_events;
+  InterpreterEvents parsed_events;
+  XLS_ASSERT_OK(buffer.AppendMessagesTo(&original_events));
+  XLS_ASSERT_OK(parsed.AppendMessagesTo(&parsed_events));
+  EXPECT_EQ(original_events, parsed_events);
+  EXPECT_THAT(original_events.trace_msgs,
+              ElementsAre(TraceMessage{.message = "compound: (3, [1, 2])",
+                                       .verbosity = 2},
+                          TraceMessage{.message = "compound: token",
+                                       .verbosity = 2}));
+}
+
+TEST(DeferredTraceTest, ParseRejectsNonTraceData) {
+  EXPECT_THAT(DeferredTraceBuffer::ParseFromString("not a trace file"),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Not a binary trace file")));
+}
+
+}  // namespace
+}  // namespace xls
@@ -26,6 +26,7 @@
 #include "absl/status/status.h"
 #include "xls/common/status/matchers.h"
 #include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
@@ -147,5 +148,26 @@ fn graph(p: bits[42], q: bits[42]) -> bits[42] {
   }
 }
 
+TEST_F(DfsVisitorTest, DeepDependencyChain) {
+  // Traversal must handle operand chains far deeper than the call stack
+  // allows; a recursive traversal overflows well before this depth.
+  constexpr int64_t kDepth = 100000;
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue value = fb.Param("x", p->GetBitsType(8));
+  for (int64_t i = 0; i < kDepth; ++i) {
+    value = fb.Not(value);
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(value));
+
+  TestVisitor v;
+  XLS_ASSERT_OK(f->return_value()->Accept(&v));
+  EXPECT_EQ(v.visited_count(), kDepth + 1);
+  // Post-order: the parameter at the bottom of the chain is visited first and
+  // the return value last.
+  EXPECT_EQ(v.visited().front(), f->param(0));
+  EXPECT_EQ(v.visited().back(), f->return_value());
+}
+
 }  // namespace
 }  // namespace xls
@@ -0,0 +1,161 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/elaboration_cache.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/block.h"
+#include "xls/ir/block_elaboration.h"
+#include "xls/ir/package.h"
+#include "xls/ir/proc.h"
+#include "xls/ir/proc_elaboration.h"
+
+namespace xls {
+namespace {
+
+bool SnapshotMatches(FunctionBase* live, FunctionBase* recorded,
+                     int64_t recorded_version) {
+  return live == recorded &&
+         live->instantiation_version() == recorded_version;
+}
+
+}  // namespace
+
+bool ElaborationCache::BlockEntryIsCurrent(Block* top) const {
+  auto it = block_entries_.find(top);
+  if (it == block_entries_.end()) {
+    return false;
+  }
+  Package* package = it->second.elaboration->package();
+  for (const Snapshot& snapshot : it->second.snapshots) {
+    std::optional<Block*> live = package->TryGetBlock(snapshot.name);
+    if (!live.has_value() ||
+        !SnapshotMatches(*live, snapshot.function_base,
+                         snapshot.instantiation_version)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ElaborationCache::ProcEntryIsCurrent(Proc* top) const {
+  auto it = proc_entries_.find(top);
+  if (it == proc_entries_.end()) {
+    return false;
+  }
+  Package* package = it->second.elaboration->package();
+  for (const Snapshot& snapshot : it->second.snapshots) {
+    std::optional<Proc*> live = package->TryGetProc(snapshot.name);
+    if (!live.has_value() ||
+        !SnapshotMatches(*live, snapshot.function_base,
+                         snapshot.instantiation_version)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+absl::StatusOr<const BlockElaboration*> ElaborationCache::GetBlockElaboration(
+    Block* top) {
+  if (!BlockEntryIsCurrent(top)) {
+    XLS_ASSIGN_OR_RETURN(BlockElaboration elaboration,
+                         BlockElaboration::Elaborate(top));
+    Entry<BlockElaboration>& entry = block_entries_[top];
+    entry.elaboration =
+        std::make_unique<BlockElaboration>(std::move(elaboration));
+    entry.snapshots.clear();
+    for (Block* block : entry.elaboration->blocks()) {
+      entry.snapshots.push_back(TakeSnapshot(block));
+    }
+  }
+  return block_entries_.at(top).elaboration.get();
+}
+
+absl::StatusOr<const ProcElaboration*> ElaborationCache::GetProcElaboration(
+    Proc* top) {
+  if (!ProcEntryIsCurrent(top)) {
+    XLS_ASSIGN_OR_RETURN(ProcElaboration elaboration,
+                         ProcElaboration::Elaborate(top));
+    Entry<ProcElaboration>& entry = proc_entries_[top];
+    entry.elaboration =
+        std::make_unique<ProcElaboration>(std::move(elaboration));
+    entry.snapshots.clear();
+    for (Proc* proc : entry.elaboration->procs()) {
+      entry.snapshots.push_back(TakeSnapshot(proc));
+    }
+  }
+  return proc_entries_.at(top).elaboration.get();
+}
+
+absl::Status ElaborationCache::PrepopulateBlocks(absl::Span<Block* const> tops,
+                                                int64_t worker_count) {
+  std::vector<Block*> stale;
+  for (Block* top : tops) {
+    if (!BlockEntryIsCurrent(top)) {
+      stale.push_back(top);
+    }
+  }
+  if (stale.empty()) {
+    return absl::OkStatus();
+  }
+  std::vector<absl::StatusOr<BlockElaboration>> elaborations(stale.size());
+  if (worker_count <= 1 || stale.size() == 1) {
+    for (int64_t i = 0; i < static_cast<int64_t>(stale.size()); ++i) {
+      elaborations[i] = BlockElaboration::Elaborate(stale[i]);
+    }
+  } else {
+    // Elaboration only reads the IR, so independent tops can be elaborated
+    // concurrently; the entries are inserted serially below.
+    std::atomic<int64_t> next_index = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (int64_t w = 0; w < worker_count; ++w) {
+      workers.push_back(std::thread([&]() {
+        for (int64_t i = next_index.fetch_add(1);
+             i < static_cast<int64_t>(stale.size());
+             i = next_index.fetch_add(1)) {
+          elaborations[i] = BlockElaboration::Elaborate(stale[i]);
+        }
+      }));
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(stale.size()); ++i) {
+    XLS_ASSIGN_OR_RETURN(BlockElaboration elaboration,
+                         std::move(elaborations[i]));
+    Entry<BlockElaboration>& entry = block_entries_[stale[i]];
+    entry.elaboration =
+        std::make_unique<BlockElaboration>(std::move(elaboration));
+    entry.snapshots.clear();
+    for (Block* block : entry.elaboration->blocks()) {
+      entry.snapshots.push_back(TakeSnapshot(block));
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace xls
@@ -0,0 +1,101 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_IR_ELABORATION_CACHE_H_
+#define XLS_IR_ELABORATION_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/ir/block.h"
+#include "xls/ir/block_elaboration.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/proc.h"
+#include "xls/ir/proc_elaboration.h"
+
+namespace xls {
+
+// Cache of proc and block elaborations keyed by top-level FunctionBase.
+// Elaborating a deep hierarchy is expensive and the result is rebuilt by
+// every pass or tool that needs instance information; this cache makes the
+// result shareable across the passes of a pipeline. Entries invalidate
+// themselves via FunctionBase::instantiation_version(), which is bumped only
+// by instantiation-structure mutations, so cached elaborations survive
+// ordinary node-level transformations.
+//
+// The cache itself is not thread-safe; Prepopulate() with worker_count > 1
+// constructs the independent elaborations on worker threads but inserts them
+// serially.
+class ElaborationCache {
+ public:
+  // Returns the elaboration rooted at `top`, recomputing it if the
+  // instantiation structure of any FunctionBase in the elaboration has
+  // changed since it was cached. The returned pointer is owned by the cache
+  // and must not be used after instantiations are mutated; call the getter
+  // again instead.
+  absl::StatusOr<const BlockElaboration*> GetBlockElaboration(Block* top);
+  absl::StatusOr<const ProcElaboration*> GetProcElaboration(Proc* top);
+
+  // Computes (up to `worker_count` tops at a time) and caches the elaboration
+  // for every block in `tops` whose cached entry is missing or stale. Wide
+  // hierarchies with many top-level blocks (e.g. codegen pipelines verifying
+  // every block) can warm the cache in parallel before serial processing.
+  absl::Status PrepopulateBlocks(absl::Span<Block* const> tops,
+                                 int64_t worker_count);
+
+  // Drops all cached elaborations.
+  void Clear() {
+    block_entries_.clear();
+    proc_entries_.clear();
+  }
+
+ private:
+  // Snapshot of one FunctionBase participating in an elaboration at
+  // computation time. The name guards against a deleted FunctionBase being
+  // reallocated at the same address.
+  struct Snapshot {
+    FunctionBase* function_base;
+    std::string name;
+    int64_t instantiation_version;
+  };
+
+  template <typename ElaborationT>
+  struct Entry {
+    std::unique_ptr<ElaborationT> elaboration;
+    // One snapshot per FunctionBase in the elaborated hierarchy.
+    std::vector<Snapshot> snapshots;
+  };
+
+  // Returns true if the cached entry for `top` (if any) was computed with the
+  // current instantiation structure of every FunctionBase it covers.
+  bool BlockEntryIsCurrent(Block* top) const;
+  bool ProcEntryIsCurrent(Proc* top) const;
+
+  static Snapshot TakeSnapshot(FunctionBase* f) {
+    return Snapshot{f, std::string(f->name()), f->instantiation_version()};
+  }
+
+  absl::flat_hash_map<Block*, Entry<BlockElaboration>> block_entries_;
+  absl::flat_hash_map<Proc*, Entry<ProcElaboration>> proc_entries_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_IR_ELABORATION_CACHE_H_
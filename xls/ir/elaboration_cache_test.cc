@@ -0,0 +1,111 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/elaboration_cache.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/block.h"
+#include "xls/ir/block_elaboration.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/proc.h"
+#include "xls/ir/proc_elaboration.h"
+#include "xls/ir/source_location.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+using ::testing::UnorderedElementsAre;
+
+class ElaborationCacheTest : public IrTestBase {};
+
+TEST_F(ElaborationCacheTest, BlockElaborationReuseAndInvalidation) {
+  auto p = CreatePackage();
+  Type* u32 = p->GetBitsType(32);
+
+  BlockBuilder sub_bb("sub", p.get());
+  sub_bb.OutputPort("c", sub_bb.Add(sub_bb.InputPort("a", u32),
+                                    sub_bb.InputPort("b", u32)));
+  XLS_ASSERT_OK_AND_ASSIGN(Block * sub, sub_bb.Build());
+
+  BlockBuilder top_bb("top", p.get());
+  top_bb.OutputPort("out", top_bb.InputPort("in", u32));
+  XLS_ASSERT_OK_AND_ASSIGN(Block * top, top_bb.Build());
+
+  ElaborationCache cache;
+  XLS_ASSERT_OK_AND_ASSIGN(const BlockElaboration* elab,
+                           cache.GetBlockElaboration(top));
+  EXPECT_THAT(elab->blocks(), UnorderedElementsAre(top));
+
+  // Node-level edits do not change the instantiation structure, so the cached
+  // elaboration is reused.
+  XLS_ASSERT_OK(
+      top->MakeNode<Literal>(SourceInfo(), Value(UBits(0, 1))).status());
+  XLS_ASSERT_OK_AND_ASSIGN(const BlockElaboration* again,
+                           cache.GetBlockElaboration(top));
+  EXPECT_EQ(elab, again);
+
+  // Adding an instantiation invalidates the entry.
+  XLS_ASSERT_OK(top->AddBlockInstantiation("sub_inst", sub).status());
+  XLS_ASSERT_OK_AND_ASSIGN(const BlockElaboration* fresh,
+                           cache.GetBlockElaboration(top));
+  EXPECT_THAT(fresh->blocks(), UnorderedElementsAre(top, sub));
+}
+
+TEST_F(ElaborationCacheTest, ProcElaborationReuse) {
+  auto p = CreatePackage();
+  TokenlessProcBuilder pb(NewStyleProc(), "top_proc", "tkn", p.get());
+  XLS_ASSERT_OK(
+      pb.AddInputChannel("in_ch", p->GetBitsType(32)).status());
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * top, pb.Build({}));
+
+  ElaborationCache cache;
+  XLS_ASSERT_OK_AND_ASSIGN(const ProcElaboration* elab,
+                           cache.GetProcElaboration(top));
+  EXPECT_THAT(elab->procs(), UnorderedElementsAre(top));
+  XLS_ASSERT_OK_AND_ASSIGN(const ProcElaboration* again,
+                           cache.GetProcElaboration(top));
+  EXPECT_EQ(elab, again);
+}
+
+TEST_F(ElaborationCacheTest, PrepopulateBlocks) {
+  auto p = CreatePackage();
+  Type* u32 = p->GetBitsType(32);
+  std::vector<Block*> tops;
+  for (int i = 0; i < 4; ++i) {
+    BlockBuilder bb(absl::StrCat("block_", i), p.get());
+    bb.OutputPort("out", bb.InputPort("in", u32));
+    XLS_ASSERT_OK_AND_ASSIGN(Block * block, bb.Build());
+    tops.push_back(block);
+  }
+
+  ElaborationCache cache;
+  XLS_ASSERT_OK(cache.PrepopulateBlocks(tops, /*worker_count=*/2));
+  for (Block* top : tops) {
+    XLS_ASSERT_OK_AND_ASSIGN(const BlockElaboration* elab,
+                             cache.GetBlockElaboration(top));
+    EXPECT_THAT(elab->blocks(), UnorderedElementsAre(top));
+  }
+}
+
+}  // namespace
+}  // namespace xls
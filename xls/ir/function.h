@@ -50,7 +50,16 @@ class Function : public FunctionBase {
     XLS_RET_CHECK_EQ(n->function_base(), this) << absl::StreamFormat(
         "Return value node %s is not in this function %s (is in function %s)",
         n->GetName(), name(), n->function_base()->name());
+    Node* old_return_value = return_value_;
     return_value_ = n;
+    // The return value affects topological orderings (it is scheduled last),
+    // so changing it invalidates any cached order.
+    BumpTransformVersion();
+    // The old return value may have lost its last (implicit) use.
+    if (old_return_value != nullptr) {
+      RecordNodeChange(old_return_value);
+    }
+    RecordNodeChange(n);
     return absl::OkStatus();
   }
 
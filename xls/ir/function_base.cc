@@ -15,9 +15,11 @@
 #include "xls/ir/function_base.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <string_view>
@@ -25,12 +27,14 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/types/span.h"
 #include "google/protobuf/text_format.h"
 #include "xls/common/casts.h"
 #include "xls/common/status/ret_check.h"
@@ -43,6 +47,7 @@
 #include "xls/ir/nodes.h"
 #include "xls/ir/package.h"
 #include "xls/ir/proc.h"
+#include "xls/ir/topo_sort.h"
 
 namespace xls {
 
@@ -119,7 +124,9 @@ absl::Status FunctionBase::RemoveNode(Node* node) {
   XLS_RET_CHECK(!HasImplicitUse(node)) << node->GetName();
   VLOG(4) << absl::StrFormat("Removing node from FunctionBase %s: %s", name(),
                              node->ToString());
-  ++package()->transform_metrics().nodes_removed;
+  package()->transform_metrics().nodes_removed.fetch_add(
+      1, std::memory_order_relaxed);
+  BumpTransformVersion();
   std::vector<Node*> unique_operands;
   for (Node* operand : node->operands()) {
     if (!absl::c_linear_search(unique_operands, operand)) {
@@ -128,7 +135,16 @@ absl::Status FunctionBase::RemoveNode(Node* node) {
   }
   for (Node* operand : unique_operands) {
     operand->RemoveUser(node);
+    // The operand may have lost its last user; record it so that incremental
+    // dead code elimination can find it.
+    RecordNodeChange(operand);
   }
+  // Assigned names live in a package-side table; drop the entry so it does
+  // not outlive the node.
+  if (node->HasAssignedName()) {
+    package()->ClearNodeName(node->id());
+  }
+  nodes_by_id_.erase(node->id());
   if (node->Is<Param>()) {
     params_.erase(std::remove(params_.begin(), params_.end(), node),
                   params_.end());
@@ -149,6 +165,60 @@ absl::Status FunctionBase::RemoveNode(Node* node) {
   return absl::OkStatus();
 }
 
+void FunctionBase::FinalizeNodeNames() {
+  if (!defer_node_name_uniquification_) {
+    return;
+  }
+  defer_node_name_uniquification_ = false;
+  // nodes() iterates in creation order, so names come out identical to those
+  // eager uniquification would have produced.
+  for (Node* node : nodes()) {
+    if (!node->HasAssignedName()) {
+      continue;
+    }
+    std::string unique_name =
+        node_name_uniquer_.GetSanitizedUniqueName(node->GetName());
+    if (unique_name != node->GetName()) {
+      node->SetNameDirectly(unique_name);
+    }
+  }
+}
+
+void FunctionBase::RecordNodeChange(Node* node) {
+  change_journal_.push_back(std::make_pair(transform_version_, node->id()));
+  while (change_journal_.size() > kChangeJournalCapacity) {
+    change_journal_start_version_ = std::max(change_journal_start_version_,
+                                             change_journal_.front().first);
+    change_journal_.pop_front();
+  }
+}
+
+std::optional<std::vector<int64_t>> FunctionBase::ChangedNodeIdsSince(
+    int64_t version) const {
+  if (version < change_journal_start_version_) {
+    return std::nullopt;
+  }
+  absl::flat_hash_set<int64_t> seen;
+  std::vector<int64_t> changed_ids;
+  // Entries are in version order; walk backwards until we reach entries from
+  // `version` or earlier.
+  for (auto it = change_journal_.rbegin();
+       it != change_journal_.rend() && it->first > version; ++it) {
+    if (seen.insert(it->second).second) {
+      changed_ids.push_back(it->second);
+    }
+  }
+  return changed_ids;
+}
+
+absl::Span<Node* const> FunctionBase::GetCachedTopoSort() {
+  if (cached_topo_sort_version_ != transform_version_) {
+    cached_topo_sort_ = TopoSort(this);
+    cached_topo_sort_version_ = transform_version_;
+  }
+  return cached_topo_sort_;
+}
+
 absl::Status FunctionBase::Accept(DfsVisitor* visitor) {
   for (Node* node : nodes()) {
     if (node->users().empty()) {
@@ -221,7 +291,9 @@ Block* FunctionBase::AsBlockOrDie() {
 Node* FunctionBase::AddNodeInternal(std::unique_ptr<Node> node) {
   VLOG(4) << absl::StrFormat("Adding node to FunctionBase %s: %s", name(),
                              node->ToString());
-  ++package()->transform_metrics().nodes_added;
+  package()->transform_metrics().nodes_added.fetch_add(
+      1, std::memory_order_relaxed);
+  BumpTransformVersion();
   if (node->Is<Param>()) {
     params_.push_back(node->As<Param>());
     next_values_by_param_[node->As<Param>()];
@@ -234,6 +306,8 @@ Node* FunctionBase::AddNodeInternal(std::unique_ptr<Node> node) {
   }
   Node* ptr = node.get();
   node_iterators_[ptr] = nodes_.insert(nodes_.end(), std::move(node));
+  nodes_by_id_[ptr->id()] = ptr;
+  RecordNodeChange(ptr);
   return ptr;
 }
 
@@ -16,16 +16,19 @@
 #define XLS_IR_FUNCTION_BASE_H_
 
 #include <cstdint>
+#include <deque>
 #include <list>
 #include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "absl/container/btree_set.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -46,6 +49,17 @@ namespace xls {
 class Function;
 class Proc;
 
+// Optional source of node ids for a FunctionBase. Installed via
+// FunctionBase::SetNodeIdSource, e.g. by a PackageShard which hands out ids
+// from per-shard reserved ranges during parallel IR construction.
+class NodeIdSource {
+ public:
+  virtual ~NodeIdSource() = default;
+
+  // Returns a package-unique id for a new node.
+  virtual int64_t GetNextNodeId() = 0;
+};
+
 // Base class for Functions and Procs. A holder of a set of nodes.
 class FunctionBase {
  protected:
@@ -60,6 +74,20 @@ class FunctionBase {
   virtual ~FunctionBase() = default;
 
   Package* package() const { return package_; }
+
+  // Returns the id to assign to a node created in this FunctionBase: drawn
+  // from the installed NodeIdSource if there is one, otherwise from the
+  // package's shared counter.
+  int64_t GetNextNodeId() {
+    return node_id_source_ == nullptr ? package_->GetNextNodeId()
+                                      : node_id_source_->GetNextNodeId();
+  }
+
+  // Sets the source from which node ids are drawn; pass nullptr to return to
+  // the package's shared counter. The source must outlive all node creation
+  // in this FunctionBase.
+  void SetNodeIdSource(NodeIdSource* source) { node_id_source_ = source; }
+
   const std::string& name() const { return name_; }
   void SetName(std::string_view name) { name_ = name; }
   std::string qualified_name() const {
@@ -103,6 +131,50 @@ class FunctionBase {
 
   int64_t node_count() const { return nodes_.size(); }
 
+  // Monotonically increasing counter which is bumped on every structural
+  // change to this FunctionBase (node addition or removal, operand or use
+  // replacement). Pass pipelines use this value to detect that a function is
+  // unchanged since an earlier pass invocation.
+  int64_t transform_version() const { return transform_version_; }
+  void BumpTransformVersion() { ++transform_version_; }
+
+  // Monotonically increasing counter which is bumped on every change to the
+  // instantiation structure of this FunctionBase: block instantiations, proc
+  // instantiations and channel interface changes. Unlike transform_version()
+  // it is unaffected by node-level edits, so cached elaborations keyed on it
+  // survive ordinary optimization passes.
+  int64_t instantiation_version() const { return instantiation_version_; }
+  void BumpInstantiationVersion() { ++instantiation_version_; }
+
+  // Appends the given node to the bounded journal of structural changes. Must
+  // be called (after BumpTransformVersion) at every mutation point with each
+  // node whose shape, users, or liveness may have been affected. Not intended
+  // for use outside of the IR mutation methods themselves.
+  void RecordNodeChange(Node* node);
+
+  // Returns the ids of the nodes changed after `version` (deduplicated, in no
+  // particular order), or std::nullopt if the change journal has been
+  // truncated past that version and the full set of changed nodes is no longer
+  // known. Ids of since-deleted nodes may be included; resolve them with
+  // GetNodeById. Worklist-driven cleanup passes use this to seed from only the
+  // nodes touched since their last run.
+  std::optional<std::vector<int64_t>> ChangedNodeIdsSince(
+      int64_t version) const;
+
+  // Returns the node owned by this FunctionBase with the given id, or nullptr
+  // if there is no such node (e.g., it has been removed).
+  Node* GetNodeById(int64_t id) const {
+    auto it = nodes_by_id_.find(id);
+    return it == nodes_by_id_.end() ? nullptr : it->second;
+  }
+
+  // Returns a topological order of the nodes in this FunctionBase (same order
+  // as TopoSort in topo_sort.h). The order is cached and only recomputed when
+  // the IR has been mutated since the last call (as observed via
+  // transform_version()), so it is cheap to call from passes which traverse
+  // without mutating. The returned span is invalidated by any IR mutation.
+  absl::Span<Node* const> GetCachedTopoSort();
+
   // Expose Nodes, so that transformation passes can operate
   // on this function.
   xabsl::iterator_range<UnwrappingIterator<NodeList::iterator>> nodes() {
@@ -132,8 +204,10 @@ class FunctionBase {
   template <typename NodeT, typename... Args>
     requires(std::is_base_of_v<Node, NodeT>)
   absl::StatusOr<NodeT*> MakeNode(Args&&... args) {
-    NodeT* new_node = AddNode(std::make_unique<NodeT>(
-        std::forward<Args>(args)..., /*name=*/"", this));
+    // Allocate from the package's node arena for locality; the node's storage
+    // is recycled through the arena when the node is deleted.
+    NodeT* new_node = AddNode(absl::WrapUnique(new (package()->node_arena())
+        NodeT(std::forward<Args>(args)..., /*name=*/"", this)));
     XLS_RETURN_IF_ERROR(VerifyNode(new_node));
     return new_node;
   }
@@ -141,8 +215,8 @@ class FunctionBase {
   template <typename NodeT, typename... Args>
     requires(std::is_base_of_v<Node, NodeT>)
   absl::StatusOr<NodeT*> MakeNodeWithName(Args&&... args) {
-    NodeT* new_node =
-        AddNode(std::make_unique<NodeT>(std::forward<Args>(args)..., this));
+    NodeT* new_node = AddNode(absl::WrapUnique(
+        new (package()->node_arena()) NodeT(std::forward<Args>(args)..., this)));
     XLS_RETURN_IF_ERROR(VerifyNode(new_node));
     return new_node;
   }
@@ -163,9 +237,26 @@ class FunctionBase {
   // uniquer. Registers the uniquified name in the uniquer so it is not handed
   // out again.
   std::string UniquifyNodeName(std::string_view name) {
+    if (defer_node_name_uniquification_) {
+      return std::string(name);
+    }
     return node_name_uniquer_.GetSanitizedUniqueName(name);
   }
 
+  // Defers node name uniquification: until FinalizeNodeNames() is called,
+  // names passed at node construction are recorded verbatim rather than
+  // sanitized, uniquified, and registered in the name uniquer per node.
+  // Intended for bulk IR construction by trusted generators (see
+  // BuilderBase::EnableBulkConstruction()); node names must not be relied
+  // upon until finalization.
+  void DeferNodeNameUniquification() { defer_node_name_uniquification_ = true; }
+
+  // Ends deferred naming: sanitizes, uniquifies, and registers the recorded
+  // name of every node, in node creation order. Final names are identical to
+  // those eager uniquification would have produced. No-op if naming is not
+  // deferred.
+  void FinalizeNodeNames();
+
   // Returns whether this FunctionBase is a function, proc, or block.
   bool IsFunction() const;
   bool IsProc() const;
@@ -218,6 +309,34 @@ class FunctionBase {
   Package* package_;
   std::optional<int64_t> initiation_interval_;
 
+  // See SetNodeIdSource().
+  NodeIdSource* node_id_source_ = nullptr;
+
+  // See transform_version().
+  int64_t transform_version_ = 0;
+
+  // See instantiation_version().
+  int64_t instantiation_version_ = 0;
+
+  // Bounded journal of structural changes: (transform version, node id) pairs
+  // in version order. When the journal exceeds kChangeJournalCapacity entries
+  // the oldest are dropped and change_journal_start_version_ records the
+  // latest version no longer covered. See ChangedNodeIdsSince().
+  static constexpr int64_t kChangeJournalCapacity = 8192;
+  std::deque<std::pair<int64_t, int64_t>> change_journal_;
+  int64_t change_journal_start_version_ = 0;
+
+  // Map from node id to node for all nodes in this FunctionBase. Node ids are
+  // never reused, so a missing id means the node has been removed.
+  absl::flat_hash_map<int64_t, Node*> nodes_by_id_;
+
+  // Lazily computed topological order of nodes_ and the transform version at
+  // which it was computed. See GetCachedTopoSort(). When the versions do not
+  // match the cached order is stale and may contain dangling Node pointers;
+  // it must not be read without recomputing.
+  std::vector<Node*> cached_topo_sort_;
+  int64_t cached_topo_sort_version_ = -1;
+
   // Store Nodes in std::list as they can be added and removed arbitrarily and
   // we want a stable iteration order. Keep a map from instruction pointer to
   // location in the list for fast lookup.
@@ -232,6 +351,9 @@ class FunctionBase {
   NameUniquer node_name_uniquer_ =
       NameUniquer(/*separator=*/"__", GetIrReservedWords());
 
+  // See DeferNodeNameUniquification().
+  bool defer_node_name_uniquification_ = false;
+
   std::optional<xls::ForeignFunctionData> foreign_function_;
 };
 
@@ -102,7 +102,7 @@ BValue BValue::operator-() { return builder()->Negate(*this); }
 
 BValue BuilderBase::CreateBValue(Node* node, const SourceInfo& loc) {
   last_node_ = node;
-  if (should_verify_) {
+  if (should_verify_ && !bulk_construction_) {
     absl::Status verify_status = VerifyNode(last_node_);
     if (!verify_status.ok()) {
       return SetError(verify_status.message(), loc);
@@ -116,6 +116,17 @@ void BuilderBase::SetForeignFunctionData(
   function_->SetForeignFunctionData(ff);
 }
 
+void BuilderBase::EnableBulkConstruction() {
+  bulk_construction_ = true;
+  function_->DeferNodeNameUniquification();
+}
+
+void BuilderBase::FinalizeBulkConstruction() {
+  if (bulk_construction_) {
+    function_->FinalizeNodeNames();
+  }
+}
+
 template <typename NodeT, typename... Args>
 BValue BuilderBase::AddNode(const SourceInfo& loc, Args&&... args) {
   last_node_ = function_->AddNode<NodeT>(std::make_unique<NodeT>(
@@ -1039,6 +1050,7 @@ absl::StatusOr<Function*> FunctionBuilder::BuildWithReturnValue(
     return GetError();
   }
   XLS_RET_CHECK_EQ(return_value.builder(), this);
+  FinalizeBulkConstruction();
   // down_cast the FunctionBase* to Function*. We know this is safe because
   // FunctionBuilder constructs and passes a Function to BuilderBase
   // constructor so function_ is always a Function.
@@ -1163,6 +1175,7 @@ absl::StatusOr<Proc*> ProcBuilder::Build(absl::Span<const BValue> next_state) {
     }
   }
 
+  FinalizeBulkConstruction();
   // down_cast the FunctionBase* to Proc*. We know this is safe because
   // ProcBuilder constructs and passes a Proc to BuilderBase constructor so
   // function_ is always a Proc.
@@ -1830,6 +1843,7 @@ absl::StatusOr<Block*> BlockBuilder::Build() {
     return GetError();
   }
 
+  FinalizeBulkConstruction();
   // down_cast the FunctionBase* to Block*. We know this is safe because
   // BlockBuilder constructs and passes a Block to BuilderBase constructor so
   // function_ is always a Block.
@@ -150,6 +150,15 @@ class BuilderBase {
   // a foreign function.
   void SetForeignFunctionData(const std::optional<ForeignFunctionData>& ff);
 
+  // Puts the builder into bulk-construction mode: per-node verification and
+  // node name uniquification are deferred until the function is built, at
+  // which point names are finalized and the whole function is verified once.
+  // The resulting names and the set of detected errors are the same as in the
+  // default mode, but errors are reported at build time rather than at the
+  // offending node. Intended for trusted IR generators which create many
+  // nodes and for which per-node bookkeeping is measurable in profiles.
+  void EnableBulkConstruction();
+
   // Get access to currently built up function (or proc).
   FunctionBase* function() const { return function_.get(); }
 
@@ -641,6 +650,10 @@ class BuilderBase {
 
   BValue CreateBValue(Node* node, const SourceInfo& loc);
 
+  // Finalizes deferred bulk-construction bookkeeping (node names). Called by
+  // the Build() methods of the concrete builders before verification.
+  void FinalizeBulkConstruction();
+
   // The most recently added node to the function.
   Node* last_node_ = nullptr;
 
@@ -653,6 +666,10 @@ class BuilderBase {
   // tests.
   bool should_verify_;
 
+  // Whether per-node verification and name uniquification are deferred to
+  // build time. See EnableBulkConstruction().
+  bool bulk_construction_ = false;
+
   std::string error_msg_;
   std::string error_stacktrace_;
   SourceInfo error_loc_;
@@ -1160,4 +1160,33 @@ TEST(FunctionBuilderTest, Registers) {
   EXPECT_THAT(get_reg_write(x_3)->load_enable().value(), m::InputPort("le"));
 }
 
+TEST(FunctionBuilderTest, BulkConstructionUniquifiesNamesAtBuildTime) {
+  Package p("p");
+  FunctionBuilder b("f", &p);
+  b.EnableBulkConstruction();
+  BValue x = b.Param("x", p.GetBitsType(32));
+  BValue first = b.Not(x, SourceInfo(), /*name=*/"result");
+  BValue second = b.Negate(first, SourceInfo(), /*name=*/"result");
+  XLS_ASSERT_OK(b.BuildWithReturnValue(second).status());
+
+  // Name collisions are resolved at build time exactly as they would have
+  // been during eager construction.
+  EXPECT_EQ(first.node()->GetName(), "result");
+  EXPECT_EQ(second.node()->GetName(), "result__1");
+}
+
+TEST(FunctionBuilderTest, BulkConstructionReportsErrorsAtBuildTime) {
+  Package p("p");
+  FunctionBuilder b("f", &p);
+  b.EnableBulkConstruction();
+  // Mismatched operand types are not caught at node-creation time in bulk
+  // mode; the error surfaces when the function is verified during Build().
+  BValue x = b.Param("x", p.GetBitsType(32));
+  BValue y = b.Param("y", p.GetBitsType(16));
+  BValue bad = b.Add(x, y);
+  EXPECT_THAT(b.BuildWithReturnValue(bad).status(),
+              StatusIs(absl::StatusCode::kInternal,
+                       HasSubstr("Expected operand 1 of")));
+}
+
 }  // namespace xls
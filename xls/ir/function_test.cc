@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -44,6 +45,8 @@ namespace {
 using status_testing::StatusIs;
 using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::UnorderedElementsAre;
 
 class FunctionTest : public IrTestBase {};
 
@@ -390,6 +393,37 @@ TEST_F(FunctionTest, IrReservedWordIdentifiers) {
   XLS_ASSERT_OK(ParsePackage(ir_text).status());
 }
 
+TEST_F(FunctionTest, ChangeJournal) {
+  auto p = CreatePackage();
+  FunctionBuilder fb("ChangeJournal", p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue not_x = fb.Not(x);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  // Nothing has changed since the current version.
+  ASSERT_TRUE(f->ChangedNodeIdsSince(f->transform_version()).has_value());
+  EXPECT_THAT(*f->ChangedNodeIdsSince(f->transform_version()), IsEmpty());
+  EXPECT_EQ(f->GetNodeById(not_x.node()->id()), not_x.node());
+
+  int64_t version = f->transform_version();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * neg, f->MakeNode<UnOp>(SourceInfo(), x.node(), Op::kNeg));
+  std::optional<std::vector<int64_t>> changed =
+      f->ChangedNodeIdsSince(version);
+  ASSERT_TRUE(changed.has_value());
+  EXPECT_THAT(*changed, UnorderedElementsAre(neg->id()));
+
+  // Removing the node records its operand (which may have become dead) and
+  // drops the node from the id lookup table.
+  version = f->transform_version();
+  int64_t neg_id = neg->id();
+  XLS_ASSERT_OK(f->RemoveNode(neg));
+  changed = f->ChangedNodeIdsSince(version);
+  ASSERT_TRUE(changed.has_value());
+  EXPECT_THAT(*changed, UnorderedElementsAre(x.node()->id()));
+  EXPECT_EQ(f->GetNodeById(neg_id), nullptr);
+}
+
 class TestVisitor : public DfsVisitorWithDefault {
  public:
   absl::Status DefaultHandler(Node* node) override { return absl::OkStatus(); }
@@ -220,6 +220,16 @@ bool IntervalSet::ForEachElement(
 IntervalSet IntervalSet::Combine(const IntervalSet& lhs,
                                  const IntervalSet& rhs) {
   CHECK_EQ(lhs.BitCount(), rhs.BitCount());
+  // Empty and maximal operands are extremely common in range analysis and
+  // need no merging work.
+  if (lhs.is_normalized_ && rhs.is_normalized_) {
+    if (lhs.IsEmpty() || rhs.IsMaximal()) {
+      return rhs;
+    }
+    if (rhs.IsEmpty() || lhs.IsMaximal()) {
+      return lhs;
+    }
+  }
   IntervalSet combined(lhs.BitCount());
   for (const Interval& interval : lhs.intervals_) {
     combined.AddInterval(interval);
@@ -231,11 +241,48 @@ IntervalSet IntervalSet::Combine(const IntervalSet& lhs,
   return combined;
 }
 
+void IntervalSet::UnionWith(const IntervalSet& other) {
+  CHECK_EQ(BitCount(), other.BitCount());
+  if (other.intervals_.empty()) {
+    return;
+  }
+  if (intervals_.empty()) {
+    intervals_ = other.intervals_;
+    is_normalized_ = other.is_normalized_;
+    return;
+  }
+  if (is_normalized_ && other.is_normalized_ &&
+      (IsMaximal() || other.IsMaximal())) {
+    intervals_ = {Interval::Maximal(BitCount())};
+    is_normalized_ = true;
+    return;
+  }
+  intervals_.insert(intervals_.end(), other.intervals_.begin(),
+                    other.intervals_.end());
+  is_normalized_ = false;
+  Normalize();
+}
+
 IntervalSet IntervalSet::Intersect(const IntervalSet& lhs,
                                    const IntervalSet& rhs) {
   CHECK_EQ(lhs.BitCount(), rhs.BitCount());
   CHECK(lhs.is_normalized_);
   CHECK(rhs.is_normalized_);
+  // Resolve the cheap cases without running the merge loop below.
+  if (lhs.IsEmpty() || rhs.IsMaximal()) {
+    return lhs;
+  }
+  if (rhs.IsEmpty() || lhs.IsMaximal()) {
+    return rhs;
+  }
+  if (lhs.IsPrecise()) {
+    return rhs.Covers(*lhs.GetPreciseValue()) ? lhs
+                                              : IntervalSet(lhs.BitCount());
+  }
+  if (rhs.IsPrecise()) {
+    return lhs.Covers(*rhs.GetPreciseValue()) ? rhs
+                                              : IntervalSet(rhs.BitCount());
+  }
   IntervalSet result(lhs.BitCount());
   std::list<Interval> lhs_intervals(lhs.Intervals().begin(),
                                     lhs.Intervals().end());
@@ -289,6 +336,28 @@ IntervalSet IntervalSet::Intersect(const IntervalSet& lhs,
   return result;
 }
 
+void IntervalSet::IntersectWith(const IntervalSet& other) {
+  CHECK(is_normalized_);
+  CHECK(other.is_normalized_);
+  CHECK_EQ(BitCount(), other.BitCount());
+  if (IsEmpty() || other.IsMaximal()) {
+    return;
+  }
+  if (other.IsEmpty() || IsMaximal()) {
+    intervals_ = other.intervals_;
+    return;
+  }
+  if (other.IsPrecise()) {
+    if (Covers(*other.GetPreciseValue())) {
+      intervals_ = other.intervals_;
+    } else {
+      intervals_.clear();
+    }
+    return;
+  }
+  *this = Intersect(*this, other);
+}
+
 /* static */ IntervalSet IntervalSet::Of(absl::Span<Interval const> intervals) {
   IntervalSet result(intervals.front().BitCount());
   for (const Interval& a : intervals) {
@@ -20,8 +20,9 @@
 #include <iosfwd>
 #include <optional>
 #include <string>
-#include <vector>
+#include <utility>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/types/span.h"
 #include "xls/ir/bits.h"
@@ -32,6 +33,11 @@ namespace xls {
 // This type represents a set of intervals.
 class IntervalSet {
  public:
+  // Storage for the intervals. An inline capacity of two covers the vast
+  // majority of sets produced by range analysis (empty, precise, or one
+  // proper/improper interval pair) without touching the heap.
+  using IntervalVector = absl::InlinedVector<Interval, 2>;
+
   // Create an empty `IntervalSet` with a `BitCount()` of -1. Every method in
   // this class fails if called on an `IntervalSet` with bit count -1, so you
   // must assign to a default constructed interval set before calling any method
@@ -69,9 +75,9 @@ class IntervalSet {
     return intervals_;
   }
 
-  std::vector<Interval> Intervals() && {
+  IntervalVector Intervals() && {
     CHECK(is_normalized_);
-    return intervals_;
+    return std::move(intervals_);
   }
 
   // Returns the `BitCount()` of all intervals in the interval set.
@@ -131,10 +137,19 @@ class IntervalSet {
   // interval sets.
   static IntervalSet Combine(const IntervalSet& lhs, const IntervalSet& rhs);
 
+  // In-place version of `Combine`: this set becomes the normalized union of
+  // itself and `other` without constructing a fresh set.
+  void UnionWith(const IntervalSet& other);
+
   // Returns a normalized set of intervals comprising the intersection of the
   // two given interval sets.
   static IntervalSet Intersect(const IntervalSet& lhs, const IntervalSet& rhs);
 
+  // In-place version of `Intersect`. The cheap cases (either side empty,
+  // maximal, or precise) are resolved without building intermediate interval
+  // lists; both sets must be normalized.
+  void IntersectWith(const IntervalSet& other);
+
   // Returns the normalized set of intervals comprising the complemet of the
   // given interval set.
   static IntervalSet Complement(const IntervalSet& set);
@@ -232,7 +247,7 @@ class IntervalSet {
  private:
   bool is_normalized_;
   int64_t bit_count_;
-  std::vector<Interval> intervals_;
+  IntervalVector intervals_;
 };
 
 inline std::ostream& operator<<(std::ostream& os,
@@ -31,6 +31,7 @@
 #include "xls/ir/interval.h"
 #include "xls/ir/interval_set_test_utils.h"
 
+using ::testing::ElementsAre;
 using ::testing::ExplainMatchResult;
 using ::testing::IsTrue;
 using ::testing::Not;
@@ -173,9 +174,66 @@ TEST(IntervalTest, Combine) {
   y.AddInterval(MakeInterval(25, 30, 32));
   y.AddInterval(MakeInterval(31, 35, 32));
 
-  EXPECT_EQ(IntervalSet::Combine(x, y).Intervals(),
-            (std::vector<Interval>{MakeInterval(5, 15, 32),
-                                   MakeInterval(25, 35, 32)}));
+  EXPECT_THAT(IntervalSet::Combine(x, y).Intervals(),
+              ElementsAre(MakeInterval(5, 15, 32), MakeInterval(25, 35, 32)));
+}
+
+TEST(IntervalTest, UnionWith) {
+  IntervalSet x(32);
+  x.AddInterval(MakeInterval(5, 10, 32));
+  x.AddInterval(MakeInterval(8, 15, 32));
+  x.Normalize();
+
+  IntervalSet y(32);
+  y.AddInterval(MakeInterval(25, 30, 32));
+  y.AddInterval(MakeInterval(31, 35, 32));
+  y.Normalize();
+
+  IntervalSet in_place = x;
+  in_place.UnionWith(y);
+  EXPECT_EQ(in_place, IntervalSet::Combine(x, y));
+
+  // Empty and maximal short circuits.
+  IntervalSet empty(32);
+  in_place = x;
+  in_place.UnionWith(empty);
+  EXPECT_EQ(in_place, x);
+  in_place = empty;
+  in_place.UnionWith(x);
+  EXPECT_EQ(in_place, x);
+  in_place = x;
+  in_place.UnionWith(IntervalSet::Maximal(32));
+  EXPECT_EQ(in_place, IntervalSet::Maximal(32));
+}
+
+TEST(IntervalTest, IntersectWith) {
+  IntervalSet x(32);
+  x.AddInterval(MakeInterval(5, 15, 32));
+  x.AddInterval(MakeInterval(20, 30, 32));
+  x.Normalize();
+
+  IntervalSet y(32);
+  y.AddInterval(MakeInterval(10, 25, 32));
+  y.Normalize();
+
+  IntervalSet in_place = x;
+  in_place.IntersectWith(y);
+  EXPECT_EQ(in_place, IntervalSet::Intersect(x, y));
+
+  // Empty, maximal, and precise short circuits.
+  IntervalSet empty(32);
+  in_place = x;
+  in_place.IntersectWith(empty);
+  EXPECT_EQ(in_place, empty);
+  in_place = x;
+  in_place.IntersectWith(IntervalSet::Maximal(32));
+  EXPECT_EQ(in_place, x);
+  in_place = x;
+  in_place.IntersectWith(IntervalSet::Precise(UBits(12, 32)));
+  EXPECT_EQ(in_place, IntervalSet::Precise(UBits(12, 32)));
+  in_place = x;
+  in_place.IntersectWith(IntervalSet::Precise(UBits(17, 32)));
+  EXPECT_EQ(in_place, empty);
 }
 
 void IntersectMatchesSetIntersection(const IntervalSet& lhs,
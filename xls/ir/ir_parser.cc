@@ -14,6 +14,8 @@
 
 #include "xls/ir/ir_parser.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <initializer_list>
@@ -42,6 +44,7 @@
 #include "google/protobuf/text_format.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/common/visitor.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_ops.h"
@@ -52,6 +55,7 @@
 #include "xls/ir/fileno.h"
 #include "xls/ir/foreign_function_data.pb.h"
 #include "xls/ir/format_strings.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/function_builder.h"
 #include "xls/ir/instantiation.h"
 #include "xls/ir/ir_scanner.h"
@@ -78,7 +82,7 @@ absl::Status Parser::ParseKeywordArguments(
     XLS_ASSIGN_OR_RETURN(Token name,
                          scanner_.PopKeywordOrIdentToken("argument"));
     XLS_RETURN_IF_ERROR(scanner_.DropTokenOrError(LexicalTokenType::kEquals));
-    if (!seen_keywords.insert(name.value()).second) {
+    if (!seen_keywords.insert(std::string(name.value())).second) {
       return absl::InvalidArgumentError(
           absl::StrFormat("Duplicate keyword argument `%s` @ %s", name.value(),
                           name.pos().ToHumanString()));
@@ -120,7 +124,7 @@ absl::StatusOr<std::vector<Parser::TypedArgument>> Parser::ParseTypedArguments(
                            scanner_.PopTokenOrError(LexicalTokenType::kIdent));
       XLS_RETURN_IF_ERROR(scanner_.DropTokenOrError(LexicalTokenType::kColon));
       XLS_ASSIGN_OR_RETURN(Type * type, ParseType(package));
-      args.push_back(TypedArgument{name.value(), type, name});
+      args.push_back(TypedArgument{std::string(name.value()), type, name});
     } while (scanner_.TryDropToken(LexicalTokenType::kComma));
   }
   return args;
@@ -389,7 +393,7 @@ absl::StatusOr<std::string> Parser::ParseIdentifier(TokenPos* pos) {
   if (pos != nullptr) {
     *pos = token.pos();
   }
-  return token.value();
+  return std::string(token.value());
 }
 
 absl::StatusOr<std::string> Parser::ParseQuotedString(TokenPos* pos) {
@@ -398,7 +402,7 @@ absl::StatusOr<std::string> Parser::ParseQuotedString(TokenPos* pos) {
   if (pos != nullptr) {
     *pos = token.pos();
   }
-  return token.value();
+  return std::string(token.value());
 }
 
 absl::StatusOr<BValue> Parser::ParseAndResolveIdentifier(
@@ -693,7 +697,8 @@ absl::StatusOr<BValue> Parser::ParseNode(
   // should be given when constructing the node as the name is autogenerated
   // (the node has no meaningful given name). Otherwise, output_name is the
   // name of the node.
-  std::string node_name = split_name.has_value() ? "" : output_name.value();
+  std::string node_name =
+      split_name.has_value() ? "" : std::string(output_name.value());
 
   std::vector<BValue> operands;
   switch (op) {
@@ -1402,7 +1407,7 @@ absl::StatusOr<ProcInstantiation*> Parser::ParseProcInstantiation(Proc* proc) {
     XLS_ASSIGN_OR_RETURN(Token channel_name,
                          scanner_.PopTokenOrError(LexicalTokenType::kIdent,
                                                   "channel reference name"));
-    channel_arg_names.push_back(channel_name.value());
+    channel_arg_names.push_back(std::string(channel_name.value()));
   } while (scanner_.TryDropToken(LexicalTokenType::kComma));
 
   // Then parse keyword arguments.
@@ -2012,7 +2017,7 @@ absl::StatusOr<Parser::BlockSignature> Parser::ParseBlockSignature(
     if (!scanner_.TryDropKeyword("clock")) {
       XLS_ASSIGN_OR_RETURN(type, ParseType(package));
     }
-    signature.ports.push_back(Port{port_name.value(), type});
+    signature.ports.push_back(Port{std::string(port_name.value()), type});
     must_end = !scanner_.TryDropToken(LexicalTokenType::kComma);
   }
 
@@ -2027,7 +2032,7 @@ absl::StatusOr<std::string> Parser::ParsePackageName() {
   XLS_ASSIGN_OR_RETURN(
       Token package_name,
       scanner_.PopTokenOrError(LexicalTokenType::kIdent, "package name"));
-  return package_name.value();
+  return std::string(package_name.value());
 }
 
 absl::Status Parser::ParseFileNumber(Package* package,
@@ -2096,7 +2101,8 @@ absl::StatusOr<Function*> Parser::ParseFunction(
       result->SetInitiationInterval(ii);
     } else if (attribute == "ffi_proto") {
       ForeignFunctionData ffi;
-      if (!google::protobuf::TextFormat::ParseFromString(literal.value(), &ffi)) {
+      if (!google::protobuf::TextFormat::ParseFromString(
+              std::string(literal.value()), &ffi)) {
         return absl::InvalidArgumentError("Non-parseable FFI metadata proto.");
       }
       // Dummy parse to make sure it is a valid template.
@@ -2326,8 +2332,8 @@ absl::StatusOr<Channel*> Parser::ParseChannel(Package* package,
         Token metadata_token,
         scanner_.PopTokenOrError(LexicalTokenType::kQuotedString));
     ChannelMetadataProto proto;
-    bool success =
-        google::protobuf::TextFormat::ParseFromString(metadata_token.value(), &proto);
+    bool success = google::protobuf::TextFormat::ParseFromString(
+        std::string(metadata_token.value()), &proto);
     if (!success) {
       return absl::InvalidArgumentError(
           absl::StrFormat("Invalid channel metadata @ %s",
@@ -2591,6 +2597,252 @@ static absl::Status VerifyAndSwapError(Package* package) {
   return package;
 }
 
+namespace {
+
+// A top-level fn/proc/block declaration carved out of the token stream by
+// ParsePackageConcurrently, parsed independently of its neighbors.
+struct ParseUnit {
+  enum class Kind : uint8_t { kFunction, kProc, kBlock };
+
+  Kind kind;
+  bool is_top;
+  // The declaration's tokens including any preceding attribute groups (but
+  // excluding any `top` keyword). Token values are views into the original
+  // input string.
+  std::vector<Token> tokens;
+
+  FunctionBase* result = nullptr;
+  absl::Status status;
+};
+
+}  // namespace
+
+/* static */ absl::StatusOr<std::unique_ptr<Package>>
+Parser::ParsePackageConcurrently(std::string_view input_string,
+                                 std::optional<std::string_view> filename,
+                                 int64_t worker_count) {
+  XLS_ASSIGN_OR_RETURN(std::vector<Token> tokens, TokenizeString(input_string));
+  std::string filename_str =
+      (filename.has_value() ? std::string(filename.value()) : "<unknown file>");
+
+  auto slice = [&tokens](int64_t begin, int64_t end) {
+    return std::vector<Token>(tokens.begin() + begin, tokens.begin() + end);
+  };
+  auto is_keyword = [&tokens](int64_t i, std::string_view keyword) {
+    return i < static_cast<int64_t>(tokens.size()) &&
+           tokens[i].type() == LexicalTokenType::kKeyword &&
+           tokens[i].value() == keyword;
+  };
+  // Returns the index one past the token of type `close` which balances the
+  // first token of type `open` at or after `i`.
+  auto find_balanced_end =
+      [&tokens](int64_t i, LexicalTokenType open,
+                LexicalTokenType close) -> absl::StatusOr<int64_t> {
+    int64_t depth = 0;
+    for (int64_t j = i; j < static_cast<int64_t>(tokens.size()); ++j) {
+      if (tokens[j].type() == open) {
+        ++depth;
+      } else if (tokens[j].type() == close) {
+        if (--depth == 0) {
+          return j + 1;
+        }
+      }
+    }
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Unterminated declaration starting @ %s",
+                        tokens[i].pos().ToHumanString()));
+  };
+
+  // Sequential pre-scan: parse the package name and the cheap package-scoped
+  // declarations (file_number, chan) immediately, and carve each fn/proc/block
+  // declaration into a ParseUnit for concurrent parsing below.
+  int64_t i = std::min<int64_t>(2, tokens.size());
+  std::unique_ptr<Package> package;
+  {
+    Parser p(Scanner::CreateFromTokens(slice(0, i)));
+    XLS_ASSIGN_OR_RETURN(std::string package_name, p.ParsePackageName());
+    package = std::make_unique<Package>(package_name);
+  }
+
+  std::vector<std::unique_ptr<ParseUnit>> units;
+  std::optional<Token> previous_top_token;
+  while (i < static_cast<int64_t>(tokens.size())) {
+    // Attribute groups (`#[ident(value)]`) prefix the declaration they apply
+    // to; keep their tokens with the declaration's.
+    int64_t attr_begin = i;
+    while (i < static_cast<int64_t>(tokens.size()) &&
+           tokens[i].type() == LexicalTokenType::kHash) {
+      while (i < static_cast<int64_t>(tokens.size()) &&
+             tokens[i].type() != LexicalTokenType::kBracketClose) {
+        ++i;
+      }
+      ++i;
+    }
+    int64_t attr_end = i;
+    if (i >= static_cast<int64_t>(tokens.size())) {
+      if (attr_end != attr_begin) {
+        return absl::InvalidArgumentError("Illegal attribute at end of file");
+      }
+      break;
+    }
+
+    bool is_top = false;
+    if (is_keyword(i, "top")) {
+      is_top = true;
+      ++i;
+      if (previous_top_token.has_value()) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Top declared more than once, previous declaration @ %s",
+            previous_top_token.value().pos().ToHumanString()));
+      }
+      if (i < static_cast<int64_t>(tokens.size())) {
+        previous_top_token = tokens[i];
+      }
+    }
+
+    if (is_keyword(i, "fn") || is_keyword(i, "proc") ||
+        is_keyword(i, "block")) {
+      ParseUnit::Kind kind = is_keyword(i, "fn")    ? ParseUnit::Kind::kFunction
+                             : is_keyword(i, "proc") ? ParseUnit::Kind::kProc
+                                                     : ParseUnit::Kind::kBlock;
+      XLS_ASSIGN_OR_RETURN(int64_t end,
+                           find_balanced_end(i, LexicalTokenType::kCurlOpen,
+                                             LexicalTokenType::kCurlClose));
+      auto unit = std::make_unique<ParseUnit>();
+      unit->kind = kind;
+      unit->is_top = is_top;
+      unit->tokens = slice(attr_begin, attr_end);
+      std::vector<Token> body = slice(i, end);
+      unit->tokens.insert(unit->tokens.end(), body.begin(), body.end());
+      units.push_back(std::move(unit));
+      i = end;
+      continue;
+    }
+    if (is_top) {
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Expected fn, proc or block definition, got %s @ %s",
+                          tokens[i].value(), tokens[i].pos().ToHumanString()));
+    }
+    if (is_keyword(i, "chan")) {
+      XLS_ASSIGN_OR_RETURN(int64_t end,
+                           find_balanced_end(i, LexicalTokenType::kParenOpen,
+                                             LexicalTokenType::kParenClose));
+      Parser p(Scanner::CreateFromTokens(slice(attr_begin, end)));
+      XLS_ASSIGN_OR_RETURN(DeclAttributes attributes, p.MaybeParseAttributes());
+      XLS_RETURN_IF_ERROR(p.ParseChannel(package.get(), attributes).status())
+          << "@ " << filename_str;
+      i = end;
+      continue;
+    }
+    if (is_keyword(i, "file_number")) {
+      int64_t end = std::min<int64_t>(i + 3, tokens.size());
+      Parser p(Scanner::CreateFromTokens(slice(attr_begin, end)));
+      XLS_ASSIGN_OR_RETURN(DeclAttributes attributes, p.MaybeParseAttributes());
+      XLS_RETURN_IF_ERROR(p.ParseFileNumber(package.get(), attributes))
+          << "@ " << filename_str;
+      i = end;
+      continue;
+    }
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Expected attribute or declaration "
+                        "(`fn`, `proc`, `block`, `chan`, `file_number`), "
+                        "got %s @ %s",
+                        tokens[i].value(), tokens[i].pos().ToHumanString()));
+  }
+
+  // Parse the units in waves. Each wave parses all pending units concurrently;
+  // a unit which fails (typically because it references a function a later
+  // unit declares, e.g. an invoke of a not-yet-parsed callee) is retried in
+  // the next wave. A wave in which no unit succeeds means the remaining
+  // failures are genuine; report the textually first one.
+  std::vector<ParseUnit*> pending;
+  pending.reserve(units.size());
+  for (const std::unique_ptr<ParseUnit>& unit : units) {
+    pending.push_back(unit.get());
+  }
+  if (worker_count <= 0) {
+    worker_count = AvailableCPUs();
+  }
+  while (!pending.empty()) {
+    std::atomic<int64_t> next_pending(0);
+    auto parse_units = [&]() {
+      while (true) {
+        int64_t index = next_pending.fetch_add(1, std::memory_order_relaxed);
+        if (index >= static_cast<int64_t>(pending.size())) {
+          return;
+        }
+        ParseUnit* unit = pending[index];
+        Parser p(Scanner::CreateFromTokens(unit->tokens));
+        unit->status = [&]() -> absl::Status {
+          XLS_ASSIGN_OR_RETURN(DeclAttributes attributes,
+                               p.MaybeParseAttributes());
+          switch (unit->kind) {
+            case ParseUnit::Kind::kFunction: {
+              XLS_ASSIGN_OR_RETURN(Function * fn,
+                                   p.ParseFunction(package.get(), attributes),
+                                   _ << "@ " << filename_str);
+              unit->result = fn;
+              break;
+            }
+            case ParseUnit::Kind::kProc: {
+              XLS_ASSIGN_OR_RETURN(Proc * proc,
+                                   p.ParseProc(package.get(), attributes),
+                                   _ << "@ " << filename_str);
+              unit->result = proc;
+              break;
+            }
+            case ParseUnit::Kind::kBlock: {
+              XLS_ASSIGN_OR_RETURN(Block * block,
+                                   p.ParseBlock(package.get(), attributes),
+                                   _ << "@ " << filename_str);
+              unit->result = block;
+              break;
+            }
+          }
+          return absl::OkStatus();
+        }();
+      }
+    };
+    {
+      std::vector<std::unique_ptr<Thread>> threads;
+      int64_t thread_count =
+          std::min<int64_t>(worker_count, pending.size()) - 1;
+      for (int64_t t = 0; t < thread_count; ++t) {
+        threads.push_back(std::make_unique<Thread>(parse_units));
+      }
+      parse_units();
+      for (std::unique_ptr<Thread>& thread : threads) {
+        thread->Join();
+      }
+    }
+    std::vector<ParseUnit*> failed;
+    for (ParseUnit* unit : pending) {
+      if (!unit->status.ok()) {
+        failed.push_back(unit);
+      }
+    }
+    if (failed.size() == pending.size()) {
+      return failed.front()->status;
+    }
+    pending = std::move(failed);
+  }
+
+  // Restore textual declaration order; workers register their FunctionBases
+  // with the package in completion order.
+  std::vector<FunctionBase*> textual_order;
+  textual_order.reserve(units.size());
+  for (const std::unique_ptr<ParseUnit>& unit : units) {
+    textual_order.push_back(unit->result);
+    if (unit->is_top) {
+      XLS_RETURN_IF_ERROR(package->SetTop(unit->result));
+    }
+  }
+  XLS_RETURN_IF_ERROR(package->ReorderFunctionBases(textual_order));
+
+  XLS_RETURN_IF_ERROR(VerifyAndSwapError(package.get()));
+  return package;
+}
+
 /* static */ absl::StatusOr<std::unique_ptr<Package>>
 Parser::ParsePackageWithEntry(std::string_view input_string,
                               std::string_view entry,
@@ -67,6 +67,18 @@ class Parser {
       std::string_view input_string,
       std::optional<std::string_view> filename = std::nullopt);
 
+  // As ParsePackage, but parses function/proc/block bodies concurrently on
+  // up to `worker_count` threads (zero means one per available CPU). The
+  // input is tokenized once and split at top-level declaration boundaries;
+  // bodies with forward references to not-yet-parsed callees are retried in
+  // subsequent waves. The resulting package is identical to the one produced
+  // by ParsePackage including declaration order, though node ids may differ
+  // for inputs which do not carry explicit id annotations.
+  static absl::StatusOr<std::unique_ptr<Package>> ParsePackageConcurrently(
+      std::string_view input_string,
+      std::optional<std::string_view> filename = std::nullopt,
+      int64_t worker_count = 0);
+
   // As above, but sets the entry function to be the given name in the returned
   // package.
   static absl::StatusOr<std::unique_ptr<Package>> ParsePackageWithEntry(
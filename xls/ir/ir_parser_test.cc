@@ -3781,4 +3781,85 @@ block my_block(in: bits[32], out: bits[32]) {
   }
 }
 
+TEST(IrParserTest, ParsePackageConcurrentlyMatchesSequential) {
+  const std::string input = R"(package concurrent_test
+
+file_number 0 "foo.x"
+
+chan ch(bits[32], id=0, kind=streaming, ops=send_receive, flow_control=none, strictness=proven_mutually_exclusive, metadata="""""")
+
+fn callee(x: bits[32]) -> bits[32] {
+  ret add.2: bits[32] = add(x, x, id=2)
+}
+
+top fn caller(x: bits[32]) -> bits[32] {
+  ret invoke.4: bits[32] = invoke(x, to_apply=callee, id=4)
+}
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<Package> sequential,
+                           Parser::ParsePackage(input));
+  // Round-trip the dumped IR (which carries explicit node ids) so the
+  // concurrent parse is byte-for-byte comparable.
+  for (int64_t worker_count : {1, 4}) {
+    XLS_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<Package> concurrent,
+        Parser::ParsePackageConcurrently(sequential->DumpIr(),
+                                         /*filename=*/std::nullopt,
+                                         worker_count));
+    EXPECT_EQ(concurrent->DumpIr(), sequential->DumpIr());
+    ASSERT_TRUE(concurrent->GetTop().has_value());
+    EXPECT_EQ(concurrent->GetTop().value()->name(), "caller");
+  }
+}
+
+TEST(IrParserTest, ParsePackageConcurrentlyForwardReference) {
+  // The caller precedes its callee; the first parse wave fails on the invoke
+  // and the retry wave succeeds once the callee exists.
+  const std::string input = R"(package forward_ref
+
+fn caller(x: bits[8]) -> bits[8] {
+  ret result: bits[8] = invoke(x, to_apply=callee)
+}
+
+fn callee(x: bits[8]) -> bits[8] {
+  ret neg_x: bits[8] = neg(x)
+}
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<Package> package,
+      Parser::ParsePackageConcurrently(input, /*filename=*/std::nullopt,
+                                       /*worker_count=*/1));
+  // Declaration order is preserved despite the callee parsing first.
+  EXPECT_EQ(package->functions()[0]->name(), "caller");
+  EXPECT_EQ(package->functions()[1]->name(), "callee");
+}
+
+TEST(IrParserTest, ParsePackageConcurrentlyBadReference) {
+  const std::string input = R"(package bad_ref
+
+fn caller(x: bits[8]) -> bits[8] {
+  ret result: bits[8] = invoke(x, to_apply=no_such_fn)
+}
+)";
+  EXPECT_THAT(Parser::ParsePackageConcurrently(input),
+              StatusIs(absl::StatusCode::kNotFound,
+                       HasSubstr("no_such_fn")));
+}
+
+TEST(IrParserTest, ParsePackageConcurrentlyDuplicateTop) {
+  const std::string input = R"(package dup_top
+
+top fn f(x: bits[8]) -> bits[8] {
+  ret neg_x: bits[8] = neg(x)
+}
+
+top fn g(x: bits[8]) -> bits[8] {
+  ret not_x: bits[8] = not(x)
+}
+)";
+  EXPECT_THAT(Parser::ParsePackageConcurrently(input),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Top declared more than once")));
+}
+
 }  // namespace xls
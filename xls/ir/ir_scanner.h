@@ -97,7 +97,7 @@ class Token {
       : type_(type), value_(value), pos_({lineno, colno}) {}
 
   LexicalTokenType type() const { return type_; }
-  const std::string& value() const { return value_; }
+  std::string_view value() const { return value_; }
   const TokenPos& pos() const { return pos_; }
 
   // Returns the token as a (u)int64_t value. Token must be a literal. The
@@ -121,7 +121,9 @@ class Token {
 
  private:
   LexicalTokenType type_;
-  std::string value_;
+  // View into the text passed to TokenizeString/Scanner::Create. Tokens do not
+  // copy their payload; the scanned text must outlive the tokens.
+  std::string_view value_;
   TokenPos pos_;
 };
 
@@ -133,13 +135,24 @@ inline std::ostream& operator<<(std::ostream& os, const Token& token) {
 // Tokenizes the given string and returns the tokens. It maintains precise
 // source location information.  Right now this is a eager implementation - it
 // tokenizes the whole input. This can be easily changed later to a more demand
-// driven tokenization.
+// driven tokenization. The returned tokens hold string_views into "str" so the
+// string must outlive them.
 absl::StatusOr<std::vector<Token>> TokenizeString(std::string_view str);
 
 class Scanner {
  public:
+  // "text" must outlive the scanner and any tokens popped from it; token
+  // values are views into the text rather than copies.
   static absl::StatusOr<Scanner> Create(std::string_view text);
 
+  // Creates a scanner over an already-tokenized slice of a larger input, as
+  // produced by TokenizeString. The text the tokens point into must outlive
+  // the scanner. Used by the parallel package parser to parse top-level
+  // declarations independently.
+  static Scanner CreateFromTokens(std::vector<Token> tokens) {
+    return Scanner(std::move(tokens));
+  }
+
   // Peeks at the next token in the token stream, or returns an error if we're
   // at EOF and no more tokens are available.
   absl::StatusOr<Token> PeekToken() const;
@@ -162,7 +175,8 @@ class Scanner {
            tokens_[token_idx_ + n].type() == target;
   }
 
-  // Pop the current token, advance token pointer to next token.
+  // Pop the current token, advance token pointer to next token. Tokens are
+  // cheap views into the scanned text so popping is a trivial copy.
   Token PopToken() {
     VLOG(6) << "Popping token: " << tokens_[token_idx_];
     return tokens_.at(token_idx_++);
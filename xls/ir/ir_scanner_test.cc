@@ -15,6 +15,7 @@
 #include "xls/ir/ir_scanner.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -34,7 +35,7 @@ using testing::HasSubstr;
 std::vector<std::string> TokensToStrings(absl::Span<const Token> tokens) {
   std::vector<std::string> strs;
   for (const Token& token : tokens) {
-    strs.push_back(token.value());
+    strs.push_back(std::string(token.value()));
   }
   return strs;
 }
@@ -106,6 +107,21 @@ TEST(IrScannerTest, OffsetQuotedString) {
   EXPECT_EQ(foo.pos().lineno, 2);
 }
 
+TEST(IrScannerTest, TokenValuesAliasTheScannedText) {
+  constexpr std::string_view kText = "fn foo(x: bits[32]) 0x42";
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Token> tokens, TokenizeString(kText));
+  for (const Token& token : tokens) {
+    if (token.value().empty()) {
+      continue;
+    }
+    // Identifier, keyword and literal payloads are views into the scanned
+    // text rather than copies.
+    EXPECT_GE(token.value().data(), kText.data());
+    EXPECT_LE(token.value().data() + token.value().size(),
+              kText.data() + kText.size());
+  }
+}
+
 TEST(IrScannerTest, EmptyQuotedString) {
   XLS_ASSERT_OK_AND_ASSIGN(std::vector<Token> tokens, TokenizeString(R"("")"));
   EXPECT_THAT(TokensToStrings(tokens), ElementsAre(""));
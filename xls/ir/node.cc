@@ -15,6 +15,8 @@
 #include "xls/ir/node.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -41,6 +43,7 @@
 #include "xls/ir/function.h"
 #include "xls/ir/instantiation.h"
 #include "xls/ir/lsb_or_msb.h"
+#include "xls/ir/node_arena.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
 #include "xls/ir/package.h"
@@ -52,14 +55,61 @@
 
 namespace xls {
 
+namespace {
+
+// Header prepended to every Node allocation recording where the storage came
+// from so Node::operator delete can return it to the right place. Sized and
+// aligned so the node following it retains maximal alignment.
+struct alignas(16) NodeAllocationHeader {
+  NodeArena* arena;  // nullptr if allocated from the global heap.
+  size_t size;       // Size of the node allocation, excluding the header.
+};
+
+}  // namespace
+
+void* Node::operator new(size_t size, NodeArena& arena) {
+  auto* header = static_cast<NodeAllocationHeader*>(
+      arena.Allocate(size + sizeof(NodeAllocationHeader)));
+  header->arena = &arena;
+  header->size = size;
+  return header + 1;
+}
+
+void* Node::operator new(size_t size) {
+  auto* header = static_cast<NodeAllocationHeader*>(
+      ::operator new(size + sizeof(NodeAllocationHeader)));
+  header->arena = nullptr;
+  header->size = size;
+  return header + 1;
+}
+
+void Node::operator delete(void* ptr) {
+  NodeAllocationHeader* header = static_cast<NodeAllocationHeader*>(ptr) - 1;
+  if (header->arena == nullptr) {
+    ::operator delete(header);
+    return;
+  }
+  header->arena->Deallocate(header,
+                            header->size + sizeof(NodeAllocationHeader));
+}
+
+void Node::operator delete(void* ptr, NodeArena& arena) {
+  Node::operator delete(ptr);
+}
+
 Node::Node(Op op, Type* type, const SourceInfo& loc, std::string_view name,
            FunctionBase* function_base)
     : function_base_(function_base),
-      id_(function_base_->package()->GetNextNodeId()),
+      id_(function_base_->GetNextNodeId()),
       op_(op),
       type_(type),
-      loc_(loc),
-      name_(name.empty() ? "" : function_base_->UniquifyNodeName(name)) {}
+      loc_id_(function_base_->package()->InternSourceInfo(loc)) {
+  if (!name.empty()) {
+    has_assigned_name_ = true;
+    function_base_->package()->SetNodeName(
+        id_, function_base_->UniquifyNodeName(name));
+  }
+}
 
 void Node::AddOperand(Node* operand) {
   VLOG(3) << " Adding operand " << operand->GetName() << " as #"
@@ -91,10 +141,21 @@ absl::Status Node::AddNodeToFunctionAndReplace(
   return ReplaceUsesWith(replacement_ptr);
 }
 
-void Node::AddUser(Node* user) { users_.insert(user); }
+void Node::AddUser(Node* user) {
+  // The user list is kept sorted by id (see NodeIdLessThan). Insert at the
+  // lower bound; skip if already present to keep the operation idempotent.
+  auto it = std::lower_bound(users_.begin(), users_.end(), user,
+                             NodeIdLessThan());
+  if (it == users_.end() || *it != user) {
+    users_.insert(it, user);
+  }
+}
 
 void Node::RemoveUser(Node* user) {
-  CHECK_EQ(users_.erase(user), 1) << GetName();
+  auto it = std::lower_bound(users_.begin(), users_.end(), user,
+                             NodeIdLessThan());
+  CHECK(it != users_.end() && *it == user) << GetName();
+  users_.erase(it);
 }
 
 absl::Status Node::VisitSingleNode(DfsVisitor* visitor) {
@@ -352,35 +413,70 @@ absl::Status Node::VisitSingleNode(DfsVisitor* visitor) {
   return absl::OkStatus();
 }
 
-absl::Status Node::Accept(DfsVisitor* visitor) {
-  if (visitor->IsVisited(this)) {
-    return absl::OkStatus();
-  }
-  if (visitor->IsTraversing(this)) {
-    std::vector<std::string> cycle_names = {GetName()};
-    Node* node = this;
-    do {
-      bool broke = false;
-      for (Node* operand : node->operands()) {
-        if (visitor->IsTraversing(operand)) {
-          node = operand;
-          broke = true;
-          break;
-        }
+namespace {
+
+// Returns an error describing the operand cycle containing `node`. Only
+// called when a cycle has been detected, i.e. `node` was reached again while
+// it was still being traversed.
+absl::Status CycleDetectedError(Node* node, DfsVisitor* visitor) {
+  std::vector<std::string> cycle_names = {node->GetName()};
+  Node* element = node;
+  do {
+    bool broke = false;
+    for (Node* operand : element->operands()) {
+      if (visitor->IsTraversing(operand)) {
+        element = operand;
+        broke = true;
+        break;
       }
-      CHECK(broke);
-      cycle_names.push_back(node->GetName());
-    } while (node != this);
-    return absl::InternalError(absl::StrFormat(
-        "Cycle detected: [%s]", absl::StrJoin(cycle_names, " -> ")));
-  }
-  visitor->SetTraversing(this);
-  for (Node* operand : operands()) {
-    XLS_RETURN_IF_ERROR(operand->Accept(visitor));
+    }
+    CHECK(broke);
+    cycle_names.push_back(element->GetName());
+  } while (element != node);
+  return absl::InternalError(absl::StrFormat(
+      "Cycle detected: [%s]", absl::StrJoin(cycle_names, " -> ")));
+}
+
+}  // namespace
+
+absl::Status Node::Accept(DfsVisitor* visitor) {
+  // Iterative post-order traversal with an explicit stack. Deep operand
+  // chains would overflow the call stack with a recursive formulation, and
+  // the explicit stack also avoids per-node call overhead on large graphs.
+  // Each node is pushed unexpanded first; popping an unexpanded frame pushes
+  // the expanded frame followed by the operands, and popping the expanded
+  // frame performs the post-order visit.
+  std::vector<std::pair<Node*, bool>> dfs_stack;
+  dfs_stack.push_back({this, /*expanded=*/false});
+  while (!dfs_stack.empty()) {
+    auto [node, expanded] = dfs_stack.back();
+    dfs_stack.pop_back();
+    if (expanded) {
+      visitor->UnsetTraversing(node);
+      visitor->MarkVisited(node);
+      XLS_RETURN_IF_ERROR(node->VisitSingleNode(visitor));
+      continue;
+    }
+    if (visitor->IsVisited(node)) {
+      continue;
+    }
+    if (visitor->IsTraversing(node)) {
+      // A node can legitimately appear several times in the stack when it has
+      // multiple users in the traversed cone, but those duplicate frames are
+      // always popped after the node's expanded frame has marked it visited.
+      // Popping an unexpanded frame for a node still being traversed means
+      // the node was reached from its own operand subtree: a cycle.
+      return CycleDetectedError(node, visitor);
+    }
+    visitor->SetTraversing(node);
+    dfs_stack.push_back({node, /*expanded=*/true});
+    // Push operands in reverse so they are traversed in operand order,
+    // matching the recursive visitation order.
+    for (int64_t i = node->operand_count() - 1; i >= 0; --i) {
+      dfs_stack.push_back({node->operand(i), /*expanded=*/false});
+    }
   }
-  visitor->UnsetTraversing(this);
-  visitor->MarkVisited(this);
-  return VisitSingleNode(visitor);
+  return absl::OkStatus();
 }
 
 bool Node::IsDefinitelyEqualTo(const Node* other) const {
@@ -411,25 +507,42 @@ bool Node::IsDefinitelyEqualTo(const Node* other) const {
 }
 
 std::string Node::GetName() const {
-  if (!name_.empty()) {
-    return name_;
+  if (has_assigned_name_) {
+    return std::string(package()->GetNodeName(id_));
   }
   // Return a generated name based on the id.
   return absl::StrFormat("%s.%d", OpToString(op()), id());
 }
 
+std::string_view Node::AssignedName() const {
+  return has_assigned_name_ ? package()->GetNodeName(id_) : std::string_view();
+}
+
 void Node::SetName(std::string_view name) {
-  name_ = function_base()->UniquifyNodeName(name);
+  package()->SetNodeName(id_, function_base()->UniquifyNodeName(name));
+  has_assigned_name_ = true;
 }
 
-void Node::SetNameDirectly(std::string_view name) { name_ = std::string(name); }
+void Node::SetNameDirectly(std::string_view name) {
+  package()->SetNodeName(id_, name);
+  has_assigned_name_ = true;
+}
 
 void Node::ClearName() {
   CHECK(!Is<Param>());
-  name_ = "";
+  if (has_assigned_name_) {
+    package()->ClearNodeName(id_);
+    has_assigned_name_ = false;
+  }
 }
 
-void Node::SetLoc(const SourceInfo& loc) { loc_ = loc; }
+const SourceInfo& Node::loc() const {
+  return package()->GetSourceInfo(loc_id_);
+}
+
+void Node::SetLoc(const SourceInfo& loc) {
+  loc_id_ = package()->InternSourceInfo(loc);
+}
 
 std::string Node::ToStringInternal(bool include_operand_types) const {
   std::string ret = absl::StrCat(GetName(), ": ", GetType()->ToString(), " = ",
@@ -670,7 +783,8 @@ std::string Node::GetUsersString() const {
 }
 
 bool Node::HasUser(const Node* target) const {
-  return users_.contains(const_cast<Node*>(target));
+  return std::binary_search(users_.begin(), users_.end(),
+                            const_cast<Node*>(target), NodeIdLessThan());
 }
 
 bool Node::IsDead() const {
@@ -698,15 +812,25 @@ int64_t Node::OperandInstanceCount(const Node* target) const {
 }
 
 void Node::SetId(int64_t id) {
-  // The data structure (btree) containing the users of each node is sorted by
-  // node id. To avoid violating invariants of the data structure, remove this
-  // node from all users lists, change id, then read to users list.
+  // The user list of each node is sorted by node id. To avoid violating that
+  // invariant, remove this node from all users lists, change id, then re-add
+  // to the users lists.
   for (Node* operand : operands()) {
-    operand->users_.erase(this);
+    auto it = std::lower_bound(operand->users_.begin(), operand->users_.end(),
+                               this, NodeIdLessThan());
+    if (it != operand->users_.end() && *it == this) {
+      operand->users_.erase(it);
+    }
+  }
+  // Assigned names are keyed by node id in the package, so move the entry to
+  // the new id.
+  if (has_assigned_name_ && id != id_) {
+    package()->SetNodeName(id, package()->GetNodeName(id_));
+    package()->ClearNodeName(id_);
   }
   id_ = id;
   for (Node* operand : operands()) {
-    operand->users_.insert(this);
+    operand->AddUser(this);
   }
   package()->set_next_node_id(std::max(id + 1, package()->next_node_id()));
 }
@@ -724,7 +848,11 @@ bool Node::ReplaceOperand(Node* old_operand, Node* new_operand) {
   if (this == new_operand) {
     return true;
   }
-  ++package()->transform_metrics().operands_replaced;
+  package()->transform_metrics().operands_replaced.fetch_add(
+      1, std::memory_order_relaxed);
+  function_base()->BumpTransformVersion();
+  function_base()->RecordNodeChange(this);
+  function_base()->RecordNodeChange(old_operand);
   bool did_replace = false;
   for (int64_t i = 0; i < operand_count(); ++i) {
     if (operands_[i] == old_operand) {
@@ -748,7 +876,11 @@ absl::Status Node::ReplaceOperandNumber(int64_t operand_no, Node* new_operand,
         << "old operand type: " << old_operand->GetType()->ToString()
         << " new operand type: " << new_operand->GetType()->ToString();
   }
-  ++package()->transform_metrics().operands_replaced;
+  package()->transform_metrics().operands_replaced.fetch_add(
+      1, std::memory_order_relaxed);
+  function_base()->BumpTransformVersion();
+  function_base()->RecordNodeChange(this);
+  function_base()->RecordNodeChange(old_operand);
 
   // AddUser is idempotent so even if the new operand is already used by this
   // node in another operand slot, it is safe to call.
@@ -772,7 +904,11 @@ absl::Status Node::ReplaceUsesWith(Node* replacement,
   XLS_RET_CHECK(GetType() == replacement->GetType())
       << "type was: " << GetType()->ToString()
       << " replacement: " << replacement->GetType()->ToString();
-  ++package()->transform_metrics().nodes_replaced;
+  package()->transform_metrics().nodes_replaced.fetch_add(
+      1, std::memory_order_relaxed);
+  function_base()->BumpTransformVersion();
+  function_base()->RecordNodeChange(this);
+  function_base()->RecordNodeChange(replacement);
   bool all_replaced = true;
   std::vector<Node*> orig_users(users().begin(), users().end());
   for (Node* user : orig_users) {
@@ -801,7 +937,7 @@ absl::Status Node::ReplaceUsesWith(Node* replacement,
       !replacement->HasAssignedName()) {
     // Do not use SetName because we do not want the name to be uniqued which
     // would add a suffix because (clearly) the name already exists.
-    replacement->name_ = name_;
+    replacement->SetNameDirectly(AssignedName());
     ClearName();
   }
   return absl::OkStatus();
@@ -15,6 +15,7 @@
 #ifndef XLS_IR_NODE_H_
 #define XLS_IR_NODE_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -22,9 +23,8 @@
 #include <string>
 #include <string_view>
 #include <utility>
-#include <vector>
 
-#include "absl/container/btree_set.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -41,6 +41,7 @@ namespace xls {
 class Package;
 class Node;
 class FunctionBase;
+class NodeArena;
 
 // Forward decaration to avoid circular dependency.
 class DfsVisitor;
@@ -52,6 +53,18 @@ class Node {
  public:
   virtual ~Node() = default;
 
+  // Nodes are preferentially allocated from the NodeArena owned by the
+  // enclosing Package (see FunctionBase::MakeNode) which lays nodes out
+  // contiguously in creation order. Allocations not routed through an arena
+  // (e.g., plain std::make_unique) fall back to the global heap. A small
+  // header in front of each node records its origin so the ordinary delete
+  // path works for both cases.
+  static void* operator new(size_t size, NodeArena& arena);
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+  // Matching placement delete; only invoked if a node constructor throws.
+  static void operator delete(void* ptr, NodeArena& arena);
+
   // Accepts the visitor, instructing it to visit this node.
   //
   // The visitor is instructed to visit this node with:
@@ -76,7 +89,10 @@ class Node {
   Op op() const { return op_; }
   FunctionBase* function_base() const { return function_base_; }
   Package* package() const;
-  const SourceInfo& loc() const { return loc_; }
+  // Returns the source locations associated with this node. The returned
+  // reference points into the package-wide intern table of location lists and
+  // is stable for the lifetime of the package.
+  const SourceInfo& loc() const;
 
   // Returns the sequence of operands used by this node.
   //
@@ -174,12 +190,17 @@ class Node {
   // Returns whether this node was assigned a name at construction. Nodes
   // without assigned names will have names generated from the opcode and unique
   // id.
-  bool HasAssignedName() const { return !name_.empty(); }
+  bool HasAssignedName() const { return has_assigned_name_; }
 
   // Returns name of this node. If not assigned at construction time, the name
   // is generated from the opcode and unique id (e.g. "add.2");
   std::string GetName() const;
 
+  // Returns the explicitly-assigned name of this node, or an empty view if no
+  // name was assigned. The view points into a package-owned table and remains
+  // valid until the name is changed or cleared.
+  std::string_view AssignedName() const;
+
   // Sets the name of this node. After this method is called. HasAssignedName
   // will return true.
   void SetName(std::string_view name);
@@ -225,7 +246,7 @@ class Node {
   };
 
   // Returns the unique set of users of this node sorted by id.
-  const absl::btree_set<Node*, NodeIdLessThan>& users() const { return users_; }
+  absl::Span<Node* const> users() const { return users_; }
 
   // Helper for querying whether "target" is a user of this node.
   bool HasUser(const Node* target) const;
@@ -313,13 +334,26 @@ class Node {
   int64_t id_;
   Op op_;
   Type* type_;
-  SourceInfo loc_;
-  std::string name_;
-
-  std::vector<Node*> operands_;
-
-  // Set of users sorted by node_id for stability.
-  absl::btree_set<Node*, NodeIdLessThan> users_;
+  // Handle of this node's source locations in the package-wide intern table
+  // (see Package::InternSourceInfo). After inlining many nodes share
+  // identical location chains, so storing a handle rather than the location
+  // vector itself substantially shrinks Node.
+  int32_t loc_id_;
+  // Whether a name was explicitly assigned to this node. Assigned names live
+  // in a package-side table keyed by node id (see Package::SetNodeName);
+  // default names are synthesized on demand so unnamed nodes, the common
+  // case, carry no string at all.
+  bool has_assigned_name_ = false;
+
+  // Most nodes have no more than two operands and a handful of users, so both
+  // edge lists are stored inline in the Node itself and only spill to the heap
+  // for high-fanin/fanout nodes. This shrinks Node and avoids a pair of heap
+  // allocations per node.
+  absl::InlinedVector<Node*, 2> operands_;
+
+  // Unique users sorted by node id (see NodeIdLessThan) for stable iteration
+  // order. Maintained by AddUser/RemoveUser.
+  absl::InlinedVector<Node*, 4> users_;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Node& node) {
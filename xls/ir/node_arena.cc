@@ -0,0 +1,57 @@
+// Copyright 2024 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/node_arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+
+namespace xls {
+
+void* NodeArena::Allocate(size_t size) {
+  size_t size_class = SizeClass(size);
+  absl::MutexLock lock(&mutex_);
+  auto it = free_lists_.find(size_class);
+  if (it != free_lists_.end() && !it->second.empty()) {
+    void* slot = it->second.back();
+    it->second.pop_back();
+    return slot;
+  }
+  if (size_class > kChunkSize) {
+    // Oversized allocation; give it a dedicated chunk.
+    chunks_.push_back(std::make_unique<char[]>(size_class));
+    return chunks_.back().get();
+  }
+  if (static_cast<int64_t>(size_class) > remaining_) {
+    chunks_.push_back(std::make_unique<char[]>(kChunkSize));
+    next_ = chunks_.back().get();
+    remaining_ = kChunkSize;
+  }
+  void* slot = next_;
+  next_ += size_class;
+  remaining_ -= size_class;
+  return slot;
+}
+
+void NodeArena::Deallocate(void* ptr, size_t size) {
+  size_t size_class = SizeClass(size);
+  absl::MutexLock lock(&mutex_);
+  free_lists_[size_class].push_back(ptr);
+}
+
+}  // namespace xls
@@ -0,0 +1,78 @@
+// Copyright 2024 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_IR_NODE_ARENA_H_
+#define XLS_IR_NODE_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace xls {
+
+// A slab allocator for IR Node objects. Allocations are bump-allocated out of
+// large contiguous chunks so nodes created together are adjacent in memory,
+// which substantially improves locality for the traversal-heavy optimization
+// passes. Deallocated slots are recycled via per-size-class free lists; chunk
+// memory itself is only released when the arena (i.e., the owning Package) is
+// destroyed.
+//
+// Allocation and deallocation are thread-safe so that nodes may be created
+// concurrently in different FunctionBases of the same package.
+class NodeArena {
+ public:
+  NodeArena() = default;
+  NodeArena(const NodeArena&) = delete;
+  NodeArena& operator=(const NodeArena&) = delete;
+
+  // Returns a pointer to uninitialized storage of at least `size` bytes
+  // aligned suitably for any Node type.
+  void* Allocate(size_t size);
+
+  // Returns the storage at `ptr` (previously returned by Allocate with the
+  // same `size`) to the arena for reuse. The chunk backing the storage is not
+  // freed until the arena is destroyed.
+  void Deallocate(void* ptr, size_t size);
+
+ private:
+  // Granularity of size classes. Also the alignment of returned storage.
+  static constexpr int64_t kAlignment = 16;
+
+  // Size of each chunk of slab storage. Allocations larger than this fall
+  // back to a dedicated chunk.
+  static constexpr int64_t kChunkSize = 256 * 1024;
+
+  // Rounds `size` up to the next multiple of kAlignment.
+  static size_t SizeClass(size_t size) {
+    return (size + kAlignment - 1) & ~static_cast<size_t>(kAlignment - 1);
+  }
+
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<char[]>> chunks_ ABSL_GUARDED_BY(mutex_);
+  char* next_ ABSL_GUARDED_BY(mutex_) = nullptr;
+  int64_t remaining_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // Recycled slots indexed by size class.
+  absl::flat_hash_map<size_t, std::vector<void*>> free_lists_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace xls
+
+#endif  // XLS_IR_NODE_ARENA_H_
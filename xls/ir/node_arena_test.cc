@@ -0,0 +1,55 @@
+// Copyright 2024 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/node_arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace xls {
+namespace {
+
+TEST(NodeArenaTest, AllocationsAreAlignedAndUsable) {
+  NodeArena arena;
+  std::vector<void*> ptrs;
+  for (int64_t i = 0; i < 1000; ++i) {
+    void* p = arena.Allocate(48);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 16, 0);
+    std::memset(p, 0xab, 48);
+    ptrs.push_back(p);
+  }
+  for (void* p : ptrs) {
+    arena.Deallocate(p, 48);
+  }
+}
+
+TEST(NodeArenaTest, DeallocatedSlotsAreRecycled) {
+  NodeArena arena;
+  void* p = arena.Allocate(64);
+  arena.Deallocate(p, 64);
+  EXPECT_EQ(arena.Allocate(64), p);
+}
+
+TEST(NodeArenaTest, OversizedAllocation) {
+  NodeArena arena;
+  void* p = arena.Allocate(1024 * 1024);
+  std::memset(p, 0, 1024 * 1024);
+  arena.Deallocate(p, 1024 * 1024);
+}
+
+}  // namespace
+}  // namespace xls
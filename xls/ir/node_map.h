@@ -0,0 +1,121 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_IR_NODE_MAP_H_
+#define XLS_IR_NODE_MAP_H_
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "xls/ir/node.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+
+// A side table mapping nodes to values of type T, backed by a vector indexed
+// by Node::id() instead of a hash table. Node ids are dense within a package,
+// so lookups are a single array index rather than a pointer hash; in analyses
+// which query per-node data along every edge of the graph this is
+// substantially cheaper than absl::flat_hash_map<Node*, T>.
+//
+// Node ids are never reused within a package, so an entry remains associated
+// with the node it was written for over the table's lifetime. Nodes created
+// after construction are accommodated by growing the table on demand; the
+// table does not observe node deletion, so (as with a Node*-keyed hash map)
+// entries for deleted nodes must not be queried.
+template <typename T>
+class NodeMap {
+ public:
+  NodeMap() = default;
+
+  // Constructs a table pre-sized for all nodes currently in `package`.
+  explicit NodeMap(const Package* package)
+      : values_(package->next_node_id()) {}
+
+  // Returns whether an entry is present for `node`.
+  bool contains(const Node* node) const {
+    return node->id() < static_cast<int64_t>(values_.size()) &&
+           values_[node->id()].has_value();
+  }
+
+  // Returns a reference to the value for `node`, default-constructing (and
+  // growing the table) if no entry is present.
+  T& operator[](const Node* node) {
+    Grow(node->id());
+    std::optional<T>& slot = values_[node->id()];
+    if (!slot.has_value()) {
+      slot.emplace();
+      ++size_;
+    }
+    return *slot;
+  }
+
+  // Returns the value for `node`. An entry must be present.
+  const T& at(const Node* node) const {
+    CHECK(contains(node)) << "No entry for node: " << node->GetName();
+    return *values_[node->id()];
+  }
+  T& at(const Node* node) {
+    CHECK(contains(node)) << "No entry for node: " << node->GetName();
+    return *values_[node->id()];
+  }
+
+  // Inserts or overwrites the entry for `node`.
+  void insert_or_assign(const Node* node, T value) {
+    Grow(node->id());
+    std::optional<T>& slot = values_[node->id()];
+    if (!slot.has_value()) {
+      ++size_;
+    }
+    slot = std::move(value);
+  }
+
+  // Removes the entry for `node` if present. Returns whether an entry was
+  // removed.
+  bool erase(const Node* node) {
+    if (!contains(node)) {
+      return false;
+    }
+    values_[node->id()].reset();
+    --size_;
+    return true;
+  }
+
+  // Number of entries present in the table.
+  int64_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    values_.clear();
+    size_ = 0;
+  }
+
+ private:
+  // Grows the backing vector to cover `id`.
+  void Grow(int64_t id) {
+    if (id >= static_cast<int64_t>(values_.size())) {
+      values_.resize(id + 1);
+    }
+  }
+
+  std::vector<std::optional<T>> values_;
+  int64_t size_ = 0;
+};
+
+}  // namespace xls
+
+#endif  // XLS_IR_NODE_MAP_H_
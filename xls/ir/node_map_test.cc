@@ -0,0 +1,93 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/node_map.h"
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/source_location.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+class NodeMapTest : public IrTestBase {};
+
+TEST_F(NodeMapTest, BasicOperations) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue y = fb.Param("y", p->GetBitsType(8));
+  BValue add = fb.Add(x, y);
+  XLS_ASSERT_OK(fb.Build().status());
+
+  NodeMap<int64_t> map(p.get());
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(x.node()));
+
+  map[x.node()] = 1;
+  map.insert_or_assign(y.node(), 2);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_TRUE(map.contains(x.node()));
+  EXPECT_EQ(map.at(x.node()), 1);
+  EXPECT_EQ(map.at(y.node()), 2);
+  EXPECT_FALSE(map.contains(add.node()));
+
+  // operator[] default-constructs missing entries.
+  EXPECT_EQ(map[add.node()], 0);
+  EXPECT_EQ(map.size(), 3);
+
+  map.insert_or_assign(x.node(), 10);
+  EXPECT_EQ(map.at(x.node()), 10);
+  EXPECT_EQ(map.size(), 3);
+
+  EXPECT_TRUE(map.erase(x.node()));
+  EXPECT_FALSE(map.erase(x.node()));
+  EXPECT_FALSE(map.contains(x.node()));
+  EXPECT_EQ(map.size(), 2);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+}
+
+TEST_F(NodeMapTest, GrowsForNodesCreatedAfterConstruction) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  NodeMap<std::string> map(p.get());
+  map[x.node()] = "x";
+
+  // A node created after the table exists is accommodated by growth.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * literal,
+      f->MakeNode<Literal>(SourceInfo(), Value(UBits(7, 8))));
+  EXPECT_FALSE(map.contains(literal));
+  map[literal] = "literal";
+  EXPECT_EQ(map.at(literal), "literal");
+  EXPECT_EQ(map.at(x.node()), "x");
+}
+
+}  // namespace
+}  // namespace xls
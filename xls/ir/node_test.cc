@@ -14,6 +14,7 @@
 
 #include "xls/ir/node.h"
 
+#include <cstdint>
 #include <string_view>
 #include <type_traits>
 #include <vector>
@@ -565,6 +566,36 @@ TEST_F(NodeTest, NodeNames) {
   EXPECT_TRUE(f->return_value()->HasAssignedName());
 }
 
+TEST_F(NodeTest, AssignedNamesTrackNodeId) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(8));
+  auto named = fb.Not(x, SourceInfo(), /*name=*/"inverted");
+  auto unnamed = fb.Not(named);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(unnamed));
+
+  EXPECT_EQ(named.node()->AssignedName(), "inverted");
+  EXPECT_FALSE(unnamed.node()->HasAssignedName());
+  EXPECT_TRUE(unnamed.node()->AssignedName().empty());
+
+  // Names are keyed by node id in the package-side table, so they must follow
+  // the node across id changes.
+  named.node()->SetId(12345);
+  EXPECT_EQ(named.node()->GetName(), "inverted");
+
+  // Removing a named node drops its table entry; reusing the id afterwards
+  // does not resurrect the old name.
+  int64_t removed_id = named.node()->id();
+  XLS_ASSERT_OK(unnamed.node()->ReplaceUsesWith(x.node()));
+  XLS_ASSERT_OK(f->RemoveNode(unnamed.node()));
+  XLS_ASSERT_OK(f->RemoveNode(named.node()));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * fresh, f->MakeNode<UnOp>(SourceInfo(), x.node(), Op::kNot));
+  fresh->SetId(removed_id);
+  EXPECT_FALSE(fresh->HasAssignedName());
+  EXPECT_EQ(fresh->GetName(), "not.12345");
+}
+
 TEST_F(NodeTest, IsDead) {
   auto p = CreatePackage();
   XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
@@ -629,5 +660,26 @@ TEST_F(NodeTest, MakeNodeForType) {
   static_assert(!MakeNodeWillSubstituteWith<Block::Port>::value);
 }
 
+TEST_F(NodeTest, UsersAreUniqueAndSortedById) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  // Create enough users to spill past the inline user storage, including one
+  // node which uses 'x' twice.
+  std::vector<BValue> users;
+  users.push_back(fb.Add(x, x));
+  for (int64_t i = 1; i < 8; ++i) {
+    users.push_back(fb.Negate(x));
+  }
+  XLS_ASSERT_OK(fb.Build().status());
+
+  ASSERT_EQ(x.node()->users().size(), 8);
+  for (int64_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(x.node()->users()[i], users[i].node());
+    EXPECT_TRUE(x.node()->HasUser(users[i].node()));
+  }
+  EXPECT_FALSE(x.node()->HasUser(x.node()));
+}
+
 }  // namespace
 }  // namespace xls
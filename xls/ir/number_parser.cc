@@ -20,16 +20,18 @@
 #include <string>
 #include <string_view>
 #include <utility>
-#include <vector>
 
+#include "absl/numeric/bits.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_replace.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/common/string_to_int.h"
+#include "xls/data_structures/inline_bitmap.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_ops.h"
 #include "xls/ir/format_preference.h"
@@ -45,13 +47,30 @@ static absl::StatusOr<Bits> ParseUnsignedNumberHelper(
     return absl::InvalidArgumentError("Cannot specify default format.");
   }
 
-  std::string numeric_string = absl::StrReplaceAll(input, {{"_", ""}});
+  // Only pay for the underscore-stripping copy when the literal actually
+  // contains separators; most literals in dumped IR do not.
+  std::string stripped;
+  std::string_view numeric_string = input;
+  if (absl::StrContains(input, '_')) {
+    stripped = absl::StrReplaceAll(input, {{"_", ""}});
+    numeric_string = stripped;
+  }
   if (numeric_string.empty()) {
     return absl::InvalidArgumentError(
         absl::StrFormat("Could not convert %s to a number", orig_string));
   }
 
   if (format == FormatPreference::kUnsignedDecimal) {
+    // Values of up to 19 digits fit in a uint64_t; convert in one shot and
+    // size the result to the significant bits.
+    if (numeric_string.size() <= 19) {
+      uint64_t value;
+      if (!absl::SimpleAtoi(numeric_string, &value)) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Could not convert %s to 32-bit decimal number", orig_string));
+      }
+      return UBits(value, 64 - absl::countl_zero(value));
+    }
     Bits result(UBits(0, 32));
     Bits bits_10(UBits(10, 8));
     for (int i = 0; i < numeric_string.size(); i++) {
@@ -86,25 +105,26 @@ static absl::StatusOr<Bits> ParseUnsignedNumberHelper(
         absl::StrFormat("Invalid format: %d", format));
   }
 
-  // Walk through string 64 bits at a time (16 hexadecimal symbols or 64
-  // binary symbols) and convert each to a separate Bits value. Then
-  // concatenate them all together.
+  // Walk through the string 64 bits (16 hexadecimal symbols or 64 binary
+  // symbols) at a time starting from the least significant digit, packing
+  // each group directly into the corresponding word of a pre-sized bitmap.
   const int64_t step_size = 64 / base_bits;
-  std::vector<Bits> chunks;
-  for (int64_t i = 0; i < numeric_string.size(); i = i + step_size) {
-    int64_t chunk_length =
-        std::min<int64_t>(step_size, numeric_string.size() - i);
-    absl::StatusOr<uint64_t> chunk_value_or =
-        StrTo64Base(numeric_string.substr(i, chunk_length), base);
-    if (!chunk_value_or.ok()) {
+  const int64_t num_digits = numeric_string.size();
+  InlineBitmap bitmap(num_digits * base_bits);
+  for (int64_t word = 0; word * step_size < num_digits; ++word) {
+    int64_t digits_end = num_digits - word * step_size;
+    int64_t digits_begin = std::max<int64_t>(0, digits_end - step_size);
+    absl::StatusOr<uint64_t> word_value_or = StrTo64Base(
+        numeric_string.substr(digits_begin, digits_end - digits_begin), base);
+    if (!word_value_or.ok()) {
       return absl::InvalidArgumentError(
           absl::StrFormat("Could not convert %s to %s number: %s", orig_string,
-                          base_name, chunk_value_or.status().message()));
+                          base_name, word_value_or.status().message()));
     }
-    chunks.push_back(UBits(*chunk_value_or, chunk_length * base_bits));
+    bitmap.SetWord(word, *word_value_or);
   }
 
-  Bits unnarrowed = bits_ops::Concat(chunks);
+  Bits unnarrowed = Bits::FromBitmap(std::move(bitmap));
   if (bit_count == kMinimumBitCount) {
     // Narrow the Bits value to be just wide enough to hold the value.
     int64_t new_width = unnarrowed.bit_count() - unnarrowed.CountLeadingZeros();
@@ -129,6 +129,10 @@ TEST(NumberParserTest, ParseNumbersWithoutPrefix) {
   expect_bits_value("42", FormatPreference::kUnsignedDecimal, UBits(42, 6));
   expect_bits_value("1234567890", FormatPreference::kUnsignedDecimal,
                     UBits(1234567890ULL, 31));
+  // 19 digits is the largest decimal handled by the uint64_t fast path; 20
+  // digits takes the digit-by-digit loop.
+  expect_bits_value("9223372036854775807", FormatPreference::kUnsignedDecimal,
+                    UBits(9223372036854775807ULL, 63));
   expect_bits_value("12345678901234567890", FormatPreference::kUnsignedDecimal,
                     UBits(12345678901234567890ULL, 64));
 
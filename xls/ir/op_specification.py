@@ -420,7 +420,7 @@ class OpClass(object):
     args.extend('{}()'.format(a.name) for a in self.attributes)
     args.extend(a.clone_expression for a in self.extra_constructor_args)
     if 'name' not in [a.name for a in self.extra_constructor_args]:
-      args.append('name_')
+      args.append('AssignedName()')
     return ', '.join(args)
 
   def data_members(self) -> Iterable[DataMember]:
@@ -1012,7 +1012,9 @@ OpClass.kinds['PARAM'] = OpClass(
     ],
     extra_methods=[
         Method(
-            name='name', return_cpp_type='std::string_view', expression='name_'
+            name='name',
+            return_cpp_type='std::string_view',
+            expression='AssignedName()',
         )
     ],
     custom_clone_method=True,
@@ -1149,7 +1151,9 @@ OpClass.kinds['INPUT_PORT'] = OpClass(
     ],
     extra_methods=[
         Method(
-            name='name', return_cpp_type='std::string_view', expression='name_'
+            name='name',
+            return_cpp_type='std::string_view',
+            expression='AssignedName()',
         )
     ],
 )
@@ -1166,7 +1170,9 @@ OpClass.kinds['OUTPUT_PORT'] = OpClass(
     ],
     extra_methods=[
         Method(
-            name='name', return_cpp_type='std::string_view', expression='name_'
+            name='name',
+            return_cpp_type='std::string_view',
+            expression='AssignedName()',
         )
     ],
 )
@@ -15,11 +15,13 @@
 #include "xls/ir/package.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <optional>
 #include <ostream>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -34,6 +36,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
@@ -58,7 +61,42 @@
 namespace xls {
 
 Package::Package(std::string_view name) : name_(name) {
-  owned_types_.insert(&token_type_);
+  {
+    absl::MutexLock lock(&type_mutex_);
+    owned_types_.insert(&token_type_);
+  }
+  // Reserve handle 0 for the empty SourceInfo.
+  InternSourceInfo(SourceInfo());
+}
+
+int32_t Package::InternSourceInfo(const SourceInfo& info) {
+  absl::MutexLock lock(&source_info_mutex_);
+  auto [it, inserted] = source_info_to_handle_.try_emplace(
+      info, static_cast<int32_t>(source_info_by_handle_.size()));
+  if (inserted) {
+    source_info_by_handle_.push_back(&it->first);
+  }
+  return it->second;
+}
+
+const SourceInfo& Package::GetSourceInfo(int32_t handle) const {
+  absl::MutexLock lock(&source_info_mutex_);
+  return *source_info_by_handle_.at(handle);
+}
+
+void Package::SetNodeName(int64_t node_id, std::string_view name) {
+  absl::MutexLock lock(&node_name_mutex_);
+  node_names_.insert_or_assign(node_id, std::string(name));
+}
+
+std::string_view Package::GetNodeName(int64_t node_id) const {
+  absl::MutexLock lock(&node_name_mutex_);
+  return node_names_.at(node_id);
+}
+
+void Package::ClearNodeName(int64_t node_id) {
+  absl::MutexLock lock(&node_name_mutex_);
+  node_names_.erase(node_id);
 }
 
 Package::~Package() = default;
@@ -148,16 +186,19 @@ absl::StatusOr<FunctionBase*> Package::GetFunctionBaseByName(
 }
 
 Function* Package::AddFunction(std::unique_ptr<Function> f) {
+  absl::MutexLock lock(&function_bases_mutex_);
   functions_.push_back(std::move(f));
   return functions_.back().get();
 }
 
 Proc* Package::AddProc(std::unique_ptr<Proc> proc) {
+  absl::MutexLock lock(&function_bases_mutex_);
   procs_.push_back(std::move(proc));
   return procs_.back().get();
 }
 
 Block* Package::AddBlock(std::unique_ptr<Block> block) {
+  absl::MutexLock lock(&function_bases_mutex_);
   blocks_.push_back(std::move(block));
   return blocks_.back().get();
 }
@@ -321,6 +362,7 @@ absl::StatusOr<Package::PackageMergeResult> Package::AddPackage(
 
 absl::StatusOr<Function*> Package::GetFunction(
     std::string_view func_name) const {
+  absl::MutexLock lock(&function_bases_mutex_);
   for (auto& f : functions_) {
     if (f->name() == func_name) {
       return f.get();
@@ -336,6 +378,7 @@ absl::StatusOr<Function*> Package::GetFunction(
 }
 
 absl::StatusOr<Proc*> Package::GetProc(std::string_view proc_name) const {
+  absl::MutexLock lock(&function_bases_mutex_);
   for (auto& p : procs_) {
     if (p->name() == proc_name) {
       return p.get();
@@ -351,6 +394,7 @@ absl::StatusOr<Proc*> Package::GetProc(std::string_view proc_name) const {
 }
 
 absl::StatusOr<Block*> Package::GetBlock(std::string_view block_name) const {
+  absl::MutexLock lock(&function_bases_mutex_);
   for (auto& block : blocks_) {
     if (block->name() == block_name) {
       return block.get();
@@ -367,6 +411,7 @@ absl::StatusOr<Block*> Package::GetBlock(std::string_view block_name) const {
 
 std::optional<Function*> Package::TryGetFunction(
     std::string_view func_name) const {
+  absl::MutexLock lock(&function_bases_mutex_);
   for (auto& f : functions_) {
     if (f->name() == func_name) {
       return f.get();
@@ -376,6 +421,7 @@ std::optional<Function*> Package::TryGetFunction(
 }
 
 std::optional<Proc*> Package::TryGetProc(std::string_view proc_name) const {
+  absl::MutexLock lock(&function_bases_mutex_);
   for (auto& p : procs_) {
     if (p->name() == proc_name) {
       return p.get();
@@ -385,6 +431,7 @@ std::optional<Proc*> Package::TryGetProc(std::string_view proc_name) const {
 }
 
 std::optional<Block*> Package::TryGetBlock(std::string_view block_name) const {
+  absl::MutexLock lock(&function_bases_mutex_);
   for (auto& block : blocks_) {
     if (block->name() == block_name) {
       return block.get();
@@ -407,6 +454,29 @@ std::vector<FunctionBase*> Package::GetFunctionBases() const {
   return result;
 }
 
+absl::Status Package::ReorderFunctionBases(
+    absl::Span<FunctionBase* const> order) {
+  XLS_RET_CHECK_EQ(order.size(),
+                   functions_.size() + procs_.size() + blocks_.size());
+  absl::flat_hash_map<FunctionBase*, int64_t> rank;
+  rank.reserve(order.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(order.size()); ++i) {
+    XLS_RET_CHECK(rank.emplace(order[i], i).second)
+        << "Duplicate FunctionBase in order: " << order[i]->name();
+  }
+  for (FunctionBase* fb : GetFunctionBases()) {
+    XLS_RET_CHECK(rank.contains(fb))
+        << "FunctionBase not in order: " << fb->name();
+  }
+  auto by_rank = [&rank](const auto& a, const auto& b) {
+    return rank.at(a.get()) < rank.at(b.get());
+  };
+  std::stable_sort(functions_.begin(), functions_.end(), by_rank);
+  std::stable_sort(procs_.begin(), procs_.end(), by_rank);
+  std::stable_sort(blocks_.begin(), blocks_.end(), by_rank);
+  return absl::OkStatus();
+}
+
 absl::Status Package::RemoveFunctionBase(FunctionBase* function_base) {
   if (function_base->IsFunction()) {
     return RemoveFunction(function_base->AsFunctionOrDie());
@@ -517,41 +587,68 @@ absl::StatusOr<Type*> Package::MapTypeFromOtherPackage(
 }
 
 BitsType* Package::GetBitsType(int64_t bit_count) {
-  if (bit_count_to_type_.find(bit_count) != bit_count_to_type_.end()) {
-    return &bit_count_to_type_.at(bit_count);
+  // Lock-free fast path for small widths, which account for nearly all
+  // lookups. The cached pointer is published once and never changes.
+  if (bit_count < kSmallBitsTypeLimit) {
+    if (BitsType* type =
+            small_bits_types_[bit_count].load(std::memory_order_acquire);
+        type != nullptr) {
+      return type;
+    }
+  }
+  absl::MutexLock lock(&type_mutex_);
+  auto it = bit_count_to_type_.find(bit_count);
+  if (it == bit_count_to_type_.end()) {
+    it = bit_count_to_type_.emplace(bit_count, BitsType(bit_count)).first;
+    owned_types_.insert(&it->second);
+  }
+  BitsType* type = &it->second;
+  if (bit_count < kSmallBitsTypeLimit) {
+    small_bits_types_[bit_count].store(type, std::memory_order_release);
   }
-  auto it = bit_count_to_type_.emplace(bit_count, BitsType(bit_count));
-  BitsType* new_type = &(it.first->second);
-  owned_types_.insert(new_type);
-  return new_type;
+  return type;
 }
 
 ArrayType* Package::GetArrayType(int64_t size, Type* element_type) {
   ArrayKey key{size, element_type};
-  if (array_types_.find(key) != array_types_.end()) {
-    return &array_types_.at(key);
+  {
+    absl::ReaderMutexLock lock(&type_mutex_);
+    auto it = array_types_.find(key);
+    if (it != array_types_.end()) {
+      return &it->second;
+    }
+  }
+  absl::MutexLock lock(&type_mutex_);
+  auto it = array_types_.find(key);
+  if (it == array_types_.end()) {
+    CHECK(owned_types_.contains(element_type))
+        << "Type is not owned by package: " << *element_type;
+    it = array_types_.emplace(key, ArrayType(size, element_type)).first;
+    owned_types_.insert(&it->second);
   }
-  CHECK(IsOwnedType(element_type))
-      << "Type is not owned by package: " << *element_type;
-  auto it = array_types_.emplace(key, ArrayType(size, element_type));
-  ArrayType* new_type = &(it.first->second);
-  owned_types_.insert(new_type);
-  return new_type;
+  return &it->second;
 }
 
 TupleType* Package::GetTupleType(absl::Span<Type* const> element_types) {
   TypeVec key(element_types.begin(), element_types.end());
-  if (tuple_types_.find(key) != tuple_types_.end()) {
-    return &tuple_types_.at(key);
+  {
+    absl::ReaderMutexLock lock(&type_mutex_);
+    auto it = tuple_types_.find(key);
+    if (it != tuple_types_.end()) {
+      return &it->second;
+    }
   }
-  for (const Type* element_type : element_types) {
-    CHECK(IsOwnedType(element_type))
-        << "Type is not owned by package: " << *element_type;
+  absl::MutexLock lock(&type_mutex_);
+  auto it = tuple_types_.find(key);
+  if (it == tuple_types_.end()) {
+    for (const Type* element_type : element_types) {
+      CHECK(owned_types_.contains(element_type))
+          << "Type is not owned by package: " << *element_type;
+    }
+    it = tuple_types_.emplace(key, TupleType(element_types)).first;
+    owned_types_.insert(&it->second);
   }
-  auto it = tuple_types_.emplace(key, TupleType(element_types));
-  TupleType* new_type = &(it.first->second);
-  owned_types_.insert(new_type);
-  return new_type;
+  return &it->second;
 }
 
 TokenType* Package::GetTokenType() { return &token_type_; }
@@ -559,17 +656,25 @@ TokenType* Package::GetTokenType() { return &token_type_; }
 FunctionType* Package::GetFunctionType(absl::Span<Type* const> args_types,
                                        Type* return_type) {
   std::string key = FunctionType(args_types, return_type).ToString();
-  if (function_types_.find(key) != function_types_.end()) {
-    return &function_types_.at(key);
+  {
+    absl::ReaderMutexLock lock(&type_mutex_);
+    auto it = function_types_.find(key);
+    if (it != function_types_.end()) {
+      return &it->second;
+    }
   }
-  for (Type* t : args_types) {
-    CHECK(IsOwnedType(t)) << "Parameter type is not owned by package: "
-                          << t->ToString();
+  absl::MutexLock lock(&type_mutex_);
+  auto it = function_types_.find(key);
+  if (it == function_types_.end()) {
+    for (Type* t : args_types) {
+      CHECK(owned_types_.contains(t))
+          << "Parameter type is not owned by package: " << t->ToString();
+    }
+    it = function_types_.emplace(key, FunctionType(args_types, return_type))
+             .first;
+    owned_function_types_.insert(&it->second);
   }
-  auto it = function_types_.emplace(key, FunctionType(args_types, return_type));
-  FunctionType* new_type = &(it.first->second);
-  owned_function_types_.insert(new_type);
-  return new_type;
+  return &it->second;
 }
 
 absl::StatusOr<Type*> Package::GetTypeFromProto(const TypeProto& proto) {
@@ -729,9 +834,15 @@ bool Package::IsDefinitelyEqualTo(const Package* other) const {
   return entry->IsDefinitelyEqualTo(other_entry);
 }
 
-std::string Package::DumpIr() const {
-  std::string out;
-  absl::StrAppend(&out, "package ", name(), "\n\n");
+void Package::DumpIr(std::ostream& os) const {
+  // Emission is delayed by one chunk so the trailing newline of the final
+  // chunk can be dropped before it is written -- package text does not
+  // include a trailing newline.
+  std::string pending = absl::StrCat("package ", name(), "\n\n");
+  auto emit = [&os, &pending](std::string chunk) {
+    os << pending;
+    pending = std::move(chunk);
+  };
 
   if (!fileno_to_filename_.empty()) {
     std::list<xls::Fileno> filenos;
@@ -742,20 +853,20 @@ std::string Package::DumpIr() const {
     // output in sorted order to be deterministic
     for (const auto& fileno : filenos) {
       std::string_view filename = fileno_to_filename_.at(fileno);
-      absl::StrAppend(&out, "file_number ", static_cast<int32_t>(fileno), " ",
-                      "\"", filename, "\"\n");
+      emit(absl::StrCat("file_number ", static_cast<int32_t>(fileno), " ", "\"",
+                        filename, "\"\n"));
     }
-    absl::StrAppend(&out, "\n");
+    emit("\n");
   }
 
   if (!channels().empty()) {
     for (Channel* channel : channels()) {
-      absl::StrAppend(&out, channel->ToString(), "\n");
+      emit(absl::StrCat(channel->ToString(), "\n"));
     }
-    absl::StrAppend(&out, "\n");
+    emit("\n");
   }
   std::optional<FunctionBase*> top = GetTop();
-  auto append_ir_with_attributes = [&top, &out](FunctionBase* fb) {
+  auto emit_ir_with_attributes = [&top, &emit](FunctionBase* fb) {
     std::string_view attribute_prefix;
     std::string_view attribute_suffix;
     std::vector<std::string> attribute_strings = fb->AttributeIrStrings();
@@ -768,27 +879,32 @@ std::string Package::DumpIr() const {
       top_prefix = "top ";
     }
 
-    absl::StrAppend(&out, attribute_prefix,
-                    absl::StrJoin(attribute_strings, ", "), attribute_suffix,
-                    top_prefix, fb->DumpIr(), "\n");
+    emit(absl::StrCat(attribute_prefix, absl::StrJoin(attribute_strings, ", "),
+                      attribute_suffix, top_prefix, fb->DumpIr(), "\n"));
   };
   for (auto& function : functions()) {
-    append_ir_with_attributes(function.get());
+    emit_ir_with_attributes(function.get());
   }
   for (auto& proc : procs()) {
-    append_ir_with_attributes(proc.get());
+    emit_ir_with_attributes(proc.get());
   }
   for (auto& block : blocks()) {
-    append_ir_with_attributes(block.get());
+    emit_ir_with_attributes(block.get());
   }
   // We don't include the trailing newline, drop it here.
-  CHECK_EQ(out.back(), '\n');
-  out.pop_back();
-  return out;
+  CHECK_EQ(pending.back(), '\n');
+  pending.pop_back();
+  os << pending;
+}
+
+std::string Package::DumpIr() const {
+  std::ostringstream out;
+  DumpIr(out);
+  return out.str();
 }
 
 std::ostream& operator<<(std::ostream& os, const Package& package) {
-  os << package.DumpIr();
+  package.DumpIr(os);
   return os;
 }
 
@@ -1039,31 +1155,56 @@ absl::StatusOr<FunctionBase*> FindTop(Package* p,
   return top.value();
 }
 
+TransformMetrics::TransformMetrics(const TransformMetrics& other)
+    : nodes_added(other.nodes_added.load(std::memory_order_relaxed)),
+      nodes_removed(other.nodes_removed.load(std::memory_order_relaxed)),
+      nodes_replaced(other.nodes_replaced.load(std::memory_order_relaxed)),
+      operands_replaced(
+          other.operands_replaced.load(std::memory_order_relaxed)) {}
+
+TransformMetrics& TransformMetrics::operator=(const TransformMetrics& other) {
+  nodes_added.store(other.nodes_added.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+  nodes_removed.store(other.nodes_removed.load(std::memory_order_relaxed),
+                      std::memory_order_relaxed);
+  nodes_replaced.store(other.nodes_replaced.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+  operands_replaced.store(
+      other.operands_replaced.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  return *this;
+}
+
 TransformMetrics TransformMetrics::operator+(
     const TransformMetrics& other) const {
-  return TransformMetrics{
-      .nodes_added = nodes_added + other.nodes_added,
-      .nodes_removed = nodes_removed + other.nodes_removed,
-      .nodes_replaced = nodes_replaced + other.nodes_replaced,
-      .operands_replaced = operands_replaced + other.operands_replaced,
-  };
+  TransformMetrics result(*this);
+  result.nodes_added += other.nodes_added.load(std::memory_order_relaxed);
+  result.nodes_removed += other.nodes_removed.load(std::memory_order_relaxed);
+  result.nodes_replaced += other.nodes_replaced.load(std::memory_order_relaxed);
+  result.operands_replaced +=
+      other.operands_replaced.load(std::memory_order_relaxed);
+  return result;
 }
 
 TransformMetrics TransformMetrics::operator-(
     const TransformMetrics& other) const {
-  return TransformMetrics{
-      .nodes_added = nodes_added - other.nodes_added,
-      .nodes_removed = nodes_removed - other.nodes_removed,
-      .nodes_replaced = nodes_replaced - other.nodes_replaced,
-      .operands_replaced = operands_replaced - other.operands_replaced,
-  };
+  TransformMetrics result(*this);
+  result.nodes_added -= other.nodes_added.load(std::memory_order_relaxed);
+  result.nodes_removed -= other.nodes_removed.load(std::memory_order_relaxed);
+  result.nodes_replaced -= other.nodes_replaced.load(std::memory_order_relaxed);
+  result.operands_replaced -=
+      other.operands_replaced.load(std::memory_order_relaxed);
+  return result;
 }
 
 std::string TransformMetrics::ToString() const {
   return absl::StrFormat(
       "{ nodes added: %d, nodes removed: %d, nodes replaced: %d, operands "
       "replaced: %d }",
-      nodes_added, nodes_removed, nodes_replaced, operands_replaced);
+      nodes_added.load(std::memory_order_relaxed),
+      nodes_removed.load(std::memory_order_relaxed),
+      nodes_replaced.load(std::memory_order_relaxed),
+      operands_replaced.load(std::memory_order_relaxed));
 }
 
 }  // namespace xls
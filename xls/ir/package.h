@@ -15,6 +15,8 @@
 #ifndef XLS_IR_PACKAGE_H_
 #define XLS_IR_PACKAGE_H_
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -24,17 +26,20 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/channel.pb.h"
 #include "xls/ir/channel_ops.h"
 #include "xls/ir/fileno.h"
+#include "xls/ir/node_arena.h"
 #include "xls/ir/source_location.h"
 #include "xls/ir/type.h"
 #include "xls/ir/value.h"
@@ -51,22 +56,29 @@ class SingleValueChannel;
 class StreamingChannel;
 
 // Data structure collecting aggregate transformation metrics for the IR.  These
-// values are zero-ed at construction time and only increment.
+// values are zero-ed at construction time and only increment. The counters are
+// atomic (like Package node-id allocation) because passes may mutate different
+// FunctionBases of the same package concurrently; they are statistics, not
+// synchronization, so all accesses use relaxed ordering.
 struct TransformMetrics {
   // Number of nodes added (number of invocations of
   // FunctionBase::AddNodeInternal).
-  int64_t nodes_added = 0;
+  std::atomic<int64_t> nodes_added = 0;
 
   // Number of nodes removed (number of invocations of
   // FunctionBase::RemoveNode).
-  int64_t nodes_removed = 0;
+  std::atomic<int64_t> nodes_removed = 0;
 
   // Number of nodes replaced (number of calls to Node::ReplaceUsesWith).
-  int64_t nodes_replaced = 0;
+  std::atomic<int64_t> nodes_replaced = 0;
 
   // Number of operands replaced (number of calls to
   // Node::ReplaceOperand[Number]).
-  int64_t operands_replaced = 0;
+  std::atomic<int64_t> operands_replaced = 0;
+
+  TransformMetrics() = default;
+  TransformMetrics(const TransformMetrics& other);
+  TransformMetrics& operator=(const TransformMetrics& other);
 
   TransformMetrics operator+(const TransformMetrics& other) const;
   TransformMetrics operator-(const TransformMetrics& other) const;
@@ -105,13 +117,21 @@ class Package {
 
   // Returns whether the given type is one of the types owned by this package.
   bool IsOwnedType(const Type* type) const {
+    absl::ReaderMutexLock lock(&type_mutex_);
     return owned_types_.find(type) != owned_types_.end();
   }
   bool IsOwnedFunctionType(const FunctionType* function_type) const {
+    absl::ReaderMutexLock lock(&type_mutex_);
     return owned_function_types_.find(function_type) !=
            owned_function_types_.end();
   }
 
+  // Returns the unique owned instance of the requested type, creating it if
+  // necessary. Types are interned: equal types requested from the same
+  // package are pointer-identical, so type equality of types from the same
+  // package may be checked by pointer comparison. These methods are
+  // thread-safe; concurrent lookups of already-interned types take at most a
+  // shared lock (and none at all for small bits types).
   BitsType* GetBitsType(int64_t bit_count);
   ArrayType* GetArrayType(int64_t size, Type* element_type);
   TupleType* GetTupleType(absl::Span<Type* const> element_types);
@@ -131,7 +151,9 @@ class Package {
   Type* GetTypeForValue(const Value& value);
 
   // Add a function, proc, or block to the package. Ownership is transferred to
-  // the package.
+  // the package. These methods are thread-safe so parallel frontends may
+  // register FunctionBases concurrently; iterating over the package's
+  // functions/procs/blocks while another thread is adding is not.
   Function* AddFunction(std::unique_ptr<Function> f);
   Proc* AddProc(std::unique_ptr<Proc> proc);
   Block* AddBlock(std::unique_ptr<Block> block);
@@ -159,6 +181,12 @@ class Package {
   std::optional<Proc*> TryGetProc(std::string_view proc_name) const;
   std::optional<Block*> TryGetBlock(std::string_view block_name) const;
 
+  // Reorders the package's functions, procs and blocks to the given order.
+  // `order` must contain exactly the FunctionBases of the package. Used by
+  // the parallel IR parser to restore textual declaration order after
+  // concurrent parsing completes declarations in nondeterministic order.
+  absl::Status ReorderFunctionBases(absl::Span<FunctionBase* const> order);
+
   // Remove a function, proc, or block. The caller is responsible for ensuring
   // no references to the construct remain (e.g., via invoke operations). The
   // function, proc, or block must not be the top entity of the package. Use the
@@ -195,8 +223,23 @@ class Package {
   std::string SourceLocationToString(const SourceLocation& loc);
 
   // Retrieves the next node ID to assign to a node in the package and
-  // increments the next node counter. For use in node construction.
-  int64_t GetNextNodeId() { return next_node_id_++; }
+  // increments the next node counter. For use in node construction. This
+  // counter is atomic so nodes may be created in different FunctionBases from
+  // multiple threads (e.g., when function-scoped passes are run in parallel).
+  int64_t GetNextNodeId() {
+    return next_node_id_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Reserves `count` consecutive node ids and returns the first. Used by
+  // PackageShard to hand out per-shard id ranges so parallel IR construction
+  // neither contends on nor nondeterministically interleaves the shared
+  // counter.
+  int64_t ReserveNodeIds(int64_t count) {
+    return next_node_id_.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  // Returns the arena from which the nodes of this package are allocated.
+  NodeArena& node_arena() { return node_arena_; }
 
   // Adds a file to the file-number table and returns its corresponding number.
   // If it already exists, returns the existing file-number entry.
@@ -213,6 +256,33 @@ class Package {
     return fileno_to_filename_;
   }
 
+  // Interns `info` package-wide and returns a dense 32-bit handle for it.
+  // Identical location lists share a handle; handle 0 is always the empty
+  // SourceInfo. Nodes store the handle instead of the location vector itself
+  // since after inlining many nodes carry identical location chains.
+  // Thread-safe: nodes may be created concurrently in different
+  // FunctionBases.
+  int32_t InternSourceInfo(const SourceInfo& info);
+
+  // Returns the interned SourceInfo for `handle`. The returned reference is
+  // stable for the lifetime of the package. Thread-safe.
+  const SourceInfo& GetSourceInfo(int32_t handle) const;
+
+  // Sets the explicitly-assigned name of the node with the given id. Only
+  // named nodes have entries in the table; default names are synthesized on
+  // demand from the opcode and id so most nodes carry no string at all.
+  // Thread-safe.
+  void SetNodeName(int64_t node_id, std::string_view name);
+
+  // Returns the assigned name of the node with the given id, which must have
+  // an assigned name. The returned view remains valid until the name is set
+  // again or cleared. Thread-safe.
+  std::string_view GetNodeName(int64_t node_id) const;
+
+  // Removes the assigned-name entry, if any, for the node with the given id.
+  // Thread-safe.
+  void ClearNodeName(int64_t node_id);
+
   // Returns the total number of nodes in the graph. Traverses the functions,
   // procs and blocks and sums the node counts.
   int64_t GetNodeCount() const;
@@ -259,13 +329,24 @@ class Package {
   // Dumps the IR in a parsable text format.
   std::string DumpIr() const;
 
+  // As above, but streams the text to `os` one function/proc/block at a time
+  // rather than materializing the entire package text in memory. Peak memory
+  // use is bounded by the text of the largest function base rather than the
+  // whole package, which matters for very large packages. The emitted bytes
+  // are identical to those returned by `DumpIr()`.
+  void DumpIr(std::ostream& os) const;
+
   std::vector<std::string> GetFunctionNames() const;
 
 
-  int64_t next_node_id() const { return next_node_id_; }
+  int64_t next_node_id() const {
+    return next_node_id_.load(std::memory_order_relaxed);
+  }
 
   // Intended for use by the parser when node ids are suggested by the IR text.
-  void set_next_node_id(int64_t value) { next_node_id_ = value; }
+  void set_next_node_id(int64_t value) {
+    next_node_id_.store(value, std::memory_order_relaxed);
+  }
 
   // Create a channel. Channels are used with send/receive nodes in communicate
   // between procs or between procs and external (to XLS) components. If no
@@ -424,39 +505,93 @@ class Package {
   std::string name_;
 
   // Ordinal to assign to the next node created in this package.
-  int64_t next_node_id_ = 1;
+  std::atomic<int64_t> next_node_id_ = 1;
+
+  // Guards the source-info intern tables below. Interned entries are never
+  // removed and node_hash_map keys are pointer-stable, so references returned
+  // by GetSourceInfo remain valid without holding the lock. Declared before
+  // the node storage below so interned locations outlive the nodes holding
+  // handles to them.
+  mutable absl::Mutex source_info_mutex_;
+
+  // Map from location list to its dense handle, and the reverse lookup table
+  // indexed by handle. Entry 0 is the empty SourceInfo.
+  absl::node_hash_map<SourceInfo, int32_t> source_info_to_handle_
+      ABSL_GUARDED_BY(source_info_mutex_);
+  std::vector<const SourceInfo*> source_info_by_handle_
+      ABSL_GUARDED_BY(source_info_mutex_);
+
+  // Guards the assigned-name table below. node_hash_map values are
+  // pointer-stable, so views returned by GetNodeName remain valid without
+  // holding the lock until the entry itself is modified. Declared before the
+  // node storage below so names outlive the nodes they describe.
+  mutable absl::Mutex node_name_mutex_;
+
+  // Explicitly-assigned node names keyed by node id. Nodes without assigned
+  // names have no entry; their names are generated on demand from the opcode
+  // and id (see Node::GetName).
+  absl::node_hash_map<int64_t, std::string> node_names_
+      ABSL_GUARDED_BY(node_name_mutex_);
+
+  // Slab storage for the nodes of this package. Declared before the
+  // FunctionBases below so it outlives their nodes.
+  NodeArena node_arena_;
+
+  // Guards insertion into the function/proc/block vectors below so
+  // FunctionBases may be added from multiple threads; the name lookup
+  // methods (GetFunction etc.) also take it so they may run concurrently
+  // with additions. Iteration via functions()/procs()/blocks() is
+  // unsynchronized; see AddFunction().
+  mutable absl::Mutex function_bases_mutex_;
 
   std::vector<std::unique_ptr<Function>> functions_;
   std::vector<std::unique_ptr<Proc>> procs_;
   std::vector<std::unique_ptr<Block>> blocks_;
 
+  // Guards the type intern tables below. The interned types themselves are
+  // immutable and pointer-stable, so only table lookups and insertions
+  // synchronize; returned Type pointers may be used without the lock.
+  mutable absl::Mutex type_mutex_;
+
   // Set of owned types in this package.
-  absl::flat_hash_set<const Type*> owned_types_;
+  absl::flat_hash_set<const Type*> owned_types_ ABSL_GUARDED_BY(type_mutex_);
 
   // Set of owned function types in this package.
-  absl::flat_hash_set<const FunctionType*> owned_function_types_;
+  absl::flat_hash_set<const FunctionType*> owned_function_types_
+      ABSL_GUARDED_BY(type_mutex_);
 
   // Mapping from bit count to the owned "bits" type with that many bits. Use
   // node_hash_map for pointer stability.
-  absl::node_hash_map<int64_t, BitsType> bit_count_to_type_;
+  absl::node_hash_map<int64_t, BitsType> bit_count_to_type_
+      ABSL_GUARDED_BY(type_mutex_);
+
+  // Lock-free cache of the interned bits types of small widths, published
+  // after insertion into bit_count_to_type_. GetBitsType is hot and the
+  // overwhelming majority of requests are for small widths.
+  static constexpr int64_t kSmallBitsTypeLimit = 65;
+  mutable std::array<std::atomic<BitsType*>, kSmallBitsTypeLimit>
+      small_bits_types_ = {};
 
   // Mapping from the size and element type of an array type to the owned
   // ArrayType. Use node_hash_map for pointer stability.
   using ArrayKey = std::pair<int64_t, const Type*>;
-  absl::node_hash_map<ArrayKey, ArrayType> array_types_;
+  absl::node_hash_map<ArrayKey, ArrayType> array_types_
+      ABSL_GUARDED_BY(type_mutex_);
 
   // Mapping from elements to the owned tuple type.
   //
   // Uses node_hash_map for pointer stability.
   using TypeVec = absl::InlinedVector<const Type*, 4>;
-  absl::node_hash_map<TypeVec, TupleType> tuple_types_;
+  absl::node_hash_map<TypeVec, TupleType> tuple_types_
+      ABSL_GUARDED_BY(type_mutex_);
 
   // Owned token type.
   TokenType token_type_;
 
   // Mapping from Type:ToString to the owned function type. Use
   // node_hash_map for pointer stability.
-  absl::node_hash_map<std::string, FunctionType> function_types_;
+  absl::node_hash_map<std::string, FunctionType> function_types_
+      ABSL_GUARDED_BY(type_mutex_);
 
   // The largest `Fileno` used in this `Package`.
   std::optional<Fileno> maximum_fileno_;
@@ -479,7 +614,7 @@ class Package {
   int64_t next_channel_id_ = 0;
 
   // Metrics which record the total number of transformations to the package.
-  TransformMetrics transform_metrics_ = {0};
+  TransformMetrics transform_metrics_;
 };
 
 std::ostream& operator<<(std::ostream& os, const Package& package);
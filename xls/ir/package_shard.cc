@@ -0,0 +1,39 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/package_shard.h"
+
+#include <cstdint>
+
+#include "absl/log/check.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+
+PackageShard::PackageShard(Package* package, int64_t id_block_size)
+    : package_(package), id_block_size_(id_block_size) {
+  CHECK_GT(id_block_size, 0);
+  next_id_ = package_->ReserveNodeIds(id_block_size_);
+  block_end_ = next_id_ + id_block_size_;
+}
+
+int64_t PackageShard::GetNextNodeId() {
+  if (next_id_ == block_end_) {
+    next_id_ = package_->ReserveNodeIds(id_block_size_);
+    block_end_ = next_id_ + id_block_size_;
+  }
+  return next_id_++;
+}
+
+}  // namespace xls
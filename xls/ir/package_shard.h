@@ -0,0 +1,81 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_IR_PACKAGE_SHARD_H_
+#define XLS_IR_PACKAGE_SHARD_H_
+
+#include <cstdint>
+
+#include "xls/ir/function_base.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+
+// A per-thread handle for constructing IR in a shared Package concurrently.
+//
+// The Package primitives touched during construction are individually
+// thread-safe: node storage (NodeArena), node id allocation, type interning
+// and FunctionBase registration (AddFunction/AddProc/AddBlock). Multiple
+// threads may therefore build FunctionBases of the same package in parallel
+// as long as each FunctionBase is built by exactly one thread; there is no
+// separate merge step because every shard builds directly into the package.
+//
+// What a bare shared counter cannot provide is id determinism: ids drawn one
+// at a time from the package interleave with the scheduling of the
+// construction threads. A PackageShard instead reserves blocks of ids up
+// front and serves node ids from its private range, so the ids of the IR a
+// thread builds depend only on its shard, not on thread timing, and id
+// allocation does not contend. With a block size large enough for the
+// shard's workload and shards created in a deterministic order, the
+// constructed IR is byte-identical across runs.
+//
+// Typical use, one shard per conversion thread:
+//
+//   PackageShard shard(package);
+//   FunctionBuilder fb(name, package);
+//   shard.CaptureIds(fb.function());
+//   ... add nodes ...
+//   XLS_ASSIGN_OR_RETURN(Function* f, fb.Build());
+//
+// This class is not thread-safe; each shard must be used by one thread at a
+// time.
+class PackageShard : public NodeIdSource {
+ public:
+  // Creates a shard of `package`, reserving an initial block of
+  // `id_block_size` node ids. Further blocks are reserved on demand if the
+  // shard creates more nodes than that. `package` must outlive the shard.
+  explicit PackageShard(Package* package, int64_t id_block_size = 65536);
+
+  Package* package() const { return package_; }
+
+  // Returns the next node id from this shard's reserved ranges.
+  int64_t GetNextNodeId() override;
+
+  // Routes the ids of nodes subsequently created in `fb` through this shard.
+  // Typically called with `builder.function()` immediately after
+  // constructing a FunctionBuilder/ProcBuilder/BlockBuilder. The shard must
+  // outlive node creation in `fb`.
+  void CaptureIds(FunctionBase* fb) { fb->SetNodeIdSource(this); }
+
+ private:
+  Package* package_;
+  int64_t id_block_size_;
+  // Next id to hand out and the first id past the current reserved block.
+  int64_t next_id_;
+  int64_t block_end_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_IR_PACKAGE_SHARD_H_
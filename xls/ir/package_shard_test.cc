@@ -0,0 +1,118 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/package_shard.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/common/thread.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/verifier.h"
+
+namespace xls {
+namespace {
+
+class PackageShardTest : public IrTestBase {};
+
+TEST_F(PackageShardTest, IdsComeFromReservedBlocks) {
+  auto p = CreatePackage();
+  int64_t base = p->next_node_id();
+
+  PackageShard shard_a(p.get(), /*id_block_size=*/16);
+  PackageShard shard_b(p.get(), /*id_block_size=*/16);
+
+  // Each shard serves ids from its own contiguous block regardless of
+  // interleaving.
+  EXPECT_EQ(shard_a.GetNextNodeId(), base);
+  EXPECT_EQ(shard_b.GetNextNodeId(), base + 16);
+  EXPECT_EQ(shard_a.GetNextNodeId(), base + 1);
+  EXPECT_EQ(shard_b.GetNextNodeId(), base + 17);
+
+  // Exhausting a block reserves a fresh one past both existing blocks.
+  for (int64_t i = 0; i < 14; ++i) {
+    shard_a.GetNextNodeId();
+  }
+  EXPECT_EQ(shard_a.GetNextNodeId(), base + 32);
+}
+
+TEST_F(PackageShardTest, CapturedFunctionDrawsShardIds) {
+  auto p = CreatePackage();
+  PackageShard shard(p.get(), /*id_block_size=*/16);
+  int64_t first_id = p->next_node_id();
+
+  FunctionBuilder fb(TestName(), p.get());
+  shard.CaptureIds(fb.function());
+  fb.Add(fb.Param("x", p->GetBitsType(8)), fb.Param("y", p->GetBitsType(8)));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  for (Node* node : f->nodes()) {
+    EXPECT_GE(node->id(), first_id - 16);
+    EXPECT_LT(node->id(), first_id);
+  }
+}
+
+TEST_F(PackageShardTest, ParallelConstruction) {
+  auto p = CreatePackage();
+
+  constexpr int64_t kThreadCount = 8;
+  constexpr int64_t kFunctionsPerThread = 4;
+  std::vector<std::unique_ptr<PackageShard>> shards;
+  for (int64_t i = 0; i < kThreadCount; ++i) {
+    shards.push_back(std::make_unique<PackageShard>(p.get()));
+  }
+  {
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int64_t i = 0; i < kThreadCount; ++i) {
+      threads.push_back(
+          std::make_unique<Thread>([p = p.get(), shard = shards[i].get(), i] {
+            for (int64_t j = 0; j < kFunctionsPerThread; ++j) {
+              FunctionBuilder fb(absl::StrCat("f_", i, "_", j), p);
+              shard->CaptureIds(fb.function());
+              BValue x = fb.Param("x", p->GetBitsType(32));
+              fb.Add(fb.Not(x), fb.Literal(UBits(j, 32)));
+              CHECK_OK(fb.Build().status());
+            }
+          }));
+    }
+    for (auto& thread : threads) {
+      thread->Join();
+    }
+  }
+
+  EXPECT_EQ(p->functions().size(), kThreadCount * kFunctionsPerThread);
+  XLS_EXPECT_OK(VerifyPackage(p.get()));
+
+  // Node ids are unique across all concurrently built functions.
+  absl::flat_hash_set<int64_t> ids;
+  for (FunctionBase* fb : p->GetFunctionBases()) {
+    for (Node* node : fb->nodes()) {
+      EXPECT_TRUE(ids.insert(node->id()).second)
+          << "Duplicate node id " << node->id();
+    }
+  }
+}
+
+}  // namespace
+}  // namespace xls
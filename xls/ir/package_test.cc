@@ -15,7 +15,9 @@
 #include "xls/ir/package.h"
 
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <sstream>
 #include <string_view>
 #include <vector>
 
@@ -25,14 +27,17 @@
 #include "absl/strings/str_cat.h"
 #include "xls/common/casts.h"
 #include "xls/common/status/matchers.h"
+#include "xls/common/thread.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/channel.pb.h"
 #include "xls/ir/channel_ops.h"
+#include "xls/ir/fileno.h"
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_matcher.h"
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/nodes.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/type.h"
 #include "xls/ir/value.h"
 #include "xls/ir/xls_type.pb.h"
@@ -134,6 +139,37 @@ TEST_F(PackageTest, GetTokenType) {
   EXPECT_EQ("token", my_token_type->ToString());
 }
 
+TEST_F(PackageTest, ConcurrentTypeInterning) {
+  Package p(TestName());
+
+  // Interning the same types from many threads must hand every thread the
+  // same pointers.
+  constexpr int64_t kThreadCount = 8;
+  std::vector<std::vector<Type*>> results(kThreadCount);
+  {
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int64_t i = 0; i < kThreadCount; ++i) {
+      threads.push_back(std::make_unique<Thread>([&p, &result = results[i]] {
+        for (int64_t bit_count : {1, 8, 8, 32, 1000}) {
+          result.push_back(p.GetBitsType(bit_count));
+        }
+        Type* u8 = p.GetBitsType(8);
+        result.push_back(p.GetArrayType(4, u8));
+        result.push_back(p.GetTupleType({u8, p.GetBitsType(32)}));
+        result.push_back(p.GetTokenType());
+      }));
+    }
+    for (auto& thread : threads) {
+      thread->Join();
+    }
+  }
+  for (int64_t i = 1; i < kThreadCount; ++i) {
+    EXPECT_EQ(results[i], results[0]);
+  }
+  EXPECT_EQ(results[0][1], results[0][2]);
+  EXPECT_TRUE(p.IsOwnedType(results[0].back()));
+}
+
 TEST_F(PackageTest, MapTypeFromOtherPackageBitsTypes) {
   Package p(TestName());
   Package other_package("other_package");
@@ -300,6 +336,25 @@ top fn main(a: bits[32]) -> bits[32] {
   EXPECT_FALSE(p1->IsDefinitelyEqualTo(p2.get()));
 }
 
+TEST_F(PackageTest, StreamingDumpIrMatchesStringDumpIr) {
+  const char text[] = R"(
+package my_package
+
+fn f(x: bits[32], y: bits[32]) -> bits[32] {
+  ret add.1: bits[32] = add(x, y)
+}
+
+top fn main(a: bits[32]) -> bits[32] {
+  ret invoke.5: bits[32] = invoke(a, a, to_apply=f)
+}
+)";
+
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(text));
+  std::ostringstream streamed;
+  p->DumpIr(streamed);
+  EXPECT_EQ(streamed.str(), p->DumpIr());
+}
+
 TEST_F(PackageTest, CreateStreamingChannel) {
   Package p(TestName());
 
@@ -1195,5 +1250,40 @@ TEST_F(PackageTest, TransformMetrics) {
   EXPECT_EQ(p->transform_metrics().operands_replaced, 2);
 }
 
+TEST_F(PackageTest, SourceInfoInterning) {
+  Package p(TestName());
+  // Handle 0 is reserved for the empty SourceInfo.
+  EXPECT_EQ(p.InternSourceInfo(SourceInfo()), 0);
+  EXPECT_TRUE(p.GetSourceInfo(0).Empty());
+
+  SourceInfo info(SourceLocation(Fileno(1), Lineno(2), Colno(3)));
+  int32_t handle = p.InternSourceInfo(info);
+  EXPECT_NE(handle, 0);
+  // Identical location lists share a handle; distinct lists do not.
+  EXPECT_EQ(p.InternSourceInfo(info), handle);
+  EXPECT_EQ(p.GetSourceInfo(handle), info);
+  EXPECT_NE(p.InternSourceInfo(
+                SourceInfo(SourceLocation(Fileno(4), Lineno(5), Colno(6)))),
+            handle);
+}
+
+TEST_F(PackageTest, NodeSourceInfoIsInterned) {
+  Package p(TestName());
+  FunctionBuilder fb("f", &p);
+  SourceInfo loc(SourceLocation(Fileno(1), Lineno(2), Colno(3)));
+  BValue x = fb.Param("x", p.GetBitsType(8), loc);
+  BValue y = fb.Not(x, loc);
+  XLS_ASSERT_OK(fb.Build().status());
+
+  // Nodes with identical location lists reference the same interned entry.
+  EXPECT_EQ(&x.node()->loc(), &y.node()->loc());
+  EXPECT_EQ(y.node()->loc(), loc);
+
+  SourceInfo other_loc(SourceLocation(Fileno(4), Lineno(5), Colno(6)));
+  y.node()->SetLoc(other_loc);
+  EXPECT_NE(&x.node()->loc(), &y.node()->loc());
+  EXPECT_EQ(y.node()->loc(), other_loc);
+}
+
 }  // namespace
 }  // namespace xls
@@ -597,6 +597,7 @@ absl::StatusOr<ChannelReferences> Proc::AddChannel(
                                  .receive_ref = receive_channel_ref.get()};
   channel_references_.push_back(std::move(send_channel_ref));
   channel_references_.push_back(std::move(receive_channel_ref));
+  BumpInstantiationVersion();
   return channel_refs;
 }
 
@@ -636,6 +637,7 @@ absl::StatusOr<ChannelReference*> Proc::AddInterfaceChannelReference(
   }
   channel_references_.push_back(std::move(channel_ref));
   interface_.push_back(channel_references_.back().get());
+  BumpInstantiationVersion();
   return interface_.back();
 }
 
@@ -645,6 +647,7 @@ absl::StatusOr<ProcInstantiation*> Proc::AddProcInstantiation(
   XLS_RET_CHECK(is_new_style_proc());
   proc_instantiations_.push_back(
       std::make_unique<ProcInstantiation>(name, channel_args, proc));
+  BumpInstantiationVersion();
   return proc_instantiations_.back().get();
 }
 
@@ -16,6 +16,7 @@
 #define XLS_IR_SOURCE_LOCATION_H_
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -49,6 +50,19 @@ class SourceLocation {
            colno_ < other.colno_;
   }
 
+  bool operator==(const SourceLocation& other) const {
+    return fileno_ == other.fileno_ && lineno_ == other.lineno_ &&
+           colno_ == other.colno_;
+  }
+  bool operator!=(const SourceLocation& other) const {
+    return !(*this == other);
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const SourceLocation& loc) {
+    return H::combine(std::move(h), loc.fileno_, loc.lineno_, loc.colno_);
+  }
+
  private:
   Fileno fileno_;
   Lineno lineno_;
@@ -65,6 +79,18 @@ struct SourceInfo {
 
   bool Empty() const { return locations.empty(); }
 
+  friend bool operator==(const SourceInfo& a, const SourceInfo& b) {
+    return a.locations == b.locations;
+  }
+  friend bool operator!=(const SourceInfo& a, const SourceInfo& b) {
+    return !(a == b);
+  }
+
+  template <typename H>
+  friend H AbslHashValue(H h, const SourceInfo& info) {
+    return H::combine(std::move(h), info.locations);
+  }
+
   std::string ToString() const {
     std::vector<std::string> strings;
     strings.reserve(locations.size());
@@ -33,6 +33,7 @@
 #include "absl/types/span.h"
 #include "xls/data_structures/inline_bitmap.h"
 #include "xls/ir/bits.h"
+#include "xls/ir/bits_ops.h"
 
 namespace xls {
 
@@ -138,6 +139,53 @@ Bits ToKnownBitsValues(TernarySpan ternary_vector) {
   return Bits(bits);
 }
 
+PackedTernary Pack(TernarySpan ternary) {
+  return PackedTernary{.known = ToKnownBits(ternary),
+                       .value = ToKnownBitsValues(ternary)};
+}
+
+TernaryVector Unpack(const PackedTernary& packed) {
+  return FromKnownBits(packed.known, packed.value);
+}
+
+PackedTernary PackedNot(const PackedTernary& a) {
+  // Knownness is preserved; complement the value under the known mask to keep
+  // unknown positions at zero.
+  return PackedTernary{
+      .known = a.known,
+      .value = bits_ops::And(bits_ops::Not(a.value), a.known)};
+}
+
+PackedTernary PackedAnd(const PackedTernary& a, const PackedTernary& b) {
+  // A result bit is known if both inputs are known or either input is a known
+  // zero (which forces the result to zero regardless of the other input).
+  Bits a_zero = bits_ops::And(a.known, bits_ops::Not(a.value));
+  Bits b_zero = bits_ops::And(b.known, bits_ops::Not(b.value));
+  return PackedTernary{
+      .known = bits_ops::Or(bits_ops::And(a.known, b.known),
+                            bits_ops::Or(a_zero, b_zero)),
+      .value = bits_ops::And(a.value, b.value)};
+}
+
+PackedTernary PackedOr(const PackedTernary& a, const PackedTernary& b) {
+  // A result bit is known if both inputs are known or either input is a known
+  // one (which forces the result to one regardless of the other input). A set
+  // value bit implies a known bit, so the value masks can be used directly as
+  // the known-one masks.
+  return PackedTernary{
+      .known = bits_ops::Or(bits_ops::And(a.known, b.known),
+                            bits_ops::Or(a.value, b.value)),
+      .value = bits_ops::Or(a.value, b.value)};
+}
+
+PackedTernary PackedXor(const PackedTernary& a, const PackedTernary& b) {
+  // Xor yields no information unless both inputs are known.
+  Bits known = bits_ops::And(a.known, b.known);
+  return PackedTernary{
+      .known = known,
+      .value = bits_ops::And(bits_ops::Xor(a.value, b.value), known)};
+}
+
 std::optional<TernaryVector> Difference(TernarySpan lhs, TernarySpan rhs) {
   CHECK_EQ(lhs.size(), rhs.size());
   const int64_t size = lhs.size();
@@ -83,6 +83,31 @@ Bits ToKnownBits(TernarySpan ternary_vector);
 // vector that is `kKnownOne`, and a 0 otherwise.
 Bits ToKnownBitsValues(TernarySpan ternary_vector);
 
+// A packed two-bitmask representation of a TernaryVector: bit i of `known` is
+// set iff element i is kKnownZero or kKnownOne, and bit i of `value` holds the
+// known value (zero where unknown). Transfer functions on this form operate a
+// machine word at a time rather than one enum element at a time, which makes
+// them roughly 64x faster than the generic AbstractEvaluator path for wide
+// values.
+struct PackedTernary {
+  Bits known;
+  Bits value;
+
+  int64_t bit_count() const { return known.bit_count(); }
+};
+
+// Conversions between the packed and vector forms.
+PackedTernary Pack(TernarySpan ternary);
+TernaryVector Unpack(const PackedTernary& packed);
+
+// Word-parallel transfer functions for the common bitwise operations. Each
+// produces exactly the same result as evaluating the operation element-wise
+// with And()/Or()/etc. below.
+PackedTernary PackedNot(const PackedTernary& a);
+PackedTernary PackedAnd(const PackedTernary& a, const PackedTernary& b);
+PackedTernary PackedOr(const PackedTernary& a, const PackedTernary& b);
+PackedTernary PackedXor(const PackedTernary& a, const PackedTernary& b);
+
 // Returns a vector with known positions for each bit known in `lhs` that isn't
 // known in `rhs`. If `lhs` and `rhs` conflict, returns `std::nullopt`.
 // CHECK fails if `lhs` and `rhs` have different lengths.
@@ -38,6 +38,38 @@ TEST(Ternary, FromKnownBits) {
   EXPECT_EQ(TernaryVector(), ternary_ops::FromKnownBits(Bits(), Bits()));
 }
 
+TEST(Ternary, PackedRoundTrip) {
+  TernaryVector vec = *StringToTernaryVector("0b1101X1X001");
+  ternary_ops::PackedTernary packed = ternary_ops::Pack(vec);
+  EXPECT_EQ(packed.known, UBits(0b1111010111, 10));
+  EXPECT_EQ(packed.value, UBits(0b1101010001, 10));
+  EXPECT_EQ(ternary_ops::Unpack(packed), vec);
+  // Empty vectors should be handled correctly.
+  EXPECT_EQ(ternary_ops::Unpack(ternary_ops::Pack(TernaryVector())),
+            TernaryVector());
+}
+
+TEST(Ternary, PackedTransferFunctionsMatchElementwise) {
+  // The two operands together enumerate all nine ternary input combinations.
+  TernaryVector a = *StringToTernaryVector("0b000111XXX");
+  TernaryVector b = *StringToTernaryVector("0b01X01X01X");
+  ternary_ops::PackedTernary pa = ternary_ops::Pack(a);
+  ternary_ops::PackedTernary pb = ternary_ops::Pack(b);
+
+  TernaryVector expected_and(a.size());
+  TernaryVector expected_or(a.size());
+  for (int64_t i = 0; i < a.size(); ++i) {
+    expected_and[i] = ternary_ops::And(a[i], b[i]);
+    expected_or[i] = ternary_ops::Or(a[i], b[i]);
+  }
+  EXPECT_EQ(ternary_ops::Unpack(ternary_ops::PackedAnd(pa, pb)), expected_and);
+  EXPECT_EQ(ternary_ops::Unpack(ternary_ops::PackedOr(pa, pb)), expected_or);
+  EXPECT_EQ(ternary_ops::Unpack(ternary_ops::PackedXor(pa, pb)),
+            *StringToTernaryVector("0b01X10XXXX"));
+  EXPECT_EQ(ternary_ops::Unpack(ternary_ops::PackedNot(pb)),
+            *StringToTernaryVector("0b10X10X10X"));
+}
+
 TEST(Ternary, Difference) {
   // Basic test of functionality.
   EXPECT_EQ(*StringToTernaryVector("0b11XXXXXXX1"),
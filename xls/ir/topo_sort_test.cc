@@ -22,6 +22,7 @@
 
 #include "benchmark/benchmark.h"
 #include "gtest/gtest.h"
+#include "absl/types/span.h"
 #include "xls/common/status/matchers.h"
 #include "xls/ir/benchmark_support.h"
 #include "xls/ir/bits.h"
@@ -288,6 +289,31 @@ TEST(NodeIteratorTest, RpoVsTopo) {
 
 // LINT.ThenChange(//xls/ir/block_elaboration_test.cc)
 
+TEST(NodeIteratorTest, CachedTopoSort) {
+  Package p("p");
+  Function f("f", &p);
+  SourceInfo loc;
+  XLS_ASSERT_OK_AND_ASSIGN(Node * literal,
+                           f.MakeNode<Literal>(loc, Value(UBits(3, 2))));
+  XLS_ASSERT_OK_AND_ASSIGN(Node * neg,
+                           f.MakeNode<UnOp>(loc, literal, Op::kNeg));
+  XLS_ASSERT_OK(f.set_return_value(neg));
+
+  absl::Span<Node* const> cached = f.GetCachedTopoSort();
+  EXPECT_EQ(std::vector<Node*>(cached.begin(), cached.end()), TopoSort(&f));
+  // Without intervening mutation the cached order is not recomputed.
+  EXPECT_EQ(cached.data(), f.GetCachedTopoSort().data());
+
+  // Mutating the function invalidates the cache.
+  XLS_ASSERT_OK_AND_ASSIGN(Node * neg2,
+                           f.MakeNode<UnOp>(loc, neg, Op::kNeg));
+  XLS_ASSERT_OK(f.set_return_value(neg2));
+  absl::Span<Node* const> recomputed = f.GetCachedTopoSort();
+  EXPECT_EQ(std::vector<Node*>(recomputed.begin(), recomputed.end()),
+            TopoSort(&f));
+  EXPECT_EQ(recomputed.size(), 3);
+}
+
 void BM_TopoSortBinaryTree(benchmark::State& state) {
   std::unique_ptr<VerifiedPackage> p =
       std::make_unique<VerifiedPackage>("balanced_tree_pkg");
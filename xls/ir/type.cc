@@ -19,8 +19,10 @@
 #include <string>
 #include <vector>
 
+#include "absl/base/call_once.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -28,6 +30,35 @@
 #include "xls/ir/xls_type.pb.h"
 
 namespace xls {
+namespace {
+
+// Appends the leaf (bits/token) types of `t` to `leaf_types` in DFS order.
+void GatherLeafTypes(Type* t, std::vector<Type*>* leaf_types) {
+  if (t->IsBits() || t->IsToken()) {
+    leaf_types->push_back(t);
+    return;
+  }
+  if (t->IsArray()) {
+    for (int64_t i = 0; i < t->AsArrayOrDie()->size(); ++i) {
+      GatherLeafTypes(t->AsArrayOrDie()->element_type(), leaf_types);
+    }
+    return;
+  }
+  CHECK(t->IsTuple());
+  for (int64_t i = 0; i < t->AsTupleOrDie()->size(); ++i) {
+    GatherLeafTypes(t->AsTupleOrDie()->element_type(i), leaf_types);
+  }
+}
+
+}  // namespace
+
+absl::Span<Type* const> Type::leaf_types() const {
+  absl::call_once(leaf_types_once_, [this] {
+    leaf_types_.reserve(leaf_count());
+    GatherLeafTypes(const_cast<Type*>(this), &leaf_types_);
+  });
+  return leaf_types_;
+}
 
 std::string TypeKindToString(TypeKind type_kind) {
   switch (type_kind) {
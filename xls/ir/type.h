@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/base/call_once.h"
 #include "absl/log/check.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
@@ -84,6 +85,13 @@ class Type {
   // Returns the number of leaf Bits types in this object.
   virtual int64_t leaf_count() const = 0;
 
+  // Returns the leaf (bits or token) types of this type in DFS order -- the
+  // flattening order used by LeafTypeTree. Lazily computed on first call and
+  // cached on the type (types are interned per package, so the cache is
+  // shared by every user of the type); thread-safe. The returned span lives
+  // as long as this type.
+  absl::Span<Type* const> leaf_types() const;
+
   virtual std::string ToString() const = 0;
 
   template <typename Sink>
@@ -96,6 +104,10 @@ class Type {
 
  private:
   TypeKind kind_;
+
+  // Lazily computed cache for leaf_types().
+  mutable absl::once_flag leaf_types_once_;
+  mutable std::vector<Type*> leaf_types_;
 };
 
 std::ostream& operator<<(std::ostream& os, const Type& type);
@@ -130,8 +142,10 @@ class TupleType : public Type {
   explicit TupleType(absl::Span<Type* const> members)
       : Type(TypeKind::kTuple), members_(members.begin(), members.end()) {
     leaf_count_ = 0;
+    flat_bit_count_ = 0;
     for (Type* t : members) {
       leaf_count_ += t->leaf_count();
+      flat_bit_count_ += t->GetFlatBitCount();
     }
   }
   ~TupleType() override = default;
@@ -151,16 +165,13 @@ class TupleType : public Type {
 
   int64_t leaf_count() const override { return leaf_count_; }
 
-  int64_t GetFlatBitCount() const override {
-    int64_t total = 0;
-    for (const Type* type : members_) {
-      total += type->GetFlatBitCount();
-    }
-    return total;
-  }
+  // Precomputed at construction; member types are immutable so the value
+  // never changes.
+  int64_t GetFlatBitCount() const override { return flat_bit_count_; }
 
  private:
   int64_t leaf_count_;
+  int64_t flat_bit_count_;
   std::vector<Type*> members_;
 };
 
@@ -170,7 +181,11 @@ class TupleType : public Type {
 class ArrayType : public Type {
  public:
   explicit ArrayType(int64_t size, Type* element_type)
-      : Type(TypeKind::kArray), size_(size), element_type_(element_type) {}
+      : Type(TypeKind::kArray),
+        size_(size),
+        element_type_(element_type),
+        flat_bit_count_(element_type->GetFlatBitCount() * size),
+        leaf_count_(element_type->leaf_count() * size) {}
   ~ArrayType() override = default;
   std::string ToString() const override;
 
@@ -180,17 +195,17 @@ class ArrayType : public Type {
   Type* element_type() const { return element_type_; }
   int64_t size() const { return size_; }
 
-  int64_t GetFlatBitCount() const override {
-    return element_type_->GetFlatBitCount() * size_;
-  }
+  // Precomputed at construction; the element type is immutable so the values
+  // never change.
+  int64_t GetFlatBitCount() const override { return flat_bit_count_; }
 
-  int64_t leaf_count() const override {
-    return size_ * element_type()->leaf_count();
-  }
+  int64_t leaf_count() const override { return leaf_count_; }
 
  private:
   int64_t size_;
   Type* element_type_;
+  int64_t flat_bit_count_;
+  int64_t leaf_count_;
 };
 
 // Represents a token type used for ordering channel accesses.
@@ -252,13 +252,25 @@ void Value::FlattenTo(BitPushBuffer* buffer) const {
   LOG(FATAL) << "Invalid value kind: " << ValueKindToString(kind_);
 }
 
-absl::StatusOr<std::vector<Value>> Value::GetElements() const {
-  if (!std::holds_alternative<std::vector<Value>>(payload_)) {
+absl::StatusOr<std::vector<Value>> Value::GetElements() const& {
+  if (!std::holds_alternative<SharedElements>(payload_)) {
     return absl::InvalidArgumentError("Value does not hold elements.");
   }
   return std::vector<Value>(elements().begin(), elements().end());
 }
 
+absl::StatusOr<std::vector<Value>> Value::GetElements() && {
+  if (!std::holds_alternative<SharedElements>(payload_)) {
+    return absl::InvalidArgumentError("Value does not hold elements.");
+  }
+  SharedElements& shared = std::get<SharedElements>(payload_);
+  if (shared.use_count() == 1) {
+    // Unique owner: move the element vector out without copying.
+    return std::move(*shared);
+  }
+  return std::vector<Value>(shared->begin(), shared->end());
+}
+
 absl::StatusOr<Bits> Value::GetBitsWithStatus() const {
   if (!IsBits()) {
     return absl::InvalidArgumentError(
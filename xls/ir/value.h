@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -68,7 +69,7 @@ class Value {
     return Value(ValueKind::kTuple, elements);
   }
   static Value TupleOwned(std::vector<Value>&& elements) {
-    return Value(ValueKind::kTuple, elements);
+    return Value(ValueKind::kTuple, std::move(elements));
   }
 
   // All members of "elements" must be of the same type, or an error status will
@@ -107,7 +108,10 @@ class Value {
   }
 
   static Value Token() {
-    return Value(ValueKind::kToken, std::vector<Value>({}));
+    // All tokens share a single (empty) element vector.
+    static const SharedElements* empty =
+        new SharedElements(std::make_shared<std::vector<Value>>());
+    return Value(ValueKind::kToken, *empty);
   }
   static Value Bool(bool enabled) {
     return Value(UBits(/*value=*/enabled, /*bit_count=*/1));
@@ -141,10 +145,15 @@ class Value {
   const Bits& bits() const { return std::get<Bits>(payload_); }
   absl::StatusOr<Bits> GetBitsWithStatus() const;
 
-  absl::StatusOr<std::vector<Value>> GetElements() const;
+  // Returns an owned vector of this value's elements. Element copies are O(1)
+  // (the element storage of aggregates is shared), so this is cheap even for
+  // large aggregates. The rvalue overload additionally moves the vector out
+  // without any copy when this value is the unique owner of its elements.
+  absl::StatusOr<std::vector<Value>> GetElements() const&;
+  absl::StatusOr<std::vector<Value>> GetElements() &&;
 
   absl::Span<const Value> elements() const {
-    return std::get<std::vector<Value>>(payload_);
+    return *std::get<SharedElements>(payload_);
   }
   const Value& element(int64_t i) const { return elements().at(i); }
   int64_t size() const { return elements().size(); }
@@ -190,15 +199,27 @@ class Value {
   }
 
  private:
+  // Aggregate elements are held behind a shared_ptr so that copying an
+  // aggregate Value is O(1) and shares the leaf storage with the original.
+  // The pointed-to vector is logically immutable: it is never modified after
+  // construction while shared (the only mutation is moving it out of a
+  // uniquely-owned rvalue in GetElements() &&).
+  using SharedElements = std::shared_ptr<std::vector<Value>>;
+
   Value(ValueKind kind, absl::Span<const Value> elements)
       : kind_(kind),
-        payload_(std::vector<Value>(elements.begin(), elements.end())) {}
+        payload_(std::make_shared<std::vector<Value>>(elements.begin(),
+                                                      elements.end())) {}
 
   Value(ValueKind kind, std::vector<Value>&& elements)
+      : kind_(kind),
+        payload_(std::make_shared<std::vector<Value>>(std::move(elements))) {}
+
+  Value(ValueKind kind, SharedElements elements)
       : kind_(kind), payload_(std::move(elements)) {}
 
   ValueKind kind_;
-  std::variant<std::nullptr_t, std::vector<Value>, Bits> payload_;
+  std::variant<std::nullptr_t, SharedElements, Bits> payload_;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Value& value) {
@@ -16,6 +16,8 @@
 
 #include <cstdint>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -658,6 +660,34 @@ void ProtoValueRoundTripWorks(const ValueProto& v) {
 
 FUZZ_TEST(ValueProto, ProtoValueRoundTripWorks)
     .WithDomains(fuzztest::Arbitrary<ValueProto>());
+
+TEST(ValueTest, CopySharesElementStorage) {
+  Value tuple = Value::Tuple({Value(UBits(1, 64)), Value(UBits(2, 64))});
+  Value copy = tuple;
+  // Copies of aggregates share the same (immutable) element storage.
+  EXPECT_EQ(tuple.elements().data(), copy.elements().data());
+  EXPECT_EQ(tuple, copy);
+}
+
+TEST(ValueTest, MoveAwareGetElements) {
+  Value tuple = Value::Tuple({Value(UBits(1, 64)), Value(UBits(2, 64))});
+  const Value* first_element_before = tuple.elements().data();
+
+  // The value uniquely owns its elements, so they are moved out rather than
+  // copied.
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Value> elements,
+                           std::move(tuple).GetElements());
+  EXPECT_EQ(elements.data(), first_element_before);
+
+  // When the element storage is shared, extraction copies instead.
+  Value original = Value::TupleOwned(std::move(elements));
+  Value copy = original;
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Value> copied_elements,
+                           std::move(copy).GetElements());
+  EXPECT_NE(copied_elements.data(), original.elements().data());
+  EXPECT_EQ(Value::TupleOwned(std::move(copied_elements)), original);
+}
+
 }  // namespace
 
 }  // namespace xls
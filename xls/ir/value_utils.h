@@ -17,6 +17,8 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
@@ -54,6 +56,14 @@ inline void ValueFormatterHex(std::string* out, const Value& value) {
   absl::StrAppend(out, value.ToString(FormatPreference::kHex));
 }
 
+// Returns the elements of the given tuple/array value as an owned vector,
+// consuming the value. When `value` uniquely owns its element storage the
+// elements are moved out without copying; otherwise element copies are O(1)
+// because aggregate element storage is shared.
+inline absl::StatusOr<std::vector<Value>> ExtractValueElements(Value&& value) {
+  return std::move(value).GetElements();
+}
+
 // Returns whether "value" conforms to type "type" -- this lets us avoid
 // constructing a Type and doing an equivalence check on hot paths.
 inline bool ValueConformsToType(const Value& value, Type* type) {
@@ -15,6 +15,8 @@
 #include "xls/ir/verifier.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <memory>
@@ -37,6 +39,7 @@
 #include "absl/types/span.h"
 #include "xls/common/casts.h"
 #include "xls/common/logging/log_lines.h"
+#include "xls/common/thread.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/ir/block.h"
@@ -372,22 +375,93 @@ absl::Status VerifyChannels(Package* package, bool codegen) {
   return absl::OkStatus();
 }
 
+// Dispatches to the verifier for the concrete type of 'function_base'.
+absl::Status VerifyAnyFunctionBase(FunctionBase* function_base, bool codegen) {
+  if (function_base->IsFunction()) {
+    return VerifyFunction(down_cast<Function*>(function_base), codegen);
+  }
+  if (function_base->IsProc()) {
+    return VerifyProc(down_cast<Proc*>(function_base), codegen);
+  }
+  return VerifyBlock(down_cast<Block*>(function_base), codegen);
+}
+
+// Minimum total node count for which per-FunctionBase verification is
+// distributed across worker threads. Below this the thread spawn/join
+// overhead outweighs the verification work itself.
+constexpr int64_t kMinNodesForParallelVerification = 4096;
+
+// Verifies each of the given FunctionBases, across worker threads if the
+// aggregate node count is large enough to amortize the thread overhead.
+// Returns the error of the earliest (in 'function_bases' order) failing
+// FunctionBase so error reporting is deterministic.
+absl::Status VerifyFunctionBases(
+    absl::Span<FunctionBase* const> function_bases, bool codegen) {
+  int64_t total_nodes = 0;
+  for (FunctionBase* function_base : function_bases) {
+    total_nodes += function_base->node_count();
+  }
+  size_t worker_count =
+      std::min(function_bases.size(), static_cast<size_t>(AvailableCPUs()));
+  if (worker_count <= 1 || total_nodes < kMinNodesForParallelVerification) {
+    for (FunctionBase* function_base : function_bases) {
+      XLS_RETURN_IF_ERROR(VerifyAnyFunctionBase(function_base, codegen));
+    }
+    return absl::OkStatus();
+  }
+
+  // Each worker claims the next unverified FunctionBase and writes only its
+  // own result slot. Verification does not mutate the IR so the package is
+  // safe to share across the workers.
+  std::vector<absl::Status> statuses(function_bases.size());
+  std::atomic<size_t> next_index = 0;
+  std::vector<std::unique_ptr<Thread>> workers;
+  workers.reserve(worker_count);
+  for (size_t w = 0; w < worker_count; ++w) {
+    workers.push_back(std::make_unique<Thread>([&] {
+      for (size_t i = next_index.fetch_add(1); i < function_bases.size();
+           i = next_index.fetch_add(1)) {
+        statuses[i] = VerifyAnyFunctionBase(function_bases[i], codegen);
+      }
+    }));
+  }
+  for (std::unique_ptr<Thread>& worker : workers) {
+    worker->Join();
+  }
+  for (const absl::Status& status : statuses) {
+    XLS_RETURN_IF_ERROR(status);
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace
 
-absl::Status VerifyPackage(Package* package, bool codegen) {
+bool VerificationCache::IsClean(FunctionBase* function_base) const {
+  auto it = verified_versions_.find(function_base);
+  return it != verified_versions_.end() &&
+         it->second == function_base->transform_version();
+}
+
+void VerificationCache::MarkClean(FunctionBase* function_base) {
+  verified_versions_[function_base] = function_base->transform_version();
+}
+
+absl::Status VerifyPackage(Package* package, bool codegen,
+                           VerificationCache* cache) {
   VLOG(4) << absl::StreamFormat("Verifying package %s:\n", package->name());
   XLS_VLOG_LINES(4, package->DumpIr());
 
-  for (auto& function : package->functions()) {
-    XLS_RETURN_IF_ERROR(VerifyFunction(function.get(), codegen));
-  }
-
-  for (auto& proc : package->procs()) {
-    XLS_RETURN_IF_ERROR(VerifyProc(proc.get(), codegen));
+  std::vector<FunctionBase*> to_verify;
+  for (FunctionBase* function_base : package->GetFunctionBases()) {
+    if (cache == nullptr || !cache->IsClean(function_base)) {
+      to_verify.push_back(function_base);
+    }
   }
-
-  for (auto& block : package->blocks()) {
-    XLS_RETURN_IF_ERROR(VerifyBlock(block.get(), codegen));
+  XLS_RETURN_IF_ERROR(VerifyFunctionBases(to_verify, codegen));
+  if (cache != nullptr) {
+    for (FunctionBase* function_base : to_verify) {
+      cache->MarkClean(function_base);
+    }
   }
 
   // Verify node IDs are unique within the package and uplinks point to this
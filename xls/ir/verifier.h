@@ -15,19 +15,51 @@
 #ifndef XLS_IR_VERIFIER_H_
 #define XLS_IR_VERIFIER_H_
 
+#include <cstdint>
+
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 
 namespace xls {
 
 class Node;
 class Function;
+class FunctionBase;
 class Proc;
 class Block;
 class Package;
 
+// Records the transform version (FunctionBase::transform_version()) at which
+// each FunctionBase last verified cleanly. When passed to VerifyPackage,
+// FunctionBases which are unchanged since their last clean verification are
+// skipped; package-wide invariants (id uniqueness, name uniqueness, channels)
+// are always re-checked. A cache instance must only be used with a single
+// package and assumes FunctionBases are not deleted and re-created between
+// verifications. Note that invariants which reach across FunctionBases (e.g.,
+// an invoke's agreement with its callee's signature) are only re-checked when
+// the referring FunctionBase itself changes.
+class VerificationCache {
+ public:
+  // Returns true if `function_base` is unchanged since it last verified
+  // cleanly.
+  bool IsClean(FunctionBase* function_base) const;
+
+  // Records that `function_base` verified cleanly at its current transform
+  // version.
+  void MarkClean(FunctionBase* function_base);
+
+ private:
+  absl::flat_hash_map<FunctionBase*, int64_t> verified_versions_;
+};
+
 // Verifies numerous invariants of the IR for the given IR construct. Returns a
 // error status if a violation is found.
-absl::Status VerifyPackage(Package* package, bool codegen = false);
+//
+// Per-FunctionBase verification is distributed across worker threads when the
+// package is large enough for the thread overhead to pay off. If `cache` is
+// non-null, verification is additionally incremental (see VerificationCache).
+absl::Status VerifyPackage(Package* package, bool codegen = false,
+                           VerificationCache* cache = nullptr);
 absl::Status VerifyFunction(Function* function, bool codegen = false);
 absl::Status VerifyProc(Proc* Proc, bool codegen = false);
 absl::Status VerifyBlock(Block* Block, bool codegen = false);
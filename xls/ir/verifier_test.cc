@@ -14,6 +14,7 @@
 
 #include "xls/ir/verifier.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -24,9 +25,13 @@
 #include "absl/strings/substitute.h"
 #include "absl/types/span.h"
 #include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/nodes.h"
 #include "xls/ir/package.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/value.h"
 
 namespace xls {
@@ -544,5 +549,53 @@ block my_block(push_valid: bits[1], push_data: bits[1], push_ready: bits[1], out
                        HasSubstr("Expected fifo depth >= 0, got -3")));
 }
 
+TEST_F(VerifierTest, VerificationCacheSkipsUnchangedFunctions) {
+  std::string input = R"(
+package p
+
+fn f(x: bits[8]) -> bits[8] {
+  ret neg.2: bits[8] = neg(x)
+}
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackageNoVerify(input));
+  Function* f = FindFunction("f", p.get());
+
+  VerificationCache cache;
+  EXPECT_FALSE(cache.IsClean(f));
+  XLS_ASSERT_OK(VerifyPackage(p.get(), /*codegen=*/false, &cache));
+  EXPECT_TRUE(cache.IsClean(f));
+
+  // A mutation invalidates the cached verification; re-verifying makes it
+  // clean again.
+  XLS_ASSERT_OK(
+      f->MakeNode<Literal>(SourceInfo(), Value(UBits(0, 8))).status());
+  EXPECT_FALSE(cache.IsClean(f));
+  XLS_ASSERT_OK(VerifyPackage(p.get(), /*codegen=*/false, &cache));
+  EXPECT_TRUE(cache.IsClean(f));
+}
+
+TEST_F(VerifierTest, VerificationCacheDoesNotMaskFailures) {
+  static constexpr std::string_view input = R"(
+package subrosa
+
+top fn function_0() -> bits[8][8] {
+  name: bits[1] = literal(value=0, id=1)
+  name__1: bits[8][8] = literal(value=[0, 0, 0, 0, 0, 0, 0, 0], id=2)
+  name__2: bits[64] = literal(value=0x0, id=3)
+  ret name__3: bits[8][8] = sel(name, cases=[name__1], default=name__2, id=4)
+}
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackageNoVerify(input));
+  VerificationCache cache;
+  // A failing FunctionBase is never marked clean, so repeated verification
+  // keeps reporting the violation.
+  for (int64_t i = 0; i < 2; ++i) {
+    EXPECT_THAT(VerifyPackage(p.get(), /*codegen=*/false, &cache),
+                StatusIs(absl::StatusCode::kInternal,
+                         HasSubstr("does not match node type")));
+    EXPECT_FALSE(cache.IsClean(FindFunction("function_0", p.get())));
+  }
+}
+
 }  // namespace
 }  // namespace xls
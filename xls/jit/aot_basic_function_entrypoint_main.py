@@ -121,6 +121,14 @@ class BasicFunctionAot:
   arg_layout: type_layout_pb2.TypeLayoutsProto
   result_layout: type_layout_pb2.TypeLayoutsProto
   extern_sanitizer: bool
+  xls_function_identifier: str
+  serialized_entrypoint: str
+  serialized_entrypoint_size: int
+
+
+def _cc_escape(data: bytes) -> str:
+  """Escapes bytes for embedding in a C++ string literal."""
+  return "".join(f"\\{b:03o}" for b in data)
 
 
 def main(argv: Sequence[str]) -> None:
@@ -157,6 +165,9 @@ def main(argv: Sequence[str]) -> None:
       arg_layout=entrypoint.inputs_layout,
       result_layout=entrypoint.outputs_layout,
       extern_sanitizer=entrypoint.has_msan,
+      xls_function_identifier=entrypoint.xls_function_identifier,
+      serialized_entrypoint=_cc_escape(entrypoint.SerializeToString()),
+      serialized_entrypoint_size=len(entrypoint.SerializeToString()),
   )
   env = jinja2.Environment(undefined=jinja2.StrictUndefined)
   env.filters["append_each"] = lambda vs, suffix: [v + suffix for v in vs]
@@ -18,10 +18,13 @@
 // disk.
 
 #include <cstdint>
+#include <filesystem>  // NOLINT
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "absl/algorithm/container.h"
@@ -37,10 +40,13 @@
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/ir/function.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/ir_parser.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/package.h"
+#include "xls/ir/proc.h"
 #include "xls/jit/aot_entrypoint.pb.h"
+#include "xls/jit/function_base_jit.h"
 #include "xls/jit/function_jit.h"
 #include "xls/jit/llvm_type_converter.h"
 #include "xls/jit/orc_jit.h"
@@ -48,11 +54,15 @@
 
 ABSL_FLAG(std::string, input, "", "Path to the IR to compile.");
 ABSL_FLAG(std::string, top, "",
-          "IR function to compile. "
-          "If unspecified, the package top function will be used - "
-          "in that case, the package-scoping mangling will be removed.");
+          "IR function or proc to compile. "
+          "If unspecified, the package top will be used - "
+          "in that case, the package-scoping mangling will be removed. "
+          "If a proc is selected, every proc in the package is compiled so "
+          "the whole proc network can run ahead-of-time.");
 ABSL_FLAG(std::string, output_object, "",
-          "Path at which to write the output object file.");
+          "Path at which to write the output object file. When compiling a "
+          "proc network with more than one proc, an index is inserted before "
+          "the extension (one object file per proc, in entrypoint order).");
 ABSL_FLAG(std::string, output_proto, "",
           "Path at which to write the AotEntrypointProto describing the ABI of "
           "the generated object file.");
@@ -70,10 +80,11 @@ ABSL_FLAG(bool, include_msan, kHasMsan,
 namespace xls {
 namespace {
 
-// Returns the TypeLayouts for the arguments of `f`.
-TypeLayoutsProto ArgLayouts(Function* f, LlvmTypeConverter& type_converter) {
+// Returns the TypeLayouts for the parameters of `fb` (the arguments of a
+// function or the state elements of a proc).
+TypeLayoutsProto ArgLayouts(FunctionBase* fb, LlvmTypeConverter& type_converter) {
   TypeLayoutsProto layouts_proto;
-  for (Param* param : f->params()) {
+  for (Param* param : fb->params()) {
     *layouts_proto.add_layouts() =
         type_converter.CreateTypeLayout(param->GetType()).ToProto();
   }
@@ -89,7 +100,7 @@ TypeLayoutsProto ResultLayouts(Function* f, LlvmTypeConverter& type_converter) {
 }
 
 absl::StatusOr<AotEntrypointProto> GenerateEntrypointProto(
-    Package* package, Function* func, const JitObjectCode& object_code,
+    Package* package, FunctionBase* func, const JittedFunctionBase& jit_func,
     bool include_msan) {
   AotEntrypointProto proto;
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<OrcJit> orc_jit,
@@ -100,56 +111,119 @@ absl::StatusOr<AotEntrypointProto> GenerateEntrypointProto(
                        OrcJit::CreateDataLayout(/*aot_specification=*/true));
   LlvmTypeConverter type_converter(orc_jit->GetContext(), data_layout);
   *proto.mutable_inputs_layout() = ArgLayouts(func, type_converter);
-  *proto.mutable_outputs_layout() = ResultLayouts(func, type_converter);
-  proto.add_outputs_names("result");
+  if (func->IsFunction()) {
+    *proto.mutable_outputs_layout() =
+        ResultLayouts(func->AsFunctionOrDie(), type_converter);
+    proto.add_outputs_names("result");
+  } else {
+    // For a proc the outputs are the next-state values, which have the same
+    // shapes and names as the state params.
+    *proto.mutable_outputs_layout() = ArgLayouts(func, type_converter);
+    for (const Param* p : func->params()) {
+      proto.add_outputs_names(p->name());
+    }
+  }
   proto.set_has_msan(include_msan);
   for (const Param* p : func->params()) {
     proto.add_inputs_names(p->name());
   }
   proto.set_xls_package_name(package->name());
   proto.set_xls_function_identifier(func->name());
-  proto.set_function_symbol(object_code.function_base.function_name());
-  absl::c_for_each(object_code.function_base.input_buffer_sizes(),
+  proto.set_function_symbol(jit_func.function_name());
+  absl::c_for_each(jit_func.input_buffer_sizes(),
                    [&](int64_t i) { proto.add_input_buffer_sizes(i); });
   absl::c_for_each(
-      object_code.function_base.input_buffer_preferred_alignments(),
+      jit_func.input_buffer_preferred_alignments(),
       [&](int64_t i) { proto.add_input_buffer_alignments(i); });
   absl::c_for_each(
-      object_code.function_base.input_buffer_abi_alignments(),
+      jit_func.input_buffer_abi_alignments(),
       [&](int64_t i) { proto.add_input_buffer_abi_alignments(i); });
-  absl::c_for_each(object_code.function_base.output_buffer_sizes(),
+  absl::c_for_each(jit_func.output_buffer_sizes(),
                    [&](int64_t i) { proto.add_output_buffer_sizes(i); });
   absl::c_for_each(
-      object_code.function_base.output_buffer_preferred_alignments(),
+      jit_func.output_buffer_preferred_alignments(),
       [&](int64_t i) { proto.add_output_buffer_alignments(i); });
   absl::c_for_each(
-      object_code.function_base.output_buffer_abi_alignments(),
+      jit_func.output_buffer_abi_alignments(),
       [&](int64_t i) { proto.add_output_buffer_abi_alignments(i); });
-  if (object_code.function_base.HasPackedFunction()) {
-    proto.set_packed_function_symbol(
-        *object_code.function_base.packed_function_name());
+  if (jit_func.HasPackedFunction()) {
+    proto.set_packed_function_symbol(*jit_func.packed_function_name());
     absl::c_for_each(
-        object_code.function_base.packed_input_buffer_sizes(),
+        jit_func.packed_input_buffer_sizes(),
         [&](int64_t i) { proto.add_packed_input_buffer_sizes(i); });
     absl::c_for_each(
-        object_code.function_base.packed_output_buffer_sizes(),
+        jit_func.packed_output_buffer_sizes(),
         [&](int64_t i) { proto.add_packed_output_buffer_sizes(i); });
   }
 
-  proto.set_temp_buffer_size(object_code.function_base.temp_buffer_size());
-  proto.set_temp_buffer_alignment(
-      object_code.function_base.temp_buffer_alignment());
-  for (const auto& [cont, node] :
-       object_code.function_base.continuation_points()) {
-    proto.mutable_continuation_point_node_ids()->at(cont) = node->id();
+  proto.set_temp_buffer_size(jit_func.temp_buffer_size());
+  proto.set_temp_buffer_alignment(jit_func.temp_buffer_alignment());
+  for (const auto& [cont, node] : jit_func.continuation_points()) {
+    (*proto.mutable_continuation_point_node_ids())[cont] = node->id();
   }
-  for (const auto& [chan_name, idx] :
-       object_code.function_base.queue_indices()) {
-    proto.mutable_channel_queue_indices()->at(chan_name) = idx;
+  for (const auto& [chan_name, idx] : jit_func.queue_indices()) {
+    (*proto.mutable_channel_queue_indices())[chan_name] = idx;
   }
   return proto;
 }
 
+absl::Status WriteProto(const google::protobuf::Message& proto,
+                        const std::string& output_proto_path,
+                        bool generate_textproto) {
+  if (generate_textproto) {
+    std::string text;
+    XLS_RET_CHECK(google::protobuf::TextFormat::PrintToString(proto, &text));
+    return SetFileContents(output_proto_path, text);
+  }
+  return SetFileContents(output_proto_path, proto.SerializeAsString());
+}
+
+// Compiles every proc in `package` to object code and writes the object files
+// and an AotPackageEntrypointsProto describing them, so an entire proc network
+// can be executed via CreateAotSerialProcRuntime() without in-process LLVM.
+// With a single proc the object file is written to `output_object_path`; with
+// N procs, an index is inserted before the extension (e.g. "net.o" becomes
+// "net.0.o" ... "net.N-1.o") in entrypoint order.
+absl::Status CompileProcNetwork(Package* package,
+                                const std::string& output_object_path,
+                                const std::string& output_proto_path,
+                                bool include_msan, bool generate_textproto) {
+  AotPackageEntrypointsProto package_proto;
+  std::vector<std::vector<uint8_t>> objects;
+  for (const std::unique_ptr<Proc>& proc : package->procs()) {
+    // Each proc gets its own OrcJit (and object file); object code for
+    // distinct modules cannot be merged without a link step.
+    XLS_ASSIGN_OR_RETURN(std::unique_ptr<OrcJit> orc_jit,
+                         OrcJit::Create(/*opt_level=*/OrcJit::kDefaultOptLevel,
+                                        /*emit_object_code=*/true,
+                                        /*emit_msan=*/include_msan));
+    XLS_ASSIGN_OR_RETURN(JittedFunctionBase jit_func,
+                         JittedFunctionBase::Build(proc.get(), *orc_jit));
+    XLS_ASSIGN_OR_RETURN(
+        AotEntrypointProto entrypoint,
+        GenerateEntrypointProto(package, proc.get(), jit_func, include_msan));
+    *package_proto.add_entrypoints() = std::move(entrypoint);
+    objects.push_back(orc_jit->GetObjectCode());
+  }
+  XLS_RET_CHECK(!objects.empty()) << "Package contains no procs.";
+
+  if (objects.size() == 1) {
+    XLS_RETURN_IF_ERROR(SetFileContents(
+        output_object_path, std::string(objects[0].begin(), objects[0].end())));
+  } else {
+    std::filesystem::path base(output_object_path);
+    for (int64_t i = 0; i < static_cast<int64_t>(objects.size()); ++i) {
+      std::filesystem::path indexed =
+          base.parent_path() / absl::StrCat(base.stem().string(), ".", i,
+                                            base.extension().string());
+      XLS_RETURN_IF_ERROR(SetFileContents(
+          indexed, std::string(objects[i].begin(), objects[i].end())));
+    }
+  }
+
+  return WriteProto(package_proto, output_proto_path, generate_textproto);
+}
+
 absl::Status RealMain(const std::string& input_ir_path, const std::string& top,
                       const std::string& output_object_path,
                       const std::string& output_proto_path, bool include_msan,
@@ -158,20 +232,37 @@ absl::Status RealMain(const std::string& input_ir_path, const std::string& top,
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
                        Parser::ParsePackage(input_ir, input_ir_path));
 
-  Function* f;
+  // Resolve the top entity; a proc top selects whole-proc-network
+  // compilation.
+  FunctionBase* fb = nullptr;
   std::string package_prefix = absl::StrCat("__", package->name(), "__");
   if (top.empty()) {
-    XLS_ASSIGN_OR_RETURN(f, package->GetTopAsFunction());
+    std::optional<FunctionBase*> maybe_top = package->GetTop();
+    XLS_RET_CHECK(maybe_top.has_value())
+        << "Package has no top set; --top must be specified.";
+    fb = *maybe_top;
+  } else if (absl::StatusOr<Function*> maybe_f = package->GetFunction(top);
+             maybe_f.ok()) {
+    fb = *maybe_f;
+  } else if (std::optional<Proc*> maybe_p = package->TryGetProc(top);
+             maybe_p.has_value()) {
+    fb = *maybe_p;
+  } else if (absl::StatusOr<Function*> prefixed_f =
+                 package->GetFunction(absl::StrCat(package_prefix, top));
+             prefixed_f.ok()) {
+    fb = *prefixed_f;
   } else {
-    absl::StatusOr<Function*> maybe_f = package->GetFunction(top);
-    if (maybe_f.ok()) {
-      f = *maybe_f;
-    } else {
-      XLS_ASSIGN_OR_RETURN(
-          f, package->GetFunction(absl::StrCat(package_prefix, top)));
-    }
+    XLS_ASSIGN_OR_RETURN(fb,
+                         package->GetProc(absl::StrCat(package_prefix, top)));
+  }
+
+  if (fb->IsProc()) {
+    return CompileProcNetwork(package.get(), output_object_path,
+                              output_proto_path, include_msan,
+                              generate_textproto);
   }
 
+  Function* f = fb->AsFunctionOrDie();
   XLS_ASSIGN_OR_RETURN(JitObjectCode object_code,
                        FunctionJit::CreateObjectCode(f));
   XLS_RETURN_IF_ERROR(SetFileContents(
@@ -180,17 +271,9 @@ absl::Status RealMain(const std::string& input_ir_path, const std::string& top,
 
   XLS_ASSIGN_OR_RETURN(
       AotEntrypointProto entrypoint,
-      GenerateEntrypointProto(package.get(), f, object_code, include_msan));
-  if (generate_textproto) {
-    std::string text;
-    XLS_RET_CHECK(google::protobuf::TextFormat::PrintToString(entrypoint, &text));
-    XLS_RETURN_IF_ERROR(SetFileContents(output_proto_path, text));
-  } else {
-    XLS_RETURN_IF_ERROR(
-        SetFileContents(output_proto_path, entrypoint.SerializeAsString()));
-  }
-
-  return absl::OkStatus();
+      GenerateEntrypointProto(package.get(), f, object_code.function_base,
+                              include_msan));
+  return WriteProto(entrypoint, output_proto_path, generate_textproto);
 }
 
 }  // namespace
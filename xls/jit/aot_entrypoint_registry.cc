@@ -0,0 +1,102 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/jit/aot_entrypoint_registry.h"
+
+#include <dlfcn.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/jit/aot_entrypoint.pb.h"
+#include "xls/jit/function_base_jit.h"
+
+namespace xls {
+namespace {
+
+// Resolves `symbol` against the running binary and its loaded libraries.
+absl::StatusOr<JitFunctionType> ResolveSymbol(std::string_view symbol) {
+  void* address = dlsym(RTLD_DEFAULT, std::string(symbol).c_str());
+  if (address == nullptr) {
+    return absl::NotFoundError(absl::StrFormat(
+        "Unable to resolve AOT entrypoint symbol `%s`", symbol));
+  }
+  return reinterpret_cast<JitFunctionType>(address);
+}
+
+}  // namespace
+
+/* static */ AotEntrypointRegistry& AotEntrypointRegistry::Global() {
+  static AotEntrypointRegistry* registry = new AotEntrypointRegistry;
+  return *registry;
+}
+
+void AotEntrypointRegistry::Register(std::string_view xls_function_identifier,
+                                     std::string_view serialized_entrypoint) {
+  absl::MutexLock lock(&mutex_);
+  registrations_[std::string(xls_function_identifier)] =
+      Registration{.serialized = serialized_entrypoint};
+}
+
+absl::StatusOr<const AotEntrypointRegistry::Entrypoint*>
+AotEntrypointRegistry::Get(std::string_view xls_function_identifier) {
+  absl::MutexLock lock(&mutex_);
+  auto it = registrations_.find(xls_function_identifier);
+  if (it == registrations_.end()) {
+    return absl::NotFoundError(
+        absl::StrFormat("No AOT entrypoint registered for `%s`",
+                        xls_function_identifier));
+  }
+  Registration& registration = it->second;
+  if (registration.materialized == nullptr) {
+    auto entrypoint = std::unique_ptr<Entrypoint>(new Entrypoint);
+    entrypoint->proto_ = std::make_unique<AotEntrypointProto>();
+    if (!entrypoint->proto_->ParseFromArray(
+            registration.serialized.data(),
+            static_cast<int>(registration.serialized.size()))) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Unable to parse serialized AotEntrypointProto for `%s`",
+          xls_function_identifier));
+    }
+    XLS_ASSIGN_OR_RETURN(
+        entrypoint->function_,
+        ResolveSymbol(entrypoint->proto_->function_symbol()));
+    if (entrypoint->proto_->has_packed_function_symbol()) {
+      XLS_ASSIGN_OR_RETURN(
+          entrypoint->packed_function_,
+          ResolveSymbol(entrypoint->proto_->packed_function_symbol()));
+    }
+    registration.materialized = std::move(entrypoint);
+  }
+  return registration.materialized.get();
+}
+
+std::vector<std::string> AotEntrypointRegistry::RegisteredIdentifiers() const {
+  absl::MutexLock lock(&mutex_);
+  std::vector<std::string> identifiers;
+  identifiers.reserve(registrations_.size());
+  for (const auto& [identifier, _] : registrations_) {
+    identifiers.push_back(identifier);
+  }
+  return identifiers;
+}
+
+}  // namespace xls
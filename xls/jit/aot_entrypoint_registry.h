@@ -0,0 +1,120 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_JIT_AOT_ENTRYPOINT_REGISTRY_H_
+#define XLS_JIT_AOT_ENTRYPOINT_REGISTRY_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/jit/aot_entrypoint.pb.h"
+#include "xls/jit/function_base_jit.h"
+
+namespace xls {
+
+// A registry of AOT-compiled entrypoints which defers all per-entrypoint work
+// until an entrypoint is actually used. Registration stores only the XLS
+// function identifier and a view of the serialized AotEntrypointProto bytes
+// (for generated code, a string literal whose .rodata pages are only faulted
+// in when read); the proto is deserialized and the code symbols are resolved
+// with dlsym on the first Get of that entrypoint. A binary linking hundreds
+// of AOT-compiled functions therefore pays no proto-parsing or symbol
+// resolution cost at startup for the functions it never calls.
+class AotEntrypointRegistry {
+ public:
+  // The materialized form of one registered entrypoint: the deserialized
+  // metadata plus the resolved code pointers. Pointers returned by Get remain
+  // valid for the lifetime of the registry.
+  class Entrypoint {
+   public:
+    const AotEntrypointProto& proto() const { return *proto_; }
+
+    // The unpacked-representation entrypoint.
+    JitFunctionType function() const { return function_; }
+
+    // The packed-representation entrypoint, if one was compiled.
+    std::optional<JitFunctionType> packed_function() const {
+      return packed_function_;
+    }
+
+   private:
+    friend class AotEntrypointRegistry;
+    Entrypoint() = default;
+
+    std::unique_ptr<AotEntrypointProto> proto_;
+    JitFunctionType function_ = nullptr;
+    std::optional<JitFunctionType> packed_function_;
+  };
+
+  AotEntrypointRegistry() = default;
+
+  // Returns the process-wide registry used by generated AOT code.
+  static AotEntrypointRegistry& Global();
+
+  // Registers the entrypoint for `xls_function_identifier`
+  // (AotEntrypointProto.xls_function_identifier). `serialized_entrypoint` is
+  // the binary-serialized AotEntrypointProto and is not copied or validated
+  // here; it must outlive the registry. Re-registering an identifier replaces
+  // any earlier, not-yet-materialized registration.
+  void Register(std::string_view xls_function_identifier,
+                std::string_view serialized_entrypoint);
+
+  // Returns the entrypoint registered for `xls_function_identifier`,
+  // deserializing its metadata and resolving its symbols on first call.
+  // Returns NotFoundError for unregistered identifiers or symbols the dynamic
+  // loader cannot resolve, and InvalidArgumentError if the serialized
+  // metadata does not parse.
+  absl::StatusOr<const Entrypoint*> Get(
+      std::string_view xls_function_identifier);
+
+  // Returns the identifiers of all registered entrypoints (materialized or
+  // not), in unspecified order.
+  std::vector<std::string> RegisteredIdentifiers() const;
+
+ private:
+  struct Registration {
+    std::string_view serialized;
+    // Null until the entrypoint is first requested.
+    std::unique_ptr<Entrypoint> materialized;
+  };
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, Registration> registrations_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+// Registers an entrypoint with the global registry at static-initialization
+// time. Intended for use from generated code:
+//
+//   static ::xls::AotEntrypointRegistrar registrar(
+//       "__package__fn", kSerializedEntrypoint);
+class AotEntrypointRegistrar {
+ public:
+  AotEntrypointRegistrar(std::string_view xls_function_identifier,
+                         std::string_view serialized_entrypoint) {
+    AotEntrypointRegistry::Global().Register(xls_function_identifier,
+                                             serialized_entrypoint);
+  }
+};
+
+}  // namespace xls
+
+#endif  // XLS_JIT_AOT_ENTRYPOINT_REGISTRY_H_
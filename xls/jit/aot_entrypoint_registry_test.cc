@@ -0,0 +1,103 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/jit/aot_entrypoint_registry.h"
+
+#include <string>
+#include <string_view>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "xls/common/status/matchers.h"
+#include "xls/jit/aot_entrypoint.pb.h"
+
+namespace xls {
+namespace {
+
+using status_testing::StatusIs;
+using ::testing::HasSubstr;
+using ::testing::UnorderedElementsAre;
+
+// Builds a serialized entrypoint whose symbol resolves in any binary via the
+// dynamic loader.
+std::string SerializedEntrypoint(std::string_view identifier) {
+  AotEntrypointProto proto;
+  proto.set_xls_package_name("test_package");
+  proto.set_xls_function_identifier(std::string(identifier));
+  proto.set_function_symbol("malloc");
+  proto.set_temp_buffer_size(16);
+  return proto.SerializeAsString();
+}
+
+TEST(AotEntrypointRegistryTest, GetMaterializesRegisteredEntrypoint) {
+  AotEntrypointRegistry registry;
+  std::string serialized = SerializedEntrypoint("__test__f");
+  registry.Register("__test__f", serialized);
+
+  XLS_ASSERT_OK_AND_ASSIGN(const AotEntrypointRegistry::Entrypoint* entrypoint,
+                           registry.Get("__test__f"));
+  EXPECT_EQ(entrypoint->proto().xls_function_identifier(), "__test__f");
+  EXPECT_EQ(entrypoint->proto().temp_buffer_size(), 16);
+  EXPECT_NE(entrypoint->function(), nullptr);
+  EXPECT_FALSE(entrypoint->packed_function().has_value());
+
+  // Repeated lookups return the same materialized instance.
+  XLS_ASSERT_OK_AND_ASSIGN(const AotEntrypointRegistry::Entrypoint* again,
+                           registry.Get("__test__f"));
+  EXPECT_EQ(entrypoint, again);
+}
+
+TEST(AotEntrypointRegistryTest, UnregisteredIdentifierIsNotFound) {
+  AotEntrypointRegistry registry;
+  EXPECT_THAT(registry.Get("__test__missing"),
+              StatusIs(absl::StatusCode::kNotFound,
+                       HasSubstr("__test__missing")));
+}
+
+TEST(AotEntrypointRegistryTest, BadMetadataIsDiagnosedOnGetNotRegister) {
+  AotEntrypointRegistry registry;
+  // Registration never touches the bytes; the parse failure surfaces on the
+  // first use of the entrypoint.
+  registry.Register("__test__garbage", "not a serialized proto");
+  EXPECT_THAT(registry.Get("__test__garbage"),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("__test__garbage")));
+}
+
+TEST(AotEntrypointRegistryTest, UnresolvableSymbolIsNotFound) {
+  AotEntrypointProto proto;
+  proto.set_xls_function_identifier("__test__unresolvable");
+  proto.set_function_symbol("__xls_no_such_symbol_anywhere");
+  std::string serialized = proto.SerializeAsString();
+
+  AotEntrypointRegistry registry;
+  registry.Register("__test__unresolvable", serialized);
+  EXPECT_THAT(registry.Get("__test__unresolvable"),
+              StatusIs(absl::StatusCode::kNotFound,
+                       HasSubstr("__xls_no_such_symbol_anywhere")));
+}
+
+TEST(AotEntrypointRegistryTest, RegisteredIdentifiersListsAllRegistrations) {
+  AotEntrypointRegistry registry;
+  std::string serialized_a = SerializedEntrypoint("__test__a");
+  std::string serialized_b = SerializedEntrypoint("__test__b");
+  registry.Register("__test__a", serialized_a);
+  registry.Register("__test__b", serialized_b);
+  EXPECT_THAT(registry.RegisteredIdentifiers(),
+              UnorderedElementsAre("__test__a", "__test__b"));
+}
+
+}  // namespace
+}  // namespace xls
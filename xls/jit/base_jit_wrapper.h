@@ -15,6 +15,7 @@
 #ifndef XLS_JIT_BASE_JIT_WRAPPER_H_
 #define XLS_JIT_BASE_JIT_WRAPPER_H_
 
+#include <array>
 #include <cstdint>
 #include <iterator>
 #include <memory>
@@ -47,6 +48,27 @@
 
 namespace xls {
 
+// Owned, zero-initialized storage for a packed value view. Generated jit
+// wrappers alias this for each argument, result and channel (e.g.
+// `FooStorage`) so callers can allocate a correctly-sized buffer and
+// read/write it directly through the typed view -- with field offsets
+// computed at compile time -- instead of packing/unpacking xls::Value.
+template <typename PackedViewT>
+class PackedViewStorage {
+ public:
+  static constexpr int64_t kBitCount = PackedViewT::kBitCount;
+  static constexpr int64_t kByteCount = (kBitCount + 7) / 8;
+
+  // Returns a typed view over the owned buffer.
+  PackedViewT view() { return PackedViewT(buffer_.data(), 0); }
+
+  uint8_t* mutable_buffer() { return buffer_.data(); }
+  const uint8_t* buffer() const { return buffer_.data(); }
+
+ private:
+  std::array<uint8_t, kByteCount> buffer_ = {};
+};
+
 // This class provides the underlying implementation for shared aspects of
 // jit-wrappers. Specifically it implements the constructor and the actual calls
 // to the underlying jit. This allows the wrapper to basically just implement
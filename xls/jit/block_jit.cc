@@ -21,10 +21,13 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "absl/base/casts.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -76,6 +79,28 @@ absl::Status BlockJit::RunOneCycle(BlockJitContinuation& continuation) {
   return absl::OkStatus();
 }
 
+absl::Status BlockJit::RunCycles(BlockJitContinuation& continuation,
+                                 int64_t cycle_count) {
+  return RunCycles(continuation, cycle_count,
+                   [](int64_t cycle) { return absl::OkStatus(); });
+}
+
+absl::Status BlockJit::RunCycles(
+    BlockJitContinuation& continuation, int64_t cycle_count,
+    absl::FunctionRef<absl::Status(int64_t cycle)> per_cycle) {
+  XLS_RET_CHECK_GE(cycle_count, 0);
+  for (int64_t cycle = 0; cycle < cycle_count; ++cycle) {
+    function_.RunJittedFunction(
+        continuation.input_buffers_.current(),
+        continuation.output_buffers_.current(), continuation.temp_buffer_,
+        &continuation.GetEvents(), /*instance_context=*/nullptr, runtime_,
+        /*continuation_point=*/0);
+    continuation.SwapRegisters();
+    XLS_RETURN_IF_ERROR(per_cycle(cycle));
+  }
+  return absl::OkStatus();
+}
+
 absl::StatusOr<JitArgumentSet> BlockJitContinuation::CombineBuffers(
     const JittedFunctionBase& jit_func, const JitArgumentSet& left,
     int64_t left_count, const JitArgumentSet& rest, int64_t rest_start,
@@ -266,6 +291,63 @@ absl::Status BlockJitContinuation::SetRegisters(
   return SetRegisters(values);
 }
 
+absl::Status BlockJitContinuation::BindInputPortToOutput(
+    int64_t input_port_index, const BlockJitContinuation& producer,
+    int64_t output_port_index) {
+  XLS_RET_CHECK_GE(input_port_index, 0);
+  XLS_RET_CHECK_LT(input_port_index,
+                   static_cast<int64_t>(block_->GetInputPorts().size()));
+  XLS_RET_CHECK_GE(output_port_index, 0);
+  XLS_RET_CHECK_LT(
+      output_port_index,
+      static_cast<int64_t>(producer.block_->GetOutputPorts().size()));
+  InputPort* input_port = block_->GetInputPorts()[input_port_index];
+  OutputPort* output_port =
+      producer.block_->GetOutputPorts()[output_port_index];
+  Type* input_type = input_port->GetType();
+  Type* output_type = output_port->operand(0)->GetType();
+  XLS_RET_CHECK(input_type->IsEqualTo(output_type))
+      << "Cannot bind input port '" << input_port->name() << "' of type "
+      << input_type->ToString() << " to output port '" << output_port->name()
+      << "' of type " << output_type->ToString();
+  XLS_RET_CHECK_EQ(block_jit_->input_port_sizes()[input_port_index],
+                   producer.block_jit_->output_port_sizes()[output_port_index])
+      << "buffer layout mismatch binding input port '" << input_port->name()
+      << "' to output port '" << output_port->name() << "'";
+  // The port sections of the producer's combined output buffers alias the
+  // same memory on both register sides, so this address is stable across
+  // cycles.
+  uint8_t* producer_buffer =
+      producer.output_port_buffers_memory_.pointers()[output_port_index];
+  XLS_RET_CHECK_EQ(
+      absl::bit_cast<uintptr_t>(producer_buffer) %
+          block_jit_->input_port_abi_alignments()[input_port_index],
+      0)
+      << "output port '" << output_port->name()
+      << "' buffer is insufficiently aligned for input port '"
+      << input_port->name() << "'";
+  input_buffers_.OverwritePointer(input_port_index, producer_buffer);
+  return absl::OkStatus();
+}
+
+absl::Status BlockJitContinuation::BindInputPortToOutput(
+    std::string_view input_port_name, const BlockJitContinuation& producer,
+    std::string_view output_port_name) {
+  auto input_indices = GetInputPortIndices();
+  auto input_it = input_indices.find(input_port_name);
+  if (input_it == input_indices.end()) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Block has no input port '%s'", input_port_name));
+  }
+  auto output_indices = producer.GetOutputPortIndices();
+  auto output_it = output_indices.find(output_port_name);
+  if (output_it == output_indices.end()) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Block has no output port '%s'", output_port_name));
+  }
+  return BindInputPortToOutput(input_it->second, producer, output_it->second);
+}
+
 std::vector<Value> BlockJitContinuation::GetOutputPorts() const {
   std::vector<Value> result;
   result.reserve(output_port_pointers().size());
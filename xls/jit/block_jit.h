@@ -30,6 +30,7 @@
 
 #include "absl/base/attributes.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
@@ -59,6 +60,23 @@ class BlockJit {
   // Runs a single cycle of a block with the given continuation.
   absl::Status RunOneCycle(BlockJitContinuation& continuation);
 
+  // Runs `cycle_count` back-to-back cycles with the given continuation.
+  // Register state stays resident in the jitted buffers between cycles and the
+  // input port buffers are reused as-is, avoiding the per-cycle
+  // set-ports/run/read-ports round trip that the single-cycle entry point
+  // encourages.
+  absl::Status RunCycles(BlockJitContinuation& continuation,
+                         int64_t cycle_count);
+
+  // As above but invokes `per_cycle` after each cycle with the zero-based
+  // cycle number, so callers can sample outputs (or overwrite inputs for the
+  // next cycle) mid-run. The raw port buffers are reachable through the
+  // continuation's `input_port_pointers()`/`output_port_pointers()` for
+  // callers that want to trace without converting to `Value`s.
+  absl::Status RunCycles(
+      BlockJitContinuation& continuation, int64_t cycle_count,
+      absl::FunctionRef<absl::Status(int64_t cycle)> per_cycle);
+
   OrcJit& orc_jit() const { return *jit_; }
 
   // Get how large each pointer buffer for the input ports are.
@@ -67,6 +85,18 @@ class BlockJit {
         .subspan(0, block_->GetInputPorts().size());
   }
 
+  // Get how large each pointer buffer for the output ports are.
+  absl::Span<const int64_t> output_port_sizes() const {
+    return absl::MakeConstSpan(function_.output_buffer_sizes())
+        .subspan(0, block_->GetOutputPorts().size());
+  }
+
+  // Get the ABI-required alignment of each input port buffer.
+  absl::Span<const int64_t> input_port_abi_alignments() const {
+    return absl::MakeConstSpan(function_.input_buffer_abi_alignments())
+        .subspan(0, block_->GetInputPorts().size());
+  }
+
   // Get how large each pointer buffer for the registers are.
   absl::Span<int64_t const> register_sizes() const {
     return absl::MakeConstSpan(function_.input_buffer_sizes())
@@ -130,6 +160,15 @@ class BlockJitContinuation {
 
     const JitArgumentSet& right() const { return right_; }
 
+    // Repoints element `index` of both underlying argument sets at `ptr`.
+    // Used to alias a port buffer owned by another continuation; the port
+    // sections of the left and right sets refer to the same memory so both
+    // must be updated together.
+    void OverwritePointer(int64_t index, uint8_t* ptr) {
+      left_.SetPointer(index, ptr);
+      right_.SetPointer(index, ptr);
+    }
+
    private:
     JitArgumentSet left_;
     JitArgumentSet right_;
@@ -156,6 +195,24 @@ class BlockJitContinuation {
   absl::Status SetRegisters(
       const absl::flat_hash_map<std::string, Value>& regs);
 
+  // Aliases the input port at `input_port_index` so the jitted function reads
+  // it directly from the buffer `producer` writes its output port
+  // `output_port_index` into, eliminating the per-cycle copy on inter-block
+  // edges of stitched designs. The port types (and therefore the buffer
+  // layouts) must be identical.
+  //
+  // `producer` must outlive this continuation. After binding, the bound input
+  // port must not be written through `SetInputPorts` (doing so would scribble
+  // over the producer's output buffer); run the producer's cycle before this
+  // continuation's so the aliased value is the producer's current-cycle
+  // output.
+  absl::Status BindInputPortToOutput(int64_t input_port_index,
+                                     const BlockJitContinuation& producer,
+                                     int64_t output_port_index);
+  absl::Status BindInputPortToOutput(std::string_view input_port_name,
+                                     const BlockJitContinuation& producer,
+                                     std::string_view output_port_name);
+
   std::vector<Value> GetOutputPorts() const;
   absl::flat_hash_map<std::string, Value> GetOutputPortsMap() const;
   std::vector<Value> GetRegisters() const;
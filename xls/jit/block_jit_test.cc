@@ -16,9 +16,11 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/status/status.h"
 #include "absl/types/span.h"
 #include "xls/common/status/matchers.h"
 #include "xls/interpreter/block_evaluator_test_base.h"
@@ -115,6 +117,129 @@ TEST_F(BlockJitTest, DelaySlot) {
   EXPECT_THAT(cont->GetOutputPorts(), ElementsAre(Value(UBits(42, 8))));
 }
 
+TEST_F(BlockJitTest, RunCyclesKeepsRegisterStateResident) {
+  auto p = CreatePackage();
+  BlockBuilder bb(TestName(), p.get());
+  XLS_ASSERT_OK_AND_ASSIGN(auto r,
+                           bb.block()->AddRegister("accum", p->GetBitsType(8)));
+  XLS_ASSERT_OK(bb.block()->AddClockPort("clk"));
+  auto input = bb.InputPort("input", p->GetBitsType(8));
+  auto read = bb.RegisterRead(r);
+  bb.RegisterWrite(r, bb.Add(read, input));
+  bb.OutputPort("output", read);
+
+  XLS_ASSERT_OK_AND_ASSIGN(Block * b, bb.Build());
+  XLS_ASSERT_OK_AND_ASSIGN(auto runtime, JitRuntime::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(auto jit, BlockJit::Create(b, runtime.get()));
+  auto cont = jit->NewContinuation();
+
+  XLS_ASSERT_OK(cont->SetRegisters({Value(UBits(0, 8))}));
+  XLS_ASSERT_OK(cont->SetInputPorts({Value(UBits(3, 8))}));
+  // Inputs are only set once; the accumulator advances every cycle without
+  // any per-cycle port traffic.
+  XLS_ASSERT_OK(jit->RunCycles(*cont, 5));
+  EXPECT_THAT(cont->GetRegisters(), ElementsAre(Value(UBits(15, 8))));
+  EXPECT_THAT(cont->GetOutputPorts(), ElementsAre(Value(UBits(12, 8))));
+}
+
+TEST_F(BlockJitTest, RunCyclesSamplesOutputsPerCycle) {
+  auto p = CreatePackage();
+  BlockBuilder bb(TestName(), p.get());
+  XLS_ASSERT_OK_AND_ASSIGN(auto r,
+                           bb.block()->AddRegister("accum", p->GetBitsType(8)));
+  XLS_ASSERT_OK(bb.block()->AddClockPort("clk"));
+  auto input = bb.InputPort("input", p->GetBitsType(8));
+  auto read = bb.RegisterRead(r);
+  bb.RegisterWrite(r, bb.Add(read, input));
+  bb.OutputPort("output", read);
+
+  XLS_ASSERT_OK_AND_ASSIGN(Block * b, bb.Build());
+  XLS_ASSERT_OK_AND_ASSIGN(auto runtime, JitRuntime::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(auto jit, BlockJit::Create(b, runtime.get()));
+  auto cont = jit->NewContinuation();
+
+  XLS_ASSERT_OK(cont->SetRegisters({Value(UBits(0, 8))}));
+  XLS_ASSERT_OK(cont->SetInputPorts({Value(UBits(1, 8))}));
+  std::vector<Value> trace;
+  XLS_ASSERT_OK(jit->RunCycles(*cont, 4, [&](int64_t cycle) {
+    trace.push_back(cont->GetOutputPorts().front());
+    return absl::OkStatus();
+  }));
+  EXPECT_THAT(trace,
+              ElementsAre(Value(UBits(0, 8)), Value(UBits(1, 8)),
+                          Value(UBits(2, 8)), Value(UBits(3, 8))));
+}
+
+TEST_F(BlockJitTest, BindInputPortToOutputSharesBuffer) {
+  auto p = CreatePackage();
+  Block* producer_block;
+  {
+    BlockBuilder bb("producer", p.get());
+    auto a = bb.InputPort("a", p->GetBitsType(32));
+    auto b = bb.InputPort("b", p->GetBitsType(32));
+    bb.OutputPort("sum", bb.Add(a, b));
+    XLS_ASSERT_OK_AND_ASSIGN(producer_block, bb.Build());
+  }
+  Block* consumer_block;
+  {
+    BlockBuilder bb("consumer", p.get());
+    auto x = bb.InputPort("x", p->GetBitsType(32));
+    bb.OutputPort("doubled", bb.Add(x, x));
+    XLS_ASSERT_OK_AND_ASSIGN(consumer_block, bb.Build());
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(auto runtime, JitRuntime::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(auto producer_jit,
+                           BlockJit::Create(producer_block, runtime.get()));
+  XLS_ASSERT_OK_AND_ASSIGN(auto consumer_jit,
+                           BlockJit::Create(consumer_block, runtime.get()));
+  auto producer_cont = producer_jit->NewContinuation();
+  auto consumer_cont = consumer_jit->NewContinuation();
+  XLS_ASSERT_OK(
+      consumer_cont->BindInputPortToOutput("x", *producer_cont, "sum"));
+  // The consumer reads directly out of the producer's output buffer; no
+  // per-cycle marshalling happens on the bound edge.
+  EXPECT_EQ(consumer_cont->input_port_pointers()[0],
+            producer_cont->output_port_pointers()[0]);
+
+  for (int64_t i = 0; i < 3; ++i) {
+    XLS_ASSERT_OK(producer_cont->SetInputPorts(
+        {Value(UBits(10 + i, 32)), Value(UBits(20, 32))}));
+    XLS_ASSERT_OK(producer_jit->RunOneCycle(*producer_cont));
+    XLS_ASSERT_OK(consumer_jit->RunOneCycle(*consumer_cont));
+    EXPECT_THAT(consumer_cont->GetOutputPorts(),
+                ElementsAre(Value(UBits(2 * (30 + i), 32))));
+  }
+}
+
+TEST_F(BlockJitTest, BindInputPortToOutputRejectsTypeMismatch) {
+  auto p = CreatePackage();
+  Block* producer_block;
+  {
+    BlockBuilder bb("producer", p.get());
+    auto a = bb.InputPort("a", p->GetBitsType(8));
+    bb.OutputPort("narrow", a);
+    XLS_ASSERT_OK_AND_ASSIGN(producer_block, bb.Build());
+  }
+  Block* consumer_block;
+  {
+    BlockBuilder bb("consumer", p.get());
+    auto x = bb.InputPort("x", p->GetBitsType(32));
+    bb.OutputPort("wide", x);
+    XLS_ASSERT_OK_AND_ASSIGN(consumer_block, bb.Build());
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(auto runtime, JitRuntime::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(auto producer_jit,
+                           BlockJit::Create(producer_block, runtime.get()));
+  XLS_ASSERT_OK_AND_ASSIGN(auto consumer_jit,
+                           BlockJit::Create(consumer_block, runtime.get()));
+  auto producer_cont = producer_jit->NewContinuation();
+  auto consumer_cont = consumer_jit->NewContinuation();
+  EXPECT_THAT(
+      consumer_cont->BindInputPortToOutput("x", *producer_cont, "narrow"),
+      status_testing::StatusIs(absl::StatusCode::kInternal,
+                               testing::HasSubstr("Cannot bind input port")));
+}
+
 TEST_F(BlockJitTest, SetInputsWithViews) {
   auto p = CreatePackage();
   BlockBuilder bb(TestName(), p.get());
@@ -40,7 +40,9 @@
 #include "llvm/include/llvm/IR/Constants.h"
 #include "llvm/include/llvm/IR/DerivedTypes.h"
 #include "llvm/include/llvm/IR/Function.h"
+#include "llvm/include/llvm/IR/GlobalVariable.h"
 #include "llvm/include/llvm/IR/IRBuilder.h"
+#include "llvm/include/llvm/IR/Intrinsics.h"
 #include "llvm/include/llvm/IR/Instructions.h"
 #include "llvm/include/llvm/IR/LLVMContext.h"
 #include "llvm/include/llvm/IR/Type.h"
@@ -57,7 +59,9 @@
 #include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
+#include "xls/ir/package.h"
 #include "xls/ir/register.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/topo_sort.h"
 #include "xls/ir/type.h"
 #include "xls/jit/aot_entrypoint.pb.h"
@@ -530,6 +534,29 @@ Type* OutputType(const Node* node) {
 // false). The return value is only checked for partitions which are
 // early exit points (e.g., contain a blocking receive).
 //
+// Emits code accumulating the cycles elapsed since `start_cycles` (and an
+// invocation count) into the profile counter slots of the node with the given
+// profile index. The loads and stores are plain (non-atomic); a jitted
+// function executes single-threaded.
+void EmitNodeProfileUpdate(llvm::IRBuilder<>& b, JitBuilderContext& jit_context,
+                           int64_t profile_index, llvm::Value* start_cycles) {
+  llvm::Value* end_cycles = b.CreateIntrinsic(
+      b.getInt64Ty(), llvm::Intrinsic::readcyclecounter, {});
+  llvm::GlobalVariable* counters = jit_context.profile_counters();
+  auto counter_slot = [&](int64_t slot) {
+    return b.CreateConstInBoundsGEP2_64(counters->getValueType(), counters,
+                                        /*idx0=*/0, /*idx1=*/slot);
+  };
+  llvm::Value* cycles_ptr = counter_slot(2 * profile_index);
+  b.CreateStore(b.CreateAdd(b.CreateLoad(b.getInt64Ty(), cycles_ptr),
+                            b.CreateSub(end_cycles, start_cycles)),
+                cycles_ptr);
+  llvm::Value* count_ptr = counter_slot(2 * profile_index + 1);
+  b.CreateStore(
+      b.CreateAdd(b.CreateLoad(b.getInt64Ty(), count_ptr), b.getInt64(1)),
+      count_ptr);
+}
+
 // `global_input_nodes` and `global_output_nodes` are the set of nodes whose
 // buffers are passed in via the `input`/`output` arguments of the function.
 absl::StatusOr<llvm::Function*> BuildPartitionFunction(
@@ -650,7 +677,16 @@ absl::StatusOr<llvm::Function*> BuildPartitionFunction(
       args.push_back(wrapper.GetInstanceContextArg());
       args.push_back(wrapper.GetJitRuntimeArg());
     }
+    std::optional<int64_t> profile_index = jit_context.GetProfileIndex(node);
+    llvm::Value* profile_start = nullptr;
+    if (profile_index.has_value()) {
+      profile_start = b.CreateIntrinsic(b.getInt64Ty(),
+                                        llvm::Intrinsic::readcyclecounter, {});
+    }
     llvm::CallInst* node_blocked = b.CreateCall(node_function.function, args);
+    if (profile_index.has_value()) {
+      EmitNodeProfileUpdate(b, jit_context, *profile_index, profile_start);
+    }
 
     if (partition.early_exit_point.has_value()) {
       XLS_RET_CHECK_EQ(partition.nodes.size(), 1);
@@ -1239,12 +1275,95 @@ JitTempBuffer JittedFunctionBase::CreateTempBuffer() const {
   return JitTempBuffer(this, temp_buffer_alignment(), temp_buffer_size());
 }
 
+std::vector<NodeProfileRecord> JittedFunctionBase::GetNodeProfile() const {
+  std::vector<NodeProfileRecord> records;
+  if (node_profile_counters_ == nullptr) {
+    return records;
+  }
+  for (int64_t i = 0; i < profiled_nodes_.size(); ++i) {
+    uint64_t invocations = node_profile_counters_[2 * i + 1];
+    if (invocations == 0) {
+      continue;
+    }
+    records.push_back(NodeProfileRecord{.node = profiled_nodes_[i],
+                                        .total_cycles =
+                                            node_profile_counters_[2 * i],
+                                        .invocations = invocations});
+  }
+  std::sort(records.begin(), records.end(),
+            [](const NodeProfileRecord& a, const NodeProfileRecord& b) {
+              return a.total_cycles > b.total_cycles;
+            });
+  return records;
+}
+
+void JittedFunctionBase::ClearNodeProfile() const {
+  if (node_profile_counters_ != nullptr) {
+    std::fill(node_profile_counters_,
+              node_profile_counters_ + 2 * profiled_nodes_.size(), 0);
+  }
+}
+
+std::string NodeProfileToString(absl::Span<const NodeProfileRecord> records,
+                                int64_t max_records) {
+  std::string result;
+  absl::StrAppendFormat(&result, "%15s %12s %10s  %s\n", "cycles",
+                        "invocations", "cyc/invoc", "node");
+  int64_t emitted = 0;
+  for (const NodeProfileRecord& record : records) {
+    if (max_records >= 0 && emitted++ == max_records) {
+      break;
+    }
+    std::string location_str;
+    for (const SourceLocation& location : record.node->loc().locations) {
+      std::optional<std::string> filename =
+          record.node->package()->GetFilename(location.fileno());
+      absl::StrAppendFormat(&location_str, " %s:%d",
+                            filename.value_or("<unknown>"),
+                            location.lineno().value());
+    }
+    absl::StrAppendFormat(
+        &result, "%15d %12d %10.1f  %s%s\n", record.total_cycles,
+        record.invocations,
+        static_cast<double>(record.total_cycles) / record.invocations,
+        record.node->ToString(), location_str);
+  }
+  return result;
+}
+
 // Jits a function implementing `xls_function`. Also jits all transitively
 // dependent xls::Functions which may be called by `xls_function`.
 absl::StatusOr<JittedFunctionBase> JittedFunctionBase::BuildInternal(
     FunctionBase* xls_function, JitBuilderContext& jit_context,
-    bool build_packed_wrapper) {
+    bool build_packed_wrapper, bool profile_nodes) {
   std::vector<FunctionBase*> functions = GetDependentFunctions(xls_function);
+
+  std::string profile_counters_name;
+  std::vector<Node*> profiled_nodes;
+  if (profile_nodes) {
+    // Assign a dense index to every node in the jitted functions and emit a
+    // zero-initialized global array with two int64 slots (accumulated cycles,
+    // invocation count) per node. The partition builders instrument each node
+    // function call site to update the node's slots.
+    absl::flat_hash_map<Node*, int64_t> node_indices;
+    for (FunctionBase* f : functions) {
+      for (Node* node : f->nodes()) {
+        node_indices[node] = profiled_nodes.size();
+        profiled_nodes.push_back(node);
+      }
+    }
+    profile_counters_name =
+        absl::StrCat("__node_profile_counters_", xls_function->name());
+    llvm::ArrayType* counters_type =
+        llvm::ArrayType::get(llvm::Type::getInt64Ty(jit_context.context()),
+                             2 * profiled_nodes.size());
+    auto* counters = new llvm::GlobalVariable(
+        *jit_context.module(), counters_type, /*isConstant=*/false,
+        llvm::GlobalValue::ExternalLinkage,
+        llvm::ConstantAggregateZero::get(counters_type), profile_counters_name);
+    jit_context.EnableNodeProfiling(counters, std::move(node_indices));
+  }
+
   BufferAllocator allocator(&jit_context.type_converter());
   llvm::Function* top_function = nullptr;
   std::vector<Partition> top_partitions;
@@ -1286,6 +1405,15 @@ absl::StatusOr<JittedFunctionBase> JittedFunctionBase::BuildInternal(
         absl::bit_cast<JitFunctionType>(packed_fn_address);
   }
 
+  if (profile_nodes) {
+    XLS_ASSIGN_OR_RETURN(
+        auto counters_address,
+        jit_context.orc_jit().LoadSymbol(profile_counters_name));
+    jitted_function.node_profile_counters_ =
+        absl::bit_cast<uint64_t*>(counters_address);
+    jitted_function.profiled_nodes_ = std::move(profiled_nodes);
+  }
+
   for (const Node* input : GetJittedFunctionInputs(xls_function)) {
     Type* input_type = InputType(input);
     jitted_function.input_buffer_sizes_.push_back(
@@ -1326,24 +1454,27 @@ absl::StatusOr<JittedFunctionBase> JittedFunctionBase::BuildInternal(
 }
 
 absl::StatusOr<JittedFunctionBase> JittedFunctionBase::Build(
-    Function* xls_function, OrcJit& orc_jit) {
+    Function* xls_function, OrcJit& orc_jit, bool profile_nodes) {
   JitBuilderContext jit_context(orc_jit);
   return JittedFunctionBase::BuildInternal(xls_function, jit_context,
-                                           /*build_packed_wrapper=*/true);
+                                           /*build_packed_wrapper=*/true,
+                                           profile_nodes);
 }
 
-absl::StatusOr<JittedFunctionBase> JittedFunctionBase::Build(Proc* proc,
-                                                             OrcJit& orc_jit) {
+absl::StatusOr<JittedFunctionBase> JittedFunctionBase::Build(
+    Proc* proc, OrcJit& orc_jit, bool profile_nodes) {
   JitBuilderContext jit_context(orc_jit);
   return JittedFunctionBase::BuildInternal(proc, jit_context,
-                                           /*build_packed_wrapper=*/false);
+                                           /*build_packed_wrapper=*/false,
+                                           profile_nodes);
 }
 
-absl::StatusOr<JittedFunctionBase> JittedFunctionBase::Build(Block* block,
-                                                             OrcJit& jit) {
+absl::StatusOr<JittedFunctionBase> JittedFunctionBase::Build(
+    Block* block, OrcJit& jit, bool profile_nodes) {
   JitBuilderContext jit_context(jit);
   return JittedFunctionBase::BuildInternal(block, jit_context,
-                                           /*build_packed_wrapper=*/false);
+                                           /*build_packed_wrapper=*/false,
+                                           profile_nodes);
 }
 
 absl::StatusOr<JittedFunctionBase> JittedFunctionBase::BuildFromAot(
@@ -70,23 +70,44 @@ using JitFunctionType = int64_t (*)(const uint8_t* const* inputs,
                                     JitRuntime* jit_runtime,
                                     int64_t continuation_point);
 
+// A single entry of a per-node execution profile gathered from jitted code
+// built with `profile_nodes` enabled. `total_cycles` is the accumulated value
+// of the CPU cycle counter (llvm.readcyclecounter) across all `invocations`
+// executions of the node function.
+struct NodeProfileRecord {
+  Node* node;
+  uint64_t total_cycles;
+  uint64_t invocations;
+};
+
+// Renders the given profile records as a human-readable table, one line per
+// node with accumulated cycles, invocation count, average cycles per
+// invocation, the node itself, and its source location(s) when known. At most
+// `max_records` lines are emitted (negative means no limit).
+std::string NodeProfileToString(absl::Span<const NodeProfileRecord> records,
+                                int64_t max_records = -1);
+
 // Abstraction holding function pointers and metadata about a jitted function
 // implementing a XLS Function, Proc, etc.
 class JittedFunctionBase {
  public:
   JittedFunctionBase() = default;
   // Builds and returns an LLVM IR function implementing the given XLS
-  // function.
+  // function. If `profile_nodes` is true the jitted code is instrumented with
+  // per-node cycle counters readable via `GetNodeProfile`.
   static absl::StatusOr<JittedFunctionBase> Build(Function* xls_function,
-                                                  OrcJit& orc_jit);
+                                                  OrcJit& orc_jit,
+                                                  bool profile_nodes = false);
 
   // Builds and returns an LLVM IR function implementing the given XLS
   // proc.
-  static absl::StatusOr<JittedFunctionBase> Build(Proc* proc, OrcJit& orc_jit);
+  static absl::StatusOr<JittedFunctionBase> Build(Proc* proc, OrcJit& orc_jit,
+                                                  bool profile_nodes = false);
 
   // Builds and returns an LLVM IR function implementing the given XLS
   // block.
-  static absl::StatusOr<JittedFunctionBase> Build(Block* block, OrcJit& jit);
+  static absl::StatusOr<JittedFunctionBase> Build(Block* block, OrcJit& jit,
+                                                  bool profile_nodes = false);
 
   // Builds and returns a JittedFunctionBase using code and ABIs provided by an
   // earlier AOT compile.
@@ -199,6 +220,20 @@ class JittedFunctionBase {
     return queue_indices_;
   }
 
+  // Whether the jitted code was built with per-node profiling instrumentation
+  // (`profile_nodes` passed to Build).
+  bool HasNodeProfile() const { return node_profile_counters_ != nullptr; }
+
+  // Returns the per-node execution profile accumulated by the jitted code so
+  // far. Nodes which have not executed are omitted. Records are sorted by
+  // descending total cycle count. Returns an empty vector if the function was
+  // built without profiling.
+  std::vector<NodeProfileRecord> GetNodeProfile() const;
+
+  // Resets all accumulated profile counters to zero. Const because it mutates
+  // the counter storage inside the jitted module, not this object.
+  void ClearNodeProfile() const;
+
   JittedFunctionBase WithCodePointers(
       JitFunctionType entrypoint,
       std::optional<JitFunctionType> packed_entrypoint = std::nullopt) const {
@@ -244,7 +279,7 @@ class JittedFunctionBase {
 
   static absl::StatusOr<JittedFunctionBase> BuildInternal(
       FunctionBase* function, JitBuilderContext& jit_context,
-      bool build_packed_wrapper);
+      bool build_packed_wrapper, bool profile_nodes = false);
 
   // Name and function pointer for the jitted function which accepts/produces
   // arguments/results in LLVM native format.
@@ -285,6 +320,13 @@ class JittedFunctionBase {
   // The map from channel reference name to the index of the respective queue in
   // the instance context.
   absl::btree_map<std::string, int64_t> queue_indices_;
+
+  // Per-node profiling state. `node_profile_counters_` points at a
+  // zero-initialized int64 array inside the jitted module with two slots
+  // (accumulated cycles, invocation count) for each entry of
+  // `profiled_nodes_`. Null if built without profiling.
+  uint64_t* node_profile_counters_ = nullptr;
+  std::vector<Node*> profiled_nodes_;
 };
 
 }  // namespace xls
@@ -14,9 +14,14 @@
 
 #include "xls/jit/function_jit.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -29,6 +34,7 @@
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "llvm/include/llvm/IR/DataLayout.h"
+#include "xls/common/metrics.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/ir/events.h"
 #include "xls/ir/function.h"
@@ -39,6 +45,7 @@
 #include "xls/ir/value_utils.h"
 #include "xls/jit/function_base_jit.h"
 #include "xls/jit/ir_builder_visitor.h"
+#include "xls/jit/jit_buffer.h"
 #include "xls/jit/jit_runtime.h"
 #include "xls/jit/observer.h"
 #include "xls/jit/orc_jit.h"
@@ -46,9 +53,10 @@
 namespace xls {
 
 absl::StatusOr<std::unique_ptr<FunctionJit>> FunctionJit::Create(
-    Function* xls_function, int64_t opt_level, JitObserver* observer) {
+    Function* xls_function, int64_t opt_level, JitObserver* observer,
+    bool profile_nodes) {
   return CreateInternal(xls_function, opt_level, /*emit_object_code=*/false,
-                        observer);
+                        observer, profile_nodes);
 }
 
 namespace {
@@ -78,22 +86,24 @@ absl::StatusOr<JitObjectCode> FunctionJit::CreateObjectCode(
 
 absl::StatusOr<std::unique_ptr<FunctionJit>> FunctionJit::CreateInternal(
     Function* xls_function, int64_t opt_level, bool emit_object_code,
-    JitObserver* observer) {
+    JitObserver* observer, bool profile_nodes) {
+  XLS_METRICS_COUNTER_INC("jit.function_compiles");
+  XLS_METRICS_SCOPED_TIMER("jit.function_compile_time");
   XLS_ASSIGN_OR_RETURN(auto orc_jit,
                        OrcJit::Create(opt_level, emit_object_code, observer));
   XLS_ASSIGN_OR_RETURN(
       llvm::DataLayout data_layout,
       OrcJit::CreateDataLayout(/*aot_specification=*/emit_object_code));
-  XLS_ASSIGN_OR_RETURN(auto function_base,
-                       JittedFunctionBase::Build(xls_function, *orc_jit));
+  XLS_ASSIGN_OR_RETURN(
+      auto function_base,
+      JittedFunctionBase::Build(xls_function, *orc_jit, profile_nodes));
 
   return std::unique_ptr<FunctionJit>(new FunctionJit(
       xls_function, std::move(orc_jit), std::move(function_base),
       std::make_unique<JitRuntime>(data_layout)));
 }
 
-absl::StatusOr<InterpreterResult<Value>> FunctionJit::Run(
-    absl::Span<const Value> args) {
+absl::Status FunctionJit::ValidateArgs(absl::Span<const Value> args) {
   absl::Span<Param* const> params = xls_function_->params();
   if (args.size() != params.size()) {
     return absl::InvalidArgumentError(absl::StrFormat(
@@ -108,27 +118,166 @@ absl::StatusOr<InterpreterResult<Value>> FunctionJit::Run(
           args[i].ToString(), i, params[i]->GetType()->ToString()));
     }
   }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<InterpreterResult<Value>> FunctionJit::Run(
+    absl::Span<const Value> args) {
+  XLS_METRICS_COUNTER_INC("jit.function_runs");
+  XLS_METRICS_SCOPED_TIMER("jit.function_run_time");
+  XLS_RETURN_IF_ERROR(ValidateArgs(args));
 
   std::vector<Type*> param_types;
   for (const Param* param : xls_function_->params()) {
     param_types.push_back(param->GetType());
   }
 
+  return RunOnBuffers(args, param_types, arg_buffers_, result_buffers_,
+                      temp_buffer_);
+}
+
+absl::StatusOr<InterpreterResult<Value>> FunctionJit::RunOnBuffers(
+    absl::Span<const Value> args, absl::Span<Type* const> param_types,
+    JitArgumentSet& arg_buffers, JitArgumentSet& result_buffers,
+    JitTempBuffer& temp_buffer) {
   // Allocate argument buffers and copy in arg Values.
   XLS_RETURN_IF_ERROR(
-      jit_runtime_->PackArgs(args, param_types, arg_buffers_.pointers()));
+      jit_runtime_->PackArgs(args, param_types, arg_buffers.pointers()));
 
   InterpreterEvents events;
   jitted_function_base_.RunJittedFunction(
-      arg_buffers_, result_buffers_, temp_buffer_, &events,
+      arg_buffers, result_buffers, temp_buffer, &events,
       /*instance_context=*/nullptr, /*jit_runtime=*/runtime(),
       /*continuation_point=*/0);
   Value result = jit_runtime_->UnpackBuffer(
-      result_buffers_.pointers()[0], xls_function_->return_value()->GetType());
+      result_buffers.pointers()[0], xls_function_->return_value()->GetType());
 
   return InterpreterResult<Value>{std::move(result), std::move(events)};
 }
 
+absl::StatusOr<std::optional<Value>> FunctionJit::RunAndCompare(
+    absl::Span<const Value> args, const Value& expected) {
+  XLS_METRICS_COUNTER_INC("jit.function_runs");
+  XLS_METRICS_SCOPED_TIMER("jit.function_run_time");
+  XLS_RETURN_IF_ERROR(ValidateArgs(args));
+  Type* return_type = xls_function_->return_value()->GetType();
+  if (!ValueConformsToType(expected, return_type)) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Expected value %s is not of return type %s",
+                        expected.ToString(), return_type->ToString()));
+  }
+
+  std::vector<Type*> param_types;
+  for (const Param* param : xls_function_->params()) {
+    param_types.push_back(param->GetType());
+  }
+  XLS_RETURN_IF_ERROR(
+      jit_runtime_->PackArgs(args, param_types, arg_buffers_.pointers()));
+
+  InterpreterEvents events;
+  jitted_function_base_.RunJittedFunction(
+      arg_buffers_, result_buffers_, temp_buffer_, &events,
+      /*instance_context=*/nullptr, /*jit_runtime=*/runtime(),
+      /*continuation_point=*/0);
+  XLS_RETURN_IF_ERROR(InterpreterEventsToStatus(events));
+
+  const uint8_t* result_buffer = result_buffers_.pointers()[0];
+  const int64_t result_size = GetReturnTypeSize();
+  if (static_cast<int64_t>(compare_buffer_.size()) != result_size) {
+    compare_buffer_.resize(result_size);
+  }
+  std::fill(compare_buffer_.begin(), compare_buffer_.end(), uint8_t{0});
+  jit_runtime_->BlitValueToBuffer(expected, return_type,
+                                  absl::MakeSpan(compare_buffer_));
+  if (std::memcmp(result_buffer, compare_buffer_.data(), result_size) == 0) {
+    return std::nullopt;
+  }
+
+  // The native layout may contain padding bytes whose contents are
+  // unspecified, so a bytewise difference is not necessarily a semantic one.
+  // Materialize the result and let Value equality decide.
+  Value result = jit_runtime_->UnpackBuffer(result_buffer, return_type);
+  if (result == expected) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+absl::StatusOr<std::vector<InterpreterResult<Value>>> FunctionJit::RunBatch(
+    absl::Span<const std::vector<Value>> args_batch, int64_t worker_count) {
+  absl::Span<Param* const> params = xls_function_->params();
+  std::vector<Type*> param_types;
+  for (const Param* param : params) {
+    param_types.push_back(param->GetType());
+  }
+
+  // Validate the whole batch up front so workers need not handle type errors.
+  for (int64_t i = 0; i < args_batch.size(); ++i) {
+    absl::Span<const Value> args = args_batch[i];
+    if (args.size() != params.size()) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Arg list %d to '%s' has the wrong size: %d vs expected %d.", i,
+          xls_function_->name(), args.size(), params.size()));
+    }
+    for (int64_t j = 0; j < params.size(); ++j) {
+      if (!ValueConformsToType(args[j], params[j]->GetType())) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Got argument %s for parameter %d of sample %d which is not of "
+            "type %s",
+            args[j].ToString(), j, i, params[j]->GetType()->ToString()));
+      }
+    }
+  }
+
+  std::vector<InterpreterResult<Value>> results(args_batch.size());
+  worker_count =
+      std::min(worker_count, static_cast<int64_t>(args_batch.size()));
+  if (worker_count <= 1) {
+    for (int64_t i = 0; i < args_batch.size(); ++i) {
+      XLS_ASSIGN_OR_RETURN(
+          results[i], RunOnBuffers(args_batch[i], param_types, arg_buffers_,
+                                   result_buffers_, temp_buffer_));
+    }
+    return results;
+  }
+
+  // Shard the batch across workers, each with its own set of buffers. The
+  // jitted code itself is reentrant; only the buffers must not be shared.
+  std::atomic<int64_t> next_index(0);
+  std::vector<absl::Status> worker_status(worker_count);
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count);
+  for (int64_t w = 0; w < worker_count; ++w) {
+    workers.push_back(std::thread([&, w]() {
+      JitArgumentSet arg_buffers = jitted_function_base_.CreateInputBuffer();
+      JitArgumentSet result_buffers =
+          jitted_function_base_.CreateOutputBuffer();
+      JitTempBuffer temp_buffer = jitted_function_base_.CreateTempBuffer();
+      while (true) {
+        int64_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+        if (i >= args_batch.size()) {
+          break;
+        }
+        absl::StatusOr<InterpreterResult<Value>> result = RunOnBuffers(
+            args_batch[i], param_types, arg_buffers, result_buffers,
+            temp_buffer);
+        if (!result.ok()) {
+          worker_status[w] = std::move(result).status();
+          break;
+        }
+        results[i] = std::move(result).value();
+      }
+    }));
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (absl::Status& status : worker_status) {
+    XLS_RETURN_IF_ERROR(std::move(status));
+  }
+  return results;
+}
+
 absl::StatusOr<InterpreterResult<Value>> FunctionJit::Run(
     const absl::flat_hash_map<std::string, Value>& kwargs) {
   XLS_ASSIGN_OR_RETURN(std::vector<Value> positional_args,
@@ -17,6 +17,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -30,6 +31,7 @@
 #include "xls/common/status/ret_check.h"
 #include "xls/ir/events.h"
 #include "xls/ir/function.h"
+#include "xls/ir/type.h"
 #include "xls/ir/value.h"
 #include "xls/jit/function_base_jit.h"
 #include "xls/jit/jit_buffer.h"
@@ -54,10 +56,12 @@ struct JitObjectCode {
 class FunctionJit {
  public:
   // Returns an object containing a host-compiled version of the specified XLS
-  // function.
+  // function. If `profile_nodes` is true the compiled code is instrumented
+  // with per-node cycle counters; the accumulated profile is available via
+  // `jitted_function_base().GetNodeProfile()` after calls to Run.
   static absl::StatusOr<std::unique_ptr<FunctionJit>> Create(
       Function* xls_function, int64_t opt_level = 3,
-      JitObserver* observer = nullptr);
+      JitObserver* observer = nullptr, bool profile_nodes = false);
 
   // Returns the bytes of an object file containing the compiled XLS function.
   static absl::StatusOr<JitObjectCode> CreateObjectCode(
@@ -71,6 +75,29 @@ class FunctionJit {
   absl::StatusOr<InterpreterResult<Value>> Run(
       const absl::flat_hash_map<std::string, Value>& kwargs);
 
+  // Executes the compiled function once for each element of `args_batch` and
+  // returns the results in batch order. Semantically equivalent to calling
+  // Run() on each element, but argument validation is amortized across the
+  // batch and, if `worker_count` is greater than one, the batch is sharded
+  // across that many worker threads, each with its own argument/result/temp
+  // buffers. Useful for fuzzing and regression harnesses which run many
+  // samples through the same function.
+  absl::StatusOr<std::vector<InterpreterResult<Value>>> RunBatch(
+      absl::Span<const std::vector<Value>> args_batch,
+      int64_t worker_count = 1);
+
+  // Executes the compiled function and compares its result against `expected`
+  // directly on the raw output buffer: `expected` is blitted into a scratch
+  // buffer with the JIT's native result layout and the buffers are compared
+  // bytewise. Returns std::nullopt on a match; on a mismatch returns the
+  // actual result as a Value. Comparison harnesses, where nearly every run
+  // matches, avoid unpacking a Value per call this way. A bytewise difference
+  // falls back to unpacking and Value equality so unspecified padding bytes in
+  // the native layout can never manufacture a mismatch. Assertion failures are
+  // returned as errors (as with DropInterpreterEvents).
+  absl::StatusOr<std::optional<Value>> RunAndCompare(
+      absl::Span<const Value> args, const Value& expected);
+
   // Executes the compiled function with the arguments and results specified as
   // "views" - flat buffers onto which structures layouts can be applied (see
   // value_view.h).
@@ -204,7 +231,18 @@ class FunctionJit {
 
   static absl::StatusOr<std::unique_ptr<FunctionJit>> CreateInternal(
       Function* xls_function, int64_t opt_level, bool emit_object_code,
-      JitObserver* observer);
+      JitObserver* observer, bool profile_nodes = false);
+
+  // Validates that `args` matches the function's parameter count and types.
+  absl::Status ValidateArgs(absl::Span<const Value> args);
+
+  // Runs the jitted function on `args` (already validated against
+  // `param_types`) using the given buffers. Used by Run() with the member
+  // buffers and by RunBatch() workers with per-thread buffers.
+  absl::StatusOr<InterpreterResult<Value>> RunOnBuffers(
+      absl::Span<const Value> args, absl::Span<Type* const> param_types,
+      JitArgumentSet& arg_buffers, JitArgumentSet& result_buffers,
+      JitTempBuffer& temp_buffer);
 
   template <bool kForceZeroCopy, typename... ArgsT>
   absl::Status RunWithUnpackedViewsCommon(ArgsT... args) {
@@ -276,6 +314,9 @@ class FunctionJit {
   // Pre-allocated & aligned storage for required temporary storage. NB Not
   // thread safe.
   JitTempBuffer temp_buffer_;
+  // Scratch storage into which RunAndCompare() blits the expected value.
+  // Lazily sized on first use. Not thread safe.
+  std::vector<uint8_t> compare_buffer_;
 
   std::unique_ptr<JitRuntime> jit_runtime_;
 };
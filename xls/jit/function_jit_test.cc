@@ -230,6 +230,108 @@ TEST(FunctionJitTest, ReuseTest) {
               IsOkAndHolds(Value(UBits(7, 8))));
 }
 
+TEST(FunctionJitTest, RunBatch) {
+  Package package("my_package");
+  std::string ir_text = R"(
+  fn add_one(x: bits[32]) -> bits[32] {
+    literal.1: bits[32] = literal(value=1)
+    ret add.2: bits[32] = add(x, literal.1)
+  }
+  )";
+  XLS_ASSERT_OK_AND_ASSIGN(Function * function,
+                           Parser::ParseFunction(ir_text, &package));
+  XLS_ASSERT_OK_AND_ASSIGN(auto jit, FunctionJit::Create(function));
+
+  std::vector<std::vector<Value>> args_batch;
+  for (int64_t i = 0; i < 100; ++i) {
+    args_batch.push_back({Value(UBits(i, 32))});
+  }
+  // Both the serial and the sharded path must produce results in batch order.
+  for (int64_t worker_count : {1, 4}) {
+    XLS_ASSERT_OK_AND_ASSIGN(
+        std::vector<InterpreterResult<Value>> results,
+        jit->RunBatch(args_batch, worker_count));
+    ASSERT_EQ(results.size(), args_batch.size());
+    for (int64_t i = 0; i < results.size(); ++i) {
+      EXPECT_EQ(results[i].value, Value(UBits(i + 1, 32)));
+    }
+  }
+
+  // Malformed samples are rejected up front.
+  EXPECT_THAT(
+      jit->RunBatch({{Value(UBits(0, 8))}}, /*worker_count=*/1).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(FunctionJitTest, RunAndCompare) {
+  Package package("my_package");
+  std::string ir_text = R"(
+  fn add_one(x: bits[32]) -> bits[32] {
+    literal.1: bits[32] = literal(value=1)
+    ret add.2: bits[32] = add(x, literal.1)
+  }
+  )";
+  XLS_ASSERT_OK_AND_ASSIGN(Function * function,
+                           Parser::ParseFunction(ir_text, &package));
+  XLS_ASSERT_OK_AND_ASSIGN(auto jit, FunctionJit::Create(function));
+
+  // A matching run reports no mismatch (and materializes no result Value).
+  EXPECT_THAT(
+      jit->RunAndCompare({Value(UBits(41, 32))}, Value(UBits(42, 32))),
+      IsOkAndHolds(std::nullopt));
+
+  // A mismatching run returns the actual result.
+  EXPECT_THAT(jit->RunAndCompare({Value(UBits(41, 32))}, Value(UBits(7, 32))),
+              IsOkAndHolds(std::make_optional(Value(UBits(42, 32)))));
+
+  // The expected value must be of the function's return type.
+  EXPECT_THAT(
+      jit->RunAndCompare({Value(UBits(41, 32))}, Value(UBits(42, 8))).status(),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(FunctionJitTest, NodeProfile) {
+  Package package("my_package");
+  std::string ir_text = R"(
+  fn mul_add(a: bits[32], b: bits[32], c: bits[32]) -> bits[32] {
+    umul.4: bits[32] = umul(a, b, id=4)
+    ret add.5: bits[32] = add(umul.4, c, id=5)
+  }
+  )";
+  XLS_ASSERT_OK_AND_ASSIGN(Function * function,
+                           Parser::ParseFunction(ir_text, &package));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto jit, FunctionJit::Create(function, /*opt_level=*/3,
+                                    /*observer=*/nullptr,
+                                    /*profile_nodes=*/true));
+  ASSERT_TRUE(jit->jitted_function_base().HasNodeProfile());
+  EXPECT_TRUE(jit->jitted_function_base().GetNodeProfile().empty());
+
+  constexpr int64_t kRunCount = 3;
+  std::vector<Value> args = {Value(UBits(7, 32)), Value(UBits(3, 32)),
+                             Value(UBits(1, 32))};
+  for (int64_t i = 0; i < kRunCount; ++i) {
+    XLS_ASSERT_OK(jit->Run(args).status());
+  }
+
+  std::vector<NodeProfileRecord> records =
+      jit->jitted_function_base().GetNodeProfile();
+  // The computed nodes (umul and add) are instrumented; params are inputs and
+  // execute no node function.
+  ASSERT_EQ(records.size(), 2);
+  for (const NodeProfileRecord& record : records) {
+    EXPECT_EQ(record.invocations, kRunCount);
+  }
+  EXPECT_THAT(NodeProfileToString(records), HasSubstr("umul"));
+
+  jit->jitted_function_base().ClearNodeProfile();
+  EXPECT_TRUE(jit->jitted_function_base().GetNodeProfile().empty());
+
+  // A JIT built without profiling has no profile.
+  XLS_ASSERT_OK_AND_ASSIGN(auto unprofiled_jit, FunctionJit::Create(function));
+  EXPECT_FALSE(unprofiled_jit->jitted_function_base().HasNodeProfile());
+}
+
 TEST(FunctionJitTest, OneHotZeroBit) {
   Package package("my_package");
   std::string ir_text = R"(
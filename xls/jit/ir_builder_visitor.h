@@ -27,6 +27,7 @@
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
 #include "llvm/include/llvm/IR/Function.h"
+#include "llvm/include/llvm/IR/GlobalVariable.h"
 #include "llvm/include/llvm/IR/IRBuilder.h"
 #include "llvm/include/llvm/IR/Value.h"
 #include "xls/ir/elaboration.h"
@@ -109,6 +110,31 @@ class JitBuilderContext {
     return queue_indices_;
   }
 
+  // Enables per-node execution profiling. `counters` must be a module-level
+  // zero-initialized array of int64 with two consecutive slots (accumulated
+  // cycles, invocation count) for the node at each index in `node_indices`.
+  // The partition builders instrument each node function call site to update
+  // the node's slots.
+  void EnableNodeProfiling(llvm::GlobalVariable* counters,
+                           absl::flat_hash_map<Node*, int64_t> node_indices) {
+    profile_counters_ = counters;
+    profile_node_indices_ = std::move(node_indices);
+  }
+
+  // Returns the global counter array used for node profiling, or nullptr if
+  // profiling is not enabled.
+  llvm::GlobalVariable* profile_counters() const { return profile_counters_; }
+
+  // Returns the index of `node` in the profile counter array, or std::nullopt
+  // if the node is not profiled.
+  std::optional<int64_t> GetProfileIndex(Node* node) const {
+    auto it = profile_node_indices_.find(node);
+    if (it == profile_node_indices_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
  private:
   std::unique_ptr<llvm::Module> module_;
   OrcJit& orc_jit_;
@@ -119,6 +145,11 @@ class JitBuilderContext {
 
   // A map from channel name to queue index.
   absl::btree_map<std::string, int64_t> queue_indices_;
+
+  // Global counter array and node-to-index map for per-node execution
+  // profiling. Null/empty unless EnableNodeProfiling has been called.
+  llvm::GlobalVariable* profile_counters_ = nullptr;
+  absl::flat_hash_map<Node*, int64_t> profile_node_indices_;
 };
 
 // Abstraction representing an llvm::Function implementing an xls::Node. The
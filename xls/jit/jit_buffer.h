@@ -59,6 +59,12 @@ class JitArgumentSet {
   // The pointers to the values.
   absl::Span<uint8_t* const> pointers() const { return pointers_; }
 
+  // Repoints argument `index` at externally-owned memory. NB Should only be
+  // called by jit-code; the block-jit uses this to alias port buffers between
+  // continuations. The pointed-to memory must satisfy the size and alignment
+  // the source function requires for this argument and must outlive this set.
+  void SetPointer(int64_t index, uint8_t* ptr) { pointers_.at(index) = ptr; }
+
   // The raw pointer the jitted code receives.
   const uint8_t* const* get() const { return pointers_.data(); }
   uint8_t* const* get() { return pointers_.data(); }
@@ -124,6 +130,10 @@ class JitArgumentSet {
 
 // A wrapper for a temporary buffer which is aligned as required for the jitted
 // function.
+//
+// NB Argument/temp buffers are allocated once per FunctionJit, proc/block
+// continuation, or batch worker and then reused for every subsequent
+// Run/Tick/cycle, so steady-state execution performs no buffer allocation.
 class JitTempBuffer {
  public:
   explicit JitTempBuffer(const JittedFunctionBase* source, size_t align,
@@ -136,6 +146,12 @@ class JitTempBuffer {
  private:
   std::unique_ptr<uint8_t[], DeleteAligned> MakeBuffer(
       size_t align, size_t size) {
+    if (size == 0) {
+      // Functions without temporaries get a null buffer; malloc(0) is allowed
+      // to return either nullptr or a unique pointer so it cannot be
+      // distinguished from failure here anyway.
+      return nullptr;
+    }
     std::unique_ptr<uint8_t[], DeleteAligned> result(
         absl::bit_cast<uint8_t*>(AllocateAligned(align, size)));
     CHECK(result != nullptr) << "size: " << size << " align: " << align;
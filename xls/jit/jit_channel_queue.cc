@@ -15,6 +15,7 @@
 #include "xls/jit/jit_channel_queue.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -100,11 +101,63 @@ void ByteQueue::Resize() {
   }
 }
 
+SpscByteQueue::SpscByteQueue(int64_t channel_element_size, int64_t capacity)
+    : channel_element_size_(channel_element_size),
+      allocated_element_size_(
+          RoundUpToNearest(channel_element_size,
+                           static_cast<int64_t>(alignof(std::max_align_t)))) {
+  // Special case to handle empty tuples, as in ByteQueue.
+  if (allocated_element_size_ == 0) {
+    allocated_element_size_ = 1;
+  }
+  // A power-of-two capacity makes the ring index a simple mask of the
+  // monotonic element counter.
+  capacity_ = int64_t{1} << CeilOfLog2(std::max<int64_t>(capacity, 2));
+  buffer_.resize(capacity_ * allocated_element_size_);
+}
+
+int64_t SpscJitChannelQueue::GetSizeInternal() const {
+  return ring_.size() + overflow_.size();
+}
+
+void SpscJitChannelQueue::WriteInternal(Value value) {
+  // Mirrors WriteRaw: once any element has overflowed, later writes must also
+  // overflow to preserve FIFO order.
+  scratch_.resize(ring_.element_size());
+  jit_runtime_->BlitValueToBuffer(value, channel()->type(),
+                                  absl::MakeSpan(scratch_));
+  if (overflow_.size() == 0 && ring_.TryWrite(scratch_.data())) {
+    return;
+  }
+  overflow_.Write(scratch_.data());
+  overflow_size_.store(overflow_.size(), std::memory_order_release);
+}
+
+std::optional<Value> SpscJitChannelQueue::ReadInternal() {
+  scratch_.resize(ring_.element_size());
+  if (!ring_.TryRead(scratch_.data())) {
+    DrainOverflow();
+    if (!ring_.TryRead(scratch_.data())) {
+      return std::nullopt;
+    }
+  }
+  return jit_runtime_->UnpackBuffer(scratch_.data(), channel()->type());
+}
+
+void SpscJitChannelQueue::DrainOverflow() {
+  scratch_.resize(ring_.element_size());
+  while (overflow_.size() > 0 && ring_.size() < ring_.capacity()) {
+    CHECK(overflow_.Read(scratch_.data()));
+    CHECK(ring_.TryWrite(scratch_.data()));
+  }
+  overflow_size_.store(overflow_.size(), std::memory_order_release);
+}
+
 int64_t ThreadSafeJitChannelQueue::GetSizeInternal() const {
   return byte_queue_.size();
 }
 
-void ThreadSafeJitChannelQueue::WriteInternal(const Value& value) {
+void ThreadSafeJitChannelQueue::WriteInternal(Value value) {
   WriteValueOnQueue(value, channel()->type(), *jit_runtime_, byte_queue_);
 }
 
@@ -116,7 +169,7 @@ int64_t ThreadUnsafeJitChannelQueue::GetSizeInternal() const {
   return byte_queue_.size();
 }
 
-void ThreadUnsafeJitChannelQueue::WriteInternal(const Value& value) {
+void ThreadUnsafeJitChannelQueue::WriteInternal(Value value) {
   WriteValueOnQueue(value, channel()->type(), *jit_runtime_, byte_queue_);
 }
 
@@ -137,8 +190,16 @@ JitChannelQueueManager::CreateThreadSafe(ProcElaboration&& elaboration) {
                        JitRuntime::Create());
   std::vector<std::unique_ptr<ChannelQueue>> queues;
   for (ChannelInstance* channel_instance : elaboration.channel_instances()) {
-    queues.push_back(std::make_unique<ThreadSafeJitChannelQueue>(
-        channel_instance, runtime.get()));
+    if (channel_instance->channel->kind() == ChannelKind::kStreaming) {
+      // A streaming channel instance has exactly one sending and one
+      // receiving proc instance, so the lock-free single-producer/
+      // single-consumer queue applies.
+      queues.push_back(std::make_unique<SpscJitChannelQueue>(channel_instance,
+                                                             runtime.get()));
+    } else {
+      queues.push_back(std::make_unique<ThreadSafeJitChannelQueue>(
+          channel_instance, runtime.get()));
+    }
   }
   return absl::WrapUnique(new JitChannelQueueManager(
       std::move(elaboration), std::move(queues), std::move(runtime)));
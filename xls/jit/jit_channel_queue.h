@@ -14,6 +14,7 @@
 #ifndef XLS_JIT_JIT_CHANNEL_QUEUE_H_
 #define XLS_JIT_JIT_CHANNEL_QUEUE_H_
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -112,6 +113,73 @@ class ByteQueue {
   bool is_single_value_;
 };
 
+// A fixed-capacity lock-free byte queue supporting exactly one concurrent
+// producer and one concurrent consumer. Elements are fixed-size blocks of
+// `element_size` bytes stored in a power-of-two-sized ring buffer indexed by
+// monotonic head/tail counters.
+class SpscByteQueue {
+ public:
+  // `capacity` (number of elements) is rounded up to a power of two.
+  SpscByteQueue(int64_t channel_element_size, int64_t capacity);
+
+  int64_t element_size() const { return channel_element_size_; }
+
+  // Writes an element into the queue. Returns false if the queue is full. May
+  // be called by at most one thread at a time.
+  bool TryWrite(const uint8_t* data) {
+#ifdef ABSL_HAVE_MEMORY_SANITIZER
+    __msan_unpoison(data, channel_element_size_);
+#endif
+    int64_t tail = tail_.load(std::memory_order_relaxed);
+    int64_t head = head_.load(std::memory_order_acquire);
+    if (tail - head == capacity_) {
+      return false;
+    }
+    memcpy(slot(tail), data, channel_element_size_);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Reads an element from the queue. Returns false if the queue is empty. May
+  // be called by at most one thread at a time.
+  bool TryRead(uint8_t* buffer) {
+    int64_t head = head_.load(std::memory_order_relaxed);
+    int64_t tail = tail_.load(std::memory_order_acquire);
+    if (tail == head) {
+      return false;
+    }
+    memcpy(buffer, slot(head), channel_element_size_);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  int64_t size() const {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+  int64_t capacity() const { return capacity_; }
+
+ private:
+  uint8_t* slot(int64_t index) {
+    return buffer_.data() + (index & (capacity_ - 1)) * allocated_element_size_;
+  }
+
+  // Size of an element in the channel in units of bytes.
+  int64_t channel_element_size_;
+  // Allocated size of an element in the ring buffer in units of bytes. The
+  // elements are aligned to the largest scalar type.
+  int64_t allocated_element_size_;
+  // Number of elements the ring can hold. Always a power of two.
+  int64_t capacity_;
+  std::vector<uint8_t> buffer_;
+  // Monotonic element counters. The ring index is the counter modulo
+  // capacity. `head_` is written only by the consumer, `tail_` only by the
+  // producer.
+  std::atomic<int64_t> head_{0};
+  std::atomic<int64_t> tail_{0};
+};
+
 // Abstract base class for channel queues which may be used by the JIT. These
 // queues support reading and writing raw bytes to the queue rather the just
 // xls::Values.
@@ -125,6 +193,13 @@ class JitChannelQueue : public ChannelQueue {
   virtual bool ReadRaw(uint8_t* buffer) = 0;
 
  protected:
+  // JIT queues store raw bytes rather than Value elements so borrowing the
+  // front element in place is unsupported; ChannelQueue::ReadInPlace reports
+  // no value available and callers fall back to Read.
+  const Value* PeekInternal() ABSL_SHARED_LOCKS_REQUIRED(mutex_) override {
+    return nullptr;
+  }
+
   JitRuntime* jit_runtime_;
 };
 
@@ -153,7 +228,7 @@ class ThreadSafeJitChannelQueue : public JitChannelQueue {
     if (generator_.has_value()) {
       std::optional<Value> generated_value = (*generator_)();
       if (generated_value.has_value()) {
-        WriteInternal(generated_value.value());
+        WriteInternal(*std::move(generated_value));
       }
     }
     return byte_queue_.Read(buffer);
@@ -161,14 +236,85 @@ class ThreadSafeJitChannelQueue : public JitChannelQueue {
 
  protected:
   int64_t GetSizeInternal() const ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
-  void WriteInternal(const Value& value)
-      ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
+  void WriteInternal(Value value) ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
   std::optional<Value> ReadInternal()
       ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
 
   ByteQueue byte_queue_ ABSL_GUARDED_BY(mutex_);
 };
 
+// A thread-safe JIT channel queue for streaming channels with a single
+// producer and single consumer thread — which the proc elaboration proves
+// statically for streaming channel instances (each has exactly one sending
+// and one receiving proc instance). The common case (ring buffer neither full
+// nor empty) takes no lock; when the ring fills, writes overflow into a
+// mutex-guarded queue which the consumer drains back into the ring in FIFO
+// order, so the queue remains unbounded like the other variants.
+class SpscJitChannelQueue : public JitChannelQueue {
+ public:
+  SpscJitChannelQueue(ChannelInstance* channel_instance,
+                      JitRuntime* jit_runtime)
+      : JitChannelQueue(channel_instance, jit_runtime),
+        ring_(jit_runtime->GetTypeByteSize(channel_instance->channel->type()),
+              /*capacity=*/kRingCapacity),
+        overflow_(
+            jit_runtime->GetTypeByteSize(channel_instance->channel->type()),
+            /*is_single_value=*/false) {}
+  ~SpscJitChannelQueue() override = default;
+
+  void WriteRaw(const uint8_t* data) override {
+    // Once any element has overflowed, later writes must also overflow to
+    // preserve FIFO order. `overflow_size_` is only reset to zero after the
+    // consumer has moved the overflowed elements into the ring.
+    if (overflow_size_.load(std::memory_order_acquire) == 0 &&
+        ring_.TryWrite(data)) {
+      return;
+    }
+    absl::MutexLock lock(&mutex_);
+    overflow_.Write(data);
+    overflow_size_.store(overflow_.size(), std::memory_order_release);
+  }
+
+  bool ReadRaw(uint8_t* buffer) override {
+    if (ring_.TryRead(buffer)) {
+      return true;
+    }
+    // Ring is empty. The slow path pulls from the generator (if any) and
+    // moves any overflowed elements into the ring under the mutex.
+    absl::MutexLock lock(&mutex_);
+    if (generator_.has_value()) {
+      std::optional<Value> generated_value = (*generator_)();
+      if (generated_value.has_value()) {
+        WriteInternal(*std::move(generated_value));
+      }
+    }
+    DrainOverflow();
+    return ring_.TryRead(buffer);
+  }
+
+ protected:
+  int64_t GetSizeInternal() const ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
+  void WriteInternal(Value value) ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
+  std::optional<Value> ReadInternal()
+      ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
+
+ private:
+  static constexpr int64_t kRingCapacity = 128;
+
+  // Moves as many overflowed elements as fit into the ring, in FIFO order,
+  // and updates overflow_size_.
+  void DrainOverflow() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  SpscByteQueue ring_;
+  ByteQueue overflow_ ABSL_GUARDED_BY(mutex_);
+  // Mirror of overflow_.size() readable without the mutex. Only reset to zero
+  // after the consumer has moved the overflowed elements into the ring.
+  std::atomic<int64_t> overflow_size_{0};
+  // Scratch space for moving elements between the overflow queue, the ring
+  // and Value objects.
+  std::vector<uint8_t> scratch_ ABSL_GUARDED_BY(mutex_);
+};
+
 // A thread-unsafe version of the JIT channel queue.
 class ThreadUnsafeJitChannelQueue : public JitChannelQueue {
  public:
@@ -185,7 +331,7 @@ class ThreadUnsafeJitChannelQueue : public JitChannelQueue {
     if (generator_.has_value()) {
       std::optional<Value> generated_value = (*generator_)();
       if (generated_value.has_value()) {
-        WriteInternal(generated_value.value());
+        WriteInternal(*std::move(generated_value));
       }
     }
     return byte_queue_.Read(buffer);
@@ -193,7 +339,7 @@ class ThreadUnsafeJitChannelQueue : public JitChannelQueue {
 
  protected:
   int64_t GetSizeInternal() const ABSL_SHARED_LOCKS_REQUIRED(mutex_) override;
-  void WriteInternal(const Value& value) override;
+  void WriteInternal(Value value) override;
   std::optional<Value> ReadInternal() override;
 
   ByteQueue byte_queue_;
@@ -18,6 +18,7 @@
 #include <cstring>
 #include <memory>
 #include <optional>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -66,7 +67,8 @@ template <typename QueueT>
 class JitChannelQueueTest : public ::testing::Test {};
 
 using QueueTypes =
-    ::testing::Types<ThreadSafeJitChannelQueue, ThreadUnsafeJitChannelQueue>;
+    ::testing::Types<ThreadSafeJitChannelQueue, SpscJitChannelQueue,
+                     ThreadUnsafeJitChannelQueue>;
 TYPED_TEST_SUITE(JitChannelQueueTest, QueueTypes);
 
 // An empty tuple represents a zero width.
@@ -179,5 +181,67 @@ TYPED_TEST(JitChannelQueueTest, IotaGeneratorWithRawApi) {
                                  "a generator function")));
 }
 
+// Writing more elements than the SPSC ring holds must spill into the overflow
+// queue and still come back out in FIFO order.
+TEST(SpscJitChannelQueueTest, FifoOrderAcrossOverflow) {
+  Package package("test");
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * channel,
+      package.CreateStreamingChannel("my_channel", ChannelOps::kSendReceive,
+                                     package.GetBitsType(32)));
+  XLS_ASSERT_OK_AND_ASSIGN(ProcElaboration elaboration,
+                           ProcElaboration::ElaborateOldStylePackage(&package));
+
+  SpscJitChannelQueue queue(elaboration.GetUniqueInstance(channel).value(),
+                            GetJitRuntime());
+
+  constexpr uint32_t kElementCount = 1000;
+  std::vector<uint8_t> buffer(4);
+  for (uint32_t i = 0; i < kElementCount; i++) {
+    memcpy(buffer.data(), &i, 4);
+    queue.WriteRaw(buffer.data());
+  }
+  EXPECT_EQ(queue.GetSize(), kElementCount);
+  for (uint32_t i = 0; i < kElementCount; i++) {
+    EXPECT_TRUE(queue.ReadRaw(buffer.data()));
+    uint32_t result;
+    memcpy(&result, buffer.data(), 4);
+    EXPECT_EQ(result, i);
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(SpscJitChannelQueueTest, ConcurrentProducerConsumer) {
+  Package package("test");
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * channel,
+      package.CreateStreamingChannel("my_channel", ChannelOps::kSendReceive,
+                                     package.GetBitsType(32)));
+  XLS_ASSERT_OK_AND_ASSIGN(ProcElaboration elaboration,
+                           ProcElaboration::ElaborateOldStylePackage(&package));
+
+  SpscJitChannelQueue queue(elaboration.GetUniqueInstance(channel).value(),
+                            GetJitRuntime());
+
+  constexpr uint32_t kElementCount = 100000;
+  std::thread producer([&]() {
+    std::vector<uint8_t> send_buffer(4);
+    for (uint32_t i = 0; i < kElementCount; i++) {
+      memcpy(send_buffer.data(), &i, 4);
+      queue.WriteRaw(send_buffer.data());
+    }
+  });
+  std::vector<uint8_t> recv_buffer(4);
+  for (uint32_t i = 0; i < kElementCount; i++) {
+    while (!queue.ReadRaw(recv_buffer.data())) {
+    }
+    uint32_t result;
+    memcpy(&result, recv_buffer.data(), 4);
+    ASSERT_EQ(result, i);
+  }
+  producer.join();
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
 }  // namespace
 }  // namespace xls
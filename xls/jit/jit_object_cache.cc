@@ -0,0 +1,171 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/jit/jit_object_cache.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>  // NOLINT
+#include <utility>
+
+#include "absl/log/log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "llvm/include/llvm/ADT/StringExtras.h"
+#include "llvm/include/llvm/ADT/StringRef.h"
+#include "llvm/include/llvm/IR/Metadata.h"
+#include "llvm/include/llvm/IR/Module.h"
+#include "llvm/include/llvm/Support/Casting.h"
+#include "llvm/include/llvm/Support/MemoryBuffer.h"
+#include "llvm/include/llvm/Support/SHA256.h"
+#include "llvm/include/llvm/Support/raw_ostream.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/status/status_macros.h"
+
+namespace xls {
+namespace {
+
+// Name of the module-level metadata node carrying the cache key.
+constexpr std::string_view kCacheKeyMetadataName = "xls.jit.object_cache_key";
+
+}  // namespace
+
+/* static */ absl::StatusOr<std::unique_ptr<OrcJitObjectCache>>
+OrcJitObjectCache::Create(const std::filesystem::path& cache_dir) {
+  XLS_RETURN_IF_ERROR(RecursivelyCreateDir(cache_dir));
+  return absl::WrapUnique(new OrcJitObjectCache(cache_dir));
+}
+
+/* static */ std::string OrcJitObjectCache::ComputeKey(
+    const llvm::Module& module, int64_t opt_level,
+    std::string_view target_description) {
+  std::string ir;
+  llvm::raw_string_ostream ostream(ir);
+  module.print(ostream, nullptr);
+  ostream.flush();
+  llvm::SHA256 hasher;
+  hasher.update(llvm::StringRef(ir));
+  std::string suffix = absl::StrCat(":", opt_level, ":", target_description);
+  hasher.update(llvm::StringRef(suffix));
+  auto digest = hasher.final();
+  return llvm::toHex(llvm::ArrayRef<uint8_t>(digest.data(), digest.size()),
+                     /*LowerCase=*/true);
+}
+
+bool OrcJitObjectCache::Contains(std::string_view key) const {
+  return FileExists(EntryPath(key)).ok();
+}
+
+void OrcJitObjectCache::notifyObjectCompiled(const llvm::Module* module,
+                                             llvm::MemoryBufferRef object) {
+  std::optional<std::string> key = GetModuleCacheKey(*module);
+  if (!key.has_value()) {
+    return;
+  }
+  // Write to a process-unique temporary file then rename into place so
+  // concurrent processes sharing the cache directory never read a partially
+  // written object.
+  std::filesystem::path entry_path = EntryPath(*key);
+  std::filesystem::path temp_path =
+      entry_path.string() + absl::StrCat(".tmp.", getpid());
+  absl::Status write_status = SetFileContents(
+      temp_path, std::string_view(object.getBufferStart(),
+                                  object.getBufferSize()));
+  if (!write_status.ok()) {
+    LOG(WARNING) << "Failed to write JIT object cache entry " << entry_path
+                 << ": " << write_status;
+    return;
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, entry_path, ec);
+  if (ec) {
+    LOG(WARNING) << "Failed to commit JIT object cache entry " << entry_path
+                 << ": " << ec.message();
+    std::filesystem::remove(temp_path, ec);
+  }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> OrcJitObjectCache::getObject(
+    const llvm::Module* module) {
+  std::optional<std::string> key = GetModuleCacheKey(*module);
+  if (!key.has_value()) {
+    return nullptr;
+  }
+  absl::StatusOr<std::string> contents = GetFileContents(EntryPath(*key));
+  if (!contents.ok()) {
+    miss_count_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  hit_count_.fetch_add(1, std::memory_order_relaxed);
+  return llvm::MemoryBuffer::getMemBufferCopy(*contents,
+                                              module->getModuleIdentifier());
+}
+
+std::filesystem::path OrcJitObjectCache::EntryPath(
+    std::string_view key) const {
+  return cache_dir_ / absl::StrCat(key, ".o");
+}
+
+void SetModuleCacheKey(llvm::Module& module, std::string_view key) {
+  llvm::NamedMDNode* md =
+      module.getOrInsertNamedMetadata(kCacheKeyMetadataName);
+  md->clearOperands();
+  md->addOperand(llvm::MDNode::get(
+      module.getContext(),
+      {llvm::MDString::get(module.getContext(),
+                           llvm::StringRef(key.data(), key.size()))}));
+}
+
+std::optional<std::string> GetModuleCacheKey(const llvm::Module& module) {
+  llvm::NamedMDNode* md = module.getNamedMetadata(kCacheKeyMetadataName);
+  if (md == nullptr || md->getNumOperands() == 0 ||
+      md->getOperand(0)->getNumOperands() == 0) {
+    return std::nullopt;
+  }
+  auto* str = llvm::dyn_cast<llvm::MDString>(md->getOperand(0)->getOperand(0));
+  if (str == nullptr) {
+    return std::nullopt;
+  }
+  return str->getString().str();
+}
+
+OrcJitObjectCache* GetDefaultOrcJitObjectCache() {
+  static OrcJitObjectCache* default_cache = []() -> OrcJitObjectCache* {
+    const char* cache_dir = getenv("XLS_JIT_OBJECT_CACHE_DIR");
+    if (cache_dir == nullptr || *cache_dir == '\0') {
+      return nullptr;
+    }
+    absl::StatusOr<std::unique_ptr<OrcJitObjectCache>> cache =
+        OrcJitObjectCache::Create(cache_dir);
+    if (!cache.ok()) {
+      LOG(WARNING) << "Failed to create JIT object cache in " << cache_dir
+                   << ": " << cache.status();
+      return nullptr;
+    }
+    return cache->release();
+  }();
+  return default_cache;
+}
+
+}  // namespace xls
@@ -0,0 +1,104 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_JIT_JIT_OBJECT_CACHE_H_
+#define XLS_JIT_JIT_OBJECT_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "absl/status/statusor.h"
+#include "llvm/include/llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/include/llvm/IR/Module.h"
+#include "llvm/include/llvm/Support/MemoryBuffer.h"
+
+namespace xls {
+
+// An llvm::ObjectCache which persists compiled object buffers in a
+// content-addressed on-disk directory. Entries are keyed by a hash of the
+// unoptimized LLVM IR together with the optimization level and target
+// description, so a process which JITs an unchanged function loads the object
+// code written by an earlier run instead of re-running LLVM optimization and
+// code generation. The key is computed by OrcJit before compilation and
+// carried on the module as named metadata (see SetModuleCacheKey below).
+//
+// Cache writes are best-effort: entries are written to a temporary file and
+// atomically renamed into place so concurrent processes sharing a cache
+// directory never observe partial objects.
+class OrcJitObjectCache : public llvm::ObjectCache {
+ public:
+  // Creates a cache rooted at `cache_dir`. The directory (and any missing
+  // parents) is created if it does not exist.
+  static absl::StatusOr<std::unique_ptr<OrcJitObjectCache>> Create(
+      const std::filesystem::path& cache_dir);
+
+  // Computes the content-addressed key for `module`: a hash of the printed
+  // module IR, the optimization level, and a description of the compilation
+  // target (triple, CPU, features, sanitizer configuration).
+  static std::string ComputeKey(const llvm::Module& module, int64_t opt_level,
+                                std::string_view target_description);
+
+  // Returns whether an entry with the given key is present on disk.
+  bool Contains(std::string_view key) const;
+
+  // llvm::ObjectCache interface. Both methods key off the metadata set by
+  // SetModuleCacheKey and are no-ops for modules without a key.
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef object) override;
+  std::unique_ptr<llvm::MemoryBuffer> getObject(
+      const llvm::Module* module) override;
+
+  const std::filesystem::path& cache_dir() const { return cache_dir_; }
+
+  // Number of lookups which were served from (missed) the on-disk cache.
+  int64_t hit_count() const {
+    return hit_count_.load(std::memory_order_relaxed);
+  }
+  int64_t miss_count() const {
+    return miss_count_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  explicit OrcJitObjectCache(std::filesystem::path cache_dir)
+      : cache_dir_(std::move(cache_dir)) {}
+
+  std::filesystem::path EntryPath(std::string_view key) const;
+
+  std::filesystem::path cache_dir_;
+  std::atomic<int64_t> hit_count_{0};
+  std::atomic<int64_t> miss_count_{0};
+};
+
+// Attaches the cache key for `module` as named metadata on the module so it
+// survives the optimization pipeline and is visible to the object cache at
+// compile time.
+void SetModuleCacheKey(llvm::Module& module, std::string_view key);
+
+// Returns the cache key attached to `module`, or std::nullopt if none was set.
+std::optional<std::string> GetModuleCacheKey(const llvm::Module& module);
+
+// Returns the process-wide default object cache configured via the
+// XLS_JIT_OBJECT_CACHE_DIR environment variable, or nullptr if the variable is
+// unset or the cache could not be created. The cache is created on first use
+// and shared by all OrcJit instances in the process.
+OrcJitObjectCache* GetDefaultOrcJitObjectCache();
+
+}  // namespace xls
+
+#endif  // XLS_JIT_JIT_OBJECT_CACHE_H_
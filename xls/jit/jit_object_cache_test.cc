@@ -0,0 +1,114 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/jit/jit_object_cache.h"
+
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <optional>
+
+#include "gtest/gtest.h"
+#include "absl/status/statusor.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/package.h"
+#include "xls/jit/function_base_jit.h"
+#include "xls/jit/orc_jit.h"
+
+namespace xls {
+namespace {
+
+class JitObjectCacheTest : public IrTestBase {
+ protected:
+  absl::StatusOr<Function*> BuildAddOneFunction(Package* package) {
+    FunctionBuilder fb("add_one", package);
+    BValue x = fb.Param("x", package->GetBitsType(32));
+    return fb.BuildWithReturnValue(fb.Add(x, fb.Literal(UBits(1, 32))));
+  }
+};
+
+TEST_F(JitObjectCacheTest, ObjectsArePersistedAndReused) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<OrcJitObjectCache> cache,
+                           OrcJitObjectCache::Create(temp_dir.path()));
+
+  // The first compilation misses the cache and populates it.
+  {
+    std::unique_ptr<Package> package = CreatePackage();
+    XLS_ASSERT_OK_AND_ASSIGN(Function * f,
+                             BuildAddOneFunction(package.get()));
+    XLS_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<OrcJit> jit,
+        OrcJit::Create(OrcJit::kDefaultOptLevel, /*emit_object_code=*/false,
+                       /*emit_msan=*/std::nullopt, /*observer=*/nullptr,
+                       cache.get()));
+    XLS_ASSERT_OK(JittedFunctionBase::Build(f, *jit).status());
+    EXPECT_EQ(cache->hit_count(), 0);
+    EXPECT_GT(cache->miss_count(), 0);
+  }
+
+  // Compiling an identical function in a fresh package and JIT instance is
+  // served from the on-disk cache.
+  {
+    std::unique_ptr<Package> package = CreatePackage();
+    XLS_ASSERT_OK_AND_ASSIGN(Function * f,
+                             BuildAddOneFunction(package.get()));
+    XLS_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<OrcJit> jit,
+        OrcJit::Create(OrcJit::kDefaultOptLevel, /*emit_object_code=*/false,
+                       /*emit_msan=*/std::nullopt, /*observer=*/nullptr,
+                       cache.get()));
+    XLS_ASSERT_OK(JittedFunctionBase::Build(f, *jit).status());
+    EXPECT_GT(cache->hit_count(), 0);
+  }
+
+  // The cache directory holds at least one object file.
+  bool found_entry = false;
+  for (const auto& entry :
+       std::filesystem::directory_iterator(cache->cache_dir())) {
+    found_entry |= entry.path().extension() == ".o";
+  }
+  EXPECT_TRUE(found_entry);
+}
+
+TEST_F(JitObjectCacheTest, DifferentOptLevelsUseDifferentKeys) {
+  std::unique_ptr<Package> package = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, BuildAddOneFunction(package.get()));
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<OrcJitObjectCache> cache,
+                           OrcJitObjectCache::Create(temp_dir.path()));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<OrcJit> o3_jit,
+      OrcJit::Create(/*opt_level=*/3, /*emit_object_code=*/false,
+                     /*emit_msan=*/std::nullopt, /*observer=*/nullptr,
+                     cache.get()));
+  XLS_ASSERT_OK(JittedFunctionBase::Build(f, *o3_jit).status());
+
+  // The same function at a different opt level must not hit the O3 entries.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<OrcJit> o0_jit,
+      OrcJit::Create(/*opt_level=*/0, /*emit_object_code=*/false,
+                     /*emit_msan=*/std::nullopt, /*observer=*/nullptr,
+                     cache.get()));
+  XLS_ASSERT_OK(JittedFunctionBase::Build(f, *o0_jit).status());
+  EXPECT_EQ(cache->hit_count(), 0);
+}
+
+}  // namespace
+}  // namespace xls
@@ -14,11 +14,18 @@
 
 #include "xls/jit/jit_proc_runtime.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/interpreter/channel_queue.h"
 #include "xls/interpreter/proc_evaluator.h"
@@ -27,29 +34,19 @@
 #include "xls/ir/package.h"
 #include "xls/ir/proc.h"
 #include "xls/ir/value.h"
+#include "xls/jit/aot_entrypoint.pb.h"
+#include "xls/jit/function_base_jit.h"
 #include "xls/jit/jit_channel_queue.h"
 #include "xls/jit/proc_jit.h"
 
 namespace xls {
 namespace {
 
-absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateRuntime(
-    ProcElaboration elaboration) {
-  // Create a queue manager for the queues. This factory verifies that there an
-  // receive only queue for every receive only channel.
-  XLS_ASSIGN_OR_RETURN(
-      std::unique_ptr<JitChannelQueueManager> queue_manager,
-      JitChannelQueueManager::CreateThreadSafe(std::move(elaboration)));
-
-  // Create a ProcJit for each Proc.
-  std::vector<std::unique_ptr<ProcEvaluator>> proc_jits;
-  for (Proc* proc : queue_manager->elaboration().procs()) {
-    XLS_ASSIGN_OR_RETURN(
-        std::unique_ptr<ProcJit> proc_jit,
-        ProcJit::Create(proc, &queue_manager->runtime(), queue_manager.get()));
-    proc_jits.push_back(std::move(proc_jit));
-  }
-
+// Assembles a SerialProcRuntime from the given evaluators and injects channel
+// initial values.
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateRuntimeFromJits(
+    std::vector<std::unique_ptr<ProcEvaluator>> proc_jits,
+    std::unique_ptr<JitChannelQueueManager> queue_manager) {
   // Create a runtime.
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<SerialProcRuntime> proc_runtime,
                        SerialProcRuntime::Create(std::move(proc_jits),
@@ -69,6 +66,99 @@ absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateRuntime(
   return std::move(proc_runtime);
 }
 
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateRuntime(
+    ProcElaboration elaboration) {
+  // Create a queue manager for the queues. This factory verifies that there an
+  // receive only queue for every receive only channel.
+  XLS_ASSIGN_OR_RETURN(
+      std::unique_ptr<JitChannelQueueManager> queue_manager,
+      JitChannelQueueManager::CreateThreadSafe(std::move(elaboration)));
+
+  // Create a ProcJit for each Proc. Each ProcJit owns a private OrcJit (and
+  // LLVM context), so the expensive LLVM optimization and code generation for
+  // different procs can run concurrently; only the XLS IR and the elaboration
+  // are shared and those are only read.
+  absl::Span<Proc* const> procs = queue_manager->elaboration().procs();
+  std::vector<absl::StatusOr<std::unique_ptr<ProcJit>>> proc_jit_results(
+      procs.size());
+  auto create_proc_jit = [&](int64_t index) {
+    proc_jit_results[index] = ProcJit::Create(
+        procs[index], &queue_manager->runtime(), queue_manager.get());
+  };
+  int64_t num_procs = static_cast<int64_t>(procs.size());
+  int64_t num_workers = std::min<int64_t>(
+      std::max<int64_t>(std::thread::hardware_concurrency(), 1), num_procs);
+  if (num_workers <= 1) {
+    for (int64_t i = 0; i < num_procs; ++i) {
+      create_proc_jit(i);
+    }
+  } else {
+    // The JIT builder interns a handful of types in the package when
+    // translating trace ops. Create them up front so no worker thread mutates
+    // the package's type tables.
+    Package* package = procs.front()->package();
+    package->GetBitsType(1);
+    package->GetTokenType();
+
+    std::atomic<int64_t> next_index = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(num_workers);
+    for (int64_t i = 0; i < num_workers; ++i) {
+      workers.push_back(std::thread([&]() {
+        int64_t index;
+        while ((index = next_index.fetch_add(1)) < num_procs) {
+          create_proc_jit(index);
+        }
+      }));
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+
+  std::vector<std::unique_ptr<ProcEvaluator>> proc_jits;
+  for (absl::StatusOr<std::unique_ptr<ProcJit>>& result : proc_jit_results) {
+    XLS_ASSIGN_OR_RETURN(std::unique_ptr<ProcJit> proc_jit, std::move(result));
+    proc_jits.push_back(std::move(proc_jit));
+  }
+
+  return CreateRuntimeFromJits(std::move(proc_jits), std::move(queue_manager));
+}
+
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateAotRuntime(
+    ProcElaboration elaboration, const AotPackageEntrypointsProto& entrypoints,
+    absl::Span<const ProcAotEntrypoints> impls) {
+  XLS_ASSIGN_OR_RETURN(
+      std::unique_ptr<JitChannelQueueManager> queue_manager,
+      JitChannelQueueManager::CreateThreadSafe(std::move(elaboration)));
+
+  // Pair each proc with its compiled ABI description and entrypoint symbol.
+  // No LLVM work happens here; construction cost is just buffer setup.
+  std::vector<std::unique_ptr<ProcEvaluator>> proc_jits;
+  for (Proc* proc : queue_manager->elaboration().procs()) {
+    auto abi_it = absl::c_find_if(
+        entrypoints.entrypoints(), [&](const AotEntrypointProto& entrypoint) {
+          return entrypoint.xls_function_identifier() == proc->name();
+        });
+    XLS_RET_CHECK(abi_it != entrypoints.entrypoints().end())
+        << "No AOT entrypoint provided for proc: " << proc->name();
+    auto impl_it =
+        absl::c_find_if(impls, [&](const ProcAotEntrypoints& impl) {
+          return impl.proc_id == proc->name();
+        });
+    XLS_RET_CHECK(impl_it != impls.end())
+        << "No AOT symbol provided for proc: " << proc->name();
+    XLS_ASSIGN_OR_RETURN(
+        std::unique_ptr<ProcJit> proc_jit,
+        ProcJit::CreateFromAot(proc, &queue_manager->runtime(),
+                               queue_manager.get(), *abi_it,
+                               impl_it->unpacked));
+    proc_jits.push_back(std::move(proc_jit));
+  }
+
+  return CreateRuntimeFromJits(std::move(proc_jits), std::move(queue_manager));
+}
+
 }  // namespace
 
 absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateJitSerialProcRuntime(
@@ -85,4 +175,20 @@ absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateJitSerialProcRuntime(
   return CreateRuntime(std::move(elaboration));
 }
 
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateAotSerialProcRuntime(
+    Package* package, const AotPackageEntrypointsProto& entrypoints,
+    absl::Span<const ProcAotEntrypoints> impls) {
+  XLS_ASSIGN_OR_RETURN(ProcElaboration elaboration,
+                       ProcElaboration::ElaborateOldStylePackage(package));
+  return CreateAotRuntime(std::move(elaboration), entrypoints, impls);
+}
+
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateAotSerialProcRuntime(
+    Proc* top, const AotPackageEntrypointsProto& entrypoints,
+    absl::Span<const ProcAotEntrypoints> impls) {
+  XLS_ASSIGN_OR_RETURN(ProcElaboration elaboration,
+                       ProcElaboration::Elaborate(top));
+  return CreateAotRuntime(std::move(elaboration), entrypoints, impls);
+}
+
 }  // namespace xls
@@ -16,10 +16,14 @@
 #define XLS_JIT_JIT_PROC_RUNTIME_H_
 
 #include <memory>
+#include <string>
 
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "xls/interpreter/serial_proc_runtime.h"
 #include "xls/ir/package.h"
+#include "xls/jit/aot_entrypoint.pb.h"
+#include "xls/jit/function_base_jit.h"
 
 namespace xls {
 
@@ -33,6 +37,30 @@ absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateJitSerialProcRuntime(
 absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateJitSerialProcRuntime(
     Proc* top);
 
+// The in-process symbol for one AOT-compiled proc, pairing the proc's
+// identifier (AotEntrypointProto.xls_function_identifier) with the pointer to
+// its compiled entrypoint, typically linked in from an object file emitted by
+// the aot_compiler tool.
+struct ProcAotEntrypoints {
+  std::string proc_id;
+  JitFunctionType unpacked;
+};
+
+// Create a SerialProcRuntime backed by previously AOT-compiled proc
+// implementations; no in-process LLVM compilation (and hence no JIT warmup)
+// occurs. `entrypoints` describes the ABI of the compiled procs and `impls`
+// must contain an entry for every proc in `package`. Supports old-style
+// procs.
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateAotSerialProcRuntime(
+    Package* package, const AotPackageEntrypointsProto& entrypoints,
+    absl::Span<const ProcAotEntrypoints> impls);
+
+// As above but constructed from the elaboration of the given proc. Supports
+// new-style procs.
+absl::StatusOr<std::unique_ptr<SerialProcRuntime>> CreateAotSerialProcRuntime(
+    Proc* top, const AotPackageEntrypointsProto& entrypoints,
+    absl::Span<const ProcAotEntrypoints> impls);
+
 }  // namespace xls
 
 #endif  // XLS_JIT_JIT_PROC_RUNTIME_H_
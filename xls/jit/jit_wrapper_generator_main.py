@@ -124,6 +124,10 @@ class XlsNamedValue:
   def specialized_arg(self):
     return f"{self.specialized_type} {self.name}"
 
+  @property
+  def camel_name(self):
+    return camelize(self.name)
+
 
 class JitType(enum.Enum):
   FUNCTION = 1
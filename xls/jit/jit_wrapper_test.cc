@@ -15,6 +15,7 @@
 #include <array>
 #include <bit>
 #include <cstdint>
+#include <cstring>
 #include <optional>
 #include <string_view>
 
@@ -85,6 +86,21 @@ TEST(JitWrapperTest, PackedFunctionCall) {
   EXPECT_EQ(fv, 3.14f);
 }
 
+TEST(JitWrapperTest, PackedViewStorageCall) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto jit, fp::F32ToF64::Create());
+  // The generated storage aliases size their buffers at compile time.
+  static_assert(fp::F32ToF64::FStorage::kByteCount == sizeof(float));
+  static_assert(fp::F32ToF64::ResultStorage::kByteCount == sizeof(double));
+  fp::F32ToF64::FStorage f;
+  fp::F32ToF64::ResultStorage result;
+  float fv = 3.14f;
+  std::memcpy(f.mutable_buffer(), &fv, sizeof(fv));
+  XLS_ASSERT_OK(jit->Run(f.view(), result.view()));
+  double dv;
+  std::memcpy(&dv, result.buffer(), sizeof(dv));
+  EXPECT_EQ(dv, static_cast<double>(3.14f));
+}
+
 TEST(JitWrapperTest, PackedFunctionCall2) {
   XLS_ASSERT_OK_AND_ASSIGN(auto jit, fp::Float32Mul::Create());
   float lv = 3.14f;
@@ -36,7 +36,13 @@ struct JitObserverRequests {
   bool assembly_code_str = false;
 };
 
-// Basic observer for JIT compilation events
+// Basic observer for JIT compilation events.
+//
+// Note this observes *compilation* only (module creation and codegen); there
+// is no runtime per-node evaluation hook in the jitted code. Any future
+// runtime observation support should be designed with sampling/filtering
+// compiled in from the start, since an unconditional per-node callback makes
+// observed runs orders of magnitude slower.
 class JitObserver {
  public:
   virtual ~JitObserver() = default;
@@ -69,6 +69,7 @@
 #include "xls/common/logging/log_lines.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/jit/jit_object_cache.h"
 #include "xls/jit/observer.h"
 
 namespace xls {
@@ -136,6 +137,19 @@ llvm::Expected<llvm::orc::ThreadSafeModule> OrcJit::Optimizer(
     const llvm::orc::MaterializationResponsibility& responsibility) {
   llvm::Module* bare_module = module.getModuleUnlocked();
 
+  // If the object cache already holds the compiled object for this module
+  // there is no point running the optimization pipeline; the compile layer
+  // will serve the object straight from the cache.
+  if (object_cache_ != nullptr) {
+    std::optional<std::string> key = GetModuleCacheKey(*bare_module);
+    if (key.has_value() && object_cache_->Contains(*key)) {
+      VLOG(2) << "Skipping optimization of module `"
+              << bare_module->getModuleIdentifier()
+              << "`: object cache hit for key " << *key;
+      return module;
+    }
+  }
+
   VLOG(2) << "Unoptimized module IR:";
   XLS_VLOG_LINES(2, DumpLlvmModuleToString(bare_module));
   if (jit_observer_ != nullptr &&
@@ -225,7 +239,7 @@ llvm::Expected<llvm::orc::ThreadSafeModule> OrcJit::Optimizer(
 
 absl::StatusOr<std::unique_ptr<OrcJit>> OrcJit::Create(
     int64_t opt_level, bool emit_object_code, std::optional<bool> emit_msan,
-    JitObserver* observer) {
+    JitObserver* observer, OrcJitObjectCache* object_cache) {
   absl::call_once(once, OnceInit);
 #ifdef ABSL_HAVE_MEMORY_SANITIZER
   constexpr bool kHasMsan = true;
@@ -235,6 +249,13 @@ absl::StatusOr<std::unique_ptr<OrcJit>> OrcJit::Create(
   std::unique_ptr<OrcJit> jit = absl::WrapUnique(
       new OrcJit(opt_level, emit_object_code, emit_msan.value_or(kHasMsan)));
   jit->SetJitObserver(observer);
+  // The object-code path (AOT) runs code generation itself in
+  // `object_code_layer_` so a cache hit would skip producing the very output
+  // it exists for. Only enable the cache for pure JIT use.
+  if (!emit_object_code) {
+    jit->object_cache_ = object_cache == nullptr ? GetDefaultOrcJitObjectCache()
+                                                 : object_cache;
+  }
   XLS_RETURN_IF_ERROR(jit->Init());
   return std::move(jit);
 }
@@ -395,7 +416,8 @@ absl::Status OrcJit::Init() {
             data_layout_.getGlobalPrefix())));
   });
 
-  auto compiler = std::make_unique<llvm::orc::SimpleCompiler>(*target_machine_);
+  auto compiler = std::make_unique<llvm::orc::SimpleCompiler>(*target_machine_,
+                                                              object_cache_);
   compile_layer_ = std::make_unique<llvm::orc::IRCompileLayer>(
       execution_session_, object_layer_, std::move(compiler));
 
@@ -484,6 +506,18 @@ absl::Status VerifyModule(const llvm::Module& module) {
 
 absl::Status OrcJit::CompileModule(std::unique_ptr<llvm::Module>&& module) {
   XLS_RETURN_IF_ERROR(VerifyModule(*module));
+  if (object_cache_ != nullptr) {
+    // Key the cache entry on everything which affects the generated object:
+    // the unoptimized IR, the optimization level, and the compilation target
+    // configuration.
+    std::string target_description = absl::StrFormat(
+        "%s:%s:%s:msan=%d",
+        target_machine_->getTargetTriple().getTriple(),
+        target_machine_->getTargetCPU().str(),
+        target_machine_->getTargetFeatureString().str(), include_msan_);
+    SetModuleCacheKey(*module, OrcJitObjectCache::ComputeKey(
+                                   *module, opt_level_, target_description));
+  }
   llvm::Error error = transform_layer_->add(
       dylib_, llvm::orc::ThreadSafeModule(std::move(module), context_));
   if (error) {
@@ -34,6 +34,7 @@
 #include "llvm/include/llvm/Support/Error.h"
 #include "llvm/include/llvm/Support/raw_ostream.h"
 #include "llvm/include/llvm/Target/TargetMachine.h"
+#include "xls/jit/jit_object_cache.h"
 #include "xls/jit/observer.h"
 
 namespace xls {
@@ -59,10 +60,14 @@ class OrcJit {
   // control whether asan calls should be included. Users other than the AOT
   // compiler should use the 3-argument version above. Passing nullopt to
   // emit_msan directs the jit to use MSAN if the running binary is MSAN and
-  // vice-versa.
+  // vice-versa. If `object_cache` is null the process-wide default cache (see
+  // GetDefaultOrcJitObjectCache) is used, if configured; the cache is never
+  // used when emitting object code since the AOT path must run code
+  // generation itself.
   static absl::StatusOr<std::unique_ptr<OrcJit>> Create(
       int64_t opt_level, bool emit_object_code, std::optional<bool> emit_msan,
-      JitObserver* observer = nullptr);
+      JitObserver* observer = nullptr,
+      OrcJitObjectCache* object_cache = nullptr);
 
   void SetJitObserver(JitObserver* o) { jit_observer_ = o; }
 
@@ -130,6 +135,10 @@ class OrcJit {
 
   JitObserver* jit_observer_ = nullptr;
 
+  // If set, compiled objects are persisted to (and served from) this
+  // content-addressed on-disk cache. Not owned.
+  OrcJitObjectCache* object_cache_ = nullptr;
+
   // If the jitted code should include msan calls. Defaults to whatever 'this'
   // process is doing and should only be overridden for AOT generators.
   bool include_msan_;
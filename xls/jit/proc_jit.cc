@@ -97,6 +97,25 @@ class ProcJitContinuation : public ProcContinuation {
 
   InstanceContext* instance_context() { return &instance_context_; }
 
+  // The queue and channel instance of the receive this continuation is
+  // blocked on, or nullptr if the continuation is not blocked on a receive.
+  // Used by ProcJit::Tick to skip invoking the jitted function entirely while
+  // the queue remains empty; in that situation no node beyond the blocking
+  // receive can execute so re-entering the compiled code is a no-op.
+  JitChannelQueue* blocked_queue() const { return blocked_queue_; }
+  ChannelInstance* blocked_channel_instance() const {
+    return blocked_channel_instance_;
+  }
+  void SetBlockedOnReceive(JitChannelQueue* queue,
+                           ChannelInstance* channel_instance) {
+    blocked_queue_ = queue;
+    blocked_channel_instance_ = channel_instance;
+  }
+  void ClearBlockedOnReceive() {
+    blocked_queue_ = nullptr;
+    blocked_channel_instance_ = nullptr;
+  }
+
  private:
   int64_t continuation_point_;
   JitRuntime* jit_runtime_;
@@ -112,6 +131,10 @@ class ProcJitContinuation : public ProcContinuation {
   // Data structure passed to the JIT function which holds instance related
   // information.
   InstanceContext instance_context_;
+
+  // Set while the continuation is blocked on a receive with an empty queue.
+  JitChannelQueue* blocked_queue_ = nullptr;
+  ChannelInstance* blocked_channel_instance_ = nullptr;
 };
 
 ProcJitContinuation::ProcJitContinuation(ProcInstance* proc_instance,
@@ -207,30 +230,46 @@ static absl::StatusOr<ChannelInstance*> GetChannelInstance(
 
 absl::StatusOr<std::unique_ptr<ProcJit>> ProcJit::Create(
     Proc* proc, JitRuntime* jit_runtime, JitChannelQueueManager* queue_mgr,
-    JitObserver* observer) {
+    JitObserver* observer, bool profile_nodes) {
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<OrcJit> orc_jit, OrcJit::Create());
   orc_jit->SetJitObserver(observer);
   auto jit = absl::WrapUnique(
       new ProcJit(proc, jit_runtime, queue_mgr, std::move(orc_jit)));
+  XLS_ASSIGN_OR_RETURN(
+      jit->jitted_function_base_,
+      JittedFunctionBase::Build(proc, jit->GetOrcJit(), profile_nodes));
+  XLS_RET_CHECK(jit->jitted_function_base_.InputsAndOutputsAreEquivalent());
+  XLS_RETURN_IF_ERROR(jit->InitializeChannelQueues());
+  return jit;
+}
+
+absl::StatusOr<std::unique_ptr<ProcJit>> ProcJit::CreateFromAot(
+    Proc* proc, JitRuntime* jit_runtime, JitChannelQueueManager* queue_mgr,
+    const AotEntrypointProto& abi, JitFunctionType unpacked) {
+  auto jit = absl::WrapUnique(
+      new ProcJit(proc, jit_runtime, queue_mgr, /*orc_jit=*/nullptr));
   XLS_ASSIGN_OR_RETURN(jit->jitted_function_base_,
-                       JittedFunctionBase::Build(proc, jit->GetOrcJit()));
+                       JittedFunctionBase::BuildFromAot(proc, abi, unpacked));
   XLS_RET_CHECK(jit->jitted_function_base_.InputsAndOutputsAreEquivalent());
+  XLS_RETURN_IF_ERROR(jit->InitializeChannelQueues());
+  return jit;
+}
 
+absl::Status ProcJit::InitializeChannelQueues() {
   for (ProcInstance* proc_instance :
-       queue_mgr->elaboration().GetInstances(proc)) {
-    jit->channel_queues_[proc_instance].resize(
-        jit->jitted_function_base_.queue_indices().size());
+       queue_mgr_->elaboration().GetInstances(proc())) {
+    channel_queues_[proc_instance].resize(
+        jitted_function_base_.queue_indices().size());
     for (const auto& [channel_name, index] :
-         jit->jitted_function_base_.queue_indices()) {
+         jitted_function_base_.queue_indices()) {
       XLS_ASSIGN_OR_RETURN(
           ChannelInstance * channel_instance,
-          GetChannelInstance(proc_instance, channel_name, queue_mgr));
-      jit->channel_queues_[proc_instance][index] =
-          &queue_mgr->GetJitQueue(channel_instance);
+          GetChannelInstance(proc_instance, channel_name, queue_mgr_));
+      channel_queues_[proc_instance][index] =
+          &queue_mgr_->GetJitQueue(channel_instance);
     }
   }
-
-  return jit;
+  return absl::OkStatus();
 }
 
 std::unique_ptr<ProcContinuation> ProcJit::NewContinuation(
@@ -247,6 +286,20 @@ absl::StatusOr<TickResult> ProcJit::Tick(ProcContinuation& continuation) const {
       << "ProcJit requires a continuation of type ProcJitContinuation";
   int64_t start_continuation_point = cont->GetContinuationPoint();
 
+  // Fast path: the previous tick blocked on a receive and no data has arrived
+  // on its channel since. The jitted function would execute no nodes and exit
+  // at the same continuation point, so skip invoking it altogether. Queues
+  // with an attached generator are excluded: a generator materializes values
+  // only when the receive executes, so such a queue may report empty yet
+  // produce a value once re-polled.
+  if (cont->blocked_queue() != nullptr && cont->blocked_queue()->IsEmpty() &&
+      !cont->blocked_queue()->has_generator()) {
+    return TickResult{.execution_state = TickExecutionState::kBlockedOnReceive,
+                      .channel_instance = cont->blocked_channel_instance(),
+                      .progress_made = false};
+  }
+  cont->ClearBlockedOnReceive();
+
   // The jitted function returns the early exit point at which execution
   // halted. A return value of zero indicates that the tick completed.
   int64_t next_continuation_point = jitted_function_base_.RunJittedFunction(
@@ -287,6 +340,13 @@ absl::StatusOr<TickResult> ProcJit::Tick(ProcContinuation& continuation) const {
       GetChannelInstance(continuation.proc_instance(),
                          early_exit_node->As<Receive>()->channel_name(),
                          queue_mgr_));
+  // Record the blocking queue so subsequent ticks can avoid re-entering the
+  // jitted function until data arrives on the channel.
+  int64_t queue_index = jitted_function_base_.queue_indices().at(
+      early_exit_node->As<Receive>()->channel_name());
+  cont->SetBlockedOnReceive(
+      cont->instance_context()->channel_queues.at(queue_index),
+      channel_instance);
   return TickResult{
       .execution_state = TickExecutionState::kBlockedOnReceive,
       .channel_instance = channel_instance,
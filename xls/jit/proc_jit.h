@@ -27,6 +27,7 @@
 #include "xls/ir/events.h"
 #include "xls/ir/proc.h"
 #include "xls/ir/value.h"
+#include "xls/jit/aot_entrypoint.pb.h"
 #include "xls/jit/function_base_jit.h"
 #include "xls/jit/ir_builder_visitor.h"
 #include "xls/jit/jit_buffer.h"
@@ -42,10 +43,21 @@ namespace xls {
 class ProcJit : public ProcEvaluator {
  public:
   // Returns an object containing a host-compiled version of the specified XLS
-  // proc.
+  // proc. If `profile_nodes` is true the compiled code is instrumented with
+  // per-node cycle counters; the accumulated profile is available via
+  // `jitted_function_base().GetNodeProfile()` after ticks.
   static absl::StatusOr<std::unique_ptr<ProcJit>> Create(
       Proc* proc, JitRuntime* jit_runtime, JitChannelQueueManager* queue_mgr,
-      JitObserver* observer = nullptr);
+      JitObserver* observer = nullptr, bool profile_nodes = false);
+
+  // Returns an object wrapping a previously AOT-compiled version of the
+  // specified XLS proc. `unpacked` must be the entrypoint symbol described by
+  // `abi` (typically linked into the binary from an object file emitted by
+  // the aot_compiler tool). No in-process LLVM compilation is performed, so
+  // the returned ProcJit has no OrcJit and GetOrcJit() may not be called.
+  static absl::StatusOr<std::unique_ptr<ProcJit>> CreateFromAot(
+      Proc* proc, JitRuntime* jit_runtime, JitChannelQueueManager* queue_mgr,
+      const AotEntrypointProto& abi, JitFunctionType unpacked);
 
   ~ProcJit() override = default;
 
@@ -58,6 +70,10 @@ class ProcJit : public ProcEvaluator {
 
   OrcJit& GetOrcJit() { return *orc_jit_; }
 
+  const JittedFunctionBase& jitted_function_base() const {
+    return jitted_function_base_;
+  }
+
  private:
   explicit ProcJit(Proc* proc, JitRuntime* jit_runtime,
                    JitChannelQueueManager* queue_mgr,
@@ -67,6 +83,10 @@ class ProcJit : public ProcEvaluator {
         queue_mgr_(queue_mgr),
         orc_jit_(std::move(orc_jit)) {}
 
+  // Populates `channel_queues_` for every instance of the proc using the
+  // queue indices baked into `jitted_function_base_`.
+  absl::Status InitializeChannelQueues();
+
   JitRuntime* jit_runtime_;
   JitChannelQueueManager* queue_mgr_;
   std::unique_ptr<OrcJit> orc_jit_;
@@ -15,14 +15,23 @@
 #include "xls/jit/proc_jit.h"
 
 #include <memory>
+#include <optional>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/log/check.h"
+#include "xls/common/status/matchers.h"
 #include "xls/interpreter/channel_queue.h"
 #include "xls/interpreter/proc_evaluator.h"
 #include "xls/interpreter/proc_evaluator_test_base.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/channel.h"
+#include "xls/ir/channel_ops.h"
+#include "xls/ir/function_builder.h"
 #include "xls/ir/package.h"
 #include "xls/ir/proc.h"
+#include "xls/ir/type.h"
+#include "xls/ir/value.h"
 #include "xls/jit/jit_channel_queue.h"
 #include "xls/jit/jit_runtime.h"
 #include "xls/jit/orc_jit.h"
@@ -30,6 +39,9 @@
 namespace xls {
 namespace {
 
+using status_testing::IsOkAndHolds;
+using ::testing::Optional;
+
 JitRuntime* GetJitRuntime() {
   static auto jit_runtime = std::make_unique<JitRuntime>(
       OrcJit::CreateDataLayout(/*aot_specification=*/false).value());
@@ -52,5 +64,132 @@ INSTANTIATE_TEST_SUITE_P(
           return JitChannelQueueManager::CreateThreadSafe(package).value();
         })));
 
+// Ticking a continuation blocked on a receive whose queue is still empty
+// should report no progress without disturbing the continuation; once data
+// arrives the tick resumes at the blocked receive and completes normally.
+TEST(ProcJitTest, BlockedTicksMakeNoProgressUntilDataArrives) {
+  Package package("blocked_tick_test");
+  Type* u32 = package.GetBitsType(32);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * ch_in,
+      package.CreateStreamingChannel("in", ChannelOps::kReceiveOnly, u32));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * ch_out,
+      package.CreateStreamingChannel("out", ChannelOps::kSendOnly, u32));
+
+  TokenlessProcBuilder pb("passthrough", "tkn", &package);
+  pb.Send(ch_out, pb.Receive(ch_in));
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build({}));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<JitChannelQueueManager> queue_manager,
+      JitChannelQueueManager::CreateThreadSafe(&package));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<ProcJit> jit,
+      ProcJit::Create(proc, GetJitRuntime(), queue_manager.get()));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      ChannelInstance * ch_in_instance,
+      queue_manager->elaboration().GetUniqueInstance(ch_in));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      ChannelInstance * ch_out_instance,
+      queue_manager->elaboration().GetUniqueInstance(ch_out));
+
+  std::unique_ptr<ProcContinuation> continuation = jit->NewContinuation(
+      queue_manager->elaboration().GetUniqueInstance(proc).value());
+
+  // The first tick executes up to the receive and blocks.
+  EXPECT_THAT(jit->Tick(*continuation),
+              IsOkAndHolds(TickResult{
+                  .execution_state = TickExecutionState::kBlockedOnReceive,
+                  .channel_instance = ch_in_instance,
+                  .progress_made = true}));
+
+  // Subsequent ticks with an empty queue make no progress.
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_THAT(jit->Tick(*continuation),
+                IsOkAndHolds(TickResult{
+                    .execution_state = TickExecutionState::kBlockedOnReceive,
+                    .channel_instance = ch_in_instance,
+                    .progress_made = false}));
+    EXPECT_FALSE(continuation->AtStartOfTick());
+  }
+
+  // Once data arrives execution resumes at the blocked receive.
+  XLS_ASSERT_OK(queue_manager->GetQueue(ch_in).Write(Value(UBits(42, 32))));
+  EXPECT_THAT(jit->Tick(*continuation),
+              IsOkAndHolds(TickResult{
+                  .execution_state = TickExecutionState::kSentOnChannel,
+                  .channel_instance = ch_out_instance,
+                  .progress_made = true}));
+  EXPECT_THAT(
+      jit->Tick(*continuation),
+      IsOkAndHolds(TickResult{.execution_state = TickExecutionState::kCompleted,
+                              .channel_instance = std::nullopt,
+                              .progress_made = true}));
+  EXPECT_THAT(queue_manager->GetQueue(ch_out).Read(),
+              Optional(Value(UBits(42, 32))));
+}
+
+// A queue generator materializes values only when the blocked receive
+// executes, so attaching one must disable the blocked-tick fast path: the
+// queue still reports empty, but the next tick has to re-enter the jitted
+// code and poll the generator.
+TEST(ProcJitTest, BlockedTickPollsQueueGenerator) {
+  Package package("blocked_generator_test");
+  Type* u32 = package.GetBitsType(32);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * ch_in,
+      package.CreateStreamingChannel("in", ChannelOps::kReceiveOnly, u32));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * ch_out,
+      package.CreateStreamingChannel("out", ChannelOps::kSendOnly, u32));
+
+  TokenlessProcBuilder pb("passthrough", "tkn", &package);
+  pb.Send(ch_out, pb.Receive(ch_in));
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build({}));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<JitChannelQueueManager> queue_manager,
+      JitChannelQueueManager::CreateThreadSafe(&package));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<ProcJit> jit,
+      ProcJit::Create(proc, GetJitRuntime(), queue_manager.get()));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      ChannelInstance * ch_in_instance,
+      queue_manager->elaboration().GetUniqueInstance(ch_in));
+
+  std::unique_ptr<ProcContinuation> continuation = jit->NewContinuation(
+      queue_manager->elaboration().GetUniqueInstance(proc).value());
+
+  // Block on the empty input queue, then attach a generator which produces a
+  // value on its second poll.
+  EXPECT_THAT(jit->Tick(*continuation),
+              IsOkAndHolds(TickResult{
+                  .execution_state = TickExecutionState::kBlockedOnReceive,
+                  .channel_instance = ch_in_instance,
+                  .progress_made = true}));
+  int polls = 0;
+  XLS_ASSERT_OK(queue_manager->GetQueue(ch_in).AttachGenerator(
+      [&polls]() -> std::optional<Value> {
+        if (++polls < 2) {
+          return std::nullopt;
+        }
+        return Value(UBits(123, 32));
+      }));
+
+  // The first tick re-enters the jitted code, polls the generator, and
+  // remains blocked; the second receives the generated value and completes.
+  EXPECT_THAT(jit->Tick(*continuation),
+              IsOkAndHolds(TickResult{
+                  .execution_state = TickExecutionState::kBlockedOnReceive,
+                  .channel_instance = ch_in_instance,
+                  .progress_made = false}));
+  EXPECT_EQ(polls, 1);
+  XLS_ASSERT_OK(jit->Tick(*continuation).status());
+  EXPECT_EQ(polls, 2);
+  EXPECT_THAT(queue_manager->GetQueue(ch_out).Read(),
+              Optional(Value(UBits(123, 32))));
+}
+
 }  // namespace
 }  // namespace xls
@@ -0,0 +1,131 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/jit/random_stimulus.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/types/span.h"
+#include "xls/ir/type.h"
+#include "xls/jit/type_layout.h"
+
+namespace xls {
+namespace {
+
+// Philox 4x32 round constants (Salmon et al., "Parallel random numbers: as
+// easy as 1, 2, 3").
+constexpr uint32_t kPhiloxM0 = 0xD2511F53;
+constexpr uint32_t kPhiloxM1 = 0xCD9E8D57;
+constexpr uint32_t kPhiloxW0 = 0x9E3779B9;
+constexpr uint32_t kPhiloxW1 = 0xBB67AE85;
+constexpr int kPhiloxRounds = 10;
+
+// Appends the bit count of every leaf element of `type` to `leaf_bit_counts`
+// in linear leaf order (tokens count as zero-width leaves).
+void CollectLeafBitCounts(Type* type, std::vector<int64_t>* leaf_bit_counts) {
+  if (type->IsBits()) {
+    leaf_bit_counts->push_back(type->AsBitsOrDie()->bit_count());
+    return;
+  }
+  if (type->IsToken()) {
+    leaf_bit_counts->push_back(0);
+    return;
+  }
+  if (type->IsTuple()) {
+    TupleType* tuple_type = type->AsTupleOrDie();
+    for (int64_t i = 0; i < tuple_type->size(); ++i) {
+      CollectLeafBitCounts(tuple_type->element_type(i), leaf_bit_counts);
+    }
+    return;
+  }
+  CHECK(type->IsArray());
+  ArrayType* array_type = type->AsArrayOrDie();
+  for (int64_t i = 0; i < array_type->size(); ++i) {
+    CollectLeafBitCounts(array_type->element_type(), leaf_bit_counts);
+  }
+}
+
+}  // namespace
+
+RandomStimulusGenerator::RandomStimulusGenerator(const TypeLayout* layout,
+                                                 uint64_t seed)
+    : layout_(layout),
+      key_({static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}) {
+  leaf_bit_counts_.reserve(layout->elements().size());
+  CollectLeafBitCounts(layout->type(), &leaf_bit_counts_);
+  CHECK_EQ(leaf_bit_counts_.size(), layout->elements().size());
+}
+
+std::array<uint32_t, 4> RandomStimulusGenerator::NextBlock() {
+  std::array<uint32_t, 4> x = {static_cast<uint32_t>(counter_),
+                               static_cast<uint32_t>(counter_ >> 32), 0, 0};
+  ++counter_;
+  std::array<uint32_t, 2> key = key_;
+  for (int round = 0; round < kPhiloxRounds; ++round) {
+    uint64_t product0 = static_cast<uint64_t>(kPhiloxM0) * x[0];
+    uint64_t product1 = static_cast<uint64_t>(kPhiloxM1) * x[2];
+    x = {static_cast<uint32_t>(product1 >> 32) ^ x[1] ^ key[0],
+         static_cast<uint32_t>(product1),
+         static_cast<uint32_t>(product0 >> 32) ^ x[3] ^ key[1],
+         static_cast<uint32_t>(product0)};
+    key[0] += kPhiloxW0;
+    key[1] += kPhiloxW1;
+  }
+  return x;
+}
+
+uint8_t RandomStimulusGenerator::NextByte() {
+  if (block_pos_ == static_cast<int64_t>(block_.size())) {
+    std::array<uint32_t, 4> block = NextBlock();
+    std::memcpy(block_.data(), block.data(), block_.size());
+    block_pos_ = 0;
+  }
+  return block_[block_pos_++];
+}
+
+void RandomStimulusGenerator::Fill(absl::Span<uint8_t> buffer) {
+  CHECK_GE(static_cast<int64_t>(buffer.size()), layout_->size());
+  std::memset(buffer.data(), 0, layout_->size());
+  for (int64_t i = 0; i < static_cast<int64_t>(layout_->elements().size());
+       ++i) {
+    const ElementLayout& element = layout_->elements()[i];
+    uint8_t* data = buffer.data() + element.offset;
+    int64_t remaining_bits = leaf_bit_counts_[i];
+    // Data bytes are least-significant first; bits beyond the leaf's bit
+    // count (and all padding bytes) must be zero in the native layout.
+    for (int64_t j = 0; j < element.data_size && remaining_bits > 0; ++j) {
+      if (remaining_bits >= 8) {
+        data[j] = NextByte();
+        remaining_bits -= 8;
+      } else {
+        data[j] = NextByte() & ((uint8_t{1} << remaining_bits) - 1);
+        remaining_bits = 0;
+      }
+    }
+  }
+}
+
+void RandomStimulusGenerator::FillBatch(absl::Span<uint8_t> buffer,
+                                        int64_t count) {
+  CHECK_GE(static_cast<int64_t>(buffer.size()), count * layout_->size());
+  for (int64_t i = 0; i < count; ++i) {
+    Fill(buffer.subspan(i * layout_->size(), layout_->size()));
+  }
+}
+
+}  // namespace xls
@@ -0,0 +1,77 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_JIT_RANDOM_STIMULUS_H_
+#define XLS_JIT_RANDOM_STIMULUS_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "xls/jit/type_layout.h"
+
+namespace xls {
+
+// Generator of uniformly random stimulus written directly in the native data
+// layout described by a TypeLayout -- the representation consumed by jitted
+// code -- bypassing Value construction entirely. Use this instead of
+// `RandomValue` plus `TypeLayout::ValueToNativeLayout` when producing bulk
+// stimulus (e.g. Monte Carlo runs); per-value cost is a handful of Philox
+// rounds and stores rather than a Value tree allocation per aggregate.
+//
+// The generator is counter-based (Philox 4x32-10): every 16-byte block of
+// random data is a pure function of (seed, block counter), so a stream is
+// reproducible from its seed alone and independent generators with distinct
+// seeds can fill batches in parallel. Padding bytes and bits beyond each
+// leaf's bit count are zeroed as the native layout requires.
+class RandomStimulusGenerator {
+ public:
+  // `layout` must outlive the generator.
+  RandomStimulusGenerator(const TypeLayout* layout, uint64_t seed);
+
+  // Fills `buffer` with one random value of the layout's type. `buffer` must
+  // hold at least `layout().size()` bytes; bytes beyond that are untouched.
+  void Fill(absl::Span<uint8_t> buffer);
+
+  // Fills `buffer` with `count` random values packed back to back, each
+  // occupying `layout().size()` bytes.
+  void FillBatch(absl::Span<uint8_t> buffer, int64_t count);
+
+  const TypeLayout& layout() const { return *layout_; }
+
+ private:
+  // Produces the next 16-byte block of the Philox stream.
+  std::array<uint32_t, 4> NextBlock();
+
+  // Returns the next byte of the random stream, refilling the block buffer
+  // as needed.
+  uint8_t NextByte();
+
+  const TypeLayout* layout_;
+  std::array<uint32_t, 2> key_;
+  // Block counter; advanced once per generated block.
+  uint64_t counter_ = 0;
+
+  // Unconsumed bytes of the most recently generated block.
+  std::array<uint8_t, 16> block_;
+  int64_t block_pos_ = 16;
+
+  // Bit count of each leaf element of layout_->type(), in linear leaf order.
+  std::vector<int64_t> leaf_bit_counts_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_JIT_RANDOM_STIMULUS_H_
@@ -0,0 +1,122 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/jit/random_stimulus.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/types/span.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/type.h"
+#include "xls/ir/value.h"
+#include "xls/jit/llvm_type_converter.h"
+#include "xls/jit/orc_jit.h"
+#include "xls/jit/type_layout.h"
+
+namespace xls {
+namespace {
+
+using ::testing::Ne;
+
+class RandomStimulusTest : public IrTestBase {
+ protected:
+  TypeLayout CreateTypeLayout(Type* type) {
+    std::unique_ptr<OrcJit> orc_jit = OrcJit::Create().value();
+    LlvmTypeConverter type_converter(
+        orc_jit->GetContext(),
+        orc_jit->CreateDataLayout(/*aot_specification=*/false).value());
+    return type_converter.CreateTypeLayout(type);
+  }
+};
+
+TEST_F(RandomStimulusTest, StreamIsDeterministicInSeed) {
+  auto p = CreatePackage();
+  Type* type = p->GetBitsType(128);
+  TypeLayout layout = CreateTypeLayout(type);
+
+  RandomStimulusGenerator gen_a(&layout, /*seed=*/42);
+  RandomStimulusGenerator gen_b(&layout, /*seed=*/42);
+  RandomStimulusGenerator gen_c(&layout, /*seed=*/43);
+  std::vector<uint8_t> buffer_a(layout.size());
+  std::vector<uint8_t> buffer_b(layout.size());
+  std::vector<uint8_t> buffer_c(layout.size());
+  gen_a.Fill(absl::MakeSpan(buffer_a));
+  gen_b.Fill(absl::MakeSpan(buffer_b));
+  gen_c.Fill(absl::MakeSpan(buffer_c));
+
+  EXPECT_EQ(buffer_a, buffer_b);
+  EXPECT_THAT(buffer_c, Ne(buffer_a));
+}
+
+TEST_F(RandomStimulusTest, GeneratedBuffersAreValidNativeLayout) {
+  auto p = CreatePackage();
+  // Mixed aggregate with padded leaves and a non-byte-aligned bit count.
+  Type* type = p->GetTupleType(
+      {p->GetBitsType(42),
+       p->GetArrayType(3, p->GetBitsType(17)),
+       p->GetTupleType({p->GetBitsType(1), p->GetBitsType(64)})});
+  TypeLayout layout = CreateTypeLayout(type);
+
+  RandomStimulusGenerator gen(&layout, /*seed=*/7);
+  std::vector<uint8_t> buffer(layout.size());
+  for (int64_t i = 0; i < 100; ++i) {
+    gen.Fill(absl::MakeSpan(buffer));
+    // Round-tripping through Value is the identity exactly when all padding
+    // bytes and bits beyond each leaf's bit count are zero.
+    Value value = layout.NativeLayoutToValue(buffer.data());
+    std::vector<uint8_t> round_trip(layout.size());
+    layout.ValueToNativeLayout(value, round_trip.data());
+    ASSERT_EQ(buffer, round_trip) << "iteration " << i;
+  }
+}
+
+TEST_F(RandomStimulusTest, BatchMatchesSequentialFills) {
+  auto p = CreatePackage();
+  Type* type = p->GetArrayType(4, p->GetBitsType(20));
+  TypeLayout layout = CreateTypeLayout(type);
+  constexpr int64_t kCount = 16;
+
+  RandomStimulusGenerator batch_gen(&layout, /*seed=*/99);
+  std::vector<uint8_t> batch(kCount * layout.size());
+  batch_gen.FillBatch(absl::MakeSpan(batch), kCount);
+
+  RandomStimulusGenerator sequential_gen(&layout, /*seed=*/99);
+  std::vector<uint8_t> sequential(kCount * layout.size());
+  for (int64_t i = 0; i < kCount; ++i) {
+    sequential_gen.Fill(
+        absl::MakeSpan(sequential).subspan(i * layout.size(), layout.size()));
+  }
+
+  EXPECT_EQ(batch, sequential);
+}
+
+TEST_F(RandomStimulusTest, ValuesVaryAcrossFills) {
+  auto p = CreatePackage();
+  Type* type = p->GetBitsType(64);
+  TypeLayout layout = CreateTypeLayout(type);
+
+  RandomStimulusGenerator gen(&layout, /*seed=*/1);
+  std::vector<uint8_t> first(layout.size());
+  std::vector<uint8_t> second(layout.size());
+  gen.Fill(absl::MakeSpan(first));
+  gen.Fill(absl::MakeSpan(second));
+  EXPECT_THAT(second, Ne(first));
+}
+
+}  // namespace
+}  // namespace xls
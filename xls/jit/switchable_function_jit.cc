@@ -14,6 +14,7 @@
 
 #include "xls/jit/switchable_function_jit.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -25,6 +26,7 @@
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
+#include "xls/common/thread.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/interpreter/ir_interpreter.h"
 #include "xls/ir/events.h"
@@ -63,6 +65,19 @@ SwitchableFunctionJit::CreateInterpreter(Function* xls_function) {
       new SwitchableFunctionJit(xls_function, /*use_jit=*/false, nullptr));
 }
 
+absl::StatusOr<std::unique_ptr<SwitchableFunctionJit>>
+SwitchableFunctionJit::CreateAdaptive(Function* xls_function, int64_t opt_level,
+                                      JitObserver* observer,
+                                      const AdaptiveOptions& adaptive_options) {
+  auto result = std::unique_ptr<SwitchableFunctionJit>(
+      new SwitchableFunctionJit(xls_function, /*use_jit=*/false, nullptr));
+  result->adaptive_ = true;
+  result->opt_level_ = opt_level;
+  result->adaptive_options_ = adaptive_options;
+  result->observer_ = observer;
+  return result;
+}
+
 absl::StatusOr<std::unique_ptr<SwitchableFunctionJit>>
 SwitchableFunctionJit::Create(Function* xls_function, ExecutionType execution,
                               int64_t opt_level, JitObserver* observer) {
@@ -77,11 +92,75 @@ SwitchableFunctionJit::Create(Function* xls_function, ExecutionType execution,
     case ExecutionType::kJit:
       return SwitchableFunctionJit::CreateJit(xls_function, opt_level,
                                               observer);
+    case ExecutionType::kAdaptive:
+#if EMERGENCY_FORCE_INTERPRETER == 1
+      // With the JIT disabled there is nothing to tier up to.
+      return SwitchableFunctionJit::CreateInterpreter(xls_function);
+#else
+      return SwitchableFunctionJit::CreateAdaptive(xls_function, opt_level,
+                                                   observer);
+#endif
     case ExecutionType::kDefault:
       LOG(FATAL) << "Unreachable";
   }
 }
 
+SwitchableFunctionJit::~SwitchableFunctionJit() {
+  if (compile_thread_ != nullptr) {
+    compile_thread_->Join();
+  }
+}
+
+void SwitchableFunctionJit::MaybeTierUp() {
+  if (compile_thread_ == nullptr) {
+    int64_t threshold = use_jit_ ? adaptive_options_.recompile_threshold
+                                 : adaptive_options_.jit_threshold;
+    if (++invocation_count_ < threshold) {
+      return;
+    }
+    // Pick the opt level for this compile. The first compile of a large
+    // function uses level 0 (LLVM's O0 pipeline with fast instruction
+    // selection) so compiled code is available quickly; the requested level
+    // is applied by a later recompile if the function keeps running.
+    int64_t compile_opt_level = opt_level_;
+    if (!use_jit_) {
+      if (adaptive_options_.first_compile_opt_level.has_value()) {
+        compile_opt_level = *adaptive_options_.first_compile_opt_level;
+      } else if (opt_level_ > 0 &&
+                 xls_function_->node_count() >=
+                     adaptive_options_.large_function_node_count) {
+        compile_opt_level = 0;
+      }
+    }
+    pending_opt_level_ = compile_opt_level;
+    compile_thread_ = std::make_unique<Thread>([this, compile_opt_level] {
+      background_jit_ =
+          FunctionJit::Create(xls_function_, compile_opt_level, observer_);
+      background_jit_ready_.store(true, std::memory_order_release);
+    });
+    return;
+  }
+  if (!background_jit_ready_.load(std::memory_order_acquire)) {
+    return;
+  }
+  compile_thread_->Join();
+  compile_thread_.reset();
+  background_jit_ready_.store(false, std::memory_order_relaxed);
+  if (!background_jit_.ok()) {
+    LOG(WARNING) << "Background JIT compilation of "
+                 << xls_function_->name()
+                 << " failed; staying with the current implementation: "
+                 << background_jit_.status();
+    adaptive_ = false;
+    return;
+  }
+  function_jit_ = std::move(background_jit_).value();
+  use_jit_ = true;
+  // Keep tiering until code at the requested opt level is installed.
+  adaptive_ = pending_opt_level_ < opt_level_;
+  invocation_count_ = 0;
+}
+
 namespace {
 absl::StatusOr<absl::flat_hash_map<Node*, Value>> ToValueMap(
     absl::Span<const Value> args, Function* f) {
@@ -129,6 +208,9 @@ absl::StatusOr<InterpreterResult<Value>> Interpret(
 
 absl::StatusOr<InterpreterResult<Value>> SwitchableFunctionJit::Run(
     absl::Span<const Value> args) {
+  if (adaptive_) {
+    MaybeTierUp();
+  }
   if (use_jit_) {
     return function_jit_->Run(args);
   }
@@ -138,6 +220,9 @@ absl::StatusOr<InterpreterResult<Value>> SwitchableFunctionJit::Run(
 
 absl::StatusOr<InterpreterResult<Value>> SwitchableFunctionJit::Run(
     const absl::flat_hash_map<std::string, Value>& kwargs) {
+  if (adaptive_) {
+    MaybeTierUp();
+  }
   if (use_jit_) {
     return function_jit_->Run(kwargs);
   }
@@ -15,6 +15,7 @@
 #ifndef XLS_JIT_SWITCHABLE_FUNCTION_JIT_H_
 #define XLS_JIT_SWITCHABLE_FUNCTION_JIT_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -24,6 +25,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "xls/common/thread.h"
 #include "xls/ir/events.h"
 #include "xls/ir/function.h"
 #include "xls/ir/value.h"
@@ -36,6 +38,11 @@ enum class ExecutionType {
   kDefault,
   kJit,
   kInterpreter,
+  // Start in the interpreter and JIT-compile in a background thread once the
+  // function has been invoked kAdaptiveJitThreshold times, swapping over to
+  // the compiled code when it is ready. Useful for fuzzers and short-lived
+  // tools where eager compilation of cold functions costs more than it saves.
+  kAdaptive,
 };
 
 // A wrapper for the jit structures that can be turned off at build time if
@@ -44,6 +51,32 @@ enum class ExecutionType {
 // TODO(google/xls#1151): 2023-10-13 Implement the rest of the FunctionJit API.
 class SwitchableFunctionJit {
  public:
+  // Number of invocations after which an ExecutionType::kAdaptive instance
+  // kicks off background JIT compilation.
+  static constexpr int64_t kAdaptiveJitThreshold = 32;
+
+  // Functions with at least this many IR nodes make their first compile at
+  // opt level 0 (LLVM's O0 pipeline with fast instruction selection) so
+  // compiled code is available quickly; the requested opt level is applied
+  // in a later background recompile if the function stays hot.
+  static constexpr int64_t kLargeFunctionNodeCount = 4096;
+
+  // Number of invocations of the cheaply-compiled code after which the
+  // background recompile at the requested opt level starts.
+  static constexpr int64_t kAdaptiveRecompileThreshold = 1024;
+
+  // Tuning knobs for ExecutionType::kAdaptive. The defaults match the
+  // constants above; tests and callers with unusual workloads can lower the
+  // thresholds or pin the opt level of the first compile per function.
+  struct AdaptiveOptions {
+    int64_t jit_threshold = kAdaptiveJitThreshold;
+    int64_t recompile_threshold = kAdaptiveRecompileThreshold;
+    int64_t large_function_node_count = kLargeFunctionNodeCount;
+    // If set, the first compile uses this opt level regardless of function
+    // size.
+    std::optional<int64_t> first_compile_opt_level;
+  };
+
   // Returns an object containing a host-compiled version of the specified XLS
   // function.
   static absl::StatusOr<std::unique_ptr<SwitchableFunctionJit>> CreateJit(
@@ -51,10 +84,22 @@ class SwitchableFunctionJit {
       JitObserver* observer = nullptr);
   static absl::StatusOr<std::unique_ptr<SwitchableFunctionJit>>
   CreateInterpreter(Function* xls_function);
+  // Returns an object that interprets the function until it proves hot and
+  // then transparently swaps in a JIT-compiled implementation; compilation
+  // runs on a background thread so invocations never block on LLVM. Large
+  // functions (per `adaptive_options`) compile at opt level 0 first and are
+  // recompiled at `opt_level` in the background if they keep running. Note
+  // the observer (if any) is invoked from the compile thread.
+  static absl::StatusOr<std::unique_ptr<SwitchableFunctionJit>> CreateAdaptive(
+      Function* xls_function, int64_t opt_level = 3,
+      JitObserver* observer = nullptr,
+      const AdaptiveOptions& adaptive_options = AdaptiveOptions());
   static absl::StatusOr<std::unique_ptr<SwitchableFunctionJit>> Create(
       Function* xls_function, ExecutionType execution = ExecutionType::kDefault,
       int64_t opt_level = 3, JitObserver* observer = nullptr);
 
+  ~SwitchableFunctionJit();
+
   // Executes the compiled function with the specified arguments.
   absl::StatusOr<InterpreterResult<Value>> Run(absl::Span<const Value> args);
 
@@ -81,9 +126,28 @@ class SwitchableFunctionJit {
         use_jit_(use_jit),
         function_jit_(std::move(jit)) {}
 
+  // Called at the top of Run() when in adaptive mode. Counts the invocation,
+  // starts background compilation once kAdaptiveJitThreshold is reached, and
+  // swaps in the compiled function once the background thread reports ready.
+  void MaybeTierUp();
+
   Function* xls_function_;
   bool use_jit_;
   std::unique_ptr<FunctionJit> function_jit_;
+
+  // Adaptive-tiering state. Run() is not thread-safe (matching FunctionJit),
+  // so only the ready flag (written by the compile thread) needs atomicity.
+  bool adaptive_ = false;
+  int64_t opt_level_ = 3;
+  AdaptiveOptions adaptive_options_;
+  // Opt level of the compile currently in flight (or last swapped in);
+  // tiering continues until code at the requested opt level is installed.
+  int64_t pending_opt_level_ = 0;
+  JitObserver* observer_ = nullptr;
+  int64_t invocation_count_ = 0;
+  std::unique_ptr<Thread> compile_thread_;
+  std::atomic<bool> background_jit_ready_{false};
+  absl::StatusOr<std::unique_ptr<FunctionJit>> background_jit_;
 };
 }  // namespace xls
 
@@ -14,6 +14,7 @@
 
 #include "xls/jit/switchable_function_jit.h"
 
+#include <cstdint>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -67,6 +68,80 @@ TEST_F(SwitchableFunctionJitTest, CanExecuteJit) {
             Value::Tuple({Value(UBits(12, 8)), Value(UBits(32, 8))}));
 }
 
+TEST_F(SwitchableFunctionJitTest, AdaptiveTiersUpToJit) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(auto f, TestFunction(p.get()));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto runner, SwitchableFunctionJit::Create(f, ExecutionType::kAdaptive));
+  EXPECT_FALSE(runner->function_jit().has_value());
+  // Results must stay correct across the interpreter phase, the compilation
+  // kick-off, and the swap to compiled code. Compilation finishes at an
+  // arbitrary point, so just keep running until the JIT is swapped in (with a
+  // generous bound in case the compile thread is starved).
+  int64_t runs = 0;
+  while (!runner->function_jit().has_value() && runs < 1000000) {
+    XLS_ASSERT_OK_AND_ASSIGN(
+        auto result, runner->Run(std::vector<Value>{Value(UBits(8, 8)),
+                                                    Value(UBits(4, 8))}));
+    ASSERT_EQ(result.value,
+              Value::Tuple({Value(UBits(12, 8)), Value(UBits(32, 8))}));
+    ++runs;
+  }
+  EXPECT_GE(runs, SwitchableFunctionJit::kAdaptiveJitThreshold);
+  ASSERT_TRUE(runner->function_jit().has_value());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto result,
+      runner->Run(std::vector<Value>{Value(UBits(8, 8)), Value(UBits(4, 8))}));
+  EXPECT_EQ(result.value,
+            Value::Tuple({Value(UBits(12, 8)), Value(UBits(32, 8))}));
+}
+
+TEST_F(SwitchableFunctionJitTest, AdaptiveRecompilesLargeFunctionsAtFullOpt) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(auto f, TestFunction(p.get()));
+
+  // Treat every function as "large" so the first compile happens at opt
+  // level 0 and a second, full-opt compile is scheduled once the cheap code
+  // proves hot.
+  SwitchableFunctionJit::AdaptiveOptions options;
+  options.jit_threshold = 4;
+  options.recompile_threshold = 4;
+  options.large_function_node_count = 1;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      SwitchableFunctionJit::CreateAdaptive(f, /*opt_level=*/3,
+                                            /*observer=*/nullptr, options));
+
+  auto run_once = [&]() {
+    XLS_ASSERT_OK_AND_ASSIGN(
+        auto result, runner->Run(std::vector<Value>{Value(UBits(8, 8)),
+                                                    Value(UBits(4, 8))}));
+    ASSERT_EQ(result.value,
+              Value::Tuple({Value(UBits(12, 8)), Value(UBits(32, 8))}));
+  };
+
+  // Phase 1: interpret until the opt-level-0 compile is swapped in.
+  int64_t runs = 0;
+  while (!runner->function_jit().has_value() && runs < 1000000) {
+    run_once();
+    ++runs;
+  }
+  ASSERT_TRUE(runner->function_jit().has_value());
+  FunctionJit* first_jit = *runner->function_jit();
+
+  // Phase 2: keep running until the full-opt recompile replaces it. Results
+  // must stay correct across the second swap as well.
+  runs = 0;
+  while (runner->function_jit() == first_jit && runs < 1000000) {
+    run_once();
+    ++runs;
+  }
+  ASSERT_TRUE(runner->function_jit().has_value());
+  EXPECT_NE(*runner->function_jit(), first_jit);
+  run_once();
+}
+
 TEST_F(SwitchableFunctionJitTest, CanExecuteDefault) {
   auto p = CreatePackage();
   XLS_ASSERT_OK_AND_ASSIGN(auto f, TestFunction(p.get()));
@@ -14,6 +14,7 @@
 
 #include "xls/jit/type_layout.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <ostream>
@@ -23,8 +24,11 @@
 
 #include "absl/log/check.h"
 #include "absl/strings/str_format.h"
+#include "absl/types/span.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/ir/bits.h"
 #include "xls/ir/ir_parser.h"
+#include "xls/ir/type.h"
 #include "xls/ir/value.h"
 #include "xls/ir/value_utils.h"
 
@@ -186,6 +190,82 @@ TypeLayoutProto TypeLayout::ToProto() const {
   return proto;
 }
 
+namespace {
+
+// Appends the bit count of every leaf element of `type` to `leaf_bit_counts`
+// in linear leaf order (tokens count as zero-width leaves).
+void CollectLeafBitCounts(Type* type, std::vector<int64_t>* leaf_bit_counts) {
+  if (type->IsBits()) {
+    leaf_bit_counts->push_back(type->AsBitsOrDie()->bit_count());
+    return;
+  }
+  if (type->IsToken()) {
+    leaf_bit_counts->push_back(0);
+    return;
+  }
+  if (type->IsTuple()) {
+    TupleType* tuple_type = type->AsTupleOrDie();
+    for (int64_t i = 0; i < tuple_type->size(); ++i) {
+      CollectLeafBitCounts(tuple_type->element_type(i), leaf_bit_counts);
+    }
+    return;
+  }
+  CHECK(type->IsArray());
+  ArrayType* array_type = type->AsArrayOrDie();
+  for (int64_t i = 0; i < array_type->size(); ++i) {
+    CollectLeafBitCounts(array_type->element_type(), leaf_bit_counts);
+  }
+}
+
+}  // namespace
+
+TypeLayoutView::TypeLayoutView(const TypeLayout& layout, uint8_t* buffer)
+    : layout_(&layout), buffer_(buffer) {
+  leaf_bit_counts_.reserve(layout.elements().size());
+  CollectLeafBitCounts(layout.type(), &leaf_bit_counts_);
+  CHECK_EQ(leaf_bit_counts_.size(), layout.elements().size());
+}
+
+void TypeLayoutView::SetLeaf(int64_t leaf_index, const Bits& bits) {
+  CHECK_EQ(bits.bit_count(), leaf_bit_counts_[leaf_index]);
+  const ElementLayout& element = layout_->elements()[leaf_index];
+  uint8_t* element_buffer = buffer_ + element.offset;
+  bits.ToBytes(absl::MakeSpan(element_buffer, element.data_size));
+  std::memset(element_buffer + element.data_size, 0,
+              element.padded_size - element.data_size);
+}
+
+Bits TypeLayoutView::GetLeafBits(int64_t leaf_index) const {
+  const ElementLayout& element = layout_->elements()[leaf_index];
+  return Bits::FromBytes(
+      absl::MakeConstSpan(buffer_ + element.offset, element.data_size),
+      leaf_bit_counts_[leaf_index]);
+}
+
+uint64_t TypeLayoutView::GetLeafAsUint64(int64_t leaf_index) const {
+  CHECK_LE(leaf_bit_counts_[leaf_index], 64);
+  const ElementLayout& element = layout_->elements()[leaf_index];
+  // The native layout stores data bytes least-significant first (matching the
+  // little-endian hosts the JIT runs on), and padding bytes are zero.
+  uint64_t result = 0;
+  std::memcpy(&result, buffer_ + element.offset,
+              std::min(element.padded_size, int64_t{8}));
+  return result;
+}
+
+void TypeLayoutView::SetLeafFromUint64(int64_t leaf_index, uint64_t value) {
+  int64_t bit_count = leaf_bit_counts_[leaf_index];
+  CHECK_LE(bit_count, 64);
+  if (bit_count < 64) {
+    CHECK_EQ(value >> bit_count, 0u);
+  }
+  const ElementLayout& element = layout_->elements()[leaf_index];
+  uint8_t* element_buffer = buffer_ + element.offset;
+  std::memset(element_buffer, 0, element.padded_size);
+  std::memcpy(element_buffer, &value,
+              std::min(element.data_size, int64_t{8}));
+}
+
 std::ostream& operator<<(std::ostream& os, ElementLayout layout) {
   os << layout.ToString();
   return os;
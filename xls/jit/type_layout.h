@@ -23,6 +23,7 @@
 #include "absl/log/check.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
+#include "xls/ir/bits.h"
 #include "xls/ir/package.h"
 #include "xls/ir/type.h"
 #include "xls/ir/value.h"
@@ -123,6 +124,62 @@ class TypeLayout {
   std::vector<ElementLayout> elements_;
 };
 
+// A non-owning view which binds a TypeLayout to a caller-provided
+// native-layout buffer. Callers which repeatedly invoke jitted code (e.g. via
+// FunctionJit::RunWithViews) can bind each argument/result buffer once and
+// then read and write individual leaf elements in place, without
+// materializing Value trees on each invocation. Value conversion dominates
+// the call cost of small functions (see value_to_native_layout_benchmark.cc).
+//
+// Leaf elements are identified by their linear index, in the same order as
+// TypeLayout::elements(). The buffer must hold at least layout.size() bytes
+// and must outlive the view.
+class TypeLayoutView {
+ public:
+  TypeLayoutView(const TypeLayout& layout, uint8_t* buffer);
+
+  const TypeLayout& layout() const { return *layout_; }
+
+  // The bound buffer, e.g. for passing to FunctionJit::RunWithViews.
+  uint8_t* buffer() { return buffer_; }
+  const uint8_t* buffer() const { return buffer_; }
+
+  // Returns the data bytes (excluding padding) of the given leaf element.
+  absl::Span<uint8_t> leaf_data(int64_t leaf_index) {
+    const ElementLayout& element = layout_->elements()[leaf_index];
+    return absl::MakeSpan(buffer_ + element.offset, element.data_size);
+  }
+  absl::Span<const uint8_t> leaf_data(int64_t leaf_index) const {
+    const ElementLayout& element = layout_->elements()[leaf_index];
+    return absl::MakeConstSpan(buffer_ + element.offset, element.data_size);
+  }
+
+  // Returns the bit count of the given leaf element's type.
+  int64_t leaf_bit_count(int64_t leaf_index) const {
+    return leaf_bit_counts_[leaf_index];
+  }
+
+  // Writes `bits` into the given leaf element and zeroes its padding
+  // bytes. `bits` must have the leaf's bit count.
+  void SetLeaf(int64_t leaf_index, const Bits& bits);
+
+  // Returns the given leaf element as a Bits value.
+  Bits GetLeafBits(int64_t leaf_index) const;
+
+  // Reads/writes the given leaf element as a uint64_t. The leaf must be at
+  // most 64 bits wide, and on write `value` must fit in the leaf's bit count.
+  uint64_t GetLeafAsUint64(int64_t leaf_index) const;
+  void SetLeafFromUint64(int64_t leaf_index, uint64_t value);
+
+ private:
+  const TypeLayout* layout_;
+  uint8_t* buffer_;
+
+  // Bit count of each leaf element of layout_->type(), computed once at
+  // binding time.
+  std::vector<int64_t> leaf_bit_counts_;
+};
+
 std::ostream& operator<<(std::ostream& os, ElementLayout layout);
 std::ostream& operator<<(std::ostream& os, const TypeLayout& layout);
 
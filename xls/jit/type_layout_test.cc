@@ -298,6 +298,40 @@ TEST_F(TypeLayoutTest, SimpleArray) {
           ElementLayout{.offset = 4, .data_size = 2, .padded_size = 2}));
 }
 
+TEST_F(TypeLayoutTest, LayoutView) {
+  auto package = CreatePackage();
+  Type* tuple =
+      package->GetTupleType({package->GetBitsType(4), package->GetBitsType(15),
+                             package->GetBitsType(16)});
+  TypeLayout layout(
+      tuple, 6,
+      {ElementLayout{.offset = 0, .data_size = 1, .padded_size = 1},
+       ElementLayout{.offset = 2, .data_size = 2, .padded_size = 2},
+       ElementLayout{.offset = 4, .data_size = 2, .padded_size = 2}});
+
+  std::vector<uint8_t> buffer(layout.size(), 0xff);
+  TypeLayoutView view(layout, buffer.data());
+  EXPECT_EQ(view.leaf_bit_count(0), 4);
+  EXPECT_EQ(view.leaf_bit_count(1), 15);
+  EXPECT_EQ(view.leaf_bit_count(2), 16);
+
+  // Writes through the view match ValueToNativeLayout without constructing
+  // any Value.
+  view.SetLeaf(0, UBits(0x3, 4));
+  view.SetLeaf(1, UBits(0x7bcd, 15));
+  view.SetLeaf(2, UBits(0xfedc, 16));
+  EXPECT_THAT(buffer, ElementsAre(0x3, 0xff, 0xcd, 0x7b, 0xdc, 0xfe));
+
+  EXPECT_EQ(view.GetLeafBits(0), UBits(0x3, 4));
+  EXPECT_EQ(view.GetLeafBits(1), UBits(0x7bcd, 15));
+  EXPECT_EQ(view.GetLeafAsUint64(2), 0xfedc);
+
+  view.SetLeafFromUint64(2, 0x1234);
+  EXPECT_EQ(view.GetLeafAsUint64(2), 0x1234);
+  EXPECT_EQ(layout.NativeLayoutToValue(buffer.data()),
+            Value(Parser::ParseValue("(0x3, 0x7bcd, 0x1234)", tuple).value()));
+}
+
 TEST_F(TypeLayoutTest, JitTypes) {
   // Randomly test the layout of a bunch of types. TypeLayouts are generated by
   // the JIT and random xls::Values are round-tripped through the native layout.
@@ -0,0 +1,339 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "xls/netlist/compiled_interpreter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
+#include "xls/netlist/cell_library.h"
+#include "xls/netlist/function_parser.h"
+#include "xls/netlist/netlist.h"
+
+namespace xls {
+namespace netlist {
+namespace {
+
+// Minimum number of programs a worker thread must have to make spawning it
+// worthwhile.
+constexpr int64_t kMinProgramsPerThread = 1024;
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<CompiledInterpreter>>
+CompiledInterpreter::Create(const rtl::Netlist* netlist,
+                            const rtl::Module* module, int64_t num_threads) {
+  auto interpreter =
+      absl::WrapUnique(new CompiledInterpreter(module, num_threads));
+
+  // Assign a dense index to every net in the module.
+  interpreter->net_index_.reserve(module->nets().size());
+  for (const auto& net : module->nets()) {
+    int32_t index = static_cast<int32_t>(interpreter->net_index_.size());
+    interpreter->net_index_[net.get()] = index;
+  }
+  interpreter->net_defined_.resize(module->nets().size(), false);
+  interpreter->net_defined_[interpreter->net_index_.at(module->zero())] = true;
+  interpreter->net_defined_[interpreter->net_index_.at(module->one())] = true;
+  for (const rtl::NetRef input : module->inputs()) {
+    interpreter->net_defined_[interpreter->net_index_.at(input)] = true;
+  }
+
+  // Compile the output functions of every cell and record which cell drives
+  // each net.
+  const int64_t num_cells = module->cells().size();
+  std::vector<std::vector<CellProgram>> cell_programs(num_cells);
+  absl::flat_hash_map<int32_t, int64_t> driver_of_net;
+  for (int64_t cell_id = 0; cell_id < num_cells; ++cell_id) {
+    const rtl::Cell& cell = *module->cells()[cell_id];
+    const CellLibraryEntry* entry = cell.cell_library_entry();
+    if (netlist->MaybeGetModule(entry->name()).has_value()) {
+      return absl::UnimplementedError(absl::StrFormat(
+          "Cell \"%s\" instantiates module \"%s\"; module-typed cells are not "
+          "supported by the compiled interpreter.",
+          cell.name(), entry->name()));
+    }
+    if (!cell.internal_pins().empty()) {
+      return absl::UnimplementedError(absl::StrFormat(
+          "Cell \"%s\" has internal pins (state table); stateful cells are "
+          "not supported by the compiled interpreter.",
+          cell.name()));
+    }
+
+    absl::flat_hash_map<std::string, int32_t> input_indices;
+    input_indices.reserve(cell.inputs().size());
+    for (const auto& input : cell.inputs()) {
+      input_indices[input.name] = interpreter->net_index_.at(input.netref);
+    }
+
+    const auto& pins = entry->output_pin_to_function();
+    for (const auto& output : cell.outputs()) {
+      if (output.netref == module->GetDummyRef()) {
+        continue;
+      }
+      if (output.eval != nullptr) {
+        return absl::UnimplementedError(absl::StrFormat(
+            "Output pin \"%s\" of cell \"%s\" has an evaluation function "
+            "override which is not supported by the compiled interpreter.",
+            output.name, cell.name()));
+      }
+      XLS_ASSIGN_OR_RETURN(function::Ast ast,
+                           function::Parser::ParseFunction(
+                               pins.at(output.name)));
+      CellProgram program;
+      program.output_index = interpreter->net_index_.at(output.netref);
+      XLS_RETURN_IF_ERROR(
+          FlattenFunction(ast, input_indices, cell, &program.operations));
+      driver_of_net[program.output_index] = cell_id;
+      interpreter->net_defined_[program.output_index] = true;
+      cell_programs[cell_id].push_back(std::move(program));
+    }
+  }
+
+  // Levelize the cells: a cell's level is one more than the deepest cell
+  // driving one of its inputs. Kahn's algorithm over the cell dependency
+  // edges yields the levels in one pass.
+  std::vector<std::vector<int64_t>> dependents(num_cells);
+  std::vector<int64_t> num_dependencies(num_cells, 0);
+  std::vector<int64_t> cell_level(num_cells, 0);
+  for (int64_t cell_id = 0; cell_id < num_cells; ++cell_id) {
+    const rtl::Cell& cell = *module->cells()[cell_id];
+    absl::flat_hash_set<int64_t> driver_cells;
+    for (const auto& input : cell.inputs()) {
+      auto it = driver_of_net.find(interpreter->net_index_.at(input.netref));
+      if (it != driver_of_net.end()) {
+        driver_cells.insert(it->second);
+      }
+    }
+    for (int64_t driver_cell : driver_cells) {
+      dependents[driver_cell].push_back(cell_id);
+    }
+    num_dependencies[cell_id] = driver_cells.size();
+  }
+  std::deque<int64_t> ready;
+  for (int64_t cell_id = 0; cell_id < num_cells; ++cell_id) {
+    if (num_dependencies[cell_id] == 0) {
+      ready.push_back(cell_id);
+    }
+  }
+  int64_t num_leveled = 0;
+  while (!ready.empty()) {
+    int64_t cell_id = ready.front();
+    ready.pop_front();
+    num_leveled++;
+    int64_t level = cell_level[cell_id];
+    if (static_cast<int64_t>(interpreter->levels_.size()) <= level) {
+      interpreter->levels_.resize(level + 1);
+    }
+    for (CellProgram& program : cell_programs[cell_id]) {
+      interpreter->levels_[level].push_back(std::move(program));
+    }
+    for (int64_t dependent : dependents[cell_id]) {
+      cell_level[dependent] = std::max(cell_level[dependent], level + 1);
+      if (--num_dependencies[dependent] == 0) {
+        ready.push_back(dependent);
+      }
+    }
+  }
+  if (num_leveled != num_cells) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Netlist module \"%s\" contains a combinational cycle and cannot be "
+        "levelized.",
+        module->name()));
+  }
+
+  return interpreter;
+}
+
+absl::Status CompiledInterpreter::FlattenFunction(
+    const function::Ast& ast,
+    const absl::flat_hash_map<std::string, int32_t>& input_indices,
+    const rtl::Cell& cell, std::vector<Operation>* operations) {
+  switch (ast.kind()) {
+    case function::Ast::Kind::kIdentifier: {
+      auto it = input_indices.find(ast.name());
+      if (it == input_indices.end()) {
+        return absl::NotFoundError(
+            absl::StrFormat("Identifier \"%s\" not found in cell %s's inputs.",
+                            ast.name(), cell.name()));
+      }
+      operations->push_back(Operation{Operation::Kind::kLoad, it->second});
+      return absl::OkStatus();
+    }
+    case function::Ast::Kind::kLiteralZero:
+      operations->push_back(Operation{Operation::Kind::kZero});
+      return absl::OkStatus();
+    case function::Ast::Kind::kLiteralOne:
+      operations->push_back(Operation{Operation::Kind::kOne});
+      return absl::OkStatus();
+    case function::Ast::Kind::kNot:
+      XLS_RETURN_IF_ERROR(FlattenFunction(ast.children()[0], input_indices,
+                                          cell, operations));
+      operations->push_back(Operation{Operation::Kind::kNot});
+      return absl::OkStatus();
+    case function::Ast::Kind::kAnd:
+    case function::Ast::Kind::kOr:
+    case function::Ast::Kind::kXor: {
+      XLS_RETURN_IF_ERROR(FlattenFunction(ast.children()[0], input_indices,
+                                          cell, operations));
+      XLS_RETURN_IF_ERROR(FlattenFunction(ast.children()[1], input_indices,
+                                          cell, operations));
+      Operation::Kind kind = ast.kind() == function::Ast::Kind::kAnd
+                                 ? Operation::Kind::kAnd
+                                 : (ast.kind() == function::Ast::Kind::kOr
+                                        ? Operation::Kind::kOr
+                                        : Operation::Kind::kXor);
+      operations->push_back(Operation{kind});
+      return absl::OkStatus();
+    }
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Unknown AST element type: %d",
+                          static_cast<int>(ast.kind())));
+  }
+}
+
+void CompiledInterpreter::EvaluatePrograms(
+    absl::Span<const CellProgram> programs, absl::Span<uint64_t> values) {
+  std::vector<uint64_t> stack;
+  for (const CellProgram& program : programs) {
+    stack.clear();
+    for (const Operation& operation : program.operations) {
+      switch (operation.kind) {
+        case Operation::Kind::kLoad:
+          stack.push_back(values[operation.net_index]);
+          break;
+        case Operation::Kind::kZero:
+          stack.push_back(0);
+          break;
+        case Operation::Kind::kOne:
+          stack.push_back(~uint64_t{0});
+          break;
+        case Operation::Kind::kNot:
+          stack.back() = ~stack.back();
+          break;
+        case Operation::Kind::kAnd: {
+          uint64_t rhs = stack.back();
+          stack.pop_back();
+          stack.back() &= rhs;
+          break;
+        }
+        case Operation::Kind::kOr: {
+          uint64_t rhs = stack.back();
+          stack.pop_back();
+          stack.back() |= rhs;
+          break;
+        }
+        case Operation::Kind::kXor: {
+          uint64_t rhs = stack.back();
+          stack.pop_back();
+          stack.back() ^= rhs;
+          break;
+        }
+      }
+    }
+    values[program.output_index] = stack.back();
+  }
+}
+
+absl::StatusOr<NetRef2Word> CompiledInterpreter::InterpretModule(
+    const NetRef2Word& inputs) const {
+  std::vector<uint64_t> values(net_index_.size(), 0);
+  values[net_index_.at(module_->zero())] = 0;
+  values[net_index_.at(module_->one())] = ~uint64_t{0};
+  for (const rtl::NetRef input : module_->inputs()) {
+    auto it = inputs.find(input);
+    XLS_RET_CHECK(it != inputs.end())
+        << "Missing input net: " << input->name();
+    values[net_index_.at(input)] = it->second;
+  }
+
+  // Evaluate one level at a time. Programs within a level write disjoint nets
+  // and only read nets settled by earlier levels, so a level can be chunked
+  // across threads without synchronization.
+  for (const std::vector<CellProgram>& level : levels_) {
+    const int64_t level_size = level.size();
+    int64_t num_chunks = 1;
+    if (num_threads_ > 0) {
+      num_chunks =
+          std::min<int64_t>(num_threads_ + 1,
+                            std::max<int64_t>(1, level_size /
+                                                     kMinProgramsPerThread));
+    }
+    if (num_chunks == 1) {
+      EvaluatePrograms(level, absl::MakeSpan(values));
+      continue;
+    }
+    int64_t chunk_size = (level_size + num_chunks - 1) / num_chunks;
+    std::vector<std::unique_ptr<Thread>> workers;
+    for (int64_t chunk = 1; chunk < num_chunks; ++chunk) {
+      int64_t begin = std::min(chunk * chunk_size, level_size);
+      int64_t end = std::min(begin + chunk_size, level_size);
+      absl::Span<const CellProgram> chunk_programs =
+          absl::MakeConstSpan(level).subspan(begin, end - begin);
+      workers.push_back(std::make_unique<Thread>(
+          [chunk_programs, &values]() {
+            EvaluatePrograms(chunk_programs, absl::MakeSpan(values));
+          }));
+    }
+    EvaluatePrograms(absl::MakeConstSpan(level).subspan(0, chunk_size),
+                     absl::MakeSpan(values));
+    for (const std::unique_ptr<Thread>& worker : workers) {
+      worker->Join();
+    }
+  }
+
+  // Collect the module outputs, resolving undriven outputs through the assign
+  // chains the same way the interpreter does.
+  NetRef2Word outputs;
+  outputs.reserve(module_->outputs().size());
+  const auto& assigns = module_->assigns();
+  for (const rtl::NetRef output : module_->outputs()) {
+    int32_t output_index = net_index_.at(output);
+    if (net_defined_[output_index]) {
+      outputs.insert({output, values[output_index]});
+      continue;
+    }
+    XLS_RET_CHECK(assigns.contains(output));
+    rtl::NetRef net_value = output;
+    while (assigns.contains(net_value)) {
+      net_value = assigns.at(net_value);
+    }
+    if (net_value == module_->zero()) {
+      outputs.insert({output, 0});
+    } else if (net_value == module_->one()) {
+      outputs.insert({output, ~uint64_t{0}});
+    } else {
+      XLS_RET_CHECK(inputs.contains(net_value));
+      outputs.insert({output, inputs.at(net_value)});
+    }
+  }
+  return outputs;
+}
+
+}  // namespace netlist
+}  // namespace xls
@@ -0,0 +1,219 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "xls/netlist/compiled_interpreter.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "xls/common/status/matchers.h"
+#include "xls/netlist/cell_library.h"
+#include "xls/netlist/fake_cell_library.h"
+#include "xls/netlist/interpreter.h"
+#include "xls/netlist/netlist.h"
+
+namespace xls {
+namespace netlist {
+namespace {
+
+// A single AND cell evaluated over 64 bit-packed input vectors at once.
+TEST(CompiledInterpreterTest, BasicFunctionality) {
+  auto module = std::make_unique<rtl::Module>("the_module");
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "A"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "B"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kOutput, "O"));
+
+  XLS_ASSERT_OK_AND_ASSIGN(CellLibrary library, MakeFakeCellLibrary());
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* entry,
+                           library.GetEntry("AND"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef a_ref, module->ResolveNet("A"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef b_ref, module->ResolveNet("B"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef o_ref, module->ResolveNet("O"));
+
+  absl::flat_hash_map<std::string, rtl::NetRef> params;
+  params["A"] = a_ref;
+  params["B"] = b_ref;
+  params["Z"] = o_ref;
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      rtl::Cell tmp_cell,
+      rtl::Cell::Create(entry, "the_cell", params, std::nullopt, nullptr));
+  XLS_ASSERT_OK_AND_ASSIGN(auto cell, module->AddCell(tmp_cell));
+  a_ref->NoteConnectedCell(cell);
+  b_ref->NoteConnectedCell(cell);
+  o_ref->NoteConnectedCell(cell);
+
+  rtl::Netlist netlist;
+  netlist.AddModule(std::move(module));
+  XLS_ASSERT_OK_AND_ASSIGN(const rtl::Module* module_ptr,
+                           netlist.GetModule("the_module"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<CompiledInterpreter> interpreter,
+      CompiledInterpreter::Create(&netlist, module_ptr));
+
+  NetRef2Word inputs;
+  inputs[module_ptr->inputs()[0]] = 0xF0F0F0F0F0F0F0F0;
+  inputs[module_ptr->inputs()[1]] = 0xFF00FF00FF00FF00;
+  XLS_ASSERT_OK_AND_ASSIGN(NetRef2Word outputs,
+                           interpreter->InterpretModule(inputs));
+  EXPECT_EQ(outputs.size(), 1);
+  EXPECT_EQ(outputs[module_ptr->outputs()[0]],
+            0xF0F0F0F0F0F0F0F0 & 0xFF00FF00FF00FF00);
+}
+
+// A two-level XOR(AND(), OR()) tree must match the plain interpreter bit for
+// bit across all 64 vectors.
+TEST(CompiledInterpreterTest, TreeMatchesInterpreter) {
+  auto module = std::make_unique<rtl::Module>("the_module");
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "i0"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "i1"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "i2"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "i3"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kWire, "and_o"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kWire, "or_o"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kOutput, "xor_o"));
+
+  XLS_ASSERT_OK_AND_ASSIGN(CellLibrary library, MakeFakeCellLibrary());
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* and_entry,
+                           library.GetEntry("AND"));
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* or_entry,
+                           library.GetEntry("OR"));
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* xor_entry,
+                           library.GetEntry("XOR"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef i0, module->ResolveNet("i0"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef i1, module->ResolveNet("i1"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef i2, module->ResolveNet("i2"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef i3, module->ResolveNet("i3"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef and_o, module->ResolveNet("and_o"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef or_o, module->ResolveNet("or_o"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef xor_o, module->ResolveNet("xor_o"));
+
+  absl::flat_hash_map<std::string, rtl::NetRef> and_params;
+  and_params["A"] = i0;
+  and_params["B"] = i1;
+  and_params["Z"] = and_o;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      rtl::Cell tmp_and,
+      rtl::Cell::Create(and_entry, "and", and_params, std::nullopt, nullptr));
+  XLS_ASSERT_OK_AND_ASSIGN(auto and_cell, module->AddCell(tmp_and));
+
+  absl::flat_hash_map<std::string, rtl::NetRef> or_params;
+  or_params["A"] = i2;
+  or_params["B"] = i3;
+  or_params["Z"] = or_o;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      rtl::Cell tmp_or,
+      rtl::Cell::Create(or_entry, "or", or_params, std::nullopt, nullptr));
+  XLS_ASSERT_OK_AND_ASSIGN(auto or_cell, module->AddCell(tmp_or));
+
+  absl::flat_hash_map<std::string, rtl::NetRef> xor_params;
+  xor_params["A"] = and_o;
+  xor_params["B"] = or_o;
+  xor_params["Z"] = xor_o;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      rtl::Cell tmp_xor,
+      rtl::Cell::Create(xor_entry, "xor", xor_params, std::nullopt, nullptr));
+  XLS_ASSERT_OK_AND_ASSIGN(auto xor_cell, module->AddCell(tmp_xor));
+
+  i0->NoteConnectedCell(and_cell);
+  i1->NoteConnectedCell(and_cell);
+  i2->NoteConnectedCell(or_cell);
+  i3->NoteConnectedCell(or_cell);
+  and_o->NoteConnectedCell(and_cell);
+  and_o->NoteConnectedCell(xor_cell);
+  or_o->NoteConnectedCell(or_cell);
+  or_o->NoteConnectedCell(xor_cell);
+  xor_o->NoteConnectedCell(xor_cell);
+
+  rtl::Netlist netlist;
+  netlist.AddModule(std::move(module));
+  XLS_ASSERT_OK_AND_ASSIGN(const rtl::Module* module_ptr,
+                           netlist.GetModule("the_module"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<CompiledInterpreter> compiled,
+      CompiledInterpreter::Create(&netlist, module_ptr, /*num_threads=*/2));
+
+  std::vector<uint64_t> words = {0x0123456789ABCDEF, 0xFEDCBA9876543210,
+                                 0x00FF00FF00FF00FF, 0xAAAAAAAAAAAAAAAA};
+  NetRef2Word inputs;
+  for (int i = 0; i < 4; ++i) {
+    inputs[module_ptr->inputs()[i]] = words[i];
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(NetRef2Word outputs,
+                           compiled->InterpretModule(inputs));
+  EXPECT_EQ(outputs.size(), 1);
+
+  // The plain interpreter evaluates a single vector at a time; cross-check
+  // every one of the 64 packed vectors against it.
+  Interpreter interpreter(&netlist);
+  uint64_t word = outputs[module_ptr->outputs()[0]];
+  for (int64_t bit = 0; bit < 64; ++bit) {
+    NetRef2Value scalar_inputs;
+    for (int i = 0; i < 4; ++i) {
+      scalar_inputs[module_ptr->inputs()[i]] = (words[i] >> bit) & 1;
+    }
+    XLS_ASSERT_OK_AND_ASSIGN(
+        NetRef2Value scalar_outputs,
+        interpreter.InterpretModule(module_ptr, scalar_inputs));
+    EXPECT_EQ((word >> bit) & 1, scalar_outputs[module_ptr->outputs()[0]])
+        << "vector " << bit;
+  }
+}
+
+// Cells with evaluation-function overrides require the general interpreter.
+TEST(CompiledInterpreterTest, RejectsCellsWithEvalFns) {
+  auto module = std::make_unique<rtl::Module>("the_module");
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "A"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kInput, "B"));
+  XLS_ASSERT_OK(module->AddNetDecl(rtl::NetDeclKind::kOutput, "O"));
+
+  XLS_ASSERT_OK_AND_ASSIGN(CellLibrary library, MakeFakeCellLibrary());
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* entry,
+                           library.GetEntry("AND"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef a_ref, module->ResolveNet("A"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef b_ref, module->ResolveNet("B"));
+  XLS_ASSERT_OK_AND_ASSIGN(rtl::NetRef o_ref, module->ResolveNet("O"));
+
+  absl::flat_hash_map<std::string, rtl::NetRef> params;
+  params["A"] = a_ref;
+  params["B"] = b_ref;
+  params["Z"] = o_ref;
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      rtl::Cell tmp_cell,
+      rtl::Cell::Create(entry, "the_cell", params, std::nullopt, nullptr));
+  XLS_ASSERT_OK_AND_ASSIGN(auto cell, module->AddCell(tmp_cell));
+  a_ref->NoteConnectedCell(cell);
+  b_ref->NoteConnectedCell(cell);
+  o_ref->NoteConnectedCell(cell);
+  XLS_ASSERT_OK(cell->SetOutputEvalFn(
+      "Z", [](const std::vector<bool>& args) { return args[0]; }));
+
+  rtl::Netlist netlist;
+  netlist.AddModule(std::move(module));
+  XLS_ASSERT_OK_AND_ASSIGN(const rtl::Module* module_ptr,
+                           netlist.GetModule("the_module"));
+  EXPECT_EQ(CompiledInterpreter::Create(&netlist, module_ptr).status().code(),
+            absl::StatusCode::kUnimplemented);
+}
+
+}  // namespace
+}  // namespace netlist
+}  // namespace xls
@@ -0,0 +1,173 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/netlist/lazy_cell_library.h"
+
+#include <cctype>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/netlist/cell_library.h"
+#include "xls/netlist/function_extractor.h"
+#include "xls/netlist/lib_parser.h"
+#include "xls/netlist/netlist.pb.h"
+
+namespace xls {
+namespace netlist {
+
+absl::StatusOr<LazyCellLibrary> LazyCellLibrary::Create(
+    std::string library_text) {
+  LazyCellLibrary library(std::move(library_text));
+  std::string_view text = library.library_text_;
+  const int64_t size = text.size();
+
+  int64_t depth = 0;
+  int64_t i = 0;
+
+  // The cell block currently being skipped over: the byte offset of its
+  // `cell` keyword, the brace depth at which the keyword appeared, and the
+  // cell name. Liberty cells do not nest, so one pending cell suffices.
+  int64_t cell_start = -1;
+  int64_t cell_depth = -1;
+  std::string cell_name;
+
+  while (i < size) {
+    char c = text[i];
+    if (c == '/' && i + 1 < size && text[i + 1] == '*') {
+      size_t close = text.find("*/", i + 2);
+      if (close == std::string_view::npos) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Unterminated comment at byte offset %d in cell library.", i));
+      }
+      i = static_cast<int64_t>(close) + 2;
+      continue;
+    }
+    if (c == '/' && i + 1 < size && text[i + 1] == '/') {
+      size_t newline = text.find('\n', i + 2);
+      i = newline == std::string_view::npos ? size
+                                            : static_cast<int64_t>(newline);
+      continue;
+    }
+    if (c == '"') {
+      size_t close = text.find('"', i + 1);
+      if (close == std::string_view::npos) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Unterminated string at byte offset %d in cell library.", i));
+      }
+      i = static_cast<int64_t>(close) + 1;
+      continue;
+    }
+    if (c == '{') {
+      depth++;
+      i++;
+      continue;
+    }
+    if (c == '}') {
+      depth--;
+      i++;
+      if (depth < 0) {
+        return absl::InvalidArgumentError(
+            "Unbalanced braces in cell library.");
+      }
+      if (cell_start >= 0 && depth == cell_depth) {
+        library.cell_ranges_.emplace(std::move(cell_name),
+                                     std::make_pair(cell_start, i));
+        cell_start = -1;
+      }
+      continue;
+    }
+    if (std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '_') {
+      int64_t word_start = i;
+      while (i < size &&
+             (std::isalnum(static_cast<unsigned char>(text[i])) != 0 ||
+              text[i] == '_')) {
+        i++;
+      }
+      std::string_view word = text.substr(word_start, i - word_start);
+      if (word != "cell" || cell_start >= 0) {
+        continue;
+      }
+      // Only `cell (<name>)` starts a cell definition; `cell` used as a plain
+      // key or value falls through.
+      int64_t j = i;
+      while (j < size && (text[j] == ' ' || text[j] == '\n')) {
+        j++;
+      }
+      if (j >= size || text[j] != '(') {
+        continue;
+      }
+      size_t close = text.find(')', j + 1);
+      if (close == std::string_view::npos) {
+        return absl::InvalidArgumentError(absl::StrFormat(
+            "Unterminated cell name at byte offset %d in cell library.", j));
+      }
+      cell_name = std::string(absl::StripAsciiWhitespace(
+          text.substr(j + 1, static_cast<int64_t>(close) - j - 1)));
+      cell_start = word_start;
+      cell_depth = depth;
+      i = static_cast<int64_t>(close) + 1;
+      continue;
+    }
+    i++;
+  }
+  if (depth != 0 || cell_start >= 0) {
+    return absl::InvalidArgumentError("Unbalanced braces in cell library.");
+  }
+  return library;
+}
+
+absl::StatusOr<const CellLibraryEntry*> LazyCellLibrary::GetEntry(
+    std::string_view name) {
+  auto it = entries_.find(name);
+  if (it != entries_.end()) {
+    return it->second.get();
+  }
+  auto range_it = cell_ranges_.find(name);
+  if (range_it == cell_ranges_.end()) {
+    return absl::NotFoundError(
+        absl::StrCat("Cell not found in library: ", name));
+  }
+  auto [start, end] = range_it->second;
+  std::string_view cell_text =
+      std::string_view(library_text_).substr(start, end - start);
+
+  // Materialize the entry by running the regular extraction path over just
+  // this cell's text, wrapped in a minimal library block.
+  XLS_ASSIGN_OR_RETURN(
+      cell_lib::CharStream stream,
+      cell_lib::CharStream::FromText(
+          absl::StrCat("library (lazy) {\n", cell_text, "\n}")));
+  XLS_ASSIGN_OR_RETURN(CellLibraryProto proto,
+                       function::ExtractFunctions(&stream));
+  XLS_RET_CHECK_EQ(proto.entries_size(), 1) << name;
+  XLS_ASSIGN_OR_RETURN(
+      CellLibraryEntry entry,
+      CellLibraryEntry::FromProto(proto.entries(0), false, true));
+  auto [entry_it, inserted] = entries_.emplace(
+      std::string(name), std::make_unique<CellLibraryEntry>(std::move(entry)));
+  return entry_it->second.get();
+}
+
+}  // namespace netlist
+}  // namespace xls
@@ -0,0 +1,74 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_NETLIST_LAZY_CELL_LIBRARY_H_
+#define XLS_NETLIST_LAZY_CELL_LIBRARY_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "xls/netlist/cell_library.h"
+
+namespace xls {
+namespace netlist {
+
+// A lazily-parsed view of a Liberty (".lib") cell library.
+//
+// CellLibrary requires the whole library to be parsed into protos up front,
+// which takes seconds and hundreds of megabytes for production libraries even
+// when a flow only ever looks up a handful of cells. LazyCellLibrary instead
+// makes one lightweight pass over the library text which only records the
+// byte range of each `cell (...) { ... }` block; a cell's body is parsed and
+// its CellLibraryEntry materialized the first time the cell is looked up.
+class LazyCellLibrary {
+ public:
+  // Indexes the cell definitions in `library_text`. The text is taken by
+  // value and kept alive for the lifetime of the library; cell bodies are not
+  // parsed. Returns an error if the text is not a structurally valid library
+  // (unbalanced braces or an unterminated comment or string).
+  static absl::StatusOr<LazyCellLibrary> Create(std::string library_text);
+
+  // Returns the entry with the given name, parsing and materializing it on
+  // first lookup. Returns a NOT_FOUND status if the library does not define
+  // such a cell.
+  absl::StatusOr<const CellLibraryEntry*> GetEntry(std::string_view name);
+
+  // The number of cells defined by the library.
+  int64_t cell_count() const { return cell_ranges_.size(); }
+
+ private:
+  explicit LazyCellLibrary(std::string library_text)
+      : library_text_(std::move(library_text)) {}
+
+  // The full library text; cell_ranges_ indexes into this buffer.
+  std::string library_text_;
+
+  // Byte range [first, second) of each cell block in library_text_ (from the
+  // `cell` keyword through the matching close brace), keyed by cell name.
+  absl::flat_hash_map<std::string, std::pair<int64_t, int64_t>> cell_ranges_;
+
+  // Entries materialized so far.
+  absl::flat_hash_map<std::string, std::unique_ptr<CellLibraryEntry>>
+      entries_;
+};
+
+}  // namespace netlist
+}  // namespace xls
+
+#endif  // XLS_NETLIST_LAZY_CELL_LIBRARY_H_
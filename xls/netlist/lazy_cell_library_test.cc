@@ -0,0 +1,99 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/netlist/lazy_cell_library.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "xls/common/status/matchers.h"
+#include "xls/netlist/cell_library.h"
+
+namespace xls {
+namespace netlist {
+namespace {
+
+constexpr const char kLibraryText[] = R"(
+library (test_lib) {
+  /* a comment with a cell (not_a_cell) { inside } */
+  operating_conditions (typical) {
+    process: 1;
+  }
+  cell (and2) {
+    pin (A) {
+      direction: input;
+    }
+    pin (B) {
+      direction: input;
+    }
+    pin (Z) {
+      direction: output;
+      function: "A&B";
+    }
+  }
+  cell (inv1) {
+    pin (A) {
+      direction: input;
+    }
+    pin (ZN) {
+      direction: output;
+      function: "!A";
+    }
+  }
+}
+)";
+
+TEST(LazyCellLibraryTest, IndexesCellsWithoutParsing) {
+  XLS_ASSERT_OK_AND_ASSIGN(LazyCellLibrary library,
+                           LazyCellLibrary::Create(kLibraryText));
+  EXPECT_EQ(library.cell_count(), 2);
+}
+
+TEST(LazyCellLibraryTest, MaterializesEntryOnFirstLookup) {
+  XLS_ASSERT_OK_AND_ASSIGN(LazyCellLibrary library,
+                           LazyCellLibrary::Create(kLibraryText));
+
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* and2,
+                           library.GetEntry("and2"));
+  EXPECT_EQ(and2->name(), "and2");
+  ASSERT_EQ(and2->input_names().size(), 2);
+  EXPECT_EQ(and2->output_pin_to_function().at("Z"), "A&B");
+
+  // A second lookup returns the already-materialized entry.
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* and2_again,
+                           library.GetEntry("and2"));
+  EXPECT_EQ(and2, and2_again);
+
+  XLS_ASSERT_OK_AND_ASSIGN(const CellLibraryEntry* inv1,
+                           library.GetEntry("inv1"));
+  EXPECT_EQ(inv1->output_pin_to_function().at("ZN"), "!A");
+}
+
+TEST(LazyCellLibraryTest, UnknownCellIsNotFound) {
+  XLS_ASSERT_OK_AND_ASSIGN(LazyCellLibrary library,
+                           LazyCellLibrary::Create(kLibraryText));
+  EXPECT_EQ(library.GetEntry("nand3").status().code(),
+            absl::StatusCode::kNotFound);
+}
+
+TEST(LazyCellLibraryTest, UnbalancedBracesAreRejected) {
+  EXPECT_EQ(
+      LazyCellLibrary::Create("library (l) { cell (c) { ").status().code(),
+      absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace netlist
+}  // namespace xls
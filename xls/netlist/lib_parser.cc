@@ -16,7 +16,6 @@
 
 #include <cctype>
 #include <cstdint>
-#include <fstream>
 #include <memory>
 #include <optional>
 #include <string>
@@ -31,6 +30,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "xls/common/file/file_mapping.h"
 #include "xls/common/status/status_macros.h"
 
 namespace xls {
@@ -39,12 +39,9 @@ namespace cell_lib {
 
 /* static */ absl::StatusOr<CharStream> CharStream::FromPath(
     std::string_view path) {
-  std::ifstream file_stream{std::string(path)};
-  if (file_stream.is_open()) {
-    return CharStream(std::move(file_stream));
-  }
-  return absl::NotFoundError(
-      absl::StrCat("Could not open file at path: ", path));
+  XLS_ASSIGN_OR_RETURN(FileMapping mapping,
+                       FileMapping::Open(std::string(path)));
+  return CharStream(std::move(mapping));
 }
 
 /* static */ absl::StatusOr<CharStream> CharStream::FromText(std::string text) {
@@ -22,7 +22,6 @@
 
 #include <cctype>
 #include <cstdint>
-#include <fstream>
 #include <memory>
 #include <optional>
 #include <string>
@@ -36,6 +35,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "xls/common/file/file_mapping.h"
 #include "xls/common/status/status_macros.h"
 
 namespace xls {
@@ -53,34 +53,20 @@ struct Pos {
 };
 
 // Wraps a file as a character stream with a 1- or 2-character lookahead
-// interface.
+// interface. Files are memory mapped rather than streamed (cell libraries
+// run to gigabytes), so scanning reads the mapped pages directly.
 class CharStream {
  public:
   static absl::StatusOr<CharStream> FromPath(std::string_view path);
   static absl::StatusOr<CharStream> FromText(std::string text);
 
-  ~CharStream() {
-    if (if_.has_value()) {
-      if_->close();
-    }
-  }
-
   CharStream(CharStream&& other) = default;
 
   Pos GetPos() const { return pos_; }
-  bool AtEof() const {
-    if (if_.has_value()) {
-      return if_->eof();
-    }
-    return cursor_ >= text_.size();
-  }
+  bool AtEof() const { return cursor_ >= view().size(); }
   char PeekCharOrDie() {
-    if (if_.has_value()) {
-      DCHECK(!if_->eof());
-      return if_->peek();
-    }
-    DCHECK_LT(cursor_, text_.size());
-    return text_[cursor_];
+    DCHECK_LT(cursor_, view().size());
+    return view()[cursor_];
   }
   char PopCharOrDie() {
     char c = PeekCharOrDie();
@@ -116,10 +102,16 @@ class CharStream {
   }
 
  private:
-  explicit CharStream(std::ifstream file_stream)
-      : if_(std::move(file_stream)) {}
+  explicit CharStream(FileMapping mapping) : mapping_(std::move(mapping)) {}
   explicit CharStream(std::string text) : text_(std::move(text)) {}
 
+  // The characters being scanned. Computed per call (rather than cached as a
+  // member) so moving the stream cannot leave a view dangling into the
+  // moved-from text buffer.
+  std::string_view view() const {
+    return mapping_.has_value() ? mapping_->data() : std::string_view(text_);
+  }
+
   void Unget(char c) {
     cursor_--;
     if (c == '\n') {
@@ -128,9 +120,6 @@ class CharStream {
     } else {
       pos_.colno--;
     }
-    if (if_.has_value()) {
-      if_->unget();
-    }
   }
 
   void BumpPos(char c) {
@@ -146,10 +135,10 @@ class CharStream {
 
   Pos pos_ = {0, 0};
 
-  // We have both ifstream mode and text mode data, we store both inline.
+  // We have both mapped-file mode and text mode data, we store both inline.
 
-  // ifstream mode
-  std::optional<std::ifstream> if_;
+  // mapped-file mode
+  std::optional<FileMapping> mapping_;
 
   // text mode
   std::string text_;
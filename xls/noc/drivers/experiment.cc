@@ -15,7 +15,9 @@
 #include "xls/noc/drivers/experiment.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,6 +31,7 @@
 #include "absl/types/variant.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/noc/simulation/common.h"
 #include "xls/noc/simulation/flit.h"
 #include "xls/noc/simulation/global_routing_table.h"
@@ -332,4 +335,47 @@ absl::StatusOr<ExperimentData> ExperimentRunner::RunExperiment(
   return experiment_data;
 }
 
+absl::StatusOr<std::vector<ExperimentData>> Experiment::RunAllSteps(
+    int64_t num_threads) const {
+  const int64_t step_count = GetStepCount();
+  if (num_threads <= 0) {
+    num_threads = AvailableCPUs();
+  }
+  num_threads = std::min(num_threads, step_count);
+
+  // Each step builds its own config, network graph, routing table, and
+  // simulator, so steps run concurrently without sharing state. Workers
+  // claim the next unfinished step until the sweep is exhausted.
+  std::vector<absl::StatusOr<ExperimentData>> results(
+      step_count, absl::InternalError("Step did not run."));
+  std::atomic<int64_t> next_step(0);
+  auto worker = [this, step_count, &results, &next_step]() {
+    while (true) {
+      int64_t step = next_step.fetch_add(1);
+      if (step >= step_count) {
+        return;
+      }
+      results[step] = RunStep(step);
+    }
+  };
+
+  std::vector<std::unique_ptr<Thread>> threads;
+  threads.reserve(num_threads - 1);
+  for (int64_t i = 1; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<Thread>(worker));
+  }
+  worker();
+  for (std::unique_ptr<Thread>& thread : threads) {
+    thread->Join();
+  }
+
+  std::vector<ExperimentData> data;
+  data.reserve(step_count);
+  for (absl::StatusOr<ExperimentData>& result : results) {
+    XLS_RETURN_IF_ERROR(result.status());
+    data.push_back(*std::move(result));
+  }
+  return data;
+}
+
 }  // namespace xls::noc
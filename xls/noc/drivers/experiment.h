@@ -295,6 +295,14 @@ class Experiment {
                                 std::move(distributed_routing_table_builder));
   }
 
+  // Runs every step of the experiment concurrently and returns each step's
+  // ExperimentData, indexed by step number. Steps are independent -- each
+  // builds its own config, network graph, routing table, and simulator -- so
+  // a sweep scales across threads. `num_threads` caps the number of steps in
+  // flight at once; a non-positive value uses the number of available CPUs.
+  absl::StatusOr<std::vector<ExperimentData>> RunAllSteps(
+      int64_t num_threads = 0) const;
+
   // Get the configuration for step N.
   absl::StatusOr<ExperimentConfig> GetConfigForStep(int64_t step) const {
     XLS_RET_CHECK(step >= 0 && step < GetStepCount());
@@ -164,6 +164,21 @@ TEST(ExperimentsTest, ExperimentSweeps) {
   }
 }
 
+TEST(ExperimentsTest, RunAllStepsPropagatesStepErrors) {
+  ExperimentFactory experiment_factory;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TestExperimentBuilder * builder,
+      experiment_factory.RegisterNewBuilder<TestExperimentBuilder>("Builder"));
+  (void)builder;
+  XLS_ASSERT_OK_AND_ASSIGN(Experiment experiment,
+                           experiment_factory.BuildExperiment("Builder"));
+
+  // The test builder's config has no network, so every step fails to build a
+  // network graph; the concurrent driver must surface the failure rather than
+  // drop it.
+  EXPECT_FALSE(experiment.RunAllSteps(/*num_threads=*/2).ok());
+}
+
 TEST(ExperimentsTest, ExperimentMetrics) {
   ExperimentMetrics metrics;
   XLS_EXPECT_OK(metrics.DebugDump());
@@ -98,23 +98,49 @@ absl::Status PortIndexMapBuilder::SetPortIndex(PortId port_id,
   return absl::OkStatus();
 }
 
+const PortIndexMap::PortOrder* PortIndexMap::GetPortOrder(
+    NetworkComponentId nc_id) const {
+  int64_t network = nc_id.network();
+  int64_t component = nc_id.id();
+  if (network >= nc_to_ports_.size() ||
+      component >= nc_to_ports_[network].size() ||
+      !nc_to_ports_[network][component].indexed) {
+    return nullptr;
+  }
+  return &nc_to_ports_[network][component];
+}
+
+PortIndexMap::PortOrder& PortIndexMap::GetOrCreatePortOrder(
+    NetworkComponentId nc_id) {
+  int64_t network = nc_id.network();
+  int64_t component = nc_id.id();
+  if (network >= nc_to_ports_.size()) {
+    nc_to_ports_.resize(network + 1);
+  }
+  if (component >= nc_to_ports_[network].size()) {
+    nc_to_ports_[network].resize(component + 1);
+  }
+  PortOrder& port_order = nc_to_ports_[network][component];
+  port_order.indexed = true;
+  return port_order;
+}
+
 absl::StatusOr<int64_t> PortIndexMap::GetPortIndex(PortId port_id,
                                                    PortDirection dir) const {
   NetworkComponentId nc_id = port_id.GetNetworkComponentId();
-  if (!nc_to_ports_.contains(nc_id)) {
+  const PortOrder* port_order = GetPortOrder(nc_id);
+  if (port_order == nullptr) {
     return absl::OutOfRangeError(absl::StrFormat(
         "Network Component %d has not been indexed", nc_id.AsUInt64()));
   }
 
-  const std::vector<PortId>& port_index =
-      dir == PortDirection::kInput
-          ? nc_to_ports_.at(nc_id).ordered_input_ports
-          : nc_to_ports_.at(nc_id).ordered_output_ports;
+  const std::vector<int64_t>& index_of_port =
+      dir == PortDirection::kInput ? port_order->input_index_of_port
+                                   : port_order->output_index_of_port;
 
-  for (int64_t i = 0; i < port_index.size(); ++i) {
-    if (port_index[i] == port_id) {
-      return i;
-    }
+  int64_t local_id = port_id.id();
+  if (local_id < index_of_port.size() && index_of_port[local_id] >= 0) {
+    return index_of_port[local_id];
   }
 
   return absl::OutOfRangeError(
@@ -162,47 +188,65 @@ absl::StatusOr<PortIndexMap> PortIndexMapBuilder::BuildPortIndex() {
 absl::Status PortIndexMap::Add(
     NetworkComponentId nc_id, PortDirection dir,
     absl::Span<const std::pair<PortId, int64_t>> port_index) {
-  std::vector<PortId>* ordered_ports =
-      dir == PortDirection::kInput ? &nc_to_ports_[nc_id].ordered_input_ports
-                                   : &nc_to_ports_[nc_id].ordered_output_ports;
+  PortOrder& port_order = GetOrCreatePortOrder(nc_id);
+  std::vector<PortId>* ordered_ports = dir == PortDirection::kInput
+                                           ? &port_order.ordered_input_ports
+                                           : &port_order.ordered_output_ports;
 
   XLS_ASSIGN_OR_RETURN(*ordered_ports,
                        ConstructOrderedIndex<PortId>("port", port_index));
+
+  // Build the reverse table mapping a port's local id to its index so that
+  // GetPortIndex() is a direct lookup.
+  std::vector<int64_t>* index_of_port = dir == PortDirection::kInput
+                                            ? &port_order.input_index_of_port
+                                            : &port_order.output_index_of_port;
+  index_of_port->clear();
+  for (int64_t i = 0; i < ordered_ports->size(); ++i) {
+    int64_t local_id = ordered_ports->at(i).id();
+    if (local_id >= index_of_port->size()) {
+      index_of_port->resize(local_id + 1, -1);
+    }
+    index_of_port->at(local_id) = i;
+  }
+
   return absl::OkStatus();
 }
 
 absl::StatusOr<int64_t> PortIndexMap::InputPortCount(
     NetworkComponentId nc_id) const {
-  if (!nc_to_ports_.contains(nc_id)) {
+  const PortOrder* port_order = GetPortOrder(nc_id);
+  if (port_order == nullptr) {
     return absl::OutOfRangeError(absl::StrFormat(
         "PortIndexMap did not index network component %x", nc_id.AsUInt64()));
   }
 
-  return nc_to_ports_.at(nc_id).ordered_input_ports.size();
+  return port_order->ordered_input_ports.size();
 }
 
 absl::StatusOr<int64_t> PortIndexMap::OutputPortCount(
     NetworkComponentId nc_id) const {
-  if (!nc_to_ports_.contains(nc_id)) {
+  const PortOrder* port_order = GetPortOrder(nc_id);
+  if (port_order == nullptr) {
     return absl::OutOfRangeError(absl::StrFormat(
         "PortIndexMap did not index network component %x", nc_id.AsUInt64()));
   }
 
-  return nc_to_ports_.at(nc_id).ordered_output_ports.size();
+  return port_order->ordered_output_ports.size();
 }
 
 absl::StatusOr<PortId> PortIndexMap::GetPortByIndex(NetworkComponentId nc_id,
                                                     PortDirection dir,
                                                     int64_t port_index) const {
-  if (!nc_to_ports_.contains(nc_id)) {
+  const PortOrder* port_order = GetPortOrder(nc_id);
+  if (port_order == nullptr) {
     return absl::OutOfRangeError(absl::StrFormat(
         "PortIndexMap did not index network component %x", nc_id.AsUInt64()));
   }
 
   const std::vector<PortId>& ordered_ports =
-      dir == PortDirection::kInput
-          ? nc_to_ports_.at(nc_id).ordered_input_ports
-          : nc_to_ports_.at(nc_id).ordered_output_ports;
+      dir == PortDirection::kInput ? port_order->ordered_input_ports
+                                   : port_order->ordered_output_ports;
 
   if (port_index >= ordered_ports.size() || port_index < 0) {
     return absl::OutOfRangeError(
@@ -223,14 +267,48 @@ absl::StatusOr<int64_t> VirtualChannelIndexMapBuilder::VirtualChannelCount(
   return port_to_vcs_.at(port_id).param_vc_index.size();
 }
 
+const VirtualChannelIndexMap::VirtualChannelOrder*
+VirtualChannelIndexMap::GetVirtualChannelOrder(PortId port_id) const {
+  int64_t network = port_id.network();
+  int64_t component = port_id.component();
+  int64_t local_id = port_id.id();
+  if (network >= port_to_vcs_.size() ||
+      component >= port_to_vcs_[network].size() ||
+      local_id >= port_to_vcs_[network][component].size() ||
+      !port_to_vcs_[network][component][local_id].indexed) {
+    return nullptr;
+  }
+  return &port_to_vcs_[network][component][local_id];
+}
+
+VirtualChannelIndexMap::VirtualChannelOrder&
+VirtualChannelIndexMap::GetOrCreateVirtualChannelOrder(PortId port_id) {
+  int64_t network = port_id.network();
+  int64_t component = port_id.component();
+  int64_t local_id = port_id.id();
+  if (network >= port_to_vcs_.size()) {
+    port_to_vcs_.resize(network + 1);
+  }
+  if (component >= port_to_vcs_[network].size()) {
+    port_to_vcs_[network].resize(component + 1);
+  }
+  if (local_id >= port_to_vcs_[network][component].size()) {
+    port_to_vcs_[network][component].resize(local_id + 1);
+  }
+  VirtualChannelOrder& vc_order = port_to_vcs_[network][component][local_id];
+  vc_order.indexed = true;
+  return vc_order;
+}
+
 absl::StatusOr<int64_t> VirtualChannelIndexMap::VirtualChannelCount(
     PortId port_id) const {
-  if (!port_to_vcs_.contains(port_id)) {
+  const VirtualChannelOrder* vc_order = GetVirtualChannelOrder(port_id);
+  if (vc_order == nullptr) {
     return absl::OutOfRangeError(
         absl::StrFormat("Port %x has not been indexed", port_id.AsUInt64()));
   }
 
-  return port_to_vcs_.at(port_id).size();
+  return vc_order->ordered_vcs.size();
 }
 
 absl::Status VirtualChannelIndexMapBuilder::SetVirtualChannelIndex(
@@ -295,13 +373,14 @@ absl::StatusOr<int64_t> VirtualChannelIndexMap::GetVirtualChannelIndex(
 
 absl::StatusOr<int64_t> VirtualChannelIndexMap::GetVirtualChannelIndexByName(
     PortId port_id, std::string_view vc_name) const {
-  if (!port_to_vcs_.contains(port_id)) {
+  const VirtualChannelOrder* vc_order = GetVirtualChannelOrder(port_id);
+  if (vc_order == nullptr) {
     return absl::OutOfRangeError(
         absl::StrFormat("Port %d has not been indexed", port_id.AsUInt64()));
   }
 
   const std::vector<VirtualChannelParam>& virtual_channel_index =
-      port_to_vcs_.at(port_id);
+      vc_order->ordered_vcs;
   for (int64_t i = 0; i < virtual_channel_index.size(); ++i) {
     if (virtual_channel_index[i].GetName() == vc_name) {
       return i;
@@ -332,10 +411,11 @@ VirtualChannelIndexMapBuilder::BuildVirtualChannelIndex() const {
 absl::Status VirtualChannelIndexMap::Add(
     PortId port_id,
     absl::Span<const std::pair<VirtualChannelParam, int64_t>> vc_index) {
-  std::vector<VirtualChannelParam>& ordered_vc = port_to_vcs_[port_id];
+  VirtualChannelOrder& vc_order = GetOrCreateVirtualChannelOrder(port_id);
 
-  XLS_ASSIGN_OR_RETURN(ordered_vc, ConstructOrderedIndex<VirtualChannelParam>(
-                                       "virtual channel", vc_index));
+  XLS_ASSIGN_OR_RETURN(vc_order.ordered_vcs,
+                       ConstructOrderedIndex<VirtualChannelParam>(
+                           "virtual channel", vc_index));
 
   return absl::OkStatus();
 }
@@ -343,13 +423,14 @@ absl::Status VirtualChannelIndexMap::Add(
 absl::StatusOr<VirtualChannelParam>
 VirtualChannelIndexMap::GetVirtualChannelByIndex(PortId port_id,
                                                  int64_t vc_index) const {
-  if (!port_to_vcs_.contains(port_id)) {
+  const VirtualChannelOrder* vc_order = GetVirtualChannelOrder(port_id);
+  if (vc_order == nullptr) {
     return absl::OutOfRangeError(
         absl::StrFormat("Port %d has not been indexed", port_id.AsUInt64()));
   }
 
   const std::vector<VirtualChannelParam>& ordered_virtual_channels =
-      port_to_vcs_.at(port_id);
+      vc_order->ordered_vcs;
 
   if (vc_index >= ordered_virtual_channels.size() || vc_index < 0) {
     return absl::OutOfRangeError(absl::StrFormat(
@@ -68,11 +68,28 @@ class PortIndexMap {
  private:
   // Stores ordering of a particular network component's ports.
   struct PortOrder {
+    bool indexed = false;
     std::vector<PortId> ordered_input_ports;
     std::vector<PortId> ordered_output_ports;
+    // Position of each port -- indexed by the port's local id -- within the
+    // ordered vectors above; -1 when the port is not indexed in that
+    // direction.
+    std::vector<int64_t> input_index_of_port;
+    std::vector<int64_t> output_index_of_port;
   };
 
-  absl::flat_hash_map<NetworkComponentId, PortOrder> nc_to_ports_;
+  // Returns the port order of the component, or nullptr if the component has
+  // not been indexed.
+  const PortOrder* GetPortOrder(NetworkComponentId nc_id) const;
+
+  // Returns the port order of the component, growing the tables as needed.
+  PortOrder& GetOrCreatePortOrder(NetworkComponentId nc_id);
+
+  // Port orders stored contiguously, indexed by the dense
+  // [network id][component id] ordinals NetworkManager assigns sequentially.
+  // The simulator resolves port indices per flit, so the lookups avoid
+  // hashing.
+  std::vector<std::vector<PortOrder>> nc_to_ports_;
 };
 
 // Used to construct a PortIndexMap object.
@@ -134,9 +151,24 @@ class VirtualChannelIndexMap {
 
  private:
   // Stores ordering of a particular port's virtual channels.
-  using VirtualChannelOrder = std::vector<VirtualChannelParam>;
+  struct VirtualChannelOrder {
+    bool indexed = false;
+    std::vector<VirtualChannelParam> ordered_vcs;
+  };
 
-  absl::flat_hash_map<PortId, VirtualChannelOrder> port_to_vcs_;
+  // Returns the virtual channel order of the port, or nullptr if the port has
+  // not been indexed.
+  const VirtualChannelOrder* GetVirtualChannelOrder(PortId port_id) const;
+
+  // Returns the virtual channel order of the port, growing the tables as
+  // needed.
+  VirtualChannelOrder& GetOrCreateVirtualChannelOrder(PortId port_id);
+
+  // Virtual channel orders stored contiguously, indexed by the dense
+  // [network id][component id][port id] ordinals NetworkManager assigns
+  // sequentially.  The simulator resolves virtual channel indices per flit,
+  // so the lookups avoid hashing.
+  std::vector<std::vector<std::vector<VirtualChannelOrder>>> port_to_vcs_;
 };
 
 class VirtualChannelIndexMapBuilder {
@@ -267,13 +267,45 @@ absl::Status NocSimulator::RunCycle(int64_t max_ticks) {
     XLS_RET_CHECK_OK(svc->RunCycle());
   }
 
-  bool converged = false;
+  // Every component must be ticked at least once per cycle so that the
+  // connections attached to it are stamped with the new cycle. After that
+  // initial sweep, only components which have not yet converged are re-ticked;
+  // in a mostly-idle network nearly every component converges on its first
+  // tick, so each additional tick only visits the components with flits or
+  // credits still in flight.
+  std::vector<SimNetworkComponentBase*> unconverged;
+  unconverged.reserve(network_interface_sources_.size() + links_.size() +
+                      routers_.size() + network_interface_sinks_.size());
+  for (SimNetworkInterfaceSrc& nc : network_interface_sources_) {
+    unconverged.push_back(&nc);
+  }
+  for (SimLink& nc : links_) {
+    unconverged.push_back(&nc);
+  }
+  for (SimInputBufferedVCRouter& nc : routers_) {
+    unconverged.push_back(&nc);
+  }
+  for (SimNetworkInterfaceSink& nc : network_interface_sinks_) {
+    unconverged.push_back(&nc);
+  }
+
   int64_t nticks = 0;
-  while (!converged) {
+  while (!unconverged.empty()) {
     VLOG(2) << absl::StreamFormat("Tick %d", nticks);
-    converged = Tick();
+
+    std::vector<SimNetworkComponentBase*> still_unconverged;
+    for (SimNetworkComponentBase* nc : unconverged) {
+      bool this_converged = nc->Tick(*this);
+      VLOG(2) << absl::StreamFormat(" NC %x Converged %d",
+                                    nc->GetId().AsUInt64(), this_converged);
+      if (!this_converged) {
+        still_unconverged.push_back(nc);
+      }
+    }
+    unconverged = std::move(still_unconverged);
+
     ++nticks;
-    if (nticks >= max_ticks) {
+    if (!unconverged.empty() && nticks >= max_ticks) {
       return absl::InternalError(absl::StrFormat(
           "Simulator unable to converge after %d ticks for cycle %d", nticks,
           cycle_));
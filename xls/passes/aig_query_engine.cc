@@ -0,0 +1,318 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/aig_query_engine.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/data_structures/and_inverter_graph.h"
+#include "xls/ir/abstract_evaluator.h"
+#include "xls/ir/abstract_node_evaluator.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/bits_ops.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/op.h"
+#include "xls/ir/ternary.h"
+#include "xls/ir/topo_sort.h"
+#include "xls/passes/bdd_query_engine.h"
+#include "xls/passes/query_engine.h"
+
+namespace xls {
+namespace {
+
+// An abstract evaluator whose primitive bit element is an AIG literal.
+class AigEvaluator : public AbstractEvaluator<AigLiteral, AigEvaluator> {
+ public:
+  explicit AigEvaluator(AndInverterGraph* aig) : aig_(aig) {}
+
+  AigLiteral One() const { return aig_->one(); }
+  AigLiteral Zero() const { return aig_->zero(); }
+  AigLiteral Not(const AigLiteral& input) const { return aig_->Not(input); }
+  AigLiteral And(const AigLiteral& a, const AigLiteral& b) const {
+    return aig_->And(a, b);
+  }
+  AigLiteral Or(const AigLiteral& a, const AigLiteral& b) const {
+    return aig_->Or(a, b);
+  }
+
+ private:
+  AndInverterGraph* aig_;
+};
+
+}  // namespace
+
+absl::Status AigQueryEngine::EvaluateNode(Node* node) {
+  if (!node->GetType()->IsBits() || node_map_.contains(node)) {
+    return absl::OkStatus();
+  }
+
+  // Create and return a vector containing newly defined AIG variables.
+  auto create_new_node_vector = [&](Node* n) {
+    std::vector<AigLiteral> v(n->BitCountOrDie());
+    for (int64_t i = 0; i < n->BitCountOrDie(); ++i) {
+      v[i] = aig_->NewVariable();
+    }
+    return v;
+  };
+
+  // If the graph has grown past the node budget, or the node includes some
+  // non-bits-typed operands, model the node's bits as fresh variables.
+  // Otherwise evaluate the node's gates into the AIG; unhandled operations
+  // (params, receives, etc.) fall through to fresh variables via the default
+  // handler.
+  if (aig_->node_count() > node_limit_ ||
+      std::any_of(node->operands().begin(), node->operands().end(),
+                  [](Node* o) { return !o->GetType()->IsBits(); })) {
+    node_map_[node] = create_new_node_vector(node);
+    return absl::OkStatus();
+  }
+
+  AigEvaluator evaluator(aig_.get());
+  std::vector<std::vector<AigLiteral>> operand_values;
+  operand_values.reserve(node->operand_count());
+  for (Node* operand : node->operands()) {
+    operand_values.push_back(node_map_.at(operand));
+  }
+  XLS_ASSIGN_OR_RETURN(
+      node_map_[node],
+      AbstractEvaluate(node, operand_values, &evaluator,
+                       /*default_handler=*/create_new_node_vector));
+  return absl::OkStatus();
+}
+
+absl::StatusOr<ReachedFixpoint> AigQueryEngine::Populate(FunctionBase* f) {
+  // Rebuild the graph from scratch if the IR changed since the last Populate
+  // call; otherwise reuse the memoized literals.
+  if (aig_ == nullptr || populated_function_base_ != f ||
+      f->transform_version() != populated_transform_version_) {
+    aig_ = std::make_unique<AndInverterGraph>();
+    node_map_.clear();
+    populated_function_base_ = f;
+    populated_transform_version_ = f->transform_version();
+    for (Node* node : TopoSort(f)) {
+      XLS_RETURN_IF_ERROR(EvaluateNode(node));
+    }
+    VLOG(2) << "AIG for " << f->name() << " has " << aig_->node_count()
+            << " nodes";
+  }
+
+  ReachedFixpoint rf = ReachedFixpoint::Unchanged;
+  for (Node* node : f->nodes()) {
+    if (!node->GetType()->IsBits()) {
+      continue;
+    }
+    absl::InlinedVector<bool, 1> known_bits;
+    absl::InlinedVector<bool, 1> bits_values;
+    for (int64_t i = 0; i < node->BitCountOrDie(); ++i) {
+      AigLiteral literal = GetLiteral(TreeBitLocation(node, i));
+      known_bits.push_back(literal == aig_->zero() || literal == aig_->one());
+      bits_values.push_back(literal == aig_->one());
+    }
+    if (!known_bits_.contains(node)) {
+      known_bits_[node] = Bits(known_bits.size());
+      bits_values_[node] = Bits(bits_values.size());
+    }
+    Bits ored_known_bits = bits_ops::Or(known_bits_[node], Bits(known_bits));
+    Bits ored_bits_values = bits_ops::Or(bits_values_[node], Bits(bits_values));
+    if (ored_known_bits != known_bits_[node] ||
+        ored_bits_values != bits_values_[node]) {
+      rf = ReachedFixpoint::Changed;
+    }
+    known_bits_[node] = ored_known_bits;
+    bits_values_[node] = ored_bits_values;
+  }
+  return rf;
+}
+
+LeafTypeTree<TernaryVector> AigQueryEngine::GetTernary(Node* node) const {
+  CHECK(node->GetType()->IsBits());
+  TernaryVector ternary =
+      ternary_ops::FromKnownBits(known_bits_.at(node), bits_values_.at(node));
+  LeafTypeTree<TernaryVector> result(node->GetType());
+  result.Set({}, ternary);
+  return result;
+}
+
+bool AigQueryEngine::AtMostOneTrue(
+    absl::Span<TreeBitLocation const> bits) const {
+  // Computing this property is quadratic (at least) so limit the width.
+  const int64_t kMaxWidth = 64;
+  if (bits.size() > kMaxWidth) {
+    return false;
+  }
+  for (const TreeBitLocation& loc : bits) {
+    if (!IsTracked(loc.node())) {
+      return false;
+    }
+  }
+
+  // Compute the OR-reduction of a pairwise AND of all bits. If this value
+  // simplifies to zero then no two bits can be simultaneously true.
+  AigLiteral result = mutable_aig().zero();
+  for (int64_t i = 0; i < bits.size(); ++i) {
+    for (int64_t j = i + 1; j < bits.size(); ++j) {
+      result = mutable_aig().Or(
+          result, mutable_aig().And(GetLiteral(bits[i]), GetLiteral(bits[j])));
+    }
+  }
+  return result == mutable_aig().zero();
+}
+
+bool AigQueryEngine::AtLeastOneTrue(
+    absl::Span<TreeBitLocation const> bits) const {
+  // At least one bit is true is equivalent to an OR-reduction of all the bits.
+  AigLiteral result = mutable_aig().zero();
+  for (const TreeBitLocation& location : bits) {
+    if (!IsTracked(location.node())) {
+      return false;
+    }
+    result = mutable_aig().Or(result, GetLiteral(location));
+  }
+  return result == mutable_aig().one();
+}
+
+bool AigQueryEngine::Implies(const TreeBitLocation& a,
+                             const TreeBitLocation& b) const {
+  if (!IsTracked(a.node()) || !IsTracked(b.node())) {
+    return false;
+  }
+  return mutable_aig().Implies(GetLiteral(a), GetLiteral(b));
+}
+
+std::optional<Bits> AigQueryEngine::ImpliedNodeValue(
+    absl::Span<const std::pair<TreeBitLocation, bool>> predicate_bit_values,
+    Node* node) const {
+  if (!IsTracked(node) || !node->GetType()->IsBits()) {
+    return std::nullopt;
+  }
+
+  // Build the conjunction of the predicate bits.
+  AigLiteral predicate = mutable_aig().one();
+  for (const auto& [bit_location, value] : predicate_bit_values) {
+    AigLiteral bit = GetLiteral(bit_location);
+    predicate =
+        mutable_aig().And(predicate, value ? bit : mutable_aig().Not(bit));
+  }
+  // If the predicate simplifies to false we can't determine what node value
+  // it implies.
+  if (predicate == mutable_aig().zero()) {
+    return std::nullopt;
+  }
+
+  BitsRope bit_rope(node->BitCountOrDie());
+  for (int64_t i = 0; i < node->BitCountOrDie(); ++i) {
+    AigLiteral bit = GetLiteral(TreeBitLocation(node, i));
+    if (mutable_aig().Implies(predicate, bit)) {
+      bit_rope.push_back(true);
+    } else if (mutable_aig().Implies(predicate, mutable_aig().Not(bit))) {
+      bit_rope.push_back(false);
+    } else {
+      return std::nullopt;
+    }
+  }
+  return bit_rope.Build();
+}
+
+bool AigQueryEngine::KnownEquals(const TreeBitLocation& a,
+                                 const TreeBitLocation& b) const {
+  if (!IsTracked(a.node()) || !IsTracked(b.node())) {
+    return false;
+  }
+  // Simulation signatures cheaply refute equivalence; structural identity
+  // (equal literals, courtesy of the unique table) is the only proof.
+  if (!aig().MayBeEquivalent(GetLiteral(a), GetLiteral(b))) {
+    return false;
+  }
+  return GetLiteral(a) == GetLiteral(b);
+}
+
+bool AigQueryEngine::KnownNotEquals(const TreeBitLocation& a,
+                                    const TreeBitLocation& b) const {
+  if (!IsTracked(a.node()) || !IsTracked(b.node())) {
+    return false;
+  }
+  return GetLiteral(a) == aig().Not(GetLiteral(b));
+}
+
+bool IsWideDatapath(FunctionBase* f, int64_t bit_count_threshold) {
+  auto is_datapath_op = [](Op op) {
+    switch (op) {
+      case Op::kAdd:
+      case Op::kSub:
+      case Op::kNeg:
+      case Op::kUMul:
+      case Op::kSMul:
+      case Op::kUDiv:
+      case Op::kSDiv:
+      case Op::kUMod:
+      case Op::kSMod:
+      case Op::kEq:
+      case Op::kNe:
+      case Op::kUGt:
+      case Op::kUGe:
+      case Op::kULt:
+      case Op::kULe:
+      case Op::kSGt:
+      case Op::kSGe:
+      case Op::kSLt:
+      case Op::kSLe:
+      case Op::kShll:
+      case Op::kShrl:
+      case Op::kShra:
+        return true;
+      default:
+        return false;
+    }
+  };
+  for (Node* node : f->nodes()) {
+    if (!is_datapath_op(node->op())) {
+      continue;
+    }
+    // Comparisons are single-bit results; consider the operand widths as well.
+    int64_t width =
+        node->GetType()->IsBits() ? node->BitCountOrDie() : int64_t{0};
+    for (Node* operand : node->operands()) {
+      if (operand->GetType()->IsBits()) {
+        width = std::max(width, operand->BitCountOrDie());
+      }
+    }
+    if (width >= bit_count_threshold) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::unique_ptr<QueryEngine> CreateBitLevelQueryEngine(
+    FunctionBase* f, int64_t bdd_path_limit) {
+  if (IsWideDatapath(f)) {
+    return std::make_unique<AigQueryEngine>();
+  }
+  return std::make_unique<BddQueryEngine>(bdd_path_limit);
+}
+
+}  // namespace xls
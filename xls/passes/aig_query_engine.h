@@ -0,0 +1,129 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_AIG_QUERY_ENGINE_H_
+#define XLS_PASSES_AIG_QUERY_ENGINE_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/data_structures/and_inverter_graph.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/passes/query_engine.h"
+
+namespace xls {
+
+// A query engine which represents each bit of an XLS function as a literal in
+// an and-inverter graph (AIG). In contrast to BddQueryEngine, the AIG grows
+// linearly with the gate count of the evaluated expressions, so wide
+// arithmetic and comparison operations are evaluated rather than skipped or
+// truncated by path limits. The tradeoff is weaker deduction: the AIG is not
+// canonical, so only structurally identical expressions (after hashing and
+// local simplification) are recognized as equivalent, and simulation
+// signatures are used to cheaply refute equivalence. No SAT-based proving is
+// performed.
+class AigQueryEngine : public QueryEngine {
+ public:
+  // The default limit on the total number of AIG nodes. Nodes evaluated after
+  // the graph reaches this size are modeled as fresh variables.
+  static constexpr int64_t kDefaultNodeLimit = 8 * 1024 * 1024;
+
+  explicit AigQueryEngine(int64_t node_limit = kDefaultNodeLimit)
+      : node_limit_(node_limit) {}
+
+  absl::StatusOr<ReachedFixpoint> Populate(FunctionBase* f) override;
+
+  bool IsTracked(Node* node) const override {
+    return known_bits_.contains(node);
+  }
+
+  LeafTypeTree<TernaryVector> GetTernary(Node* node) const override;
+
+  bool AtMostOneTrue(absl::Span<TreeBitLocation const> bits) const override;
+  bool AtLeastOneTrue(absl::Span<TreeBitLocation const> bits) const override;
+  bool Implies(const TreeBitLocation& a,
+               const TreeBitLocation& b) const override;
+  std::optional<Bits> ImpliedNodeValue(
+      absl::Span<const std::pair<TreeBitLocation, bool>> predicate_bit_values,
+      Node* node) const override;
+  bool KnownEquals(const TreeBitLocation& a,
+                   const TreeBitLocation& b) const override;
+  bool KnownNotEquals(const TreeBitLocation& a,
+                      const TreeBitLocation& b) const override;
+
+  // Returns the underlying AIG representing the XLS function.
+  const AndInverterGraph& aig() const { return *aig_; }
+
+ private:
+  // Returns the underlying AIG. This method is const, but queries on the AIG
+  // may create nodes. As with BddQueryEngine, conflicts with C++ const are
+  // avoided because the graph is only held indirectly via a pointer.
+  AndInverterGraph& mutable_aig() const { return *aig_; }
+
+  // Returns the AIG literal associated with the given bit.
+  AigLiteral GetLiteral(const TreeBitLocation& location) const {
+    CHECK(location.tree_index().empty());
+    CHECK(location.node()->GetType()->IsBits());
+    return node_map_.at(location.node()).at(location.bit_index());
+  }
+
+  // Evaluates `node`, associating an AIG literal with each output bit.
+  // Operands must already be evaluated.
+  absl::Status EvaluateNode(Node* node);
+
+  // The maximum total number of AIG nodes before remaining expressions are
+  // modeled as fresh variables.
+  int64_t node_limit_;
+
+  // Transform version of the FunctionBase when the AIG was last built. Used to
+  // reuse the graph across Populate calls when the IR is unchanged.
+  int64_t populated_transform_version_ = -1;
+  FunctionBase* populated_function_base_ = nullptr;
+
+  // Indicates the bits at the output of each node which have known values.
+  absl::flat_hash_map<Node*, Bits> known_bits_;
+
+  // Indicates the values of bits at the output of each node (if known).
+  absl::flat_hash_map<Node*, Bits> bits_values_;
+
+  // The AIG literals of each bit of each evaluated node.
+  absl::flat_hash_map<Node*, std::vector<AigLiteral>> node_map_;
+
+  std::unique_ptr<AndInverterGraph> aig_;
+};
+
+// Returns true if `f` contains wide-datapath operations (arithmetic,
+// comparison, or shift nodes of at least `bit_count_threshold` bits) for which
+// BDD-based analysis typically saturates its path limit and yields little
+// information.
+bool IsWideDatapath(FunctionBase* f, int64_t bit_count_threshold = 128);
+
+// Returns a bit-level query engine appropriate for `f`: an AigQueryEngine for
+// wide-datapath functions (per IsWideDatapath), otherwise a BddQueryEngine
+// with the given path limit. The returned engine is not yet populated.
+std::unique_ptr<QueryEngine> CreateBitLevelQueryEngine(
+    FunctionBase* f, int64_t bdd_path_limit = 1024);
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_AIG_QUERY_ENGINE_H_
@@ -0,0 +1,149 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/aig_query_engine.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/package.h"
+#include "xls/passes/bdd_query_engine.h"
+#include "xls/passes/query_engine.h"
+
+namespace xls {
+namespace {
+
+class AigQueryEngineTest : public IrTestBase {
+ protected:
+  // Convenience methods for testing implication, equality, and inverse for
+  // single-bit node values.
+  bool Implies(const QueryEngine& engine, Node* a, Node* b) {
+    return engine.Implies(TreeBitLocation(a, 0), TreeBitLocation(b, 0));
+  }
+  bool KnownEquals(const QueryEngine& engine, Node* a, Node* b) {
+    return engine.KnownEquals(TreeBitLocation(a, 0), TreeBitLocation(b, 0));
+  }
+  bool KnownNotEquals(const QueryEngine& engine, Node* a, Node* b) {
+    return engine.KnownNotEquals(TreeBitLocation(a, 0), TreeBitLocation(b, 0));
+  }
+};
+
+TEST_F(AigQueryEngineTest, KnownBitsThroughWideArithmetic) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(512));
+  // x + 0 == x, so the sum's bits are the same literals as x's and the
+  // comparison is known true despite the 512-bit datapath.
+  BValue sum = fb.Add(x, fb.Literal(UBits(0, 512)));
+  BValue zero = fb.Literal(UBits(0, 512));
+  BValue x_and_0 = fb.And(x, zero);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  AigQueryEngine query_engine;
+  XLS_ASSERT_OK(query_engine.Populate(f).status());
+
+  EXPECT_TRUE(query_engine.IsAllZeros(x_and_0.node()));
+  for (int64_t i = 0; i < 512; ++i) {
+    EXPECT_TRUE(query_engine.KnownEquals(TreeBitLocation(sum.node(), i),
+                                         TreeBitLocation(x.node(), i)));
+  }
+}
+
+TEST_F(AigQueryEngineTest, StructurallyIdenticalExpressions) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(256));
+  BValue y = fb.Param("y", p->GetBitsType(256));
+  BValue x_eq_y = fb.Eq(x, y);
+  BValue x_eq_y_2 = fb.Eq(x, y);
+  BValue x_ne_y = fb.Not(x_eq_y);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  AigQueryEngine query_engine;
+  XLS_ASSERT_OK(query_engine.Populate(f).status());
+
+  EXPECT_TRUE(KnownEquals(query_engine, x_eq_y.node(), x_eq_y_2.node()));
+  EXPECT_TRUE(KnownNotEquals(query_engine, x_eq_y.node(), x_ne_y.node()));
+  EXPECT_FALSE(KnownEquals(query_engine, x_eq_y.node(), x_ne_y.node()));
+
+  EXPECT_TRUE(Implies(query_engine, x_eq_y.node(), x_eq_y_2.node()));
+  EXPECT_TRUE(
+      query_engine.AtLeastOneNodeTrue({x_eq_y.node(), x_ne_y.node()}));
+  EXPECT_TRUE(query_engine.AtMostOneNodeTrue({x_eq_y.node(), x_ne_y.node()}));
+}
+
+TEST_F(AigQueryEngineTest, ImpliedNodeValue) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue pred = fb.And(fb.BitSlice(x, 0, 1), fb.BitSlice(x, 1, 1));
+  BValue low_bits = fb.BitSlice(x, 0, 2);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  AigQueryEngine query_engine;
+  XLS_ASSERT_OK(query_engine.Populate(f).status());
+
+  EXPECT_EQ(query_engine.ImpliedNodeValue(
+                {{TreeBitLocation(pred.node(), 0), true}}, low_bits.node()),
+            UBits(3, 2));
+}
+
+TEST_F(AigQueryEngineTest, NonBitsTypedOperandsAreFreshVariables) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue tuple = fb.Tuple({x});
+  BValue element = fb.TupleIndex(tuple, 0);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  AigQueryEngine query_engine;
+  XLS_ASSERT_OK(query_engine.Populate(f).status());
+
+  // The tuple index is modeled as fresh variables; nothing is known about it
+  // but queries must be well-formed.
+  EXPECT_TRUE(query_engine.IsTracked(element.node()));
+  EXPECT_FALSE(query_engine.KnownEquals(TreeBitLocation(element.node(), 0),
+                                        TreeBitLocation(x.node(), 0)));
+}
+
+TEST_F(AigQueryEngineTest, AutomaticEngineSelection) {
+  auto p = CreatePackage();
+
+  FunctionBuilder wide_fb("wide_func", p.get());
+  BValue wx = wide_fb.Param("x", p->GetBitsType(512));
+  wide_fb.UMul(wx, wx);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * wide_f, wide_fb.Build());
+
+  FunctionBuilder narrow_fb("narrow_func", p.get());
+  BValue nx = narrow_fb.Param("x", p->GetBitsType(8));
+  narrow_fb.Add(nx, nx);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * narrow_f, narrow_fb.Build());
+
+  EXPECT_TRUE(IsWideDatapath(wide_f));
+  EXPECT_FALSE(IsWideDatapath(narrow_f));
+
+  std::unique_ptr<QueryEngine> wide_engine =
+      CreateBitLevelQueryEngine(wide_f);
+  EXPECT_NE(dynamic_cast<AigQueryEngine*>(wide_engine.get()), nullptr);
+
+  std::unique_ptr<QueryEngine> narrow_engine =
+      CreateBitLevelQueryEngine(narrow_f);
+  EXPECT_NE(dynamic_cast<BddQueryEngine*>(narrow_engine.get()), nullptr);
+}
+
+}  // namespace
+}  // namespace xls
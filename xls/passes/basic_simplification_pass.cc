@@ -18,7 +18,7 @@
 #include <functional>
 #include <vector>
 
-#include "absl/log/check.h"
+#include "absl/base/no_destructor.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
 #include "xls/common/status/ret_check.h"
@@ -35,174 +35,164 @@
 #include "xls/passes/optimization_pass.h"
 #include "xls/passes/optimization_pass_registry.h"
 #include "xls/passes/pass_base.h"
+#include "xls/passes/rewrite_rule_set.h"
 #include "xls/passes/stateless_query_engine.h"
 
 namespace xls {
 namespace {
 
-// Return true iff `node` is an node for which op(x, x) == true.
-bool IsBinaryReflexiveRelation(Node* node) {
-  switch (node->op()) {
-    case Op::kEq:
-    case Op::kSGe:
-    case Op::kUGe:
-    case Op::kSLe:
-    case Op::kULe:
+// Returns true if all operands of 'node' are the same.
+bool AllOperandsSame(Node* node) {
+  StatelessQueryEngine query_engine;
+  return std::all_of(node->operands().begin(), node->operands().end(),
+                     [node, &query_engine](Node* op) {
+                       return query_engine.NodesKnownUnsignedEquals(
+                           op, node->operand(0));
+                     });
+}
+
+// Returns true if one of `node`'s operands also appears inverted in the
+// operands of `node`.
+bool HasInvertedOperand(Node* node) {
+  for (Node* operand : node->operands()) {
+    if (operand->op() == Op::kNot &&
+        std::find(node->operands().begin(), node->operands().end(),
+                  operand->operand(0)) != node->operands().end()) {
       return true;
-    default:
-      return false;
+    }
   }
+  return false;
 }
 
-// Return true iff `node` is an node for which op(x, x) == false.
-bool IsBinaryIrreflexiveRelation(Node* node) {
-  switch (node->op()) {
-    case Op::kNe:
-    case Op::kSGt:
-    case Op::kUGt:
-    case Op::kSLt:
-    case Op::kULt:
-      return true;
-    default:
-      return false;
+// Replaces uses of `n` with a new node by eliminating operands for which the
+// "predicate" holds. If the predicate holds for all operands, the
+// NaryOpNullaryResult is used as a replacement.
+absl::StatusOr<bool> EliminateOperandsWhere(
+    Node* n, const std::function<bool(Node*)>& predicate) {
+  XLS_RET_CHECK(n->Is<NaryOp>());
+  std::vector<Node*> new_operands;
+  for (Node* operand : n->operands()) {
+    if (!predicate(operand)) {
+      new_operands.push_back(operand);
+    }
+  }
+  if (new_operands.size() == n->operand_count()) {
+    return false;
   }
+  if (new_operands.empty()) {
+    XLS_RETURN_IF_ERROR(
+        n
+            ->ReplaceUsesWithNew<Literal>(Value(DoLogicalOp(
+                n->op(), {LogicalOpIdentity(n->op(), n->BitCountOrDie())})))
+            .status());
+  } else {
+    XLS_RETURN_IF_ERROR(
+        n->ReplaceUsesWithNew<NaryOp>(new_operands, n->op()).status());
+  }
+  return true;
 }
 
-// MatchPatterns matches simple tree patterns to find opportunities
-// for simplification.
-//
-// Return 'true' if the IR was modified (uses of node was replaced with a
-// different expression).
-absl::StatusOr<bool> MatchPatterns(Node* n) {
+// Pattern: Add/Sub/Or/Shift a value with 0 on the RHS.
+absl::StatusOr<bool> SimplifyOpWithZeroRhs(Node* n) {
   StatelessQueryEngine query_engine;
-
-  // Pattern: Add/Sub/Or/Shift a value with 0 on the RHS.
-  if ((n->op() == Op::kAdd || n->op() == Op::kSub || n->op() == Op::kShll ||
-       n->op() == Op::kShrl || n->op() == Op::kShra) &&
-      query_engine.IsAllZeros(n->operand(1))) {
+  if (query_engine.IsAllZeros(n->operand(1))) {
     VLOG(2) << "FOUND: Useless operation of value with zero";
     XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)));
     return true;
   }
+  return false;
+}
 
-  // Returns true if all operands of 'node' are the same.
-  auto all_operands_same = [&query_engine](Node* node) {
-    return std::all_of(node->operands().begin(), node->operands().end(),
-                       [node, &query_engine](Node* op) {
-                         return query_engine.NodesKnownUnsignedEquals(
-                             op, node->operand(0));
-                       });
-  };
-
-  // Duplicate operands of AND and OR (and their inverting forms NAND and OR)
-  // can be removed.
-  //
-  //   Op(x, y, y, x)  =>  Op(x, y)
-  if (n->Is<NaryOp>() && (n->op() == Op::kAnd || n->op() == Op::kOr ||
-                          n->op() == Op::kNand || n->op() == Op::kNor)) {
-    std::vector<Node*> unique_operands;
-    for (Node* operand : n->operands()) {
-      // This is quadratic in the number of operands, but shouldn't cause
-      // problems unless we have at least hundreds of thousands of operands
-      // which seems unlikely.
-      if (std::find(unique_operands.begin(), unique_operands.end(), operand) ==
-          unique_operands.end()) {
-        unique_operands.push_back(operand);
-      }
-    }
-    if (unique_operands.size() != n->operand_count()) {
-      VLOG(2) << "FOUND: remove duplicate operands in and/or/nand/nor";
-      XLS_RETURN_IF_ERROR(
-          n->ReplaceUsesWithNew<NaryOp>(unique_operands, n->op()).status());
-      return true;
+// Duplicate operands of AND and OR (and their inverting forms NAND and OR)
+// can be removed.
+//
+//   Op(x, y, y, x)  =>  Op(x, y)
+absl::StatusOr<bool> RemoveDuplicateNaryOperands(Node* n) {
+  if (!n->Is<NaryOp>()) {
+    return false;
+  }
+  std::vector<Node*> unique_operands;
+  for (Node* operand : n->operands()) {
+    // This is quadratic in the number of operands, but shouldn't cause
+    // problems unless we have at least hundreds of thousands of operands
+    // which seems unlikely.
+    if (std::find(unique_operands.begin(), unique_operands.end(), operand) ==
+        unique_operands.end()) {
+      unique_operands.push_back(operand);
     }
   }
+  if (unique_operands.size() != n->operand_count()) {
+    VLOG(2) << "FOUND: remove duplicate operands in and/or/nand/nor";
+    XLS_RETURN_IF_ERROR(
+        n->ReplaceUsesWithNew<NaryOp>(unique_operands, n->op()).status());
+    return true;
+  }
+  return false;
+}
 
-  // Single operand forms of non-inverting logical ops (AND, OR) can be
-  // replaced with the operand.
-  //
-  //   Op(x)  =>  x
-  if (n->Is<NaryOp>() && (n->op() == Op::kAnd || n->op() == Op::kOr) &&
-      n->operand_count() == 1) {
+// Single operand forms of non-inverting logical ops (AND, OR) can be
+// replaced with the operand.
+//
+//   Op(x)  =>  x
+absl::StatusOr<bool> SimplifySingleOperandAndOr(Node* n) {
+  if (n->Is<NaryOp>() && n->operand_count() == 1) {
     VLOG(2) << "FOUND: replace single operand or(x) with x";
     XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)));
     return true;
   }
+  return false;
+}
 
-  // Single operand forms of inverting logical ops (NAND, NOR) can be
-  // replaced with the inverted operand.
-  //
-  //   Op(x)  =>  Not(x)
-  if (n->Is<NaryOp>() && (n->op() == Op::kNor || n->op() == Op::kNand) &&
-      n->operand_count() == 1) {
+// Single operand forms of inverting logical ops (NAND, NOR) can be
+// replaced with the inverted operand.
+//
+//   Op(x)  =>  Not(x)
+absl::StatusOr<bool> SimplifySingleOperandNandNor(Node* n) {
+  if (n->Is<NaryOp>() && n->operand_count() == 1) {
     VLOG(2) << "FOUND: replace single operand nand/nor(x) with not(x)";
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<UnOp>(n->operand(0), Op::kNot).status());
     return true;
   }
+  return false;
+}
 
-  // All operands the same for XOR:
-  //
-  //   XOR(x, x, ...)  =>  x  // Odd number of operands.
-  //   XOR(x, x, ...)  =>  0  // Even number of operands.
-  if (n->op() == Op::kXor && all_operands_same(n)) {
-    VLOG(2) << "FOUND: replace xor(x, x, ...) with 0 or 1";
-    if (n->operand_count() % 2 == 0) {
-      // Even number of operands. Replace with zero.
-      XLS_RETURN_IF_ERROR(
-          n->ReplaceUsesWithNew<Literal>(Value(UBits(0, n->BitCountOrDie())))
-              .status());
-    } else {
-      // Odd number of operands. Replace with XOR operand.
-      XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)));
-    }
-    return true;
+// All operands the same for XOR:
+//
+//   XOR(x, x, ...)  =>  x  // Odd number of operands.
+//   XOR(x, x, ...)  =>  0  // Even number of operands.
+absl::StatusOr<bool> SimplifyXorSameOperands(Node* n) {
+  if (!AllOperandsSame(n)) {
+    return false;
   }
-
-  // Replaces uses of n with a new node by eliminating operands for which the
-  // "predicate" holds. If the predicate holds for all operands, the
-  // NaryOpNullaryResult is used as a replacement.
-  auto eliminate_operands_where =
-      [n](std::function<bool(Node*)> predicate) -> absl::StatusOr<bool> {
-    XLS_RET_CHECK(n->Is<NaryOp>());
-    std::vector<Node*> new_operands;
-    for (Node* operand : n->operands()) {
-      if (!predicate(operand)) {
-        new_operands.push_back(operand);
-      }
-    }
-    if (new_operands.size() == n->operand_count()) {
-      return false;
-    }
-    if (new_operands.empty()) {
-      XLS_RETURN_IF_ERROR(
-          n
-              ->ReplaceUsesWithNew<Literal>(Value(DoLogicalOp(
-                  n->op(), {LogicalOpIdentity(n->op(), n->BitCountOrDie())})))
-              .status());
-    } else {
-      XLS_RETURN_IF_ERROR(
-          n->ReplaceUsesWithNew<NaryOp>(new_operands, n->op()).status());
-    }
-    return true;
-  };
-
-  // Or(x, 0, y) => Or(x, y)
-  // Xor(x, 0, y) => Xor(x, y)
-  // Nor(x, 0, y) => Nor(x, y)
-  if ((n->op() == Op::kOr || n->op() == Op::kXor || n->op() == Op::kNor)) {
-    VLOG(2) << "FOUND: remove zero valued operands from or, nor, or, xor";
-    XLS_ASSIGN_OR_RETURN(bool changed,
-                         eliminate_operands_where([&query_engine](Node* node) {
-                           return query_engine.IsAllZeros(node);
-                         }));
-    if (changed) {
-      return true;
-    }
+  VLOG(2) << "FOUND: replace xor(x, x, ...) with 0 or 1";
+  if (n->operand_count() % 2 == 0) {
+    // Even number of operands. Replace with zero.
+    XLS_RETURN_IF_ERROR(
+        n->ReplaceUsesWithNew<Literal>(Value(UBits(0, n->BitCountOrDie())))
+            .status());
+  } else {
+    // Odd number of operands. Replace with XOR operand.
+    XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)));
   }
+  return true;
+}
+
+// Or(x, 0, y) => Or(x, y)
+// Xor(x, 0, y) => Xor(x, y)
+// Nor(x, 0, y) => Nor(x, y)
+absl::StatusOr<bool> RemoveZeroOperands(Node* n) {
+  StatelessQueryEngine query_engine;
+  VLOG(2) << "FOUND: remove zero valued operands from or, nor, or, xor";
+  return EliminateOperandsWhere(n, [&query_engine](Node* node) {
+    return query_engine.IsAllZeros(node);
+  });
+}
 
-  // Or(x, -1, y) => -1
-  if (n->op() == Op::kOr && AnyOperandWhere(n, [&query_engine](Node* node) {
+// Or(x, -1, y) => -1
+absl::StatusOr<bool> SimplifyOrWithAllOnes(Node* n) {
+  StatelessQueryEngine query_engine;
+  if (AnyOperandWhere(n, [&query_engine](Node* node) {
         return query_engine.IsAllOnes(node);
       })) {
     VLOG(2) << "FOUND: replace or(..., 1, ...) with 1";
@@ -210,9 +200,13 @@ absl::StatusOr<bool> MatchPatterns(Node* n) {
         n->ReplaceUsesWithNew<Literal>(AllOnesOfType(n->GetType())).status());
     return true;
   }
+  return false;
+}
 
-  // Nor(x, -1, y) => 0
-  if (n->op() == Op::kNor && AnyOperandWhere(n, [&query_engine](Node* node) {
+// Nor(x, -1, y) => 0
+absl::StatusOr<bool> SimplifyNorWithAllOnes(Node* n) {
+  StatelessQueryEngine query_engine;
+  if (AnyOperandWhere(n, [&query_engine](Node* node) {
         return query_engine.IsAllOnes(node);
       })) {
     VLOG(2) << "FOUND: replace nor(..., 1, ...) with 0";
@@ -220,22 +214,23 @@ absl::StatusOr<bool> MatchPatterns(Node* n) {
         n->ReplaceUsesWithNew<Literal>(ZeroOfType(n->GetType())).status());
     return true;
   }
+  return false;
+}
 
-  // And(x, -1, y) => And(x, y)
-  // Nand(x, -1, y) => Nand(x, y)
-  if (n->op() == Op::kAnd || n->op() == Op::kNand) {
-    VLOG(2) << "FOUND: remove all-ones operands from and/nand";
-    XLS_ASSIGN_OR_RETURN(bool changed,
-                         eliminate_operands_where([&query_engine](Node* node) {
-                           return query_engine.IsAllOnes(node);
-                         }));
-    if (changed) {
-      return true;
-    }
-  }
+// And(x, -1, y) => And(x, y)
+// Nand(x, -1, y) => Nand(x, y)
+absl::StatusOr<bool> RemoveAllOnesOperands(Node* n) {
+  StatelessQueryEngine query_engine;
+  VLOG(2) << "FOUND: remove all-ones operands from and/nand";
+  return EliminateOperandsWhere(n, [&query_engine](Node* node) {
+    return query_engine.IsAllOnes(node);
+  });
+}
 
-  // And(x, 0) => 0
-  if (n->op() == Op::kAnd && AnyOperandWhere(n, [&query_engine](Node* node) {
+// And(x, 0) => 0
+absl::StatusOr<bool> SimplifyAndWithZero(Node* n) {
+  StatelessQueryEngine query_engine;
+  if (AnyOperandWhere(n, [&query_engine](Node* node) {
         return query_engine.IsAllZeros(node);
       })) {
     VLOG(2) << "FOUND: replace and(..., 0, ...) with 0";
@@ -243,9 +238,13 @@ absl::StatusOr<bool> MatchPatterns(Node* n) {
         n->ReplaceUsesWithNew<Literal>(ZeroOfType(n->GetType())).status());
     return true;
   }
+  return false;
+}
 
-  // Nand(x, 0) => 1
-  if (n->op() == Op::kNand && AnyOperandWhere(n, [&query_engine](Node* node) {
+// Nand(x, 0) => 1
+absl::StatusOr<bool> SimplifyNandWithZero(Node* n) {
+  StatelessQueryEngine query_engine;
+  if (AnyOperandWhere(n, [&query_engine](Node* node) {
         return query_engine.IsAllZeros(node);
       })) {
     VLOG(2) << "FOUND: replace nand(..., 0, ...) with 1";
@@ -253,85 +252,88 @@ absl::StatusOr<bool> MatchPatterns(Node* n) {
         n->ReplaceUsesWithNew<Literal>(AllOnesOfType(n->GetType())).status());
     return true;
   }
+  return false;
+}
 
-  // Returns true if `node` one of its operands also appears inverted in the
-  // operands of `node`.
-  auto has_inverted_operand = [](Node* node) {
-    for (Node* operand : node->operands()) {
-      if (operand->op() == Op::kNot &&
-          std::find(node->operands().begin(), node->operands().end(),
-                    operand->operand(0)) != node->operands().end()) {
-        return true;
-      }
-    }
-    return false;
-  };
-
-  // And(x, Not(x)) => 0
-  // And(Not(x), x) => 0
-  //
-  // Note that this won't be found through the ternary query engine because
-  // conservatively it determines `not(UNKNOWN) = UNKNOWN`.
-  if (n->op() == Op::kAnd && has_inverted_operand(n)) {
+// And(x, Not(x)) => 0
+// And(Not(x), x) => 0
+//
+// Note that this won't be found through the ternary query engine because
+// conservatively it determines `not(UNKNOWN) = UNKNOWN`.
+absl::StatusOr<bool> SimplifyAndWithInvertedOperand(Node* n) {
+  if (HasInvertedOperand(n)) {
     VLOG(2) << "FOUND: replace and(x, not(x)) with 0";
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(UBits(0, n->BitCountOrDie())))
             .status());
     return true;
   }
+  return false;
+}
 
-  //   Or(X, Not(X), ...)  => 1...
-  //
-  // Note that this won't be found through the ternary query engine because
-  // conservatively it determines `not(UNKNOWN) = UNKNOWN`.
-  if (n->op() == Op::kOr && has_inverted_operand(n)) {
+//   Or(X, Not(X), ...)  => 1...
+//
+// Note that this won't be found through the ternary query engine because
+// conservatively it determines `not(UNKNOWN) = UNKNOWN`.
+absl::StatusOr<bool> SimplifyOrWithInvertedOperand(Node* n) {
+  if (HasInvertedOperand(n)) {
     VLOG(2) << "FOUND: replace Or(x, not(x)) with 1...";
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(Bits::AllOnes(n->BitCountOrDie())))
             .status());
     return true;
   }
+  return false;
+}
 
-  //   Add(X, Not(X)) => 1...
-  //   Add(Not(X), X) => 1...
-  //
-  // Note that this won't be found through the ternary query engine because
-  // conservatively it determines `not(UNKNOWN) = UNKNOWN`.
-  if (n->op() == Op::kAdd && n->operand_count() == 2 &&
-      has_inverted_operand(n)) {
+//   Add(X, Not(X)) => 1...
+//   Add(Not(X), X) => 1...
+//
+// Note that this won't be found through the ternary query engine because
+// conservatively it determines `not(UNKNOWN) = UNKNOWN`.
+absl::StatusOr<bool> SimplifyAddWithInvertedOperand(Node* n) {
+  if (n->operand_count() == 2 && HasInvertedOperand(n)) {
     VLOG(2) << "FOUND: replace Add(x, not(x)) with 1...";
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(Bits::AllOnes(n->BitCountOrDie())))
             .status());
     return true;
   }
+  return false;
+}
 
-  // Xor(x, -1) => Not(x)
-  if (n->op() == Op::kXor && n->operand_count() == 2 &&
-      query_engine.IsAllOnes(n->operand(1))) {
+// Xor(x, -1) => Not(x)
+absl::StatusOr<bool> SimplifyXorWithAllOnes(Node* n) {
+  StatelessQueryEngine query_engine;
+  if (n->operand_count() == 2 && query_engine.IsAllOnes(n->operand(1))) {
     VLOG(2) << "FOUND: Found xor with all ones";
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<UnOp>(n->operand(0), Op::kNot).status());
     return true;
   }
+  return false;
+}
 
-  // Sub(X, X) => Literal(0)
-  if (n->op() == Op::kSub && all_operands_same(n)) {
+// Sub(X, X) => Literal(0)
+absl::StatusOr<bool> SimplifySubSameOperands(Node* n) {
+  if (AllOperandsSame(n)) {
     VLOG(2) << "FOUND: Sub of value with itself";
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(UBits(0, n->BitCountOrDie())))
             .status());
     return true;
   }
+  return false;
+}
 
+// Flatten nested associative nary ops into their root op:
+//
+//   Op(Op(x, y), z)  =>  Op(x, y, z)
+//
+// This operation should only be performed if the only user of the nested ops
+// is the outer op itself.
+absl::StatusOr<bool> FlattenAssociativeNaryOp(Node* n) {
   auto is_same_opcode = [&](Node* other) { return n->op() == other->op(); };
-
-  // Flatten nested associative nary ops into their root op:
-  //
-  //   Op(Op(x, y), z)  =>  Op(x, y, z)
-  //
-  // This operation should only be performed if the only user of the nested ops
-  // is the outer op itself.
   if (OpIsAssociative(n->op()) && n->Is<NaryOp>() &&
       AnyOperandWhere(n, is_same_opcode)) {
     std::vector<Node*> new_operands;
@@ -353,10 +355,14 @@ absl::StatusOr<bool> MatchPatterns(Node* n) {
       return true;
     }
   }
+  return false;
+}
 
-  // Fold the constant values presented to the nary op.
-  //
-  //   Op(C0, x, C1)  =>  Op(C2, x) where C2 == Op(C0, C1)
+// Fold the constant values presented to the nary op.
+//
+//   Op(C0, x, C1)  =>  Op(C2, x) where C2 == Op(C0, C1)
+absl::StatusOr<bool> FoldNaryOpLiteralOperands(Node* n) {
+  StatelessQueryEngine query_engine;
   if (OpIsCommutative(n->op()) && OpIsAssociative(n->op()) && n->Is<NaryOp>() &&
       AnyTwoOperandsWhere(n, [&query_engine](Node* node) {
         return query_engine.IsFullyKnown(node);
@@ -380,39 +386,43 @@ absl::StatusOr<bool> MatchPatterns(Node* n) {
         n->ReplaceUsesWithNew<NaryOp>(new_operands, n->op()).status());
     return true;
   }
+  return false;
+}
 
-  // Pattern: Mul by 0
-  if ((n->op() == Op::kSMul || n->op() == Op::kUMul) &&
-      query_engine.IsAllZeros(n->operand(1))) {
+// Pattern: Mul by 0
+absl::StatusOr<bool> SimplifyMulByZero(Node* n) {
+  StatelessQueryEngine query_engine;
+  if (query_engine.IsAllZeros(n->operand(1))) {
     VLOG(2) << "FOUND: Mul by 0";
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(UBits(0, n->BitCountOrDie())))
             .status());
     return true;
   }
+  return false;
+}
 
-  // Pattern: Not(Not(x)) => x
-  if (n->op() == Op::kNot && n->operand(0)->op() == Op::kNot) {
-    VLOG(2) << "FOUND: replace not(not(x)) with x";
-    XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)->operand(0)));
-    return true;
-  }
-
-  // Pattern: Double negative.
-  //   -(-expr)
-  if (n->op() == Op::kNeg && n->operand(0)->op() == Op::kNeg) {
-    VLOG(2) << "FOUND: Double negative";
+// Patterns:
+//   Not(Not(x))  =>  x
+//   -(-expr)     =>  expr
+absl::StatusOr<bool> SimplifyInverseOfInverse(Node* n) {
+  if (n->operand(0)->op() == n->op()) {
+    VLOG(2) << "FOUND: replace not(not(x))/neg(neg(x)) with x";
     XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)->operand(0)));
     return true;
   }
+  return false;
+}
 
-  // Patterns (where x is a bits[1] type):
-  //   eq(x, 1) => x
-  //   eq(x, 0) => not(x)
-  //
-  // Because eq is commutative, we can rely on the literal being on the right
-  // because of canonicalization.
-  if (n->op() == Op::kEq && n->operand(0)->GetType()->IsBits() &&
+// Patterns (where x is a bits[1] type):
+//   eq(x, 1) => x
+//   eq(x, 0) => not(x)
+//
+// Because eq is commutative, we can rely on the literal being on the right
+// because of canonicalization.
+absl::StatusOr<bool> SimplifyEqOfBitsOneLiteral(Node* n) {
+  StatelessQueryEngine query_engine;
+  if (n->operand(0)->GetType()->IsBits() &&
       n->operand(0)->BitCountOrDie() == 1 &&
       query_engine.IsFullyKnown(n->operand(1))) {
     if (query_engine.IsAllZeros(n->operand(1))) {
@@ -425,43 +435,115 @@ absl::StatusOr<bool> MatchPatterns(Node* n) {
     XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)));
     return true;
   }
+  return false;
+}
 
-  // eq(x, x) => 1 (or other reflexive relations such as ule)
-  // ne(x, x) => 0 (or other irreflexive relations such as ult)
-  if (IsBinaryReflexiveRelation(n) && n->operand(0) == n->operand(1)) {
+// eq(x, x) => 1 (or other reflexive relations such as ule)
+absl::StatusOr<bool> SimplifyReflexiveRelation(Node* n) {
+  if (n->operand(0) == n->operand(1)) {
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(UBits(1, 1))).status());
     return true;
   }
-  if (IsBinaryIrreflexiveRelation(n) && n->operand(0) == n->operand(1)) {
+  return false;
+}
+
+// ne(x, x) => 0 (or other irreflexive relations such as ult)
+absl::StatusOr<bool> SimplifyIrreflexiveRelation(Node* n) {
+  if (n->operand(0) == n->operand(1)) {
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(UBits(0, 1))).status());
     return true;
   }
+  return false;
+}
 
-  // If x and y are zero-width values:
-  //    eq(x, y) => 1
-  //    ne(x, y) => 0
-  if (n->op() == Op::kEq && n->operand(0)->GetType()->GetFlatBitCount() == 0) {
+// If x and y are zero-width values:
+//    eq(x, y) => 1
+absl::StatusOr<bool> SimplifyZeroWidthEq(Node* n) {
+  if (n->operand(0)->GetType()->GetFlatBitCount() == 0) {
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(UBits(1, 1))).status());
     return true;
   }
-  if (n->op() == Op::kNe && n->operand(0)->GetType()->GetFlatBitCount() == 0) {
+  return false;
+}
+
+// If x and y are zero-width values:
+//    ne(x, y) => 0
+absl::StatusOr<bool> SimplifyZeroWidthNe(Node* n) {
+  if (n->operand(0)->GetType()->GetFlatBitCount() == 0) {
     XLS_RETURN_IF_ERROR(
         n->ReplaceUsesWithNew<Literal>(Value(UBits(0, 1))).status());
     return true;
   }
-
   return false;
 }
 
+// The basic simplification patterns compiled into a single opcode-dispatched
+// rule set. Rules registered for a given op are evaluated in the order they
+// appear here.
+const RewriteRuleSet& BasicSimplificationRules() {
+  static const absl::NoDestructor<RewriteRuleSet> kRules(RewriteRuleSet({
+      {"op-with-zero-rhs",
+       {Op::kAdd, Op::kSub, Op::kShll, Op::kShrl, Op::kShra},
+       &SimplifyOpWithZeroRhs},
+      {"remove-duplicate-nary-operands",
+       {Op::kAnd, Op::kOr, Op::kNand, Op::kNor},
+       &RemoveDuplicateNaryOperands},
+      {"single-operand-and-or",
+       {Op::kAnd, Op::kOr},
+       &SimplifySingleOperandAndOr},
+      {"single-operand-nand-nor",
+       {Op::kNand, Op::kNor},
+       &SimplifySingleOperandNandNor},
+      {"xor-same-operands", {Op::kXor}, &SimplifyXorSameOperands},
+      {"remove-zero-operands",
+       {Op::kOr, Op::kXor, Op::kNor},
+       &RemoveZeroOperands},
+      {"or-with-all-ones", {Op::kOr}, &SimplifyOrWithAllOnes},
+      {"nor-with-all-ones", {Op::kNor}, &SimplifyNorWithAllOnes},
+      {"remove-all-ones-operands",
+       {Op::kAnd, Op::kNand},
+       &RemoveAllOnesOperands},
+      {"and-with-zero", {Op::kAnd}, &SimplifyAndWithZero},
+      {"nand-with-zero", {Op::kNand}, &SimplifyNandWithZero},
+      {"and-with-inverted-operand",
+       {Op::kAnd},
+       &SimplifyAndWithInvertedOperand},
+      {"or-with-inverted-operand", {Op::kOr}, &SimplifyOrWithInvertedOperand},
+      {"add-with-inverted-operand",
+       {Op::kAdd},
+       &SimplifyAddWithInvertedOperand},
+      {"xor-with-all-ones", {Op::kXor}, &SimplifyXorWithAllOnes},
+      {"sub-same-operands", {Op::kSub}, &SimplifySubSameOperands},
+      {"flatten-associative-nary-op",
+       {Op::kAnd, Op::kOr, Op::kXor},
+       &FlattenAssociativeNaryOp},
+      {"fold-nary-op-literal-operands",
+       {Op::kAnd, Op::kOr, Op::kXor},
+       &FoldNaryOpLiteralOperands},
+      {"mul-by-zero", {Op::kSMul, Op::kUMul}, &SimplifyMulByZero},
+      {"inverse-of-inverse", {Op::kNot, Op::kNeg}, &SimplifyInverseOfInverse},
+      {"eq-of-bits-one-literal", {Op::kEq}, &SimplifyEqOfBitsOneLiteral},
+      {"reflexive-relation",
+       {Op::kEq, Op::kSGe, Op::kUGe, Op::kSLe, Op::kULe},
+       &SimplifyReflexiveRelation},
+      {"irreflexive-relation",
+       {Op::kNe, Op::kSGt, Op::kUGt, Op::kSLt, Op::kULt},
+       &SimplifyIrreflexiveRelation},
+      {"zero-width-eq", {Op::kEq}, &SimplifyZeroWidthEq},
+      {"zero-width-ne", {Op::kNe}, &SimplifyZeroWidthNe},
+  }));
+  return *kRules;
+}
+
 }  // namespace
 
 absl::StatusOr<bool> BasicSimplificationPass::RunOnFunctionBaseInternal(
     FunctionBase* f, const OptimizationPassOptions& options,
     PassResults* results) const {
-  return TransformNodesToFixedPoint(f, MatchPatterns);
+  return BasicSimplificationRules().RunToFixedPoint(f);
 }
 
 REGISTER_OPT_PASS(BasicSimplificationPass);
@@ -68,6 +68,11 @@ struct TooManyPaths {};
 using SaturatingBddNodeIndex = std::variant<BddNodeIndex, TooManyPaths>;
 using SaturatingBddNodeVector = std::vector<SaturatingBddNodeIndex>;
 
+// Bound on how much banked path budget a single node may draw: a node's
+// effective path limit never exceeds kMaxEffortBoostFactor times the base
+// per-node limit, no matter how much budget earlier nodes released.
+constexpr int64_t kMaxEffortBoostFactor = 8;
+
 // The AbstractEvaluator requires equals to and not equals to operations on the
 // primitive element.
 bool operator==(const SaturatingBddNodeIndex& a,
@@ -332,88 +337,199 @@ class BddStatistics {
                                 f->node_count());
   XLS_VLOG_LINES(5, f->DumpIr());
 
-  auto bdd_function = absl::WrapUnique(new BddFunction(f));
-  SaturatingBddEvaluator evaluator(path_limit, &bdd_function->bdd());
+  auto bdd_function =
+      absl::WrapUnique(new BddFunction(f, path_limit, std::move(node_filter)));
+
+  VLOG(3) << "BDD expressions:";
+  BddStatistics bdd_stats;
+  for (Node* node : TopoSort(f)) {
+    std::optional<Stopwatch> stop_watch;
+    if (VLOG_IS_ON(2)) {
+      stop_watch = Stopwatch();
+    }
+    XLS_RETURN_IF_ERROR(bdd_function->EvaluateNode(node));
+    if (stop_watch.has_value()) {
+      bdd_stats.AddOp(node->op(), stop_watch->GetElapsedTime());
+    }
+  }
+  XLS_VLOG_LINES(2, bdd_stats.ToString());
+  return std::move(bdd_function);
+}
+
+/* static */ std::unique_ptr<BddFunction> BddFunction::CreateLazy(
+    FunctionBase* f, int64_t path_limit,
+    std::optional<std::function<bool(const Node*)>> node_filter) {
+  return absl::WrapUnique(new BddFunction(f, path_limit, std::move(node_filter)));
+}
+
+absl::Status BddFunction::EvaluateNode(Node* node) {
+  VLOG(3) << "node: " << node->ToString();
+  if (!node->GetType()->IsBits()) {
+    VLOG(3) << "  skipping node, type is not bits: "
+            << node->GetType()->ToString();
+    return absl::OkStatus();
+  }
+  if (node_map_.contains(node)) {
+    return absl::OkStatus();
+  }
+
+  // Every evaluated node is allotted path_limit_ paths of budget. Nodes whose
+  // expressions stayed small have banked their unused allotment, and this
+  // node may draw on the bank -- up to a bounded boost -- if it would
+  // otherwise saturate.
+  int64_t effective_limit = path_limit_;
+  if (path_limit_ > 0) {
+    effective_limit += std::min(banked_path_budget_,
+                                (kMaxEffortBoostFactor - 1) * path_limit_);
+  }
+  SaturatingBddEvaluator evaluator(effective_limit, &bdd_);
 
   // Create and return a vector containing newly defined BDD variables.
   auto create_new_node_vector = [&](Node* n) {
     SaturatingBddNodeVector v(n->BitCountOrDie());
     for (int64_t i = 0; i < n->BitCountOrDie(); ++i) {
-      v[i] = bdd_function->bdd().NewVariable();
+      v[i] = bdd_.NewVariable();
     }
-    bdd_function->saturated_expressions_.insert(n);
+    saturated_expressions_.insert(n);
     return v;
   };
 
-  VLOG(3) << "BDD expressions:";
-  absl::flat_hash_map<Node*, SaturatingBddNodeVector> values;
-  BddStatistics bdd_stats;
-  for (Node* node : TopoSort(f)) {
-    VLOG(3) << "node: " << node->ToString();
-    if (!node->GetType()->IsBits()) {
-      VLOG(3) << "  skipping node, type is not bits: "
-              << node->GetType()->ToString();
-      continue;
-    }
-
-    std::optional<Stopwatch> stop_watch;
-    if (VLOG_IS_ON(2)) {
-      stop_watch = Stopwatch();
+  SaturatingBddNodeVector value;
+  // If we shouldn't evaluate this node, the node is to be modeled as
+  // variables, or the node includes some non-bits-typed operands, then just
+  // create a vector of new BDD variables for this node.
+  if (!ShouldEvaluate(node) ||
+      (node_filter_.has_value() && !node_filter_.value()(node)) ||
+      std::any_of(node->operands().begin(), node->operands().end(),
+                  [](Node* o) { return !o->GetType()->IsBits(); })) {
+    VLOG(3) << "  node filtered out.";
+    value = create_new_node_vector(node);
+  } else if (path_limit_ > 0 && saturation_limits_.contains(node) &&
+             saturation_limits_.at(node) >= effective_limit) {
+    // An earlier evaluation saturated at this effort level or above; don't
+    // pay for rediscovering the saturation.
+    VLOG(3) << "  node known to saturate; allotting new variables.";
+    value = create_new_node_vector(node);
+  } else {
+    VLOG(3) << "  computing BDD value...";
+    std::vector<SaturatingBddNodeVector> operand_values;
+    operand_values.reserve(node->operand_count());
+    for (Node* operand : node->operands()) {
+      const BddNodeVector& operand_vector = node_map_.at(operand);
+      operand_values.push_back(SaturatingBddNodeVector(operand_vector.begin(),
+                                                       operand_vector.end()));
     }
-
-    // If we shouldn't evaluate this node, the node is to be modeled as
-    // variables, or the node includes some non-bits-typed operands, then just
-    // create a vector of new BDD variables for this node.
-    if (!ShouldEvaluate(node) ||
-        (node_filter.has_value() && !node_filter.value()(node)) ||
-        std::any_of(node->operands().begin(), node->operands().end(),
-                    [](Node* o) { return !o->GetType()->IsBits(); })) {
-      VLOG(3) << "  node filtered out.";
-      values[node] = create_new_node_vector(node);
-    } else {
-      VLOG(3) << "  computing BDD value...";
-      std::vector<SaturatingBddNodeVector> operand_values;
-      operand_values.reserve(node->operand_count());
-      for (Node* operand : node->operands()) {
-        operand_values.push_back(values.at(operand));
+    XLS_ASSIGN_OR_RETURN(
+        value, AbstractEvaluate(node, operand_values, &evaluator,
+                                /*default_handler=*/create_new_node_vector));
+
+    // Associate a new BDD variable with each bit that exceeded the path
+    // limit.
+    bool saturated = false;
+    for (SaturatingBddNodeIndex& element : value) {
+      if (std::holds_alternative<TooManyPaths>(element)) {
+        saturated = true;
+        saturated_expressions_.insert(node);
+        element = bdd_.NewVariable();
       }
-      XLS_ASSIGN_OR_RETURN(
-          values[node],
-          AbstractEvaluate(node, operand_values, &evaluator,
-                           /*default_handler=*/create_new_node_vector));
-
-      // Associate a new BDD variable with each bit that exceeded the path
-      // limit.
-      for (SaturatingBddNodeIndex& value : values.at(node)) {
-        if (std::holds_alternative<TooManyPaths>(value)) {
-          bdd_function->saturated_expressions_.insert(node);
-          value = bdd_function->bdd().NewVariable();
+    }
+    if (path_limit_ > 0) {
+      if (saturated) {
+        // The node's bits are modeled as free variables, so its allotment
+        // goes unspent: release it to the bank and remember the effort level
+        // at which the saturation occurred.
+        saturation_limits_[node] = effective_limit;
+        banked_path_budget_ += path_limit_;
+      } else {
+        // Bank the unused part of the allotment, or charge the bank for any
+        // overdraw. The widest bit of the expression determines the usage.
+        int64_t usage = 0;
+        for (const SaturatingBddNodeIndex& element : value) {
+          usage = std::max(usage,
+                           bdd_.path_count(std::get<BddNodeIndex>(element)));
         }
+        banked_path_budget_ += path_limit_ - usage;
       }
     }
-    if (VLOG_IS_ON(5)) {
-      VLOG(5) << "  " << node->GetName() << ":";
-      for (int64_t i = 0; i < node->BitCountOrDie(); ++i) {
-        VLOG(5) << absl::StreamFormat(
-            "    bit %d : %s", i,
-            bdd_function->bdd().ToStringDnf(
-                std::get<BddNodeIndex>(values.at(node)[i]),
-                /*minterm_limit=*/15));
-      }
+  }
+  if (VLOG_IS_ON(5)) {
+    VLOG(5) << "  " << node->GetName() << ":";
+    for (int64_t i = 0; i < node->BitCountOrDie(); ++i) {
+      VLOG(5) << absl::StreamFormat(
+          "    bit %d : %s",
+          i,
+          bdd_.ToStringDnf(std::get<BddNodeIndex>(value[i]),
+                           /*minterm_limit=*/15));
     }
-    if (stop_watch.has_value()) {
-      bdd_stats.AddOp(node->op(), stop_watch->GetElapsedTime());
+  }
+  node_map_[node] = ToBddNodeVector(value);
+  return absl::OkStatus();
+}
+
+absl::Status BddFunction::EnsureEvaluated(Node* node) {
+  if (!node->GetType()->IsBits() || node_map_.contains(node)) {
+    return absl::OkStatus();
+  }
+  // Iterative post-order walk of the unevaluated transitive fanin so operand
+  // expressions are always memoized before EvaluateNode uses them.
+  std::vector<std::pair<Node*, bool>> stack;
+  stack.push_back({node, false});
+  while (!stack.empty()) {
+    auto [n, operands_done] = stack.back();
+    stack.pop_back();
+    if (!n->GetType()->IsBits() || node_map_.contains(n)) {
+      continue;
+    }
+    if (!operands_done) {
+      stack.push_back({n, true});
+      for (Node* operand : n->operands()) {
+        if (operand->GetType()->IsBits() && !node_map_.contains(operand)) {
+          stack.push_back({operand, false});
+        }
+      }
+      continue;
     }
+    XLS_RETURN_IF_ERROR(EvaluateNode(n));
   }
-  XLS_VLOG_LINES(2, bdd_stats.ToString());
+  return absl::OkStatus();
+}
 
-  // Copy over the vector and BDD variables into the node map which is exposed
-  // via the BddFunction interface. At this point any TooManyPaths sentinel
-  // values have been replaced with new Bdd variables.
-  for (const auto& pair : values) {
-    bdd_function->node_map_[pair.first] = ToBddNodeVector(pair.second);
+void BddFunction::RaisePathLimit(int64_t new_path_limit) {
+  if (path_limit_ == 0 ||
+      (new_path_limit != 0 && new_path_limit <= path_limit_)) {
+    // Already unlimited, or not an increase.
+    return;
   }
-  return std::move(bdd_function);
+  // Discard the memoized expressions of saturated nodes and everything
+  // downstream of them; they will be recomputed with the larger budget on
+  // demand. Expressions which did not saturate remain valid, as do nodes
+  // already known to saturate at or above the new limit -- re-evaluating
+  // those would only rediscover the saturation.
+  std::vector<Node*> worklist;
+  for (Node* n : saturated_expressions_) {
+    auto it = saturation_limits_.find(n);
+    if (new_path_limit != 0 && it != saturation_limits_.end() &&
+        it->second >= new_path_limit) {
+      continue;
+    }
+    worklist.push_back(n);
+  }
+  absl::flat_hash_set<Node*> invalidated;
+  while (!worklist.empty()) {
+    Node* n = worklist.back();
+    worklist.pop_back();
+    if (!invalidated.insert(n).second) {
+      continue;
+    }
+    node_map_.erase(n);
+    saturated_expressions_.erase(n);
+    for (Node* user : n->users()) {
+      if (!invalidated.contains(user)) {
+        worklist.push_back(user);
+      }
+    }
+  }
+  path_limit_ = new_path_limit;
 }
 
 absl::StatusOr<Value> BddFunction::Evaluate(
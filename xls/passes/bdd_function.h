@@ -19,6 +19,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -56,6 +57,12 @@ class BddFunction {
   // a particular bit in the function ({Node*, bit index} pair) exceeds this
   // value the bit's representation in the BDD is replaced with a new BDD
   // variable. This provides a mechanism for limiting the growth of the BDD.
+  //
+  // The limit is applied adaptively: nodes whose expressions stay well under
+  // the limit release their unused allotment into a shared pool, and a node
+  // which would otherwise saturate may draw a bounded boost from the pool.
+  // The same total budget therefore yields more precise expressions than a
+  // hard per-node cutoff.
   static constexpr int64_t kDefaultPathLimit = 1024;
 
   // Construct a BDD representing the given function/proc.
@@ -70,6 +77,33 @@ class BddFunction {
       std::optional<std::function<bool(const Node*)>> node_filter =
           std::nullopt);
 
+  // Like Run, but performs no evaluation up front. Nodes are evaluated (and
+  // memoized) on demand via EnsureEvaluated. Useful when only a subset of the
+  // function's nodes will ever be queried.
+  static std::unique_ptr<BddFunction> CreateLazy(
+      FunctionBase* f, int64_t path_limit = 0,
+      std::optional<std::function<bool(const Node*)>> node_filter =
+          std::nullopt);
+
+  // Ensures that the expressions of `node` and its transitive fanin are
+  // present in the BDD, evaluating any which have not yet been computed.
+  // Already-evaluated nodes are not recomputed.
+  absl::Status EnsureEvaluated(Node* node);
+
+  // Raises the path limit to `new_path_limit` and discards the memoized
+  // expressions of saturated nodes and their transitive users so they are
+  // recomputed with the larger budget by the next EnsureEvaluated. Expressions
+  // which did not saturate at the old limit are kept as-is, as are nodes
+  // already known to saturate at or above the new limit. Has no effect if
+  // the new limit is not an increase.
+  void RaisePathLimit(int64_t new_path_limit);
+
+  // Returns the FunctionBase this BddFunction represents.
+  FunctionBase* function_base() const { return func_base_; }
+
+  // Returns the path limit the BDD is currently built with.
+  int64_t path_limit() const { return path_limit_; }
+
   // Returns the underlying BDD.
   const BinaryDecisionDiagram& bdd() const { return bdd_; }
   BinaryDecisionDiagram& bdd() { return bdd_; }
@@ -88,9 +122,19 @@ class BddFunction {
   absl::StatusOr<Value> Evaluate(absl::Span<const Value> args) const;
 
  private:
-  explicit BddFunction(FunctionBase* f) : func_base_(f) {}
+  BddFunction(FunctionBase* f, int64_t path_limit,
+              std::optional<std::function<bool(const Node*)>> node_filter)
+      : func_base_(f),
+        path_limit_(path_limit),
+        node_filter_(std::move(node_filter)) {}
+
+  // Computes and memoizes the BDD expression for `node`. The expressions of
+  // all bits-typed operands must already be present in the node map.
+  absl::Status EvaluateNode(Node* node);
 
   FunctionBase* func_base_;
+  int64_t path_limit_;
+  std::optional<std::function<bool(const Node*)>> node_filter_;
   BinaryDecisionDiagram bdd_;
 
   // A map from XLS Node to vector of BDD nodes representing the XLS Node's
@@ -102,6 +146,18 @@ class BddFunction {
   // BDD. These are the XLS Nodes for which it was determined the precisely
   // computing the expression for the node using the BDD was too expensive.
   absl::flat_hash_set<Node*> saturated_expressions_;
+
+  // Shared pool of unused path budget. Every evaluated node is allotted
+  // path_limit_ paths; nodes whose expressions stay small bank the unused
+  // part of their allotment here, and nodes which would otherwise saturate
+  // draw from it (bounded by a small multiple of the per-node limit).
+  int64_t banked_path_budget_ = 0;
+
+  // Maps a node to the effective path limit at which its evaluation
+  // saturated. Consulted before evaluating so that known-saturated nodes are
+  // replaced with free variables immediately rather than re-running the
+  // evaluation only to rediscover the saturation.
+  absl::flat_hash_map<Node*, int64_t> saturation_limits_;
 };
 
 // Returns true if the given node is very cheap to evaluate using a
@@ -84,6 +84,70 @@ TEST_F(BddFunctionTest, AndNot) {
               IsOkAndHolds(Value(UBits(0, 8))));
 }
 
+TEST_F(BddFunctionTest, LazyEvaluation) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  Type* t = p->GetBitsType(8);
+  BValue x = fb.Param("x", t);
+  fb.And(x, fb.Not(x));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  std::unique_ptr<BddFunction> bdd_function = BddFunction::CreateLazy(f);
+  // Evaluation of the return value pulls in the whole fanin on demand.
+  XLS_ASSERT_OK(bdd_function->EnsureEvaluated(f->return_value()));
+  for (int64_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(bdd_function->GetBddNode(f->return_value(), i),
+              bdd_function->bdd().zero());
+  }
+}
+
+TEST_F(BddFunctionTest, RaisePathLimitRecomputesSaturatedExpressions) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue parity = fb.Literal(UBits(0, 1));
+  for (int64_t i = 0; i < 32; ++i) {
+    parity = fb.Xor(parity, fb.BitSlice(x, i, 1));
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  // With a tiny path limit the parity expression saturates; raising the limit
+  // and re-evaluating recomputes it precisely.
+  std::unique_ptr<BddFunction> bdd_function =
+      BddFunction::CreateLazy(f, /*path_limit=*/2);
+  XLS_ASSERT_OK(bdd_function->EnsureEvaluated(f->return_value()));
+  bdd_function->RaisePathLimit(1 << 20);
+  EXPECT_EQ(bdd_function->path_limit(), 1 << 20);
+  XLS_ASSERT_OK(bdd_function->EnsureEvaluated(f->return_value()));
+  EXPECT_THAT(bdd_function->Evaluate({Value(UBits(1, 32))}),
+              IsOkAndHolds(Value(UBits(1, 1))));
+}
+
+TEST_F(BddFunctionTest, BankedBudgetAllowsWiderExpressions) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(3));
+  auto parity = [&]() {
+    BValue acc = fb.Literal(UBits(0, 1));
+    for (int64_t i = 0; i < 3; ++i) {
+      acc = fb.Xor(acc, fb.BitSlice(x, i, 1));
+    }
+    return acc;
+  };
+  BValue a = parity();
+  BValue b = parity();
+  fb.And(a, fb.Not(b));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  // A three-input parity expression needs 8 paths -- more than the per-node
+  // limit of 4 -- but the budget banked by the cheap literal and bit-slice
+  // nodes covers the difference, so both parity chains are expressed
+  // precisely and and(a, not(b)) folds to constant zero.
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<BddFunction> bdd_function,
+                           BddFunction::Run(f, /*path_limit=*/4));
+  EXPECT_EQ(bdd_function->GetBddNode(f->return_value(), 0),
+            bdd_function->bdd().zero());
+}
+
 TEST_F(BddFunctionTest, Parity) {
   auto p = CreatePackage();
   FunctionBuilder fb(TestName(), p.get());
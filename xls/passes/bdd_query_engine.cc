@@ -26,20 +26,28 @@
 #include "xls/data_structures/binary_decision_diagram.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_ops.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
+#include "xls/passes/bdd_function.h"
 #include "xls/passes/query_engine.h"
 
 namespace xls {
 
 absl::StatusOr<ReachedFixpoint> BddQueryEngine::Populate(FunctionBase* f) {
-  XLS_ASSIGN_OR_RETURN(bdd_function_,
-                       BddFunction::Run(f, path_limit_, node_filter_));
+  // Reuse the memoized BDD from an earlier Populate call when the IR has not
+  // changed; otherwise start from a fresh, lazily-evaluated BddFunction.
+  if (bdd_function_ == nullptr || bdd_function_->function_base() != f ||
+      f->transform_version() != populated_transform_version_) {
+    bdd_function_ = BddFunction::CreateLazy(f, path_limit_, node_filter_);
+    populated_transform_version_ = f->transform_version();
+  }
   // Construct the Bits objects indication which bit values are statically known
   // for each node and what those values are (0 or 1) if known.
   BinaryDecisionDiagram& bdd = this->bdd();
   ReachedFixpoint rf = ReachedFixpoint::Unchanged;
   for (Node* node : f->nodes()) {
     if (node->GetType()->IsBits()) {
+      XLS_RETURN_IF_ERROR(bdd_function_->EnsureEvaluated(node));
       absl::InlinedVector<bool, 1> known_bits;
       absl::InlinedVector<bool, 1> bits_values;
       for (int64_t i = 0; i < node->BitCountOrDie(); ++i) {
@@ -74,6 +82,16 @@ absl::StatusOr<ReachedFixpoint> BddQueryEngine::Populate(FunctionBase* f) {
   return rf;
 }
 
+absl::StatusOr<ReachedFixpoint> BddQueryEngine::PopulateWithPathLimit(
+    FunctionBase* f, int64_t path_limit) {
+  if (bdd_function_ != nullptr && bdd_function_->function_base() == f &&
+      f->transform_version() == populated_transform_version_) {
+    bdd_function_->RaisePathLimit(path_limit);
+  }
+  path_limit_ = path_limit;
+  return Populate(f);
+}
+
 bool BddQueryEngine::AtMostOneTrue(
     absl::Span<TreeBitLocation const> bits) const {
   // Computing this property is quadratic (at least) so limit the width.
@@ -57,6 +57,12 @@ class BddQueryEngine : public QueryEngine {
 
   absl::StatusOr<ReachedFixpoint> Populate(FunctionBase* f) override;
 
+  // Raises the BDD path limit to `path_limit` and re-populates. Only the
+  // expressions which saturated at the previous limit (and their transitive
+  // users) are recomputed; everything else is reused from the memoized BDD.
+  absl::StatusOr<ReachedFixpoint> PopulateWithPathLimit(FunctionBase* f,
+                                                        int64_t path_limit);
+
   bool IsTracked(Node* node) const override {
     return known_bits_.contains(node);
   }
@@ -116,6 +122,10 @@ class BddQueryEngine : public QueryEngine {
 
   std::optional<std::function<bool(const Node*)>> node_filter_;
 
+  // Transform version of the FunctionBase when the BDD was last built. Used to
+  // reuse the memoized BDD across Populate calls when the IR is unchanged.
+  int64_t populated_transform_version_ = -1;
+
   // Indicates the bits at the output of each node which have known values.
   absl::flat_hash_map<Node*, Bits> known_bits_;
 
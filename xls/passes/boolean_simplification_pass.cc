@@ -15,6 +15,7 @@
 #include "xls/passes/boolean_simplification_pass.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <optional>
 #include <utility>
@@ -27,13 +28,13 @@
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_ops.h"
 #include "xls/ir/dfs_visitor.h"
-#include "xls/ir/format_preference.h"
 #include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
 #include "xls/ir/node_util.h"
@@ -48,9 +49,11 @@
 namespace xls {
 namespace {
 
-// We store up to two "frontier nodes" on the frontier of the boolean
-// computation -- if we have more than this many "frontier nodes", we switch
-// over to "TooMany" via the TooManySentinel type below.
+// The replacement catalogue below (see CreateTruthTables) describes logical
+// functions of up to three variables, arbitrarily named "X", "Y" and "Z".
+// Wider cones are still analyzed -- see kMaxConeInputs below -- and are
+// simplified when their truth table turns out to depend on at most this many
+// of the cone's inputs.
 constexpr int64_t kMaxFrontierNodes = 3;
 
 }  // namespace
@@ -198,11 +201,98 @@ namespace {
 
 using xls::internal::TruthTable;
 
-// Indicates more than kMaxFrontierNodes are involved in a boolean expression.
+// Number of cone inputs ("frontier nodes") we track exactly: the truth table
+// of a boolean function of 2^6 = 64 rows fits in a single uint64_t word (one
+// bit per row), so flowing a table through the cone costs one bitwise machine
+// operation per node.
+constexpr int64_t kMaxConeInputs = 6;
+
+// Returns the truth table column for cone input "i": bit "row" of the result
+// holds the value of input "i" in that row, with input 0 toggling slowest --
+// the same input ordering convention as TruthTable::GetInitialVector, just
+// over 64 rows instead of 8.
+constexpr uint64_t ConeInputVector(int64_t i) {
+  uint64_t vector = 0;
+  for (int64_t row = 0; row < 64; ++row) {
+    if ((row >> (kMaxConeInputs - 1 - i)) & 1) {
+      vector |= uint64_t{1} << row;
+    }
+  }
+  return vector;
+}
+
+constexpr std::array<uint64_t, kMaxConeInputs> kConeInputVectors = {
+    ConeInputVector(0), ConeInputVector(1), ConeInputVector(2),
+    ConeInputVector(3), ConeInputVector(4), ConeInputVector(5)};
+
+// Op kernel over uint64_t truth tables: folds the operand tables with the
+// logical operation "op". Each bitwise instruction evaluates all 64 rows of
+// the truth table at once. constexpr so kernels can also seed compile-time
+// tables.
+constexpr uint64_t ApplyOpKernel(Op op, absl::Span<const uint64_t> operands) {
+  uint64_t accum = operands[0];
+  switch (op) {
+    case Op::kAnd:
+    case Op::kNand:
+      for (uint64_t operand : operands.subspan(1)) {
+        accum &= operand;
+      }
+      break;
+    case Op::kOr:
+    case Op::kNor:
+      for (uint64_t operand : operands.subspan(1)) {
+        accum |= operand;
+      }
+      break;
+    case Op::kXor:
+      for (uint64_t operand : operands.subspan(1)) {
+        accum ^= operand;
+      }
+      break;
+    case Op::kNot:
+      break;
+    default:
+      LOG(FATAL) << "Unhandled logical operation: " << op;
+  }
+  if (op == Op::kNand || op == Op::kNor || op == Op::kNot) {
+    accum = ~accum;
+  }
+  return accum;
+}
+
+// Returns whether cone input "i" influences the given 64-row truth table;
+// i.e. whether some pair of rows differing only in input "i" disagree.
+constexpr bool InputInfluencesTable(uint64_t table, int64_t i) {
+  const int64_t delta = int64_t{1} << (kMaxConeInputs - 1 - i);
+  const uint64_t input_zero_rows = ~kConeInputVectors[i];
+  return (((table >> delta) ^ table) & input_zero_rows) != 0;
+}
+
+// Compresses a 64-row truth table which depends only on the cone inputs in
+// "support" (ascending) down to the canonical 8-row table over the catalogue
+// slots X, Y, Z -- support input 0 becomes X, input 1 becomes Y, etc.
+constexpr uint64_t CompressTableToSupport(uint64_t table,
+                                          absl::Span<const int64_t> support) {
+  uint64_t compressed = 0;
+  for (int64_t q = 0; q < 8; ++q) {
+    int64_t row = 0;
+    for (int64_t j = 0; j < static_cast<int64_t>(support.size()); ++j) {
+      if ((q >> (2 - j)) & 1) {
+        row |= int64_t{1} << (kMaxConeInputs - 1 - support[j]);
+      }
+    }
+    if ((table >> row) & 1) {
+      compressed |= uint64_t{1} << q;
+    }
+  }
+  return compressed;
+}
+
+// Indicates more than kMaxConeInputs are involved in a boolean expression.
 struct TooManySentinel {};
 
 // Type that notes the frontier nodes involved in a boolean expression.
-using FrontierVector = absl::InlinedVector<Node*, kMaxFrontierNodes>;
+using FrontierVector = absl::InlinedVector<Node*, kMaxConeInputs>;
 using Frontier = std::variant<FrontierVector, TooManySentinel>;
 
 bool HasFrontierVector(const Frontier& frontier) {
@@ -222,7 +312,7 @@ void AddNonBool(Node* node, Frontier* frontier) {
   if (std::find(nodes.begin(), nodes.end(), node) != nodes.end()) {
     return;  // Already present.
   }
-  if (nodes.size() >= kMaxFrontierNodes) {
+  if (nodes.size() >= kMaxConeInputs) {
     *frontier = TooManySentinel{};
     return;
   }
@@ -244,19 +334,6 @@ void Union(const Frontier& arg, Frontier* out) {
   }
 }
 
-// We arbitrarily call the node at index 0 in the frontier "X", and the one at
-// index 1 "Y".
-Node* GetX(const Frontier& frontier) {
-  return std::get<FrontierVector>(frontier)[0];
-}
-Node* GetY(const Frontier& frontier) {
-  return std::get<FrontierVector>(frontier)[1];
-}
-Node* GetZ(const Frontier& frontier) {
-  const auto& v = std::get<FrontierVector>(frontier);
-  return v.size() > 2 ? v[2] : nullptr;
-}
-
 // DFS tracker for boolean value flow.
 //
 // When we arrive at a node we potentially replace it with a simpler boolean
@@ -347,32 +424,54 @@ class BooleanFlowTracker : public DfsVisitorWithDefault {
     return *tables;
   }
 
-  // "operands" are the nodes on the frontier of the logical operations.
-  absl::StatusOr<Node*> ResolveTruthTable(const Bits& bits,
-                                          absl::Span<Node* const> operands,
+  // "table" is the 64-row truth table computed for "original" over the cone
+  // inputs in "frontier". Returns a replacement node, or nullptr if no
+  // simplification applies.
+  absl::StatusOr<Node*> ResolveTruthTable(uint64_t table,
+                                          const FrontierVector& frontier,
                                           Node* original) {
-    XLS_RET_CHECK(2 <= operands.size() && operands.size() <= 3);
+    const int64_t frontier_size = static_cast<int64_t>(frontier.size());
+    XLS_RET_CHECK(2 <= frontier_size && frontier_size <= kMaxConeInputs);
     FunctionBase* f = original->function_base();
-    if (bits.IsAllOnes()) {
+    if (table == ~uint64_t{0}) {
       return f->MakeNode<Literal>(original->loc(),
                                   Value(SBits(-1, original->BitCountOrDie())));
     }
-    if (bits.IsZero()) {
+    if (table == 0) {
       return f->MakeNode<Literal>(original->loc(),
                                   Value(UBits(0, original->BitCountOrDie())));
     }
 
+    // Reduce the table onto the cone inputs it actually depends on; a wide
+    // cone often collapses onto a function of only a few of its inputs. The
+    // catalogue only describes functions of up to kMaxFrontierNodes
+    // variables.
+    absl::InlinedVector<int64_t, kMaxFrontierNodes> support;
+    for (int64_t i = 0; i < frontier_size; ++i) {
+      if (InputInfluencesTable(table, i)) {
+        if (static_cast<int64_t>(support.size()) == kMaxFrontierNodes) {
+          return nullptr;  // Depends on too many inputs to match.
+        }
+        support.push_back(i);
+      }
+    }
+    std::vector<Node*> operands;
+    operands.reserve(support.size());
+    for (int64_t i : support) {
+      operands.push_back(frontier[i]);
+    }
+
     const auto& truth_tables = GetTruthTables();
-    auto it = truth_tables.find(bits.ToUint64().value());
+    auto it = truth_tables.find(CompressTableToSupport(table, support));
     if (it == truth_tables.end()) {
       return nullptr;  // No match.
     }
-    const TruthTable& table = it->second;
-    if (table.MatchesSymmetrical(original, operands)) {
+    const TruthTable& truth_table = it->second;
+    if (truth_table.MatchesSymmetrical(original, operands)) {
       // Already in minimal form.
       return nullptr;
     }
-    return table.CreateReplacement(original->loc(), operands, f);
+    return truth_table.CreateReplacement(original->loc(), operands, f);
   }
 
   absl::Status DefaultHandler(Node* node) override { return absl::OkStatus(); }
@@ -385,68 +484,57 @@ class BooleanFlowTracker : public DfsVisitorWithDefault {
   // Flows a truth table from the frontier to the output node "node".
   //
   // Starting at node, recursively invokes itself until it gets to the "frontier
-  // nodes" at the frontier of the boolean computation. Those get initialized
-  // with the full truth table of possibilities for two variables:
+  // nodes" at the frontier of the boolean computation. Cone input "i" gets
+  // initialized with its column of the full 64-row truth table
+  // (kConeInputVectors[i]); e.g. for the first two inputs:
   //
-  //    X: 0 0 1 1 0 0 1 1
-  //    Y: 0 1 0 1 0 1 0 1
-  //    Z: 0 0 0 0 1 1 1 1
+  //    input 0: 32 zero rows then 32 one rows
+  //    input 1: 16 zero rows, 16 one rows, repeated
   //
   // Once we've pushed this vector of possibilities though all the intermediate
-  // bitwise nodes what we're left with at "node" is the resulting logical
-  // function. At that point we can just look up whether there's a simplified
-  // expression of that logical function is and replace it accordingly, as we do
-  // in ResolveTruthTable().
+  // bitwise nodes -- one uint64_t op kernel per node -- what we're left with
+  // at "node" is the resulting logical function. At that point we can just
+  // look up whether there's a simplified expression of that logical function
+  // and replace it accordingly, as we do in ResolveTruthTable().
   //
   // Results are memoized in `memoized_results` because this function traces all
   // paths in an expression which can be exponential in worst case.
-  absl::StatusOr<Bits> FlowFromFrontierToNode(
-      const Frontier& frontier, Node* node,
-      absl::flat_hash_map<Node*, Bits>& memoized_results) {
+  absl::StatusOr<uint64_t> FlowFromFrontierToNode(
+      const FrontierVector& frontier, Node* node,
+      absl::flat_hash_map<Node*, uint64_t>& memoized_results) {
     if (auto it = memoized_results.find(node); it != memoized_results.end()) {
       return it->second;
     }
-    Bits result;
-    if (node == GetX(frontier)) {
-      result = TruthTable::GetInitialVector(0);
-    } else if (node == GetY(frontier)) {
-      result = TruthTable::GetInitialVector(1);
-    } else if (node == GetZ(frontier)) {
-      result = TruthTable::GetInitialVector(2);
+    uint64_t result;
+    if (auto frontier_it = std::find(frontier.begin(), frontier.end(), node);
+        frontier_it != frontier.end()) {
+      result = kConeInputVectors[frontier_it - frontier.begin()];
     } else {
-      std::vector<Bits> operands;
+      absl::InlinedVector<uint64_t, 4> operands;
       for (Node* operand : node->operands()) {
         XLS_ASSIGN_OR_RETURN(
-            Bits operand_result,
+            uint64_t operand_result,
             FlowFromFrontierToNode(frontier, operand, memoized_results));
         operands.push_back(operand_result);
       }
       switch (node->op()) {
         case Op::kAnd:
-          result = bits_ops::NaryAnd(operands);
-          break;
         case Op::kOr:
-          result = bits_ops::NaryOr(operands);
-          break;
         case Op::kXor:
-          result = bits_ops::NaryXor(operands);
-          break;
         case Op::kNand:
-          result = bits_ops::NaryNand(operands);
-          break;
         case Op::kNor:
-          result = bits_ops::NaryNor(operands);
+          result = ApplyOpKernel(node->op(), operands);
           break;
         case Op::kNot:
           XLS_RET_CHECK(operands.size() == 1);
-          result = bits_ops::Not(operands[0]);
+          result = ApplyOpKernel(Op::kNot, operands);
           break;
         default:
           LOG(FATAL) << "Expected node to be logical bitwise: " << node;
       }
     }
     memoized_results[node] = result;
-    return std::move(result);
+    return result;
   }
 
   absl::Status HandleLogicOp(Node* node) {
@@ -455,14 +543,15 @@ class BooleanFlowTracker : public DfsVisitorWithDefault {
     const Frontier& frontier = UnionOperandFrontier(node);
     if (HasFrontierVector(frontier) &&
         GetFrontierVector(frontier).size() >= 2) {
-      const auto& operands = GetFrontierVector(frontier);
-      absl::flat_hash_map<Node*, Bits> memoized_results;
-      XLS_ASSIGN_OR_RETURN(Bits result, FlowFromFrontierToNode(
-                                            frontier, node, memoized_results));
+      const FrontierVector& cone_inputs = GetFrontierVector(frontier);
+      absl::flat_hash_map<Node*, uint64_t> memoized_results;
+      XLS_ASSIGN_OR_RETURN(
+          uint64_t result,
+          FlowFromFrontierToNode(cone_inputs, node, memoized_results));
       VLOG(3) << "Flow result for " << node << ": "
-              << BitsToString(result, FormatPreference::kBinary, true);
+              << absl::StrFormat("%#018x", result);
       XLS_ASSIGN_OR_RETURN(Node * replacement,
-                           ResolveTruthTable(result, operands, node));
+                           ResolveTruthTable(result, cone_inputs, node));
       if (replacement == nullptr) {
         return absl::OkStatus();
       }
@@ -267,6 +267,49 @@ TEST_F(BooleanSimplificationPassTest, ManyPaths) {
   EXPECT_THAT(f->return_value(), m::And(m::Param("x"), m::Param("y")));
 }
 
+TEST_F(BooleanSimplificationPassTest, WideConeCollapsesToTwoInputs) {
+  // The cone has four inputs -- too many for the replacement catalogue -- but
+  // its truth table only depends on "c" and "d".
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+fn f(a: bits[8], b: bits[8], c: bits[8], d: bits[8]) -> bits[8] {
+  xor_abcd: bits[8] = xor(a, b, c, d)
+  xor_ab: bits[8] = xor(a, b)
+  ret xor: bits[8] = xor(xor_abcd, xor_ab)
+}
+  )",
+                                                       p.get()));
+  EXPECT_THAT(Run(f), IsOkAndHolds(true));
+  EXPECT_THAT(f->return_value(), m::Xor(m::Param("c"), m::Param("d")));
+}
+
+TEST_F(BooleanSimplificationPassTest, FiveVarsMakingAllOnes) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+fn f(a: bits[8], b: bits[8], c: bits[8], d: bits[8], e: bits[8]) -> bits[8] {
+  an: bits[8] = not(a)
+  ret or: bits[8] = or(a, an, b, c, d, e)
+}
+  )",
+                                                       p.get()));
+  EXPECT_THAT(Run(f), IsOkAndHolds(true));
+  EXPECT_THAT(f->return_value(), m::Literal(255));
+}
+
+TEST_F(BooleanSimplificationPassTest, TooManyConeInputs) {
+  // Seven cone inputs exceeds the tracking limit; the expression is left
+  // alone.
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+fn f(a: bits[8], b: bits[8], c: bits[8], d: bits[8], e: bits[8], g: bits[8], h: bits[8]) -> bits[8] {
+  xor_ab: bits[8] = xor(a, b)
+  ret xor: bits[8] = xor(xor_ab, c, d, e, g, h)
+}
+  )",
+                                                       p.get()));
+  EXPECT_THAT(Run(f), IsOkAndHolds(false));
+}
+
 // TODO(leary): 2019-10-11 Needs AOI21 logical function to map against.
 #if 0
 TEST_F(BooleanSimplificationPassTest, SimplifyRealWorld2) {
@@ -320,16 +320,33 @@ Node* GetSelectedCase(Select* select, const Bits& selector_value) {
 absl::StatusOr<bool> ConditionalSpecializationPass::RunOnFunctionBaseInternal(
     FunctionBase* f, const OptimizationPassOptions& options,
     PassResults* results) const {
-  std::vector<std::unique_ptr<QueryEngine>> query_engines;
-  query_engines.push_back(std::make_unique<StatelessQueryEngine>());
-  if (use_bdd_) {
-    query_engines.push_back(std::make_unique<BddQueryEngine>(
-        BddFunction::kDefaultPathLimit, IsCheapForBdds));
+  auto make_query_engine =
+      [&]() -> absl::StatusOr<std::unique_ptr<QueryEngine>> {
+    std::vector<std::unique_ptr<QueryEngine>> query_engines;
+    query_engines.push_back(std::make_unique<StatelessQueryEngine>());
+    if (use_bdd_) {
+      query_engines.push_back(std::make_unique<BddQueryEngine>(
+          BddFunction::kDefaultPathLimit, IsCheapForBdds));
+    }
+    return std::make_unique<UnionQueryEngine>(std::move(query_engines));
+  };
+
+  // Reuse an engine populated by an earlier pass where possible. The analysis
+  // cache is not thread-safe, so construct the engine locally when
+  // FunctionBases are processed concurrently.
+  QueryEngine* query_engine = nullptr;
+  std::unique_ptr<QueryEngine> local_query_engine;
+  if (options.worker_count == 1) {
+    XLS_ASSIGN_OR_RETURN(
+        query_engine,
+        results->analysis_cache.GetEngine(
+            use_bdd_ ? "stateless+bdd" : "stateless", f, make_query_engine));
+  } else {
+    XLS_ASSIGN_OR_RETURN(local_query_engine, make_query_engine());
+    XLS_RETURN_IF_ERROR(local_query_engine->Populate(f).status());
+    query_engine = local_query_engine.get();
   }
 
-  UnionQueryEngine query_engine(std::move(query_engines));
-  XLS_RETURN_IF_ERROR(query_engine.Populate(f).status());
-
   ConditionMap condition_map(f);
 
   // Iterate backwards through the graph because we add conditions at the case
@@ -497,7 +514,7 @@ absl::StatusOr<bool> ConditionalSpecializationPass::RunOnFunctionBaseInternal(
       // First check to see if the condition set directly implies a value for
       // the operand. If so replace with the implied value.
       if (std::optional<Bits> implied_value =
-              ImpliedNodeValue(edge_set, operand, query_engine);
+              ImpliedNodeValue(edge_set, operand, *query_engine);
           implied_value.has_value()) {
         VLOG(3) << absl::StreamFormat("Replacing operand %d of %s with %v",
                                       operand_no, node->GetName(),
@@ -538,7 +555,7 @@ absl::StatusOr<bool> ConditionalSpecializationPass::RunOnFunctionBaseInternal(
             break;
           }
           std::optional<Bits> implied_selector =
-              ImpliedNodeValue(edge_set, select->selector(), query_engine);
+              ImpliedNodeValue(edge_set, select->selector(), *query_engine);
           if (!implied_selector.has_value()) {
             break;
           }
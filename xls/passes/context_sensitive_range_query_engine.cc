@@ -42,6 +42,7 @@
 #include "xls/ir/interval_ops.h"
 #include "xls/ir/interval_set.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
 #include "xls/ir/ternary.h"
@@ -186,7 +187,7 @@ struct EquivalenceSet {
 class Analysis {
  public:
   struct InterestingStatesAndNodeList {
-    absl::flat_hash_map<Node*, int64_t> node_indices;
+    NodeMap<int64_t> node_indices;
     std::vector<std::pair<PredicateState, InlineBitmap>> state_and_nodes;
   };
   Analysis(
@@ -321,7 +322,7 @@ class Analysis {
   }
   absl::StatusOr<RangeQueryEngine> CalculateRangeGiven(
       PredicateState s, const InlineBitmap& interesting_nodes,
-      const absl::flat_hash_map<Node*, int64_t>& node_ids) const {
+      const NodeMap<int64_t>& node_ids) const {
     RangeQueryEngine result;
     absl::flat_hash_map<Node*, RangeData> known_data;
     XLS_ASSIGN_OR_RETURN(known_data, ExtractKnownData(s));
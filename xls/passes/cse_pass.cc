@@ -15,9 +15,14 @@
 #include "xls/passes/cse_pass.h"
 
 #include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
@@ -118,10 +123,96 @@ absl::StatusOr<bool> RunCse(FunctionBase* f,
   return changed;
 }
 
+// Incremental form of CSE which only attempts to eliminate the given changed
+// nodes (plus nodes whose operands change as a result of a replacement). A
+// node introduced or re-pointed by a preceding pass can only have become
+// equivalent to a node which shares all of its operands, so candidates are
+// drawn from the users of the changed node's least-fanout operand rather than
+// from a full-function scan.
+static absl::StatusOr<bool> RunIncrementalCse(
+    FunctionBase* f, std::deque<Node*> worklist,
+    absl::flat_hash_map<Node*, Node*>* replacements) {
+  bool changed = false;
+  absl::flat_hash_set<Node*> replaced;
+  while (!worklist.empty()) {
+    Node* node = worklist.front();
+    worklist.pop_front();
+    if (replaced.contains(node) || OpIsSideEffecting(node->op()) ||
+        node->operand_count() == 0) {
+      // Zero-operand nodes (literals and params) are left to the full sweep:
+      // params are never equivalent and duplicated literals are rare.
+      continue;
+    }
+    Node* search_operand = node->operand(0);
+    for (Node* operand : node->operands()) {
+      if (operand->users().size() < search_operand->users().size()) {
+        search_operand = operand;
+      }
+    }
+    std::vector<Node*> node_span_backing_store;
+    absl::Span<Node* const> node_operands_for_cse =
+        GetOperandsForCse(node, &node_span_backing_store);
+    for (Node* candidate : search_operand->users()) {
+      if (candidate == node || candidate->op() != node->op() ||
+          replaced.contains(candidate)) {
+        continue;
+      }
+      std::vector<Node*> candidate_span_backing_store;
+      if (node_operands_for_cse ==
+              GetOperandsForCse(candidate, &candidate_span_backing_store) &&
+          node->IsDefinitelyEqualTo(candidate)) {
+        VLOG(3) << absl::StreamFormat("Replacing %s with equivalent node %s",
+                                      node->GetName(), candidate->GetName());
+        // The users of `node` are about to change shape and may now duplicate
+        // other users of `candidate`.
+        for (Node* user : node->users()) {
+          worklist.push_back(user);
+        }
+        XLS_RETURN_IF_ERROR(node->ReplaceUsesWith(candidate));
+        if (replacements != nullptr) {
+          (*replacements)[node] = candidate;
+        }
+        replaced.insert(node);
+        changed = true;
+        break;
+      }
+    }
+  }
+  return changed;
+}
+
 absl::StatusOr<bool> CsePass::RunOnFunctionBaseInternal(
     FunctionBase* f, const OptimizationPassOptions& options,
     PassResults* results) const {
-  return RunCse(f, nullptr);
+  // Seed a worklist from only the nodes touched since our previous run on
+  // this function when the change journal reaches back that far; otherwise
+  // run a full sweep. Only usable when FunctionBases are processed serially
+  // as `results` is shared between workers.
+  std::optional<std::vector<int64_t>> changed_ids;
+  std::pair<std::string, std::string> last_run_key(short_name(), f->name());
+  if (options.worker_count == 1) {
+    auto it = results->last_run_versions.find(last_run_key);
+    if (it != results->last_run_versions.end()) {
+      changed_ids = f->ChangedNodeIdsSince(it->second);
+    }
+  }
+  bool changed = false;
+  if (changed_ids.has_value()) {
+    std::deque<Node*> worklist;
+    for (int64_t id : *changed_ids) {
+      if (Node* n = f->GetNodeById(id); n != nullptr) {
+        worklist.push_back(n);
+      }
+    }
+    XLS_ASSIGN_OR_RETURN(changed,
+                         RunIncrementalCse(f, std::move(worklist), nullptr));
+  } else {
+    XLS_ASSIGN_OR_RETURN(changed, RunCse(f, nullptr));
+  }
+  if (options.worker_count == 1) {
+    results->last_run_versions[last_run_key] = f->transform_version();
+  }
+  return changed;
 }
 
 REGISTER_OPT_PASS(CsePass);
@@ -26,8 +26,10 @@
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_matcher.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
 #include "xls/ir/package.h"
+#include "xls/ir/source_location.h"
 #include "xls/passes/dce_pass.h"
 #include "xls/passes/optimization_pass.h"
 
@@ -233,5 +235,38 @@ TEST_F(CsePassTest, NonCommutativeOperands) {
   EXPECT_NE(f->return_value()->operand(0), f->return_value()->operand(1));
 }
 
+TEST_F(CsePassTest, IncrementalSeedingAcrossRuns) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue y = fb.Param("y", p->GetBitsType(8));
+  fb.Not(fb.Add(x, y));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  PassResults results;
+  CsePass pass;
+  EXPECT_THAT(pass.RunOnFunctionBase(f, OptimizationPassOptions(), &results),
+              IsOkAndHolds(false));
+
+  // Duplicate the add/not expression and make the duplicate the return value.
+  // The second run with the same PassResults seeds its worklist from the
+  // change journal and still commons the duplicated expression.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * dup_add,
+      f->MakeNode<BinOp>(SourceInfo(), x.node(), y.node(), Op::kAdd));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * dup_not, f->MakeNode<UnOp>(SourceInfo(), dup_add, Op::kNot));
+  XLS_ASSERT_OK(f->set_return_value(dup_not));
+  EXPECT_THAT(pass.RunOnFunctionBase(f, OptimizationPassOptions(), &results),
+              IsOkAndHolds(true));
+  // One add and one not survive (plus the two userless duplicates awaiting
+  // DCE).
+  XLS_ASSERT_OK(DeadCodeEliminationPass()
+                    .RunOnFunctionBase(f, OptimizationPassOptions(), &results)
+                    .status());
+  EXPECT_EQ(f->node_count(), 4);
+  EXPECT_THAT(f->return_value(), m::Not(m::Add(m::Param("x"), m::Param("y"))));
+}
+
 }  // namespace
 }  // namespace xls
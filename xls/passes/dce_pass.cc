@@ -16,6 +16,10 @@
 
 #include <cstdint>
 #include <deque>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
@@ -38,10 +42,32 @@ absl::StatusOr<bool> DeadCodeEliminationPass::RunOnFunctionBaseInternal(
            (!OpIsSideEffecting(n->op()) || n->Is<Gate>());
   };
 
+  // Seed the worklist from only the nodes touched since our previous run on
+  // this function when the change journal reaches back that far; otherwise
+  // fall back to a full sweep. The transitive operand walk below finds
+  // everything else. Only usable when FunctionBases are processed serially as
+  // `results` is shared between workers.
   std::deque<Node*> worklist;
-  for (Node* n : f->nodes()) {
-    if (n->users().empty() && is_deletable(n)) {
-      worklist.push_back(n);
+  std::optional<std::vector<int64_t>> changed_ids;
+  std::pair<std::string, std::string> last_run_key(short_name(), f->name());
+  if (options.worker_count == 1) {
+    auto it = results->last_run_versions.find(last_run_key);
+    if (it != results->last_run_versions.end()) {
+      changed_ids = f->ChangedNodeIdsSince(it->second);
+    }
+  }
+  if (changed_ids.has_value()) {
+    for (int64_t id : *changed_ids) {
+      Node* n = f->GetNodeById(id);
+      if (n != nullptr && n->users().empty() && is_deletable(n)) {
+        worklist.push_back(n);
+      }
+    }
+  } else {
+    for (Node* n : f->nodes()) {
+      if (n->users().empty() && is_deletable(n)) {
+        worklist.push_back(n);
+      }
     }
   }
   int64_t removed_count = 0;
@@ -66,6 +92,9 @@ absl::StatusOr<bool> DeadCodeEliminationPass::RunOnFunctionBaseInternal(
   }
 
   VLOG(2) << "Removed " << removed_count << " dead nodes";
+  if (options.worker_count == 1) {
+    results->last_run_versions[last_run_key] = f->transform_version();
+  }
   return removed_count > 0;
 }
 
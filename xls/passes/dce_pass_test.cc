@@ -26,6 +26,9 @@
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_matcher.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/value.h"
 #include "xls/passes/optimization_pass.h"
 
@@ -163,5 +166,29 @@ TEST_F(DeadCodeEliminationPassTest, GateRemoved) {
   EXPECT_THAT(f->GetNode(kDeadNodeName), Not(IsOk()));
 }
 
+TEST_F(DeadCodeEliminationPassTest, IncrementalSeedingAcrossRuns) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  fb.Not(x);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  PassResults results;
+  DeadCodeEliminationPass pass;
+  EXPECT_THAT(pass.RunOnFunctionBase(f, OptimizationPassOptions(), &results),
+              IsOkAndHolds(false));
+
+  // Add a chain of dead nodes. The second run with the same PassResults seeds
+  // its worklist from the change journal and still removes the whole chain.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * dead_add,
+      f->MakeNode<BinOp>(SourceInfo(), x.node(), x.node(), Op::kAdd));
+  XLS_ASSERT_OK(f->MakeNode<UnOp>(SourceInfo(), dead_add, Op::kNeg).status());
+  EXPECT_EQ(f->node_count(), 4);
+  EXPECT_THAT(pass.RunOnFunctionBase(f, OptimizationPassOptions(), &results),
+              IsOkAndHolds(true));
+  EXPECT_EQ(f->node_count(), 2);
+}
+
 }  // namespace
 }  // namespace xls
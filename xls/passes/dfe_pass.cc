@@ -27,6 +27,7 @@
 #include "xls/data_structures/union_find.h"
 #include "xls/ir/block.h"
 #include "xls/ir/channel.h"
+#include "xls/ir/elaboration_cache.h"
 #include "xls/ir/function.h"  // IWYU pragma: keep
 #include "xls/ir/function_base.h"
 #include "xls/ir/instantiation.h"
@@ -91,11 +92,13 @@ struct FunctionBaseLiveness {
   absl::flat_hash_set<Channel*> live_global_channels;
 };
 
-absl::StatusOr<FunctionBaseLiveness> LivenessFromTopProc(Proc* top) {
+absl::StatusOr<FunctionBaseLiveness> LivenessFromTopProc(
+    Proc* top, ElaborationCache& elaborations) {
   if (top->is_new_style_proc()) {
-    XLS_ASSIGN_OR_RETURN(ProcElaboration elab, ProcElaboration::Elaborate(top));
+    XLS_ASSIGN_OR_RETURN(const ProcElaboration* elab,
+                         elaborations.GetProcElaboration(top));
     return FunctionBaseLiveness{.live_roots = std::vector<FunctionBase*>(
-                                    elab.procs().begin(), elab.procs().end()),
+                                    elab->procs().begin(), elab->procs().end()),
                                 .live_global_channels = {}};
   }
 
@@ -169,7 +172,8 @@ absl::StatusOr<bool> DeadFunctionEliminationPass::RunInternal(
 
   FunctionBaseLiveness liveness;
   if ((*top)->IsProc()) {
-    XLS_ASSIGN_OR_RETURN(liveness, LivenessFromTopProc((*top)->AsProcOrDie()));
+    XLS_ASSIGN_OR_RETURN(liveness, LivenessFromTopProc((*top)->AsProcOrDie(),
+                                                       results->elaborations));
   } else {
     liveness.live_roots = {*top};
   }
@@ -0,0 +1,112 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/function_specialization.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/function.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/value.h"
+#include "xls/ir/value_utils.h"
+#include "xls/passes/constant_folding_pass.h"
+#include "xls/passes/dce_pass.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/pass_base.h"
+#include "xls/passes/select_simplification_pass.h"
+
+namespace xls {
+namespace {
+
+// Verifies that each binding names a parameter of `function` and conforms to
+// its type.
+absl::Status ValidateBindings(
+    Function* function,
+    const absl::flat_hash_map<std::string, Value>& bound_params) {
+  for (const auto& [name, value] : bound_params) {
+    XLS_ASSIGN_OR_RETURN(Param * param, function->GetParamByName(name));
+    if (!ValueConformsToType(value, param->GetType())) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Value `%s` bound to parameter `%s` does not conform to its type %s",
+          value.ToString(), name, param->GetType()->ToString()));
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Propagates the newly-bound constants through `function`: folds operations
+// with literal operands, simplifies selects with constant selectors and
+// removes the dead remainder, to fixed point.
+absl::Status PropagateConstants(Function* function) {
+  OptimizationPassOptions options;
+  PassResults results;
+  bool changed = true;
+  while (changed) {
+    XLS_ASSIGN_OR_RETURN(bool folded,
+                         ConstantFoldingPass().RunOnFunctionBase(
+                             function, options, &results));
+    XLS_ASSIGN_OR_RETURN(bool simplified,
+                         SelectSimplificationPass().RunOnFunctionBase(
+                             function, options, &results));
+    XLS_ASSIGN_OR_RETURN(bool dced, DeadCodeEliminationPass().RunOnFunctionBase(
+                                        function, options, &results));
+    changed = folded || simplified || dced;
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<Function*> SpecializeFunction(
+    Function* function,
+    const absl::flat_hash_map<std::string, Value>& bound_params,
+    std::string_view new_name) {
+  XLS_RETURN_IF_ERROR(ValidateBindings(function, bound_params));
+  XLS_ASSIGN_OR_RETURN(Function * specialized, function->Clone(new_name));
+  for (const auto& [name, value] : bound_params) {
+    XLS_ASSIGN_OR_RETURN(Param * param, specialized->GetParamByName(name));
+    if (!param->IsDead()) {
+      XLS_RETURN_IF_ERROR(param->ReplaceUsesWithNew<Literal>(value).status());
+    }
+  }
+  XLS_RETURN_IF_ERROR(PropagateConstants(specialized));
+  return specialized;
+}
+
+absl::StatusOr<std::vector<Function*>> SpecializeFunctionBatch(
+    Function* function,
+    absl::Span<const absl::flat_hash_map<std::string, Value>> configurations) {
+  std::vector<Function*> specialized;
+  specialized.reserve(configurations.size());
+  for (int64_t i = 0; i < configurations.size(); ++i) {
+    XLS_ASSIGN_OR_RETURN(
+        Function * config_function,
+        SpecializeFunction(function, configurations[i],
+                           absl::StrCat(function->name(), "__config", i)));
+    specialized.push_back(config_function);
+  }
+  return specialized;
+}
+
+}  // namespace xls
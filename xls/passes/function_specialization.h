@@ -0,0 +1,54 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_FUNCTION_SPECIALIZATION_H_
+#define XLS_PASSES_FUNCTION_SPECIALIZATION_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/ir/function.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+
+// Creates a copy of `function` named `new_name` in the same package with the
+// parameters named in `bound_params` replaced by the given constant values,
+// then constant-propagates through the copy and prunes selects whose
+// selectors have become constant. Bound parameters remain in the specialized
+// function's signature (as dead parameters) so the specialized function can
+// be invoked with the original argument list; their values are simply
+// ignored. Returns an error if a bound name is not a parameter of `function`
+// or a bound value does not conform to the parameter's type. `function`
+// itself is unchanged.
+absl::StatusOr<Function*> SpecializeFunction(
+    Function* function,
+    const absl::flat_hash_map<std::string, Value>& bound_params,
+    std::string_view new_name);
+
+// Specializes `function` once per entry of `configurations`, as
+// `SpecializeFunction` above. The i-th result is named
+// "<function name>__config<i>". Configurations may bind different subsets of
+// the parameters.
+absl::StatusOr<std::vector<Function*>> SpecializeFunctionBatch(
+    Function* function,
+    absl::Span<const absl::flat_hash_map<std::string, Value>> configurations);
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_FUNCTION_SPECIALIZATION_H_
@@ -0,0 +1,131 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/function_specialization.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_matcher.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/package.h"
+#include "xls/ir/value.h"
+
+namespace m = ::xls::op_matchers;
+
+namespace xls {
+namespace {
+
+using status_testing::StatusIs;
+
+using ::testing::HasSubstr;
+
+class FunctionSpecializationTest : public IrTestBase {
+ protected:
+  // f(cfg: bits[1], x: bits[32]) = sel(cfg, [x + 1, x - 1])
+  absl::StatusOr<Function*> ConfigurableFunction(Package* p) {
+    FunctionBuilder fb(TestName(), p);
+    BValue cfg = fb.Param("cfg", p->GetBitsType(1));
+    BValue x = fb.Param("x", p->GetBitsType(32));
+    BValue one = fb.Literal(UBits(1, 32));
+    fb.Select(cfg, {fb.Add(x, one), fb.Subtract(x, one)});
+    return fb.Build();
+  }
+};
+
+TEST_F(FunctionSpecializationTest, BindsConfigAndPrunesSelect) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ConfigurableFunction(p.get()));
+  int64_t original_node_count = f->node_count();
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Function * specialized,
+      SpecializeFunction(f, {{"cfg", Value(UBits(1, 1))}}, "f_sub"));
+
+  EXPECT_THAT(specialized->return_value(),
+              m::Sub(m::Param("x"), m::Literal(UBits(1, 32))));
+  // The signature is unchanged: the bound parameter remains, dead.
+  ASSERT_EQ(specialized->params().size(), 2);
+  EXPECT_EQ(specialized->param(0)->GetName(), "cfg");
+  // The original function is untouched.
+  EXPECT_EQ(f->node_count(), original_node_count);
+}
+
+TEST_F(FunctionSpecializationTest, FullyConstantFoldsToLiteral) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ConfigurableFunction(p.get()));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Function * specialized,
+      SpecializeFunction(
+          f, {{"cfg", Value(UBits(0, 1))}, {"x", Value(UBits(41, 32))}},
+          "f_const"));
+
+  EXPECT_THAT(specialized->return_value(), m::Literal(UBits(42, 32)));
+}
+
+TEST_F(FunctionSpecializationTest, UnknownParameterNameFails) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ConfigurableFunction(p.get()));
+
+  EXPECT_THAT(
+      SpecializeFunction(f, {{"nope", Value(UBits(0, 1))}}, "f_bad").status(),
+      StatusIs(absl::StatusCode::kNotFound, HasSubstr("nope")));
+}
+
+TEST_F(FunctionSpecializationTest, MismatchedTypeFails) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ConfigurableFunction(p.get()));
+
+  EXPECT_THAT(
+      SpecializeFunction(f, {{"cfg", Value(UBits(0, 17))}}, "f_bad").status(),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("does not conform")));
+}
+
+TEST_F(FunctionSpecializationTest, BatchProducesPerConfigFunctions) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ConfigurableFunction(p.get()));
+
+  std::vector<absl::flat_hash_map<std::string, Value>> configurations = {
+      {{"cfg", Value(UBits(0, 1))}},
+      {{"cfg", Value(UBits(1, 1))}},
+  };
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Function*> specialized,
+                           SpecializeFunctionBatch(f, configurations));
+
+  ASSERT_EQ(specialized.size(), 2);
+  EXPECT_THAT(specialized[0]->return_value(),
+              m::Add(m::Param("x"), m::Literal(UBits(1, 32))));
+  EXPECT_THAT(specialized[1]->return_value(),
+              m::Sub(m::Param("x"), m::Literal(UBits(1, 32))));
+  EXPECT_EQ(specialized[0]->name(),
+            absl::StrCat(f->name(), "__config0"));
+  EXPECT_EQ(specialized[1]->name(),
+            absl::StrCat(f->name(), "__config1"));
+}
+
+}  // namespace
+}  // namespace xls
@@ -0,0 +1,140 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/gvn_pass.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/node_util.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
+#include "xls/ir/topo_sort.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/optimization_pass_registry.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls {
+
+namespace {
+
+// Returns the operands of `node` in the order used for hashing and
+// comparison. Commutative operations compare their operands as an unordered
+// set, so their operands are sorted by id into `span_backing_store` first
+// (ids are canonical here: uses have already been redirected onto class
+// representatives by the time a node is visited).
+absl::Span<Node* const> GetOperandsForGvn(
+    Node* node, std::vector<Node*>* span_backing_store) {
+  if (!OpIsCommutative(node->op())) {
+    return node->operands();
+  }
+  span_backing_store->insert(span_backing_store->begin(),
+                             node->operands().begin(), node->operands().end());
+  SortByNodeId(span_backing_store);
+  return *span_backing_store;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> RunGvn(FunctionBase* f,
+                            absl::flat_hash_map<Node*, Node*>* replacements) {
+  // Structural hash of each class representative. A node's hash is built from
+  // its op, its type and the hashes of its operands, so two nodes heading
+  // identical expression trees hash equally no matter how deep the trees are.
+  absl::flat_hash_map<Node*, uint64_t> structural_hash;
+  structural_hash.reserve(f->node_count());
+  auto hasher = absl::Hash<std::vector<uint64_t>>();
+  auto node_hash = [&](Node* node,
+                       absl::Span<Node* const> operands) -> uint64_t {
+    std::vector<uint64_t> parts;
+    parts.reserve(operands.size() + 3);
+    parts.push_back(static_cast<uint64_t>(node->op()));
+    // Types are interned in the package so the pointer is canonical.
+    parts.push_back(reinterpret_cast<uintptr_t>(node->GetType()));
+    if (node->Is<Literal>()) {
+      // Fold the literal payload into the hash so the (frequently numerous)
+      // literals of a function don't all land in one bucket. Other payload-
+      // carrying ops (e.g. bit slices) are discriminated well enough by type
+      // and operands; stray collisions are resolved by the equality check.
+      parts.push_back(
+          absl::Hash<std::string>()(node->As<Literal>()->value().ToString()));
+    }
+    for (Node* operand : operands) {
+      parts.push_back(structural_hash.at(operand));
+    }
+    return hasher(parts);
+  };
+
+  bool changed = false;
+  // Hash-cons table mapping structural hash to class representatives.
+  absl::flat_hash_map<uint64_t, std::vector<Node*>> table;
+  table.reserve(f->node_count());
+  for (Node* node : TopoSort(f)) {
+    std::vector<Node*> node_span_backing_store;
+    absl::Span<Node* const> node_operands =
+        GetOperandsForGvn(node, &node_span_backing_store);
+    uint64_t hash = node_hash(node, node_operands);
+    if (OpIsSideEffecting(node->op())) {
+      // Side-effecting nodes are never merged but still need a hash so their
+      // users can compute theirs. Their identity keeps the hash unique.
+      structural_hash[node] = absl::Hash<std::pair<uint64_t, int64_t>>()(
+          {hash, node->id()});
+      continue;
+    }
+    bool replaced = false;
+    for (Node* candidate : table[hash]) {
+      std::vector<Node*> candidate_span_backing_store;
+      if (node_operands ==
+              GetOperandsForGvn(candidate, &candidate_span_backing_store) &&
+          node->IsDefinitelyEqualTo(candidate)) {
+        VLOG(3) << absl::StreamFormat("Replacing %s with equivalent node %s",
+                                      node->GetName(), candidate->GetName());
+        // Redirecting uses now means nodes downstream in the topological
+        // order only ever see class representatives as operands, which is
+        // what makes a single pass sufficient.
+        XLS_RETURN_IF_ERROR(node->ReplaceUsesWith(candidate));
+        if (replacements != nullptr) {
+          (*replacements)[node] = candidate;
+        }
+        changed = true;
+        replaced = true;
+        break;
+      }
+    }
+    if (!replaced) {
+      structural_hash[node] = hash;
+      table[hash].push_back(node);
+    }
+  }
+  return changed;
+}
+
+absl::StatusOr<bool> GvnPass::RunOnFunctionBaseInternal(
+    FunctionBase* f, const OptimizationPassOptions& options,
+    PassResults* results) const {
+  return RunGvn(f, nullptr);
+}
+
+REGISTER_OPT_PASS(GvnPass);
+
+}  // namespace xls
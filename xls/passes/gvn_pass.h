@@ -0,0 +1,59 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_GVN_PASS_H_
+#define XLS_PASSES_GVN_PASS_H_
+
+#include <string_view>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls {
+
+// Deduplicates structurally equivalent expressions in `f` via hash-consing:
+// each node is assigned a structural hash built from its op, type and the
+// hashes of its (canonicalized) operands, and nodes which hash and compare
+// equal are commoned onto a single representative. Because nodes are visited
+// in topological order and uses are redirected to representatives as classes
+// are formed, arbitrarily deep duplicated cones collapse in a single pass.
+// Each replacement is recorded in `replacements` if it is not `nullptr`.
+absl::StatusOr<bool> RunGvn(FunctionBase* f,
+                            absl::flat_hash_map<Node*, Node*>* replacements);
+
+// Pass which performs global value numbering. Subsumes the deduplication done
+// by `CsePass` but hashes structurally -- literal payloads and operand
+// equivalence classes are folded into the hash rather than bucketing on raw
+// operand ids -- so duplicated expression trees produced by generated code are
+// collapsed in one iteration instead of over repeated fixed-point rounds.
+class GvnPass : public OptimizationFunctionBasePass {
+ public:
+  static constexpr std::string_view kName = "gvn";
+  GvnPass()
+      : OptimizationFunctionBasePass(kName, "Global value numbering") {}
+  ~GvnPass() override = default;
+
+ protected:
+  absl::StatusOr<bool> RunOnFunctionBaseInternal(
+      FunctionBase* f, const OptimizationPassOptions& options,
+      PassResults* results) const override;
+};
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_GVN_PASS_H_
@@ -0,0 +1,142 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/gvn_pass.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/matchers.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/function.h"
+#include "xls/ir/ir_matcher.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/package.h"
+#include "xls/passes/dce_pass.h"
+#include "xls/passes/optimization_pass.h"
+
+namespace m = ::xls::op_matchers;
+
+namespace xls {
+namespace {
+
+using status_testing::IsOkAndHolds;
+
+class GvnPassTest : public IrTestBase {
+ protected:
+  GvnPassTest() = default;
+
+  absl::StatusOr<bool> Run(Function* f) {
+    PassResults results;
+    XLS_ASSIGN_OR_RETURN(
+        bool changed,
+        GvnPass().RunOnFunctionBase(f, OptimizationPassOptions(), &results));
+    // Run dce to clean things up.
+    XLS_RETURN_IF_ERROR(
+        DeadCodeEliminationPass()
+            .RunOnFunctionBase(f, OptimizationPassOptions(), &results)
+            .status());
+    // Return whether gvn changed anything.
+    return changed;
+  }
+};
+
+TEST_F(GvnPassTest, SingleLiteralNoChange) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+     fn single_literal() -> bits[2] {
+        ret one: bits[2] = literal(value=1)
+     }
+  )",
+                                                       p.get()));
+  EXPECT_EQ(f->node_count(), 1);
+  EXPECT_THAT(Run(f), IsOkAndHolds(false));
+  EXPECT_EQ(f->node_count(), 1);
+}
+
+TEST_F(GvnPassTest, DifferentLiteralsNotMerged) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+     fn different_literals() -> (bits[2], bits[2]) {
+        literal.1: bits[2] = literal(value=1)
+        literal.2: bits[2] = literal(value=2)
+        ret tuple.3: (bits[2], bits[2]) = tuple(literal.1, literal.2)
+     }
+  )",
+                                                       p.get()));
+  EXPECT_EQ(f->node_count(), 3);
+  EXPECT_THAT(Run(f), IsOkAndHolds(false));
+  EXPECT_EQ(f->node_count(), 3);
+}
+
+TEST_F(GvnPassTest, DuplicatedDeepConeCollapsesInOnePass) {
+  // Two copies of the same expression tree all the way down to duplicated
+  // literal leaves. Structural hashing collapses the whole cone in a single
+  // run, including the leaves, so only one copy of each node survives.
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+     fn deep_cone(x: bits[8], y: bits[8]) -> bits[8] {
+        literal.1: bits[8] = literal(value=42)
+        literal.2: bits[8] = literal(value=42)
+        add.3: bits[8] = add(x, literal.1)
+        add.4: bits[8] = add(x, literal.2)
+        and.5: bits[8] = and(add.3, y)
+        and.6: bits[8] = and(add.4, y)
+        neg.7: bits[8] = neg(and.5)
+        neg.8: bits[8] = neg(and.6)
+        ret add.9: bits[8] = add(neg.7, neg.8)
+     }
+  )",
+                                                       p.get()));
+  EXPECT_EQ(f->node_count(), 11);
+  EXPECT_THAT(Run(f), IsOkAndHolds(true));
+  EXPECT_EQ(f->node_count(), 7);
+  EXPECT_EQ(f->return_value()->operand(0), f->return_value()->operand(1));
+}
+
+TEST_F(GvnPassTest, CommutativeOperandOrder) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+     fn commutative(x: bits[8], y: bits[8]) -> bits[8] {
+        add.1: bits[8] = add(x, y)
+        add.2: bits[8] = add(y, x)
+        ret sub.3: bits[8] = sub(add.1, add.2)
+     }
+  )",
+                                                       p.get()));
+  EXPECT_EQ(f->node_count(), 5);
+  EXPECT_THAT(Run(f), IsOkAndHolds(true));
+  EXPECT_EQ(f->node_count(), 4);
+  EXPECT_THAT(f->return_value(),
+              m::Sub(m::Add(m::Param("x"), m::Param("y")),
+                     m::Add(m::Param("x"), m::Param("y"))));
+}
+
+TEST_F(GvnPassTest, NonCommutativeOperandOrderNotMerged) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(R"(
+     fn non_commutative(x: bits[8], y: bits[8]) -> (bits[8], bits[8]) {
+        sub.1: bits[8] = sub(x, y)
+        sub.2: bits[8] = sub(y, x)
+        ret tuple.3: (bits[8], bits[8]) = tuple(sub.1, sub.2)
+     }
+  )",
+                                                       p.get()));
+  EXPECT_EQ(f->node_count(), 5);
+  EXPECT_THAT(Run(f), IsOkAndHolds(false));
+  EXPECT_EQ(f->node_count(), 5);
+}
+
+}  // namespace
+}  // namespace xls
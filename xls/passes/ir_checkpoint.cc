@@ -0,0 +1,182 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/ir_checkpoint.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "xls/ir/channel.h"
+#include "xls/ir/fileno.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+namespace {
+
+// Mirrors the header portion of Package::DumpIr: the package declaration,
+// file number table and channel definitions, each section followed by a blank
+// line.
+std::string DumpPreamble(Package* package) {
+  std::string out = absl::StrCat("package ", package->name(), "\n\n");
+  if (!package->fileno_to_name().empty()) {
+    std::vector<Fileno> filenos;
+    filenos.reserve(package->fileno_to_name().size());
+    for (const auto& [fileno, filename] : package->fileno_to_name()) {
+      filenos.push_back(fileno);
+    }
+    std::sort(filenos.begin(), filenos.end());
+    for (Fileno fileno : filenos) {
+      absl::StrAppend(&out, "file_number ", static_cast<int32_t>(fileno), " \"",
+                      package->fileno_to_name().at(fileno), "\"\n");
+    }
+    absl::StrAppend(&out, "\n");
+  }
+  if (!package->channels().empty()) {
+    for (Channel* channel : package->channels()) {
+      absl::StrAppend(&out, channel->ToString(), "\n");
+    }
+    absl::StrAppend(&out, "\n");
+  }
+  return out;
+}
+
+// The dump of `fb` as it appears in a package dump: attributes, `top` marker
+// and body, followed by a blank separator line.
+std::string DumpDecoratedFunction(FunctionBase* fb, bool is_top) {
+  std::string out;
+  std::vector<std::string> attribute_strings = fb->AttributeIrStrings();
+  if (!attribute_strings.empty()) {
+    absl::StrAppend(&out, "#[", absl::StrJoin(attribute_strings, ", "), "]\n");
+  }
+  if (is_top) {
+    absl::StrAppend(&out, "top ");
+  }
+  absl::StrAppend(&out, fb->DumpIr(), "\n");
+  return out;
+}
+
+}  // namespace
+
+void IrCheckpointStore::Record(Package* package, std::string_view pass_name,
+                               int64_t ordinal, bool changed) {
+  Checkpoint checkpoint;
+  checkpoint.pass_name = std::string(pass_name);
+  checkpoint.ordinal = ordinal;
+  checkpoint.changed = changed;
+
+  std::string preamble = DumpPreamble(package);
+  if (!checkpoints_.empty() && *checkpoints_.back().preamble == preamble) {
+    checkpoint.preamble = checkpoints_.back().preamble;
+  } else {
+    checkpoint.preamble =
+        std::make_shared<const std::string>(std::move(preamble));
+  }
+
+  FunctionBase* top = package->GetTop().value_or(nullptr);
+  checkpoint.function_dumps.reserve(package->GetFunctionBases().size());
+  for (FunctionBase* fb : package->GetFunctionBases()) {
+    bool is_top = fb == top;
+    // The transform version covers structural changes; the decorations (which
+    // can change without a transform) are folded into the key directly.
+    std::string key = absl::StrFormat(
+        "%s#%d#%s#%s", fb->name(), fb->transform_version(),
+        is_top ? "top" : "",
+        absl::StrJoin(fb->AttributeIrStrings(), ","));
+    auto it = dumps_.find(key);
+    if (it == dumps_.end()) {
+      it = dumps_
+               .insert({std::move(key), std::make_shared<const std::string>(
+                                            DumpDecoratedFunction(fb, is_top))})
+               .first;
+    }
+    checkpoint.function_dumps.push_back(
+        FunctionDump{.name = fb->name(), .text = it->second});
+  }
+  checkpoints_.push_back(std::move(checkpoint));
+}
+
+absl::StatusOr<const IrCheckpointStore::Checkpoint*>
+IrCheckpointStore::GetCheckpoint(int64_t ordinal) const {
+  for (const Checkpoint& checkpoint : checkpoints_) {
+    if (checkpoint.ordinal == ordinal) {
+      return &checkpoint;
+    }
+  }
+  return absl::NotFoundError(absl::StrFormat(
+      "No IR checkpoint recorded for pass invocation %d", ordinal));
+}
+
+/* static */ std::string IrCheckpointStore::Materialize(
+    const Checkpoint& checkpoint) {
+  std::string out = *checkpoint.preamble;
+  for (const FunctionDump& dump : checkpoint.function_dumps) {
+    absl::StrAppend(&out, *dump.text);
+  }
+  // Package text does not include a trailing newline.
+  CHECK(!out.empty());
+  CHECK_EQ(out.back(), '\n');
+  out.pop_back();
+  return out;
+}
+
+/* static */ std::vector<std::string> IrCheckpointStore::DifferingFunctions(
+    const Checkpoint& before, const Checkpoint& after) {
+  absl::flat_hash_map<std::string_view, const std::shared_ptr<const std::string>*>
+      before_dumps;
+  for (const FunctionDump& dump : before.function_dumps) {
+    before_dumps.insert({dump.name, &dump.text});
+  }
+  std::vector<std::string> differing;
+  absl::flat_hash_set<std::string_view> in_after;
+  for (const FunctionDump& dump : after.function_dumps) {
+    in_after.insert(dump.name);
+    auto it = before_dumps.find(dump.name);
+    if (it == before_dumps.end()) {
+      differing.push_back(dump.name);
+      continue;
+    }
+    // Shared storage: identical pointers mean identical text. Different
+    // pointers can still be equal text (e.g. a transform that was undone), so
+    // compare contents on pointer mismatch.
+    if (it->second->get() != dump.text.get() && **it->second != *dump.text) {
+      differing.push_back(dump.name);
+    }
+  }
+  for (const FunctionDump& dump : before.function_dumps) {
+    if (!in_after.contains(dump.name)) {
+      differing.push_back(dump.name);
+    }
+  }
+  return differing;
+}
+
+void IrCheckpointStore::Clear() {
+  checkpoints_.clear();
+  dumps_.clear();
+}
+
+}  // namespace xls
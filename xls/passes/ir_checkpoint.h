@@ -0,0 +1,95 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_IR_CHECKPOINT_H_
+#define XLS_PASSES_IR_CHECKPOINT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+
+// An in-memory store of per-pass IR checkpoints. A checkpoint records the
+// complete state of a package, but only functions transformed since their
+// text was last recorded are re-dumped: unchanged function bodies share
+// storage across checkpoints (keyed by the FunctionBase's transform version),
+// so keeping checkpointing enabled is cheap on the many pass invocations
+// which change little or nothing -- unlike --ir_dump_path, which writes the
+// full textual IR to disk after every pass.
+class IrCheckpointStore {
+ public:
+  struct FunctionDump {
+    std::string name;
+    // Decorated textual dump (attributes, `top` marker, body). Shared with
+    // every other checkpoint in which the function is unchanged.
+    std::shared_ptr<const std::string> text;
+  };
+
+  struct Checkpoint {
+    // Short name of the pass after which the checkpoint was taken.
+    std::string pass_name;
+    // Ordinal of the pass invocation (index into PassResults::invocations).
+    int64_t ordinal;
+    // Whether the pass reported changing the IR.
+    bool changed;
+    // Package-level preamble: package declaration, file numbers and channels.
+    std::shared_ptr<const std::string> preamble;
+    // Per-function dumps in package dump order.
+    std::vector<FunctionDump> function_dumps;
+  };
+
+  // Records the current state of `package` as a checkpoint taken after pass
+  // invocation `ordinal` of the pass with the given short name.
+  void Record(Package* package, std::string_view pass_name, int64_t ordinal,
+              bool changed);
+
+  absl::Span<const Checkpoint> checkpoints() const { return checkpoints_; }
+
+  // Returns the checkpoint recorded for pass invocation `ordinal`, or
+  // NotFoundError if no checkpoint was recorded for it.
+  absl::StatusOr<const Checkpoint*> GetCheckpoint(int64_t ordinal) const;
+
+  // Returns the full IR text of the given checkpoint; byte-identical to what
+  // Package::DumpIr returned at recording time.
+  static std::string Materialize(const Checkpoint& checkpoint);
+
+  // Returns the names of the functions whose text differs between the two
+  // checkpoints, in the order of `after`; functions present in only one of
+  // the checkpoints are included. Shared storage makes this a pointer
+  // comparison per function.
+  static std::vector<std::string> DifferingFunctions(const Checkpoint& before,
+                                                     const Checkpoint& after);
+
+  // Drops all checkpoints and their shared storage.
+  void Clear();
+
+ private:
+  std::vector<Checkpoint> checkpoints_;
+
+  // Dump text shared across checkpoints, keyed by function name, transform
+  // version and dump decorations.
+  absl::flat_hash_map<std::string, std::shared_ptr<const std::string>> dumps_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_IR_CHECKPOINT_H_
@@ -0,0 +1,121 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/ir_checkpoint.h"
+
+#include <string_view>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/package.h"
+#include "xls/ir/source_location.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+using status_testing::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+class IrCheckpointTest : public IrTestBase {
+ protected:
+  absl::StatusOr<Function*> MakeIdentityFunction(Package* p,
+                                                 std::string_view name) {
+    FunctionBuilder fb(name, p);
+    fb.Identity(fb.Param("x", p->GetBitsType(32)));
+    return fb.Build();
+  }
+};
+
+TEST_F(IrCheckpointTest, MaterializeMatchesDumpIr) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK(MakeIdentityFunction(p.get(), "f").status());
+  XLS_ASSERT_OK(MakeIdentityFunction(p.get(), "g").status());
+  XLS_ASSERT_OK(p->SetTopByName("f"));
+
+  IrCheckpointStore store;
+  store.Record(p.get(), "dce", /*ordinal=*/0, /*changed=*/false);
+  XLS_ASSERT_OK_AND_ASSIGN(const IrCheckpointStore::Checkpoint* checkpoint,
+                           store.GetCheckpoint(0));
+  EXPECT_EQ(checkpoint->pass_name, "dce");
+  EXPECT_FALSE(checkpoint->changed);
+  EXPECT_EQ(IrCheckpointStore::Materialize(*checkpoint), p->DumpIr());
+}
+
+TEST_F(IrCheckpointTest, UnchangedFunctionsShareStorage) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, MakeIdentityFunction(p.get(), "f"));
+  XLS_ASSERT_OK(MakeIdentityFunction(p.get(), "g").status());
+
+  IrCheckpointStore store;
+  store.Record(p.get(), "dce", /*ordinal=*/0, /*changed=*/false);
+
+  // Transform f; g remains untouched.
+  XLS_ASSERT_OK(f->MakeNode<Literal>(SourceInfo(), Value(UBits(42, 32))));
+  store.Record(p.get(), "cse", /*ordinal=*/1, /*changed=*/true);
+
+  XLS_ASSERT_OK_AND_ASSIGN(const IrCheckpointStore::Checkpoint* before,
+                           store.GetCheckpoint(0));
+  XLS_ASSERT_OK_AND_ASSIGN(const IrCheckpointStore::Checkpoint* after,
+                           store.GetCheckpoint(1));
+  ASSERT_EQ(before->function_dumps.size(), 2);
+  ASSERT_EQ(after->function_dumps.size(), 2);
+  // g's dump is the same shared string in both checkpoints; f's is not.
+  EXPECT_EQ(before->function_dumps[1].text.get(),
+            after->function_dumps[1].text.get());
+  EXPECT_NE(before->function_dumps[0].text.get(),
+            after->function_dumps[0].text.get());
+  EXPECT_EQ(before->preamble.get(), after->preamble.get());
+
+  EXPECT_THAT(IrCheckpointStore::DifferingFunctions(*before, *after),
+              ElementsAre("f"));
+  EXPECT_EQ(IrCheckpointStore::Materialize(*after), p->DumpIr());
+}
+
+TEST_F(IrCheckpointTest, DifferingFunctionsIncludesAddedAndRemoved) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK(MakeIdentityFunction(p.get(), "f").status());
+
+  IrCheckpointStore store;
+  store.Record(p.get(), "dce", /*ordinal=*/0, /*changed=*/false);
+  XLS_ASSERT_OK(MakeIdentityFunction(p.get(), "g").status());
+  store.Record(p.get(), "inlining", /*ordinal=*/1, /*changed=*/true);
+
+  XLS_ASSERT_OK_AND_ASSIGN(const IrCheckpointStore::Checkpoint* before,
+                           store.GetCheckpoint(0));
+  XLS_ASSERT_OK_AND_ASSIGN(const IrCheckpointStore::Checkpoint* after,
+                           store.GetCheckpoint(1));
+  EXPECT_THAT(IrCheckpointStore::DifferingFunctions(*before, *after),
+              UnorderedElementsAre("g"));
+  EXPECT_THAT(IrCheckpointStore::DifferingFunctions(*after, *before),
+              UnorderedElementsAre("g"));
+}
+
+TEST_F(IrCheckpointTest, GetCheckpointNotFound) {
+  IrCheckpointStore store;
+  EXPECT_THAT(store.GetCheckpoint(3),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+}  // namespace
+}  // namespace xls
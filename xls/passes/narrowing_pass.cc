@@ -1719,7 +1719,20 @@ static void RangeAnalysisLog(FunctionBase* f,
   }
 }
 
-static absl::StatusOr<std::unique_ptr<QueryEngine>> GetQueryEngine(
+// Returns the name under which the composed query engine for the given
+// analysis type is registered in the analysis cache.
+static std::string_view QueryEngineName(AnalysisType analysis) {
+  switch (analysis) {
+    case AnalysisType::kRangeWithContext:
+      return "stateless+ternary+context_range";
+    case AnalysisType::kRange:
+      return "stateless+ternary+range";
+    default:
+      return "stateless+ternary";
+  }
+}
+
+static absl::StatusOr<std::unique_ptr<QueryEngine>> MakeQueryEngine(
     FunctionBase* f, AnalysisType analysis) {
   std::unique_ptr<QueryEngine> query_engine;
   if (analysis == AnalysisType::kRangeWithContext) {
@@ -1755,20 +1768,34 @@ static absl::StatusOr<std::unique_ptr<QueryEngine>> GetQueryEngine(
     engines.push_back(std::make_unique<TernaryQueryEngine>());
     query_engine = std::make_unique<UnionQueryEngine>(std::move(engines));
   }
-  XLS_RETURN_IF_ERROR(query_engine->Populate(f).status());
   return std::move(query_engine);
 }
 
 absl::StatusOr<bool> NarrowingPass::RunOnFunctionBaseInternal(
     FunctionBase* f, const OptimizationPassOptions& options,
     PassResults* results) const {
-  XLS_ASSIGN_OR_RETURN(std::unique_ptr<QueryEngine> query_engine,
-                       GetQueryEngine(f, RealAnalysis(options)));
+  AnalysisType analysis = RealAnalysis(options);
+  // Reuse an engine populated by an earlier pass where possible. The analysis
+  // cache is not thread-safe, so construct the engine locally when
+  // FunctionBases are processed concurrently.
+  QueryEngine* query_engine = nullptr;
+  std::unique_ptr<QueryEngine> local_query_engine;
+  if (options.worker_count == 1) {
+    XLS_ASSIGN_OR_RETURN(
+        query_engine,
+        results->analysis_cache.GetEngine(
+            QueryEngineName(analysis), f,
+            [&] { return MakeQueryEngine(f, analysis); }));
+  } else {
+    XLS_ASSIGN_OR_RETURN(local_query_engine, MakeQueryEngine(f, analysis));
+    XLS_RETURN_IF_ERROR(local_query_engine->Populate(f).status());
+    query_engine = local_query_engine.get();
+  }
 
   PredicateDominatorAnalysis pda = PredicateDominatorAnalysis::Run(f);
-  SpecializedQueryEngines sqe(RealAnalysis(options), pda, *query_engine);
+  SpecializedQueryEngines sqe(analysis, pda, *query_engine);
 
-  NarrowVisitor narrower(sqe, RealAnalysis(options), options,
+  NarrowVisitor narrower(sqe, analysis, options,
                          SplitsEnabled(opt_level_));
 
   for (Node* node : TopoSort(f)) {
@@ -18,7 +18,6 @@
 #include <tuple>
 #include <utility>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -26,6 +25,7 @@
 #include "xls/data_structures/inline_bitmap.h"
 #include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/topo_sort.h"
 
 namespace xls {
@@ -38,13 +38,11 @@ namespace {
 // searched). Preds returns the nodes the argument depends on. iter is the
 // iterator to walk the function in the topological order defined by preds.
 template <typename Predecessors>
-std::tuple<absl::flat_hash_map<Node*, InlineBitmap>,
-           absl::flat_hash_map<Node*, int64_t>>
+std::tuple<NodeMap<InlineBitmap>, NodeMap<int64_t>>
 AnalyzeDependents(FunctionBase* f,
                   const absl::flat_hash_set<Node*>& interesting_nodes,
                   Predecessors preds, absl::Span<Node* const> topo_sort) {
-  absl::flat_hash_map<Node*, int64_t> node_ids;
-  node_ids.reserve(f->node_count());
+  NodeMap<int64_t> node_ids(f->package());
   int64_t cnt = 0;
   for (Node* n : f->nodes()) {
     node_ids[n] = cnt++;
@@ -63,10 +61,10 @@ AnalyzeDependents(FunctionBase* f,
     return seen_interesting_nodes_count == interesting_nodes.size();
   };
   int64_t bitmap_size = f->node_count();
-  absl::flat_hash_map<Node*, InlineBitmap> results;
-  results.reserve(f->node_count());
+  NodeMap<InlineBitmap> results(f->package());
   for (Node* n : topo_sort) {
-    InlineBitmap& bm = results.emplace(n, bitmap_size).first->second;
+    results.insert_or_assign(n, InlineBitmap(bitmap_size));
+    InlineBitmap& bm = results.at(n);
     bm.Set(node_ids[n]);
     for (Node* pred : preds(n)) {
       bm.Union(results.at(pred));
@@ -76,9 +74,12 @@ AnalyzeDependents(FunctionBase* f,
     }
   }
   // To avoid any bugs delete everything that's not specifically requested.
-  absl::erase_if(results,
-                 [&](auto& pair) { return !is_interesting(pair.first); });
-  return {results, node_ids};
+  for (Node* n : f->nodes()) {
+    if (!is_interesting(n)) {
+      results.erase(n);
+    }
+  }
+  return {std::move(results), std::move(node_ids)};
 }
 
 }  // namespace
@@ -97,7 +98,8 @@ NodeDependencyAnalysis NodeDependencyAnalysis::BackwardDependents(
   auto [dependents, node_ids] = AnalyzeDependents(
       fb, interesting, [](Node* node) { return node->operands(); },
       TopoSort(fb));
-  return NodeDependencyAnalysis(/*is_forwards=*/false, dependents, node_ids);
+  return NodeDependencyAnalysis(/*is_forwards=*/false, std::move(dependents),
+                                std::move(node_ids));
 }
 
 NodeDependencyAnalysis NodeDependencyAnalysis::ForwardDependents(
@@ -106,7 +108,8 @@ NodeDependencyAnalysis NodeDependencyAnalysis::ForwardDependents(
   auto [dependents, node_ids] = AnalyzeDependents(
       fb, interesting, [](Node* node) { return node->users(); },
       ReverseTopoSort(fb));
-  return NodeDependencyAnalysis(/*is_forwards=*/true, dependents, node_ids);
+  return NodeDependencyAnalysis(/*is_forwards=*/true, std::move(dependents),
+                                std::move(node_ids));
 }
 
 }  // namespace xls
@@ -19,7 +19,6 @@
 #include <utility>
 
 #include "absl/base/attributes.h"
-#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
@@ -27,6 +26,7 @@
 #include "xls/data_structures/inline_bitmap.h"
 #include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 
 namespace xls {
 
@@ -40,9 +40,7 @@ class DependencyBitmap {
   DependencyBitmap& operator=(DependencyBitmap&&) = delete;
 
   const InlineBitmap& bitmap() const { return bitmap_; }
-  const absl::flat_hash_map<Node*, int64_t>& node_indices() const {
-    return node_indices_;
-  }
+  const NodeMap<int64_t>& node_indices() const { return node_indices_; }
   absl::StatusOr<bool> IsDependent(Node* n) const {
     if (!node_indices_.contains(n)) {
       return absl::InvalidArgumentError("node is from a different function!");
@@ -52,11 +50,11 @@ class DependencyBitmap {
 
  private:
   DependencyBitmap(const InlineBitmap& bitmap ABSL_ATTRIBUTE_LIFETIME_BOUND,
-                   const absl::flat_hash_map<Node*, int64_t>& node_indices
+                   const NodeMap<int64_t>& node_indices
                        ABSL_ATTRIBUTE_LIFETIME_BOUND)
       : bitmap_(bitmap), node_indices_(node_indices) {}
   const InlineBitmap& bitmap_;
-  const absl::flat_hash_map<Node*, int64_t>& node_indices_;
+  const NodeMap<int64_t>& node_indices_;
   friend class NodeDependencyAnalysis;
 };
 
@@ -102,21 +100,18 @@ class NodeDependencyAnalysis {
     XLS_ASSIGN_OR_RETURN(auto bitmap, GetDependents(from));
     return bitmap.IsDependent(to);
   }
-  const absl::flat_hash_map<Node*, int64_t>& node_indices() const {
-    return node_indices_;
-  }
+  const NodeMap<int64_t>& node_indices() const { return node_indices_; }
 
  private:
-  NodeDependencyAnalysis(bool is_forwards,
-                         absl::flat_hash_map<Node*, InlineBitmap> dependents,
-                         absl::flat_hash_map<Node*, int64_t> node_ids)
+  NodeDependencyAnalysis(bool is_forwards, NodeMap<InlineBitmap> dependents,
+                         NodeMap<int64_t> node_ids)
       : is_forward_(is_forwards),
         dependents_(std::move(dependents)),
         node_indices_(std::move(node_ids)) {}
 
   bool is_forward_;
-  absl::flat_hash_map<Node*, InlineBitmap> dependents_;
-  absl::flat_hash_map<Node*, int64_t> node_indices_;
+  NodeMap<InlineBitmap> dependents_;
+  NodeMap<int64_t> node_indices_;
 };
 
 }  // namespace xls
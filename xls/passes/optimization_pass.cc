@@ -20,6 +20,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -32,6 +33,8 @@
 #include "xls/common/logging/log_lines.h"
 #include "xls/common/math_util.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
+#include "xls/ir/call_graph.h"
 #include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
 #include "xls/ir/package.h"
@@ -145,18 +148,107 @@ absl::StatusOr<bool> OptimizationFunctionBasePass::RunOnFunctionBase(
   return changed;
 }
 
+int64_t DependentTransformVersion(FunctionBase* f) {
+  int64_t version = 0;
+  for (FunctionBase* dependency : GetDependentFunctions(f)) {
+    version += dependency->transform_version();
+  }
+  return version;
+}
+
+absl::flat_hash_map<std::string, int64_t>
+OptimizationFixedPointCompoundPass::SnapshotFunctionVersions(
+    Package* package) const {
+  absl::flat_hash_map<std::string, int64_t> versions;
+  for (FunctionBase* f : package->GetFunctionBases()) {
+    versions.insert({f->name(), DependentTransformVersion(f)});
+  }
+  return versions;
+}
+
+void OptimizationFixedPointCompoundPass::RecordConvergence(
+    Package* package,
+    const absl::flat_hash_map<std::string, int64_t>& versions_before,
+    PassResults* results) const {
+  for (FunctionBase* f : package->GetFunctionBases()) {
+    int64_t version = DependentTransformVersion(f);
+    auto it = versions_before.find(f->name());
+    if (it != versions_before.end() && it->second == version) {
+      // A complete iteration of the pipeline left `f` and everything it
+      // depends on untouched; rerunning the same passes on the same input
+      // cannot change it.
+      results->converged_function_versions.insert_or_assign(f->name(),
+                                                            version);
+    } else {
+      results->converged_function_versions.erase(f->name());
+    }
+  }
+}
+
 absl::StatusOr<bool> OptimizationFunctionBasePass::RunInternal(
     Package* p, const OptimizationPassOptions& options,
     PassResults* results) const {
+  if (options.worker_count > 1) {
+    return RunOnFunctionBasesInParallel(p, options, results);
+  }
   bool changed = false;
   for (FunctionBase* f : p->GetFunctionBases()) {
+    std::pair<std::string, std::string> cache_key(short_name(), f->name());
+    int64_t version_before = 0;
+    if (options.skip_unchanged_functions) {
+      version_before = DependentTransformVersion(f);
+      auto converged_it = results->converged_function_versions.find(f->name());
+      if (converged_it != results->converged_function_versions.end() &&
+          converged_it->second == version_before) {
+        VLOG(2) << absl::StreamFormat(
+            "Skipping %s on function_base %s; at fixed point.", short_name(),
+            f->name());
+        continue;
+      }
+      auto it = results->unchanged_function_versions.find(cache_key);
+      if (it != results->unchanged_function_versions.end() &&
+          it->second == version_before) {
+        VLOG(2) << absl::StreamFormat(
+            "Skipping %s on function_base %s; unchanged since last run.",
+            short_name(), f->name());
+        continue;
+      }
+    }
     XLS_ASSIGN_OR_RETURN(bool function_changed,
                          RunOnFunctionBaseInternal(f, options, results));
+    if (options.skip_unchanged_functions && !function_changed) {
+      results->unchanged_function_versions[cache_key] = version_before;
+    }
     changed = changed || function_changed;
   }
   return changed;
 }
 
+absl::StatusOr<bool> OptimizationFunctionBasePass::RunOnFunctionBasesInParallel(
+    Package* p, const OptimizationPassOptions& options,
+    PassResults* results) const {
+  bool changed = false;
+  // FunctionBases within a call graph level do not call each other so the pass
+  // may be run on them concurrently. Levels are processed in callee-first
+  // order so passes which specialize call sites (e.g., inlining) see fully
+  // optimized callees. The pool threads are reused across levels; the calling
+  // thread participates in each ParallelFor, so the pool holds one thread
+  // fewer than the configured worker count.
+  ThreadPool pool(options.worker_count - 1);
+  for (const std::vector<FunctionBase*>& level : CallGraphLevels(p)) {
+    std::vector<absl::StatusOr<bool>> function_results =
+        pool.ParallelMap<absl::StatusOr<bool>>(
+            static_cast<int64_t>(level.size()), [&](int64_t i) {
+              return RunOnFunctionBaseInternal(level[i], options, results);
+            });
+    for (const absl::StatusOr<bool>& function_result : function_results) {
+      XLS_ASSIGN_OR_RETURN(bool function_changed, function_result);
+      changed = changed || function_changed;
+    }
+  }
+  return changed;
+}
+
 absl::StatusOr<bool> OptimizationFunctionBasePass::TransformNodesToFixedPoint(
     FunctionBase* f,
     std::function<absl::StatusOr<bool>(Node*)> simplify_f) const {
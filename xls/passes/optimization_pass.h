@@ -116,6 +116,13 @@ struct OptimizationPassOptions : public PassOptionsBase {
   // the optimization pass pipeline which holds this value.
   bool inline_procs = false;
 
+  // If at least two, proc inlining proceeds hierarchically: clusters of up to
+  // this many tightly connected procs are inlined into intermediate container
+  // procs bottom-up before the final inline into the top proc. This bounds
+  // the activation-network book-keeping built by any single inlining step on
+  // packages with many procs. Zero (the default) inlines all procs at once.
+  int64_t proc_inlining_cluster_size = 0;
+
   // If this is not `std::nullopt`, convert array indexes with fewer than or
   // equal to the given number of possible indices (by range analysis) into
   // chains of selects. Otherwise, this optimization is skipped, since it can
@@ -133,6 +140,22 @@ struct OptimizationPassOptions : public PassOptionsBase {
 
   // Use select context during narrowing range analysis.
   bool use_context_narrowing_analysis = false;
+
+  // If true, function-scoped passes record the transform version of each
+  // FunctionBase (and its transitive callees) when a run makes no changes, and
+  // skip later invocations on functions whose versions are unchanged. This
+  // makes fixed-point pipelines incremental: iterations which only touch a few
+  // functions do not re-traverse the rest of the package. Only applies when
+  // FunctionBases are processed serially (worker_count == 1).
+  bool skip_unchanged_functions = false;
+
+  // Number of worker threads used to run function-scoped passes over the
+  // FunctionBases of a package. With the default value of one the
+  // FunctionBases are processed serially in deterministic order. Values
+  // greater than one process call-graph-independent FunctionBases
+  // concurrently; passes must only mutate the FunctionBase they are given for
+  // this to be safe.
+  int64_t worker_count = 1;
 };
 
 // An object containing information about the invocation of a pass (single call
@@ -143,8 +166,30 @@ struct OptimizationPassOptions : public PassOptionsBase {
 using OptimizationPass = PassBase<Package, OptimizationPassOptions>;
 using OptimizationCompoundPass =
     CompoundPassBase<Package, OptimizationPassOptions>;
-using OptimizationFixedPointCompoundPass =
-    FixedPointCompoundPassBase<Package, OptimizationPassOptions>;
+
+// A fixed-point compound pass over a package which additionally tracks
+// convergence per FunctionBase: a function whose combined transform version
+// (its own plus its transitive callees', see DependentTransformVersion) is
+// unchanged by a complete iteration of the pipeline has reached a local fixed
+// point and is skipped by function-scoped passes in subsequent iterations,
+// until inter-function changes (e.g. inlining or dead function elimination
+// altering its callee set) move the version again.
+class OptimizationFixedPointCompoundPass
+    : public FixedPointCompoundPassBase<Package, OptimizationPassOptions> {
+ public:
+  OptimizationFixedPointCompoundPass(std::string_view short_name,
+                                     std::string_view long_name)
+      : FixedPointCompoundPassBase<Package, OptimizationPassOptions>(
+            short_name, long_name) {}
+
+ protected:
+  absl::flat_hash_map<std::string, int64_t> SnapshotFunctionVersions(
+      Package* package) const override;
+  void RecordConvergence(
+      Package* package,
+      const absl::flat_hash_map<std::string, int64_t>& versions_before,
+      PassResults* results) const override;
+};
 using OptimizationInvariantChecker = OptimizationCompoundPass::InvariantChecker;
 using OptimizationPipelineGenerator =
     PipelineGeneratorBase<Package, OptimizationPassOptions>;
@@ -164,6 +209,12 @@ using OptimizationPassGenerator =
 inline bool SplitsEnabled(int64_t opt_level) { return opt_level >= 3; }
 inline bool NarrowingEnabled(int64_t opt_level) { return opt_level >= 2; }
 
+// Returns the sum of the transform versions of `f` and its transitive
+// callees. A function-scoped pass invocation on `f` can only be affected by
+// changes within this set of FunctionBases, and any such change moves the
+// combined version.
+int64_t DependentTransformVersion(FunctionBase* f);
+
 // Abstract base class for passes operate at function/proc scope. The derived
 // class must define RunOnFunctionBaseInternal.
 class OptimizationFunctionBasePass : public OptimizationPass {
@@ -188,6 +239,13 @@ class OptimizationFunctionBasePass : public OptimizationPass {
       FunctionBase* f, const OptimizationPassOptions& options,
       PassResults* results) const = 0;
 
+  // Runs the pass over the FunctionBases of the package using
+  // `options.worker_count` worker threads. FunctionBases which are independent
+  // in the call graph are processed concurrently.
+  absl::StatusOr<bool> RunOnFunctionBasesInParallel(
+      Package* p, const OptimizationPassOptions& options,
+      PassResults* results) const;
+
   // Calls the given function for every node in the graph in a loop until no
   // further simplifications are possible.  simplify_f should return true if the
   // IR was modified. simplify_f can add or remove nodes including the node
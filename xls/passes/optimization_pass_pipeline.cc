@@ -59,6 +59,7 @@
 #include "xls/passes/optimization_pass_registry.h"
 #include "xls/passes/pass_base.h"
 #include "xls/passes/proc_inlining_pass.h"
+#include "xls/passes/proc_state_array_splitting_pass.h"
 #include "xls/passes/proc_state_flattening_pass.h"
 #include "xls/passes/proc_state_narrowing_pass.h"
 #include "xls/passes/proc_state_optimization_pass.h"
@@ -215,6 +216,7 @@ PostInliningPassGroup::PostInliningPassGroup(int64_t opt_level)
   // simplification to simplify tuple structures left over from flattening.
   // TODO(meheff): Consider running proc state optimization more than once.
   Add<ProcStateFlatteningPass>();
+  Add<ProcStateArraySplittingPass>();
   Add<IdentityRemovalPass>();
   Add<DataflowSimplificationPass>();
   Add<NextValueOptimizationPass>(std::min(int64_t{3}, opt_level));
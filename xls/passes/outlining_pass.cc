@@ -0,0 +1,316 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/outlining_pass.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/function.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
+#include "xls/ir/package.h"
+#include "xls/ir/source_location.h"
+#include "xls/ir/topo_sort.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/optimization_pass_registry.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls {
+namespace {
+
+// Depth bound on extracted regions. Limits the cost of region extraction and
+// matching; deeper repeated logic is outlined as nested trees of regions.
+constexpr int64_t kMaxRegionDepth = 8;
+
+// Minimum number of nodes in a region for outlining to pay for the invoke.
+constexpr int64_t kMinRegionNodes = 4;
+
+// A single-use expression tree rooted at `root`, the candidate unit of
+// outlining.
+struct Region {
+  Node* root;
+
+  // The nodes of the tree in pre-order; the first element is the root. All
+  // nodes other than the root have exactly one user, inside the tree.
+  std::vector<Node*> nodes;
+
+  // Operands from outside the tree in first-use order, deduplicated. These
+  // become the parameters of the outlined function and the arguments of each
+  // invoke.
+  std::vector<Node*> inputs;
+
+  // For each tree node, the encoding of each of its operands: a non-negative
+  // value is the pre-order index of an interior node, a negative value -k
+  // refers to inputs[k - 1].
+  std::vector<std::vector<int64_t>> operand_refs;
+};
+
+// Returns true if `node` may be placed in the interior of a region: its
+// (unique) user would subsume it into the outlined function.
+bool CanBeInterior(Node* node) {
+  return !node->Is<Param>() && !OpIsSideEffecting(node->op()) &&
+         node->users().size() == 1 &&
+         !node->function_base()->HasImplicitUse(node);
+}
+
+int64_t ExtractRegionHelper(
+    Node* node, int64_t depth, Region& region,
+    absl::flat_hash_map<Node*, int64_t>& input_indices) {
+  int64_t index = region.nodes.size();
+  region.nodes.push_back(node);
+  region.operand_refs.emplace_back();
+  std::vector<int64_t> refs;
+  refs.reserve(node->operand_count());
+  for (Node* operand : node->operands()) {
+    if (depth < kMaxRegionDepth && CanBeInterior(operand)) {
+      refs.push_back(
+          ExtractRegionHelper(operand, depth + 1, region, input_indices));
+    } else {
+      auto [it, inserted] =
+          input_indices.try_emplace(operand, region.inputs.size());
+      if (inserted) {
+        region.inputs.push_back(operand);
+      }
+      refs.push_back(-(it->second + 1));
+    }
+  }
+  region.operand_refs[index] = std::move(refs);
+  return index;
+}
+
+// Extracts the maximal (depth-bounded) single-use tree rooted at `root`.
+Region ExtractRegion(Node* root) {
+  Region region;
+  region.root = root;
+  absl::flat_hash_map<Node*, int64_t> input_indices;
+  ExtractRegionHelper(root, /*depth=*/0, region, input_indices);
+  return region;
+}
+
+// Returns a bucketing key for the region's structure. Regions with different
+// signatures never match; regions with equal signatures are verified with
+// RegionsMatch since node attributes (e.g. bit-slice offsets) are not fully
+// captured here.
+std::string RegionSignature(const Region& region) {
+  std::string signature;
+  for (int64_t i = 0; i < static_cast<int64_t>(region.nodes.size()); ++i) {
+    Node* node = region.nodes[i];
+    absl::StrAppend(&signature, OpToString(node->op()), ":",
+                    node->GetType()->ToString(), "(");
+    for (int64_t ref : region.operand_refs[i]) {
+      absl::StrAppend(&signature, ref, ",");
+    }
+    absl::StrAppend(&signature, ");");
+  }
+  for (Node* input : region.inputs) {
+    absl::StrAppend(&signature, input->GetType()->ToString(), ";");
+  }
+  return signature;
+}
+
+// Returns true if the regions compute the same function of their inputs.
+bool RegionsMatch(const Region& a, const Region& b) {
+  if (a.nodes.size() != b.nodes.size() ||
+      a.inputs.size() != b.inputs.size()) {
+    return false;
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(a.nodes.size()); ++i) {
+    if (a.operand_refs[i] != b.operand_refs[i] ||
+        !a.nodes[i]->IsDefinitelyEqualTo(b.nodes[i])) {
+      return false;
+    }
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(a.inputs.size()); ++i) {
+    if (a.inputs[i]->GetType() != b.inputs[i]->GetType()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns a function name derived from `base` which is not yet taken in
+// `package`.
+std::string UnusedFunctionName(Package* package, std::string_view base) {
+  std::string name(base);
+  int64_t suffix = 0;
+  while (package->TryGetFunction(name).has_value()) {
+    name = absl::StrCat(base, "_", suffix++);
+  }
+  return name;
+}
+
+// Outlines the representative region `instances.front()` into a new function
+// and replaces every instance with an invoke of it. All instances must be
+// pairwise disjoint and match the representative.
+absl::Status OutlineInstances(FunctionBase* f,
+                              absl::Span<const Region* const> instances,
+                              int64_t class_number) {
+  Package* package = f->package();
+  const Region& representative = *instances.front();
+
+  Function* callee = package->AddFunction(std::make_unique<Function>(
+      UnusedFunctionName(package,
+                         absl::StrCat(f->name(), "_outlined_", class_number)),
+      package));
+  std::vector<Node*> params;
+  params.reserve(representative.inputs.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(representative.inputs.size());
+       ++i) {
+    XLS_ASSIGN_OR_RETURN(
+        Node * param,
+        callee->MakeNodeWithName<Param>(SourceInfo(),
+                                        representative.inputs[i]->GetType(),
+                                        absl::StrCat("arg_", i)));
+    params.push_back(param);
+  }
+  // Clone the tree in reverse pre-order so operands exist before their users.
+  std::vector<Node*> clones(representative.nodes.size());
+  for (int64_t i = static_cast<int64_t>(representative.nodes.size()) - 1;
+       i >= 0; --i) {
+    std::vector<Node*> new_operands;
+    new_operands.reserve(representative.operand_refs[i].size());
+    for (int64_t ref : representative.operand_refs[i]) {
+      new_operands.push_back(ref >= 0 ? clones[ref] : params[-ref - 1]);
+    }
+    XLS_ASSIGN_OR_RETURN(
+        clones[i],
+        representative.nodes[i]->CloneInNewFunction(new_operands, callee));
+  }
+  XLS_RETURN_IF_ERROR(callee->set_return_value(clones[0]));
+
+  VLOG(2) << absl::StrCat("Outlined ", representative.nodes.size(),
+                          " nodes x", instances.size(), " occurrences into ",
+                          callee->name());
+  for (const Region* instance : instances) {
+    XLS_ASSIGN_OR_RETURN(
+        Node * invoke,
+        f->MakeNode<Invoke>(instance->root->loc(), instance->inputs, callee));
+    XLS_RETURN_IF_ERROR(instance->root->ReplaceUsesWith(invoke));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<bool> OutliningPass::RunOnFunctionBaseInternal(
+    FunctionBase* f, const OptimizationPassOptions& options,
+    PassResults* results) const {
+  if (f->IsBlock()) {
+    return false;
+  }
+
+  // Extract a candidate region rooted at every eligible node and bucket the
+  // candidates by structure.
+  std::vector<Region> regions;
+  absl::flat_hash_map<std::string, std::vector<int64_t>> buckets;
+  for (Node* node : TopoSort(f)) {
+    if (node->Is<Param>() || node->Is<Literal>() || node->Is<Invoke>() ||
+        OpIsSideEffecting(node->op())) {
+      continue;
+    }
+    Region region = ExtractRegion(node);
+    if (static_cast<int64_t>(region.nodes.size()) < kMinRegionNodes) {
+      continue;
+    }
+    buckets[RegionSignature(region)].push_back(
+        static_cast<int64_t>(regions.size()));
+    regions.push_back(std::move(region));
+  }
+
+  // Partition each bucket into classes of exactly-matching regions.
+  std::vector<std::vector<const Region*>> classes;
+  for (auto& [signature, indices] : buckets) {
+    if (indices.size() < 2) {
+      continue;
+    }
+    std::vector<std::vector<const Region*>> bucket_classes;
+    for (int64_t index : indices) {
+      const Region& region = regions[index];
+      bool matched = false;
+      for (std::vector<const Region*>& existing : bucket_classes) {
+        if (RegionsMatch(*existing.front(), region)) {
+          existing.push_back(&region);
+          matched = true;
+          break;
+        }
+      }
+      if (!matched) {
+        bucket_classes.push_back({&region});
+      }
+    }
+    for (std::vector<const Region*>& bucket_class : bucket_classes) {
+      if (bucket_class.size() >= 2) {
+        classes.push_back(std::move(bucket_class));
+      }
+    }
+  }
+
+  // Outline larger regions first so occurrences nested inside them are
+  // subsumed rather than outlined separately.
+  std::sort(classes.begin(), classes.end(),
+            [](const std::vector<const Region*>& a,
+               const std::vector<const Region*>& b) {
+              if (a.front()->nodes.size() != b.front()->nodes.size()) {
+                return a.front()->nodes.size() > b.front()->nodes.size();
+              }
+              return a.front()->root->id() < b.front()->root->id();
+            });
+
+  bool changed = false;
+  int64_t class_number = 0;
+  absl::flat_hash_set<Node*> claimed;
+  for (const std::vector<const Region*>& matching : classes) {
+    // Drop instances overlapping an already-outlined region or an earlier
+    // instance of this class (identical trees can be nested).
+    std::vector<const Region*> disjoint;
+    absl::flat_hash_set<Node*> locally_claimed;
+    for (const Region* instance : matching) {
+      if (std::none_of(instance->nodes.begin(), instance->nodes.end(),
+                       [&](Node* node) {
+                         return claimed.contains(node) ||
+                                locally_claimed.contains(node);
+                       })) {
+        disjoint.push_back(instance);
+        locally_claimed.insert(instance->nodes.begin(),
+                               instance->nodes.end());
+      }
+    }
+    if (disjoint.size() < 2) {
+      continue;
+    }
+    claimed.insert(locally_claimed.begin(), locally_claimed.end());
+    XLS_RETURN_IF_ERROR(OutlineInstances(f, disjoint, class_number++));
+    changed = true;
+  }
+  return changed;
+}
+
+REGISTER_OPT_PASS(OutliningPass);
+
+}  // namespace xls
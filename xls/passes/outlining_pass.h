@@ -0,0 +1,46 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_OUTLINING_PASS_H_
+#define XLS_PASSES_OUTLINING_PASS_H_
+
+#include <string_view>
+
+#include "absl/status/statusor.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls {
+
+// Pass which finds structurally identical single-use expression trees --
+// typically produced by loop unrolling -- and outlines them into a shared
+// function invoked at each occurrence. Later passes then process one copy of
+// the repeated logic instead of one per occurrence. The pass is not part of
+// the default pipeline; it is intended for explicit pipelines which run it
+// after unrolling and re-inline the invokes (InliningPass) before codegen.
+class OutliningPass : public OptimizationFunctionBasePass {
+ public:
+  static constexpr std::string_view kName = "outlining";
+  OutliningPass() : OptimizationFunctionBasePass(kName, "Outlining") {}
+  ~OutliningPass() override = default;
+
+ protected:
+  absl::StatusOr<bool> RunOnFunctionBaseInternal(
+      FunctionBase* f, const OptimizationPassOptions& options,
+      PassResults* results) const override;
+};
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_OUTLINING_PASS_H_
@@ -0,0 +1,140 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/outlining_pass.h"
+
+#include <cstdint>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/matchers.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_matcher.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/package.h"
+#include "xls/ir/value.h"
+#include "xls/passes/dce_pass.h"
+#include "xls/passes/inlining_pass.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/pass_base.h"
+
+namespace m = ::xls::op_matchers;
+
+namespace xls {
+namespace {
+
+using status_testing::IsOkAndHolds;
+
+class OutliningPassTest : public IrTestBase {
+ protected:
+  // ((x + 1) * 3) ^ (x >> 2): a four-node region over one input.
+  BValue Kernel(FunctionBuilder& fb, BValue x) {
+    BValue scaled =
+        fb.UMul(fb.Add(x, fb.Literal(UBits(1, 32))), fb.Literal(UBits(3, 32)));
+    return fb.Xor(scaled, fb.Shrl(x, fb.Literal(UBits(2, 32))));
+  }
+
+  absl::StatusOr<bool> Run(Package* p) {
+    PassResults results;
+    XLS_ASSIGN_OR_RETURN(
+        bool changed,
+        OutliningPass().Run(p, OptimizationPassOptions(), &results));
+    XLS_RETURN_IF_ERROR(DeadCodeEliminationPass()
+                            .Run(p, OptimizationPassOptions(), &results)
+                            .status());
+    return changed;
+  }
+};
+
+TEST_F(OutliningPassTest, OutlinesRepeatedKernels) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  fb.Add(Kernel(fb, x), Kernel(fb, y));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(true));
+
+  EXPECT_THAT(f->return_value(), m::Add(m::Invoke(m::Param("x")),
+                                        m::Invoke(m::Param("y"))));
+  // Both invocations share one outlined callee.
+  Invoke* lhs = f->return_value()->operand(0)->As<Invoke>();
+  Invoke* rhs = f->return_value()->operand(1)->As<Invoke>();
+  EXPECT_EQ(lhs->to_apply(), rhs->to_apply());
+  EXPECT_EQ(p->functions().size(), 2);
+}
+
+TEST_F(OutliningPassTest, OutlinedCodeComputesTheSameValues) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  fb.Add(Kernel(fb, x), Kernel(fb, y));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(true));
+
+  // Re-inlining the invokes must reproduce the original computation
+  // structure: invoke of the outlined function is exactly the region it
+  // replaced.
+  PassResults results;
+  XLS_ASSERT_OK(
+      InliningPass().Run(p.get(), OptimizationPassOptions(), &results));
+  XLS_ASSERT_OK(DeadCodeEliminationPass()
+                    .Run(p.get(), OptimizationPassOptions(), &results)
+                    .status());
+  EXPECT_THAT(f->return_value(),
+              m::Add(m::Xor(m::UMul(), m::Shrl()),
+                     m::Xor(m::UMul(), m::Shrl())));
+}
+
+TEST_F(OutliningPassTest, SmallRegionsAreNotOutlined) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  fb.Add(fb.Not(x), fb.Not(y));
+  XLS_ASSERT_OK(fb.Build().status());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(false));
+  EXPECT_EQ(p->functions().size(), 1);
+}
+
+TEST_F(OutliningPassTest, DifferingConstantsAreNotMerged) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  // Same shape but a different literal inside the second region.
+  BValue lhs = fb.Xor(
+      fb.UMul(fb.Add(x, fb.Literal(UBits(1, 32))), fb.Literal(UBits(3, 32))),
+      fb.Shrl(x, fb.Literal(UBits(2, 32))));
+  BValue rhs = fb.Xor(
+      fb.UMul(fb.Add(y, fb.Literal(UBits(7, 32))), fb.Literal(UBits(3, 32))),
+      fb.Shrl(y, fb.Literal(UBits(2, 32))));
+  fb.Add(lhs, rhs);
+  XLS_ASSERT_OK(fb.Build().status());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(false));
+  EXPECT_EQ(p->functions().size(), 1);
+}
+
+}  // namespace
+}  // namespace xls
@@ -15,16 +15,41 @@
 #include "xls/passes/pass_base.h"
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/time.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/package.h"
+#include "xls/passes/query_engine.h"
 
 namespace xls {
 
+absl::StatusOr<QueryEngine*> AnalysisCache::GetEngine(
+    std::string_view analysis_name, FunctionBase* f,
+    const QueryEngineFactory& factory) {
+  Entry& entry = engines_[std::make_pair(std::string(analysis_name), f)];
+  if (entry.engine != nullptr && entry.function_name == f->name() &&
+      entry.transform_version == f->transform_version()) {
+    // Cache hit; the engine was populated at the current version of `f`.
+    return entry.engine.get();
+  }
+  // Construct a fresh engine rather than re-populating a stale one; engines
+  // key internal state by Node* and a re-population could otherwise alias
+  // entries for deleted-and-reallocated nodes.
+  XLS_ASSIGN_OR_RETURN(entry.engine, factory());
+  XLS_RETURN_IF_ERROR(entry.engine->Populate(f).status());
+  entry.function_name = f->name();
+  entry.transform_version = f->transform_version();
+  return entry.engine.get();
+}
+
 void CompoundPassResult::AddSinglePassResult(std::string_view pass_name,
                                              bool changed,
                                              absl::Duration duration,
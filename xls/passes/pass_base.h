@@ -18,10 +18,12 @@
 #include <algorithm>
 #include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -37,9 +39,16 @@
 #include "xls/common/casts.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/logging/log_lines.h"
+#include "xls/common/metrics.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/ir/elaboration_cache.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/package.h"
+#include "xls/passes/ir_checkpoint.h"
+#include "xls/passes/post_dominator_analysis.h"
+#include "xls/passes/query_engine.h"
+#include "xls/passes/token_provenance_analysis.h"
 
 namespace xls {
 
@@ -66,6 +75,20 @@ struct PassOptionsBase {
   // number of passes executed might change due to setting this field as
   // fixed-points may complete earlier.
   std::optional<int64_t> bisect_limit;
+
+  // If present, a best-effort bound on the total time spent running passes.
+  // Once the accumulated pass run time reaches the budget, remaining passes
+  // are skipped (the IR is always left in a valid, if less optimized, state).
+  // The budget is only consulted between passes; a pass which is already
+  // running is never interrupted, so the bound can be exceeded by the run
+  // time of a single pass.
+  std::optional<absl::Duration> compile_time_budget;
+
+  // If true, an in-memory checkpoint of the IR is recorded after every leaf
+  // pass invocation in PassResults::ir_checkpoints. Unchanged functions share
+  // storage across checkpoints, so this is far cheaper than ir_dump_path; see
+  // IrCheckpointStore.
+  bool record_ir_checkpoints = false;
 };
 
 // An object containing information about the invocation of a pass (single call
@@ -79,6 +102,51 @@ struct PassInvocation {
 
   // The run duration of the pass.
   absl::Duration run_duration;
+
+  // Transformation metrics (nodes added/removed/replaced) accumulated during
+  // the invocation.
+  TransformMetrics metrics;
+};
+
+// A cache of populated analyses (QueryEngines) shared across pass
+// invocations. Entries are keyed by an analysis name chosen by the requesting
+// pass and the FunctionBase being analyzed, and are validated against the
+// FunctionBase's transform version: an entry populated before the function was
+// last transformed is re-populated before being handed out, so consecutive
+// passes which request the same analysis on an unchanged function reuse the
+// populated engine instead of re-running the analysis from scratch.
+//
+// The cache is not thread-safe; passes which process FunctionBases
+// concurrently (worker_count > 1) must construct their engines locally
+// instead.
+class AnalysisCache {
+ public:
+  using QueryEngineFactory =
+      std::function<absl::StatusOr<std::unique_ptr<QueryEngine>>()>;
+
+  // Returns the query engine registered under `analysis_name` for `f`,
+  // populated at `f`'s current transform version. If no engine is cached for
+  // the key, one is constructed with `factory` and populated. The returned
+  // pointer is owned by the cache and remains valid until the cache is
+  // cleared; it must not be used after `f` is transformed without calling
+  // GetEngine again.
+  absl::StatusOr<QueryEngine*> GetEngine(std::string_view analysis_name,
+                                         FunctionBase* f,
+                                         const QueryEngineFactory& factory);
+
+  // Drops all cached engines.
+  void Clear() { engines_.clear(); }
+
+ private:
+  struct Entry {
+    std::unique_ptr<QueryEngine> engine;
+    // Name of the FunctionBase at population time. Guards against a deleted
+    // FunctionBase being reallocated at the same address.
+    std::string function_name;
+    // FunctionBase::transform_version() at population time.
+    int64_t transform_version;
+  };
+  absl::flat_hash_map<std::pair<std::string, FunctionBase*>, Entry> engines_;
 };
 
 // A object to which metadata may be written in each pass invocation. This data
@@ -86,8 +154,88 @@ struct PassInvocation {
 struct PassResults {
   // This vector contains and entry for each invocation of each pass.
   std::vector<PassInvocation> invocations;
+
+  // Records, per fixed-point compound pass short name, the total number of
+  // iterations run before reaching the fixed point, summed across invocations
+  // of the compound pass.
+  absl::flat_hash_map<std::string, int64_t> fixed_point_iterations;
+
+  // Total run time of all leaf pass invocations so far. Consulted by the
+  // compound pass runner to enforce PassOptionsBase::compile_time_budget.
+  absl::Duration total_run_duration;
+
+  // Records, per (pass short name, FunctionBase name), the combined transform
+  // version of the FunctionBase and its transitive callees at the last time
+  // the pass ran on it without making changes. Function-scoped passes consult
+  // this map to skip invocations whose input subgraph is unchanged since their
+  // last run. Stale entries (e.g., for deleted functions) are harmless as the
+  // recorded versions can never match again.
+  absl::flat_hash_map<std::pair<std::string, std::string>, int64_t>
+      unchanged_function_versions;
+
+  // Records, per (pass short name, FunctionBase name), the transform version
+  // of the FunctionBase when the pass last finished running on it.
+  // Worklist-driven cleanup passes use this together with
+  // FunctionBase::ChangedNodeIdsSince to seed their worklists from only the
+  // nodes touched since their previous run.
+  absl::flat_hash_map<std::pair<std::string, std::string>, int64_t>
+      last_run_versions;
+
+  // Populated analyses shared across the passes of a pipeline. Entries
+  // invalidate themselves when the analyzed FunctionBase is transformed, so
+  // passes which leave a function untouched pass their engines on to the next
+  // pass for free.
+  AnalysisCache analysis_cache;
+
+  // Cached token provenance shared across the passes of a pipeline. Entries
+  // invalidate themselves when token-relevant nodes of the analyzed
+  // FunctionBase change; mutations that cannot reroute tokens revalidate the
+  // cached result instead of recomputing it.
+  CachedTokenProvenance token_provenance;
+
+  // Cached post-dominator analyses shared across the passes of a pipeline.
+  // Entries invalidate themselves when the analyzed FunctionBase is
+  // transformed.
+  CachedPostDominatorAnalysis post_dominators;
+
+  // Cached proc and block elaborations shared across the passes of a
+  // pipeline. Entries invalidate themselves when the instantiation structure
+  // of any covered FunctionBase changes; node-level edits leave them intact.
+  ElaborationCache elaborations;
+
+  // Records, per FunctionBase name, the combined transform version (the
+  // function's own plus its transitive callees') at which the innermost
+  // running fixed-point compound pass found the function to be at a local
+  // fixed point: a complete iteration of the pipeline left the function and
+  // everything it depends on untouched. Function-scoped passes skip such
+  // functions until the version changes again, e.g. because inlining or dead
+  // function elimination altered the callee set. Maintained (and scoped) by
+  // FixedPointCompoundPassBase; empty outside of a fixed-point pipeline.
+  absl::flat_hash_map<std::string, int64_t> converged_function_versions;
+
+  // Per-pass IR checkpoints with shared storage for unchanged functions.
+  // Populated by the compound pass runner when
+  // PassOptionsBase::record_ir_checkpoints is set.
+  IrCheckpointStore ir_checkpoints;
 };
 
+// Returns the Package underlying the IR construct a pass pipeline operates
+// on, or nullptr if `IrT` carries no package. Used by the compound pass
+// runner for package-level bookkeeping (e.g. IR checkpointing) without
+// constraining the IrT interface.
+template <typename IrT>
+Package* CheckpointPackage(IrT* ir) {
+  if constexpr (std::is_same_v<IrT, Package>) {
+    return ir;
+  } else if constexpr (requires { ir->GetPackage(); }) {
+    return ir->GetPackage();
+  } else if constexpr (requires { ir->package; }) {
+    return ir->package;
+  } else {
+    return nullptr;
+  }
+}
+
 // Base class for all compiler passes. Template parameters:
 //
 //   IrT : The data type that the pass operates on (e.g., xls::Package). The
@@ -130,6 +278,8 @@ class PassBase {
   // fixed point computation.
   virtual absl::StatusOr<bool> Run(IrT* ir, const OptionsT& options,
                                    ResultsT* results) const {
+    XLS_METRICS_COUNTER_INC("pass.runs");
+    XLS_METRICS_SCOPED_TIMER("pass.run_time");
     VLOG(2) << absl::StreamFormat("Running %s [pass #%d]", long_name(),
                                   results->invocations.size());
     VLOG(3) << "Before:";
@@ -319,17 +469,40 @@ class FixedPointCompoundPassBase
       : CompoundPassBase<IrT, OptionsT, ResultsT>(short_name, long_name) {}
 
  protected:
+  // Hooks for tracking convergence at FunctionBase granularity.
+  // SnapshotFunctionVersions returns, per function name, a version which
+  // changes whenever an iteration of the pipeline could affect that function;
+  // RecordConvergence compares a pre-iteration snapshot against the current
+  // state and updates ResultsT::converged_function_versions accordingly. The
+  // defaults do no tracking, for IR types without function granularity.
+  virtual absl::flat_hash_map<std::string, int64_t> SnapshotFunctionVersions(
+      IrT* ir) const {
+    return {};
+  }
+  virtual void RecordConvergence(
+      IrT* ir, const absl::flat_hash_map<std::string, int64_t>& versions_before,
+      ResultsT* results) const {}
+
   absl::StatusOr<CompoundPassResult> RunNested(
       IrT* ir, const OptionsT& options, ResultsT* results,
       std::string_view top_level_name,
       absl::Span<const typename CompoundPassBase<
           IrT, OptionsT, ResultsT>::InvariantChecker* const>
           invariant_checkers) const override {
+    // Convergence entries are only meaningful to the pipeline whose
+    // iterations established them; shelve any enclosing pipeline's entries
+    // for the duration of this run.
+    absl::flat_hash_map<std::string, int64_t> enclosing_converged =
+        std::move(results->converged_function_versions);
+    results->converged_function_versions.clear();
+
     bool local_changed = true;
     int64_t iteration_count = 0;
     CompoundPassResult aggregate_result;
     while (local_changed) {
       ++iteration_count;
+      absl::flat_hash_map<std::string, int64_t> versions_before =
+          SnapshotFunctionVersions(ir);
       XLS_ASSIGN_OR_RETURN(
           CompoundPassResult compound_result,
           (CompoundPassBase<IrT, OptionsT, ResultsT>::RunNested(
@@ -338,11 +511,17 @@ class FixedPointCompoundPassBase
             << this->long_name() << " [short: " << this->short_name() << "]");
       local_changed = compound_result.changed();
       aggregate_result.AccumulateCompoundPassResult(compound_result);
+      if (local_changed) {
+        RecordConvergence(ir, versions_before, results);
+      }
     }
     VLOG(1) << absl::StreamFormat(
         "Fixed point compound pass %s iterated %d times.", this->long_name(),
         iteration_count);
+    results->fixed_point_iterations[this->short_name()] += iteration_count;
     XLS_VLOG_LINES(2, aggregate_result.ToString());
+
+    results->converged_function_versions = std::move(enclosing_converged);
     return aggregate_result;
   }
 };
@@ -385,10 +564,7 @@ CompoundPassBase<IrT, OptionsT, ResultsT>::RunNested(
                                   pass->long_name(), pass->short_name(),
                                   results->invocations.size(), ir->name());
 
-    TransformMetrics before_metrics;
-    if (VLOG_IS_ON(1)) {
-      before_metrics = ir->transform_metrics();
-    }
+    TransformMetrics before_metrics = ir->transform_metrics();
 
     if (!pass->IsCompound() && options.bisect_limit &&
         results->invocations.size() >= options.bisect_limit) {
@@ -397,6 +573,15 @@ CompoundPassBase<IrT, OptionsT, ResultsT>::RunNested(
       continue;
     }
 
+    if (options.compile_time_budget.has_value() &&
+        results->total_run_duration >= *options.compile_time_budget) {
+      VLOG(1) << "Skipping pass " << pass->short_name()
+              << ": compile time budget of "
+              << FormatDuration(*options.compile_time_budget)
+              << " is exhausted.";
+      continue;
+    }
+
     if (std::find_if(options.skip_passes.begin(), options.skip_passes.end(),
                      [&](const std::string& name) {
                        return pass->short_name() == name;
@@ -452,7 +637,16 @@ CompoundPassBase<IrT, OptionsT, ResultsT>::RunNested(
     }
     if (!pass->IsCompound()) {
       results->invocations.push_back(
-          {pass->short_name(), pass_changed, duration});
+          {pass->short_name(), pass_changed, duration, pass_metrics});
+      results->total_run_duration += duration;
+      if (options.record_ir_checkpoints) {
+        if (Package* package = CheckpointPackage(ir); package != nullptr) {
+          results->ir_checkpoints.Record(
+              package, pass->short_name(),
+              /*ordinal=*/results->invocations.size() - 1,
+              /*changed=*/pass_changed);
+        }
+      }
     }
     if (!options.ir_dump_path.empty()) {
       XLS_RETURN_IF_ERROR(DumpIr(options.ir_dump_path, ir, top_level_name,
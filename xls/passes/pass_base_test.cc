@@ -14,14 +14,18 @@
 
 #include "xls/passes/pass_base.h"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <utility>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xls/common/status/matchers.h"
 #include "xls/common/status/status_macros.h"
@@ -34,10 +38,13 @@
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/topo_sort.h"
 #include "xls/ir/value.h"
 #include "xls/passes/dce_pass.h"
 #include "xls/passes/optimization_pass.h"
+#include "xls/passes/query_engine.h"
+#include "xls/passes/ternary_query_engine.h"
 
 namespace m = ::xls::op_matchers;
 namespace xls {
@@ -288,5 +295,178 @@ TEST_F(PassBaseTest, BisectLimitZero) {
   EXPECT_THAT(results.invocations, IsEmpty());
 }
 
+TEST_F(PassBaseTest, CompileTimeBudgetExhaustedSkipsPasses) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  fb.Literal(UBits(0, 64));
+  XLS_ASSERT_OK_AND_ASSIGN(auto* f, fb.Build());
+  OptimizationCompoundPass opt("opt", "opt");
+  opt.Add<LevelUpPass>();
+  opt.Add<DeadCodeEliminationPass>();
+  PassResults results;
+  // An already-exhausted budget skips every pass and leaves the IR untouched.
+  EXPECT_THAT(opt.Run(p.get(),
+                      OptimizationPassOptions(PassOptionsBase{
+                          .compile_time_budget = absl::ZeroDuration()}),
+                      &results),
+              IsOk());
+  EXPECT_THAT(f->return_value(), m::Literal(UBits(0, 64)));
+  EXPECT_THAT(results.invocations, IsEmpty());
+}
+
+TEST_F(PassBaseTest, CompileTimeBudgetGenerousRunsAllPasses) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  fb.Literal(UBits(0, 64));
+  XLS_ASSERT_OK_AND_ASSIGN(auto* f, fb.Build());
+  OptimizationCompoundPass opt("opt", "opt");
+  opt.Add<LevelUpPass>();
+  opt.Add<DeadCodeEliminationPass>();
+  PassResults results;
+  EXPECT_THAT(opt.Run(p.get(),
+                      OptimizationPassOptions(PassOptionsBase{
+                          .compile_time_budget = absl::Hours(1)}),
+                      &results),
+              IsOk());
+  EXPECT_THAT(f->return_value(), m::Literal(UBits(1, 64)));
+  EXPECT_THAT(results.invocations, ElementsAre(LevelUpInvoke(), DceInvoke()));
+}
+
+TEST_F(PassBaseTest, AnalysisCacheReusesPopulatedEngines) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  fb.Concat({fb.Literal(UBits(0b101, 3)), x});
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  PassResults results;
+  int64_t factory_calls = 0;
+  AnalysisCache::QueryEngineFactory factory =
+      [&]() -> absl::StatusOr<std::unique_ptr<QueryEngine>> {
+    ++factory_calls;
+    return std::make_unique<TernaryQueryEngine>();
+  };
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      QueryEngine * engine,
+      results.analysis_cache.GetEngine("ternary", f, factory));
+  EXPECT_EQ(factory_calls, 1);
+  EXPECT_TRUE(engine->IsTracked(f->return_value()));
+
+  // A second request for the same analysis on the unchanged function returns
+  // the same populated engine without invoking the factory.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      QueryEngine * second,
+      results.analysis_cache.GetEngine("ternary", f, factory));
+  EXPECT_EQ(second, engine);
+  EXPECT_EQ(factory_calls, 1);
+
+  // A different analysis name gets its own engine.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      QueryEngine * other,
+      results.analysis_cache.GetEngine("other", f, factory));
+  EXPECT_NE(other, engine);
+  EXPECT_EQ(factory_calls, 2);
+
+  // Transforming the function invalidates the cached entry; the next request
+  // constructs and populates a fresh engine which sees the new node.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * literal,
+      f->MakeNode<Literal>(SourceInfo(), Value(UBits(42, 8))));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      QueryEngine * rebuilt,
+      results.analysis_cache.GetEngine("ternary", f, factory));
+  EXPECT_EQ(factory_calls, 3);
+  EXPECT_TRUE(rebuilt->IsTracked(literal));
+  EXPECT_EQ(rebuilt->ToString(literal), "0b0010_1010");
+}
+
+// Counts how many times it is invoked on each function; never changes the IR.
+class InvocationCountingPass : public OptimizationFunctionBasePass {
+ public:
+  explicit InvocationCountingPass(
+      absl::flat_hash_map<std::string, int64_t>* counts)
+      : OptimizationFunctionBasePass("counter", "Invocation counting pass"),
+        counts_(counts) {}
+
+ protected:
+  absl::StatusOr<bool> RunOnFunctionBaseInternal(
+      FunctionBase* f, const OptimizationPassOptions& options,
+      PassResults* results) const override {
+    ++(*counts_)[f->name()];
+    return false;
+  }
+
+  absl::flat_hash_map<std::string, int64_t>* counts_;
+};
+
+// Exposes the convergence-tracking hooks for direct testing.
+class ExposedFixedPointPass : public OptimizationFixedPointCompoundPass {
+ public:
+  using OptimizationFixedPointCompoundPass::OptimizationFixedPointCompoundPass;
+  using OptimizationFixedPointCompoundPass::RecordConvergence;
+  using OptimizationFixedPointCompoundPass::SnapshotFunctionVersions;
+};
+
+TEST_F(PassBaseTest, RecordConvergenceTracksUntouchedFunctions) {
+  auto p = CreatePackage();
+  FunctionBuilder fb_busy("busy", p.get());
+  fb_busy.Literal(UBits(0, 8));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * busy, fb_busy.Build());
+  FunctionBuilder fb_quiet("quiet", p.get());
+  fb_quiet.Literal(UBits(0, 8));
+  XLS_ASSERT_OK(fb_quiet.Build().status());
+
+  ExposedFixedPointPass pass("fixed", "fixed");
+  PassResults results;
+
+  // An iteration which only touches `busy` marks `quiet` as converged.
+  absl::flat_hash_map<std::string, int64_t> before =
+      pass.SnapshotFunctionVersions(p.get());
+  XLS_ASSERT_OK(
+      busy->MakeNode<Literal>(SourceInfo(), Value(UBits(1, 8))).status());
+  pass.RecordConvergence(p.get(), before, &results);
+  EXPECT_FALSE(results.converged_function_versions.contains("busy"));
+  EXPECT_TRUE(results.converged_function_versions.contains("quiet"));
+
+  // A later iteration which touches `quiet` drops it from the converged set.
+  before = pass.SnapshotFunctionVersions(p.get());
+  XLS_ASSERT_OK(p->GetFunction("quiet")
+                    .value()
+                    ->MakeNode<Literal>(SourceInfo(), Value(UBits(1, 8)))
+                    .status());
+  pass.RecordConvergence(p.get(), before, &results);
+  EXPECT_TRUE(results.converged_function_versions.contains("busy"));
+  EXPECT_FALSE(results.converged_function_versions.contains("quiet"));
+}
+
+TEST_F(PassBaseTest, FunctionScopedPassSkipsConvergedFunctions) {
+  auto p = CreatePackage();
+  FunctionBuilder fb_busy("busy", p.get());
+  fb_busy.Literal(UBits(0, 8));
+  XLS_ASSERT_OK(fb_busy.Build().status());
+  FunctionBuilder fb_quiet("quiet", p.get());
+  fb_quiet.Literal(UBits(0, 8));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * quiet, fb_quiet.Build());
+
+  absl::flat_hash_map<std::string, int64_t> counts;
+  InvocationCountingPass pass(&counts);
+  OptimizationPassOptions options;
+  options.skip_unchanged_functions = true;
+  PassResults results;
+  results.converged_function_versions["quiet"] =
+      DependentTransformVersion(quiet);
+
+  XLS_ASSERT_OK(pass.Run(p.get(), options, &results).status());
+  EXPECT_EQ(counts["busy"], 1);
+  EXPECT_EQ(counts["quiet"], 0);
+
+  // Transforming `quiet` invalidates the converged entry.
+  XLS_ASSERT_OK(
+      quiet->MakeNode<Literal>(SourceInfo(), Value(UBits(1, 8))).status());
+  XLS_ASSERT_OK(pass.Run(p.get(), options, &results).status());
+  EXPECT_EQ(counts["quiet"], 1);
+}
+
 }  // namespace
 }  // namespace xls
@@ -0,0 +1,48 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/pass_metrics.h"
+
+#include <cstdint>
+
+#include "absl/time/time.h"
+#include "xls/passes/pass_base.h"
+#include "xls/passes/pass_metrics.pb.h"
+
+namespace xls {
+
+PassPipelineMetricsProto PassResultsToProto(const PassResults& results) {
+  PassPipelineMetricsProto proto;
+  int64_t total_duration_ns = 0;
+  for (const PassInvocation& invocation : results.invocations) {
+    PassInvocationProto* invocation_proto = proto.add_invocations();
+    invocation_proto->set_pass_name(invocation.pass_name);
+    invocation_proto->set_ir_changed(invocation.ir_changed);
+    int64_t duration_ns = absl::ToInt64Nanoseconds(invocation.run_duration);
+    invocation_proto->set_duration_ns(duration_ns);
+    total_duration_ns += duration_ns;
+    invocation_proto->set_nodes_added(invocation.metrics.nodes_added);
+    invocation_proto->set_nodes_removed(invocation.metrics.nodes_removed);
+    invocation_proto->set_nodes_replaced(invocation.metrics.nodes_replaced);
+    invocation_proto->set_operands_replaced(
+        invocation.metrics.operands_replaced);
+  }
+  for (const auto& [pass_name, iterations] : results.fixed_point_iterations) {
+    (*proto.mutable_fixed_point_iterations())[pass_name] = iterations;
+  }
+  proto.set_total_duration_ns(total_duration_ns);
+  return proto;
+}
+
+}  // namespace xls
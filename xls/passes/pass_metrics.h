@@ -0,0 +1,29 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_PASS_METRICS_H_
+#define XLS_PASSES_PASS_METRICS_H_
+
+#include "xls/passes/pass_base.h"
+#include "xls/passes/pass_metrics.pb.h"
+
+namespace xls {
+
+// Converts the telemetry accumulated in `results` during a pipeline run into
+// its proto form for emission as a build artifact.
+PassPipelineMetricsProto PassResultsToProto(const PassResults& results);
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_PASS_METRICS_H_
@@ -0,0 +1,56 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/pass_metrics.h"
+
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/time/time.h"
+#include "xls/ir/package.h"
+#include "xls/passes/pass_base.h"
+#include "xls/passes/pass_metrics.pb.h"
+
+namespace xls {
+namespace {
+
+TEST(PassMetricsTest, ConvertsResultsToProto) {
+  PassResults results;
+  PassInvocation dce_invocation{.pass_name = "dce",
+                                .ir_changed = true,
+                                .run_duration = absl::Microseconds(5)};
+  dce_invocation.metrics.nodes_added = 1;
+  dce_invocation.metrics.nodes_removed = 7;
+  results.invocations.push_back(std::move(dce_invocation));
+  results.invocations.push_back(
+      PassInvocation{.pass_name = "cse",
+                     .ir_changed = false,
+                     .run_duration = absl::Microseconds(3)});
+  results.fixed_point_iterations["simp"] = 4;
+
+  PassPipelineMetricsProto proto = PassResultsToProto(results);
+  ASSERT_EQ(proto.invocations_size(), 2);
+  EXPECT_EQ(proto.invocations(0).pass_name(), "dce");
+  EXPECT_TRUE(proto.invocations(0).ir_changed());
+  EXPECT_EQ(proto.invocations(0).duration_ns(), 5000);
+  EXPECT_EQ(proto.invocations(0).nodes_added(), 1);
+  EXPECT_EQ(proto.invocations(0).nodes_removed(), 7);
+  EXPECT_EQ(proto.invocations(1).pass_name(), "cse");
+  EXPECT_FALSE(proto.invocations(1).ir_changed());
+  EXPECT_EQ(proto.total_duration_ns(), 8000);
+  EXPECT_EQ(proto.fixed_point_iterations().at("simp"), 4);
+}
+
+}  // namespace
+}  // namespace xls
@@ -14,136 +14,267 @@
 
 #include "xls/passes/post_dominator_analysis.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
-#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
-#include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/node_util.h"
-#include "xls/ir/topo_sort.h"
+#include "xls/ir/package.h"
 
 namespace xls {
 namespace {
 
-using NodeIndex = int64_t;
+// Returns true if `node` is a root of the post-dominator computation: a path
+// of uses ends at the node, so nothing beyond the node itself can
+// post-dominate it.
+bool IsRoot(FunctionBase* f, Node* node) {
+  return f->HasImplicitUse(node) || node->users().empty();
+}
 
-// Returns the intersection of the given sorted lists. Lists should be sorted in
-// ascending order.
-std::vector<NodeIndex> IntersectSortedLists(
-    absl::Span<const absl::Span<const NodeIndex>> lists) {
-  std::vector<NodeIndex> intersection;
-  if (lists.empty()) {
-    return intersection;
-  }
-  std::vector<int64_t> indices(lists.size(), 0);
-
-  // Returns true if any of the indices are at the end of their respective
-  // lists.
-  auto at_end_of_a_list = [&]() {
-    for (int64_t i = 0; i < indices.size(); ++i) {
-      if (indices[i] == lists[i].size()) {
-        return true;
+}  // namespace
+
+/* static */ absl::StatusOr<std::unique_ptr<PostDominatorAnalysis>>
+PostDominatorAnalysis::Run(FunctionBase* f) {
+  // Post-dominators of the dataflow graph are dominators of the reverse graph
+  // (edges from each node to its operands) rooted at a virtual exit vertex
+  // which precedes every root node. The dominator tree of the reverse graph
+  // is computed with the semi-NCA algorithm on vectors indexed by preorder
+  // number; vertex 0 is the virtual exit.
+  const int64_t vertex_count = f->node_count() + 1;
+
+  // Depth-first traversal of the reverse graph assigning preorder numbers.
+  std::vector<Node*> vertex(vertex_count, nullptr);
+  std::vector<int64_t> parent(vertex_count, 0);
+  NodeMap<int64_t> preorder_number(f->package());
+  {
+    // Stack entries are (node, preorder number of the discovering vertex).
+    std::vector<std::pair<Node*, int64_t>> dfs_stack;
+    for (Node* node : f->nodes()) {
+      if (IsRoot(f, node)) {
+        dfs_stack.push_back({node, 0});
       }
     }
-    return false;
-  };
-  while (!at_end_of_a_list()) {
-    // Find the minimum value among the list elements at their respective
-    // indices.
-    NodeIndex min_value = lists[0][indices[0]];
-    for (int64_t i = 1; i < lists.size(); ++i) {
-      NodeIndex value = lists[i][indices[i]];
-      if (value < min_value) {
-        min_value = value;
+    int64_t next_number = 1;
+    while (!dfs_stack.empty()) {
+      auto [node, discoverer] = dfs_stack.back();
+      dfs_stack.pop_back();
+      if (preorder_number.contains(node)) {
+        continue;
+      }
+      const int64_t number = next_number++;
+      preorder_number[node] = number;
+      vertex[number] = node;
+      parent[number] = discoverer;
+      for (Node* operand : node->operands()) {
+        if (!preorder_number.contains(operand)) {
+          dfs_stack.push_back({operand, number});
+        }
       }
     }
+    // The graph is a DAG so every use chain terminates at a root and every
+    // node is reachable from the virtual exit.
+    XLS_RET_CHECK_EQ(next_number, vertex_count);
+  }
 
-    // Advance all list indices which hold the minimum value.
-    int64_t match_count = 0;
-    for (int64_t i = 0; i < lists.size(); ++i) {
-      if (lists[i][indices[i]] == min_value) {
-        indices[i]++;
-        match_count++;
+  // Compute semidominators with path compression over the preorder-indexed
+  // forest (the first phase of Lengauer-Tarjan, shared by semi-NCA).
+  // `ancestor` holds the compressed forest parent of each linked vertex (-1
+  // while unlinked) and `label` the minimal-semidominator vertex on the
+  // compressed path.
+  std::vector<int64_t> semi(vertex_count);
+  std::vector<int64_t> label(vertex_count);
+  std::vector<int64_t> ancestor(vertex_count, -1);
+  for (int64_t v = 0; v < vertex_count; ++v) {
+    semi[v] = v;
+    label[v] = v;
+  }
+  std::vector<int64_t> compression_path;
+  auto eval = [&](int64_t v) -> int64_t {
+    if (ancestor[v] < 0) {
+      return v;
+    }
+    // Compress the path from `v` to its forest root, folding the minimal
+    // label downward from the root.
+    compression_path.clear();
+    int64_t x = v;
+    while (ancestor[ancestor[x]] >= 0) {
+      compression_path.push_back(x);
+      x = ancestor[x];
+    }
+    for (auto it = compression_path.rbegin(); it != compression_path.rend();
+         ++it) {
+      if (semi[label[ancestor[*it]]] < semi[label[*it]]) {
+        label[*it] = label[ancestor[*it]];
       }
+      ancestor[*it] = ancestor[ancestor[*it]];
     }
-
-    // If all lists contained the minimum value then add the value to the
-    // intersection.
-    if (match_count == lists.size()) {
-      intersection.push_back(min_value);
+    return label[v];
+  };
+  for (int64_t w = vertex_count - 1; w >= 1; --w) {
+    Node* node = vertex[w];
+    // The predecessors of `node` in the reverse graph are its users, plus the
+    // virtual exit (vertex 0) if the node is a root.
+    for (Node* user : node->users()) {
+      semi[w] = std::min(semi[w], semi[eval(preorder_number.at(user))]);
     }
+    if (IsRoot(f, node)) {
+      semi[w] = 0;
+    }
+    ancestor[w] = parent[w];
   }
-  return intersection;
-}
 
-}  // namespace
+  // The NCA phase: the immediate dominator of `w` is the nearest common
+  // ancestor of its tree parent and its semidominator, found by walking the
+  // already-final immediate dominators of smaller preorder numbers.
+  std::vector<int64_t> idom(vertex_count, 0);
+  for (int64_t w = 1; w < vertex_count; ++w) {
+    int64_t candidate = parent[w];
+    while (candidate > semi[w]) {
+      candidate = idom[candidate];
+    }
+    idom[w] = candidate;
+  }
 
-/* static */ absl::StatusOr<std::unique_ptr<PostDominatorAnalysis>>
-PostDominatorAnalysis::Run(FunctionBase* f) {
   auto analysis = std::make_unique<PostDominatorAnalysis>();
 
-  // A reverse topological sort of the function nodes.
-  std::vector<Node*> reverse_toposort = ReverseTopoSort(f);
-
-  // Construct the postdominators for each node. Postdominators are gathered as
-  // a sorted vector containing the node indices (in a reverse toposort) of the
-  // post dominator nodes.
-  absl::flat_hash_map<Node*, std::vector<NodeIndex>> postdominators;
-  for (NodeIndex i = 0; i < reverse_toposort.size(); ++i) {
-    Node* node = reverse_toposort[i];
-    std::vector<absl::Span<const NodeIndex>> user_postdominators;
-    for (Node* user : node->users()) {
-      user_postdominators.push_back(postdominators.at(user));
-    }
-    // The postdominators of a node is the intersection of the lists of
-    // postdominators for its users plus the node itself.
-    postdominators[node] = IntersectSortedLists(user_postdominators);
-    // If a node has an implicit use, then there exists an alternate path to a
-    // root node other than its users, so it can't be dominated by anything
-    // other than itself.
-    if (f->HasImplicitUse(node)) {
-      postdominators[node] = std::vector<NodeIndex>();
-    }
-    postdominators[node].push_back(i);
+  // Number the post-dominator tree in preorder so that each subtree occupies
+  // a contiguous interval; ancestor queries become interval containment.
+  {
+    std::vector<std::vector<int64_t>> children(vertex_count);
+    for (int64_t w = 1; w < vertex_count; ++w) {
+      children[idom[w]].push_back(w);
+    }
+    std::vector<int64_t> tree_preorder(vertex_count);
+    std::vector<int64_t> subtree_end(vertex_count);
+    // Stack entries are (vertex, subtree completed).
+    std::vector<std::pair<int64_t, bool>> tree_stack = {{0, false}};
+    int64_t counter = 0;
+    while (!tree_stack.empty()) {
+      auto [v, completed] = tree_stack.back();
+      tree_stack.pop_back();
+      if (completed) {
+        subtree_end[v] = counter;
+        continue;
+      }
+      tree_preorder[v] = counter++;
+      tree_stack.push_back({v, true});
+      for (int64_t child : children[v]) {
+        tree_stack.push_back({child, false});
+      }
+    }
+    for (int64_t w = 1; w < vertex_count; ++w) {
+      analysis->tree_intervals_[vertex[w]] =
+          TreeInterval{tree_preorder[w], subtree_end[w]};
+    }
   }
 
+  // Record immediate post-dominators and materialize the by-id-ordered chain
+  // and subtree vectors by walking each node's path to the virtual exit.
+  for (int64_t w = 1; w < vertex_count; ++w) {
+    Node* node = vertex[w];
+    analysis->immediate_post_dominators_[node] =
+        idom[w] == 0 ? nullptr : vertex[idom[w]];
+    for (int64_t a = w; a != 0; a = idom[a]) {
+      Node* post_dominator = vertex[a];
+      analysis->dominated_node_to_post_dominators_ordered_by_id_[node]
+          .push_back(post_dominator);
+      analysis->post_dominator_to_dominated_nodes_ordered_by_id_[post_dominator]
+          .push_back(node);
+    }
+  }
   for (Node* node : f->nodes()) {
-    for (NodeIndex postdominator_index : postdominators[node]) {
-      Node* postdominator = reverse_toposort.at(postdominator_index);
-      analysis->dominated_node_to_post_dominators_[node].insert(postdominator);
-      analysis->post_dominator_to_dominated_nodes_[postdominator].insert(node);
+    SortByNodeId(
+        &analysis->dominated_node_to_post_dominators_ordered_by_id_.at(node));
+    SortByNodeId(
+        &analysis->post_dominator_to_dominated_nodes_ordered_by_id_.at(node));
+  }
+
+  return std::move(analysis);
+}
+
+absl::StatusOr<const PostDominatorAnalysis*>
+CachedPostDominatorAnalysis::GetAnalysis(FunctionBase* f) {
+  Entry& entry = entries_[f];
+  if (entry.analysis != nullptr && entry.function_name == f->name() &&
+      entry.transform_version == f->transform_version()) {
+    return entry.analysis.get();
+  }
+  XLS_ASSIGN_OR_RETURN(entry.analysis, PostDominatorAnalysis::Run(f));
+  entry.function_name = f->name();
+  entry.transform_version = f->transform_version();
+  return entry.analysis.get();
+}
+
+bool CachedPostDominatorAnalysis::EntryIsCurrent(FunctionBase* f) const {
+  auto it = entries_.find(f);
+  return it != entries_.end() && it->second.analysis != nullptr &&
+         it->second.function_name == f->name() &&
+         it->second.transform_version == f->transform_version();
+}
+
+absl::Status CachedPostDominatorAnalysis::Prepopulate(Package* package,
+                                                      int64_t worker_count) {
+  std::vector<FunctionBase*> stale;
+  for (FunctionBase* f : package->GetFunctionBases()) {
+    if (!EntryIsCurrent(f)) {
+      stale.push_back(f);
     }
   }
+  if (stale.empty()) {
+    return absl::OkStatus();
+  }
 
-  // Order nodes.
-  auto generate_ordered_by_id_nodes =
-      [](const absl::flat_hash_map<Node*, absl::flat_hash_set<Node*>>&
-             node_to_node_set,
-         absl::flat_hash_map<Node*, std::vector<Node*>>* node_to_node_vect) {
-        for (auto& [base_node, node_set] : node_to_node_set) {
-          auto& node_vect = (*node_to_node_vect)[base_node];
-          node_vect.insert(node_vect.begin(), node_set.begin(), node_set.end());
-          SortByNodeId(&node_vect);
-        }
-      };
-  XLS_RET_CHECK(
-      analysis->dominated_node_to_post_dominators_ordered_by_id_.empty());
-  XLS_RET_CHECK(
-      analysis->post_dominator_to_dominated_nodes_ordered_by_id_.empty());
-  generate_ordered_by_id_nodes(
-      analysis->dominated_node_to_post_dominators_,
-      &analysis->dominated_node_to_post_dominators_ordered_by_id_);
-  generate_ordered_by_id_nodes(
-      analysis->post_dominator_to_dominated_nodes_,
-      &analysis->post_dominator_to_dominated_nodes_ordered_by_id_);
+  // The per-function analyses are independent; compute them with
+  // `worker_count` workers pulling function indices from a shared counter,
+  // then insert the results into the cache serially.
+  std::vector<absl::StatusOr<std::unique_ptr<PostDominatorAnalysis>>> analyses(
+      stale.size());
+  worker_count = std::min(worker_count, static_cast<int64_t>(stale.size()));
+  if (worker_count <= 1) {
+    for (int64_t i = 0; i < static_cast<int64_t>(stale.size()); ++i) {
+      analyses[i] = PostDominatorAnalysis::Run(stale[i]);
+    }
+  } else {
+    std::atomic<int64_t> next_index = 0;
+    auto worker_body = [&]() {
+      for (int64_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+           i < static_cast<int64_t>(stale.size());
+           i = next_index.fetch_add(1, std::memory_order_relaxed)) {
+        analyses[i] = PostDominatorAnalysis::Run(stale[i]);
+      }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count - 1);
+    for (int64_t i = 1; i < worker_count; ++i) {
+      workers.push_back(std::thread(worker_body));
+    }
+    worker_body();
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
 
-  return std::move(analysis);
+  for (int64_t i = 0; i < static_cast<int64_t>(stale.size()); ++i) {
+    FunctionBase* f = stale[i];
+    XLS_ASSIGN_OR_RETURN(std::unique_ptr<PostDominatorAnalysis> analysis,
+                         std::move(analyses[i]));
+    Entry& entry = entries_[f];
+    entry.analysis = std::move(analysis);
+    entry.function_name = f->name();
+    entry.transform_version = f->transform_version();
+  }
+  return absl::OkStatus();
 }
 
 }  // namespace xls
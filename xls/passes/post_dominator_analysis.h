@@ -15,19 +15,26 @@
 #ifndef XLS_PASSES_POST_DOMINATOR_ANALYSIS_H_
 #define XLS_PASSES_POST_DOMINATOR_ANALYSIS_H_
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
-#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
-#include "xls/ir/function.h"
+#include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
+#include "xls/ir/package.h"
 
 namespace xls {
 
 // A class for post-dominator analysis of the IR instructions in a function.
+// The analysis computes the post-dominator tree with the semi-NCA algorithm
+// over dense preorder-indexed vectors, so construction is near-linear in the
+// number of edges and post-dominance queries are constant time.
 class PostDominatorAnalysis {
  public:
   // Performs post-dominator analysis on the function and returns the result.
@@ -45,25 +52,84 @@ class PostDominatorAnalysis {
   // Returns true if 'node' is post-dominated by 'post_dominator'.
   bool NodeIsPostDominatedBy(const Node* node,
                              const Node* post_dominator) const {
-    return dominated_node_to_post_dominators_.at(node).contains(post_dominator);
+    const TreeInterval& dominator = tree_intervals_.at(post_dominator);
+    const TreeInterval& dominated = tree_intervals_.at(node);
+    return dominator.preorder <= dominated.preorder &&
+           dominated.preorder < dominator.subtree_end;
   }
   // Returns true if 'node' post_dominates 'post_dominated'.
   bool NodePostDominates(const Node* node, const Node* post_dominated) const {
-    return post_dominator_to_dominated_nodes_.at(node).contains(post_dominated);
+    return NodeIsPostDominatedBy(post_dominated, node);
+  }
+
+  // Returns the immediate post-dominator of `node`, or nullptr if `node` is
+  // post-dominated only by itself.
+  Node* GetImmediatePostDominator(const Node* node) const {
+    return immediate_post_dominators_.at(node);
   }
 
  private:
-  // Maps from a node to all nodes that post-dominate the node.
-  absl::flat_hash_map<Node*, absl::flat_hash_set<Node*>>
-      dominated_node_to_post_dominators_;
-  absl::flat_hash_map<Node*, std::vector<Node*>>
+  // Position of a node in a preorder traversal of the post-dominator tree.
+  // A node's subtree occupies the contiguous preorder interval
+  // [preorder, subtree_end), so ancestor queries are two comparisons.
+  struct TreeInterval {
+    int64_t preorder;
+    int64_t subtree_end;
+  };
+
+  // The parent of each node in the post-dominator tree, or nullptr for nodes
+  // post-dominated only by themselves.
+  NodeMap<Node*> immediate_post_dominators_;
+  NodeMap<TreeInterval> tree_intervals_;
+
+  // Materialized post-dominator chains and subtrees, sorted by node id.
+  NodeMap<std::vector<Node*>>
       dominated_node_to_post_dominators_ordered_by_id_;
+  NodeMap<std::vector<Node*>> post_dominator_to_dominated_nodes_ordered_by_id_;
+};
+
+// A cache of post-dominator analyses shared across pass invocations
+// (typically via PassResults::post_dominators). Entries are validated against
+// the FunctionBase's transform version: a consumer running on an unchanged
+// function reuses the analysis computed by an earlier pass instead of
+// re-running it.
+//
+// The cache is not thread-safe; passes which process FunctionBases
+// concurrently (worker_count > 1) must construct their analyses locally
+// instead.
+class CachedPostDominatorAnalysis {
+ public:
+  // Returns the post-dominator analysis for `f`, recomputing it if `f` has
+  // been transformed since it was cached. The returned pointer is owned by
+  // the cache and must not be used after `f` is mutated; call GetAnalysis
+  // again instead.
+  absl::StatusOr<const PostDominatorAnalysis*> GetAnalysis(FunctionBase* f);
+
+  // Computes (up to `worker_count` FunctionBases at a time) and caches the
+  // analysis for every FunctionBase in `package` whose cached entry is
+  // missing or stale. The per-function analyses are independent, so a
+  // pipeline which needs post-dominators for many functions can warm the
+  // cache in parallel before its serial per-function processing.
+  absl::Status Prepopulate(Package* package, int64_t worker_count);
+
+  // Drops all cached analyses.
+  void Clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    std::unique_ptr<PostDominatorAnalysis> analysis;
+    // Name of the FunctionBase at computation time. Guards against a deleted
+    // FunctionBase being reallocated at the same address.
+    std::string function_name;
+    // FunctionBase::transform_version() at computation time.
+    int64_t transform_version;
+  };
+
+  // Returns true if the cached entry for `f` (if any) was computed at `f`'s
+  // current transform version.
+  bool EntryIsCurrent(FunctionBase* f) const;
 
-  // Maps from a node to all nodes that are post-dominated by the node.
-  absl::flat_hash_map<Node*, absl::flat_hash_set<Node*>>
-      post_dominator_to_dominated_nodes_;
-  absl::flat_hash_map<Node*, std::vector<Node*>>
-      post_dominator_to_dominated_nodes_ordered_by_id_;
+  absl::flat_hash_map<FunctionBase*, Entry> entries_;
 };
 
 }  // namespace xls
@@ -22,6 +22,10 @@
 #include "xls/ir/bits.h"
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/value.h"
 
 namespace xls {
@@ -249,5 +253,70 @@ TEST_F(PostDominatorAnalysisTest, MultipleOutputs) {
               ElementsAre(y.node(), z.node()));
 }
 
+TEST_F(PostDominatorAnalysisTest, ImmediatePostDominators) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(1));
+  BValue a = fb.Not(x);
+  BValue b = fb.Not(x);
+  BValue and_op = fb.And(a, b);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<PostDominatorAnalysis> analysis,
+                           PostDominatorAnalysis::Run(f));
+
+  EXPECT_EQ(analysis->GetImmediatePostDominator(x.node()), and_op.node());
+  EXPECT_EQ(analysis->GetImmediatePostDominator(a.node()), and_op.node());
+  EXPECT_EQ(analysis->GetImmediatePostDominator(b.node()), and_op.node());
+  EXPECT_EQ(analysis->GetImmediatePostDominator(and_op.node()), nullptr);
+}
+
+TEST_F(PostDominatorAnalysisTest, CachedAnalysisReuse) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(1));
+  fb.Not(x);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  CachedPostDominatorAnalysis cache;
+  XLS_ASSERT_OK_AND_ASSIGN(const PostDominatorAnalysis* first,
+                           cache.GetAnalysis(f));
+  XLS_ASSERT_OK_AND_ASSIGN(const PostDominatorAnalysis* second,
+                           cache.GetAnalysis(f));
+  // The function is unchanged, so the cached analysis is handed out again.
+  EXPECT_EQ(first, second);
+
+  // Transforming the function invalidates the cached analysis; the fresh one
+  // covers the new node.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * not_node,
+      f->MakeNode<UnOp>(SourceInfo(), f->return_value(), Op::kNot));
+  XLS_ASSERT_OK_AND_ASSIGN(const PostDominatorAnalysis* third,
+                           cache.GetAnalysis(f));
+  EXPECT_THAT(third->GetPostDominatorsOfNode(not_node),
+              ElementsAre(not_node));
+}
+
+TEST_F(PostDominatorAnalysisTest, PrepopulatePackage) {
+  auto p = CreatePackage();
+  FunctionBuilder fb_f("f", p.get());
+  BValue x = fb_f.Param("x", p->GetBitsType(1));
+  BValue not_x = fb_f.Not(x);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb_f.Build());
+  FunctionBuilder fb_g("g", p.get());
+  BValue y = fb_g.Param("y", p->GetBitsType(1));
+  BValue not_y = fb_g.Not(y);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * g, fb_g.Build());
+
+  CachedPostDominatorAnalysis cache;
+  XLS_ASSERT_OK(cache.Prepopulate(p.get(), /*worker_count=*/2));
+
+  XLS_ASSERT_OK_AND_ASSIGN(const PostDominatorAnalysis* f_analysis,
+                           cache.GetAnalysis(f));
+  EXPECT_TRUE(f_analysis->NodeIsPostDominatedBy(x.node(), not_x.node()));
+  XLS_ASSERT_OK_AND_ASSIGN(const PostDominatorAnalysis* g_analysis,
+                           cache.GetAnalysis(g));
+  EXPECT_TRUE(g_analysis->NodeIsPostDominatedBy(y.node(), not_y.node()));
+}
+
 }  // namespace
 }  // namespace xls
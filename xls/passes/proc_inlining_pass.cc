@@ -15,12 +15,14 @@
 #include "xls/passes/proc_inlining_pass.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>  // NOLINT(build/c++11)
 #include <utility>
 #include <vector>
 
@@ -54,6 +56,7 @@
 #include "xls/ir/value_utils.h"
 #include "xls/passes/bdd_query_engine.h"
 #include "xls/passes/dataflow_visitor.h"
+#include "xls/passes/dce_pass.h"
 #include "xls/passes/optimization_pass.h"
 #include "xls/passes/optimization_pass_registry.h"
 #include "xls/passes/pass_base.h"
@@ -1180,8 +1183,9 @@ class ProcThread {
                                   send->GetName(), ch->name());
 
     Node* result;
-    if (ch->supported_ops() == ChannelOps::kSendReceive) {
-      // Non-external send. Convert send into a virtual send.
+    if (virtual_channels.contains(ch)) {
+      // Channel internal to the procs being inlined. Convert send into a
+      // virtual send.
       XLS_ASSIGN_OR_RETURN(result, CreateVirtualSend(send, activation_node,
                                                      virtual_channels.at(ch)));
     } else if (ch->kind() == ChannelKind::kStreaming) {
@@ -1207,8 +1211,9 @@ class ProcThread {
                                   receive->GetName(), ch->name());
 
     Node* result;
-    if (ch->supported_ops() == ChannelOps::kSendReceive) {
-      // Non-external receive. Convert receive into a virtual receive.
+    if (virtual_channels.contains(ch)) {
+      // Channel internal to the procs being inlined. Convert receive into a
+      // virtual receive.
       XLS_ASSIGN_OR_RETURN(result,
                            CreateVirtualReceive(receive, activation_node,
                                                 virtual_channels.at(ch)));
@@ -1763,68 +1768,83 @@ absl::Status SetProcState(Proc* proc, absl::Span<const StateElement> elements) {
   return absl::OkStatus();
 }
 
-}  // namespace
-
-absl::StatusOr<bool> ProcInliningPass::RunInternal(
-    Package* p, const OptimizationPassOptions& options,
-    PassResults* results) const {
-  if (!options.inline_procs || p->procs().size() <= 1) {
-    return false;
-  }
-
-  if (!p->HasTop()) {
-    return absl::InvalidArgumentError(
-        "Must specify top-level proc name when running proc inlining");
-  }
-
-  FunctionBase* top_func_base = p->GetTop().value();
-
-  if (!top_func_base->IsProc()) {
-    return absl::InvalidArgumentError(absl::StrFormat(
-        "Top level %s should be a proc when running proc inlining",
-        top_func_base->name()));
+// Inlines the procs of `cluster` into a freshly created container proc named
+// `container_name`. Channels whose operations all live within the cluster are
+// replaced with virtual channels and deleted; channels with an endpoint
+// outside the cluster remain real, with their operations sequenced on the
+// activation chain like external I/O. If the cluster contains the package top
+// the container becomes the new top and takes over its name. The cluster
+// procs are removed from the package. Returns the container proc.
+absl::StatusOr<Proc*> InlineProcCluster(Package* p,
+                                        absl::Span<Proc* const> cluster,
+                                        std::string_view container_name) {
+  XLS_RET_CHECK(!cluster.empty());
+  absl::flat_hash_set<Proc*> cluster_set(cluster.begin(), cluster.end());
+
+  std::optional<FunctionBase*> top = p->GetTop();
+  bool contains_top = top.has_value() && (*top)->IsProc() &&
+                      cluster_set.contains((*top)->AsProcOrDie());
+  Proc* reference_proc =
+      contains_top ? (*top)->AsProcOrDie() : cluster.front();
+
+  // The initiation intervals of all inlined procs must agree.
+  int64_t reference_ii = reference_proc->GetInitiationInterval().value_or(1);
+  bool explicit_ii = false;
+  for (Proc* proc : cluster) {
+    int64_t inner_ii = proc->GetInitiationInterval().value_or(1);
+    XLS_RET_CHECK_EQ(inner_ii, reference_ii)
+        << "Proc " << proc->name() << " had a different initiation interval "
+        << "when compared to proc " << reference_proc->name();
+    explicit_ii =
+        explicit_ii || proc->GetInitiationInterval().has_value();
+  }
+
+  Proc* container_proc =
+      p->AddProc(std::make_unique<Proc>(container_name, p));
+  if (explicit_ii) {
+    container_proc->SetInitiationInterval(reference_ii);
   }
+  XLS_ASSIGN_OR_RETURN(Node * container_token,
+                       container_proc->MakeNodeWithName<Literal>(
+                           SourceInfo(), Value::Token(), "__container_tkn"));
 
-  std::vector<Proc*> procs_to_inline;
-  procs_to_inline.reserve(p->procs().size());
+  // Find the procs operating on each channel. A channel is virtualized only
+  // if every operation on it lives within the cluster; otherwise it stays a
+  // real package channel connecting the container to the outside.
+  absl::flat_hash_map<Channel*, absl::flat_hash_set<Proc*>> channel_users;
   for (const std::unique_ptr<Proc>& proc : p->procs()) {
-    procs_to_inline.push_back(proc.get());
+    for (Node* node : proc->nodes()) {
+      if (!IsChannelNode(node)) {
+        continue;
+      }
+      XLS_ASSIGN_OR_RETURN(Channel * ch, GetChannelUsedByNode(node));
+      channel_users[ch].insert(proc.get());
+    }
   }
-
-  {
-    int64_t top_ii = 1;
-    if (top_func_base->GetInitiationInterval().has_value()) {
-      top_ii = top_func_base->GetInitiationInterval().value();
+  auto channel_is_internal = [&](Channel* ch) {
+    if (ch->supported_ops() != ChannelOps::kSendReceive) {
+      return false;
     }
-    for (Proc* proc : procs_to_inline) {
-      int64_t inner_ii = 1;
-      if (proc->GetInitiationInterval().has_value()) {
-        inner_ii = proc->GetInitiationInterval().value();
-      }
-      XLS_RET_CHECK_EQ(inner_ii, top_ii)
-          << "Proc " << proc->name() << " had a different initiation interval "
-          << "when compared to the top proc (" << top_func_base->name() << ")";
-      if (!proc->next_values().empty()) {
-        return absl::UnimplementedError(absl::StrFormat(
-            "Proc %s uses next_value nodes, which are not currently "
-            "supported by proc inlining.",
-            proc->name()));
+    auto it = channel_users.find(ch);
+    if (it == channel_users.end()) {
+      // Unused internal channel; safe to virtualize (and delete).
+      return true;
+    }
+    for (Proc* proc : it->second) {
+      if (!cluster_set.contains(proc)) {
+        return false;
       }
     }
-  }
-
-  Proc* container_proc = p->AddProc(std::make_unique<Proc>("__container", p));
-  XLS_ASSIGN_OR_RETURN(Node * container_token,
-                       container_proc->MakeNodeWithName<Literal>(
-                           SourceInfo(), Value::Token(), "__container_tkn"));
+    return true;
+  };
 
   // Gather all inlined proc state and proc thread book-keeping bits and add to
-  // the top-level proc state.
+  // the container proc state.
   std::vector<StateElement> state_elements;
 
   absl::flat_hash_map<Channel*, VirtualChannel> virtual_channels;
   for (Channel* ch : p->channels()) {
-    if (ch->supported_ops() == ChannelOps::kSendReceive) {
+    if (channel_is_internal(ch)) {
       XLS_ASSIGN_OR_RETURN(virtual_channels[ch],
                            VirtualChannel::Create(ch, container_proc));
       if (virtual_channels[ch].ChannelDataState().has_value()) {
@@ -1838,18 +1858,18 @@ absl::StatusOr<bool> ProcInliningPass::RunInternal(
 
   std::vector<ProcThread> proc_threads;
 
-  // Inline each proc into `container_proc`. Sends/receives are converted to
-  // virtual send/receives.
+  // Inline each proc into `container_proc`. Sends/receives on virtualized
+  // channels are converted to virtual send/receives.
   // TODO(meheff): 2022/02/11 Add analysis which determines whether inlining is
   // a legal transformation.
-  for (Proc* proc : procs_to_inline) {
+  for (Proc* proc : cluster) {
     XLS_ASSIGN_OR_RETURN(
         ProcThread proc_thread,
         InlineProcAsProcThread(proc, container_proc, virtual_channels));
     proc_threads.push_back(std::move(proc_thread));
   }
 
-  VLOG(3) << "After inlining procs:\n" << p->DumpIr();
+  VLOG(3) << "After inlining cluster:\n" << p->DumpIr();
 
   // Changes were made to IsCheapForBdds which breaks proc inlining. Replicate
   // the old IsCheapForBdds function here. This doesn't matter because proc
@@ -1876,7 +1896,7 @@ absl::StatusOr<bool> ProcInliningPass::RunInternal(
     XLS_RETURN_IF_ERROR(proc_thread.MaybeSaveReceivedData(query_engine));
   }
 
-  // Add the inlined (and top) proc state and activation bits.
+  // Add the inlined proc state and activation bits.
   for (const ProcThread& proc_thread : proc_threads) {
     for (const StateElement& state_element : proc_thread.GetStateElements()) {
       state_elements.push_back(state_element);
@@ -1896,25 +1916,30 @@ absl::StatusOr<bool> ProcInliningPass::RunInternal(
 
   VLOG(3) << "After transforming proc state:\n" << p->DumpIr();
 
-  // Delete inlined procs.
-  XLS_RETURN_IF_ERROR(p->SetTop(container_proc));
-  std::string top_proc_name = top_func_base->AsProcOrDie()->name();
-  for (Proc* proc : procs_to_inline) {
+  // Delete the inlined procs. If the top proc was inlined the container
+  // replaces it (and takes over its name).
+  if (contains_top) {
+    XLS_RETURN_IF_ERROR(p->SetTop(container_proc));
+  }
+  std::string reference_name = reference_proc->name();
+  for (Proc* proc : cluster) {
     XLS_RETURN_IF_ERROR(p->RemoveProc(proc));
   }
-  container_proc->SetName(top_proc_name);
+  if (contains_top) {
+    container_proc->SetName(reference_name);
+  }
 
   VLOG(3) << "After deleting inlined procs:\n" << p->DumpIr();
 
-  // Delete send and receive nodes in top which were used for communicating with
-  // the inlined procs.
+  // Delete send and receive nodes in the container which were used for
+  // communicating between the inlined procs.
   std::vector<Node*> to_remove;
   for (Node* node : container_proc->nodes()) {
     if (!IsChannelNode(node)) {
       continue;
     }
     XLS_ASSIGN_OR_RETURN(Channel * ch, GetChannelUsedByNode(node));
-    if (ch->supported_ops() == ChannelOps::kSendReceive) {
+    if (virtual_channels.contains(ch)) {
       to_remove.push_back(node);
     }
   }
@@ -1922,16 +1947,212 @@ absl::StatusOr<bool> ProcInliningPass::RunInternal(
     XLS_RETURN_IF_ERROR(container_proc->RemoveNode(node));
   }
 
-  // Delete channels used for communicating with the inlined procs.
+  // Delete the virtualized channels.
   std::vector<Channel*> channels(p->channels().begin(), p->channels().end());
   for (Channel* ch : channels) {
-    if (ch->supported_ops() == ChannelOps::kSendReceive) {
+    if (virtual_channels.contains(ch)) {
       XLS_RETURN_IF_ERROR(p->RemoveChannel(ch));
     }
   }
 
   VLOG(3) << "After deleting inlined I/O:\n" << p->DumpIr();
 
+  return container_proc;
+}
+
+// Groups non-top procs connected by internal channels into clusters of at
+// most `cluster_size` procs. Clustering is greedy: each unassigned proc seeds
+// a cluster which repeatedly absorbs the unassigned neighbor sharing the most
+// channels with the cluster, so inlining a cluster virtualizes as many
+// channels as possible. Only clusters of at least two procs are returned; a
+// proc with no channel to another non-top proc is left alone.
+std::vector<std::vector<Proc*>> FormProcClusters(Package* p,
+                                                 FunctionBase* top,
+                                                 int64_t cluster_size) {
+  absl::flat_hash_map<Channel*, absl::flat_hash_set<Proc*>> channel_users;
+  for (const std::unique_ptr<Proc>& proc : p->procs()) {
+    for (Node* node : proc->nodes()) {
+      if (!IsChannelNode(node)) {
+        continue;
+      }
+      absl::StatusOr<Channel*> ch = GetChannelUsedByNode(node);
+      if (ch.ok()) {
+        channel_users[*ch].insert(proc.get());
+      }
+    }
+  }
+
+  absl::flat_hash_map<Proc*, absl::flat_hash_map<Proc*, int64_t>> weight;
+  for (const auto& [channel, users] : channel_users) {
+    if (channel->supported_ops() != ChannelOps::kSendReceive ||
+        users.size() != 2) {
+      continue;
+    }
+    auto it = users.begin();
+    Proc* a = *it;
+    Proc* b = *std::next(it);
+    if (a == top || b == top) {
+      continue;
+    }
+    ++weight[a][b];
+    ++weight[b][a];
+  }
+
+  std::vector<std::vector<Proc*>> clusters;
+  absl::flat_hash_set<Proc*> assigned;
+  for (const std::unique_ptr<Proc>& proc_ptr : p->procs()) {
+    Proc* seed = proc_ptr.get();
+    if (seed == top || assigned.contains(seed) || !weight.contains(seed)) {
+      continue;
+    }
+    std::vector<Proc*> cluster = {seed};
+    assigned.insert(seed);
+    while (static_cast<int64_t>(cluster.size()) < cluster_size) {
+      // Absorb the unassigned neighbor with the strongest connection to the
+      // cluster; break weight ties by name for determinism.
+      Proc* best = nullptr;
+      int64_t best_weight = 0;
+      for (Proc* member : cluster) {
+        auto member_it = weight.find(member);
+        if (member_it == weight.end()) {
+          continue;
+        }
+        for (const auto& [neighbor, w] : member_it->second) {
+          if (assigned.contains(neighbor)) {
+            continue;
+          }
+          if (best == nullptr || w > best_weight ||
+              (w == best_weight && neighbor->name() < best->name())) {
+            best = neighbor;
+            best_weight = w;
+          }
+        }
+      }
+      if (best == nullptr) {
+        break;
+      }
+      cluster.push_back(best);
+      assigned.insert(best);
+    }
+    if (cluster.size() >= 2) {
+      clusters.push_back(std::move(cluster));
+    }
+  }
+  return clusters;
+}
+
+// Runs dead-code elimination over freshly created cluster containers so each
+// round of hierarchical inlining starts from cleaned-up inputs. The
+// containers are independent procs, so with worker_count > 1 they are
+// processed concurrently.
+absl::Status CleanUpClusterContainers(absl::Span<Proc* const> containers,
+                                      const OptimizationPassOptions& options,
+                                      PassResults* results) {
+  DeadCodeEliminationPass dce;
+  int64_t worker_count =
+      std::min(options.worker_count, static_cast<int64_t>(containers.size()));
+  if (worker_count <= 1) {
+    for (Proc* container : containers) {
+      XLS_RETURN_IF_ERROR(
+          dce.RunOnFunctionBase(container, options, results).status());
+    }
+    return absl::OkStatus();
+  }
+  std::vector<absl::Status> statuses(containers.size());
+  std::atomic<int64_t> next_index = 0;
+  auto worker_body = [&]() {
+    for (int64_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+         i < static_cast<int64_t>(containers.size());
+         i = next_index.fetch_add(1, std::memory_order_relaxed)) {
+      statuses[i] =
+          dce.RunOnFunctionBase(containers[i], options, results).status();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count - 1);
+  for (int64_t i = 1; i < worker_count; ++i) {
+    workers.push_back(std::thread(worker_body));
+  }
+  worker_body();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  for (const absl::Status& status : statuses) {
+    XLS_RETURN_IF_ERROR(status);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<bool> ProcInliningPass::RunInternal(
+    Package* p, const OptimizationPassOptions& options,
+    PassResults* results) const {
+  if (!options.inline_procs || p->procs().size() <= 1) {
+    return false;
+  }
+
+  if (!p->HasTop()) {
+    return absl::InvalidArgumentError(
+        "Must specify top-level proc name when running proc inlining");
+  }
+
+  FunctionBase* top_func_base = p->GetTop().value();
+
+  if (!top_func_base->IsProc()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Top level %s should be a proc when running proc inlining",
+        top_func_base->name()));
+  }
+
+  for (const std::unique_ptr<Proc>& proc : p->procs()) {
+    if (!proc->next_values().empty()) {
+      return absl::UnimplementedError(absl::StrFormat(
+          "Proc %s uses next_value nodes, which are not currently "
+          "supported by proc inlining.",
+          proc->name()));
+    }
+  }
+
+  // Hierarchical mode: repeatedly collapse clusters of tightly connected
+  // non-top procs bottom-up before the final inline into the top proc. This
+  // bounds the number of proc threads (and thus the activation-network
+  // book-keeping) created by any single inlining step, and the independent
+  // cluster containers are cleaned up in parallel between rounds.
+  if (options.proc_inlining_cluster_size >= 2) {
+    int64_t round = 0;
+    while (static_cast<int64_t>(p->procs().size()) >
+           options.proc_inlining_cluster_size) {
+      std::vector<std::vector<Proc*>> clusters = FormProcClusters(
+          p, top_func_base, options.proc_inlining_cluster_size);
+      if (clusters.empty()) {
+        break;
+      }
+      std::vector<Proc*> containers;
+      containers.reserve(clusters.size());
+      for (const std::vector<Proc*>& cluster : clusters) {
+        XLS_ASSIGN_OR_RETURN(
+            Proc * container,
+            InlineProcCluster(p, cluster,
+                              absl::StrFormat("__cluster_%d_%d", round,
+                                              containers.size())));
+        containers.push_back(container);
+      }
+      XLS_RETURN_IF_ERROR(
+          CleanUpClusterContainers(containers, options, results));
+      ++round;
+    }
+  }
+
+  std::vector<Proc*> procs_to_inline;
+  procs_to_inline.reserve(p->procs().size());
+  for (const std::unique_ptr<Proc>& proc : p->procs()) {
+    procs_to_inline.push_back(proc.get());
+  }
+
+  XLS_RETURN_IF_ERROR(
+      InlineProcCluster(p, procs_to_inline, "__container").status());
+
   return true;
 }
 
@@ -85,13 +85,15 @@ class ProcInliningPassTest : public IrTestBase {
   ProcInliningPassTest() = default;
 
   absl::StatusOr<bool> Run(Package* p,
-                           std::optional<std::string> top = std::nullopt) {
+                           std::optional<std::string> top = std::nullopt,
+                           int64_t cluster_size = 0) {
     if (top.has_value()) {
       XLS_RETURN_IF_ERROR(p->SetTopByName(top.value()));
     }
 
     OptimizationPassOptions options;
     options.inline_procs = true;
+    options.proc_inlining_cluster_size = cluster_size;
     PassResults results;
     XLS_ASSIGN_OR_RETURN(bool changed,
                          ProcInliningPass().Run(p, options, &results));
@@ -1183,6 +1185,64 @@ TEST_F(ProcInliningPassTest, DoubleNestedProcsPassThrough) {
           .status());
 }
 
+TEST_F(ProcInliningPassTest, HierarchicalInliningPassThrough) {
+  // Same network as DoubleNestedProcsPassThrough, but inlined hierarchically
+  // with clusters of at most two procs: B and C (connected by two internal
+  // channels) are collapsed into an intermediate container proc before the
+  // final inline into A.
+  auto p = CreatePackage();
+  Type* u32 = p->GetBitsType(32);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * ch_in,
+      p->CreateStreamingChannel("in", ChannelOps::kReceiveOnly, u32));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * ch_out,
+      p->CreateStreamingChannel("out", ChannelOps::kSendOnly, u32));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * a_to_b,
+      p->CreateStreamingChannel("a_to_b", ChannelOps::kSendReceive, u32,
+                                /*initial_values=*/{},
+                                /*fifo_config=*/FifoConfigWithDepth(0)));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * b_to_a,
+      p->CreateStreamingChannel("b_to_a", ChannelOps::kSendReceive, u32,
+                                /*initial_values=*/{},
+                                /*fifo_config=*/FifoConfigWithDepth(0)));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * b_to_c,
+      p->CreateStreamingChannel("b_to_c", ChannelOps::kSendReceive, u32,
+                                /*initial_values=*/{},
+                                /*fifo_config=*/FifoConfigWithDepth(0)));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Channel * c_to_b,
+      p->CreateStreamingChannel("c_to_b", ChannelOps::kSendReceive, u32,
+                                /*initial_values=*/{},
+                                /*fifo_config=*/FifoConfigWithDepth(0)));
+
+  XLS_ASSERT_OK(MakePassThroughProc("A", ch_in, a_to_b, b_to_a, ch_out, p.get())
+                    .status());
+  XLS_ASSERT_OK(
+      MakePassThroughProc("B", a_to_b, b_to_c, c_to_b, b_to_a, p.get())
+          .status());
+  XLS_ASSERT_OK(MakeLoopbackProc("C", b_to_c, c_to_b, p.get()).status());
+
+  EXPECT_EQ(p->procs().size(), 3);
+  XLS_EXPECT_OK(
+      EvalAndExpect(p.get(), {{"in", {123, 22, 42}}}, {{"out", {123, 22, 42}}})
+          .status());
+
+  ASSERT_THAT(Run(p.get(), /*top=*/"A", /*cluster_size=*/2),
+              IsOkAndHolds(true));
+
+  EXPECT_EQ(p->procs().size(), 1);
+  EXPECT_EQ(p->procs().front()->name(), "A");
+  XLS_EXPECT_OK(
+      EvalAndExpect(p.get(), {{"in", {123, 22, 42}}}, {{"out", {123, 22, 42}}})
+          .status());
+}
+
 TEST_F(ProcInliningPassTest, SequentialNestedProcsPassThrough) {
   // Sequential procs where each inner proc passes through the value.
   auto p = CreatePackage();
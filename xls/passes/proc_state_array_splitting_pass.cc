@@ -0,0 +1,319 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/proc_state_array_splitting_pass.h"
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/container/btree_set.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/proc.h"
+#include "xls/ir/type.h"
+#include "xls/ir/value.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/optimization_pass_registry.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls {
+namespace {
+
+// Returns the value of `index` if it is a literal, clamped to `limit`.
+// Returns std::nullopt for non-literal indices. Values which do not fit in a
+// uint64_t are necessarily out of bounds for any array and map to `limit`.
+std::optional<int64_t> LiteralIndexValue(Node* index, int64_t limit) {
+  if (!index->Is<Literal>()) {
+    return std::nullopt;
+  }
+  const Bits& bits = index->As<Literal>()->value().bits();
+  if (!bits.FitsInUint64()) {
+    return limit;
+  }
+  uint64_t value = bits.ToUint64().value();
+  if (value > static_cast<uint64_t>(limit)) {
+    return limit;
+  }
+  return static_cast<int64_t>(value);
+}
+
+// The result of analyzing one splittable array-typed state element.
+struct ArraySplitPlan {
+  // Constant-index reads of the state param paired with the element index
+  // they access. Out-of-bounds literal indices are clamped to the maximum
+  // index, matching kArrayIndex semantics.
+  std::vector<std::pair<ArrayIndex*, int64_t>> reads;
+
+  // For each write of the state element -- a next_value node, or nullptr for
+  // the legacy next-state element -- the last-write-wins update value for
+  // each element index written by its array-update chain. Out-of-bounds
+  // updates are no-ops and are dropped; indices absent from the map keep
+  // their previous value.
+  std::vector<std::pair<Next*, absl::flat_hash_map<int64_t, Node*>>> writes;
+
+  // The array-update nodes making up the write chains, ordered from each
+  // chain's head down towards the state param. All are dead once the writes
+  // are rewritten.
+  std::vector<ArrayUpdate*> chain_nodes;
+};
+
+// Analyzes the state element of `proc` at `state_index` and returns a plan
+// for splitting it into per-element state, or std::nullopt if the element is
+// not array-typed or has an access which cannot be attributed to a single
+// constant index.
+std::optional<ArraySplitPlan> AnalyzeArrayStateElement(Proc* proc,
+                                                       int64_t state_index) {
+  Param* param = proc->GetStateParam(state_index);
+  if (!param->GetType()->IsArray()) {
+    return std::nullopt;
+  }
+  const int64_t array_size = param->GetType()->AsArrayOrDie()->size();
+
+  ArraySplitPlan plan;
+  absl::flat_hash_set<Node*> chain_members;
+
+  // Decomposes a linear chain of single-constant-index array-updates rooted
+  // at `param` into a map from element index to final update value. Returns
+  // std::nullopt if `head` is not such a chain or an intermediate result is
+  // observed outside the chain.
+  auto decompose_chain =
+      [&](Node* head) -> std::optional<absl::flat_hash_map<int64_t, Node*>> {
+    std::vector<ArrayUpdate*> chain;
+    Node* node = head;
+    while (node != param) {
+      if (!node->Is<ArrayUpdate>()) {
+        return std::nullopt;
+      }
+      ArrayUpdate* update = node->As<ArrayUpdate>();
+      if (update->indices().size() != 1 ||
+          !LiteralIndexValue(update->indices().front(), array_size)
+               .has_value()) {
+        return std::nullopt;
+      }
+      if (node != head && update->users().size() != 1) {
+        return std::nullopt;
+      }
+      chain.push_back(update);
+      node = update->array_to_update();
+    }
+    // Apply the chain from the param outwards so later updates of the same
+    // index win.
+    absl::flat_hash_map<int64_t, Node*> updates;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      int64_t index =
+          *LiteralIndexValue((*it)->indices().front(), array_size);
+      if (index < array_size) {
+        updates[index] = (*it)->update_value();
+      }
+    }
+    for (ArrayUpdate* update : chain) {
+      chain_members.insert(update);
+      plan.chain_nodes.push_back(update);
+    }
+    return updates;
+  };
+
+  // Memoize decomposed chain heads; a head may feed several next_value nodes
+  // (e.g., with different predicates) and its chain must only be removed
+  // once.
+  absl::flat_hash_map<Node*, absl::flat_hash_map<int64_t, Node*>> decomposed;
+
+  if (proc->next_values(param).empty()) {
+    // Legacy next-state element style.
+    Node* next_state = proc->GetNextStateElement(state_index);
+    if (next_state != param) {
+      if (!next_state->users().empty() ||
+          proc->GetNextStateIndices(next_state) !=
+              absl::btree_set<int64_t>{state_index}) {
+        return std::nullopt;
+      }
+      std::optional<absl::flat_hash_map<int64_t, Node*>> updates =
+          decompose_chain(next_state);
+      if (!updates.has_value()) {
+        return std::nullopt;
+      }
+      plan.writes.push_back({nullptr, *std::move(updates)});
+    }
+  } else {
+    for (Next* next : proc->next_values(param)) {
+      if (next->value() == param) {
+        plan.writes.push_back({next, {}});
+        continue;
+      }
+      // The chain head must only be observed by next_value nodes of this
+      // state element.
+      for (Node* user : next->value()->users()) {
+        if (!user->Is<Next>() || user->As<Next>()->param() != param) {
+          return std::nullopt;
+        }
+      }
+      auto it = decomposed.find(next->value());
+      if (it == decomposed.end()) {
+        std::optional<absl::flat_hash_map<int64_t, Node*>> updates =
+            decompose_chain(next->value());
+        if (!updates.has_value()) {
+          return std::nullopt;
+        }
+        it = decomposed.insert({next->value(), *std::move(updates)}).first;
+      }
+      plan.writes.push_back({next, it->second});
+    }
+  }
+
+  // Every use of the state param must be a constant-index read, a write
+  // chain, or a next_value node of this state element.
+  for (Node* user : param->users()) {
+    if (user->Is<Next>()) {
+      if (user->As<Next>()->param() != param) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    if (chain_members.contains(user)) {
+      continue;
+    }
+    if (user->Is<ArrayIndex>()) {
+      ArrayIndex* read = user->As<ArrayIndex>();
+      if (read->array() != param || read->indices().empty()) {
+        return std::nullopt;
+      }
+      std::optional<int64_t> index =
+          LiteralIndexValue(read->indices().front(), array_size - 1);
+      if (!index.has_value()) {
+        return std::nullopt;
+      }
+      plan.reads.push_back({read, *index});
+      continue;
+    }
+    return std::nullopt;
+  }
+
+  return plan;
+}
+
+// Replaces the array-typed state element of `proc` at `state_index` with one
+// state element per array element according to `plan`.
+absl::Status SplitArrayStateElement(Proc* proc, int64_t state_index,
+                                    const ArraySplitPlan& plan) {
+  Param* param = proc->GetStateParam(state_index);
+  const int64_t array_size = param->GetType()->AsArrayOrDie()->size();
+  const Value& init_value = proc->GetInitValueElement(state_index);
+
+  std::vector<Param*> element_params;
+  element_params.reserve(array_size);
+  for (int64_t i = 0; i < array_size; ++i) {
+    XLS_ASSIGN_OR_RETURN(
+        Param * element_param,
+        proc->AppendStateElement(absl::StrCat(param->GetName(), "_", i),
+                                 init_value.element(i)));
+    element_params.push_back(element_param);
+  }
+
+  // Rewrite the writes on a per-element basis. Elements not written by a
+  // chain keep their previous value.
+  for (const auto& [next, updates] : plan.writes) {
+    if (next == nullptr) {
+      // Legacy next-state element style; the appended elements default to
+      // keeping their value so only written indices need wiring.
+      for (const auto& [index, value] : updates) {
+        XLS_ASSIGN_OR_RETURN(int64_t element_index,
+                             proc->GetStateParamIndex(element_params[index]));
+        XLS_RETURN_IF_ERROR(proc->SetNextStateElement(element_index, value));
+      }
+      continue;
+    }
+    for (int64_t i = 0; i < array_size; ++i) {
+      auto it = updates.find(i);
+      Node* value = (it == updates.end()) ? element_params[i] : it->second;
+      XLS_RETURN_IF_ERROR(
+          proc->MakeNodeWithName<Next>(next->loc(),
+                                       /*param=*/element_params[i],
+                                       /*value=*/value,
+                                       /*predicate=*/next->predicate(),
+                                       absl::StrCat(next->GetName(), "_", i))
+              .status());
+    }
+  }
+
+  // Remove the old next_value nodes (or detach the legacy next-state node).
+  for (const auto& [next, updates] : plan.writes) {
+    if (next == nullptr) {
+      XLS_RETURN_IF_ERROR(proc->SetNextStateElement(state_index, param));
+      continue;
+    }
+    XLS_RETURN_IF_ERROR(
+        next->ReplaceUsesWithNew<Literal>(Value::Tuple({})).status());
+    XLS_RETURN_IF_ERROR(proc->RemoveNode(next));
+  }
+
+  // Forward the constant-index reads to the corresponding element param.
+  // Multi-dimensional reads keep their remaining indices.
+  for (const auto& [read, index] : plan.reads) {
+    Node* replacement = element_params[index];
+    if (read->indices().size() > 1) {
+      XLS_ASSIGN_OR_RETURN(
+          replacement,
+          proc->MakeNode<ArrayIndex>(read->loc(), element_params[index],
+                                     read->indices().subspan(1)));
+    }
+    XLS_RETURN_IF_ERROR(read->ReplaceUsesWith(replacement));
+    XLS_RETURN_IF_ERROR(proc->RemoveNode(read));
+  }
+
+  // The chain nodes are ordered head-first within each chain, so each node is
+  // dead by the time it is removed.
+  for (ArrayUpdate* update : plan.chain_nodes) {
+    XLS_RETURN_IF_ERROR(proc->RemoveNode(update));
+  }
+
+  XLS_RET_CHECK(param->IsDead());
+  return proc->RemoveStateElement(state_index);
+}
+
+}  // namespace
+
+absl::StatusOr<bool> ProcStateArraySplittingPass::RunOnProcInternal(
+    Proc* proc, const OptimizationPassOptions& options,
+    PassResults* results) const {
+  bool changed = false;
+  // Iterate downwards so removing a split element does not shift the indices
+  // of elements yet to be visited. Elements appended by a split have indices
+  // beyond the original count and are not revisited.
+  for (int64_t i = proc->GetStateElementCount() - 1; i >= 0; --i) {
+    std::optional<ArraySplitPlan> plan = AnalyzeArrayStateElement(proc, i);
+    if (!plan.has_value()) {
+      continue;
+    }
+    VLOG(2) << "Splitting array state element: "
+            << proc->GetStateParam(i)->GetName();
+    XLS_RETURN_IF_ERROR(SplitArrayStateElement(proc, i, *plan));
+    changed = true;
+  }
+  return changed;
+}
+
+REGISTER_OPT_PASS(ProcStateArraySplittingPass);
+
+}  // namespace xls
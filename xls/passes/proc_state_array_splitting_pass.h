@@ -0,0 +1,48 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_PROC_STATE_ARRAY_SPLITTING_PASS_H_
+#define XLS_PASSES_PROC_STATE_ARRAY_SPLITTING_PASS_H_
+
+#include <string_view>
+
+#include "absl/status/statusor.h"
+#include "xls/ir/proc.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls {
+
+// Pass which splits array-typed proc state elements into one state element
+// per array element when every access uses a literal index: reads must be
+// array-index operations with a constant first index and writes must be
+// linear chains of constant-index array-update operations feeding the next
+// state value. Splitting turns whole-array rewrites into per-element updates
+// and lets downstream passes narrow or remove the individual elements.
+class ProcStateArraySplittingPass : public OptimizationProcPass {
+ public:
+  static constexpr std::string_view kName = "proc_state_array_split";
+  ProcStateArraySplittingPass()
+      : OptimizationProcPass(kName, "Proc State Array Splitting") {}
+  ~ProcStateArraySplittingPass() override = default;
+
+ protected:
+  absl::StatusOr<bool> RunOnProcInternal(Proc* proc,
+                                         const OptimizationPassOptions& options,
+                                         PassResults* results) const override;
+};
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_PROC_STATE_ARRAY_SPLITTING_PASS_H_
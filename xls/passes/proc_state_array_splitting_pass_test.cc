@@ -0,0 +1,162 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/proc_state_array_splitting_pass.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/matchers.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_matcher.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/package.h"
+#include "xls/ir/value.h"
+#include "xls/passes/dce_pass.h"
+#include "xls/passes/optimization_pass.h"
+#include "xls/passes/pass_base.h"
+
+namespace m = ::xls::op_matchers;
+
+namespace xls {
+namespace {
+
+using status_testing::IsOkAndHolds;
+
+using ::testing::UnorderedElementsAre;
+
+class ProcStateArraySplittingPassTest : public IrTestBase {
+ protected:
+  absl::StatusOr<bool> Run(Package* p) {
+    PassResults results;
+    XLS_ASSIGN_OR_RETURN(bool changed,
+                         ProcStateArraySplittingPass().Run(
+                             p, OptimizationPassOptions(), &results));
+    // Run dce to clean up the dead index literals.
+    XLS_RETURN_IF_ERROR(DeadCodeEliminationPass()
+                            .Run(p, OptimizationPassOptions(), &results)
+                            .status());
+    return changed;
+  }
+};
+
+TEST_F(ProcStateArraySplittingPassTest, NonArrayStateUntouched) {
+  auto p = CreatePackage();
+  ProcBuilder pb("p", p.get());
+  BValue x = pb.StateElement("x", Value(UBits(0, 32)));
+  pb.Next(x, pb.Add(x, pb.Literal(UBits(1, 32))));
+  XLS_ASSERT_OK(pb.Build().status());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(false));
+}
+
+TEST_F(ProcStateArraySplittingPassTest, SplitsConstantIndexArrayState) {
+  auto p = CreatePackage();
+  ProcBuilder pb("p", p.get());
+  BValue x = pb.StateElement("x", Value::UBitsArray({1, 2}, 32).value());
+  // Swap the two elements each tick via an array-update chain.
+  BValue elem0 = pb.ArrayIndex(x, {pb.Literal(UBits(0, 32))});
+  BValue elem1 = pb.ArrayIndex(x, {pb.Literal(UBits(1, 32))});
+  BValue swap_lo = pb.ArrayUpdate(x, elem1, {pb.Literal(UBits(0, 32))});
+  BValue swap = pb.ArrayUpdate(swap_lo, elem0, {pb.Literal(UBits(1, 32))});
+  pb.Next(x, swap);
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(true));
+
+  ASSERT_EQ(proc->GetStateElementCount(), 2);
+  EXPECT_EQ(proc->GetStateParam(0)->GetName(), "x_0");
+  EXPECT_EQ(proc->GetStateParam(1)->GetName(), "x_1");
+  EXPECT_TRUE(proc->GetStateElementType(0)->IsBits());
+  EXPECT_TRUE(proc->GetStateElementType(1)->IsBits());
+  EXPECT_EQ(proc->GetInitValueElement(0), Value(UBits(1, 32)));
+  EXPECT_EQ(proc->GetInitValueElement(1), Value(UBits(2, 32)));
+  EXPECT_THAT(
+      proc->next_values(proc->GetStateParam(0)),
+      UnorderedElementsAre(m::Next(m::Param("x_0"), m::Param("x_1"))));
+  EXPECT_THAT(
+      proc->next_values(proc->GetStateParam(1)),
+      UnorderedElementsAre(m::Next(m::Param("x_1"), m::Param("x_0"))));
+}
+
+TEST_F(ProcStateArraySplittingPassTest, PredicatedWriteOfSingleElement) {
+  auto p = CreatePackage();
+  ProcBuilder pb("p", p.get());
+  BValue x = pb.StateElement("x", Value::UBitsArray({0, 0}, 8).value());
+  BValue pred = pb.StateElement("pred", Value(UBits(0, 1)));
+  pb.Next(x, pb.ArrayUpdate(x, pb.Literal(UBits(42, 8)),
+                            {pb.Literal(UBits(0, 32))}),
+          /*pred=*/pred);
+  pb.Next(pred, pb.Not(pred));
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(true));
+
+  ASSERT_EQ(proc->GetStateElementCount(), 3);
+  // Element 0 is written under the predicate; element 1 gets an identity
+  // next_value under the same predicate.
+  EXPECT_THAT(proc->next_values(proc->GetStateParam(1)),
+              UnorderedElementsAre(
+                  m::Next(m::Param("x_0"), m::Literal(UBits(42, 8)),
+                          m::Param("pred"))));
+  EXPECT_THAT(proc->next_values(proc->GetStateParam(2)),
+              UnorderedElementsAre(
+                  m::Next(m::Param("x_1"), m::Param("x_1"), m::Param("pred"))));
+}
+
+TEST_F(ProcStateArraySplittingPassTest, DynamicIndexPreventsSplitting) {
+  auto p = CreatePackage();
+  ProcBuilder pb("p", p.get());
+  BValue i = pb.StateElement("i", Value(UBits(0, 2)));
+  BValue x = pb.StateElement("x", Value::UBitsArray({0, 0, 0}, 32).value());
+  pb.Next(i, pb.Add(i, pb.Literal(UBits(1, 2))));
+  pb.Next(x, pb.ArrayUpdate(x, pb.Literal(UBits(7, 32)), {i}));
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(false));
+  EXPECT_EQ(proc->GetStateElementCount(), 2);
+}
+
+TEST_F(ProcStateArraySplittingPassTest, WholeArrayUsePreventsSplitting) {
+  auto p = CreatePackage();
+  ProcBuilder pb("p", p.get());
+  BValue x = pb.StateElement("x", Value::UBitsArray({0, 0}, 16).value());
+  // The whole array flows into a tuple, so it cannot be split.
+  BValue wrapped = pb.Tuple({x});
+  pb.Next(x, pb.TupleIndex(wrapped, 0));
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build());
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(false));
+  EXPECT_EQ(proc->GetStateElementCount(), 1);
+}
+
+TEST_F(ProcStateArraySplittingPassTest, LegacyNextStateElementStyle) {
+  auto p = CreatePackage();
+  ProcBuilder pb("p", p.get());
+  BValue x = pb.StateElement("x", Value::UBitsArray({1, 2}, 32).value());
+  BValue updated = pb.ArrayUpdate(x, pb.Literal(UBits(42, 32)),
+                                  {pb.Literal(UBits(0, 32))});
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build({updated}));
+
+  EXPECT_THAT(Run(p.get()), IsOkAndHolds(true));
+
+  ASSERT_EQ(proc->GetStateElementCount(), 2);
+  EXPECT_THAT(proc->GetNextStateElement(0), m::Literal(UBits(42, 32)));
+  EXPECT_THAT(proc->GetNextStateElement(1), m::Param("x_1"));
+}
+
+}  // namespace
+}  // namespace xls
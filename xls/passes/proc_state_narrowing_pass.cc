@@ -23,13 +23,16 @@
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
+#include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/data_structures/inline_bitmap.h"
 #include "xls/ir/bits.h"
+#include "xls/ir/bits_ops.h"
 #include "xls/ir/interval_ops.h"
 #include "xls/ir/interval_set.h"
 #include "xls/ir/node.h"
@@ -85,6 +88,178 @@ struct ProcStateNarrowTransform : public Proc::StateElementTransformer {
   Bits known_leading_;
 };
 
+// Struct which transforms a param into the concatenation of its live bit
+// ranges, dropping bits which no user observes.
+struct ProcStateDeadBitTransform : public Proc::StateElementTransformer {
+ public:
+  // `live_segments` holds the [start, start + width) runs of live bits of the
+  // original param, ordered LSB first.
+  ProcStateDeadBitTransform(
+      std::vector<std::pair<int64_t, int64_t>> live_segments,
+      int64_t orig_width)
+      : Proc::StateElementTransformer(),
+        live_segments_(std::move(live_segments)),
+        orig_width_(orig_width) {}
+
+  absl::StatusOr<Node*> TransformParamRead(Proc* proc, Param* new_param,
+                                           Param* old_param) final {
+    XLS_RET_CHECK_EQ(old_param->GetType()->GetFlatBitCount(), orig_width_);
+    // Rebuild a value of the original width by filling the dead gaps between
+    // live segments with zeros; by construction no user observes those bits.
+    std::vector<Node*> msb_to_lsb;
+    int64_t next_unfilled = orig_width_;
+    int64_t segment_offset = new_param->GetType()->GetFlatBitCount();
+    for (auto it = live_segments_.crbegin(); it != live_segments_.crend();
+         ++it) {
+      const auto& [start, width] = *it;
+      if (start + width < next_unfilled) {
+        XLS_ASSIGN_OR_RETURN(
+            Node * gap,
+            proc->MakeNode<Literal>(
+                old_param->loc(),
+                Value(UBits(0, next_unfilled - (start + width)))));
+        msb_to_lsb.push_back(gap);
+      }
+      segment_offset -= width;
+      XLS_ASSIGN_OR_RETURN(
+          Node * segment,
+          proc->MakeNode<BitSlice>(new_param->loc(), new_param,
+                                   /*start=*/segment_offset,
+                                   /*width=*/width));
+      msb_to_lsb.push_back(segment);
+      next_unfilled = start;
+    }
+    if (next_unfilled > 0) {
+      XLS_ASSIGN_OR_RETURN(
+          Node * gap, proc->MakeNode<Literal>(old_param->loc(),
+                                              Value(UBits(0, next_unfilled))));
+      msb_to_lsb.push_back(gap);
+    }
+    return proc->MakeNodeWithName<Concat>(
+        new_param->loc(), msb_to_lsb,
+        absl::StrFormat("expanded_%s", old_param->name()));
+  }
+
+  absl::StatusOr<Node*> TransformNextValue(Proc* proc, Param* new_param,
+                                           Next* old_next) final {
+    XLS_RET_CHECK_EQ(old_next->value()->GetType()->GetFlatBitCount(),
+                     orig_width_);
+    std::vector<Node*> msb_to_lsb;
+    for (auto it = live_segments_.crbegin(); it != live_segments_.crend();
+         ++it) {
+      const auto& [start, width] = *it;
+      XLS_ASSIGN_OR_RETURN(
+          Node * segment,
+          proc->MakeNode<BitSlice>(old_next->loc(), old_next->value(),
+                                   /*start=*/start, /*width=*/width));
+      msb_to_lsb.push_back(segment);
+    }
+    if (msb_to_lsb.size() == 1) {
+      return msb_to_lsb.front();
+    }
+    return proc->MakeNodeWithName<Concat>(
+        old_next->loc(), msb_to_lsb,
+        absl::StrFormat("compacted_for_%s", old_next->GetName()));
+  }
+
+ private:
+  std::vector<std::pair<int64_t, int64_t>> live_segments_;
+  int64_t orig_width_;
+};
+
+// Returns the set of bits of the bits-typed state param which some user may
+// observe, or std::nullopt if a user may observe every bit. Bits which only
+// feed identity updates of the param itself are not observable.
+std::optional<InlineBitmap> LiveBitsOfStateParam(Proc* proc, Param* param) {
+  int64_t width = param->BitCountOrDie();
+  InlineBitmap live(width);
+  for (Node* user : param->users()) {
+    if (user->Is<Next>() && user->As<Next>()->param() == param) {
+      Next* next = user->As<Next>();
+      if (next->predicate().has_value() && *next->predicate() == param) {
+        return std::nullopt;
+      }
+      // The param appearing as its own (possibly predicated) next value feeds
+      // each bit only back into itself, so it observes nothing new; any other
+      // value node is handled as a user of that node.
+      continue;
+    }
+    if (user->Is<BitSlice>()) {
+      BitSlice* slice = user->As<BitSlice>();
+      for (int64_t i = 0; i < slice->width(); ++i) {
+        live.Set(slice->start() + i, true);
+      }
+      continue;
+    }
+    // Any other user is conservatively assumed to observe every bit.
+    return std::nullopt;
+  }
+  return live;
+}
+
+// Shrinks bits-typed state elements to only the bits some user observes.
+// Wide elements produced by proc state flattening are often only partially
+// read; the unread ranges cost state registers and JIT state copies every
+// tick. Whole dead elements are left to ProcStateOptimizationPass.
+absl::StatusOr<bool> RemoveDeadStateBits(Proc* proc) {
+  struct ToTransform {
+    Param* param;
+    Value new_init_value;
+    ProcStateDeadBitTransform transformer;
+  };
+  std::vector<ToTransform> transforms;
+  for (Param* param : proc->StateParams()) {
+    if (!param->GetType()->IsBits() || proc->next_values(param).empty()) {
+      continue;
+    }
+    std::optional<InlineBitmap> live = LiveBitsOfStateParam(proc, param);
+    if (!live.has_value()) {
+      continue;
+    }
+    // Gather the contiguous runs of live bits, LSB first.
+    std::vector<std::pair<int64_t, int64_t>> segments;
+    int64_t width = param->BitCountOrDie();
+    int64_t live_count = 0;
+    for (int64_t i = 0; i < width; ++i) {
+      if (!live->Get(i)) {
+        continue;
+      }
+      ++live_count;
+      if (!segments.empty() &&
+          segments.back().first + segments.back().second == i) {
+        ++segments.back().second;
+      } else {
+        segments.push_back({i, 1});
+      }
+    }
+    if (live_count == width || live_count == 0) {
+      // Fully live, or fully dead (left for whole-element removal).
+      continue;
+    }
+    XLS_ASSIGN_OR_RETURN(Value init_value, proc->GetInitValue(param));
+    std::vector<Bits> init_segments_msb_to_lsb;
+    init_segments_msb_to_lsb.reserve(segments.size());
+    for (auto it = segments.crbegin(); it != segments.crend(); ++it) {
+      init_segments_msb_to_lsb.push_back(
+          init_value.bits().Slice(it->first, it->second));
+    }
+    VLOG(3) << absl::StrFormat(
+        "Narrowing state element `%s` from %d to %d observed bits",
+        param->GetName(), width, live_count);
+    transforms.push_back(
+        {.param = param,
+         .new_init_value = Value(bits_ops::Concat(init_segments_msb_to_lsb)),
+         .transformer = ProcStateDeadBitTransform(std::move(segments), width)});
+  }
+  bool changed = !transforms.empty();
+  for (auto t : std::move(transforms)) {
+    XLS_RETURN_IF_ERROR(
+        proc->TransformStateElement(t.param, t.new_init_value, t.transformer)
+            .status());
+  }
+  return changed;
+}
+
 class NarrowGivens final : public RangeDataProvider {
  public:
   NarrowGivens(absl::Span<Node* const> reverse_topo_sort, Node* target,
@@ -280,6 +455,11 @@ absl::StatusOr<bool> ProcStateNarrowingPass::RunOnProcInternal(
     made_changes = true;
   }
 
+  // With the known leading bits gone, drop any bits of the (possibly
+  // freshly-narrowed) state elements which no user observes.
+  XLS_ASSIGN_OR_RETURN(bool dead_bits_removed, RemoveDeadStateBits(proc));
+  made_changes = made_changes || dead_bits_removed;
+
   return made_changes;
 }
 
@@ -230,5 +230,37 @@ TEST_F(ProcStateNarrowingPassTest, MultiPath) {
                   AllOf(m::Param("the_state"), m::Type(p->GetBitsType(4)))));
 }
 
+TEST_F(ProcStateNarrowingPassTest, UnreadBitsRemoved) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto* out_chan,
+      p->CreateStreamingChannel("out_chan", ChannelOps::kSendOnly,
+                                p->GetBitsType(8)));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto* in_chan,
+      p->CreateStreamingChannel("in_chan", ChannelOps::kReceiveOnly,
+                                p->GetBitsType(32)));
+  ProcBuilder pb(TestName(), p.get());
+  auto state = pb.StateElement("the_state", UBits(0, 32));
+  // Only the middle byte of the state is ever observed; the rest of each
+  // received value is dead.
+  auto send_tok = pb.Send(out_chan, pb.Literal(Value::Token()),
+                          pb.BitSlice(state, 8, 8));
+  auto recv = pb.Receive(in_chan, send_tok);
+  pb.Next(state, pb.TupleIndex(recv, 1));
+
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build());
+
+  solvers::z3::ScopedVerifyProcEquivalence svpe(proc, /*activation_count=*/16,
+                                                /*include_state=*/false);
+  ScopedRecordIr sri(p.get());
+  EXPECT_THAT(RunPass(proc), IsOkAndHolds(true));
+  EXPECT_THAT(RunProcStateCleanup(proc), IsOkAndHolds(true));
+
+  EXPECT_THAT(proc->StateParams(),
+              UnorderedElementsAre(
+                  AllOf(m::Param("the_state"), m::Type(p->GetBitsType(8)))));
+}
+
 }  // namespace
 }  // namespace xls
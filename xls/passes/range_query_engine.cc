@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
@@ -48,6 +49,7 @@
 #include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
 #include "xls/ir/ternary.h"
+#include "xls/ir/topo_sort.h"
 #include "xls/ir/type.h"
 #include "xls/ir/value.h"
 #include "xls/ir/value_utils.h"
@@ -302,6 +304,85 @@ absl::StatusOr<ReachedFixpoint> RangeQueryEngine::PopulateWithGivens(
   return visitor.GetReachedFixpoint();
 }
 
+namespace {
+
+// Restricts iteration to the not-yet-computed part of the cone of influence
+// of a set of queried nodes. Nodes outside the cone are not visited at all;
+// their previously computed results are read directly out of the engine's maps
+// by the visitor's handlers, so no givens are needed.
+class ConeOfInfluenceProvider final : public RangeDataProvider {
+ public:
+  ConeOfInfluenceProvider(FunctionBase* f, absl::Span<Node* const> queried,
+                          const absl::flat_hash_set<Node*>& computed)
+      : function_(f) {
+    std::vector<Node*> worklist(queried.begin(), queried.end());
+    while (!worklist.empty()) {
+      Node* node = worklist.back();
+      worklist.pop_back();
+      if (computed.contains(node) || !cone_.insert(node).second) {
+        continue;
+      }
+      for (Node* operand : node->operands()) {
+        worklist.push_back(operand);
+      }
+    }
+  }
+
+  std::optional<RangeData> GetKnownIntervals(Node* node) override {
+    return std::nullopt;
+  }
+
+  absl::Status IterateFunction(DfsVisitor* visitor) override {
+    for (Node* node : TopoSort(function_)) {
+      if (cone_.contains(node)) {
+        XLS_RETURN_IF_ERROR(node->VisitSingleNode(visitor));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  const absl::flat_hash_set<Node*>& cone() const { return cone_; }
+
+ private:
+  FunctionBase* function_;
+  absl::flat_hash_set<Node*> cone_;
+};
+
+}  // namespace
+
+absl::StatusOr<ReachedFixpoint> RangeQueryEngine::PopulateForNodes(
+    FunctionBase* f, absl::Span<Node* const> nodes) {
+  ConeOfInfluenceProvider provider(f, nodes, computed_);
+  if (provider.cone().empty()) {
+    // Everything queried is already cached.
+    return ReachedFixpoint::Unchanged;
+  }
+  XLS_ASSIGN_OR_RETURN(ReachedFixpoint rf, PopulateWithGivens(provider));
+  computed_.insert(provider.cone().begin(), provider.cone().end());
+  return rf;
+}
+
+void RangeQueryEngine::Invalidate(Node* node) {
+  // Drop the node and its entire forward closure; anything downstream may have
+  // been derived from the invalidated value.
+  std::vector<Node*> worklist = {node};
+  absl::flat_hash_set<Node*> invalidated;
+  while (!worklist.empty()) {
+    Node* stale = worklist.back();
+    worklist.pop_back();
+    if (!invalidated.insert(stale).second) {
+      continue;
+    }
+    known_bits_.erase(stale);
+    known_bit_values_.erase(stale);
+    interval_sets_.erase(stale);
+    computed_.erase(stale);
+    for (Node* user : stale->users()) {
+      worklist.push_back(user);
+    }
+  }
+}
+
 IntervalSetTree RangeQueryEngine::GetIntervalSetTree(Node* node) const {
   if (interval_sets_.contains(node)) {
     return interval_sets_.at(node);
@@ -319,7 +400,7 @@ void RangeQueryEngine::SetIntervalSetTree(
     leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
         ist, interval_sets.AsView(),
         [](IntervalSet& lhs, const IntervalSet& rhs) {
-          lhs = IntervalSet::Intersect(lhs, rhs);
+          lhs.IntersectWith(rhs);
         });
   }
 
@@ -341,7 +422,7 @@ void RangeQueryEngine::SetIntervalSetTree(Node* node,
     leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
         ist, interval_sets.AsView(),
         [](IntervalSet& lhs, const IntervalSet& rhs) {
-          lhs = IntervalSet::Intersect(lhs, rhs);
+          lhs.IntersectWith(rhs);
         });
   }
 
@@ -551,9 +632,8 @@ absl::Status RangeQueryVisitor::HandleEq(CompareOp* eq) {
 
   IntervalSet res(/*bit_count=*/1);
   for (int64_t i = 0; i < lhs_intervals->size(); ++i) {
-    res = IntervalSet::Combine(res,
-                               interval_ops::Eq(lhs_intervals->elements()[i],
-                                                rhs_intervals->elements()[i]));
+    res.UnionWith(interval_ops::Eq(lhs_intervals->elements()[i],
+                                  rhs_intervals->elements()[i]));
   }
   return SetIntervalSet(eq, std::move(res));
 }
@@ -707,7 +787,7 @@ absl::Status RangeQueryVisitor::HandleArrayIndex(ArrayIndex* array_index) {
     leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
         result.AsMutableView(), array_interval_set_tree->AsView(indexes),
         [](IntervalSet& lhs, const IntervalSet& rhs) {
-          lhs = IntervalSet::Combine(lhs, rhs);
+          lhs.UnionWith(rhs);
         });
     return false;
   });
@@ -750,7 +830,7 @@ absl::Status RangeQueryVisitor::HandleArraySlice(ArraySlice* slice) {
     leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
         result.AsMutableView(), slice_ltt->AsView(),
         [](IntervalSet& lhs, const IntervalSet& rhs) {
-          lhs = IntervalSet::Combine(lhs, rhs);
+          lhs.UnionWith(rhs);
         });
     return start >= slice->array()->GetType()->AsArrayOrDie()->size();
   });
@@ -860,7 +940,7 @@ absl::Status RangeQueryVisitor::HandleArrayUpdate(ArrayUpdate* update) {
             leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
                 element_tree, update_value->AsView(),
                 [](IntervalSet& lhs, const IntervalSet& rhs) {
-                  lhs = IntervalSet::Combine(lhs, rhs);
+                  lhs.UnionWith(rhs);
                 });
           } else {
             // The update value is unconstrained, so remove all constraints on
@@ -948,9 +1028,8 @@ absl::Status RangeQueryVisitor::HandleNe(CompareOp* ne) {
 
   IntervalSet res(/*bit_count=*/1);
   for (int64_t i = 0; i < lhs_intervals->size(); ++i) {
-    res = IntervalSet::Combine(res,
-                               interval_ops::Ne(lhs_intervals->elements()[i],
-                                                rhs_intervals->elements()[i]));
+    res.UnionWith(interval_ops::Ne(lhs_intervals->elements()[i],
+                                  rhs_intervals->elements()[i]));
   }
   return SetIntervalSet(ne, std::move(res));
 }
@@ -1071,7 +1150,7 @@ absl::Status RangeQueryVisitor::HandlePrioritySel(PrioritySelect* sel) {
       leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
           result.AsMutableView(), *case_i,
           [](IntervalSet& lhs, const IntervalSet& rhs) {
-            lhs = IntervalSet::Combine(lhs, rhs);
+            lhs.UnionWith(rhs);
           });
     }
   }
@@ -1214,7 +1293,7 @@ absl::Status RangeQueryVisitor::HandleSel(Select* sel) {
     leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
         result.AsMutableView(), *selected_case,
         [](IntervalSet& lhs, const IntervalSet& rhs) {
-          lhs = IntervalSet::Combine(lhs, rhs);
+          lhs.UnionWith(rhs);
         });
     return finished;
   });
@@ -22,6 +22,8 @@
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
@@ -122,6 +124,19 @@ class RangeQueryEngine : public QueryEngine {
   // std::nullopt and `ShouldContinue` always returns true)
   absl::StatusOr<ReachedFixpoint> PopulateWithGivens(RangeDataProvider& givens);
 
+  // Populate the data for just the cone of influence of `nodes` in `f`,
+  // reusing results cached by earlier `PopulateForNodes` calls. Together with
+  // `Invalidate` this supports demand-driven use where only the nodes a pass
+  // actually queries (plus anything invalidated by graph mutations since the
+  // last call) are ever analyzed.
+  absl::StatusOr<ReachedFixpoint> PopulateForNodes(FunctionBase* f,
+                                                   absl::Span<Node* const> nodes);
+
+  // Drops the cached analysis for `node` and everything depending on it so
+  // that a later `PopulateForNodes` call recomputes just the stale region.
+  // Should be called when a pass changes `node`'s operands or semantics.
+  void Invalidate(Node* node);
+
   bool IsTracked(Node* node) const override {
     return known_bits_.contains(node);
   }
@@ -240,6 +255,97 @@ class RangeQueryEngine : public QueryEngine {
   absl::flat_hash_map<Node*, Bits> known_bits_;
   absl::flat_hash_map<Node*, Bits> known_bit_values_;
   absl::flat_hash_map<Node*, IntervalSetTree> interval_sets_;
+  // Nodes whose cached results `PopulateForNodes` may reuse. Only maintained
+  // by the demand-driven entry points; a full `Populate` run does not need it.
+  absl::flat_hash_set<Node*> computed_;
+};
+
+// A demand-driven wrapper around `RangeQueryEngine`. `Populate` records the
+// function but computes nothing; each query analyzes (and caches) just the
+// cone of influence of the queried node. Passes that mutate the graph must
+// call `Invalidate` on changed nodes to keep subsequent queries sound. Useful
+// for passes like narrowing which query only a small subset of the function:
+// range analysis is rerun several times per pipeline and mostly computes data
+// nobody reads when run eagerly.
+class LazyRangeQueryEngine : public QueryEngine {
+ public:
+  absl::StatusOr<ReachedFixpoint> Populate(FunctionBase* f) override {
+    function_ = f;
+    engine_ = RangeQueryEngine();
+    return ReachedFixpoint::Changed;
+  }
+
+  // Drops cached results for `node` and its transitive users.
+  void Invalidate(Node* node) { engine_.Invalidate(node); }
+
+  bool IsTracked(Node* node) const override {
+    EnsureAnalyzed(node);
+    return engine_.IsTracked(node);
+  }
+
+  LeafTypeTree<TernaryVector> GetTernary(Node* node) const override {
+    EnsureAnalyzed(node);
+    return engine_.GetTernary(node);
+  }
+
+  LeafTypeTree<IntervalSet> GetIntervals(Node* node) const override {
+    EnsureAnalyzed(node);
+    return engine_.GetIntervals(node);
+  }
+
+  bool AtMostOneTrue(absl::Span<TreeBitLocation const> bits) const override {
+    EnsureAnalyzedAll(bits);
+    return engine_.AtMostOneTrue(bits);
+  }
+
+  bool AtLeastOneTrue(absl::Span<TreeBitLocation const> bits) const override {
+    EnsureAnalyzedAll(bits);
+    return engine_.AtLeastOneTrue(bits);
+  }
+
+  bool KnownEquals(const TreeBitLocation& a,
+                   const TreeBitLocation& b) const override {
+    EnsureAnalyzed(a.node());
+    EnsureAnalyzed(b.node());
+    return engine_.KnownEquals(a, b);
+  }
+
+  bool KnownNotEquals(const TreeBitLocation& a,
+                      const TreeBitLocation& b) const override {
+    EnsureAnalyzed(a.node());
+    EnsureAnalyzed(b.node());
+    return engine_.KnownNotEquals(a, b);
+  }
+
+  bool Implies(const TreeBitLocation& a,
+               const TreeBitLocation& b) const override {
+    return false;
+  }
+
+  std::optional<Bits> ImpliedNodeValue(
+      absl::Span<const std::pair<TreeBitLocation, bool>> predicate_bit_values,
+      Node* node) const override {
+    return std::nullopt;
+  }
+
+ private:
+  // Makes sure `node`'s cone of influence has been analyzed. Analysis only
+  // fails on malformed IR so failure is fatal here.
+  void EnsureAnalyzed(Node* node) const {
+    if (function_ == nullptr) {
+      return;
+    }
+    CHECK_OK(engine_.PopulateForNodes(function_, {node}).status());
+  }
+
+  void EnsureAnalyzedAll(absl::Span<TreeBitLocation const> bits) const {
+    for (const TreeBitLocation& location : bits) {
+      EnsureAnalyzed(location.node());
+    }
+  }
+
+  FunctionBase* function_ = nullptr;
+  mutable RangeQueryEngine engine_;
 };
 
 std::string IntervalSetTreeToString(const IntervalSetTree& tree);
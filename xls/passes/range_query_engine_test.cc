@@ -2259,6 +2259,54 @@ TEST_F(RangeQueryEngineTest, EarlyBailout) {
             BitsLTT(xy.node(), {Interval(UBits(110, 10), UBits(220, 10))}));
 }
 
+TEST_F(RangeQueryEngineTest, PopulateForNodesOnlyAnalyzesCone) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue other = fb.Not(x);
+  BValue l5 = fb.Literal(UBits(5, 8));
+  BValue l7 = fb.Literal(UBits(7, 8));
+  BValue l9 = fb.Literal(UBits(9, 8));
+  BValue sum = fb.Add(l5, l7);
+  fb.Tuple({sum, other});
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  RangeQueryEngine engine;
+  XLS_ASSERT_OK(engine.PopulateForNodes(f, {sum.node()}));
+  EXPECT_EQ(engine.GetIntervalSetTree(sum.node()),
+            BitsLTT(sum.node(), {Interval::Precise(UBits(12, 8))}));
+  // Nodes outside the queried cone are never analyzed.
+  EXPECT_FALSE(engine.HasExplicitIntervals(other.node()));
+
+  // After a mutation and invalidation only the stale region is recomputed.
+  XLS_ASSERT_OK(sum.node()->ReplaceOperandNumber(1, l9.node()));
+  engine.Invalidate(sum.node());
+  EXPECT_FALSE(engine.HasExplicitIntervals(sum.node()));
+  XLS_ASSERT_OK(engine.PopulateForNodes(f, {sum.node()}));
+  EXPECT_EQ(engine.GetIntervalSetTree(sum.node()),
+            BitsLTT(sum.node(), {Interval::Precise(UBits(14, 8))}));
+}
+
+TEST_F(RangeQueryEngineTest, LazyEngineComputesOnDemand) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue l5 = fb.Literal(UBits(5, 8));
+  BValue l7 = fb.Literal(UBits(7, 8));
+  BValue l9 = fb.Literal(UBits(9, 8));
+  BValue sum = fb.Add(l5, l7);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  LazyRangeQueryEngine engine;
+  XLS_ASSERT_OK(engine.Populate(f));
+  EXPECT_EQ(engine.GetIntervals(sum.node()).Get({}),
+            IntervalSet::Precise(UBits(12, 8)));
+
+  XLS_ASSERT_OK(sum.node()->ReplaceOperandNumber(1, l9.node()));
+  engine.Invalidate(sum.node());
+  EXPECT_EQ(engine.GetIntervals(sum.node()).Get({}),
+            IntervalSet::Precise(UBits(14, 8)));
+}
+
 template <typename FKnown>
 class LambdaRangeGivens : public RangeDataProvider {
  public:
@@ -0,0 +1,119 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/rewrite_rule_set.h"
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/op.h"
+
+namespace xls {
+
+RewriteRuleSet::RewriteRuleSet(std::vector<RewriteRule> rules)
+    : rules_(std::move(rules)), rule_indices_by_op_(kOpLimit) {
+  for (int64_t i = 0; i < static_cast<int64_t>(rules_.size()); ++i) {
+    for (Op op : rules_[i].ops) {
+      rule_indices_by_op_[static_cast<int64_t>(op)].push_back(i);
+    }
+  }
+}
+
+absl::StatusOr<bool> RewriteRuleSet::RewriteNode(Node* node) const {
+  for (int64_t rule_index :
+       rule_indices_by_op_[static_cast<int64_t>(node->op())]) {
+    const RewriteRule& rule = rules_[rule_index];
+    XLS_ASSIGN_OR_RETURN(bool node_changed, rule.rewrite(node));
+    if (node_changed) {
+      VLOG(3) << "Rewrite rule fired: " << rule.name << " on "
+              << node->GetName();
+      return true;
+    }
+  }
+  return false;
+}
+
+absl::StatusOr<bool> RewriteRuleSet::RunToFixedPoint(FunctionBase* f) const {
+  bool changed = false;
+
+  // Worklist of node ids; ids are stable across rewrites while Node pointers
+  // of removed nodes may be reused.
+  std::deque<int64_t> worklist;
+  absl::flat_hash_set<int64_t> in_worklist;
+  auto enqueue = [&](int64_t id) {
+    if (in_worklist.insert(id).second) {
+      worklist.push_back(id);
+    }
+  };
+  for (Node* node : f->GetCachedTopoSort()) {
+    enqueue(node->id());
+  }
+
+  // Once a node has been rewritten and become dead it is not revisited, to
+  // avoid endlessly resimplifying dead cones.
+  absl::flat_hash_set<int64_t> rewritten_node_ids;
+
+  while (!worklist.empty()) {
+    int64_t id = worklist.front();
+    worklist.pop_front();
+    in_worklist.erase(id);
+
+    Node* node = f->GetNodeById(id);
+    if (node == nullptr) {
+      continue;
+    }
+    if (node->IsDead() && rewritten_node_ids.contains(id)) {
+      continue;
+    }
+
+    int64_t version_before = f->transform_version();
+    XLS_ASSIGN_OR_RETURN(bool node_changed, RewriteNode(node));
+    if (!node_changed) {
+      continue;
+    }
+    changed = true;
+    rewritten_node_ids.insert(id);
+
+    std::optional<std::vector<int64_t>> changed_ids =
+        f->ChangedNodeIdsSince(version_before);
+    if (!changed_ids.has_value()) {
+      // The change journal was truncated; conservatively revisit every node.
+      for (Node* n : f->GetCachedTopoSort()) {
+        enqueue(n->id());
+      }
+      continue;
+    }
+    for (int64_t changed_id : *changed_ids) {
+      enqueue(changed_id);
+      if (Node* changed_node = f->GetNodeById(changed_id);
+          changed_node != nullptr) {
+        for (Node* user : changed_node->users()) {
+          enqueue(user->id());
+        }
+      }
+    }
+  }
+  return changed;
+}
+
+}  // namespace xls
@@ -0,0 +1,79 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PASSES_REWRITE_RULE_SET_H_
+#define XLS_PASSES_REWRITE_RULE_SET_H_
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/op.h"
+
+namespace xls {
+
+// A single peephole rewrite rule. The rule's function is only invoked on
+// nodes whose op is one of `ops`; it performs any further matching itself and
+// applies the rewrite (typically via Node::ReplaceUsesWith or
+// Node::ReplaceUsesWithNew), returning true iff the IR was modified.
+struct RewriteRule {
+  // Used in logging when the rule fires.
+  std::string_view name;
+
+  // The opcodes the rule can apply to.
+  std::vector<Op> ops;
+
+  absl::StatusOr<bool> (*rewrite)(Node*);
+};
+
+// An opcode-indexed dispatch table of peephole rewrite rules. Rules from one
+// or more simplification passes are compiled once into a table keyed on Op so
+// that visiting a node only evaluates the rules which can possibly apply to
+// it, and a whole rule set is driven to fixed point with a single worklist
+// traversal rather than one full-function sweep per rule.
+//
+// Rule sets are immutable once constructed and are typically built once into
+// a function-local static and shared by all invocations of a pass.
+class RewriteRuleSet {
+ public:
+  explicit RewriteRuleSet(std::vector<RewriteRule> rules);
+
+  // Runs the rules registered for node->op() against `node` in registration
+  // order, stopping at the first rule which modifies the IR. Returns true iff
+  // the IR was modified. `node` may be left without users (dead) by a firing
+  // rule but is never removed from the function.
+  absl::StatusOr<bool> RewriteNode(Node* node) const;
+
+  // Applies the rule set to every node of `f` and propagates rewrites via a
+  // worklist until no rule fires. Nodes affected by a rewrite are discovered
+  // through the FunctionBase change journal
+  // (FunctionBase::ChangedNodeIdsSince); if the journal has been truncated the
+  // whole function is conservatively revisited. Returns true iff the IR was
+  // modified.
+  absl::StatusOr<bool> RunToFixedPoint(FunctionBase* f) const;
+
+ private:
+  std::vector<RewriteRule> rules_;
+
+  // Indices into `rules_` of the rules registered for each opcode, in
+  // registration order, indexed by the opcode's integer value.
+  std::vector<std::vector<int64_t>> rule_indices_by_op_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_PASSES_REWRITE_RULE_SET_H_
@@ -0,0 +1,97 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/passes/rewrite_rule_set.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/matchers.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_matcher.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/op.h"
+
+namespace m = ::xls::op_matchers;
+
+namespace xls {
+namespace {
+
+using status_testing::IsOkAndHolds;
+
+// not(not(x)) => x
+absl::StatusOr<bool> RewriteDoubleNot(Node* n) {
+  if (n->operand(0)->op() == Op::kNot) {
+    XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)->operand(0)));
+    return true;
+  }
+  return false;
+}
+
+// neg(x) => x (nonsense rule; used to verify dispatch by op).
+absl::StatusOr<bool> RewriteNegToIdentity(Node* n) {
+  XLS_RETURN_IF_ERROR(n->ReplaceUsesWith(n->operand(0)));
+  return true;
+}
+
+RewriteRuleSet TestRules() {
+  return RewriteRuleSet({
+      {"double-not", {Op::kNot}, &RewriteDoubleNot},
+      {"neg-to-identity", {Op::kNeg}, &RewriteNegToIdentity},
+  });
+}
+
+class RewriteRuleSetTest : public IrTestBase {};
+
+TEST_F(RewriteRuleSetTest, RewriteNodeDispatchesByOp) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(8));
+  auto not1 = fb.Not(x);
+  auto not2 = fb.Not(not1);
+  auto rev = fb.Reverse(not2);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  (void)rev;
+
+  RewriteRuleSet rules = TestRules();
+  // No rule is registered for reverse, so nothing is evaluated.
+  EXPECT_THAT(rules.RewriteNode(f->return_value()), IsOkAndHolds(false));
+  // The outer not matches the double-not rule.
+  EXPECT_THAT(rules.RewriteNode(not2.node()), IsOkAndHolds(true));
+  EXPECT_THAT(f->return_value(), m::Reverse(m::Param("x")));
+}
+
+TEST_F(RewriteRuleSetTest, RunToFixedPointPropagatesRewrites) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(8));
+  // A chain of four nots collapses to the parameter only if rewrites are
+  // reapplied to nodes affected by earlier rewrites.
+  auto chain = fb.Not(fb.Not(fb.Not(fb.Not(x))));
+  auto neg = fb.Negate(chain);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  (void)neg;
+
+  RewriteRuleSet rules = TestRules();
+  EXPECT_THAT(rules.RunToFixedPoint(f), IsOkAndHolds(true));
+  EXPECT_THAT(f->return_value(), m::Param("x"));
+  // A second run is a no-op.
+  EXPECT_THAT(rules.RunToFixedPoint(f), IsOkAndHolds(false));
+}
+
+}  // namespace
+}  // namespace xls
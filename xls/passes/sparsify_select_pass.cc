@@ -16,9 +16,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <tuple>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "xls/common/status/status_macros.h"
@@ -34,10 +37,27 @@
 #include "xls/passes/optimization_pass.h"
 #include "xls/passes/optimization_pass_registry.h"
 #include "xls/passes/pass_base.h"
+#include "xls/passes/query_engine.h"
 #include "xls/passes/range_query_engine.h"
 
 namespace xls {
 
+// Decode logic built to test whether a selector is within an interval.
+// Selects with the same selector are often guaranteed to be in the same
+// intervals (e.g. multiple lookup tables indexed by one narrow counter), so
+// the subtract/compare nodes are cached per (selector, interval) and reused
+// instead of growing a redundant comparator tree per select for later passes
+// to fold away.
+struct IntervalDecode {
+  Node* lower_bound = nullptr;
+  Node* upper_bound = nullptr;
+  Node* selector_minus_lower_bound = nullptr;
+  // Created on first use by a non-leaf link of a select chain.
+  Node* is_in_range = nullptr;
+};
+using IntervalDecodeCache =
+    absl::flat_hash_map<std::tuple<Node*, Bits, Bits>, IntervalDecode>;
+
 // Returns a vector of the intervals contained within the given `IntervalSet`,
 // sorted from smallest to largest in terms of number of points covered.
 static std::vector<Interval> IntervalsSortedBySize(IntervalSet set) {
@@ -66,7 +86,8 @@ static std::vector<Interval> IntervalsSortedBySize(IntervalSet set) {
 // TODO(taktoa): build a binary search tree based on interval lower bounds
 // rather than a linear chain.
 static absl::Status SparsifySelect(FunctionBase* f, Select* select,
-                                   const IntervalSet& selector_intervals) {
+                                   const IntervalSet& selector_intervals,
+                                   IntervalDecodeCache* decode_cache) {
   // As we build up the select chain, this represents the rest of the chain,
   // i.e.: what we should use when the current select we are adding is false.
   Node* other = nullptr;
@@ -103,15 +124,20 @@ static absl::Status SparsifySelect(FunctionBase* f, Select* select,
       XLS_RETURN_IF_ERROR(failure);
     }
 
-    XLS_ASSIGN_OR_RETURN(
-        Node * lower_bound,
-        f->MakeNode<Literal>(select->loc(), Value(interval.LowerBound())));
-    XLS_ASSIGN_OR_RETURN(
-        Node * upper_bound,
-        f->MakeNode<Literal>(select->loc(), Value(interval.UpperBound())));
-    XLS_ASSIGN_OR_RETURN(Node * selector_minus_lower_bound,
-                         f->MakeNode<BinOp>(select->loc(), select->selector(),
-                                            lower_bound, Op::kSub));
+    IntervalDecode& decode = (*decode_cache)[std::make_tuple(
+        select->selector(), interval.LowerBound(), interval.UpperBound())];
+    if (decode.selector_minus_lower_bound == nullptr) {
+      XLS_ASSIGN_OR_RETURN(
+          decode.lower_bound,
+          f->MakeNode<Literal>(select->loc(), Value(interval.LowerBound())));
+      XLS_ASSIGN_OR_RETURN(
+          decode.upper_bound,
+          f->MakeNode<Literal>(select->loc(), Value(interval.UpperBound())));
+      XLS_ASSIGN_OR_RETURN(
+          decode.selector_minus_lower_bound,
+          f->MakeNode<BinOp>(select->loc(), select->selector(),
+                             decode.lower_bound, Op::kSub));
+    }
 
     // TODO(taktoa): would be good to use assume(false) here instead of 0
     XLS_ASSIGN_OR_RETURN(
@@ -120,28 +146,31 @@ static absl::Status SparsifySelect(FunctionBase* f, Select* select,
 
     XLS_ASSIGN_OR_RETURN(
         Node * if_in_range,
-        f->MakeNode<Select>(select->loc(), selector_minus_lower_bound,
+        f->MakeNode<Select>(select->loc(), decode.selector_minus_lower_bound,
                             cases_in_range, /*default_value=*/zero));
 
     if (is_leaf) {
       other = if_in_range;
     } else {
-      XLS_ASSIGN_OR_RETURN(
-          Node * ge_lower_bound,
-          f->MakeNode<CompareOp>(select->loc(), select->selector(), lower_bound,
-                                 Op::kUGe));
-      XLS_ASSIGN_OR_RETURN(
-          Node * le_upper_bound,
-          f->MakeNode<CompareOp>(select->loc(), select->selector(), upper_bound,
-                                 Op::kULe));
-      XLS_ASSIGN_OR_RETURN(
-          Node * is_in_range,
-          f->MakeNode<NaryOp>(
-              select->loc(),
-              std::vector<Node*>({ge_lower_bound, le_upper_bound}), Op::kAnd));
+      if (decode.is_in_range == nullptr) {
+        XLS_ASSIGN_OR_RETURN(
+            Node * ge_lower_bound,
+            f->MakeNode<CompareOp>(select->loc(), select->selector(),
+                                   decode.lower_bound, Op::kUGe));
+        XLS_ASSIGN_OR_RETURN(
+            Node * le_upper_bound,
+            f->MakeNode<CompareOp>(select->loc(), select->selector(),
+                                   decode.upper_bound, Op::kULe));
+        XLS_ASSIGN_OR_RETURN(
+            decode.is_in_range,
+            f->MakeNode<NaryOp>(
+                select->loc(),
+                std::vector<Node*>({ge_lower_bound, le_upper_bound}),
+                Op::kAnd));
+      }
 
       XLS_ASSIGN_OR_RETURN(
-          other, f->MakeNode<Select>(select->loc(), is_in_range,
+          other, f->MakeNode<Select>(select->loc(), decode.is_in_range,
                                      std::vector<Node*>({other, if_in_range}),
                                      /*default_value=*/std::nullopt));
     }
@@ -156,29 +185,57 @@ static absl::Status SparsifySelect(FunctionBase* f, Select* select,
   return absl::OkStatus();
 }
 
+// Returns true if sparsifying `select` is expected to shrink the function.
+// Sparsification trades an n-case select for a chain of interval decodes and
+// small dispatch selects; every interval costs a handful of decode nodes, so
+// when range analysis removes only a few cases the rewrite is a net growth
+// which later passes must spend time folding away again. Require the
+// reachable values to cover at most half of the cases so the decode overhead
+// is amortized by the removed select arms.
+static bool SparsificationProfitable(Select* select,
+                                     const IntervalSet& selector_intervals) {
+  std::optional<int64_t> size = selector_intervals.Size();
+  if (!size.has_value()) {
+    return false;
+  }
+  return 2 * *size <= static_cast<int64_t>(select->cases().size());
+}
+
 absl::StatusOr<bool> SparsifySelectPass::RunOnFunctionBaseInternal(
     FunctionBase* f, const OptimizationPassOptions& options,
     PassResults* results) const {
-  RangeQueryEngine engine;
-  XLS_RETURN_IF_ERROR(engine.Populate(f).status());
+  // Reuse a range analysis populated by an earlier pass where possible. The
+  // analysis cache is not thread-safe, so construct the engine locally when
+  // FunctionBases are processed concurrently.
+  QueryEngine* engine = nullptr;
+  std::unique_ptr<RangeQueryEngine> local_engine;
+  if (options.worker_count == 1) {
+    XLS_ASSIGN_OR_RETURN(
+        engine,
+        results->analysis_cache.GetEngine(
+            "range", f, []() -> absl::StatusOr<std::unique_ptr<QueryEngine>> {
+              return std::make_unique<RangeQueryEngine>();
+            }));
+  } else {
+    local_engine = std::make_unique<RangeQueryEngine>();
+    XLS_RETURN_IF_ERROR(local_engine->Populate(f).status());
+    engine = local_engine.get();
+  }
 
   bool changed = false;
+  IntervalDecodeCache decode_cache;
   for (Node* node : TopoSort(f)) {
     if (node->Is<Select>()) {
       Select* select = node->As<Select>();
       Node* selector = select->selector();
-      IntervalSetTree selector_ist = engine.GetIntervalSetTree(selector);
-      IntervalSet selector_intervals = selector_ist.Get({});
-      if (std::optional<int64_t> size = selector_intervals.Size()) {
-        if (size >= select->cases().size()) {
-          continue;
-        }
-      } else {
+      IntervalSet selector_intervals = engine->GetIntervals(selector).Get({});
+      if (!SparsificationProfitable(select, selector_intervals)) {
         continue;
       }
 
       changed = true;
-      XLS_RETURN_IF_ERROR(SparsifySelect(f, select, selector_intervals));
+      XLS_RETURN_IF_ERROR(
+          SparsifySelect(f, select, selector_intervals, &decode_cache));
     }
   }
 
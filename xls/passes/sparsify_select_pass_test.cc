@@ -15,6 +15,7 @@
 #include "xls/passes/sparsify_select_pass.h"
 
 #include <cstdint>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -26,6 +27,8 @@
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_matcher.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/op.h"
 #include "xls/ir/value.h"
 #include "xls/passes/dce_pass.h"
 #include "xls/passes/optimization_pass.h"
@@ -388,5 +391,55 @@ TEST_F(SparsifySelectPassTest, DefaultValue) {
                                /*default_value=*/m::Literal("bits[4]:0"))}));
 }
 
+TEST_F(SparsifySelectPassTest, UnprofitableSelectNotSparsified) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(2));
+  auto x_big = fb.ZeroExtend(x, 3);
+  std::vector<BValue> cases;
+  for (int64_t i = 0; i < 6; ++i) {
+    cases.push_back(fb.Literal(UBits(i, 4)));
+  }
+  fb.Select(x_big, cases, /*default_value=*/fb.Literal(UBits(0, 4)));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  // Range analysis only removes two of the six cases; the interval decode
+  // chain would outweigh the removed select arms.
+  EXPECT_THAT(Run(f), IsOkAndHolds(false));
+}
+
+TEST_F(SparsifySelectPassTest, DecodeSharedAcrossSelects) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(1));
+  auto x_big = fb.ZeroExtend(x, 3);
+  std::vector<BValue> lhs_cases;
+  std::vector<BValue> rhs_cases;
+  for (int64_t i = 0; i < 8; ++i) {
+    lhs_cases.push_back(fb.Literal(UBits(i, 4)));
+    rhs_cases.push_back(fb.Literal(UBits(i + 8, 4)));
+  }
+  fb.Add(fb.Select(x_big, lhs_cases), fb.Select(x_big, rhs_cases));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+  EXPECT_THAT(Run(f), IsOkAndHolds(true));
+
+  // Both selects share the same selector and guaranteed interval, so the
+  // rewrite emits a single subtract feeding both dispatch selects.
+  int64_t sub_count = 0;
+  for (Node* node : f->nodes()) {
+    if (node->op() == Op::kSub) {
+      ++sub_count;
+    }
+  }
+  EXPECT_EQ(sub_count, 1);
+  EXPECT_THAT(
+      f->return_value(),
+      m::Add(m::Select(m::Sub(x_big.node(), m::Literal(UBits(0, 3))),
+                       {m::Literal(UBits(0, 4)), m::Literal(UBits(1, 4))},
+                       m::Literal(UBits(0, 4))),
+             m::Select(m::Sub(x_big.node(), m::Literal(UBits(0, 3))),
+                       {m::Literal(UBits(8, 4)), m::Literal(UBits(9, 4))},
+                       m::Literal(UBits(0, 4)))));
+}
+
 }  // namespace
 }  // namespace xls
@@ -33,6 +33,7 @@
 #include "xls/ir/node_util.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/op.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/topo_sort.h"
 #include "xls/ir/value.h"
 #include "xls/passes/optimization_pass.h"
@@ -280,6 +281,114 @@ absl::StatusOr<std::optional<Value>> LinksToTable(
   return std::nullopt;
 }
 
+// Returns the index of the longest suffix links[j..] which LinksToTable() can
+// convert into a table, or std::nullopt if there is none. This mirrors the
+// per-head behavior of the main loop - the head of links[j..] would be
+// considered as a chain head of its own once the full chain fails - but
+// evaluates every suffix in one pass over the chain instead of re-walking
+// each one, which kept the pass quadratic on long chains. Suffixes whose head
+// is in `ineligible` (already transformed) and suffixes shorter than three
+// links are skipped.
+std::optional<int64_t> FindTableSuffix(
+    absl::Span<const Link> links,
+    const absl::flat_hash_set<Node*>& ineligible) {
+  int64_t index_width = links.front().index->GetType()->GetFlatBitCount();
+  std::optional<uint64_t> index_space_size = std::nullopt;
+  if (index_width < 63) {
+    index_space_size = uint64_t{1} << index_width;
+  }
+  const bool else_is_literal = links.back().next->Is<Literal>();
+
+  // Walk the chain from the top down, growing the key set of the current
+  // suffix. The set of keys of links[j..] does not depend on which duplicate
+  // wins, so the density conditions of LinksToTable() can be evaluated in
+  // O(1) per suffix.
+  absl::flat_hash_set<uint64_t> keys;
+  uint64_t max_key = 0;
+  std::optional<int64_t> best;
+  for (int64_t j = links.size() - 1; j >= 0; --j) {
+    keys.insert(links[j].key);
+    max_key = std::max(max_key, links[j].key);
+    if (static_cast<int64_t>(links.size()) - j <= 2) {
+      // Chain is too short.
+      continue;
+    }
+    if (ineligible.contains(links[j].node)) {
+      continue;
+    }
+    const uint64_t size = keys.size();
+    bool convertible = false;
+    if (index_space_size.has_value() && size == index_space_size.value()) {
+      // The suffix covers the entire index space.
+      convertible = true;
+    } else if (else_is_literal) {
+      // There are holes, but most of the index space is covered...
+      convertible = (index_space_size.has_value() &&
+                     size < index_space_size.value() &&
+                     size * 2 > index_space_size.value()) ||
+                    // ... or the keys are dense from zero on up.
+                    size == max_key + 1;
+    }
+    if (convertible) {
+      best = j;
+    }
+  }
+  return best;
+}
+
+// One entry of a sparse lookup table: `value` is selected when the index
+// equals `key`.
+struct TableEntry {
+  uint64_t key;
+  Value value;
+};
+
+// Minimum chain length at which a chain that cannot be represented as a dense
+// table is lowered to a balanced binary search over its keys. Short chains
+// are left alone; the select tree only pays off once it meaningfully reduces
+// logic depth.
+constexpr int64_t kMinBinarySearchChainLength = 8;
+
+// Builds a balanced binary search tree of selects over `entries` (sorted by
+// key, keys unique): internal nodes dispatch on a comparison against the
+// median key and leaves compare for equality against a single key, falling
+// through to `else_node`. The resulting logic depth is logarithmic in the
+// number of entries where the original chain was linear.
+absl::StatusOr<Node*> BuildBinarySearchTree(
+    FunctionBase* f, Node* index, absl::Span<const TableEntry> entries,
+    Node* else_node, const SourceInfo& loc) {
+  const int64_t index_width = index->BitCountOrDie();
+  if (entries.size() == 1) {
+    XLS_ASSIGN_OR_RETURN(
+        Node * key_literal,
+        f->MakeNode<Literal>(loc, Value(UBits(entries.front().key,
+                                              index_width))));
+    XLS_ASSIGN_OR_RETURN(
+        Node * is_equal,
+        f->MakeNode<CompareOp>(loc, index, key_literal, Op::kEq));
+    XLS_ASSIGN_OR_RETURN(Node * value_literal,
+                         f->MakeNode<Literal>(loc, entries.front().value));
+    return f->MakeNode<Select>(loc, is_equal,
+                               std::vector<Node*>({else_node, value_literal}),
+                               /*default_value=*/std::nullopt);
+  }
+  const int64_t mid = entries.size() / 2;
+  XLS_ASSIGN_OR_RETURN(
+      Node * pivot,
+      f->MakeNode<Literal>(loc, Value(UBits(entries[mid].key, index_width))));
+  XLS_ASSIGN_OR_RETURN(Node * is_below,
+                       f->MakeNode<CompareOp>(loc, index, pivot, Op::kULt));
+  XLS_ASSIGN_OR_RETURN(
+      Node * low_tree,
+      BuildBinarySearchTree(f, index, entries.subspan(0, mid), else_node, loc));
+  XLS_ASSIGN_OR_RETURN(
+      Node * high_tree,
+      BuildBinarySearchTree(f, index, entries.subspan(mid), else_node, loc));
+  return f->MakeNode<Select>(loc, is_below,
+                             std::vector<Node*>({high_tree, low_tree}),
+                             /*default_value=*/std::nullopt);
+}
+
 }  // namespace
 
 absl::StatusOr<bool> TableSwitchPass::RunOnFunctionBaseInternal(
@@ -287,17 +396,39 @@ absl::StatusOr<bool> TableSwitchPass::RunOnFunctionBaseInternal(
     PassResults* results) const {
   StatelessQueryEngine query_engine;
 
+  // Index of link-pattern matches, so each select is matched at most once no
+  // matter how many chain walks pass through it.
+  absl::flat_hash_map<Node*, std::optional<Link>> link_index;
+  auto get_link = [&](Node* n) -> const std::optional<Link>& {
+    auto [it, inserted] = link_index.try_emplace(n);
+    if (inserted) {
+      it->second = MatchLink(query_engine, n);
+    }
+    return it->second;
+  };
+
   bool changed = false;
   absl::flat_hash_set<Node*> transformed;
+  // Nodes whose maximal chain has already been evaluated without producing a
+  // table. The chain reachable from a node is a function of the node alone,
+  // so there is no point re-walking it when the node shows up again as the
+  // suffix of a longer chain; on long unconvertible chains those re-walks
+  // made the pass quadratic.
+  absl::flat_hash_set<Node*> no_table;
   for (Node* node : ReverseTopoSort(f)) {
     VLOG(3) << "Considering node: " << node->ToString();
     if (transformed.contains(node)) {
       VLOG(3) << absl::StreamFormat("Already transformed %s", node->GetName());
       continue;
     }
+    if (no_table.contains(node)) {
+      VLOG(3) << absl::StreamFormat("Chain from %s already evaluated",
+                                    node->GetName());
+      continue;
+    }
     // Check if this node is the start of a chain of selects. This also
     // identifies the common index.
-    std::optional<Link> start = MatchLink(query_engine, node);
+    const std::optional<Link>& start = get_link(node);
     if (!start.has_value()) {
       VLOG(3) << absl::StreamFormat("%s is not the start of a chain.",
                                     node->GetName());
@@ -327,7 +458,11 @@ absl::StatusOr<bool> TableSwitchPass::RunOnFunctionBaseInternal(
     Node* next = start->next;
     Node* index = start->index;
     std::vector<Link> links = {start.value()};
-    while (std::optional<Link> link = MatchLink(query_engine, next, index)) {
+    while (true) {
+      const std::optional<Link>& link = get_link(next);
+      if (!link.has_value() || link->index != index) {
+        break;
+      }
       next = link->next;
       links.push_back(link.value());
     }
@@ -342,34 +477,86 @@ absl::StatusOr<bool> TableSwitchPass::RunOnFunctionBaseInternal(
       }
     }
 
-    if (links.size() <= 2) {
-      VLOG(3) << "Chain is too short.";
+    // Find the longest suffix of the chain which can be lowered to a table
+    // lookup. Evaluating all suffixes here is equivalent to the interior
+    // links later being considered as chain heads of their own, but touches
+    // each link once instead of once per suffix.
+    if (std::optional<int64_t> suffix_start =
+            FindTableSuffix(links, transformed);
+        suffix_start.has_value()) {
+      absl::Span<const Link> suffix =
+          absl::MakeConstSpan(links).subspan(*suffix_start);
+      XLS_ASSIGN_OR_RETURN(std::optional<Value> table, LinksToTable(suffix));
+      XLS_RET_CHECK(table.has_value());
+      Node* head = suffix.front().node;
+
+      VLOG(3) << absl::StreamFormat(
+          "Replacing chain starting at %s with index of array: %s",
+          head->GetName(), table.value().ToString());
+
+      XLS_ASSIGN_OR_RETURN(Literal * array_literal,
+                           f->MakeNode<Literal>(head->loc(), table.value()));
+      XLS_RETURN_IF_ERROR(head->ReplaceUsesWithNew<ArrayIndex>(
+                                  array_literal, std::vector<Node*>({index}))
+                              .status());
+
+      // Mark the replaced nodes as being transformed to avoid quadratic
+      // behavior. These nodes will be skipped in future iterations.
+      for (const Link& link : suffix) {
+        transformed.insert(link.node);
+      }
+      for (const Link& link :
+           absl::MakeConstSpan(links).subspan(0, *suffix_start)) {
+        no_table.insert(link.node);
+      }
+      changed = true;
       continue;
     }
 
-    // Try to convert the chain into a table representing the lookup being
-    // performed.
-    XLS_ASSIGN_OR_RETURN(std::optional<Value> table, LinksToTable(links));
-    if (!table.has_value()) {
+    // The chain is too sparse for a dense table. Long chains are still worth
+    // rewriting: a balanced binary search over the keys has logarithmic logic
+    // depth where the chain was linear.
+    if (static_cast<int64_t>(links.size()) >= kMinBinarySearchChainLength) {
+      // Gather the selectable values, bottom-most instance of each key
+      // winning as in LinksToTable(), and sort by key.
+      absl::flat_hash_map<uint64_t, Value> map;
+      for (const Link& link : links) {
+        if (!map.contains(link.key)) {
+          map.insert({link.key, link.value});
+        }
+      }
+      std::vector<TableEntry> entries;
+      entries.reserve(map.size());
+      for (const auto& [key, value] : map) {
+        entries.push_back(TableEntry{key, value});
+      }
+      std::sort(entries.begin(), entries.end(),
+                [](const TableEntry& a, const TableEntry& b) {
+                  return a.key < b.key;
+                });
+
+      VLOG(3) << absl::StreamFormat(
+          "Replacing sparse chain starting at %s with a binary search over "
+          "%d keys",
+          node->GetName(), entries.size());
+
+      XLS_ASSIGN_OR_RETURN(
+          Node * tree,
+          BuildBinarySearchTree(f, index, entries, links.back().next,
+                                node->loc()));
+      XLS_RETURN_IF_ERROR(node->ReplaceUsesWith(tree));
+      for (const Link& link : links) {
+        transformed.insert(link.node);
+      }
+      changed = true;
       continue;
     }
 
-    VLOG(3) << absl::StreamFormat(
-        "Replacing chain starting at %s with index of array: %s",
-        node->GetName(), table.value().ToString());
-
-    XLS_ASSIGN_OR_RETURN(Literal * array_literal,
-                         f->MakeNode<Literal>(node->loc(), table.value()));
-    XLS_RETURN_IF_ERROR(node->ReplaceUsesWithNew<ArrayIndex>(
-                                array_literal, std::vector<Node*>({index}))
-                            .status());
-
-    // Mark the replaced nodes as being transformed to avoid quadratic
-    // behavior. These nodes will be skipped in future iterations.
+    // Nothing to do for this chain; remember the evaluated links so
+    // overlapping chains do not re-walk them.
     for (const Link& link : links) {
-      transformed.insert(link.node);
+      no_table.insert(link.node);
     }
-    changed = true;
   }
 
   return changed;
@@ -793,5 +793,62 @@ fn main(index: bits[2]) -> bits[32] {
           /*indices=*/{m::Param()}));
 }
 
+// A chain too sparse for a dense table but long enough to be lowered to a
+// balanced binary search over the keys.
+TEST_F(TableSwitchPassTest, SparseChainLoweredToBinarySearch) {
+  std::string program = R"(
+fn main(index: bits[32]) -> bits[32] {
+  _0: bits[32] = literal(value=0)
+  _111: bits[32] = literal(value=111)
+  _222: bits[32] = literal(value=222)
+  _333: bits[32] = literal(value=333)
+  _444: bits[32] = literal(value=444)
+  _555: bits[32] = literal(value=555)
+  _666: bits[32] = literal(value=666)
+  _777: bits[32] = literal(value=777)
+  _888: bits[32] = literal(value=888)
+
+  literal_2: bits[32] = literal(value=2)
+  literal_5: bits[32] = literal(value=5)
+  literal_9: bits[32] = literal(value=9)
+  literal_17: bits[32] = literal(value=17)
+  literal_33: bits[32] = literal(value=33)
+  literal_65: bits[32] = literal(value=65)
+  literal_129: bits[32] = literal(value=129)
+  literal_257: bits[32] = literal(value=257)
+  eq_2: bits[1] = eq(index, literal_2)
+  eq_5: bits[1] = eq(index, literal_5)
+  eq_9: bits[1] = eq(index, literal_9)
+  eq_17: bits[1] = eq(index, literal_17)
+  eq_33: bits[1] = eq(index, literal_33)
+  eq_65: bits[1] = eq(index, literal_65)
+  eq_129: bits[1] = eq(index, literal_129)
+  eq_257: bits[1] = eq(index, literal_257)
+
+  sel_7: bits[32] = sel(eq_257, cases=[_0, _888])
+  sel_6: bits[32] = sel(eq_129, cases=[sel_7, _777])
+  sel_5: bits[32] = sel(eq_65, cases=[sel_6, _666])
+  sel_4: bits[32] = sel(eq_33, cases=[sel_5, _555])
+  sel_3: bits[32] = sel(eq_17, cases=[sel_4, _444])
+  sel_2: bits[32] = sel(eq_9, cases=[sel_3, _333])
+  sel_1: bits[32] = sel(eq_5, cases=[sel_2, _222])
+  ret sel_0: bits[32] = sel(eq_2, cases=[sel_1, _111])
+})";
+
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, ParseFunction(program, p.get()));
+  // Capture the behavior before the transformation.
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<Value> before_data,
+                           GetBeforeData(f, 300));
+
+  ASSERT_THAT(Run(f), IsOkAndHolds(true));
+  // The root of the tree dispatches on a comparison against the median key.
+  EXPECT_THAT(f->return_value(),
+              m::Select(m::ULt(m::Param(), m::Literal(UBits(33, 32))),
+                        /*cases=*/{m::Select(), m::Select()}));
+
+  XLS_ASSERT_OK(CompareBeforeAfter(f, before_data));
+}
+
 }  // namespace
 }  // namespace xls
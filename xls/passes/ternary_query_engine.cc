@@ -176,6 +176,38 @@ class TernaryNodeEvaluator : public AbstractNodeEvaluator<TernaryEvaluator> {
     return SetValue(n, std::move(unconstrained));
   }
 
+  // The generic AbstractEvaluator path evaluates bitwise logic one
+  // TernaryValue at a time; these overrides instead run the packed
+  // two-bitmask transfer functions, which process a machine word of bits per
+  // operation.
+  absl::Status HandleNaryAnd(NaryOp* and_op) override {
+    return HandleBitwiseNary(and_op, ternary_ops::PackedAnd,
+                             /*invert=*/false);
+  }
+
+  absl::Status HandleNaryNand(NaryOp* nand_op) override {
+    return HandleBitwiseNary(nand_op, ternary_ops::PackedAnd,
+                             /*invert=*/true);
+  }
+
+  absl::Status HandleNaryOr(NaryOp* or_op) override {
+    return HandleBitwiseNary(or_op, ternary_ops::PackedOr, /*invert=*/false);
+  }
+
+  absl::Status HandleNaryNor(NaryOp* nor_op) override {
+    return HandleBitwiseNary(nor_op, ternary_ops::PackedOr, /*invert=*/true);
+  }
+
+  absl::Status HandleNaryXor(NaryOp* xor_op) override {
+    return HandleBitwiseNary(xor_op, ternary_ops::PackedXor, /*invert=*/false);
+  }
+
+  absl::Status HandleNot(UnOp* not_op) override {
+    XLS_ASSIGN_OR_RETURN(auto v, GetValue(not_op->operand(0)));
+    return SetValue(not_op, ternary_ops::Unpack(ternary_ops::PackedNot(
+                                ternary_ops::Pack(v))));
+  }
+
   absl::Status HandleArrayIndex(ArrayIndex* index) override {
     XLS_ASSIGN_OR_RETURN(auto indices, GetValueList(index->indices()));
     XLS_ASSIGN_OR_RETURN(auto array, GetCompoundValue(index->array()));
@@ -260,6 +292,22 @@ class TernaryNodeEvaluator : public AbstractNodeEvaluator<TernaryEvaluator> {
   }
 
  private:
+  // Folds 'op's operands together in packed form using the word-parallel
+  // 'combine' transfer function, complementing the result if 'invert' is set.
+  template <typename BinaryOp>
+  absl::Status HandleBitwiseNary(NaryOp* op, BinaryOp combine, bool invert) {
+    XLS_ASSIGN_OR_RETURN(auto args, GetValueList(op->operands()));
+    XLS_RET_CHECK(!args.empty()) << op;
+    ternary_ops::PackedTernary accum = ternary_ops::Pack(args.front());
+    for (TernaryEvaluator::Span arg : absl::MakeConstSpan(args).subspan(1)) {
+      accum = combine(accum, ternary_ops::Pack(arg));
+    }
+    if (invert) {
+      accum = ternary_ops::PackedNot(accum);
+    }
+    return SetValue(op, ternary_ops::Unpack(accum));
+  }
+
   // Intersect all 'possibilities' together
   absl::StatusOr<CompoundValue> MergePossibilities(
       absl::Span<CompoundValueView const> possibilities) {
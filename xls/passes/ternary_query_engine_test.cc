@@ -337,6 +337,42 @@ TEST_F(TernaryQueryEngineTest, Ult) {
   EXPECT_THAT(RunOnBinaryOp("0b0XX", "0b1XX", make_ult), IsOkAndHolds("0b1"));
 }
 
+// The bitwise logical ops are evaluated with the packed word-parallel
+// transfer functions; check them against the elementwise truth tables. The
+// operands together enumerate all nine ternary input combinations.
+TEST_F(TernaryQueryEngineTest, BitwiseOps) {
+  auto make_and = [](BValue lhs, BValue rhs, FunctionBuilder* fb) {
+    fb->And(lhs, rhs);
+  };
+  EXPECT_THAT(RunOnBinaryOp("0b000111XXX", "0b01X01X01X", make_and),
+              IsOkAndHolds("0b0_0001_X0XX"));
+  auto make_nand = [](BValue lhs, BValue rhs, FunctionBuilder* fb) {
+    fb->Nand(lhs, rhs);
+  };
+  EXPECT_THAT(RunOnBinaryOp("0b000111XXX", "0b01X01X01X", make_nand),
+              IsOkAndHolds("0b1_1110_X1XX"));
+  auto make_or = [](BValue lhs, BValue rhs, FunctionBuilder* fb) {
+    fb->Or(lhs, rhs);
+  };
+  EXPECT_THAT(RunOnBinaryOp("0b000111XXX", "0b01X01X01X", make_or),
+              IsOkAndHolds("0b0_1X11_1X1X"));
+  auto make_nor = [](BValue lhs, BValue rhs, FunctionBuilder* fb) {
+    fb->Nor(lhs, rhs);
+  };
+  EXPECT_THAT(RunOnBinaryOp("0b000111XXX", "0b01X01X01X", make_nor),
+              IsOkAndHolds("0b1_0X00_0X0X"));
+  auto make_xor = [](BValue lhs, BValue rhs, FunctionBuilder* fb) {
+    fb->Xor(lhs, rhs);
+  };
+  EXPECT_THAT(RunOnBinaryOp("0b000111XXX", "0b01X01X01X", make_xor),
+              IsOkAndHolds("0b0_1X10_XXXX"));
+  auto make_not = [](BValue lhs, BValue rhs, FunctionBuilder* fb) {
+    fb->Not(rhs);
+  };
+  EXPECT_THAT(RunOnBinaryOp("0b000111XXX", "0b01X01X01X", make_not),
+              IsOkAndHolds("0b1_0X10_X10X"));
+}
+
 TEST_F(TernaryQueryEngineTest, Ne) {
   auto make_ne = [](BValue lhs, BValue rhs, FunctionBuilder* fb) {
     fb->Ne(lhs, rhs);
@@ -14,6 +14,7 @@
 
 #include "xls/passes/token_dependency_pass.h"
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -59,14 +60,24 @@ absl::StatusOr<bool> TokenDependencyPass::RunOnFunctionBaseInternal(
   // B to A in this relation.
   NodeRelation token_deps;
   {
-    XLS_ASSIGN_OR_RETURN(TokenProvenance provenance,
-                         TokenProvenanceAnalysis(f));
-    for (const auto& [node, ignore] : provenance) {
+    // Reuse token provenance computed by an earlier pass where possible. The
+    // provenance cache is not thread-safe, so compute the analysis locally
+    // when FunctionBases are processed concurrently.
+    const TokenProvenance* provenance = nullptr;
+    std::optional<TokenProvenance> local_provenance;
+    if (options.worker_count == 1) {
+      XLS_ASSIGN_OR_RETURN(provenance,
+                           results->token_provenance.GetProvenance(f));
+    } else {
+      XLS_ASSIGN_OR_RETURN(local_provenance, TokenProvenanceAnalysis(f));
+      provenance = &*local_provenance;
+    }
+    for (const auto& [node, ignore] : *provenance) {
       for (Node* child : node->operands()) {
-        if (!provenance.contains(child)) {
+        if (!provenance->contains(child)) {
           continue;
         }
-        for (Node* element : provenance.at(child).elements()) {
+        for (Node* element : provenance->at(child).elements()) {
           if (element != nullptr) {
             token_deps[element].insert(node);
           }
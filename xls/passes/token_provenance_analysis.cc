@@ -17,6 +17,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -132,6 +134,27 @@ class TokenProvenanceWithTopoSortVisitor : public TokenProvenanceVisitor {
   std::vector<Node*> topo_sorted_token_nodes_;
 };
 
+// Builds the immediate-predecessor DAG of side-effecting nodes from an
+// already-computed provenance map.
+TokenDAG TokenDAGFromProvenance(FunctionBase* f,
+                                const TokenProvenance& provenance) {
+  TokenDAG dag;
+  for (Node* node : f->nodes()) {
+    if (OpIsSideEffecting(node->op()) || node->op() == Op::kAfterAll ||
+        node->op() == Op::kMinDelay) {
+      for (Node* operand : node->operands()) {
+        if (operand->GetType()->IsToken()) {
+          Node* child = provenance.at(operand).Get({});
+          if (child != nullptr) {
+            dag[node].insert(child);
+          }
+        }
+      }
+    }
+  }
+  return dag;
+}
+
 }  // namespace
 
 absl::StatusOr<TokenProvenance> TokenProvenanceAnalysis(FunctionBase* f) {
@@ -164,23 +187,71 @@ std::string ToString(const TokenProvenance& provenance) {
 
 absl::StatusOr<TokenDAG> ComputeTokenDAG(FunctionBase* f) {
   XLS_ASSIGN_OR_RETURN(TokenProvenance provenance, TokenProvenanceAnalysis(f));
+  return TokenDAGFromProvenance(f, provenance);
+}
 
-  TokenDAG dag;
-  for (Node* node : f->nodes()) {
-    if (OpIsSideEffecting(node->op()) || node->op() == Op::kAfterAll ||
-        node->op() == Op::kMinDelay) {
-      for (Node* operand : node->operands()) {
-        if (operand->GetType()->IsToken()) {
-          Node* child = provenance.at(operand).Get({});
-          if (child != nullptr) {
-            dag[node].insert(child);
+absl::StatusOr<CachedTokenProvenance::Entry*> CachedTokenProvenance::GetEntry(
+    FunctionBase* f) {
+  std::unique_ptr<Entry>& entry = entries_[f];
+  if (entry == nullptr) {
+    entry = std::make_unique<Entry>();
+  }
+  if (entry->function_name == f->name()) {
+    if (entry->transform_version == f->transform_version()) {
+      return entry.get();
+    }
+    // The function has been transformed; if every changed node is live,
+    // token-free and non-side-effecting, no token can have been rerouted and
+    // the cached provenance is still correct for all token-carrying nodes.
+    // Deleted nodes resolve to nullptr and force a recompute, so the cached
+    // map never holds dangling keys.
+    std::optional<std::vector<int64_t>> changed_ids =
+        f->ChangedNodeIdsSince(entry->transform_version);
+    if (changed_ids.has_value()) {
+      bool token_relevant = false;
+      for (int64_t id : *changed_ids) {
+        Node* node = f->GetNodeById(id);
+        if (node == nullptr || TypeHasToken(node->GetType()) ||
+            OpIsSideEffecting(node->op())) {
+          token_relevant = true;
+          break;
+        }
+      }
+      if (!token_relevant) {
+        // Revalidate in place, inserting all-null entries for any new nodes
+        // so the map keeps covering every node of `f`.
+        for (int64_t id : *changed_ids) {
+          Node* node = f->GetNodeById(id);
+          if (!entry->provenance.contains(node)) {
+            entry->provenance.insert(
+                {node, LeafTypeTree<Node*>(node->GetType(), nullptr)});
           }
         }
+        entry->transform_version = f->transform_version();
+        return entry.get();
       }
     }
   }
+  XLS_ASSIGN_OR_RETURN(entry->provenance, TokenProvenanceAnalysis(f));
+  entry->dag.reset();
+  entry->function_name = f->name();
+  entry->transform_version = f->transform_version();
+  return entry.get();
+}
 
-  return dag;
+absl::StatusOr<const TokenProvenance*> CachedTokenProvenance::GetProvenance(
+    FunctionBase* f) {
+  XLS_ASSIGN_OR_RETURN(Entry * entry, GetEntry(f));
+  return &entry->provenance;
+}
+
+absl::StatusOr<const TokenDAG*> CachedTokenProvenance::GetTokenDAG(
+    FunctionBase* f) {
+  XLS_ASSIGN_OR_RETURN(Entry * entry, GetEntry(f));
+  if (!entry->dag.has_value()) {
+    entry->dag = TokenDAGFromProvenance(f, entry->provenance);
+  }
+  return &*entry->dag;
 }
 
 absl::StatusOr<std::vector<NodeAndPredecessors>> ComputeTopoSortedTokenDAG(
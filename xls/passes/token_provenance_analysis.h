@@ -15,6 +15,9 @@
 #ifndef XLS_PASSES_TOKEN_PROVENANCE_ANALYSIS_H_
 #define XLS_PASSES_TOKEN_PROVENANCE_ANALYSIS_H_
 
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -48,6 +51,51 @@ using TokenDAG = absl::flat_hash_map<Node*, absl::flat_hash_set<Node*>>;
 // result map.
 absl::StatusOr<TokenDAG> ComputeTokenDAG(FunctionBase* f);
 
+// A cache of token provenance results shared across pass invocations
+// (typically via PassResults::token_provenance). Entries are validated
+// against the FunctionBase's transform version. When the function has been
+// transformed since an entry was computed, the change journal
+// (FunctionBase::ChangedNodeIdsSince) is consulted: if every changed node is
+// live, token-free and non-side-effecting, the mutation cannot have rerouted
+// any token and the cached result is revalidated in place; otherwise the
+// analysis is recomputed from scratch.
+//
+// The cache is not thread-safe; passes which process FunctionBases
+// concurrently (worker_count > 1) must compute their provenance locally
+// instead.
+class CachedTokenProvenance {
+ public:
+  // Returns the token provenance for `f` (see TokenProvenanceAnalysis). The
+  // returned pointer is owned by the cache and must not be used after `f` is
+  // mutated; call GetProvenance again instead.
+  absl::StatusOr<const TokenProvenance*> GetProvenance(FunctionBase* f);
+
+  // Returns the token DAG for `f` (see ComputeTokenDAG), derived from the
+  // cached provenance. Same validity rules as GetProvenance.
+  absl::StatusOr<const TokenDAG*> GetTokenDAG(FunctionBase* f);
+
+  // Drops all cached results.
+  void Clear() { entries_.clear(); }
+
+ private:
+  struct Entry {
+    TokenProvenance provenance;
+    // Computed from `provenance` on first request.
+    std::optional<TokenDAG> dag;
+    // Name of the FunctionBase at computation time. Guards against a deleted
+    // FunctionBase being reallocated at the same address.
+    std::string function_name;
+    // FunctionBase::transform_version() up to which `provenance` is valid.
+    int64_t transform_version;
+  };
+
+  // Returns the cache entry for `f`, recomputing the provenance if any
+  // token-relevant node has changed since it was computed.
+  absl::StatusOr<Entry*> GetEntry(FunctionBase* f);
+
+  // Entries are heap-allocated so returned pointers survive rehashing.
+  absl::flat_hash_map<FunctionBase*, std::unique_ptr<Entry>> entries_;
+};
 
 struct NodeAndPredecessors {
   Node* node;
@@ -29,7 +29,9 @@
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
 #include "xls/ir/proc.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/value.h"
 
 namespace xls {
@@ -259,5 +261,54 @@ TEST_F(TokenProvenanceAnalysisTest, SelectOfTokens) {
                        HasSubstr("Node type should not contain a token")));
 }
 
+TEST_F(TokenProvenanceAnalysisTest, CachedTokenProvenance) {
+  auto p = CreatePackage();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      StreamingChannel * channel,
+      p->CreateStreamingChannel("test_channel", ChannelOps::kSendReceive,
+                                p->GetBitsType(32)));
+  ProcBuilder pb(TestName(), p.get());
+  BValue token = pb.Literal(Value::Token());
+  BValue recv = pb.Receive(channel, token);
+  BValue send =
+      pb.Send(channel, pb.TupleIndex(recv, 0), pb.TupleIndex(recv, 1));
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * proc, pb.Build());
+
+  CachedTokenProvenance cache;
+  XLS_ASSERT_OK_AND_ASSIGN(const TokenProvenance* provenance,
+                           cache.GetProvenance(proc));
+  EXPECT_EQ(provenance->at(send.node()).Get({}), send.node());
+
+  // An unchanged proc reuses the cached result.
+  XLS_ASSERT_OK_AND_ASSIGN(const TokenProvenance* again,
+                           cache.GetProvenance(proc));
+  EXPECT_EQ(again, provenance);
+
+  // A token-free mutation revalidates the cached result in place and extends
+  // it to cover the new node.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * literal,
+      proc->MakeNode<Literal>(SourceInfo(), Value(UBits(0, 32))));
+  XLS_ASSERT_OK_AND_ASSIGN(const TokenProvenance* revalidated,
+                           cache.GetProvenance(proc));
+  EXPECT_EQ(revalidated, provenance);
+  EXPECT_EQ(revalidated->at(literal).Get({}), nullptr);
+
+  // A token-relevant mutation recomputes the provenance.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * after_all,
+      proc->MakeNode<AfterAll>(SourceInfo(),
+                               std::vector<Node*>{send.node()}));
+  XLS_ASSERT_OK_AND_ASSIGN(const TokenProvenance* recomputed,
+                           cache.GetProvenance(proc));
+  EXPECT_EQ(recomputed->at(after_all).Get({}), after_all);
+
+  // The token DAG derived from the cached provenance matches the
+  // from-scratch computation.
+  XLS_ASSERT_OK_AND_ASSIGN(const TokenDAG* dag, cache.GetTokenDAG(proc));
+  XLS_ASSERT_OK_AND_ASSIGN(TokenDAG fresh_dag, ComputeTokenDAG(proc));
+  EXPECT_EQ(*dag, fresh_dag);
+}
+
 }  // namespace
 }  // namespace xls
@@ -20,7 +20,9 @@
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
@@ -56,6 +58,32 @@ absl::StatusOr<ReachedFixpoint> UnownedUnionQueryEngine::Populate(
   return result;
 }
 
+bool UnownedUnionQueryEngine::QueryEachEngine(
+    Node* memo_key, absl::FunctionRef<bool(QueryEngine&)> query) const {
+  int64_t memoized = -1;
+  if (memo_key != nullptr) {
+    auto it = last_decisive_engine_.find(memo_key);
+    if (it != last_decisive_engine_.end()) {
+      memoized = it->second;
+      if (query(*engines_[memoized])) {
+        return true;
+      }
+    }
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(engines_.size()); ++i) {
+    if (i == memoized) {
+      continue;
+    }
+    if (query(*engines_[i])) {
+      if (memo_key != nullptr) {
+        last_decisive_engine_[memo_key] = i;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
 bool UnownedUnionQueryEngine::IsTracked(Node* node) const {
   for (const auto& engine : engines_) {
     if (engine->IsTracked(node)) {
@@ -76,15 +104,20 @@ LeafTypeTree<TernaryVector> UnownedUnionQueryEngine::GetTernary(
                                  TernaryValue::kUnknown);
           })
           .value();
-  for (const auto& engine : engines_) {
-    if (engine->IsTracked(node)) {
+  QueryEachEngine(node, [&](QueryEngine& engine) {
+    if (engine.IsTracked(node)) {
       leaf_type_tree::SimpleUpdateFrom<TernaryVector, TernaryVector>(
-          result.AsMutableView(), engine->GetTernary(node).AsView(),
+          result.AsMutableView(), engine.GetTernary(node).AsView(),
           [](TernaryVector& lhs, const TernaryVector& rhs) {
             CHECK_OK(ternary_ops::UpdateWithUnion(lhs, rhs));
           });
     }
-  }
+    // Decisive once every bit is known; further engines cannot improve the
+    // merged result.
+    return absl::c_all_of(result.elements(), [](const TernaryVector& v) {
+      return ternary_ops::IsFullyKnown(v);
+    });
+  });
   return result;
 }
 
@@ -105,77 +138,65 @@ LeafTypeTree<IntervalSet> UnownedUnionQueryEngine::GetIntervals(
     result.elements()[i] =
         IntervalSet::Maximal(result.leaf_types()[i]->GetFlatBitCount());
   }
-  for (const auto& engine : engines_) {
-    if (engine->IsTracked(node)) {
+  QueryEachEngine(node, [&](QueryEngine& engine) {
+    if (engine.IsTracked(node)) {
       leaf_type_tree::SimpleUpdateFrom<IntervalSet, IntervalSet>(
-          result.AsMutableView(), engine->GetIntervals(node).AsView(),
+          result.AsMutableView(), engine.GetIntervals(node).AsView(),
           [](IntervalSet& lhs, const IntervalSet& rhs) {
-            lhs = IntervalSet::Intersect(lhs, rhs);
+            lhs.IntersectWith(rhs);
           });
     }
-  }
+    // Decisive once every leaf is a single point; intersection with further
+    // engines cannot narrow the result any more.
+    return absl::c_all_of(result.elements(), [](const IntervalSet& intervals) {
+      return intervals.IsPrecise();
+    });
+  });
   return result;
 }
 
 bool UnownedUnionQueryEngine::AtMostOneTrue(
     absl::Span<TreeBitLocation const> bits) const {
-  for (const auto& engine : engines_) {
-    if (engine->AtMostOneTrue(bits)) {
-      return true;
-    }
-  }
-  return false;
+  return QueryEachEngine(
+      bits.empty() ? nullptr : bits.front().node(),
+      [&](QueryEngine& engine) { return engine.AtMostOneTrue(bits); });
 }
 
 bool UnownedUnionQueryEngine::AtLeastOneTrue(
     absl::Span<TreeBitLocation const> bits) const {
-  for (const auto& engine : engines_) {
-    if (engine->AtLeastOneTrue(bits)) {
-      return true;
-    }
-  }
-  return false;
+  return QueryEachEngine(
+      bits.empty() ? nullptr : bits.front().node(),
+      [&](QueryEngine& engine) { return engine.AtLeastOneTrue(bits); });
 }
 
 bool UnownedUnionQueryEngine::KnownEquals(const TreeBitLocation& a,
                                           const TreeBitLocation& b) const {
-  for (const auto& engine : engines_) {
-    if (engine->KnownEquals(a, b)) {
-      return true;
-    }
-  }
-  return false;
+  return QueryEachEngine(
+      a.node(), [&](QueryEngine& engine) { return engine.KnownEquals(a, b); });
 }
 
 bool UnownedUnionQueryEngine::KnownNotEquals(const TreeBitLocation& a,
                                              const TreeBitLocation& b) const {
-  for (const auto& engine : engines_) {
-    if (engine->KnownNotEquals(a, b)) {
-      return true;
-    }
-  }
-  return false;
+  return QueryEachEngine(a.node(), [&](QueryEngine& engine) {
+    return engine.KnownNotEquals(a, b);
+  });
 }
 
 bool UnownedUnionQueryEngine::Implies(const TreeBitLocation& a,
                                       const TreeBitLocation& b) const {
-  for (const auto& engine : engines_) {
-    if (engine->Implies(a, b)) {
-      return true;
-    }
-  }
-  return false;
+  return QueryEachEngine(
+      a.node(), [&](QueryEngine& engine) { return engine.Implies(a, b); });
 }
 
 std::optional<Bits> UnownedUnionQueryEngine::ImpliedNodeValue(
     absl::Span<const std::pair<TreeBitLocation, bool>> predicate_bit_values,
     Node* node) const {
-  for (const auto& engine : engines_) {
-    if (auto i = engine->ImpliedNodeValue(predicate_bit_values, node)) {
-      return i;
-    }
-  }
-  return std::nullopt;
+  std::optional<Bits> result;
+  QueryEachEngine(node, [&](QueryEngine& engine) {
+    result = engine.ImpliedNodeValue(predicate_bit_values, node);
+    return result.has_value();
+  });
+  return result;
 }
 
 }  // namespace xls
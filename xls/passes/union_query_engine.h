@@ -15,6 +15,7 @@
 #ifndef XLS_PASSES_UNION_QUERY_ENGINE_H_
 #define XLS_PASSES_UNION_QUERY_ENGINE_H_
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -22,6 +23,7 @@
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xls/data_structures/leaf_type_tree.h"
@@ -38,6 +40,15 @@ namespace xls {
 // A query engine that combines the results of multiple (unowned) given query
 // engines.
 //
+// Engines are consulted in the order they were given and queries return as
+// soon as a decisive answer is found, so callers should order engines from
+// cheapest to most expensive (e.g. `StatelessQueryEngine` before a BDD or
+// range engine). A per-node memo records which engine produced the decisive
+// answer last time; that engine is consulted first on subsequent queries
+// touching the same node. Queries whose results genuinely strengthen under
+// union (`GetTernary`, `GetIntervals`) still merge across engines, stopping
+// early only once the merged result cannot be improved further.
+//
 // `GetKnownBits` and `GetKnownBitsValues` use `const_cast<...>(this)` under the
 // hood, so it is undefined behavior to define a `const UnionQueryEngine`
 // variable (but `const UnionQueryEngine*` is fine, the storage location just
@@ -79,9 +90,21 @@ class UnownedUnionQueryEngine : public QueryEngine {
       Node* node) const override;
 
  private:
+  // Runs `query` against each engine in cost order, returning true as soon as
+  // one answers decisively (i.e. `query` returns true). The engine memoized
+  // for `memo_key` is tried first and the memo is updated whenever a
+  // different engine ends up providing the decisive answer. A null `memo_key`
+  // disables memoization for the query.
+  bool QueryEachEngine(Node* memo_key,
+                       absl::FunctionRef<bool(QueryEngine&)> query) const;
+
   absl::flat_hash_map<Node*, Bits> known_bits_;
   absl::flat_hash_map<Node*, Bits> known_bit_values_;
   std::vector<QueryEngine*> engines_;
+  // Maps a node to the index of the engine which most recently gave a
+  // decisive answer for a query involving that node. Purely a performance
+  // hint; a stale entry only costs one redundant engine query.
+  mutable absl::flat_hash_map<Node*, int64_t> last_decisive_engine_;
 };
 
 // A query engine that combines the results of multiple given query engines.
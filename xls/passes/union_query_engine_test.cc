@@ -34,6 +34,7 @@
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/node.h"
 #include "xls/ir/package.h"
+#include "xls/ir/ternary.h"
 #include "xls/ir/type.h"
 #include "xls/passes/query_engine.h"
 
@@ -215,6 +216,72 @@ class FakeQueryEngine : public QueryEngine {
       equality_states_;
 };
 
+// Forwards all queries to a wrapped engine, counting how many it receives.
+// Used to observe short-circuiting and memoization in the union engine.
+class CountingQueryEngine : public QueryEngine {
+ public:
+  explicit CountingQueryEngine(QueryEngine* wrapped) : wrapped_(wrapped) {}
+
+  absl::StatusOr<ReachedFixpoint> Populate(FunctionBase* f) override {
+    return wrapped_->Populate(f);
+  }
+
+  bool IsTracked(Node* node) const override {
+    return wrapped_->IsTracked(node);
+  }
+
+  LeafTypeTree<TernaryVector> GetTernary(Node* node) const override {
+    ++query_count_;
+    return wrapped_->GetTernary(node);
+  }
+
+  LeafTypeTree<IntervalSet> GetIntervals(Node* node) const override {
+    ++query_count_;
+    return wrapped_->GetIntervals(node);
+  }
+
+  bool AtMostOneTrue(absl::Span<TreeBitLocation const> bits) const override {
+    ++query_count_;
+    return wrapped_->AtMostOneTrue(bits);
+  }
+
+  bool AtLeastOneTrue(absl::Span<TreeBitLocation const> bits) const override {
+    ++query_count_;
+    return wrapped_->AtLeastOneTrue(bits);
+  }
+
+  bool Implies(const TreeBitLocation& a,
+               const TreeBitLocation& b) const override {
+    ++query_count_;
+    return wrapped_->Implies(a, b);
+  }
+
+  std::optional<Bits> ImpliedNodeValue(
+      absl::Span<const std::pair<TreeBitLocation, bool>> predicate_bit_values,
+      Node* node) const override {
+    ++query_count_;
+    return wrapped_->ImpliedNodeValue(predicate_bit_values, node);
+  }
+
+  bool KnownEquals(const TreeBitLocation& a,
+                   const TreeBitLocation& b) const override {
+    ++query_count_;
+    return wrapped_->KnownEquals(a, b);
+  }
+
+  bool KnownNotEquals(const TreeBitLocation& a,
+                      const TreeBitLocation& b) const override {
+    ++query_count_;
+    return wrapped_->KnownNotEquals(a, b);
+  }
+
+  int64_t query_count() const { return query_count_; }
+
+ private:
+  QueryEngine* wrapped_;
+  mutable int64_t query_count_ = 0;
+};
+
 class UnionQueryEngineTest : public IrTestBase {};
 
 TEST_F(UnionQueryEngineTest, Simple) {
@@ -321,5 +388,49 @@ TEST_F(UnionQueryEngineTest, Intervals) {
   EXPECT_EQ(tuple_intervals.elements()[1], y_b);
 }
 
+TEST_F(UnionQueryEngineTest, ShortCircuitsAndMemoizes) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+
+  BValue param = fb.Param("param", fb.package()->GetBitsType(8));
+  XLS_ASSERT_OK(fb.Build());
+
+  Node* node = param.node();
+
+  // The cheap engine knows every bit of the node; the expensive engine only
+  // knows an implication.
+  FakeQueryEngine cheap_fake;
+  for (int64_t i = 0; i < 8; ++i) {
+    cheap_fake.AddKnownBit(TreeBitLocation(node, i), /*value=*/i % 2 == 0);
+  }
+  FakeQueryEngine expensive_fake;
+  expensive_fake.AddImplication(TreeBitLocation(node, 3),
+                                TreeBitLocation(node, 7));
+  CountingQueryEngine cheap(&cheap_fake);
+  CountingQueryEngine expensive(&expensive_fake);
+  UnownedUnionQueryEngine union_query_engine({&cheap, &expensive});
+
+  // The cheap engine already answers the ternary query completely, so the
+  // expensive engine is never consulted.
+  EXPECT_TRUE(ternary_ops::IsFullyKnown(
+      union_query_engine.GetTernary(node).Get({})));
+  EXPECT_EQ(expensive.query_count(), 0);
+
+  // Only the expensive engine knows the implication; answering requires
+  // consulting both engines and memoizes the expensive engine for this node.
+  int64_t cheap_queries_before = cheap.query_count();
+  EXPECT_TRUE(union_query_engine.Implies(TreeBitLocation(node, 3),
+                                         TreeBitLocation(node, 7)));
+  EXPECT_EQ(cheap.query_count(), cheap_queries_before + 1);
+  EXPECT_EQ(expensive.query_count(), 1);
+
+  // Asking again goes straight to the memoized engine.
+  cheap_queries_before = cheap.query_count();
+  EXPECT_TRUE(union_query_engine.Implies(TreeBitLocation(node, 3),
+                                         TreeBitLocation(node, 7)));
+  EXPECT_EQ(cheap.query_count(), cheap_queries_before);
+  EXPECT_EQ(expensive.query_count(), 2);
+}
+
 }  // namespace
 }  // namespace xls
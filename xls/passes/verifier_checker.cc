@@ -23,7 +23,7 @@ namespace xls {
 absl::Status VerifierChecker::Run(Package* p,
                                   const OptimizationPassOptions& options,
                                   PassResults* results) const {
-  return VerifyPackage(p);
+  return VerifyPackage(p, /*codegen=*/false, &cache_);
 }
 
 }  // namespace xls
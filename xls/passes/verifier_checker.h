@@ -16,6 +16,7 @@
 #define XLS_PASSES_VERIFIER_CHECKER_H_
 
 #include "absl/status/status.h"
+#include "xls/ir/verifier.h"
 #include "xls/passes/optimization_pass.h"
 
 namespace xls {
@@ -25,6 +26,13 @@ class VerifierChecker : public OptimizationInvariantChecker {
  public:
   absl::Status Run(Package* p, const OptimizationPassOptions& options,
                    PassResults* results) const override;
+
+ private:
+  // Memoizes per-FunctionBase clean verifications so that each invocation
+  // only re-verifies FunctionBases changed since the previous one. Mutable
+  // because Run() is const; the cache is pure memoization and a checker
+  // instance is only ever run against a single package at a time.
+  mutable VerificationCache cache_;
 };
 
 }  // namespace xls
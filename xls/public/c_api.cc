@@ -0,0 +1,229 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/public/c_api.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "llvm/include/llvm/IR/DataLayout.h"
+#include "xls/ir/events.h"
+#include "xls/ir/format_preference.h"
+#include "xls/ir/function.h"
+#include "xls/ir/ir_parser.h"
+#include "xls/ir/package.h"
+#include "xls/ir/value.h"
+#include "xls/ir/value_utils.h"
+#include "xls/jit/function_jit.h"
+#include "xls/jit/llvm_type_converter.h"
+#include "xls/jit/orc_jit.h"
+#include "xls/jit/type_layout.h"
+
+extern "C" {
+
+struct xls_package {
+  std::unique_ptr<xls::Package> package;
+};
+
+struct xls_function_jit {
+  xls::Function* function;
+  std::unique_ptr<xls::FunctionJit> jit;
+  // Native-layout descriptions of the argument and result types, for the
+  // value-text conversion helpers.
+  std::vector<xls::TypeLayout> arg_layouts;
+  std::optional<xls::TypeLayout> result_layout;
+  // Per-handle scratch reused across calls so xls_function_jit_run performs
+  // no heap allocation. This is what makes the handle single-threaded.
+  std::vector<uint8_t*> arg_scratch;
+  xls::InterpreterEvents events;
+};
+
+}  // extern "C"
+
+namespace {
+
+// Returns a heap-allocated copy of `s` for handoff across the C ABI; the
+// caller releases it with xls_c_str_free.
+char* ToOwnedCString(const std::string& s) {
+  char* result = new char[s.size() + 1];
+  std::memcpy(result, s.c_str(), s.size() + 1);
+  return result;
+}
+
+void SetError(char** error_out, const absl::Status& status) {
+  if (error_out != nullptr) {
+    *error_out = ToOwnedCString(status.ToString());
+  }
+}
+
+void SetError(char** error_out, const std::string& message) {
+  SetError(error_out, absl::InvalidArgumentError(message));
+}
+
+}  // namespace
+
+extern "C" {
+
+void xls_c_str_free(char* s) { delete[] s; }
+
+bool xls_parse_ir_package(const char* ir, const char* filename,
+                          char** error_out, struct xls_package** package_out) {
+  std::optional<std::string_view> filename_opt;
+  if (filename != nullptr) {
+    filename_opt = filename;
+  }
+  absl::StatusOr<std::unique_ptr<xls::Package>> package =
+      xls::Parser::ParsePackage(ir, filename_opt);
+  if (!package.ok()) {
+    SetError(error_out, package.status());
+    return false;
+  }
+  *package_out = new xls_package{.package = *std::move(package)};
+  return true;
+}
+
+void xls_package_free(struct xls_package* package) { delete package; }
+
+bool xls_function_jit_create(struct xls_package* package,
+                             const char* function_name, char** error_out,
+                             struct xls_function_jit** jit_out) {
+  absl::StatusOr<xls::Function*> function =
+      package->package->GetFunction(function_name);
+  if (!function.ok()) {
+    SetError(error_out, function.status());
+    return false;
+  }
+  absl::StatusOr<std::unique_ptr<xls::FunctionJit>> jit =
+      xls::FunctionJit::Create(*function);
+  if (!jit.ok()) {
+    SetError(error_out, jit.status());
+    return false;
+  }
+  // Build the native-layout descriptions used by the value-text helpers. The
+  // data layout matches the one the jitted code was compiled against.
+  absl::StatusOr<std::unique_ptr<xls::OrcJit>> orc_jit = xls::OrcJit::Create();
+  if (!orc_jit.ok()) {
+    SetError(error_out, orc_jit.status());
+    return false;
+  }
+  absl::StatusOr<llvm::DataLayout> data_layout =
+      (*orc_jit)->CreateDataLayout(/*aot_specification=*/false);
+  if (!data_layout.ok()) {
+    SetError(error_out, data_layout.status());
+    return false;
+  }
+  xls::LlvmTypeConverter type_converter((*orc_jit)->GetContext(),
+                                        *data_layout);
+  auto handle = std::make_unique<xls_function_jit>();
+  handle->function = *function;
+  handle->jit = *std::move(jit);
+  for (xls::Param* param : (*function)->params()) {
+    handle->arg_layouts.push_back(
+        type_converter.CreateTypeLayout(param->GetType()));
+  }
+  handle->result_layout = type_converter.CreateTypeLayout(
+      (*function)->return_value()->GetType());
+  handle->arg_scratch.resize((*function)->params().size());
+  *jit_out = handle.release();
+  return true;
+}
+
+void xls_function_jit_free(struct xls_function_jit* jit) { delete jit; }
+
+int64_t xls_function_jit_arg_count(const struct xls_function_jit* jit) {
+  return static_cast<int64_t>(jit->arg_layouts.size());
+}
+
+int64_t xls_function_jit_arg_buffer_size(const struct xls_function_jit* jit,
+                                         int64_t arg_index) {
+  return jit->jit->GetArgTypeSize(static_cast<int>(arg_index));
+}
+
+int64_t xls_function_jit_result_buffer_size(
+    const struct xls_function_jit* jit) {
+  return jit->jit->GetReturnTypeSize();
+}
+
+bool xls_function_jit_run(struct xls_function_jit* jit,
+                          const uint8_t* const* arg_buffers, int64_t arg_count,
+                          uint8_t* result_buffer, char** error_out) {
+  if (arg_count != static_cast<int64_t>(jit->arg_layouts.size())) {
+    SetError(error_out,
+             absl::StrFormat("Expected %d argument buffers, got %d.",
+                             jit->arg_layouts.size(), arg_count));
+    return false;
+  }
+  for (int64_t i = 0; i < arg_count; ++i) {
+    // RunWithViews copies arguments into aligned storage and never writes
+    // through these pointers.
+    jit->arg_scratch[i] = const_cast<uint8_t*>(arg_buffers[i]);
+  }
+  jit->events.Clear();
+  absl::Status status = jit->jit->RunWithViews(
+      absl::MakeConstSpan(jit->arg_scratch),
+      absl::MakeSpan(result_buffer, jit->jit->GetReturnTypeSize()),
+      &jit->events);
+  if (!status.ok()) {
+    SetError(error_out, status);
+    return false;
+  }
+  return true;
+}
+
+bool xls_function_jit_arg_value_to_buffer(const struct xls_function_jit* jit,
+                                          int64_t arg_index,
+                                          const char* value_text,
+                                          uint8_t* buffer, char** error_out) {
+  if (arg_index < 0 ||
+      arg_index >= static_cast<int64_t>(jit->arg_layouts.size())) {
+    SetError(error_out,
+             absl::StrFormat("Argument index %d out of range.", arg_index));
+    return false;
+  }
+  absl::StatusOr<xls::Value> value = xls::Parser::ParseTypedValue(value_text);
+  if (!value.ok()) {
+    SetError(error_out, value.status());
+    return false;
+  }
+  const xls::TypeLayout& layout = jit->arg_layouts[arg_index];
+  if (!xls::ValueConformsToType(*value, layout.type())) {
+    SetError(error_out,
+             absl::StrFormat("Value `%s` does not match argument type %s.",
+                             value->ToString(), layout.type()->ToString()));
+    return false;
+  }
+  layout.ValueToNativeLayout(*value, buffer);
+  return true;
+}
+
+bool xls_function_jit_result_buffer_to_value(
+    const struct xls_function_jit* jit, const uint8_t* result_buffer,
+    char** value_text_out, char** error_out) {
+  xls::Value value = jit->result_layout->NativeLayoutToValue(result_buffer);
+  *value_text_out = ToOwnedCString(
+      value.ToString(xls::FormatPreference::kHex));
+  return true;
+}
+
+}  // extern "C"
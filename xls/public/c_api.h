@@ -0,0 +1,120 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_PUBLIC_C_API_H_
+#define XLS_PUBLIC_C_API_H_
+
+// C API for embedding XLS IR evaluation in non-C++ hosts (e.g. Rust or Go
+// services via FFI).
+//
+// The API is handle based so the expensive steps are paid once: IR text is
+// parsed once into a package handle, a function is JIT-compiled once into a
+// function-jit handle, and each evaluation then runs against caller-provided
+// input/output buffers with no per-call heap allocation on the success path.
+//
+// Buffer layout: argument and result buffers use the JIT's native data
+// layout, the same layout `xls::TypeLayout` reads and writes. Callers query
+// the required sizes from the function-jit handle and may fill buffers either
+// directly (e.g. via TypeLayout in a mixed C++/C embedding) or with the
+// value-text conversion helpers below. Buffers do not require any particular
+// alignment.
+//
+// Error handling: functions that can fail return `bool` (true on success).
+// On failure, if `error_out` is non-null it is set to a heap-allocated
+// NUL-terminated message that the caller must release with `xls_c_str_free`;
+// other out-parameters are left untouched.
+//
+// Thread safety: a package handle is immutable once created and may be
+// shared freely across threads. A function-jit handle holds per-evaluation
+// scratch state and must not be used from two threads at once; for
+// concurrent evaluations create one function-jit handle per thread (multiple
+// handles for the same function are supported and share nothing mutable).
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Opaque handle to a parsed IR package.
+struct xls_package;
+
+// Opaque handle to a JIT-compiled function within a package.
+struct xls_function_jit;
+
+// Frees a string returned via an `error_out` or `..._out` parameter.
+void xls_c_str_free(char* s);
+
+// Parses IR text into a package handle. `filename` is used only for
+// diagnostic messages and may be null. On success the caller owns the
+// returned package and must release it with `xls_package_free`.
+bool xls_parse_ir_package(const char* ir, const char* filename,
+                          char** error_out, struct xls_package** package_out);
+
+// Frees a package. All function-jit handles created from the package must be
+// freed first.
+void xls_package_free(struct xls_package* package);
+
+// JIT-compiles the function named `function_name` in `package`. On success
+// the caller owns the returned handle and must release it with
+// `xls_function_jit_free` before freeing the package.
+bool xls_function_jit_create(struct xls_package* package,
+                             const char* function_name, char** error_out,
+                             struct xls_function_jit** jit_out);
+
+// Frees a function-jit handle.
+void xls_function_jit_free(struct xls_function_jit* jit);
+
+// Returns the number of arguments of the compiled function.
+int64_t xls_function_jit_arg_count(const struct xls_function_jit* jit);
+
+// Returns the required size in bytes of the buffer for argument `arg_index`.
+int64_t xls_function_jit_arg_buffer_size(const struct xls_function_jit* jit,
+                                         int64_t arg_index);
+
+// Returns the required size in bytes of the result buffer.
+int64_t xls_function_jit_result_buffer_size(
+    const struct xls_function_jit* jit);
+
+// Evaluates the compiled function. `arg_buffers` holds `arg_count` pointers
+// (one per argument, in signature order) to buffers of at least the sizes
+// reported by `xls_function_jit_arg_buffer_size`; the result is written to
+// `result_buffer` which must hold at least
+// `xls_function_jit_result_buffer_size` bytes. Performs no heap allocation
+// on the success path. Fails if an assertion in the function fires.
+bool xls_function_jit_run(struct xls_function_jit* jit,
+                          const uint8_t* const* arg_buffers, int64_t arg_count,
+                          uint8_t* result_buffer, char** error_out);
+
+// Writes the IR-text value `value_text` (e.g. "bits[32]:42") into `buffer`
+// in the native layout of argument `arg_index`. Intended for setup and
+// debugging; hot paths should fill buffers directly.
+bool xls_function_jit_arg_value_to_buffer(const struct xls_function_jit* jit,
+                                          int64_t arg_index,
+                                          const char* value_text,
+                                          uint8_t* buffer, char** error_out);
+
+// Converts the contents of a result buffer to IR value text. On success
+// `value_text_out` is heap-allocated and must be released with
+// `xls_c_str_free`.
+bool xls_function_jit_result_buffer_to_value(
+    const struct xls_function_jit* jit, const uint8_t* result_buffer,
+    char** value_text_out, char** error_out);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // XLS_PUBLIC_C_API_H_
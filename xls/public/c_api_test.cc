@@ -0,0 +1,103 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/public/c_api.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using ::testing::HasSubstr;
+
+constexpr const char* kPackageIr = R"(package test
+
+fn add_one(x: bits[32]) -> bits[32] {
+  literal.2: bits[32] = literal(value=1, id=2)
+  ret add.3: bits[32] = add(x, literal.2, id=3)
+}
+)";
+
+TEST(CApiTest, ParseRunAndConvert) {
+  char* error = nullptr;
+  struct xls_package* package = nullptr;
+  ASSERT_TRUE(xls_parse_ir_package(kPackageIr, "test.ir", &error, &package));
+
+  struct xls_function_jit* jit = nullptr;
+  ASSERT_TRUE(xls_function_jit_create(package, "add_one", &error, &jit));
+
+  ASSERT_EQ(xls_function_jit_arg_count(jit), 1);
+  std::vector<uint8_t> arg(xls_function_jit_arg_buffer_size(jit, 0));
+  std::vector<uint8_t> result(xls_function_jit_result_buffer_size(jit));
+  ASSERT_TRUE(xls_function_jit_arg_value_to_buffer(jit, 0, "bits[32]:41",
+                                                   arg.data(), &error));
+
+  const uint8_t* arg_buffers[] = {arg.data()};
+  // Run twice to exercise the reused per-handle scratch state.
+  for (int64_t i = 0; i < 2; ++i) {
+    ASSERT_TRUE(
+        xls_function_jit_run(jit, arg_buffers, 1, result.data(), &error));
+  }
+
+  char* value_text = nullptr;
+  ASSERT_TRUE(xls_function_jit_result_buffer_to_value(jit, result.data(),
+                                                      &value_text, &error));
+  EXPECT_EQ(std::string(value_text), "bits[32]:0x2a");
+  xls_c_str_free(value_text);
+
+  xls_function_jit_free(jit);
+  xls_package_free(package);
+}
+
+TEST(CApiTest, ErrorsAreReported) {
+  char* error = nullptr;
+  struct xls_package* package = nullptr;
+  ASSERT_FALSE(
+      xls_parse_ir_package("not an ir package", "bad.ir", &error, &package));
+  ASSERT_NE(error, nullptr);
+  xls_c_str_free(error);
+  error = nullptr;
+
+  ASSERT_TRUE(xls_parse_ir_package(kPackageIr, "test.ir", &error, &package));
+  struct xls_function_jit* jit = nullptr;
+  EXPECT_FALSE(
+      xls_function_jit_create(package, "no_such_function", &error, &jit));
+  ASSERT_NE(error, nullptr);
+  EXPECT_THAT(std::string(error), HasSubstr("no_such_function"));
+  xls_c_str_free(error);
+  error = nullptr;
+
+  ASSERT_TRUE(xls_function_jit_create(package, "add_one", &error, &jit));
+  std::vector<uint8_t> arg(xls_function_jit_arg_buffer_size(jit, 0));
+  EXPECT_FALSE(xls_function_jit_arg_value_to_buffer(jit, 0, "bits[8]:1",
+                                                    arg.data(), &error));
+  ASSERT_NE(error, nullptr);
+  EXPECT_THAT(std::string(error), HasSubstr("does not match"));
+  xls_c_str_free(error);
+  error = nullptr;
+
+  std::vector<uint8_t> result(xls_function_jit_result_buffer_size(jit));
+  EXPECT_FALSE(xls_function_jit_run(jit, nullptr, 0, result.data(), &error));
+  ASSERT_NE(error, nullptr);
+  xls_c_str_free(error);
+
+  xls_function_jit_free(jit);
+  xls_package_free(package);
+}
+
+}  // namespace
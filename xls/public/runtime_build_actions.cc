@@ -21,6 +21,7 @@
 
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/status/status_macros.h"
@@ -112,4 +113,40 @@ absl::StatusOr<ScheduleAndCodegenResult> ScheduleAndCodegenPackage(
   };
 }
 
+absl::StatusOr<ScheduleAndCodegenResult> OptimizeScheduleAndCodegenPackage(
+    Package* p,
+    const SchedulingOptionsFlagsProto& scheduling_options_flags_proto,
+    const CodegenFlagsProto& codegen_flags_proto, bool with_delay_model,
+    const OptimizeAndCodegenOptions& options) {
+  const tools::OptOptions opt_options = {
+      .opt_level = options.opt_level.value_or(xls::kMaxOptLevel),
+      .top = options.top,
+  };
+  XLS_RETURN_IF_ERROR(tools::OptimizePackage(p, opt_options));
+  const bool dump_stages = !options.stage_dump_dir.empty();
+  if (dump_stages) {
+    XLS_RETURN_IF_ERROR(SetFileContents(
+        std::filesystem::path(options.stage_dump_dir) /
+            absl::StrCat(p->name(), ".opt.ir"),
+        p->DumpIr()));
+  }
+  XLS_ASSIGN_OR_RETURN(
+      ScheduleAndCodegenResult result,
+      ScheduleAndCodegenPackage(p, scheduling_options_flags_proto,
+                                codegen_flags_proto, with_delay_model));
+  if (dump_stages) {
+    if (result.pipeline_schedule_group_proto.has_value()) {
+      XLS_RETURN_IF_ERROR(SetTextProtoFile(
+          std::filesystem::path(options.stage_dump_dir) /
+              absl::StrCat(p->name(), ".schedule.textproto"),
+          *result.pipeline_schedule_group_proto));
+    }
+    XLS_RETURN_IF_ERROR(SetFileContents(
+        std::filesystem::path(options.stage_dump_dir) /
+            absl::StrCat(p->name(), ".v"),
+        result.module_generator_result.verilog_text));
+  }
+  return result;
+}
+
 }  // namespace xls
@@ -28,6 +28,7 @@
 // compiler remaining stable, users should not depend on the precise output of
 // these actions remaining stable, they will evolve as the XLS system evolves.
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
@@ -121,6 +122,40 @@ absl::StatusOr<ScheduleAndCodegenResult> ScheduleAndCodegenPackage(
     const SchedulingOptionsFlagsProto& scheduling_options_flags_proto,
     const CodegenFlagsProto& codegen_flags_proto, bool with_delay_model);
 
+// Options for OptimizeScheduleAndCodegenPackage.
+struct OptimizeAndCodegenOptions {
+  // Name of the top-level entity to optimize for. If empty the package's
+  // current top is used.
+  std::string top;
+
+  // Optimization level; unset runs the pipeline at the maximum level.
+  std::optional<int64_t> opt_level;
+
+  // If nonempty, the output of each flow stage is also written into this
+  // directory for debugging: the optimized IR as "<package>.opt.ir", the
+  // pipeline schedule as "<package>.schedule.textproto", and the generated
+  // Verilog as "<package>.v". Nothing is written when empty.
+  std::string stage_dump_dir;
+};
+
+// Runs the whole backend flow -- optimization, scheduling, and codegen -- on
+// a single in-memory package. This is the single-process equivalent of
+// piping `opt_main` output into `codegen_main` but with no serialization,
+// parsing, or dumping of intermediate IR between stages; it is built from the
+// same libraries that back those tools so the results are identical.
+//
+// Args:
+//  p: The package to optimize, schedule and codegen; optimized in place.
+//  scheduling_options_flags_proto: The scheduling params.
+//  codegen_flags_proto: The codegen params.
+//  with_delay_model: Whether the delay model should be used for codegen.
+//  options: Flow-level options; see OptimizeAndCodegenOptions.
+absl::StatusOr<ScheduleAndCodegenResult> OptimizeScheduleAndCodegenPackage(
+    Package* p,
+    const SchedulingOptionsFlagsProto& scheduling_options_flags_proto,
+    const CodegenFlagsProto& codegen_flags_proto, bool with_delay_model,
+    const OptimizeAndCodegenOptions& options = {});
+
 }  // namespace xls
 
 #endif  // XLS_PUBLIC_RUNTIME_BUILD_ACTIONS_H_
@@ -27,6 +27,8 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/container/btree_map.h"
 #include "absl/container/btree_set.h"
 #include "absl/container/flat_hash_map.h"
@@ -35,18 +37,22 @@
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xls/common/casts.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/data_structures/graph_coloring.h"
 #include "xls/data_structures/transitive_closure.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_ops.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/function_base.h"
+#include "xls/ir/lsb_or_msb.h"
 #include "xls/ir/node.h"
 #include "xls/ir/node_util.h"
 #include "xls/ir/nodes.h"
@@ -96,12 +102,230 @@ bool HasIntersection(const absl::flat_hash_set<T>& lhs,
                      [&bigger](T element) { return bigger.contains(element); });
 }
 
-Z3_lbool RunSolver(Z3_context c, Z3_ast asserted) {
-  Z3_solver solver = solvers::z3::CreateSolver(c, 1);
-  Z3_solver_assert(c, solver, asserted);
-  Z3_lbool satisfiable = Z3_solver_check(c, solver);
-  Z3_solver_dec_ref(c, solver);
-  return satisfiable;
+// Runs satisfiability queries against a single long-lived solver. Each query
+// is asserted inside its own push/pop scope, so the solver (and whatever it
+// has learned from earlier queries over the same translation) is reused
+// rather than constructed anew for every candidate pair.
+class IncrementalSolverSession {
+ public:
+  explicit IncrementalSolverSession(Z3_context ctx)
+      : ctx_(ctx), solver_(solvers::z3::CreateSolver(ctx, 1)) {}
+  ~IncrementalSolverSession() { Z3_solver_dec_ref(ctx_, solver_); }
+
+  IncrementalSolverSession(const IncrementalSolverSession&) = delete;
+  IncrementalSolverSession& operator=(const IncrementalSolverSession&) = delete;
+
+  Z3_lbool Check(Z3_ast asserted) {
+    Z3_solver_push(ctx_, solver_);
+    Z3_solver_assert(ctx_, solver_, asserted);
+    Z3_lbool satisfiable = Z3_solver_check(ctx_, solver_);
+    Z3_solver_pop(ctx_, solver_, 1);
+    return satisfiable;
+  }
+
+ private:
+  Z3_context ctx_;
+  Z3_solver solver_;
+};
+
+// Returns true if a node with the given op is fully described, for the
+// purposes of AppendStructuralKey, by its op, its type and the keys of its
+// operands. Ops carrying attributes that are not reflected in the type (e.g.
+// bit_slice's start) are serialized explicitly in AppendStructuralKey; any
+// other op returns false here so that distinct queries can never alias in the
+// verdict cache.
+bool OpHasNoHiddenAttributes(Op op) {
+  switch (op) {
+    case Op::kAdd:
+    case Op::kSub:
+    case Op::kUMul:
+    case Op::kSMul:
+    case Op::kUDiv:
+    case Op::kSDiv:
+    case Op::kUMod:
+    case Op::kSMod:
+    case Op::kAnd:
+    case Op::kOr:
+    case Op::kXor:
+    case Op::kNand:
+    case Op::kNor:
+    case Op::kNot:
+    case Op::kNeg:
+    case Op::kIdentity:
+    case Op::kAndReduce:
+    case Op::kOrReduce:
+    case Op::kXorReduce:
+    case Op::kEq:
+    case Op::kNe:
+    case Op::kUGt:
+    case Op::kUGe:
+    case Op::kULt:
+    case Op::kULe:
+    case Op::kSGt:
+    case Op::kSGe:
+    case Op::kSLt:
+    case Op::kSLe:
+    case Op::kShll:
+    case Op::kShrl:
+    case Op::kShra:
+    case Op::kConcat:
+    case Op::kReverse:
+    case Op::kZeroExt:
+    case Op::kSignExt:
+    case Op::kDynamicBitSlice:
+    case Op::kBitSliceUpdate:
+    case Op::kEncode:
+    case Op::kDecode:
+    case Op::kOneHotSel:
+    case Op::kPrioritySel:
+    case Op::kTuple:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Appends a canonical serialization of the expression DAG rooted at `node` to
+// `out`. Every visited node is numbered in order of first visit and revisits
+// emit a back-reference, so two expressions serialize identically iff they are
+// structurally identical up to a renaming of leaves. Leaves are params and
+// side-effecting ops, which the Z3 translation models as unconstrained
+// variables; identical serializations therefore yield equisatisfiable
+// formulas. Returns false if the expression contains a node which cannot be
+// canonically serialized.
+bool AppendStructuralKey(Node* node,
+                         absl::flat_hash_map<Node*, int64_t>& numbering,
+                         std::string& out) {
+  if (auto it = numbering.find(node); it != numbering.end()) {
+    absl::StrAppend(&out, "ref", it->second);
+    return true;
+  }
+  numbering.insert({node, static_cast<int64_t>(numbering.size())});
+  if (node->Is<Literal>()) {
+    absl::StrAppend(&out, "lit{", node->As<Literal>()->value().ToString(),
+                    "}");
+    return true;
+  }
+  if (node->Is<Param>() || OpIsSideEffecting(node->op())) {
+    absl::StrAppend(&out, "var{", node->GetType()->ToString(), "}");
+    return true;
+  }
+  if (node->Is<TupleIndex>()) {
+    absl::StrAppend(&out, "tuple_index{", node->As<TupleIndex>()->index(),
+                    "}");
+  } else if (node->Is<BitSlice>()) {
+    absl::StrAppend(&out, "bit_slice{", node->As<BitSlice>()->start(), "}");
+  } else if (node->Is<OneHot>()) {
+    absl::StrAppend(
+        &out, "one_hot{",
+        node->As<OneHot>()->priority() == LsbOrMsb::kLsb ? "lsb" : "msb", "}");
+  } else if (node->Is<Select>()) {
+    absl::StrAppend(
+        &out, "sel{",
+        node->As<Select>()->default_value().has_value() ? "default" : "", "}");
+  } else if (OpHasNoHiddenAttributes(node->op())) {
+    absl::StrAppend(&out, OpToString(node->op()));
+  } else {
+    return false;
+  }
+  absl::StrAppend(&out, ":", node->GetType()->ToString(), "(");
+  for (Node* operand : node->operands()) {
+    if (!AppendStructuralKey(operand, numbering, out)) {
+      return false;
+    }
+    absl::StrAppend(&out, ",");
+  }
+  absl::StrAppend(&out, ")");
+  return true;
+}
+
+// Returns a canonical cache key for the satisfiability of `a` (or of `a ∧ b`
+// when `b` is non-null), or std::nullopt when the expression cannot be
+// canonically serialized.
+std::optional<std::string> StructuralQueryKey(Node* a, Node* b = nullptr) {
+  absl::flat_hash_map<Node*, int64_t> numbering;
+  std::string key;
+  if (!AppendStructuralKey(a, numbering, key)) {
+    return std::nullopt;
+  }
+  if (b != nullptr) {
+    absl::StrAppend(&key, "&");
+    if (!AppendStructuralKey(b, numbering, key)) {
+      return std::nullopt;
+    }
+  }
+  return key;
+}
+
+// Process-wide memoization of definitive solver verdicts, keyed by the
+// canonical query serialization produced by StructuralQueryKey. The scheduling
+// pipeline runs the mutual exclusion pass more than once (and schedulers may
+// be rerun during design space exploration); structurally identical queries
+// then resolve without touching the solver even though the IR nodes involved
+// are different objects by the time of the rerun. Verdicts of `unknown` are
+// not stored because they depend on the rlimit in effect when the query ran.
+class SolverVerdictCache {
+ public:
+  static SolverVerdictCache& Singleton() {
+    static absl::NoDestructor<SolverVerdictCache> cache;
+    return *cache;
+  }
+
+  std::optional<bool> GetSatisfiable(const std::string& key) const {
+    absl::MutexLock lock(&mu_);
+    auto it = verdicts_.find(key);
+    if (it == verdicts_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  void SetSatisfiable(const std::string& key, bool satisfiable) {
+    absl::MutexLock lock(&mu_);
+    verdicts_.insert({key, satisfiable});
+  }
+
+ private:
+  mutable absl::Mutex mu_;
+  absl::flat_hash_map<std::string, bool> verdicts_ ABSL_GUARDED_BY(mu_);
+};
+
+// A single `a ∧ b` satisfiability query, produced by the pair filtering in
+// ComputeMutualExclusion and resolved either from the verdict cache or by a
+// solver worker.
+struct PairQuery {
+  Node* a;
+  Node* b;
+  // Whether proving this pair mutually exclusive is required for channel
+  // legalization; if so the query runs without an rlimit.
+  bool required_for_compilation;
+  // Verdict cache key; empty when the predicates cannot be serialized.
+  std::string cache_key;
+  Z3_lbool satisfiable = Z3_L_UNDEF;
+};
+
+// Resolves `queries` against a translation of their common function in a
+// single incremental solver session. Used both on the serial path and by each
+// parallel worker; each caller must pass a translator whose context is not
+// concurrently used by any other thread.
+absl::Status SolvePairQueries(solvers::z3::IrTranslator* translator,
+                              int64_t z3_rlimit,
+                              absl::Span<PairQuery* const> queries) {
+  Z3_context ctx = translator->ctx();
+  solvers::z3::ScopedErrorHandler seh(ctx);
+  IncrementalSolverSession session(ctx);
+  for (PairQuery* query : queries) {
+    Z3_ast z3_a = translator->GetTranslation(query->a);
+    Z3_ast z3_b = translator->GetTranslation(query->b);
+
+    // We try to find out if `a ∧ b` is satisfiable, which is true iff
+    // `a NAND b` is not valid.
+    Z3_ast a_and_b =
+        solvers::z3::BitVectorToBoolean(ctx, Z3_mk_bvand(ctx, z3_a, z3_b));
+    translator->SetRlimit(query->required_for_compilation ? 0 : z3_rlimit);
+    query->satisfiable = session.Check(a_and_b);
+  }
+  return seh.status();
 }
 
 // Returns a list of all predicates in a deterministic order, paired with their
@@ -966,31 +1190,51 @@ absl::Status ComputeMutualExclusion(Predicates* p, FunctionBase* f,
 
   std::vector<std::pair<Node*, int64_t>> predicate_nodes = PredicateNodes(p, f);
 
+  SolverVerdictCache& cache = SolverVerdictCache::Singleton();
+
   // Determine for each predicate whether it is always false using Z3.
   // Dead nodes are mutually exclusive with all other nodes, so this can reduce
   // the runtime by doing only a linear amount of Z3 calls to remove
   // quadratically many Z3 calls.
-  for (const auto& [node, index] : predicate_nodes) {
-    Z3_ast translated = translator->GetTranslation(node);
-    // Check whether it's possible for `node` to need to be proven mutually
-    // exclusive with some other node in order for channel operations to be
-    // legal; if so, we remove the rlimit on the prover.
-    XLS_ASSIGN_OR_RETURN(
-        bool required_for_compilation,
-        ControlsContendedProvenMutuallyExclusiveChannel(node, p, f));
-    if (required_for_compilation) {
-      LOG(INFO) << "Removing Z3's rlimit for always-false check on "
-                << node->GetName()
-                << " as mutual exclusion is required for compilation.";
-    }
-    translator->SetRlimit(z3_rlimit);
-    if (RunSolver(ctx, solvers::z3::BitVectorToBoolean(ctx, translated)) ==
-        Z3_L_FALSE) {
-      VLOG(3) << "Proved that " << node << " is always false";
-      // A constant false node is mutually exclusive with all other nodes.
-      for (const auto& [other, other_index] : predicate_nodes) {
-        if (index != other_index) {
-          XLS_RETURN_IF_ERROR(p->MarkMutuallyExclusive(node, other));
+  {
+    IncrementalSolverSession session(ctx);
+    for (const auto& [node, index] : predicate_nodes) {
+      std::optional<std::string> cache_key = StructuralQueryKey(node);
+      std::optional<bool> satisfiable;
+      if (cache_key.has_value()) {
+        satisfiable = cache.GetSatisfiable(*cache_key);
+      }
+      if (!satisfiable.has_value()) {
+        Z3_ast translated = translator->GetTranslation(node);
+        // Check whether it's possible for `node` to need to be proven mutually
+        // exclusive with some other node in order for channel operations to be
+        // legal; if so, we remove the rlimit on the prover.
+        XLS_ASSIGN_OR_RETURN(
+            bool required_for_compilation,
+            ControlsContendedProvenMutuallyExclusiveChannel(node, p, f));
+        if (required_for_compilation) {
+          LOG(INFO) << "Removing Z3's rlimit for always-false check on "
+                    << node->GetName()
+                    << " as mutual exclusion is required for compilation.";
+        }
+        translator->SetRlimit(required_for_compilation ? 0 : z3_rlimit);
+        Z3_lbool verdict =
+            session.Check(solvers::z3::BitVectorToBoolean(ctx, translated));
+        if (verdict == Z3_L_UNDEF) {
+          continue;
+        }
+        satisfiable = (verdict == Z3_L_TRUE);
+        if (cache_key.has_value()) {
+          cache.SetSatisfiable(*cache_key, *satisfiable);
+        }
+      }
+      if (!*satisfiable) {
+        VLOG(3) << "Proved that " << node << " is always false";
+        // A constant false node is mutually exclusive with all other nodes.
+        for (const auto& [other, other_index] : predicate_nodes) {
+          if (index != other_index) {
+            XLS_RETURN_IF_ERROR(p->MarkMutuallyExclusive(node, other));
+          }
         }
       }
     }
@@ -1023,6 +1267,9 @@ absl::Status ComputeMutualExclusion(Predicates* p, FunctionBase* f,
     }
   }
 
+  int64_t cached = 0;
+
+  std::vector<PairQuery> queries;
   for (const auto& [node_a, index_a] : predicate_nodes) {
     XLS_ASSIGN_OR_RETURN(
         absl::flat_hash_set<Channel*> channels_a,
@@ -1043,14 +1290,6 @@ absl::Status ComputeMutualExclusion(Predicates* p, FunctionBase* f,
         continue;
       }
 
-      Z3_ast z3_a = translator->GetTranslation(node_a);
-      Z3_ast z3_b = translator->GetTranslation(node_b);
-
-      // We try to find out if `a ∧ b` is satisfiable, which is true iff
-      // `a NAND b` is not valid.
-      Z3_ast a_and_b =
-          solvers::z3::BitVectorToBoolean(ctx, Z3_mk_bvand(ctx, z3_a, z3_b));
-
       // Check whether `a` and `b` must be proven mutually exclusive in order
       // for channel operations to be legal; if so, we remove the rlimit on the
       // prover.
@@ -1060,31 +1299,112 @@ absl::Status ComputeMutualExclusion(Predicates* p, FunctionBase* f,
       bool required_for_compilation = absl::c_any_of(
           channels_a,
           [&](Channel* channel) { return channels_b.contains(channel); });
-      translator->SetRlimit(required_for_compilation ? 0 : z3_rlimit);
       if (required_for_compilation) {
         LOG(INFO) << "Removing Z3's rlimit for mutual exclusion between "
                   << node_a->GetName() << " and " << node_b->GetName()
                   << " as mutual exclusion is required for compilation.";
       }
-      Z3_lbool satisfiable = RunSolver(ctx, a_and_b);
-
-      if (satisfiable == Z3_L_FALSE) {
-        known_true += 1;
-        XLS_RETURN_IF_ERROR(p->MarkMutuallyExclusive(node_a, node_b));
-      } else if (satisfiable == Z3_L_TRUE) {
-        known_false += 1;
-        XLS_RETURN_IF_ERROR(p->MarkNotMutuallyExclusive(node_a, node_b));
-      } else {
-        unknown += 1;
-        VLOG(3) << "Z3 ran out of time checking mutual exclusion of "
-                << node_a->GetName() << " and " << node_b->GetName();
+
+      std::optional<std::string> cache_key =
+          StructuralQueryKey(node_a, node_b);
+      if (cache_key.has_value()) {
+        if (std::optional<bool> satisfiable = cache.GetSatisfiable(*cache_key);
+            satisfiable.has_value()) {
+          cached += 1;
+          if (*satisfiable) {
+            known_false += 1;
+            XLS_RETURN_IF_ERROR(p->MarkNotMutuallyExclusive(node_a, node_b));
+          } else {
+            known_true += 1;
+            XLS_RETURN_IF_ERROR(p->MarkMutuallyExclusive(node_a, node_b));
+          }
+          continue;
+        }
+      }
+
+      queries.push_back(PairQuery{.a = node_a,
+                                  .b = node_b,
+                                  .required_for_compilation =
+                                      required_for_compilation,
+                                  .cache_key = cache_key.value_or("")});
+    }
+  }
+
+  std::vector<PairQuery*> query_ptrs;
+  query_ptrs.reserve(queries.size());
+  for (PairQuery& query : queries) {
+    query_ptrs.push_back(&query);
+  }
+
+  // Dispatch the remaining queries. The verdicts are independent of each
+  // other, so when there are enough of them to amortize one IR-to-Z3
+  // translation per worker they are sharded across threads; a Z3 context may
+  // only be used by a single thread at a time, so each worker runs an
+  // incremental session against its own translation of `f`.
+  constexpr int64_t kMinQueriesPerWorker = 8;
+  const int64_t num_workers = std::min<int64_t>(
+      std::max<int64_t>(1, AvailableCPUs()),
+      static_cast<int64_t>(queries.size()) / kMinQueriesPerWorker);
+  if (num_workers <= 1) {
+    XLS_RETURN_IF_ERROR(
+        SolvePairQueries(translator.get(), z3_rlimit, query_ptrs));
+  } else {
+    std::vector<absl::Status> worker_statuses(num_workers, absl::OkStatus());
+    std::vector<std::unique_ptr<Thread>> workers;
+    workers.reserve(num_workers);
+    for (int64_t i = 0; i < num_workers; ++i) {
+      const int64_t begin =
+          (static_cast<int64_t>(queries.size()) * i) / num_workers;
+      const int64_t end =
+          (static_cast<int64_t>(queries.size()) * (i + 1)) / num_workers;
+      absl::Span<PairQuery* const> shard =
+          absl::MakeConstSpan(query_ptrs).subspan(begin, end - begin);
+      absl::Status* worker_status = &worker_statuses[i];
+      workers.push_back(
+          std::make_unique<Thread>([f, z3_rlimit, shard, worker_status] {
+            absl::StatusOr<std::unique_ptr<solvers::z3::IrTranslator>>
+                worker_translator = solvers::z3::IrTranslator::
+                    CreateAndTranslate(f, /*allow_unsupported=*/true);
+            if (!worker_translator.ok()) {
+              *worker_status = worker_translator.status();
+              return;
+            }
+            *worker_status =
+                SolvePairQueries(worker_translator->get(), z3_rlimit, shard);
+          }));
+    }
+    for (std::unique_ptr<Thread>& worker : workers) {
+      worker->Join();
+    }
+    for (const absl::Status& worker_status : worker_statuses) {
+      XLS_RETURN_IF_ERROR(worker_status);
+    }
+  }
+
+  for (const PairQuery& query : queries) {
+    if (query.satisfiable == Z3_L_FALSE) {
+      known_true += 1;
+      XLS_RETURN_IF_ERROR(p->MarkMutuallyExclusive(query.a, query.b));
+      if (!query.cache_key.empty()) {
+        cache.SetSatisfiable(query.cache_key, false);
       }
+    } else if (query.satisfiable == Z3_L_TRUE) {
+      known_false += 1;
+      XLS_RETURN_IF_ERROR(p->MarkNotMutuallyExclusive(query.a, query.b));
+      if (!query.cache_key.empty()) {
+        cache.SetSatisfiable(query.cache_key, true);
+      }
+    } else {
+      unknown += 1;
+      VLOG(3) << "Z3 ran out of time checking mutual exclusion of "
+              << query.a->GetName() << " and " << query.b->GetName();
     }
   }
 
   VLOG(3) << "known_false = " << known_false;
   VLOG(3) << "known_true  = " << known_true;
   VLOG(3) << "unknown     = " << unknown;
+  VLOG(3) << "cached      = " << cached;
 
   XLS_RETURN_IF_ERROR(seh.status());
 
@@ -369,6 +369,36 @@ TEST_F(PipelineScheduleTest, TestVerifyTiming) {
               "(3ps): add.3 (1ps) -> neg.4 (1ps) -> sub.5 (1ps)")));
 }
 
+TEST_F(PipelineScheduleTest, SdcSchedulesDisconnectedComponents) {
+  // A function whose dataflow graph has two weakly-connected components
+  // exercises the decomposed SDC path which solves an independent LP per
+  // component.
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  Type* u32 = p->GetBitsType(32);
+  BValue x = fb.Param("x", u32);
+  BValue y = fb.Param("y", u32);
+  // A dead island disconnected from the return value.
+  fb.Negate(fb.Not(y));
+  BValue ret = fb.Not(fb.Negate(x), SourceInfo(), "ret_value");
+  XLS_ASSERT_OK_AND_ASSIGN(Function * func, fb.BuildWithReturnValue(ret));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule schedule,
+      RunPipelineSchedule(
+          func, TestDelayEstimator(),
+          SchedulingOptions().clock_period_ps(2).pipeline_stages(2)));
+
+  EXPECT_EQ(schedule.length(), 2);
+  for (Node* node : func->nodes()) {
+    EXPECT_TRUE(schedule.IsScheduled(node));
+  }
+  // Params are pinned to the first stage and the return value to the last.
+  EXPECT_EQ(schedule.cycle(x.node()), 0);
+  EXPECT_EQ(schedule.cycle(y.node()), 0);
+  EXPECT_EQ(schedule.cycle(ret.node()), 1);
+}
+
 TEST_F(PipelineScheduleTest, ClockPeriodAndPipelineLengthGiven) {
   auto p = CreatePackage();
   FunctionBuilder fb(TestName(), p.get());
@@ -592,6 +622,74 @@ TEST_F(PipelineScheduleTest, SerializeAndDeserialize) {
   }
 }
 
+TEST_F(PipelineScheduleTest, ScheduleHintWarmStart) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  Type* u32 = p->GetBitsType(32);
+  auto x = fb.Param("x", u32);
+  auto y = fb.Param("y", u32);
+  auto z = fb.Param("z", u32);
+  fb.Negate(fb.Concat({(fb.Not(fb.Negate(x | y)) - z) * x, z + z}));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * func, fb.Build());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule schedule,
+      RunPipelineSchedule(
+          func, TestDelayEstimator(),
+          SchedulingOptions().clock_period_ps(2).pipeline_stages(4)));
+
+  // Round-trip the schedule through its proto form (as a design-iteration
+  // flow would) and use it to warm-start an identical solve. The hint must
+  // not change the result.
+  PipelineScheduleProto proto = schedule.ToProto(TestDelayEstimator());
+  PackagePipelineSchedulesProto package_schedules_proto;
+  package_schedules_proto.mutable_schedules()->emplace(func->name(),
+                                                       std::move(proto));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule hint,
+      PipelineSchedule::FromProto(func, package_schedules_proto));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule rescheduled,
+      RunPipelineSchedule(func, TestDelayEstimator(),
+                          SchedulingOptions()
+                              .clock_period_ps(2)
+                              .pipeline_stages(4)
+                              .schedule_hint(hint.GetCycleMap())));
+  EXPECT_EQ(rescheduled.length(), 4);
+  EXPECT_EQ(rescheduled.CountFinalInteriorPipelineRegisters(),
+            schedule.CountFinalInteriorPipelineRegisters());
+}
+
+TEST_F(PipelineScheduleTest, ZeroDelayOpsClusterWithTheirProducer) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue a = fb.Negate(x);
+  // A chain of zero-delay operations fed by `a`; all of them should share
+  // `a`'s scheduling decision.
+  BValue widened = fb.Concat({a, a});
+  BValue sliced = fb.BitSlice(widened, /*start=*/8, /*width=*/32);
+  // A multi-stage chain consuming the slice, so later stages would otherwise
+  // be available to the zero-delay nodes.
+  BValue chain = sliced;
+  for (int64_t i = 0; i < 6; ++i) {
+    chain = fb.Not(fb.Negate(chain));
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(Function * func, fb.Build());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PipelineSchedule schedule,
+      RunPipelineSchedule(func, TestDelayEstimator(),
+                          SchedulingOptions().clock_period_ps(2)));
+
+  // The schedule is node-level: every node has a cycle, and the zero-delay
+  // nodes are in the same cycle as the cluster leader producing their input.
+  EXPECT_GT(schedule.length(), 1);
+  for (Node* node : func->nodes()) {
+    EXPECT_TRUE(schedule.IsScheduled(node)) << node->GetName();
+  }
+  EXPECT_EQ(schedule.cycle(widened.node()), schedule.cycle(a.node()));
+  EXPECT_EQ(schedule.cycle(sliced.node()), schedule.cycle(a.node()));
+}
+
 TEST_F(PipelineScheduleTest, NodeDelayInScheduleProto) {
   // Tests that node and path delays are serialized in the schedule proto
   // using trivial pipeline: 3 stages of 2 x 1-bit inverters.
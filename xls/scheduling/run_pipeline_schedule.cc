@@ -27,6 +27,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/base/log_severity.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/random/distributions.h"
@@ -154,6 +155,59 @@ absl::Status TightenBounds(sched::ScheduleBounds& bounds, FunctionBase* f,
   return absl::OkStatus();
 }
 
+// Returns a map from node to cluster leader which collapses chains of
+// zero-delay operations (bit slices, tuple indices, concats of
+// already-clustered values, ...) into the cluster of the operand producing
+// their input. The SDC scheduler gives all nodes of a cluster a single cycle
+// variable, shrinking the LP; the solved schedule is expanded back to
+// node-level when the cycle map is extracted. Only nodes whose operands all
+// resolve to the same cluster are merged, so scheduling a clustered node in
+// its leader's cycle is always feasible: every constraint on the shared
+// variable is implied by the corresponding node-level constraints. Nodes
+// with their own cycle requirements (side-effecting operations, min_delay
+// nodes, a function's return value, and nodes named by node-targeting
+// scheduling constraints) always keep their own variable.
+absl::StatusOr<absl::flat_hash_map<Node*, Node*>> ComputeZeroDelayClusters(
+    FunctionBase* f, const DelayEstimator& delay_estimator,
+    absl::Span<const SchedulingConstraint> constraints) {
+  absl::flat_hash_set<Node*> pinned;
+  for (const SchedulingConstraint& constraint : constraints) {
+    if (std::holds_alternative<NodeInCycleConstraint>(constraint)) {
+      pinned.insert(std::get<NodeInCycleConstraint>(constraint).GetNode());
+    } else if (std::holds_alternative<DifferenceConstraint>(constraint)) {
+      pinned.insert(std::get<DifferenceConstraint>(constraint).GetA());
+      pinned.insert(std::get<DifferenceConstraint>(constraint).GetB());
+    }
+  }
+
+  absl::flat_hash_map<Node*, Node*> cluster_leader;
+  auto leader_of = [&](Node* node) {
+    auto it = cluster_leader.find(node);
+    return it == cluster_leader.end() ? node : it->second;
+  };
+  for (Node* node : TopoSort(f)) {
+    if (node->operand_count() == 0 || OpIsSideEffecting(node->op()) ||
+        node->Is<MinDelay>() || pinned.contains(node) ||
+        (f->IsFunction() && f->HasImplicitUse(node))) {
+      continue;
+    }
+    XLS_ASSIGN_OR_RETURN(int64_t delay,
+                         delay_estimator.GetOperationDelayInPsFast(node));
+    if (delay != 0) {
+      continue;
+    }
+    // Since we visit in topological order, operand leaders are already fully
+    // resolved; mapping to them directly keeps cluster membership transitive.
+    Node* root = leader_of(node->operand(0));
+    if (absl::c_all_of(node->operands(), [&](Node* operand) {
+          return leader_of(operand) == root;
+        })) {
+      cluster_leader[node] = root;
+    }
+  }
+  return cluster_leader;
+}
+
 // Returns the critical path through the given nodes (ordered topologically).
 absl::StatusOr<int64_t> ComputeCriticalPath(
     absl::Span<Node* const> topo_sort, const DelayEstimator& delay_estimator) {
@@ -165,7 +219,7 @@ absl::StatusOr<int64_t> ComputeCriticalPath(
       node_start = std::max(node_start, node_cp[operand]);
     }
     XLS_ASSIGN_OR_RETURN(int64_t node_delay,
-                         delay_estimator.GetOperationDelayInPs(node));
+                         delay_estimator.GetOperationDelayInPsFast(node));
     node_cp[node] = node_start + node_delay;
     function_cp = std::max(function_cp, node_cp[node]);
   }
@@ -342,6 +396,11 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
                                           : base_delay;
       });
 
+  // Scheduling queries the delay of each node many times; cache the decorated
+  // delays in a flat array indexed by node id.
+  FunctionBaseCachingDelayEstimator cached_input_delay_added(
+      "cached_input_delay_added", f, input_delay_added);
+
   if (options.worst_case_throughput().has_value()) {
     f->SetInitiationInterval(*options.worst_case_throughput());
   }
@@ -354,9 +413,20 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
     // We currently use the SDC scheduler to determine the minimum clock period
     // (if not specified) and worst-case throughput (if minimization is
     // requested), even if we're not using it for the final schedule.
+    // Pre-cluster chains of zero-delay operations so the LP has one cycle
+    // variable per cluster rather than one per node; the solved schedule is
+    // still node-level.
+    XLS_ASSIGN_OR_RETURN(
+        absl::flat_hash_map<Node*, Node*> cluster_leader,
+        ComputeZeroDelayClusters(f, cached_input_delay_added,
+                                 options.constraints()));
     XLS_ASSIGN_OR_RETURN(sdc_scheduler,
-                         SDCScheduler::Create(f, input_delay_added));
+                         SDCScheduler::Create(f, cached_input_delay_added,
+                                              std::move(cluster_leader)));
     XLS_RETURN_IF_ERROR(sdc_scheduler->AddConstraints(options.constraints()));
+    if (options.schedule_hint().has_value()) {
+      sdc_scheduler->SetSolutionHint(*options.schedule_hint());
+    }
   }
 
   int64_t clock_period_ps;
@@ -383,8 +453,9 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
     CHECK(sdc_scheduler != nullptr);
     XLS_ASSIGN_OR_RETURN(
         clock_period_ps,
-        FindMinimumClockPeriod(f, options.pipeline_stages(), input_delay_added,
-                               *sdc_scheduler, options.failure_behavior()));
+        FindMinimumClockPeriod(f, options.pipeline_stages(),
+                               cached_input_delay_added, *sdc_scheduler,
+                               options.failure_behavior()));
 
     if (options.period_relaxation_percent().has_value()) {
       int64_t relaxation_percent = options.period_relaxation_percent().value();
@@ -426,6 +497,7 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
       isdc_options.fanout_driven_path_number =
           options.fdo_fanout_driven_path_number();
       isdc_options.stochastic_ratio = options.fdo_refinement_stochastic_ratio();
+      isdc_options.synthesis_concurrency = options.fdo_synthesis_concurrency();
       isdc_options.path_evaluate_strategy =
           options.fdo_path_evaluate_strategy();
 
@@ -472,8 +544,9 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
               << " ps); finding the shortest feasible clock period...";
           int64_t target_clock_period_ps = clock_period_ps + 1;
           absl::StatusOr<int64_t> min_clock_period_ps = FindMinimumClockPeriod(
-              f, options.pipeline_stages(), input_delay_added, *sdc_scheduler,
-              options.failure_behavior(), target_clock_period_ps);
+              f, options.pipeline_stages(), cached_input_delay_added,
+              *sdc_scheduler, options.failure_behavior(),
+              target_clock_period_ps);
           if (min_clock_period_ps.ok()) {
             if (options.recover_after_minimizing_clock().value_or(false)) {
               LOG(WARNING) << "Continuing with clock period = "
@@ -506,7 +579,7 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
 
         // Check if just increasing the clock period would have helped.
         XLS_ASSIGN_OR_RETURN(int64_t pessimistic_clock_period_ps,
-                             ComputeCriticalPath(f, input_delay_added));
+                             ComputeCriticalPath(f, cached_input_delay_added));
         // Make a copy of failure behavior with explain_feasibility true- we
         // always want to produce an error message because this we are
         // re-running the scheduler for its error message.
@@ -545,7 +618,7 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
     // Run an initial ASAP/ALAP scheduling pass, which we'll refine with the
     // chosen scheduler.
     sched::ScheduleBounds bounds(f, TopoSort(f), clock_period_ps,
-                                 input_delay_added);
+                                 cached_input_delay_added);
     XLS_RETURN_IF_ERROR(TightenBounds(bounds, f, options.pipeline_stages()));
 
     if (options.strategy() == SchedulingStrategy::MIN_CUT) {
@@ -553,8 +626,9 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
                            MinCutScheduler(f,
                                            options.pipeline_stages().value_or(
                                                bounds.max_lower_bound() + 1),
-                                           clock_period_ps, input_delay_added,
-                                           &bounds, options.constraints()));
+                                           clock_period_ps,
+                                           cached_input_delay_added, &bounds,
+                                           options.constraints()));
     } else if (options.strategy() == SchedulingStrategy::RANDOM) {
       std::mt19937_64 gen(options.seed().value_or(0));
 
@@ -585,7 +659,7 @@ absl::StatusOr<PipelineSchedule> RunPipelineSchedule(
   auto schedule = PipelineSchedule(f, cycle_map, options.pipeline_stages());
   XLS_RETURN_IF_ERROR(schedule.Verify());
   XLS_RETURN_IF_ERROR(
-      schedule.VerifyTiming(clock_period_ps, input_delay_added));
+      schedule.VerifyTiming(clock_period_ps, cached_input_delay_added));
   XLS_RETURN_IF_ERROR(schedule.VerifyConstraints(options.constraints(),
                                                  f->GetInitiationInterval()));
 
@@ -16,12 +16,15 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <limits>
+#include <queue>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -53,11 +56,20 @@ ScheduleBounds::ScheduleBounds(FunctionBase* f, std::vector<Node*> topo_sort,
 void ScheduleBounds::Reset() {
   max_lower_bound_ = 0;
   min_upper_bound_ = 0;
-  for (Node* node : topo_sort_) {
+  topo_index_.clear();
+  for (int64_t i = 0; i < static_cast<int64_t>(topo_sort_.size()); ++i) {
+    Node* node = topo_sort_[i];
     bounds_[node] = {0, std::numeric_limits<int64_t>::max()};
+    topo_index_[node] = i;
     max_lower_bound_ = 0;
     min_upper_bound_ = std::numeric_limits<int64_t>::max();
   }
+  lb_in_cycle_delay_.clear();
+  ub_in_cycle_delay_.clear();
+  lb_delays_valid_ = false;
+  ub_delays_valid_ = false;
+  dirty_lb_.clear();
+  dirty_ub_.clear();
 }
 
 std::string ScheduleBounds::ToString() const {
@@ -74,10 +86,14 @@ std::string ScheduleBounds::ToString() const {
 }
 
 absl::Status ScheduleBounds::PropagateLowerBounds() {
+  if (lb_delays_valid_) {
+    return PropagateLowerBoundsIncremental();
+  }
   VLOG(4) << "PropagateLowerBounds()";
   // The delay in picoseconds from the beginning of a cycle to the start of the
-  // node.
-  absl::flat_hash_map<Node*, int64_t> in_cycle_delay;
+  // node. Persisted so later propagations can walk only the affected cone.
+  absl::flat_hash_map<Node*, int64_t>& in_cycle_delay = lb_in_cycle_delay_;
+  in_cycle_delay.clear();
 
   // Compute the lower bound of each node based on the lower bounds of the
   // operands of the node.
@@ -91,7 +107,7 @@ absl::Status ScheduleBounds::PropagateLowerBounds() {
         continue;
       }
       XLS_ASSIGN_OR_RETURN(int64_t operand_delay,
-                           delay_estimator_->GetOperationDelayInPs(operand));
+                           delay_estimator_->GetOperationDelayInPsFast(operand));
       if (operand_lb > lb(node)) {
         VLOG(4) << absl::StreamFormat(
             "    tightened lb to %d because of operand %s", operand_lb,
@@ -104,7 +120,7 @@ absl::Status ScheduleBounds::PropagateLowerBounds() {
           node_in_cycle_delay, in_cycle_delay.at(operand) + operand_delay);
     }
     XLS_ASSIGN_OR_RETURN(int64_t node_delay,
-                         delay_estimator_->GetOperationDelayInPs(node));
+                         delay_estimator_->GetOperationDelayInPsFast(node));
     if (node_delay > clock_period_ps_) {
       return absl::ResourceExhaustedError(absl::StrFormat(
           "Node %s has a greater delay (%dps) than the clock period (%dps)",
@@ -117,13 +133,88 @@ absl::Status ScheduleBounds::PropagateLowerBounds() {
       node_in_cycle_delay = 0;
     }
   }
+  lb_delays_valid_ = true;
+  dirty_lb_.clear();
+  return absl::OkStatus();
+}
+
+absl::Status ScheduleBounds::PropagateLowerBoundsIncremental() {
+  VLOG(4) << "PropagateLowerBoundsIncremental()";
+  // Process the affected cone in topological order via a min-heap of
+  // topological indices. A node's operands are always processed (or left
+  // untouched) before the node itself, so each node is visited at most once.
+  std::priority_queue<std::pair<int64_t, Node*>,
+                      std::vector<std::pair<int64_t, Node*>>, std::greater<>>
+      queue;
+  absl::flat_hash_set<Node*> queued;
+  for (Node* node : dirty_lb_) {
+    queue.emplace(topo_index_.at(node), node);
+    queued.insert(node);
+  }
+  // The bounds of the seed nodes have already been tightened externally, so
+  // their users must be visited even if recomputation leaves the seed's own
+  // state unchanged.
+  absl::flat_hash_set<Node*> seeds = std::move(dirty_lb_);
+  dirty_lb_.clear();
+
+  while (!queue.empty()) {
+    Node* node = queue.top().second;
+    queue.pop();
+
+    // Recompute the node's lower bound and in-cycle delay from its operands;
+    // this mirrors one step of the full propagation pass.
+    const int64_t old_lb = lb(node);
+    const int64_t old_in_cycle_delay = lb_in_cycle_delay_[node];
+    int64_t new_lb = old_lb;
+    for (Node* operand : node->operands()) {
+      new_lb = std::max(new_lb, lb(operand));
+    }
+    int64_t node_in_cycle_delay = 0;
+    for (Node* operand : node->operands()) {
+      if (lb(operand) != new_lb) {
+        continue;
+      }
+      XLS_ASSIGN_OR_RETURN(int64_t operand_delay,
+                           delay_estimator_->GetOperationDelayInPsFast(operand));
+      node_in_cycle_delay = std::max(
+          node_in_cycle_delay, lb_in_cycle_delay_.at(operand) + operand_delay);
+    }
+    XLS_ASSIGN_OR_RETURN(int64_t node_delay,
+                         delay_estimator_->GetOperationDelayInPsFast(node));
+    if (node_in_cycle_delay + node_delay > clock_period_ps_) {
+      // Node does not fit in this cycle. Move to next cycle.
+      new_lb += 1;
+      node_in_cycle_delay = 0;
+    }
+    if (new_lb == old_lb && node_in_cycle_delay == old_in_cycle_delay &&
+        !seeds.contains(node)) {
+      continue;
+    }
+    VLOG(4) << absl::StreamFormat("  %s : lb %d -> %d", node->GetName(), old_lb,
+                                  new_lb);
+    XLS_RETURN_IF_ERROR(TightenNodeLb(node, new_lb));
+    lb_in_cycle_delay_[node] = node_in_cycle_delay;
+    for (Node* user : node->users()) {
+      if (queued.insert(user).second) {
+        queue.emplace(topo_index_.at(user), user);
+      }
+    }
+  }
+  // Drop the entries re-added by the TightenNodeLb calls above; the cone they
+  // affect has already been processed.
+  dirty_lb_.clear();
   return absl::OkStatus();
 }
 
 absl::Status ScheduleBounds::PropagateUpperBounds() {
+  if (ub_delays_valid_) {
+    return PropagateUpperBoundsIncremental();
+  }
   VLOG(4) << "PropagateUpperBounds()";
   // The delay in picoseconds from the end of a cycle to the end of the node.
-  absl::flat_hash_map<Node*, int64_t> in_cycle_delay;
+  // Persisted so later propagations can walk only the affected cone.
+  absl::flat_hash_map<Node*, int64_t>& in_cycle_delay = ub_in_cycle_delay_;
+  in_cycle_delay.clear();
 
   // Compute the upper bound of each node based on the upper bounds of the
   // users of the node.
@@ -139,7 +230,7 @@ absl::Status ScheduleBounds::PropagateUpperBounds() {
         continue;
       }
       XLS_ASSIGN_OR_RETURN(int64_t user_delay,
-                           delay_estimator_->GetOperationDelayInPs(user));
+                           delay_estimator_->GetOperationDelayInPsFast(user));
       if (user_ub < ub(node)) {
         VLOG(4) << absl::StreamFormat(
             "    tightened ub to %d because of user %s", user_ub,
@@ -152,7 +243,7 @@ absl::Status ScheduleBounds::PropagateUpperBounds() {
           std::max(node_in_cycle_delay, in_cycle_delay.at(user) + user_delay);
     }
     XLS_ASSIGN_OR_RETURN(int64_t node_delay,
-                         delay_estimator_->GetOperationDelayInPs(node));
+                         delay_estimator_->GetOperationDelayInPsFast(node));
     if (node_delay > clock_period_ps_) {
       return absl::ResourceExhaustedError(absl::StrFormat(
           "Node %s has a greater delay (%dps) than the clock period (%dps)",
@@ -165,6 +256,77 @@ absl::Status ScheduleBounds::PropagateUpperBounds() {
       node_in_cycle_delay = 0;
     }
   }
+  ub_delays_valid_ = true;
+  dirty_ub_.clear();
+  return absl::OkStatus();
+}
+
+absl::Status ScheduleBounds::PropagateUpperBoundsIncremental() {
+  VLOG(4) << "PropagateUpperBoundsIncremental()";
+  // Process the affected cone in reverse topological order via a max-heap of
+  // topological indices. A node's users are always processed (or left
+  // untouched) before the node itself, so each node is visited at most once.
+  std::priority_queue<std::pair<int64_t, Node*>> queue;
+  absl::flat_hash_set<Node*> queued;
+  for (Node* node : dirty_ub_) {
+    queue.emplace(topo_index_.at(node), node);
+    queued.insert(node);
+  }
+  // The bounds of the seed nodes have already been tightened externally, so
+  // their operands must be visited even if recomputation leaves the seed's own
+  // state unchanged.
+  absl::flat_hash_set<Node*> seeds = std::move(dirty_ub_);
+  dirty_ub_.clear();
+
+  while (!queue.empty()) {
+    Node* node = queue.top().second;
+    queue.pop();
+
+    // Recompute the node's upper bound and in-cycle delay from its users; this
+    // mirrors one step of the full propagation pass.
+    const int64_t old_ub = ub(node);
+    const int64_t old_in_cycle_delay = ub_in_cycle_delay_[node];
+    int64_t new_ub = old_ub;
+    for (Node* user : node->users()) {
+      if (ub(user) != std::numeric_limits<int64_t>::max()) {
+        new_ub = std::min(new_ub, ub(user));
+      }
+    }
+    int64_t node_in_cycle_delay = 0;
+    for (Node* user : node->users()) {
+      if (ub(user) == std::numeric_limits<int64_t>::max() ||
+          ub(user) != new_ub) {
+        continue;
+      }
+      XLS_ASSIGN_OR_RETURN(int64_t user_delay,
+                           delay_estimator_->GetOperationDelayInPsFast(user));
+      node_in_cycle_delay = std::max(node_in_cycle_delay,
+                                     ub_in_cycle_delay_.at(user) + user_delay);
+    }
+    XLS_ASSIGN_OR_RETURN(int64_t node_delay,
+                         delay_estimator_->GetOperationDelayInPsFast(node));
+    if (node_in_cycle_delay + node_delay > clock_period_ps_) {
+      // Node does not fit in this cycle. Move to previous cycle.
+      new_ub -= 1;
+      node_in_cycle_delay = 0;
+    }
+    if (new_ub == old_ub && node_in_cycle_delay == old_in_cycle_delay &&
+        !seeds.contains(node)) {
+      continue;
+    }
+    VLOG(4) << absl::StreamFormat("  %s : ub %d -> %d", node->GetName(), old_ub,
+                                  new_ub);
+    XLS_RETURN_IF_ERROR(TightenNodeUb(node, new_ub));
+    ub_in_cycle_delay_[node] = node_in_cycle_delay;
+    for (Node* operand : node->operands()) {
+      if (queued.insert(operand).second) {
+        queue.emplace(topo_index_.at(operand), operand);
+      }
+    }
+  }
+  // Drop the entries re-added by the TightenNodeUb calls above; the cone they
+  // affect has already been processed.
+  dirty_ub_.clear();
   return absl::OkStatus();
 }
 
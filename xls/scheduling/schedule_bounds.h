@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
@@ -86,7 +87,13 @@ class ScheduleBounds {
           absl::StrFormat("Unable to tighten the lower bound of node %s to %d.",
                           node->GetName(), value));
     }
-    bounds_.at(node).first = std::max(bounds_.at(node).first, value);
+    std::pair<int64_t, int64_t>& node_bounds = bounds_.at(node);
+    if (value > node_bounds.first) {
+      node_bounds.first = value;
+      // Remember the change so the next propagation only needs to walk the
+      // affected cone.
+      dirty_lb_.insert(node);
+    }
     max_lower_bound_ = std::max(max_lower_bound_, value);
     return absl::OkStatus();
   }
@@ -100,7 +107,11 @@ class ScheduleBounds {
           absl::StrFormat("Unable to tighten the upper bound of node %s to %d.",
                           node->GetName(), value));
     }
-    bounds_.at(node).second = std::min(bounds_.at(node).second, value);
+    std::pair<int64_t, int64_t>& node_bounds = bounds_.at(node);
+    if (value < node_bounds.second) {
+      node_bounds.second = value;
+      dirty_ub_.insert(node);
+    }
     min_upper_bound_ = std::min(min_upper_bound_, value);
     return absl::OkStatus();
   }
@@ -117,10 +128,20 @@ class ScheduleBounds {
   // throughout the graph. This method only tightens bounds (increases lower
   // bounds and decreases upper bounds). Returns an error if propagation results
   // in infeasible bounds (lower bound is greater than upper bound for a node).
+  //
+  // The first call walks the whole function; subsequent calls only walk the
+  // cone affected by bounds tightened since the previous propagation.
   absl::Status PropagateLowerBounds();
   absl::Status PropagateUpperBounds();
 
  private:
+  // Incremental forms of the propagation methods which only visit the cone
+  // reachable from the nodes whose bounds have been tightened since the last
+  // propagation. Requires a previous full propagation to have populated the
+  // in-cycle delay state.
+  absl::Status PropagateLowerBoundsIncremental();
+  absl::Status PropagateUpperBoundsIncremental();
+
   // A topological sort of the nodes in the function.
   std::vector<Node*> topo_sort_;
 
@@ -132,6 +153,25 @@ class ScheduleBounds {
 
   int64_t max_lower_bound_;
   int64_t min_upper_bound_;
+
+  // Position of each node in `topo_sort_`; used to process only the affected
+  // cone in (reverse) topological order during incremental propagation.
+  absl::flat_hash_map<Node*, int64_t> topo_index_;
+
+  // The delay from the start (end) of a node's cycle to the start (end) of the
+  // node as computed by the last lower (upper) bound propagation. Persisted so
+  // that incremental propagation can extend combinational paths through
+  // unchanged nodes. Only meaningful when the corresponding `*_delays_valid_`
+  // flag is set.
+  absl::flat_hash_map<Node*, int64_t> lb_in_cycle_delay_;
+  absl::flat_hash_map<Node*, int64_t> ub_in_cycle_delay_;
+  bool lb_delays_valid_ = false;
+  bool ub_delays_valid_ = false;
+
+  // Nodes whose lower (upper) bound has been tightened since the last lower
+  // (upper) bound propagation.
+  absl::flat_hash_set<Node*> dirty_lb_;
+  absl::flat_hash_set<Node*> dirty_ub_;
 };
 
 }  // namespace sched
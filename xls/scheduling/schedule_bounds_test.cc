@@ -165,6 +165,42 @@ TEST_F(ScheduleBoundsTest, SimpleExpressionTightenBounds) {
   EXPECT_EQ(bounds.lb(result.node()), 23);
 }
 
+TEST_F(ScheduleBoundsTest, IncrementalPropagationMatchesRecompute) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(32));
+  auto a = fb.Not(x);
+  auto b = fb.Not(a);
+  auto c = fb.Not(b);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  ScheduleBounds bounds(f, /*clock_period_ps=*/1, delay_estimator_);
+  XLS_ASSERT_OK(bounds.PropagateLowerBounds());
+  EXPECT_EQ(bounds.lb(a.node()), 0);
+  EXPECT_EQ(bounds.lb(b.node()), 1);
+  EXPECT_EQ(bounds.lb(c.node()), 2);
+
+  // Tightening a node in the middle of the chain and repropagating (which
+  // takes the incremental path) should push the change through the downstream
+  // cone only.
+  XLS_ASSERT_OK(bounds.TightenNodeLb(b.node(), 5));
+  XLS_ASSERT_OK(bounds.PropagateLowerBounds());
+  EXPECT_EQ(bounds.lb(x.node()), 0);
+  EXPECT_EQ(bounds.lb(a.node()), 0);
+  EXPECT_EQ(bounds.lb(b.node()), 5);
+  EXPECT_EQ(bounds.lb(c.node()), 6);
+
+  // A fresh ScheduleBounds given the same tightening computes the same
+  // fixpoint from scratch.
+  ScheduleBounds recompute(f, /*clock_period_ps=*/1, delay_estimator_);
+  XLS_ASSERT_OK(recompute.TightenNodeLb(b.node(), 5));
+  XLS_ASSERT_OK(recompute.PropagateLowerBounds());
+  EXPECT_EQ(recompute.lb(x.node()), bounds.lb(x.node()));
+  EXPECT_EQ(recompute.lb(a.node()), bounds.lb(a.node()));
+  EXPECT_EQ(recompute.lb(b.node()), bounds.lb(b.node()));
+  EXPECT_EQ(recompute.lb(c.node()), bounds.lb(c.node()));
+}
+
 }  // namespace
 }  // namespace sched
 }  // namespace xls
@@ -0,0 +1,226 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/scheduling/schedule_explorer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
+#include "xls/delay_model/delay_estimator.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/scheduling/pipeline_schedule.h"
+#include "xls/scheduling/run_pipeline_schedule.h"
+#include "xls/scheduling/schedule_exploration.pb.h"
+#include "xls/scheduling/scheduling_options.h"
+
+namespace xls {
+namespace {
+
+// A delay estimator backed by a map populated once up front. The map is
+// immutable after construction so the estimator may be shared read-only by
+// concurrently running schedulers.
+class PrecomputedDelayEstimator : public DelayEstimator {
+ public:
+  PrecomputedDelayEstimator(std::string_view name,
+                            absl::flat_hash_map<Node*, int64_t> delays)
+      : DelayEstimator(name), delays_(std::move(delays)) {}
+
+  absl::StatusOr<int64_t> GetOperationDelayInPs(Node* node) const override {
+    auto it = delays_.find(node);
+    XLS_RET_CHECK(it != delays_.end())
+        << "No precomputed delay for node: " << node->GetName();
+    return it->second;
+  }
+
+ private:
+  absl::flat_hash_map<Node*, int64_t> delays_;
+};
+
+// Returns the longest intra-stage combinational path of `schedule` in
+// picoseconds: the clock period the schedule actually achieves under the
+// delay model.
+absl::StatusOr<int64_t> AchievedClockPeriodPs(
+    const PipelineSchedule& schedule, const DelayEstimator& delay_estimator) {
+  int64_t achieved_ps = 0;
+  absl::flat_hash_map<Node*, int64_t> path_delay;
+  for (int64_t stage = 0; stage < schedule.length(); ++stage) {
+    // Nodes within a cycle are ordered topologically.
+    for (Node* node : schedule.nodes_in_cycle(stage)) {
+      int64_t node_start = 0;
+      for (Node* operand : node->operands()) {
+        if (schedule.IsScheduled(operand) &&
+            schedule.cycle(operand) == stage) {
+          node_start = std::max(node_start, path_delay.at(operand));
+        }
+      }
+      XLS_ASSIGN_OR_RETURN(int64_t node_delay,
+                           delay_estimator.GetOperationDelayInPs(node));
+      path_delay[node] = node_start + node_delay;
+      achieved_ps = std::max(achieved_ps, path_delay[node]);
+    }
+  }
+  return achieved_ps;
+}
+
+// Fills the result fields of `proto` from a scheduling outcome.
+absl::Status RecordOutcome(const absl::StatusOr<PipelineSchedule>& schedule,
+                           const DelayEstimator& delay_estimator,
+                           ScheduleExplorationPointProto* proto) {
+  if (!schedule.ok()) {
+    proto->set_feasible(false);
+    proto->set_error(std::string(schedule.status().message()));
+    return absl::OkStatus();
+  }
+  proto->set_feasible(true);
+  proto->set_pipeline_stages(schedule->length());
+  XLS_ASSIGN_OR_RETURN(int64_t achieved_ps,
+                       AchievedClockPeriodPs(*schedule, delay_estimator));
+  proto->set_clock_period_ps(achieved_ps);
+  proto->set_pipeline_register_bits(
+      schedule->CountFinalInteriorPipelineRegisters());
+  return absl::OkStatus();
+}
+
+// Marks the feasible points of `report` which no other feasible point
+// dominates in (pipeline_stages, clock_period_ps, pipeline_register_bits).
+void MarkParetoFrontier(ScheduleExplorationReportProto& report) {
+  auto dominates = [](const ScheduleExplorationPointProto& a,
+                      const ScheduleExplorationPointProto& b) {
+    return a.pipeline_stages() <= b.pipeline_stages() &&
+           a.clock_period_ps() <= b.clock_period_ps() &&
+           a.pipeline_register_bits() <= b.pipeline_register_bits() &&
+           (a.pipeline_stages() < b.pipeline_stages() ||
+            a.clock_period_ps() < b.clock_period_ps() ||
+            a.pipeline_register_bits() < b.pipeline_register_bits());
+  };
+  for (ScheduleExplorationPointProto& point : *report.mutable_points()) {
+    if (!point.feasible()) {
+      continue;
+    }
+    bool dominated = false;
+    for (const ScheduleExplorationPointProto& other : report.points()) {
+      if (other.feasible() && dominates(other, point)) {
+        dominated = true;
+        break;
+      }
+    }
+    point.set_on_pareto_frontier(!dominated);
+  }
+}
+
+}  // namespace
+
+absl::StatusOr<ScheduleExplorationReportProto> ExploreSchedules(
+    FunctionBase* f, const DelayEstimator& delay_estimator,
+    const SchedulingOptions& base_options,
+    absl::Span<const ScheduleExplorationPoint> points, int64_t parallelism) {
+  XLS_RET_CHECK_GE(parallelism, 0);
+  // FDO and worst-case-throughput minimization mutate the IR while
+  // scheduling, which is unsound when configurations share `f`.
+  XLS_RET_CHECK(!base_options.use_fdo())
+      << "ExploreSchedules does not support FDO";
+  XLS_RET_CHECK(!base_options.worst_case_throughput().has_value() &&
+                !base_options.minimize_worst_case_throughput().has_value())
+      << "ExploreSchedules does not support worst-case throughput options";
+
+  // Compute the delay of every node once; the schedulers for each
+  // configuration share the precomputed delays read-only.
+  absl::flat_hash_map<Node*, int64_t> delays;
+  delays.reserve(f->node_count());
+  for (Node* node : f->nodes()) {
+    XLS_ASSIGN_OR_RETURN(delays[node],
+                         delay_estimator.GetOperationDelayInPs(node));
+  }
+  PrecomputedDelayEstimator precomputed(
+      absl::StrCat("precomputed_", delay_estimator.name()), std::move(delays));
+
+  ScheduleExplorationReportProto report;
+  report.set_function_base(f->name());
+  std::vector<ScheduleExplorationPointProto*> protos;
+  protos.reserve(points.size());
+  for (const ScheduleExplorationPoint& point : points) {
+    ScheduleExplorationPointProto* proto = report.add_points();
+    if (point.pipeline_stages.has_value()) {
+      proto->set_requested_pipeline_stages(*point.pipeline_stages);
+    }
+    if (point.clock_period_ps.has_value()) {
+      proto->set_requested_clock_period_ps(*point.clock_period_ps);
+    }
+    protos.push_back(proto);
+  }
+
+  // Schedule the configurations concurrently. Each worker claims the next
+  // unscheduled configuration and writes only its own result slot.
+  std::vector<absl::Status> statuses(points.size(), absl::OkStatus());
+  std::atomic<size_t> next_point(0);
+  auto explore_point = [&](size_t i) {
+    SchedulingOptions options = base_options;
+    if (points[i].pipeline_stages.has_value()) {
+      options.pipeline_stages(*points[i].pipeline_stages);
+    }
+    if (points[i].clock_period_ps.has_value()) {
+      options.clock_period_ps(*points[i].clock_period_ps);
+    }
+    absl::StatusOr<PipelineSchedule> schedule =
+        RunPipelineSchedule(f, precomputed, options);
+    statuses[i] = RecordOutcome(schedule, precomputed, protos[i]);
+  };
+  size_t worker_count = std::min(
+      points.size(),
+      static_cast<size_t>(parallelism == 0 ? AvailableCPUs() : parallelism));
+  if (worker_count <= 1) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      explore_point(i);
+    }
+  } else {
+    std::vector<std::unique_ptr<Thread>> workers;
+    workers.reserve(worker_count);
+    for (size_t w = 0; w < worker_count; ++w) {
+      workers.push_back(std::make_unique<Thread>([&] {
+        for (size_t i = next_point.fetch_add(1); i < points.size();
+             i = next_point.fetch_add(1)) {
+          explore_point(i);
+        }
+      }));
+    }
+    for (std::unique_ptr<Thread>& worker : workers) {
+      worker->Join();
+    }
+  }
+  for (const absl::Status& status : statuses) {
+    XLS_RETURN_IF_ERROR(status);
+  }
+
+  MarkParetoFrontier(report);
+  return report;
+}
+
+}  // namespace xls
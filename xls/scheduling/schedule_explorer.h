@@ -0,0 +1,57 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_SCHEDULING_SCHEDULE_EXPLORER_H_
+#define XLS_SCHEDULING_SCHEDULE_EXPLORER_H_
+
+#include <cstdint>
+#include <optional>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/delay_model/delay_estimator.h"
+#include "xls/ir/function_base.h"
+#include "xls/scheduling/schedule_exploration.pb.h"
+#include "xls/scheduling/scheduling_options.h"
+
+namespace xls {
+
+// One scheduling configuration to explore. At least one of the fields must be
+// set; a field left unset is unconstrained, matching the semantics of the
+// corresponding SchedulingOptions setters.
+struct ScheduleExplorationPoint {
+  std::optional<int64_t> pipeline_stages;
+  std::optional<int64_t> clock_period_ps;
+};
+
+// Schedules `f` under every configuration in `points` and returns a report
+// with the achieved stage count, clock period and pipeline register area
+// proxy of each feasible point, with Pareto-optimal points marked.
+//
+// Node delays are computed once up front and shared read-only by all
+// configurations, and the configurations are scheduled concurrently on up to
+// `parallelism` threads (zero means one thread per available CPU). Each
+// configuration is `base_options` with the point's pipeline_stages and
+// clock_period_ps applied on top; `base_options` must not request FDO or
+// worst-case-throughput minimization as those mutate the IR during
+// scheduling.
+absl::StatusOr<ScheduleExplorationReportProto> ExploreSchedules(
+    FunctionBase* f, const DelayEstimator& delay_estimator,
+    const SchedulingOptions& base_options,
+    absl::Span<const ScheduleExplorationPoint> points,
+    int64_t parallelism = 0);
+
+}  // namespace xls
+
+#endif  // XLS_SCHEDULING_SCHEDULE_EXPLORER_H_
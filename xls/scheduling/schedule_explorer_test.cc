@@ -0,0 +1,83 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/scheduling/schedule_explorer.h"
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/scheduling/schedule_exploration.pb.h"
+#include "xls/scheduling/scheduling_options.h"
+
+namespace xls {
+namespace {
+
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+class ScheduleExplorerTest : public IrTestBase {};
+
+TEST_F(ScheduleExplorerTest, ExploresFamilyOfConfigurations) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Function * f, fb.BuildWithReturnValue(fb.Negate(fb.Not(fb.Add(x, y)))));
+
+  std::vector<ScheduleExplorationPoint> points = {
+      {.pipeline_stages = 1},
+      {.pipeline_stages = 3},
+      // Infeasible: three unit-delay operations chained in a single stage
+      // cannot meet a 1 ps clock.
+      {.pipeline_stages = 1, .clock_period_ps = 1},
+  };
+  XLS_ASSERT_OK_AND_ASSIGN(
+      ScheduleExplorationReportProto report,
+      ExploreSchedules(f, TestDelayEstimator(), SchedulingOptions(), points,
+                       /*parallelism=*/2));
+
+  EXPECT_EQ(report.function_base(), f->name());
+  ASSERT_EQ(report.points_size(), 3);
+
+  const ScheduleExplorationPointProto& single_stage = report.points(0);
+  EXPECT_EQ(single_stage.requested_pipeline_stages(), 1);
+  ASSERT_TRUE(single_stage.feasible());
+  EXPECT_EQ(single_stage.pipeline_stages(), 1);
+  EXPECT_EQ(single_stage.clock_period_ps(), 3);
+  EXPECT_EQ(single_stage.pipeline_register_bits(), 0);
+  EXPECT_TRUE(single_stage.on_pareto_frontier());
+
+  const ScheduleExplorationPointProto& three_stage = report.points(1);
+  ASSERT_TRUE(three_stage.feasible());
+  EXPECT_EQ(three_stage.pipeline_stages(), 3);
+  EXPECT_EQ(three_stage.clock_period_ps(), 1);
+  EXPECT_EQ(three_stage.pipeline_register_bits(), 64);
+  // Fewer registers at one stage, shorter clock at three stages; neither
+  // point dominates the other.
+  EXPECT_TRUE(three_stage.on_pareto_frontier());
+
+  const ScheduleExplorationPointProto& infeasible = report.points(2);
+  EXPECT_FALSE(infeasible.feasible());
+  EXPECT_THAT(infeasible.error(), Not(IsEmpty()));
+  EXPECT_FALSE(infeasible.on_pareto_frontier());
+}
+
+}  // namespace
+}  // namespace xls
@@ -19,6 +19,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -222,6 +223,9 @@ struct SchedulingFailureBehavior {
   std::optional<double> infeasible_per_state_backedge_slack_pool;
 };
 
+// A map from node to cycle as a bare-bones representation of a schedule.
+using ScheduleCycleMap = absl::flat_hash_map<Node*, int64_t>;
+
 // Options to use when generating a pipeline schedule. At least a clock period
 // or a pipeline length (or both) must be specified. See
 // https://google.github.io/xls/scheduling/ for details on these options.
@@ -242,6 +246,7 @@ class SchedulingOptions {
         fdo_delay_driven_path_number_(1),
         fdo_fanout_driven_path_number_(0),
         fdo_refinement_stochastic_ratio_(1.0),
+        fdo_synthesis_concurrency_(0),
         fdo_path_evaluate_strategy_(PathEvaluateStrategy::WINDOW),
         fdo_synthesizer_name_("yosys"),
         schedule_all_procs_(false) {}
@@ -445,6 +450,16 @@ class SchedulingOptions {
     return fdo_refinement_stochastic_ratio_;
   }
 
+  // Maximum number of concurrent synthesis requests issued during FDO delay
+  // refinement; 0 means one request per extracted path/cone/window.
+  SchedulingOptions& fdo_synthesis_concurrency(int64_t value) {
+    fdo_synthesis_concurrency_ = value;
+    return *this;
+  }
+  int64_t fdo_synthesis_concurrency() const {
+    return fdo_synthesis_concurrency_;
+  }
+
   // Support window, cone, and path for now.
   SchedulingOptions& fdo_path_evaluate_strategy(std::string_view value) {
     if (value == "path") {
@@ -497,6 +512,20 @@ class SchedulingOptions {
   }
   bool schedule_all_procs() const { return schedule_all_procs_; }
 
+  // Sets/gets a node-to-cycle mapping from a previously computed schedule
+  // (e.g. one recovered via PipelineSchedule::FromProto) used to warm-start
+  // LP-based schedulers. The hint does not constrain the resulting schedule;
+  // it only gives the solver a starting point, which can substantially reduce
+  // solve time when rescheduling after small IR or option changes. Nodes
+  // missing from the map (or no longer present in the IR) are ignored.
+  SchedulingOptions& schedule_hint(ScheduleCycleMap value) {
+    schedule_hint_ = std::move(value);
+    return *this;
+  }
+  const std::optional<ScheduleCycleMap>& schedule_hint() const {
+    return schedule_hint_;
+  }
+
  private:
   SchedulingStrategy strategy_;
   std::optional<int64_t> clock_period_ps_;
@@ -520,17 +549,16 @@ class SchedulingOptions {
   int64_t fdo_delay_driven_path_number_;
   int64_t fdo_fanout_driven_path_number_;
   float fdo_refinement_stochastic_ratio_;
+  int64_t fdo_synthesis_concurrency_;
   PathEvaluateStrategy fdo_path_evaluate_strategy_;
   std::string fdo_synthesizer_name_;
   std::string fdo_yosys_path_;
   std::string fdo_sta_path_;
   std::string fdo_synthesis_libraries_;
   bool schedule_all_procs_;
+  std::optional<ScheduleCycleMap> schedule_hint_;
 };
 
-// A map from node to cycle as a bare-bones representation of a schedule.
-using ScheduleCycleMap = absl::flat_hash_map<Node*, int64_t>;
-
 }  // namespace xls
 
 #endif  // XLS_SCHEDULING_SCHEDULING_OPTIONS_H_
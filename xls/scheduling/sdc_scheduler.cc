@@ -14,6 +14,8 @@
 
 #include "xls/scheduling/sdc_scheduler.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
 #include <memory>
@@ -34,8 +36,11 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/types/span.h"
+#include "xls/common/metrics.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
+#include "xls/data_structures/union_find.h"
 #include "xls/delay_model/delay_estimator.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/function.h"
@@ -62,7 +67,7 @@ absl::StatusOr<DelayMap> ComputeNodeDelays(
   DelayMap result;
   for (Node* node : f->nodes()) {
     XLS_ASSIGN_OR_RETURN(result[node],
-                         delay_estimator.GetOperationDelayInPs(node));
+                         delay_estimator.GetOperationDelayInPsFast(node));
   }
   return result;
 }
@@ -184,13 +189,23 @@ ComputeCombinationalDelayConstraints(
 
 }  // namespace
 
-SDCSchedulingModel::SDCSchedulingModel(FunctionBase* func,
-                                       const DelayMap& delay_map,
-                                       std::string_view model_name)
+SDCSchedulingModel::SDCSchedulingModel(
+    FunctionBase* func, const DelayMap& delay_map,
+    absl::flat_hash_map<Node*, Node*> cluster_leader,
+    std::string_view model_name)
+    : SDCSchedulingModel(func, TopoSort(func), delay_map,
+                         std::move(cluster_leader), model_name) {}
+
+SDCSchedulingModel::SDCSchedulingModel(
+    FunctionBase* func, absl::Span<Node* const> nodes,
+    const DelayMap& delay_map,
+    absl::flat_hash_map<Node*, Node*> cluster_leader,
+    std::string_view model_name)
     : func_(func),
-      topo_sort_(TopoSort(func_)),
+      topo_sort_(nodes.begin(), nodes.end()),
       model_(model_name),
       delay_map_(delay_map),
+      cluster_leader_(std::move(cluster_leader)),
       last_stage_(model_.AddContinuousVariable(0.0, kInfinity, "last_stage")),
       cycle_at_sinknode_(model_.AddContinuousVariable(-kInfinity, kInfinity,
                                                       "cycle_at_sinknode")) {
@@ -201,11 +216,18 @@ SDCSchedulingModel::SDCSchedulingModel(FunctionBase* func,
   }
 
   for (Node* node : topo_sort_) {
-    cycle_var_.emplace(
-        node, model_.AddContinuousVariable(0.0, kInfinity, node->GetName()));
-    model_.AddLinearConstraint(
-        cycle_var_.at(node) <= last_stage_,
-        absl::StrFormat("pipeline_length:%s", node->GetName()));
+    if (auto it = cluster_leader_.find(node); it != cluster_leader_.end()) {
+      // Clustered nodes share their leader's cycle variable (created earlier,
+      // as the leader is an ancestor). The leader's pipeline-length
+      // constraint covers the shared variable.
+      cycle_var_.emplace(node, cycle_var_.at(it->second));
+    } else {
+      cycle_var_.emplace(
+          node, model_.AddContinuousVariable(0.0, kInfinity, node->GetName()));
+      model_.AddLinearConstraint(
+          cycle_var_.at(node) <= last_stage_,
+          absl::StrFormat("pipeline_length:%s", node->GetName()));
+    }
     lifetime_var_.emplace(
         node,
         model_.AddContinuousVariable(
@@ -215,18 +237,23 @@ SDCSchedulingModel::SDCSchedulingModel(FunctionBase* func,
   if (func_->IsFunction()) {
     Function* function = func_->AsFunctionOrDie();
     // For functions, all parameter nodes must be scheduled in the first stage
-    // of the pipeline...
+    // of the pipeline... (a model restricted to a subset of nodes only
+    // constrains the params it contains).
     for (Param* param : function->params()) {
-      model_.AddLinearConstraint(cycle_var_.at(param) <= 0,
-                                 absl::StrCat("param:", param->GetName()));
+      if (auto it = cycle_var_.find(param); it != cycle_var_.end()) {
+        model_.AddLinearConstraint(it->second <= 0,
+                                   absl::StrCat("param:", param->GetName()));
+      }
     }
 
     // ... and the return value must be scheduled in the final stage, unless
     // it's a parameter.
-    if (!function->return_value()->Is<Param>()) {
+    Node* return_value = function->return_value();
+    if (auto it = cycle_var_.find(return_value);
+        it != cycle_var_.end() && !return_value->Is<Param>()) {
       model_.AddLinearConstraint(
-          cycle_var_.at(function->return_value()) >= last_stage_,
-          absl::StrCat("return:", function->return_value()->GetName()));
+          it->second >= last_stage_,
+          absl::StrCat("return:", return_value->GetName()));
     }
   }
 }
@@ -907,19 +934,23 @@ SDCSchedulingModel::AddLowerBoundSlack(
 }
 
 absl::StatusOr<std::unique_ptr<SDCScheduler>> SDCScheduler::Create(
-    FunctionBase* f, const DelayEstimator& delay_estimator) {
+    FunctionBase* f, const DelayEstimator& delay_estimator,
+    absl::flat_hash_map<Node*, Node*> cluster_leader) {
   XLS_ASSIGN_OR_RETURN(DelayMap delay_map,
                        ComputeNodeDelays(f, delay_estimator));
   std::unique_ptr<SDCScheduler> scheduler(
-      new SDCScheduler(f, std::move(delay_map)));
+      new SDCScheduler(f, std::move(delay_map), std::move(cluster_leader)));
   XLS_RETURN_IF_ERROR(scheduler->Initialize());
   return std::move(scheduler);
 }
 
-SDCScheduler::SDCScheduler(FunctionBase* f, DelayMap delay_map)
+SDCScheduler::SDCScheduler(FunctionBase* f, DelayMap delay_map,
+                           absl::flat_hash_map<Node*, Node*> cluster_leader)
     : f_(f),
       delay_map_(std::move(delay_map)),
-      model_(f, delay_map_, absl::StrCat("sdc_model:", f->name())) {}
+      cluster_leader_(std::move(cluster_leader)),
+      model_(f, delay_map_, cluster_leader_,
+             absl::StrCat("sdc_model:", f->name())) {}
 
 absl::Status SDCScheduler::Initialize() {
   XLS_ASSIGN_OR_RETURN(
@@ -955,10 +986,68 @@ absl::Status SDCScheduler::AddConstraints(
     absl::Span<const SchedulingConstraint> constraints) {
   for (const SchedulingConstraint& constraint : constraints) {
     XLS_RETURN_IF_ERROR(model_.AddSchedulingConstraint(constraint));
+    // Backedge and send/recv constraints are no-ops for functions (they only
+    // constrain proc state and channel operations) and are present in the
+    // default SchedulingOptions, so they don't disqualify a function from
+    // decomposed scheduling.
+    if (f_->IsProc() ||
+        (!std::holds_alternative<BackedgeConstraint>(constraint) &&
+         !std::holds_alternative<SendThenRecvConstraint>(constraint))) {
+      has_explicit_constraints_ = true;
+    }
   }
   return absl::OkStatus();
 }
 
+void SDCScheduler::SetSolutionHint(const ScheduleCycleMap& cycle_map) {
+  math_opt::ModelSolveParameters::SolutionHint hint;
+  for (const auto& [node, cycle_var] : model_.GetCycleVars()) {
+    auto it = cycle_map.find(node);
+    if (it == cycle_map.end()) {
+      continue;
+    }
+    hint.variable_values.emplace(cycle_var,
+                                 static_cast<double>(it->second));
+  }
+  // Hint each lifetime variable with the value implied by the hinted cycles
+  // of its node and users; nodes with unhinted users are left to the solver.
+  for (const auto& [node, lifetime_var] : model_.GetLifetimeVars()) {
+    auto node_it = cycle_map.find(node);
+    if (node_it == cycle_map.end()) {
+      continue;
+    }
+    int64_t last_use = node_it->second;
+    bool all_users_hinted = true;
+    for (Node* user : node->users()) {
+      auto user_it = cycle_map.find(user);
+      if (user_it == cycle_map.end()) {
+        all_users_hinted = false;
+        break;
+      }
+      last_use = std::max(last_use, user_it->second);
+    }
+    if (all_users_hinted) {
+      hint.variable_values.emplace(
+          lifetime_var, static_cast<double>(last_use - node_it->second));
+    }
+  }
+  solution_hint_ = std::move(hint);
+}
+
+absl::StatusOr<math_opt::SolveResult> SDCScheduler::SolveWithHint() {
+  if (solution_hint_.has_value()) {
+    math_opt::SolveArguments arguments;
+    arguments.model_parameters.solution_hints.push_back(*solution_hint_);
+    absl::StatusOr<math_opt::SolveResult> result = solver_->Solve(arguments);
+    if (result.ok() || !absl::IsInvalidArgument(result.status())) {
+      return result;
+    }
+    // The active solver does not accept solution hints; re-solve cold.
+    VLOG(2) << "Solver rejected the solution hint: " << result.status();
+  }
+  return solver_->Solve();
+}
+
 absl::Status SDCScheduler::BuildError(
     const math_opt::SolveResult& result,
     SchedulingFailureBehavior failure_behavior) {
@@ -991,10 +1080,136 @@ absl::Status SDCScheduler::BuildError(
                    math_opt::EnumToString(result.termination.reason)));
 }
 
+std::optional<ScheduleCycleMap> SDCScheduler::ScheduleDecomposed(
+    int64_t pipeline_stages, int64_t clock_period_ps, bool check_feasibility) {
+  // Partition the nodes into weakly-connected components of the dataflow
+  // graph. Nodes in different components share no constraints, so each
+  // component can be scheduled by an independent (and much smaller) LP.
+  UnionFind<Node*> components;
+  for (Node* node : f_->nodes()) {
+    components.Insert(node);
+  }
+  for (Node* node : f_->nodes()) {
+    for (Node* operand : node->operands()) {
+      components.Union(node, operand);
+    }
+  }
+
+  // Gather the nodes of each component in topological order.
+  absl::flat_hash_map<Node*, int64_t> component_index;
+  std::vector<std::vector<Node*>> subproblems;
+  for (Node* node : TopoSort(f_)) {
+    auto [it, inserted] =
+        component_index.try_emplace(components.Find(node), subproblems.size());
+    if (inserted) {
+      subproblems.emplace_back();
+    }
+    subproblems[it->second].push_back(node);
+  }
+  if (subproblems.size() < 2) {
+    return std::nullopt;
+  }
+  VLOG(2) << absl::StreamFormat(
+      "Scheduling %s as %d independent subproblems", f_->name(),
+      subproblems.size());
+
+  // Solve the subproblems concurrently; each worker claims the next unsolved
+  // subproblem until none remain.
+  std::vector<absl::StatusOr<ScheduleCycleMap>> results(subproblems.size());
+  std::atomic<int64_t> next_subproblem(0);
+  auto solve_subproblems = [&]() {
+    int64_t i;
+    while ((i = next_subproblem.fetch_add(1)) <
+           static_cast<int64_t>(subproblems.size())) {
+      results[i] = ScheduleSubproblem(subproblems[i], i, pipeline_stages,
+                                      clock_period_ps, check_feasibility);
+    }
+  };
+  int64_t worker_count = std::min(static_cast<int64_t>(AvailableCPUs()),
+                                  static_cast<int64_t>(subproblems.size()));
+  std::vector<std::unique_ptr<Thread>> workers;
+  for (int64_t i = 1; i < worker_count; ++i) {
+    workers.push_back(std::make_unique<Thread>(solve_subproblems));
+  }
+  solve_subproblems();
+  for (std::unique_ptr<Thread>& worker : workers) {
+    worker->Join();
+  }
+
+  ScheduleCycleMap cycle_map;
+  for (absl::StatusOr<ScheduleCycleMap>& result : results) {
+    if (!result.ok()) {
+      // Let the monolithic model reproduce the failure; it carries the slack
+      // machinery needed to produce an actionable error message.
+      VLOG(2) << "Decomposed SDC subproblem failed (" << result.status()
+              << "); falling back to the monolithic model";
+      return std::nullopt;
+    }
+    for (const auto& [node, cycle] : *result) {
+      cycle_map[node] = cycle;
+    }
+  }
+  return cycle_map;
+}
+
+absl::StatusOr<ScheduleCycleMap> SDCScheduler::ScheduleSubproblem(
+    absl::Span<Node* const> nodes, int64_t subproblem_index,
+    int64_t pipeline_stages, int64_t clock_period_ps,
+    bool check_feasibility) const {
+  XLS_METRICS_COUNTER_INC("scheduler.sdc_subproblem_solves");
+  XLS_METRICS_SCOPED_TIMER("scheduler.sdc_subproblem_solve_time");
+  SDCSchedulingModel model(
+      f_, nodes, delay_map_, cluster_leader_,
+      absl::StrFormat("sdc_model:%s:%d", f_->name(), subproblem_index));
+  for (Node* node : nodes) {
+    for (Node* user : node->users()) {
+      XLS_RETURN_IF_ERROR(model.AddDefUseConstraints(node, user));
+    }
+    if (f_->IsFunction() && f_->HasImplicitUse(node)) {
+      XLS_RETURN_IF_ERROR(model.AddDefUseConstraints(node, std::nullopt));
+    }
+  }
+  model.SetClockPeriod(clock_period_ps);
+  model.SetPipelineLength(pipeline_stages);
+  if (check_feasibility) {
+    model.RemoveObjective();
+  } else {
+    model.SetObjective();
+  }
+  XLS_ASSIGN_OR_RETURN(
+      math_opt::SolveResult result,
+      math_opt::Solve(model.UnderlyingModel(), math_opt::SolverType::kGlop));
+  if (result.termination.reason == math_opt::TerminationReason::kOptimal ||
+      (check_feasibility &&
+       result.termination.reason == math_opt::TerminationReason::kFeasible)) {
+    return model.ExtractResult(result.variable_values());
+  }
+  return absl::InternalError(
+      absl::StrCat("The subproblem does not have an optimal solution; solver "
+                   "terminated with ",
+                   math_opt::EnumToString(result.termination.reason)));
+}
+
 absl::StatusOr<ScheduleCycleMap> SDCScheduler::Schedule(
     std::optional<int64_t> pipeline_stages, int64_t clock_period_ps,
     SchedulingFailureBehavior failure_behavior, bool check_feasibility,
     std::optional<int64_t> worst_case_throughput) {
+  XLS_METRICS_COUNTER_INC("scheduler.sdc_solves");
+  XLS_METRICS_SCOPED_TIMER("scheduler.sdc_solve_time");
+  // With a fixed pipeline length and no coupling through state backedges or
+  // user-specified constraints, the LP decomposes along the weakly-connected
+  // components of the dataflow graph. Procs are excluded as their next-state
+  // and channel nodes couple components through shared slack and the sink
+  // node.
+  if (f_->IsFunction() && pipeline_stages.has_value() &&
+      !worst_case_throughput.has_value() && !has_explicit_constraints_) {
+    std::optional<ScheduleCycleMap> decomposed = ScheduleDecomposed(
+        *pipeline_stages, clock_period_ps, check_feasibility);
+    if (decomposed.has_value()) {
+      return *std::move(decomposed);
+    }
+  }
+
   model_.SetClockPeriod(clock_period_ps);
   if (worst_case_throughput.has_value()) {
     XLS_RETURN_IF_ERROR(model_.SetWorstCaseThroughput(*worst_case_throughput));
@@ -1006,7 +1221,7 @@ absl::StatusOr<ScheduleCycleMap> SDCScheduler::Schedule(
     model_.MinimizePipelineLength();
     XLS_ASSIGN_OR_RETURN(
         const math_opt::SolveResult result_with_minimized_pipeline_length,
-        solver_->Solve());
+        SolveWithHint());
     if (result_with_minimized_pipeline_length.termination.reason !=
         math_opt::TerminationReason::kOptimal) {
       return BuildError(result_with_minimized_pipeline_length,
@@ -1025,7 +1240,7 @@ absl::StatusOr<ScheduleCycleMap> SDCScheduler::Schedule(
     model_.SetObjective();
   }
 
-  XLS_ASSIGN_OR_RETURN(math_opt::SolveResult result, solver_->Solve());
+  XLS_ASSIGN_OR_RETURN(math_opt::SolveResult result, SolveWithHint());
   if (result.termination.reason == math_opt::TerminationReason::kOptimal ||
       (check_feasibility &&
        result.termination.reason == math_opt::TerminationReason::kFeasible)) {
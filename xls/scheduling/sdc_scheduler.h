@@ -46,9 +46,22 @@ class SDCSchedulingModel {
   static constexpr double kInfinity = std::numeric_limits<double>::infinity();
 
  public:
+  // `cluster_leader` maps nodes onto the (transitively resolved) node whose
+  // cycle variable they share; see SDCScheduler::Create. Nodes absent from
+  // the map receive their own cycle variable.
   SDCSchedulingModel(FunctionBase* func, const DelayMap& delay_map,
+                     absl::flat_hash_map<Node*, Node*> cluster_leader = {},
                      std::string_view model_name = "");
 
+  // Builds a model restricted to the given subset of `func`'s nodes, which
+  // must be in topological order and closed under operands and users (e.g., a
+  // weakly-connected component of the dataflow graph). Used to decompose the
+  // scheduling problem into independent subproblems.
+  SDCSchedulingModel(FunctionBase* func, absl::Span<Node* const> nodes,
+                     const DelayMap& delay_map,
+                     absl::flat_hash_map<Node*, Node*> cluster_leader,
+                     std::string_view model_name);
+
   absl::Status AddDefUseConstraints(Node* node, std::optional<Node*> user);
   absl::Status AddCausalConstraint(Node* node, std::optional<Node*> user);
   absl::Status AddLifetimeConstraint(Node* node, std::optional<Node*> user);
@@ -152,6 +165,11 @@ class SDCSchedulingModel {
   operations_research::math_opt::Model model_;
   const DelayMap& delay_map_;
 
+  // Nodes mapped here share the cycle variable of their cluster leader
+  // instead of receiving one of their own; results are still extracted per
+  // node.
+  absl::flat_hash_map<Node*, Node*> cluster_leader_;
+
   // Stores the critical-path distances between all pairs of Nodes; if there is
   // a path from `x` to `y`, `distances_to_node_[y][x]` is the length of the
   // critical path.
@@ -211,12 +229,30 @@ class SDCScheduler {
   using DelayMap = absl::flat_hash_map<Node*, int64_t>;
 
  public:
+  // `cluster_leader` optionally maps nodes onto a (transitively resolved)
+  // operand-side node whose cycle variable they share, collapsing chains of
+  // zero-delay operations into single scheduling units and shrinking the LP.
+  // Clustering a node is only sound if scheduling it in its leader's cycle
+  // is always feasible; see ComputeZeroDelayClusters in
+  // run_pipeline_schedule.cc for the conditions under which that holds. The
+  // resulting schedule is still node-level: every node of the cluster is
+  // assigned the (shared) cycle of its leader.
   static absl::StatusOr<std::unique_ptr<SDCScheduler>> Create(
-      FunctionBase* f, const DelayEstimator& delay_estimator);
+      FunctionBase* f, const DelayEstimator& delay_estimator,
+      absl::flat_hash_map<Node*, Node*> cluster_leader = {});
 
   absl::Status AddConstraints(
       absl::Span<const SchedulingConstraint> constraints);
 
+  // Seeds subsequent calls to Schedule with the stage assignments of a
+  // previously computed schedule (e.g. the cycle map of a PipelineSchedule
+  // recovered via FromProto). Nodes missing from `cycle_map` or no longer
+  // present in the function are simply not hinted. The hint does not
+  // constrain the solution; it only gives the solver a starting point, which
+  // can substantially reduce solve time when rescheduling after small IR or
+  // option changes.
+  void SetSolutionHint(const ScheduleCycleMap& cycle_map);
+
   // Schedule to minimize the total pipeline registers using SDC scheduling
   // the constraint matrix is totally unimodular, this ILP problem can be solved
   // by LP.
@@ -247,18 +283,57 @@ class SDCScheduler {
       std::optional<int64_t> worst_case_throughput = std::nullopt);
 
  private:
-  SDCScheduler(FunctionBase* f, DelayMap delay_map);
+  SDCScheduler(FunctionBase* f, DelayMap delay_map,
+               absl::flat_hash_map<Node*, Node*> cluster_leader);
   absl::Status Initialize();
 
   absl::Status BuildError(
       const operations_research::math_opt::SolveResult& result,
       SchedulingFailureBehavior failure_behavior);
 
+  // Attempts to schedule by decomposing the LP along the weakly-connected
+  // components of the dataflow graph and solving the per-component subproblems
+  // concurrently. With a fixed pipeline length the components share no
+  // variables, so the stitched-together subproblem solutions form an optimal
+  // solution of the monolithic LP. Returns std::nullopt if the function has
+  // only one component or if any subproblem fails to solve; in the latter case
+  // the monolithic model reproduces the failure with full diagnostics.
+  std::optional<ScheduleCycleMap> ScheduleDecomposed(int64_t pipeline_stages,
+                                                     int64_t clock_period_ps,
+                                                     bool check_feasibility);
+
+  // Builds and solves the LP for one weakly-connected component. `nodes` must
+  // be in topological order.
+  absl::StatusOr<ScheduleCycleMap> ScheduleSubproblem(
+      absl::Span<Node* const> nodes, int64_t subproblem_index,
+      int64_t pipeline_stages, int64_t clock_period_ps,
+      bool check_feasibility) const;
+
+  // Solves the monolithic model, passing `solution_hint_` (if set) to the
+  // solver. Falls back to an unhinted solve if the underlying solver does not
+  // accept solution hints.
+  absl::StatusOr<operations_research::math_opt::SolveResult> SolveWithHint();
+
   FunctionBase* f_;
   DelayMap delay_map_;
 
+  // Shared-cycle-variable clusters; passed to the monolithic model and to
+  // each decomposed subproblem model. See Create.
+  absl::flat_hash_map<Node*, Node*> cluster_leader_;
+
   SDCSchedulingModel model_;
   std::unique_ptr<operations_research::math_opt::IncrementalSolver> solver_;
+
+  // If set, a starting point passed to the solver on each solve of the
+  // monolithic model; see SetSolutionHint.
+  std::optional<
+      operations_research::math_opt::ModelSolveParameters::SolutionHint>
+      solution_hint_;
+
+  // Whether any user-specified scheduling constraints have been added. Such
+  // constraints may couple otherwise-independent components, so they disable
+  // the decomposed scheduling path.
+  bool has_explicit_constraints_ = false;
 };
 
 }  // namespace xls
@@ -16,6 +16,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <deque>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -24,23 +26,28 @@
 #include <variant>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xls/codegen/flattening.h"
 #include "xls/codegen/module_signature.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/value.h"
 #include "xls/ir/xls_type.pb.h"
 #include "xls/simulation/module_testbench.h"
 #include "xls/simulation/module_testbench_thread.h"
+#include "xls/simulation/testbench_stream.h"
 #include "xls/tools/eval_utils.h"
 
 namespace xls {
@@ -517,6 +524,237 @@ absl::StatusOr<std::vector<Value>> ModuleSimulator::RunBatched(
   return outputs;
 }
 
+absl::StatusOr<std::unique_ptr<ModuleSimulatorSession>>
+ModuleSimulator::StartBatchedSession() const {
+  if (!signature_.proto().has_clock_name() &&
+      !signature_.proto().has_combinational()) {
+    return absl::InvalidArgumentError("Expected clock in signature");
+  }
+  int64_t latency;
+  std::optional<PipelineControl> pipeline_control;
+  if (signature_.proto().has_pipeline()) {
+    latency = signature_.proto().pipeline().latency();
+    if (signature_.proto().pipeline().has_pipeline_control()) {
+      pipeline_control = signature_.proto().pipeline().pipeline_control();
+      if (!pipeline_control->has_valid()) {
+        return absl::UnimplementedError(
+            "Batched sessions do not support manual pipeline control.");
+      }
+    }
+  } else if (signature_.proto().has_combinational()) {
+    latency = 0;
+  } else {
+    return absl::UnimplementedError(absl::StrCat(
+        "Unsupported interface: ", signature_.proto().interface_oneof_case()));
+  }
+
+  // The session runs for an unbounded number of cycles (one per streamed
+  // sample) so no cycle limit is imposed.
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<ModuleTestbench> tb,
+                       ModuleTestbench::CreateFromVerilogText(
+                           verilog_text_, file_type_, signature_, simulator_,
+                           /*reset_dut=*/true, includes_,
+                           /*simulation_cycle_limit=*/std::nullopt));
+
+  // Every advanced cycle carries a sample, so the input-valid signal (if any)
+  // is driven to one for the whole simulation.
+  if (pipeline_control.has_value()) {
+    XLS_RETURN_IF_ERROR(
+        tb->CreateThread("valid driver",
+                         {DutInput{.port_name =
+                                       pipeline_control->valid().input_name(),
+                                   .initial_value = UBits(1, 1)}},
+                         /*wait_until_done=*/false)
+            .status());
+  }
+
+  // Each data input port is driven by a thread which reads one value per
+  // cycle from the port's input stream. The blocking stream read provides
+  // flow control: the simulation only advances when a sample is available.
+  for (const PortProto& input : signature_.data_inputs()) {
+    XLS_ASSIGN_OR_RETURN(const TestbenchStream* stream,
+                         tb->CreateInputStream(input.name(), input.width()));
+    XLS_ASSIGN_OR_RETURN(
+        ModuleTestbenchThread * tbt,
+        tb->CreateThread(absl::StrFormat("%s driver", input.name()),
+                         {DutInput{.port_name = input.name(),
+                                   .initial_value = IsX()}},
+                         /*wait_until_done=*/false));
+    SequentialBlock& loop = tbt->MainBlock().RepeatForever();
+    loop.ReadFromStreamAndSet(input.name(), stream).NextCycle();
+  }
+
+  // Output ports are captured every cycle once the first sample has reached
+  // the end of the pipeline.
+  for (const PortProto& output : signature_.data_outputs()) {
+    XLS_ASSIGN_OR_RETURN(const TestbenchStream* stream,
+                         tb->CreateOutputStream(output.name(), output.width()));
+    XLS_ASSIGN_OR_RETURN(
+        ModuleTestbenchThread * tbt,
+        tb->CreateThread(absl::StrFormat("%s capture", output.name()),
+                         /*dut_inputs=*/{},
+                         /*wait_until_done=*/false));
+    SequentialBlock& seq_block = tbt->MainBlock();
+    if (latency > 0) {
+      seq_block.AdvanceNCycles(latency);
+    }
+    SequentialBlock& loop = seq_block.RepeatForever();
+    loop.AtEndOfCycle().CaptureAndWriteToStream(output.name(), stream);
+  }
+
+  return absl::WrapUnique(
+      new ModuleSimulatorSession(signature_, latency, std::move(tb)));
+}
+
+ModuleSimulatorSession::ModuleSimulatorSession(
+    const ModuleSignature& signature, int64_t flush_sample_count,
+    std::unique_ptr<ModuleTestbench> testbench)
+    : signature_(signature),
+      flush_sample_count_(flush_sample_count),
+      testbench_(std::move(testbench)) {
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const PortProto& input : signature_.data_inputs()) {
+      input_queues_[input.name()];
+    }
+    for (const PortProto& output : signature_.data_outputs()) {
+      output_queues_[output.name()];
+    }
+  }
+  // The streaming run is blocking so it is performed on a separate thread;
+  // the producer/consumer callbacks bridge to the queues above.
+  run_thread_ = absl::WrapUnique(new Thread([this]() {
+    std::deque<std::function<std::optional<Bits>()>> producer_fns;
+    std::deque<std::function<absl::Status(const Bits&)>> consumer_fns;
+    absl::flat_hash_map<std::string, TestbenchStreamThread::Producer>
+        producers;
+    absl::flat_hash_map<std::string, TestbenchStreamThread::Consumer>
+        consumers;
+    for (const PortProto& input : signature_.data_inputs()) {
+      const std::string name = input.name();
+      producer_fns.push_back([this, name]() { return NextInputFor(name); });
+      producers.insert({name, producer_fns.back()});
+    }
+    for (const PortProto& output : signature_.data_outputs()) {
+      const std::string name = output.name();
+      consumer_fns.push_back([this, name](const Bits& value) {
+        return HandleOutputFor(name, value);
+      });
+      consumers.insert({name, consumer_fns.back()});
+    }
+    absl::Status status =
+        testbench_->RunWithStreamingIo(producers, consumers);
+    absl::MutexLock lock(&mutex_);
+    run_status_ = status;
+    run_done_ = true;
+  }));
+}
+
+ModuleSimulatorSession::~ModuleSimulatorSession() {
+  if (run_thread_ != nullptr) {
+    Finish().IgnoreError();
+  }
+}
+
+std::optional<Bits> ModuleSimulatorSession::NextInputFor(
+    const std::string& port) {
+  absl::MutexLock lock(&mutex_);
+  std::deque<Bits>& queue = input_queues_.at(port);
+  auto ready = [this, &queue]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !queue.empty() || finished_;
+  };
+  mutex_.Await(absl::Condition(&ready));
+  if (queue.empty()) {
+    // Finished and drained; closes the stream which terminates the
+    // simulation.
+    return std::nullopt;
+  }
+  Bits result = queue.front();
+  queue.pop_front();
+  return result;
+}
+
+absl::Status ModuleSimulatorSession::HandleOutputFor(const std::string& port,
+                                                     const Bits& value) {
+  absl::MutexLock lock(&mutex_);
+  output_queues_.at(port).push_back(value);
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<ModuleSimulator::BitsMap>>
+ModuleSimulatorSession::RunBatched(
+    absl::Span<const ModuleSimulator::BitsMap> inputs) {
+  XLS_RET_CHECK(run_thread_ != nullptr) << "Session has already finished.";
+  if (inputs.empty()) {
+    return std::vector<ModuleSimulator::BitsMap>();
+  }
+  for (const ModuleSimulator::BitsMap& input : inputs) {
+    XLS_RETURN_IF_ERROR(signature_.ValidateInputs(input));
+  }
+  const int64_t batch_size = inputs.size();
+
+  absl::MutexLock lock(&mutex_);
+  for (const ModuleSimulator::BitsMap& sample : inputs) {
+    for (const PortProto& port : signature_.data_inputs()) {
+      input_queues_.at(port.name()).push_back(sample.at(port.name()));
+    }
+  }
+  auto batch_complete = [this,
+                         batch_size]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (run_done_) {
+      return true;
+    }
+    for (const auto& [_, queue] : output_queues_) {
+      if (static_cast<int64_t>(queue.size()) < batch_size) {
+        return false;
+      }
+    }
+    return true;
+  };
+  mutex_.Await(absl::Condition(&batch_complete));
+  for (const auto& [_, queue] : output_queues_) {
+    if (static_cast<int64_t>(queue.size()) < batch_size) {
+      // The simulation terminated before producing all outputs.
+      return run_status_.ok() ? absl::InternalError(
+                                    "Simulation ended before producing all "
+                                    "outputs for the batch.")
+                              : run_status_;
+    }
+  }
+  std::vector<ModuleSimulator::BitsMap> outputs(batch_size);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    for (const PortProto& port : signature_.data_outputs()) {
+      std::deque<Bits>& queue = output_queues_.at(port.name());
+      outputs[i][port.name()] = queue.front();
+      queue.pop_front();
+    }
+  }
+  return outputs;
+}
+
+absl::Status ModuleSimulatorSession::Finish() {
+  if (run_thread_ == nullptr) {
+    absl::MutexLock lock(&mutex_);
+    return run_status_;
+  }
+  {
+    absl::MutexLock lock(&mutex_);
+    // Push zero-valued samples to drain the pipeline so the final real
+    // samples' outputs are produced before the input streams hit
+    // end-of-file.
+    for (int64_t i = 0; i < flush_sample_count_; ++i) {
+      for (const PortProto& port : signature_.data_inputs()) {
+        input_queues_.at(port.name()).push_back(UBits(0, port.width()));
+      }
+    }
+    finished_ = true;
+  }
+  run_thread_->Join();
+  run_thread_.reset();
+  absl::MutexLock lock(&mutex_);
+  return run_status_;
+}
+
 absl::StatusOr<std::string> ModuleSimulator::GenerateProcTestbenchVerilog(
     const absl::flat_hash_map<std::string, std::vector<Bits>>& channel_inputs,
     const absl::flat_hash_map<std::string, int64_t>& output_channel_counts,
@@ -16,17 +16,23 @@
 #define XLS_SIMULATION_MODULE_SIMULATOR_H_
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xls/codegen/module_signature.h"
 #include "xls/codegen/vast.h"
+#include "xls/common/thread.h"
+#include "xls/ir/bits.h"
 #include "xls/ir/value.h"
 #include "xls/simulation/module_testbench.h"
 #include "xls/simulation/verilog_simulator.h"
@@ -72,6 +78,8 @@ struct ReadyValidHoldoffs {
   absl::flat_hash_map<std::string, std::vector<int64_t>> ready_holdoffs;
 };
 
+class ModuleSimulatorSession;
+
 // Abstraction for simulating a module described by a SignatureProto using a
 // testbench run under the Verilog simulator.
 class ModuleSimulator {
@@ -131,6 +139,15 @@ class ModuleSimulator {
   // Runs a function with arguments as a Span.
   absl::StatusOr<Value> RunFunction(absl::Span<const Value> inputs) const;
 
+  // Starts a persistent simulation session which keeps the compiled
+  // simulation alive across batches. Each `RunBatched` call on the returned
+  // session streams its inputs to the already-running simulator process via
+  // the testbench stream protocol rather than compiling the testbench and
+  // starting a simulator process per invocation. Only pipeline (without
+  // manual pipeline control) and combinational interfaces are supported.
+  absl::StatusOr<std::unique_ptr<ModuleSimulatorSession>> StartBatchedSession()
+      const;
+
   // Returns the (System)Verilog testbench for testing the module with the given
   // inputs and expected outputs counts.
   absl::StatusOr<std::string> GenerateProcTestbenchVerilog(
@@ -162,6 +179,63 @@ class ModuleSimulator {
   absl::Span<const VerilogInclude> includes_;
 };
 
+// A persistent simulation session created by
+// `ModuleSimulator::StartBatchedSession`. The testbench is compiled and the
+// simulator process started once; input batches are streamed in (and outputs
+// streamed back) over named pipes using the testbench stream protocol, so
+// repeated batches pay no per-batch compilation or simulator startup cost.
+//
+// Not thread-safe. `Finish` (or destruction) terminates the simulation.
+class ModuleSimulatorSession {
+ public:
+  ~ModuleSimulatorSession();
+
+  ModuleSimulatorSession(const ModuleSimulatorSession&) = delete;
+  ModuleSimulatorSession& operator=(const ModuleSimulatorSession&) = delete;
+
+  // Runs the given batch of inputs through the live simulation. Blocks until
+  // all outputs for the batch have been produced and returns them in input
+  // order.
+  absl::StatusOr<std::vector<ModuleSimulator::BitsMap>> RunBatched(
+      absl::Span<const ModuleSimulator::BitsMap> inputs);
+
+  // Terminates the simulation and returns its final status. Called
+  // automatically (discarding the status) on destruction.
+  absl::Status Finish();
+
+ private:
+  friend class ModuleSimulator;
+
+  ModuleSimulatorSession(const ModuleSignature& signature,
+                         int64_t flush_sample_count,
+                         std::unique_ptr<ModuleTestbench> testbench);
+
+  // Producer/consumer callbacks invoked by the testbench stream threads.
+  std::optional<Bits> NextInputFor(const std::string& port);
+  absl::Status HandleOutputFor(const std::string& port, const Bits& value);
+
+  ModuleSignature signature_;
+  // Number of zero-valued samples pushed at Finish() to drain the pipeline so
+  // the outputs of the final real samples are produced before the input
+  // streams hit end-of-file and terminate the simulation.
+  int64_t flush_sample_count_;
+  std::unique_ptr<ModuleTestbench> testbench_;
+
+  absl::Mutex mutex_;
+  // Per-port queues of values flowing to and from the simulation. Indexed by
+  // data port name.
+  absl::flat_hash_map<std::string, std::deque<Bits>> input_queues_
+      ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, std::deque<Bits>> output_queues_
+      ABSL_GUARDED_BY(mutex_);
+  bool finished_ ABSL_GUARDED_BY(mutex_) = false;
+  bool run_done_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::Status run_status_ ABSL_GUARDED_BY(mutex_);
+
+  // Thread which runs the (blocking) streaming simulation.
+  std::unique_ptr<Thread> run_thread_;
+};
+
 }  // namespace verilog
 }  // namespace xls
 
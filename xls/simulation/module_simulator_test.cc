@@ -15,6 +15,7 @@
 #include "xls/simulation/module_simulator.h"
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -362,6 +363,42 @@ TEST_P(ModuleSimulatorTest, CombinationalBatched) {
   EXPECT_THAT(outputs[2], ElementsAre(Pair("out", UBits(100, 8))));
 }
 
+TEST_P(ModuleSimulatorTest, CombinationalBatchedSession) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto verilog_signature, MakeCombinationalModule());
+  ModuleSimulator simulator =
+      NewModuleSimulator(verilog_signature.first, verilog_signature.second);
+
+  // A single simulation process serves multiple batches.
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<ModuleSimulatorSession> session,
+                           simulator.StartBatchedSession());
+
+  using BitsMap = ModuleSimulator::BitsMap;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::vector<BitsMap> outputs,
+      session->RunBatched({BitsMap{{"x", UBits(99, 8)}, {"y", UBits(12, 8)}},
+                           BitsMap{{"x", UBits(100, 8)}, {"y", UBits(25, 8)}}}));
+  EXPECT_EQ(outputs.size(), 2);
+  EXPECT_THAT(outputs[0], ElementsAre(Pair("out", UBits(87, 8))));
+  EXPECT_THAT(outputs[1], ElementsAre(Pair("out", UBits(75, 8))));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      outputs, session->RunBatched(
+                   {BitsMap{{"x", UBits(255, 8)}, {"y", UBits(155, 8)}}}));
+  EXPECT_EQ(outputs.size(), 1);
+  EXPECT_THAT(outputs[0], ElementsAre(Pair("out", UBits(100, 8))));
+
+  XLS_ASSERT_OK(session->Finish());
+}
+
+TEST_P(ModuleSimulatorTest, FixedLatencySessionUnsupported) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto verilog_signature, MakeFixedLatencyModule());
+  ModuleSimulator simulator =
+      NewModuleSimulator(verilog_signature.first, verilog_signature.second);
+  EXPECT_THAT(simulator.StartBatchedSession(),
+              StatusIs(absl::StatusCode::kUnimplemented,
+                       HasSubstr("Unsupported interface")));
+}
+
 TEST_P(ModuleSimulatorTest, MultipleOutputs) {
   const std::string text = R"(
 module delay_3(
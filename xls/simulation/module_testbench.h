@@ -132,10 +132,16 @@ class ModuleTestbench {
   // Allocate streams for reading and writing values to the testbench. The
   // returned pointer can be passed to SequentialBlock::ReadFromStreamAndSet or
   // EndOfCycleEvent::CaptureAndWriteToStream to connect into the simulation.
+  // `encoding` selects how values are represented on the underlying pipe;
+  // kBinary avoids per-value text formatting and parsing (see
+  // TestbenchStreamEncoding) but requires simulator support for the `%u`
+  // conversion and cannot transfer X values.
   absl::StatusOr<const TestbenchStream*> CreateInputStream(
-      std::string_view name, int64_t width);
+      std::string_view name, int64_t width,
+      TestbenchStreamEncoding encoding = TestbenchStreamEncoding::kHexText);
   absl::StatusOr<const TestbenchStream*> CreateOutputStream(
-      std::string_view name, int64_t width);
+      std::string_view name, int64_t width,
+      TestbenchStreamEncoding encoding = TestbenchStreamEncoding::kHexText);
 
  private:
   ModuleTestbench(std::string_view verilog_text, FileType file_type,
@@ -14,12 +14,16 @@
 
 #include "xls/simulation/testbench_stream.h"
 
+#include <cerrno>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>  // NOLINT
 #include <functional>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -30,6 +34,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
+#include "absl/types/span.h"
 #include "xls/codegen/vast.h"
 #include "xls/common/file/named_pipe.h"
 #include "xls/common/status/status_macros.h"
@@ -42,6 +47,23 @@
 
 namespace xls {
 namespace verilog {
+namespace {
+
+// Serializes `bits` into a little-endian binary record of `record_size`
+// bytes. Bytes beyond the value are zero.
+std::vector<uint8_t> BitsToBinaryRecord(const Bits& bits, int64_t record_size) {
+  std::vector<uint8_t> record(record_size, 0);
+  bits.ToBytes(
+      absl::MakeSpan(record).subspan(0, (bits.bit_count() + 7) / 8));
+  return record;
+}
+
+// Deserializes a little-endian binary record into a Bits of `width` bits.
+Bits BinaryRecordToBits(absl::Span<const uint8_t> record, int64_t width) {
+  return Bits::FromBytes(record.subspan(0, (width + 7) / 8), width);
+}
+
+}  // namespace
 
 /* static */ VastStreamEmitter VastStreamEmitter::Create(
     const TestbenchStream& stream, Module* m) {
@@ -107,11 +129,17 @@ void VastStreamEmitter::EmitRead(StatementBlock* block, LogicRef* lhs) const {
   //     $display("FAILED: ...");
   //     $finish;
   //   end
+  //
+  // Binary-encoded streams use the unformatted `%u` conversion instead of
+  // `%x\n` and read a fixed-size record rather than a text line.
+  std::string_view format_string =
+      stream_.encoding == TestbenchStreamEncoding::kBinary ? "%u" : R"(%x\n)";
   SystemFunctionCall* call = block->file()->Make<SystemFunctionCall>(
       SourceInfo(), "fscanf",
       std::vector<Expression*>{
           file_descriptor_,
-          block->file()->Make<QuotedString>(SourceInfo(), R"(%x\n)"), lhs});
+          block->file()->Make<QuotedString>(SourceInfo(), format_string),
+          lhs});
   block->Add<BlockingAssignment>(SourceInfo(), count_, call);
   Conditional* conditional = block->Add<Conditional>(
       SourceInfo(),
@@ -128,6 +156,17 @@ void VastStreamEmitter::EmitRead(StatementBlock* block, LogicRef* lhs) const {
 
 void VastStreamEmitter::EmitWrite(StatementBlock* block,
                                   Expression* value) const {
+  if (stream_.encoding == TestbenchStreamEncoding::kBinary) {
+    // Emit code which writes the value as a fixed-size binary record:
+    //
+    //   $fwrite(fd, "%u", <value>);
+    block->Add<SystemTaskCall>(
+        SourceInfo(), "fwrite",
+        std::vector<Expression*>{
+            file_descriptor_,
+            block->file()->Make<QuotedString>(SourceInfo(), "%u"), value});
+    return;
+  }
   // Emit code:
   //
   //   $fwriteh(fd, <value>);
@@ -157,6 +196,41 @@ TestbenchStreamThread::Create(const TestbenchStream& stream,
 void TestbenchStreamThread::RunInputStream(
     TestbenchStreamThread::Producer producer) {
   VLOG(1) << absl::StrFormat("RunInputStream [%s]", stream_.name);
+  if (stream_.encoding == TestbenchStreamEncoding::kBinary) {
+    thread_ = absl::WrapUnique(new Thread([this, producer]() {
+      VLOG(1) << absl::StrFormat("Thread for stream `%s` started",
+                                 stream_.name);
+      std::FILE* file = std::fopen(named_pipe_.path().c_str(), "wb");
+      if (file == nullptr) {
+        MaybeSetError(absl::InternalError(
+            absl::StrFormat("Cannot open named pipe for stream `%s`: %s",
+                            stream_.name, strerror(errno))));
+        return;
+      }
+      while (true) {
+        std::optional<Bits> bits = producer();
+        if (!bits.has_value()) {
+          VLOG(1) << absl::StrFormat(
+              "Producer returned std::nullopt for stream `%s`", stream_.name);
+          break;
+        }
+        CHECK_EQ(bits->bit_count(), stream_.width);
+        std::vector<uint8_t> record =
+            BitsToBinaryRecord(*bits, stream_.BinaryRecordSizeInBytes());
+        // Flush each record so the testbench is never blocked waiting on a
+        // value stuck in the stdio buffer.
+        if (std::fwrite(record.data(), 1, record.size(), file) !=
+                record.size() ||
+            std::fflush(file) != 0) {
+          MaybeSetError(absl::InternalError(absl::StrFormat(
+              "Writing value to stream `%s` failed", stream_.name)));
+          break;
+        }
+      }
+      std::fclose(file);
+    }));
+    return;
+  }
   thread_ = absl::WrapUnique(new Thread([this, producer]() {
     VLOG(1) << absl::StrFormat("Thread for stream `%s` started", stream_.name);
     absl::StatusOr<FileLineWriter> writer =
@@ -194,6 +268,48 @@ void TestbenchStreamThread::RunInputStream(
 void TestbenchStreamThread::RunOutputStream(
     TestbenchStreamThread::Consumer consumer) {
   VLOG(1) << absl::StrFormat("RunOutputStream [%s]", stream_.name);
+  if (stream_.encoding == TestbenchStreamEncoding::kBinary) {
+    thread_ = absl::WrapUnique(new Thread([this, consumer]() {
+      VLOG(1) << absl::StrFormat("Thread for stream `%s` started",
+                                 stream_.name);
+      std::FILE* file = std::fopen(named_pipe_.path().c_str(), "rb");
+      if (file == nullptr) {
+        MaybeSetError(absl::InternalError(
+            absl::StrFormat("Cannot open named pipe for stream `%s`: %s",
+                            stream_.name, strerror(errno))));
+        return;
+      }
+      std::vector<uint8_t> record(stream_.BinaryRecordSizeInBytes());
+      while (true) {
+        size_t bytes_read = std::fread(record.data(), 1, record.size(), file);
+        if (bytes_read == 0 && std::feof(file) != 0) {
+          // The other end of the pipe has been closed.
+          VLOG(1) << absl::StrFormat("Pipe for stream `%s` has been closed.",
+                                     stream_.name);
+          break;
+        }
+        if (bytes_read != record.size()) {
+          MaybeSetError(absl::InternalError(absl::StrFormat(
+              "Truncated record (%d of %d bytes) read from stream `%s`",
+              bytes_read, record.size(), stream_.name)));
+          break;
+        }
+        Bits value = BinaryRecordToBits(record, stream_.width);
+        VLOG(1) << absl::StrFormat("Read from stream `%s`: %s", stream_.name,
+                                   BitsToString(value, FormatPreference::kHex));
+        absl::Status result = consumer(value);
+        if (!result.ok()) {
+          VLOG(1) << absl::StrFormat(
+              "Consumer for stream `%s` returned an error: %s", stream_.name,
+              result.message());
+          MaybeSetError(result);
+          continue;
+        }
+      }
+      std::fclose(file);
+    }));
+    return;
+  }
   thread_ = absl::WrapUnique(new Thread([this, consumer]() {
     VLOG(1) << absl::StrFormat("Thread for stream `%s` started", stream_.name);
     absl::StatusOr<FileLineReader> reader =
@@ -37,6 +37,19 @@ namespace verilog {
 // flowing from the testbench.
 enum class TestbenchStreamDirection : int8_t { kInput, kOutput };
 
+// Encoding of the values transferred over a stream:
+//
+//   kHexText: each value is a newline-terminated hexadecimal string, read and
+//     written in the testbench with `$fscanf`/`$fwriteh`.
+//
+//   kBinary: each value is a fixed-width binary record of
+//     4 * ceil(width / 32) bytes holding the value as 32-bit words, least
+//     significant word first. The testbench reads and writes records with the
+//     unformatted `%u` conversion. This avoids per-value text formatting and
+//     parsing which dominates the I/O cost of long simulations, but cannot
+//     represent X values (`%u` maps X and Z bits to zero).
+enum class TestbenchStreamEncoding : int8_t { kHexText, kBinary };
+
 // An abstraction representing a stream for communicating with Verilog
 // testbench.
 struct TestbenchStream {
@@ -50,6 +63,12 @@ struct TestbenchStream {
 
   // The width of the data to read/write to the testbench.
   int64_t width;
+
+  // How values are encoded on the underlying pipe.
+  TestbenchStreamEncoding encoding = TestbenchStreamEncoding::kHexText;
+
+  // The size in bytes of a single record when `encoding` is kBinary.
+  int64_t BinaryRecordSizeInBytes() const { return 4 * ((width + 31) / 32); }
 };
 
 // Class for emitting VAST code for reading and writing values to streams.
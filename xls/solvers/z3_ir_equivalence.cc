@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -112,6 +113,21 @@ absl::StatusOr<ProverResult> TryProveEquivalence(Function* a, Function* b,
   // to_test_function.  We do this so we can test whether the two functions are
   // semantically equivalent by making a single Z3-AST function and checking a
   // single eq node's value.
+  //
+  // A node of b whose (mapped) operands and operation match a node already in
+  // to_test_func reuses that node rather than cloning a duplicate. When b is a
+  // lightly-edited version of a -- the common case when checking candidate
+  // transforms -- this shares the untouched subtrees between the two halves of
+  // the equivalence check, so the Z3 translation cost scales with the size of
+  // the edit instead of the size of the function.
+  using StructuralKey = std::pair<Op, std::vector<Node*>>;
+  absl::flat_hash_map<StructuralKey, std::vector<Node*>> structural_index;
+  auto operand_vector = [](Node* n) {
+    return std::vector<Node*>(n->operands().begin(), n->operands().end());
+  };
+  for (Node* n : to_test_func->nodes()) {
+    structural_index[{n->op(), operand_vector(n)}].push_back(n);
+  }
   absl::flat_hash_map<Node*, Node*> node_map;
   for (Node* n : TopoSort(b)) {
     if (n->Is<Param>()) {
@@ -124,8 +140,23 @@ absl::StatusOr<ProverResult> TryProveEquivalence(Function* a, Function* b,
     for (Node* op : n->operands()) {
       new_ops.push_back(node_map[op]);
     }
+    Node* reused = nullptr;
+    auto it = structural_index.find(StructuralKey{n->op(), new_ops});
+    if (it != structural_index.end()) {
+      for (Node* candidate : it->second) {
+        if (n->IsDefinitelyEqualTo(candidate)) {
+          reused = candidate;
+          break;
+        }
+      }
+    }
+    if (reused != nullptr) {
+      node_map[n] = reused;
+      continue;
+    }
     XLS_ASSIGN_OR_RETURN(node_map[n],
                          n->CloneInNewFunction(new_ops, to_test_func));
+    structural_index[StructuralKey{n->op(), new_ops}].push_back(node_map[n]);
   }
 
   // Add check, coerce any tuples/arays into bit-arrays since z3 ir-translator
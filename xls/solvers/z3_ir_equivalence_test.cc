@@ -58,6 +58,41 @@ TEST_F(EquivalenceTest, NoOpIsEquivalent) {
       IsOkAndHolds(IsProvenTrue()));
 }
 
+TEST_F(EquivalenceTest, IdenticalFunctionsAreEquivalent) {
+  // Structurally identical functions share all their subtrees in the combined
+  // proof function; the check must still come out equivalent.
+  std::unique_ptr<Package> p = CreatePackage();
+  auto build = [&](std::string_view name) -> absl::StatusOr<Function*> {
+    FunctionBuilder fb(name, p.get());
+    BValue x = fb.Param("x", p->GetBitsType(32));
+    BValue y = fb.Param("y", p->GetBitsType(32));
+    BValue lit = fb.Literal(UBits(3, 32));
+    fb.BitSlice(fb.Add(fb.UMul(x, lit), y), /*start=*/4, /*width=*/16);
+    return fb.Build();
+  };
+  XLS_ASSERT_OK_AND_ASSIGN(Function * a, build("func_a"));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * b, build("func_b"));
+  EXPECT_THAT(TryProveEquivalence(a, b), IsOkAndHolds(IsProvenTrue()));
+}
+
+TEST_F(EquivalenceTest, SmallEditOnSharedSubtreesIsDetected) {
+  // Functions which differ only in one node deep in an otherwise shared
+  // expression must not be conflated by subtree sharing.
+  std::unique_ptr<Package> p = CreatePackage();
+  auto build = [&](std::string_view name,
+                   int64_t slice_start) -> absl::StatusOr<Function*> {
+    FunctionBuilder fb(name, p.get());
+    BValue x = fb.Param("x", p->GetBitsType(32));
+    BValue y = fb.Param("y", p->GetBitsType(32));
+    fb.BitSlice(fb.Add(fb.UMul(x, y), y), /*start=*/slice_start, /*width=*/8);
+    return fb.Build();
+  };
+  XLS_ASSERT_OK_AND_ASSIGN(Function * a, build("func_a", /*slice_start=*/0));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * b, build("func_b", /*slice_start=*/8));
+  EXPECT_THAT(TryProveEquivalence(a, b),
+              IsOkAndHolds(Not(IsProvenTrue())));
+}
+
 TEST_F(EquivalenceTest, ScopedNoOpIsEquivalent) {
   std::unique_ptr<Package> p = CreatePackage();
   FunctionBuilder fb(TestName(), p.get());
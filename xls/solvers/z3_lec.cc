@@ -15,6 +15,7 @@
 #include "xls/solvers/z3_lec.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
 #include <iostream>
@@ -36,6 +37,7 @@
 #include "xls/codegen/vast.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_ops.h"
 #include "xls/ir/format_preference.h"
@@ -87,6 +89,63 @@ absl::StatusOr<std::unique_ptr<Lec>> Lec::CreateForStage(
   return lec;
 }
 
+absl::StatusOr<LecPortfolioResult> Lec::RunPortfolio(const LecParams& params,
+                                                     int64_t num_partitions) {
+  XLS_RET_CHECK_GT(num_partitions, 0);
+  const int64_t total_bits =
+      params.ir_function->return_value()->GetType()->GetFlatBitCount();
+  num_partitions = std::min(num_partitions, std::max<int64_t>(total_bits, 1));
+
+  // One Lec - and thus one Z3 context - per output bit range: Z3 contexts are
+  // not thread-safe, so each concurrent query must own its own context.
+  const int64_t chunk_size = (total_bits + num_partitions - 1) / num_partitions;
+  std::vector<std::unique_ptr<Lec>> lecs;
+  for (int64_t p = 0; p < num_partitions; p++) {
+    auto lec = absl::WrapUnique<Lec>(new Lec(params.ir_function, params.netlist,
+                                             params.netlist_module_name,
+                                             std::nullopt, 0));
+    lec->output_bit_begin_ = std::min(p * chunk_size, total_bits);
+    lec->output_bit_end_ =
+        std::min(lec->output_bit_begin_ + chunk_size, total_bits);
+    XLS_RETURN_IF_ERROR(lec->Init());
+    lecs.push_back(std::move(lec));
+  }
+
+  // Solve the partitions concurrently. The first counterexample interrupts the
+  // solvers still running; an interrupted solver reports "equivalent", which
+  // is harmless since the overall verdict is already "not equivalent".
+  std::vector<int> equivalent(lecs.size(), 0);
+  std::atomic<bool> counterexample_found = false;
+  std::vector<std::unique_ptr<Thread>> threads;
+  threads.reserve(lecs.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(lecs.size()); i++) {
+    threads.push_back(std::make_unique<Thread>(
+        [&lecs, &equivalent, &counterexample_found, i] {
+          equivalent[i] = lecs[i]->Run() ? 1 : 0;
+          if (equivalent[i] == 0 && !counterexample_found.exchange(true)) {
+            for (int64_t j = 0; j < static_cast<int64_t>(lecs.size()); j++) {
+              if (j != i) {
+                Z3_interrupt(lecs[j]->ctx());
+              }
+            }
+          }
+        }));
+  }
+  for (std::unique_ptr<Thread>& thread : threads) {
+    thread->Join();
+  }
+
+  LecPortfolioResult result{/*proven_equivalent=*/true, /*counterexample=*/""};
+  for (int64_t i = 0; i < static_cast<int64_t>(lecs.size()); i++) {
+    if (equivalent[i] == 0) {
+      result.proven_equivalent = false;
+      result.counterexample = lecs[i]->ResultToString();
+      break;
+    }
+  }
+  return result;
+}
+
 Lec::Lec(Function* ir_function, Netlist* netlist,
          const std::string& netlist_module_name,
          std::optional<PipelineSchedule> schedule, int stage)
@@ -124,6 +183,10 @@ absl::Status Lec::Init() {
   Z3_ast x = Z3_mk_const(ctx(), Z3_mk_string_symbol(ctx(), "X"),
                          Z3_mk_bv_sort(ctx(), 1));
   std::vector<Z3_ast> eq_nodes;
+  // The flattened index of the current output bit across all output nodes;
+  // bits outside [output_bit_begin_, output_bit_end_) are still translated
+  // (for result printing) but not asserted equal.
+  int64_t flat_bit_index = 0;
   for (const Node* node : ir_output_nodes_) {
     // Extract the individual bits out of each IR output node, and match those
     // up the corresponding netlist bits. The netlist outputs do not contain
@@ -139,6 +202,10 @@ absl::Status Lec::Init() {
     XLS_RET_CHECK(ir_bits.size() == netlist_bits.size());
 
     for (int i = 0; i < ir_bits.size(); i++) {
+      bool in_partition =
+          output_bit_end_ < 0 || (flat_bit_index >= output_bit_begin_ &&
+                                  flat_bit_index < output_bit_end_);
+      flat_bit_index++;
       if (netlist_bits[i] == nullptr) {
         VLOG(3) << "  Skipping " << node->GetName() << " IR output bit " << i;
         ir_outputs_.push_back(x);
@@ -146,7 +213,9 @@ absl::Status Lec::Init() {
       } else {
         ir_outputs_.push_back(ir_bits[i]);
         netlist_outputs_.push_back(netlist_bits[i]);
-        eq_nodes.push_back(Z3_mk_eq(ctx(), ir_bits[i], netlist_bits[i]));
+        if (in_partition) {
+          eq_nodes.push_back(Z3_mk_eq(ctx(), ir_bits[i], netlist_bits[i]));
+        }
       }
     }
   }
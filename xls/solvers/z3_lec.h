@@ -15,6 +15,7 @@
 #ifndef XLS_SOLVERS_Z3_LEC_H_
 #define XLS_SOLVERS_Z3_LEC_H_
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -52,6 +53,15 @@ struct LecParams {
   std::string netlist_module_name;
 };
 
+// The outcome of a partitioned equivalence check (see Lec::RunPortfolio).
+struct LecPortfolioResult {
+  bool proven_equivalent;
+
+  // Human-readable description of the first counterexample found; empty when
+  // the designs are proven equivalent.
+  std::string counterexample;
+};
+
 // Class for performing logical equivalence checks between a function specified
 // in XLS IR (perhaps converted from DSLX) and a netlist.
 class Lec {
@@ -60,6 +70,14 @@ class Lec {
   // module.
   static absl::StatusOr<std::unique_ptr<Lec>> Create(const LecParams& params);
 
+  // Partitions the whole-function equivalence check into independent queries
+  // by output bit range and solves them concurrently, one Z3 context (and OS
+  // thread) per partition. The first counterexample found interrupts the
+  // remaining solvers. Per-stage checks and AddConstraints() are not
+  // supported in portfolio mode.
+  static absl::StatusOr<LecPortfolioResult> RunPortfolio(
+      const LecParams& params, int64_t num_partitions);
+
   // Creates a LEC object for a particular pipeline stage. The schedule only
   // directly applies to the specified XLS Function; the mapping of Netlist
   // cell/wire to stage is derived from there.
@@ -158,6 +176,12 @@ class Lec {
   std::optional<PipelineSchedule> schedule_;
   int stage_;
 
+  // Half-open range of flattened output bits this instance asserts equality
+  // over; an end of -1 means all bits. RunPortfolio() gives each partition
+  // its own range so the queries are independent.
+  int64_t output_bit_begin_ = 0;
+  int64_t output_bit_end_ = -1;
+
   // Z3 elements are, under the hood, void pointers, but let's respect the
   // interface and use std::optional to determine live-ness.
   std::optional<Z3_solver> solver_;
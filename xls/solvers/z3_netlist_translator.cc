@@ -194,8 +194,6 @@ absl::Status NetlistTranslator::Translate() {
 }
 
 absl::Status NetlistTranslator::TranslateCell(const Cell& cell) {
-  using netlist::function::Ast;
-
   // If this cell is actually a reference to a module defined in this netlist,
   // then translate it into Z3-space here and grab its output nodes.
   std::string entry_name = cell.cell_library_entry()->name();
@@ -236,47 +234,60 @@ absl::Status NetlistTranslator::TranslateCell(const Cell& cell) {
     XLS_ASSIGN_OR_RETURN(state_table_values, TranslateStateTable(cell));
   }
 
-  const CellLibraryEntry::OutputPinToFunction& pins =
-      entry->output_pin_to_function();
   for (const auto& output : cell.outputs()) {
-    XLS_ASSIGN_OR_RETURN(Ast ast, netlist::function::Parser::ParseFunction(
-                                      pins.at(output.name)));
-    XLS_ASSIGN_OR_RETURN(Z3_ast result,
-                         TranslateFunction(cell, ast, state_table_values));
+    XLS_ASSIGN_OR_RETURN(const FunctionTemplate* function_template,
+                         GetFunctionTemplate(entry, output.name));
+    XLS_ASSIGN_OR_RETURN(
+        Z3_ast result,
+        InstantiateFunctionTemplate(cell, *function_template,
+                                    state_table_values));
     translated_[output.netref] = result;
   }
 
   return absl::OkStatus();
 }
 
+absl::StatusOr<const NetlistTranslator::FunctionTemplate*>
+NetlistTranslator::GetFunctionTemplate(const CellLibraryEntry* entry,
+                                       const std::string& pin_name) {
+  auto it = function_templates_.find(std::make_pair(entry, pin_name));
+  if (it != function_templates_.end()) {
+    return &it->second;
+  }
+
+  XLS_ASSIGN_OR_RETURN(
+      Ast ast, netlist::function::Parser::ParseFunction(
+                   entry->output_pin_to_function().at(pin_name)));
+  FunctionTemplate function_template;
+  XLS_ASSIGN_OR_RETURN(
+      function_template.body,
+      BuildTemplateBody(ast, &function_template.placeholders));
+  auto result = function_templates_.insert(
+      {std::make_pair(entry, pin_name), std::move(function_template)});
+  return &result.first->second;
+}
+
 // After all the above, this is the spot where any _ACTUAL_ translation happens.
-absl::StatusOr<Z3_ast> NetlistTranslator::TranslateFunction(
-    const Cell& cell, netlist::function::Ast ast,
-    const absl::flat_hash_map<std::string, Z3_ast>& state_table_values) {
+absl::StatusOr<Z3_ast> NetlistTranslator::BuildTemplateBody(
+    const Ast& ast, std::vector<std::pair<std::string, Z3_ast>>* placeholders) {
   switch (ast.kind()) {
     case Ast::Kind::kAnd: {
-      XLS_ASSIGN_OR_RETURN(
-          Z3_ast lhs,
-          TranslateFunction(cell, ast.children()[0], state_table_values));
-      XLS_ASSIGN_OR_RETURN(
-          Z3_ast rhs,
-          TranslateFunction(cell, ast.children()[1], state_table_values));
+      XLS_ASSIGN_OR_RETURN(Z3_ast lhs,
+                           BuildTemplateBody(ast.children()[0], placeholders));
+      XLS_ASSIGN_OR_RETURN(Z3_ast rhs,
+                           BuildTemplateBody(ast.children()[1], placeholders));
       return Z3_mk_bvand(ctx_, lhs, rhs);
     }
     case Ast::Kind::kIdentifier: {
-      for (const auto& input : cell.inputs()) {
-        if (input.name == ast.name()) {
-          return translated_.at(input.netref);
+      for (const auto& placeholder : *placeholders) {
+        if (placeholder.first == ast.name()) {
+          return placeholder.second;
         }
       }
-
-      if (state_table_values.contains(ast.name())) {
-        return state_table_values.at(ast.name());
-      }
-
-      return absl::NotFoundError(absl::StrFormat(
-          "Identifier \"%s\", was not found in cell %s's inputs.", ast.name(),
-          cell.name()));
+      Z3_ast placeholder = Z3_mk_fresh_const(ctx_, ast.name().c_str(),
+                                             Z3_mk_bv_sort(ctx_, 1));
+      placeholders->push_back(std::make_pair(ast.name(), placeholder));
+      return placeholder;
     }
     case Ast::Kind::kLiteralOne: {
       return Z3_mk_int(ctx_, 1, Z3_mk_bv_sort(ctx_, 1));
@@ -286,26 +297,21 @@ absl::StatusOr<Z3_ast> NetlistTranslator::TranslateFunction(
     }
     case Ast::Kind::kNot: {
       XLS_ASSIGN_OR_RETURN(
-          Z3_ast child,
-          TranslateFunction(cell, ast.children()[0], state_table_values));
+          Z3_ast child, BuildTemplateBody(ast.children()[0], placeholders));
       return Z3_mk_bvnot(ctx_, child);
     }
     case Ast::Kind::kOr: {
-      XLS_ASSIGN_OR_RETURN(
-          Z3_ast lhs,
-          TranslateFunction(cell, ast.children()[0], state_table_values));
-      XLS_ASSIGN_OR_RETURN(
-          Z3_ast rhs,
-          TranslateFunction(cell, ast.children()[1], state_table_values));
+      XLS_ASSIGN_OR_RETURN(Z3_ast lhs,
+                           BuildTemplateBody(ast.children()[0], placeholders));
+      XLS_ASSIGN_OR_RETURN(Z3_ast rhs,
+                           BuildTemplateBody(ast.children()[1], placeholders));
       return Z3_mk_bvor(ctx_, lhs, rhs);
     }
     case Ast::Kind::kXor: {
-      XLS_ASSIGN_OR_RETURN(
-          Z3_ast lhs,
-          TranslateFunction(cell, ast.children()[0], state_table_values));
-      XLS_ASSIGN_OR_RETURN(
-          Z3_ast rhs,
-          TranslateFunction(cell, ast.children()[1], state_table_values));
+      XLS_ASSIGN_OR_RETURN(Z3_ast lhs,
+                           BuildTemplateBody(ast.children()[0], placeholders));
+      XLS_ASSIGN_OR_RETURN(Z3_ast rhs,
+                           BuildTemplateBody(ast.children()[1], placeholders));
       return Z3_mk_bvxor(ctx_, lhs, rhs);
     }
     default:
@@ -314,6 +320,41 @@ absl::StatusOr<Z3_ast> NetlistTranslator::TranslateFunction(
   }
 }
 
+absl::StatusOr<Z3_ast> NetlistTranslator::InstantiateFunctionTemplate(
+    const Cell& cell, const FunctionTemplate& function_template,
+    const absl::flat_hash_map<std::string, Z3_ast>& state_table_values) {
+  if (function_template.placeholders.empty()) {
+    return function_template.body;
+  }
+
+  std::vector<Z3_ast> from;
+  std::vector<Z3_ast> to;
+  from.reserve(function_template.placeholders.size());
+  to.reserve(function_template.placeholders.size());
+  for (const auto& [name, placeholder] : function_template.placeholders) {
+    Z3_ast value = nullptr;
+    for (const auto& input : cell.inputs()) {
+      if (input.name == name) {
+        value = translated_.at(input.netref);
+        break;
+      }
+    }
+    if (value == nullptr && state_table_values.contains(name)) {
+      value = state_table_values.at(name);
+    }
+    if (value == nullptr) {
+      return absl::NotFoundError(absl::StrFormat(
+          "Identifier \"%s\", was not found in cell %s's inputs.", name,
+          cell.name()));
+    }
+    from.push_back(placeholder);
+    to.push_back(value);
+  }
+  return Z3_substitute(ctx_, function_template.body,
+                       static_cast<unsigned int>(from.size()), from.data(),
+                       to.data());
+}
+
 absl::StatusOr<absl::flat_hash_map<std::string, Z3_ast>>
 NetlistTranslator::TranslateStateTable(const Cell& cell) {
   const StateTable& table = cell.cell_library_entry()->state_table().value();
@@ -17,12 +17,14 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "xls/netlist/cell_library.h"
 #include "xls/netlist/function_parser.h"
 #include "xls/netlist/netlist.h"
 #include "../z3/src/api/z3.h"
@@ -86,21 +88,54 @@ class NetlistTranslator {
           module_refs);
   absl::Status Init();
 
+  // A cell function compiled once into Z3-space, with a placeholder constant
+  // standing in for each distinct identifier in the function. Cell instances
+  // are translated by substituting per-instance values for the placeholders
+  // instead of re-parsing and re-walking the function per instance.
+  struct FunctionTemplate {
+    Z3_ast body;
+    // Distinct identifiers appearing in the function paired with the
+    // placeholder constant created for each.
+    std::vector<std::pair<std::string, Z3_ast>> placeholders;
+  };
+
   // Translates the module, cell, or cell function, respectively, into Z3-space.
   absl::Status Translate();
   absl::Status TranslateCell(const netlist::rtl::Cell& cell);
-  absl::StatusOr<Z3_ast> TranslateFunction(
-      const netlist::rtl::Cell& cell, netlist::function::Ast ast,
-      const absl::flat_hash_map<std::string, Z3_ast>& state_table_values);
   absl::StatusOr<absl::flat_hash_map<std::string, Z3_ast>> TranslateStateTable(
       const netlist::rtl::Cell& cell);
 
+  // Returns the compiled template for the given output pin of the given
+  // library entry, parsing and compiling the function on first use.
+  absl::StatusOr<const FunctionTemplate*> GetFunctionTemplate(
+      const netlist::CellLibraryEntry* entry, const std::string& pin_name);
+
+  // Builds the Z3 body of a function template from its parsed AST, creating
+  // (and recording in `placeholders`) a placeholder constant for each distinct
+  // identifier.
+  absl::StatusOr<Z3_ast> BuildTemplateBody(
+      const netlist::function::Ast& ast,
+      std::vector<std::pair<std::string, Z3_ast>>* placeholders);
+
+  // Instantiates the given template for the given cell by substituting the
+  // cell's translated input nets (or state table values) for the template's
+  // placeholders.
+  absl::StatusOr<Z3_ast> InstantiateFunctionTemplate(
+      const netlist::rtl::Cell& cell, const FunctionTemplate& function_template,
+      const absl::flat_hash_map<std::string, Z3_ast>& state_table_values);
+
   Z3_context ctx_;
   const netlist::rtl::Module* module_;
 
   // Maps a NetDef to a Z3 entity.
   absl::flat_hash_map<netlist::rtl::NetRef, Z3_ast> translated_;
 
+  // Compiled cell functions keyed by library entry and output pin. Shared by
+  // every instance of the cell, including across Retranslate() calls.
+  absl::flat_hash_map<std::pair<const netlist::CellLibraryEntry*, std::string>,
+                      FunctionTemplate>
+      function_templates_;
+
   const absl::flat_hash_map<std::string, const netlist::rtl::Module*>
       module_refs_;
 };
@@ -0,0 +1,191 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/synthesis/characterization_driver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/delay_model/delay_model.pb.h"
+
+namespace xls {
+namespace synthesis {
+namespace {
+
+// Loads the checkpoint at `checkpoint_path` if it exists; a missing file is
+// not an error (first run) and yields an empty DataPoints.
+absl::StatusOr<delay_model::DataPoints> LoadCheckpoint(
+    const std::string& checkpoint_path) {
+  absl::Status exists = FileExists(checkpoint_path);
+  if (absl::IsNotFound(exists)) {
+    return delay_model::DataPoints();
+  }
+  XLS_RETURN_IF_ERROR(exists);
+  return ParseTextProtoFile<delay_model::DataPoints>(checkpoint_path);
+}
+
+}  // namespace
+
+std::string CharacterizationPointKey(
+    const delay_model::Operation& operation) {
+  std::string key = absl::StrCat(operation.op(), ": ", operation.bit_count());
+  for (const delay_model::Operation::Operand& operand : operation.operands()) {
+    absl::StrAppend(&key, ", ", operand.bit_count());
+    if (operand.element_count() != 0) {
+      absl::StrAppend(&key, "[", operand.element_count(), "]");
+    }
+  }
+  if (operation.specialization() != delay_model::NO_SPECIALIZATION) {
+    absl::StrAppend(
+        &key, " ",
+        delay_model::SpecializationKind_Name(operation.specialization()));
+  }
+  return key;
+}
+
+absl::StatusOr<delay_model::DataPoints> RunCharacterization(
+    absl::Span<const CharacterizationPoint> points,
+    const CharacterizationOptions& options) {
+  delay_model::DataPoints results;
+  absl::flat_hash_set<std::string> completed_keys;
+  if (!options.checkpoint_path.empty()) {
+    XLS_ASSIGN_OR_RETURN(results, LoadCheckpoint(options.checkpoint_path));
+    for (const delay_model::DataPoint& data_point : results.data_points()) {
+      completed_keys.insert(CharacterizationPointKey(data_point.operation()));
+    }
+  }
+
+  // The shard is the points not covered by the checkpoint. Duplicate keys
+  // within `points` are characterized once.
+  std::vector<const CharacterizationPoint*> pending;
+  for (const CharacterizationPoint& point : points) {
+    if (completed_keys.insert(CharacterizationPointKey(point.operation))
+            .second) {
+      pending.push_back(&point);
+    }
+  }
+
+  // Workers pull the next pending point off a shared index; completed points
+  // are appended to `results` and the checkpoint rewritten under `mutex` so
+  // an interrupted run loses at most the points in flight.
+  absl::Mutex mutex;
+  absl::Status first_error;
+  std::atomic<int64_t> next_index = 0;
+  auto run_points = [&]() {
+    while (true) {
+      int64_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+      if (index >= static_cast<int64_t>(pending.size())) {
+        return;
+      }
+      {
+        absl::MutexLock lock(&mutex);
+        if (!first_error.ok()) {
+          return;
+        }
+      }
+      absl::StatusOr<delay_model::DataPoint> data_point =
+          pending[index]->synthesize();
+      absl::MutexLock lock(&mutex);
+      if (!data_point.ok()) {
+        if (first_error.ok()) {
+          first_error = data_point.status();
+        }
+        return;
+      }
+      *results.add_data_points() = *std::move(data_point);
+      if (!options.checkpoint_path.empty() && first_error.ok()) {
+        first_error = SetTextProtoFile(options.checkpoint_path, results);
+      }
+    }
+  };
+
+  int64_t worker_count =
+      std::min(options.worker_count, static_cast<int64_t>(pending.size()));
+  if (worker_count <= 1) {
+    run_points();
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (int64_t i = 0; i < worker_count; ++i) {
+      workers.push_back(std::thread(run_points));
+    }
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+  }
+  XLS_RETURN_IF_ERROR(first_error);
+  return results;
+}
+
+absl::StatusOr<delay_model::DelayModel> JoinDelayModel(
+    const delay_model::OpModels& op_models,
+    const delay_model::DataPoints& data_points) {
+  absl::flat_hash_set<std::string> regression_ops;
+  for (const delay_model::OpModel& op_model : op_models.op_models()) {
+    if (op_model.estimator().estimator_case() ==
+        delay_model::Estimator::kRegression) {
+      regression_ops.insert(op_model.op());
+    }
+  }
+  absl::flat_hash_set<std::string> data_point_ops;
+  for (const delay_model::DataPoint& data_point : data_points.data_points()) {
+    data_point_ops.insert(data_point.operation().op());
+  }
+
+  std::vector<std::string> errors;
+  for (const std::string& op : regression_ops) {
+    if (!data_point_ops.contains(op)) {
+      errors.push_back(absl::StrFormat(
+          "%s has a regression estimator but no data points.", op));
+    }
+  }
+  for (const std::string& op : data_point_ops) {
+    if (!regression_ops.contains(op)) {
+      errors.push_back(absl::StrFormat(
+          "%s has data points but doesn't have a regression estimator.", op));
+    }
+  }
+  if (!errors.empty()) {
+    std::sort(errors.begin(), errors.end());
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Op models and data points are out of sync: ",
+        absl::StrJoin(errors, " ")));
+  }
+
+  delay_model::DelayModel delay_model;
+  for (const delay_model::OpModel& op_model : op_models.op_models()) {
+    *delay_model.add_op_models() = op_model;
+  }
+  for (const delay_model::DataPoint& data_point : data_points.data_points()) {
+    *delay_model.add_data_points() = data_point;
+  }
+  return delay_model;
+}
+
+}  // namespace synthesis
+}  // namespace xls
@@ -0,0 +1,77 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_SYNTHESIS_CHARACTERIZATION_DRIVER_H_
+#define XLS_SYNTHESIS_CHARACTERIZATION_DRIVER_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xls/delay_model/delay_model.pb.h"
+
+namespace xls {
+namespace synthesis {
+
+// A single (op x width x configuration) sample to characterize. `operation`
+// describes the point (and keys checkpoint resumption); `synthesize` performs
+// the actual synthesis run and returns the measured data point. The callback
+// is invoked from a worker thread and must be safe to run concurrently with
+// the callbacks of other points.
+struct CharacterizationPoint {
+  delay_model::Operation operation;
+  std::function<absl::StatusOr<delay_model::DataPoint>()> synthesize;
+};
+
+// Options controlling a characterization run.
+struct CharacterizationOptions {
+  // Number of worker threads the points are sharded across. Values less than
+  // two run the points serially on the calling thread.
+  int64_t worker_count = 1;
+
+  // Path of a DataPoints textproto checkpoint. If nonempty and the file
+  // exists, points already present in it are skipped; every newly completed
+  // point is appended and the file rewritten so an interrupted run resumes
+  // where it left off. Empty disables checkpointing.
+  std::string checkpoint_path;
+};
+
+// Returns the key identifying an operation for checkpoint resumption. The
+// key is derived from the same fields timing_characterization_client.py keys
+// on: the op name, result bit count, operand bit and element counts, and
+// specialization.
+std::string CharacterizationPointKey(const delay_model::Operation& operation);
+
+// Characterizes `points`, sharding them across `options.worker_count` worker
+// threads, and returns the accumulated data points (checkpointed points
+// included). Points whose key already appears in the checkpoint are not
+// re-synthesized. Synthesis failures abort the run, but the checkpoint
+// retains everything completed before the failure.
+absl::StatusOr<delay_model::DataPoints> RunCharacterization(
+    absl::Span<const CharacterizationPoint> points,
+    const CharacterizationOptions& options);
+
+// Joins an OpModels proto and a DataPoints proto into a DelayModel,
+// following delay_model_join.py semantics: plain concatenation plus a check
+// that ops with regression estimators (and only those ops) have data points.
+absl::StatusOr<delay_model::DelayModel> JoinDelayModel(
+    const delay_model::OpModels& op_models,
+    const delay_model::DataPoints& data_points);
+
+}  // namespace synthesis
+}  // namespace xls
+
+#endif  // XLS_SYNTHESIS_CHARACTERIZATION_DRIVER_H_
@@ -0,0 +1,169 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/synthesis/characterization_driver.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_file.h"
+#include "xls/common/status/matchers.h"
+#include "xls/delay_model/delay_model.pb.h"
+
+namespace xls {
+namespace synthesis {
+namespace {
+
+using ::testing::HasSubstr;
+using ::xls::status_testing::StatusIs;
+
+delay_model::Operation MakeOperation(const std::string& op,
+                                     int64_t result_bit_count,
+                                     int64_t operand_bit_count) {
+  delay_model::Operation operation;
+  operation.set_op(op);
+  operation.set_bit_count(result_bit_count);
+  operation.add_operands()->set_bit_count(operand_bit_count);
+  return operation;
+}
+
+CharacterizationPoint MakePoint(const std::string& op,
+                                int64_t result_bit_count, int64_t delay,
+                                std::atomic<int64_t>* synthesis_count) {
+  CharacterizationPoint point;
+  point.operation = MakeOperation(op, result_bit_count, result_bit_count);
+  point.synthesize =
+      [operation = point.operation, delay,
+       synthesis_count]() -> absl::StatusOr<delay_model::DataPoint> {
+    synthesis_count->fetch_add(1);
+    delay_model::DataPoint data_point;
+    *data_point.mutable_operation() = operation;
+    data_point.set_delay(delay);
+    return data_point;
+  };
+  return point;
+}
+
+TEST(CharacterizationDriverTest, PointKeyIncludesAllFields) {
+  delay_model::Operation operation = MakeOperation("kAdd", 8, 8);
+  operation.add_operands()->set_bit_count(8);
+  EXPECT_EQ(CharacterizationPointKey(operation), "kAdd: 8, 8, 8");
+
+  operation.mutable_operands(1)->set_element_count(4);
+  operation.set_specialization(delay_model::OPERANDS_IDENTICAL);
+  EXPECT_EQ(CharacterizationPointKey(operation),
+            "kAdd: 8, 8, 8[4] OPERANDS_IDENTICAL");
+}
+
+TEST(CharacterizationDriverTest, RunsAllPointsInParallel) {
+  std::atomic<int64_t> synthesis_count = 0;
+  std::vector<CharacterizationPoint> points;
+  for (int64_t width = 1; width <= 16; ++width) {
+    points.push_back(MakePoint("kAdd", width, 100 * width, &synthesis_count));
+  }
+  CharacterizationOptions options;
+  options.worker_count = 4;
+  XLS_ASSERT_OK_AND_ASSIGN(delay_model::DataPoints results,
+                           RunCharacterization(points, options));
+  EXPECT_EQ(synthesis_count.load(), 16);
+  EXPECT_EQ(results.data_points_size(), 16);
+}
+
+TEST(CharacterizationDriverTest, ResumesFromCheckpoint) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempFile checkpoint, TempFile::Create());
+  std::atomic<int64_t> synthesis_count = 0;
+  std::vector<CharacterizationPoint> points;
+  for (int64_t width = 1; width <= 4; ++width) {
+    points.push_back(MakePoint("kUMul", width, 100 * width, &synthesis_count));
+  }
+  CharacterizationOptions options;
+  options.checkpoint_path = checkpoint.path().string();
+
+  XLS_ASSERT_OK_AND_ASSIGN(delay_model::DataPoints results,
+                           RunCharacterization(points, options));
+  EXPECT_EQ(synthesis_count.load(), 4);
+  EXPECT_EQ(results.data_points_size(), 4);
+
+  // The checkpoint holds every completed point, so a rerun (e.g. after an
+  // interruption) synthesizes nothing new.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      delay_model::DataPoints checkpointed,
+      ParseTextProtoFile<delay_model::DataPoints>(checkpoint.path()));
+  EXPECT_EQ(checkpointed.data_points_size(), 4);
+
+  points.push_back(MakePoint("kUMul", 5, 500, &synthesis_count));
+  XLS_ASSERT_OK_AND_ASSIGN(results, RunCharacterization(points, options));
+  EXPECT_EQ(synthesis_count.load(), 5);
+  EXPECT_EQ(results.data_points_size(), 5);
+}
+
+TEST(CharacterizationDriverTest, SynthesisFailureAbortsRun) {
+  std::atomic<int64_t> synthesis_count = 0;
+  std::vector<CharacterizationPoint> points;
+  points.push_back(MakePoint("kAdd", 1, 100, &synthesis_count));
+  points.push_back(CharacterizationPoint{
+      .operation = MakeOperation("kAdd", 2, 2),
+      .synthesize = []() -> absl::StatusOr<delay_model::DataPoint> {
+        return absl::InternalError("yosys crashed");
+      }});
+  EXPECT_THAT(RunCharacterization(points, CharacterizationOptions()),
+              StatusIs(absl::StatusCode::kInternal, HasSubstr("yosys")));
+}
+
+TEST(CharacterizationDriverTest, JoinDelayModelConcatenates) {
+  delay_model::OpModels op_models;
+  delay_model::OpModel* op_model = op_models.add_op_models();
+  op_model->set_op("kAdd");
+  op_model->mutable_estimator()->mutable_regression();
+
+  delay_model::DataPoints data_points;
+  delay_model::DataPoint* data_point = data_points.add_data_points();
+  *data_point->mutable_operation() = MakeOperation("kAdd", 8, 8);
+  data_point->set_delay(123);
+
+  XLS_ASSERT_OK_AND_ASSIGN(delay_model::DelayModel delay_model,
+                           JoinDelayModel(op_models, data_points));
+  EXPECT_EQ(delay_model.op_models_size(), 1);
+  EXPECT_EQ(delay_model.data_points_size(), 1);
+}
+
+TEST(CharacterizationDriverTest, JoinDelayModelChecksSync) {
+  delay_model::OpModels op_models;
+  delay_model::OpModel* op_model = op_models.add_op_models();
+  op_model->set_op("kAdd");
+  op_model->mutable_estimator()->mutable_regression();
+
+  EXPECT_THAT(
+      JoinDelayModel(op_models, delay_model::DataPoints()),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("kAdd has a regression estimator but no data")));
+
+  delay_model::DataPoints data_points;
+  *data_points.add_data_points()->mutable_operation() =
+      MakeOperation("kSub", 8, 8);
+  EXPECT_THAT(JoinDelayModel(delay_model::OpModels(), data_points),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("kSub has data points")));
+}
+
+}  // namespace
+}  // namespace synthesis
+}  // namespace xls
@@ -17,8 +17,13 @@
 #include <memory>
 #include <string>
 
+#include "absl/base/const_init.h"
+#include "absl/base/no_destructor.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "grpcpp/support/channel_arguments.h"
 #include "grpcpp/support/status.h"
 #include "grpcpp/channel.h"
 #include "grpcpp/client_context.h"
@@ -62,5 +67,46 @@ absl::StatusOr<CompileResponse> SynthesizeViaClient(
   return response;
 }
 
+namespace {
+
+// Returns a process-wide stub for `server`, creating (and caching) a warm
+// channel on first use. gRPC stubs are thread-safe and multiplex concurrent
+// RPCs over a single HTTP/2 connection, so callers pipeline outstanding
+// requests without per-call connection setup.
+std::shared_ptr<SynthesisService::Stub> GetSharedStub(
+    const std::string& server) {
+  static absl::Mutex mutex(absl::kConstInit);
+  static absl::NoDestructor<
+      absl::flat_hash_map<std::string, std::shared_ptr<SynthesisService::Stub>>>
+      stubs;
+  absl::MutexLock lock(&mutex);
+  auto it = stubs->find(server);
+  if (it != stubs->end()) {
+    return it->second;
+  }
+  grpc::ChannelArguments args;
+  // Verilog text compresses well; ship it gzipped to cut payload round-trip
+  // time for large modules.
+  args.SetCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+  std::shared_ptr<grpc::Channel> channel = grpc::CreateCustomChannel(
+      server, GetChannelCredentials(), args);
+  auto stub = std::shared_ptr<SynthesisService::Stub>(
+      SynthesisService::NewStub(channel));
+  stubs->emplace(server, stub);
+  return stub;
+}
+
+}  // namespace
+
+absl::StatusOr<CompileResponse> SynthesizeViaSharedClient(
+    const std::string& server, const CompileRequest& request) {
+  std::shared_ptr<SynthesisService::Stub> stub = GetSharedStub(server);
+  grpc::ClientContext context;
+  CompileResponse response;
+  XLS_RETURN_IF_ERROR(
+      GrpcToAbslStatus(stub->Compile(&context, request, &response)));
+  return response;
+}
+
 }  // namespace synthesis
 }  // namespace xls
@@ -28,6 +28,16 @@ absl::StatusOr<CompileResponse> SynthesizeViaClient(
     const std::string& server,
     const CompileRequest& request);
 
+// Like SynthesizeViaClient but backed by a process-wide pool of warm channels
+// keyed by server endpoint. The connection (and the server's synthesis
+// session behind it) stays up across requests, request payloads are sent
+// gzip-compressed, and concurrent callers are multiplexed over the same
+// HTTP/2 connection so multiple outstanding requests pipeline instead of
+// paying a connection setup per call. Preferred for workloads issuing many
+// small compile requests (FDO, timing characterization).
+absl::StatusOr<CompileResponse> SynthesizeViaSharedClient(
+    const std::string& server, const CompileRequest& request);
+
 }  // namespace synthesis
 }  // namespace xls
 
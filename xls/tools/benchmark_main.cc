@@ -20,7 +20,9 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <ostream>
 #include <random>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -32,6 +34,7 @@
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
@@ -47,6 +50,7 @@
 #include "xls/common/init_xls.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/data_structures/binary_decision_diagram.h"
 #include "xls/delay_model/analyze_critical_path.h"
 #include "xls/delay_model/delay_estimator.h"
@@ -69,6 +73,7 @@
 #include "xls/ir/topo_sort.h"
 #include "xls/ir/value.h"
 #include "xls/jit/block_jit.h"
+#include "xls/jit/function_base_jit.h"
 #include "xls/jit/function_jit.h"
 #include "xls/jit/jit_channel_queue.h"
 #include "xls/jit/jit_runtime.h"
@@ -121,6 +126,19 @@ ABSL_FLAG(bool, use_context_narrowing_analysis, false,
           "usage context to narrow values more aggressively.");
 ABSL_FLAG(bool, run_evaluators, true,
           "Whether to run the JIT and interpreter.");
+ABSL_FLAG(bool, profile_jit_nodes, false,
+          "Build the JIT with per-node cycle counters and print a per-node "
+          "heat report after the JIT benchmark runs. Only supported when the "
+          "top entity is a function. The instrumentation perturbs the "
+          "reported JIT call rates.");
+ABSL_FLAG(int64_t, benchmark_parallelism, 1,
+          "Maximum number of independent benchmark phases to run "
+          "concurrently. With values greater than one, phases which do not "
+          "share state (evaluator comparisons vs. optimization or codegen, "
+          "analyses of the optimized IR) are overlapped and their reports "
+          "are printed in the usual order. Concurrent phases share the "
+          "machine, so evaluator throughput numbers may be perturbed; use "
+          "the default of 1 when exact rate measurements matter.");
 ABSL_FLAG(bool, compare_delay_to_synthesis, false,
           "Synthesize the target and report metrics for post-synthesis delay "
           "vs. the delay model prediction.");
@@ -139,9 +157,9 @@ std::string KnownBitString(Node* node, const QueryEngine& query_engine) {
   return query_engine.ToString(node);
 }
 
-void PrintNodeBreakdown(FunctionBase* f) {
-  std::cout << absl::StreamFormat("Entry function (%s) node count: %d nodes\n",
-                                  f->name(), f->node_count());
+void PrintNodeBreakdown(FunctionBase* f, std::ostream& out) {
+  out << absl::StreamFormat("Entry function (%s) node count: %d nodes\n",
+                            f->name(), f->node_count());
   std::vector<Op> ops;
   absl::flat_hash_map<Op, int64_t> op_count;
   for (Node* node : f->nodes()) {
@@ -152,11 +170,11 @@ void PrintNodeBreakdown(FunctionBase* f) {
   }
   std::sort(ops.begin(), ops.end(),
             [&](Op a, Op b) { return op_count.at(a) > op_count.at(b); });
-  std::cout << "Breakdown by op of all nodes in the graph:" << '\n';
+  out << "Breakdown by op of all nodes in the graph:" << '\n';
   for (Op op : ops) {
-    std::cout << absl::StreamFormat("  %15s : %5d (%5.2f%%)\n", OpToString(op),
-                                    op_count.at(op),
-                                    100.0 * op_count.at(op) / f->node_count());
+    out << absl::StreamFormat("  %15s : %5d (%5.2f%%)\n", OpToString(op),
+                              op_count.at(op),
+                              100.0 * op_count.at(op) / f->node_count());
   }
 }
 
@@ -164,9 +182,59 @@ int64_t DurationToMs(absl::Duration duration) {
   return duration / absl::Milliseconds(1);
 }
 
+// A named phase of the benchmark which writes its report to the given stream.
+struct BenchmarkPhase {
+  std::string name;
+  std::function<absl::Status(std::ostream&)> run;
+};
+
+// Runs the given phases, concurrently when --benchmark_parallelism is greater
+// than one. Concurrent phases write into per-phase buffers which are printed
+// in the given order once all phases complete, so the report is identical to a
+// serial run. Phases grouped together must not mutate shared state.
+absl::Status RunPhases(std::vector<BenchmarkPhase> phases) {
+  int64_t parallelism = absl::GetFlag(FLAGS_benchmark_parallelism);
+  if (parallelism <= 1 || phases.size() <= 1) {
+    for (BenchmarkPhase& phase : phases) {
+      VLOG(1) << "Running benchmark phase: " << phase.name;
+      XLS_RETURN_IF_ERROR(phase.run(std::cout));
+    }
+    return absl::OkStatus();
+  }
+
+  int64_t num_threads =
+      std::min(parallelism, static_cast<int64_t>(phases.size()));
+  std::vector<std::ostringstream> outputs(phases.size());
+  std::vector<absl::Status> statuses(phases.size());
+  std::vector<std::unique_ptr<Thread>> threads;
+  threads.reserve(num_threads);
+  for (int64_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+    // Phases are distributed round-robin across threads.
+    threads.push_back(absl::WrapUnique(new Thread([&, thread_idx]() {
+      for (int64_t i = thread_idx; i < static_cast<int64_t>(phases.size());
+           i += num_threads) {
+        VLOG(1) << "Running benchmark phase: " << phases[i].name;
+        statuses[i] = phases[i].run(outputs[i]);
+      }
+    })));
+  }
+  for (std::unique_ptr<Thread>& thread : threads) {
+    thread->Join();
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(phases.size()); ++i) {
+    std::cout << outputs[i].str();
+  }
+  for (int64_t i = 0; i < static_cast<int64_t>(phases.size()); ++i) {
+    XLS_RETURN_IF_ERROR(statuses[i])
+        << "in benchmark phase: " << phases[i].name;
+  }
+  return absl::OkStatus();
+}
+
 // Run the standard pipeline on the given package and prints stats about the
 // passes and execution time.
-absl::Status RunOptimizationAndPrintStats(Package* package) {
+absl::Status RunOptimizationAndPrintStats(Package* package,
+                                          std::ostream& out) {
   std::unique_ptr<OptimizationCompoundPass> pipeline =
       CreateOptimizationPassPipeline();
 
@@ -191,10 +259,10 @@ absl::Status RunOptimizationAndPrintStats(Package* package) {
   XLS_RETURN_IF_ERROR(
       pipeline->Run(package, pass_options, &pass_results).status());
   absl::Duration total_time = absl::Now() - start;
-  std::cout << absl::StreamFormat("Optimization time: %dms\n",
-                                  DurationToMs(total_time));
-  std::cout << absl::StreamFormat("Dynamic pass count: %d\n",
-                                  pass_results.invocations.size());
+  out << absl::StreamFormat("Optimization time: %dms\n",
+                            DurationToMs(total_time));
+  out << absl::StreamFormat("Dynamic pass count: %d\n",
+                            pass_results.invocations.size());
 
   // Aggregate run times by the pass name and print a table of the aggregate
   // execution time of each pass in descending order.
@@ -236,14 +304,13 @@ absl::Status RunOptimizationAndPrintStats(Package* package) {
               }
               return a > b;
             });
-  std::cout << "Pass run durations (# of times pass changed IR / # of times "
-               "pass was run):"
-            << '\n';
+  out << "Pass run durations (# of times pass changed IR / # of times "
+         "pass was run):"
+      << '\n';
   for (const std::string& name : pass_names) {
-    std::cout << absl::StreamFormat("  %-20s : %-5dms (%3d / %3d)\n", name,
-                                    DurationToMs(pass_times.at(name)),
-                                    changed_counts.at(name),
-                                    pass_counts.at(name));
+    out << absl::StreamFormat("  %-20s : %-5dms (%3d / %3d)\n", name,
+                              DurationToMs(pass_times.at(name)),
+                              changed_counts.at(name), pass_counts.at(name));
   }
   return absl::OkStatus();
 }
@@ -542,13 +609,14 @@ constexpr int64_t kJitRunMultiplier = 1000;
 template <typename Rng>
 absl::Status RunFunctionInterpreterAndJit(Function* function,
                                           std::string_view description,
-                                          Rng& rng_engine) {
+                                          Rng& rng_engine, std::ostream& out) {
   absl::Time start_jit_compile = absl::Now();
-  XLS_ASSIGN_OR_RETURN(std::unique_ptr<FunctionJit> jit,
-                       FunctionJit::Create(function));
-  std::cout << absl::StreamFormat(
-      "JIT compile time (%s): %dms\n", description,
-      DurationToMs(absl::Now() - start_jit_compile));
+  XLS_ASSIGN_OR_RETURN(
+      std::unique_ptr<FunctionJit> jit,
+      FunctionJit::Create(function, /*opt_level=*/3, /*observer=*/nullptr,
+                          absl::GetFlag(FLAGS_profile_jit_nodes)));
+  out << absl::StreamFormat("JIT compile time (%s): %dms\n", description,
+                            DurationToMs(absl::Now() - start_jit_compile));
 
   const int64_t kInputCount = 100;
   auto arg_set =
@@ -580,9 +648,17 @@ absl::Status RunFunctionInterpreterAndJit(Function* function,
             return absl::OkStatus();
           },
           kRunDurationMs));
-  std::cout << absl::StreamFormat(
-      "JIT run time (%s): %d Kcalls/s\n", description,
-      static_cast<int64_t>(kInputCount * jit_run_rate));
+  out << absl::StreamFormat("JIT run time (%s): %d Kcalls/s\n", description,
+                            static_cast<int64_t>(kInputCount * jit_run_rate));
+
+  if (absl::GetFlag(FLAGS_profile_jit_nodes)) {
+    // Limit the report to the hottest nodes; large functions can have
+    // thousands.
+    constexpr int64_t kMaxProfileRecords = 64;
+    out << absl::StreamFormat("JIT node profile (%s):\n", description);
+    out << NodeProfileToString(jit->jitted_function_base().GetNodeProfile(),
+                               kMaxProfileRecords);
+  }
 
   XLS_ASSIGN_OR_RETURN(
       float interpreter_run_rate,
@@ -594,7 +670,7 @@ absl::Status RunFunctionInterpreterAndJit(Function* function,
             return absl::OkStatus();
           },
           kRunDurationMs));
-  std::cout << absl::StreamFormat(
+  out << absl::StreamFormat(
       "Interpreter run time (%s): %d calls/s\n", description,
       static_cast<int64_t>(kInputCount * interpreter_run_rate));
   return absl::OkStatus();
@@ -603,15 +679,14 @@ absl::Status RunFunctionInterpreterAndJit(Function* function,
 template <typename Rng>
 absl::Status RunBlockInterpreterAndJit(Block* block,
                                        std::string_view description,
-                                       Rng& rng_engine) {
+                                       Rng& rng_engine, std::ostream& out) {
   absl::Time start_jit_compile = absl::Now();
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<JitRuntime> runtime,
                        JitRuntime::Create());
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<BlockJit> jit,
                        BlockJit::Create(block, runtime.get()));
-  std::cout << absl::StreamFormat(
-      "JIT compile time (%s): %dms\n", description,
-      DurationToMs(absl::Now() - start_jit_compile));
+  out << absl::StreamFormat("JIT compile time (%s): %dms\n", description,
+                            DurationToMs(absl::Now() - start_jit_compile));
 
   const int64_t kInputCount = 100;
   std::vector<std::vector<Value>> arg_set =
@@ -653,9 +728,8 @@ absl::Status RunBlockInterpreterAndJit(Block* block,
             return absl::OkStatus();
           },
           kRunDurationMs));
-  std::cout << absl::StreamFormat(
-      "JIT run time (%s): %d Kcalls/s\n", description,
-      static_cast<int64_t>(kInputCount * jit_run_rate));
+  out << absl::StreamFormat("JIT run time (%s): %d Kcalls/s\n", description,
+                            static_cast<int64_t>(kInputCount * jit_run_rate));
 
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<BlockContinuation> continuation,
                        kInterpreterBlockEvaluator.NewContinuation(block));
@@ -670,7 +744,7 @@ absl::Status RunBlockInterpreterAndJit(Block* block,
             return absl::OkStatus();
           },
           kRunDurationMs));
-  std::cout << absl::StreamFormat(
+  out << absl::StreamFormat(
       "Interpreter run time (%s): %d calls/s\n", description,
       static_cast<int64_t>(kInputCount * interpreter_run_rate));
   return absl::OkStatus();
@@ -678,7 +752,7 @@ absl::Status RunBlockInterpreterAndJit(Block* block,
 
 template <typename Rng>
 absl::Status RunProcInterpreterAndJit(Proc* proc, std::string_view description,
-                                      Rng& rng_engine) {
+                                      Rng& rng_engine, std::ostream& out) {
   absl::Time start_jit_compile = absl::Now();
   XLS_ASSIGN_OR_RETURN(
       std::unique_ptr<JitChannelQueueManager> queue_manager,
@@ -686,30 +760,31 @@ absl::Status RunProcInterpreterAndJit(Proc* proc, std::string_view description,
   XLS_ASSIGN_OR_RETURN(
       std::unique_ptr<ProcJit> jit,
       ProcJit::Create(proc, &queue_manager->runtime(), queue_manager.get()));
-  std::cout << absl::StreamFormat(
-      "JIT compile time (%s): %dms\n", description,
-      DurationToMs(absl::Now() - start_jit_compile));
+  out << absl::StreamFormat("JIT compile time (%s): %dms\n", description,
+                            DurationToMs(absl::Now() - start_jit_compile));
   // TODO(meheff): 2022/5/16 Run the proc as well.
 
   return absl::OkStatus();
 }
 
 absl::Status RunInterpreterAndJit(FunctionBase* function_base,
-                                  std::string_view description) {
+                                  std::string_view description,
+                                  std::ostream& out) {
   std::minstd_rand rng_engine;
   if (function_base->IsFunction()) {
     Function* function = function_base->AsFunctionOrDie();
-    return RunFunctionInterpreterAndJit(function, description, rng_engine);
+    return RunFunctionInterpreterAndJit(function, description, rng_engine,
+                                        out);
   }
 
   if (function_base->IsBlock()) {
     Block* block = function_base->AsBlockOrDie();
-    return RunBlockInterpreterAndJit(block, description, rng_engine);
+    return RunBlockInterpreterAndJit(block, description, rng_engine, out);
   }
 
   XLS_RET_CHECK(function_base->IsProc());
   Proc* proc = function_base->AsProcOrDie();
-  return RunProcInterpreterAndJit(proc, description, rng_engine);
+  return RunProcInterpreterAndJit(proc, description, rng_engine, out);
 }
 
 absl::Status RealMain(std::string_view path) {
@@ -734,17 +809,38 @@ absl::Status RealMain(std::string_view path) {
     return absl::InternalError(absl::StrFormat(
         "Top entity not set for package: %s.", package->name()));
   }
-  if (absl::GetFlag(FLAGS_run_evaluators)) {
-    XLS_RETURN_IF_ERROR(
-        RunInterpreterAndJit(package->GetTop().value(), "unoptimized"));
+  const int64_t parallelism = absl::GetFlag(FLAGS_benchmark_parallelism);
+
+  {
+    // The evaluator comparison of the unoptimized IR and the optimization
+    // pipeline are independent, except that JIT compilation and optimization
+    // both mutate the package. When running concurrently the evaluators are
+    // given their own copy of the package parsed from the original text.
+    std::vector<BenchmarkPhase> phases;
+    std::unique_ptr<Package> unoptimized_copy;
+    if (absl::GetFlag(FLAGS_run_evaluators)) {
+      FunctionBase* top = package->GetTop().value();
+      if (parallelism > 1) {
+        XLS_ASSIGN_OR_RETURN(unoptimized_copy, Parser::ParsePackage(contents));
+        if (!codegen_flags_proto.top().empty()) {
+          XLS_RETURN_IF_ERROR(
+              unoptimized_copy->SetTopByName(codegen_flags_proto.top()));
+        }
+        XLS_RET_CHECK(unoptimized_copy->GetTop().has_value());
+        top = unoptimized_copy->GetTop().value();
+      }
+      phases.push_back({"unoptimized evaluators", [top](std::ostream& out) {
+                          return RunInterpreterAndJit(top, "unoptimized", out);
+                        }});
+    }
+    phases.push_back({"optimization", [&package](std::ostream& out) {
+                        return RunOptimizationAndPrintStats(package.get(),
+                                                            out);
+                      }});
+    XLS_RETURN_IF_ERROR(RunPhases(std::move(phases)));
   }
-  XLS_RETURN_IF_ERROR(RunOptimizationAndPrintStats(package.get()));
 
   FunctionBase* f = package->GetTop().value();
-  BddQueryEngine query_engine(BddFunction::kDefaultPathLimit);
-  XLS_RETURN_IF_ERROR(query_engine.Populate(f).status());
-  PrintNodeBreakdown(f);
-
   std::optional<int64_t> effective_clock_period_ps;
   if (scheduling_options_flags_proto.has_clock_period_ps() &&
       scheduling_options_flags_proto.clock_period_ps() > 0) {
@@ -768,9 +864,29 @@ absl::Status RealMain(std::string_view path) {
         GetDelayEstimator(scheduling_options_flags_proto.delay_model()));
   }
   const auto& delay_estimator = *pdelay_estimator;
-  XLS_ASSIGN_OR_RETURN(
-      std::vector<CriticalPathEntry> critical_path,
-      AnalyzeCriticalPath(f, effective_clock_period_ps, delay_estimator));
+
+  // The BDD-based node breakdown and the critical path analysis both only
+  // read the optimized IR, so they may be overlapped.
+  BddQueryEngine query_engine(BddFunction::kDefaultPathLimit);
+  std::vector<CriticalPathEntry> critical_path;
+  {
+    std::vector<BenchmarkPhase> phases;
+    phases.push_back(
+        {"node breakdown", [&](std::ostream& out) -> absl::Status {
+           XLS_RETURN_IF_ERROR(query_engine.Populate(f).status());
+           PrintNodeBreakdown(f, out);
+           return absl::OkStatus();
+         }});
+    phases.push_back(
+        {"critical path analysis", [&](std::ostream& out) -> absl::Status {
+           XLS_ASSIGN_OR_RETURN(
+               critical_path,
+               AnalyzeCriticalPath(f, effective_clock_period_ps,
+                                   delay_estimator));
+           return absl::OkStatus();
+         }});
+    XLS_RETURN_IF_ERROR(RunPhases(std::move(phases)));
+  }
   std::unique_ptr<synthesis::Synthesizer> synthesizer;
   if (absl::GetFlag(FLAGS_compare_delay_to_synthesis)) {
     synthesis::GrpcSynthesizerParameters parameters(
@@ -780,12 +896,12 @@ absl::Status RealMain(std::string_view path) {
         synthesis::GetSynthesizerManagerSingleton().MakeSynthesizer(
             parameters.name(), parameters));
   }
-  if (absl::GetFlag(FLAGS_run_evaluators)) {
-    XLS_RETURN_IF_ERROR(RunInterpreterAndJit(f, "optimized"));
-  }
   const bool benchmark_codegen =
       scheduling_options_flags_proto.clock_period_ps() > 0 ||
       scheduling_options_flags_proto.pipeline_stages() > 0;
+  if (absl::GetFlag(FLAGS_run_evaluators) && !benchmark_codegen) {
+    XLS_RETURN_IF_ERROR(RunInterpreterAndJit(f, "optimized", std::cout));
+  }
   if (!f->IsProc() && !benchmark_codegen) {
     synthesis::SynthesizedDelayDiff delay_diff;
     if (synthesizer) {
@@ -801,11 +917,38 @@ absl::Status RealMain(std::string_view path) {
   } else if (benchmark_codegen) {
     TimingReport timing_report;
     PipelineScheduleOrGroup schedules = PackagePipelineSchedules();
-    XLS_ASSIGN_OR_RETURN(
-        CodegenResult codegen_result,
-        ScheduleAndCodegen(package.get(), scheduling_options_flags_proto,
-                           codegen_flags_proto, delay_model_flag_passed,
-                           &timing_report, &schedules));
+    CodegenResult codegen_result;
+    {
+      // Scheduling and codegen mutate the package, so a concurrent evaluator
+      // comparison of the optimized IR runs on its own copy.
+      std::vector<BenchmarkPhase> phases;
+      std::unique_ptr<Package> optimized_copy;
+      if (absl::GetFlag(FLAGS_run_evaluators)) {
+        FunctionBase* optimized_top = f;
+        if (parallelism > 1) {
+          XLS_ASSIGN_OR_RETURN(optimized_copy,
+                               Parser::ParsePackage(package->DumpIr()));
+          XLS_RETURN_IF_ERROR(optimized_copy->SetTopByName(f->name()));
+          optimized_top = optimized_copy->GetTop().value();
+        }
+        phases.push_back(
+            {"optimized evaluators", [optimized_top](std::ostream& out) {
+               return RunInterpreterAndJit(optimized_top, "optimized", out);
+             }});
+      }
+      phases.push_back(
+          {"schedule and codegen", [&](std::ostream& out) -> absl::Status {
+             XLS_ASSIGN_OR_RETURN(
+                 codegen_result,
+                 ScheduleAndCodegen(package.get(),
+                                    scheduling_options_flags_proto,
+                                    codegen_flags_proto,
+                                    delay_model_flag_passed, &timing_report,
+                                    &schedules));
+             return absl::OkStatus();
+           }});
+      XLS_RETURN_IF_ERROR(RunPhases(std::move(phases)));
+    }
     synthesis::SynthesizedDelayDiffByStage delay_diff;
     if (synthesizer) {
       XLS_ASSIGN_OR_RETURN(
@@ -849,7 +992,8 @@ absl::Status RealMain(std::string_view path) {
     }
     if (absl::GetFlag(FLAGS_run_evaluators)) {
       XLS_RETURN_IF_ERROR(
-          RunInterpreterAndJit(package->blocks()[0].get(), "block"));
+          RunInterpreterAndJit(package->blocks()[0].get(), "block",
+                               std::cout));
     }
   }
 
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -27,6 +28,7 @@
 #include "absl/strings/str_format.h"
 #include "xls/codegen/module_signature.h"
 #include "xls/common/exit_status.h"
+#include "xls/common/file/file_mapping.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/init_xls.h"
 #include "xls/common/status/ret_check.h"
@@ -63,9 +65,10 @@ absl::Status RealMain(std::string_view ir_path) {
   if (ir_path == "-") {
     ir_path = "/dev/stdin";
   }
-  XLS_ASSIGN_OR_RETURN(std::string ir_contents, GetFileContents(ir_path));
+  XLS_ASSIGN_OR_RETURN(FileMapping ir_mapping,
+                       FileMapping::Open(std::string(ir_path)));
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> p,
-                       Parser::ParsePackage(ir_contents, ir_path));
+                       Parser::ParsePackage(ir_mapping.data(), ir_path));
 
   XLS_ASSIGN_OR_RETURN(CodegenFlagsProto codegen_flags_proto,
                        GetCodegenFlags());
@@ -94,7 +97,7 @@ absl::Status RealMain(std::string_view ir_path) {
   if (!absl::GetFlag(FLAGS_output_schedule_ir_path).empty()) {
     XLS_RETURN_IF_ERROR(
         SetFileContents(absl::GetFlag(FLAGS_output_schedule_ir_path),
-                        main()->package()->DumpIr()));
+                        [&](std::ostream& os) { p->DumpIr(os); }));
   }
 
   if (!absl::GetFlag(FLAGS_output_schedule_path).empty()) {
@@ -111,8 +114,9 @@ absl::Status RealMain(std::string_view ir_path) {
     QCHECK_GE(p->blocks().size(), 1)
         << "There should be at least one block in the package after generating "
            "module text.";
-    XLS_RETURN_IF_ERROR(SetFileContents(
-        absl::GetFlag(FLAGS_output_block_ir_path), p->DumpIr()));
+    XLS_RETURN_IF_ERROR(
+        SetFileContents(absl::GetFlag(FLAGS_output_block_ir_path),
+                        [&](std::ostream& os) { p->DumpIr(os); }));
   }
 
   if (!absl::GetFlag(FLAGS_output_signature_path).empty()) {
@@ -27,9 +27,11 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/base/casts.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/memory/memory.h"
 #include "absl/random/bit_gen_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -70,7 +72,9 @@
 #include "xls/common/exit_status.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/init_xls.h"
+#include "xls/common/math_util.h"
 #include "xls/common/status/ret_check.h"
+#include "xls/common/thread.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/dslx/create_import_data.h"
 #include "xls/dslx/default_dslx_stdlib_path.h"
@@ -99,6 +103,7 @@
 #include "xls/passes/optimization_pass.h"
 #include "xls/passes/optimization_pass_pipeline.h"
 #include "xls/passes/pass_base.h"
+#include "xls/tools/eval_utils.h"
 
 static constexpr std::string_view kUsage = R"(
 Evaluates an IR file with user-specified or random inputs using the IR
@@ -155,6 +160,13 @@ ABSL_FLAG(std::string, input_file, "",
           "Inputs to interpreter, one set per line. Each line should contain a "
           "semicolon-separated set of typed values. Cannot be specified with "
           "--input.");
+ABSL_FLAG(std::string, input_record_file, "",
+          "Binary value-record file of inputs (see SerializeValueRecords in "
+          "xls/tools/eval_utils.h). Each function parameter is a record "
+          "stream named after the parameter; the i-th records of the "
+          "parameter streams form the i-th argument set. Values are stored "
+          "bit-packed so no value parsing is required on load. Cannot be "
+          "specified with --input or --input_file.");
 ABSL_FLAG(int64_t, random_inputs, 0,
           "If non-zero, this is the number of randomly generated inputs to use "
           "in evaluation. Cannot be specified with --input.");
@@ -166,6 +178,11 @@ ABSL_FLAG(
     "The expected result(s) of the evaluation(s). A non-zero error code is "
     "returned if the evaluated result does not match. Must be specified with "
     "--input_file.");
+ABSL_FLAG(std::string, expected_record_file, "",
+          "Binary value-record file of expected results (see "
+          "SerializeValueRecords in xls/tools/eval_utils.h). The records in "
+          "file order are the expected results of the corresponding argument "
+          "sets. Cannot be specified with --expected or --expected_file.");
 ABSL_FLAG(bool, optimize_ir, false,
           "Run optimization passes on the input and evaluate before and after "
           "optimizations. A non-zero error status is returned if the results "
@@ -223,6 +240,13 @@ ABSL_FLAG(
     "Instead of compiling jitted XLS ir code and executing it, compile it to "
     "LLVM ir and then interpret the LLVM IR. --use_llvm_jit must be true. Use "
     "--llvm_opt_level=0 if you want to execute the unoptimized llvm ir.");
+ABSL_FLAG(int64_t, parallelism, 1,
+          "Number of threads across which to shard the evaluation of the "
+          "input samples. Each thread evaluates a contiguous shard of the "
+          "samples with its own JIT instance (or the interpreter) and the "
+          "results are merged in input order. Incompatible with the LLVM "
+          "IR/asm dumping flags, --use_llvm_jit_interpreter and "
+          "--llvm_jit_main_wrapper_output.");
 
 namespace xls {
 namespace {
@@ -574,6 +598,86 @@ absl::Status WriteMainWrapper(Function* f, FunctionJit* jit,
   return SetFileContents(output_path, buffer);
 }
 
+// Evaluates the ArgSets sharded across `parallelism` threads, each with its
+// own JIT instance (or the shared, stateless interpreter). Results are merged
+// and printed in input order.
+absl::StatusOr<std::vector<Value>> EvalParallel(
+    Function* f, absl::Span<const ArgSet> arg_sets, bool use_jit,
+    int64_t parallelism, std::string_view actual_src,
+    std::string_view expected_src) {
+  if (absl::GetFlag(FLAGS_llvm_jit_ir_output).has_value() ||
+      absl::GetFlag(FLAGS_llvm_jit_opt_ir_output).has_value() ||
+      absl::GetFlag(FLAGS_llvm_jit_asm_output).has_value() ||
+      absl::GetFlag(FLAGS_llvm_jit_main_wrapper_output).has_value() ||
+      absl::GetFlag(FLAGS_use_llvm_jit_interpreter) ||
+      !absl::GetFlag(FLAGS_test_only_inject_jit_result).empty()) {
+    return absl::InvalidArgumentError(
+        "--parallelism > 1 is incompatible with the LLVM IR/asm dumping "
+        "flags, --use_llvm_jit_interpreter, --llvm_jit_main_wrapper_output "
+        "and --test_only_inject_jit_result");
+  }
+  const int64_t num_threads =
+      std::min<int64_t>(parallelism, arg_sets.size());
+  // JIT instances are created up front on this thread; compilation mutates
+  // shared package state (e.g. interned types) and is not thread-safe.
+  std::vector<std::unique_ptr<FunctionJit>> jits;
+  if (use_jit) {
+    for (int64_t i = 0; i < num_threads; ++i) {
+      XLS_ASSIGN_OR_RETURN(
+          std::unique_ptr<FunctionJit> jit,
+          FunctionJit::Create(f, absl::GetFlag(FLAGS_llvm_opt_level)));
+      jits.push_back(std::move(jit));
+    }
+  }
+
+  std::vector<Value> results(arg_sets.size());
+  std::vector<absl::Status> shard_statuses(num_threads, absl::OkStatus());
+  std::vector<std::unique_ptr<Thread>> threads;
+  const int64_t shard_size =
+      CeilOfRatio<int64_t>(arg_sets.size(), num_threads);
+  for (int64_t shard = 0; shard < num_threads; ++shard) {
+    const int64_t begin = shard * shard_size;
+    const int64_t end =
+        std::min<int64_t>(begin + shard_size, arg_sets.size());
+    if (begin >= end) {
+      break;
+    }
+    threads.push_back(absl::WrapUnique(new Thread([&, shard, begin, end]() {
+      FunctionJit* jit = use_jit ? jits[shard].get() : nullptr;
+      for (int64_t i = begin; i < end; ++i) {
+        absl::StatusOr<Value> result =
+            jit != nullptr
+                ? DropInterpreterEvents(jit->Run(arg_sets[i].args))
+                : DropInterpreterEvents(InterpretFunction(f, arg_sets[i].args));
+        if (!result.ok()) {
+          shard_statuses[shard] = std::move(result).status();
+          return;
+        }
+        results[i] = std::move(result).value();
+      }
+    })));
+  }
+  for (std::unique_ptr<Thread>& thread : threads) {
+    thread->Join();
+  }
+  for (const absl::Status& status : shard_statuses) {
+    XLS_RETURN_IF_ERROR(status);
+  }
+
+  for (int64_t i = 0; i < static_cast<int64_t>(arg_sets.size()); ++i) {
+    std::cout << results[i].ToString(FormatPreference::kHex) << '\n';
+    if (arg_sets[i].expected.has_value() &&
+        results[i] != *arg_sets[i].expected) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Miscompare for input[%i] \"%s\"\n  %s: %s\n  %s: %s", i,
+          ArgsToString(arg_sets[i].args), actual_src,
+          results[i].ToString(FormatPreference::kHex), expected_src,
+          arg_sets[i].expected->ToString(FormatPreference::kHex)));
+    }
+  }
+  return results;
+}
+
 // Evaluates the function with the given ArgSets. Returns an error if the result
 // does not match expectations (if any). 'actual_src' and 'expected_src' are
 // string descriptions of the sources of the actual results and expected
@@ -582,6 +686,11 @@ absl::StatusOr<std::vector<Value>> Eval(
     Function* f, absl::Span<const ArgSet> arg_sets, bool use_jit,
     std::string_view actual_src = "actual",
     std::string_view expected_src = "expected") {
+  if (absl::GetFlag(FLAGS_parallelism) > 1) {
+    return EvalParallel(f, arg_sets, use_jit,
+                        absl::GetFlag(FLAGS_parallelism), actual_src,
+                        expected_src);
+  }
   EvalIrJitObserver observer(absl::GetFlag(FLAGS_llvm_jit_ir_output),
                              absl::GetFlag(FLAGS_llvm_jit_opt_ir_output),
                              absl::GetFlag(FLAGS_use_llvm_jit_interpreter),
@@ -840,6 +949,8 @@ absl::Status RealMain(std::string_view input_path,
         << "Cannot specify both --input and --random_inputs";
     QCHECK(absl::GetFlag(FLAGS_input_file).empty())
         << "Cannot specify both --input and --input_file";
+    QCHECK(absl::GetFlag(FLAGS_input_record_file).empty())
+        << "Cannot specify both --input and --input_record_file";
     absl::StatusOr<ArgSet> arg_set_status =
         ArgSetFromString(absl::GetFlag(FLAGS_input));
     QCHECK_OK(arg_set_status.status())
@@ -860,9 +971,43 @@ absl::Status RealMain(std::string_view input_path,
                                 absl::GetFlag(FLAGS_input_file), arg_line);
       arg_sets.push_back(arg_set_status.value());
     }
+  } else if (!absl::GetFlag(FLAGS_input_record_file).empty()) {
+    QCHECK_EQ(absl::GetFlag(FLAGS_random_inputs), 0)
+        << "Cannot specify both --input_record_file and --random_inputs";
+    absl::StatusOr<std::string> record_data =
+        GetFileContents(absl::GetFlag(FLAGS_input_record_file));
+    QCHECK_OK(record_data.status());
+    absl::StatusOr<std::vector<ValueRecord>> records =
+        DeserializeValueRecords(record_data.value());
+    QCHECK_OK(records.status()) << "Invalid input record file: "
+                                << absl::GetFlag(FLAGS_input_record_file);
+    absl::flat_hash_map<std::string, std::vector<Value>> values_by_param;
+    for (ValueRecord& record : records.value()) {
+      values_by_param[record.name].push_back(std::move(record.value));
+    }
+    int64_t sample_count = 0;
+    for (Param* param : f->params()) {
+      auto it = values_by_param.find(param->name());
+      QCHECK(it != values_by_param.end())
+          << "Input record file has no records for parameter "
+          << param->name();
+      if (param == f->params().front()) {
+        sample_count = it->second.size();
+      }
+      QCHECK_EQ(it->second.size(), sample_count)
+          << "Record streams for the function parameters have mismatched "
+             "lengths";
+    }
+    arg_sets.resize(sample_count);
+    for (int64_t i = 0; i < sample_count; ++i) {
+      for (Param* param : f->params()) {
+        arg_sets[i].args.push_back(values_by_param.at(param->name())[i]);
+      }
+    }
   } else {
     QCHECK_NE(absl::GetFlag(FLAGS_random_inputs), 0)
-        << "Must specify --input, --input_file, or --random_inputs.";
+        << "Must specify --input, --input_file, --input_record_file, or "
+           "--random_inputs.";
     arg_sets.resize(absl::GetFlag(FLAGS_random_inputs));
     std::minstd_rand rng_engine;
     std::string validator_text = absl::GetFlag(FLAGS_input_validator_expr);
@@ -920,6 +1065,20 @@ absl::Status RealMain(std::string_view input_path,
     for (int64_t i = 0; i < arg_sets.size(); ++i) {
       arg_sets[i].expected = expecteds[i];
     }
+  } else if (!absl::GetFlag(FLAGS_expected_record_file).empty()) {
+    absl::StatusOr<std::string> record_data =
+        GetFileContents(absl::GetFlag(FLAGS_expected_record_file));
+    QCHECK_OK(record_data.status());
+    absl::StatusOr<std::vector<ValueRecord>> records =
+        DeserializeValueRecords(record_data.value());
+    QCHECK_OK(records.status()) << "Invalid expected record file: "
+                                << absl::GetFlag(FLAGS_expected_record_file);
+    QCHECK_EQ(records.value().size(), arg_sets.size())
+        << "Number of records in expected record file does not match the "
+           "number of inputs.";
+    for (int64_t i = 0; i < arg_sets.size(); ++i) {
+      arg_sets[i].expected = std::move(records.value()[i].value);
+    }
   }
 
   return Run(package.get(), arg_sets);
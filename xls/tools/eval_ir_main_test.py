@@ -121,6 +121,30 @@ class EvalMainTest(absltest.TestCase):
     self.assertSequenceEqual(('bits[32]:0x165', 'bits[32]:0xf1f'),
                              results.decode('utf-8').strip().split('\n'))
 
+  def test_input_file_parallelism(self):
+    ir_file = self.create_tempfile(content=ADD_IR)
+    inputs = tuple(
+        'bits[32]:0x%x; bits[32]:0x100' % i for i in range(16)
+    )
+    input_file = self.create_tempfile(content='\n'.join(inputs))
+    for use_jit in ('true', 'false'):
+      results = subprocess.check_output([
+          EVAL_IR_MAIN_PATH, '--input_file=' + input_file.full_path,
+          '--parallelism=4', '--use_llvm_jit=' + use_jit, ir_file.full_path
+      ])
+      # Results must be merged in input order.
+      self.assertSequenceEqual(
+          tuple('bits[32]:0x%x' % (0x100 + i) for i in range(16)),
+          results.decode('utf-8').strip().split('\n'))
+
+  def test_parallelism_test_llvm_jit(self):
+    ir_file = self.create_tempfile(content=ADD_IR)
+    result = subprocess.check_output([
+        EVAL_IR_MAIN_PATH, '--input=bits[32]:0x42; bits[32]:0x123',
+        '--parallelism=2', '--test_llvm_jit', ir_file.full_path
+    ])
+    self.assertIn('bits[32]:0x165', result.decode('utf-8'))
+
   def test_input_file_extra_whitespace(self):
     ir_file = self.create_tempfile(content=ADD_IR)
     # Empty lines and extra whitespace in the arg file should be ignored.
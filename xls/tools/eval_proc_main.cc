@@ -20,6 +20,7 @@
 #include <deque>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -145,6 +146,22 @@ ABSL_FLAG(
     std::string, expected_proto_outputs_for_all_channels, "",
     "Path to file containing ProcChannelValuesProto binary proto of outputs "
     "for all channels.");
+ABSL_FLAG(std::string, record_inputs_for_all_channels, "",
+          "Path to a binary value-record file (see SerializeValueRecords in "
+          "xls/tools/eval_utils.h) containing inputs for all channels. Values "
+          "are stored bit-packed so no value parsing is required on load.");
+ABSL_FLAG(std::string, expected_record_outputs_for_all_channels, "",
+          "Path to a binary value-record file (see SerializeValueRecords in "
+          "xls/tools/eval_utils.h) containing expected outputs for all "
+          "channels.");
+ABSL_FLAG(bool, stream_proto_inputs, false,
+          "When set, incrementally decode the "
+          "'proto_inputs_for_all_channels' file and feed channel queues on "
+          "demand instead of loading all inputs into memory up front. Only "
+          "supported by the serial_jit and ir_interpreter backends.");
+ABSL_FLAG(int64_t, input_readahead, 1024,
+          "Maximum number of input values decoded ahead of the consumer per "
+          "channel when 'stream_proto_inputs' is set.");
 ABSL_FLAG(std::string, streaming_channel_data_suffix, "_data",
           "Suffix to data signals for streaming channels.");
 ABSL_FLAG(std::string, streaming_channel_valid_suffix, "_vld",
@@ -207,8 +224,58 @@ struct EvaluateProcsOptions {
   bool use_jit = false;
   bool fail_on_assert = false;
   std::vector<int64_t> ticks = {-1};
+  // When non-null, channel inputs are decoded incrementally from this reader
+  // (with at most `input_readahead` values buffered per channel) rather than
+  // taken from the eagerly loaded inputs map.
+  StreamingChannelValuesReader* streaming_inputs = nullptr;
+  int64_t input_readahead = 1024;
 };
 
+// Attaches generators to the input channel queues which pull values from
+// `reader` in chunks of up to `readahead` values, so that only a bounded
+// window of the stimulus is decoded into memory at a time.
+static absl::Status AttachStreamingInputs(ChannelQueueManager& queue_manager,
+                                          StreamingChannelValuesReader* reader,
+                                          int64_t readahead) {
+  for (const std::string& channel_name : reader->channel_names()) {
+    XLS_ASSIGN_OR_RETURN(ChannelQueue * in_queue,
+                         queue_manager.GetQueueByName(channel_name));
+    if (in_queue->channel()->kind() == ChannelKind::kSingleValue) {
+      // Single-value channels cannot have generators. Their contents are
+      // small (the queue only holds the latest value), so load them eagerly.
+      XLS_ASSIGN_OR_RETURN(
+          std::vector<Value> values,
+          reader->ReadValues(channel_name, std::numeric_limits<int64_t>::max()));
+      for (const Value& value : values) {
+        XLS_RETURN_IF_ERROR(in_queue->Write(value));
+      }
+      continue;
+    }
+    XLS_RETURN_IF_ERROR(in_queue->AttachGenerator(
+        [reader, channel_name, readahead,
+         buffer =
+             std::make_shared<std::deque<Value>>()]() -> std::optional<Value> {
+          if (buffer->empty()) {
+            absl::StatusOr<std::vector<Value>> values =
+                reader->ReadValues(channel_name, readahead);
+            if (!values.ok()) {
+              LOG(ERROR) << "Failed to decode streamed inputs for channel "
+                         << channel_name << ": " << values.status();
+              return std::nullopt;
+            }
+            absl::c_move(*values, std::back_inserter(*buffer));
+          }
+          if (buffer->empty()) {
+            return std::nullopt;
+          }
+          Value value = std::move(buffer->front());
+          buffer->pop_front();
+          return value;
+        }));
+  }
+  return absl::OkStatus();
+}
+
 static absl::Status EvaluateProcs(
     Package* package,
     const absl::btree_map<std::string, std::vector<Value>>& inputs_for_channels,
@@ -223,6 +290,10 @@ static absl::Status EvaluateProcs(
   }
 
   ChannelQueueManager& queue_manager = runtime->queue_manager();
+  if (options.streaming_inputs != nullptr) {
+    XLS_RETURN_IF_ERROR(AttachStreamingInputs(
+        queue_manager, options.streaming_inputs, options.input_readahead));
+  }
   for (const auto& [channel_name, values] : inputs_for_channels) {
     XLS_ASSIGN_OR_RETURN(ChannelQueue * in_queue,
                          queue_manager.GetQueueByName(channel_name));
@@ -1063,6 +1134,9 @@ static absl::Status RealMain(
     const std::string& expected_outputs_for_all_channels_text,
     const std::string& proto_inputs_for_all_channels,
     const std::string& expected_proto_outputs_for_all_channels,
+    const std::string& record_inputs_for_all_channels,
+    const std::string& expected_record_outputs_for_all_channels,
+    bool stream_proto_inputs, int64_t input_readahead,
     std::string_view streaming_channel_data_suffix,
     std::string_view streaming_channel_ready_suffix,
     std::string_view streaming_channel_valid_suffix,
@@ -1081,6 +1155,7 @@ static absl::Status RealMain(
       std::accumulate(ticks.begin(), ticks.end(), static_cast<int64_t>(0));
 
   absl::btree_map<std::string, std::vector<Value>> inputs_for_channels;
+  std::unique_ptr<StreamingChannelValuesReader> streaming_inputs;
   if (!inputs_for_channels_text.empty()) {
     XLS_ASSIGN_OR_RETURN(
         inputs_for_channels,
@@ -1090,9 +1165,19 @@ static absl::Status RealMain(
         inputs_for_channels,
         ParseChannelValuesFromFile(inputs_for_all_channels_text, total_ticks));
   } else if (!proto_inputs_for_all_channels.empty()) {
+    if (stream_proto_inputs) {
+      XLS_ASSIGN_OR_RETURN(
+          streaming_inputs,
+          StreamingChannelValuesReader::Create(proto_inputs_for_all_channels));
+    } else {
+      XLS_ASSIGN_OR_RETURN(inputs_for_channels,
+                           ParseChannelValuesFromProtoFile(
+                               proto_inputs_for_all_channels, total_ticks));
+    }
+  } else if (!record_inputs_for_all_channels.empty()) {
     XLS_ASSIGN_OR_RETURN(inputs_for_channels,
-                         ParseChannelValuesFromProtoFile(
-                             proto_inputs_for_all_channels, total_ticks));
+                         ParseChannelValuesFromRecordFile(
+                             record_inputs_for_all_channels, total_ticks));
   }
 
   absl::btree_map<std::string, std::vector<Value>>
@@ -1111,6 +1196,11 @@ static absl::Status RealMain(
         expected_outputs_for_channels,
         ParseChannelValuesFromProtoFile(expected_proto_outputs_for_all_channels,
                                         total_ticks));
+  } else if (!expected_record_outputs_for_all_channels.empty()) {
+    XLS_ASSIGN_OR_RETURN(expected_outputs_for_channels,
+                         ParseChannelValuesFromRecordFile(
+                             expected_record_outputs_for_all_channels,
+                             total_ticks));
   }
 
   absl::flat_hash_map<std::string, std::pair<int64_t, Value>> model_memories;
@@ -1129,6 +1219,9 @@ static absl::Status RealMain(
   }
 
   if (backend.starts_with("block")) {
+    if (streaming_inputs != nullptr) {
+      LOG(QFATAL) << "Block backends do not support --stream_proto_inputs";
+    }
     RunBlockOptions block_options = {
         .ticks = ticks,
         .max_cycles_no_output = max_cycles_no_output,
@@ -1164,6 +1257,8 @@ static absl::Status RealMain(
   EvaluateProcsOptions evaluate_procs_options = {
       .fail_on_assert = fail_on_assert,
       .ticks = ticks,
+      .streaming_inputs = streaming_inputs.get(),
+      .input_readahead = input_readahead,
   };
 
   if (backend == "serial_jit") {
@@ -1213,11 +1308,19 @@ int main(int argc, char* argv[]) {
           absl::Span<const bool>{
               absl::GetFlag(FLAGS_inputs_for_channels).empty() &&
               absl::GetFlag(FLAGS_inputs_for_all_channels).empty() &&
-              absl::GetFlag(FLAGS_proto_inputs_for_all_channels).empty()},
+              absl::GetFlag(FLAGS_proto_inputs_for_all_channels).empty() &&
+              absl::GetFlag(FLAGS_record_inputs_for_all_channels).empty()},
           false) > 1) {
     LOG(QFATAL) << "Only one of --inputs_for_channels, "
-                   "--inputs_for_all_channels, and "
-                   "--proto_inputs_for_all_channels must be set.";
+                   "--inputs_for_all_channels, "
+                   "--proto_inputs_for_all_channels, and "
+                   "--record_inputs_for_all_channels must be set.";
+  }
+
+  if (absl::GetFlag(FLAGS_stream_proto_inputs) &&
+      absl::GetFlag(FLAGS_proto_inputs_for_all_channels).empty()) {
+    LOG(QFATAL) << "--stream_proto_inputs requires "
+                   "--proto_inputs_for_all_channels.";
   }
 
   if (absl::c_count(
@@ -1225,11 +1328,14 @@ int main(int argc, char* argv[]) {
               absl::GetFlag(FLAGS_expected_outputs_for_channels).empty() &&
               absl::GetFlag(FLAGS_expected_outputs_for_all_channels).empty() &&
               absl::GetFlag(FLAGS_expected_proto_outputs_for_all_channels)
+                  .empty() &&
+              absl::GetFlag(FLAGS_expected_record_outputs_for_all_channels)
                   .empty()},
           false) > 1) {
     LOG(QFATAL) << "Only one of --expected_outputs_for_channels, "
-                   "--expected_outputs_for_all_channels, and "
-                   "--expected_proto_outputs_for_all_channels must be set.";
+                   "--expected_outputs_for_all_channels, "
+                   "--expected_proto_outputs_for_all_channels, and "
+                   "--expected_record_outputs_for_all_channels must be set.";
   }
 
   return xls::ExitStatus(xls::RealMain(
@@ -1242,6 +1348,10 @@ int main(int argc, char* argv[]) {
       absl::GetFlag(FLAGS_expected_outputs_for_all_channels),
       absl::GetFlag(FLAGS_proto_inputs_for_all_channels),
       absl::GetFlag(FLAGS_expected_proto_outputs_for_all_channels),
+      absl::GetFlag(FLAGS_record_inputs_for_all_channels),
+      absl::GetFlag(FLAGS_expected_record_outputs_for_all_channels),
+      absl::GetFlag(FLAGS_stream_proto_inputs),
+      absl::GetFlag(FLAGS_input_readahead),
       absl::GetFlag(FLAGS_streaming_channel_data_suffix),
       absl::GetFlag(FLAGS_streaming_channel_ready_suffix),
       absl::GetFlag(FLAGS_streaming_channel_valid_suffix),
@@ -15,7 +15,12 @@
 #include "xls/tools/eval_utils.h"
 
 #include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <istream>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -24,15 +29,23 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_split.h"
+#include "absl/types/span.h"
+#include "xls/codegen/flattening.h"
 #include "xls/common/file/filesystem.h"
+#include "xls/common/math_util.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/ir/bits.h"
 #include "xls/ir/ir_parser.h"
+#include "xls/ir/package.h"
+#include "xls/ir/type.h"
 #include "xls/ir/value.h"
 #include "xls/ir/xls_value.pb.h"
 #include "xls/tools/proc_channel_values.pb.h"
@@ -181,4 +194,321 @@ absl::StatusOr<ProcChannelValuesProto> ChannelValuesToProto(
   }
   return pcv;
 }
+
+namespace {
+
+// Magic bytes and version of the binary value-record format documented in
+// eval_utils.h.
+constexpr char kValueRecordMagic[8] = {'X', 'L', 'S', 'V', 'R', 'E', 'C', 0};
+constexpr uint32_t kValueRecordVersion = 1;
+
+// Appends `value` to `out` as four bytes, least significant byte first.
+void AppendU32(uint32_t value, std::string* out) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+// Reads a four byte little-endian integer from `data` at `*cursor`, advancing
+// the cursor.
+absl::StatusOr<uint32_t> ReadU32(std::string_view data, int64_t* cursor) {
+  if (*cursor + 4 > data.size()) {
+    return absl::InvalidArgumentError("Truncated value-record data");
+  }
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value |= static_cast<uint32_t>(
+                 static_cast<uint8_t>(data[*cursor + i]))
+             << (8 * i);
+  }
+  *cursor += 4;
+  return value;
+}
+
+// Reads a u32-length-prefixed string from `data` at `*cursor`, advancing the
+// cursor.
+absl::StatusOr<std::string_view> ReadString(std::string_view data,
+                                            int64_t* cursor) {
+  XLS_ASSIGN_OR_RETURN(uint32_t length, ReadU32(data, cursor));
+  if (*cursor + length > data.size()) {
+    return absl::InvalidArgumentError("Truncated value-record data");
+  }
+  std::string_view result = data.substr(*cursor, length);
+  *cursor += length;
+  return result;
+}
+
+}  // namespace
+
+absl::StatusOr<std::string> SerializeValueRecords(
+    absl::Span<const ValueRecord> records) {
+  // The package exists only to intern the types of the serialized values.
+  Package type_package("value_records");
+  std::vector<std::pair<std::string_view, Type*>> streams;
+  absl::flat_hash_map<std::string_view, uint32_t> stream_indices;
+  for (const ValueRecord& record : records) {
+    Type* type = type_package.GetTypeForValue(record.value);
+    auto [it, inserted] =
+        stream_indices.try_emplace(record.name, streams.size());
+    if (inserted) {
+      streams.push_back({record.name, type});
+    } else if (streams[it->second].second != type) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Records for '%s' have mismatched types: %s vs %s", record.name,
+          streams[it->second].second->ToString(), type->ToString()));
+    }
+  }
+
+  std::string out(kValueRecordMagic, sizeof(kValueRecordMagic));
+  AppendU32(kValueRecordVersion, &out);
+  AppendU32(streams.size(), &out);
+  for (const auto& [name, type] : streams) {
+    AppendU32(name.size(), &out);
+    out.append(name);
+    std::string type_str = type->ToString();
+    AppendU32(type_str.size(), &out);
+    out.append(type_str);
+  }
+  for (const ValueRecord& record : records) {
+    AppendU32(stream_indices.at(record.name), &out);
+    std::vector<uint8_t> bytes = FlattenValueToBits(record.value).ToBytes();
+    out.append(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+  }
+  return out;
+}
+
+absl::StatusOr<std::vector<ValueRecord>> DeserializeValueRecords(
+    std::string_view data) {
+  if (data.size() < sizeof(kValueRecordMagic) ||
+      memcmp(data.data(), kValueRecordMagic, sizeof(kValueRecordMagic)) != 0) {
+    return absl::InvalidArgumentError(
+        "Not value-record data: magic bytes do not match");
+  }
+  int64_t cursor = sizeof(kValueRecordMagic);
+  XLS_ASSIGN_OR_RETURN(uint32_t version, ReadU32(data, &cursor));
+  if (version != kValueRecordVersion) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Unsupported value-record version: %d", version));
+  }
+
+  // The package exists only to hold the types parsed from the stream table.
+  Package type_package("value_records");
+  struct Stream {
+    std::string name;
+    Type* type;
+    int64_t byte_count;
+  };
+  XLS_ASSIGN_OR_RETURN(uint32_t stream_count, ReadU32(data, &cursor));
+  std::vector<Stream> streams;
+  streams.reserve(stream_count);
+  for (uint32_t i = 0; i < stream_count; ++i) {
+    XLS_ASSIGN_OR_RETURN(std::string_view name, ReadString(data, &cursor));
+    XLS_ASSIGN_OR_RETURN(std::string_view type_str, ReadString(data, &cursor));
+    XLS_ASSIGN_OR_RETURN(Type * type,
+                         Parser::ParseType(type_str, &type_package));
+    streams.push_back(
+        {std::string(name), type,
+         CeilOfRatio<int64_t>(type->GetFlatBitCount(), 8)});
+  }
+
+  std::vector<ValueRecord> records;
+  while (cursor < data.size()) {
+    XLS_ASSIGN_OR_RETURN(uint32_t stream_index, ReadU32(data, &cursor));
+    if (stream_index >= streams.size()) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Invalid stream index in value-record data: %d", stream_index));
+    }
+    const Stream& stream = streams[stream_index];
+    if (cursor + stream.byte_count > data.size()) {
+      return absl::InvalidArgumentError("Truncated value-record data");
+    }
+    Bits flat = Bits::FromBytes(
+        absl::MakeConstSpan(
+            reinterpret_cast<const uint8_t*>(data.data()) + cursor,
+            stream.byte_count),
+        stream.type->GetFlatBitCount());
+    cursor += stream.byte_count;
+    XLS_ASSIGN_OR_RETURN(Value value, UnflattenBitsToValue(flat, stream.type));
+    records.push_back(ValueRecord{stream.name, std::move(value)});
+  }
+  return records;
+}
+
+absl::StatusOr<std::string> ChannelValuesToRecordData(
+    const absl::btree_map<std::string, std::vector<Value>>& channel_map) {
+  std::vector<ValueRecord> records;
+  for (const auto& [channel_name, values] : channel_map) {
+    for (const Value& value : values) {
+      records.push_back(ValueRecord{channel_name, value});
+    }
+  }
+  return SerializeValueRecords(records);
+}
+
+absl::StatusOr<absl::btree_map<std::string, std::vector<Value>>>
+ParseChannelValuesFromRecordData(
+    std::string_view data, std::optional<const int64_t> max_values_count) {
+  XLS_ASSIGN_OR_RETURN(std::vector<ValueRecord> records,
+                       DeserializeValueRecords(data));
+  absl::btree_map<std::string, std::vector<Value>> channel_map;
+  for (ValueRecord& record : records) {
+    std::vector<Value>& values = channel_map[record.name];
+    if (max_values_count.has_value() && values.size() >= *max_values_count) {
+      continue;
+    }
+    values.push_back(std::move(record.value));
+  }
+  return channel_map;
+}
+
+absl::StatusOr<absl::btree_map<std::string, std::vector<Value>>>
+ParseChannelValuesFromRecordFile(
+    std::string_view filename,
+    std::optional<const int64_t> max_values_count) {
+  XLS_ASSIGN_OR_RETURN(std::string data, GetFileContents(filename));
+  return ParseChannelValuesFromRecordData(data, max_values_count);
+}
+
+namespace {
+
+// Wire-format constants of ProcChannelValuesProto. The streaming reader walks
+// the serialized file record-by-record rather than parsing it as a whole, so
+// it needs the field numbers and wire type of the fields involved. All fields
+// of ProcChannelValuesProto and its Channel submessage are length-delimited.
+constexpr uint64_t kLengthDelimitedWireType = 2;
+constexpr uint64_t kChannelsFieldNumber = 1;
+constexpr uint64_t kChannelNameFieldNumber = 1;
+constexpr uint64_t kChannelEntryFieldNumber = 2;
+
+// Reads a varint-encoded integer from the stream.
+absl::StatusOr<uint64_t> ReadVarint(std::istream& stream) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = stream.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return absl::DataLossError(
+          "Unexpected end of file within varint in channel values file");
+    }
+    result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return result;
+    }
+  }
+  return absl::DataLossError("Overlong varint in channel values file");
+}
+
+}  // namespace
+
+/* static */ absl::StatusOr<std::unique_ptr<StreamingChannelValuesReader>>
+StreamingChannelValuesReader::Create(std::string_view filename) {
+  std::ifstream stream{std::string(filename), std::ios::binary};
+  if (!stream.is_open()) {
+    return absl::NotFoundError(
+        absl::StrFormat("Cannot open channel values file: %s", filename));
+  }
+  auto reader =
+      absl::WrapUnique(new StreamingChannelValuesReader(std::move(stream)));
+  XLS_RETURN_IF_ERROR(reader->IndexChannels());
+  return reader;
+}
+
+absl::Status StreamingChannelValuesReader::IndexChannels() {
+  stream_.seekg(0, std::ios::end);
+  const int64_t file_size = stream_.tellg();
+  stream_.seekg(0);
+  while (static_cast<int64_t>(stream_.tellg()) < file_size) {
+    XLS_ASSIGN_OR_RETURN(uint64_t tag, ReadVarint(stream_));
+    if (tag >> 3 != kChannelsFieldNumber ||
+        (tag & 0x7) != kLengthDelimitedWireType) {
+      return absl::DataLossError(absl::StrFormat(
+          "Unexpected field in ProcChannelValuesProto (tag %d)", tag));
+    }
+    XLS_ASSIGN_OR_RETURN(uint64_t length, ReadVarint(stream_));
+    const int64_t payload_end =
+        static_cast<int64_t>(stream_.tellg()) + static_cast<int64_t>(length);
+    if (payload_end > file_size) {
+      return absl::DataLossError("Truncated channel record");
+    }
+    // Scan the channel record for its name and the offset of its first value
+    // record. Serializers write the name first, so this typically touches
+    // only the first few bytes before seeking past the values.
+    std::string name;
+    bool has_name = false;
+    std::optional<int64_t> entry_start;
+    while (static_cast<int64_t>(stream_.tellg()) < payload_end &&
+           !(has_name && entry_start.has_value())) {
+      const int64_t field_start = stream_.tellg();
+      XLS_ASSIGN_OR_RETURN(uint64_t field_tag, ReadVarint(stream_));
+      if ((field_tag & 0x7) != kLengthDelimitedWireType) {
+        return absl::DataLossError(absl::StrFormat(
+            "Unexpected field in ProcChannelValuesProto.Channel (tag %d)",
+            field_tag));
+      }
+      XLS_ASSIGN_OR_RETURN(uint64_t field_length, ReadVarint(stream_));
+      if (field_tag >> 3 == kChannelNameFieldNumber) {
+        name.resize(field_length);
+        if (!stream_.read(name.data(), field_length)) {
+          return absl::DataLossError("Truncated channel name");
+        }
+        has_name = true;
+      } else {
+        if (field_tag >> 3 == kChannelEntryFieldNumber &&
+            !entry_start.has_value()) {
+          entry_start = field_start;
+        }
+        stream_.seekg(static_cast<int64_t>(field_length), std::ios::cur);
+      }
+    }
+    if (!has_name) {
+      return absl::DataLossError("Channel record without a name");
+    }
+    auto [it, inserted] = channels_.emplace(
+        name, ChannelRange{.cursor = entry_start.value_or(payload_end),
+                           .end = payload_end});
+    if (!inserted) {
+      return absl::DataLossError(absl::StrFormat(
+          "Channel '%s' declared more than once in channel values file", name));
+    }
+    channel_names_.push_back(std::move(name));
+    stream_.seekg(payload_end);
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<Value>> StreamingChannelValuesReader::ReadValues(
+    std::string_view channel_name, int64_t max_count) {
+  auto it = channels_.find(channel_name);
+  if (it == channels_.end()) {
+    return absl::NotFoundError(absl::StrFormat(
+        "No channel '%s' in channel values file", channel_name));
+  }
+  ChannelRange& range = it->second;
+  std::vector<Value> values;
+  stream_.clear();
+  stream_.seekg(range.cursor);
+  std::string buffer;
+  while (static_cast<int64_t>(values.size()) < max_count &&
+         range.cursor < range.end) {
+    XLS_ASSIGN_OR_RETURN(uint64_t tag, ReadVarint(stream_));
+    if ((tag & 0x7) != kLengthDelimitedWireType) {
+      return absl::DataLossError(absl::StrFormat(
+          "Unexpected field in ProcChannelValuesProto.Channel (tag %d)", tag));
+    }
+    XLS_ASSIGN_OR_RETURN(uint64_t length, ReadVarint(stream_));
+    if (tag >> 3 == kChannelEntryFieldNumber) {
+      buffer.resize(length);
+      if (!stream_.read(buffer.data(), length)) {
+        return absl::DataLossError("Truncated channel entry");
+      }
+      ValueProto proto;
+      XLS_RET_CHECK(proto.ParseFromString(buffer));
+      XLS_ASSIGN_OR_RETURN(Value value, Value::FromProto(proto));
+      values.push_back(std::move(value));
+    } else {
+      stream_.seekg(static_cast<int64_t>(length), std::ios::cur);
+    }
+    range.cursor = stream_.tellg();
+  }
+  return values;
+}
 }  // namespace xls
@@ -16,14 +16,18 @@
 #define XLS_TOOLS_EVAL_UTILS_H_
 
 #include <cstdint>
+#include <fstream>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_join.h"
+#include "absl/types/span.h"
 #include "xls/common/indent.h"
 #include "xls/ir/format_preference.h"
 #include "xls/ir/value.h"
@@ -130,6 +134,100 @@ ParseChannelValuesFromProtoFile(
 absl::StatusOr<ProcChannelValuesProto> ChannelValuesToProto(
     const absl::btree_map<std::string, std::vector<Value>>& channel_map);
 
+// A single stimulus or expectation record: a Value bound to a named stream
+// (typically a proc channel or a function parameter).
+struct ValueRecord {
+  std::string name;
+  Value value;
+};
+
+// Serializes `records` into the binary value-record format shared by the
+// evaluation tools. Record order is preserved. All records bound to the same
+// name must have the same type.
+//
+// File layout (all integers unsigned 32-bit little-endian):
+//   magic "XLSVREC\0" (8 bytes)
+//   version (currently 1)
+//   stream count, then for each stream:
+//     name length, name bytes,
+//     type length, type in IR syntax (e.g. "bits[32]")
+//   records until end of data, each:
+//     stream index, then the value flattened to bits (see
+//     xls/codegen/flattening.h) as ceil(flat bit count / 8) bytes, least
+//     significant byte first.
+//
+// Values are stored bit-packed rather than as text so consumers can decode a
+// record with a single Bits construction instead of parsing value literals.
+absl::StatusOr<std::string> SerializeValueRecords(
+    absl::Span<const ValueRecord> records);
+
+// Parses data produced by SerializeValueRecords, returning the records in
+// file order.
+absl::StatusOr<std::vector<ValueRecord>> DeserializeValueRecords(
+    std::string_view data);
+
+// Converts a channels-to-values map into the binary value-record format with
+// records grouped by channel. This is the binary analog of
+// ChannelValuesToString and the inverse of ParseChannelValuesFromRecordData.
+absl::StatusOr<std::string> ChannelValuesToRecordData(
+    const absl::btree_map<std::string, std::vector<Value>>& channel_map);
+
+// Returns the channels-to-values map stored in the given value-record data or
+// file. Per-channel value order is preserved. The max_values_count denotes the
+// maximum number of values for a channel; extra records are ignored.
+absl::StatusOr<absl::btree_map<std::string, std::vector<Value>>>
+ParseChannelValuesFromRecordData(
+    std::string_view data,
+    std::optional<const int64_t> max_values_count = std::nullopt);
+
+// As ParseChannelValuesFromRecordData but reads the record data from the given
+// file.
+absl::StatusOr<absl::btree_map<std::string, std::vector<Value>>>
+ParseChannelValuesFromRecordFile(
+    std::string_view filename,
+    std::optional<const int64_t> max_values_count = std::nullopt);
+
+// Incrementally decodes a ProcChannelValuesProto binary file without
+// materializing all of its values in memory. The file is scanned once at
+// creation time to index the per-channel records; values are then decoded on
+// demand by ReadValues. This keeps memory usage bounded when driving long
+// simulations from stimulus files whose decoded Values are much larger than
+// their serialized form.
+class StreamingChannelValuesReader {
+ public:
+  // Opens and indexes the given binary ProcChannelValuesProto file.
+  static absl::StatusOr<std::unique_ptr<StreamingChannelValuesReader>> Create(
+      std::string_view filename);
+
+  // Returns the names of the channels in the file, in file order.
+  absl::Span<const std::string> channel_names() const { return channel_names_; }
+
+  // Decodes and returns up to `max_count` values of the given channel,
+  // advancing the channel's read cursor. Returns fewer than `max_count` values
+  // (eventually an empty vector) when the channel's values are exhausted.
+  absl::StatusOr<std::vector<Value>> ReadValues(std::string_view channel_name,
+                                                int64_t max_count);
+
+ private:
+  // Byte range within the file holding the not-yet-decoded value records of a
+  // single channel.
+  struct ChannelRange {
+    int64_t cursor;  // Offset of the next undecoded record.
+    int64_t end;     // Offset one past the channel's last record.
+  };
+
+  explicit StreamingChannelValuesReader(std::ifstream stream)
+      : stream_(std::move(stream)) {}
+
+  // Scans the file recording the name and value-record byte range of each
+  // channel without decoding the values themselves.
+  absl::Status IndexChannels();
+
+  std::ifstream stream_;
+  std::vector<std::string> channel_names_;
+  absl::flat_hash_map<std::string, ChannelRange> channels_;
+};
+
 }  // namespace xls
 
 #endif  // XLS_TOOLS_EVAL_UTILS_H_
@@ -14,14 +14,19 @@
 
 #include "xls/tools/eval_utils.h"
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include <memory>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/container/btree_map.h"
+#include "absl/status/status.h"
 #include "google/protobuf/text_format.h"
+#include "xls/common/file/temp_file.h"
 #include "xls/common/proto_test_utils.h"
 #include "xls/common/status/matchers.h"
 #include "xls/ir/bits.h"
@@ -131,5 +136,105 @@ TEST(EvalHelpersTest, ChannelValuesToProto) {
   EXPECT_THAT(ChannelValuesToProto(input), IsOkAndHolds(EqualsProto(expected)));
 }
 
+TEST(EvalHelpersTest, StreamingChannelValuesReader) {
+  absl::btree_map<std::string, std::vector<Value>> input{
+      {"bar", {Value(UBits(0x42, 8))}},
+      {"empty", {}},
+      {"foo",
+       {Value(UBits(1, 32)), Value(UBits(2, 32)), Value(UBits(3, 32)),
+        Value::Tuple({Value(UBits(4, 32)), Value(UBits(5, 8))})}}};
+  XLS_ASSERT_OK_AND_ASSIGN(ProcChannelValuesProto pcv,
+                           ChannelValuesToProto(input));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TempFile file,
+      TempFile::CreateWithContent(pcv.SerializeAsString(), ".pb"));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<StreamingChannelValuesReader> reader,
+      StreamingChannelValuesReader::Create(file.path().string()));
+  EXPECT_THAT(reader->channel_names(), ElementsAre("bar", "empty", "foo"));
+
+  // Values are decoded incrementally, in order, with each channel keeping its
+  // own cursor.
+  EXPECT_THAT(reader->ReadValues("foo", 2),
+              IsOkAndHolds(
+                  ElementsAre(Value(UBits(1, 32)), Value(UBits(2, 32)))));
+  EXPECT_THAT(reader->ReadValues("bar", 10),
+              IsOkAndHolds(ElementsAre(Value(UBits(0x42, 8)))));
+  EXPECT_THAT(
+      reader->ReadValues("foo", 10),
+      IsOkAndHolds(ElementsAre(
+          Value(UBits(3, 32)),
+          Value::Tuple({Value(UBits(4, 32)), Value(UBits(5, 8))}))));
+
+  // Exhausted and empty channels yield no values.
+  EXPECT_THAT(reader->ReadValues("foo", 10), IsOkAndHolds(ElementsAre()));
+  EXPECT_THAT(reader->ReadValues("empty", 10), IsOkAndHolds(ElementsAre()));
+
+  EXPECT_THAT(reader->ReadValues("no_such_channel", 1).status(),
+              status_testing::StatusIs(absl::StatusCode::kNotFound));
+}
+
+TEST(EvalHelpersTest, ValueRecordRoundTrip) {
+  std::vector<ValueRecord> records{
+      {"a", Value(UBits(0x42, 8))},
+      {"b", Value::Tuple({Value(UBits(0x1234, 17)), Value(UBits(1, 1))})},
+      {"a", Value(UBits(0xff, 8))},
+      {"c", Value::ArrayOrDie({Value(UBits(1, 4)), Value(UBits(2, 4))})},
+  };
+  XLS_ASSERT_OK_AND_ASSIGN(std::string data, SerializeValueRecords(records));
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<ValueRecord> parsed,
+                           DeserializeValueRecords(data));
+  ASSERT_EQ(parsed.size(), records.size());
+  for (int64_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ(parsed[i].name, records[i].name);
+    EXPECT_EQ(parsed[i].value, records[i].value);
+  }
+}
+
+TEST(EvalHelpersTest, ValueRecordErrors) {
+  // Records bound to the same name must have the same type.
+  EXPECT_THAT(
+      SerializeValueRecords(std::vector<ValueRecord>{
+                                {"a", Value(UBits(1, 8))},
+                                {"a", Value(UBits(1, 9))}})
+          .status(),
+      status_testing::StatusIs(absl::StatusCode::kInvalidArgument,
+                               testing::HasSubstr("mismatched types")));
+  EXPECT_THAT(DeserializeValueRecords("not a record file").status(),
+              status_testing::StatusIs(absl::StatusCode::kInvalidArgument,
+                                       testing::HasSubstr("magic")));
+  // Truncated record payloads are rejected.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::string data, SerializeValueRecords(std::vector<ValueRecord>{
+                            {"a", Value(UBits(0x1234, 16))}}));
+  EXPECT_THAT(
+      DeserializeValueRecords(std::string_view(data).substr(0, data.size() - 1))
+          .status(),
+      status_testing::StatusIs(absl::StatusCode::kInvalidArgument,
+                               testing::HasSubstr("Truncated")));
+}
+
+TEST(EvalHelpersTest, ChannelValuesRecordDataRoundTrip) {
+  absl::btree_map<std::string, std::vector<Value>> input{
+      {"bar", {Value(UBits(0x42, 8))}},
+      {"foo",
+       {Value(UBits(1, 32)), Value(UBits(2, 32)),
+        Value::Tuple({Value(UBits(4, 16)), Value(UBits(5, 8))})}}};
+  XLS_ASSERT_OK_AND_ASSIGN(std::string data, ChannelValuesToRecordData(input));
+  EXPECT_THAT(
+      ParseChannelValuesFromRecordData(data),
+      IsOkAndHolds(UnorderedElementsAre(
+          Pair("bar", ElementsAre(Value(UBits(0x42, 8)))),
+          Pair("foo", ElementsAre(Value(UBits(1, 32)), Value(UBits(2, 32)),
+                                  Value::Tuple({Value(UBits(4, 16)),
+                                                Value(UBits(5, 8))}))))));
+  // max_values_count caps the number of values decoded per channel.
+  EXPECT_THAT(ParseChannelValuesFromRecordData(data, 1),
+              IsOkAndHolds(UnorderedElementsAre(
+                  Pair("bar", ElementsAre(Value(UBits(0x42, 8)))),
+                  Pair("foo", ElementsAre(Value(UBits(1, 32)))))));
+}
+
 }  // namespace
 }  // namespace xls
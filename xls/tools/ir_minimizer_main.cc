@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>  // NOLINT
 #include <iostream>
 #include <iterator>
 #include <memory>
@@ -42,6 +43,7 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xls/common/exit_status.h"
 #include "xls/common/file/filesystem.h"
@@ -51,6 +53,7 @@
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/common/subprocess.h"
+#include "xls/common/thread.h"
 #include "xls/data_structures/binary_search.h"
 #include "xls/data_structures/inline_bitmap.h"
 #include "xls/interpreter/function_interpreter.h"
@@ -117,6 +120,11 @@ from the interpreter results. Example invocation:
   ir_minimizer_main --test_llvm_jit --use_optimization_pipeline \
     --input='bits[32]:42; bits[1]:0' IR_FILE
 
+If IR_FILE is a directory, every .ir file in it is minimized and each result
+is written next to its input with a .minimized suffix. --parallelism controls
+how many candidate reductions (single-file mode) or files (batch mode) are
+evaluated concurrently.
+
 )";
 
 ABSL_FLAG(bool, can_remove_params, false,
@@ -202,6 +210,13 @@ ABSL_FLAG(int64_t, simplifications_between_tests, 1,
 ABSL_FLAG(int64_t, failed_attempts_between_tests_limit, 16,
           "Failed simplification attempts between tests before we conclude we "
           "need to check our changes so far.");
+ABSL_FLAG(int64_t, parallelism, 1,
+          "Number of independent candidate simplifications to generate and "
+          "test concurrently each round. The test predicate is pure so "
+          "candidates can be evaluated in parallel; results are memoized in a "
+          "cache shared between workers. When the positional argument is a "
+          "directory this is instead the number of files minimized "
+          "concurrently.");
 ABSL_FLAG(
     bool, verify_ir, true,
     "Verify IR whenever parsing. In most cases, this is a good check that the "
@@ -224,6 +239,30 @@ ABSL_FLAG(
 namespace xls {
 namespace {
 
+// Thread-safe memoization of test results keyed by IR text. Shared between
+// concurrently-evaluated candidates (and between files in batch mode) so no
+// IR is ever tested twice.
+class TestCache {
+ public:
+  std::optional<bool> Lookup(std::string_view ir_text) {
+    absl::MutexLock lock(&mu_);
+    auto it = results_.find(ir_text);
+    if (it == results_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  void Insert(std::string_view ir_text, bool result) {
+    absl::MutexLock lock(&mu_);
+    results_.emplace(ir_text, result);
+  }
+
+ private:
+  absl::Mutex mu_;
+  absl::flat_hash_map<std::string, bool> results_;
+};
+
 absl::StatusOr<std::unique_ptr<Package>> ParsePackage(
     std::string_view ir_text) {
   std::optional<std::string_view> entry;
@@ -321,22 +360,22 @@ absl::StatusOr<bool> StillFailsHelper(
 // used to memoize the results of testing the given IR.
 absl::StatusOr<bool> StillFails(
     std::string_view ir_text, std::optional<std::vector<Value>> inputs,
-    absl::flat_hash_map<std::string, bool>* test_cache) {
+    TestCache* test_cache) {
   VLOG(1) << "=== Verifying contents still fails";
   XLS_VLOG_LINES(2, ir_text);
 
   if (test_cache != nullptr) {
-    auto it = test_cache->find(ir_text);
-    if (it != test_cache->end()) {
+    if (std::optional<bool> cached = test_cache->Lookup(ir_text);
+        cached.has_value()) {
       LOG(INFO) << absl::StreamFormat("Found result in cache (failed = %d)",
-                                      it->second);
-      return it->second;
+                                      *cached);
+      return *cached;
     }
   }
 
   XLS_ASSIGN_OR_RETURN(bool result, StillFailsHelper(ir_text, inputs));
   if (test_cache != nullptr) {
-    (*test_cache)[ir_text] = result;
+    test_cache->Insert(ir_text, result);
   }
   return result;
 }
@@ -346,8 +385,7 @@ absl::StatusOr<bool> StillFails(
 // cache is used to memoize the results of testing the given IR.
 absl::Status VerifyStillFails(
     std::string_view ir_text, std::optional<std::vector<Value>> inputs,
-    std::string_view description,
-    absl::flat_hash_map<std::string, bool>* test_cache) {
+    std::string_view description, TestCache* test_cache) {
   XLS_ASSIGN_OR_RETURN(bool still_fails,
                        StillFails(ir_text, inputs, test_cache));
 
@@ -1175,55 +1213,49 @@ absl::Status CleanUp(FunctionBase* f, bool can_remove_params) {
   return absl::OkStatus();
 }
 
-absl::Status RealMain(std::string_view path, const int64_t failed_attempt_limit,
-                      const int64_t total_attempt_limit,
-                      const int64_t simplifications_between_tests,
-                      const int64_t failed_attempts_between_tests_limit) {
-  XLS_ASSIGN_OR_RETURN(std::string knownf_ir_text, GetFileContents(path));
-  // Cache of test results to avoid duplicate invocations of the
-  // test_executable.
-  absl::flat_hash_map<std::string, bool> test_cache;
-
-  // Parse inputs, if specified.
-  std::optional<std::vector<xls::Value>> inputs;
-  if (!absl::GetFlag(FLAGS_input).empty()) {
-    inputs = std::vector<xls::Value>();
-    QCHECK(absl::GetFlag(FLAGS_test_llvm_jit))
-        << "Can only specify --input with --test_llvm_jit";
-    for (const std::string_view& value_string :
-         absl::StrSplit(absl::GetFlag(FLAGS_input), ';')) {
-      XLS_ASSIGN_OR_RETURN(Value input, Parser::ParseTypedValue(value_string));
-      inputs->push_back(input);
-    }
+// Cleans up any initial garbage in `knownf_ir_text` and returns the
+// cleaned-up text if it still fails, otherwise the input text unchanged.
+absl::StatusOr<std::string> CleanUpInitialGarbage(
+    std::string knownf_ir_text, const std::optional<std::vector<Value>>& inputs,
+    TestCache* test_cache) {
+  LOG(INFO) << "=== Cleaning up initial garbage";
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       ParsePackage(knownf_ir_text));
+  FunctionBase* main = package->GetTop().value();
+  XLS_RETURN_IF_ERROR(CleanUp(main, absl::GetFlag(FLAGS_can_remove_params)));
+  if (absl::GetFlag(FLAGS_verify_ir)) {
+    XLS_RETURN_IF_ERROR(VerifyPackage(package.get()));
+  }
+  std::string cleaned_up_ir_text = package->DumpIr();
+  XLS_ASSIGN_OR_RETURN(bool still_fails,
+                       StillFails(cleaned_up_ir_text, inputs, test_cache));
+  if (still_fails) {
+    knownf_ir_text = cleaned_up_ir_text;
+  } else {
+    LOG(INFO) << "=== Original main function does not fail after cleanup";
   }
+  LOG(INFO) << "=== Done cleaning up initial garbage";
+  return knownf_ir_text;
+}
 
+// Minimizes `knownf_ir_text` with the serial simplification loop and returns
+// the minimized text.
+absl::StatusOr<std::string> MinimizeIrText(
+    std::string knownf_ir_text, const std::optional<std::vector<Value>>& inputs,
+    const int64_t failed_attempt_limit, const int64_t total_attempt_limit,
+    const int64_t simplifications_between_tests,
+    const int64_t failed_attempts_between_tests_limit, TestCache* test_cache) {
   // Check what the user gave us actually fails.
   XLS_RETURN_IF_ERROR(VerifyStillFails(
       knownf_ir_text, inputs,
-      "Originally-provided main function provided does not fail", &test_cache));
+      "Originally-provided main function provided does not fail", test_cache));
 
   const bool can_remove_params = absl::GetFlag(FLAGS_can_remove_params);
 
   // Clean up any initial garbage and see if it still fails.
-  {
-    LOG(INFO) << "=== Cleaning up initial garbage";
-    XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
-                         ParsePackage(knownf_ir_text));
-    FunctionBase* main = package->GetTop().value();
-    XLS_RETURN_IF_ERROR(CleanUp(main, can_remove_params));
-    if (absl::GetFlag(FLAGS_verify_ir)) {
-      XLS_RETURN_IF_ERROR(VerifyPackage(package.get()));
-    }
-    std::string cleaned_up_ir_text = package->DumpIr();
-    XLS_ASSIGN_OR_RETURN(bool still_fails,
-                         StillFails(cleaned_up_ir_text, inputs, &test_cache));
-    if (still_fails) {
-      knownf_ir_text = cleaned_up_ir_text;
-    } else {
-      LOG(INFO) << "=== Original main function does not fail after cleanup";
-    }
-    LOG(INFO) << "=== Done cleaning up initial garbage";
-  }
+  XLS_ASSIGN_OR_RETURN(
+      knownf_ir_text,
+      CleanUpInitialGarbage(std::move(knownf_ir_text), inputs, test_cache));
 
   // If so, we start simplifying via this seeded RNG.
   std::mt19937 rng;  // Default constructor uses deterministic seed.
@@ -1361,7 +1393,7 @@ absl::Status RealMain(std::string_view path, const int64_t failed_attempt_limit,
 
     XLS_ASSIGN_OR_RETURN(bool still_fails,
                          StillFails(candidate_changes.back().package_ir_text,
-                                    inputs, &test_cache));
+                                    inputs, test_cache));
     if (!still_fails) {
       // Test earlier changes to see if they were failing, and discard the ones
       // that aren't.
@@ -1375,7 +1407,7 @@ absl::Status RealMain(std::string_view path, const int64_t failed_attempt_limit,
                 XLS_ASSIGN_OR_RETURN(
                     bool still_fails,
                     StillFails(candidate_changes[i].package_ir_text, inputs,
-                               &test_cache));
+                               test_cache));
                 return !still_fails;
               },
               BinarySearchAssumptions::kEndKnownTrue));
@@ -1420,13 +1452,307 @@ absl::Status RealMain(std::string_view path, const int64_t failed_attempt_limit,
     candidate_changes.clear();
   }
 
-  std::cout << knownf_ir_text;
+  // Run the last test verification without the cache.
+  XLS_RETURN_IF_ERROR(VerifyStillFails(knownf_ir_text, inputs,
+                                       "Minimized function does not fail!",
+                                       /*test_cache=*/nullptr));
+
+  return knownf_ir_text;
+}
+
+// Result of one speculative candidate reduction evaluated by a parallel
+// worker.
+struct ParallelAttempt {
+  std::string ir_text;
+  int64_t node_count;
+  std::vector<std::string> transforms;
+  bool still_fails;
+};
+
+// Applies up to `simplifications_between_tests` random simplifications to a
+// private copy of `knownf_ir_text` and tests the result. Returns std::nullopt
+// if the RNG stream seeded with `seed` produced no change. Workers share no
+// mutable state other than the test cache, so any number of attempts can run
+// concurrently.
+absl::StatusOr<std::optional<ParallelAttempt>> AttemptSimplification(
+    std::string_view knownf_ir_text,
+    const std::optional<std::vector<Value>>& inputs,
+    int64_t simplifications_between_tests, uint64_t seed,
+    TestCache* test_cache) {
+  std::mt19937 rng(seed);
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       ParsePackage(knownf_ir_text));
+  std::vector<std::string> transforms;
+  for (int64_t i = 0; i < simplifications_between_tests; ++i) {
+    FunctionBase* candidate;
+    if (absl::GetFlag(FLAGS_simplify_top_only)) {
+      candidate = package->GetTop().value();
+    } else {
+      std::vector<FunctionBase*> bases = package->GetFunctionBases();
+      std::vector<int64_t> node_counts;
+      node_counts.reserve(bases.size());
+      for (auto it = bases.begin(); it != bases.end();) {
+        int64_t node_count = (*it)->node_count();
+        if (node_count == 0) {
+          // This is an empty function.
+          it = bases.erase(it);
+          continue;
+        }
+        node_counts.push_back(node_count);
+        it++;
+      }
+      if (bases.empty()) {
+        break;
+      }
+      absl::discrete_distribution<size_t> distribution(node_counts.cbegin(),
+                                                       node_counts.cend());
+      candidate = bases[distribution(rng)];
+    }
+
+    std::string which_transform;
+    XLS_ASSIGN_OR_RETURN(SimplifiedIr simplification,
+                         Simplify(candidate, inputs, rng, &which_transform));
+    if (simplification.result == SimplificationResult::kCannotChange) {
+      break;
+    }
+    if (simplification.result == SimplificationResult::kDidNotChange) {
+      continue;
+    }
+    if (simplification.in_place()) {
+      XLS_RETURN_IF_ERROR(
+          CleanUp(candidate, absl::GetFlag(FLAGS_can_remove_params)));
+    } else {
+      // The simplification produced new IR text (e.g. segment extraction);
+      // continue from a reparse of it.
+      XLS_ASSIGN_OR_RETURN(package, ParsePackage(simplification.ir()));
+    }
+    transforms.push_back(which_transform);
+  }
+  if (transforms.empty()) {
+    return std::nullopt;
+  }
+
+  ParallelAttempt attempt;
+  attempt.ir_text = package->DumpIr();
+  attempt.node_count = package->GetNodeCount();
+  attempt.transforms = std::move(transforms);
+  XLS_ASSIGN_OR_RETURN(attempt.still_fails,
+                       StillFails(attempt.ir_text, inputs, test_cache));
+  return attempt;
+}
+
+// Parallel variant of the minimization loop: each round generates
+// `parallelism` independent candidate reductions of the current known-failing
+// IR, tests them concurrently (the test predicate is pure) and commits the
+// smallest one which still fails. Because every worker tests its own batch,
+// --failed_attempts_between_tests_limit does not apply here.
+absl::StatusOr<std::string> MinimizeIrTextParallel(
+    std::string knownf_ir_text, const std::optional<std::vector<Value>>& inputs,
+    const int64_t failed_attempt_limit, const int64_t total_attempt_limit,
+    const int64_t simplifications_between_tests, const int64_t parallelism,
+    TestCache* test_cache) {
+  XLS_RETURN_IF_ERROR(VerifyStillFails(
+      knownf_ir_text, inputs,
+      "Originally-provided main function provided does not fail", test_cache));
+
+  XLS_ASSIGN_OR_RETURN(
+      knownf_ir_text,
+      CleanUpInitialGarbage(std::move(knownf_ir_text), inputs, test_cache));
+
+  int64_t failed_simplification_attempts = 0;
+  int64_t total_attempts = 0;
+  uint64_t next_seed = 0;
+  while (failed_simplification_attempts < failed_attempt_limit &&
+         total_attempts < total_attempt_limit) {
+    LOG(INFO) << "Total attempts " << total_attempts << "/"
+              << total_attempt_limit;
+    LOG(INFO) << "Failed attempt count " << failed_simplification_attempts
+              << "/" << failed_attempt_limit;
+    total_attempts += parallelism;
+
+    std::vector<absl::StatusOr<std::optional<ParallelAttempt>>> attempts(
+        parallelism);
+    {
+      std::vector<std::unique_ptr<Thread>> threads;
+      threads.reserve(parallelism);
+      for (int64_t i = 0; i < parallelism; ++i) {
+        uint64_t seed = next_seed++;
+        threads.push_back(std::make_unique<Thread>([&, i, seed] {
+          attempts[i] =
+              AttemptSimplification(knownf_ir_text, inputs,
+                                    simplifications_between_tests, seed,
+                                    test_cache);
+        }));
+      }
+      for (std::unique_ptr<Thread>& thread : threads) {
+        thread->Join();
+      }
+    }
+
+    const ParallelAttempt* best = nullptr;
+    for (const absl::StatusOr<std::optional<ParallelAttempt>>& attempt :
+         attempts) {
+      XLS_RETURN_IF_ERROR(attempt.status());
+      if (attempt->has_value() && (*attempt)->still_fails &&
+          (best == nullptr || (*attempt)->node_count < best->node_count)) {
+        best = &**attempt;
+      }
+    }
+    if (best == nullptr) {
+      failed_simplification_attempts += parallelism;
+      continue;
+    }
+
+    knownf_ir_text = best->ir_text;
+    failed_simplification_attempts = 0;
+    std::cerr << "---\ntransforms: " << absl::StrJoin(best->transforms, ", ")
+              << "\n(" << best->node_count << " nodes)\n";
+  }
 
   // Run the last test verification without the cache.
   XLS_RETURN_IF_ERROR(VerifyStillFails(knownf_ir_text, inputs,
                                        "Minimized function does not fail!",
                                        /*test_cache=*/nullptr));
 
+  return knownf_ir_text;
+}
+
+// Minimizes every `.ir` file in `dir`, `parallelism` files at a time, writing
+// each result next to its input with a `.minimized` suffix. Files whose
+// minimization fails (e.g. samples which do not fail to begin with) are
+// logged and skipped rather than aborting the batch.
+absl::Status MinimizeDirectory(
+    const std::filesystem::path& dir,
+    const std::optional<std::vector<Value>>& inputs,
+    const int64_t failed_attempt_limit, const int64_t total_attempt_limit,
+    const int64_t simplifications_between_tests,
+    const int64_t failed_attempts_between_tests_limit,
+    const int64_t parallelism, TestCache* test_cache) {
+  std::vector<std::filesystem::path> files;
+  for (const std::filesystem::directory_entry& entry :
+       std::filesystem::directory_iterator(dir)) {
+    if (entry.path().extension() == ".ir") {
+      files.push_back(entry.path());
+    }
+  }
+  if (files.empty()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("No .ir files found in directory: ", dir.string()));
+  }
+  std::sort(files.begin(), files.end());
+  LOG(INFO) << "Minimizing " << files.size() << " files from " << dir.string();
+
+  absl::Mutex mu;
+  size_t next_file = 0;
+  std::vector<absl::Status> statuses(files.size(), absl::OkStatus());
+  auto worker = [&] {
+    while (true) {
+      size_t index;
+      {
+        absl::MutexLock lock(&mu);
+        if (next_file >= files.size()) {
+          return;
+        }
+        index = next_file++;
+      }
+      const std::filesystem::path& file = files[index];
+      absl::StatusOr<std::string> ir_text = GetFileContents(file);
+      absl::StatusOr<std::string> minimized =
+          ir_text.ok() ? MinimizeIrText(*std::move(ir_text), inputs,
+                                        failed_attempt_limit,
+                                        total_attempt_limit,
+                                        simplifications_between_tests,
+                                        failed_attempts_between_tests_limit,
+                                        test_cache)
+                       : ir_text;
+      if (minimized.ok()) {
+        statuses[index] = SetFileContents(
+            absl::StrCat(file.string(), ".minimized"), *minimized);
+      } else {
+        statuses[index] = minimized.status();
+      }
+    }
+  };
+  {
+    std::vector<std::unique_ptr<Thread>> threads;
+    int64_t worker_count =
+        std::min(parallelism, static_cast<int64_t>(files.size()));
+    threads.reserve(worker_count);
+    for (int64_t i = 0; i < worker_count; ++i) {
+      threads.push_back(std::make_unique<Thread>(worker));
+    }
+    for (std::unique_ptr<Thread>& thread : threads) {
+      thread->Join();
+    }
+  }
+
+  int64_t failures = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (statuses[i].ok()) {
+      LOG(INFO) << "Minimized " << files[i].string() << " -> "
+                << files[i].string() << ".minimized";
+    } else {
+      LOG(ERROR) << "Failed to minimize " << files[i].string() << ": "
+                 << statuses[i];
+      failures++;
+    }
+  }
+  if (failures > 0) {
+    return absl::InternalError(absl::StrFormat(
+        "%d of %d files failed to minimize", failures, files.size()));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status RealMain(std::string_view path, const int64_t failed_attempt_limit,
+                      const int64_t total_attempt_limit,
+                      const int64_t simplifications_between_tests,
+                      const int64_t failed_attempts_between_tests_limit,
+                      const int64_t parallelism) {
+  // Cache of test results to avoid duplicate invocations of the
+  // test_executable.
+  TestCache test_cache;
+
+  // Parse inputs, if specified.
+  std::optional<std::vector<xls::Value>> inputs;
+  if (!absl::GetFlag(FLAGS_input).empty()) {
+    inputs = std::vector<xls::Value>();
+    QCHECK(absl::GetFlag(FLAGS_test_llvm_jit))
+        << "Can only specify --input with --test_llvm_jit";
+    for (const std::string_view& value_string :
+         absl::StrSplit(absl::GetFlag(FLAGS_input), ';')) {
+      XLS_ASSIGN_OR_RETURN(Value input, Parser::ParseTypedValue(value_string));
+      inputs->push_back(input);
+    }
+  }
+
+  if (std::filesystem::is_directory(std::filesystem::path(path))) {
+    // Batch mode: minimize every .ir file in the directory, with parallelism
+    // applied across files rather than candidates.
+    return MinimizeDirectory(std::filesystem::path(path), inputs,
+                             failed_attempt_limit, total_attempt_limit,
+                             simplifications_between_tests,
+                             failed_attempts_between_tests_limit, parallelism,
+                             &test_cache);
+  }
+
+  XLS_ASSIGN_OR_RETURN(std::string knownf_ir_text, GetFileContents(path));
+  std::string minimized;
+  if (parallelism > 1) {
+    XLS_ASSIGN_OR_RETURN(
+        minimized,
+        MinimizeIrTextParallel(std::move(knownf_ir_text), inputs,
+                               failed_attempt_limit, total_attempt_limit,
+                               simplifications_between_tests, parallelism,
+                               &test_cache));
+  } else {
+    XLS_ASSIGN_OR_RETURN(
+        minimized,
+        MinimizeIrText(std::move(knownf_ir_text), inputs, failed_attempt_limit,
+                       total_attempt_limit, simplifications_between_tests,
+                       failed_attempts_between_tests_limit, &test_cache));
+  }
+  std::cout << minimized;
   return absl::OkStatus();
 }
 
@@ -1470,9 +1796,13 @@ int main(int argc, char** argv) {
         << absl::StrJoin(failures, " ");
   }
 
+  QCHECK_GE(absl::GetFlag(FLAGS_parallelism), 1)
+      << "--parallelism must be at least 1";
+
   return xls::ExitStatus(xls::RealMain(
       positional_arguments[0], absl::GetFlag(FLAGS_failed_attempt_limit),
       absl::GetFlag(FLAGS_total_attempt_limit),
       absl::GetFlag(FLAGS_simplifications_between_tests),
-      absl::GetFlag(FLAGS_failed_attempts_between_tests_limit)));
+      absl::GetFlag(FLAGS_failed_attempts_between_tests_limit),
+      absl::GetFlag(FLAGS_parallelism)));
 }
@@ -30,6 +30,7 @@
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "xls/common/exit_status.h"
+#include "xls/common/file/file_mapping.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/file/get_runfile_path.h"
 #include "xls/common/init_xls.h"
@@ -116,9 +117,8 @@ absl::StatusOr<netlist::CellLibrary> GetCellLibrary(
     XLS_RET_CHECK(cell_proto.ParseFromString(cell_proto_text));
     return netlist::CellLibrary::FromProto(cell_proto);
   }
-  XLS_ASSIGN_OR_RETURN(std::string lib_text, GetFileContents(cell_lib_path));
   XLS_ASSIGN_OR_RETURN(auto stream,
-                       netlist::cell_lib::CharStream::FromText(lib_text));
+                       netlist::cell_lib::CharStream::FromPath(cell_lib_path));
   XLS_ASSIGN_OR_RETURN(netlist::CellLibraryProto proto,
                        netlist::function::ExtractFunctions(&stream));
   return netlist::CellLibrary::FromProto(proto);
@@ -127,8 +127,9 @@ absl::StatusOr<netlist::CellLibrary> GetCellLibrary(
 // Loads and parses a netlist from a file.
 absl::StatusOr<std::unique_ptr<netlist::rtl::Netlist>> GetNetlist(
     std::string_view netlist_path, netlist::CellLibrary* cell_library) {
-  XLS_ASSIGN_OR_RETURN(std::string netlist_text, GetFileContents(netlist_path));
-  netlist::rtl::Scanner scanner(netlist_text);
+  XLS_ASSIGN_OR_RETURN(FileMapping netlist_mapping,
+                       FileMapping::Open(std::string(netlist_path)));
+  netlist::rtl::Scanner scanner(netlist_mapping.data());
   return netlist::rtl::Parser::ParseNetlist(cell_library, &scanner);
 }
 
@@ -238,8 +239,9 @@ static absl::Status RealMain(
     std::string_view constraints_file, std::string_view schedule_path,
     int stage, bool auto_stage, int timeout_sec) {
   solvers::z3::LecParams lec_params;
-  XLS_ASSIGN_OR_RETURN(std::string ir_text, GetFileContents(ir_path));
-  XLS_ASSIGN_OR_RETURN(auto package, Parser::ParsePackage(ir_text));
+  XLS_ASSIGN_OR_RETURN(FileMapping ir_mapping,
+                       FileMapping::Open(std::string(ir_path)));
+  XLS_ASSIGN_OR_RETURN(auto package, Parser::ParsePackage(ir_mapping.data()));
   lec_params.ir_package = package.get();
   if (entry_function_name.empty()) {
     XLS_ASSIGN_OR_RETURN(lec_params.ir_function,
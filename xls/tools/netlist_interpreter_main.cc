@@ -27,6 +27,7 @@
 #include "absl/types/span.h"
 #include "xls/codegen/flattening.h"
 #include "xls/common/exit_status.h"
+#include "xls/common/file/file_mapping.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/init_xls.h"
 #include "xls/common/status/ret_check.h"
@@ -73,11 +74,9 @@ static absl::StatusOr<netlist::CellLibrary> GetCellLibrary(
     XLS_RET_CHECK(lib_proto.ParseFromString(proto_text));
     return netlist::CellLibrary::FromProto(lib_proto);
   }
-  XLS_ASSIGN_OR_RETURN(std::string cell_library_text,
-                       GetFileContents(cell_library_path));
   XLS_ASSIGN_OR_RETURN(
       auto char_stream,
-      netlist::cell_lib::CharStream::FromText(cell_library_text));
+      netlist::cell_lib::CharStream::FromPath(cell_library_path));
   XLS_ASSIGN_OR_RETURN(netlist::CellLibraryProto lib_proto,
                        netlist::function::ExtractFunctions(&char_stream));
   return netlist::CellLibrary::FromProto(lib_proto);
@@ -94,8 +93,9 @@ static absl::Status RealMain(const std::string& netlist_path,
       netlist::CellLibrary cell_library,
       GetCellLibrary(cell_library_path, cell_library_proto_path));
 
-  XLS_ASSIGN_OR_RETURN(std::string netlist_text, GetFileContents(netlist_path));
-  netlist::rtl::Scanner scanner(netlist_text);
+  XLS_ASSIGN_OR_RETURN(FileMapping netlist_mapping,
+                       FileMapping::Open(netlist_path));
+  netlist::rtl::Scanner scanner(netlist_mapping.data());
   XLS_ASSIGN_OR_RETURN(auto netlist, netlist::rtl::Parser::ParseNetlist(
                                          &cell_library, &scanner));
   XLS_ASSIGN_OR_RETURN(const auto* module, netlist->GetModule(module_name));
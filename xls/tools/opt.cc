@@ -27,31 +27,26 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
+#include "xls/common/file/file_mapping.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/ir/function_base.h"
 #include "xls/ir/ir_parser.h"
+#include "xls/ir/package.h"
 #include "xls/ir/verifier.h"
+#include "xls/passes/ir_checkpoint.h"
 #include "xls/passes/optimization_pass.h"
 #include "xls/passes/optimization_pass_pipeline.h"
 #include "xls/passes/pass_base.h"
+#include "xls/passes/pass_metrics.h"
 #include "xls/passes/verifier_checker.h"
 
 namespace xls::tools {
 
-absl::StatusOr<std::string> OptimizeIrForTop(std::string_view ir,
-                                             const OptOptions& options) {
-  if (!options.top.empty()) {
-    VLOG(3) << "OptimizeIrForEntry; top: '" << options.top
-            << "'; opt_level: " << options.opt_level;
-  } else {
-    VLOG(3) << "OptimizeIrForEntry; opt_level: " << options.opt_level;
-  }
-
-  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
-                       Parser::ParsePackage(ir, options.ir_path));
+absl::Status OptimizePackage(Package* package, const OptOptions& options) {
   if (!options.top.empty()) {
     XLS_RETURN_IF_ERROR(package->SetTopByName(options.top));
   }
@@ -78,6 +73,7 @@ absl::StatusOr<std::string> OptimizeIrForTop(std::string_view ir,
   pass_options.ir_dump_path = options.ir_dump_path;
   pass_options.skip_passes = options.skip_passes;
   pass_options.inline_procs = options.inline_procs;
+  pass_options.proc_inlining_cluster_size = options.proc_inlining_cluster_size;
   pass_options.convert_array_index_to_select =
       options.convert_array_index_to_select;
   pass_options.split_next_value_selects = options.split_next_value_selects;
@@ -85,20 +81,76 @@ absl::StatusOr<std::string> OptimizeIrForTop(std::string_view ir,
   pass_options.use_context_narrowing_analysis =
       options.use_context_narrowing_analysis;
   pass_options.bisect_limit = options.bisect_limit;
+  if (options.compile_time_budget_ms.has_value()) {
+    pass_options.compile_time_budget =
+        absl::Milliseconds(*options.compile_time_budget_ms);
+  }
+  pass_options.worker_count = options.worker_count;
+  pass_options.skip_unchanged_functions = options.skip_unchanged_functions;
+  pass_options.record_ir_checkpoints = !options.ir_checkpoint_dump_dir.empty();
   PassResults results;
-  XLS_RETURN_IF_ERROR(
-      pipeline->Run(package.get(), pass_options, &results).status());
+  absl::Status run_status =
+      pipeline->Run(package, pass_options, &results).status();
+  if (!run_status.ok() && !options.ir_checkpoint_dump_dir.empty()) {
+    // Materialize the recorded checkpoints so the IR going into the failing
+    // pass can be inspected; on success nothing is written.
+    for (const IrCheckpointStore::Checkpoint& checkpoint :
+         results.ir_checkpoints.checkpoints()) {
+      std::filesystem::path path =
+          std::filesystem::path(options.ir_checkpoint_dump_dir) /
+          absl::StrFormat("%s.%05d.after_%s.%s.ir", package->name(),
+                          checkpoint.ordinal, checkpoint.pass_name,
+                          checkpoint.changed ? "changed" : "unchanged");
+      XLS_RETURN_IF_ERROR(
+          SetFileContents(path, IrCheckpointStore::Materialize(checkpoint)));
+    }
+  }
+  XLS_RETURN_IF_ERROR(run_status);
+  if (!options.pass_metrics_path.empty()) {
+    XLS_RETURN_IF_ERROR(
+        SetTextProtoFile(std::filesystem::path(options.pass_metrics_path),
+                         PassResultsToProto(results)));
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::unique_ptr<Package>> OptimizePackageForTop(
+    std::string_view ir, const OptOptions& options) {
+  if (!options.top.empty()) {
+    VLOG(3) << "OptimizeIrForEntry; top: '" << options.top
+            << "'; opt_level: " << options.opt_level;
+  } else {
+    VLOG(3) << "OptimizeIrForEntry; opt_level: " << options.opt_level;
+  }
+
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       Parser::ParsePackage(ir, options.ir_path));
+  XLS_RETURN_IF_ERROR(OptimizePackage(package.get(), options));
+  return package;
+}
+
+absl::StatusOr<std::string> OptimizeIrForTop(std::string_view ir,
+                                             const OptOptions& options) {
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       OptimizePackageForTop(ir, options));
   return package->DumpIr();
 }
 
-absl::StatusOr<std::string> OptimizeIrForTop(
+absl::StatusOr<std::unique_ptr<Package>> OptimizePackageForTop(
     std::string_view input_path, int64_t opt_level, std::string_view top,
     std::string_view ir_dump_path, absl::Span<const std::string> skip_passes,
     int64_t convert_array_index_to_select, int64_t split_next_value_selects,
-    bool inline_procs, std::string_view ram_rewrites_pb,
-    bool use_context_narrowing_analysis, std::optional<std::string> pass_list,
-    std::optional<int64_t> bisect_limit) {
-  XLS_ASSIGN_OR_RETURN(std::string ir, GetFileContents(input_path));
+    bool inline_procs, int64_t proc_inlining_cluster_size,
+    std::string_view ram_rewrites_pb, bool use_context_narrowing_analysis,
+    std::optional<std::string> pass_list,
+    std::optional<int64_t> bisect_limit, int64_t worker_count,
+    bool skip_unchanged_functions, std::string_view pass_metrics_path,
+    std::optional<int64_t> compile_time_budget_ms,
+    std::string_view ir_checkpoint_dump_dir) {
+  // Map rather than copy the input; large optimized IR files run to hundreds
+  // of megabytes and the parser only needs a read-only view.
+  XLS_ASSIGN_OR_RETURN(FileMapping ir_mapping,
+                       FileMapping::Open(std::string(input_path)));
   std::vector<RamRewrite> ram_rewrites;
   if (!ram_rewrites_pb.empty()) {
     RamRewritesProto ram_rewrite_proto;
@@ -121,12 +173,18 @@ absl::StatusOr<std::string> OptimizeIrForTop(
               ? std::nullopt
               : std::make_optional(split_next_value_selects),
       .inline_procs = inline_procs,
+      .proc_inlining_cluster_size = proc_inlining_cluster_size,
       .ram_rewrites = std::move(ram_rewrites),
       .use_context_narrowing_analysis = use_context_narrowing_analysis,
       .pass_list = std::move(pass_list),
       .bisect_limit = bisect_limit,
+      .worker_count = worker_count,
+      .skip_unchanged_functions = skip_unchanged_functions,
+      .compile_time_budget_ms = compile_time_budget_ms,
+      .pass_metrics_path = std::string(pass_metrics_path),
+      .ir_checkpoint_dump_dir = std::string(ir_checkpoint_dump_dir),
   };
-  return OptimizeIrForTop(ir, options);
+  return OptimizePackageForTop(ir_mapping.data(), options);
 }
 
 }  // namespace xls::tools
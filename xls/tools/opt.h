@@ -18,15 +18,18 @@
 #define XLS_TOOLS_OPT_H_
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 
 // TODO(meheff): 2021-10-04 Remove this header.
 #include "absl/types/span.h"
+#include "xls/ir/package.h"
 #include "xls/passes/optimization_pass.h"
 
 namespace xls::tools {
@@ -42,27 +45,63 @@ struct OptOptions {
   std::optional<int64_t> convert_array_index_to_select = std::nullopt;
   std::optional<int64_t> split_next_value_selects = std::nullopt;
   bool inline_procs;
+  // See OptimizationPassOptions::proc_inlining_cluster_size.
+  int64_t proc_inlining_cluster_size = 0;
   std::vector<RamRewrite> ram_rewrites = {};
   bool use_context_narrowing_analysis;
   std::optional<std::string> pass_list;
   std::optional<int64_t> bisect_limit;
+  int64_t worker_count = 1;
+  bool skip_unchanged_functions = false;
+  // If present, a best-effort bound in milliseconds on the total time spent
+  // running optimization passes; once exhausted the remaining passes are
+  // skipped.
+  std::optional<int64_t> compile_time_budget_ms;
+  // If non-empty, per-pass telemetry (durations, node deltas, fixed-point
+  // iteration counts) is written to this path as a PassPipelineMetricsProto
+  // textproto after the pipeline runs.
+  std::string pass_metrics_path = "";
+  // If non-empty, in-memory IR checkpoints are recorded after every pass
+  // invocation and, should the pipeline fail, materialized as .ir files into
+  // this directory for inspection. Much cheaper than ir_dump_path as
+  // unchanged functions share storage and nothing is written on success.
+  std::string ir_checkpoint_dump_dir = "";
 };
 
+// Runs the optimization pipeline over an already-constructed package in
+// place. This is the core of the opt flow with parsing factored out; callers
+// holding an in-memory `Package` (e.g. single-process opt+codegen flows)
+// should use this directly rather than round-tripping through textual IR. If
+// `options.top` is nonempty the package top is (re)set to it first.
+absl::Status OptimizePackage(Package* package, const OptOptions& options);
+
 // Helper used in the opt_main tool, optimizes the given IR for a particular
 // top-level entity (e.g., function, proc, etc) at the given opt level and
-// returns the resulting optimized IR.
+// returns the resulting optimized package. Returning the package (rather than
+// its text) lets callers stream large results out via
+// `Package::DumpIr(std::ostream&)` instead of materializing the whole dump as
+// one string.
+absl::StatusOr<std::unique_ptr<Package>> OptimizePackageForTop(
+    std::string_view ir, const OptOptions& options);
+
+// As above, but returns the textual IR of the optimized package.
 absl::StatusOr<std::string> OptimizeIrForTop(std::string_view ir,
                                              const OptOptions& options);
 
 // Convenience wrapper around the above that builds an OptOptions appropriately.
 // Analogous to calling opt_main with each argument being a flag.
-absl::StatusOr<std::string> OptimizeIrForTop(
+absl::StatusOr<std::unique_ptr<Package>> OptimizePackageForTop(
     std::string_view input_path, int64_t opt_level, std::string_view top,
     std::string_view ir_dump_path, absl::Span<const std::string> skip_passes,
     int64_t convert_array_index_to_select, int64_t split_next_value_selects,
-    bool inline_procs, std::string_view ram_rewrites_pb,
-    bool use_context_narrowing_analysis, std::optional<std::string> pass_list,
-    std::optional<int64_t> bisect_limit);
+    bool inline_procs, int64_t proc_inlining_cluster_size,
+    std::string_view ram_rewrites_pb, bool use_context_narrowing_analysis,
+    std::optional<std::string> pass_list,
+    std::optional<int64_t> bisect_limit, int64_t worker_count = 1,
+    bool skip_unchanged_functions = false,
+    std::string_view pass_metrics_path = "",
+    std::optional<int64_t> compile_time_budget_ms = std::nullopt,
+    std::string_view ir_checkpoint_dump_dir = "");
 
 }  // namespace xls::tools
 
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <ostream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -39,6 +40,7 @@
 #include "xls/common/file/filesystem.h"
 #include "xls/common/init_xls.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/ir/package.h"
 #include "xls/passes/optimization_pass.h"
 #include "xls/passes/optimization_pass_pipeline.h"
 #include "xls/tools/opt.h"
@@ -85,6 +87,11 @@ ABSL_FLAG(int64_t, opt_level, xls::kMaxOptLevel,
                           xls::kMaxOptLevel));
 ABSL_FLAG(bool, inline_procs, false,
           "Whether to inline all procs by calling the proc inlining pass.");
+ABSL_FLAG(int64_t, proc_inlining_cluster_size, 0,
+          "If at least two, proc inlining proceeds hierarchically: clusters "
+          "of up to this many tightly connected procs are inlined into "
+          "intermediate container procs bottom-up before the final inline "
+          "into the top proc. Zero inlines all procs at once.");
 ABSL_FLAG(std::string, ram_rewrites_pb, "",
           "Path to protobuf describing ram rewrites.");
 ABSL_FLAG(bool, use_context_narrowing_analysis, false,
@@ -110,6 +117,29 @@ ABSL_FLAG(std::optional<int64_t>, passes_bisect_limit, std::nullopt,
           "fuel to ensure the compiler finishes at a particular point.");
 ABSL_FLAG(bool, list_passes, false,
           "If passed list the names of all passes and exit.");
+ABSL_FLAG(bool, skip_unchanged_functions, false,
+          "If true, function-scoped passes skip functions/procs whose IR is "
+          "unchanged since the pass last ran on them without making changes. "
+          "Speeds up fixed-point pipelines on packages with many functions.");
+ABSL_FLAG(int64_t, worker_count, 1,
+          "Number of worker threads to use when running function-scoped "
+          "passes over the functions/procs of the package. A value of 1 "
+          "processes function bases serially in deterministic order.");
+ABSL_FLAG(std::optional<int64_t>, passes_time_budget_ms, std::nullopt,
+          "Best-effort bound in milliseconds on the total time spent running "
+          "optimization passes. Once the accumulated pass run time reaches "
+          "the budget, remaining passes are skipped; the output IR is valid "
+          "but less optimized. The budget is only consulted between passes, "
+          "so a single long-running pass can overshoot it.");
+ABSL_FLAG(std::string, pass_metrics_path, "",
+          "If set, per-pass telemetry (wall time, nodes added/removed/"
+          "replaced, fixed-point iteration counts) is written to this path as "
+          "a PassPipelineMetricsProto textproto.");
+ABSL_FLAG(std::string, ir_checkpoint_dump_dir, "",
+          "If set, in-memory IR checkpoints are recorded after every pass "
+          "invocation and, if the pipeline fails, written as .ir files into "
+          "this directory. Cheaper than --ir_dump_path: unchanged functions "
+          "share storage and nothing is written unless the pipeline fails.");
 
 namespace xls::tools {
 namespace {
@@ -174,10 +204,11 @@ absl::Status RealMain(std::string_view input_path) {
   std::optional<std::string> pass_list = absl::GetFlag(FLAGS_passes);
   std::optional<int64_t> bisect_limit =
       absl::GetFlag(FLAGS_passes_bisect_limit);
+  int64_t worker_count = absl::GetFlag(FLAGS_worker_count);
 
   XLS_ASSIGN_OR_RETURN(
-      std::string opt_ir,
-      tools::OptimizeIrForTop(
+      std::unique_ptr<Package> package,
+      tools::OptimizePackageForTop(
           /*input_path=*/input_path, /*opt_level=*/opt_level,
           /*top=*/top,
           /*ir_dump_path=*/ir_dump_path,
@@ -185,16 +216,30 @@ absl::Status RealMain(std::string_view input_path) {
           /*convert_array_index_to_select=*/convert_array_index_to_select,
           /*split_next_value_selects=*/split_next_value_selects,
           /*inline_procs=*/inline_procs,
+          /*proc_inlining_cluster_size=*/
+          absl::GetFlag(FLAGS_proc_inlining_cluster_size),
           /*ram_rewrites_pb=*/ram_rewrites_pb,
           /*use_context_narrowing_analysis=*/use_context_narrowing_analysis,
           /*pass_list=*/pass_list,
-          /*bisect_limit=*/bisect_limit));
+          /*bisect_limit=*/bisect_limit,
+          /*worker_count=*/worker_count,
+          /*skip_unchanged_functions=*/
+          absl::GetFlag(FLAGS_skip_unchanged_functions),
+          /*pass_metrics_path=*/absl::GetFlag(FLAGS_pass_metrics_path),
+          /*compile_time_budget_ms=*/
+          absl::GetFlag(FLAGS_passes_time_budget_ms),
+          /*ir_checkpoint_dump_dir=*/
+          absl::GetFlag(FLAGS_ir_checkpoint_dump_dir)));
 
+  // Stream the dump out rather than materializing it; the textual IR of a
+  // large package can rival the in-memory representation in size.
   if (output_path == "-") {
-    std::cout << opt_ir;
+    package->DumpIr(std::cout);
     return absl::OkStatus();
   }
-  return SetFileContents(output_path, opt_ir);
+  return SetFileContents(output_path, [&package](std::ostream& os) {
+    package->DumpIr(os);
+  });
 }
 
 }  // namespace
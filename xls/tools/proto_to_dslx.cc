@@ -34,6 +34,7 @@
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
@@ -85,6 +86,19 @@ struct MessageRecord {
   dslx::StructDef* struct_def = nullptr;
 };
 
+struct DedupState {
+  // Number of occurrences seen of each repeated-submessage content key,
+  // accumulated across all messages added to the module so far.
+  absl::flat_hash_map<std::string, int64_t> counts;
+
+  // The NameDef of the module-level constant each content key has been
+  // hoisted into, if any.
+  absl::flat_hash_map<std::string, dslx::NameDef*> constants;
+
+  // Counter used to give hoisted constants unique names.
+  int64_t next_id = 0;
+};
+
 }  // namespace internal
 
 namespace {
@@ -99,6 +113,7 @@ using google::protobuf::Reflection;
 using google::protobuf::compiler::DiskSourceTree;
 using google::protobuf::compiler::SourceTreeDescriptorDatabase;
 
+using internal::DedupState;
 using internal::MessageRecord;
 using internal::NameToRecord;
 
@@ -529,6 +544,43 @@ absl::Status CollectElementCounts(const std::string& top_package,
   return absl::OkStatus();
 }
 
+// Returns a key identifying the contents of a submessage for deduplication
+// purposes: two messages of the same [DSLX] type with identical contents get
+// the same key.
+std::string DedupKey(const std::string& type_name, const Message& message) {
+  std::string text;
+  google::protobuf::TextFormat::PrintToString(message, &text);
+  return absl::StrCat(type_name, ":", text);
+}
+
+// Walks the fields of the passed message and counts the occurrences of each
+// distinct repeated-submessage value, so that emission knows which values are
+// worth hoisting into shared constants.
+void CollectDedupCounts(const std::string& top_package, const Message& message,
+                        DedupState* dedup_state) {
+  const Descriptor* descriptor = message.GetDescriptor();
+  const Reflection* reflection = message.GetReflection();
+  for (int i = 0; i < descriptor->field_count(); i++) {
+    const FieldDescriptor* fd = descriptor->field(i);
+    if (fd->type() != FieldDescriptor::Type::TYPE_MESSAGE) {
+      continue;
+    }
+    if (fd->is_repeated()) {
+      std::string type_name =
+          GetParentPrefixedName(top_package, fd->message_type());
+      for (int j = 0; j < reflection->FieldSize(message, fd); j++) {
+        const Message& sub_message =
+            reflection->GetRepeatedMessage(message, fd, j);
+        dedup_state->counts[DedupKey(type_name, sub_message)]++;
+        CollectDedupCounts(top_package, sub_message, dedup_state);
+      }
+    } else {
+      CollectDedupCounts(top_package, reflection->GetMessage(message, fd),
+                         dedup_state);
+    }
+  }
+}
+
 // Emits an enum definition from the parsed protobuf schema into the passed
 // Module.
 absl::Status EmitEnumDef(dslx::Module* module, MessageRecord* message_record) {
@@ -769,18 +821,22 @@ absl::Status EmitArray(
   return absl::OkStatus();
 }
 
-// Forward decl of the overall data-emission driver function.
+// Forward decl of the overall data-emission driver function. "dedup_state"
+// may be null, in which case no submessage deduplication is performed.
 absl::StatusOr<dslx::Expr*> EmitData(const std::string& top_package,
                                      dslx::Module* module,
                                      const Message& message,
-                                     const NameToRecord& name_to_record);
+                                     const NameToRecord& name_to_record,
+                                     DedupState* dedup_state);
 
-// Creates the DSLX elements for a struct instance.
+// Creates the DSLX elements for a struct instance. If "dedup_state" is
+// non-null, repeated submessage values occurring more than once are hoisted
+// into shared module-level constants and referenced by name.
 absl::Status EmitStructData(
     const std::string& top_package, dslx::Module* module,
     const Message& message, const FieldDescriptor* fd,
     const Reflection* reflection, const MessageRecord& message_record,
-    const NameToRecord& name_to_record,
+    const NameToRecord& name_to_record, DedupState* dedup_state,
     std::vector<std::pair<std::string, dslx::Expr*>>* elements) {
   dslx::Span span(dslx::Pos{}, dslx::Pos{});
   std::string field_name = fd->name();
@@ -792,18 +848,48 @@ absl::Status EmitStructData(
       return absl::OkStatus();
     }
 
+    std::string type_name =
+        GetParentPrefixedName(top_package, fd->message_type());
     std::vector<dslx::Expr*> array_elements;
     for (int submsg_idx = 0; submsg_idx < num_submsgs; submsg_idx++) {
       const Message& sub_message =
           reflection->GetRepeatedMessage(message, fd, submsg_idx);
-      XLS_ASSIGN_OR_RETURN(
-          dslx::Expr * expr,
-          EmitData(top_package, module, sub_message, name_to_record));
+      std::string key;
+      if (dedup_state != nullptr) {
+        key = DedupKey(type_name, sub_message);
+        auto it = dedup_state->constants.find(key);
+        if (it != dedup_state->constants.end()) {
+          // Already hoisted: just reference the shared constant.
+          array_elements.push_back(module->Make<dslx::NameRef>(
+              span, it->second->identifier(), it->second));
+          continue;
+        }
+      }
+
+      XLS_ASSIGN_OR_RETURN(dslx::Expr * expr,
+                           EmitData(top_package, module, sub_message,
+                                    name_to_record, dedup_state));
+      if (dedup_state != nullptr && dedup_state->counts.at(key) > 1) {
+        // This value repeats: hoist it into a module-level constant and
+        // reference that here (and at every later occurrence).
+        std::string constant_name = absl::StrCat(
+            absl::AsciiStrToUpper(type_name), "_", dedup_state->next_id++);
+        auto* name_def = module->Make<dslx::NameDef>(span, constant_name,
+                                                     /*definer=*/nullptr);
+        auto* constant_def = module->Make<dslx::ConstantDef>(
+            span, name_def, /*type_annotation=*/nullptr, expr,
+            /*is_public=*/false);
+        name_def->set_definer(constant_def);
+        XLS_RETURN_IF_ERROR(
+            module->AddTop(constant_def, /*make_collision_error=*/nullptr));
+        dedup_state->constants[key] = name_def;
+        array_elements.push_back(
+            module->Make<dslx::NameRef>(span, constant_name, name_def));
+        continue;
+      }
       array_elements.push_back(expr);
     }
 
-    std::string type_name =
-        GetParentPrefixedName(top_package, fd->message_type());
     auto* typeref_type = name_to_record.at(type_name)->dslx_type;
     return EmitArray(
         module, message, fd, reflection, message_record, &array_elements,
@@ -814,9 +900,9 @@ absl::Status EmitStructData(
   }
 
   const Message& sub_message = reflection->GetMessage(message, fd);
-  XLS_ASSIGN_OR_RETURN(
-      dslx::Expr * expr,
-      EmitData(top_package, module, sub_message, name_to_record));
+  XLS_ASSIGN_OR_RETURN(dslx::Expr * expr,
+                       EmitData(top_package, module, sub_message,
+                                name_to_record, dedup_state));
   elements->push_back(std::make_pair(field_name, expr));
   return absl::OkStatus();
 }
@@ -947,7 +1033,8 @@ absl::Status EmitIntegralData(
 absl::StatusOr<dslx::Expr*> EmitData(const std::string& top_package,
                                      dslx::Module* module,
                                      const Message& message,
-                                     const NameToRecord& name_to_record) {
+                                     const NameToRecord& name_to_record,
+                                     DedupState* dedup_state) {
   const Descriptor* descriptor = message.GetDescriptor();
   std::string type_name = GetParentPrefixedName(top_package, descriptor);
   const Reflection* reflection = message.GetReflection();
@@ -971,7 +1058,8 @@ absl::StatusOr<dslx::Expr*> EmitData(const std::string& top_package,
       case FieldDescriptor::Type::TYPE_MESSAGE:
         XLS_RETURN_IF_ERROR(EmitStructData(top_package, module, message, fd,
                                            reflection, message_record,
-                                           name_to_record, &elements));
+                                           name_to_record, dedup_state,
+                                           &elements));
         break;
       case FieldDescriptor::Type::TYPE_ENUM:
         XLS_RETURN_IF_ERROR(EmitEnumData(top_package, module, message, fd,
@@ -989,7 +1077,8 @@ absl::StatusOr<dslx::Expr*> EmitData(const std::string& top_package,
 
 absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslxWithDescriptorPool(
     std::string_view message_name, std::string_view text_proto,
-    std::string_view binding_name, DescriptorPool* descriptor_pool) {
+    std::string_view binding_name, DescriptorPool* descriptor_pool,
+    bool dedup_repeated_submessages) {
   XLS_RET_CHECK(descriptor_pool != nullptr);
 
   google::protobuf::DynamicMessageFactory factory;
@@ -1001,7 +1090,7 @@ absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslxWithDescriptorPool(
   auto module =
       std::make_unique<dslx::Module>("the_module", /*fs_path=*/std::nullopt);
 
-  ProtoToDslxManager proto_to_dslx(module.get());
+  ProtoToDslxManager proto_to_dslx(module.get(), dedup_repeated_submessages);
   XLS_RETURN_IF_ERROR(proto_to_dslx.AddProtoInstantiationToDslxModule(
       binding_name, *new_message));
 
@@ -1010,8 +1099,10 @@ absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslxWithDescriptorPool(
 
 }  // namespace
 
-ProtoToDslxManager::ProtoToDslxManager(dslx::Module* module)
-    : module_(module) {}
+ProtoToDslxManager::ProtoToDslxManager(dslx::Module* module,
+                                       bool dedup_repeated_submessages)
+    : module_(module),
+      dedup_repeated_submessages_(dedup_repeated_submessages) {}
 
 ProtoToDslxManager::~ProtoToDslxManager() = default;
 
@@ -1027,8 +1118,18 @@ absl::Status ProtoToDslxManager::AddProtoInstantiationToDslxModule(
   NameToRecord& name_to_record = name_to_records_[descriptor];
   std::string top_package = descriptor->file()->package();
 
+  DedupState* dedup_state = nullptr;
+  if (dedup_repeated_submessages_) {
+    if (dedup_state_ == nullptr) {
+      dedup_state_ = std::make_unique<DedupState>();
+    }
+    CollectDedupCounts(top_package, message, dedup_state_.get());
+    dedup_state = dedup_state_.get();
+  }
+
   XLS_ASSIGN_OR_RETURN(dslx::Expr * expr,
-                       EmitData(top_package, module_, message, name_to_record));
+                       EmitData(top_package, module_, message, name_to_record,
+                                dedup_state));
   dslx::Span span{dslx::Pos{}, dslx::Pos{}};
   auto* name_def = module_->Make<dslx::NameDef>(span, std::string(binding_name),
                                                 /*definer=*/nullptr);
@@ -1104,20 +1205,23 @@ absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslx(
     const std::filesystem::path& source_root,
     const std::filesystem::path& proto_schema_path,
     std::string_view message_name, std::string_view text_proto,
-    std::string_view binding_name) {
+    std::string_view binding_name, bool dedup_repeated_submessages) {
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<DescriptorPool> descriptor_pool,
                        ProcessProtoSchema(source_root, proto_schema_path));
   return ProtoToDslxWithDescriptorPool(message_name, text_proto, binding_name,
-                                       descriptor_pool.get());
+                                       descriptor_pool.get(),
+                                       dedup_repeated_submessages);
 }
 
 absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslxViaText(
     std::string_view proto_def, std::string_view message_name,
-    std::string_view text_proto, std::string_view binding_name) {
+    std::string_view text_proto, std::string_view binding_name,
+    bool dedup_repeated_submessages) {
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<DescriptorPool> descriptor_pool,
                        ProcessStringProtoSchema(proto_def));
   return ProtoToDslxWithDescriptorPool(message_name, text_proto, binding_name,
-                                       descriptor_pool.get());
+                                       descriptor_pool.get(),
+                                       dedup_repeated_submessages);
 }
 
 absl::StatusOr<std::unique_ptr<Message>> ConstructProtoViaText(
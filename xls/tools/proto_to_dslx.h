@@ -40,6 +40,9 @@ struct MessageRecord;
 using NameToRecord =
     absl::flat_hash_map<std::string, std::unique_ptr<MessageRecord>>;
 
+// Bookkeeping for deduplicating repeated submessages into shared constants.
+struct DedupState;
+
 }  // namespace internal
 
 // Provides functionality to construct DSLX definitions and constant
@@ -48,7 +51,13 @@ class ProtoToDslxManager {
  public:
   // Constructs an instance that will add DSLX definitions to the
   // previously constructed DSLX module.
-  explicit ProtoToDslxManager(dslx::Module* module);
+  //
+  // If `dedup_repeated_submessages` is true, repeated submessage entries whose
+  // contents occur more than once are hoisted into shared module-level
+  // constants and referenced by name. This can shrink the emitted DSLX
+  // dramatically for large config protos with many identical submessages.
+  explicit ProtoToDslxManager(dslx::Module* module,
+                              bool dedup_repeated_submessages = false);
 
   ~ProtoToDslxManager();
 
@@ -72,6 +81,8 @@ class ProtoToDslxManager {
   dslx::Module* module_ = nullptr;
   absl::flat_hash_map<const google::protobuf::Descriptor*, internal::NameToRecord>
       name_to_records_;
+  bool dedup_repeated_submessages_ = false;
+  std::unique_ptr<internal::DedupState> dedup_state_;
 };
 
 // Construct a DSLX module for the given proto definitions.
@@ -125,11 +136,14 @@ absl::StatusOr<std::unique_ptr<dslx::Module>> CreateDslxFromParams(
 //       emit.
 //   text_proto: The text of the message definition to translate.
 //   binding_name: The name to assign to the resulting DSLX constant.
+//   dedup_repeated_submessages: If true, repeated submessage entries whose
+//       contents occur more than once are hoisted into shared module-level
+//       constants instead of being emitted inline each time.
 absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslx(
     const std::filesystem::path& source_root,
     const std::filesystem::path& proto_schema_path,
     std::string_view message_name, std::string_view text_proto,
-    std::string_view binding_name);
+    std::string_view binding_name, bool dedup_repeated_submessages = false);
 
 // As above, but doesn't refer directly to the filesystem for resolution.
 //
@@ -138,7 +152,8 @@ absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslx(
 //  ..rest: as above
 absl::StatusOr<std::unique_ptr<dslx::Module>> ProtoToDslxViaText(
     std::string_view proto_def, std::string_view message_name,
-    std::string_view text_proto, std::string_view binding_name);
+    std::string_view text_proto, std::string_view binding_name,
+    bool dedup_repeated_submessages = false);
 
 // Compiles the specified proto schema into a "Descriptor" (contained in the
 // returned pool), potentially loading dependent schema files along the way.
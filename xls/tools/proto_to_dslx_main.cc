@@ -41,6 +41,10 @@ ABSL_FLAG(std::string, textproto_path, "",
           "Path to the textproto to translate into DSLX.");
 ABSL_FLAG(std::string, var_name, "",
           "The name of the DSLX variable to instantiate.");
+ABSL_FLAG(bool, dedup_repeated_submessages, false,
+          "Whether to hoist repeated submessage entries whose contents occur "
+          "more than once into shared module-level constants. This can "
+          "drastically shrink the output for large config protos.");
 
 namespace xls {
 
@@ -49,11 +53,13 @@ static absl::Status RealMain(const std::string& source_root_path,
                              const std::string& proto_name,
                              const std::string& textproto_path,
                              const std::string& var_name,
-                             const std::string& output_path) {
+                             const std::string& output_path,
+                             bool dedup_repeated_submessages) {
   XLS_ASSIGN_OR_RETURN(std::string textproto, GetFileContents(textproto_path));
   XLS_ASSIGN_OR_RETURN(auto module,
                        ProtoToDslx(source_root_path, proto_def_path, proto_name,
-                                   textproto, var_name));
+                                   textproto, var_name,
+                                   dedup_repeated_submessages));
   return SetFileContents(output_path, module->ToString());
 }
 
@@ -79,7 +85,8 @@ int main(int argc, char* argv[]) {
 
   std::string var_name = absl::GetFlag(FLAGS_var_name);
   QCHECK(!var_name.empty()) << "--var_name must be specified.";
-  return xls::ExitStatus(xls::RealMain(source_root_path, proto_def_path,
-                                       proto_name, textproto_path, var_name,
-                                       output_path));
+  return xls::ExitStatus(
+      xls::RealMain(source_root_path, proto_def_path, proto_name,
+                    textproto_path, var_name, output_path,
+                    absl::GetFlag(FLAGS_dedup_repeated_submessages)));
 }
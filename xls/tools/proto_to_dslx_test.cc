@@ -394,6 +394,52 @@ pub struct Top {
 pub const foo = Top { submessage: [SubMessage { my_ints: [sN[64]:1, sN[64]:2, sN[64]:3, sN[64]:4], my_ints_count: u32:4 }, SubMessage { my_ints: [sN[64]:0, sN[64]:0, sN[64]:0, sN[64]:0], my_ints_count: u32:0 }], submessage_count: u32:2 };)");
 }
 
+TEST(ProtoToDslxTest, DedupsRepeatedSubmessages) {
+  const std::string kSchema = R"(
+syntax = "proto2";
+
+package xls;
+
+message SubField {
+  optional uint32 sub_index = 1;
+}
+
+message Top {
+  repeated SubField sub_fields = 1;
+}
+)";
+
+  // The first two entries each repeat, so they should be hoisted into shared
+  // constants; the final entry occurs only once and stays inline.
+  const std::string kTextproto = R"(
+sub_fields: { sub_index: 1 }
+sub_fields: { sub_index: 2 }
+sub_fields: { sub_index: 1 }
+sub_fields: { sub_index: 2 }
+sub_fields: { sub_index: 3 }
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(auto tempdir, TempDirectory::Create());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto schema_file,
+      TempFile::CreateWithContentInDirectory(kSchema, tempdir.path()));
+  XLS_ASSERT_OK(SetFileContents(schema_file.path(), kSchema));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<dslx::Module> module,
+      ProtoToDslx(tempdir.path(), schema_file.path(), "xls.Top", kTextproto,
+                  "foo", /*dedup_repeated_submessages=*/true));
+  EXPECT_EQ(module->ToString(),
+            R"(pub struct SubField {
+    sub_index: uN[32],
+}
+pub struct Top {
+    sub_fields: SubField[5],
+    sub_fields_count: u32,
+}
+const SUBFIELD_0 = SubField { sub_index: uN[32]:1 };
+const SUBFIELD_1 = SubField { sub_index: uN[32]:2 };
+pub const foo = Top { sub_fields: [SUBFIELD_0, SUBFIELD_1, SUBFIELD_0, SUBFIELD_1, SubField { sub_index: uN[32]:3 }], sub_fields_count: u32:5 };)");
+}
+
 TEST(ProtoToDslxTest, MultipleTypesAndInstantiations) {
   const std::string kSchema = R"(
 syntax = "proto2";
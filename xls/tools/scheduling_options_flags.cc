@@ -148,6 +148,10 @@ ABSL_FLAG(
     "*path_number over refinement_stochastic_ratio paths are extracted and "
     "*path_number paths are randomly selected from them for synthesis in each "
     "FDO iteration. Must be a positive float <= 1.0.");
+ABSL_FLAG(int64_t, fdo_synthesis_concurrency, 0,
+          "Maximum number of concurrent synthesis requests issued during FDO "
+          "delay refinement. Must be a non-negative integer; 0 launches one "
+          "request per extracted path/cone/window.");
 ABSL_FLAG(std::string, fdo_path_evaluate_strategy, "window",
           "Path evaluation strategy for FDO. Supports path, cone, and window.");
 ABSL_FLAG(std::string, fdo_synthesizer_name, "yosys",
@@ -213,6 +217,7 @@ static absl::StatusOr<bool> SetOptionsFromFlags(
   POPULATE_FLAG(fdo_delay_driven_path_number);
   POPULATE_FLAG(fdo_fanout_driven_path_number);
   POPULATE_FLAG(fdo_refinement_stochastic_ratio);
+  POPULATE_FLAG(fdo_synthesis_concurrency);
   POPULATE_FLAG(fdo_path_evaluate_strategy);
   POPULATE_FLAG(fdo_synthesizer_name);
   POPULATE_FLAG(fdo_yosys_path);
@@ -428,6 +433,14 @@ static absl::StatusOr<SchedulingOptions> OptionsFromFlagProto(
         proto.fdo_refinement_stochastic_ratio());
   }
 
+  if (proto.has_fdo_synthesis_concurrency()) {
+    if (proto.fdo_synthesis_concurrency() < 0) {
+      return absl::InternalError("fdo_synthesis_concurrency must be >= 0");
+    }
+    scheduling_options.fdo_synthesis_concurrency(
+        proto.fdo_synthesis_concurrency());
+  }
+
   if (proto.has_fdo_path_evaluate_strategy()) {
     if (proto.fdo_path_evaluate_strategy() != "path" &&
         proto.fdo_path_evaluate_strategy() != "cone" &&
@@ -0,0 +1,74 @@
+// Copyright 2026 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Decodes a binary trace file produced by DeferredTraceBuffer and prints the
+// formatted trace messages to stdout in record order.
+
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "xls/common/exit_status.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/init_xls.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/ir/deferred_trace.h"
+#include "xls/ir/events.h"
+
+static constexpr std::string_view kUsage = R"(
+Decodes a binary trace file written by DeferredTraceBuffer (xls/ir/
+deferred_trace.h) and prints the lazily formatted trace messages to stdout.
+
+Example invocation:
+  trace_decoder_main TRACE_FILE
+)";
+
+ABSL_FLAG(int64_t, max_verbosity, std::numeric_limits<int64_t>::max(),
+          "Only print trace messages with verbosity less than or equal to "
+          "this value.");
+
+namespace xls {
+namespace {
+
+absl::Status RealMain(std::string_view trace_path, int64_t max_verbosity) {
+  XLS_ASSIGN_OR_RETURN(std::string serialized, GetFileContents(trace_path));
+  XLS_ASSIGN_OR_RETURN(DeferredTraceBuffer buffer,
+                       DeferredTraceBuffer::ParseFromString(serialized));
+  for (int64_t i = 0; i < buffer.record_count(); ++i) {
+    XLS_ASSIGN_OR_RETURN(TraceMessage message, buffer.FormatRecord(i));
+    if (message.verbosity <= max_verbosity) {
+      std::cout << message.message << '\n';
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+}  // namespace xls
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string_view> positional_arguments =
+      xls::InitXls(kUsage, argc, argv);
+  if (positional_arguments.size() != 1) {
+    LOG(QFATAL) << "Expected invocation: " << argv[0] << " TRACE_FILE";
+  }
+  return xls::ExitStatus(xls::RealMain(positional_arguments[0],
+                                       absl::GetFlag(FLAGS_max_verbosity)));
+}
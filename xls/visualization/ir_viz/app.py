@@ -260,6 +260,14 @@ def graph_handler():
       argv.append('--pipeline_stages={}'.format(FLAGS.pipeline_stages))
     if FLAGS.top is not None:
       argv.append('--entry_name={}'.format(FLAGS.top))
+    # Optionally restrict the response to the neighborhood of a single node so
+    # arbitrarily large graphs can be loaded incrementally.
+    node_name = flask.request.form.get('node_name')
+    if node_name:
+      argv.append('--node_name={}'.format(node_name))
+      radius = flask.request.form.get('radius')
+      if radius:
+        argv.append('--radius={}'.format(radius))
     try:
       json_text = subprocess.check_output(
           argv,
@@ -14,6 +14,7 @@
 
 #include "xls/visualization/ir_viz/ir_to_json.h"
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -29,14 +30,10 @@
 #include "xls/visualization/ir_viz/visualization.pb.h"
 
 namespace xls {
+namespace {
 
-absl::StatusOr<std::string> IrToJson(
-    Package* package, const DelayEstimator& delay_estimator,
-    const PipelineSchedule* schedule,
-    std::optional<std::string_view> entry_name) {
-  XLS_ASSIGN_OR_RETURN(viz::Package proto, IrToProto(package, delay_estimator,
-                                                     schedule, entry_name));
-
+// Serializes the visualization proto to JSON.
+absl::StatusOr<std::string> PackageProtoToJson(const viz::Package& proto) {
   std::string serialized_json;
   google::protobuf::util::JsonPrintOptions print_options;
   print_options.add_whitespace = true;
@@ -50,4 +47,26 @@ absl::StatusOr<std::string> IrToJson(
   return serialized_json;
 }
 
+}  // namespace
+
+absl::StatusOr<std::string> IrToJson(
+    Package* package, const DelayEstimator& delay_estimator,
+    const PipelineSchedule* schedule,
+    std::optional<std::string_view> entry_name) {
+  XLS_ASSIGN_OR_RETURN(viz::Package proto, IrToProto(package, delay_estimator,
+                                                     schedule, entry_name));
+  return PackageProtoToJson(proto);
+}
+
+absl::StatusOr<std::string> IrToJsonNeighborhood(
+    Package* package, const DelayEstimator& delay_estimator,
+    std::string_view function_name, std::string_view node_name, int64_t radius,
+    const PipelineSchedule* schedule) {
+  XLS_ASSIGN_OR_RETURN(
+      viz::Package proto,
+      IrToProtoNeighborhood(package, delay_estimator, function_name, node_name,
+                            radius, schedule));
+  return PackageProtoToJson(proto);
+}
+
 }  // namespace xls
@@ -15,6 +15,7 @@
 #ifndef XLS_VISUALIZATION_IR_VIZ_IR_TO_JSON_H_
 #define XLS_VISUALIZATION_IR_VIZ_IR_TO_JSON_H_
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -34,6 +35,17 @@ absl::StatusOr<std::string> IrToJson(
     const PipelineSchedule* schedule = nullptr,
     std::optional<std::string_view> entry_name = std::nullopt);
 
+// As above, but the JSON contains only the neighborhood of the node named
+// `node_name` in the function base named `function_name`: the nodes within
+// `radius` def-use hops of the center node and the edges between them. The
+// output size is bounded by the neighborhood size rather than the package size
+// so the visualizer can incrementally load windows of arbitrarily large
+// graphs.
+absl::StatusOr<std::string> IrToJsonNeighborhood(
+    Package* package, const DelayEstimator& delay_estimator,
+    std::string_view function_name, std::string_view node_name, int64_t radius,
+    const PipelineSchedule* schedule = nullptr);
+
 }  // namespace xls
 
 #endif  // XLS_VISUALIZATION_IR_VIZ_IR_TO_JSON_H_
@@ -45,9 +45,16 @@ ABSL_FLAG(std::string, delay_model, "", "Delay model to use.");
 ABSL_FLAG(std::optional<int64_t>, pipeline_stages, std::nullopt,
           "Pipeline stages to use when scheduling the function");
 ABSL_FLAG(std::optional<std::string>, entry_name, std::nullopt, "Entry name");
+ABSL_FLAG(std::optional<std::string>, node_name, std::nullopt,
+          "If given, emit only the neighborhood of this node in the entry "
+          "rather than the entire package. Bounds the output size for very "
+          "large graphs.");
+ABSL_FLAG(int64_t, radius, 1,
+          "Number of def-use hops around --node_name to include in the "
+          "emitted neighborhood.");
 
 constexpr std::string_view kUsage =
-    R"(Expected: ir_to_json_main --delay_model=MODEL [--pipeline_stages=N] [--entry_name=ENTRY] /path/to/file.ir)";
+    R"(Expected: ir_to_json_main --delay_model=MODEL [--pipeline_stages=N] [--entry_name=ENTRY] [--node_name=NODE --radius=N] /path/to/file.ir)";
 
 namespace xls {
 namespace {
@@ -70,7 +77,9 @@ absl::StatusOr<FunctionBase*> GetFunctionBaseToView(Package* package) {
 absl::Status RealMain(const std::filesystem::path& ir_path,
                       std::string_view delay_model_name,
                       std::optional<int64_t> pipeline_stages,
-                      std::optional<std::string_view> entry_name) {
+                      std::optional<std::string_view> entry_name,
+                      std::optional<std::string_view> node_name,
+                      int64_t radius) {
   XLS_ASSIGN_OR_RETURN(std::string ir_text, GetFileContents(ir_path));
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
                        Parser::ParsePackage(ir_text));
@@ -83,21 +92,29 @@ absl::Status RealMain(const std::filesystem::path& ir_path,
   XLS_ASSIGN_OR_RETURN(DelayEstimator * delay_estimator,
                        GetDelayEstimator(delay_model_name));
 
-  std::string json;
+  std::optional<PipelineSchedule> schedule;
   if (pipeline_stages.has_value()) {
     // TODO(meheff): Support scheduled procs.
     XLS_RET_CHECK(func_base->IsFunction());
     XLS_ASSIGN_OR_RETURN(
-        PipelineSchedule schedule,
+        schedule,
         RunPipelineSchedule(
             func_base->AsFunctionOrDie(), *delay_estimator,
             SchedulingOptions().pipeline_stages(pipeline_stages.value())));
-    XLS_ASSIGN_OR_RETURN(json, IrToJson(package.get(), *delay_estimator,
-                                        &schedule, func_base->name()));
+  }
+
+  std::string json;
+  if (node_name.has_value()) {
+    XLS_ASSIGN_OR_RETURN(
+        json, IrToJsonNeighborhood(
+                  package.get(), *delay_estimator, func_base->name(),
+                  node_name.value(), radius,
+                  schedule.has_value() ? &schedule.value() : nullptr));
   } else {
-    XLS_ASSIGN_OR_RETURN(json,
-                         IrToJson(package.get(), *delay_estimator,
-                                  /*schedule=*/nullptr, func_base->name()));
+    XLS_ASSIGN_OR_RETURN(
+        json, IrToJson(package.get(), *delay_estimator,
+                       schedule.has_value() ? &schedule.value() : nullptr,
+                       func_base->name()));
   }
   std::cout << json << "\n";
   return absl::OkStatus();
@@ -120,5 +137,6 @@ int main(int argc, char** argv) {
 
   return xls::ExitStatus(xls::RealMain(
       positional_arguments[0], absl::GetFlag(FLAGS_delay_model),
-      absl::GetFlag(FLAGS_pipeline_stages), absl::GetFlag(FLAGS_entry_name)));
+      absl::GetFlag(FLAGS_pipeline_stages), absl::GetFlag(FLAGS_entry_name),
+      absl::GetFlag(FLAGS_node_name), absl::GetFlag(FLAGS_radius)));
 }
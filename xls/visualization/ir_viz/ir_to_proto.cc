@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -181,10 +182,14 @@ absl::StatusOr<viz::NodeAttributes> NodeAttributes(
   return attributes;
 }
 
+// Builds the visualization proto for the given function base. If `node_filter`
+// is non-null, only nodes in the filter and edges whose endpoints are both in
+// the filter are emitted.
 absl::StatusOr<viz::FunctionBase> FunctionBaseToVisualizationProto(
     FunctionBase* function, const DelayEstimator& delay_estimator,
     const PipelineSchedule* schedule,
-    const absl::flat_hash_map<FunctionBase*, std::string>& function_ids) {
+    const absl::flat_hash_map<FunctionBase*, std::string>& function_ids,
+    const absl::flat_hash_set<Node*>* node_filter = nullptr) {
   viz::FunctionBase proto;
   proto.set_name(function->name());
   if (function->IsFunction()) {
@@ -217,6 +222,9 @@ absl::StatusOr<viz::FunctionBase> FunctionBaseToVisualizationProto(
   XLS_RETURN_IF_ERROR(query_engine.Populate(function).status());
 
   for (Node* node : function->nodes()) {
+    if (node_filter != nullptr && !node_filter->contains(node)) {
+      continue;
+    }
     viz::Node* graph_node = proto.add_nodes();
     graph_node->set_name(node->GetName());
     graph_node->set_id(GetNodeUniqueId(node, function_ids));
@@ -241,9 +249,15 @@ absl::StatusOr<viz::FunctionBase> FunctionBaseToVisualizationProto(
   };
 
   for (Node* node : function->nodes()) {
+    if (node_filter != nullptr && !node_filter->contains(node)) {
+      continue;
+    }
     bool node_on_critical_path = node_to_critical_path_entry.contains(node);
     for (int64_t i = 0; i < node->operand_count(); ++i) {
       Node* operand = node->operand(i);
+      if (node_filter != nullptr && !node_filter->contains(operand)) {
+        continue;
+      }
       viz::Edge* graph_edge = proto.add_edges();
       graph_edge->set_id(GetEdgeUniqueId(operand, node, function_ids));
       graph_edge->set_source_id(GetNodeUniqueId(operand, function_ids));
@@ -271,6 +285,32 @@ absl::StatusOr<viz::FunctionBase> FunctionBaseToVisualizationProto(
   return std::move(proto);
 }
 
+// Returns the set of nodes within `radius` def-use hops of `center`, walking
+// both operands and users. The node's operand and user lists serve as the
+// adjacency index so no additional graph structure needs to be built.
+absl::flat_hash_set<Node*> GetNodeNeighborhood(Node* center, int64_t radius) {
+  absl::flat_hash_set<Node*> visited = {center};
+  std::vector<Node*> frontier = {center};
+  for (int64_t hop = 0; hop < radius && !frontier.empty(); ++hop) {
+    std::vector<Node*> next_frontier;
+    auto visit = [&](Node* neighbor) {
+      if (visited.insert(neighbor).second) {
+        next_frontier.push_back(neighbor);
+      }
+    };
+    for (Node* node : frontier) {
+      for (Node* operand : node->operands()) {
+        visit(operand);
+      }
+      for (Node* user : node->users()) {
+        visit(user);
+      }
+    }
+    frontier = std::move(next_frontier);
+  }
+  return visited;
+}
+
 // Wraps the given text in a span with the given id, classes, and data. The
 // string `str` is modified in place.
 absl::Status WrapTextInSpan(
@@ -531,4 +571,44 @@ absl::StatusOr<viz::Package> IrToProto(
   return proto;
 }
 
+absl::StatusOr<viz::Package> IrToProtoNeighborhood(
+    Package* package, const DelayEstimator& delay_estimator,
+    std::string_view function_name, std::string_view node_name, int64_t radius,
+    const PipelineSchedule* schedule) {
+  XLS_RET_CHECK_GE(radius, 0);
+
+  FunctionBase* function = nullptr;
+  for (FunctionBase* fb : package->GetFunctionBases()) {
+    if (fb->name() == function_name) {
+      function = fb;
+      break;
+    }
+  }
+  if (function == nullptr) {
+    return absl::NotFoundError(absl::StrFormat(
+        "No function, proc, or block named `%s` in package.", function_name));
+  }
+  XLS_ASSIGN_OR_RETURN(Node * center, function->GetNode(node_name));
+  absl::flat_hash_set<Node*> neighborhood = GetNodeNeighborhood(center, radius);
+
+  absl::flat_hash_map<FunctionBase*, std::string> function_ids =
+      GetFunctionIds(package);
+
+  // The proto contains only the surrounding function base with nodes and edges
+  // restricted to the neighborhood. The marked up IR text is deliberately
+  // omitted as it scales with the size of the package.
+  viz::Package proto;
+  proto.set_name(package->name());
+  XLS_ASSIGN_OR_RETURN(
+      *proto.add_function_bases(),
+      FunctionBaseToVisualizationProto(
+          function, delay_estimator,
+          schedule != nullptr && schedule->function_base() == function
+              ? schedule
+              : nullptr,
+          function_ids, &neighborhood));
+  proto.set_entry_id(function_ids.at(function));
+  return proto;
+}
+
 }  // namespace xls
@@ -15,6 +15,7 @@
 #ifndef XLS_VISUALIZATION_IR_VIZ_IR_TO_PROTO_H_
 #define XLS_VISUALIZATION_IR_VIZ_IR_TO_PROTO_H_
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -34,6 +35,18 @@ absl::StatusOr<xls::viz::Package> IrToProto(
     const PipelineSchedule* schedule = nullptr,
     std::optional<std::string_view> entry_name = std::nullopt);
 
+// Returns a xls::viz::Package proto containing only the neighborhood of the
+// node named `node_name` in the function base named `function_name`: the nodes
+// reachable from the center node within `radius` def-use hops (in either
+// direction) and the edges between them. The proto contains a single
+// FunctionBase and no marked up IR text so its size is bounded by the
+// neighborhood size rather than the package size. This enables viewing a
+// window of a graph which is too large to serialize in its entirety.
+absl::StatusOr<xls::viz::Package> IrToProtoNeighborhood(
+    Package* package, const DelayEstimator& delay_estimator,
+    std::string_view function_name, std::string_view node_name, int64_t radius,
+    const PipelineSchedule* schedule = nullptr);
+
 }  // namespace xls
 
 #endif  // XLS_VISUALIZATION_IR_VIZ_IR_TO_PROTO_H_
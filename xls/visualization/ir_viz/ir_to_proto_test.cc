@@ -16,8 +16,11 @@
 
 #include <filesystem>  // NOLINT
 #include <memory>
+#include <string>
 #include <string_view>
+#include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/log/log.h"
 #include "absl/strings/str_format.h"
@@ -178,5 +181,95 @@ top proc the_proc(x: bits[32], y: bits[64], init={0, 42}) {
   ExpectEqualToGoldenFile(GoldenFilePath("htmltext"), proto.ir_html());
 }
 
+TEST_F(IrToProtoTest, Neighborhood) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(R"(
+package test
+
+fn main(x: bits[32]) -> bits[32] {
+  a: bits[32] = not(x)
+  b: bits[32] = not(a)
+  c: bits[32] = not(b)
+  d: bits[32] = not(c)
+  ret e: bits[32] = not(d)
+}
+)"));
+  XLS_ASSERT_OK_AND_ASSIGN(DelayEstimator * delay_estimator,
+                           GetDelayEstimator("unit"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      viz::Package proto,
+      IrToProtoNeighborhood(p.get(), *delay_estimator,
+                            /*function_name=*/"main", /*node_name=*/"c",
+                            /*radius=*/1));
+
+  // Only the center node and its immediate operands and users should be
+  // emitted along with the edges between them. The marked up IR text is
+  // omitted entirely.
+  ASSERT_EQ(proto.function_bases_size(), 1);
+  const viz::FunctionBase& fb = proto.function_bases(0);
+  std::vector<std::string> node_names;
+  for (const viz::Node& node : fb.nodes()) {
+    node_names.push_back(node.name());
+  }
+  EXPECT_THAT(node_names, testing::UnorderedElementsAre("b", "c", "d"));
+  EXPECT_EQ(fb.edges_size(), 2);
+  EXPECT_TRUE(proto.ir_html().empty());
+  EXPECT_EQ(proto.entry_id(), fb.id());
+}
+
+TEST_F(IrToProtoTest, NeighborhoodLargerRadius) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(R"(
+package test
+
+fn main(x: bits[32]) -> bits[32] {
+  a: bits[32] = not(x)
+  b: bits[32] = not(a)
+  c: bits[32] = not(b)
+  d: bits[32] = not(c)
+  ret e: bits[32] = not(d)
+}
+)"));
+  XLS_ASSERT_OK_AND_ASSIGN(DelayEstimator * delay_estimator,
+                           GetDelayEstimator("unit"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      viz::Package proto,
+      IrToProtoNeighborhood(p.get(), *delay_estimator,
+                            /*function_name=*/"main", /*node_name=*/"c",
+                            /*radius=*/2));
+
+  // Radius two reaches node `e` which has an implicit use as the return value
+  // so the implicit sink node and its edge are included as well.
+  ASSERT_EQ(proto.function_bases_size(), 1);
+  const viz::FunctionBase& fb = proto.function_bases(0);
+  std::vector<std::string> node_names;
+  for (const viz::Node& node : fb.nodes()) {
+    node_names.push_back(node.name());
+  }
+  EXPECT_THAT(node_names, testing::UnorderedElementsAre(
+                              "a", "b", "c", "d", "e", "main_sink"));
+  EXPECT_EQ(fb.edges_size(), 5);
+}
+
+TEST_F(IrToProtoTest, NeighborhoodOfUnknownNode) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(R"(
+package test
+
+fn main(x: bits[32]) -> bits[32] {
+  ret not_x: bits[32] = not(x)
+}
+)"));
+  XLS_ASSERT_OK_AND_ASSIGN(DelayEstimator * delay_estimator,
+                           GetDelayEstimator("unit"));
+  EXPECT_FALSE(IrToProtoNeighborhood(p.get(), *delay_estimator,
+                                     /*function_name=*/"main",
+                                     /*node_name=*/"does_not_exist",
+                                     /*radius=*/1)
+                   .ok());
+  EXPECT_FALSE(IrToProtoNeighborhood(p.get(), *delay_estimator,
+                                     /*function_name=*/"does_not_exist",
+                                     /*node_name=*/"not_x",
+                                     /*radius=*/1)
+                   .ok());
+}
+
 }  // namespace
 }  // namespace xls